@@ -42,6 +42,7 @@
 #include "mlpack/methods/fastmks.hpp"
 #include "mlpack/methods/gmm.hpp"
 #include "mlpack/methods/hmm.hpp"
+#include "mlpack/methods/hnsw.hpp"
 #include "mlpack/methods/hoeffding_trees.hpp"
 #include "mlpack/methods/kde.hpp"
 #include "mlpack/methods/kernel_pca.hpp"
@@ -63,9 +64,11 @@
 #include "mlpack/methods/pca.hpp"
 #include "mlpack/methods/perceptron.hpp"
 #include "mlpack/methods/preprocess.hpp"
+#include "mlpack/methods/product_quantization.hpp"
 #include "mlpack/methods/quic_svd.hpp"
 #include "mlpack/methods/radical.hpp"
 #include "mlpack/methods/random_forest.hpp"
+#include "mlpack/methods/random_fourier_features.hpp"
 #include "mlpack/methods/randomized_svd.hpp"
 #include "mlpack/methods/range_search.hpp"
 #include "mlpack/methods/rann.hpp"
@@ -75,6 +78,7 @@
 #include "mlpack/methods/sparse_autoencoder.hpp"
 #include "mlpack/methods/sparse_coding.hpp"
 #include "mlpack/methods/svdplusplus.hpp"
+#include "mlpack/methods/xgboost.hpp"
 
 // Include reverse compatibility.
 #include "mlpack/namespace_compat.hpp"
@@ -81,6 +81,18 @@
   #error "Need to enable C++17 mode in your compiler"
 #endif
 
+// If memory is tracked, Armadillo allocates its memory through mlpack; this
+// has to be set up before Armadillo is included.
+#include <mlpack/core/util/memory_usage.hpp>
+#ifdef MLPACK_TRACK_MEMORY
+  #if defined(ARMA_INCLUDES)
+    #error "Armadillo must be included after mlpack when memory is tracked"
+  #endif
+
+  #define ARMA_ALIEN_MEM_ALLOC_FUNCTION mlpack::util::TrackedAllocate
+  #define ARMA_ALIEN_MEM_FREE_FUNCTION mlpack::util::TrackedFree
+#endif
+
 // Now include Armadillo and traits that we use for it.
 #include <armadillo>
 #include <mlpack/core/util/arma_traits.hpp>
@@ -0,0 +1,302 @@
+/**
+ * @file benchmarks/benchmark.hpp
+ *
+ * A small harness for the performance benchmarks of mlpack: each benchmark is
+ * a function that is registered with MLPACK_BENCHMARK(), and that is run for
+ * every configuration (dataset, tree type, leaf size, dimensionality, number
+ * of points and number of threads) given on the command line of
+ * mlpack_benchmarks.  Benchmarks of neural network layers are registered with
+ * MLPACK_LAYER_BENCHMARK() instead (see layer_benchmark.hpp), and are run for
+ * every batch size, precision and number of threads.  Benchmarks of data
+ * loading and preprocessing are registered with MLPACK_DATA_BENCHMARK(), and
+ * are run for every number of points, dimensionality and number of threads of
+ * the --data_points and --data_dimensions options.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BENCHMARKS_BENCHMARK_HPP
+#define MLPACK_BENCHMARKS_BENCHMARK_HPP
+
+#include <mlpack/core.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <sys/resource.h>
+#endif
+
+namespace mlpack {
+namespace benchmarks {
+
+/**
+ * The configuration that a benchmark is run with.
+ */
+struct BenchmarkConfig
+{
+  //! The dataset: the name of a synthetic dataset (see GenerateDataset()), or
+  //! the name of a file to load.
+  std::string dataset;
+  //! The tree type ("kd", "ball" or "cover").
+  std::string tree;
+  //! The number of points of a synthetic dataset.
+  size_t points;
+  //! The dimensionality of a synthetic dataset.
+  size_t dimensionality;
+  //! The maximum number of points in a leaf (ignored by cover trees).
+  size_t leafSize;
+  //! The number of threads (see SetThreads()).
+  size_t threads;
+  //! The seed of synthetic datasets.
+  size_t seed;
+  //! The batch size of a layer benchmark.
+  size_t batchSize;
+  //! The precision of a layer benchmark ("double" or "float").
+  std::string precision;
+  //! The directory that data benchmarks write their files to.
+  std::string scratchDirectory;
+};
+
+/**
+ * The configurations that a benchmark is run with.
+ */
+enum BenchmarkSweep
+{
+  //! Every dataset, tree type, leaf size, dimensionality, number of points and
+  //! number of threads.
+  DATASET_SWEEP,
+  //! Every batch size, precision and number of threads.
+  LAYER_SWEEP,
+  //! Every number of points and dimensionality of the data options, and every
+  //! number of threads.
+  DATA_SWEEP
+};
+
+/**
+ * Get the peak resident memory of the process since the last call to
+ * ResetProcessPeakMemory() (or since the process started, if the peak could
+ * not be reset), in bytes.  This is 0 if the platform does not give it.
+ */
+inline size_t ProcessPeakMemory()
+{
+  #if defined(__linux__)
+  // The peak ("high water mark") given in kB by /proc can be reset, unlike the
+  // one of getrusage().
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line))
+  {
+    if (line.compare(0, 6, "VmHWM:") == 0)
+      return 1024 * std::strtoull(line.c_str() + 6, NULL, 10);
+  }
+  #endif
+
+  #if defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+    return (size_t) usage.ru_maxrss;
+  #elif defined(__unix__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+    return 1024 * (size_t) usage.ru_maxrss;
+  #endif
+
+  return 0;
+}
+
+/**
+ * Reset the peak resident memory of the process to its current resident
+ * memory, if the platform allows it (only Linux does).
+ */
+inline void ResetProcessPeakMemory()
+{
+  #if defined(__linux__)
+  std::ofstream clearRefs("/proc/self/clear_refs");
+  clearRefs << "5";
+  #endif
+}
+
+/**
+ * The state of a run of a benchmark.  The benchmark prepares its input, times
+ * the code to measure with Measure(), and reports with SetItems() how many
+ * items (points, queries) each run processes, and with
+ * SetDistanceEvaluations(), SetScores() and SetFlops() how much work each run
+ * did.
+ */
+class BenchmarkState
+{
+ public:
+  /**
+   * Create the state of a run of a benchmark.
+   *
+   * @param config Configuration of the run.
+   * @param repetitions Number of timed repetitions of the measured code.
+   * @param warmups Number of untimed repetitions before the timed ones.
+   */
+  BenchmarkState(const BenchmarkConfig& config,
+                 const size_t repetitions,
+                 const size_t warmups) :
+      config(config),
+      repetitions(repetitions),
+      warmups(warmups),
+      items(0),
+      distanceEvaluations(0),
+      scores(0),
+      flops(0),
+      bytes(0),
+      peakResidentMemory(0),
+      skipped(false)
+  { }
+
+  //! Get the configuration of the run.
+  const BenchmarkConfig& Config() const { return config; }
+
+  /**
+   * Call the given function for each warmup, and then time it for each
+   * repetition.  The function runs with the number of threads of the
+   * configuration.  The peak resident memory of the process during the calls
+   * is recorded too.
+   *
+   * @param f Function to time.
+   */
+  template<typename FunctionType>
+  void Measure(FunctionType f)
+  {
+    ScopedThreads threads(config.threads);
+    ResetProcessPeakMemory();
+
+    for (size_t i = 0; i < warmups; ++i)
+      f();
+
+    times.clear();
+    for (size_t i = 0; i < repetitions; ++i)
+    {
+      const std::chrono::steady_clock::time_point start =
+          std::chrono::steady_clock::now();
+      f();
+      times.push_back(std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - start).count());
+    }
+
+    peakResidentMemory = ProcessPeakMemory();
+  }
+
+  //! Set the number of items that each run processes.
+  void SetItems(const size_t n) { items = n; }
+  //! Set the number of distance (or kernel) evaluations of each run.
+  void SetDistanceEvaluations(const size_t n) { distanceEvaluations = n; }
+  //! Set the number of node (or node combination) scores of each run.
+  void SetScores(const size_t n) { scores = n; }
+  //! Set the number of floating-point operations of each run.
+  void SetFlops(const size_t n) { flops = n; }
+  //! Set the number of bytes (of files or of data) that each run processes.
+  void SetBytes(const size_t n) { bytes = n; }
+
+  //! Skip the run, because the configuration does not apply to the benchmark.
+  void Skip() { skipped = true; }
+
+  //! Get the time of each repetition, in seconds.
+  const std::vector<double>& Times() const { return times; }
+  //! Get the number of items of each run.
+  size_t Items() const { return items; }
+  //! Get the number of distance evaluations of each run.
+  size_t DistanceEvaluations() const { return distanceEvaluations; }
+  //! Get the number of scores of each run.
+  size_t Scores() const { return scores; }
+  //! Get the number of floating-point operations of each run.
+  size_t Flops() const { return flops; }
+  //! Get the number of bytes of each run.
+  size_t Bytes() const { return bytes; }
+  //! Get the peak resident memory of the process during Measure(), in bytes.
+  size_t PeakResidentMemory() const { return peakResidentMemory; }
+  //! Get whether the run was skipped.
+  bool Skipped() const { return skipped; }
+
+ private:
+  //! The configuration of the run.
+  BenchmarkConfig config;
+  //! The number of timed repetitions.
+  size_t repetitions;
+  //! The number of untimed repetitions.
+  size_t warmups;
+  //! The times of the repetitions.
+  std::vector<double> times;
+  //! The number of items of each run.
+  size_t items;
+  //! The number of distance evaluations of each run.
+  size_t distanceEvaluations;
+  //! The number of scores of each run.
+  size_t scores;
+  //! The number of floating-point operations of each run.
+  size_t flops;
+  //! The number of bytes of each run.
+  size_t bytes;
+  //! The peak resident memory during Measure().
+  size_t peakResidentMemory;
+  //! Whether the run was skipped.
+  bool skipped;
+};
+
+//! The type of the function of a benchmark.
+using BenchmarkFunction = std::function<void(BenchmarkState&)>;
+
+/**
+ * A registered benchmark.
+ */
+struct Benchmark
+{
+  //! The name of the benchmark.
+  std::string name;
+  //! The function of the benchmark.
+  BenchmarkFunction function;
+  //! The configurations that the benchmark is run with.
+  BenchmarkSweep sweep;
+};
+
+/**
+ * Get the registered benchmarks, in order of registration.  Benchmarks are
+ * registered with MLPACK_BENCHMARK() or MLPACK_LAYER_BENCHMARK().
+ */
+inline std::vector<Benchmark>& Benchmarks()
+{
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+/**
+ * Registers a benchmark when constructed; see MLPACK_BENCHMARK().
+ */
+struct RegisterBenchmark
+{
+  RegisterBenchmark(const std::string& name,
+                    BenchmarkFunction function,
+                    const BenchmarkSweep sweep = DATASET_SWEEP)
+  {
+    Benchmarks().push_back(Benchmark{ name, function, sweep });
+  }
+};
+
+} // namespace benchmarks
+} // namespace mlpack
+
+/**
+ * Register the given function as a benchmark with the given name.  Names are
+ * of the form "method/variant", for instance "knn/dual_tree".
+ */
+#define MLPACK_BENCHMARK(NAME, FUNCTION) \
+    static mlpack::benchmarks::RegisterBenchmark FUNCTION##Registration( \
+        NAME, FUNCTION)
+
+/**
+ * Register the given function as a benchmark of data loading or preprocessing
+ * with the given name, for instance "data/load_csv".
+ */
+#define MLPACK_DATA_BENCHMARK(NAME, FUNCTION) \
+    static mlpack::benchmarks::RegisterBenchmark FUNCTION##Registration( \
+        NAME, FUNCTION, mlpack::benchmarks::DATA_SWEEP)
+
+#endif
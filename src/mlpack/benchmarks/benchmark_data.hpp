@@ -0,0 +1,236 @@
+/**
+ * @file benchmarks/benchmark_data.hpp
+ *
+ * Reproducible datasets and tree construction for the benchmarks.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BENCHMARKS_BENCHMARK_DATA_HPP
+#define MLPACK_BENCHMARKS_BENCHMARK_DATA_HPP
+
+#include <mlpack/core.hpp>
+
+#include "benchmark.hpp"
+
+#include <random>
+
+namespace mlpack {
+namespace benchmarks {
+
+/**
+ * A source of uniform and normal random numbers that gives the same numbers
+ * on every platform for the same seed (the distributions of the standard
+ * library may differ between implementations).
+ */
+class BenchmarkRandom
+{
+ public:
+  //! Create the source with the given seed.
+  BenchmarkRandom(const size_t seed) : generator(seed) { }
+
+  //! Get a random number uniformly distributed in [0, 1).
+  double Uniform() { return (generator() >> 11) * 0x1.0p-53; }
+
+  //! Get a random number from the standard normal distribution.
+  double Normal()
+  {
+    // Box-Muller transform; 1 - Uniform() is never 0.
+    const double u = 1.0 - Uniform();
+    const double v = Uniform();
+    return std::sqrt(-2.0 * std::log(u)) * std::cos(2.0 * M_PI * v);
+  }
+
+ private:
+  //! The generator.
+  std::mt19937_64 generator;
+};
+
+/**
+ * Get the dataset of the given configuration, scaled so that each dimension
+ * spans [0, 1].  The synthetic datasets are
+ *
+ *  - "uniform": points distributed uniformly;
+ *  - "clustered": points from 10 Gaussians with standard deviation 0.05 and
+ *    uniformly distributed centers;
+ *  - "manifold": points on a smooth 3-dimensional manifold (or of the
+ *    dimensionality of the dataset, if it is smaller), with a little noise.
+ *    Real datasets usually have such a low intrinsic dimension, which is what
+ *    makes trees effective.
+ *
+ * Any other name is loaded as a file, whose points and dimensionality are
+ * used instead of those of the configuration.  A std::runtime_error is thrown
+ * if the file cannot be loaded.
+ *
+ * @param config Configuration of the benchmark.
+ */
+inline arma::mat GenerateDataset(const BenchmarkConfig& config)
+{
+  arma::mat dataset;
+  const size_t d = config.dimensionality;
+  const size_t n = config.points;
+  BenchmarkRandom random(config.seed);
+
+  if (config.dataset == "uniform")
+  {
+    dataset.set_size(d, n);
+    for (size_t i = 0; i < dataset.n_elem; ++i)
+      dataset[i] = random.Uniform();
+  }
+  else if (config.dataset == "clustered")
+  {
+    const size_t numClusters = 10;
+    arma::mat centers(d, numClusters);
+    for (size_t i = 0; i < centers.n_elem; ++i)
+      centers[i] = random.Uniform();
+
+    dataset.set_size(d, n);
+    for (size_t c = 0; c < n; ++c)
+    {
+      const size_t cluster = c % numClusters;
+      for (size_t r = 0; r < d; ++r)
+        dataset(r, c) = centers(r, cluster) + 0.05 * random.Normal();
+    }
+  }
+  else if (config.dataset == "manifold")
+  {
+    // Each point is a random linear and a random sinusoidal function of
+    // latent coordinates.
+    const size_t latentDims = std::min(d, (size_t) 3);
+    arma::mat linear(d, latentDims), frequencies(d, latentDims);
+    for (size_t i = 0; i < linear.n_elem; ++i)
+    {
+      linear[i] = random.Normal();
+      frequencies[i] = 2.0 * M_PI * random.Uniform();
+    }
+
+    dataset.set_size(d, n);
+    arma::vec latent(latentDims);
+    for (size_t c = 0; c < n; ++c)
+    {
+      for (size_t j = 0; j < latentDims; ++j)
+        latent[j] = random.Uniform();
+
+      for (size_t r = 0; r < d; ++r)
+      {
+        double value = 0.01 * random.Normal();
+        for (size_t j = 0; j < latentDims; ++j)
+        {
+          value += linear(r, j) * latent[j] +
+              0.5 * std::sin(frequencies(r, j) * latent[j]);
+        }
+        dataset(r, c) = value;
+      }
+    }
+  }
+  else if (!data::Load(config.dataset, dataset, false))
+  {
+    throw std::runtime_error("cannot load the dataset '" + config.dataset +
+        "'!");
+  }
+
+  // Scale each dimension to [0, 1].
+  for (size_t r = 0; r < dataset.n_rows; ++r)
+  {
+    const double minValue = dataset.row(r).min();
+    const double range = dataset.row(r).max() - minValue;
+    dataset.row(r) -= minValue;
+    if (range > 0.0)
+      dataset.row(r) /= range;
+  }
+
+  return dataset;
+}
+
+/**
+ * Get the radius of a ball that holds, on average, the given number of points
+ * of a dataset with the given number of points distributed uniformly in the
+ * unit cube of the given dimensionality.  This gives range searches and
+ * kernel bandwidths of a similar amount of work for all dimensionalities.
+ *
+ * @param points Number of points of the dataset.
+ * @param dimensionality Dimensionality of the dataset.
+ * @param neighbors Average number of points in the ball.
+ */
+inline double NeighborhoodRadius(const size_t points,
+                                 const size_t dimensionality,
+                                 const double neighbors)
+{
+  // The volume of the unit ball is pi^(d / 2) / Gamma(d / 2 + 1).
+  const double d = (double) dimensionality;
+  const double logUnitBall = 0.5 * d * std::log(M_PI) -
+      std::lgamma(0.5 * d + 1.0);
+  return std::exp((std::log(neighbors / points) - logUnitBall) / d);
+}
+
+/**
+ * Holds a tree type, so that benchmarks can be written once for all tree
+ * types; see DispatchTree().
+ */
+template<template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+struct TreeSelector
+{
+  template<typename TreeDistanceType,
+           typename TreeStatType,
+           typename TreeMatType>
+  using Tree = TreeType<TreeDistanceType, TreeStatType, TreeMatType>;
+};
+
+/**
+ * Call f(TreeSelector<TreeType>()) for the tree type with the given name
+ * ("kd", "ball" or "cover").  Inside f, the tree type is
+ * `decltype(selector)::template Tree`.
+ *
+ * @param name Name of the tree type.
+ * @param f Function to call.
+ * @return false if the name is not known.
+ */
+template<typename FunctionType>
+bool DispatchTree(const std::string& name, FunctionType f)
+{
+  if (name == "kd")
+    f(TreeSelector<KDTree>());
+  else if (name == "ball")
+    f(TreeSelector<BallTree>());
+  else if (name == "cover")
+    f(TreeSelector<StandardCoverTree>());
+  else
+    return false;
+
+  return true;
+}
+
+/**
+ * Build a tree of the given type on the given dataset, with the given leaf
+ * size if the tree has leaves of several points.
+ *
+ * @param dataset Dataset to build the tree on.
+ * @param leafSize Maximum number of points in a leaf.
+ * @param oldFromNew Vector to store the original index of each point of the
+ *     tree in, if the tree rearranges the dataset (it is left empty
+ *     otherwise).
+ */
+template<typename TreeType>
+TreeType* BuildBenchmarkTree(arma::mat dataset,
+                             const size_t leafSize,
+                             std::vector<size_t>& oldFromNew)
+{
+  if constexpr (TreeTraits<TreeType>::RearrangesDataset)
+  {
+    return new TreeType(std::move(dataset), oldFromNew, leafSize);
+  }
+  else
+  {
+    oldFromNew.clear();
+    return new TreeType(std::move(dataset));
+  }
+}
+
+} // namespace benchmarks
+} // namespace mlpack
+
+#endif
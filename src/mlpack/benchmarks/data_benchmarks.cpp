@@ -0,0 +1,382 @@
+/**
+ * @file benchmarks/data_benchmarks.cpp
+ *
+ * Benchmarks of data loading, saving and preprocessing.  Each benchmark works
+ * on a uniform dataset with the number of points and dimensionality of the
+ * configuration (use large values, like --data_points 10000000, for inputs of
+ * several GB), written to files in the scratch directory; the files are
+ * removed after the benchmark.  The bytes of each run are the size of the
+ * files for loading and saving, and the size of the dataset in memory for
+ * preprocessing.
+ *
+ * Categorical datasets have every other dimension categorical, with 10
+ * categories; datasets with missing values miss 1% of their values.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark_data.hpp"
+
+#include <filesystem>
+
+using namespace mlpack;
+using namespace mlpack::benchmarks;
+
+/**
+ * Files in the scratch directory of a benchmark, which are removed when the
+ * object is destroyed.
+ */
+class ScratchFiles
+{
+ public:
+  ScratchFiles(const BenchmarkConfig& config) :
+      directory(config.scratchDirectory)
+  { }
+
+  ~ScratchFiles()
+  {
+    std::error_code error;
+    for (const std::string& file : files)
+      std::filesystem::remove(file, error);
+  }
+
+  ScratchFiles(const ScratchFiles&) = delete;
+  ScratchFiles& operator=(const ScratchFiles&) = delete;
+
+  //! Add a file with the given name, and return its path.
+  std::string Add(const std::string& name)
+  {
+    files.push_back((std::filesystem::path(directory) /
+        ("mlpack_benchmark_" + name)).string());
+    return files.back();
+  }
+
+  //! Get the paths of the files.
+  const std::vector<std::string>& Files() const { return files; }
+
+  //! Get the total size of the files, in bytes.
+  size_t Bytes() const
+  {
+    size_t bytes = 0;
+    for (const std::string& file : files)
+      bytes += std::filesystem::file_size(file);
+    return bytes;
+  }
+
+ private:
+  //! The scratch directory.
+  std::string directory;
+  //! The paths of the files.
+  std::vector<std::string> files;
+};
+
+// The kinds of text datasets that WriteTextDataset() writes.
+enum TextDatasetKind
+{
+  CATEGORICAL_CSV,
+  CATEGORICAL_ARFF,
+  MISSING_CSV
+};
+
+// The category of a value of a categorical dimension.
+static size_t Category(const double value)
+{
+  return std::min((size_t) (10 * value), (size_t) 9);
+}
+
+/**
+ * Write the given dataset, one point per line, as categorical CSV or ARFF
+ * (where every other dimension is categorical), or as CSV where 1% of the
+ * values are missing ("?").
+ */
+static void WriteTextDataset(const std::string& filename,
+                             const arma::mat& dataset,
+                             const TextDatasetKind kind)
+{
+  std::ofstream stream(filename);
+  if (!stream.is_open())
+    throw std::runtime_error("cannot open '" + filename + "' for writing!");
+
+  if (kind == CATEGORICAL_ARFF)
+  {
+    stream << "@relation benchmark\n";
+    for (size_t r = 0; r < dataset.n_rows; ++r)
+    {
+      stream << "@attribute a" << r << " ";
+      if (r % 2 == 1)
+        stream << "{c0,c1,c2,c3,c4,c5,c6,c7,c8,c9}\n";
+      else
+        stream << "numeric\n";
+    }
+    stream << "@data\n";
+  }
+
+  stream << std::setprecision(10);
+  for (size_t c = 0; c < dataset.n_cols; ++c)
+  {
+    for (size_t r = 0; r < dataset.n_rows; ++r)
+    {
+      if (r > 0)
+        stream << ",";
+
+      if (kind == MISSING_CSV && (r * 7919 + c) % 100 == 0)
+        stream << "?";
+      else if (kind != MISSING_CSV && r % 2 == 1)
+        stream << "c" << Category(dataset(r, c));
+      else
+        stream << dataset(r, c);
+    }
+    stream << "\n";
+  }
+
+  if (!stream.good())
+    throw std::runtime_error("cannot write '" + filename + "'!");
+}
+
+/**
+ * Time data::Save() of the dataset to a file with the given extension (which
+ * gives the format of the file).
+ */
+static void SaveBenchmark(BenchmarkState& state, const std::string& extension)
+{
+  const arma::mat dataset = GenerateDataset(state.Config());
+  ScratchFiles files(state.Config());
+  const std::string file = files.Add("save." + extension);
+
+  state.Measure([&]() { data::Save(file, dataset, true); });
+
+  state.SetItems(dataset.n_cols);
+  state.SetBytes(files.Bytes());
+}
+
+/**
+ * Time data::Load() of the dataset from a file with the given extension
+ * (which gives the format of the file), saved with data::Save().
+ */
+static void LoadBenchmark(BenchmarkState& state, const std::string& extension)
+{
+  ScratchFiles files(state.Config());
+  const std::string file = files.Add("load." + extension);
+  data::Save(file, GenerateDataset(state.Config()), true);
+
+  arma::mat dataset;
+  state.Measure([&]() { data::Load(file, dataset, true); });
+
+  state.SetItems(dataset.n_cols);
+  state.SetBytes(files.Bytes());
+}
+
+/**
+ * Time data::Load() of the dataset written as a text file of the given kind,
+ * with a DatasetInfo to map its categories.
+ */
+static void LoadCategoricalBenchmark(BenchmarkState& state,
+                                     const TextDatasetKind kind)
+{
+  ScratchFiles files(state.Config());
+  const std::string file = files.Add((kind == CATEGORICAL_ARFF) ?
+      "load.arff" : "load.csv");
+  WriteTextDataset(file, GenerateDataset(state.Config()), kind);
+
+  arma::mat dataset;
+  state.Measure([&]()
+  {
+    data::DatasetInfo info;
+    data::Load(file, dataset, info, true);
+  });
+
+  state.SetItems(dataset.n_cols);
+  state.SetBytes(files.Bytes());
+}
+
+static void SaveCSV(BenchmarkState& state) { SaveBenchmark(state, "csv"); }
+static void LoadCSV(BenchmarkState& state) { LoadBenchmark(state, "csv"); }
+
+static void LoadCategoricalCSV(BenchmarkState& state)
+{
+  LoadCategoricalBenchmark(state, CATEGORICAL_CSV);
+}
+
+static void LoadARFF(BenchmarkState& state)
+{
+  LoadCategoricalBenchmark(state, CATEGORICAL_ARFF);
+}
+
+static void SaveArmaBinary(BenchmarkState& state)
+{
+  SaveBenchmark(state, "bin");
+}
+
+static void LoadArmaBinary(BenchmarkState& state)
+{
+  LoadBenchmark(state, "bin");
+}
+
+static void SaveHDF5(BenchmarkState& state)
+{
+  #ifdef ARMA_USE_HDF5
+  SaveBenchmark(state, "h5");
+  #else
+  state.Skip();
+  #endif
+}
+
+static void LoadHDF5(BenchmarkState& state)
+{
+  #ifdef ARMA_USE_HDF5
+  LoadBenchmark(state, "h5");
+  #else
+  state.Skip();
+  #endif
+}
+
+/**
+ * Time data::Save() (if save is true) or data::Load() of 64x64 RGB PNG images
+ * with random pixels; there are as many images as needed to hold as many
+ * values as the dataset (at least one).
+ */
+static void ImageBenchmark(BenchmarkState& state, const bool save)
+{
+  #ifdef MLPACK_HAS_STB
+  const BenchmarkConfig& config = state.Config();
+  data::ImageInfo info(64, 64, 3);
+  const size_t pixels = 64 * 64 * 3;
+  const size_t numImages = std::max(config.points * config.dimensionality /
+      pixels, (size_t) 1);
+
+  arma::mat images(pixels, numImages);
+  BenchmarkRandom random(config.seed);
+  for (size_t i = 0; i < images.n_elem; ++i)
+    images[i] = std::floor(256.0 * random.Uniform());
+
+  ScratchFiles files(config);
+  for (size_t i = 0; i < numImages; ++i)
+    files.Add("image_" + std::to_string(i) + ".png");
+
+  if (save)
+  {
+    state.Measure([&]() { data::Save(files.Files(), images, info, true); });
+  }
+  else
+  {
+    data::Save(files.Files(), images, info, true);
+    state.Measure([&]() { data::Load(files.Files(), images, info, true); });
+  }
+
+  state.SetItems(numImages);
+  state.SetBytes(files.Bytes());
+  #else
+  state.Skip();
+  #endif
+}
+
+static void SaveImages(BenchmarkState& state) { ImageBenchmark(state, true); }
+static void LoadImages(BenchmarkState& state) { ImageBenchmark(state, false); }
+
+/**
+ * Fit a StandardScaler to the dataset and transform it.
+ */
+static void ScaleBenchmark(BenchmarkState& state)
+{
+  const arma::mat dataset = GenerateDataset(state.Config());
+
+  arma::mat output;
+  state.Measure([&]()
+  {
+    data::StandardScaler scaler;
+    scaler.Fit(dataset);
+    scaler.Transform(dataset, output);
+  });
+
+  state.SetItems(dataset.n_cols);
+  state.SetBytes(dataset.n_elem * sizeof(double));
+}
+
+/**
+ * One-hot encode every other dimension of the dataset, which holds the
+ * categories of the values.
+ */
+static void OneHotEncodingBenchmark(BenchmarkState& state)
+{
+  arma::mat dataset = GenerateDataset(state.Config());
+  arma::Col<size_t> indices(dataset.n_rows / 2);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+  {
+    indices[i] = 2 * i + 1;
+    dataset.row(indices[i]).transform([](const double v)
+        { return (double) Category(v); });
+  }
+
+  arma::mat output;
+  state.Measure([&]() { data::OneHotEncoding(dataset, indices, output); });
+
+  state.SetItems(dataset.n_cols);
+  state.SetBytes(dataset.n_elem * sizeof(double));
+}
+
+/**
+ * Replace the missing values of every dimension with the mean of the
+ * dimension.  The dataset is loaded (without timing) from a CSV file with
+ * missing values; as imputation works in place, each run imputes a copy of
+ * it, and the copy is timed too.
+ */
+static void ImputationBenchmark(BenchmarkState& state)
+{
+  using MapperType = data::DatasetMapper<data::MissingPolicy>;
+
+  ScratchFiles files(state.Config());
+  const std::string file = files.Add("impute.csv");
+  WriteTextDataset(file, GenerateDataset(state.Config()), MISSING_CSV);
+
+  arma::mat dataset;
+  data::MissingPolicy policy(std::set<std::string>({ "?" }));
+  MapperType info(policy);
+  data::Load(file, dataset, info, true);
+
+  std::vector<size_t> dimensions(dataset.n_rows);
+  std::iota(dimensions.begin(), dimensions.end(), 0);
+  data::Imputer<double, MapperType, data::MeanImputation<double>> imputer(
+      info);
+
+  arma::mat imputed;
+  state.Measure([&]()
+  {
+    imputed = dataset;
+    imputer.Impute(imputed, "?", dimensions);
+  });
+
+  state.SetItems(dataset.n_cols);
+  state.SetBytes(dataset.n_elem * sizeof(double));
+}
+
+/**
+ * Split the dataset into a shuffled training set and test set, with 20% of
+ * the points in the test set.
+ */
+static void SplitBenchmark(BenchmarkState& state)
+{
+  const arma::mat dataset = GenerateDataset(state.Config());
+
+  arma::mat trainData, testData;
+  state.Measure([&]() { data::Split(dataset, trainData, testData, 0.2); });
+
+  state.SetItems(dataset.n_cols);
+  state.SetBytes(dataset.n_elem * sizeof(double));
+}
+
+MLPACK_DATA_BENCHMARK("data/save_csv", SaveCSV);
+MLPACK_DATA_BENCHMARK("data/load_csv", LoadCSV);
+MLPACK_DATA_BENCHMARK("data/load_categorical_csv", LoadCategoricalCSV);
+MLPACK_DATA_BENCHMARK("data/load_arff", LoadARFF);
+MLPACK_DATA_BENCHMARK("data/save_arma_binary", SaveArmaBinary);
+MLPACK_DATA_BENCHMARK("data/load_arma_binary", LoadArmaBinary);
+MLPACK_DATA_BENCHMARK("data/save_hdf5", SaveHDF5);
+MLPACK_DATA_BENCHMARK("data/load_hdf5", LoadHDF5);
+MLPACK_DATA_BENCHMARK("data/save_images", SaveImages);
+MLPACK_DATA_BENCHMARK("data/load_images", LoadImages);
+MLPACK_DATA_BENCHMARK("preprocess/scale", ScaleBenchmark);
+MLPACK_DATA_BENCHMARK("preprocess/one_hot_encoding", OneHotEncodingBenchmark);
+MLPACK_DATA_BENCHMARK("preprocess/imputation", ImputationBenchmark);
+MLPACK_DATA_BENCHMARK("preprocess/split", SplitBenchmark);
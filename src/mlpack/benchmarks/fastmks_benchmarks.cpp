@@ -0,0 +1,56 @@
+/**
+ * @file benchmarks/fastmks_benchmarks.cpp
+ *
+ * Benchmarks of fast max-kernel search.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark_data.hpp"
+
+#include <mlpack/methods/fastmks.hpp>
+
+using namespace mlpack;
+using namespace mlpack::benchmarks;
+
+/**
+ * Find the 5 points of the dataset with the largest linear kernel value for
+ * every point of the dataset.  FastMKS needs trees built only on points of the
+ * dataset, so only cover trees are benchmarked.  The tree is built before the
+ * search is timed; the items are the query points.
+ */
+static void FastMKSBenchmark(BenchmarkState& state, const bool singleMode)
+{
+  const BenchmarkConfig& config = state.Config();
+  if (config.tree != "cover")
+  {
+    state.Skip();
+    return;
+  }
+
+  const size_t k = 5;
+  FastMKS<LinearKernel> fastmks(GenerateDataset(config), singleMode);
+
+  arma::Mat<size_t> indices;
+  arma::mat kernels;
+  state.Measure([&]() { fastmks.Search(k, indices, kernels); });
+
+  state.SetItems(indices.n_cols);
+  state.SetDistanceEvaluations(fastmks.BaseCases());
+  state.SetScores(fastmks.Scores());
+}
+
+static void FastMKSDualTree(BenchmarkState& state)
+{
+  FastMKSBenchmark(state, false);
+}
+
+static void FastMKSSingleTree(BenchmarkState& state)
+{
+  FastMKSBenchmark(state, true);
+}
+
+MLPACK_BENCHMARK("fastmks/dual_tree", FastMKSDualTree);
+MLPACK_BENCHMARK("fastmks/single_tree", FastMKSSingleTree);
@@ -0,0 +1,67 @@
+/**
+ * @file benchmarks/kde_benchmarks.cpp
+ *
+ * Benchmarks of kernel density estimation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark_data.hpp"
+
+#include <mlpack/methods/kde.hpp>
+
+using namespace mlpack;
+using namespace mlpack::benchmarks;
+
+/**
+ * Estimate the density of every point of the dataset with a Gaussian kernel
+ * whose bandwidth is the radius that holds 10 points on average, and a
+ * relative error of 5%.  The tree is built before the estimation is timed;
+ * the items are the query points.
+ */
+static void KDEBenchmark(BenchmarkState& state, const KDEMode mode)
+{
+  const BenchmarkConfig& config = state.Config();
+
+  DispatchTree(config.tree, [&](auto selector)
+  {
+    using KDEType = KDE<GaussianKernel, EuclideanDistance, arma::mat,
+        decltype(selector)::template Tree>;
+    using TreeType = typename KDEType::Tree;
+
+    std::vector<size_t> oldFromNew;
+    TreeType* tree = BuildBenchmarkTree<TreeType>(GenerateDataset(config),
+        config.leafSize, oldFromNew);
+    const double bandwidth = NeighborhoodRadius(tree->Dataset().n_cols,
+        tree->Dataset().n_rows, 10.0);
+
+    {
+      KDEType kde(0.05, 0.0, GaussianKernel(bandwidth), mode);
+      kde.Train(tree, &oldFromNew);
+
+      arma::vec estimations;
+      state.Measure([&]() { kde.Evaluate(estimations); });
+
+      state.SetItems(estimations.n_elem);
+      state.SetDistanceEvaluations(kde.BaseCases());
+      state.SetScores(kde.Scores());
+    }
+
+    delete tree;
+  });
+}
+
+static void KDEDualTree(BenchmarkState& state)
+{
+  KDEBenchmark(state, KDE_DUAL_TREE_MODE);
+}
+
+static void KDESingleTree(BenchmarkState& state)
+{
+  KDEBenchmark(state, KDE_SINGLE_TREE_MODE);
+}
+
+MLPACK_BENCHMARK("kde/dual_tree", KDEDualTree);
+MLPACK_BENCHMARK("kde/single_tree", KDESingleTree);
@@ -0,0 +1,243 @@
+/**
+ * @file benchmarks/layer_benchmark.hpp
+ *
+ * Helpers for the benchmarks of neural network layers: each layer benchmark
+ * times one pass (forward, backward or gradient) of a layer on a batch of
+ * random inputs, in single or double precision, and reports the number of
+ * floating-point operations of the pass, so that its throughput can be
+ * compared with the throughput of a large matrix multiplication (see
+ * GemmGFlops()).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BENCHMARKS_LAYER_BENCHMARK_HPP
+#define MLPACK_BENCHMARKS_LAYER_BENCHMARK_HPP
+
+#include "benchmark_data.hpp"
+
+#include <mlpack/methods/ann/layer/layer.hpp>
+
+#include <array>
+
+namespace mlpack {
+namespace benchmarks {
+
+//! The passes of a layer that are benchmarked.
+enum LayerPass
+{
+  FORWARD_PASS = 0,
+  BACKWARD_PASS = 1,
+  GRADIENT_PASS = 2
+};
+
+//! The type of the function of a layer benchmark.
+using LayerBenchmarkFunction = std::function<void(BenchmarkState&,
+                                                  const LayerPass)>;
+
+/**
+ * Registers the benchmarks of the forward pass, the backward pass and the
+ * gradient of a layer when constructed, as "<name>/forward",
+ * "<name>/backward" and "<name>/gradient"; see MLPACK_LAYER_BENCHMARK().
+ */
+struct RegisterLayerBenchmark
+{
+  RegisterLayerBenchmark(const std::string& name,
+                         LayerBenchmarkFunction function)
+  {
+    const char* passNames[] = { "forward", "backward", "gradient" };
+    for (size_t i = 0; i < 3; ++i)
+    {
+      const LayerPass pass = (LayerPass) i;
+      RegisterBenchmark(name + "/" + passNames[i],
+          [function, pass](BenchmarkState& state) { function(state, pass); },
+          LAYER_SWEEP);
+    }
+  }
+};
+
+/**
+ * Call f(MatType()) with the matrix type of the given precision ("double" or
+ * "float").  Inside f, the matrix type is `decltype(matrix)`.
+ *
+ * @param precision Name of the precision.
+ * @param f Function to call.
+ * @return false if the name is not known.
+ */
+template<typename FunctionType>
+bool DispatchPrecision(const std::string& precision, FunctionType f)
+{
+  if (precision == "double")
+    f(arma::mat());
+  else if (precision == "float")
+    f(arma::fmat());
+  else
+    return false;
+
+  return true;
+}
+
+/**
+ * Fill the given matrix with numbers uniformly distributed in [-scale, scale).
+ *
+ * @param matrix Matrix to fill.
+ * @param random Source of random numbers.
+ * @param scale Largest absolute value of the numbers.
+ */
+template<typename MatType>
+void RandomFill(MatType& matrix,
+                BenchmarkRandom& random,
+                const double scale = 1.0)
+{
+  using ElemType = typename MatType::elem_type;
+  for (size_t i = 0; i < matrix.n_elem; ++i)
+    matrix[i] = (ElemType) (scale * (2.0 * random.Uniform() - 1.0));
+}
+
+/**
+ * Set up the given layer for inputs of the given dimensions, with small random
+ * weights, in training mode.
+ *
+ * @param layer Layer to set up.
+ * @param inputDimensions Dimensions of each input point of the layer.
+ * @param random Source of random numbers.
+ * @param weights Matrix to store the weights of the layer in; it has to live
+ *     as long as the layer is used.
+ */
+template<typename MatType>
+void InitializeLayer(Layer<MatType>& layer,
+                     const std::vector<size_t>& inputDimensions,
+                     BenchmarkRandom& random,
+                     MatType& weights)
+{
+  layer.Training() = true;
+  layer.InputDimensions() = inputDimensions;
+  layer.ComputeOutputDimensions();
+
+  weights.set_size(layer.WeightSize(), 1);
+  RandomFill(weights, random, 0.1);
+  layer.CustomInitialize(weights, weights.n_elem);
+  layer.SetWeights(weights);
+}
+
+/**
+ * Time the given pass of the given layer, which has no recurrent state, on a
+ * batch of random inputs of the batch size of the configuration.  The backward
+ * pass and the gradient are timed after a forward pass (and, for the gradient,
+ * a backward pass) on the same batch.  The items are the points of the batch.
+ *
+ * @param state State of the benchmark.
+ * @param layer Layer to benchmark.
+ * @param inputDimensions Dimensions of each input point of the layer.
+ * @param pass Pass to time.
+ * @param flops Number of floating-point operations of each pass, for a batch
+ *     of one point, in the order forward, backward, gradient.
+ */
+template<typename MatType>
+void MeasureLayer(BenchmarkState& state,
+                  Layer<MatType>& layer,
+                  const std::vector<size_t>& inputDimensions,
+                  const LayerPass pass,
+                  const std::array<size_t, 3>& flops)
+{
+  const size_t batchSize = state.Config().batchSize;
+  BenchmarkRandom random(state.Config().seed);
+
+  MatType weights;
+  InitializeLayer(layer, inputDimensions, random, weights);
+
+  // Layers without weights have no gradient.
+  if (pass == GRADIENT_PASS && weights.n_elem == 0)
+  {
+    state.Skip();
+    return;
+  }
+
+  const size_t inputSize = std::accumulate(inputDimensions.begin(),
+      inputDimensions.end(), (size_t) 1, std::multiplies<size_t>());
+  MatType input(inputSize, batchSize);
+  RandomFill(input, random);
+  MatType output(layer.OutputSize(), batchSize);
+  MatType gy(layer.OutputSize(), batchSize);
+  RandomFill(gy, random);
+  MatType g(inputSize, batchSize);
+  MatType gradient(weights.n_elem, 1);
+
+  if (pass == FORWARD_PASS)
+  {
+    state.Measure([&]() { layer.Forward(input, output); });
+  }
+  else if (pass == BACKWARD_PASS)
+  {
+    layer.Forward(input, output);
+    state.Measure([&]() { layer.Backward(input, output, gy, g); });
+  }
+  else
+  {
+    layer.Forward(input, output);
+    layer.Backward(input, output, gy, g);
+    state.Measure([&]() { layer.Gradient(input, gy, gradient); });
+  }
+
+  state.SetItems(batchSize);
+  state.SetFlops(flops[pass] * batchSize);
+}
+
+/**
+ * Get the throughput, in GFLOP/s, of the multiplication of two square
+ * matrices of the given precision and size with the given number of threads.
+ * This is the practical peak of the machine that the throughput of the layers
+ * is compared with.
+ *
+ * @param precision Precision of the matrices ("double" or "float").
+ * @param threads Number of threads; 0 uses one thread per processor.
+ * @param repetitions Number of timed multiplications (the fastest is used).
+ * @param size Number of rows and columns of the matrices.
+ */
+inline double GemmGFlops(const std::string& precision,
+                         const size_t threads,
+                         const size_t repetitions,
+                         const size_t size = 1024)
+{
+  double best = 0.0;
+  DispatchPrecision(precision, [&](auto matrix)
+  {
+    using MatType = decltype(matrix);
+
+    BenchmarkRandom random(size);
+    MatType a(size, size), b(size, size), c(size, size);
+    RandomFill(a, random);
+    RandomFill(b, random);
+
+    ScopedThreads scopedThreads(threads);
+    c = a * b;
+    for (size_t i = 0; i < std::max(repetitions, (size_t) 3); ++i)
+    {
+      const std::chrono::steady_clock::time_point start =
+          std::chrono::steady_clock::now();
+      c = a * b;
+      const double time = std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - start).count();
+      best = std::max(best, 2.0 * size * size * size / time / 1e9);
+    }
+  });
+
+  return best;
+}
+
+} // namespace benchmarks
+} // namespace mlpack
+
+/**
+ * Register the benchmarks of the forward pass, the backward pass and the
+ * gradient of a layer, with the given name prefix (for instance "ann/linear")
+ * and the given function, which takes the state of the benchmark and the pass
+ * to time.
+ */
+#define MLPACK_LAYER_BENCHMARK(NAME, FUNCTION) \
+    static mlpack::benchmarks::RegisterLayerBenchmark FUNCTION##Registration( \
+        NAME, FUNCTION)
+
+#endif
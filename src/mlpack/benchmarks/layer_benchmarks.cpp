@@ -0,0 +1,255 @@
+/**
+ * @file benchmarks/layer_benchmarks.cpp
+ *
+ * Benchmarks of the forward pass, backward pass and gradient of the most used
+ * neural network layers.  The layers have fixed sizes, typical of small
+ * networks:
+ *
+ *  - "ann/linear": 512 inputs and 512 outputs;
+ *  - "ann/convolution_<rule>": 3x3 filters from 16 maps of 32x32 to 16 maps,
+ *    with each convolution rule (naive, fft, svd, im2col and winograd) for all
+ *    three passes;
+ *  - "ann/max_pooling": 2x2 pooling with stride 2 of 16 maps of 32x32;
+ *  - "ann/batch_norm": normalization of 16 maps of 32x32;
+ *  - "ann/lstm": 256 inputs and 256 outputs, for one step that follows
+ *    (forward) or precedes (backward) another step of the sequence;
+ *  - "ann/multihead_attention": self-attention with 8 heads over sequences of
+ *    32 embeddings of 128 dimensions.
+ *
+ * The number of floating-point operations is the nominal count of the matrix
+ * products of each pass (a multiply-add counts as two operations), so that the
+ * convolution rules are compared on the same work; for the pooling and the
+ * normalization, which have no products, it is the approximate number of
+ * element-wise operations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "layer_benchmark.hpp"
+
+#include <mlpack/methods/ann.hpp>
+
+using namespace mlpack;
+using namespace mlpack::benchmarks;
+
+static void LinearBenchmark(BenchmarkState& state, const LayerPass pass)
+{
+  const size_t inSize = 512;
+  const size_t outSize = 512;
+  const size_t flops = 2 * inSize * outSize;
+
+  DispatchPrecision(state.Config().precision, [&](auto matrix)
+  {
+    using MatType = decltype(matrix);
+
+    LinearType<MatType, NoRegularizer> layer(outSize);
+    MeasureLayer(state, layer, { inSize }, pass, { flops, flops, flops });
+  });
+}
+
+/**
+ * Benchmark a convolution layer with the given rules for the forward pass, the
+ * backward pass and the gradient.
+ */
+template<typename ForwardRule, typename BackwardRule, typename GradientRule>
+static void ConvolutionBenchmark(BenchmarkState& state, const LayerPass pass)
+{
+  const size_t size = 32;
+  const size_t inMaps = 16;
+  const size_t outMaps = 16;
+  const size_t kernelSize = 3;
+  const size_t outputSize = size - kernelSize + 1;
+  const size_t flops = 2 * inMaps * outMaps * kernelSize * kernelSize *
+      outputSize * outputSize;
+
+  DispatchPrecision(state.Config().precision, [&](auto matrix)
+  {
+    using MatType = decltype(matrix);
+
+    ConvolutionType<ForwardRule, BackwardRule, GradientRule, MatType> layer(
+        outMaps, kernelSize, kernelSize);
+    MeasureLayer(state, layer, { size, size, inMaps }, pass,
+        { flops, flops, flops });
+  });
+}
+
+static void NaiveConvolutionBenchmark(BenchmarkState& state,
+                                      const LayerPass pass)
+{
+  ConvolutionBenchmark<NaiveConvolution<ValidConvolution>,
+      NaiveConvolution<FullConvolution>,
+      NaiveConvolution<ValidConvolution>>(state, pass);
+}
+
+static void FFTConvolutionBenchmark(BenchmarkState& state,
+                                    const LayerPass pass)
+{
+  ConvolutionBenchmark<FFTConvolution<ValidConvolution>,
+      FFTConvolution<FullConvolution>,
+      FFTConvolution<ValidConvolution>>(state, pass);
+}
+
+static void SVDConvolutionBenchmark(BenchmarkState& state,
+                                    const LayerPass pass)
+{
+  ConvolutionBenchmark<SVDConvolution<ValidConvolution>,
+      SVDConvolution<FullConvolution>,
+      SVDConvolution<ValidConvolution>>(state, pass);
+}
+
+static void Im2ColConvolutionBenchmark(BenchmarkState& state,
+                                       const LayerPass pass)
+{
+  ConvolutionBenchmark<Im2ColConvolution<ValidConvolution>,
+      Im2ColConvolution<FullConvolution>,
+      Im2ColConvolution<ValidConvolution>>(state, pass);
+}
+
+static void WinogradConvolutionBenchmark(BenchmarkState& state,
+                                         const LayerPass pass)
+{
+  ConvolutionBenchmark<WinogradConvolution<ValidConvolution>,
+      WinogradConvolution<FullConvolution>,
+      WinogradConvolution<ValidConvolution>>(state, pass);
+}
+
+static void MaxPoolingBenchmark(BenchmarkState& state, const LayerPass pass)
+{
+  const size_t size = 32;
+  const size_t maps = 16;
+  const size_t outputElements = (size / 2) * (size / 2) * maps;
+
+  DispatchPrecision(state.Config().precision, [&](auto matrix)
+  {
+    using MatType = decltype(matrix);
+
+    // Each output is the maximum of 4 inputs, and the backward pass routes
+    // each error to one input.
+    MaxPoolingType<MatType> layer(2, 2, 2, 2);
+    MeasureLayer(state, layer, { size, size, maps }, pass,
+        { 4 * outputElements, outputElements, 0 });
+  });
+}
+
+static void BatchNormBenchmark(BenchmarkState& state, const LayerPass pass)
+{
+  const size_t size = 32;
+  const size_t maps = 16;
+  const size_t elements = size * size * maps;
+
+  DispatchPrecision(state.Config().precision, [&](auto matrix)
+  {
+    using MatType = decltype(matrix);
+
+    // The forward pass computes the mean and the variance of each map, and
+    // then normalizes, scales and shifts each element; the backward pass and
+    // the gradient reduce over the elements again.
+    BatchNormType<MatType> layer;
+    MeasureLayer(state, layer, { size, size, maps }, pass,
+        { 7 * elements, 10 * elements, 4 * elements });
+  });
+}
+
+/**
+ * The LSTM keeps the state of the previous steps, so it is timed on the second
+ * of two steps in the forward pass, and on the first of two steps in the
+ * backward pass and the gradient, as an RNN would call it.
+ */
+static void LSTMBenchmark(BenchmarkState& state, const LayerPass pass)
+{
+  const size_t inSize = 256;
+  const size_t outSize = 256;
+  const size_t batchSize = state.Config().batchSize;
+  // The four gates multiply the input and the previous output by their
+  // weights; the errors and the gradient take the same products.
+  const size_t flops = 2 * 4 * outSize * (inSize + outSize);
+
+  DispatchPrecision(state.Config().precision, [&](auto matrix)
+  {
+    using MatType = decltype(matrix);
+
+    BenchmarkRandom random(state.Config().seed);
+    LSTMType<MatType> layer(outSize);
+    MatType weights;
+    InitializeLayer(layer, { inSize }, random, weights);
+    layer.ClearRecurrentState(2, batchSize);
+
+    MatType input(inSize, batchSize);
+    RandomFill(input, random);
+    MatType firstOutput(outSize, batchSize), secondOutput(outSize, batchSize);
+    MatType gy(outSize, batchSize);
+    RandomFill(gy, random);
+    MatType g(inSize, batchSize);
+    MatType gradient(weights.n_elem, 1);
+
+    layer.PreviousStep() = size_t(-1);
+    layer.CurrentStep() = 0;
+    layer.Forward(input, firstOutput);
+    layer.PreviousStep() = 0;
+    layer.CurrentStep() = 1;
+    if (pass == FORWARD_PASS)
+    {
+      state.Measure([&]() { layer.Forward(input, secondOutput); });
+    }
+    else
+    {
+      layer.Forward(input, secondOutput);
+
+      layer.PreviousStep() = size_t(-1);
+      layer.Backward(input, secondOutput, gy, g);
+      layer.PreviousStep() = 1;
+      layer.CurrentStep() = 0;
+      if (pass == BACKWARD_PASS)
+      {
+        state.Measure([&]() { layer.Backward(input, firstOutput, gy, g); });
+      }
+      else
+      {
+        layer.Backward(input, firstOutput, gy, g);
+        state.Measure([&]() { layer.Gradient(input, gy, gradient); });
+      }
+    }
+
+    state.SetItems(batchSize);
+    state.SetFlops(flops * batchSize);
+  });
+}
+
+static void MultiheadAttentionBenchmark(BenchmarkState& state,
+                                        const LayerPass pass)
+{
+  const size_t embedDim = 128;
+  const size_t seqLen = 32;
+  const size_t numHeads = 8;
+  // The projections of the queries, keys, values and outputs, and the two
+  // products of the attention: the scores and their weighted sum of the
+  // values.  The backward pass takes the products of the projections once and
+  // those of the attention twice; the gradient only those of the projections.
+  const size_t projections = 4 * 2 * embedDim * embedDim * seqLen;
+  const size_t attention = 2 * 2 * seqLen * seqLen * embedDim;
+
+  DispatchPrecision(state.Config().precision, [&](auto matrix)
+  {
+    using MatType = decltype(matrix);
+
+    MultiheadAttentionType<MatType, NoRegularizer> layer(seqLen, numHeads,
+        MatType(), MatType(), true);
+    MeasureLayer(state, layer, { embedDim, seqLen }, pass,
+        { projections + attention, projections + 2 * attention,
+          projections });
+  });
+}
+
+MLPACK_LAYER_BENCHMARK("ann/linear", LinearBenchmark);
+MLPACK_LAYER_BENCHMARK("ann/convolution_naive", NaiveConvolutionBenchmark);
+MLPACK_LAYER_BENCHMARK("ann/convolution_fft", FFTConvolutionBenchmark);
+MLPACK_LAYER_BENCHMARK("ann/convolution_svd", SVDConvolutionBenchmark);
+MLPACK_LAYER_BENCHMARK("ann/convolution_im2col", Im2ColConvolutionBenchmark);
+MLPACK_LAYER_BENCHMARK("ann/convolution_winograd",
+    WinogradConvolutionBenchmark);
+MLPACK_LAYER_BENCHMARK("ann/max_pooling", MaxPoolingBenchmark);
+MLPACK_LAYER_BENCHMARK("ann/batch_norm", BatchNormBenchmark);
+MLPACK_LAYER_BENCHMARK("ann/lstm", LSTMBenchmark);
+MLPACK_LAYER_BENCHMARK("ann/multihead_attention", MultiheadAttentionBenchmark);
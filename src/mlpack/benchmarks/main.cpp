@@ -0,0 +1,575 @@
+/**
+ * @file benchmarks/main.cpp
+ *
+ * Driver of mlpack_benchmarks: run every registered benchmark whose name
+ * matches the filter, for every combination of the given datasets, tree types,
+ * leaf sizes, dimensionalities, numbers of points and numbers of threads (or,
+ * for benchmarks of layers, of the given batch sizes, precisions and numbers
+ * of threads, and for benchmarks of data loading and preprocessing, of the
+ * given data sizes and numbers of threads), and print the results as JSON (or
+ * CSV).
+ *
+ * For example,
+ *
+ * @code
+ * mlpack_benchmarks --filter knn --trees kd,ball --leaf_sizes 10,20,40 \
+ *     --threads 1,4 --output knn.json
+ * mlpack_benchmarks --filter ann/convolution --batch_sizes 1,64 \
+ *     --precisions float --format csv
+ * @endcode
+ *
+ * Run `mlpack_benchmarks --help` for all options.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "layer_benchmark.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+using namespace mlpack;
+using namespace mlpack::benchmarks;
+
+// The options of the driver.
+struct BenchmarkOptions
+{
+  std::string filter;
+  std::vector<std::string> datasets = { "uniform", "manifold" };
+  std::vector<std::string> trees = { "kd", "ball", "cover" };
+  std::vector<size_t> leafSizes = { 20 };
+  std::vector<size_t> dimensions = { 3, 10 };
+  std::vector<size_t> points = { 20000 };
+  std::vector<size_t> threads = { 1 };
+  std::vector<size_t> batchSizes = { 1, 32, 256 };
+  std::vector<std::string> precisions = { "double", "float" };
+  std::vector<size_t> dataPoints = { 1000000 };
+  std::vector<size_t> dataDimensions = { 10 };
+  std::string scratchDirectory;
+  size_t repetitions = 5;
+  size_t warmups = 1;
+  size_t seed = 42;
+  std::string format = "json";
+  std::string output;
+  bool list = false;
+};
+
+// The results of a run of a benchmark.
+struct BenchmarkResult
+{
+  std::string name;
+  BenchmarkConfig config;
+  std::vector<double> times;
+  size_t items;
+  size_t distanceEvaluations;
+  size_t scores;
+  size_t flops;
+  // The throughput of a large matrix multiplication with the precision and
+  // the number of threads of a layer benchmark (0 for other benchmarks).
+  double gemmGFlops;
+  size_t bytes;
+  size_t peakResidentMemory;
+};
+
+static void PrintUsage(std::ostream& stream)
+{
+  stream << "Usage: mlpack_benchmarks [options]\n"
+      << "\n"
+      << "Lists take comma-separated values; for numbers, the defaults are\n"
+      << "given in parentheses.\n"
+      << "\n"
+      << "  --filter <text>         Run only benchmarks whose name contains\n"
+      << "                          the text.\n"
+      << "  --datasets <list>       Datasets: uniform, clustered, manifold,\n"
+      << "                          or names of files (uniform,manifold).\n"
+      << "  --trees <list>          Tree types: kd, ball, cover (all).\n"
+      << "  --leaf_sizes <list>     Leaf sizes; cover trees ignore them (20).\n"
+      << "  --dimensions <list>     Dimensionalities of synthetic datasets\n"
+      << "                          (3,10).\n"
+      << "  --points <list>         Numbers of points of synthetic datasets\n"
+      << "                          (20000).\n"
+      << "  --threads <list>        Numbers of threads; 0 uses one thread per\n"
+      << "                          processor (1).\n"
+      << "  --batch_sizes <list>    Batch sizes of layer benchmarks\n"
+      << "                          (1,32,256).\n"
+      << "  --precisions <list>     Precisions of layer benchmarks: double,\n"
+      << "                          float (all).\n"
+      << "  --data_points <list>    Numbers of points of data benchmarks\n"
+      << "                          (1000000).\n"
+      << "  --data_dimensions <list> Dimensionalities of data benchmarks\n"
+      << "                          (10).\n"
+      << "  --scratch <dir>         Directory for the files of data\n"
+      << "                          benchmarks (the temporary directory).\n"
+      << "  --repetitions <n>       Timed repetitions of each run (5).\n"
+      << "  --warmups <n>           Untimed repetitions before them (1).\n"
+      << "  --seed <n>              Seed of synthetic datasets (42).\n"
+      << "  --format <json|csv>     Output format (json).\n"
+      << "  --output <file>         File to write the results to (stdout).\n"
+      << "  --list                  List the benchmarks and exit.\n"
+      << "  --help                  Print this message and exit.\n";
+}
+
+// Split a comma-separated list.
+static std::vector<std::string> SplitList(const std::string& list)
+{
+  std::vector<std::string> values;
+  std::istringstream stream(list);
+  std::string value;
+  while (std::getline(stream, value, ','))
+  {
+    if (!value.empty())
+      values.push_back(value);
+  }
+
+  return values;
+}
+
+// Parse a non-negative number, or throw a std::invalid_argument.
+static size_t ParseNumber(const std::string& option, const std::string& value)
+{
+  size_t end = 0;
+  long long number = -1;
+  try
+  {
+    number = std::stoll(value, &end);
+  }
+  catch (const std::exception&)
+  {
+    end = 0;
+  }
+
+  if (end != value.size() || number < 0)
+  {
+    throw std::invalid_argument("invalid value '" + value + "' for option "
+        "--" + option + "!");
+  }
+
+  return (size_t) number;
+}
+
+static std::vector<size_t> ParseNumbers(const std::string& option,
+                                        const std::string& list)
+{
+  std::vector<size_t> numbers;
+  for (const std::string& value : SplitList(list))
+    numbers.push_back(ParseNumber(option, value));
+
+  if (numbers.empty())
+  {
+    throw std::invalid_argument("option --" + option + " needs at least one "
+        "value!");
+  }
+
+  return numbers;
+}
+
+// Parse the command line; returns false if the program should exit.
+static bool ParseOptions(int argc, char** argv, BenchmarkOptions& options)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h")
+    {
+      PrintUsage(std::cout);
+      return false;
+    }
+    else if (arg == "--list")
+    {
+      options.list = true;
+      continue;
+    }
+    else if (arg.substr(0, 2) != "--" || i + 1 == argc)
+    {
+      throw std::invalid_argument("unknown or incomplete option '" + arg +
+          "'!");
+    }
+
+    const std::string option = arg.substr(2);
+    const std::string value = argv[++i];
+    if (option == "filter")
+      options.filter = value;
+    else if (option == "datasets")
+      options.datasets = SplitList(value);
+    else if (option == "trees")
+      options.trees = SplitList(value);
+    else if (option == "leaf_sizes")
+      options.leafSizes = ParseNumbers(option, value);
+    else if (option == "dimensions")
+      options.dimensions = ParseNumbers(option, value);
+    else if (option == "points")
+      options.points = ParseNumbers(option, value);
+    else if (option == "threads")
+      options.threads = ParseNumbers(option, value);
+    else if (option == "batch_sizes")
+      options.batchSizes = ParseNumbers(option, value);
+    else if (option == "precisions")
+      options.precisions = SplitList(value);
+    else if (option == "data_points")
+      options.dataPoints = ParseNumbers(option, value);
+    else if (option == "data_dimensions")
+      options.dataDimensions = ParseNumbers(option, value);
+    else if (option == "scratch")
+      options.scratchDirectory = value;
+    else if (option == "repetitions")
+      options.repetitions = ParseNumber(option, value);
+    else if (option == "warmups")
+      options.warmups = ParseNumber(option, value);
+    else if (option == "seed")
+      options.seed = ParseNumber(option, value);
+    else if (option == "format")
+      options.format = value;
+    else if (option == "output")
+      options.output = value;
+    else
+      throw std::invalid_argument("unknown option '" + arg + "'!");
+  }
+
+  for (const std::string& tree : options.trees)
+  {
+    if (!DispatchTree(tree, [](auto /* selector */) { }))
+      throw std::invalid_argument("unknown tree type '" + tree + "'!");
+  }
+
+  for (const std::string& precision : options.precisions)
+  {
+    if (!DispatchPrecision(precision, [](auto /* matrix */) { }))
+      throw std::invalid_argument("unknown precision '" + precision + "'!");
+  }
+
+  if (std::find(options.batchSizes.begin(), options.batchSizes.end(), 0) !=
+      options.batchSizes.end())
+  {
+    throw std::invalid_argument("batch sizes must be positive!");
+  }
+
+  if (options.format != "json" && options.format != "csv")
+  {
+    throw std::invalid_argument("unknown format '" + options.format + "'; use "
+        "json or csv!");
+  }
+
+  if (options.repetitions == 0)
+    throw std::invalid_argument("--repetitions must be positive!");
+
+  if (options.scratchDirectory.empty())
+  {
+    std::error_code error;
+    options.scratchDirectory =
+        std::filesystem::temp_directory_path(error).string();
+    if (error)
+      options.scratchDirectory = ".";
+  }
+
+  return true;
+}
+
+// Escape a string for JSON.
+static std::string Escape(const std::string& s)
+{
+  std::string result;
+  for (const char c : s)
+  {
+    if (c == '"' || c == '\\')
+      result += '\\';
+    if ((unsigned char) c >= 0x20)
+      result += c;
+  }
+
+  return result;
+}
+
+// Quote a string for CSV.
+static std::string QuoteCSV(const std::string& s)
+{
+  std::string result = "\"";
+  for (const char c : s)
+    result += (c == '"') ? std::string("\"\"") : std::string(1, c);
+
+  return result + "\"";
+}
+
+static void WriteJSON(std::ostream& stream,
+                      const BenchmarkOptions& options,
+                      const std::vector<BenchmarkResult>& results)
+{
+  stream << std::setprecision(9);
+  stream << "{\n  \"context\": {\"mlpack_version\": \""
+      << Escape(util::GetVersion()) << "\", \"seed\": " << options.seed
+      << ", \"repetitions\": " << options.repetitions << ", \"warmups\": "
+      << options.warmups << ", \"max_threads\": " << Threads() << "},\n"
+      << "  \"benchmarks\": [";
+
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    const BenchmarkResult& r = results[i];
+    std::vector<double> times = r.times;
+    std::sort(times.begin(), times.end());
+    const double median = times[times.size() / 2];
+    const double mean = std::accumulate(times.begin(), times.end(), 0.0) /
+        times.size();
+
+    stream << ((i == 0) ? "\n" : ",\n") << "    {\"name\": \""
+        << Escape(r.name) << "\", \"dataset\": \"" << Escape(r.config.dataset)
+        << "\", \"tree\": \"" << r.config.tree << "\", \"leaf_size\": "
+        << r.config.leafSize << ", \"points\": " << r.config.points
+        << ", \"dimensionality\": " << r.config.dimensionality
+        << ", \"threads\": "
+        << r.config.threads << ", \"min_time\": " << times.front()
+        << ", \"median_time\": " << median << ", \"mean_time\": " << mean
+        << ", \"max_time\": " << times.back() << ", \"items\": " << r.items
+        << ", \"items_per_second\": " << (r.items / median)
+        << ", \"distance_evaluations\": " << r.distanceEvaluations
+        << ", \"scores\": " << r.scores << ", \"batch_size\": "
+        << r.config.batchSize << ", \"precision\": \"" << r.config.precision
+        << "\", \"flops\": " << r.flops << ", \"gflops_per_second\": "
+        << (r.flops / median / 1e9) << ", \"gemm_gflops_per_second\": "
+        << r.gemmGFlops << ", \"bytes\": " << r.bytes
+        << ", \"megabytes_per_second\": " << (r.bytes / median / 1e6)
+        << ", \"peak_rss\": " << r.peakResidentMemory << "}";
+  }
+
+  stream << "\n  ]\n}" << std::endl;
+}
+
+static void WriteCSV(std::ostream& stream,
+                     const std::vector<BenchmarkResult>& results)
+{
+  stream << std::setprecision(9);
+  stream << "name,dataset,tree,leaf_size,points,dimensionality,threads,"
+      << "min_time,median_time,mean_time,max_time,items,items_per_second,"
+      << "distance_evaluations,scores,batch_size,precision,flops,"
+      << "gflops_per_second,gemm_gflops_per_second,bytes,"
+      << "megabytes_per_second,peak_rss" << std::endl;
+
+  for (const BenchmarkResult& r : results)
+  {
+    std::vector<double> times = r.times;
+    std::sort(times.begin(), times.end());
+    const double median = times[times.size() / 2];
+    const double mean = std::accumulate(times.begin(), times.end(), 0.0) /
+        times.size();
+
+    stream << r.name << "," << QuoteCSV(r.config.dataset) << ","
+        << r.config.tree << "," << r.config.leafSize << ","
+        << r.config.points << "," << r.config.dimensionality << ","
+        << r.config.threads << "," << times.front()
+        << "," << median << "," << mean << "," << times.back() << ","
+        << r.items << "," << (r.items / median) << ","
+        << r.distanceEvaluations << "," << r.scores << ","
+        << r.config.batchSize << "," << r.config.precision << "," << r.flops
+        << "," << (r.flops / median / 1e9) << "," << r.gemmGFlops << ","
+        << r.bytes << "," << (r.bytes / median / 1e6) << ","
+        << r.peakResidentMemory << std::endl;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  BenchmarkOptions options;
+  try
+  {
+    if (!ParseOptions(argc, argv, options))
+      return 0;
+  }
+  catch (const std::invalid_argument& e)
+  {
+    std::cerr << "mlpack_benchmarks: " << e.what() << std::endl;
+    PrintUsage(std::cerr);
+    return 1;
+  }
+
+  if (options.list)
+  {
+    for (const Benchmark& benchmark : Benchmarks())
+      std::cout << benchmark.name << std::endl;
+    return 0;
+  }
+
+  // The throughput of matrix multiplication is only measured once for each
+  // precision and number of threads.
+  std::map<std::pair<std::string, size_t>, double> gemmGFlops;
+
+  std::vector<BenchmarkResult> results;
+  for (const Benchmark& benchmark : Benchmarks())
+  {
+    if (benchmark.name.find(options.filter) == std::string::npos)
+      continue;
+
+    // Run the benchmark with the given configuration, and store its results;
+    // returns false if the benchmark failed.
+    auto run = [&](const BenchmarkConfig& config)
+    {
+      BenchmarkState state(config, options.repetitions, options.warmups);
+      try
+      {
+        benchmark.function(state);
+      }
+      catch (const std::exception& e)
+      {
+        std::cerr << "mlpack_benchmarks: " << benchmark.name << " failed: "
+            << e.what() << std::endl;
+        return false;
+      }
+
+      if (state.Skipped() || state.Times().empty())
+        return true;
+
+      BenchmarkResult result;
+      result.name = benchmark.name;
+      result.config = config;
+      result.times = state.Times();
+      result.items = state.Items();
+      result.distanceEvaluations = state.DistanceEvaluations();
+      result.scores = state.Scores();
+      result.flops = state.Flops();
+      result.bytes = state.Bytes();
+      result.peakResidentMemory = state.PeakResidentMemory();
+      result.gemmGFlops = 0.0;
+      if (benchmark.sweep == LAYER_SWEEP)
+      {
+        const std::pair<std::string, size_t> key(config.precision,
+            config.threads);
+        if (gemmGFlops.count(key) == 0)
+        {
+          gemmGFlops[key] = GemmGFlops(config.precision, config.threads,
+              options.repetitions);
+        }
+
+        result.gemmGFlops = gemmGFlops[key];
+      }
+
+      results.push_back(result);
+      return true;
+    };
+
+    if (benchmark.sweep == LAYER_SWEEP)
+    {
+      for (const std::string& precision : options.precisions)
+      for (const size_t batchSize : options.batchSizes)
+      for (const size_t threads : options.threads)
+      {
+        BenchmarkConfig config;
+        config.points = 0;
+        config.dimensionality = 0;
+        config.leafSize = 0;
+        config.threads = threads;
+        config.seed = options.seed;
+        config.batchSize = batchSize;
+        config.precision = precision;
+
+        std::cerr << "Running " << benchmark.name << " (" << precision
+            << ", batch size " << batchSize << ", " << threads
+            << " threads)..." << std::endl;
+        if (!run(config))
+          return 1;
+      }
+
+      continue;
+    }
+
+    if (benchmark.sweep == DATA_SWEEP)
+    {
+      for (const size_t n : options.dataPoints)
+      for (const size_t d : options.dataDimensions)
+      for (const size_t threads : options.threads)
+      {
+        BenchmarkConfig config;
+        config.dataset = "uniform";
+        config.points = n;
+        config.dimensionality = d;
+        config.leafSize = 0;
+        config.threads = threads;
+        config.seed = options.seed;
+        config.batchSize = 0;
+        config.scratchDirectory = options.scratchDirectory;
+
+        std::cerr << "Running " << benchmark.name << " (" << n << " points, "
+            << d << " dimensions, " << threads << " threads)..."
+            << std::endl;
+        if (!run(config))
+          return 1;
+      }
+
+      continue;
+    }
+
+    for (const std::string& dataset : options.datasets)
+    {
+      // The sizes of a dataset loaded from a file are those of the file.
+      std::vector<size_t> points = options.points;
+      std::vector<size_t> dimensions = options.dimensions;
+      if (dataset != "uniform" && dataset != "clustered" &&
+          dataset != "manifold")
+      {
+        BenchmarkConfig config;
+        config.dataset = dataset;
+        try
+        {
+          const arma::mat data = GenerateDataset(config);
+          points.assign(1, data.n_cols);
+          dimensions.assign(1, data.n_rows);
+        }
+        catch (const std::exception& e)
+        {
+          std::cerr << "mlpack_benchmarks: " << e.what() << std::endl;
+          return 1;
+        }
+      }
+
+      for (const size_t n : points)
+      for (const size_t d : dimensions)
+      for (const std::string& tree : options.trees)
+      for (const size_t leafSize : options.leafSizes)
+      {
+        // Cover trees have no leaf size, so they are run only once.
+        if (tree == "cover" && leafSize != options.leafSizes[0])
+          continue;
+
+        for (const size_t threads : options.threads)
+        {
+          BenchmarkConfig config;
+          config.dataset = dataset;
+          config.tree = tree;
+          config.points = n;
+          config.dimensionality = d;
+          config.leafSize = (tree == "cover") ? 0 : leafSize;
+          config.threads = threads;
+          config.seed = options.seed;
+          config.batchSize = 0;
+
+          std::cerr << "Running " << benchmark.name << " (" << dataset
+              << ", " << tree << " tree, leaf size " << config.leafSize
+              << ", " << n << " points, " << d << " dimensions, " << threads
+              << " threads)..." << std::endl;
+          if (!run(config))
+            return 1;
+        }
+      }
+    }
+  }
+
+  std::ofstream file;
+  if (!options.output.empty())
+  {
+    file.open(options.output);
+    if (!file.is_open())
+    {
+      std::cerr << "mlpack_benchmarks: cannot open '" << options.output
+          << "' for writing!" << std::endl;
+      return 1;
+    }
+  }
+
+  std::ostream& stream = options.output.empty() ? std::cout : file;
+  if (options.format == "json")
+    WriteJSON(stream, options, results);
+  else
+    WriteCSV(stream, results);
+
+  return 0;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file benchmarks/neighbor_search_benchmarks.cpp
+ *
+ * Benchmarks of k-nearest-neighbor search.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark_data.hpp"
+
+#include <mlpack/methods/neighbor_search.hpp>
+
+using namespace mlpack;
+using namespace mlpack::benchmarks;
+
+/**
+ * Find the 5 nearest neighbors of every point of the dataset (all-kNN) with
+ * the given search mode.  The tree is built before the search is timed; the
+ * items are the query points.
+ */
+static void KNNSearch(BenchmarkState& state, const NeighborSearchMode mode)
+{
+  const BenchmarkConfig& config = state.Config();
+  const size_t k = 5;
+
+  DispatchTree(config.tree, [&](auto selector)
+  {
+    using KNNType = NeighborSearch<NearestNeighborSort, EuclideanDistance,
+        arma::mat, decltype(selector)::template Tree>;
+    using TreeType = typename KNNType::Tree;
+
+    std::vector<size_t> oldFromNew;
+    TreeType* tree = BuildBenchmarkTree<TreeType>(GenerateDataset(config),
+        config.leafSize, oldFromNew);
+    KNNType knn(std::move(*tree), mode);
+    delete tree;
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    state.Measure([&]() { knn.Search(k, neighbors, distances); });
+
+    state.SetItems(neighbors.n_cols);
+    state.SetDistanceEvaluations(knn.BaseCases());
+    state.SetScores(knn.Scores());
+  });
+}
+
+static void KNNDualTree(BenchmarkState& state)
+{
+  KNNSearch(state, DUAL_TREE_MODE);
+}
+
+static void KNNSingleTree(BenchmarkState& state)
+{
+  KNNSearch(state, SINGLE_TREE_MODE);
+}
+
+MLPACK_BENCHMARK("knn/dual_tree", KNNDualTree);
+MLPACK_BENCHMARK("knn/single_tree", KNNSingleTree);
@@ -0,0 +1,66 @@
+/**
+ * @file benchmarks/range_search_benchmarks.cpp
+ *
+ * Benchmarks of range search.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark_data.hpp"
+
+#include <mlpack/methods/range_search.hpp>
+
+using namespace mlpack;
+using namespace mlpack::benchmarks;
+
+/**
+ * Find the points of the dataset within a radius of every point of the
+ * dataset; the radius holds 10 points on average for uniformly distributed
+ * points.  The tree is built before the search is timed; the items are the
+ * query points.
+ */
+static void RangeSearchBenchmark(BenchmarkState& state, const bool singleMode)
+{
+  const BenchmarkConfig& config = state.Config();
+
+  DispatchTree(config.tree, [&](auto selector)
+  {
+    using RangeSearchType = RangeSearch<EuclideanDistance, arma::mat,
+        decltype(selector)::template Tree>;
+    using TreeType = typename RangeSearchType::Tree;
+
+    std::vector<size_t> oldFromNew;
+    TreeType* tree = BuildBenchmarkTree<TreeType>(GenerateDataset(config),
+        config.leafSize, oldFromNew);
+    const Range range(0.0, NeighborhoodRadius(tree->Dataset().n_cols,
+        tree->Dataset().n_rows, 10.0));
+
+    {
+      RangeSearchType rs(tree, singleMode);
+      std::vector<std::vector<size_t>> neighbors;
+      std::vector<std::vector<double>> distances;
+      state.Measure([&]() { rs.Search(range, neighbors, distances); });
+
+      state.SetItems(neighbors.size());
+      state.SetDistanceEvaluations(rs.BaseCases());
+      state.SetScores(rs.Scores());
+    }
+
+    delete tree;
+  });
+}
+
+static void RangeSearchDualTree(BenchmarkState& state)
+{
+  RangeSearchBenchmark(state, false);
+}
+
+static void RangeSearchSingleTree(BenchmarkState& state)
+{
+  RangeSearchBenchmark(state, true);
+}
+
+MLPACK_BENCHMARK("range_search/dual_tree", RangeSearchDualTree);
+MLPACK_BENCHMARK("range_search/single_tree", RangeSearchSingleTree);
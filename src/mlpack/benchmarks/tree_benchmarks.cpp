@@ -0,0 +1,59 @@
+/**
+ * @file benchmarks/tree_benchmarks.cpp
+ *
+ * Benchmarks of tree construction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark_data.hpp"
+
+using namespace mlpack;
+using namespace mlpack::benchmarks;
+
+// Cover trees count the distance evaluations of their construction; other
+// trees don't.
+template<typename TreeType>
+auto ConstructionDistances(const TreeType& tree, int)
+    -> decltype(tree.DistanceComps())
+{
+  return tree.DistanceComps();
+}
+
+template<typename TreeType>
+size_t ConstructionDistances(const TreeType& /* tree */, long)
+{
+  return 0;
+}
+
+/**
+ * Build a tree on the dataset.  The items are the points of the dataset.
+ */
+static void TreeBuild(BenchmarkState& state)
+{
+  const BenchmarkConfig& config = state.Config();
+  const arma::mat dataset = GenerateDataset(config);
+
+  DispatchTree(config.tree, [&](auto selector)
+  {
+    using TreeType = typename decltype(selector)::template Tree<
+        EuclideanDistance, EmptyStatistic, arma::mat>;
+
+    size_t distances = 0;
+    state.Measure([&]()
+    {
+      std::vector<size_t> oldFromNew;
+      TreeType* tree = BuildBenchmarkTree<TreeType>(dataset, config.leafSize,
+          oldFromNew);
+      distances = ConstructionDistances(*tree, 0);
+      delete tree;
+    });
+    state.SetDistanceEvaluations(distances);
+  });
+
+  state.SetItems(dataset.n_cols);
+}
+
+MLPACK_BENCHMARK("tree/build", TreeBuild);
@@ -25,8 +25,20 @@ namespace cli {
  */
 inline void EndProgram(util::Params& params, util::Timers& timers)
 {
-  // Stop the timers.
+  // Stop the timers, and save their trace if requested.
   timers.StopAllTimers();
+  if (params.Has("timing_output"))
+  {
+    const std::string& filename = params.Get<std::string>("timing_output");
+    try
+    {
+      timers.ExportTrace(filename);
+    }
+    catch (const std::runtime_error& e)
+    {
+      Log::Fatal << e.what() << std::endl;
+    }
+  }
 
   // Print any output.
   std::map<std::string, util::ParamData>& parameters = params.Parameters();
@@ -76,6 +88,34 @@ inline void EndProgram(util::Params& params, util::Timers& timers)
     for (auto& it2 : timerMap)
     {
       Log::Info << "  " << it2.first << ": " << timers.Print(it2.second);
+
+      // Timers that ran several times (for instance, in several threads) also
+      // show how long their runs took.
+      const size_t count = timers.Count(it2.first);
+      if (count > 1)
+      {
+        std::string minTime = timers.Print(timers.Min(it2.first));
+        std::string maxTime = timers.Print(timers.Max(it2.first));
+        minTime.pop_back();
+        maxTime.pop_back();
+        Log::Info << "    " << count << " runs; shortest " << minTime
+            << ", longest " << maxTime << std::endl;
+      }
+
+      // When memory is tracked, show the peak memory of each phase too.
+      if (util::MemoryUsage::Enabled() && count > 0)
+      {
+        Log::Info << "    peak memory "
+            << util::MemoryUsage::Print(timers.PeakMemory(it2.first)) << "; "
+            << timers.Allocations(it2.first) << " allocations" << std::endl;
+      }
+    }
+
+    if (util::MemoryUsage::Enabled())
+    {
+      Log::Info << "Peak memory: "
+          << util::MemoryUsage::Print(util::MemoryUsage::Peak()) << " ("
+          << util::MemoryUsage::Allocations() << " allocations)" << std::endl;
     }
   }
 
@@ -86,8 +86,10 @@ using Option = mlpack::bindings::cli::CLIOption<T>;
 
 #include <mlpack/core/util/param.hpp>
 #include <mlpack/core/util/io.hpp>
+#include <mlpack/core/util/threads.hpp>
 #include <mlpack/bindings/cli/parse_command_line.hpp>
 #include <mlpack/bindings/cli/end_program.hpp>
+#include <mlpack/bindings/cli/serve.hpp>
 
 // Forward definition of the binding function.
 void BINDING_FUNCTION(mlpack::util::Params&, mlpack::util::Timers&);
@@ -101,11 +103,28 @@ int main(int argc, char** argv)
   // Create a new timer object for this call.
   mlpack::util::Timers timers;
   timers.Enabled() = true;
+  timers.Tracing() = params.Has("timing_output");
   mlpack::Timer::EnableTiming();
 
+  // Use the number of threads given with --threads, if any.
+  if (params.Has("threads"))
+  {
+    if (params.Get<int>("threads") < 0)
+    {
+      mlpack::Log::Fatal << "Invalid value for --threads ("
+          << params.Get<int>("threads") << "); it must be at least 0!"
+          << std::endl;
+    }
+
+    mlpack::SetThreads((size_t) params.Get<int>("threads"));
+  }
+
   // A "total_time" timer is run by default for each mlpack program.
   timers.Start("total_time");
-  BINDING_FUNCTION(params, timers);
+  if (params.Has("serve"))
+    mlpack::bindings::cli::Serve(params, timers, &BINDING_FUNCTION);
+  else
+    BINDING_FUNCTION(params, timers);
   timers.Stop("total_time");
 
   // Print output options, print verbose information, save model parameters,
@@ -123,5 +142,24 @@ PARAM_GLOBAL(bool, "verbose", "Display informational messages and the full "
     false, true, false, false);
 PARAM_GLOBAL(bool, "version", "Display the version of mlpack.", "V", "bool",
     false, true, false, false);
+PARAM_GLOBAL(std::string, "timing_output", "If specified, the runs of the "
+    "timers are saved to this file as a Chrome trace (JSON), which can be "
+    "displayed with chrome://tracing or Perfetto.", "", "std::string", false,
+    true, false, "");
+PARAM_GLOBAL(bool, "serve", "If set, the program is run once for each "
+    "request read from standard input (points as CSV lines, ending with an "
+    "empty line), which gives the input named by --serve_input; the outputs "
+    "are written to standard output, each followed by an empty line.  Models "
+    "and other inputs are loaded only once.", "", "bool", false, true, false,
+    false);
+PARAM_GLOBAL(std::string, "serve_input", "Name of the input matrix that is "
+    "given by the requests of --serve (for instance, 'test').", "",
+    "std::string", false, true, false, "");
+PARAM_GLOBAL(std::string, "serve_output", "Comma-separated names of the "
+    "outputs that are written for each request of --serve; by default, all "
+    "the output matrices.", "", "std::string", false, true, false, "");
+PARAM_GLOBAL(int, "threads", "Number of threads to use (for mlpack and the "
+    "BLAS library); 0 uses one thread for each processor.  By default, OpenMP "
+    "chooses.", "", "int", false, true, false, 0);
 
 #endif
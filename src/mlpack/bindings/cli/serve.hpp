@@ -0,0 +1,227 @@
+/**
+ * @file bindings/cli/serve.hpp
+ *
+ * The serving mode of command-line programs (--serve): the models and other
+ * inputs of the program are loaded once, and then the program is run once for
+ * each request read from a stream, which gives one of its input matrices; the
+ * outputs of each run are written back as the response.
+ *
+ * A request is a block of lines of comma-separated numbers, one point per line,
+ * ended by an empty line (or the end of the stream).  The response is each of
+ * the outputs, in the same layout as the files that the program would save,
+ * each followed by an empty line; if the program fails on a request, the
+ * response is a line "error: <message>" followed by an empty line, and the
+ * next request is served.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_SERVE_HPP
+#define MLPACK_BINDINGS_CLI_SERVE_HPP
+
+#include <mlpack/core/util/io.hpp>
+
+#include <iostream>
+#include <sstream>
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+/**
+ * Read the next request from the given stream into the given batch, with one
+ * point in each column.  Throws std::invalid_argument if the lines of the
+ * request are not numbers or do not all have the same number of values.
+ *
+ * @param stream Stream to read from.
+ * @param batch Matrix to store the points of the request in.
+ * @return false if the stream has no more requests.
+ */
+inline bool ReadServeRequest(std::istream& stream, arma::mat& batch)
+{
+  // Read all the lines of the request first, so that an invalid line does not
+  // leave the rest of the request in the stream.
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+    if (line.find_first_not_of(" \t") == std::string::npos)
+    {
+      // Skip empty lines between requests.
+      if (lines.empty())
+        continue;
+      break;
+    }
+
+    lines.push_back(line);
+  }
+
+  if (lines.empty())
+    return false;
+
+  std::vector<double> values;
+  size_t dimensionality = 0;
+  for (size_t i = 0; i < lines.size(); ++i)
+  {
+    std::replace(lines[i].begin(), lines[i].end(), ',', ' ');
+    std::istringstream lineStream(lines[i]);
+    size_t lineValues = 0;
+    std::string token;
+    while (lineStream >> token)
+    {
+      size_t end = 0;
+      double value = 0.0;
+      try
+      {
+        value = std::stod(token, &end);
+      }
+      catch (const std::exception&) { }
+
+      if (end != token.size())
+      {
+        throw std::invalid_argument("'" + token + "' on line " +
+            std::to_string(i + 1) + " of the request is not a number");
+      }
+
+      values.push_back(value);
+      ++lineValues;
+    }
+
+    if (i > 0 && lineValues != dimensionality)
+    {
+      throw std::invalid_argument("line " + std::to_string(i + 1) +
+          " of the request has " + std::to_string(lineValues) + " values, "
+          "but line 1 has " + std::to_string(dimensionality));
+    }
+
+    dimensionality = lineValues;
+  }
+
+  batch = arma::mat(values.data(), dimensionality, lines.size());
+  return true;
+}
+
+/**
+ * Run the given binding once for each request read from the given stream, and
+ * write the responses to the given stream.  The input matrix that the requests
+ * give is named by --serve_input; the outputs that are written are named by
+ * --serve_output (a comma-separated list), or are all the matrix outputs of the
+ * binding if it is empty.  All the other inputs (like models) are loaded before
+ * the first request.
+ *
+ * @param params Parameters of the binding.
+ * @param timers Timers of the binding.
+ * @param binding Binding function to run for each request.
+ * @param input Stream to read the requests from.
+ * @param output Stream to write the responses to.
+ */
+inline void Serve(util::Params& params,
+                  util::Timers& timers,
+                  void (*binding)(util::Params&, util::Timers&),
+                  std::istream& input = std::cin,
+                  std::ostream& output = std::cout)
+{
+  std::map<std::string, util::ParamData>& parameters = params.Parameters();
+
+  const std::string& inputName = params.Get<std::string>("serve_input");
+  if (inputName.empty())
+  {
+    Log::Fatal << "--serve_input must be given with --serve, to name the input "
+        << "matrix of the requests!" << std::endl;
+  }
+  if (parameters.count(inputName) == 0 || !parameters[inputName].input)
+  {
+    Log::Fatal << "--serve_input: '" << inputName << "' is not an input "
+        << "parameter of this program!" << std::endl;
+  }
+  if (params.Has("verbose"))
+  {
+    Log::Fatal << "--serve cannot be used with --verbose, whose messages would "
+        << "be mixed with the responses!" << std::endl;
+  }
+
+  // Find the outputs of the responses.
+  std::vector<std::string> outputNames;
+  std::istringstream outputList(params.Get<std::string>("serve_output"));
+  std::string name;
+  while (std::getline(outputList, name, ','))
+  {
+    if (parameters.count(name) == 0 || parameters[name].input)
+    {
+      Log::Fatal << "--serve_output: '" << name << "' is not an output "
+          << "parameter of this program!" << std::endl;
+    }
+    outputNames.push_back(name);
+  }
+  if (outputNames.empty())
+  {
+    for (auto& it : parameters)
+    {
+      if (!it.second.input &&
+          it.second.cppType.find("arma::") != std::string::npos)
+        outputNames.push_back(it.first);
+    }
+  }
+
+  // The binding computes the outputs only if they were passed.
+  for (const std::string& outputName : outputNames)
+    parameters[outputName].wasPassed = true;
+
+  // Load the other inputs once; GetParam() loads matrices and models.
+  for (auto& it : parameters)
+  {
+    util::ParamData& d = it.second;
+    if (d.input && d.wasPassed && it.first != inputName)
+    {
+      void* result;
+      params.functionMap[d.tname]["GetParam"](d, NULL, (void*) &result);
+    }
+  }
+
+  util::ParamData& inputData = parameters[inputName];
+  inputData.wasPassed = true;
+
+  arma::mat batch;
+  while (true)
+  {
+    try
+    {
+      if (!ReadServeRequest(input, batch))
+        break;
+
+      params.functionMap[inputData.tname]["ServeInputParam"](inputData,
+          (const void*) &batch, NULL);
+      binding(params, timers);
+
+      // Build the response first, so that a failure does not leave a partial
+      // response.
+      std::ostringstream response;
+      for (const std::string& outputName : outputNames)
+      {
+        util::ParamData& d = parameters[outputName];
+        params.functionMap[d.tname]["ServeOutputParam"](d, NULL,
+            (void*) &response);
+        response << "\n";
+      }
+      output << response.str();
+    }
+    catch (const std::exception& e)
+    {
+      std::string message = e.what();
+      std::replace(message.begin(), message.end(), '\n', ' ');
+      output << "error: " << message << "\n\n";
+    }
+
+    output.flush();
+  }
+}
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
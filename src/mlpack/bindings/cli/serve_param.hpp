@@ -0,0 +1,233 @@
+/**
+ * @file bindings/cli/serve_param.hpp
+ *
+ * Set the input parameter and write the output parameters of a request in the
+ * serving mode of command-line programs (see serve.hpp).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_SERVE_PARAM_HPP
+#define MLPACK_BINDINGS_CLI_SERVE_PARAM_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/param_data.hpp>
+#include <mlpack/core/util/is_std_vector.hpp>
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+/**
+ * Write the given matrix to the given stream as CSV, one line for each column
+ * of the matrix if transpose is true, or for each row otherwise (so that the
+ * lines are the same as those of the file that the program would save).
+ */
+template<typename MatType>
+void WriteServeMatrix(std::ostream& stream,
+                      const MatType& matrix,
+                      const bool transpose)
+{
+  using ElemType = typename MatType::elem_type;
+  const std::streamsize precision = stream.precision(
+      std::numeric_limits<ElemType>::max_digits10);
+
+  const size_t lines = transpose ? matrix.n_cols : matrix.n_rows;
+  const size_t values = transpose ? matrix.n_rows : matrix.n_cols;
+  for (size_t i = 0; i < lines; ++i)
+  {
+    for (size_t j = 0; j < values; ++j)
+    {
+      if (j > 0)
+        stream << ",";
+      stream << (transpose ? matrix(j, i) : matrix(i, j));
+    }
+    stream << "\n";
+  }
+
+  stream.precision(precision);
+}
+
+/**
+ * Set a matrix parameter to the given batch, which holds one point in each
+ * column.
+ */
+template<typename T>
+void ServeInputParamImpl(
+    util::ParamData& d,
+    const arma::mat& batch,
+    const typename std::enable_if<arma::is_arma_type<T>::value>::type* = 0)
+{
+  typedef std::tuple<T, std::tuple<std::string, size_t, size_t>> TupleType;
+  TupleType& tuple = *std::any_cast<TupleType>(&d.value);
+  T& matrix = std::get<0>(tuple);
+  if (arma::is_Row<T>::value || arma::is_Col<T>::value)
+    matrix = arma::conv_to<T>::from(arma::vectorise(batch));
+  else if (d.noTranspose)
+    matrix = arma::conv_to<T>::from(batch.t());
+  else
+    matrix = arma::conv_to<T>::from(batch);
+
+  std::get<1>(std::get<1>(tuple)) = matrix.n_rows;
+  std::get<2>(std::get<1>(tuple)) = matrix.n_cols;
+  d.loaded = true;
+}
+
+/**
+ * Set a matrix parameter with dataset info to the given batch, whose
+ * dimensions are all numeric.
+ */
+template<typename T>
+void ServeInputParamImpl(
+    util::ParamData& d,
+    const arma::mat& batch,
+    const typename std::enable_if<std::is_same<T,
+        std::tuple<data::DatasetInfo, arma::mat>>::value>::type* = 0)
+{
+  typedef std::tuple<T, std::tuple<std::string, size_t, size_t>> TupleType;
+  TupleType& tuple = *std::any_cast<TupleType>(&d.value);
+  arma::mat& matrix = std::get<1>(std::get<0>(tuple));
+  matrix = d.noTranspose ? arma::mat(batch.t()) : batch;
+  std::get<0>(std::get<0>(tuple)) = data::DatasetInfo(matrix.n_rows);
+
+  std::get<1>(std::get<1>(tuple)) = matrix.n_rows;
+  std::get<2>(std::get<1>(tuple)) = matrix.n_cols;
+  d.loaded = true;
+}
+
+/**
+ * Other parameters cannot be given in requests.
+ */
+template<typename T>
+void ServeInputParamImpl(
+    util::ParamData& d,
+    const arma::mat& /* batch */,
+    const typename std::enable_if<!arma::is_arma_type<T>::value>::type* = 0,
+    const typename std::enable_if<!std::is_same<T,
+        std::tuple<data::DatasetInfo, arma::mat>>::value>::type* = 0)
+{
+  Log::Fatal << "Parameter '" << d.name << "' is not a matrix, so requests "
+      << "cannot be given to it!" << std::endl;
+}
+
+/**
+ * Write a matrix output parameter.
+ */
+template<typename T>
+void ServeOutputParamImpl(
+    util::ParamData& d,
+    std::ostream& stream,
+    const typename std::enable_if<arma::is_arma_type<T>::value>::type* = 0)
+{
+  typedef std::tuple<T, std::tuple<std::string, size_t, size_t>> TupleType;
+  const T& matrix = std::get<0>(*std::any_cast<TupleType>(&d.value));
+
+  // Vectors are saved with one element on each line.
+  const bool transpose = arma::is_Row<T>::value ||
+      (!arma::is_Col<T>::value && !d.noTranspose);
+  WriteServeMatrix(stream, matrix, transpose);
+}
+
+/**
+ * Write a matrix output parameter with dataset info (the mappings are not
+ * written, as for a saved file).
+ */
+template<typename T>
+void ServeOutputParamImpl(
+    util::ParamData& d,
+    std::ostream& stream,
+    const typename std::enable_if<std::is_same<T,
+        std::tuple<data::DatasetInfo, arma::mat>>::value>::type* = 0)
+{
+  typedef std::tuple<T, std::tuple<std::string, size_t, size_t>> TupleType;
+  const T& tuple = std::get<0>(*std::any_cast<TupleType>(&d.value));
+  WriteServeMatrix(stream, std::get<1>(tuple), !d.noTranspose);
+}
+
+/**
+ * Write a vector output parameter, on one line.
+ */
+template<typename T>
+void ServeOutputParamImpl(
+    util::ParamData& d,
+    std::ostream& stream,
+    const typename std::enable_if<util::IsStdVector<T>::value>::type* = 0)
+{
+  const T& t = *std::any_cast<T>(&d.value);
+  for (size_t i = 0; i < t.size(); ++i)
+    stream << ((i == 0) ? "" : ",") << t[i];
+  stream << "\n";
+}
+
+/**
+ * Write a simple output parameter, on one line.
+ */
+template<typename T>
+void ServeOutputParamImpl(
+    util::ParamData& d,
+    std::ostream& stream,
+    const typename std::enable_if<!arma::is_arma_type<T>::value>::type* = 0,
+    const typename std::enable_if<!util::IsStdVector<T>::value>::type* = 0,
+    const typename std::enable_if<!data::HasSerialize<T>::value>::type* = 0,
+    const typename std::enable_if<!std::is_same<T,
+        std::tuple<data::DatasetInfo, arma::mat>>::value>::type* = 0)
+{
+  stream << *std::any_cast<T>(&d.value) << "\n";
+}
+
+/**
+ * Models cannot be written in responses.
+ */
+template<typename T>
+void ServeOutputParamImpl(
+    util::ParamData& d,
+    std::ostream& /* stream */,
+    const typename std::enable_if<!arma::is_arma_type<T>::value>::type* = 0,
+    const typename std::enable_if<data::HasSerialize<T>::value>::type* = 0)
+{
+  Log::Fatal << "Parameter '" << d.name << "' is a model, so it cannot be "
+      << "given in responses!" << std::endl;
+}
+
+/**
+ * Set the given input parameter to the batch of a request.  This is the
+ * function that will be called by the IO module.
+ *
+ * @param d Parameter information.
+ * @param input Pointer to the batch (an arma::mat with one point in each
+ *     column).
+ * @param * (output) Unused parameter.
+ */
+template<typename T>
+void ServeInputParam(util::ParamData& d,
+                     const void* input,
+                     void* /* output */)
+{
+  ServeInputParamImpl<typename std::remove_pointer<T>::type>(d,
+      *((const arma::mat*) input));
+}
+
+/**
+ * Write the given output parameter in the response to a request.  This is the
+ * function that will be called by the IO module.
+ *
+ * @param d Parameter information.
+ * @param * (input) Unused parameter.
+ * @param output Pointer to the std::ostream to write to.
+ */
+template<typename T>
+void ServeOutputParam(util::ParamData& d,
+                      const void* /* input */,
+                      void* output)
+{
+  ServeOutputParamImpl<typename std::remove_pointer<T>::type>(d,
+      *((std::ostream*) output));
+}
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
@@ -81,7 +81,10 @@ class MDOption
 
     // Add the option.
     if (identifier != "verbose" && identifier != "copy_all_inputs" &&
-        identifier != "help" && identifier != "info" && identifier != "version")
+        identifier != "help" && identifier != "info" &&
+        identifier != "version" && identifier != "threads" &&
+        identifier != "timing_output" && identifier != "serve" &&
+        identifier != "serve_input" && identifier != "serve_output")
     {
       IO::AddParameter(bindingName, std::move(data));
     }
@@ -137,6 +137,22 @@ PARAM_GLOBAL(std::string, "info", "Print help on a specific option.", "",
     "std::string", false, true, false, "");
 PARAM_GLOBAL(bool, "version", "Display the version of mlpack.", "V", "bool",
     false, true, false, false);
+PARAM_GLOBAL(std::string, "timing_output", "If specified, the runs of the "
+    "timers are saved to this file as a Chrome trace (JSON), which can be "
+    "displayed with chrome://tracing or Perfetto.", "", "std::string", false,
+    true, false, "");
+PARAM_GLOBAL(bool, "serve", "If set, the program is run once for each "
+    "request read from standard input (points as CSV lines, ending with an "
+    "empty line), which gives the input named by --serve_input; the outputs "
+    "are written to standard output, each followed by an empty line.  Models "
+    "and other inputs are loaded only once.", "", "bool", false, true, false,
+    false);
+PARAM_GLOBAL(std::string, "serve_input", "Name of the input matrix that is "
+    "given by the requests of --serve (for instance, 'test').", "",
+    "std::string", false, true, false, "");
+PARAM_GLOBAL(std::string, "serve_output", "Comma-separated names of the "
+    "outputs that are written for each request of --serve; by default, all "
+    "the output matrices.", "", "std::string", false, true, false, "");
 
 // Python-specific parameters.
 PARAM_GLOBAL(bool, "copy_all_inputs", "If specified, all input parameters will "
@@ -147,4 +163,9 @@ PARAM_GLOBAL(bool, "check_input_matrices", "If specified, the input matrix "
     "is checked for NaN and inf values; an exception is thrown if any are "
     "found.", "", "bool", false, true, false, false);
 
+// CLI and Python parameters.
+PARAM_GLOBAL(int, "threads", "Number of threads to use (for mlpack and the "
+    "BLAS library); 0 uses one thread for each processor.  By default, OpenMP "
+    "chooses.", "", "int", false, true, false, 0);
+
 #endif
@@ -639,6 +639,10 @@ inline std::string ProgramCall(const std::string& programName)
     p.Parameters().erase("help");
     p.Parameters().erase("info");
     p.Parameters().erase("version");
+    p.Parameters().erase("timing_output");
+    p.Parameters().erase("serve");
+    p.Parameters().erase("serve_input");
+    p.Parameters().erase("serve_output");
 
     s += "python\n";
     std::string import = PrintImport(programName);
@@ -652,8 +656,13 @@ inline std::string ProgramCall(const std::string& programName)
     p.Parameters().erase("help");
     p.Parameters().erase("info");
     p.Parameters().erase("version");
+    p.Parameters().erase("timing_output");
+    p.Parameters().erase("serve");
+    p.Parameters().erase("serve_input");
+    p.Parameters().erase("serve_output");
     p.Parameters().erase("copy_all_inputs");
     p.Parameters().erase("check_input_matrices");
+    p.Parameters().erase("threads");
 
     s += "julia\n";
     std::string import = PrintImport(programName);
@@ -667,8 +676,13 @@ inline std::string ProgramCall(const std::string& programName)
     p.Parameters().erase("help");
     p.Parameters().erase("info");
     p.Parameters().erase("version");
+    p.Parameters().erase("timing_output");
+    p.Parameters().erase("serve");
+    p.Parameters().erase("serve_input");
+    p.Parameters().erase("serve_output");
     p.Parameters().erase("copy_all_inputs");
     p.Parameters().erase("check_input_matrices");
+    p.Parameters().erase("threads");
 
     s += "go\n";
     std::string import = PrintImport(programName);
@@ -682,8 +696,13 @@ inline std::string ProgramCall(const std::string& programName)
     p.Parameters().erase("help");
     p.Parameters().erase("info");
     p.Parameters().erase("version");
+    p.Parameters().erase("timing_output");
+    p.Parameters().erase("serve");
+    p.Parameters().erase("serve_input");
+    p.Parameters().erase("serve_output");
     p.Parameters().erase("copy_all_inputs");
     p.Parameters().erase("check_input_matrices");
+    p.Parameters().erase("threads");
 
     s += "R\n";
     std::string import = PrintImport(programName);
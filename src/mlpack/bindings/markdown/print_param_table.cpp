@@ -41,9 +41,15 @@ void PrintParamTable(const string& bindingName,
     if (language != "python" && it->second.name == "copy_all_inputs")
       continue;
 
+    if (language != "cli" && language != "python" &&
+        it->second.name == "threads")
+      continue;
+
     if (language != "cli" &&
         (it->second.name == "help" || it->second.name == "info" ||
-        it->second.name == "version"))
+        it->second.name == "version" || it->second.name == "timing_output" ||
+        it->second.name == "serve" || it->second.name == "serve_input" ||
+        it->second.name == "serve_output"))
       continue;
 
     if (paramsSet.find(it->second.name) != paramsSet.end())
@@ -116,7 +122,10 @@ void PrintParamTable(const string& bindingName,
       cout << desc; // just a string
       // Print whether or not it's a "special" language-only parameter.
       if (it->second.name == "copy_all_inputs" || it->second.name == "help" ||
-          it->second.name == "info" || it->second.name == "version")
+          it->second.name == "info" || it->second.name == "version" ||
+          it->second.name == "timing_output" || it->second.name == "serve" ||
+          it->second.name == "serve_input" ||
+          it->second.name == "serve_output")
       {
         cout << "  <span class=\"special\">Only exists in "
             << PrintLanguage(language) << " binding.</span>";
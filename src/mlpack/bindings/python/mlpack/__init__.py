@@ -10,3 +10,5 @@ http://www.opensource.org/licenses/BSD-3-Clause for more information.
 """
 import warnings
 warnings.filterwarnings("default", category=ImportWarning)
+
+from .shared_model import SharedModel
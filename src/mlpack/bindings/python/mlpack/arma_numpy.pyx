@@ -53,8 +53,9 @@ cdef Mat[double]* numpy_to_mat_d(numpy.ndarray[numpy.double_t, ndim=2] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory.
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    # If needed, make a copy where we own the memory.  Contiguous views of
+    # other arrays are used directly when we do not take ownership.
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -75,9 +76,10 @@ cdef Mat[size_t]* numpy_to_mat_s(numpy.ndarray[numpy.npy_intp, ndim=2] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
     # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+    # we never copy.  Contiguous views of other arrays are used directly when
+    # we do not take ownership.
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -141,9 +143,10 @@ cdef Row[double]* numpy_to_row_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
     # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+    # we never copy.  Contiguous views of other arrays are used directly when
+    # we do not take ownership.
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -165,9 +168,10 @@ cdef Row[size_t]* numpy_to_row_s(numpy.ndarray[numpy.npy_intp, ndim=1] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
     # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+    # we never copy.  Contiguous views of other arrays are used directly when
+    # we do not take ownership.
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -228,9 +232,10 @@ cdef Col[double]* numpy_to_col_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
     # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+    # we never copy.  Contiguous views of other arrays are used directly when
+    # we do not take ownership.
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -252,9 +257,10 @@ cdef Col[size_t]* numpy_to_col_s(numpy.ndarray[numpy.npy_intp, ndim=1] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
     # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+    # we never copy.  Contiguous views of other arrays are used directly when
+    # we do not take ownership.
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -4,8 +4,9 @@ io.pyx: Cython functionality for mlpack::IO and other utilities.
 
 This file imports the Parameters() function from mlpack::IO, plus other utility
 functions: SetParam(), SetParamPtr(), SetParamWithInfo(), GetParam(),
-GetParamWithInfo(), EnableVerbose(), DisableVerbose(), DisableBacktrace(),
-EnableTimers() and ResetTimers().
+GetParamWithInfo(), EnableVerbose(), DisableVerbose(), StartVerboseCall(),
+EndVerboseCall(), DisableBacktrace(), EnableTimers(), ResetTimers(),
+SetBindingThreads() and RestoreThreads().
 
 mlpack is free software; you may redistribute it and/or modify it under the
 terms of the 3-clause BSD license.  You should have received a copy of the
@@ -32,6 +33,10 @@ cdef extern from "<mlpack/bindings/python/mlpack/io_util.hpp>" \
   (T&) GetParamWithInfo[T](Params, string) nogil except +
   void EnableVerbose() nogil except +
   void DisableVerbose() nogil except +
+  void StartVerboseCall(bool) nogil except +
+  void EndVerboseCall(bool) nogil except +
   void DisableBacktrace() nogil except +
   void ResetTimers() nogil except +
   void EnableTimers() nogil except +
+  size_t SetBindingThreads(Params) nogil except +
+  void RestoreThreads(size_t) nogil except +
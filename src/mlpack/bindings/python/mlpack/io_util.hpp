@@ -14,8 +14,11 @@
 #define MLPACK_BINDINGS_PYTHON_CYTHON_IO_UTIL_HPP
 
 #include <mlpack/core/util/io.hpp>
+#include <mlpack/core/util/threads.hpp>
 #include <mlpack/core/data/dataset_mapper.hpp>
 
+#include <mutex>
+
 namespace mlpack {
 namespace util {
 
@@ -169,6 +172,48 @@ inline void DisableVerbose()
   Log::Info.ignoreInput = true;
 }
 
+/**
+ * Return the number of verbose binding calls that are running, after taking
+ * the lock that guards it.
+ */
+inline size_t& VerboseCalls(std::unique_lock<std::mutex>& lock)
+{
+  static std::mutex verboseMutex;
+  static size_t verboseCalls = 0;
+  lock = std::unique_lock<std::mutex>(verboseMutex);
+  return verboseCalls;
+}
+
+/**
+ * Start a binding call: if verbose is true, enable verbose output until the
+ * matching call to EndVerboseCall().  Bindings may run in several threads at
+ * once, so the number of running verbose calls is counted, and the output is
+ * only disabled again when the last of them ends.  A call that is not verbose
+ * does not disable the output of verbose calls that run at the same time.
+ */
+inline void StartVerboseCall(const bool verbose)
+{
+  if (!verbose)
+    return;
+
+  std::unique_lock<std::mutex> lock;
+  if (VerboseCalls(lock)++ == 0)
+    Log::Info.ignoreInput = false;
+}
+
+/**
+ * End a binding call that was started with StartVerboseCall().
+ */
+inline void EndVerboseCall(const bool verbose)
+{
+  if (!verbose)
+    return;
+
+  std::unique_lock<std::mutex> lock;
+  if (--VerboseCalls(lock) == 0)
+    Log::Info.ignoreInput = true;
+}
+
 /**
  * Disable backtraces.
  */
@@ -194,6 +239,39 @@ inline void EnableTimers()
   Timer::EnableTiming();
 }
 
+/**
+ * Use the number of threads given with the "threads" parameter, if it was
+ * passed, and return the previous number of threads so that it can be restored
+ * after the binding is run.
+ */
+inline size_t SetBindingThreads(util::Params& params)
+{
+  const size_t oldThreads = Threads();
+  if (params.Has("threads"))
+  {
+    const int threads = params.Get<int>("threads");
+    if (threads < 0)
+    {
+      std::ostringstream oss;
+      oss << "Invalid value for 'threads' (" << threads << "); it must be at "
+          << "least 0!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    SetThreads((size_t) threads);
+  }
+
+  return oldThreads;
+}
+
+/**
+ * Restore the number of threads returned by SetBindingThreads().
+ */
+inline void RestoreThreads(const size_t threads)
+{
+  SetThreads(threads);
+}
+
 } // namespace util
 } // namespace mlpack
 
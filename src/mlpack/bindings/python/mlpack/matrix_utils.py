@@ -47,28 +47,27 @@ def to_matrix(x, dtype=np.double, copy=False):
       not hasattr(x, '__array__'):
     raise TypeError("given argument is not array-like")
 
-  if (isinstance(x, np.ndarray) and x.dtype == dtype and x.flags.c_contiguous):
-    if copy: # Copy the matrix if required.
-      return x.copy("C"), True
-    else:
+  if isinstance(x, np.ndarray):
+    if x.dtype == dtype and x.flags.c_contiguous and not copy:
+      # The matrix can be used as-is, without any copy.
       return x, False
-  elif (isinstance(x, np.ndarray) and x.dtype == dtype and x.flags.f_contiguous):
-    # A copy is always necessary here.
-    return x.copy("C"), True
-  else:
-    if isinstance(x, pd.core.series.Series) or isinstance(x, pd.DataFrame):
-      # We can only avoid a copy if the dtype is the same and the copy flag is
-      # false.  I'm actually not sure if this is possible, since in everything I
-      # have found, Pandas stores with F_CONTIGUOUS not C_CONTIGUOUS.
-      y = x.values
-      if copy == False and y.dtype == dtype and y.flags.c_contiguous:
-        return np.ndarray(y.shape, buffer=x.values, dtype=dtype, order='C'),\
-            False
-      else:
-        # We have to make a copy or change the dtype, so just do this directly.
-        return np.array(y, dtype=dtype, order='C', copy=True), True
     else:
-      return np.array(x, copy=True, dtype=dtype, order='C'), True
+      # Any other array takes exactly one copy, which converts the dtype (for
+      # instance from float32) and the memory order in a single pass.
+      return np.array(x, dtype=dtype, order='C', copy=True), True
+  elif isinstance(x, pd.core.series.Series) or isinstance(x, pd.DataFrame):
+    # Pandas often stores with F_CONTIGUOUS, and DataFrames with several dtypes
+    # are converted to a new array by .values; take at most one more copy, to
+    # convert the dtype and the memory order.
+    y = x.values
+    out = np.asarray(y, dtype=dtype, order='C')
+    if out is y:
+      if copy:
+        return out.copy(order='C'), True
+      return out, False
+    return out, True
+  else:
+    return np.array(x, copy=True, dtype=dtype, order='C'), True
 
 
 def to_matrix_with_info(x, dtype, copy=False):
@@ -89,11 +88,9 @@ def to_matrix_with_info(x, dtype, copy=False):
     else:
       d = np.zeros([x.shape[1]], dtype=bool)
 
-    # Copy the matrix if needed.
-    if copy:
-      return (x.copy(order="C"), True, d)
-    else:
-      return (x, False, d)
+    # Convert the matrix to the right dtype, or copy it, only if needed.
+    t = to_matrix(x, dtype=dtype, copy=copy)
+    return (t[0], t[1], d)
 
   if isinstance(x, pd.DataFrame) or isinstance(x, pd.Series):
     # It's a pandas dataframe.  So we need to see if any of the dtypes are
@@ -58,6 +58,105 @@ void SerializeInJSON(T* t, const std::string& str, const std::string& name)
   b(cereal::make_nvp(name.c_str(), *t));
 }
 
+/**
+ * A stream buffer that only counts the characters written to it, so that the
+ * size of a serialized model can be known without storing it.
+ */
+class CountingBuffer : public std::streambuf
+{
+ public:
+  //! Get the number of characters written.
+  size_t Count() const { return count; }
+
+ protected:
+  std::streamsize xsputn(const char* /* s */, std::streamsize n) override
+  {
+    count += n;
+    return n;
+  }
+
+  int_type overflow(int_type c) override
+  {
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+      ++count;
+    return traits_type::not_eof(c);
+  }
+
+ private:
+  size_t count = 0;
+};
+
+/**
+ * A stream buffer over the given memory, which is not copied.
+ */
+class MemoryBuffer : public std::streambuf
+{
+ public:
+  MemoryBuffer(char* buffer, const size_t size)
+  {
+    setg(buffer, buffer, buffer + size);
+    setp(buffer, buffer + size);
+  }
+};
+
+/**
+ * Get the size of the binary serialization of the given model, without storing
+ * it (the model is serialized once).
+ */
+template<typename T>
+size_t SerializedSize(T* t, const std::string& name)
+{
+  CountingBuffer buffer;
+  std::ostream os(&buffer);
+  {
+    cereal::BinaryOutputArchive b(os);
+
+    b(cereal::make_nvp(name.c_str(), *t));
+  }
+  return buffer.Count();
+}
+
+/**
+ * Serialize the given model directly into the given memory (for instance,
+ * shared memory), which must hold at least SerializedSize() bytes.
+ */
+template<typename T>
+void SerializeOutBuffer(T* t,
+                        char* data,
+                        const size_t size,
+                        const std::string& name)
+{
+  MemoryBuffer buffer(data, size);
+  std::ostream os(&buffer);
+  {
+    cereal::BinaryOutputArchive b(os);
+
+    b(cereal::make_nvp(name.c_str(), *t));
+  }
+
+  if (!os.good())
+  {
+    throw std::runtime_error("the buffer is too small for the serialized "
+        "model!");
+  }
+}
+
+/**
+ * Deserialize the given model directly from the given memory, which is not
+ * copied.
+ */
+template<typename T>
+void SerializeInBuffer(T* t,
+                       const char* data,
+                       const size_t size,
+                       const std::string& name)
+{
+  MemoryBuffer buffer(const_cast<char*>(data), size);
+  std::istream is(&buffer);
+  cereal::BinaryInputArchive b(is);
+  b(cereal::make_nvp(name.c_str(), *t));
+}
+
 } // namespace python
 } // namespace bindings
 } // namespace mlpack
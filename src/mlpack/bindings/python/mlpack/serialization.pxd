@@ -19,4 +19,9 @@ cdef extern from "serialization.hpp" namespace "mlpack::bindings::python" nogil:
   void SerializeIn[T](T* t, string str, string name) nogil
   string SerializeOutJSON[T](T* t, string name) nogil
   void SerializeInJSON[T](T* t, string str, string name) nogil
+  size_t SerializedSize[T](T* t, string name) nogil except +
+  void SerializeOutBuffer[T](T* t, char* data, size_t size, string name) \
+      nogil except +
+  void SerializeInBuffer[T](T* t, const char* data, size_t size, \
+      string name) nogil except +
   
@@ -0,0 +1,130 @@
+#!/usr/bin/env python
+"""
+shared_model.py: transport of mlpack models through shared memory
+
+This file defines the SharedModel class, a handle of an mlpack model that is
+serialized once into shared memory.  Pickling the handle (for instance, to pass
+it to multiprocessing workers) only pickles the name of the shared memory, and
+each process that calls get() deserializes the model directly from the shared
+memory, once.
+
+  >>> model = random_forest(training=x, labels=y)['output_model']
+  >>> shared = model.share()
+  >>> with multiprocessing.Pool(32) as pool:
+  ...   results = pool.map(predict, [(shared, batch) for batch in batches])
+  >>> shared.unlink()
+
+where predict() calls random_forest(input_model=shared.get(), test=batch).
+
+mlpack is free software; you may redistribute it and/or modify it under the
+terms of the 3-clause BSD license.  You should have received a copy of the
+3-clause BSD license along with mlpack.  If not, see
+http://www.opensource.org/licenses/BSD-3-Clause for more information.
+"""
+from multiprocessing import shared_memory
+
+# The models that were already deserialized in this process, by the name of
+# their shared memory, so that each process deserializes each model once.
+_loaded_models = {}
+
+# The shared memory created by this process, by name.
+_created_memory = {}
+
+
+def _attach(name):
+  """
+  Attach to the shared memory with the given name, without letting this
+  process remove it when it exits.
+  """
+  if name in _created_memory:
+    return _created_memory[name]
+
+  try:
+    return shared_memory.SharedMemory(name=name, track=False)
+  except TypeError:
+    # Before Python 3.13, attaching registers the shared memory with the
+    # resource tracker, which would remove it when this process exits.
+    from multiprocessing import resource_tracker
+    shm = shared_memory.SharedMemory(name=name)
+    resource_tracker.unregister(shm._name, 'shared_memory')
+    return shm
+
+
+class SharedModel:
+  """
+  A handle of an mlpack model serialized into shared memory.  The process that
+  creates the handle owns the shared memory, and should call unlink() when no
+  other process needs the model anymore (or use the handle as a context
+  manager).
+  """
+
+  def __init__(self, model, name=None):
+    """
+    Serialize the given model (the output model of an mlpack binding) into new
+    shared memory, with the given name or a generated one.
+    """
+    self.model_class = model.__class__
+    self.size = model._serialized_size()
+    self._shm = shared_memory.SharedMemory(name=name, create=True,
+                                           size=max(self.size, 1))
+    self.name = self._shm.name
+    self._owner = True
+    _created_memory[self.name] = self._shm
+    try:
+      model._serialize_into(self._shm.buf[:self.size])
+    except:
+      self.unlink()
+      raise
+
+  def get(self):
+    """
+    Get the model.  The first call in each process deserializes it from the
+    shared memory; later calls return the same model.
+    """
+    model = _loaded_models.get(self.name)
+    if model is None:
+      if self._shm is None:
+        self._shm = _attach(self.name)
+      model = self.model_class()
+      model._deserialize_from(self._shm.buf[:self.size])
+      _loaded_models[self.name] = model
+    return model
+
+  def close(self):
+    """
+    Detach this process from the shared memory (models already obtained with
+    get() stay valid).
+    """
+    if self._shm is not None and self.name not in _created_memory:
+      self._shm.close()
+    self._shm = None
+
+  def unlink(self):
+    """
+    Remove the shared memory; only the process that created the handle can do
+    this.
+    """
+    if not self._owner:
+      raise RuntimeError("only the process that created the SharedModel can "
+          "unlink it")
+    shm = _created_memory.pop(self.name)
+    _loaded_models.pop(self.name, None)
+    self._shm = None
+    shm.close()
+    shm.unlink()
+    self._owner = False
+
+  def __enter__(self):
+    return self
+
+  def __exit__(self, *args):
+    if self._owner:
+      self.unlink()
+
+  def __getstate__(self):
+    return (self.model_class, self.name, self.size)
+
+  def __setstate__(self, state):
+    self.model_class, self.name, self.size = state
+    self._shm = None
+    self._owner = False
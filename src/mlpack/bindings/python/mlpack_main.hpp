@@ -143,5 +143,8 @@ PARAM_GLOBAL(bool, "copy_all_inputs", "If specified, all input parameters "
 PARAM_GLOBAL(bool, "check_input_matrices", "If specified, the input matrix "
     "is checked for NaN and inf values; an exception is thrown if any are "
     "found.", "", "bool", false, true, false, false);
+PARAM_GLOBAL(int, "threads", "Number of threads to use (for mlpack and the "
+    "BLAS library); 0 uses one thread for each processor.  By default, OpenMP "
+    "chooses.", "", "int", false, true, false, 0);
 
 #endif
@@ -94,6 +94,22 @@ void PrintClassDefn(
    *     params_str = process_params_in(self, params_dic)
    *     self._set_cpp_params(params_str)
    *
+   *   def _serialized_size(self):
+   *     return SerializedSize(self.modelptr, "<ModelType>")
+   *
+   *   def _serialize_into(self, buffer):
+   *     cdef unsigned char[::1] view = buffer
+   *     SerializeOutBuffer(self.modelptr, <char*> &view[0], view.shape[0],
+   *         "<ModelType>")
+   *
+   *   def _deserialize_from(self, buffer):
+   *     cdef const unsigned char[::1] view = buffer
+   *     SerializeInBuffer(self.modelptr, <const char*> &view[0],
+   *         view.shape[0], "<ModelType>")
+   *
+   *   def share(self):
+   *     return SharedModel(self)
+   *
    * @endcode
    */
   std::cout << "cdef class " << strippedType << "Type:" << std::endl;
@@ -138,6 +154,29 @@ void PrintClassDefn(
   std::cout << "    self._set_cpp_params(params_str.encode(\"utf-8\"))"
       << std::endl;
   std::cout << std::endl;
+  std::cout << "  def _serialized_size(self):" << std::endl;
+  std::cout << "    return SerializedSize(self.modelptr, \"" << printedType
+      << "\")" << std::endl;
+  std::cout << std::endl;
+  std::cout << "  def _serialize_into(self, buffer):" << std::endl;
+  std::cout << "    cdef unsigned char[::1] view = buffer" << std::endl;
+  std::cout << "    SerializeOutBuffer(self.modelptr, <char*> &view[0], "
+      << "view.shape[0], \"" << printedType << "\")" << std::endl;
+  std::cout << std::endl;
+  std::cout << "  def _deserialize_from(self, buffer):" << std::endl;
+  std::cout << "    cdef const unsigned char[::1] view = buffer" << std::endl;
+  std::cout << "    SerializeInBuffer(self.modelptr, <const char*> &view[0], "
+      << "view.shape[0], \"" << printedType << "\")" << std::endl;
+  std::cout << std::endl;
+  std::cout << "  def share(self):" << std::endl;
+  std::cout << "    \"\"\"" << std::endl;
+  std::cout << "    Copy the model into shared memory, and return a "
+      << "SharedModel handle that" << std::endl;
+  std::cout << "    can be passed to other processes without pickling the "
+      << "model." << std::endl;
+  std::cout << "    \"\"\"" << std::endl;
+  std::cout << "    return SharedModel(self)" << std::endl;
+  std::cout << std::endl;
 }
 
 /**
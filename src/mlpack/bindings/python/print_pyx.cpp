@@ -83,13 +83,16 @@ void PrintPYX(const util::BindingDetails& doc,
   cout << "from .timers cimport Timers" << endl;
   cout << "from .io cimport SetParam, SetParamPtr, SetParamWithInfo, "
       << "GetParamPtr" << endl;
-  cout << "from .io cimport EnableVerbose, DisableVerbose, DisableBacktrace, "
-      << "ResetTimers, EnableTimers" << endl;
+  cout << "from .io cimport StartVerboseCall, EndVerboseCall, "
+      << "DisableBacktrace, ResetTimers, EnableTimers, SetBindingThreads, "
+      << "RestoreThreads" << endl;
   cout << "from .matrix_utils import to_matrix, to_matrix_with_info" << endl;
   cout << "from .preprocess_json_params import process_params_out, "
       << "process_params_in" << endl;
   cout << "from .serialization cimport SerializeIn, SerializeOut, "
-      << "SerializeOutJSON, SerializeInJSON" << endl;
+      << "SerializeOutJSON, SerializeInJSON, SerializedSize, "
+      << "SerializeOutBuffer, SerializeInBuffer" << endl;
+  cout << "from .shared_model import SharedModel" << endl;
   cout << endl;
   cout << "import numpy as np" << endl;
   cout << "cimport numpy as np" << endl;
@@ -198,11 +201,11 @@ void PrintPYX(const util::BindingDetails& doc,
       << "returned." << endl;
   cout << "  \"\"\"" << endl;
 
-  // Reset any timers and disable backtraces.
+  // Reset any timers and disable backtraces.  Verbose output is enabled
+  // around the call only (see StartVerboseCall()).
   cout << "  ResetTimers()" << endl;
   cout << "  EnableTimers()" << endl;
   cout << "  DisableBacktrace()" << endl;
-  cout << "  DisableVerbose()" << endl;
 
   // Get the Params object from IO.
   cout << "  cdef Params p = IO.Parameters(\"" << bindingName << "\")"
@@ -249,9 +252,26 @@ void PrintPYX(const util::BindingDetails& doc,
   cout << "  if check_input_matrices:" << endl;
   cout << "    p.CheckInputMatrices()" << endl;
 
+  // Use the given number of threads for the call only.
+  cout << "  cdef size_t oldThreads = SetBindingThreads(p)" << endl;
+  cout << "  cdef cbool verboseCall = p.Get[cbool](<const string> 'verbose')"
+      << endl;
+  cout << "  StartVerboseCall(verboseCall)" << endl;
+  cout << endl;
+
   // Call the method.
   cout << "  # Call the mlpack program." << endl;
-  cout << "  mlpack_" << bindingName << "(p, t)" << endl;
+  // The GIL is released during the call, so that other Python threads can
+  // run (and call other mlpack bindings) at the same time.  The global state
+  // that the call uses is thread-safe: the Log streams lock, the verbosity is
+  // counted by StartVerboseCall(), and the OpenMP thread count is a setting
+  // of the calling thread.
+  cout << "  try:" << endl;
+  cout << "    with nogil:" << endl;
+  cout << "      mlpack_" << bindingName << "(p, t)" << endl;
+  cout << "  finally:" << endl;
+  cout << "    EndVerboseCall(verboseCall)" << endl;
+  cout << "    RestoreThreads(oldThreads)" << endl;
 
   // Do any output processing and return.
   cout << "  # Initialize result dictionary." << endl;
@@ -207,6 +207,81 @@ class TestPythonBinding(unittest.TestCase):
     for j in range(100):
       self.assertEqual(2 * x[j, 2], output['matrix_out'][j, 2])
 
+  def testNumpyFloat32Matrix(self):
+    """
+    A float32 matrix should be converted, and we should get back the third
+    dimension doubled and the fifth forgotten.
+    """
+    x = np.random.rand(100, 5).astype(np.float32)
+
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 mat_req_in=[[1.0]],
+                                 col_req_in=[1.0],
+                                 matrix_in=x)
+
+    self.assertEqual(output['matrix_out'].shape[0], 100)
+    self.assertEqual(output['matrix_out'].shape[1], 4)
+    self.assertEqual(output['matrix_out'].dtype, np.double)
+    for i in [0, 1, 3]:
+      for j in range(100):
+        self.assertEqual(x[j, i], output['matrix_out'][j, i])
+
+    for j in range(100):
+      self.assertEqual(2 * x[j, 2], output['matrix_out'][j, 2])
+
+  def testNumpyContiguousViewMatrix(self):
+    """
+    A contiguous view of another matrix can be used without a copy; we should
+    get back the third dimension doubled and the fifth forgotten.
+    """
+    y = np.random.rand(200, 5)
+    x = y[50:150]
+    z = copy.deepcopy(x)
+
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 mat_req_in=[[1.0]],
+                                 col_req_in=[1.0],
+                                 matrix_in=x)
+
+    self.assertEqual(output['matrix_out'].shape[0], 100)
+    self.assertEqual(output['matrix_out'].shape[1], 4)
+    for i in [0, 1, 3]:
+      for j in range(100):
+        self.assertEqual(z[j, i], output['matrix_out'][j, i])
+
+    for j in range(100):
+      self.assertEqual(2 * z[j, 2], output['matrix_out'][j, 2])
+
+  def testConcurrentCalls(self):
+    """
+    The binding can be called from several Python threads at once (the GIL is
+    released during the call), with and without verbose output, and each call
+    gets its own results.
+    """
+    from concurrent.futures import ThreadPoolExecutor
+
+    def run(i):
+      x = np.full((100, 5), float(i))
+      return test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 mat_req_in=[[1.0]],
+                                 col_req_in=[1.0],
+                                 matrix_in=x,
+                                 verbose=(i % 2 == 0))
+
+    with ThreadPoolExecutor(max_workers=4) as pool:
+      outputs = list(pool.map(run, range(16)))
+
+    for i in range(16):
+      self.assertEqual(outputs[i]['matrix_out'].shape[0], 100)
+      self.assertEqual(outputs[i]['matrix_out'][0, 0], float(i))
+      self.assertEqual(outputs[i]['matrix_out'][0, 2], 2.0 * i)
+
   def testPandasSeriesMatrix(self):
     """
     Test that we can pass pandas.Series as input parameter.
@@ -896,6 +971,37 @@ class TestPythonBinding(unittest.TestCase):
 
     self.assertEqual(output2['model_bw_out'], 20.0)
 
+  def testSharedModel(self):
+    """
+    Share a GaussianKernel object through shared memory, and make sure that the
+    handle can be pickled and gives back a working model.
+    """
+    import pickle
+
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 mat_req_in=[[1.0]],
+                                 col_req_in=[1.0],
+                                 build_model=True)
+
+    with output['model_out'].share() as shared:
+      handle = pickle.loads(pickle.dumps(shared))
+      self.assertEqual(handle.name, shared.name)
+
+      model = handle.get()
+      self.assertIs(handle.get(), model)
+
+      output2 = test_python_binding(string_in='hello',
+                                    int_in=12,
+                                    double_in=4.0,
+                                    mat_req_in=[[1.0]],
+                                    col_req_in=[1.0],
+                                    model_in=model)
+
+      self.assertEqual(output2['model_bw_out'], 20.0)
+      handle.close()
+
   def testOneDimensionNumpyMatrix(self):
     """
     Test that we can pass one dimension matrix from matrix_in
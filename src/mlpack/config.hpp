@@ -56,6 +56,16 @@
 // #define MLPACK_GIT_VERSION
 #endif
 
+//
+// If MLPACK_TRACK_MEMORY is defined, mlpack counts the memory allocated by
+// Armadillo and by the nodes of the trees (see util::MemoryUsage), and the
+// timers record the peak memory of each run; command-line programs print it
+// with --verbose.  Armadillo must then be included after mlpack.
+//
+#ifndef MLPACK_TRACK_MEMORY
+// #define MLPACK_TRACK_MEMORY
+#endif
+
 //
 // MLPACK_COUT_STREAM is used to change the default stream for printing
 // non-error messages.
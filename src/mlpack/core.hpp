@@ -42,6 +42,7 @@
 #include <mlpack/core/util/conv_to.hpp>
 #include <mlpack/core/util/log.hpp>
 #include <mlpack/core/util/io.hpp>
+#include <mlpack/core/util/threads.hpp>
 #include <mlpack/core/data/data.hpp>
 #include <mlpack/core/math/math.hpp>
 
@@ -25,6 +25,38 @@
  */
 namespace cereal {
 
+/**
+ * Serialize the n elements at the given address.  Binary archives write them
+ * as a single block of memory, which is much faster than writing them one at a
+ * time for large matrices, and gives exactly the same bytes (so models saved
+ * either way can be loaded either way); portable binary archives still swap
+ * the bytes of each element if needed.  Text archives write every element
+ * with the given name.
+ */
+template<typename Archive, typename eT>
+void SerializeElements(Archive& ar,
+                       eT* mem,
+                       const size_t n,
+                       const char* name)
+{
+  // Complex elements are written as their real and imaginary parts by text
+  // archives, so only arithmetic types can be written as a block.
+  constexpr bool isBinary = std::is_arithmetic<eT>::value &&
+      (traits::is_output_serializable<BinaryData<eT>, Archive>::value ||
+       traits::is_input_serializable<BinaryData<eT>, Archive>::value);
+
+  if constexpr (isBinary)
+  {
+    if (n > 0)
+      ar(binary_data(mem, n * sizeof(eT)));
+  }
+  else
+  {
+    for (size_t i = 0; i < n; ++i)
+      ar(make_nvp(name, mem[i]));
+  }
+}
+
 template<typename Archive, typename eT>
 void serialize(Archive& ar, arma::SpMat<eT>& mat)
 {
@@ -51,12 +83,12 @@ void serialize(Archive& ar, arma::SpMat<eT>& mat)
   }
 
   // Serialize the values held in the sparse matrix.
-  for (size_t i = 0; i < mat.n_nonzero; ++i)
-    ar(cereal::make_nvp("value", arma::access::rw(mat.values[i])));
-  for (size_t i = 0; i < mat.n_nonzero; ++i)
-    ar(cereal::make_nvp("row_index", arma::access::rw(mat.row_indices[i])));
-  for (size_t i = 0; i < mat.n_cols + 1; ++i)
-    ar(cereal::make_nvp("col_ptr", arma::access::rw(mat.col_ptrs[i])));
+  SerializeElements(ar, arma::access::rwp(mat.values), mat.n_nonzero,
+      "value");
+  SerializeElements(ar, arma::access::rwp(mat.row_indices), mat.n_nonzero,
+      "row_index");
+  SerializeElements(ar, arma::access::rwp(mat.col_ptrs), mat.n_cols + 1,
+      "col_ptr");
 }
 
 // Add an external serialization function for Mat.
@@ -79,8 +111,7 @@ void serialize(Archive& ar, arma::Mat<eT>& mat)
   }
 
   // Directly serialize the contents of the matrix's memory.
-  for (size_t i = 0; i < mat.n_elem; ++i)
-    ar(cereal::make_nvp("elem", arma::access::rw(mat.mem[i])));
+  SerializeElements(ar, arma::access::rwp(mat.mem), mat.n_elem, "elem");
 }
 
 // Add a serialization function for armadillo Cube
@@ -100,8 +131,7 @@ void serialize(Archive& ar, arma::Cube<eT>& cube)
     cube.set_size(n_rows, n_cols, n_slices);
 
   // Directly serialize the contents of the cube's memory.
-  for (size_t i = 0; i < cube.n_elem; ++i)
-    ar(cereal::make_nvp("elem", arma::access::rw(cube.mem[i])));
+  SerializeElements(ar, arma::access::rwp(cube.mem), cube.n_elem, "elem");
 }
 
 } // end namespace cereal
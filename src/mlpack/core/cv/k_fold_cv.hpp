@@ -43,6 +43,19 @@ namespace mlpack {
  * the @c Shuffle() function.  Shuffling is performed at construction time if
  * the parameter @c shuffle is set to @c true in the constructor.
  *
+ * The folds are independent, so several of them can be trained and evaluated
+ * at the same time by setting @c ParallelFolds().  Since the learners may be
+ * parallel themselves, @c FoldThreads() sets the number of threads each fold
+ * may use; by default, each fold uses one thread, so that the machine is not
+ * oversubscribed.
+ *
+ * @code
+ * KFoldCV<SoftmaxRegression<>, Accuracy> cv(10, data, labels, numClasses);
+ * cv.ParallelFolds() = 5; // Train five folds at a time...
+ * cv.FoldThreads() = 2;   // ...each with two threads.
+ * double softmaxAccuracy = cv.Evaluate(lambda);
+ * @endcode
+ *
  * @tparam MLAlgorithm A machine learning algorithm.
  * @tparam Metric A metric to assess the quality of a trained model.
  * @tparam MatType The type of data.
@@ -167,6 +180,14 @@ class KFoldCV
           const WeightsType& weights,
           const bool shuffle = true);
 
+  /**
+   * Copy the given KFoldCV object (with its data, but without the model from
+   * its last run), so that copies can be used from different threads.
+   *
+   * @param other KFoldCV object to copy.
+   */
+  KFoldCV(const KFoldCV& other);
+
   /**
    * Run k-fold cross-validation.
    *
@@ -179,6 +200,19 @@ class KFoldCV
   //! Access and modify a model from the last run of k-fold cross-validation.
   MLAlgorithm& Model();
 
+  //! Get the number of folds that are trained and evaluated at the same time.
+  size_t ParallelFolds() const { return parallelFolds; }
+  //! Modify the number of folds that are trained and evaluated at the same
+  //! time (1, the default, trains them one after the other).
+  size_t& ParallelFolds() { return parallelFolds; }
+
+  //! Get the number of threads each fold may use when folds are trained in
+  //! parallel.
+  size_t FoldThreads() const { return foldThreads; }
+  //! Modify the number of threads each fold may use when folds are trained in
+  //! parallel.
+  size_t& FoldThreads() { return foldThreads; }
+
  private:
   //! A short alias for CVBase.
   using Base = CVBase<MLAlgorithm, MatType, PredictionsType, WeightsType>;
@@ -224,6 +258,13 @@ class KFoldCV
   //! A pointer to a model from the last run of k-fold cross-validation.
   std::unique_ptr<MLAlgorithm> modelPtr;
 
+  //! The number of folds that are trained and evaluated at the same time.
+  size_t parallelFolds;
+
+  //! The number of threads each fold may use when folds are trained in
+  //! parallel.
+  size_t foldThreads;
+
   /**
    * Assert the k parameter and data consistency and initialize fields required
    * for running k-fold cross-validation.
@@ -269,6 +310,15 @@ class KFoldCV
            typename = void>
   double TrainAndEvaluate(const MLAlgorithmArgs& ...mlAlgorithmArgs);
 
+  /**
+   * Train a model on each training subset with the given function (which
+   * takes the index of the fold), and store its evaluation on the validation
+   * subset in the given vector.  The folds are handled ParallelFolds() at a
+   * time; the model of the last fold is kept.
+   */
+  template<typename TrainFunctionType>
+  void EvaluateFolds(const TrainFunctionType& train, arma::vec& evaluations);
+
   /**
    * Calculate the index of the first column of the ith validation subset.
    *
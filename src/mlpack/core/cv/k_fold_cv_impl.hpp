@@ -134,7 +134,9 @@ KFoldCV<MLAlgorithm,
                               const PredictionsType& ys,
                               const bool shuffle) :
     base(std::move(base)),
-    k(k)
+    k(k),
+    parallelFolds(1),
+    foldThreads(1)
 {
   if (k < 2)
     throw std::invalid_argument("KFoldCV: k should not be less than 2");
@@ -165,7 +167,9 @@ KFoldCV<MLAlgorithm,
                               const WeightsType& weights,
                               const bool shuffle) :
     base(std::move(base)),
-    k(k)
+    k(k),
+    parallelFolds(1),
+    foldThreads(1)
 {
   Base::AssertWeightsConsistency(xs, weights);
 
@@ -178,6 +182,27 @@ KFoldCV<MLAlgorithm,
     Shuffle();
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+KFoldCV<MLAlgorithm,
+        Metric,
+        MatType,
+        PredictionsType,
+        WeightsType>::KFoldCV(const KFoldCV& other) :
+    base(other.base),
+    k(other.k),
+    xs(other.xs),
+    ys(other.ys),
+    weights(other.weights),
+    lastBinSize(other.lastBinSize),
+    binSize(other.binSize),
+    parallelFolds(other.parallelFolds),
+    foldThreads(other.foldThreads)
+{ /* Nothing left to do. */ }
+
 template<typename MLAlgorithm,
          typename Metric,
          typename MatType,
@@ -244,14 +269,15 @@ double KFoldCV<MLAlgorithm,
                 WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
 {
   arma::vec evaluations(k);
+  EvaluateFolds([&](const size_t i)
+  {
+    return base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
+        args...);
+  }, evaluations);
 
   size_t numInvalidScores = 0;
   for (size_t i = 0; i < k; ++i)
   {
-    MLAlgorithm&& model  = base.Train(GetTrainingSubset(xs, i),
-        GetTrainingSubset(ys, i), args...);
-    evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
-        GetValidationSubset(ys, i));
     if (std::isnan(evaluations(i)) || std::isinf(evaluations(i)))
     {
       ++numInvalidScores;
@@ -259,8 +285,6 @@ double KFoldCV<MLAlgorithm,
           << "a score of " << evaluations(i) << "; ignoring when computing "
           << "the average score." << std::endl;
     }
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
   }
 
   if (numInvalidScores == k)
@@ -286,23 +310,92 @@ double KFoldCV<MLAlgorithm,
                 WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
 {
   arma::vec evaluations(k);
-
-  for (size_t i = 0; i < k; ++i)
+  EvaluateFolds([&](const size_t i)
   {
-    MLAlgorithm&& model = (weights.n_elem > 0) ?
+    return (weights.n_elem > 0) ?
         base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
             GetTrainingSubset(weights, i), args...) :
         base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
             args...);
-    evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
-        GetValidationSubset(ys, i));
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
-  }
+  }, evaluations);
 
   return arma::mean(evaluations);
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename TrainFunctionType>
+void KFoldCV<MLAlgorithm,
+             Metric,
+             MatType,
+             PredictionsType,
+             WeightsType>::EvaluateFolds(const TrainFunctionType& train,
+                                         arma::vec& evaluations)
+{
+  const size_t numParallelFolds = std::min(std::max(parallelFolds, size_t(1)),
+      k);
+  if (numParallelFolds == 1)
+  {
+    for (size_t i = 0; i < k; ++i)
+    {
+      MLAlgorithm&& model = train(i);
+      evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
+          GetValidationSubset(ys, i));
+      if (i == k - 1)
+        modelPtr.reset(new MLAlgorithm(std::move(model)));
+    }
+
+    return;
+  }
+
+  // The parallel regions of the learners are only run in parallel if nested
+  // parallelism is allowed; the number of threads of each fold is set in the
+  // thread that trains it.
+  #ifdef MLPACK_USE_OPENMP
+  const int maxActiveLevels = omp_get_max_active_levels();
+  if (foldThreads > 1 && maxActiveLevels < 2)
+    omp_set_max_active_levels(2);
+  #endif
+
+  // Exceptions cannot leave an OpenMP region, so the first one is kept and
+  // rethrown afterwards.
+  std::exception_ptr exception;
+  #pragma omp parallel for schedule(dynamic) num_threads(numParallelFolds)
+  for (size_t i = 0; i < k; ++i)
+  {
+    #ifdef MLPACK_USE_OPENMP
+    omp_set_num_threads((int) std::max(foldThreads, size_t(1)));
+    #endif
+
+    try
+    {
+      MLAlgorithm&& model = train(i);
+      evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
+          GetValidationSubset(ys, i));
+      if (i == k - 1)
+        modelPtr.reset(new MLAlgorithm(std::move(model)));
+    }
+    catch (...)
+    {
+      #pragma omp critical
+      {
+        if (!exception)
+          exception = std::current_exception();
+      }
+    }
+  }
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_max_active_levels(maxActiveLevels);
+  #endif
+
+  if (exception)
+    std::rethrow_exception(exception);
+}
+
 template<typename MLAlgorithm,
          typename Metric,
          typename MatType,
@@ -0,0 +1,174 @@
+/**
+ * @file core/cv/metrics/classification_statistics.hpp
+ *
+ * Definition of the ClassificationStatistics class, which accumulates the
+ * statistics that classification metrics are computed from.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_CLASSIFICATION_STATISTICS_HPP
+#define MLPACK_CORE_CV_METRICS_CLASSIFICATION_STATISTICS_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/core/cv/metrics/average_strategy.hpp>
+
+namespace mlpack {
+
+/**
+ * ClassificationStatistics accumulates the confusion counts of a classifier
+ * (and, optionally, histograms of the scores of a positive class), so that
+ * accuracy, precision, recall, F1 and an approximate ROC AUC can all be
+ * computed from a single pass of predictions.  Statistics can be added a chunk
+ * of points at a time, and the statistics of different chunks (computed, for
+ * instance, by different threads or processes) can be merged; the result does
+ * not depend on how the points were split.
+ *
+ * The metrics are defined as for the Accuracy, Precision, Recall, F1 and
+ * ROCAUCScore classes.  In the multiclass case, macroaveraged metrics assume
+ * that there are instances of every label from 0 to the largest label seen.
+ *
+ * The ROC AUC is computed from histograms of the scores (which must lie in
+ * [0, 1]; others are clamped), so points whose scores fall into the same bin
+ * are counted as ties.  With numBins bins, the error is at most the fraction
+ * of positive/negative pairs that share a bin.
+ *
+ * @code
+ * ClassificationStatistics stats;
+ * data::ChunkedReader<> reader("test.csv");
+ * arma::mat chunk;
+ * while (reader.Read(chunk, 100000) > 0)
+ * {
+ *   // Get the labels of the chunk in `chunkLabels`...
+ *   stats.Add(model, chunk, chunkLabels);
+ * }
+ *
+ * const double accuracy = stats.Accuracy();
+ * const double f1 = stats.F1(Macro);
+ * @endcode
+ */
+class ClassificationStatistics
+{
+ public:
+  /**
+   * Create an empty set of statistics.
+   *
+   * @param positiveClass Label of the positive class, for binary metrics and
+   *     the ROC AUC.
+   * @param numBins Number of bins of the score histograms (0 to not keep
+   *     them).
+   */
+  ClassificationStatistics(const size_t positiveClass = 1,
+                           const size_t numBins = 1000);
+
+  /**
+   * Add the statistics of the given true and predicted labels.
+   *
+   * @param labels Ground truth (correct) labels.
+   * @param predictions Predicted labels.
+   */
+  void Add(const arma::Row<size_t>& labels,
+           const arma::Row<size_t>& predictions);
+
+  /**
+   * Add the statistics of the given true and predicted labels, and of the
+   * given scores of the positive class for the ROC AUC.
+   *
+   * @param labels Ground truth (correct) labels.
+   * @param predictions Predicted labels.
+   * @param scores Probability scores of the positive class.
+   */
+  void Add(const arma::Row<size_t>& labels,
+           const arma::Row<size_t>& predictions,
+           const arma::rowvec& scores);
+
+  /**
+   * Classify the given points with the model, and add the statistics of the
+   * predictions.
+   *
+   * @param model A classification model.
+   * @param data Column-major data containing test items.
+   * @param labels Ground truth (correct) labels for the test items.
+   */
+  template<typename MLAlgorithm, typename DataType>
+  void Add(MLAlgorithm& model,
+           const DataType& data,
+           const arma::Row<size_t>& labels);
+
+  /**
+   * Add the statistics of another ClassificationStatistics object, which must
+   * have the same positive class and number of bins.
+   *
+   * @param other Statistics to add.
+   */
+  void Merge(const ClassificationStatistics& other);
+
+  //! Get the fraction of correct predictions.
+  double Accuracy() const;
+
+  //! Get the precision, with the given average strategy.
+  double Precision(const AverageStrategy strategy = Binary) const;
+
+  //! Get the recall, with the given average strategy.
+  double Recall(const AverageStrategy strategy = Binary) const;
+
+  //! Get the F1 score, with the given average strategy.
+  double F1(const AverageStrategy strategy = Binary) const;
+
+  /**
+   * Get the approximate area under the ROC curve of the scores that were
+   * added.  A std::invalid_argument is thrown if only one class has scores.
+   */
+  double AUC() const;
+
+  //! Get the confusion counts (the true labels are the rows, the predicted
+  //! labels the columns).
+  const arma::Mat<size_t>& Confusion() const { return confusion; }
+
+  //! Get the number of points that were added.
+  size_t NumPoints() const { return numPoints; }
+
+  //! Get the label of the positive class.
+  size_t PositiveClass() const { return positiveClass; }
+
+  //! Get the number of bins of the score histograms.
+  size_t NumBins() const { return numBins; }
+
+  //! Serialize the statistics.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Grow the confusion counts to hold the given number of classes.
+  void Grow(const size_t numClasses);
+
+  //! Compute the binary precision, recall or F1 of the given class.
+  double ClassPrecision(const size_t c) const;
+  double ClassRecall(const size_t c) const;
+  double ClassF1(const size_t c) const;
+
+  //! The number of classes with true labels (for macroaveraging).
+  size_t NumLabelClasses() const;
+
+  //! The label of the positive class.
+  size_t positiveClass;
+  //! The number of bins of the score histograms.
+  size_t numBins;
+  //! The number of points added.
+  size_t numPoints;
+  //! The confusion counts.
+  arma::Mat<size_t> confusion;
+  //! The histogram of the scores of positive points.
+  arma::Col<size_t> positiveScores;
+  //! The histogram of the scores of negative points.
+  arma::Col<size_t> negativeScores;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "classification_statistics_impl.hpp"
+
+#endif
@@ -0,0 +1,267 @@
+/**
+ * @file core/cv/metrics/classification_statistics_impl.hpp
+ *
+ * Implementation of the ClassificationStatistics class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_CLASSIFICATION_STATISTICS_IMPL_HPP
+#define MLPACK_CORE_CV_METRICS_CLASSIFICATION_STATISTICS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "classification_statistics.hpp"
+
+namespace mlpack {
+
+inline ClassificationStatistics::ClassificationStatistics(
+    const size_t positiveClass,
+    const size_t numBins) :
+    positiveClass(positiveClass),
+    numBins(numBins),
+    numPoints(0),
+    positiveScores(numBins, arma::fill::zeros),
+    negativeScores(numBins, arma::fill::zeros)
+{
+  Grow(positiveClass + 1);
+}
+
+inline void ClassificationStatistics::Add(const arma::Row<size_t>& labels,
+                                          const arma::Row<size_t>& predictions)
+{
+  util::CheckSameSizes(labels, predictions, "ClassificationStatistics::Add()",
+      "predictions");
+  if (labels.n_elem == 0)
+    return;
+
+  Grow(std::max(arma::max(labels), arma::max(predictions)) + 1);
+
+  // Each thread counts its points, and the counts are added at the end.
+  #pragma omp parallel
+  {
+    arma::Mat<size_t> threadConfusion(confusion.n_rows, confusion.n_cols,
+        arma::fill::zeros);
+
+    #pragma omp for schedule(static)
+    for (size_t i = 0; i < labels.n_elem; ++i)
+      ++threadConfusion(labels[i], predictions[i]);
+
+    #pragma omp critical
+    confusion += threadConfusion;
+  }
+
+  numPoints += labels.n_elem;
+}
+
+inline void ClassificationStatistics::Add(const arma::Row<size_t>& labels,
+                                          const arma::Row<size_t>& predictions,
+                                          const arma::rowvec& scores)
+{
+  util::CheckSameSizes(labels, scores, "ClassificationStatistics::Add()",
+      "scores");
+  if (numBins == 0)
+  {
+    throw std::invalid_argument("ClassificationStatistics::Add(): scores "
+        "cannot be added to statistics without score histograms!");
+  }
+
+  Add(labels, predictions);
+
+  #pragma omp parallel
+  {
+    arma::Col<size_t> threadPositives(numBins, arma::fill::zeros);
+    arma::Col<size_t> threadNegatives(numBins, arma::fill::zeros);
+
+    #pragma omp for schedule(static)
+    for (size_t i = 0; i < labels.n_elem; ++i)
+    {
+      const double score = std::min(std::max(scores[i], 0.0), 1.0);
+      const size_t bin = std::min(size_t(score * numBins), numBins - 1);
+      if (labels[i] == positiveClass)
+        ++threadPositives[bin];
+      else
+        ++threadNegatives[bin];
+    }
+
+    #pragma omp critical
+    {
+      positiveScores += threadPositives;
+      negativeScores += threadNegatives;
+    }
+  }
+}
+
+template<typename MLAlgorithm, typename DataType>
+void ClassificationStatistics::Add(MLAlgorithm& model,
+                                   const DataType& data,
+                                   const arma::Row<size_t>& labels)
+{
+  util::CheckSameSizes(data, labels, "ClassificationStatistics::Add()");
+
+  arma::Row<size_t> predictions;
+  model.Classify(data, predictions);
+  Add(labels, predictions);
+}
+
+inline void ClassificationStatistics::Merge(
+    const ClassificationStatistics& other)
+{
+  if (other.positiveClass != positiveClass || other.numBins != numBins)
+  {
+    std::ostringstream oss;
+    oss << "ClassificationStatistics::Merge(): cannot merge statistics with "
+        << "positive class " << other.positiveClass << " and " << other.numBins
+        << " bins into statistics with positive class " << positiveClass
+        << " and " << numBins << " bins!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  Grow(other.confusion.n_rows);
+  confusion.submat(0, 0, other.confusion.n_rows - 1,
+      other.confusion.n_cols - 1) += other.confusion;
+  positiveScores += other.positiveScores;
+  negativeScores += other.negativeScores;
+  numPoints += other.numPoints;
+}
+
+inline double ClassificationStatistics::Accuracy() const
+{
+  return double(arma::accu(confusion.diag())) / numPoints;
+}
+
+inline double ClassificationStatistics::Precision(
+    const AverageStrategy strategy) const
+{
+  // Microaveraged precision turns out to be just accuracy.
+  if (strategy == Binary)
+    return ClassPrecision(positiveClass);
+  else if (strategy == Micro)
+    return Accuracy();
+
+  const size_t numClasses = NumLabelClasses();
+  double precision = 0.0;
+  for (size_t c = 0; c < numClasses; ++c)
+    precision += ClassPrecision(c);
+
+  return precision / numClasses;
+}
+
+inline double ClassificationStatistics::Recall(
+    const AverageStrategy strategy) const
+{
+  // Microaveraged recall turns out to be just accuracy.
+  if (strategy == Binary)
+    return ClassRecall(positiveClass);
+  else if (strategy == Micro)
+    return Accuracy();
+
+  const size_t numClasses = NumLabelClasses();
+  double recall = 0.0;
+  for (size_t c = 0; c < numClasses; ++c)
+    recall += ClassRecall(c);
+
+  return recall / numClasses;
+}
+
+inline double ClassificationStatistics::F1(
+    const AverageStrategy strategy) const
+{
+  // Microaveraged F1 is the same as microaveraged precision and recall.
+  if (strategy == Binary)
+    return ClassF1(positiveClass);
+  else if (strategy == Micro)
+    return Accuracy();
+
+  const size_t numClasses = NumLabelClasses();
+  double f1 = 0.0;
+  for (size_t c = 0; c < numClasses; ++c)
+    f1 += ClassF1(c);
+
+  return f1 / numClasses;
+}
+
+inline double ClassificationStatistics::AUC() const
+{
+  const size_t numberOfTrueLabels = arma::accu(positiveScores);
+  const size_t numberOfFalseLabels = arma::accu(negativeScores);
+  if (numberOfTrueLabels == 0 || numberOfFalseLabels == 0)
+  {
+    throw std::invalid_argument("ClassificationStatistics::AUC(): only one "
+        "class is given in labels, ROC AUC is undefined");
+  }
+
+  // Walk the bins from the highest scores down, integrating with the
+  // trapezoidal rule; the points of a bin are ties, as in ROCAUCScore.
+  double area = 0.0;
+  size_t tp = 0, fp = 0;
+  for (size_t b = numBins; b > 0; --b)
+  {
+    const size_t newTp = tp + positiveScores[b - 1];
+    const size_t newFp = fp + negativeScores[b - 1];
+    area += double(newFp - fp) * double(newTp + tp) / 2.0;
+    tp = newTp;
+    fp = newFp;
+  }
+
+  return area / (double(numberOfTrueLabels) * double(numberOfFalseLabels));
+}
+
+template<typename Archive>
+void ClassificationStatistics::serialize(Archive& ar,
+                                         const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(positiveClass));
+  ar(CEREAL_NVP(numBins));
+  ar(CEREAL_NVP(numPoints));
+  ar(CEREAL_NVP(confusion));
+  ar(CEREAL_NVP(positiveScores));
+  ar(CEREAL_NVP(negativeScores));
+}
+
+inline void ClassificationStatistics::Grow(const size_t numClasses)
+{
+  // New elements are set to zero.
+  if (numClasses > confusion.n_rows)
+    confusion.resize(numClasses, numClasses);
+}
+
+inline double ClassificationStatistics::ClassPrecision(const size_t c) const
+{
+  const size_t tp = (c < confusion.n_rows) ? confusion(c, c) : 0;
+  const size_t numberOfPositivePredictions = (c < confusion.n_cols) ?
+      arma::accu(confusion.col(c)) : 0;
+  return double(tp) / numberOfPositivePredictions;
+}
+
+inline double ClassificationStatistics::ClassRecall(const size_t c) const
+{
+  const size_t tp = (c < confusion.n_rows) ? confusion(c, c) : 0;
+  const size_t numberOfPositiveClassInstances = (c < confusion.n_rows) ?
+      arma::accu(confusion.row(c)) : 0;
+  return double(tp) / numberOfPositiveClassInstances;
+}
+
+inline double ClassificationStatistics::ClassF1(const size_t c) const
+{
+  const double precision = ClassPrecision(c);
+  const double recall = ClassRecall(c);
+  return (precision + recall == 0.0) ? 0.0 :
+      2.0 * precision * recall / (precision + recall);
+}
+
+inline size_t ClassificationStatistics::NumLabelClasses() const
+{
+  for (size_t c = confusion.n_rows; c > 0; --c)
+  {
+    if (arma::accu(confusion.row(c - 1)) > 0)
+      return c;
+  }
+
+  return 0;
+}
+
+} // namespace mlpack
+
+#endif
@@ -15,6 +15,7 @@
 #include "facilities.hpp"
 #include "accuracy.hpp"
 #include "average_strategy.hpp"
+#include "classification_statistics.hpp"
 #include "f1.hpp"
 #include "mse.hpp"
 #include "precision.hpp"
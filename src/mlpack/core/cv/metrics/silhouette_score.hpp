@@ -35,6 +35,13 @@ namespace mlpack {
  * @f}
  *
  * The Overall Silhouette Score is the mean of individual silhoutte scores.
+ *
+ * When the distances are not precomputed, they are computed in blocks of
+ * points, in parallel, and only the sum of the distances from each point to
+ * each cluster is stored, so the memory used grows with the number of points
+ * times the number of clusters instead of with the square of the number of
+ * points.  For very large datasets, Overall() can also estimate the score from
+ * a random sample of the points.
  */
 class SilhouetteScore
 {
@@ -52,6 +59,25 @@ class SilhouetteScore
                         const arma::Row<size_t>& labels,
                         const Metric& metric);
 
+  /**
+   * Estimate the overall silhouette score from the silhouette scores of
+   * numSamples points chosen at random (the score of each of them is exact,
+   * as it takes the distances to all points).  This takes time proportional
+   * to numSamples times the number of points.  If numSamples is 0 or not
+   * smaller than the number of points, the exact score is returned.
+   *
+   * @param X Column-major data used for clustering.
+   * @param labels Labels assigned to data by clustering.
+   * @param metric Metric to be used to calculate dissimilarity.
+   * @param numSamples Number of points to estimate the score with.
+   * @return (double) estimated silhouette score.
+   */
+  template<typename DataType, typename Metric>
+  static double Overall(const DataType& X,
+                        const arma::Row<size_t>& labels,
+                        const Metric& metric,
+                        const size_t numSamples);
+
   /**
    * Find the individual silhouette scores for precomputted dissimilarites.
    *
@@ -91,6 +117,22 @@ class SilhouetteScore
                                         const size_t& label,
                                         const bool& sameCluster = false);
 
+  /**
+   * Find the silhouette scores of the points of X with the given indices,
+   * without storing the distances between points.
+   *
+   * @param X Column-major data used for clustering.
+   * @param labels Labels assigned to data by clustering.
+   * @param metric Metric to be used to calculate dissimilarity.
+   * @param points Indices of the points to find the scores of.
+   * @return (arma::rowvec) silhouette score of each given point.
+   */
+  template<typename DataType, typename Metric>
+  static arma::rowvec PointsScore(const DataType& X,
+                                  const arma::Row<size_t>& labels,
+                                  const Metric& metric,
+                                  const arma::uvec& points);
+
   /**
    * Information for hyper-parameter tuning code. It indicates that we want
    * to maximize the metric.
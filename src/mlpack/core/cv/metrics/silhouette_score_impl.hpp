@@ -25,6 +25,20 @@ double SilhouetteScore::Overall(const DataType& X,
   return arma::mean(SamplesScore(X, labels, metric));
 }
 
+template<typename DataType, typename Metric>
+double SilhouetteScore::Overall(const DataType& X,
+                                const arma::Row<size_t>& labels,
+                                const Metric& metric,
+                                const size_t numSamples)
+{
+  util::CheckSameSizes(X, labels, "SilhouetteScore::Overall()");
+  if (numSamples == 0 || numSamples >= X.n_cols)
+    return arma::mean(SamplesScore(X, labels, metric));
+
+  const arma::uvec points = arma::randperm<arma::uvec>(X.n_cols, numSamples);
+  return arma::mean(PointsScore(X, labels, metric, points));
+}
+
 template<typename DataType>
 arma::rowvec SilhouetteScore::SamplesScore(const DataType& distances,
                                            const arma::Row<size_t>& labels)
@@ -76,8 +90,89 @@ arma::rowvec SilhouetteScore::SamplesScore(const DataType& X,
                                            const Metric& metric)
 {
   util::CheckSameSizes(X, labels, "SilhouetteScore::SamplesScore()");
-  DataType distances = PairwiseDistances(X, metric);
-  return SamplesScore(distances, labels);
+  if (X.n_cols == 0)
+    return arma::rowvec();
+
+  return PointsScore(X, labels, metric,
+      arma::regspace<arma::uvec>(0, X.n_cols - 1));
+}
+
+template<typename DataType, typename Metric>
+arma::rowvec SilhouetteScore::PointsScore(const DataType& X,
+                                          const arma::Row<size_t>& labels,
+                                          const Metric& metric,
+                                          const arma::uvec& points)
+{
+  // Map the labels to the indices of the clusters.
+  const arma::Row<size_t> clusterLabels = arma::unique(labels);
+  arma::Row<size_t> clusters(labels.n_elem);
+  arma::Row<size_t> clusterSizes(clusterLabels.n_elem, arma::fill::zeros);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    clusters[i] = std::lower_bound(clusterLabels.begin(), clusterLabels.end(),
+        labels[i]) - clusterLabels.begin();
+    ++clusterSizes[clusters[i]];
+  }
+
+  // Sum the distances from each point to each cluster, a block of points
+  // against a block of all points at a time, so that both blocks stay in the
+  // cache.
+  const size_t blockSize = 64;
+  const size_t numBlocks = (points.n_elem + blockSize - 1) / blockSize;
+  arma::mat clusterDistances(clusterLabels.n_elem, points.n_elem,
+      arma::fill::zeros);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) points.n_elem);
+    for (size_t jBegin = 0; jBegin < X.n_cols; jBegin += blockSize)
+    {
+      const size_t jEnd = std::min(jBegin + blockSize, (size_t) X.n_cols);
+      for (size_t p = begin; p < end; ++p)
+      {
+        const size_t i = points[p];
+        for (size_t j = jBegin; j < jEnd; ++j)
+        {
+          if (j != i)
+          {
+            clusterDistances(clusters[j], p) +=
+                metric.Evaluate(X.col(i), X.col(j));
+          }
+        }
+      }
+    }
+  }
+
+  arma::rowvec sampleScores(points.n_elem);
+  for (size_t p = 0; p < points.n_elem; ++p)
+  {
+    const size_t cluster = clusters[points[p]];
+    const double intraClusterDistance = (clusterSizes[cluster] == 1) ? 0.0 :
+        clusterDistances(cluster, p) / (clusterSizes[cluster] - 1);
+    if (intraClusterDistance == 0)
+    {
+      // i is the only element in the cluster.
+      sampleScores(p) = 0.0;
+      continue;
+    }
+
+    double minInterClusterDistance = DBL_MAX;
+    for (size_t c = 0; c < clusterLabels.n_elem; ++c)
+    {
+      if (c != cluster)
+      {
+        minInterClusterDistance = std::min(minInterClusterDistance,
+            clusterDistances(c, p) / clusterSizes[c]);
+      }
+    }
+
+    sampleScores(p) = minInterClusterDistance - intraClusterDistance;
+    sampleScores(p) /= std::max(intraClusterDistance, minInterClusterDistance);
+  }
+
+  return sampleScores;
 }
 
 inline double SilhouetteScore::MeanDistanceFromCluster(
@@ -197,6 +197,14 @@ class SimpleCV
            const size_t numClasses,
            WeightsInType&& weights);
 
+  /**
+   * Copy the given SimpleCV object (with its data, but without the model from
+   * its last run), so that copies can be used from different threads.
+   *
+   * @param other SimpleCV object to copy.
+   */
+  SimpleCV(const SimpleCV& other);
+
   /**
    * Train on the training set and assess performance on the validation set by
    * using the class Metric.
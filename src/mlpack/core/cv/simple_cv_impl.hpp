@@ -126,6 +126,33 @@ SimpleCV<MLAlgorithm,
         std::forward<WIT>(weights))
 { /* Nothing left to do. */ }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+SimpleCV<MLAlgorithm,
+         Metric,
+         MatType,
+         PredictionsType,
+         WeightsType>::SimpleCV(const SimpleCV& other) :
+    base(other.base),
+    xs(other.xs),
+    ys(other.ys),
+    weights(other.weights)
+{
+  // The subsets are aliases of the data of this object.
+  const size_t numberOfTrainingPoints = other.trainingXs.n_cols;
+
+  trainingXs = GetSubset(xs, 0, numberOfTrainingPoints - 1);
+  trainingYs = GetSubset(ys, 0, numberOfTrainingPoints - 1);
+  if (weights.n_elem > 0)
+    trainingWeights = GetSubset(weights, 0, numberOfTrainingPoints - 1);
+
+  validationXs = GetSubset(xs, numberOfTrainingPoints, xs.n_cols - 1);
+  validationYs = GetSubset(ys, numberOfTrainingPoints, xs.n_cols - 1);
+}
+
 template<typename MLAlgorithm,
          typename Metric,
          typename MatType,
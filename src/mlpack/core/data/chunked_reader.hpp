@@ -0,0 +1,194 @@
+/**
+ * @file core/data/chunked_reader.hpp
+ *
+ * Definition of the ChunkedReader class, which reads a dataset file of any
+ * of the usual formats a fixed number of points at a time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHUNKED_READER_HPP
+#define MLPACK_CORE_DATA_CHUNKED_READER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "csv_chunk_reader.hpp"
+#include "dataset_mapper.hpp"
+#include "detect_file_type.hpp"
+#include "load_csv.hpp"
+#include "types.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The ChunkedReader reads a dataset file a chunk of points at a time, so that
+ * a file much larger than the available memory can be processed (for instance
+ * by a streaming learner, or to compute statistics for scaling) while holding
+ * only one chunk in memory.  Each chunk holds one point per column, as
+ * `data::Load()` returns them by default (with `transpose = true`), so the
+ * chunks of a file are the columns of the matrix `data::Load()` would load
+ * from it.
+ *
+ * The following formats are supported:
+ *
+ *  - CSV files, read with a CSVChunkReader: the categorical dimensions are
+ *    mapped with the given DatasetInfo, or with one built from the first chunk
+ *    (see CSVChunkReader).  Lines that cannot be mapped are skipped.
+ *  - raw ASCII and Armadillo ASCII files (with one point on each line).  The
+ *    values must be numbers; lines with a wrong number of values are skipped.
+ *  - Armadillo binary files, with any element type, which is converted to the
+ *    element type of the chunks.
+ *  - raw binary files, holding elements of the element type of the chunks.
+ *    Since they do not hold the size of the matrix, a DatasetInfo must be
+ *    given for them.
+ *
+ * Binary files are read directly at the position of each chunk, so nothing is
+ * parsed, and skipping back to the start is free.
+ *
+ * A DatasetInfo given to the constructor is never changed, so that every
+ * chunk is mapped the same way; for formats other than CSV, it only has to
+ * have the right dimensionality.
+ *
+ * @code
+ * data::ChunkedReader<> reader("data.bin");
+ * arma::mat chunk;
+ * while (reader.Read(chunk, 10000) > 0)
+ * {
+ *   // Use chunk, whose dimensions are described by reader.Info().
+ * }
+ * @endcode
+ *
+ * @tparam MatType Type of the chunks.
+ */
+template<typename MatType = arma::mat>
+class ChunkedReader
+{
+ public:
+  //! The element type of the chunks.
+  using ElemType = typename MatType::elem_type;
+
+  /**
+   * Open the given file for reading.  A std::runtime_error is thrown if the
+   * file cannot be opened, or if its type is not supported.
+   *
+   * @param filename Name of the file.
+   * @param type Type of the file; by default, it is detected like by
+   *     `data::Load()`.
+   */
+  ChunkedReader(const std::string& filename,
+                const FileType type = FileType::AutoDetect);
+
+  /**
+   * Open the given file for reading, and map every chunk with the given
+   * DatasetInfo.  A std::runtime_error is thrown if the file cannot be opened
+   * or if its type is not supported, and a std::invalid_argument if the
+   * DatasetInfo does not have the dimensionality of the file.
+   *
+   * @param filename Name of the file.
+   * @param info DatasetInfo of the points of the file.
+   * @param type Type of the file; by default, it is detected like by
+   *     `data::Load()`.
+   */
+  ChunkedReader(const std::string& filename,
+                const DatasetInfo& info,
+                const FileType type = FileType::AutoDetect);
+
+  /**
+   * Read the next chunk of at most chunkSize points into the given matrix
+   * (one column for each point).  When the end of the file is reached, the
+   * matrix is empty and 0 is returned.
+   *
+   * @param chunk Matrix to store the points of the chunk in.
+   * @param chunkSize Maximum number of points to read.
+   * @return The number of points read.
+   */
+  size_t Read(MatType& chunk, const size_t chunkSize);
+
+  /**
+   * Go back to the start of the file, so that it can be read again (for
+   * instance, for another pass of training).  The DatasetInfo is kept.
+   */
+  void Reset();
+
+  //! Get the DatasetInfo of the file (for CSV files without a given
+  //! DatasetInfo, it is empty before the first chunk is read).
+  const DatasetInfo& Info() const
+  {
+    return csvReader ? csvReader->Info() : info;
+  }
+
+  //! Get the type of the file.
+  FileType Type() const { return type; }
+
+  //! Get the number of lines of a text file that have been skipped because
+  //! they could not be mapped.
+  size_t SkippedLines() const
+  {
+    return csvReader ? csvReader->SkippedLines() : skippedLines;
+  }
+
+ private:
+  /**
+   * Open the file and read its header; if hasInfo is false, the DatasetInfo
+   * is built from the file.
+   */
+  void Open(const FileType inputType, const bool hasInfo);
+
+  //! Read the next chunk of a raw ASCII or Armadillo ASCII file.
+  size_t ReadText(MatType& chunk, const size_t chunkSize);
+
+  //! Read the next chunk of a raw binary or Armadillo binary file.
+  size_t ReadBinary(MatType& chunk, const size_t chunkSize);
+
+  //! Split the next non-empty line of a text file into tokens; return false
+  //! at the end of the file.
+  bool ReadTokens(std::vector<std::string>& tokens);
+
+  /**
+   * Convert the n elements of type T at the given address to ElemType, and
+   * store them every `stride` elements of out.
+   */
+  template<typename T>
+  static void Convert(const char* data,
+                      const size_t n,
+                      ElemType* out,
+                      const size_t stride);
+
+  //! The name of the file.
+  std::string filename;
+  //! The type of the file.
+  FileType type;
+  //! The reader of CSV files.
+  std::unique_ptr<CSVChunkReader> csvReader;
+  //! The stream of other files.
+  std::fstream stream;
+  //! The position of the first point in the stream.
+  std::streampos dataStart;
+  //! The DatasetInfo of files other than CSV files.
+  DatasetInfo info;
+  //! The kind of the elements of a binary file ('f', 'i' or 'u').
+  char elemKind;
+  //! The size of the elements of a binary file, in bytes.
+  size_t elemSize;
+  //! The number of points of a binary file.
+  size_t numPoints;
+  //! The index of the next point of a binary file.
+  size_t position;
+  //! The number of lines of a text file that were skipped.
+  size_t skippedLines;
+  //! The converter of the tokens of text files.
+  LoadCSV converter;
+  //! The buffer of the elements of binary files.
+  std::vector<char> buffer;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "chunked_reader_impl.hpp"
+
+#endif
@@ -0,0 +1,332 @@
+/**
+ * @file core/data/chunked_reader_impl.hpp
+ *
+ * Implementation of the ChunkedReader class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHUNKED_READER_IMPL_HPP
+#define MLPACK_CORE_DATA_CHUNKED_READER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "chunked_reader.hpp"
+
+namespace mlpack {
+namespace data {
+
+template<typename MatType>
+ChunkedReader<MatType>::ChunkedReader(const std::string& filename,
+                                      const FileType type) :
+    filename(filename),
+    type(type),
+    elemKind('f'),
+    elemSize(sizeof(ElemType)),
+    numPoints(0),
+    position(0),
+    skippedLines(0)
+{
+  Open(type, false);
+}
+
+template<typename MatType>
+ChunkedReader<MatType>::ChunkedReader(const std::string& filename,
+                                      const DatasetInfo& info,
+                                      const FileType type) :
+    filename(filename),
+    type(type),
+    info(info),
+    elemKind('f'),
+    elemSize(sizeof(ElemType)),
+    numPoints(0),
+    position(0),
+    skippedLines(0)
+{
+  Open(type, true);
+}
+
+template<typename MatType>
+void ChunkedReader<MatType>::Open(const FileType inputType,
+                                  const bool hasInfo)
+{
+  stream.open(filename, std::fstream::in | std::fstream::binary);
+  if (!stream.is_open())
+  {
+    throw std::runtime_error("ChunkedReader: cannot open '" + filename +
+        "' for reading!");
+  }
+
+  type = (inputType == FileType::AutoDetect) ? AutoDetect(stream, filename) :
+      inputType;
+  stream.clear();
+  stream.seekg(0);
+
+  size_t dimensionality = 0;
+  if (type == FileType::CSVASCII)
+  {
+    stream.close();
+    if (hasInfo)
+      csvReader.reset(new CSVChunkReader(filename, info));
+    else
+      csvReader.reset(new CSVChunkReader(filename));
+    return;
+  }
+  else if (type == FileType::RawASCII || type == FileType::ArmaASCII)
+  {
+    if (type == FileType::ArmaASCII)
+    {
+      // Skip the header and the size; each line holds a point.
+      std::string header;
+      size_t rows, cols;
+      stream >> header >> rows >> cols;
+      if (stream.fail() || header.substr(0, 12) != "ARMA_MAT_TXT")
+      {
+        throw std::runtime_error("ChunkedReader: '" + filename + "' is not an "
+            "Armadillo ASCII file!");
+      }
+      dimensionality = cols;
+    }
+
+    dataStart = stream.tellg();
+    if (type == FileType::RawASCII)
+    {
+      // The first point gives the dimensionality.
+      std::vector<std::string> tokens;
+      if (ReadTokens(tokens))
+        dimensionality = tokens.size();
+      stream.clear();
+      stream.seekg(dataStart);
+    }
+  }
+  else if (type == FileType::ArmaBinary)
+  {
+    std::string header;
+    size_t rows, cols;
+    stream >> header >> rows >> cols;
+    stream.get();
+    if (stream.fail() || header.size() != 18 ||
+        header.substr(0, 13) != "ARMA_MAT_BIN_")
+    {
+      throw std::runtime_error("ChunkedReader: '" + filename + "' is not an "
+          "Armadillo binary file of a dense, real matrix!");
+    }
+
+    // The header ends with the kind ("FN", "IS" or "IU") and the size of the
+    // elements; complex elements are not supported.
+    const std::string kind = header.substr(13, 2);
+    elemKind = (kind == "FN") ? 'f' : (kind == "IS") ? 'i' :
+        (kind == "IU") ? 'u' : '\0';
+    elemSize = std::atoi(header.substr(15).c_str());
+    if (elemKind == '\0')
+    {
+      throw std::runtime_error("ChunkedReader: '" + filename + "' is not an "
+          "Armadillo binary file of a dense, real matrix!");
+    }
+
+    // The file holds one point per row.
+    dataStart = stream.tellg();
+    numPoints = rows;
+    dimensionality = cols;
+  }
+  else if (type == FileType::RawBinary)
+  {
+    if (!hasInfo || info.Dimensionality() == 0)
+    {
+      throw std::runtime_error("ChunkedReader: a DatasetInfo must be given to "
+          "read the raw binary file '" + filename + "'!");
+    }
+
+    stream.seekg(0, std::ios::end);
+    const size_t fileSize = stream.tellg();
+    dataStart = 0;
+    dimensionality = info.Dimensionality();
+    elemKind = std::is_floating_point<ElemType>::value ? 'f' :
+        (std::is_signed<ElemType>::value ? 'i' : 'u');
+    if (fileSize % (elemSize * dimensionality) != 0)
+    {
+      std::ostringstream oss;
+      oss << "ChunkedReader: the size of '" << filename << "' is not a "
+          << "multiple of the size of a point with " << dimensionality
+          << " dimensions!";
+      throw std::runtime_error(oss.str());
+    }
+    numPoints = fileSize / (elemSize * dimensionality);
+  }
+  else
+  {
+    throw std::runtime_error("ChunkedReader: cannot read '" + filename +
+        "' in chunks; its type is " + GetStringType(type) + "!");
+  }
+
+  if (!hasInfo)
+  {
+    info = DatasetInfo(dimensionality);
+  }
+  else if (info.Dimensionality() != dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "ChunkedReader: the DatasetInfo has " << info.Dimensionality()
+        << " dimensions, but the points of '" << filename << "' have "
+        << dimensionality << "!";
+    throw std::invalid_argument(oss.str());
+  }
+}
+
+template<typename MatType>
+size_t ChunkedReader<MatType>::Read(MatType& chunk, const size_t chunkSize)
+{
+  if (csvReader)
+    return csvReader->Read(chunk, chunkSize);
+  else if (type == FileType::RawASCII || type == FileType::ArmaASCII)
+    return ReadText(chunk, chunkSize);
+  else
+    return ReadBinary(chunk, chunkSize);
+}
+
+template<typename MatType>
+void ChunkedReader<MatType>::Reset()
+{
+  if (csvReader)
+  {
+    csvReader->Reset();
+    return;
+  }
+
+  stream.clear();
+  stream.seekg(dataStart);
+  position = 0;
+}
+
+template<typename MatType>
+size_t ChunkedReader<MatType>::ReadText(MatType& chunk,
+                                        const size_t chunkSize)
+{
+  const size_t dimensionality = info.Dimensionality();
+  if (dimensionality == 0)
+  {
+    chunk.clear();
+    return 0;
+  }
+
+  chunk.set_size(dimensionality, chunkSize);
+  std::vector<std::string> tokens;
+  size_t points = 0;
+  while (points < chunkSize && ReadTokens(tokens))
+  {
+    bool valid = (tokens.size() == dimensionality);
+    for (size_t d = 0; valid && d < dimensionality; ++d)
+      valid = converter.ConvertToken(chunk(d, points), tokens[d]);
+
+    if (valid)
+      ++points;
+    else
+      ++skippedLines;
+  }
+
+  if (points < chunkSize)
+    chunk.resize(dimensionality, points);
+
+  return points;
+}
+
+template<typename MatType>
+size_t ChunkedReader<MatType>::ReadBinary(MatType& chunk,
+                                          const size_t chunkSize)
+{
+  const size_t dimensionality = info.Dimensionality();
+  const size_t points = std::min(chunkSize, numPoints - position);
+  chunk.set_size(dimensionality, points);
+  if (points == 0)
+    return 0;
+
+  // The values of each dimension are contiguous in the file, so each chunk
+  // takes one read for each dimension.
+  buffer.resize(points * elemSize);
+  for (size_t d = 0; d < dimensionality; ++d)
+  {
+    stream.seekg(dataStart + std::streamoff((d * numPoints + position) *
+        elemSize));
+    stream.read(buffer.data(), buffer.size());
+    if (!stream.good())
+    {
+      throw std::runtime_error("ChunkedReader: error reading '" + filename +
+          "'; is it truncated?");
+    }
+
+    ElemType* out = chunk.memptr() + d;
+    switch (elemKind | (elemSize << 8))
+    {
+      case 'f' | (4 << 8):
+        Convert<float>(buffer.data(), points, out, dimensionality); break;
+      case 'f' | (8 << 8):
+        Convert<double>(buffer.data(), points, out, dimensionality); break;
+      case 'i' | (1 << 8):
+        Convert<int8_t>(buffer.data(), points, out, dimensionality); break;
+      case 'i' | (2 << 8):
+        Convert<int16_t>(buffer.data(), points, out, dimensionality); break;
+      case 'i' | (4 << 8):
+        Convert<int32_t>(buffer.data(), points, out, dimensionality); break;
+      case 'i' | (8 << 8):
+        Convert<int64_t>(buffer.data(), points, out, dimensionality); break;
+      case 'u' | (1 << 8):
+        Convert<uint8_t>(buffer.data(), points, out, dimensionality); break;
+      case 'u' | (2 << 8):
+        Convert<uint16_t>(buffer.data(), points, out, dimensionality); break;
+      case 'u' | (4 << 8):
+        Convert<uint32_t>(buffer.data(), points, out, dimensionality); break;
+      case 'u' | (8 << 8):
+        Convert<uint64_t>(buffer.data(), points, out, dimensionality); break;
+      default:
+        throw std::runtime_error("ChunkedReader: '" + filename + "' holds an "
+            "unknown element type!");
+    }
+  }
+
+  position += points;
+  return points;
+}
+
+template<typename MatType>
+bool ChunkedReader<MatType>::ReadTokens(std::vector<std::string>& tokens)
+{
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    Trim(line);
+    if (line.empty())
+      continue;
+
+    tokens.clear();
+    std::istringstream lineStream(line);
+    std::string token;
+    while (lineStream >> token)
+      tokens.push_back(token);
+
+    return true;
+  }
+
+  return false;
+}
+
+template<typename MatType>
+template<typename T>
+void ChunkedReader<MatType>::Convert(const char* data,
+                                     const size_t n,
+                                     ElemType* out,
+                                     const size_t stride)
+{
+  // The buffer is not necessarily aligned for T.
+  for (size_t i = 0; i < n; ++i)
+  {
+    T value;
+    std::memcpy(&value, data + i * sizeof(T), sizeof(T));
+    out[i * stride] = ElemType(value);
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,132 @@
+/**
+ * @file core/data/csv_chunk_reader.hpp
+ *
+ * Definition of the CSVChunkReader class, which reads a (possibly categorical)
+ * CSV file a fixed number of points at a time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CSV_CHUNK_READER_HPP
+#define MLPACK_CORE_DATA_CSV_CHUNK_READER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "dataset_mapper.hpp"
+#include "string_algorithms.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The CSVChunkReader reads a CSV file with one point on each line, a chunk of
+ * points at a time, so that a file much larger than the available memory can
+ * be processed (for instance by a streaming learner) while holding only one
+ * chunk in memory.
+ *
+ * The DatasetInfo of the file is built from the first chunk: a dimension is
+ * categorical if any of its values in the first chunk is not a number, and
+ * the categories of each categorical dimension are the values seen in the
+ * first chunk.  Later chunks are mapped with the same DatasetInfo, which never
+ * changes after the first chunk, so that models built on the first chunk can
+ * be trained on the later ones.  Lines of later chunks that cannot be mapped
+ * (a wrong number of values, a value of a numeric dimension that is not a
+ * number, or an unknown category) are skipped and counted.
+ *
+ * @code
+ * data::CSVChunkReader reader("data.csv");
+ * arma::mat chunk;
+ * while (reader.Read(chunk, 10000) > 0)
+ * {
+ *   // Use chunk, whose dimensions are described by reader.Info().
+ * }
+ * @endcode
+ */
+class CSVChunkReader
+{
+ public:
+  /**
+   * Open the given CSV file for reading.  A std::runtime_error is thrown if
+   * the file cannot be opened.
+   *
+   * @param filename Name of the CSV file.
+   * @param delimiter Character that separates the values of each line.
+   */
+  CSVChunkReader(const std::string& filename, const char delimiter = ',');
+
+  /**
+   * Open the given CSV file for reading, and map every chunk (including the
+   * first one) with the given DatasetInfo, instead of building one from the
+   * first chunk.  A std::runtime_error is thrown if the file cannot be opened.
+   *
+   * @param filename Name of the CSV file.
+   * @param info DatasetInfo to map each line with.
+   * @param delimiter Character that separates the values of each line.
+   */
+  CSVChunkReader(const std::string& filename,
+                 const DatasetInfo& info,
+                 const char delimiter = ',');
+
+  /**
+   * Read the next chunk of at most chunkSize points into the given matrix
+   * (one column for each point).  The first call also builds the DatasetInfo
+   * of the file.  When the end of the file is reached, the matrix is empty
+   * and 0 is returned.
+   *
+   * @param chunk Matrix to store the points of the chunk in.
+   * @param chunkSize Maximum number of points to read.
+   * @return The number of points read.
+   */
+  template<typename eT>
+  size_t Read(arma::Mat<eT>& chunk, const size_t chunkSize);
+
+  /**
+   * Go back to the start of the file, so that it can be read again (for
+   * instance, for another pass of training).  The DatasetInfo is kept.
+   */
+  void Reset();
+
+  //! Get the DatasetInfo of the file (empty before the first chunk is read).
+  const DatasetInfo& Info() const { return info; }
+
+  //! Get the number of lines that have been skipped because they could not
+  //! be mapped.
+  size_t SkippedLines() const { return skippedLines; }
+
+ private:
+  /**
+   * Read the next non-empty line of the file and split it into tokens.
+   * Return false at the end of the file.
+   */
+  bool ReadTokens(std::vector<std::string>& tokens);
+
+  /**
+   * Map the tokens of a line of a later chunk into the given column with the
+   * DatasetInfo; return false if any token cannot be mapped.
+   */
+  template<typename eT>
+  bool MapTokens(const std::vector<std::string>& tokens, eT* column);
+
+  //! The name of the file.
+  std::string filename;
+  //! The stream of the file.
+  std::ifstream stream;
+  //! The delimiter of the values of each line.
+  char delimiter;
+  //! The DatasetInfo of the file, built from the first chunk.
+  DatasetInfo info;
+  //! Whether the first chunk has been read.
+  bool initialized;
+  //! The number of lines that were skipped.
+  size_t skippedLines;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "csv_chunk_reader_impl.hpp"
+
+#endif
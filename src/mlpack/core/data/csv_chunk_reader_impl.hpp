@@ -0,0 +1,180 @@
+/**
+ * @file core/data/csv_chunk_reader_impl.hpp
+ *
+ * Implementation of the CSVChunkReader class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CSV_CHUNK_READER_IMPL_HPP
+#define MLPACK_CORE_DATA_CSV_CHUNK_READER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "csv_chunk_reader.hpp"
+
+namespace mlpack {
+namespace data {
+
+inline CSVChunkReader::CSVChunkReader(const std::string& filename,
+                                      const char delimiter) :
+    filename(filename),
+    stream(filename),
+    delimiter(delimiter),
+    initialized(false),
+    skippedLines(0)
+{
+  if (!stream.is_open())
+  {
+    throw std::runtime_error("CSVChunkReader: cannot open '" + filename +
+        "' for reading!");
+  }
+}
+
+inline CSVChunkReader::CSVChunkReader(const std::string& filename,
+                                      const DatasetInfo& info,
+                                      const char delimiter) :
+    filename(filename),
+    stream(filename),
+    delimiter(delimiter),
+    info(info),
+    initialized(true),
+    skippedLines(0)
+{
+  if (!stream.is_open())
+  {
+    throw std::runtime_error("CSVChunkReader: cannot open '" + filename +
+        "' for reading!");
+  }
+}
+
+template<typename eT>
+size_t CSVChunkReader::Read(arma::Mat<eT>& chunk, const size_t chunkSize)
+{
+  std::vector<std::string> tokens;
+  if (!initialized)
+  {
+    // Keep the tokens of the first chunk, so that the type of each dimension
+    // is known before any of them is mapped.
+    std::vector<std::vector<std::string>> lines;
+    while (lines.size() < chunkSize && ReadTokens(tokens))
+    {
+      if (!lines.empty() && tokens.size() != lines[0].size())
+      {
+        ++skippedLines;
+        continue;
+      }
+
+      lines.push_back(std::move(tokens));
+    }
+
+    initialized = true;
+    if (lines.empty())
+    {
+      chunk.clear();
+      return 0;
+    }
+
+    const size_t dimensionality = lines[0].size();
+    info = DatasetInfo(dimensionality);
+    for (size_t i = 0; i < lines.size(); ++i)
+      for (size_t d = 0; d < dimensionality; ++d)
+        info.MapFirstPass<eT>(lines[i][d], d);
+
+    chunk.set_size(dimensionality, lines.size());
+    for (size_t i = 0; i < lines.size(); ++i)
+      for (size_t d = 0; d < dimensionality; ++d)
+        chunk(d, i) = info.MapString<eT>(lines[i][d], d);
+
+    return chunk.n_cols;
+  }
+
+  if (info.Dimensionality() == 0)
+  {
+    chunk.clear();
+    return 0;
+  }
+
+  chunk.set_size(info.Dimensionality(), chunkSize);
+  size_t points = 0;
+  while (points < chunkSize && ReadTokens(tokens))
+  {
+    if (MapTokens(tokens, chunk.colptr(points)))
+      ++points;
+    else
+      ++skippedLines;
+  }
+
+  if (points < chunkSize)
+    chunk.resize(info.Dimensionality(), points);
+
+  return points;
+}
+
+inline void CSVChunkReader::Reset()
+{
+  stream.clear();
+  stream.seekg(0, std::ios::beg);
+}
+
+inline bool CSVChunkReader::ReadTokens(std::vector<std::string>& tokens)
+{
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    Trim(line);
+    if (line.empty())
+      continue;
+
+    tokens = Tokenize(line, delimiter, '"');
+    for (size_t i = 0; i < tokens.size(); ++i)
+      Trim(tokens[i]);
+
+    return true;
+  }
+
+  return false;
+}
+
+template<typename eT>
+bool CSVChunkReader::MapTokens(const std::vector<std::string>& tokens,
+                               eT* column)
+{
+  if (tokens.size() != info.Dimensionality())
+    return false;
+
+  for (size_t d = 0; d < tokens.size(); ++d)
+  {
+    if (info.Type(d) == Datatype::numeric)
+    {
+      // Parse the value the same way the map policy did for the first chunk.
+      std::stringstream token(tokens[d]);
+      eT value;
+      token >> value;
+      if (token.fail() || !token.eof())
+        return false;
+
+      column[d] = value;
+    }
+    else
+    {
+      // Only the categories of the first chunk are known.
+      try
+      {
+        column[d] = (eT) info.UnmapValue(tokens[d], d);
+      }
+      catch (const std::invalid_argument&)
+      {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
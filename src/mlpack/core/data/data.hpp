@@ -28,13 +28,18 @@
 
 #include "binarize.hpp"
 #include "check_categorical_param.hpp"
+#include "chunked_reader.hpp"
 #include "confusion_matrix.hpp"
+#include "csv_chunk_reader.hpp"
 #include "dataset_mapper.hpp"
 #include "image_info.hpp"
 #include "imputer.hpp"
 #include "is_naninf.hpp"
+#include "mapped_dataset.hpp"
+#include "mapped_file.hpp"
 #include "normalize_labels.hpp"
 #include "one_hot_encoding.hpp"
+#include "rating_triples.hpp"
 #include "split_data.hpp"
 #include "string_algorithms.hpp"
 #include "types.hpp"
@@ -45,6 +45,7 @@ class MedianImputation
     std::vector<PairType> targets;
     // good elements are kept inside this vector.
     std::vector<double> elemsToKeep;
+    elemsToKeep.reserve(columnMajor ? input.n_cols : input.n_rows);
 
     if (columnMajor)
     {
@@ -77,8 +78,22 @@ class MedianImputation
       }
     }
 
-    // calculate median
-    const double median = arma::median(arma::vec(elemsToKeep));
+    if (elemsToKeep.empty())
+      Log::Fatal << "it is impossible to calculate median; no valid elements "
+          << "in the dimension" << std::endl;
+
+    // Calculate the median by selection, which is linear (the elements do not
+    // need to be sorted).  For an even number of elements, the lower middle
+    // element is the largest element before the upper middle one.
+    const size_t middle = elemsToKeep.size() / 2;
+    std::nth_element(elemsToKeep.begin(), elemsToKeep.begin() + middle,
+        elemsToKeep.end());
+    double median = elemsToKeep[middle];
+    if (elemsToKeep.size() % 2 == 0)
+    {
+      median = (median + *std::max_element(elemsToKeep.begin(),
+          elemsToKeep.begin() + middle)) / 2.0;
+    }
 
     for (const PairType& target : targets)
     {
@@ -15,6 +15,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include "dataset_mapper.hpp"
+#include "imputation_methods/listwise_deletion.hpp"
 #include "map_policies/missing_policy.hpp"
 #include "map_policies/increment_policy.hpp"
 
@@ -65,6 +66,60 @@ class Imputer
     strategy.Impute(input, mappedValue, dimension, columnMajor);
   }
 
+  /**
+  * Given an input dataset, replace missing values of each of the given
+  * dimensions with the imputation strategy, like calling Impute() for each
+  * dimension.  The dimensions are imputed in parallel, so the strategy must
+  * only change the elements of the dimension it is given; ListwiseDeletion,
+  * which removes points, imputes the dimensions one at a time.
+  *
+  * @param input Input dataset to apply imputation.
+  * @param missingValue User defined missing value; it can be anything.
+  * @param dimensions Dimensions to apply the imputation.
+  */
+  void Impute(arma::Mat<T>& input,
+              const std::string& missingValue,
+              const std::vector<size_t>& dimensions)
+  {
+    // Unmapping may throw, so do it before imputing anything.
+    std::vector<T> mappedValues(dimensions.size());
+    for (size_t i = 0; i < dimensions.size(); ++i)
+    {
+      mappedValues[i] = static_cast<T>(mapper.UnmapValue(missingValue,
+          dimensions[i]));
+    }
+
+    if (std::is_same<StrategyType, ListwiseDeletion<T>>::value)
+    {
+      for (size_t i = 0; i < dimensions.size(); ++i)
+        strategy.Impute(input, mappedValues[i], dimensions[i], columnMajor);
+      return;
+    }
+
+    // Exceptions cannot leave the parallel region, so the first one is thrown
+    // after it.
+    std::exception_ptr exception;
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < dimensions.size(); ++i)
+    {
+      try
+      {
+        strategy.Impute(input, mappedValues[i], dimensions[i], columnMajor);
+      }
+      catch (...)
+      {
+        #pragma omp critical
+        {
+          if (!exception)
+            exception = std::current_exception();
+        }
+      }
+    }
+
+    if (exception)
+      std::rethrow_exception(exception);
+  }
+
   //! Get the strategy.
   const StrategyType& Strategy() const { return strategy; }
 
@@ -24,6 +24,7 @@
 #include "load_csv.hpp"
 #include "load_arff.hpp"
 #include "load_image.hpp"
+#include "mapped_dataset.hpp"
 
 namespace mlpack {
 namespace data /** Functions to load and save matrices and models. */ {
@@ -45,6 +46,12 @@ namespace data /** Functions to load and save matrices and models. */ {
  *  - Armadillo binary (arma::arma_binary), denoted by .bin
  *  - HDF5 (arma::hdf5_binary), denoted by .hdf, .hdf5, .h5, or .he5
  *
+ * mlpack's binary dataset format (see MappedDataset), denoted by .mlds, is
+ * also supported; since such a file already holds one point per column, the
+ * `transpose` parameter is ignored for it, and its elements are converted to
+ * `eT` if necessary.  To use the file without copying it, load it into a
+ * MappedDataset instead.
+ *
  * By default, this function will try to automatically determine the type of
  * file to load based on its extension and by inspecting the file.  If you know
  * the file type and want to specify it manually, override the default
@@ -188,6 +195,9 @@ bool Load(const std::string& filename,
  * - TSV (raw_ascii), denoted by .tsv, .csv, or .txt
  * - ASCII (raw_ascii), denoted by .txt
  *
+ * mlpack's binary dataset format (see MappedDataset), denoted by .mlds, can
+ * also be loaded if `info` is a DatasetInfo; `transpose` is then ignored.
+ *
  * If the file extension is not one of those types, an error will be given.
  * This is preferable to Armadillo's default behavior of loading an unknown
  * filetype as raw_binary, which can have very confusing effects.
@@ -220,6 +230,24 @@ bool Load(const std::string& filename,
           const bool fatal = false,
           const bool transpose = true);
 
+/**
+ * Map a dataset in mlpack's binary dataset format (denoted by .mlds) into
+ * memory; the matrix of `dataset` then aliases the mapped file, so that
+ * nothing is copied.  See MappedDataset for details.
+ *
+ * If the parameter 'fatal' is set to true, a std::runtime_error exception will
+ * be thrown if the dataset does not load successfully.
+ *
+ * @param filename Name of file to map.
+ * @param dataset MappedDataset to map the file into.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT>
+bool Load(const std::string& filename,
+          MappedDataset<eT>& dataset,
+          const bool fatal = false);
+
 /**
  * Load a model from a file, guessing the filetype from the extension, or,
  * optionally, loading the specified format.  If automatic extension detection
@@ -44,15 +44,24 @@ void LoadARFF(const std::string& filename, arma::Mat<eT>& matrix);
  * loading the training set is not used, then the test set may be loaded with
  * different mappings---which can cause horrible problems!
  *
+ * The @data section is parsed in parallel, from a memory mapping of the file
+ * when possible: it is split into chunks of lines, and the values of each
+ * chunk are converted, and its categories collected, by one thread.  The
+ * categories of the chunks are then mapped in order, so that the mappings are
+ * the same as if the file were read line by line.
+ *
  * @param filename Name of ARFF file to load.
  * @param matrix Matrix to load data into.
  * @param info DatasetInfo object; can be default-constructed or pre-existing
  *     from another call to LoadARFF().
+ * @param chunkSize Approximate size of each chunk of the @data section, in
+ *     bytes.
  */
 template<typename eT, typename PolicyType>
 void LoadARFF(const std::string& filename,
               arma::Mat<eT>& matrix,
-              DatasetMapper<PolicyType>& info);
+              DatasetMapper<PolicyType>& info,
+              const size_t chunkSize = 4 * 1024 * 1024);
 
 } // namespace data
 } // namespace mlpack
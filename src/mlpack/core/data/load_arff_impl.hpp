@@ -14,8 +14,9 @@
 
 // In case it hasn't been included yet.
 #include "load_arff.hpp"
+#include "load_csv.hpp"
+#include "mapped_file.hpp"
 #include "string_algorithms.hpp"
-#include "is_naninf.hpp"
 
 namespace mlpack {
 namespace data {
@@ -23,7 +24,8 @@ namespace data {
 template<typename eT, typename PolicyType>
 void LoadARFF(const std::string& filename,
               arma::Mat<eT>& matrix,
-              DatasetMapper<PolicyType>& info)
+              DatasetMapper<PolicyType>& info,
+              const size_t chunkSize)
 {
   // First, open the file.
   std::ifstream ifs;
@@ -171,120 +173,234 @@ void LoadARFF(const std::string& filename,
     }
   }
 
-  // We need to find out how many lines of data are in the file.
-  std::streampos pos = ifs.tellg();
-  size_t row = 0;
-  while (ifs.good())
+  // The data section is parsed from memory, in parallel over chunks of lines.
+  // The file is mapped if possible; otherwise the rest of it is read.
+  const size_t dataOffset = size_t(ifs.tellg());
+  std::unique_ptr<MappedFile> file;
+  std::string contents;
+  try
   {
-    std::getline(ifs, line, '\n');
-    ++row;
+    file.reset(new MappedFile(filename));
+  }
+  catch (const std::runtime_error& e)
+  {
+    Log::Debug << e.what() << "  Reading the data section instead."
+        << std::endl;
+    contents.assign(std::istreambuf_iterator<char>(ifs),
+        std::istreambuf_iterator<char>());
   }
-  // Uncount the EOF row.
-  --row;
+  const char* data = file ? file->Data() + dataOffset : contents.data();
+  const size_t size = file ? file->Size() - dataOffset : contents.size();
 
-  // Since we've hit the EOF, we have to call clear() so we can seek again.
-  ifs.clear();
-  ifs.seekg(pos);
+  // Split the data section into chunks that end just after a newline.
+  std::vector<size_t> starts(1, 0);
+  while (starts.back() < size)
+  {
+    size_t next = std::min(starts.back() + std::max(chunkSize, size_t(1)),
+        size);
+    if (next < size)
+    {
+      const char* newline = (const char*) std::memchr(data + next - 1, '\n',
+          size - next + 1);
+      next = (newline == NULL) ? size : size_t(newline - data) + 1;
+    }
 
-  // Now, set the size of the matrix.
-  matrix.set_size(dimensionality, row);
+    starts.push_back(next);
+  }
+  const size_t numChunks = starts.size() - 1;
 
-  // Now we are looking at the @data section.
-  row = 0;
-  while (ifs.good())
+  // Each line of the @data section holds a point, except empty lines and
+  // comments.
+  auto isPoint = [](const char* p, const char* lineEnd)
   {
-    std::getline(ifs, line, '\n');
-    Trim(line);
-    // Each line of the @data section must be a CSV (except sparse data, which
-    // we will handle later).  So now we can tokenize the
-    // CSV and parse it.  The '?' representing a missing value is not allowed,
-    // so if that occurs we throw an exception.  We also throw an exception if
-    // any piece of data does not match its type (categorical or numeric).
-
-    // If the first character is {, it is sparse data, and we can just say this
-    // is not handled for now...
-    if (line[0] == '{')
-      throw std::runtime_error("cannot yet parse sparse ARFF data");
-
-    // Tokenize the line.
-    std::vector<std::string> tok = Tokenize(line, ',', '"');
-
-    size_t col = 0;
-    std::stringstream token;
-    for (std::vector<std::string>::iterator it = tok.begin(); it != tok.end();
-         ++it)
+    while (p < lineEnd && std::isspace(*p))
+      ++p;
+    return (p < lineEnd && *p != '%');
+  };
+
+  // First pass: count the lines and the points of each chunk.
+  std::vector<size_t> chunkLines(numChunks, 0);
+  std::vector<size_t> chunkPoints(numChunks, 0);
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    const char* p = data + starts[c];
+    const char* end = data + starts[c + 1];
+    while (p < end)
+    {
+      const char* lineEnd = (const char*) std::memchr(p, '\n', end - p);
+      if (lineEnd == NULL)
+        lineEnd = end;
+
+      ++chunkLines[c];
+      if (isPoint(p, lineEnd))
+        ++chunkPoints[c];
+      p = lineEnd + 1;
+    }
+  }
+
+  std::vector<size_t> firstLine(numChunks, headerLines + 1);
+  std::vector<size_t> firstPoint(numChunks, 0);
+  for (size_t c = 1; c < numChunks; ++c)
+  {
+    firstLine[c] = firstLine[c - 1] + chunkLines[c - 1];
+    firstPoint[c] = firstPoint[c - 1] + chunkPoints[c - 1];
+  }
+  const size_t numPoints = (numChunks == 0) ? 0 :
+      firstPoint[numChunks - 1] + chunkPoints[numChunks - 1];
+
+  // Missing trailing values are filled with 0.
+  matrix.zeros(dimensionality, numPoints);
+
+  // Second pass: convert the numeric values, and map the categorical values of
+  // each chunk with its own dictionaries; each category gets the index of its
+  // first appearance in the chunk.  The first error of each chunk is kept.
+  // The '?' representing a missing value is not allowed, and any piece of data
+  // that does not match its type (categorical or numeric) is an error.
+  std::vector<std::vector<std::vector<std::string>>> categories(numChunks,
+      std::vector<std::vector<std::string>>(dimensionality));
+  std::vector<std::vector<std::vector<size_t>>> categoryLines(numChunks,
+      std::vector<std::vector<size_t>>(dimensionality));
+  std::vector<std::string> errors(numChunks);
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    std::vector<std::unordered_map<std::string, size_t>> dictionaries(
+        dimensionality);
+    LoadCSV converter;
+    const char* p = data + starts[c];
+    const char* end = data + starts[c + 1];
+    size_t lineNumber = firstLine[c];
+    size_t point = firstPoint[c];
+    for (; p < end && errors[c].empty(); ++lineNumber)
     {
-      // Check that we are not too many columns in.
-      if (col >= matrix.n_rows)
+      const char* lineEnd = (const char*) std::memchr(p, '\n', end - p);
+      if (lineEnd == NULL)
+        lineEnd = end;
+
+      const bool hasPoint = isPoint(p, lineEnd);
+      std::string line(p, lineEnd);
+      p = lineEnd + 1;
+      if (!hasPoint)
+        continue;
+
+      Trim(line);
+      // If the first character is {, it is sparse data, and we can just say
+      // this is not handled for now...
+      if (line[0] == '{')
       {
-        std::stringstream error;
-        error << "Too many columns in line " << (headerLines + row) << ".";
-        throw std::runtime_error(error.str());
+        errors[c] = "cannot yet parse sparse ARFF data";
+        break;
       }
 
-      // What should this token be?
-      if (info.Type(col) == Datatype::categorical)
+      std::vector<std::string> tok = Tokenize(line, ',', '"');
+      if (tok.size() > dimensionality)
       {
-        // Strip spaces before mapping.
-        std::string token = *it;
-        Trim(token);
-        const size_t currentNumMappings = info.NumMappings(col);
-        const eT result = info.template MapString<eT>(token, col);
-
-        // If the set of categories was pre-specified, then we must crash if
-        // this was not one of those categories.
-        if (categoryStrings.count(col) > 0 &&
-            currentNumMappings < info.NumMappings(col))
-        {
-          std::stringstream error;
-          error << "Parse error at line " << (headerLines + row) << " token "
-              << col << ": category \"" << token << "\" not in the set of known"
-              << " categories for this dimension (";
-          for (size_t i = 0; i < categoryStrings.at(col).size() - 1; ++i)
-            error << "\"" << categoryStrings.at(col)[i] << "\", ";
-          error << "\"" << categoryStrings.at(col).back() << "\").";
-          throw std::runtime_error(error.str());
-        }
-
-        // We load transposed.
-        matrix(col, row) = result;
+        std::ostringstream error;
+        error << "Too many columns in line " << lineNumber << ".";
+        errors[c] = error.str();
+        break;
       }
-      else if (info.Type(col) == Datatype::numeric)
+
+      for (size_t col = 0; col < tok.size(); ++col)
       {
-        // Attempt to read as numeric.
-        token.clear();
-        token.str(*it);
+        std::string& token = tok[col];
+        Trim(token);
 
-        eT val = eT(0);
-        token >> val;
+        if (types[col])
+        {
+          auto it = dictionaries[col].find(token);
+          if (it == dictionaries[col].end())
+          {
+            it = dictionaries[col].emplace(token,
+                categories[c][col].size()).first;
+            categories[c][col].push_back(std::move(token));
+            categoryLines[c][col].push_back(lineNumber);
+          }
 
-        if (token.fail())
+          // We load transposed.
+          matrix(col, point) = eT(it->second);
+        }
+        else
         {
-          // Check for NaN or inf.
-          if (!IsNaNInf(val, token.str()))
+          // Empty tokens are not numbers (unlike for CSV files).
+          eT val = eT(0);
+          if (token.empty() || token == "?" ||
+              !converter.ConvertToken(val, token))
           {
-            // Okay, it's not NaN or inf.  If it's '?', we issue a specific
-            // error, otherwise we issue a general error.
-            std::stringstream error;
-            std::string tokenStr = token.str();
-            Trim(tokenStr);
-            if (tokenStr == "?")
+            // If it's '?', we issue a specific error, otherwise we issue a
+            // general error.
+            std::ostringstream error;
+            if (token == "?")
               error << "Missing values ('?') not supported, ";
             else
               error << "Parse error ";
-            error << "at line " << (headerLines + row) << " token " << col
-                << ": \"" << tokenStr << "\".";
-            throw std::runtime_error(error.str());
+            error << "at line " << lineNumber << " token " << col << ": \""
+                << token << "\".";
+            errors[c] = error.str();
+            break;
           }
+
+          matrix(col, point) = val; // We load transposed.
         }
+      }
 
-        // If we made it to here, we have a value.
-        matrix(col, row) = val; // We load transposed.
+      ++point;
+    }
+  }
+
+  for (size_t c = 0; c < numChunks; ++c)
+    if (!errors[c].empty())
+      throw std::runtime_error(errors[c]);
+
+  // Merge the dictionaries in the order of the chunks, so that each category
+  // is mapped in the order of its first appearance in the file, but only once
+  // for each chunk.
+  std::vector<std::vector<std::vector<eT>>> codes(numChunks,
+      std::vector<std::vector<eT>>(dimensionality));
+  for (size_t d = 0; d < dimensionality; ++d)
+  {
+    if (!types[d])
+      continue;
+
+    for (size_t c = 0; c < numChunks; ++c)
+    {
+      codes[c][d].resize(categories[c][d].size());
+      for (size_t k = 0; k < categories[c][d].size(); ++k)
+      {
+        const std::string& token = categories[c][d][k];
+        const size_t currentNumMappings = info.NumMappings(d);
+        codes[c][d][k] = info.template MapString<eT>(token, d);
+
+        // If the set of categories was pre-specified, then we must crash if
+        // this was not one of those categories.
+        if (categoryStrings.count(d) > 0 &&
+            currentNumMappings < info.NumMappings(d))
+        {
+          std::stringstream error;
+          error << "Parse error at line " << categoryLines[c][d][k]
+              << " token " << d << ": category \"" << token << "\" not in the "
+              << "set of known categories for this dimension (";
+          for (size_t i = 0; i < categoryStrings.at(d).size() - 1; ++i)
+            error << "\"" << categoryStrings.at(d)[i] << "\", ";
+          error << "\"" << categoryStrings.at(d).back() << "\").";
+          throw std::runtime_error(error.str());
+        }
       }
+    }
+  }
 
-      ++col;
+  // Replace the indices of each chunk with the codes of the DatasetInfo.
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    for (size_t point = firstPoint[c]; point < firstPoint[c] + chunkPoints[c];
+        ++point)
+    {
+      for (size_t d = 0; d < dimensionality; ++d)
+        if (types[d])
+          matrix(d, point) = codes[c][d][size_t(matrix(d, point))];
     }
-    ++row;
   }
 }
 
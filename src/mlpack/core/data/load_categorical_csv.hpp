@@ -221,6 +221,14 @@ template<typename T, typename PolicyType>
 void LoadCSV::TransposeParse(arma::Mat<T>& inout,
                              DatasetMapper<PolicyType>& infoSet)
 {
+  // The mappings of a DatasetInfo only depend on the order in which the
+  // categories first appear, so they can be built in parallel.
+  if constexpr (std::is_same<PolicyType, IncrementPolicy>::value)
+  {
+    ParallelTransposeParse(inout, infoSet);
+    return;
+  }
+
   // Get matrix size.  This also initializes infoSet correctly.
   size_t rows, cols;
   InitializeTransposeMapper<T>(rows, cols, infoSet);
@@ -346,6 +354,219 @@ void LoadCSV::NonTransposeParse(arma::Mat<T>& inout,
   }
 }
 
+template<typename T>
+void LoadCSV::ParallelTransposeParse(arma::Mat<T>& inout,
+                                     DatasetInfo& infoSet)
+{
+  // Read every line; each one holds a point.
+  std::vector<std::string> lines;
+  std::string line;
+  inFile.clear();
+  inFile.seekg(0, std::ios::beg);
+  while (std::getline(inFile, line))
+  {
+    Trim(line);
+    lines.push_back(std::move(line));
+  }
+
+  // Use a few chunks for each thread, to balance the load.
+  size_t numThreads = 1;
+  #ifdef MLPACK_USE_OPENMP
+  numThreads = omp_get_max_threads();
+  #endif
+  const size_t numChunks = std::max<size_t>(1,
+      std::min(lines.size(), 4 * numThreads));
+  std::vector<size_t> starts(numChunks + 1);
+  for (size_t c = 0; c <= numChunks; ++c)
+    starts[c] = c * lines.size() / numChunks;
+
+  // First pass: count the tokens of each line, and find, in each chunk, a
+  // token of each dimension that is not a number (if there is one).
+  std::vector<size_t> counts(lines.size());
+  std::vector<std::vector<std::string>> failedTokens(numChunks);
+  std::vector<std::vector<char>> failed(numChunks);
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    std::vector<std::string> tokens;
+    for (size_t i = starts[c]; i < starts[c + 1]; ++i)
+    {
+      SplitCategoricalLine(lines[i], tokens);
+      counts[i] = tokens.size();
+      if (failed[c].size() < tokens.size())
+      {
+        failed[c].resize(tokens.size(), 0);
+        failedTokens[c].resize(tokens.size());
+      }
+
+      for (size_t d = 0; d < tokens.size(); ++d)
+      {
+        if (failed[c][d])
+          continue;
+
+        std::stringstream token(tokens[d]);
+        T val;
+        token >> val;
+        if (token.fail() || !token.eof())
+        {
+          failed[c][d] = 1;
+          failedTokens[c][d] = std::move(tokens[d]);
+        }
+      }
+    }
+  }
+
+  // The dimensionality is the largest number of tokens on the lines before
+  // the first empty one, as for TransposeParse().
+  size_t rows = 0;
+  for (size_t i = 0; i < lines.size() && !lines[i].empty(); ++i)
+    rows = std::max(rows, counts[i]);
+
+  if (infoSet.Dimensionality() == 0)
+  {
+    infoSet.SetDimensionality(rows);
+  }
+  else if (infoSet.Dimensionality() != rows)
+  {
+    std::ostringstream oss;
+    oss << "data::LoadCSV(): given DatasetInfo has dimensionality "
+        << infoSet.Dimensionality() << ", but data has dimensionality "
+        << rows;
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (lines.empty())
+  {
+    inout.set_size(rows, 0);
+    return;
+  }
+
+  for (size_t i = 0; i < lines.size(); ++i)
+  {
+    if (counts[i] != rows)
+    {
+      std::ostringstream oss;
+      oss << "LoadCSV::TransposeParse(): wrong number of dimensions ("
+          << counts[i] << ") on line " << i << "; should be " << rows
+          << " dimensions.";
+      throw std::runtime_error(oss.str());
+    }
+  }
+
+  // Let the policy set the type of each dimension, from a token that is not a
+  // number if there is one (the policy may also force all the mappings).
+  std::vector<std::string> firstTokens;
+  SplitCategoricalLine(lines[0], firstTokens);
+  for (size_t d = 0; d < rows; ++d)
+  {
+    size_t c = 0;
+    while (c < numChunks && (d >= failed[c].size() || !failed[c][d]))
+      ++c;
+
+    infoSet.template MapFirstPass<T>(
+        (c < numChunks) ? failedTokens[c][d] : firstTokens[d], d);
+  }
+
+  std::vector<char> categorical(rows);
+  for (size_t d = 0; d < rows; ++d)
+    categorical[d] = (infoSet.Type(d) == Datatype::categorical);
+
+  // Second pass: map each chunk with its own dictionaries; each category gets
+  // the index of its first appearance in the chunk.
+  const size_t cols = lines.size();
+  inout.set_size(rows, cols);
+  std::vector<std::vector<std::vector<std::string>>> categories(numChunks,
+      std::vector<std::vector<std::string>>(rows));
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    std::vector<std::unordered_map<std::string, size_t>> dictionaries(rows);
+    std::vector<std::string> tokens;
+    for (size_t col = starts[c]; col < starts[c + 1]; ++col)
+    {
+      SplitCategoricalLine(lines[col], tokens);
+      for (size_t d = 0; d < rows; ++d)
+      {
+        if (categorical[d])
+        {
+          auto it = dictionaries[d].find(tokens[d]);
+          if (it == dictionaries[d].end())
+          {
+            it = dictionaries[d].emplace(tokens[d],
+                categories[c][d].size()).first;
+            categories[c][d].push_back(std::move(tokens[d]));
+          }
+          inout(d, col) = T(it->second);
+        }
+        else
+        {
+          // Every token of a numeric dimension is a number.
+          std::stringstream token(tokens[d]);
+          token >> inout(d, col);
+        }
+      }
+    }
+  }
+
+  // Merge the dictionaries in the order of the chunks; only the categories of
+  // each chunk are mapped, not every token.
+  std::vector<std::vector<std::vector<T>>> codes(numChunks,
+      std::vector<std::vector<T>>(rows));
+  for (size_t d = 0; d < rows; ++d)
+  {
+    if (!categorical[d])
+      continue;
+
+    for (size_t c = 0; c < numChunks; ++c)
+    {
+      codes[c][d].resize(categories[c][d].size());
+      for (size_t k = 0; k < categories[c][d].size(); ++k)
+      {
+        codes[c][d][k] = infoSet.template MapString<T>(
+            std::move(categories[c][d][k]), d);
+      }
+    }
+  }
+
+  // Replace the indices of each chunk with the codes of the DatasetInfo.
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    for (size_t col = starts[c]; col < starts[c + 1]; ++col)
+      for (size_t d = 0; d < rows; ++d)
+        if (categorical[d])
+          inout(d, col) = codes[c][d][size_t(inout(d, col))];
+  }
+}
+
+inline void LoadCSV::SplitCategoricalLine(const std::string& line,
+                                          std::vector<std::string>& tokens)
+{
+  tokens.clear();
+  std::stringstream lineStream(line);
+  std::string token;
+  while (lineStream.good())
+  {
+    std::getline(lineStream, token, delim);
+    // Remove whitespace from either side.
+    Trim(token);
+
+    if (!token.empty() && token[0] == '"' && token[token.size() - 1] != '"')
+    {
+      std::string tok = token;
+      while (lineStream.good() &&
+          (token.empty() || token[token.size() - 1] != '"'))
+      {
+        tok += delim;
+        std::getline(lineStream, token, delim);
+        tok += token;
+      }
+      token = tok;
+    }
+    tokens.push_back(std::move(token));
+  }
+}
+
 } //namespace data
 } //namespace mlpack
 
@@ -43,6 +43,8 @@
 #define MLPACK_CORE_DATA_LOAD_CSV_HPP
 
 #include <mlpack/core/util/log.hpp>
+#include <charconv>
+#include <cstring>
 #include <set>
 #include <string>
 
@@ -51,6 +53,7 @@
 #include "format.hpp"
 #include "dataset_mapper.hpp"
 #include "types.hpp"
+#include "mapped_file.hpp"
 
 namespace mlpack {
 namespace data {
@@ -113,6 +116,28 @@ class LoadCSV
   template<typename eT>
   bool LoadNumericCSV(arma::Mat<eT>& x, std::fstream& f);
 
+  /**
+   * Returns a bool value showing whether data was loaded successfully or not.
+   *
+   * Parses a csv file that has been mapped into memory, and loads the data
+   * into the given matrix; the result is the same as for the stream version
+   * above (followed by a transposition if `transpose` is true).  The file is
+   * split into chunks that start at the beginning of a line, and the chunks
+   * are parsed in parallel: a first pass counts the lines and columns of each
+   * chunk, and a second pass converts the values and writes them directly to
+   * their place in the matrix, so that no transposition is needed.
+   *
+   * @param x Matrix in which data will be loaded.
+   * @param file Mapped data file.
+   * @param transpose If true, each line of the file is a column of x.
+   * @param chunkSize Approximate size of each chunk, in bytes.
+   */
+  template<typename eT>
+  bool LoadNumericCSV(arma::Mat<eT>& x,
+                      const MappedFile& file,
+                      const bool transpose,
+                      const size_t chunkSize = 4 * 1024 * 1024);
+
   /**
   * Converts the given string token to assigned datatype and assigns
   * this value to the given address. The address here will be a
@@ -127,6 +152,18 @@ class LoadCSV
   template<typename eT>
   bool ConvertToken(eT& val, const std::string& token);
 
+  /**
+   * Convert the token between `begin` and `end` like the version above.
+   * Plain numbers are converted with std::from_chars(), without copying the
+   * token; other tokens are handed to the version above.
+   *
+   * @param val Token's value will be assigned to this address.
+   * @param begin Start of the token.
+   * @param end End of the token.
+   */
+  template<typename eT>
+  bool ConvertToken(eT& val, const char* begin, const char* end);
+
   /**
    * Calculate the number of columns in each row
    * and assign the value to the col. This function
@@ -295,6 +332,30 @@ class LoadCSV
   template<typename T, typename PolicyType>
   void TransposeParse(arma::Mat<T>& inout, DatasetMapper<PolicyType>& infoSet);
 
+  /**
+  * Parse a transposed matrix in parallel, with the same result as
+  * TransposeParse() with a DatasetInfo.  The file is split into chunks of
+  * lines; each chunk is mapped with its own dictionary for each categorical
+  * dimension, and the dictionaries are then merged into the DatasetInfo in
+  * the order of the chunks, so that each category gets the same code as if
+  * the file had been mapped sequentially.
+  *
+  * @param input Matrix to load into.
+  * @param infoSet DatasetInfo to load with.
+  */
+  template<typename T>
+  void ParallelTransposeParse(arma::Mat<T>& inout, DatasetInfo& infoSet);
+
+  /**
+  * Split the given line into tokens like TransposeParse() does: each token is
+  * trimmed, and quoted tokens may contain the delimiter.
+  *
+  * @param line Line to split.
+  * @param tokens Vector to store the tokens in.
+  */
+  inline void SplitCategoricalLine(const std::string& line,
+                                   std::vector<std::string>& tokens);
+
   //! Extension (type) of file.
   std::string extension;
   //! Name of file.
@@ -64,21 +64,56 @@ bool Load(const std::string& filename,
           const bool fatal = false);
 
 /**
- * Load the image file into the given matrix.
+ * Load the image files into the given matrix, one image per column.  The
+ * images are decoded in parallel, directly into their column of the matrix.
+ *
+ * The images are converted to the number of channels of the given ImageInfo
+ * (between 1 and 4, where 1 is grayscale and 3 is RGB, the default).  If
+ * `resize` is true, every image is also resized, with bilinear
+ * interpolation, to the width and height of the ImageInfo, so that images of
+ * different sizes can be loaded together; otherwise the size of the first
+ * image is stored in the ImageInfo, and every image must have that size.
  *
  * @param files A vector consisting of filenames.
  * @param matrix Matrix to save the image from.
  * @param info An object of ImageInfo class.
  * @param fatal If an error should be reported as fatal (default false).
+ * @param resize If true, resize every image to the size of the ImageInfo
+ *     (default false).
  * @return Boolean value indicating success or failure of load.
  */
 template<typename eT>
 bool Load(const std::vector<std::string>& files,
           arma::Mat<eT>& matrix,
           ImageInfo& info,
-          const bool fatal = false);
+          const bool fatal = false,
+          const bool resize = false);
+
+/**
+ * Resize an image, with its channels interleaved (as stored by Load()), with
+ * bilinear interpolation.  If the size does not change, the image is only
+ * copied.
+ *
+ * @param image Pixels of the image to resize.
+ * @param width Width of the image.
+ * @param height Height of the image.
+ * @param channels Number of channels of the image.
+ * @param output Memory to store the newWidth * newHeight * channels pixels of
+ *     the resized image in.
+ * @param newWidth Width of the resized image.
+ * @param newHeight Height of the resized image.
+ */
+template<typename eT>
+void ResizeImage(const unsigned char* image,
+                 const size_t width,
+                 const size_t height,
+                 const size_t channels,
+                 eT* output,
+                 const size_t newWidth,
+                 const size_t newHeight);
 
-// Implementation found in load_image.hpp.
+// Implementation found in load_image_impl.hpp.  The image is converted to the
+// number of channels of the ImageInfo (between 1 and 4; 3 otherwise).
 inline bool LoadImage(const std::string& filename,
                       arma::Mat<unsigned char>& matrix,
                       ImageInfo& info,
@@ -50,7 +50,8 @@ template<typename eT>
 bool Load(const std::vector<std::string>& files,
           arma::Mat<eT>& matrix,
           ImageInfo& info,
-          const bool fatal)
+          const bool fatal,
+          const bool resize)
 {
   if (files.size() == 0)
   {
@@ -65,29 +66,148 @@ bool Load(const std::vector<std::string>& files,
     return false;
   }
 
-  arma::Mat<unsigned char> img;
-  bool status = LoadImage(files[0], img, info, fatal);
+  if (resize && (info.Width() == 0 || info.Height() == 0 ||
+      info.Channels() == 0 || info.Channels() > 4))
+  {
+    std::ostringstream oss;
+    oss << "Load(): the width, the height and the number of channels (between "
+        << "1 and 4) of the ImageInfo must be set to resize images."
+        << std::endl;
+
+    if (fatal)
+      Log::Fatal << oss.str();
+    else
+      Log::Warn << oss.str();
 
-  if (!status)
     return false;
+  }
 
-  // Decide matrix dimension using the image height and width.
-  arma::Mat<unsigned char> tmpMatrix(
-      info.Width() * info.Height() * info.Channels(), files.size());
-  tmpMatrix.col(0) = img;
+  // Without resizing, the first image gives the size of every image.
+  size_t first = 0;
+  if (!resize)
+  {
+    arma::Mat<unsigned char> img;
+    if (!LoadImage(files[0], img, info, fatal))
+      return false;
 
-  for (size_t i = 1; i < files.size() ; ++i)
+    matrix.set_size(img.n_elem, files.size());
+    ResizeImage(img.memptr(), info.Width(), info.Height(), info.Channels(),
+        matrix.colptr(0), info.Width(), info.Height());
+    first = 1;
+  }
+  else
   {
-    arma::Mat<unsigned char> colImg(tmpMatrix.colptr(i), tmpMatrix.n_rows, 1,
-        false, true);
-    status = LoadImage(files[i], colImg, info, fatal);
+    matrix.set_size(info.Width() * info.Height() * info.Channels(),
+        files.size());
+  }
 
-    if (!status)
-      return false;
+  // Each image is decoded (and resized) into its column by one thread.
+  // Exceptions cannot leave the parallel region, so the first one is thrown
+  // after it.
+  bool success = true;
+  std::exception_ptr exception;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = first; i < files.size(); ++i)
+  {
+    try
+    {
+      ImageInfo imageInfo(0, 0, info.Channels());
+      arma::Mat<unsigned char> img;
+      bool status = LoadImage(files[i], img, imageInfo, fatal);
+
+      if (status && !resize && (imageInfo.Width() != info.Width() ||
+          imageInfo.Height() != info.Height()))
+      {
+        std::ostringstream oss;
+        oss << "Load(): image '" << files[i] << "' has size "
+            << imageInfo.Width() << "x" << imageInfo.Height() << ", but the "
+            << "first image has size " << info.Width() << "x" << info.Height()
+            << "; resize the images to load them together." << std::endl;
+
+        if (fatal)
+          Log::Fatal << oss.str();
+        else
+          Log::Warn << oss.str();
+
+        status = false;
+      }
+
+      if (status)
+      {
+        ResizeImage(img.memptr(), imageInfo.Width(), imageInfo.Height(),
+            info.Channels(), matrix.colptr(i), info.Width(), info.Height());
+      }
+      else
+      {
+        #pragma omp critical
+        success = false;
+      }
+    }
+    catch (...)
+    {
+      #pragma omp critical
+      {
+        if (!exception)
+          exception = std::current_exception();
+      }
+    }
   }
 
-  matrix = arma::conv_to<arma::Mat<eT>>::from(tmpMatrix);
-  return true;
+  if (exception)
+    std::rethrow_exception(exception);
+
+  return success;
+}
+
+template<typename eT>
+void ResizeImage(const unsigned char* image,
+                 const size_t width,
+                 const size_t height,
+                 const size_t channels,
+                 eT* output,
+                 const size_t newWidth,
+                 const size_t newHeight)
+{
+  if (width == newWidth && height == newHeight)
+  {
+    for (size_t i = 0; i < width * height * channels; ++i)
+      output[i] = eT(image[i]);
+    return;
+  }
+
+  // The centers of the pixels of the resized image are mapped to the
+  // original image, and interpolated from the four nearest pixels.
+  const double xScale = double(width) / double(newWidth);
+  const double yScale = double(height) / double(newHeight);
+  for (size_t y = 0; y < newHeight; ++y)
+  {
+    const double sourceY = std::min(std::max((y + 0.5) * yScale - 0.5, 0.0),
+        double(height - 1));
+    const size_t y0 = (size_t) sourceY;
+    const size_t y1 = std::min(y0 + 1, height - 1);
+    const double dy = sourceY - y0;
+
+    for (size_t x = 0; x < newWidth; ++x)
+    {
+      const double sourceX = std::min(std::max((x + 0.5) * xScale - 0.5,
+          0.0), double(width - 1));
+      const size_t x0 = (size_t) sourceX;
+      const size_t x1 = std::min(x0 + 1, width - 1);
+      const double dx = sourceX - x0;
+
+      for (size_t c = 0; c < channels; ++c)
+      {
+        const double top = (1.0 - dx) * image[(y0 * width + x0) * channels + c]
+            + dx * image[(y0 * width + x1) * channels + c];
+        const double bottom = (1.0 - dx) *
+            image[(y1 * width + x0) * channels + c] +
+            dx * image[(y1 * width + x1) * channels + c];
+        const double value = (1.0 - dy) * top + dy * bottom;
+        output[(y * newWidth + x) * channels + c] =
+            std::is_integral<eT>::value ? eT(std::round(value)) : eT(value);
+      }
+    }
+  }
 }
 
 #ifdef MLPACK_HAS_STB
@@ -124,17 +244,12 @@ inline bool LoadImage(const std::string& filename,
   // Temporary variables needed as stb_image.h supports int parameters.
   int tempWidth, tempHeight, tempChannels;
 
-  // For grayscale images.
-  if (info.Channels() == 1)
-  {
-    image = stbi_load(filename.c_str(), &tempWidth, &tempHeight, &tempChannels,
-        STBI_grey);
-  }
-  else
-  {
-    image = stbi_load(filename.c_str(), &tempWidth, &tempHeight, &tempChannels,
-        STBI_rgb);
-  }
+  // stb_image converts the image to the requested number of channels
+  // (grayscale, grayscale and alpha, RGB or RGBA); RGB by default.
+  const int channels = (info.Channels() >= 1 && info.Channels() <= 4) ?
+      (int) info.Channels() : STBI_rgb;
+  image = stbi_load(filename.c_str(), &tempWidth, &tempHeight, &tempChannels,
+      channels);
 
   if (!image)
   {
@@ -154,9 +269,7 @@ inline bool LoadImage(const std::string& filename,
 
   info.Width() = tempWidth;
   info.Height() = tempHeight;
-  // Only set the new number of channels if we didn't force grayscale loading.
-  if (info.Channels() != 1)
-    info.Channels() = tempChannels;
+  info.Channels() = channels;
 
   // Copy image into armadillo Mat.
   matrix = arma::Mat<unsigned char>(image, info.Width() * info.Height() *
@@ -108,6 +108,38 @@ bool Load(const std::string& filename,
     return false;
   }
 
+  // mlpack's own dataset format is not handled by Armadillo; the points are
+  // already stored as columns, so `transpose` is ignored.
+  if constexpr (std::is_arithmetic<eT>::value)
+  {
+    if (inputLoadType == FileType::AutoDetect &&
+        Extension(filename) == "mlds")
+    {
+      Log::Info << "Loading '" << filename << "' as mlpack dataset.  "
+          << std::flush;
+      try
+      {
+        DatasetInfo info;
+        MappedDataset<eT>::Read(filename, matrix, info);
+      }
+      catch (std::exception& e)
+      {
+        Timer::Stop("loading_data");
+        if (fatal)
+          Log::Fatal << e.what() << std::endl;
+        else
+          Log::Warn << e.what() << std::endl;
+
+        return false;
+      }
+
+      Log::Info << "Size is " << matrix.n_rows << " x " << matrix.n_cols
+          << ".\n";
+      Timer::Stop("loading_data");
+      return true;
+    }
+  }
+
   FileType loadType = inputLoadType;
   std::string stringType;
   if (inputLoadType == FileType::AutoDetect)
@@ -159,12 +191,36 @@ bool Load(const std::string& filename,
 
   // We can't use the stream if the type is HDF5.
   bool success;
+  bool transposed = false;
   LoadCSV loader;
 
   if (loadType != FileType::HDF5Binary)
   {
     if (loadType == FileType::CSVASCII)
-      success = loader.LoadNumericCSV(matrix, stream);
+    {
+      // Parse the file in parallel from memory if it can be mapped; the
+      // matrix is then written already transposed.
+      std::unique_ptr<MappedFile> file;
+      try
+      {
+        file.reset(new MappedFile(filename));
+      }
+      catch (const std::runtime_error& e)
+      {
+        Log::Debug << e.what() << "  Loading from a stream instead."
+            << std::endl;
+      }
+
+      if (file)
+      {
+        success = loader.LoadNumericCSV(matrix, *file, transpose);
+        transposed = transpose;
+      }
+      else
+      {
+        success = loader.LoadNumericCSV(matrix, stream);
+      }
+    }
     else
       success = matrix.load(stream, ToArmaFileType(loadType));
   }
@@ -183,11 +239,14 @@ bool Load(const std::string& filename,
     return false;
   }
   else
-    Log::Info << "Size is " << (transpose ? matrix.n_cols : matrix.n_rows)
-        << " x " << (transpose ? matrix.n_rows : matrix.n_cols) << ".\n";
+    Log::Info << "Size is "
+        << ((transpose && !transposed) ? matrix.n_cols : matrix.n_rows)
+        << " x "
+        << ((transpose && !transposed) ? matrix.n_rows : matrix.n_cols)
+        << ".\n";
 
   // Now transpose the matrix, if necessary.
-  if (transpose)
+  if (transpose && !transposed)
   {
     success = inplace_transpose(matrix, fatal);
   }
@@ -228,7 +287,41 @@ bool Load(const std::string& filename,
     return false;
   }
 
-  if (extension == "csv" || extension == "tsv" || extension == "txt")
+  if (extension == "mlds")
+  {
+    Log::Info << "Loading '" << filename << "' as mlpack dataset.  "
+        << std::flush;
+    try
+    {
+      if constexpr (std::is_same<PolicyType, IncrementPolicy>::value &&
+          std::is_arithmetic<eT>::value)
+      {
+        MappedDataset<eT>::Read(filename, matrix, info);
+      }
+      else
+      {
+        throw std::runtime_error("Cannot load '" + filename + "': mlpack "
+            "datasets can only be loaded with a DatasetInfo.");
+      }
+    }
+    catch (std::exception& e)
+    {
+      Timer::Stop("loading_data");
+      if (fatal)
+        Log::Fatal << e.what() << std::endl;
+      else
+        Log::Warn << e.what() << std::endl;
+
+      return false;
+    }
+
+    // The points are already stored as columns.
+    Log::Info << "Size is " << matrix.n_rows << " x " << matrix.n_cols
+        << ".\n";
+    Timer::Stop("loading_data");
+    return true;
+  }
+  else if (extension == "csv" || extension == "tsv" || extension == "txt")
   {
     Log::Info << "Loading '" << filename << "' as CSV dataset.  " << std::flush;
     try
@@ -294,6 +387,36 @@ bool Load(const std::string& filename,
   return true;
 }
 
+template<typename eT>
+bool Load(const std::string& filename,
+          MappedDataset<eT>& dataset,
+          const bool fatal)
+{
+  Timer::Start("loading_data");
+
+  Log::Info << "Mapping '" << filename << "' as mlpack dataset.  "
+      << std::flush;
+  try
+  {
+    dataset.Load(filename);
+  }
+  catch (std::exception& e)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << e.what() << std::endl;
+    else
+      Log::Warn << e.what() << std::endl;
+
+    return false;
+  }
+
+  Log::Info << "Size is " << dataset.Matrix().n_rows << " x "
+      << dataset.Matrix().n_cols << ".\n";
+  Timer::Stop("loading_data");
+  return true;
+}
+
 // For loading data into sparse matrix
 template <typename eT>
 bool Load(const std::string& filename,
@@ -174,6 +174,179 @@ bool LoadCSV::LoadNumericCSV(arma::Mat<eT>& x, std::fstream& f)
   return loadOkay;
 }
 
+template<typename eT>
+bool LoadCSV::ConvertToken(eT& val, const char* begin, const char* end)
+{
+  // strtod() skips leading whitespace and ignores what follows a number, so
+  // neither spaces after a delimiter nor a trailing carriage return (from a
+  // file with Windows line endings) change the value.
+  const char* first = begin;
+  while (first < end && (*first == ' ' || *first == '\t'))
+    ++first;
+  const char* last = (end > first && *(end - 1) == '\r') ? end - 1 : end;
+
+  // std::from_chars() does not accept everything strtod() accepts (a leading
+  // '+', for instance), so it is only a fast path for tokens that are a plain
+  // number.  Floating-point std::from_chars() is not available in every
+  // standard library.
+  #if defined(__cpp_lib_to_chars)
+  constexpr bool fastPath = std::is_floating_point<eT>::value ||
+      (std::is_integral<eT>::value && !std::is_same<eT, bool>::value);
+  #else
+  constexpr bool fastPath =
+      (std::is_integral<eT>::value && !std::is_same<eT, bool>::value);
+  #endif
+
+  if constexpr (fastPath)
+  {
+    if (last > first)
+    {
+      const std::from_chars_result result = std::from_chars(first, last, val);
+      if (result.ec == std::errc() && result.ptr == last)
+        return true;
+    }
+  }
+
+  return ConvertToken(val, std::string(begin, end));
+}
+
+template<typename eT>
+bool LoadCSV::LoadNumericCSV(arma::Mat<eT>& x,
+                             const MappedFile& file,
+                             const bool transpose,
+                             const size_t chunkSize)
+{
+  const char* data = file.Data();
+  const size_t size = file.Size();
+
+  // Split the file into chunks that end just after a newline.
+  std::vector<size_t> starts(1, 0);
+  while (starts.back() < size)
+  {
+    size_t next = std::min(starts.back() + std::max(chunkSize, size_t(1)),
+        size);
+    if (next < size)
+    {
+      const char* newline = (const char*) std::memchr(data + next - 1, '\n',
+          size - next + 1);
+      next = (newline == NULL) ? size : size_t(newline - data) + 1;
+    }
+
+    starts.push_back(next);
+  }
+  const size_t numChunks = starts.size() - 1;
+
+  // First pass: count the lines and columns of each chunk.  Like the stream
+  // version, loading stops at the first empty line, and the number of columns
+  // is the largest number of values of a line.
+  std::vector<size_t> chunkLines(numChunks, 0);
+  std::vector<size_t> chunkCols(numChunks, 0);
+  std::vector<char> chunkStops(numChunks, 0);
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    const char* p = data + starts[c];
+    const char* end = data + starts[c + 1];
+    while (p < end)
+    {
+      const char* lineEnd = (const char*) std::memchr(p, '\n', end - p);
+      if (lineEnd == NULL)
+        lineEnd = end;
+
+      if (lineEnd == p)
+      {
+        chunkStops[c] = 1;
+        break;
+      }
+
+      const size_t lineCols = std::count(p, lineEnd, ',') + 1;
+      chunkCols[c] = std::max(chunkCols[c], lineCols);
+      ++chunkLines[c];
+      p = lineEnd + 1;
+    }
+  }
+
+  // Find where each chunk starts in the matrix, and the size of the matrix.
+  size_t rows = 0;
+  size_t cols = 0;
+  size_t usedChunks = 0;
+  std::vector<size_t> firstRow(numChunks, 0);
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    firstRow[c] = rows;
+    rows += chunkLines[c];
+    cols = std::max(cols, chunkCols[c]);
+    ++usedChunks;
+    if (chunkStops[c])
+      break;
+  }
+
+  // Missing values are filled with 0.
+  if (transpose)
+    x.zeros(cols, rows);
+  else
+    x.zeros(rows, cols);
+
+  // Second pass: convert the values of each chunk.  The first token that
+  // cannot be converted is recorded for each chunk.
+  std::vector<size_t> failedRow(usedChunks, size_t(-1));
+  std::vector<size_t> failedCol(usedChunks, 0);
+  std::vector<std::string> failedToken(usedChunks);
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < usedChunks; ++c)
+  {
+    const char* p = data + starts[c];
+    const char* end = data + starts[c + 1];
+    for (size_t row = firstRow[c]; row < firstRow[c] + chunkLines[c]; ++row)
+    {
+      const char* lineEnd = (const char*) std::memchr(p, '\n', end - p);
+      if (lineEnd == NULL)
+        lineEnd = end;
+
+      const char* tokenStart = p;
+      for (size_t col = 0; ; ++col)
+      {
+        const char* tokenEnd = std::find(tokenStart, lineEnd, ',');
+        eT val = eT(0);
+        if (!ConvertToken<eT>(val, tokenStart, tokenEnd))
+        {
+          failedRow[c] = row;
+          failedCol[c] = col;
+          failedToken[c] = std::string(tokenStart, tokenEnd);
+          break;
+        }
+
+        if (transpose)
+          x.at(col, row) = val;
+        else
+          x.at(row, col) = val;
+
+        if (tokenEnd == lineEnd)
+          break;
+        tokenStart = tokenEnd + 1;
+      }
+
+      if (failedRow[c] != size_t(-1))
+        break;
+      p = lineEnd + 1;
+    }
+  }
+
+  for (size_t c = 0; c < usedChunks; ++c)
+  {
+    if (failedRow[c] != size_t(-1))
+    {
+      // Printing failed token and it's location.
+      Log::Warn << "Failed to convert token " << failedToken[c] << ", at row "
+          << failedRow[c] << ", column " << failedCol[c] << " of matrix!";
+
+      return false;
+    }
+  }
+
+  return true;
+}
+
 inline void LoadCSV::NumericMatSize(std::stringstream& lineStream,
                                     size_t& col,
                                     const char delim)
@@ -0,0 +1,202 @@
+/**
+ * @file core/data/mapped_dataset.hpp
+ *
+ * Definition of the MappedDataset class, a dataset (with its DatasetInfo)
+ * that can be memory-mapped from mlpack's native binary dataset format.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MAPPED_DATASET_HPP
+#define MLPACK_CORE_DATA_MAPPED_DATASET_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "dataset_mapper.hpp"
+#include "mapped_file.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * MappedDataset holds a dataset and its DatasetInfo, and can save them to (and
+ * map them from) mlpack's native binary dataset format, denoted by the
+ * `.mlds` extension.  A dataset file holds:
+ *
+ *  - a header, with the element type, the byte order and the size of the
+ *    matrix;
+ *  - the DatasetInfo (the type of each dimension and the mappings of the
+ *    categorical dimensions), in a portable binary archive;
+ *  - the matrix, column-major (one point per column, as mlpack holds it), in
+ *    the given element type and the byte order of the machine that wrote it,
+ *    aligned to 64 bytes.
+ *
+ * Load() maps the file into memory, and Matrix() is then an Armadillo matrix
+ * that aliases the mapped memory: nothing is parsed, converted or copied, and
+ * the points are read lazily from the file (or the page cache, which is shared
+ * by every process that maps the same file).  The mapping is private, so the
+ * matrix can be modified without modifying the file.
+ *
+ * Copies of a MappedDataset share the same mapping (like an alias of an
+ * Armadillo matrix), so that writes to the matrix of one copy are seen by the
+ * others.
+ *
+ * `data::Load()` and `data::Save()` also accept `.mlds` files (converting the
+ * element type if necessary, and ignoring the `transpose` option, since the
+ * points are already stored as columns), and the `preprocess_convert`
+ * binding converts any dataset to this format.
+ *
+ * @code
+ * // Convert a dataset once...
+ * arma::mat dataset;
+ * data::DatasetInfo info;
+ * data::Load("dataset.arff", dataset, info, true);
+ * data::MappedDataset<>::Save("dataset.mlds", dataset, info);
+ *
+ * // ...and map it for every experiment.
+ * data::MappedDataset<> mapped("dataset.mlds");
+ * const arma::mat& points = mapped.Matrix();
+ * @endcode
+ *
+ * @tparam eT Element type of the matrix.
+ */
+template<typename eT = double>
+class MappedDataset
+{
+  static_assert(std::is_arithmetic<eT>::value, "MappedDataset: the element "
+      "type must be an arithmetic type!");
+
+ public:
+  //! Create an empty dataset.
+  MappedDataset() { }
+
+  /**
+   * Map the dataset of the given file; see Load().
+   *
+   * @param filename Name of the file to map.
+   */
+  explicit MappedDataset(const std::string& filename) { Load(filename); }
+
+  //! Copy the given dataset; the copy shares the mapping.
+  MappedDataset(const MappedDataset& other);
+
+  //! Copy the given dataset; the copy shares the mapping.
+  MappedDataset& operator=(const MappedDataset& other);
+
+  /**
+   * Save the given matrix and DatasetInfo to the given file, so that they can
+   * be mapped by Load().  A std::runtime_error is thrown if the file cannot be
+   * written.
+   *
+   * @param filename Name of the file to save to.
+   * @param matrix Matrix to save (one point per column).
+   * @param info Type of each dimension of the matrix.
+   */
+  static void Save(const std::string& filename,
+                   const arma::Mat<eT>& matrix,
+                   const DatasetInfo& info);
+
+  /**
+   * Save the given matrix to the given file, with only numeric dimensions.
+   *
+   * @param filename Name of the file to save to.
+   * @param matrix Matrix to save (one point per column).
+   */
+  static void Save(const std::string& filename, const arma::Mat<eT>& matrix)
+  {
+    Save(filename, matrix, DatasetInfo(matrix.n_rows));
+  }
+
+  /**
+   * Map the dataset of the given file (written by Save()) into memory; this
+   * replaces the current dataset.  The file must hold elements of type eT,
+   * written with the byte order of this machine.  A std::runtime_error is
+   * thrown if the file cannot be mapped or is not a valid dataset file.
+   *
+   * @param filename Name of the file to map.
+   */
+  void Load(const std::string& filename);
+
+  /**
+   * Read the dataset of the given file into the given matrix and DatasetInfo,
+   * converting the elements to type eT if the file holds another type.  This
+   * copies the matrix, but does not parse anything.  A std::runtime_error is
+   * thrown if the file cannot be read or is not a valid dataset file.
+   *
+   * @param filename Name of the file to read.
+   * @param matrix Matrix to read the points into.
+   * @param info DatasetInfo to read the type of each dimension into.
+   */
+  static void Read(const std::string& filename,
+                   arma::Mat<eT>& matrix,
+                   DatasetInfo& info);
+
+  //! Get the matrix (one point per column).
+  const arma::Mat<eT>& Matrix() const { return matrix; }
+  //! Modify the matrix; this never modifies the file.
+  arma::Mat<eT>& Matrix() { return matrix; }
+
+  //! Get the type of each dimension.
+  const DatasetInfo& Info() const { return info; }
+
+  //! Return whether the dataset is memory-mapped from a file.
+  bool IsMapped() const { return mappedFile != nullptr; }
+
+ private:
+  //! The header at the start of dataset files.
+  struct FileHeader
+  {
+    char magic[8];
+    //! 0x01020304, in the byte order of the machine that wrote the file.
+    uint32_t byteOrder;
+    //! 'f' (floating point), 'i' (signed integer) or 'u' (unsigned integer).
+    char elemKind;
+    //! The size of each element, in bytes.
+    uint8_t elemSize;
+    uint16_t reserved;
+    uint64_t nRows;
+    uint64_t nCols;
+    uint64_t infoOffset;
+    uint64_t infoSize;
+    uint64_t dataOffset;
+  };
+
+  //! Get the kind of the given element type, as stored in the header.
+  template<typename T>
+  static char ElemKind()
+  {
+    return std::is_floating_point<T>::value ? 'f' :
+        (std::is_signed<T>::value ? 'i' : 'u');
+  }
+
+  /**
+   * Map the given file and check its header; the DatasetInfo is read into
+   * `info`.
+   */
+  static std::shared_ptr<MappedFile> Open(const std::string& filename,
+                                          FileHeader& header,
+                                          DatasetInfo& info);
+
+  /**
+   * Convert the n elements of type T at the given address to eT.
+   */
+  template<typename T>
+  static void Convert(const char* data, const size_t n, eT* out);
+
+  //! The type of each dimension.
+  DatasetInfo info;
+  //! The mapping of the file, if the dataset is mapped.
+  std::shared_ptr<MappedFile> mappedFile;
+  //! The matrix (an alias of the mapping, if the dataset is mapped).
+  arma::Mat<eT> matrix;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "mapped_dataset_impl.hpp"
+
+#endif
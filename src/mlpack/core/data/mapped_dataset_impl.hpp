@@ -0,0 +1,238 @@
+/**
+ * @file core/data/mapped_dataset_impl.hpp
+ *
+ * Implementation of the MappedDataset class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MAPPED_DATASET_IMPL_HPP
+#define MLPACK_CORE_DATA_MAPPED_DATASET_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mapped_dataset.hpp"
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+MappedDataset<eT>::MappedDataset(const MappedDataset& other) :
+    info(other.info),
+    mappedFile(other.mappedFile)
+{
+  if (mappedFile)
+  {
+    matrix = arma::Mat<eT>(const_cast<eT*>(other.matrix.memptr()),
+        other.matrix.n_rows, other.matrix.n_cols, false, false);
+  }
+  else
+  {
+    matrix = other.matrix;
+  }
+}
+
+template<typename eT>
+MappedDataset<eT>& MappedDataset<eT>::operator=(const MappedDataset& other)
+{
+  if (&other == this)
+    return *this;
+
+  // Release the current matrix before the current mapping.
+  matrix.reset();
+  info = other.info;
+  mappedFile = other.mappedFile;
+  if (mappedFile)
+  {
+    matrix = arma::Mat<eT>(const_cast<eT*>(other.matrix.memptr()),
+        other.matrix.n_rows, other.matrix.n_cols, false, false);
+  }
+  else
+  {
+    matrix = other.matrix;
+  }
+
+  return *this;
+}
+
+template<typename eT>
+void MappedDataset<eT>::Save(const std::string& filename,
+                             const arma::Mat<eT>& matrix,
+                             const DatasetInfo& info)
+{
+  if (info.Dimensionality() != matrix.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "MappedDataset::Save(): the DatasetInfo has "
+        << info.Dimensionality() << " dimensions, but the matrix has "
+        << matrix.n_rows << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // The DatasetInfo is stored in a portable archive, so it can be read on any
+  // machine.
+  std::ostringstream infoStream(std::ios::binary);
+  {
+    cereal::PortableBinaryOutputArchive ar(infoStream);
+    ar(cereal::make_nvp("info", info));
+  }
+  const std::string infoData = infoStream.str();
+
+  // Align the matrix to 64 bytes once mapped (the mapping itself is aligned to
+  // a page).
+  const uint64_t alignment = 64;
+  FileHeader header;
+  std::memset(&header, 0, sizeof(FileHeader));
+  std::memcpy(header.magic, "MLPKDSF1", 8);
+  header.byteOrder = 0x01020304;
+  header.elemKind = ElemKind<eT>();
+  header.elemSize = sizeof(eT);
+  header.nRows = matrix.n_rows;
+  header.nCols = matrix.n_cols;
+  header.infoOffset = sizeof(FileHeader);
+  header.infoSize = infoData.size();
+  header.dataOffset = ((header.infoOffset + header.infoSize + alignment - 1) /
+      alignment) * alignment;
+
+  std::ofstream stream(filename, std::ios::binary);
+  if (!stream.is_open())
+  {
+    throw std::runtime_error("MappedDataset::Save(): cannot open '" +
+        filename + "' for writing!");
+  }
+
+  const std::vector<char> padding(header.dataOffset - header.infoOffset -
+      header.infoSize, 0);
+  stream.write((const char*) &header, sizeof(FileHeader));
+  stream.write(infoData.data(), infoData.size());
+  stream.write(padding.data(), padding.size());
+  stream.write((const char*) matrix.memptr(), matrix.n_elem * sizeof(eT));
+  if (!stream.good())
+  {
+    throw std::runtime_error("MappedDataset::Save(): error writing to '" +
+        filename + "'!");
+  }
+}
+
+template<typename eT>
+std::shared_ptr<MappedFile> MappedDataset<eT>::Open(
+    const std::string& filename,
+    FileHeader& header,
+    DatasetInfo& info)
+{
+  std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>(filename);
+
+  if (file->Size() < sizeof(FileHeader))
+  {
+    throw std::runtime_error("MappedDataset: '" + filename + "' is not a "
+        "dataset file!");
+  }
+  std::memcpy(&header, file->Data(), sizeof(FileHeader));
+
+  if (std::memcmp(header.magic, "MLPKDSF1", 8) != 0)
+  {
+    throw std::runtime_error("MappedDataset: '" + filename + "' is not a "
+        "dataset file!");
+  }
+  if (header.byteOrder != 0x01020304)
+  {
+    throw std::runtime_error("MappedDataset: '" + filename + "' was written "
+        "on a machine with a different byte order; convert it again on this "
+        "machine!");
+  }
+  if (header.infoOffset + header.infoSize > header.dataOffset ||
+      header.dataOffset % 64 != 0 ||
+      header.dataOffset + header.nRows * header.nCols * header.elemSize !=
+          file->Size())
+  {
+    throw std::runtime_error("MappedDataset: '" + filename + "' is truncated "
+        "or corrupted!");
+  }
+
+  std::istringstream infoStream(std::string(file->Data() + header.infoOffset,
+      header.infoSize), std::ios::binary);
+  {
+    cereal::PortableBinaryInputArchive ar(infoStream);
+    ar(cereal::make_nvp("info", info));
+  }
+
+  if (info.Dimensionality() != header.nRows)
+  {
+    throw std::runtime_error("MappedDataset: '" + filename + "' is truncated "
+        "or corrupted!");
+  }
+
+  return file;
+}
+
+template<typename eT>
+void MappedDataset<eT>::Load(const std::string& filename)
+{
+  FileHeader header;
+  DatasetInfo newInfo;
+  std::shared_ptr<MappedFile> file = Open(filename, header, newInfo);
+
+  if (header.elemKind != ElemKind<eT>() || header.elemSize != sizeof(eT))
+  {
+    throw std::runtime_error("MappedDataset::Load(): '" + filename + "' holds "
+        "a different element type; use MappedDataset::Read() or data::Load() "
+        "to convert it!");
+  }
+
+  // This replaces the current dataset (and releases any previous mapping).
+  // The alias is not strict, so the matrix can still be resized.
+  matrix = arma::Mat<eT>((eT*) (file->Data() + header.dataOffset),
+      header.nRows, header.nCols, false, false);
+  info = std::move(newInfo);
+  mappedFile = std::move(file);
+}
+
+template<typename eT>
+void MappedDataset<eT>::Read(const std::string& filename,
+                             arma::Mat<eT>& matrix,
+                             DatasetInfo& info)
+{
+  FileHeader header;
+  std::shared_ptr<MappedFile> file = Open(filename, header, info);
+
+  matrix.set_size(header.nRows, header.nCols);
+  const char* data = file->Data() + header.dataOffset;
+  const size_t n = matrix.n_elem;
+  switch (header.elemKind | (header.elemSize << 8))
+  {
+    case 'f' | (4 << 8): Convert<float>(data, n, matrix.memptr()); break;
+    case 'f' | (8 << 8): Convert<double>(data, n, matrix.memptr()); break;
+    case 'i' | (1 << 8): Convert<int8_t>(data, n, matrix.memptr()); break;
+    case 'i' | (2 << 8): Convert<int16_t>(data, n, matrix.memptr()); break;
+    case 'i' | (4 << 8): Convert<int32_t>(data, n, matrix.memptr()); break;
+    case 'i' | (8 << 8): Convert<int64_t>(data, n, matrix.memptr()); break;
+    case 'u' | (1 << 8): Convert<uint8_t>(data, n, matrix.memptr()); break;
+    case 'u' | (2 << 8): Convert<uint16_t>(data, n, matrix.memptr()); break;
+    case 'u' | (4 << 8): Convert<uint32_t>(data, n, matrix.memptr()); break;
+    case 'u' | (8 << 8): Convert<uint64_t>(data, n, matrix.memptr()); break;
+    default:
+      throw std::runtime_error("MappedDataset::Read(): '" + filename + "' "
+          "holds an unknown element type!");
+  }
+}
+
+template<typename eT>
+template<typename T>
+void MappedDataset<eT>::Convert(const char* data, const size_t n, eT* out)
+{
+  if (std::is_same<T, eT>::value)
+  {
+    std::memcpy(out, data, n * sizeof(eT));
+    return;
+  }
+
+  const T* in = (const T*) data;
+  for (size_t i = 0; i < n; ++i)
+    out[i] = eT(in[i]);
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,122 @@
+/**
+ * @file core/data/mapped_file.hpp
+ *
+ * Definition of the MappedFile class, a simple RAII wrapper around a private,
+ * copy-on-write memory mapping of a file.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MAPPED_FILE_HPP
+#define MLPACK_CORE_DATA_MAPPED_FILE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A MappedFile maps the whole contents of a file into memory.  The mapping is
+ * private and copy-on-write: pages are read lazily from the file (or from the
+ * page cache, where they can be shared by every process that maps the same
+ * file), and writing to the memory never modifies the file.
+ *
+ * The memory stays valid until the MappedFile is destroyed, so any object that
+ * points into Data() (for instance an Armadillo matrix constructed with
+ * copy_aux_mem = false) must not outlive its MappedFile.
+ *
+ * Memory mapping is only supported on POSIX systems; on other platforms the
+ * constructor throws a std::runtime_error.
+ */
+class MappedFile
+{
+ public:
+  /**
+   * Map the given file into memory.  A std::runtime_error is thrown if the
+   * file cannot be opened or mapped.
+   *
+   * @param filename Name of the file to map.
+   */
+  MappedFile(const std::string& filename) :
+      data(NULL),
+      size(0)
+  {
+    #ifndef _WIN32
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      throw std::runtime_error("MappedFile: cannot open '" + filename +
+          "' for reading!");
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+      close(fd);
+      throw std::runtime_error("MappedFile: cannot get the size of '" +
+          filename + "'!");
+    }
+
+    size = (size_t) info.st_size;
+    if (size > 0)
+    {
+      void* addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+      if (addr == MAP_FAILED)
+      {
+        close(fd);
+        throw std::runtime_error("MappedFile: cannot map '" + filename +
+            "' into memory!");
+      }
+
+      data = (char*) addr;
+    }
+
+    // The mapping stays valid after the file descriptor is closed.
+    close(fd);
+    #else
+    throw std::runtime_error("MappedFile: memory-mapped files are not "
+        "supported on this platform; cannot map '" + filename + "'!");
+    #endif
+  }
+
+  //! Unmap the file.
+  ~MappedFile()
+  {
+    #ifndef _WIN32
+    if (data != NULL)
+      munmap(data, size);
+    #endif
+  }
+
+  // A mapping has a single owner.
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  //! Get the mapped memory.
+  const char* Data() const { return data; }
+  //! Modify the mapped memory (this never modifies the file).
+  char* Data() { return data; }
+
+  //! Get the size of the mapping, in bytes.
+  size_t Size() const { return size; }
+
+ private:
+  //! The mapped memory.
+  char* data;
+  //! The size of the mapping, in bytes.
+  size_t size;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
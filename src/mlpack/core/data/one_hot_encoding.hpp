@@ -62,6 +62,50 @@ void OneHotEncoding(const arma::Mat<eT>& input,
                     arma::Mat<eT>& output,
                     const data::DatasetInfo& datasetInfo);
 
+/**
+ * Sparse overload of the label variant above: the output matrix holds one
+ * nonzero value for each label, so it takes memory proportional to the number
+ * of labels instead of the number of labels times the number of distinct
+ * labels.  The encoding is the same as for a dense output matrix.
+ *
+ * @param labelsIn Input labels of arbitrary datatype.
+ * @param output Sparse binary matrix.
+ */
+template<typename RowType, typename eT>
+void OneHotEncoding(const RowType& labelsIn,
+                    arma::SpMat<eT>& output);
+
+/**
+ * Sparse overload of the dataset variant above, which takes a matrix as input
+ * and a vector of indices of the dimensions to one-hot encode, and outputs a
+ * sparse matrix.  Each encoded dimension gives a single nonzero value in each
+ * point, so for categorical dimensions with many levels the output is much
+ * smaller than the dense encoding (which it equals).  The compressed columns
+ * of the output are built in parallel.
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param output Sparse encoded matrix.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::SpMat<eT>& output);
+
+/**
+ * Sparse overload of the DatasetInfo variant above; all the dimensions marked
+ * `Datatype::categorical` in the data::DatasetInfo are encoded into a sparse
+ * matrix.
+ *
+ * @param input Input dataset to be encoded.
+ * @param output Sparse encoded matrix.
+ * @param datasetInfo DatasetInfo object that has information about data.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    arma::SpMat<eT>& output,
+                    const data::DatasetInfo& datasetInfo);
+
 } // namespace data
 } // namespace mlpack
 
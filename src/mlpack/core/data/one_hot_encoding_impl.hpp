@@ -20,25 +20,22 @@ namespace mlpack {
 namespace data {
 
 /**
- * Given a set of labels of a particular datatype, convert them to binary
- * vector. The categorical values be mapped to integer values.
- * Then, each integer value is represented as a binary vector that is
- * all zero values except the index of the integer, which is marked
- * with a 1.
+ * Map each of the given labels to the index of its category (in order of first
+ * appearance), and return the number of categories.  This is used by the
+ * dense and sparse label variants of OneHotEncoding().
  *
  * @param labelsIn Input labels of arbitrary datatype.
- * @param output Binary matrix.
+ * @param labels Index of the category of each label.
+ * @tparam KeyType Type the labels are mapped as.
  */
-template<typename RowType, typename MatType>
-void OneHotEncoding(const RowType& labelsIn,
-                    MatType& output)
+template<typename KeyType, typename RowType>
+size_t MapOneHotLabels(const RowType& labelsIn, arma::Row<size_t>& labels)
 {
-  arma::Row<size_t> labels;
   labels.set_size(labelsIn.n_elem);
 
   // Loop over the input labels, and develop the mapping.
   // Map for labelsIn to labels.
-  std::unordered_map<typename MatType::elem_type, size_t> labelMap;
+  std::unordered_map<KeyType, size_t> labelMap;
   size_t curLabel = 0;
   for (size_t i = 0; i < labelsIn.n_elem; ++i)
   {
@@ -55,46 +52,37 @@ void OneHotEncoding(const RowType& labelsIn,
       ++curLabel;
     }
   }
-  // Resize output matrix to necessary size, and fill it with zeros.
-  output.zeros(curLabel, labelsIn.n_elem);
-  // Fill ones in at the required places.
-  for (size_t i = 0; i < labelsIn.n_elem; ++i)
-  {
-    output(labels[i], i) = 1;
-  }
-  labelMap.clear();
+
+  return curLabel;
 }
 
 /**
- * Overloaded function for the above function, which takes a matrix as input
- * and also a vector of indices to encode and outputs a matrix.
- * Indices represent the IDs of the dimensions to be one-hot encoded.
+ * Compute the mappings of the values of the dimensions to encode to the index
+ * of the dimension they take, and the offset of each dimension in the encoded
+ * matrix.  This is used by the dense and sparse dataset variants of
+ * OneHotEncoding().
  *
  * @param input Input dataset to be encoded.
  * @param indices Index of rows to be encoded.
- * @param output Encoded matrix.
+ * @param dimensionOffsets Offsets of the dimensions; the last element is the
+ *     total number of dimensions, and the first element is the offset of
+ *     dimension *2* (not 1).
+ * @param mappings Mappings of the values of each encoded dimension.
  */
 template<typename eT>
-void OneHotEncoding(const arma::Mat<eT>& input,
-                    const arma::Col<size_t>& indices,
-                    arma::Mat<eT>& output)
+void MapOneHotDimensions(
+    const arma::Mat<eT>& input,
+    const arma::Col<size_t>& indices,
+    arma::Col<size_t>& dimensionOffsets,
+    std::unordered_map<size_t, std::unordered_map<eT, size_t>>& mappings)
 {
-  // Handle the edge case where there is nothing to encode.
-  if (indices.n_elem == 0)
-  {
-    output = input;
-    return;
-  }
-
-  // First, we need to compute the size of the output matrix.
-
   // This vector will eventually hold the offsets for each dimension in the
   // one-hot encoded matrix, but first it will just hold the counts of
   // dimensions for each dimension.
-  arma::Col<size_t> dimensionOffsets(input.n_rows, arma::fill::ones);
+  dimensionOffsets.ones(input.n_rows);
   // This will hold the mappings from a value that should be one-hot encoded to
   // the index of the dimension it should take.
-  std::unordered_map<size_t, std::unordered_map<eT, size_t>> mappings;
+  mappings.clear();
   for (size_t i = 0; i < indices.n_elem; ++i)
   {
     dimensionOffsets[indices[i]] = 0;
@@ -115,11 +103,63 @@ void OneHotEncoding(const arma::Mat<eT>& input,
     }
   }
 
-  // Turn the dimension counts into offsets.  Note that the last element is the
-  // total number of dimensions, and the first element is the offset for
-  // dimension *2* (not 1).
+  // Turn the dimension counts into offsets.
   for (size_t i = 1; i < dimensionOffsets.n_elem; ++i)
     dimensionOffsets[i] += dimensionOffsets[i - 1];
+}
+
+/**
+ * Given a set of labels of a particular datatype, convert them to binary
+ * vector. The categorical values be mapped to integer values.
+ * Then, each integer value is represented as a binary vector that is
+ * all zero values except the index of the integer, which is marked
+ * with a 1.
+ *
+ * @param labelsIn Input labels of arbitrary datatype.
+ * @param output Binary matrix.
+ */
+template<typename RowType, typename MatType>
+void OneHotEncoding(const RowType& labelsIn,
+                    MatType& output)
+{
+  arma::Row<size_t> labels;
+  const size_t curLabel =
+      MapOneHotLabels<typename MatType::elem_type>(labelsIn, labels);
+
+  // Resize output matrix to necessary size, and fill it with zeros.
+  output.zeros(curLabel, labelsIn.n_elem);
+  // Fill ones in at the required places.
+  for (size_t i = 0; i < labelsIn.n_elem; ++i)
+  {
+    output(labels[i], i) = 1;
+  }
+}
+
+/**
+ * Overloaded function for the above function, which takes a matrix as input
+ * and also a vector of indices to encode and outputs a matrix.
+ * Indices represent the IDs of the dimensions to be one-hot encoded.
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param output Encoded matrix.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::Mat<eT>& output)
+{
+  // Handle the edge case where there is nothing to encode.
+  if (indices.n_elem == 0)
+  {
+    output = input;
+    return;
+  }
+
+  // First, we need to compute the size of the output matrix.
+  arma::Col<size_t> dimensionOffsets;
+  std::unordered_map<size_t, std::unordered_map<eT, size_t>> mappings;
+  MapOneHotDimensions(input, indices, dimensionOffsets, mappings);
 
   // Now, initialize the output matrix to the right size.
   output.zeros(dimensionOffsets[dimensionOffsets.n_elem - 1], input.n_cols);
@@ -169,6 +209,112 @@ void OneHotEncoding(const arma::Mat<eT>& input,
   OneHotEncoding(input, arma::Col<size_t>(indices), output);
 }
 
+template<typename RowType, typename eT>
+void OneHotEncoding(const RowType& labelsIn,
+                    arma::SpMat<eT>& output)
+{
+  arma::Row<size_t> labels;
+  const size_t curLabel = MapOneHotLabels<eT>(labelsIn, labels);
+
+  // Each column holds a single one, so the compressed columns can be given
+  // directly.
+  const arma::uvec rowIndices(labels.t());
+  const arma::uvec colPtrs = arma::regspace<arma::uvec>(0, labelsIn.n_elem);
+  const arma::Col<eT> values(labelsIn.n_elem, arma::fill::ones);
+  output = arma::SpMat<eT>(rowIndices, colPtrs, values, curLabel,
+      labelsIn.n_elem);
+}
+
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::SpMat<eT>& output)
+{
+  // Handle the edge case where there is nothing to encode.
+  if (indices.n_elem == 0)
+  {
+    output = arma::SpMat<eT>(input);
+    return;
+  }
+
+  arma::Col<size_t> dimensionOffsets;
+  std::unordered_map<size_t, std::unordered_map<eT, size_t>> mappings;
+  MapOneHotDimensions(input, indices, dimensionOffsets, mappings);
+
+  // The mappings are only read from now on, so they can be shared by the
+  // threads; keep a pointer to the mapping of each dimension to encode.
+  std::vector<const std::unordered_map<eT, size_t>*> rowMappings(input.n_rows,
+      nullptr);
+  for (const auto& mapping : mappings)
+    rowMappings[mapping.first] = &mapping.second;
+
+  // Count the nonzero values of each column: one for each encoded dimension,
+  // and the nonzero values of the other dimensions.
+  arma::uvec colPtrs(input.n_cols + 1);
+  colPtrs[0] = 0;
+  #pragma omp parallel for schedule(static)
+  for (size_t col = 0; col < input.n_cols; ++col)
+  {
+    size_t nonzeros = 0;
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      if (rowMappings[row] != nullptr || input(row, col) != eT(0))
+        ++nonzeros;
+    }
+    colPtrs[col + 1] = nonzeros;
+  }
+
+  for (size_t col = 1; col <= input.n_cols; ++col)
+    colPtrs[col] += colPtrs[col - 1];
+
+  // Now fill the row indices and values of each column, which are already in
+  // order since the dimension offsets increase with the rows.
+  arma::uvec rowIndices(colPtrs[input.n_cols]);
+  arma::Col<eT> values(colPtrs[input.n_cols]);
+  #pragma omp parallel for schedule(static)
+  for (size_t col = 0; col < input.n_cols; ++col)
+  {
+    size_t index = colPtrs[col];
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      const size_t dimOffset = (row == 0) ? 0 : dimensionOffsets[row - 1];
+      if (rowMappings[row] != nullptr)
+      {
+        // Values that do not compare equal to themselves (NaN) are mapped to
+        // the first dimension, like in the dense variant.
+        const auto it = rowMappings[row]->find(input(row, col));
+        rowIndices[index] = dimOffset +
+            ((it == rowMappings[row]->end()) ? 0 : it->second);
+        values[index++] = eT(1);
+      }
+      else if (input(row, col) != eT(0))
+      {
+        rowIndices[index] = dimOffset;
+        values[index++] = input(row, col);
+      }
+    }
+  }
+
+  output = arma::SpMat<eT>(rowIndices, colPtrs, values,
+      dimensionOffsets[dimensionOffsets.n_elem - 1], input.n_cols);
+}
+
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    arma::SpMat<eT>& output,
+                    const data::DatasetInfo& datasetInfo)
+{
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < datasetInfo.Dimensionality(); ++i)
+  {
+    if (datasetInfo.Type(i) == data::Datatype::categorical)
+    {
+      indices.push_back(i);
+    }
+  }
+  OneHotEncoding(input, arma::Col<size_t>(indices), output);
+}
+
 } // namespace data
 } // namespace mlpack
 
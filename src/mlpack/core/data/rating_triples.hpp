@@ -0,0 +1,172 @@
+/**
+ * @file core/data/rating_triples.hpp
+ *
+ * Definition of the RatingTriples class, a compact list of (user, item,
+ * rating) triples that can be memory-mapped from a binary file.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_RATING_TRIPLES_HPP
+#define MLPACK_CORE_DATA_RATING_TRIPLES_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+
+#include "mapped_file.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * RatingTriples holds a list of (user, item, rating) triples, such as the
+ * coordinate lists given to RegularizedSVD, BiasSVD and SVDPlusPlus, with a
+ * 32-bit user, a 32-bit item and a single-precision rating for each triple: 12
+ * bytes for each rating, instead of 24 for a 3 x n arma::mat.
+ *
+ * The triples can be saved to a binary file with Save(), and Load() maps such
+ * a file into memory, so that the ratings are read lazily from the file (or
+ * the page cache) instead of being parsed and converted at startup.  The file
+ * holds a 32-byte header and then the triples, in the byte order of the
+ * machine that wrote it.
+ *
+ * Copies of a RatingTriples object share the same triples (like an alias of
+ * an Armadillo matrix), so that trainers can hold a copy without duplicating
+ * the ratings; note that Shuffle() reorders the triples of every copy.
+ *
+ * For compatibility with the code written for coordinate lists, a
+ * RatingTriples object has `n_rows` (always 3) and `n_cols` (the number of
+ * ratings) members, and `data(0, i)`, `data(1, i)` and `data(2, i)` are the
+ * user, item and rating of triple i.
+ *
+ * @code
+ * // Convert a coordinate list once...
+ * arma::mat ratings;
+ * data::Load("ratings.csv", ratings, true);
+ * data::RatingTriples(ratings).Save("ratings.bin");
+ *
+ * // ...and map it for training.
+ * data::RatingTriples triples;
+ * triples.Load("ratings.bin");
+ * RegularizedSVD<> svd(10, 0.01, 0.02);
+ * arma::mat u, v;
+ * svd.Apply(triples, 20, u, v);
+ * @endcode
+ */
+class RatingTriples
+{
+ public:
+  //! A single rating, as it is stored in memory and in files.
+  struct Triple
+  {
+    //! The user of the rating.
+    uint32_t user;
+    //! The item of the rating.
+    uint32_t item;
+    //! The rating.
+    float rating;
+  };
+
+  static_assert(sizeof(Triple) == 12, "RatingTriples::Triple must be packed!");
+
+  //! Create an empty list of triples.
+  RatingTriples();
+
+  /**
+   * Create the triples of the given coordinate list, where each column holds a
+   * user, an item, and a rating.  A std::invalid_argument is thrown if the
+   * matrix does not have three rows or if a user or item is not a valid 32-bit
+   * index.
+   *
+   * @param coordinates Coordinate list to convert.
+   */
+  template<typename MatType>
+  explicit RatingTriples(const MatType& coordinates);
+
+  /**
+   * Save the triples to the given binary file, so that they can be mapped by
+   * Load().  A std::runtime_error is thrown if the file cannot be written.
+   *
+   * @param filename Name of the file to save to.
+   */
+  void Save(const std::string& filename) const;
+
+  /**
+   * Map the triples of the given binary file (written by Save()) into memory;
+   * this replaces the current triples.  A std::runtime_error is thrown if the
+   * file cannot be mapped or is not a valid triple file.
+   *
+   * @param filename Name of the file to map.
+   */
+  void Load(const std::string& filename);
+
+  //! Get the user of the given triple.
+  uint32_t User(const size_t i) const { return triples[i].user; }
+  //! Get the item of the given triple.
+  uint32_t Item(const size_t i) const { return triples[i].item; }
+  //! Get the rating of the given triple.
+  float Rating(const size_t i) const { return triples[i].rating; }
+
+  //! Get the user (row 0), item (row 1) or rating (row 2) of the given triple.
+  double operator()(const size_t row, const size_t col) const
+  {
+    const Triple& t = triples[col];
+    return (row == 0) ? (double) t.user :
+        ((row == 1) ? (double) t.item : (double) t.rating);
+  }
+
+  //! Get the number of triples.
+  size_t Size() const { return n_cols; }
+  //! Get the number of users (one more than the largest user).
+  size_t NumUsers() const { return numUsers; }
+  //! Get the number of items (one more than the largest item).
+  size_t NumItems() const { return numItems; }
+
+  //! Get the triples.
+  const Triple* Triples() const { return triples; }
+
+  //! Return whether the triples are memory-mapped from a file.
+  bool IsMapped() const { return mappedFile != nullptr; }
+
+  /**
+   * Shuffle the triples.  If the triples are mapped, the shuffled pages are
+   * held in memory; the file is never modified.
+   */
+  void Shuffle();
+
+  //! The number of rows of the coordinate list (always 3).
+  static constexpr size_t n_rows = 3;
+  //! The number of triples; this must not be modified.
+  size_t n_cols;
+
+ private:
+  //! The header at the start of files written by Save().
+  struct FileHeader
+  {
+    char magic[8];
+    uint64_t numRatings;
+    uint64_t numUsers;
+    uint64_t numItems;
+  };
+
+  //! The triples, if they are held in memory.
+  std::shared_ptr<std::vector<Triple>> memory;
+  //! The mapping of the file, if the triples are mapped.
+  std::shared_ptr<MappedFile> mappedFile;
+  //! The first triple (in memory or in the mapping).
+  Triple* triples;
+  //! The number of users.
+  size_t numUsers;
+  //! The number of items.
+  size_t numItems;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "rating_triples_impl.hpp"
+
+#endif
@@ -0,0 +1,131 @@
+/**
+ * @file core/data/rating_triples_impl.hpp
+ *
+ * Implementation of the RatingTriples class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_RATING_TRIPLES_IMPL_HPP
+#define MLPACK_CORE_DATA_RATING_TRIPLES_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "rating_triples.hpp"
+
+namespace mlpack {
+namespace data {
+
+inline RatingTriples::RatingTriples() :
+    n_cols(0),
+    triples(NULL),
+    numUsers(0),
+    numItems(0)
+{
+  // Nothing to do.
+}
+
+template<typename MatType>
+RatingTriples::RatingTriples(const MatType& coordinates) :
+    n_cols(coordinates.n_cols),
+    memory(std::make_shared<std::vector<Triple>>(coordinates.n_cols)),
+    triples(memory->data()),
+    numUsers(0),
+    numItems(0)
+{
+  if (coordinates.n_rows != 3)
+  {
+    std::ostringstream oss;
+    oss << "RatingTriples::RatingTriples(): the coordinate list must have 3 "
+        << "rows (user, item, rating), but it has " << coordinates.n_rows
+        << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const double maxIndex = (double) std::numeric_limits<uint32_t>::max();
+  for (size_t i = 0; i < n_cols; ++i)
+  {
+    const double user = coordinates(0, i);
+    const double item = coordinates(1, i);
+    if (!(user >= 0.0 && user <= maxIndex && item >= 0.0 && item <= maxIndex))
+    {
+      std::ostringstream oss;
+      oss << "RatingTriples::RatingTriples(): the user and item of rating " << i
+          << " must be valid 32-bit indices!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    triples[i].user = (uint32_t) user;
+    triples[i].item = (uint32_t) item;
+    triples[i].rating = (float) coordinates(2, i);
+    numUsers = std::max(numUsers, (size_t) triples[i].user + 1);
+    numItems = std::max(numItems, (size_t) triples[i].item + 1);
+  }
+}
+
+inline void RatingTriples::Save(const std::string& filename) const
+{
+  FileHeader header;
+  std::memcpy(header.magic, "MLPKRTF1", 8);
+  header.numRatings = n_cols;
+  header.numUsers = numUsers;
+  header.numItems = numItems;
+
+  std::ofstream stream(filename, std::ios::binary);
+  if (!stream.is_open())
+  {
+    throw std::runtime_error("RatingTriples::Save(): cannot open '" + filename +
+        "' for writing!");
+  }
+
+  stream.write((const char*) &header, sizeof(FileHeader));
+  stream.write((const char*) triples, n_cols * sizeof(Triple));
+  if (!stream.good())
+  {
+    throw std::runtime_error("RatingTriples::Save(): error writing to '" +
+        filename + "'!");
+  }
+}
+
+inline void RatingTriples::Load(const std::string& filename)
+{
+  std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>(filename);
+
+  FileHeader header;
+  if (file->Size() < sizeof(FileHeader))
+  {
+    throw std::runtime_error("RatingTriples::Load(): '" + filename + "' is "
+        "not a rating triple file!");
+  }
+  std::memcpy(&header, file->Data(), sizeof(FileHeader));
+
+  if (std::memcmp(header.magic, "MLPKRTF1", 8) != 0)
+  {
+    throw std::runtime_error("RatingTriples::Load(): '" + filename + "' is "
+        "not a rating triple file!");
+  }
+  if (sizeof(FileHeader) + header.numRatings * sizeof(Triple) != file->Size())
+  {
+    throw std::runtime_error("RatingTriples::Load(): '" + filename + "' is "
+        "truncated or corrupted!");
+  }
+
+  // This replaces the current triples (and releases any previous mapping).
+  memory.reset();
+  mappedFile = std::move(file);
+  triples = (Triple*) (mappedFile->Data() + sizeof(FileHeader));
+  n_cols = header.numRatings;
+  numUsers = header.numUsers;
+  numItems = header.numItems;
+}
+
+inline void RatingTriples::Shuffle()
+{
+  std::shuffle(triples, triples + n_cols, RandGen());
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
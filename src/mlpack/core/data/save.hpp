@@ -22,6 +22,7 @@
 #include "image_info.hpp"
 #include "detect_file_type.hpp"
 #include "save_image.hpp"
+#include "mapped_dataset.hpp"
 
 namespace mlpack {
 namespace data /** Functions to load and save matrices. */ {
@@ -42,6 +43,10 @@ namespace data /** Functions to load and save matrices. */ {
  *  - Armadillo binary (arma::arma_binary), denoted by .bin
  *  - HDF5 (arma::hdf5_binary), denoted by .hdf5, .hdf, .h5, or .he5
  *
+ * mlpack's binary dataset format (see MappedDataset), denoted by .mlds, is
+ * also supported; the matrix is always saved as it is (one point per column),
+ * so the `transpose` parameter is ignored for it.
+ *
  * By default, this function will try to automatically determine the format to
  * save with based only on the filename's extension.  If you would prefer to
  * specify a file type manually, override the default
@@ -47,6 +47,34 @@ bool Save(const std::string& filename,
 {
   Timer::Start("saving_data");
 
+  // mlpack's own dataset format is not handled by Armadillo.
+  if constexpr (std::is_arithmetic<eT>::value)
+  {
+    if (inputSaveType == FileType::AutoDetect &&
+        Extension(filename) == "mlds")
+    {
+      Log::Info << "Saving mlpack dataset to '" << filename << "'."
+          << std::endl;
+      try
+      {
+        MappedDataset<eT>::Save(filename, matrix);
+      }
+      catch (std::exception& e)
+      {
+        Timer::Stop("saving_data");
+        if (fatal)
+          Log::Fatal << e.what() << std::endl;
+        else
+          Log::Warn << e.what() << std::endl;
+
+        return false;
+      }
+
+      Timer::Stop("saving_data");
+      return true;
+    }
+  }
+
   FileType saveType = inputSaveType;
   std::string stringType = "";
 
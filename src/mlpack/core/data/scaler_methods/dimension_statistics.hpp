@@ -0,0 +1,187 @@
+/**
+ * @file core/data/scaler_methods/dimension_statistics.hpp
+ *
+ * Functions that compute the statistics of each dimension of a dataset that
+ * the scalers are fitted with, in parallel across dimensions.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SCALER_METHODS_DIMENSION_STATISTICS_HPP
+#define MLPACK_CORE_DATA_SCALER_METHODS_DIMENSION_STATISTICS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Call f(begin, end) for blocks of consecutive dimensions [begin, end) of a
+ * dataset with the given dimensionality, in parallel.  Each block is handled
+ * by a single thread that reads a contiguous part of every point, so the
+ * points are read in the order they are stored in, and threads never share
+ * the cache lines they compute statistics for.
+ *
+ * @param dimensionality Number of dimensions of the dataset.
+ * @param f Function to call for each block of dimensions.
+ */
+template<typename FunctionType>
+void ForEachDimensionBlock(const size_t dimensionality, FunctionType f)
+{
+  // Eight dimensions of doubles fill a cache line.
+  const size_t blockSize = 8;
+  const size_t numBlocks = (dimensionality + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for schedule(static)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    f(b * blockSize, std::min((b + 1) * blockSize, dimensionality));
+  }
+}
+
+/**
+ * Compute the mean of each dimension (row) of the given dataset.  This is
+ * equivalent to `arma::mean(input, 1)`.
+ *
+ * @param input Dataset (one point per column).
+ * @param itemMean Vector to store the mean of each dimension in.
+ */
+template<typename MatType>
+void DimensionMean(const MatType& input, arma::vec& itemMean)
+{
+  if (arma::is_arma_sparse_type<MatType>::value || input.n_cols == 0)
+  {
+    itemMean = arma::conv_to<arma::vec>::from(arma::mean(input, 1));
+    return;
+  }
+
+  itemMean.set_size(input.n_rows);
+  ForEachDimensionBlock(input.n_rows, [&](const size_t begin, const size_t end)
+  {
+    for (size_t r = begin; r < end; ++r)
+      itemMean[r] = 0.0;
+
+    for (size_t c = 0; c < input.n_cols; ++c)
+      for (size_t r = begin; r < end; ++r)
+        itemMean[r] += input.at(r, c);
+
+    for (size_t r = begin; r < end; ++r)
+      itemMean[r] /= input.n_cols;
+  });
+}
+
+/**
+ * Compute the standard deviation of each dimension (row) of the given dataset,
+ * normalized by the number of points, given the mean of each dimension.  This
+ * is equivalent to `arma::stddev(input, 1, 1)`.
+ *
+ * @param input Dataset (one point per column).
+ * @param itemMean Mean of each dimension, as given by DimensionMean().
+ * @param itemStdDev Vector to store the standard deviation of each dimension
+ *     in.
+ */
+template<typename MatType>
+void DimensionStdDev(const MatType& input,
+                     const arma::vec& itemMean,
+                     arma::vec& itemStdDev)
+{
+  if (arma::is_arma_sparse_type<MatType>::value || input.n_cols == 0)
+  {
+    itemStdDev = arma::conv_to<arma::vec>::from(arma::stddev(input, 1, 1));
+    return;
+  }
+
+  itemStdDev.set_size(input.n_rows);
+  ForEachDimensionBlock(input.n_rows, [&](const size_t begin, const size_t end)
+  {
+    for (size_t r = begin; r < end; ++r)
+      itemStdDev[r] = 0.0;
+
+    // The deviations are taken from the mean, which is more accurate than
+    // subtracting the squared mean from the mean of the squares.
+    for (size_t c = 0; c < input.n_cols; ++c)
+    {
+      for (size_t r = begin; r < end; ++r)
+      {
+        const double diff = input.at(r, c) - itemMean[r];
+        itemStdDev[r] += diff * diff;
+      }
+    }
+
+    for (size_t r = begin; r < end; ++r)
+      itemStdDev[r] = std::sqrt(itemStdDev[r] / input.n_cols);
+  });
+}
+
+/**
+ * Compute the minimum and maximum of each dimension (row) of the given
+ * dataset.  This is equivalent to `arma::min(input, 1)` and
+ * `arma::max(input, 1)`.
+ *
+ * @param input Dataset (one point per column).
+ * @param itemMin Vector to store the minimum of each dimension in.
+ * @param itemMax Vector to store the maximum of each dimension in.
+ */
+template<typename MatType>
+void DimensionMinMax(const MatType& input,
+                     arma::vec& itemMin,
+                     arma::vec& itemMax)
+{
+  if (arma::is_arma_sparse_type<MatType>::value || input.n_cols == 0)
+  {
+    itemMin = arma::conv_to<arma::vec>::from(arma::min(input, 1));
+    itemMax = arma::conv_to<arma::vec>::from(arma::max(input, 1));
+    return;
+  }
+
+  itemMin.set_size(input.n_rows);
+  itemMax.set_size(input.n_rows);
+  ForEachDimensionBlock(input.n_rows, [&](const size_t begin, const size_t end)
+  {
+    for (size_t r = begin; r < end; ++r)
+    {
+      itemMin[r] = input.at(r, 0);
+      itemMax[r] = input.at(r, 0);
+    }
+
+    for (size_t c = 1; c < input.n_cols; ++c)
+    {
+      for (size_t r = begin; r < end; ++r)
+      {
+        const double value = input.at(r, c);
+        itemMin[r] = std::min(itemMin[r], value);
+        itemMax[r] = std::max(itemMax[r], value);
+      }
+    }
+  });
+}
+
+/**
+ * Throw a std::invalid_argument if a scaler fitted on points with the given
+ * dimensionality cannot be merged with one fitted on points with another
+ * dimensionality.
+ *
+ * @param scalerName Name of the scaler, for the error message.
+ * @param dimensionality Dimensionality of the points of the scaler.
+ * @param otherDimensionality Dimensionality of the points of the other scaler.
+ */
+inline void CheckMergeDimensionality(const std::string& scalerName,
+                                     const size_t dimensionality,
+                                     const size_t otherDimensionality)
+{
+  if (dimensionality != otherDimensionality)
+  {
+    std::ostringstream oss;
+    oss << scalerName << "::Merge(): cannot merge a scaler fitted on points "
+        << "with " << otherDimensionality << " dimensions into one fitted on "
+        << "points with " << dimensionality << " dimensions!";
+    throw std::invalid_argument(oss.str());
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
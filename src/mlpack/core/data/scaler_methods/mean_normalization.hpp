@@ -14,6 +14,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "dimension_statistics.hpp"
+
 namespace mlpack {
 namespace data {
 
@@ -42,10 +44,18 @@ namespace data {
  * // Retransform the input.
  * scale.InverseTransform(output, input);
  * @endcode
+ *
+ * A dataset too large to fit in memory (or split across several processes)
+ * can be fitted in batches with PartialFit(), and scalers fitted on different
+ * parts of a dataset can be combined with Merge(); the result is the same as
+ * fitting the whole dataset at once.
  */
 class MeanNormalization
 {
  public:
+  //! Create an unfitted scaler.
+  MeanNormalization() : numPoints(0) { }
+
   /**
    * Function to fit features, to find out the min max and scale.
    *
@@ -54,13 +64,56 @@ class MeanNormalization
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
-    itemMin = min(input, 1);
-    itemMax = arma::max(input, 1);
-    scale = itemMax - itemMin;
-    // Handling zeros in scale vector.
-    scale.for_each([](arma::vec::elem_type& val) { val =
-        (val == 0) ? 1 : val; });
+    DimensionMean(input, itemMean);
+    DimensionMinMax(input, itemMin, itemMax);
+    numPoints = input.n_cols;
+    ComputeScale();
+  }
+
+  /**
+   * Update the scaler with another batch of points, as if it had been fitted
+   * on every batch given since the last call to Fit() at once.  For an
+   * unfitted scaler, this is the same as Fit().
+   *
+   * @param batch Batch of points to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& batch)
+  {
+    if (batch.n_cols == 0)
+      return;
+
+    MeanNormalization batchScaler;
+    batchScaler.Fit(batch);
+    Merge(batchScaler);
+  }
+
+  /**
+   * Merge the statistics of another scaler into this one, so that it is
+   * fitted on the points of both.  A std::invalid_argument is thrown if the
+   * scalers were fitted on points of different dimensionalities.
+   *
+   * @param other Scaler to merge into this one.
+   */
+  void Merge(const MeanNormalization& other)
+  {
+    if (other.numPoints == 0)
+      return;
+
+    if (numPoints == 0)
+    {
+      *this = other;
+      return;
+    }
+
+    CheckMergeDimensionality("MeanNormalization", itemMean.n_elem,
+        other.itemMean.n_elem);
+    const double n = double(numPoints) + double(other.numPoints);
+    itemMean += (other.itemMean - itemMean) * (other.numPoints / n);
+    itemMin = arma::min(itemMin, other.itemMin);
+    itemMax = arma::max(itemMax, other.itemMax);
+    numPoints += other.numPoints;
+    ComputeScale();
   }
 
   /**
@@ -102,17 +155,35 @@ class MeanNormalization
   const arma::vec& ItemMax() const { return itemMax; }
   //! Get the Scale row vector.
   const arma::vec& Scale() const { return scale; }
+  //! Get the number of points the scaler was fitted on.
+  size_t NumPoints() const { return numPoints; }
 
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */)
+  void serialize(Archive& ar, const uint32_t version)
   {
     ar(CEREAL_NVP(itemMin));
     ar(CEREAL_NVP(itemMax));
     ar(CEREAL_NVP(scale));
     ar(CEREAL_NVP(itemMean));
+
+    // Older versions do not hold the number of points, so they are treated as
+    // unfitted by PartialFit() and Merge().
+    if (version > 0)
+      ar(CEREAL_NVP(numPoints));
+    else if (cereal::is_loading<Archive>())
+      numPoints = 0;
   }
 
  private:
+  // Compute the scale from the minimum and maximum of each feature.
+  void ComputeScale()
+  {
+    scale = itemMax - itemMin;
+    // Handling zeros in scale vector.
+    scale.for_each([](arma::vec::elem_type& val) { val =
+        (val == 0) ? 1 : val; });
+  }
+
   // Vector which holds mean of each feature.
   arma::vec itemMean;
   // Vector which holds minimum of each feature.
@@ -121,9 +192,13 @@ class MeanNormalization
   arma::vec itemMax;
   // Vector which is used to scale up each feature.
   arma::vec scale;
+  // Number of points the scaler was fitted on.
+  size_t numPoints;
 }; // class MeanNormalization
 
 } // namespace data
 } // namespace mlpack
 
+CEREAL_CLASS_VERSION(mlpack::data::MeanNormalization, 1);
+
 #endif
@@ -14,6 +14,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "dimension_statistics.hpp"
+
 namespace mlpack {
 namespace data {
 
@@ -44,6 +46,11 @@ namespace data {
  * // Retransform the input.
  * scale.InverseTransform(output, input);
  * @endcode
+ *
+ * A dataset too large to fit in memory (or split across several processes)
+ * can be fitted in batches with PartialFit(), and scalers fitted on different
+ * parts of a dataset can be combined with Merge(); the result is the same as
+ * fitting the whole dataset at once.
  */
 class MinMaxScaler
 {
@@ -54,7 +61,7 @@ class MinMaxScaler
    * @param min Lower range of scaling.
    * @param max Upper range of scaling.
    */
-  MinMaxScaler(const double min = 0, const double max = 1)
+  MinMaxScaler(const double min = 0, const double max = 1) : numPoints(0)
   {
     scaleMin = min;
     scaleMax = max;
@@ -73,16 +80,57 @@ class MinMaxScaler
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMin = min(input, 1);
-    itemMax = arma::max(input, 1);
-    scale = itemMax - itemMin;
-    // Handle zeros in scale vector.
-    scale.for_each([](arma::vec::elem_type& val) { val =
-        (val == 0) ? 1 : val; });
-    scale = (scaleMax - scaleMin) / scale;
-    scalerowmin.copy_size(itemMin);
-    scalerowmin.fill(scaleMin);
-    scalerowmin = scalerowmin - itemMin % scale;
+    DimensionMinMax(input, itemMin, itemMax);
+    numPoints = input.n_cols;
+    ComputeScale();
+  }
+
+  /**
+   * Update the scaler with another batch of points, as if it had been fitted
+   * on every batch given since the last call to Fit() at once.  For an
+   * unfitted scaler, this is the same as Fit().
+   *
+   * @param batch Batch of points to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& batch)
+  {
+    if (batch.n_cols == 0)
+      return;
+
+    MinMaxScaler batchScaler(scaleMin, scaleMax);
+    batchScaler.Fit(batch);
+    Merge(batchScaler);
+  }
+
+  /**
+   * Merge the statistics of another scaler into this one, so that it is
+   * fitted on the points of both; the range of this scaler is kept.  A
+   * std::invalid_argument is thrown if the scalers were fitted on points of
+   * different dimensionalities.
+   *
+   * @param other Scaler to merge into this one.
+   */
+  void Merge(const MinMaxScaler& other)
+  {
+    if (other.numPoints == 0)
+      return;
+
+    if (numPoints == 0)
+    {
+      itemMin = other.itemMin;
+      itemMax = other.itemMax;
+    }
+    else
+    {
+      CheckMergeDimensionality("MinMaxScaler", itemMin.n_elem,
+          other.itemMin.n_elem);
+      itemMin = arma::min(itemMin, other.itemMin);
+      itemMax = arma::max(itemMax, other.itemMax);
+    }
+
+    numPoints += other.numPoints;
+    ComputeScale();
   }
 
   /**
@@ -126,9 +174,11 @@ class MinMaxScaler
   double ScaleMax() const { return scaleMax; }
   //! Get the lower range parameter.
   double ScaleMin() const { return scaleMin; }
+  //! Get the number of points the scaler was fitted on.
+  size_t NumPoints() const { return numPoints; }
 
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */)
+  void serialize(Archive& ar, const uint32_t version)
   {
     ar(CEREAL_NVP(itemMin));
     ar(CEREAL_NVP(itemMax));
@@ -136,9 +186,29 @@ class MinMaxScaler
     ar(CEREAL_NVP(scaleMin));
     ar(CEREAL_NVP(scaleMax));
     ar(CEREAL_NVP(scalerowmin));
+
+    // Older versions do not hold the number of points, so they are treated as
+    // unfitted by PartialFit() and Merge().
+    if (version > 0)
+      ar(CEREAL_NVP(numPoints));
+    else if (cereal::is_loading<Archive>())
+      numPoints = 0;
   }
 
  private:
+  // Compute the scale from the minimum and maximum of each feature.
+  void ComputeScale()
+  {
+    scale = itemMax - itemMin;
+    // Handle zeros in scale vector.
+    scale.for_each([](arma::vec::elem_type& val) { val =
+        (val == 0) ? 1 : val; });
+    scale = (scaleMax - scaleMin) / scale;
+    scalerowmin.copy_size(itemMin);
+    scalerowmin.fill(scaleMin);
+    scalerowmin = scalerowmin - itemMin % scale;
+  }
+
   // Vector which holds minimum of each feature.
   arma::vec itemMin;
   // Vector which holds maximum of each feature.
@@ -151,9 +221,13 @@ class MinMaxScaler
   double scaleMax;
   // Column vector of scalemin
   arma::vec scalerowmin;
+  // Number of points the scaler was fitted on.
+  size_t numPoints;
 }; // class MinMaxScaler
 
 } // namespace data
 } // namespace mlpack
 
+CEREAL_CLASS_VERSION(mlpack::data::MinMaxScaler, 1);
+
 #endif
@@ -15,6 +15,8 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/math/ccov.hpp>
 
+#include "dimension_statistics.hpp"
+
 namespace mlpack {
 namespace data {
 
@@ -42,6 +44,14 @@ namespace data {
  * // Retransform the input.
  * scale.InverseTransform(output, input);
  * @endcode
+ *
+ * A dataset too large to fit in memory (or split across several processes)
+ * can be fitted in batches with PartialFit(), and scalers fitted on different
+ * parts of a dataset can be combined with Merge().  The scaler holds the mean
+ * and the scatter matrix (the sum of the outer products of the deviations
+ * from the mean) of the points, which are updated with the pairwise algorithm
+ * of Chan et al., so the result is the same as fitting the whole dataset at
+ * once.
  */
 class PCAWhitening
 {
@@ -51,7 +61,7 @@ class PCAWhitening
    *
    * @param eps Regularization parameter.
    */
-  PCAWhitening(double eps = 0.00005)
+  PCAWhitening(double eps = 0.00005) : numPoints(0)
   {
     epsilon = eps;
     // Ensure scaleMin is smaller than scaleMax.
@@ -70,10 +80,61 @@ class PCAWhitening
   void Fit(const MatType& input)
   {
     itemMean = arma::mean(input, 1);
-    // Get eigenvectors and eigenvalues of covariance of input matrix.
-    eig_sym(eigenValues, eigenVectors, ColumnCovariance(
-        input.each_col() - itemMean));
-    eigenValues += epsilon;
+    const arma::mat centered = input.each_col() - itemMean;
+    scatter = centered * centered.t();
+    numPoints = input.n_cols;
+    ComputeEigen();
+  }
+
+  /**
+   * Update the scaler with another batch of points, as if it had been fitted
+   * on every batch given since the last call to Fit() at once.  For an
+   * unfitted scaler, this is the same as Fit().
+   *
+   * @param batch Batch of points to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& batch)
+  {
+    if (batch.n_cols == 0)
+      return;
+
+    PCAWhitening batchScaler(epsilon);
+    batchScaler.Fit(batch);
+    Merge(batchScaler);
+  }
+
+  /**
+   * Merge the statistics of another scaler into this one, so that it is
+   * fitted on the points of both; the regularization parameter of this
+   * scaler is kept.  A std::invalid_argument is thrown if the scalers were
+   * fitted on points of different dimensionalities.
+   *
+   * @param other Scaler to merge into this one.
+   */
+  void Merge(const PCAWhitening& other)
+  {
+    if (other.numPoints == 0)
+      return;
+
+    if (numPoints == 0)
+    {
+      itemMean = other.itemMean;
+      scatter = other.scatter;
+    }
+    else
+    {
+      CheckMergeDimensionality("PCAWhitening", itemMean.n_elem,
+          other.itemMean.n_elem);
+      const double n = double(numPoints) + double(other.numPoints);
+      const arma::vec delta = other.itemMean - itemMean;
+      itemMean += delta * (other.numPoints / n);
+      scatter += other.scatter + (delta * delta.t()) *
+          (numPoints * (other.numPoints / n));
+    }
+
+    numPoints += other.numPoints;
+    ComputeEigen();
   }
 
   /**
@@ -118,17 +179,41 @@ class PCAWhitening
   const arma::mat& EigenVectors() const { return eigenVectors; }
   //! Get the regularization parameter.
   const double& Epsilon() const { return epsilon; }
+  //! Get the number of points the scaler was fitted on.
+  size_t NumPoints() const { return numPoints; }
 
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */)
+  void serialize(Archive& ar, const uint32_t version)
   {
     ar(CEREAL_NVP(eigenValues));
     ar(CEREAL_NVP(eigenVectors));
     ar(CEREAL_NVP(itemMean));
     ar(CEREAL_NVP(epsilon));
+
+    // Older versions do not hold the running statistics, so they are treated
+    // as unfitted by PartialFit() and Merge().
+    if (version > 0)
+    {
+      ar(CEREAL_NVP(numPoints));
+      ar(CEREAL_NVP(scatter));
+    }
+    else if (cereal::is_loading<Archive>())
+    {
+      numPoints = 0;
+      scatter.clear();
+    }
   }
 
  private:
+  // Compute the eigendecomposition of the covariance of the points from the
+  // scatter matrix.
+  void ComputeEigen()
+  {
+    const double norm = (numPoints > 1) ? double(numPoints - 1) : 1.0;
+    eig_sym(eigenValues, eigenVectors, arma::mat(scatter / norm));
+    eigenValues += epsilon;
+  }
+
   // Vector which holds mean of each feature.
   arma::vec itemMean;
   // Mat which hold the eigenvectors.
@@ -137,9 +222,16 @@ class PCAWhitening
   double epsilon;
   // Vector which hold the eigenvalues.
   arma::vec eigenValues;
+  // Number of points the scaler was fitted on.
+  size_t numPoints;
+  // Matrix which holds the sum of the outer products of the deviations of the
+  // points from the mean.
+  arma::mat scatter;
 }; // class PCAWhitening
 
 } // namespace data
 } // namespace mlpack
 
+CEREAL_CLASS_VERSION(mlpack::data::PCAWhitening, 1);
+
 #endif
@@ -14,6 +14,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "dimension_statistics.hpp"
+
 namespace mlpack {
 namespace data {
 
@@ -43,20 +45,82 @@ namespace data {
  * // Retransform the input.
  * scale.InverseTransform(output, input);
  * @endcode
+ *
+ * A dataset too large to fit in memory (or split across several processes)
+ * can be fitted in batches with PartialFit(), and scalers fitted on different
+ * parts of a dataset can be combined with Merge(); the mean and the variance
+ * are updated with the pairwise algorithm of Chan et al., so the result is
+ * the same as fitting the whole dataset at once.
  */
 class StandardScaler
 {
  public:
+  //! Create an unfitted scaler.
+  StandardScaler() : numPoints(0) { }
+
   /**
-   * Function to fit features, to find out the min max and scale.
+   * Function to fit features, to find out the mean and standard deviation.
    *
    * @param input Dataset to fit.
    */
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
-    itemStdDev = arma::stddev(input, 1, 1);
+    DimensionMean(input, itemMean);
+    DimensionStdDev(input, itemMean, itemStdDev);
+    numPoints = input.n_cols;
+    sumSquares = arma::square(itemStdDev) * double(numPoints);
+    // Handle zeros in scale vector.
+    itemStdDev.for_each([](arma::vec::elem_type& val) { val =
+        (val == 0) ? 1 : val; });
+  }
+
+  /**
+   * Update the scaler with another batch of points, as if it had been fitted
+   * on every batch given since the last call to Fit() at once.  For an
+   * unfitted scaler, this is the same as Fit().
+   *
+   * @param batch Batch of points to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& batch)
+  {
+    if (batch.n_cols == 0)
+      return;
+
+    StandardScaler batchScaler;
+    batchScaler.Fit(batch);
+    Merge(batchScaler);
+  }
+
+  /**
+   * Merge the statistics of another scaler into this one, so that it is
+   * fitted on the points of both.  A std::invalid_argument is thrown if the
+   * scalers were fitted on points of different dimensionalities.
+   *
+   * @param other Scaler to merge into this one.
+   */
+  void Merge(const StandardScaler& other)
+  {
+    if (other.numPoints == 0)
+      return;
+
+    if (numPoints == 0)
+    {
+      *this = other;
+      return;
+    }
+
+    CheckMergeDimensionality("StandardScaler", itemMean.n_elem,
+        other.itemMean.n_elem);
+    const double n = double(numPoints) + double(other.numPoints);
+    const arma::vec delta = other.itemMean - itemMean;
+    itemMean += delta * (other.numPoints / n);
+    sumSquares += other.sumSquares + arma::square(delta) *
+        (numPoints * (other.numPoints / n));
+    numPoints += other.numPoints;
+
+    itemStdDev = arma::sqrt(sumSquares / double(numPoints));
     // Handle zeros in scale vector.
     itemStdDev.for_each([](arma::vec::elem_type& val) { val =
         (val == 0) ? 1 : val; });
@@ -97,12 +161,27 @@ class StandardScaler
   const arma::vec& ItemMean() const { return itemMean; }
   //! Get the standard deviation row vector.
   const arma::vec& ItemStdDev() const { return itemStdDev; }
+  //! Get the number of points the scaler was fitted on.
+  size_t NumPoints() const { return numPoints; }
 
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */)
+  void serialize(Archive& ar, const uint32_t version)
   {
     ar(CEREAL_NVP(itemMean));
     ar(CEREAL_NVP(itemStdDev));
+
+    // Older versions do not hold the running statistics, so they are treated
+    // as unfitted by PartialFit() and Merge().
+    if (version > 0)
+    {
+      ar(CEREAL_NVP(numPoints));
+      ar(CEREAL_NVP(sumSquares));
+    }
+    else if (cereal::is_loading<Archive>())
+    {
+      numPoints = 0;
+      sumSquares.clear();
+    }
   }
 
  private:
@@ -110,9 +189,16 @@ class StandardScaler
   arma::vec itemMean;
   // Vector which holds standard devation of each feature.
   arma::vec itemStdDev;
+  // Number of points the scaler was fitted on.
+  size_t numPoints;
+  // Vector which holds the sum of squared deviations from the mean of each
+  // feature.
+  arma::vec sumSquares;
 }; // class StandardScaler
 
 } // namespace data
 } // namespace mlpack
 
+CEREAL_CLASS_VERSION(mlpack::data::StandardScaler, 1);
+
 #endif
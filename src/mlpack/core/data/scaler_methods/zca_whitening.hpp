@@ -64,6 +64,29 @@ class ZCAWhitening
     pca.Fit(input);
   }
 
+  /**
+   * Update the scaler with another batch of points; see
+   * PCAWhitening::PartialFit().
+   *
+   * @param batch Batch of points to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& batch)
+  {
+    pca.PartialFit(batch);
+  }
+
+  /**
+   * Merge the statistics of another scaler into this one; see
+   * PCAWhitening::Merge().
+   *
+   * @param other Scaler to merge into this one.
+   */
+  void Merge(const ZCAWhitening& other)
+  {
+    pca.Merge(other.pca);
+  }
+
   /**
    * Function for ZCA whitening.
    *
@@ -99,6 +122,8 @@ class ZCAWhitening
   const arma::mat& EigenVectors() const { return pca.EigenVectors(); }
   //! Get the regularization parameter.
   double Epsilon() const { return pca.Epsilon(); }
+  //! Get the number of points the scaler was fitted on.
+  size_t NumPoints() const { return pca.NumPoints(); }
 
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
@@ -62,6 +62,116 @@ void SplitHelper(const InputType& input,
   }
 }
 
+/**
+ * Compute the indices of the points of the training set and the test set
+ * that Split() would give for a dataset with the given number of points,
+ * instead of copying the points.  The sets can be accessed without copying
+ * them with `input.cols(trainIndices)`, or the indices can be given to
+ * methods that take the indices of the points to use.
+ *
+ * @code
+ * arma::uvec trainIndices, testIndices;
+ * std::tie(trainIndices, testIndices) = SplitIndices(input.n_cols, 0.3);
+ * @endcode
+ *
+ * @param numPoints Number of points of the dataset.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *     sample is visited in linear order. (Default true.)
+ * @return std::pair of the indices of the training points and of the test
+ *     points.
+ */
+inline std::pair<arma::uvec, arma::uvec> SplitIndices(
+    const size_t numPoints,
+    const double testRatio,
+    const bool shuffleData = true)
+{
+  const size_t testSize = static_cast<size_t>(numPoints * testRatio);
+  const size_t trainSize = numPoints - testSize;
+
+  arma::uvec order;
+  if (numPoints > 0)
+  {
+    order = arma::linspace<arma::uvec>(0, numPoints - 1, numPoints);
+    if (shuffleData)
+      order = arma::shuffle(order);
+  }
+
+  return std::make_pair(arma::uvec(order.head(trainSize)),
+                        arma::uvec(order.tail(testSize)));
+}
+
+/**
+ * Compute the indices of the points of the training set and the test set
+ * that StratifiedSplit() would give for the given labels, instead of copying
+ * the points.  Expects labels to be of type arma::Row<> or arma::Col<>;
+ * throws a runtime error if this is not the case.
+ *
+ * @param inputLabel Labels of the points to stratify.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *     sample is visited in linear order. (Default true.)
+ * @return std::pair of the indices of the training points and of the test
+ *     points.
+ */
+template<typename LabelsType,
+         typename = std::enable_if_t<arma::is_arma_type<LabelsType>::value> >
+std::pair<arma::uvec, arma::uvec> StratifiedSplitIndices(
+    const LabelsType& inputLabel,
+    const double testRatio,
+    const bool shuffleData = true)
+{
+  const bool typeCheck = (arma::is_Row<LabelsType>::value)
+      || (arma::is_Col<LabelsType>::value);
+  if (!typeCheck)
+    throw std::runtime_error("data::Split(): when stratified sampling is done, "
+        "labels must have type `arma::Row<>`!");
+
+  size_t trainIdx = 0;
+  size_t testIdx = 0;
+  size_t trainSize = 0;
+  size_t testSize = 0;
+  arma::uvec labelCounts;
+  arma::uvec testLabelCounts;
+  typename LabelsType::elem_type maxLabel = inputLabel.max();
+
+  labelCounts.zeros(maxLabel+1);
+  testLabelCounts.zeros(maxLabel+1);
+
+  for (typename LabelsType::elem_type label : inputLabel)
+    ++labelCounts[label];
+
+  for (arma::uword labelCount : labelCounts)
+  {
+    testSize += floor(labelCount * testRatio);
+    trainSize += labelCount - floor(labelCount * testRatio);
+  }
+
+  arma::uvec trainIndices(trainSize);
+  arma::uvec testIndices(testSize);
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, inputLabel.n_elem - 1,
+      inputLabel.n_elem);
+  if (shuffleData)
+    order = arma::shuffle(order);
+
+  for (arma::uword i : order)
+  {
+    typename LabelsType::elem_type label = inputLabel[i];
+    if (testLabelCounts[label] < floor(labelCounts[label] * testRatio))
+    {
+      testLabelCounts[label] += 1;
+      testIndices[testIdx++] = i;
+    }
+    else
+    {
+      trainIndices[trainIdx++] = i;
+    }
+  }
+
+  return std::make_pair(std::move(trainIndices), std::move(testIndices));
+}
+
 /**
  * Given an input dataset and labels, stratify into a training set and test set.
  * It is recommended to have the input labels between the range [0, n) where n
@@ -142,80 +252,19 @@ void StratifiedSplit(const arma::Mat<T>& input,
    * 0
    * 1 1
    */
-  const bool typeCheck = (arma::is_Row<LabelsType>::value)
-      || (arma::is_Col<LabelsType>::value);
-  if (!typeCheck)
-    throw std::runtime_error("data::Split(): when stratified sampling is done, "
-        "labels must have type `arma::Row<>`!");
+  arma::uvec trainIndices, testIndices;
+  std::tie(trainIndices, testIndices) = StratifiedSplitIndices(inputLabel,
+      testRatio, shuffleData);
   util::CheckSameSizes(input, inputLabel, "data::Split()");
-  size_t trainIdx = 0;
-  size_t testIdx = 0;
-  size_t trainSize = 0;
-  size_t testSize = 0;
-  arma::uvec labelCounts;
-  arma::uvec testLabelCounts;
-  typename LabelsType::elem_type maxLabel = inputLabel.max();
 
-  labelCounts.zeros(maxLabel+1);
-  testLabelCounts.zeros(maxLabel+1);
-
-  for (typename LabelsType::elem_type label : inputLabel)
-    ++labelCounts[label];
-
-  for (arma::uword labelCount : labelCounts)
-  {
-    testSize += floor(labelCount * testRatio);
-    trainSize += labelCount - floor(labelCount * testRatio);
-  }
-
-  trainData.set_size(input.n_rows, trainSize);
-  testData.set_size(input.n_rows, testSize);
-  trainLabel.set_size(inputLabel.n_rows, trainSize);
-  testLabel.set_size(inputLabel.n_rows, testSize);
-
-  if (shuffleData)
-  {
-    arma::uvec order = arma::shuffle(
-        arma::linspace<arma::uvec>(0, input.n_cols - 1, input.n_cols));
-
-    for (arma::uword i : order)
-    {
-      typename LabelsType::elem_type label = inputLabel[i];
-      if (testLabelCounts[label] < floor(labelCounts[label] * testRatio))
-      {
-        testLabelCounts[label] += 1;
-        testData.col(testIdx) = input.col(i);
-        testLabel[testIdx] = inputLabel[i];
-        testIdx += 1;
-      }
-      else
-      {
-        trainData.col(trainIdx) = input.col(i);
-        trainLabel[trainIdx] = inputLabel[i];
-        trainIdx += 1;
-      }
-    }
-  }
-  else
-  {
-    for (arma::uword i = 0; i < input.n_cols; i++)
-    {
-      typename LabelsType::elem_type label = inputLabel[i];
-      if (testLabelCounts[label] < floor(labelCounts[label] * testRatio))
-      {
-        testLabelCounts[label] += 1;
-        testData.col(testIdx) = input.col(i);
-        testLabel[testIdx] = inputLabel[i];
-        testIdx += 1;
-      }
-      else
-      {
-        trainData.col(trainIdx) = input.col(i);
-        trainLabel[trainIdx] = inputLabel[i];
-        trainIdx += 1;
-      }
-    }
-  }
+  trainData = input.cols(trainIndices);
+  testData = input.cols(testIndices);
+  trainLabel.set_size(inputLabel.n_rows, trainIndices.n_elem);
+  testLabel.set_size(inputLabel.n_rows, testIndices.n_elem);
+  for (size_t i = 0; i < trainIndices.n_elem; ++i)
+    trainLabel[i] = inputLabel[trainIndices[i]];
+  for (size_t i = 0; i < testIndices.n_elem; ++i)
+    testLabel[i] = inputLabel[testIndices[i]];
 }
 
 /**
@@ -98,6 +98,11 @@ class StringEncoding
    * writes it in the column-major order. If the output type is 2D std::vector
    * then the function writes it in the row major order.
    *
+   * With the bag of words and tf-idf policies, sparse outputs are built
+   * directly from the counts of the tokens of each string, without a dense
+   * intermediate, and the strings are tokenized in parallel; the dictionary
+   * gets the same labels as with a sequential encoding.
+   *
    * @tparam OutputType Type of the output container. The function supports
    *                    the following types: arma::mat, arma::sp_mat,
    *                    std::vector<std::vector<>>.
@@ -201,6 +206,32 @@ class StringEncoding
                     typename std::enable_if<StringEncodingPolicyTraits<
                         PolicyType>::onePassEncoding>::type* = 0);
 
+  /**
+   * A helper function to encode the given text into a sparse matrix, for
+   * policies whose encoded values only depend on the counts of the tokens.
+   * The strings are split into chunks that are tokenized in parallel, each
+   * with its own dictionary; the dictionaries of the chunks are then merged
+   * into the dictionary in order, so that each token gets the label of its
+   * first occurrence.  The encoder writes data in the column-major order.
+   *
+   * @tparam TokenizerType Type of the tokenizer.
+   * @tparam PolicyType The type of the encoding policy. It has to be
+   *                    equal to EncodingPolicyType.
+   * @tparam ElemType Type of the output values.
+   *
+   * @param input Corpus of text to encode.
+   * @param output Output sparse matrix to store the result.
+   * @param tokenizer The tokenizer object; it is used concurrently.
+   * @param policy The policy object.
+   */
+  template<typename TokenizerType, typename PolicyType, typename ElemType>
+  void EncodeHelper(const std::vector<std::string>& input,
+                    arma::SpMat<ElemType>& output,
+                    const TokenizerType& tokenizer,
+                    PolicyType& policy,
+                    typename std::enable_if<StringEncodingPolicyTraits<
+                        PolicyType>::countEncoding>::type* = 0);
+
  private:
   //! The encoding policy object.
   EncodingPolicyType encodingPolicy;
@@ -16,6 +16,7 @@
 // In case it hasn't been included yet.
 #include "string_encoding.hpp"
 #include <type_traits>
+#include <unordered_map>
 
 namespace mlpack {
 namespace data {
@@ -196,6 +197,145 @@ EncodeHelper(const std::vector<std::string>& input,
   }
 }
 
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename TokenizerType, typename PolicyType, typename ElemType>
+void StringEncoding<EncodingPolicyType, DictionaryType>::
+EncodeHelper(const std::vector<std::string>& input,
+             arma::SpMat<ElemType>& output,
+             const TokenizerType& tokenizer,
+             PolicyType& policy,
+             typename std::enable_if<StringEncodingPolicyTraits<
+                 PolicyType>::countEncoding>::type*)
+{
+  using TokenType = typename std::remove_reference<
+      typename DictionaryType::TokenType>::type;
+
+  policy.Reset();
+
+  // Use a few chunks for each thread, to balance the load.
+  size_t numThreads = 1;
+  #ifdef MLPACK_USE_OPENMP
+  numThreads = omp_get_max_threads();
+  #endif
+  const size_t numLines = input.size();
+  const size_t numChunks = std::max<size_t>(1,
+      std::min(numLines, 4 * numThreads));
+  std::vector<size_t> starts(numChunks + 1);
+  for (size_t c = 0; c <= numChunks; ++c)
+    starts[c] = c * numLines / numChunks;
+
+  // The distinct tokens of each chunk, in the order of their first
+  // occurrence, and the number of lines of the chunk that contain each of
+  // them.
+  std::vector<std::vector<TokenType>> chunkTokens(numChunks);
+  std::vector<std::vector<size_t>> chunkContaining(numChunks);
+  // The chunk index and the number of occurrences of each distinct token of
+  // each line, sorted by index, and the number of tokens of each line.
+  std::vector<std::vector<std::pair<size_t, size_t>>> lineCounts(numLines);
+  std::vector<size_t> lineSizes(numLines, 0);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    std::unordered_map<TokenType, size_t> chunkDictionary;
+    std::vector<size_t> indices;
+    for (size_t i = starts[c]; i < starts[c + 1]; ++i)
+    {
+      std::string_view strView(input[i]);
+      auto token = tokenizer(strView);
+
+      static_assert(
+          std::is_same<typename std::remove_reference<decltype(token)>::type,
+                       TokenType>::value,
+          "The dictionary token type doesn't match the return value type "
+          "of the tokenizer.");
+
+      indices.clear();
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        auto it = chunkDictionary.find(token);
+        if (it == chunkDictionary.end())
+        {
+          it = chunkDictionary.emplace(token, chunkTokens[c].size()).first;
+          chunkTokens[c].push_back(token);
+          chunkContaining[c].push_back(0);
+        }
+
+        indices.push_back(it->second);
+        token = tokenizer(strView);
+      }
+
+      lineSizes[i] = indices.size();
+      std::sort(indices.begin(), indices.end());
+      for (size_t k = 0; k < indices.size(); ++k)
+      {
+        if (k == 0 || indices[k] != indices[k - 1])
+        {
+          lineCounts[i].emplace_back(indices[k], 1);
+          chunkContaining[c][indices[k]]++;
+        }
+        else
+        {
+          lineCounts[i].back().second++;
+        }
+      }
+    }
+  }
+
+  // Merge the dictionaries of the chunks in order.  Labels start from one.
+  std::vector<std::vector<size_t>> labels(numChunks);
+  std::vector<size_t> numContaining;
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    labels[c].resize(chunkTokens[c].size());
+    for (size_t k = 0; k < chunkTokens[c].size(); ++k)
+    {
+      const TokenType& token = chunkTokens[c][k];
+      labels[c][k] = dictionary.HasToken(token) ? dictionary.Value(token) :
+          dictionary.AddToken(token);
+
+      if (numContaining.size() <= labels[c][k])
+        numContaining.resize(labels[c][k] + 1, 0);
+      numContaining[labels[c][k]] += chunkContaining[c][k];
+    }
+  }
+
+  // Build the matrix from the counts of each line.
+  std::vector<size_t> offsets(numLines + 1, 0);
+  for (size_t i = 0; i < numLines; ++i)
+    offsets[i + 1] = offsets[i] + lineCounts[i].size();
+
+  arma::umat locations(2, offsets[numLines]);
+  arma::Col<ElemType> values(offsets[numLines]);
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    for (size_t i = starts[c]; i < starts[c + 1]; ++i)
+    {
+      std::vector<std::pair<size_t, size_t>>& counts = lineCounts[i];
+      for (size_t k = 0; k < counts.size(); ++k)
+        counts[k].first = labels[c][counts[k].first];
+
+      // The locations have to be sorted within each column.
+      std::sort(counts.begin(), counts.end());
+      for (size_t k = 0; k < counts.size(); ++k)
+      {
+        locations(0, offsets[i] + k) = counts[k].first - 1;
+        locations(1, offsets[i] + k) = i;
+        values[offsets[i] + k] = policy.template CountValue<ElemType>(
+            counts[k].second, lineSizes[i], numLines,
+            numContaining[counts[k].first]);
+      }
+
+      // Free the memory of the line.
+      std::vector<std::pair<size_t, size_t>>().swap(counts);
+    }
+  }
+
+  output = arma::SpMat<ElemType>(locations, values, dictionary.Size(),
+      numLines, false, true);
+}
+
 template<typename EncodingPolicyType, typename DictionaryType>
 template<typename Archive>
 void StringEncoding<EncodingPolicyType, DictionaryType>::serialize(
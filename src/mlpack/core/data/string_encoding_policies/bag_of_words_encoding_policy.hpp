@@ -146,6 +146,27 @@ class BagOfWordsEncodingPolicy
                               size_t /* value */)
   { }
 
+  /**
+   * Return the encoded value of a token that occurs the given number of times
+   * in a string; this is used to encode into sparse matrices.
+   *
+   * @tparam ElemType Type of the output values.
+   *
+   * @param numOccurrences The number of occurrences of the token in the line.
+   * @param * (numTokens) The total number of tokens in the line (not used).
+   * @param * (totalNumLines) The number of strings (not used).
+   * @param * (numContainingLines) The number of strings which contain the
+   *     token (not used).
+   */
+  template<typename ElemType>
+  static ElemType CountValue(const size_t numOccurrences,
+                             const size_t /* numTokens */,
+                             const size_t /* totalNumLines */,
+                             const size_t /* numContainingLines */)
+  {
+    return ElemType(numOccurrences);
+  }
+
   /**
    * Serialize the class to the given archive.
    */
@@ -156,6 +177,26 @@ class BagOfWordsEncodingPolicy
   }
 };
 
+/**
+ * The specialization provides some information about the bag of words
+ * encoding policy.
+ */
+template<>
+struct StringEncodingPolicyTraits<BagOfWordsEncodingPolicy>
+{
+  /**
+   * Indicates if the policy is able to encode the token at once without
+   * any information about other tokens as well as the total tokens count.
+   */
+  static const bool onePassEncoding = false;
+
+  /**
+   * Indicates if the encoded value of a token only depends on the counts of
+   * the token.
+   */
+  static const bool countEncoding = true;
+};
+
 /**
  * A convenient alias for the StringEncoding class with BagOfWordsEncodingPolicy
  * and the default dictionary for the given token type.
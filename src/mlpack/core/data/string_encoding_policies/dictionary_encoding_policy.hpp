@@ -133,6 +133,12 @@ struct StringEncodingPolicyTraits<DictionaryEncodingPolicy>
    * any information about other tokens as well as the total tokens count.
    */
   static const bool onePassEncoding = true;
+
+  /**
+   * Indicates if the encoded value of a token only depends on the counts of
+   * the token.
+   */
+  static const bool countEncoding = false;
 };
 
 /**
@@ -31,6 +31,15 @@ struct StringEncodingPolicyTraits
    * any information about other tokens as well as the total tokens count.
    */
   static const bool onePassEncoding = false;
+
+  /**
+   * Indicates if the encoded value of a token in a string only depends on the
+   * number of times it occurs in the string, the number of tokens of the
+   * string, the number of strings and the number of strings that contain the
+   * token.  Such policies provide a CountValue() method, and can encode into a
+   * sparse matrix directly.
+   */
+  static const bool countEncoding = false;
 };
 
 } // namespace data
@@ -217,6 +217,28 @@ class TfIdfEncodingPolicy
     linesSizes[line]++;
   }
 
+  /**
+   * Return the encoded value of a token that occurs the given number of times
+   * in a string; this is used to encode into sparse matrices, and does not use
+   * the statistics gathered by PreprocessToken().
+   *
+   * @tparam ElemType Type of the output values.
+   *
+   * @param numOccurrences The number of occurrences of the token in the line.
+   * @param numTokens The total number of tokens in the line.
+   * @param totalNumLines The number of strings in the input dataset.
+   * @param numContainingLines The number of strings which contain the token.
+   */
+  template<typename ElemType>
+  ElemType CountValue(const size_t numOccurrences,
+                      const size_t numTokens,
+                      const size_t totalNumLines,
+                      const size_t numContainingLines)
+  {
+    return TermFrequency<ElemType>(numOccurrences, numTokens) *
+        InverseDocumentFrequency<ElemType>(totalNumLines, numContainingLines);
+  }
+
   //! Return token frequencies.
   const std::vector<std::unordered_map<size_t, size_t>>&
       TokensFrequences() const { return tokensFrequences; }
@@ -334,6 +356,26 @@ class TfIdfEncodingPolicy
   bool smoothIdf;
 };
 
+/**
+ * The specialization provides some information about the tf-idf encoding
+ * policy.
+ */
+template<>
+struct StringEncodingPolicyTraits<TfIdfEncodingPolicy>
+{
+  /**
+   * Indicates if the policy is able to encode the token at once without
+   * any information about other tokens as well as the total tokens count.
+   */
+  static const bool onePassEncoding = false;
+
+  /**
+   * Indicates if the encoded value of a token only depends on the counts of
+   * the token.
+   */
+  static const bool countEncoding = true;
+};
+
 /**
  * A convenient alias for the StringEncoding class with TfIdfEncodingPolicy
  * and the default dictionary for the given token type.
@@ -15,6 +15,7 @@
 #define MLPACK_CORE_DISTANCES_DISTANCES_HPP
 
 #include "lmetric.hpp"
+#include "fixed_lmetric.hpp"
 #include "mahalanobis_distance.hpp"
 #include "ip_metric.hpp"
 #include "iou_distance.hpp"
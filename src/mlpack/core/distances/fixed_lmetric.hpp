@@ -0,0 +1,85 @@
+/**
+ * @file core/distances/fixed_lmetric.hpp
+ *
+ * An L-metric for points whose dimensionality is known at compile time, so
+ * that the distance computation is a loop with a compile-time trip count.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DISTANCES_FIXED_LMETRIC_HPP
+#define MLPACK_CORE_DISTANCES_FIXED_LMETRIC_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * The L_p metric for points of dimensionality Dim, where Dim is known at
+ * compile time.  This gives the same results as LMetric<Power, TakeRoot>, but
+ * the distance is computed with a loop over exactly Dim elements that the
+ * compiler can fully unroll and vectorize, instead of with Armadillo
+ * expressions; for low-dimensional data (e.g. 2-D or 3-D points, or small
+ * embeddings) this is much faster.  The points must be dense vectors (e.g.
+ * arma::vec, arma::vec::fixed<Dim>, or columns of an arma::mat) with exactly
+ * Dim elements; this is not checked.
+ *
+ * LMetric does not use this class; it must be chosen explicitly, by giving it
+ * to trees and other algorithms as the distance metric when the
+ * dimensionality is known in advance.  The root of the Euclidean distance is a
+ * plain square root, not the overflow-safe arma::norm() of LMetric.
+ *
+ * @code
+ * // Nearest neighbor search on 3-dimensional points.
+ * NeighborSearch<NearestNeighborSort, FixedLMetric<2, 3>> knn(points);
+ * @endcode
+ *
+ * @tparam Power Power of metric; i.e. Power = 1 gives the L1-norm (Manhattan
+ *    distance), and Power = INT_MAX gives the L-infinity norm.
+ * @tparam Dim Dimensionality of the points.
+ * @tparam TakeRoot If true, the Power'th root of the result is taken before it
+ *    is returned.
+ */
+template<int TPower, size_t TDim, bool TTakeRoot = true>
+class FixedLMetric
+{
+ public:
+  /**
+   * Default constructor does nothing, but is required to satisfy the Metric
+   * policy.
+   */
+  FixedLMetric() { }
+
+  /**
+   * Computes the distance between two points of dimensionality Dim.
+   *
+   * @tparam VecTypeA Type of first vector (a dense vector type).
+   * @tparam VecTypeB Type of second vector.
+   * @param a First vector.
+   * @param b Second vector.
+   * @return Distance between vectors a and b.
+   */
+  template<typename VecTypeA, typename VecTypeB>
+  static typename VecTypeA::elem_type Evaluate(const VecTypeA& a,
+                                               const VecTypeB& b);
+
+  //! Serialize the metric (nothing to do).
+  template<typename Archive>
+  void serialize(Archive& /* ar */, const uint32_t /* version */) { }
+
+  //! The power of the metric.
+  static const int Power = TPower;
+  //! The dimensionality of the points.
+  static const size_t Dim = TDim;
+  //! Whether or not the root is taken.
+  static const bool TakeRoot = TTakeRoot;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "fixed_lmetric_impl.hpp"
+
+#endif
@@ -0,0 +1,63 @@
+/**
+ * @file core/distances/fixed_lmetric_impl.hpp
+ *
+ * Implementation of the FixedLMetric class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DISTANCES_FIXED_LMETRIC_IMPL_HPP
+#define MLPACK_CORE_DISTANCES_FIXED_LMETRIC_IMPL_HPP
+
+// In case it hasn't been included.
+#include "fixed_lmetric.hpp"
+
+namespace mlpack {
+
+template<int Power, size_t Dim, bool TakeRoot>
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type FixedLMetric<Power, Dim, TakeRoot>::Evaluate(
+    const VecTypeA& a,
+    const VecTypeB& b)
+{
+  typedef typename VecTypeA::elem_type ElemType;
+
+  ElemType sum = 0;
+  if constexpr (Power == INT_MAX)
+  {
+    // The L-infinity distance; the root doesn't matter.
+    for (size_t d = 0; d < Dim; ++d)
+      sum = std::max(sum, (ElemType) std::abs(a[d] - b[d]));
+
+    return sum;
+  }
+  else
+  {
+    #pragma omp simd reduction(+:sum)
+    for (size_t d = 0; d < Dim; ++d)
+    {
+      const ElemType diff = (ElemType) std::abs(a[d] - b[d]);
+      if constexpr (Power == 1)
+        sum += diff;
+      else if constexpr (Power == 2)
+        sum += diff * diff;
+      else if constexpr (Power == 3)
+        sum += diff * diff * diff;
+      else
+        sum += std::pow(diff, (ElemType) Power);
+    }
+
+    if constexpr (!TakeRoot || Power == 1)
+      return sum;
+    else if constexpr (Power == 2)
+      return std::sqrt(sum);
+    else
+      return std::pow(sum, (ElemType) (1.0 / Power));
+  }
+}
+
+} // namespace mlpack
+
+#endif
@@ -36,10 +36,25 @@ namespace mlpack {
  *
  * If you wish to use the KNN class or other tree-based algorithms with this
  * distance, it is recommended to instead stretch the dataset first, by
- * decomposing Q = L^T L (perhaps via a Cholesky decomposition), and then
- * multiply the data by L.  If you still wish to use the KNN class with a custom
- * distance anyway, you will need to use a different tree type than the default
- * KDTree, which only works with the LMetric class.
+ * decomposing Q = W^T W and then multiplying the data by W; the Mahalanobis
+ * distance is then the Euclidean distance between the stretched points, which
+ * costs O(d) instead of O(d^2) and can be used with the default KDTree.
+ * Transform() does this, with a factor W that is computed once (see
+ * Whitening()):
+ *
+ * @code
+ * MahalanobisDistance<> d(q);
+ * arma::mat stretchedReferences, stretchedQueries;
+ * d.Transform(references, stretchedReferences);
+ * d.Transform(queries, stretchedQueries);
+ *
+ * KNN knn(std::move(stretchedReferences));
+ * knn.Search(stretchedQueries, k, neighbors, distances);
+ * @endcode
+ *
+ * If you still wish to use the KNN class with the MahalanobisDistance anyway,
+ * you will need to use a different tree type than the default KDTree, which
+ * only works with the LMetric class.
  *
  * Similar to the LMetric class, this offers a template parameter TakeRoot
  * which, when set to false, will instead evaluate the distance
@@ -105,8 +120,32 @@ class MahalanobisDistance
 
   // Access the Q matrix.
   const MatType& Q() const { return q; }
-  // Modify the Q matrix.
-  MatType& Q() { return q; }
+  // Modify the Q matrix.  This discards the cached whitening matrix.
+  MatType& Q() { whitening.reset(); return q; }
+
+  /**
+   * Get the whitening matrix W such that Q = W^T W, so that the distance
+   * between x and y is the Euclidean distance between W x and W y.  W is
+   * computed the first time it is needed, and then cached until Q is modified
+   * with Q().  If the symmetric part of Q is positive definite, W is its upper
+   * triangular Cholesky factor; otherwise, W is computed from the
+   * eigendecomposition of the symmetric part of Q, with negative eigenvalues
+   * set to zero.  If Q has not been set, a std::runtime_error is thrown.
+   */
+  const MatType& Whitening();
+
+  /**
+   * Stretch the given points (one per column) with the whitening matrix W
+   * (see Whitening()), so that the Mahalanobis distance between two points is
+   * the Euclidean distance between their transformed versions.  If the
+   * dimensionality of the points does not match Q, a std::runtime_error is
+   * thrown.
+   *
+   * @param data Points to transform.
+   * @param transformedData Matrix to store the transformed points into.
+   */
+  template<typename InMatType, typename OutMatType>
+  void Transform(const InMatType& data, OutMatType& transformedData);
 
   //! Serialize the Mahalanobis distance.
   template<typename Archive>
@@ -115,6 +154,8 @@ class MahalanobisDistance
  private:
   //! The inverse covariance matrix associated with this distance.
   MatType q;
+  //! The cached whitening matrix W, with Q = W^T W (empty if not computed).
+  MatType whitening;
 };
 
 } // namespace mlpack
@@ -41,6 +41,59 @@ double MahalanobisDistance<TakeRoot, MatType>::Evaluate(
     return as_scalar(m.t() * q * m); // 1x1
 }
 
+template<bool TakeRoot, typename MatType>
+const MatType& MahalanobisDistance<TakeRoot, MatType>::Whitening()
+{
+  if (!whitening.is_empty())
+    return whitening;
+
+  if (q.is_empty())
+  {
+    throw std::runtime_error("MahalanobisDistance::Whitening(): the Q matrix "
+        "has not been set!");
+  }
+
+  // Only the symmetric part of Q contributes to the distance.
+  const MatType qSym = 0.5 * (q + q.t());
+
+  // Q = W^T W, where W is the upper triangular Cholesky factor.
+  if (!arma::chol(whitening, qSym))
+  {
+    // Q is only positive semidefinite (or slightly indefinite, because of
+    // rounding); Q = V diag(lambda) V^T = W^T W, with
+    // W = diag(sqrt(lambda)) V^T.
+    VecType eigval;
+    MatType eigvec;
+    if (!arma::eig_sym(eigval, eigvec, qSym))
+    {
+      throw std::runtime_error("MahalanobisDistance::Whitening(): the "
+          "eigendecomposition of Q failed!");
+    }
+
+    eigval.clamp(0, std::numeric_limits<typename MatType::elem_type>::max());
+    whitening = arma::diagmat(arma::sqrt(eigval)) * eigvec.t();
+  }
+
+  return whitening;
+}
+
+template<bool TakeRoot, typename MatType>
+template<typename InMatType, typename OutMatType>
+void MahalanobisDistance<TakeRoot, MatType>::Transform(
+    const InMatType& data, OutMatType& transformedData)
+{
+  if (data.n_rows != q.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "MahalanobisDistance::Transform(): given data dimensionality ("
+        << data.n_rows << ") does not match Q dimensionality (" << q.n_rows
+        << ")!";
+    throw std::runtime_error(oss.str());
+  }
+
+  transformedData = Whitening() * data;
+}
+
 // Serialize the Mahalanobis distance.
 template<bool TakeRoot, typename MatType>
 template<typename Archive>
@@ -59,6 +112,10 @@ void MahalanobisDistance<TakeRoot, MatType>::serialize(
   {
     ar(CEREAL_NVP(q));
   }
+
+  // The whitening matrix is recomputed when needed.
+  if (Archive::is_loading::value)
+    whitening.reset();
 }
 
 } // namespace mlpack
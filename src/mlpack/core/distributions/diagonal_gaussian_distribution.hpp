@@ -138,6 +138,12 @@ class DiagonalGaussianDistribution
   //! Return the covariance matrix.
   const VecType& Covariance() const { return covariance; }
 
+  //! Return the inverse of the diagonal covariance.
+  const VecType& InvCov() const { return invCov; }
+
+  //! Return the log-determinant of the covariance.
+  ElemType LogDetCov() const { return logDetCov; }
+
   //! Set the covariance matrix.
   void Covariance(const VecType& covariance);
 
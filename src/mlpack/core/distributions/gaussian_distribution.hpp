@@ -165,6 +165,9 @@ class GaussianDistribution
   void Covariance(const MatType& covariance);
   void Covariance(MatType&& covariance);
 
+  //! Return the lower triangular factor L of the covariance (cov = LL^T).
+  const MatType& CovLower() const { return covLower; }
+
   //! Return the invCov.
   const MatType& InvCov() const { return invCov; }
 
@@ -65,7 +65,10 @@ class CVFunction
              const BoundArgs&... args);
 
   /**
-   * Run cross-validation with the bound and passed parameters.
+   * Run cross-validation with the bound and passed parameters.  The result
+   * for each set of parameters is kept, so cross-validation is not run again
+   * for parameters that have already been evaluated (as happens when the
+   * gradient is computed).
    *
    * @param parameters Arguments (rather than the bound arguments) that should
    *     be passed into the Evaluate method of the CVType object.
@@ -124,6 +127,9 @@ class CVFunction
   //! Minimum absolute increase of arguments for calculation of gradient.
   double minDelta;
 
+  //! The objectives of the parameters evaluated so far.
+  std::map<std::vector<double>, double> evaluations;
+
   /**
    * Collect all arguments and run cross-validation.
    */
@@ -64,7 +64,14 @@ template<typename CVType,
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
     const arma::mat& parameters)
 {
-  return Evaluate<0, 0>(parameters);
+  const std::vector<double> key(parameters.begin(), parameters.end());
+  const auto it = evaluations.find(key);
+  if (it != evaluations.end())
+    return it->second;
+
+  const double objective = Evaluate<0, 0>(parameters);
+  evaluations[key] = objective;
+  return objective;
 }
 
 template<typename CVType,
@@ -67,6 +67,16 @@ namespace mlpack {
  *     Fixed(useCholesky), lambda1Set, lambda2Set);
  * @endcode
  *
+ * With GridSearch, several sets of hyper-parameters can be evaluated at the
+ * same time by setting ParallelEvaluations(), if the CV class can be copied
+ * (as KFoldCV and SimpleCV can): each thread evaluates its sets with its own
+ * copy of the cross-validation object, and so of the data.
+ *
+ * @code
+ * hpt.ParallelEvaluations() = 8;
+ * std::tie(bestLambda) = hpt.Optimize(lambdas);
+ * @endcode
+ *
  * @tparam MLAlgorithm A machine learning algorithm.
  * @tparam Metric A metric to assess the quality of a trained model.
  * @tparam CV A cross-validation strategy used to assess a set of
@@ -150,6 +160,25 @@ class HyperParameterTuner
    */
   double& MinDelta() { return minDelta; }
 
+  /**
+   * Get the number of sets of hyper-parameters that are evaluated at the same
+   * time when GridSearch is used as an optimizer.
+   *
+   * The default value is 1.
+   */
+  size_t ParallelEvaluations() const { return parallelEvaluations; }
+
+  /**
+   * Modify the number of sets of hyper-parameters that are evaluated at the
+   * same time when GridSearch is used as an optimizer.  Each thread holds its
+   * own copy of the cross-validation object; if the CV class cannot be copied,
+   * the sets are evaluated one after the other.  The result is the same as
+   * for a sequential search.
+   *
+   * The default value is 1.
+   */
+  size_t& ParallelEvaluations() { return parallelEvaluations; }
+
   /**
    * Find the best hyper-parameters by using the given Optimizer. For each
    * hyper-parameter one of the following should be passed as an argument.
@@ -229,6 +258,22 @@ class HyperParameterTuner
    */
   double minDelta;
 
+  //! The number of sets of hyper-parameters evaluated at the same time.
+  size_t parallelEvaluations;
+
+  /**
+   * Evaluate every set of hyper-parameters of the grid given by numCategories
+   * in parallel, each thread with its own copy of the cross-validation object,
+   * and store the best ones (in the order of GridSearch, if several are as
+   * good), the best objective, and the best model.
+   */
+  template<size_t TotalArgs, typename... FixedArgs>
+  void ParallelGridSearch(
+      arma::mat& bestParams,
+      data::DatasetMapper<data::IncrementPolicy, double>& datasetInfo,
+      const arma::Row<size_t>& numCategories,
+      const FixedArgs&... fixedArgs);
+
   /**
    * A type function to check whether the element I of the tuple type is a
    * PreFixedArg.
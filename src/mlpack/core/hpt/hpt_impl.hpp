@@ -31,7 +31,8 @@ HyperParameterTuner<MLAlgorithm,
                     MatType,
                     PredictionsType,
                     WeightsType>::HyperParameterTuner(const CVArgs&... args) :
-    cv(args...), relativeDelta(0.01), minDelta(1e-10) {}
+    cv(args...), relativeDelta(0.01), minDelta(1e-10), parallelEvaluations(1)
+{ }
 
 template<typename MLAlgorithm,
          typename Metric,
@@ -101,6 +102,19 @@ void HyperParameterTuner<MLAlgorithm,
         mlpack::data::Datatype::categorical;
   }
 
+  // A grid can be searched in parallel with copies of the cross-validation
+  // object.
+  if constexpr (std::is_same<Optimizer, ens::GridSearch>::value &&
+      std::is_copy_constructible<CVType>::value)
+  {
+    if (parallelEvaluations > 1)
+    {
+      ParallelGridSearch<totalArgs>(bestParams, datasetInfo, numCategories,
+          fixedArgs...);
+      return;
+    }
+  }
+
   CVFunction<CVType, MLAlgorithm, totalArgs, FixedArgs...>
       cvFunction(cv, datasetInfo, relativeDelta, minDelta, fixedArgs...);
   bestObjective = Metric::NeedsMinimization ? optimizer.Optimize(cvFunction,
@@ -110,6 +124,112 @@ void HyperParameterTuner<MLAlgorithm,
       bestModel = std::move(cvFunction.BestModel());
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         template<typename, typename, typename, typename, typename> class CV,
+         typename Optimizer,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<size_t TotalArgs, typename... FixedArgs>
+void HyperParameterTuner<MLAlgorithm,
+                         Metric,
+                         CV,
+                         Optimizer,
+                         MatType,
+                         PredictionsType,
+                         WeightsType>::ParallelGridSearch(
+    arma::mat& bestParams,
+    data::DatasetMapper<data::IncrementPolicy, double>& datasetInfo,
+    const arma::Row<size_t>& numCategories,
+    const FixedArgs&... fixedArgs)
+{
+  size_t numConfigurations = 1;
+  for (size_t d = 0; d < numCategories.n_elem; ++d)
+    numConfigurations *= numCategories[d];
+
+  // Set the parameters of the c'th set of hyper-parameters; the last one
+  // changes fastest, as in GridSearch.
+  auto configuration = [&](size_t c, arma::mat& parameters)
+  {
+    for (size_t d = parameters.n_rows; d > 0; --d)
+    {
+      parameters(d - 1) = double(c % numCategories[d - 1]);
+      c /= numCategories[d - 1];
+    }
+  };
+
+  // Each thread keeps its best set (the first one, if several are as good as
+  // each other) and the model trained with it.
+  const size_t numThreads = std::min(parallelEvaluations, numConfigurations);
+  std::vector<double> objectives(numThreads,
+      std::numeric_limits<double>::max());
+  std::vector<size_t> bestConfigurations(numThreads, numConfigurations);
+  std::vector<MLAlgorithm> models(numThreads);
+
+  // Exceptions cannot leave an OpenMP region, so the first one is kept and
+  // rethrown afterwards.
+  std::exception_ptr exception;
+  #pragma omp parallel num_threads(numThreads)
+  {
+    size_t thread = 0;
+    #ifdef MLPACK_USE_OPENMP
+    thread = (size_t) omp_get_thread_num();
+    #endif
+
+    try
+    {
+      CVType threadCV(cv);
+      CVFunction<CVType, MLAlgorithm, TotalArgs, FixedArgs...> cvFunction(
+          threadCV, datasetInfo, relativeDelta, minDelta, fixedArgs...);
+      arma::mat parameters(bestParams.n_rows, 1);
+
+      #pragma omp for schedule(dynamic)
+      for (size_t c = 0; c < numConfigurations; ++c)
+      {
+        configuration(c, parameters);
+        const double objective = cvFunction.Evaluate(parameters);
+
+        // The sets of each thread are evaluated in increasing order, so this
+        // is the same choice as the one CVFunction made for its best model.
+        if (objectives[thread] > objective ||
+            bestConfigurations[thread] == numConfigurations)
+        {
+          objectives[thread] = objective;
+          bestConfigurations[thread] = c;
+        }
+      }
+
+      if (bestConfigurations[thread] < numConfigurations)
+        models[thread] = std::move(cvFunction.BestModel());
+    }
+    catch (...)
+    {
+      #pragma omp critical
+      {
+        if (!exception)
+          exception = std::current_exception();
+      }
+    }
+  }
+
+  if (exception)
+    std::rethrow_exception(exception);
+
+  size_t best = 0;
+  for (size_t t = 1; t < numThreads; ++t)
+  {
+    if (objectives[t] < objectives[best] || (objectives[t] == objectives[best]
+        && bestConfigurations[t] < bestConfigurations[best]))
+      best = t;
+  }
+
+  configuration(bestConfigurations[best], bestParams);
+  bestObjective = Metric::NeedsMinimization ? objectives[best] :
+      -objectives[best];
+  bestModel = std::move(models[best]);
+}
+
 template<typename MLAlgorithm,
          typename Metric,
          template<typename, typename, typename, typename, typename> class CV,
@@ -15,6 +15,7 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/distances/lmetric.hpp>
 #include <mlpack/core/kernels/kernel_traits.hpp>
+#include <mlpack/core/kernels/pairwise_distances.hpp>
 
 namespace mlpack {
 
@@ -67,6 +68,22 @@ class CauchyKernel
         std::pow(EuclideanDistance::Evaluate(a, b) / bandwidth, 2)));
   }
 
+  /**
+   * Evaluate the Cauchy kernel on all pairs of points (columns) of a and b, so
+   * that k(i, j) = K(a_i, b_j).  The squared distances are computed from the
+   * norms and the dot products of the points (see PairwiseSquaredDistances()).
+   *
+   * @param a First set of points.
+   * @param b Second set of points.
+   * @param k Matrix to store the kernel values into (a.n_cols x b.n_cols).
+   */
+  template<typename MatType>
+  void Evaluate(const MatType& a, const MatType& b, MatType& k) const
+  {
+    PairwiseSquaredDistances(a, b, k);
+    k = 1 / (1 + k / (bandwidth * bandwidth));
+  }
+
   /**
    * Serialize the kernel.
    */
@@ -93,6 +110,9 @@ class KernelTraits<CauchyKernel>
  public:
   //! The Cauchy kernel is normalized: K(x, x) = 1 for all x.
   static const bool IsNormalized = true;
+
+  //! The Cauchy kernel can be evaluated on blocks of points at once.
+  static const bool HasBatchEvaluate = true;
 };
 
 } // namespace mlpack
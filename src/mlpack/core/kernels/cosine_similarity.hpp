@@ -40,6 +40,19 @@ class CosineSimilarity
   template<typename VecTypeA, typename VecTypeB>
   static double Evaluate(const VecTypeA& a, const VecTypeB& b);
 
+  /**
+   * Compute the cosine similarity between all pairs of points (columns) of a
+   * and b, so that k(i, j) = K(a_i, b_j), with one matrix multiplication for
+   * all the dot products.  As for two points, the similarity with a zero point
+   * is 0.
+   *
+   * @param a First set of points.
+   * @param b Second set of points.
+   * @param k Matrix to store the similarities into (a.n_cols x b.n_cols).
+   */
+  template<typename MatType>
+  static void Evaluate(const MatType& a, const MatType& b, MatType& k);
+
   //! Serialize the class (there's nothing to save).
   template<typename Archive>
   void serialize(Archive& /* ar */, const uint32_t /* version */) { }
@@ -55,6 +68,9 @@ class KernelTraits<CosineSimilarity>
 
   //! The cosine kernel doesn't include a squared distance.
   static const bool UsesSquaredDistance = false;
+
+  //! The cosine similarity can be evaluated on blocks of points at once.
+  static const bool HasBatchEvaluate = true;
 };
 
 // This name is deprecated and can be removed in mlpack 5.0.0.
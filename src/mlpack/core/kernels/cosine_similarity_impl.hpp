@@ -31,6 +31,25 @@ double CosineSimilarity::Evaluate(const VecTypeA& a, const VecTypeB& b)
     return dot(a, b) / denominator;
 }
 
+template<typename MatType>
+void CosineSimilarity::Evaluate(const MatType& a,
+                                const MatType& b,
+                                MatType& k)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  // Zero norms are replaced by 1; the dot products with zero points are 0
+  // anyway, so their similarities are 0.
+  arma::Col<ElemType> aNorms = arma::sqrt(arma::sum(arma::square(a), 0)).t();
+  arma::Row<ElemType> bNorms = arma::sqrt(arma::sum(arma::square(b), 0));
+  aNorms.replace(ElemType(0), ElemType(1));
+  bNorms.replace(ElemType(0), ElemType(1));
+
+  k = a.t() * b;
+  k.each_col() /= aNorms;
+  k.each_row() /= bNorms;
+}
+
 } // namespace mlpack
 
 #endif
@@ -14,6 +14,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/kernels/kernel_traits.hpp>
+#include <mlpack/core/kernels/pairwise_distances.hpp>
 
 namespace mlpack {
 
@@ -50,6 +51,19 @@ class EpanechnikovKernel
   template<typename VecTypeA, typename VecTypeB>
   double Evaluate(const VecTypeA& a, const VecTypeB& b) const;
 
+  /**
+   * Evaluate the Epanechnikov kernel on all pairs of points (columns) of a and
+   * b, so that k(i, j) = K(a_i, b_j).  The squared distances are computed from
+   * the norms and the dot products of the points (see
+   * PairwiseSquaredDistances()).
+   *
+   * @param a First set of points.
+   * @param b Second set of points.
+   * @param k Matrix to store the kernel values into (a.n_cols x b.n_cols).
+   */
+  template<typename MatType>
+  void Evaluate(const MatType& a, const MatType& b, MatType& k) const;
+
   /**
    * Evaluate the Epanechnikov kernel given that the distance between the two
    * input points is known.
@@ -101,6 +115,9 @@ class KernelTraits<EpanechnikovKernel>
   static const bool IsNormalized = true;
   //! The Epanechnikov kernel includes a squared distance.
   static const bool UsesSquaredDistance = true;
+
+  //! The Epanechnikov kernel can be evaluated on blocks of points at once.
+  static const bool HasBatchEvaluate = true;
 };
 
 } // namespace mlpack
@@ -28,6 +28,18 @@ inline double EpanechnikovKernel::Evaluate(const VecTypeA& a, const VecTypeB& b)
       * inverseBandwidthSquared);
 }
 
+template<typename MatType>
+inline void EpanechnikovKernel::Evaluate(const MatType& a,
+                                         const MatType& b,
+                                         MatType& k) const
+{
+  typedef typename MatType::elem_type ElemType;
+
+  PairwiseSquaredDistances(a, b, k);
+  k = 1 - k * inverseBandwidthSquared;
+  k.clamp(ElemType(0), std::numeric_limits<ElemType>::max());
+}
+
 /**
  * Compute the normalizer of this Epanechnikov kernel for the given dimension.
  *
@@ -53,6 +53,13 @@ namespace mlpack {
  * generalization, mlpack methods expect all kernels to require state and hence
  * must store instantiated kernel functions; this is why a default constructor
  * is necessary.
+ *
+ * @note
+ * A kernel may also provide a batch `Evaluate(a, b, k)` function, which fills
+ * `k(i, j)` with the kernel value between columns `i` of `a` and `j` of `b`
+ * (see GaussianKernel).  It then has to set `HasBatchEvaluate` to true in its
+ * KernelTraits specialization, and KernelMatrix() will use it; otherwise,
+ * KernelMatrix() calls `Evaluate()` on each pair of points.
  */
 class ExampleKernel
 {
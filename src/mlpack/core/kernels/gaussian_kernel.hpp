@@ -17,6 +17,7 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/distances/lmetric.hpp>
 #include <mlpack/core/kernels/kernel_traits.hpp>
+#include <mlpack/core/kernels/pairwise_distances.hpp>
 
 namespace mlpack {
 
@@ -67,6 +68,23 @@ class GaussianKernel
     return std::exp(gamma * SquaredEuclideanDistance::Evaluate(a, b));
   }
 
+  /**
+   * Evaluate the Gaussian kernel on all pairs of points (columns) of a and b,
+   * so that k(i, j) = K(a_i, b_j).  The squared distances are computed from
+   * the norms and the dot products of the points (see
+   * PairwiseSquaredDistances()).
+   *
+   * @param a First set of points.
+   * @param b Second set of points.
+   * @param k Matrix to store the kernel values into (a.n_cols x b.n_cols).
+   */
+  template<typename MatType>
+  void Evaluate(const MatType& a, const MatType& b, MatType& k) const
+  {
+    PairwiseSquaredDistances(a, b, k);
+    k = arma::exp(gamma * k);
+  }
+
   /**
    * Evaluation of the Gaussian kernel given the distance between two points.
    *
@@ -143,6 +161,9 @@ class KernelTraits<GaussianKernel>
   static const bool IsNormalized = true;
   //! The Gaussian kernel includes a squared distance.
   static const bool UsesSquaredDistance = true;
+
+  //! The Gaussian kernel can be evaluated on blocks of points at once.
+  static const bool HasBatchEvaluate = true;
 };
 
 } // namespace mlpack
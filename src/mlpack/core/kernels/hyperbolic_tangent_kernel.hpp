@@ -13,6 +13,7 @@
 #define MLPACK_CORE_KERNELS_HYPERBOLIC_TANGENT_KERNEL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_traits.hpp>
 
 namespace mlpack {
 
@@ -61,6 +62,21 @@ class HyperbolicTangentKernel
     return tanh(scale * dot(a, b) + offset);
   }
 
+  /**
+   * Evaluate the hyperbolic tangent kernel on all pairs of points (columns) of
+   * a and b, so that k(i, j) = K(a_i, b_j).  All the dot products are computed
+   * with one matrix multiplication.
+   *
+   * @param a First set of points.
+   * @param b Second set of points.
+   * @param k Matrix to store the kernel values into (a.n_cols x b.n_cols).
+   */
+  template<typename MatType>
+  void Evaluate(const MatType& a, const MatType& b, MatType& k) const
+  {
+    k = arma::tanh(scale * (a.t() * b) + offset);
+  }
+
   //! Get scale factor.
   double Scale() const { return scale; }
   //! Modify scale factor.
@@ -84,6 +100,22 @@ class HyperbolicTangentKernel
   double offset;
 };
 
+//! Kernel traits for the hyperbolic tangent kernel.
+template<>
+class KernelTraits<HyperbolicTangentKernel>
+{
+ public:
+  //! The hyperbolic tangent kernel is not normalized.
+  static const bool IsNormalized = false;
+
+  //! The hyperbolic tangent kernel does not use a squared distance.
+  static const bool UsesSquaredDistance = false;
+
+  //! The hyperbolic tangent kernel can be evaluated on blocks of points at
+  //! once.
+  static const bool HasBatchEvaluate = true;
+};
+
 } // namespace mlpack
 
 #endif
@@ -0,0 +1,63 @@
+/**
+ * @file core/kernels/kernel_matrix.hpp
+ *
+ * Functions to compute whole kernel matrices between two sets of points.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+#define MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "kernel_traits.hpp"
+
+namespace mlpack {
+
+/**
+ * Compute the kernel matrix between the points (columns) of `a` and `b`, so
+ * that `k(i, j)` is `kernel.Evaluate(a.col(i), b.col(j))`.
+ *
+ * If the kernel has a batch Evaluate() function (see
+ * KernelTraits::HasBatchEvaluate) and the points are in dense matrices, it is
+ * used to compute the whole matrix at once; for most kernels, this is one
+ * matrix multiplication and an element-wise transform.  Otherwise, the matrix
+ * is split into blocks of points, and the blocks are computed in parallel with
+ * `kernel.Evaluate()` on each pair of points; so, `kernel.Evaluate()` must be
+ * safe to call from several threads.
+ *
+ * @param kernel Kernel to use.
+ * @param a First set of points.
+ * @param b Second set of points.
+ * @param k Matrix to store the kernel matrix into (a.n_cols x b.n_cols).
+ */
+template<typename KernelType, typename MatType>
+void KernelMatrix(KernelType& kernel,
+                  const MatType& a,
+                  const MatType& b,
+                  arma::Mat<typename MatType::elem_type>& k);
+
+/**
+ * Compute the (symmetric) kernel matrix of the points (columns) of `data`, so
+ * that `k(i, j)` is `kernel.Evaluate(data.col(i), data.col(j))`.  This is
+ * like KernelMatrix(kernel, data, data, k), but only the blocks in the upper
+ * triangle are computed with `kernel.Evaluate()`.
+ *
+ * @param kernel Kernel to use.
+ * @param data Set of points.
+ * @param k Matrix to store the kernel matrix into (data.n_cols x data.n_cols).
+ */
+template<typename KernelType, typename MatType>
+void KernelMatrix(KernelType& kernel,
+                  const MatType& data,
+                  arma::Mat<typename MatType::elem_type>& k);
+
+} // namespace mlpack
+
+// Include implementation.
+#include "kernel_matrix_impl.hpp"
+
+#endif
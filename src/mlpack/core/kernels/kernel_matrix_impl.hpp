@@ -0,0 +1,121 @@
+/**
+ * @file core/kernels/kernel_matrix_impl.hpp
+ *
+ * Implementation of the functions to compute kernel matrices.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_KERNEL_MATRIX_IMPL_HPP
+#define MLPACK_CORE_KERNELS_KERNEL_MATRIX_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "kernel_matrix.hpp"
+
+namespace mlpack {
+
+/**
+ * Compute the kernel matrix with the batch Evaluate() function of the kernel,
+ * if it has one (see KernelTraits::HasBatchEvaluate) and the points are held
+ * in dense matrices.  Return false otherwise.
+ */
+template<typename KernelType, typename MatType>
+bool KernelMatrixBatch(KernelType& kernel,
+                       const MatType& a,
+                       const MatType& b,
+                       arma::Mat<typename MatType::elem_type>& k)
+{
+  typedef typename std::remove_const<KernelType>::type Kernel;
+  typedef arma::Mat<typename MatType::elem_type> DenseMatType;
+
+  if constexpr (KernelTraits<Kernel>::HasBatchEvaluate &&
+                std::is_same<MatType, DenseMatType>::value)
+  {
+    kernel.Evaluate(a, b, k);
+    return true;
+  }
+  else
+  {
+    return false;
+  }
+}
+
+template<typename KernelType, typename MatType>
+void KernelMatrix(KernelType& kernel,
+                  const MatType& a,
+                  const MatType& b,
+                  arma::Mat<typename MatType::elem_type>& k)
+{
+  if (KernelMatrixBatch(kernel, a, b, k))
+    return;
+
+  k.set_size(a.n_cols, b.n_cols);
+
+  // The number of points on each side of a block.
+  const size_t blockSize = 64;
+  const size_t rowBlocks = (a.n_cols + blockSize - 1) / blockSize;
+  const size_t colBlocks = (b.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < rowBlocks * colBlocks; ++block)
+  {
+    const size_t rowBegin = (block % rowBlocks) * blockSize;
+    const size_t rowEnd = std::min(rowBegin + blockSize, (size_t) a.n_cols);
+    const size_t colBegin = (block / rowBlocks) * blockSize;
+    const size_t colEnd = std::min(colBegin + blockSize, (size_t) b.n_cols);
+
+    for (size_t j = colBegin; j < colEnd; ++j)
+      for (size_t i = rowBegin; i < rowEnd; ++i)
+        k(i, j) = kernel.Evaluate(a.col(i), b.col(j));
+  }
+}
+
+template<typename KernelType, typename MatType>
+void KernelMatrix(KernelType& kernel,
+                  const MatType& data,
+                  arma::Mat<typename MatType::elem_type>& k)
+{
+  if (KernelMatrixBatch(kernel, data, data, k))
+    return;
+
+  k.set_size(data.n_cols, data.n_cols);
+
+  // The number of points on each side of a block.
+  const size_t blockSize = 64;
+
+  // Only the blocks on and above the diagonal are computed; block (r, c), with
+  // r <= c, has index c * (c + 1) / 2 + r.
+  const size_t blocks = (data.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < blocks * (blocks + 1) / 2; ++block)
+  {
+    size_t colBlock = (size_t) ((std::sqrt(8.0 * block + 1.0) - 1.0) / 2.0);
+    // Correct any rounding of the square root.
+    while (colBlock * (colBlock + 1) / 2 > block)
+      --colBlock;
+    while ((colBlock + 1) * (colBlock + 2) / 2 <= block)
+      ++colBlock;
+    const size_t rowBlock = block - colBlock * (colBlock + 1) / 2;
+
+    const size_t rowBegin = rowBlock * blockSize;
+    const size_t rowEnd = std::min(rowBegin + blockSize,
+        (size_t) data.n_cols);
+    const size_t colBegin = colBlock * blockSize;
+    const size_t colEnd = std::min(colBegin + blockSize,
+        (size_t) data.n_cols);
+
+    for (size_t j = colBegin; j < colEnd; ++j)
+      for (size_t i = rowBegin; i < std::min(rowEnd, j + 1); ++i)
+        k(i, j) = kernel.Evaluate(data.col(i), data.col(j));
+  }
+
+  // Copy the upper triangle to the lower triangle.
+  k = arma::symmatu(k);
+}
+
+} // namespace mlpack
+
+#endif
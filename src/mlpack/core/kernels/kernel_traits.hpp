@@ -35,6 +35,14 @@ class KernelTraits
    * If true, then the kernel include a squared distance, ||x - y||^2 .
    */
   static const bool UsesSquaredDistance = false;
+
+  /**
+   * If true, then the kernel has a member (or static) function
+   * `Evaluate(const MatType& a, const MatType& b, MatType& k)` that computes
+   * the kernel values between all pairs of columns of `a` and `b` at once.  Use
+   * KernelMatrix() to compute kernel matrices with any kernel.
+   */
+  static const bool HasBatchEvaluate = false;
 };
 
 } // namespace mlpack
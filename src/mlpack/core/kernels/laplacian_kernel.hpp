@@ -13,6 +13,7 @@
 #define MLPACK_CORE_KERNELS_LAPLACIAN_KERNEL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/pairwise_distances.hpp>
 
 namespace mlpack {
 
@@ -55,6 +56,22 @@ class LaplacianKernel
     return std::exp(-EuclideanDistance::Evaluate(a, b) / bandwidth);
   }
 
+  /**
+   * Evaluate the Laplacian kernel on all pairs of points (columns) of a and b,
+   * so that k(i, j) = K(a_i, b_j).  The distances are computed from the norms
+   * and the dot products of the points (see PairwiseSquaredDistances()).
+   *
+   * @param a First set of points.
+   * @param b Second set of points.
+   * @param k Matrix to store the kernel values into (a.n_cols x b.n_cols).
+   */
+  template<typename MatType>
+  void Evaluate(const MatType& a, const MatType& b, MatType& k) const
+  {
+    PairwiseSquaredDistances(a, b, k);
+    k = arma::exp(-arma::sqrt(k) / bandwidth);
+  }
+
   /**
    * Evaluation of the Laplacian kernel given the distance between two points.
    *
@@ -108,6 +125,9 @@ class KernelTraits<LaplacianKernel>
   static const bool IsNormalized = true;
   //! The Laplacian kernel doesn't include a squared distance.
   static const bool UsesSquaredDistance = false;
+
+  //! The Laplacian kernel can be evaluated on blocks of points at once.
+  static const bool HasBatchEvaluate = true;
 };
 
 } // namespace mlpack
@@ -15,6 +15,7 @@
 #define MLPACK_CORE_KERNELS_LINEAR_KERNEL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_traits.hpp>
 
 namespace mlpack {
 
@@ -54,11 +55,40 @@ class LinearKernel
     return dot(a, b);
   }
 
+  /**
+   * Evaluate the linear kernel on all pairs of points (columns) of a and b, so
+   * that k(i, j) = K(a_i, b_j), with one matrix multiplication.
+   *
+   * @param a First set of points.
+   * @param b Second set of points.
+   * @param k Matrix to store the kernel values into (a.n_cols x b.n_cols).
+   */
+  template<typename MatType>
+  static void Evaluate(const MatType& a, const MatType& b, MatType& k)
+  {
+    k = a.t() * b;
+  }
+
   //! Serialize the kernel (it has no members... do nothing).
   template<typename Archive>
   void serialize(Archive& /* ar */, const uint32_t /* version */) { }
 };
 
+//! Kernel traits for the linear kernel.
+template<>
+class KernelTraits<LinearKernel>
+{
+ public:
+  //! The linear kernel is not normalized.
+  static const bool IsNormalized = false;
+
+  //! The linear kernel does not use a squared distance.
+  static const bool UsesSquaredDistance = false;
+
+  //! The linear kernel can be evaluated on blocks of points at once.
+  static const bool HasBatchEvaluate = true;
+};
+
 } // namespace mlpack
 
 #endif
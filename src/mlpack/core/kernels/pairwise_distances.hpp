@@ -0,0 +1,48 @@
+/**
+ * @file core/kernels/pairwise_distances.hpp
+ *
+ * Computation of the squared Euclidean distances between all pairs of points
+ * of two sets, for the batch evaluation of distance-based kernels.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_PAIRWISE_DISTANCES_HPP
+#define MLPACK_CORE_KERNELS_PAIRWISE_DISTANCES_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Compute the squared Euclidean distances between the points (columns) of `a`
+ * and `b`, so that `d(i, j)` is ||a_i - b_j||^2.  This uses
+ * ||x - y||^2 = ||x||^2 + ||y||^2 - 2 x^T y, so that the dot products are
+ * computed with one matrix multiplication; the (slightly) negative distances
+ * caused by rounding are set to zero.
+ *
+ * @param a First set of points.
+ * @param b Second set of points.
+ * @param d Matrix to store the squared distances into (a.n_cols x b.n_cols).
+ */
+template<typename MatType>
+void PairwiseSquaredDistances(const MatType& a,
+                              const MatType& b,
+                              MatType& d)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const arma::Col<ElemType> aNorms = arma::sum(arma::square(a), 0).t();
+  const arma::Row<ElemType> bNorms = arma::sum(arma::square(b), 0);
+
+  d = -2 * (a.t() * b);
+  d.each_col() += aNorms;
+  d.each_row() += bNorms;
+  d.clamp(0, std::numeric_limits<ElemType>::max());
+}
+
+} // namespace mlpack
+
+#endif
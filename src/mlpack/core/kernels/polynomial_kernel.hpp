@@ -13,6 +13,7 @@
 #define MLPACK_CORE_KERNELS_POLYNOMIAL_KERNEL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_traits.hpp>
 
 namespace mlpack {
 
@@ -56,6 +57,26 @@ class PolynomialKernel
     return std::pow((dot(a, b) + offset), degree);
   }
 
+  /**
+   * Evaluate the polynomial kernel on all pairs of points (columns) of a and
+   * b, so that k(i, j) = K(a_i, b_j).  All the dot products are computed with
+   * one matrix multiplication.
+   *
+   * @param a First set of points.
+   * @param b Second set of points.
+   * @param k Matrix to store the kernel values into (a.n_cols x b.n_cols).
+   */
+  template<typename MatType>
+  void Evaluate(const MatType& a, const MatType& b, MatType& k) const
+  {
+    typedef typename MatType::elem_type ElemType;
+
+    k = a.t() * b;
+    const ElemType o = (ElemType) offset;
+    const ElemType d = (ElemType) degree;
+    k.transform([o, d](const ElemType x) { return std::pow(x + o, d); });
+  }
+
   //! Get the degree of the polynomial.
   const double& Degree() const { return degree; }
   //! Modify the degree of the polynomial.
@@ -81,6 +102,21 @@ class PolynomialKernel
   double offset;
 };
 
+//! Kernel traits for the polynomial kernel.
+template<>
+class KernelTraits<PolynomialKernel>
+{
+ public:
+  //! The polynomial kernel is not normalized.
+  static const bool IsNormalized = false;
+
+  //! The polynomial kernel does not use a squared distance.
+  static const bool UsesSquaredDistance = false;
+
+  //! The polynomial kernel can be evaluated on blocks of points at once.
+  static const bool HasBatchEvaluate = true;
+};
+
 } // namespace mlpack
 
 #endif
@@ -18,10 +18,12 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/util/log.hpp>
+#include <mlpack/core/kernels/kernel_traits.hpp>
 
 namespace mlpack {
 
@@ -60,6 +62,12 @@ namespace mlpack {
  * the data according to the fake data matrix -- resulting in a meaningless
  * tree.  This kernel was originally written for the FastMKS method; so, at the
  * very least, it will work with that.
+ *
+ * By default, each distinct substring is given an integer ID at construction
+ * time, and the substring counts of each string are stored as a sparse vector
+ * indexed by these IDs (see BuildIndex()).  Then, Evaluate() is a sparse dot
+ * product, without any string comparisons, and the batch Evaluate() computes a
+ * whole block of the kernel matrix with one sparse matrix product.
  */
 class PSpectrumStringKernel
 {
@@ -70,10 +78,13 @@ class PSpectrumStringKernel
    *
    * @param datasets Sets of string data.
    * @param p The length of substrings to search.
+   * @param buildIndex If true, build the sparse count vectors of the strings
+   *     (see BuildIndex()), so that the kernel can be evaluated quickly.
    */
   inline PSpectrumStringKernel(
       const std::vector<std::vector<std::string>>& datasets,
-      const size_t p);
+      const size_t p,
+      const bool buildIndex = true);
 
   /**
    * Evaluate the kernel for the string indices given.  As mentioned in the
@@ -89,12 +100,45 @@ class PSpectrumStringKernel
   template<typename VecType>
   double Evaluate(const VecType& a, const VecType& b) const;
 
+  /**
+   * Evaluate the kernel on all pairs of strings given by the columns of a and
+   * b (in the same format as for the other Evaluate() overload), so that
+   * k(i, j) = K(a_i, b_j).  If the index has been built, this is one sparse
+   * matrix product.
+   *
+   * @param a First set of string indices.
+   * @param b Second set of string indices.
+   * @param k Matrix to store the kernel values into (a.n_cols x b.n_cols).
+   */
+  template<typename MatType>
+  void Evaluate(const MatType& a, const MatType& b, MatType& k) const;
+
+  /**
+   * Build the index of the substring counts: each distinct substring is given
+   * an integer ID, and the counts of each string are stored as a sparse
+   * vector indexed by these IDs.  This is done by the constructor by default;
+   * it is only necessary to call it again after modifying Counts().
+   */
+  inline void BuildIndex();
+
+  //! Get whether the index of the substring counts has been built.
+  bool Indexed() const { return !index.empty(); }
+  //! Get the number of distinct substrings in the index.
+  size_t NumSubstrings() const { return numSubstrings; }
+  //! Get the index: the sparse count vectors of the strings of each dataset
+  //! (one column per string, one row per substring ID).
+  const std::vector<arma::sp_mat>& Index() const { return index; }
+
   //! Access the lists of substrings.
   const std::vector<std::vector<std::map<std::string, int> > >& Counts() const
   { return counts; }
-  //! Modify the lists of substrings.
+  //! Modify the lists of substrings.  This discards the index; call
+  //! BuildIndex() after the modifications to build it again.
   std::vector<std::vector<std::map<std::string, int> > >& Counts()
-  { return counts; }
+  {
+    index.clear();
+    return counts;
+  }
 
   //! Access the value of p.
   size_t P() const { return p; }
@@ -106,8 +150,36 @@ class PSpectrumStringKernel
   //! is not wonderful...
   std::vector<std::vector<std::map<std::string, int> > > counts;
 
+  //! The sparse substring count vectors of the strings of each dataset; empty
+  //! if the index has not been built.
+  std::vector<arma::sp_mat> index;
+
+  //! The number of distinct substrings in the index.
+  size_t numSubstrings;
+
   //! The value of p to use in calculation.
   size_t p;
+
+  //! Collect the sparse count vectors of the strings given by the columns of
+  //! points into one sparse matrix (one column per string).
+  template<typename MatType>
+  arma::sp_mat GatherCounts(const MatType& points) const;
+};
+
+//! Kernel traits for the p-spectrum string kernel.
+template<>
+class KernelTraits<PSpectrumStringKernel>
+{
+ public:
+  //! The p-spectrum string kernel is not normalized.
+  static const bool IsNormalized = false;
+
+  //! The p-spectrum string kernel does not use a squared distance.
+  static const bool UsesSquaredDistance = false;
+
+  //! The p-spectrum string kernel can be evaluated on blocks of strings at
+  //! once.
+  static const bool HasBatchEvaluate = true;
 };
 
 } // namespace mlpack
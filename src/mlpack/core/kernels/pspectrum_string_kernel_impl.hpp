@@ -23,7 +23,10 @@ namespace mlpack {
 
 inline PSpectrumStringKernel::PSpectrumStringKernel(
     const std::vector<std::vector<std::string> >& datasets,
-    const size_t p) : p(p)
+    const size_t p,
+    const bool buildIndex) :
+    numSubstrings(0),
+    p(p)
 {
   if (p == 0)
   {
@@ -83,6 +86,51 @@ inline PSpectrumStringKernel::PSpectrumStringKernel(
     }
   }
   Log::Info << "Substring extraction complete." << std::endl;
+
+  if (buildIndex)
+    BuildIndex();
+}
+
+inline void PSpectrumStringKernel::BuildIndex()
+{
+  // Give each distinct substring an integer ID.
+  std::unordered_map<std::string, size_t> ids;
+  for (size_t dataset = 0; dataset < counts.size(); ++dataset)
+    for (size_t i = 0; i < counts[dataset].size(); ++i)
+      for (const std::pair<const std::string, int>& count : counts[dataset][i])
+        ids.emplace(count.first, ids.size());
+
+  numSubstrings = ids.size();
+  index.clear();
+  index.resize(counts.size());
+
+  // Now store the counts of each string as a sparse column.
+  for (size_t dataset = 0; dataset < counts.size(); ++dataset)
+  {
+    size_t nonzeros = 0;
+    for (size_t i = 0; i < counts[dataset].size(); ++i)
+      nonzeros += counts[dataset][i].size();
+
+    arma::umat locations(2, nonzeros);
+    arma::vec values(nonzeros);
+    size_t nz = 0;
+    for (size_t i = 0; i < counts[dataset].size(); ++i)
+    {
+      for (const std::pair<const std::string, int>& count : counts[dataset][i])
+      {
+        locations(0, nz) = ids.at(count.first);
+        locations(1, nz) = i;
+        values[nz] = count.second;
+        ++nz;
+      }
+    }
+
+    index[dataset] = arma::sp_mat(locations, values, numSubstrings,
+        counts[dataset].size());
+  }
+
+  Log::Info << "Indexed " << numSubstrings << " distinct substrings."
+      << std::endl;
 }
 
 /**
@@ -99,6 +147,33 @@ template<typename VecType>
 double PSpectrumStringKernel::Evaluate(const VecType& a,
                                        const VecType& b) const
 {
+  if (!index.empty())
+  {
+    // Merge the two sorted lists of substring IDs.
+    const arma::sp_mat& aCounts = index[(size_t) a[0]];
+    const arma::sp_mat& bCounts = index[(size_t) b[0]];
+    const size_t aCol = (size_t) a[1];
+    const size_t bCol = (size_t) b[1];
+
+    size_t i = aCounts.col_ptrs[aCol];
+    size_t j = bCounts.col_ptrs[bCol];
+    const size_t aEnd = aCounts.col_ptrs[aCol + 1];
+    const size_t bEnd = bCounts.col_ptrs[bCol + 1];
+
+    double eval = 0;
+    while (i < aEnd && j < bEnd)
+    {
+      if (aCounts.row_indices[i] == bCounts.row_indices[j])
+        eval += aCounts.values[i++] * bCounts.values[j++];
+      else if (aCounts.row_indices[i] < bCounts.row_indices[j])
+        ++i;
+      else
+        ++j;
+    }
+
+    return eval;
+  }
+
   // Get the map of substrings for the two strings we are interested in.
   const std::map<std::string, int>& aMap = counts[a[0]][a[1]];
   const std::map<std::string, int>& bMap = counts[b[0]][b[1]];
@@ -137,6 +212,60 @@ double PSpectrumStringKernel::Evaluate(const VecType& a,
 
   return eval;
 }
+
+template<typename MatType>
+void PSpectrumStringKernel::Evaluate(const MatType& a,
+                                     const MatType& b,
+                                     MatType& k) const
+{
+  if (index.empty())
+  {
+    k.set_size(a.n_cols, b.n_cols);
+    for (size_t j = 0; j < b.n_cols; ++j)
+      for (size_t i = 0; i < a.n_cols; ++i)
+        k(i, j) = Evaluate(a.col(i), b.col(j));
+
+    return;
+  }
+
+  const arma::sp_mat aCounts = GatherCounts(a);
+  const arma::sp_mat bCounts = GatherCounts(b);
+  k = arma::conv_to<MatType>::from(arma::mat(aCounts.t() * bCounts));
+}
+
+template<typename MatType>
+arma::sp_mat PSpectrumStringKernel::GatherCounts(const MatType& points) const
+{
+  // Each column is copied from the index (the columns are already sorted).
+  arma::uvec colPtrs(points.n_cols + 1);
+  colPtrs[0] = 0;
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    const arma::sp_mat& stringCounts = index[(size_t) points(0, i)];
+    const size_t col = (size_t) points(1, i);
+    colPtrs[i + 1] = colPtrs[i] + stringCounts.col_ptrs[col + 1] -
+        stringCounts.col_ptrs[col];
+  }
+
+  arma::uvec rowIndices(colPtrs[points.n_cols]);
+  arma::vec values(colPtrs[points.n_cols]);
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    const arma::sp_mat& stringCounts = index[(size_t) points(0, i)];
+    const size_t col = (size_t) points(1, i);
+    const size_t begin = stringCounts.col_ptrs[col];
+    const size_t end = stringCounts.col_ptrs[col + 1];
+
+    std::copy(stringCounts.row_indices + begin, stringCounts.row_indices + end,
+        rowIndices.memptr() + colPtrs[i]);
+    std::copy(stringCounts.values + begin, stringCounts.values + end,
+        values.memptr() + colPtrs[i]);
+  }
+
+  return arma::sp_mat(rowIndices, colPtrs, values, numSubstrings,
+      points.n_cols);
+}
+
 } // namespace mlpack
 
 #endif
@@ -11,6 +11,7 @@
 #define MLPACK_CORE_KERNELS_SPHERICAL_KERNEL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/pairwise_distances.hpp>
 
 namespace mlpack {
 
@@ -54,6 +55,28 @@ class SphericalKernel
         1.0 : 0.0;
   }
 
+  /**
+   * Evaluate the spherical kernel on all pairs of points (columns) of a and b,
+   * so that k(i, j) = K(a_i, b_j).  The squared distances are computed from the
+   * norms and the dot products of the points (see PairwiseSquaredDistances()),
+   * so points very close to the boundary may be classified differently than by
+   * the evaluation on two points.
+   *
+   * @param a First set of points.
+   * @param b Second set of points.
+   * @param k Matrix to store the kernel values into (a.n_cols x b.n_cols).
+   */
+  template<typename MatType>
+  void Evaluate(const MatType& a, const MatType& b, MatType& k) const
+  {
+    typedef typename MatType::elem_type ElemType;
+
+    PairwiseSquaredDistances(a, b, k);
+    const ElemType threshold = (ElemType) bandwidthSquared;
+    k.transform([threshold](const ElemType x)
+        { return (x <= threshold) ? ElemType(1) : ElemType(0); });
+  }
+
   double Normalizer(size_t dimension) const
   {
     return std::pow(bandwidth, (double) dimension) *
@@ -97,6 +120,9 @@ class KernelTraits<SphericalKernel>
   static const bool IsNormalized = true;
   //! The spherical kernel doesn't include a squared distance.
   static const bool UsesSquaredDistance = false;
+
+  //! The spherical kernel can be evaluated on blocks of points at once.
+  static const bool HasBatchEvaluate = true;
 };
 
 } // namespace mlpack
@@ -14,6 +14,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/distances/lmetric.hpp>
+#include <mlpack/core/kernels/pairwise_distances.hpp>
 
 namespace mlpack {
 
@@ -50,6 +51,25 @@ class TriangularKernel
     return std::max(0.0, (1 - EuclideanDistance::Evaluate(a, b) / bandwidth));
   }
 
+  /**
+   * Evaluate the triangular kernel on all pairs of points (columns) of a and b,
+   * so that k(i, j) = K(a_i, b_j).  The distances are computed from the norms
+   * and the dot products of the points (see PairwiseSquaredDistances()).
+   *
+   * @param a First set of points.
+   * @param b Second set of points.
+   * @param k Matrix to store the kernel values into (a.n_cols x b.n_cols).
+   */
+  template<typename MatType>
+  void Evaluate(const MatType& a, const MatType& b, MatType& k) const
+  {
+    typedef typename MatType::elem_type ElemType;
+
+    PairwiseSquaredDistances(a, b, k);
+    k = 1 - arma::sqrt(k) / bandwidth;
+    k.clamp(ElemType(0), std::numeric_limits<ElemType>::max());
+  }
+
   /**
    * Evaluate the triangular kernel given that the distance between the two
    * points is known.
@@ -110,6 +130,9 @@ class KernelTraits<TriangularKernel>
   static const bool IsNormalized = true;
   //! The triangular kernel doesn't include a squared distance.
   static const bool UsesSquaredDistance = false;
+
+  //! The triangular kernel can be evaluated on blocks of points at once.
+  static const bool HasBatchEvaluate = true;
 };
 
 } // namespace mlpack
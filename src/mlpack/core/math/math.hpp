@@ -17,6 +17,7 @@
 #include "digamma.hpp"
 #include "log_add.hpp"
 #include "make_alias.hpp"
+#include "moments_accumulator.hpp"
 #include "multiply_slices.hpp"
 #include "quantile.hpp"
 #include "random_basis.hpp"
@@ -24,6 +25,7 @@
 #include "rand_vector.hpp"
 #include "range.hpp"
 #include "shuffle_data.hpp"
+#include "sparse_products.hpp"
 #include "trigamma.hpp"
 #include "unwrap_alias.hpp"
 
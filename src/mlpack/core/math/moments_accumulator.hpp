@@ -0,0 +1,223 @@
+/**
+ * @file core/math/moments_accumulator.hpp
+ *
+ * Definition of the MomentsAccumulator class, which computes the moments of
+ * each dimension of a dataset in one pass, a chunk of points at a time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_MOMENTS_ACCUMULATOR_HPP
+#define MLPACK_CORE_MATH_MOMENTS_ACCUMULATOR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * The MomentsAccumulator class holds the number of points, the mean, the sums
+ * of the second, third and fourth powers of the deviations from the mean, the
+ * minimum and the maximum of each dimension of a set of points.  Accumulators
+ * of two sets of points can be merged into the accumulator of their union with
+ * the pairwise formulas of Pebay, so that a dataset can be processed one chunk
+ * at a time, in constant memory, and a chunk can be split into blocks that are
+ * processed in parallel.  The blocks are merged in order, so the results do
+ * not depend on the number of threads.
+ *
+ * @code
+ * @techreport{pebay2008formulas,
+ *   title = {Formulas for Robust, One-Pass Parallel Computation of
+ *       Covariances and Arbitrary-Order Statistical Moments},
+ *   author = {P{\'e}bay, Philippe},
+ *   institution = {Sandia National Laboratories},
+ *   number = {SAND2008-6212},
+ *   year = {2008}
+ * }
+ * @endcode
+ */
+class MomentsAccumulator
+{
+ public:
+  //! Create an accumulator of no points.
+  MomentsAccumulator() : count(0) { }
+
+  /**
+   * Add the given points (one per column) to the accumulator.  All the points
+   * given to an accumulator must have the same dimensionality.
+   *
+   * @param points Points to add.
+   */
+  template<typename MatType>
+  void Update(const MatType& points)
+  {
+    if (points.n_cols == 0)
+      return;
+
+    if (count > 0 && points.n_rows != mean.n_elem)
+    {
+      std::ostringstream oss;
+      oss << "MomentsAccumulator::Update(): the points have " << points.n_rows
+          << " dimensions, but the accumulator has " << mean.n_elem
+          << " dimensions!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    // Compute the moments of each block of points directly, then merge them.
+    const size_t blockSize = 4096;
+    const size_t numBlocks = (points.n_cols + blockSize - 1) / blockSize;
+    std::vector<MomentsAccumulator> blocks(numBlocks);
+
+    #pragma omp parallel for schedule(static)
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      const size_t begin = b * blockSize;
+      const size_t end = std::min(begin + blockSize, (size_t) points.n_cols);
+      blocks[b].SetBlock(arma::conv_to<arma::mat>::from(
+          points.cols(begin, end - 1)));
+    }
+
+    for (size_t b = 0; b < numBlocks; ++b)
+      Merge(blocks[b]);
+  }
+
+  /**
+   * Merge the given accumulator into this one, which then describes the points
+   * of both.
+   *
+   * @param other Accumulator to merge.
+   */
+  void Merge(const MomentsAccumulator& other)
+  {
+    if (other.count == 0)
+      return;
+
+    if (count == 0)
+    {
+      *this = other;
+      return;
+    }
+
+    if (other.mean.n_elem != mean.n_elem)
+    {
+      std::ostringstream oss;
+      oss << "MomentsAccumulator::Merge(): cannot merge an accumulator with "
+          << other.mean.n_elem << " dimensions into an accumulator with "
+          << mean.n_elem << " dimensions!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    const double nA = count;
+    const double nB = other.count;
+    const double n = nA + nB;
+    const arma::vec delta = other.mean - mean;
+    const arma::vec delta2 = arma::square(delta);
+
+    // The higher moments use the lower moments of both sides, so they are
+    // updated first.
+    m4 += other.m4 + arma::square(delta2) * (nA * nB *
+        (nA * nA - nA * nB + nB * nB) / (n * n * n)) +
+        6.0 * delta2 % (nA * nA * other.m2 + nB * nB * m2) / (n * n) +
+        4.0 * delta % (nA * other.m3 - nB * m3) / n;
+    m3 += other.m3 + delta2 % delta * (nA * nB * (nA - nB) / (n * n)) +
+        3.0 * delta % (nA * other.m2 - nB * m2) / n;
+    m2 += other.m2 + delta2 * (nA * nB / n);
+    mean += delta * (nB / n);
+
+    minimum = arma::min(minimum, other.minimum);
+    maximum = arma::max(maximum, other.maximum);
+    count += other.count;
+  }
+
+  //! Get the number of points.
+  size_t Count() const { return count; }
+  //! Get the dimensionality of the points (0 if there are none).
+  size_t Dimensionality() const { return mean.n_elem; }
+
+  //! Get the mean of each dimension.
+  const arma::vec& Mean() const { return mean; }
+  //! Get the minimum of each dimension.
+  const arma::vec& Min() const { return minimum; }
+  //! Get the maximum of each dimension.
+  const arma::vec& Max() const { return maximum; }
+
+  /**
+   * Get the variance of each dimension, normalized by the number of points if
+   * population is true, or by the number of points minus one otherwise.
+   */
+  arma::vec Variance(const bool population = false) const
+  {
+    return m2 / (population ? (double) count : (double) count - 1.0);
+  }
+
+  //! Get the standard deviation of each dimension (see Variance()).
+  arma::vec Stddev(const bool population = false) const
+  {
+    return arma::sqrt(Variance(population));
+  }
+
+  /**
+   * Get the skewness of each dimension; the sample skewness is the adjusted
+   * Fisher-Pearson coefficient, n M3 / ((n - 1) (n - 2) s^3), where M3 is the
+   * sum of the cubed deviations and s is the sample standard deviation.
+   */
+  arma::vec Skewness(const bool population = false) const
+  {
+    const double n = count;
+    const arma::vec s3 = arma::pow(Stddev(population), 3.0);
+    return population ? arma::vec(m3 / (n * s3)) :
+        arma::vec(n * m3 / ((n - 1) * (n - 2) * s3));
+  }
+
+  /**
+   * Get the excess kurtosis of each dimension; the sample excess kurtosis is
+   * adjusted for the bias of small samples.
+   */
+  arma::vec Kurtosis(const bool population = false) const
+  {
+    const double n = count;
+    if (population)
+      return n * m4 / arma::square(m2) - 3.0;
+
+    const arma::vec s4 = arma::square(Variance(false));
+    const double norm3 = (3 * (n - 1) * (n - 1)) / ((n - 2) * (n - 3));
+    const double normC = (n * (n + 1)) / ((n - 1) * (n - 2) * (n - 3));
+    return normC * m4 / s4 - norm3;
+  }
+
+ private:
+  //! Compute the moments of the given points directly, replacing the current
+  //! ones.
+  void SetBlock(const arma::mat& points)
+  {
+    count = points.n_cols;
+    mean = arma::mean(points, 1);
+    const arma::mat deviations = points.each_col() - mean;
+    const arma::mat deviations2 = arma::square(deviations);
+    m2 = arma::sum(deviations2, 1);
+    m3 = arma::sum(deviations2 % deviations, 1);
+    m4 = arma::sum(arma::square(deviations2), 1);
+    minimum = arma::min(points, 1);
+    maximum = arma::max(points, 1);
+  }
+
+  //! The number of points.
+  size_t count;
+  //! The mean of each dimension.
+  arma::vec mean;
+  //! The sum of the squared deviations from the mean of each dimension.
+  arma::vec m2;
+  //! The sum of the cubed deviations from the mean of each dimension.
+  arma::vec m3;
+  //! The sum of the fourth powers of the deviations of each dimension.
+  arma::vec m4;
+  //! The minimum of each dimension.
+  arma::vec minimum;
+  //! The maximum of each dimension.
+  arma::vec maximum;
+};
+
+} // namespace mlpack
+
+#endif
@@ -236,6 +236,131 @@ void ShuffleData(const MatType& inputPoints,
   }
 }
 
+/**
+ * Return a random ordering of the given number of points, as used by
+ * ShuffleData(): the i'th shuffled point is the ordering[i]'th input point.
+ * This can be used to shuffle several objects the same way, or to access the
+ * shuffled points through `data.cols(ordering)` without copying them.
+ *
+ * @param numPoints Number of points to shuffle.
+ * @return A random permutation of [0, numPoints).
+ */
+inline arma::uvec ShuffleOrder(const size_t numPoints)
+{
+  if (numPoints == 0)
+    return arma::uvec();
+
+  return arma::shuffle(arma::linspace<arma::uvec>(0, numPoints - 1,
+      numPoints));
+}
+
+/**
+ * Reorder the columns of the given dense matrix in place, so that column i of
+ * the result is column ordering[i] of the input; this gives the same result as
+ * `matrix = matrix.cols(ordering)`, without holding a copy of the matrix.
+ *
+ * The columns are moved along the cycles of the ordering.  Each thread moves
+ * one block of rows of every column, so the columns are reordered in parallel
+ * with only one block of extra memory for each thread.
+ *
+ * @param matrix Matrix to reorder the columns of.
+ * @param ordering Permutation of the columns of the matrix.
+ */
+template<typename MatType>
+void PermuteColumns(MatType& matrix, const arma::uvec& ordering)
+{
+  using ElemType = typename MatType::elem_type;
+
+  if (ordering.n_elem != matrix.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "PermuteColumns(): the ordering has " << ordering.n_elem
+        << " elements, but the matrix has " << matrix.n_cols << " columns!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Find the first column of each cycle, so that the threads do not need to
+  // track which columns were moved.
+  std::vector<size_t> cycleStarts;
+  std::vector<bool> visited(ordering.n_elem, false);
+  for (size_t i = 0; i < ordering.n_elem; ++i)
+  {
+    if (visited[i])
+      continue;
+
+    size_t j = i;
+    do
+    {
+      if (ordering[j] >= ordering.n_elem || visited[j])
+      {
+        throw std::invalid_argument("PermuteColumns(): the ordering is not a "
+            "permutation of the columns of the matrix!");
+      }
+
+      visited[j] = true;
+      j = ordering[j];
+    } while (j != i);
+
+    // Columns that do not move do not need to be visited again.
+    if (ordering[i] != i)
+      cycleStarts.push_back(i);
+  }
+
+  // Each block of rows fills at least a cache line.
+  const size_t blockSize = std::max(size_t(64 / sizeof(ElemType)), size_t(1));
+  const size_t numBlocks = (matrix.n_rows + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for schedule(static)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t n = std::min(blockSize, size_t(matrix.n_rows - begin));
+    std::vector<ElemType> buffer(n);
+
+    for (size_t c = 0; c < cycleStarts.size(); ++c)
+    {
+      const size_t start = cycleStarts[c];
+      std::copy(matrix.colptr(start) + begin, matrix.colptr(start) + begin + n,
+          buffer.begin());
+
+      size_t j = start;
+      while (ordering[j] != start)
+      {
+        std::copy(matrix.colptr(ordering[j]) + begin,
+            matrix.colptr(ordering[j]) + begin + n, matrix.colptr(j) + begin);
+        j = ordering[j];
+      }
+
+      std::copy(buffer.begin(), buffer.end(), matrix.colptr(j) + begin);
+    }
+  }
+}
+
+/**
+ * Shuffle a dense dataset and associated labels (or responses) in place.  It is
+ * expected that points and labels have the same number of columns (so, be sure
+ * that labels, if it is a vector, is a row vector).
+ *
+ * This gives the same result as `ShuffleData(points, labels, points, labels)`,
+ * but the points and labels are reordered in place (in parallel) instead of
+ * being copied, so that no copy of a large dataset is held.
+ *
+ * @param points Dataset to shuffle.
+ * @param labels Labels (or responses) to shuffle the same way.
+ */
+template<typename MatType, typename LabelsType>
+void ShuffleData(MatType& points,
+                 LabelsType& labels,
+                 const std::enable_if_t<!arma::is_SpMat<MatType>::value>* = 0,
+                 const std::enable_if_t<!arma::is_Cube<MatType>::value>* = 0)
+{
+  util::CheckSameSizes(points, labels, "ShuffleData()");
+
+  const arma::uvec ordering = ShuffleOrder(points.n_cols);
+  PermuteColumns(points, ordering);
+  PermuteColumns(labels, ordering);
+}
+
 } // namespace mlpack
 
 #endif
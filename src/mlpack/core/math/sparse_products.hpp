@@ -0,0 +1,94 @@
+/**
+ * @file core/math/sparse_products.hpp
+ *
+ * Products of a sparse matrix with a dense matrix that work directly on the
+ * CSC layout of the sparse matrix: they only visit its nonzero elements, never
+ * build a transposed copy of it, and are split between OpenMP threads so that
+ * no two threads write to the same element.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_SPARSE_PRODUCTS_HPP
+#define MLPACK_CORE_MATH_SPARSE_PRODUCTS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Compute V * H^T, where V is sparse and H is dense.  Each thread computes
+ * whole columns of the result (one for each row of H).
+ *
+ * @param V Sparse matrix.
+ * @param H Dense matrix, with as many columns as V.
+ * @param output Result, of size V.n_rows x H.n_rows.
+ */
+template<typename SpMatType, typename DenseMatType>
+void SparseTimesDenseTrans(const SpMatType& V,
+                              const DenseMatType& H,
+                              DenseMatType& output)
+{
+  typedef typename DenseMatType::elem_type ElemType;
+
+  // Make sure the CSC layout is up to date before it is used directly.
+  V.sync();
+  output.zeros(V.n_rows, H.n_rows);
+
+  #pragma omp parallel for schedule(static)
+  for (size_t a = 0; a < H.n_rows; ++a)
+  {
+    ElemType* outputCol = output.colptr(a);
+    for (size_t j = 0; j < V.n_cols; ++j)
+    {
+      const ElemType h = H(a, j);
+      if (h == ElemType(0))
+        continue;
+
+      for (size_t k = V.col_ptrs[j]; k < V.col_ptrs[j + 1]; ++k)
+        outputCol[V.row_indices[k]] += ElemType(V.values[k]) * h;
+    }
+  }
+}
+
+/**
+ * Compute W^T * V, where W is dense and V is sparse.  Each thread computes
+ * whole columns of the result (one for each column of V).
+ *
+ * @param W Dense matrix, with as many rows as V.
+ * @param V Sparse matrix.
+ * @param output Result, of size W.n_cols x V.n_cols.
+ */
+template<typename DenseMatType, typename SpMatType>
+void DenseTransTimesSparse(const DenseMatType& W,
+                              const SpMatType& V,
+                              DenseMatType& output)
+{
+  typedef typename DenseMatType::elem_type ElemType;
+
+  // The rows of W are used as columns, so that they are contiguous.
+  const DenseMatType wTrans = W.t();
+  const size_t rank = W.n_cols;
+
+  V.sync();
+  output.zeros(rank, V.n_cols);
+
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (size_t j = 0; j < V.n_cols; ++j)
+  {
+    ElemType* outputCol = output.colptr(j);
+    for (size_t k = V.col_ptrs[j]; k < V.col_ptrs[j + 1]; ++k)
+    {
+      const ElemType v = ElemType(V.values[k]);
+      const ElemType* w = wTrans.colptr(V.row_indices[k]);
+      for (size_t a = 0; a < rank; ++a)
+        outputCol[a] += v * w[a];
+    }
+  }
+}
+
+} // namespace mlpack
+
+#endif
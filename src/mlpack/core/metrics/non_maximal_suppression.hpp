@@ -34,6 +34,13 @@ namespace mlpack {
  *                        If true, each value in vector represents a coordinate 
  *                        in the formate x0, y0, x1, y1. Else the bounding box is
  *                        represented as x0, y0, h, w.
+ *
+ * The boxes are copied in the order of their scores to contiguous arrays of
+ * corners and areas, and each selected box suppresses the following boxes
+ * with a bit mask, 64 boxes at a time: the IoU loop over a block has no
+ * branches, so it can be vectorized, and blocks whose boxes are all suppressed
+ * are skipped.  EvaluateByClass() runs the suppression of each class in
+ * parallel.
  */
 template<bool UseCoordinates = false>
 class NMS
@@ -69,11 +76,51 @@ class NMS
                        OutputType& selectedIndices,
                        const double threshold = 0.5);
 
+  /**
+   * Performs non-maximal suppression separately for the boxes of each class,
+   * so that boxes of different classes never suppress each other (batched
+   * NMS).  The classes are processed in parallel when OpenMP is available.
+   *
+   * @param boundingBoxes Column major representation of bounding boxes, as
+   *                      with Evaluate().
+   * @param confidenceScores Vector containing confidence score corresponding
+   *                         to each bounding box.
+   * @param labels Class of each bounding box.
+   * @param selectedIndices Output of Non Maximal Suppression (NMS) is stored
+   *                        here. It contains the indices of the bounding boxes
+   *                        selected in all the classes, sorted in descending
+   *                        order of the confidence scores.
+   * @param threshold Threshold used to discard all overlapping bounding boxes
+   *                  that have IoU greater than the threshold.
+   */
+  template<
+      typename BoundingBoxesType,
+      typename ConfidenceScoreType,
+      typename OutputType
+  >
+  static void EvaluateByClass(const BoundingBoxesType& boundingBoxes,
+                              const ConfidenceScoreType& confidenceScores,
+                              const arma::Row<size_t>& labels,
+                              OutputType& selectedIndices,
+                              const double threshold = 0.5);
+
   static const bool useCoordinates = UseCoordinates;
 
   //! Serialize the metric.
   template <typename Archive>
   void serialize(Archive &ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Perform the greedy suppression of the given boxes, in the given order
+   * (descending confidence scores), and store the positions in the order of
+   * the selected boxes.
+   */
+  template<typename BoundingBoxesType>
+  static void Suppress(const BoundingBoxesType& boundingBoxes,
+                       const arma::uvec& order,
+                       const double threshold,
+                       std::vector<size_t>& selected);
 }; // Class NMS.
 
 } // namespace mlpack
@@ -1,5 +1,5 @@
 /**
- * @file core/metrics/nms_metric_impl.hpp
+ * @file core/metrics/non_maximal_suppression_impl.hpp
  * @author Kartik Dutt
  *
  * Implementation of Non Maximal Suppression metric.
@@ -34,94 +34,168 @@ void NMS<UseCoordinates>::Evaluate(
       "box either in {x1, y1, x2, y2} or {x1, y1, h, w} format."
       "Refer to the documentation for more information.");
 
-  Log::Assert(confidenceScores.n_cols != boundingBoxes.n_cols, "Each "
+  Log::Assert(confidenceScores.n_elem == boundingBoxes.n_cols, "Each "
       "bounding box must correspond to atleast and only 1 bounding box. "
-      "Found " + std::to_string(confidenceScores.n_cols) + " confidence "
+      "Found " + std::to_string(confidenceScores.n_elem) + " confidence "
       "scores for " + std::to_string(boundingBoxes.n_cols) +
       " bounding boxes.");
 
-  // Clear selected bounding boxes.
-  selectedIndices.clear();
+  // Obtain sorted indices for bounding boxes according to their confidence
+  // scores; ties are broken by the index of the boxes.
+  const arma::uvec order = arma::stable_sort_index(confidenceScores,
+      "descend");
 
-  // Obtain Sorted indices for bounding boxes according to
-  // their confidence scores.
-  arma::ucolvec sortedIndices = arma::sort_index(confidenceScores);
+  std::vector<size_t> selected;
+  Suppress(boundingBoxes, order, threshold, selected);
 
-  // Pre-Compute area of each bounding box.
-  arma::mat area;
-  if (UseCoordinates)
-  {
-    area = (boundingBoxes.row(2) - boundingBoxes.row(0)) %
-        (boundingBoxes.row(3) - boundingBoxes.row(1));
-  }
-  else
-  {
-    area = boundingBoxes.row(2) % boundingBoxes.row(3);
-  }
+  selectedIndices.set_size(selected.size());
+  for (size_t i = 0; i < selected.size(); ++i)
+    selectedIndices[i] = order[selected[i]];
+}
 
-  while (sortedIndices.n_elem > 0)
-  {
-    size_t selectedIndex = sortedIndices(sortedIndices.n_elem - 1);
+template<bool UseCoordinates>
+template<
+    typename BoundingBoxesType,
+    typename ConfidenceScoreType,
+    typename OutputType
+>
+void NMS<UseCoordinates>::EvaluateByClass(
+    const BoundingBoxesType& boundingBoxes,
+    const ConfidenceScoreType& confidenceScores,
+    const arma::Row<size_t>& labels,
+    OutputType& selectedIndices,
+    const double threshold)
+{
+  Log::Assert(boundingBoxes.n_rows == 4, "Bounding boxes must "
+      "contain only 4 rows determining coordinates of bounding "
+      "box either in {x1, y1, x2, y2} or {x1, y1, h, w} format."
+      "Refer to the documentation for more information.");
 
-    // Choose the box with the largest probability.
-    selectedIndices.insert_rows(0, arma::uvec(1).fill(selectedIndex));
+  if (confidenceScores.n_elem != boundingBoxes.n_cols ||
+      labels.n_elem != boundingBoxes.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "NMS::EvaluateByClass(): found " << confidenceScores.n_elem
+        << " confidence scores and " << labels.n_elem << " labels for "
+        << boundingBoxes.n_cols << " bounding boxes!";
+    throw std::invalid_argument(oss.str());
+  }
 
-    // Check if there are other bounding boxes to compare with.
-    if (sortedIndices.n_elem == 1)
-    {
-      break;
-    }
+  const arma::uvec order = arma::stable_sort_index(confidenceScores,
+      "descend");
+  const size_t numClasses = (labels.n_elem == 0) ? 0 : labels.max() + 1;
 
-    // Remove the last index.
-    sortedIndices = sortedIndices(arma::span(0, sortedIndices.n_rows - 2),
-        arma::span());
+  // Split the order of the scores into the order of each class.
+  arma::Col<size_t> counts(numClasses, arma::fill::zeros);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    ++counts[labels[i]];
 
-    // Get x and y coordinates for remaining bounding boxes.
-    BoundingBoxesType x2 = boundingBoxes.submat(arma::uvec(1).fill(2),
-        sortedIndices);
+  std::vector<arma::uvec> classOrders(numClasses);
+  for (size_t c = 0; c < numClasses; ++c)
+    classOrders[c].set_size(counts[c]);
+  counts.zeros();
+  for (size_t i = 0; i < order.n_elem; ++i)
+  {
+    const size_t c = labels[order[i]];
+    classOrders[c][counts[c]++] = order[i];
+  }
 
-    BoundingBoxesType x1 = boundingBoxes.submat(arma::uvec(1).fill(0),
-        sortedIndices);;
+  std::vector<std::vector<size_t>> classSelected(numClasses);
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numClasses; ++c)
+    Suppress(boundingBoxes, classOrders[c], threshold, classSelected[c]);
+
+  // Merge the selected boxes of all the classes, in the order of the scores.
+  arma::uvec ranks(order.n_elem);
+  for (size_t i = 0; i < order.n_elem; ++i)
+    ranks[order[i]] = i;
+  std::vector<size_t> selected;
+  for (size_t c = 0; c < numClasses; ++c)
+    for (size_t i = 0; i < classSelected[c].size(); ++i)
+      selected.push_back(classOrders[c][classSelected[c][i]]);
+  std::sort(selected.begin(), selected.end(),
+      [&ranks](const size_t a, const size_t b) { return ranks[a] < ranks[b]; });
+
+  selectedIndices.set_size(selected.size());
+  for (size_t i = 0; i < selected.size(); ++i)
+    selectedIndices[i] = selected[i];
+}
 
-    BoundingBoxesType y2 = boundingBoxes.submat(arma::uvec(1).fill(3),
-        sortedIndices);
+template<bool UseCoordinates>
+template<typename BoundingBoxesType>
+void NMS<UseCoordinates>::Suppress(
+    const BoundingBoxesType& boundingBoxes,
+    const arma::uvec& order,
+    const double threshold,
+    std::vector<size_t>& selected)
+{
+  typedef typename BoundingBoxesType::elem_type ElemType;
 
-    BoundingBoxesType y1 = boundingBoxes.submat(arma::uvec(1).fill(1),
-        sortedIndices);
+  // Copy the corners and the areas of the boxes, in the order of the scores,
+  // to contiguous arrays.
+  const size_t n = order.n_elem;
+  arma::Col<ElemType> x1(n), y1(n), x2(n), y2(n), area(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    const size_t box = order[i];
+    x1[i] = boundingBoxes(0, box);
+    y1[i] = boundingBoxes(1, box);
+    // Change height - width representation to coordinate represention.
+    x2[i] = UseCoordinates ? boundingBoxes(2, box) :
+        boundingBoxes(0, box) + boundingBoxes(2, box);
+    y2[i] = UseCoordinates ? boundingBoxes(3, box) :
+        boundingBoxes(1, box) + boundingBoxes(3, box);
+    area[i] = (x2[i] - x1[i]) * (y2[i] - y1[i]);
+  }
 
-    size_t selectedX2 = boundingBoxes(2, selectedIndex);
-    size_t selectedY2 = boundingBoxes(3, selectedIndex);
-    size_t selectedX1 = boundingBoxes(0, selectedIndex);
-    size_t selectedY1 = boundingBoxes(1, selectedIndex);
+  // Bit i is set once box i is selected or suppressed; the bits past the last
+  // box are set, so that it is never a candidate again.
+  const size_t numWords = (n + 63) / 64;
+  std::vector<uint64_t> removed(numWords, 0);
+  if (n % 64 != 0)
+    removed.back() = ~((((uint64_t) 1) << (n % 64)) - 1);
 
-    if (!UseCoordinates)
+  selected.clear();
+  for (size_t i = 0; i < n; ++i)
+  {
+    if ((removed[i / 64] >> (i % 64)) & 1)
+      continue;
+
+    // Choose the box with the largest score that is left.
+    selected.push_back(i);
+    removed[i / 64] |= ((uint64_t) 1) << (i % 64);
+
+    const ElemType selectedX1 = x1[i];
+    const ElemType selectedY1 = y1[i];
+    const ElemType selectedX2 = x2[i];
+    const ElemType selectedY2 = y2[i];
+    const ElemType selectedArea = area[i];
+    for (size_t w = i / 64; w < numWords; ++w)
     {
-      // Change height - width representation to coordinate represention.
-      x2 = x2 + x1;
-      y2 = y2 + y1;
-      selectedX2 = selectedX2 + selectedX1;
-      selectedY2 = selectedY2 + selectedY1;
+      // Skip the blocks whose boxes are all removed.
+      if (removed[w] == ~((uint64_t) 0))
+        continue;
+
+      // Calculate the IoU of the boxes of the block with the selected box.  A
+      // NaN IoU (both boxes are empty) suppresses the box.
+      const size_t begin = 64 * w;
+      const size_t end = std::min(begin + 64, n);
+      uint64_t word = 0;
+      for (size_t j = begin; j < end; ++j)
+      {
+        const ElemType width = std::max(std::min(selectedX2, x2[j]) -
+            std::max(selectedX1, x1[j]), ElemType(0));
+        const ElemType height = std::max(std::min(selectedY2, y2[j]) -
+            std::max(selectedY1, y1[j]), ElemType(0));
+        const ElemType intersection = width * height;
+        const ElemType iou = intersection /
+            (selectedArea + area[j] - intersection);
+        word |= ((uint64_t) !(iou <= threshold)) << (j - begin);
+      }
+
+      removed[w] |= word;
     }
-
-    // Calculate points of intersection between the bounding box with
-    // highest confidence score and remaining bounding boxes.
-    x2 = arma::clamp(x2, DBL_MIN, selectedX2);
-    y2 = arma::clamp(y2, DBL_MIN, selectedY2);
-    x1 = arma::clamp(x1, selectedX1, DBL_MAX);
-    y1 = arma::clamp(y1, selectedY1, DBL_MAX);
-
-    BoundingBoxesType intersectionArea = arma::clamp(x2 - x1, 0.0, DBL_MAX) %
-          arma::clamp(y2 - y1, 0.0, DBL_MAX);
-
-    // Calculate IoU of remaining boxes with the last bounding box with
-    // the highest confidence score.
-    BoundingBoxesType calculateIoU = intersectionArea /
-        (area(sortedIndices).t() - intersectionArea + area(selectedIndex));
-
-    sortedIndices = sortedIndices(arma::find(calculateIoU <= threshold));
   }
-
-  selectedIndices = arma::flipud(selectedIndices);
 }
 
 template<bool UseCoordinates>
@@ -14,7 +14,9 @@
 #include <mlpack/prereqs.hpp>
 
 #include "../statistic.hpp"
+#include "../node_arena.hpp"
 #include "midpoint_split.hpp"
+#include "mean_split.hpp"
 
 namespace mlpack {
 
@@ -31,6 +33,10 @@ namespace mlpack {
  * This tree does take one runtime parameter in the constructor, which is the
  * max leaf size to be used.
  *
+ * The nodes of a tree are allocated from a NodeArena owned by the root, so
+ * building and destroying a tree takes only a few calls to the system
+ * allocator.  Copies of a tree allocate their nodes individually.
+ *
  * @tparam DistanceType The distance metric used for tree-building.  The
  *     BoundType may place restrictions on the metrics that can be used.
  * @tparam StatisticType Extra data contained in the node.  See statistic.hpp
@@ -51,7 +57,7 @@ template<typename DistanceType,
                   typename...> class BoundType = HRectBound,
          template<typename SplitBoundType,
                   typename SplitMatType> class SplitType = MidpointSplit>
-class BinarySpaceTree
+class BinarySpaceTree : public ArenaAllocated
 {
  public:
   //! So other classes can use TreeType::Mat.
@@ -61,6 +67,23 @@ class BinarySpaceTree
 
   typedef SplitType<BoundType<DistanceType, ElemType>, MatType> Split;
 
+  /**
+   * Whether or not the two children of a node can be built at the same time.
+   * This requires a splitter that holds no state, is deterministic, and does
+   * not need the sibling of a node to compute its bound (HollowBallBound does).
+   * Columns of sparse matrices cannot be swapped independently either.
+   */
+  static constexpr bool ParallelBuild =
+      (std::is_same<Split, MidpointSplit<BoundType<DistanceType, ElemType>,
+                                         MatType>>::value ||
+       std::is_same<Split, MeanSplit<BoundType<DistanceType, ElemType>,
+                                     MatType>>::value) &&
+      !arma::is_arma_sparse_type<MatType>::value;
+
+  //! Nodes with at least this many points build their children in separate
+  //! OpenMP tasks, if ParallelBuild is true.
+  static constexpr size_t ParallelBuildMinCount = 4096;
+
  private:
   //! The left child node.
   BinarySpaceTree* left;
@@ -88,6 +111,10 @@ class BinarySpaceTree
   //! The dataset.  If we are the root of the tree, we own the dataset and must
   //! delete it.
   MatType* dataset;
+  //! The arena that the children are allocated from (NULL if the root is a
+  //! leaf, or to allocate the children individually).  If we are the root of
+  //! the tree, we own the arena and must delete it.
+  NodeArena* arena;
 
  public:
   //! A single-tree traverser for binary space trees; see
@@ -102,6 +129,11 @@ class BinarySpaceTree
   template<typename RuleType>
   class BreadthFirstDualTreeTraverser;
 
+  //! A dual-tree traverser that splits the recursion into OpenMP tasks; see
+  //! parallel_dual_tree_traverser.hpp.
+  template<typename RuleType>
+  class ParallelDualTreeTraverser;
+
   /**
    * Construct this as the root node of a binary space tree using the given
    * dataset.  This will copy the input matrix; if you don't want this, consider
@@ -538,6 +570,20 @@ class BinarySpaceTree
       const size_t maxLeafSize,
       SplitType<BoundType<DistanceType, ElemType>, MatType>& splitter);
 
+  /**
+   * Build the two children of the current node with the given functors.  If
+   * ParallelBuild is true and the node is large enough, the children are built
+   * in separate OpenMP tasks; a parallel region is opened if we are not inside
+   * one already.  Nodes large enough to be partitioned in parallel (see
+   * ParallelSplitMinCount) build their children one after another, so that
+   * the partitions of the children can use all threads too.
+   *
+   * @param buildLeft Functor that builds the left child.
+   * @param buildRight Functor that builds the right child.
+   */
+  template<typename LeftBuilderType, typename RightBuilderType>
+  void BuildChildren(LeftBuilderType& buildLeft, RightBuilderType& buildRight);
+
   /**
    * Update the bound of the current node. This method does not take into
    * account bound-specific properties.
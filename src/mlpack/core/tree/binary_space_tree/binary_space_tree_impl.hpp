@@ -40,7 +40,8 @@ BinarySpaceTree(
     count(data.n_cols), /* and spans all of the dataset. */
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(data)) // Copies the dataset.
+    dataset(new MatType(data)), // Copies the dataset.
+    arena((dataset->n_cols > maxLeafSize) ? new NodeArena() : NULL)
 {
   // Do the actual splitting of this node.
   SplitType<BoundType<DistanceType, ElemType>, MatType> splitter;
@@ -70,7 +71,8 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(data)) // Copies the dataset.
+    dataset(new MatType(data)), // Copies the dataset.
+    arena((dataset->n_cols > maxLeafSize) ? new NodeArena() : NULL)
 {
   // Initialize oldFromNew correctly.
   oldFromNew.resize(data.n_cols);
@@ -106,7 +108,8 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(data)) // Copies the dataset.
+    dataset(new MatType(data)), // Copies the dataset.
+    arena((dataset->n_cols > maxLeafSize) ? new NodeArena() : NULL)
 {
   // Initialize the oldFromNew vector correctly.
   oldFromNew.resize(data.n_cols);
@@ -143,7 +146,8 @@ BinarySpaceTree(MatType&& data, const size_t maxLeafSize) :
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(std::move(data)))
+    dataset(new MatType(std::move(data))),
+    arena((dataset->n_cols > maxLeafSize) ? new NodeArena() : NULL)
 {
   // Do the actual splitting of this node.
   SplitType<BoundType<DistanceType, ElemType>, MatType> splitter;
@@ -173,7 +177,8 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(std::move(data)))
+    dataset(new MatType(std::move(data))),
+    arena((dataset->n_cols > maxLeafSize) ? new NodeArena() : NULL)
 {
   // Initialize oldFromNew correctly.
   oldFromNew.resize(dataset->n_cols);
@@ -209,7 +214,8 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(std::move(data)))
+    dataset(new MatType(std::move(data))),
+    arena((dataset->n_cols > maxLeafSize) ? new NodeArena() : NULL)
 {
   // Initialize the oldFromNew vector correctly.
   oldFromNew.resize(dataset->n_cols);
@@ -250,7 +256,8 @@ BinarySpaceTree(
     begin(begin),
     count(count),
     bound(parent->Dataset().n_rows),
-    dataset(&parent->Dataset()) // Point to the parent's dataset.
+    dataset(&parent->Dataset()), // Point to the parent's dataset.
+    arena(parent->arena)
 {
   // Perform the actual splitting.
   SplitNode(maxLeafSize, splitter);
@@ -281,7 +288,8 @@ BinarySpaceTree(
     begin(begin),
     count(count),
     bound(parent->Dataset().n_rows),
-    dataset(&parent->Dataset())
+    dataset(&parent->Dataset()),
+    arena(parent->arena)
 {
   // Hopefully the vector is initialized correctly!  We can't check that
   // entirely but we can do a minor sanity check.
@@ -317,7 +325,8 @@ BinarySpaceTree(
     begin(begin),
     count(count),
     bound(parent->Dataset()->n_rows),
-    dataset(&parent->Dataset())
+    dataset(&parent->Dataset()),
+    arena(parent->arena)
 {
   // Hopefully the vector is initialized correctly!  We can't check that
   // entirely but we can do a minor sanity check.
@@ -361,7 +370,9 @@ BinarySpaceTree(
     furthestDescendantDistance(other.furthestDescendantDistance),
     minimumBoundDistance(other.minimumBoundDistance),
     // Copy matrix, but only if we are the root.
-    dataset((other.parent == NULL) ? new MatType(*other.dataset) : NULL)
+    dataset((other.parent == NULL) ? new MatType(*other.dataset) : NULL),
+    // Copies allocate their nodes individually.
+    arena(NULL)
 {
   // Create left and right children (if any).
   if (other.Left())
@@ -421,9 +432,12 @@ operator=(const BinarySpaceTree& other)
   delete dataset;
   delete left;
   delete right;
+  if (!parent)
+    delete arena;
 
   left = NULL;
   right = NULL;
+  arena = NULL;
   parent = other.Parent();
   begin = other.Begin();
   count = other.Count();
@@ -495,6 +509,8 @@ operator=(BinarySpaceTree&& other)
   delete dataset;
   delete left;
   delete right;
+  if (!parent)
+    delete arena;
 
   parent = other.Parent();
   left = other.Left();
@@ -507,6 +523,7 @@ operator=(BinarySpaceTree&& other)
   furthestDescendantDistance = other.FurthestDescendantDistance();
   minimumBoundDistance = other.MinimumBoundDistance();
   dataset = other.dataset;
+  arena = other.arena;
 
   other.left = NULL;
   other.right = NULL;
@@ -517,6 +534,7 @@ operator=(BinarySpaceTree&& other)
   other.furthestDescendantDistance = 0.0;
   other.minimumBoundDistance = 0.0;
   other.dataset = NULL;
+  other.arena = NULL;
 
   return *this;
 }
@@ -545,7 +563,8 @@ BinarySpaceTree(BinarySpaceTree&& other) :
     parentDistance(other.parentDistance),
     furthestDescendantDistance(other.furthestDescendantDistance),
     minimumBoundDistance(other.minimumBoundDistance),
-    dataset(other.dataset)
+    dataset(other.dataset),
+    arena(other.arena)
 {
   // Now we are a clone of the other tree.  But we must also clear the other
   // tree's contents, so it doesn't delete anything when it is destructed.
@@ -558,6 +577,7 @@ BinarySpaceTree(BinarySpaceTree&& other) :
   other.furthestDescendantDistance = 0.0;
   other.minimumBoundDistance = 0.0;
   other.dataset = NULL;
+  other.arena = NULL;
 
   // Set new parent.
   if (left)
@@ -608,9 +628,12 @@ BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
   delete left;
   delete right;
 
-  // If we're the root, delete the matrix.
+  // If we're the root, delete the matrix and the arena that held the children.
   if (!parent)
+  {
     delete dataset;
+    delete arena;
+  }
 }
 
 template<typename DistanceType,
@@ -964,10 +987,19 @@ BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
 
   // Now that we know the split column, we will recursively split the children
   // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, splitter,
-      maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
-      splitter, maxLeafSize);
+  // The children hold disjoint ranges of the dataset, so they may be built in
+  // parallel.
+  auto buildLeft = [&]()
+  {
+    left = new (arena) BinarySpaceTree(this, begin, splitCol - begin,
+        splitter, maxLeafSize);
+  };
+  auto buildRight = [&]()
+  {
+    right = new (arena) BinarySpaceTree(this, splitCol,
+        begin + count - splitCol, splitter, maxLeafSize);
+  };
+  BuildChildren(buildLeft, buildRight);
 
   // Calculate parent distances for those two nodes.
   arma::Col<ElemType> center, leftCenter, rightCenter;
@@ -1035,10 +1067,19 @@ SplitNode(std::vector<size_t>& oldFromNew,
 
   // Now that we know the split column, we will recursively split the children
   // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, oldFromNew,
-      splitter, maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
-      oldFromNew, splitter, maxLeafSize);
+  // The children hold disjoint ranges of the dataset (and of oldFromNew), so
+  // they may be built in parallel.
+  auto buildLeft = [&]()
+  {
+    left = new (arena) BinarySpaceTree(this, begin, splitCol - begin,
+        oldFromNew, splitter, maxLeafSize);
+  };
+  auto buildRight = [&]()
+  {
+    right = new (arena) BinarySpaceTree(this, splitCol,
+        begin + count - splitCol, oldFromNew, splitter, maxLeafSize);
+  };
+  BuildChildren(buildLeft, buildRight);
 
   // Calculate parent distances for those two nodes.
   arma::Col<ElemType> center, leftCenter, rightCenter;
@@ -1055,6 +1096,62 @@ SplitNode(std::vector<size_t>& oldFromNew,
   right->ParentDistance() = rightParentDistance;
 }
 
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename LeftBuilderType, typename RightBuilderType>
+void
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+BuildChildren(LeftBuilderType& buildLeft, RightBuilderType& buildRight)
+{
+  #ifdef MLPACK_USE_OPENMP
+  if (ParallelBuild && count >= ParallelBuildMinCount &&
+      !UseParallelSplit<MatType>(count) && omp_get_max_threads() > 1)
+  {
+    if (omp_in_parallel())
+    {
+      // We are already inside a task (or the user's parallel region), so
+      // just spawn more tasks.
+      #pragma omp task shared(buildLeft)
+      {
+        buildLeft();
+      }
+
+      buildRight();
+
+      #pragma omp taskwait
+    }
+    else
+    {
+      #pragma omp parallel
+      {
+        #pragma omp single
+        {
+          #pragma omp task shared(buildLeft)
+          {
+            buildLeft();
+          }
+
+          buildRight();
+
+          #pragma omp taskwait
+        }
+      }
+    }
+
+    return;
+  }
+  #endif
+
+  buildLeft();
+  buildRight();
+}
+
 template<typename DistanceType,
          typename StatisticType,
          typename MatType,
@@ -1120,7 +1217,8 @@ BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
     stat(*this),
     parentDistance(0),
     furthestDescendantDistance(0),
-    dataset(NULL)
+    dataset(NULL),
+    arena(NULL)
 {
   // Nothing to do.
 }
@@ -1149,11 +1247,15 @@ BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
     if (right)
       delete right;
     if (!parent)
+    {
       delete dataset;
+      delete arena;
+    }
 
     parent = NULL;
     left = NULL;
     right = NULL;
+    arena = NULL;
   }
 
   ar(CEREAL_NVP(begin));
@@ -18,6 +18,7 @@
 #include <mlpack/prereqs.hpp>
 
 #include "binary_space_tree.hpp"
+#include "../leaf_base_case.hpp"
 
 namespace mlpack {
 
@@ -87,6 +88,11 @@ class BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType,
   //! Traversal information, held in the class so that it isn't continually
   //! being reallocated.
   typename RuleType::TraversalInfoType traversalInfo;
+
+  //! The query points of a leaf that were not pruned, if the rules provide
+  //! LeafBaseCase(); held in the class so that it isn't continually being
+  //! reallocated.
+  std::vector<size_t> leafQueries;
 };
 
 } // namespace mlpack
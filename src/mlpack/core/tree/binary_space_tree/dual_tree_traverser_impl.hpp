@@ -77,22 +77,43 @@ DualTreeTraverser<RuleType>::Traverse(
   {
     // Loop through each of the points in each node.
     const size_t queryEnd = queryNode.Begin() + queryNode.Count();
-    const size_t refEnd = referenceNode.Begin() + referenceNode.Count();
-    for (size_t query = queryNode.Begin(); query < queryEnd; ++query)
+    if constexpr (HasLeafBaseCase<RuleType, BinarySpaceTree>::value)
     {
-      // See if we need to investigate this point (this function should be
-      // implemented for the single-tree recursion too).  Restore the traversal
-      // information first.
-      rule.TraversalInfo() = traversalInfo;
-      const double childScore = rule.Score(query, referenceNode);
+      // The rules can compute all the base cases of the two leaves at once,
+      // so only collect the query points that can't be pruned.
+      leafQueries.clear();
+      for (size_t query = queryNode.Begin(); query < queryEnd; ++query)
+      {
+        rule.TraversalInfo() = traversalInfo;
+        if (rule.Score(query, referenceNode) != DBL_MAX)
+          leafQueries.push_back(query);
+      }
+
+      if (!leafQueries.empty())
+      {
+        rule.LeafBaseCase(leafQueries, referenceNode);
+        numBaseCases += leafQueries.size() * referenceNode.Count();
+      }
+    }
+    else
+    {
+      const size_t refEnd = referenceNode.Begin() + referenceNode.Count();
+      for (size_t query = queryNode.Begin(); query < queryEnd; ++query)
+      {
+        // See if we need to investigate this point (this function should be
+        // implemented for the single-tree recursion too).  Restore the
+        // traversal information first.
+        rule.TraversalInfo() = traversalInfo;
+        const double childScore = rule.Score(query, referenceNode);
 
-      if (childScore == DBL_MAX)
-        continue; // We can't improve this particular point.
+        if (childScore == DBL_MAX)
+          continue; // We can't improve this particular point.
 
-      for (size_t ref = referenceNode.Begin(); ref < refEnd; ++ref)
-        rule.BaseCase(query, ref);
+        for (size_t ref = referenceNode.Begin(); ref < refEnd; ++ref)
+          rule.BaseCase(query, ref);
 
-      numBaseCases += referenceNode.Count();
+        numBaseCases += referenceNode.Count();
+      }
     }
   }
   else if (((!queryNode.IsLeaf()) && referenceNode.IsLeaf()) ||
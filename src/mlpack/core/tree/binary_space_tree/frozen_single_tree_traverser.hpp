@@ -0,0 +1,68 @@
+/**
+ * @file core/tree/binary_space_tree/frozen_single_tree_traverser.hpp
+ *
+ * Defines the SingleTreeTraverser for the FrozenTree type.  This walks the
+ * flat arrays of the FrozenTree instead of following child pointers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_FROZEN_SINGLE_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_FROZEN_SINGLE_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "frozen_tree.hpp"
+
+namespace mlpack {
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+class FrozenTree<BinarySpaceTree<DistanceType, StatisticType, MatType,
+                                 HRectBound, SplitType>>::SingleTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the single tree traverser with the given rule set.
+   */
+  SingleTreeTraverser(RuleType& rule);
+
+  /**
+   * Traverse the tree with the given point.
+   *
+   * @param queryIndex The index of the point in the query set which is being
+   *     used as the query point.
+   * @param referenceTree The frozen tree to be traversed.
+   */
+  void Traverse(const size_t queryIndex, const FrozenTree& referenceTree);
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+  //! Modify the number of prunes.
+  size_t& NumPrunes() { return numPrunes; }
+
+ private:
+  //! Traverse the given node.
+  void Traverse(const size_t queryIndex,
+                const FrozenTree& referenceTree,
+                const size_t referenceNode);
+
+  //! Reference to the rules with which the tree will be traversed.
+  RuleType& rule;
+
+  //! The number of nodes which have been pruned during traversal.
+  size_t numPrunes;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "frozen_single_tree_traverser_impl.hpp"
+
+#endif
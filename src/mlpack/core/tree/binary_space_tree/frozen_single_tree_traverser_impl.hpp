@@ -0,0 +1,127 @@
+/**
+ * @file core/tree/binary_space_tree/frozen_single_tree_traverser_impl.hpp
+ *
+ * Implementation of the SingleTreeTraverser for FrozenTree.  This follows
+ * exactly the same recursion as the BinarySpaceTree single tree traverser.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_FROZEN_SINGLE_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_FROZEN_SINGLE_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "frozen_single_tree_traverser.hpp"
+
+namespace mlpack {
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+FrozenTree<BinarySpaceTree<DistanceType, StatisticType, MatType, HRectBound,
+                           SplitType>>::
+SingleTreeTraverser<RuleType>::SingleTreeTraverser(RuleType& rule) :
+    rule(rule),
+    numPrunes(0)
+{ /* Nothing to do. */ }
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+void
+FrozenTree<BinarySpaceTree<DistanceType, StatisticType, MatType, HRectBound,
+                           SplitType>>::
+SingleTreeTraverser<RuleType>::Traverse(const size_t queryIndex,
+                                        const FrozenTree& referenceTree)
+{
+  // If the root is not a leaf, it must be scored first.
+  if (!referenceTree.IsLeaf(0))
+  {
+    const double rootScore = rule.Score(queryIndex, referenceTree.Root());
+    // If root score is DBL_MAX, don't recurse into that node.
+    if (rootScore == DBL_MAX)
+    {
+      ++numPrunes;
+      return;
+    }
+  }
+
+  Traverse(queryIndex, referenceTree, 0);
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+void
+FrozenTree<BinarySpaceTree<DistanceType, StatisticType, MatType, HRectBound,
+                           SplitType>>::
+SingleTreeTraverser<RuleType>::Traverse(const size_t queryIndex,
+                                        const FrozenTree& referenceTree,
+                                        const size_t referenceNode)
+{
+  // If we are a leaf, run the base case as necessary.
+  if (referenceTree.IsLeaf(referenceNode))
+  {
+    const size_t refBegin = referenceTree.Begin(referenceNode);
+    const size_t refEnd = refBegin + referenceTree.Count(referenceNode);
+    for (size_t i = refBegin; i < refEnd; ++i)
+      rule.BaseCase(queryIndex, i);
+    return;
+  }
+
+  // The children are adjacent in memory.
+  const size_t left = referenceTree.Left(referenceNode);
+  const size_t right = left + 1;
+  const Node leftNode = referenceTree.GetNode(left);
+  const Node rightNode = referenceTree.GetNode(right);
+
+  // If either score is DBL_MAX, we do not recurse into that node.
+  double leftScore = rule.Score(queryIndex, leftNode);
+  double rightScore = rule.Score(queryIndex, rightNode);
+
+  if (leftScore == DBL_MAX && rightScore == DBL_MAX)
+  {
+    numPrunes += 2; // Pruned both left and right.
+  }
+  else if (leftScore <= rightScore)
+  {
+    // Recurse to the left first (this is also what happens on a tie).
+    Traverse(queryIndex, referenceTree, left);
+
+    // Is it still valid to recurse to the right?
+    rightScore = rule.Rescore(queryIndex, rightNode, rightScore);
+
+    if (rightScore != DBL_MAX)
+      Traverse(queryIndex, referenceTree, right);
+    else
+      ++numPrunes;
+  }
+  else
+  {
+    // Recurse to the right first.
+    Traverse(queryIndex, referenceTree, right);
+
+    // Is it still valid to recurse to the left?
+    leftScore = rule.Rescore(queryIndex, leftNode, leftScore);
+
+    if (leftScore != DBL_MAX)
+      Traverse(queryIndex, referenceTree, left);
+    else
+      ++numPrunes;
+  }
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,207 @@
+/**
+ * @file core/tree/binary_space_tree/frozen_tree.hpp
+ *
+ * Definition of the FrozenTree class, a read-only, contiguous representation
+ * of a kd-tree that can be used for querying once the tree is built.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_FROZEN_TREE_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_FROZEN_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "binary_space_tree.hpp"
+
+namespace mlpack {
+
+/**
+ * A lightweight handle to a node of a FrozenTree.  This is what rules receive
+ * when they are used with FrozenTree::SingleTreeTraverser; it provides the
+ * point-to-node distances that the sort policies need.
+ *
+ * @tparam FrozenTreeType Type of the FrozenTree the node belongs to.
+ */
+template<typename FrozenTreeType>
+class FrozenTreeNode
+{
+ public:
+  //! The type of element held in the dataset.
+  typedef typename FrozenTreeType::ElemType ElemType;
+
+  //! Create a handle to the given node of the given tree.
+  FrozenTreeNode(const FrozenTreeType& tree, const size_t index) :
+      tree(&tree), index(index) { }
+
+  //! Get the tree this node belongs to.
+  const FrozenTreeType& Tree() const { return *tree; }
+  //! Get the index of this node in the tree.
+  size_t Index() const { return index; }
+
+  //! Return the index of the first point held in this node.
+  size_t Begin() const { return tree->Begin(index); }
+  //! Return the number of points held in this node.
+  size_t Count() const { return tree->Count(index); }
+  //! Return whether or not this node is a leaf.
+  bool IsLeaf() const { return tree->IsLeaf(index); }
+
+  //! Return the minimum distance from this node to the given point.
+  template<typename VecType>
+  ElemType MinDistance(const VecType& point) const
+  {
+    return tree->MinDistance(index, point);
+  }
+
+  //! Return the maximum distance from this node to the given point.
+  template<typename VecType>
+  ElemType MaxDistance(const VecType& point) const
+  {
+    return tree->MaxDistance(index, point);
+  }
+
+ private:
+  //! The tree this node belongs to.
+  const FrozenTreeType* tree;
+  //! The index of the node.
+  size_t index;
+};
+
+/**
+ * A FrozenTree is a query-only copy of the structure of a tree.  Instead of
+ * one heap-allocated object per node, all nodes are stored in breadth-first
+ * order in a few contiguous arrays: the bounds of all nodes are the columns of
+ * a single matrix, and the begin/count/child indices and the statistics are
+ * stored in flat vectors.  The two children of a node are always adjacent, so
+ * the right child of node i is Left(i) + 1.
+ *
+ * This means that the traversal walks through memory that is mostly
+ * contiguous instead of chasing pointers to separately allocated nodes and
+ * bounds.  The dataset itself is not copied; the FrozenTree refers to the
+ * dataset of the tree it was built from, so that tree must outlive the
+ * FrozenTree.  Statistics are copied at construction time.
+ *
+ * Only trees with an HRectBound (that is, KDTree and MeanSplitKDTree) are
+ * supported.  A FrozenTree can be traversed with its SingleTreeTraverser; the
+ * rules must provide Score() and Rescore() overloads that take a
+ * FrozenTreeNode, as NeighborSearchRules does.
+ *
+ * @code
+ * KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+ *     arma::mat> tree(dataset);
+ * FrozenTree<decltype(tree)> frozenTree(tree);
+ * @endcode
+ *
+ * @tparam TreeType Type of tree to freeze.
+ */
+template<typename TreeType>
+class FrozenTree;
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+class FrozenTree<BinarySpaceTree<DistanceType, StatisticType, MatType,
+                                 HRectBound, SplitType>>
+{
+ public:
+  //! The type of the tree that this was built from.
+  typedef BinarySpaceTree<DistanceType, StatisticType, MatType, HRectBound,
+      SplitType> TreeType;
+  //! So other classes can use FrozenTree::Mat.
+  typedef MatType Mat;
+  //! The type of element held in MatType.
+  typedef typename MatType::elem_type ElemType;
+  //! The type of node handles passed to rules.
+  typedef FrozenTreeNode<FrozenTree> Node;
+
+  //! A single-tree traverser for frozen trees; see frozen_tree_impl.hpp.
+  template<typename RuleType>
+  class SingleTreeTraverser;
+
+  /**
+   * Build the frozen representation of the given tree.  The tree itself is
+   * not modified, but it must outlive this object since its dataset is used.
+   *
+   * @param tree Tree to freeze.
+   */
+  FrozenTree(const TreeType& tree);
+
+  //! Get the dataset of the tree.
+  const MatType& Dataset() const { return *dataset; }
+
+  //! Get the number of nodes in the tree.
+  size_t NumNodes() const { return nodes.size(); }
+  //! Get a handle to the root node.
+  Node Root() const { return Node(*this, 0); }
+  //! Get a handle to the given node.
+  Node GetNode(const size_t node) const { return Node(*this, node); }
+
+  //! Get the index of the first point held in the given node.
+  size_t Begin(const size_t node) const { return nodes[node].begin; }
+  //! Get the number of points held in the given node.
+  size_t Count(const size_t node) const { return nodes[node].count; }
+  //! Return whether or not the given node is a leaf.
+  bool IsLeaf(const size_t node) const { return nodes[node].left == 0; }
+  //! Get the index of the left child of the given node.
+  size_t Left(const size_t node) const { return nodes[node].left; }
+  //! Get the index of the right child of the given node.
+  size_t Right(const size_t node) const { return nodes[node].left + 1; }
+
+  //! Get the statistic of the given node.
+  const StatisticType& Stat(const size_t node) const { return stats[node]; }
+  //! Modify the statistic of the given node.
+  StatisticType& Stat(const size_t node) { return stats[node]; }
+
+  //! Get the bounds of all nodes; column i holds the lower corner of node i
+  //! followed by its upper corner.
+  const arma::Mat<ElemType>& Bounds() const { return bounds; }
+
+  /**
+   * Return the minimum distance between the given node and the given point.
+   * This gives the same result as HRectBound::MinDistance().
+   */
+  template<typename VecType>
+  ElemType MinDistance(const size_t node, const VecType& point) const;
+
+  /**
+   * Return the maximum distance between the given node and the given point.
+   * This gives the same result as HRectBound::MaxDistance().
+   */
+  template<typename VecType>
+  ElemType MaxDistance(const size_t node, const VecType& point) const;
+
+ private:
+  //! Index information for a single node.
+  struct NodeInfo
+  {
+    //! The index of the first point held in the node.
+    size_t begin;
+    //! The number of points held in the node.
+    size_t count;
+    //! The index of the left child, or 0 if the node is a leaf (the root
+    //! cannot be anyone's child).
+    size_t left;
+  };
+
+  //! The dataset of the original tree.
+  const MatType* dataset;
+  //! The dimensionality of the data.
+  size_t dim;
+  //! The bounds of all nodes, one column per node.
+  arma::Mat<ElemType> bounds;
+  //! The index information of all nodes.
+  std::vector<NodeInfo> nodes;
+  //! The statistics of all nodes.
+  std::vector<StatisticType> stats;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "frozen_tree_impl.hpp"
+
+#endif
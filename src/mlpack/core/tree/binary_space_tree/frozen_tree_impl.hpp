@@ -0,0 +1,159 @@
+/**
+ * @file core/tree/binary_space_tree/frozen_tree_impl.hpp
+ *
+ * Implementation of the FrozenTree class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_FROZEN_TREE_IMPL_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_FROZEN_TREE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "frozen_tree.hpp"
+
+namespace mlpack {
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+FrozenTree<BinarySpaceTree<DistanceType, StatisticType, MatType, HRectBound,
+                           SplitType>>::FrozenTree(const TreeType& tree) :
+    dataset(&tree.Dataset()),
+    dim(tree.Dataset().n_rows)
+{
+  // Walk the tree in breadth-first order.  Since the children of a node are
+  // pushed one after the other, they receive adjacent indices.
+  std::vector<const TreeType*> order;
+  order.push_back(&tree);
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    NodeInfo info;
+    info.begin = order[i]->Begin();
+    info.count = order[i]->Count();
+    info.left = 0;
+    if (!order[i]->IsLeaf())
+    {
+      info.left = order.size();
+      order.push_back(order[i]->Left());
+      order.push_back(order[i]->Right());
+    }
+
+    nodes.push_back(info);
+    stats.push_back(order[i]->Stat());
+  }
+
+  // Now pack the bounds of all nodes into one matrix.
+  bounds.set_size(2 * dim, order.size());
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    for (size_t d = 0; d < dim; ++d)
+    {
+      bounds(d, i) = order[i]->Bound()[d].Lo();
+      bounds(dim + d, i) = order[i]->Bound()[d].Hi();
+    }
+  }
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename VecType>
+inline typename MatType::elem_type
+FrozenTree<BinarySpaceTree<DistanceType, StatisticType, MatType, HRectBound,
+                           SplitType>>::MinDistance(
+    const size_t node,
+    const VecType& point) const
+{
+  const ElemType* lo = bounds.colptr(node);
+  const ElemType* hi = lo + dim;
+
+  ElemType sum = 0;
+  for (size_t d = 0; d < dim; ++d)
+  {
+    const ElemType lower = lo[d] - point[d];
+    const ElemType higher = point[d] - hi[d];
+
+    // Only one of lower or higher can be positive; see
+    // HRectBound::MinDistance() for the details of this computation.
+    const ElemType v = (lower + std::fabs(lower)) + (higher + std::fabs(higher));
+    if (DistanceType::Power == 1)
+      sum += v;
+    else if (DistanceType::Power == 2)
+      sum += v * v;
+    else
+      sum += std::pow(v, (ElemType) DistanceType::Power);
+  }
+
+  // Cancel out the constant of 2 that was introduced above.
+  if (DistanceType::Power == 1)
+    return sum * 0.5;
+  else if (DistanceType::Power == 2)
+  {
+    if (DistanceType::TakeRoot)
+      return (ElemType) std::sqrt(sum) * 0.5;
+    else
+      return sum * 0.25;
+  }
+  else
+  {
+    if (DistanceType::TakeRoot)
+      return (ElemType) std::pow((double) sum,
+          1.0 / (double) DistanceType::Power) / 2.0;
+    else
+      return sum / std::pow(2.0, DistanceType::Power);
+  }
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename VecType>
+inline typename MatType::elem_type
+FrozenTree<BinarySpaceTree<DistanceType, StatisticType, MatType, HRectBound,
+                           SplitType>>::MaxDistance(
+    const size_t node,
+    const VecType& point) const
+{
+  const ElemType* lo = bounds.colptr(node);
+  const ElemType* hi = lo + dim;
+
+  ElemType sum = 0;
+  for (size_t d = 0; d < dim; ++d)
+  {
+    const ElemType v = std::max(std::fabs(point[d] - lo[d]),
+        std::fabs(hi[d] - point[d]));
+
+    if (DistanceType::Power == 1)
+      sum += v;
+    else if (DistanceType::Power == 2)
+      sum += v * v;
+    else
+      sum += std::pow(v, (ElemType) DistanceType::Power);
+  }
+
+  if (DistanceType::TakeRoot)
+  {
+    if (DistanceType::Power == 1)
+      return sum;
+    else if (DistanceType::Power == 2)
+      return (ElemType) std::sqrt(sum);
+    else
+      return (ElemType) std::pow((double) sum, 1.0 /
+          (double) DistanceType::Power);
+  }
+  else
+    return sum;
+}
+
+} // namespace mlpack
+
+#endif
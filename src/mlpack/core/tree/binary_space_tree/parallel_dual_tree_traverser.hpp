@@ -0,0 +1,170 @@
+/**
+ * @file core/tree/binary_space_tree/parallel_dual_tree_traverser.hpp
+ *
+ * Defines the ParallelDualTreeTraverser for the BinarySpaceTree tree type.
+ * This is a nested class of BinarySpaceTree which performs the same depth-first
+ * dual-tree traversal as the DualTreeTraverser, but splits the recursion over
+ * disjoint query subtrees into OpenMP tasks down to a configurable depth.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "../rule_traits.hpp"
+#include "binary_space_tree.hpp"
+
+namespace mlpack {
+
+/**
+ * A dual-tree traverser that spawns an OpenMP task for each query child while
+ * the recursion is shallower than MaxTaskDepth().  Below that depth, each task
+ * continues with the sequential DualTreeTraverser.  Because every task owns a
+ * disjoint query subtree, query statistics and per-query-point results are
+ * never written by two tasks at once.
+ *
+ * Each task works on its own copy of the rule, so that the traversal info, the
+ * cached last base case and the base case/score counters are task-local.  This
+ * means that RuleType must be copy-constructible, copies of the rule must
+ * share the storage for the results, and the rule must only write results and
+ * statistics of the query side.  Rules declare this by setting
+ * RuleTraits<RuleType>::HasPerQueryResults, as NeighborSearchRules,
+ * RASearchRules, RangeSearchRules and KDERules do; rules that write reference
+ * or global state (such as the DTBRules of EMST) cannot be used with this
+ * traverser.  The counters of each
+ * copy are added back to the rule that was given to the constructor once the
+ * traversal finishes.
+ *
+ * If mlpack is compiled without OpenMP, this behaves like the
+ * DualTreeTraverser.
+ */
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+class BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType,
+                      SplitType>::ParallelDualTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the parallel dual-tree traverser with the given rule set.  If
+   * maxTaskDepth is 0, the task depth is chosen from the number of available
+   * OpenMP threads.
+   *
+   * @param rule Rule set to use during the traversal.
+   * @param maxTaskDepth Maximum recursion depth at which tasks are spawned.
+   */
+  ParallelDualTreeTraverser(RuleType& rule, const size_t maxTaskDepth = 0);
+
+  /**
+   * Traverse the two trees.  This does not reset the number of prunes.
+   *
+   * @param queryNode The query node to be traversed.
+   * @param referenceNode The reference node to be traversed.
+   */
+  void Traverse(BinarySpaceTree& queryNode,
+                BinarySpaceTree& referenceNode);
+
+  //! Get the maximum depth at which tasks are spawned.
+  size_t MaxTaskDepth() const { return maxTaskDepth; }
+  //! Modify the maximum depth at which tasks are spawned.
+  size_t& MaxTaskDepth() { return maxTaskDepth; }
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+  //! Modify the number of prunes.
+  size_t& NumPrunes() { return numPrunes; }
+
+  //! Get the number of visited combinations.
+  size_t NumVisited() const { return numVisited; }
+  //! Modify the number of visited combinations.
+  size_t& NumVisited() { return numVisited; }
+
+  //! Get the number of times a node combination was scored.
+  size_t NumScores() const { return numScores; }
+  //! Modify the number of times a node combination was scored.
+  size_t& NumScores() { return numScores; }
+
+  //! Get the number of times a base case was calculated.
+  size_t NumBaseCases() const { return numBaseCases; }
+  //! Modify the number of times a base case was calculated.
+  size_t& NumBaseCases() { return numBaseCases; }
+
+ private:
+  //! Convenience typedef for the sequential traverser used below the task
+  //! depth.
+  typedef typename BinarySpaceTree::template DualTreeTraverser<RuleType>
+      SequentialTraverser;
+
+  /**
+   * Traverse the given node combination with the given (task-local) rule.  The
+   * rule's traversal info must already correspond to the given combination.
+   */
+  void Traverse(RuleType& localRule,
+                BinarySpaceTree& queryNode,
+                BinarySpaceTree& referenceNode,
+                const size_t depth);
+
+  /**
+   * Score both children of the reference node against the query node and
+   * recurse into them in the order given by the scores.
+   */
+  void TraverseReferenceChildren(RuleType& localRule,
+                                 BinarySpaceTree& queryNode,
+                                 BinarySpaceTree& referenceNode,
+                                 const size_t depth);
+
+  /**
+   * Score the given query child against the reference node with a new copy of
+   * the rule and traverse the combination if it is not pruned; this is the
+   * body of a task.  recurseReference indicates whether the reference node
+   * should be split too.  The counters of the copy are added to localRule.
+   */
+  void TraverseQueryChild(RuleType& localRule,
+                          const typename RuleType::TraversalInfoType& info,
+                          BinarySpaceTree& queryChild,
+                          BinarySpaceTree& referenceNode,
+                          const bool recurseReference,
+                          const size_t depth,
+                          size_t& baseCases,
+                          size_t& scores);
+
+  //! Reference to the rules with which the trees will be traversed.
+  RuleType& rule;
+
+  //! The maximum depth at which tasks are spawned.
+  size_t maxTaskDepth;
+
+  //! The number of prunes.
+  size_t numPrunes;
+
+  //! The number of node combinations that have been visited during traversal.
+  size_t numVisited;
+
+  //! The number of times a node combination was scored.
+  size_t numScores;
+
+  //! The number of times a base case was calculated.
+  size_t numBaseCases;
+
+  static_assert(RuleTraits<RuleType>::HasPerQueryResults, "RuleType must "
+      "only write per-query results to be used with the "
+      "ParallelDualTreeTraverser; see RuleTraits.");
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "parallel_dual_tree_traverser_impl.hpp"
+
+#endif // MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
@@ -0,0 +1,313 @@
+/**
+ * @file core/tree/binary_space_tree/parallel_dual_tree_traverser_impl.hpp
+ *
+ * Implementation of the ParallelDualTreeTraverser for BinarySpaceTree.  The
+ * recursion over query children is split into OpenMP tasks, and each task
+ * continues with its own copy of the rule.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "parallel_dual_tree_traverser.hpp"
+
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+ParallelDualTreeTraverser<RuleType>::ParallelDualTreeTraverser(
+    RuleType& rule,
+    const size_t maxTaskDepth) :
+    rule(rule),
+    maxTaskDepth(maxTaskDepth),
+    numPrunes(0),
+    numVisited(0),
+    numScores(0),
+    numBaseCases(0)
+{
+  #ifdef MLPACK_USE_OPENMP
+  // Spawn roughly four tasks per thread, so that the load can be balanced when
+  // some query subtrees are pruned early.
+  if (this->maxTaskDepth == 0)
+  {
+    const size_t threads = (size_t) omp_get_max_threads();
+    while ((size_t(1) << this->maxTaskDepth) < 4 * threads)
+      ++this->maxTaskDepth;
+  }
+  #endif
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+void
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+ParallelDualTreeTraverser<RuleType>::Traverse(
+    BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>&
+        queryNode,
+    BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>&
+        referenceNode)
+{
+  // The top-level combination is handled by a single thread; the rest of the
+  // team picks up the tasks it spawns.
+  #pragma omp parallel
+  {
+    #pragma omp single
+    {
+      Traverse(rule, queryNode, referenceNode, 0);
+    }
+  }
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+void
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+ParallelDualTreeTraverser<RuleType>::Traverse(
+    RuleType& localRule,
+    BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>&
+        queryNode,
+    BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>&
+        referenceNode,
+    const size_t depth)
+{
+  // Once we are deep enough (or the query node cannot be split anymore), there
+  // is no more parallelism to expose, so hand over to the sequential traverser.
+  if (depth >= maxTaskDepth || queryNode.IsLeaf())
+  {
+    SequentialTraverser traverser(localRule);
+    traverser.Traverse(queryNode, referenceNode);
+
+    #pragma omp atomic
+    numPrunes += traverser.NumPrunes();
+    #pragma omp atomic
+    numVisited += traverser.NumVisited();
+    #pragma omp atomic
+    numScores += traverser.NumScores();
+    #pragma omp atomic
+    numBaseCases += traverser.NumBaseCases();
+    return;
+  }
+
+  #pragma omp atomic
+  ++numVisited;
+
+  // If both nodes are root nodes, just score them.
+  if (queryNode.Parent() == NULL && referenceNode.Parent() == NULL)
+  {
+    const double rootScore = localRule.Score(queryNode, referenceNode);
+    // If root score is DBL_MAX, don't recurse.
+    if (rootScore == DBL_MAX)
+    {
+      #pragma omp atomic
+      ++numPrunes;
+      return;
+    }
+  }
+
+  // Store the traversal info for this combination; every task starts from it.
+  const typename RuleType::TraversalInfoType traversalInfo =
+      localRule.TraversalInfo();
+
+  // We only recurse down the query node if the reference node is a leaf or if
+  // the query node is much larger than the reference node; this is the same
+  // heuristic that the DualTreeTraverser uses.
+  const bool recurseReference = !referenceNode.IsLeaf() &&
+      (queryNode.NumDescendants() <= 3 * referenceNode.NumDescendants());
+
+  // The two query children hold disjoint sets of points, so they can be
+  // traversed at the same time.
+  size_t leftBaseCases = 0, leftScores = 0;
+  size_t rightBaseCases = 0, rightScores = 0;
+  #pragma omp task shared(localRule, traversalInfo, queryNode, referenceNode, \
+      leftBaseCases, leftScores)
+  {
+    TraverseQueryChild(localRule, traversalInfo, *queryNode.Left(),
+        referenceNode, recurseReference, depth, leftBaseCases, leftScores);
+  }
+
+  #pragma omp task shared(localRule, traversalInfo, queryNode, referenceNode, \
+      rightBaseCases, rightScores)
+  {
+    TraverseQueryChild(localRule, traversalInfo, *queryNode.Right(),
+        referenceNode, recurseReference, depth, rightBaseCases, rightScores);
+  }
+
+  #pragma omp taskwait
+
+  // Now that both tasks are done, fold their counters back into our rule.
+  localRule.BaseCases() += leftBaseCases + rightBaseCases;
+  localRule.Scores() += leftScores + rightScores;
+  localRule.TraversalInfo() = traversalInfo;
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+void
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+ParallelDualTreeTraverser<RuleType>::TraverseQueryChild(
+    RuleType& localRule,
+    const typename RuleType::TraversalInfoType& info,
+    BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>&
+        queryChild,
+    BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>&
+        referenceNode,
+    const bool recurseReference,
+    const size_t depth,
+    size_t& baseCases,
+    size_t& scores)
+{
+  // Create the task-local rule.  Its counters start at zero so that only the
+  // work done by this task is reported back.
+  RuleType childRule(localRule);
+  childRule.BaseCases() = 0;
+  childRule.Scores() = 0;
+  childRule.TraversalInfo() = info;
+
+  if (recurseReference)
+  {
+    TraverseReferenceChildren(childRule, queryChild, referenceNode, depth + 1);
+  }
+  else
+  {
+    const double score = childRule.Score(queryChild, referenceNode);
+    #pragma omp atomic
+    ++numScores;
+
+    if (score != DBL_MAX)
+    {
+      Traverse(childRule, queryChild, referenceNode, depth + 1);
+    }
+    else
+    {
+      #pragma omp atomic
+      ++numPrunes;
+    }
+  }
+
+  baseCases = childRule.BaseCases();
+  scores = childRule.Scores();
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+void
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+ParallelDualTreeTraverser<RuleType>::TraverseReferenceChildren(
+    RuleType& localRule,
+    BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>&
+        queryNode,
+    BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>&
+        referenceNode,
+    const size_t depth)
+{
+  // The recursion order of the reference children matters, so score both of
+  // them first.  The traversal info must be restored before each score.
+  const typename RuleType::TraversalInfoType traversalInfo =
+      localRule.TraversalInfo();
+  double leftScore = localRule.Score(queryNode, *referenceNode.Left());
+  const typename RuleType::TraversalInfoType leftInfo =
+      localRule.TraversalInfo();
+  localRule.TraversalInfo() = traversalInfo;
+  double rightScore = localRule.Score(queryNode, *referenceNode.Right());
+  const typename RuleType::TraversalInfoType rightInfo =
+      localRule.TraversalInfo();
+
+  #pragma omp atomic
+  numScores += 2;
+
+  if (leftScore == DBL_MAX && rightScore == DBL_MAX)
+  {
+    #pragma omp atomic
+    numPrunes += 2;
+  }
+  else if (leftScore <= rightScore)
+  {
+    // Recurse to the left first.
+    localRule.TraversalInfo() = leftInfo;
+    Traverse(localRule, queryNode, *referenceNode.Left(), depth);
+
+    // Is it still valid to recurse to the right?
+    rightScore = localRule.Rescore(queryNode, *referenceNode.Right(),
+        rightScore);
+
+    if (rightScore != DBL_MAX)
+    {
+      localRule.TraversalInfo() = rightInfo;
+      Traverse(localRule, queryNode, *referenceNode.Right(), depth);
+    }
+    else
+    {
+      #pragma omp atomic
+      ++numPrunes;
+    }
+  }
+  else
+  {
+    // Recurse to the right first.
+    localRule.TraversalInfo() = rightInfo;
+    Traverse(localRule, queryNode, *referenceNode.Right(), depth);
+
+    // Is it still valid to recurse to the left?
+    leftScore = localRule.Rescore(queryNode, *referenceNode.Left(), leftScore);
+
+    if (leftScore != DBL_MAX)
+    {
+      localRule.TraversalInfo() = leftInfo;
+      Traverse(localRule, queryNode, *referenceNode.Left(), depth);
+    }
+    else
+    {
+      #pragma omp atomic
+      ++numPrunes;
+    }
+  }
+}
+
+} // namespace mlpack
+
+#endif // MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
@@ -33,6 +33,7 @@ class CosineTree
 {
  public:
   typedef typename GetDenseColType<MatType>::type VecType;
+  typedef typename GetDenseMatType<MatType>::type DenseMatType;
 
   /**
    * CosineTree constructor for the root node of the tree. It initializes the
@@ -65,6 +66,12 @@ class CosineTree
    * input matrix's projection on the obtained subspace is less than a fraction
    * of the norm of the input matrix.
    *
+   * The basis vectors of the nodes in the queue are kept as the columns of one
+   * workspace matrix, so that the orthonormalization of a new basis vector and
+   * the projections of the Monte Carlo samples are matrix-vector products; the
+   * samples and the cosines of the columns of a split node are computed in
+   * parallel.
+   *
    * @param dataset Matrix for which the CosineTree is constructed.
    * @param epsilon Error tolerance fraction for calculated subspace.
    * @param delta Cumulative probability for Monte Carlo error lower bound.
@@ -280,6 +287,27 @@ class CosineTree
   double frobNormSquared;
   //! If true, we own the dataset and need to destroy it in the destructor.
   bool localDataset;
+
+  /**
+   * Orthonormalize the given centroid with respect to the columns of the given
+   * orthonormal basis.
+   *
+   * @param basis Current basis (one vector per column; may be empty).
+   * @param centroid Centroid of the node being added to the basis.
+   * @param newBasisVector Orthonormalized centroid of the node.
+   */
+  static void Orthonormalize(const DenseMatType& basis,
+                             const VecType& centroid,
+                             VecType& newBasisVector);
+
+  /**
+   * Estimate the squared error of the projection of the given node's matrix
+   * onto the span of the columns of the given basis, as in MonteCarloError().
+   *
+   * @param node Node for which Monte Carlo estimate is calculated.
+   * @param basis Current basis (one vector per column; may be empty).
+   */
+  double BasisMonteCarloError(CosineTree* node, const DenseMatType& basis);
 };
 
 class CompareCosineNode
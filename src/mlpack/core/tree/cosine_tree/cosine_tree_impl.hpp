@@ -30,6 +30,7 @@ inline CosineTree<MatType>::CosineTree(const MatType& dataset) :
   l2NormsSquared.zeros(numColumns);
 
   // Set indices and calculate squared norms of the columns.
+  #pragma omp parallel for
   for (size_t i = 0; i < numColumns; ++i)
   {
     indices[i] = i;
@@ -98,6 +99,21 @@ inline CosineTree<MatType>::CosineTree(const MatType& dataset,
   treeQueue.push_back(&root);
   // treeQueue is empty now, so we don't need to call std::push_heap here.
 
+  // The basis vectors of the nodes in the queue are the columns of
+  // basisWorkspace; basisNodes[i] is the node whose basis vector is column i.
+  // The workspace grows by doubling, so it is not reallocated at each split.
+  const size_t dims = dataset.n_rows;
+  DenseMatType basisWorkspace(dims, 16);
+  std::vector<CosineTree*> basisNodes;
+  basisWorkspace.col(0) = root.BasisVector();
+  basisNodes.push_back(&root);
+
+  // Get the first n columns of the workspace, without copying them.
+  auto activeBasis = [&](const size_t n)
+  {
+    return DenseMatType(basisWorkspace.memptr(), dims, n, false, true);
+  };
+
   // Initialize Monte Carlo error estimate for comparison.
   double monteCarloError = root.FrobNormSquared();
 
@@ -110,6 +126,17 @@ inline CosineTree<MatType>::CosineTree(const MatType& dataset,
     std::pop_heap(treeQueue.begin(), treeQueue.end(), comp);
     treeQueue.pop_back();
 
+    // Remove its basis vector from the workspace.
+    const size_t column = std::find(basisNodes.begin(), basisNodes.end(),
+        currentNode) - basisNodes.begin();
+    const size_t lastColumn = basisNodes.size() - 1;
+    if (column != lastColumn)
+    {
+      basisWorkspace.col(column) = basisWorkspace.col(lastColumn);
+      basisNodes[column] = basisNodes[lastColumn];
+    }
+    basisNodes.pop_back();
+
     // If the priority is 0, we can't improve anything, and we can assume that
     // we've done the best we can.
     if (currentNode->L2Error() == 0.0)
@@ -131,20 +158,29 @@ inline CosineTree<MatType>::CosineTree(const MatType& dataset,
     currentLeft = currentNode->Left();
     currentRight = currentNode->Right();
 
-    // Calculate basis vectors of left and right children.
-    VecType lBasisVector, rBasisVector;
+    // Calculate basis vectors of left and right children, and add them to the
+    // workspace.
+    const size_t numBasis = basisNodes.size();
+    if (numBasis + 2 > basisWorkspace.n_cols)
+      basisWorkspace.resize(dims, 2 * basisWorkspace.n_cols);
 
-    ModifiedGramSchmidt(treeQueue, currentLeft->Centroid(), lBasisVector);
-    ModifiedGramSchmidt(treeQueue, currentRight->Centroid(), rBasisVector,
-                        &lBasisVector);
+    VecType lBasisVector, rBasisVector;
+    Orthonormalize(activeBasis(numBasis), currentLeft->Centroid(),
+        lBasisVector);
+    basisWorkspace.col(numBasis) = lBasisVector;
+    Orthonormalize(activeBasis(numBasis + 1), currentRight->Centroid(),
+        rBasisVector);
+    basisWorkspace.col(numBasis + 1) = rBasisVector;
+    basisNodes.push_back(currentLeft);
+    basisNodes.push_back(currentRight);
 
     // Add basis vectors to their respective nodes.
     currentLeft->BasisVector(lBasisVector);
     currentRight->BasisVector(rBasisVector);
 
     // Calculate Monte Carlo error estimates for child nodes.
-    MonteCarloError(currentLeft, treeQueue, &lBasisVector, &rBasisVector);
-    MonteCarloError(currentRight, treeQueue, &lBasisVector, &rBasisVector);
+    BasisMonteCarloError(currentLeft, activeBasis(numBasis + 2));
+    BasisMonteCarloError(currentRight, activeBasis(numBasis + 2));
 
     // Push child nodes into the priority queue.
     treeQueue.push_back(currentLeft);
@@ -153,7 +189,7 @@ inline CosineTree<MatType>::CosineTree(const MatType& dataset,
     std::push_heap(treeQueue.begin(), treeQueue.end(), comp);
 
     // Calculate Monte Carlo error estimate for the root node.
-    monteCarloError = MonteCarloError(&root, treeQueue);
+    monteCarloError = BasisMonteCarloError(&root, activeBasis(numBasis + 2));
   }
 
   // Construct the subspace basis from the current priority queue.
@@ -387,33 +423,33 @@ inline void CosineTree<MatType>::ModifiedGramSchmidt(
     typename CosineTree<MatType>::VecType& newBasisVector,
     typename CosineTree<MatType>::VecType* addBasisVector)
 {
-  // Set new basis vector to centroid.
-  newBasisVector = centroid;
-
-  // Variables for iterating throught the priority queue.
-  CosineTree *currentNode;
-  typename CosineNodeQueue<MatType>::const_iterator i = treeQueue.cbegin();
-
-  // For every vector in the current basis, remove its projection from the
-  // centroid.
-  for ( ; i != treeQueue.cend(); ++i)
-  {
-    currentNode = *i;
+  // Collect the current basis (and the additional basis vector, if passed).
+  DenseMatType basis(centroid.n_elem,
+      treeQueue.size() + (addBasisVector ? 1 : 0));
+  for (size_t i = 0; i < treeQueue.size(); ++i)
+    basis.col(i) = treeQueue[i]->BasisVector();
+  if (addBasisVector)
+    basis.col(treeQueue.size()) = *addBasisVector;
 
-    double projection = (double) dot(currentNode->BasisVector(), centroid);
-    newBasisVector -= projection * currentNode->BasisVector();
-  }
+  Orthonormalize(basis, centroid, newBasisVector);
+}
 
-  // If additional basis vector is passed, take it into account.
-  if (addBasisVector)
-  {
-    double projection = (double) dot(*addBasisVector, centroid);
-    newBasisVector -= *addBasisVector * projection;
-  }
+template<typename MatType>
+inline void CosineTree<MatType>::Orthonormalize(
+    const DenseMatType& basis,
+    const VecType& centroid,
+    VecType& newBasisVector)
+{
+  // Remove the projection of the centroid onto every vector in the current
+  // basis.
+  newBasisVector = centroid;
+  if (basis.n_cols > 0)
+    newBasisVector -= basis * (basis.t() * centroid);
 
   // Normalize the modified centroid vector.
-  if (arma::norm(newBasisVector, 2))
-    newBasisVector /= arma::norm(newBasisVector, 2);
+  const double norm = arma::norm(newBasisVector, 2);
+  if (norm)
+    newBasisVector /= norm;
 }
 
 template<typename MatType>
@@ -422,6 +458,27 @@ inline double CosineTree<MatType>::MonteCarloError(
     CosineNodeQueue<MatType>& treeQueue,
     typename CosineTree<MatType>::VecType* addBasisVector1,
     typename CosineTree<MatType>::VecType* addBasisVector2)
+{
+  // Collect the current basis (and the additional basis vectors, if both are
+  // passed).
+  const bool addVectors = (addBasisVector1 && addBasisVector2);
+  DenseMatType basis(node->GetDataset().n_rows,
+      treeQueue.size() + (addVectors ? 2 : 0));
+  for (size_t i = 0; i < treeQueue.size(); ++i)
+    basis.col(i) = treeQueue[i]->BasisVector();
+  if (addVectors)
+  {
+    basis.col(treeQueue.size()) = *addBasisVector1;
+    basis.col(treeQueue.size() + 1) = *addBasisVector2;
+  }
+
+  return BasisMonteCarloError(node, basis);
+}
+
+template<typename MatType>
+inline double CosineTree<MatType>::BasisMonteCarloError(
+    CosineTree* node,
+    const DenseMatType& basis)
 {
   std::vector<size_t> sampledIndices;
   VecType probabilities;
@@ -434,50 +491,20 @@ inline double CosineTree<MatType>::MonteCarloError(
   // Get pointer to the original dataset.
   const MatType& dataset = node->GetDataset();
 
-  // Initialize weighted projection magnitudes as zeros.
-  VecType weightedMagnitudes;
-  weightedMagnitudes.zeros(numSamples);
-
-  // Set size of projection vector, depending on whether additional basis
-  // vectors are passed.
-  size_t projectionSize;
-  if (addBasisVector1 && addBasisVector2)
-    projectionSize = treeQueue.size() + 2;
-  else
-    projectionSize = treeQueue.size();
-
   // For each sample, calculate the weighted projection onto the current basis.
+  VecType weightedMagnitudes(numSamples);
+
+  #pragma omp parallel for
   for (size_t i = 0; i < numSamples; ++i)
   {
-    // Initialize projection as a vector of zeros.
-    VecType projection;
-    projection.zeros(projectionSize);
-
-    CosineTree *currentNode;
-    typename CosineNodeQueue<MatType>::const_iterator j = treeQueue.cbegin();
-
-    size_t k = 0;
-    // Compute the projection of the sampled vector onto the existing subspace.
-    for ( ; j != treeQueue.cend(); ++j, ++k)
-    {
-      currentNode = *j;
-
-      projection(k) = dot(dataset.col(sampledIndices[i]),
-                                currentNode->BasisVector());
-    }
-    // If two additional vectors are passed, take their projections.
-    if (addBasisVector1 && addBasisVector2)
+    // Calculate the Frobenius norm squared of the projected vector.
+    double frobProjectionSquared = 0.0;
+    if (basis.n_cols > 0)
     {
-      projection(k++) = dot(dataset.col(sampledIndices[i]),
-                                  *addBasisVector1);
-      projection(k) = dot(dataset.col(sampledIndices[i]),
-                                *addBasisVector2);
+      const VecType projection = basis.t() * dataset.col(sampledIndices[i]);
+      frobProjectionSquared = arma::dot(projection, projection);
     }
 
-    // Calculate the Frobenius norm squared of the projected vector.
-    double frobProjection = arma::norm(projection, "frob");
-    double frobProjectionSquared = frobProjection * frobProjection;
-
     // Calculate the weighted projection magnitude.
     weightedMagnitudes(i) = frobProjectionSquared / probabilities(i);
   }
@@ -659,6 +686,7 @@ inline void CosineTree<MatType>::CalculateCosines(
   // Initialize cosine vector as a vector of zeros.
   cosines.zeros(numColumns);
 
+  #pragma omp parallel for
   for (size_t i = 0; i < numColumns; ++i)
   {
     // If norm is zero, store cosine value as zero. Else, calculate cosine value
@@ -16,6 +16,7 @@
 #include <mlpack/core/math/range.hpp>
 
 #include "../statistic.hpp"
+#include "../node_arena.hpp"
 #include "first_point_is_root.hpp"
 
 namespace mlpack {
@@ -95,7 +96,7 @@ template<typename DistanceType = LMetric<2, true>,
          typename StatisticType = EmptyStatistic,
          typename MatType = arma::mat,
          typename RootPointPolicy = FirstPointIsRoot>
-class CoverTree
+class CoverTree : public ArenaAllocated
 {
  public:
   //! So that other classes can access the matrix type.
@@ -103,6 +104,10 @@ class CoverTree
   //! The type held by the matrix type.
   typedef typename MatType::elem_type ElemType;
 
+  //! The minimum number of distances that are computed in parallel (with
+  //! OpenMP) during tree construction; smaller sets are computed serially.
+  static constexpr size_t ParallelDistanceThreshold = 1024;
+
   /**
    * Create the cover tree with the given dataset and given base.
    * The dataset will not be modified during the building procedure (unlike
@@ -577,6 +582,10 @@ class CoverTree
 
  private:
   size_t distanceComps;
+  //! The arena that the children are allocated from (NULL if the root is a
+  //! leaf, or to allocate the children individually).  If we are the root of
+  //! the tree, we own the arena and must delete it.
+  NodeArena* arena;
 };
 
 } // namespace mlpack
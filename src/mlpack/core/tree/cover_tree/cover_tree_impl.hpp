@@ -54,7 +54,8 @@ CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::CoverTree(
     localDistance(distance == NULL),
     localDataset(false),
     distance(distance),
-    distanceComps(0)
+    distanceComps(0),
+    arena((this->dataset->n_cols > 1) ? new NodeArena() : NULL)
 {
   // If we need to create a distance metric, do that.  We'll just do it on the
   // heap.
@@ -155,7 +156,8 @@ CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::CoverTree(
     localDistance(true),
     localDataset(false),
     distance(new DistanceType(distance)),
-    distanceComps(0)
+    distanceComps(0),
+    arena((this->dataset->n_cols > 1) ? new NodeArena() : NULL)
 {
   // If there is only one point or zero points in the dataset... uh, we're done.
   // Technically, if the dataset has zero points, our node is not correct...
@@ -249,7 +251,8 @@ CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::CoverTree(
     furthestDescendantDistance(0),
     localDistance(true),
     localDataset(true),
-    distanceComps(0)
+    distanceComps(0),
+    arena((this->dataset->n_cols > 1) ? new NodeArena() : NULL)
 {
   // We need to create a distance metric.  We'll just do it on the heap.
   this->distance = new DistanceType();
@@ -348,7 +351,8 @@ CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::CoverTree(
     localDistance(true),
     localDataset(true),
     distance(new DistanceType(distance)),
-    distanceComps(0)
+    distanceComps(0),
+    arena((this->dataset->n_cols > 1) ? new NodeArena() : NULL)
 {
   // If there is only one point or zero points in the dataset... uh, we're done.
   // Technically, if the dataset has zero points, our node is not correct...
@@ -453,7 +457,8 @@ CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::CoverTree(
     localDistance(false),
     localDataset(false),
     distance(&distance),
-    distanceComps(0)
+    distanceComps(0),
+    arena(parent->arena)
 {
   // If the size of the near set is 0, this is a leaf.
   if (nearSetSize == 0)
@@ -494,7 +499,8 @@ CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::CoverTree(
     localDistance(distance == NULL),
     localDataset(false),
     distance(distance),
-    distanceComps(0)
+    distanceComps(0),
+    arena(NULL)
 {
   // If necessary, create a local distance metric.
   if (localDistance)
@@ -523,7 +529,9 @@ CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::CoverTree(
     localDistance(other.localDistance),
     localDataset(other.parent == NULL && other.localDataset),
     distance((other.localDistance ? new DistanceType() : other.distance)),
-    distanceComps(0)
+    distanceComps(0),
+    // Copies allocate their nodes individually.
+    arena(NULL)
 {
   // Copy each child by hand.
   for (size_t i = 0; i < other.NumChildren(); ++i)
@@ -577,6 +585,9 @@ operator=(const CoverTree& other)
     delete children[i];
   children.clear();
 
+  if (!parent)
+    delete arena;
+
   dataset = ((other.parent == NULL && other.localDataset) ?
       new MatType(*other.dataset) : other.dataset);
   point = other.point;
@@ -591,6 +602,7 @@ operator=(const CoverTree& other)
   localDataset = (other.parent == NULL && other.localDataset);
   distance = (other.localDistance ? new DistanceType() : other.distance);
   distanceComps = 0;
+  arena = NULL;
 
   // Copy each child by hand.
   for (size_t i = 0; i < other.NumChildren(); ++i)
@@ -643,7 +655,8 @@ CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::CoverTree(
     localDistance(other.localDistance),
     localDataset(other.localDataset),
     distance(other.distance),
-    distanceComps(other.distanceComps)
+    distanceComps(other.distanceComps),
+    arena(other.arena)
 {
   // Set proper parent pointer.
   for (size_t i = 0; i < children.size(); ++i)
@@ -660,6 +673,7 @@ CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::CoverTree(
   other.localDistance = false;
   other.localDataset = false;
   other.distance = NULL;
+  other.arena = NULL;
 }
 
 // Move assignment operator: take ownership of the given tree.
@@ -686,6 +700,9 @@ operator=(CoverTree&& other)
   for (size_t i = 0; i < children.size(); ++i)
     delete children[i];
 
+  if (!parent)
+    delete arena;
+
   dataset = other.dataset;
   point = other.point;
   children = std::move(other.children);
@@ -700,6 +717,7 @@ operator=(CoverTree&& other)
   localDataset = other.localDataset;
   distance = other.distance;
   distanceComps = other.distanceComps;
+  arena = other.arena;
 
   // Set proper parent pointer.
   for (size_t i = 0; i < children.size(); ++i)
@@ -716,6 +734,7 @@ operator=(CoverTree&& other)
   other.localDistance = false;
   other.localDataset = false;
   other.distance = NULL;
+  other.arena = NULL;
 
   return *this;
 }
@@ -757,6 +776,10 @@ CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::~CoverTree()
   // Delete the local dataset, if necessary.
   if (localDataset)
     delete dataset;
+
+  // If we're the root, delete the arena that held the children.
+  if (!parent)
+    delete arena;
 }
 
 //! Return the number of descendant points.
@@ -1159,15 +1182,15 @@ CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
     // Make the self child at the lowest possible level.
     // This should not modify farSetSize or usedSetSize.
     size_t tempSize = 0;
-    children.push_back(new CoverTree(*dataset, base, point, INT_MIN, this, 0,
-        indices, distances, 0, tempSize, usedSetSize, *distance));
+    children.push_back(new (arena) CoverTree(*dataset, base, point, INT_MIN,
+        this, 0, indices, distances, 0, tempSize, usedSetSize, *distance));
     distanceComps += children.back()->DistanceComps();
 
     // Every point in the near set should be a leaf.
     for (size_t i = 0; i < nearSetSize; ++i)
     {
       // farSetSize and usedSetSize will not be modified.
-      children.push_back(new CoverTree(*dataset, base, indices[i],
+      children.push_back(new (arena) CoverTree(*dataset, base, indices[i],
           INT_MIN, this, distances[i], indices, distances, 0, tempSize,
           usedSetSize, *distance));
       distanceComps += children.back()->DistanceComps();
@@ -1199,9 +1222,9 @@ CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
   // Build the self child (recursively).
   size_t childFarSetSize = nearSetSize - childNearSetSize;
   size_t childUsedSetSize = 0;
-  children.push_back(new CoverTree(*dataset, base, point, nextScale, this, 0,
-      indices, distances, childNearSetSize, childFarSetSize, childUsedSetSize,
-      *distance));
+  children.push_back(new (arena) CoverTree(*dataset, base, point, nextScale,
+      this, 0, indices, distances, childNearSetSize, childFarSetSize,
+      childUsedSetSize, *distance));
   // Don't double-count the self-child (so, subtract one).
   numDescendants += children[0]->NumDescendants();
 
@@ -1257,9 +1280,9 @@ CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
     if ((nearSetSize == 1) && (farSetSize == 0))
     {
       size_t childNearSetSize = 0;
-      children.push_back(new CoverTree(*dataset, base, indices[0], nextScale,
-          this, distances[0], indices, distances, childNearSetSize, farSetSize,
-          usedSetSize, *distance));
+      children.push_back(new (arena) CoverTree(*dataset, base, indices[0],
+          nextScale, this, distances[0], indices, distances, childNearSetSize,
+          farSetSize, usedSetSize, *distance));
       distanceComps += children.back()->DistanceComps();
       numDescendants += children.back()->NumDescendants();
 
@@ -1299,9 +1322,9 @@ CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
 
     // Build this child (recursively).
     childUsedSetSize = 1; // Mark self point as used.
-    children.push_back(new CoverTree(*dataset, base, indices[0], nextScale,
-        this, distances[0], childIndices, childDistances, childNearSetSize,
-        childFarSetSize, childUsedSetSize, *distance));
+    children.push_back(new (arena) CoverTree(*dataset, base, indices[0],
+        nextScale, this, distances[0], childIndices, childDistances,
+        childNearSetSize, childFarSetSize, childUsedSetSize, *distance));
     numDescendants += children.back()->NumDescendants();
 
     // Remove any implicit nodes.
@@ -1396,8 +1419,14 @@ void CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
                      const size_t pointSetSize)
 {
   // For each point, rebuild the distances.  The indices do not need to be
-  // modified.
+  // modified.  The recursion that creates the children is inherently
+  // sequential (each child takes points that its later siblings may not use),
+  // but the distances are independent and are the bulk of the construction
+  // cost, so they are computed in parallel when the point set is large enough
+  // to be worth it.  This does not change the tree that is built.
   distanceComps += pointSetSize;
+  #pragma omp parallel for schedule(static) \
+      if (pointSetSize >= ParallelDistanceThreshold)
   for (size_t i = 0; i < pointSetSize; ++i)
   {
     distances[i] = distance->Evaluate(dataset->col(pointIndex),
@@ -1715,7 +1744,8 @@ CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::CoverTree() :
     localDistance(false),
     localDataset(false),
     distance(NULL),
-    distanceComps(0)
+    distanceComps(0),
+    arena(NULL)
 {
   // Nothing to do.
 }
@@ -1746,8 +1776,11 @@ CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::serialize(
       delete distance;
     if (localDataset && dataset)
       delete dataset;
+    if (!parent)
+      delete arena;
 
     parent = NULL;
+    arena = NULL;
   }
 
   bool hasParent = (parent != NULL);
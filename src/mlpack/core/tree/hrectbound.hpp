@@ -18,6 +18,7 @@
 #include <mlpack/core/math/range.hpp>
 #include <mlpack/core/distances/lmetric.hpp>
 #include "bound_traits.hpp"
+#include "hrectbound_kernels.hpp"
 
 namespace mlpack {
 
@@ -36,6 +37,13 @@ struct IsLMetric<LMetric<Power, TakeRoot>>
   static const bool Value = true;
 };
 
+//! Specialization for IsLMetric when the argument is of type FixedLMetric.
+template<int Power, size_t Dim, bool TakeRoot>
+struct IsLMetric<FixedLMetric<Power, Dim, TakeRoot>>
+{
+  static const bool Value = true;
+};
+
 /**
  * Hyper-rectangle bound for an L-metric.  This should be used in conjunction
  * with the LMetric class.  Be sure to use the same template parameters for
@@ -246,6 +254,9 @@ class HRectBound
   ElemType minWidth;
   //! Instantiated distance metric (likely has size 0).
   DistanceType distance;
+
+  //! The kernels that compute the distances.
+  typedef HRectBoundKernels<DistanceType::Power, ElemType> Kernels;
 };
 
 // A specialization of BoundTraits for this class.
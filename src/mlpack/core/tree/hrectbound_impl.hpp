@@ -190,52 +190,8 @@ inline ElemType HRectBound<DistanceType, ElemType>::MinDistance(
 {
   Log::Assert(point.n_elem == dim);
 
-  ElemType sum = 0;
-
-  ElemType lower, higher;
-  for (size_t d = 0; d < dim; d++)
-  {
-    lower = bounds[d].Lo() - point[d];
-    higher = point[d] - bounds[d].Hi();
-
-    // Since only one of 'lower' or 'higher' is negative, if we add each's
-    // absolute value to itself and then sum those two, our result is the
-    // nonnegative half of the equation times two; then we raise to power Power.
-    if (DistanceType::Power == 1)
-      sum += (lower + std::fabs(lower)) + (higher + std::fabs(higher));
-    else if (DistanceType::Power == 2)
-    {
-      ElemType dist = (lower + std::fabs(lower)) + (higher + std::fabs(higher));
-      sum += dist * dist;
-    }
-    else
-    {
-      sum += std::pow((lower + std::fabs(lower)) + (higher + std::fabs(higher)),
-          (ElemType) DistanceType::Power);
-    }
-  }
-
-  // Now take the Power'th root (but make sure our result is squared if it needs
-  // to be); then cancel out the constant of 2 (which may have been squared now)
-  // that was introduced earlier.  The compiler should optimize out the if
-  // statement entirely.
-  if (DistanceType::Power == 1)
-    return sum * 0.5;
-  else if (DistanceType::Power == 2)
-  {
-    if (DistanceType::TakeRoot)
-      return (ElemType) std::sqrt(sum) * 0.5;
-    else
-      return sum * 0.25;
-  }
-  else
-  {
-    if (DistanceType::TakeRoot)
-      return (ElemType) std::pow((double) sum,
-          1.0 / (double) DistanceType::Power) / 2.0;
-    else
-      return sum / std::pow(2.0, DistanceType::Power);
-  }
+  return Kernels::template Root<DistanceType::TakeRoot>(
+      Kernels::MinDistance(bounds, point, dim));
 }
 
 /**
@@ -247,56 +203,8 @@ ElemType HRectBound<DistanceType, ElemType>::MinDistance(
 {
   Log::Assert(dim == other.dim);
 
-  ElemType sum = 0;
-  const RangeType<ElemType>* mbound = bounds;
-  const RangeType<ElemType>* obound = other.bounds;
-
-  ElemType lower, higher;
-  for (size_t d = 0; d < dim; d++)
-  {
-    lower = obound->Lo() - mbound->Hi();
-    higher = mbound->Lo() - obound->Hi();
-    // We invoke the following:
-    //   x + fabs(x) = max(x * 2, 0)
-    //   (x * 2)^2 / 4 = x^2
-
-    // The compiler should optimize out this if statement entirely.
-    if (DistanceType::Power == 1)
-      sum += (lower + std::fabs(lower)) + (higher + std::fabs(higher));
-    else if (DistanceType::Power == 2)
-    {
-      ElemType dist = (lower + std::fabs(lower)) + (higher + std::fabs(higher));
-      sum += dist * dist;
-    }
-    else
-    {
-      sum += std::pow((lower + std::fabs(lower)) + (higher + std::fabs(higher)),
-          (ElemType) DistanceType::Power);
-    }
-
-    // Move bound pointers.
-    mbound++;
-    obound++;
-  }
-
-  // The compiler should optimize out this if statement entirely.
-  if (DistanceType::Power == 1)
-    return sum * 0.5;
-  else if (DistanceType::Power == 2)
-  {
-    if (DistanceType::TakeRoot)
-      return (ElemType) std::sqrt(sum) * 0.5;
-    else
-      return sum * 0.25;
-  }
-  else
-  {
-    if (DistanceType::TakeRoot)
-      return (ElemType) std::pow((double) sum,
-          1.0 / (double) DistanceType::Power) / 2.0;
-    else
-      return sum / std::pow(2.0, DistanceType::Power);
-  }
+  return Kernels::template Root<DistanceType::TakeRoot>(
+      Kernels::MinDistanceToBound(bounds, other.bounds, dim));
 }
 
 /**
@@ -308,37 +216,10 @@ inline ElemType HRectBound<DistanceType, ElemType>::MaxDistance(
     const VecType& point,
     typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
 {
-  ElemType sum = 0;
-
   Log::Assert(point.n_elem == dim);
 
-  for (size_t d = 0; d < dim; d++)
-  {
-    ElemType v = std::max(fabs(point[d] - bounds[d].Lo()),
-        fabs(bounds[d].Hi() - point[d]));
-
-    // The compiler should optimize out this if statement entirely.
-    if (DistanceType::Power == 1)
-      sum += v; // v is non-negative.
-    else if (DistanceType::Power == 2)
-      sum += v * v;
-    else
-      sum += std::pow(v, (ElemType) DistanceType::Power);
-  }
-
-  // The compiler should optimize out this if statement entirely.
-  if (DistanceType::TakeRoot)
-  {
-    if (DistanceType::Power == 1)
-      return sum;
-    else if (DistanceType::Power == 2)
-      return (ElemType) std::sqrt(sum);
-    else
-      return (ElemType) std::pow((double) sum, 1.0 /
-          (double) DistanceType::Power);
-  }
-  else
-    return sum;
+  return Kernels::template Root<DistanceType::TakeRoot>(
+      Kernels::MaxDistance(bounds, point, dim));
 }
 
 /**
@@ -349,38 +230,10 @@ inline ElemType HRectBound<DistanceType, ElemType>::MaxDistance(
     const HRectBound& other)
     const
 {
-  ElemType sum = 0;
-
   Log::Assert(dim == other.dim);
 
-  ElemType v;
-  for (size_t d = 0; d < dim; d++)
-  {
-    v = std::max(fabs(other.bounds[d].Hi() - bounds[d].Lo()),
-        fabs(bounds[d].Hi() - other.bounds[d].Lo()));
-
-    // The compiler should optimize out this if statement entirely.
-    if (DistanceType::Power == 1)
-      sum += v; // v is non-negative.
-    else if (DistanceType::Power == 2)
-      sum += v * v;
-    else
-      sum += std::pow(v, (ElemType) DistanceType::Power);
-  }
-
-  // The compiler should optimize out this if statement entirely.
-  if (DistanceType::TakeRoot)
-  {
-    if (DistanceType::Power == 1)
-      return sum;
-    else if (DistanceType::Power == 2)
-      return (ElemType) std::sqrt(sum);
-    else
-      return (ElemType) std::pow((double) sum, 1.0 /
-          (double) DistanceType::Power);
-  }
-  else
-    return sum;
+  return Kernels::template Root<DistanceType::TakeRoot>(
+      Kernels::MaxDistanceToBound(bounds, other.bounds, dim));
 }
 
 /**
@@ -391,66 +244,14 @@ inline RangeType<ElemType>
 HRectBound<DistanceType, ElemType>::RangeDistance(
     const HRectBound& other) const
 {
-  ElemType loSum = 0;
-  ElemType hiSum = 0;
-
   Log::Assert(dim == other.dim);
 
-  ElemType v1, v2, vLo, vHi;
-  for (size_t d = 0; d < dim; d++)
-  {
-    v1 = other.bounds[d].Lo() - bounds[d].Hi();
-    v2 = bounds[d].Lo() - other.bounds[d].Hi();
-    // One of v1 or v2 is negative.
-    if (v1 >= v2)
-    {
-      vHi = -v2; // Make it nonnegative.
-      vLo = (v1 > 0) ? v1 : 0; // Force to be 0 if negative.
-    }
-    else
-    {
-      vHi = -v1; // Make it nonnegative.
-      vLo = (v2 > 0) ? v2 : 0; // Force to be 0 if negative.
-    }
-
-    // The compiler should optimize out this if statement entirely.
-    if (DistanceType::Power == 1)
-    {
-      loSum += vLo; // vLo is non-negative.
-      hiSum += vHi; // vHi is non-negative.
-    }
-    else if (DistanceType::Power == 2)
-    {
-      loSum += vLo * vLo;
-      hiSum += vHi * vHi;
-    }
-    else
-    {
-      loSum += std::pow(vLo, (ElemType) DistanceType::Power);
-      hiSum += std::pow(vHi, (ElemType) DistanceType::Power);
-    }
-  }
+  ElemType loSum, hiSum;
+  Kernels::RangeDistanceToBound(bounds, other.bounds, dim, loSum, hiSum);
 
-  if (DistanceType::TakeRoot)
-  {
-    if (DistanceType::Power == 1)
-      return RangeType<ElemType>(loSum, hiSum);
-    else if (DistanceType::Power == 2)
-      return RangeType<ElemType>((ElemType) std::sqrt(loSum),
-                                       (ElemType) std::sqrt(hiSum));
-    else
-    {
-      return RangeType<ElemType>(
-          (ElemType) std::pow((double) loSum,
-              1.0 / (double) DistanceType::Power),
-          (ElemType) std::pow((double) hiSum,
-              1.0 / (double) DistanceType::Power));
-    }
-  }
-  else
-  {
-    return RangeType<ElemType>(loSum, hiSum);
-  }
+  return RangeType<ElemType>(
+      Kernels::template Root<DistanceType::TakeRoot>(loSum),
+      Kernels::template Root<DistanceType::TakeRoot>(hiSum));
 }
 
 /**
@@ -463,72 +264,14 @@ HRectBound<DistanceType, ElemType>::RangeDistance(
     const VecType& point,
     typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
 {
-  ElemType loSum = 0;
-  ElemType hiSum = 0;
-
   Log::Assert(point.n_elem == dim);
 
-  ElemType v1, v2, vLo, vHi;
-  for (size_t d = 0; d < dim; d++)
-  {
-    v1 = bounds[d].Lo() - point[d]; // Negative if point[d] > lo.
-    v2 = point[d] - bounds[d].Hi(); // Negative if point[d] < hi.
-    // One of v1 or v2 (or both) is negative.
-    if (v1 >= 0) // point[d] <= bounds_[d].Lo().
-    {
-      vHi = -v2; // v2 will be larger but must be negated.
-      vLo = v1;
-    }
-    else // point[d] is between lo and hi, or greater than hi.
-    {
-      if (v2 >= 0)
-      {
-        vHi = -v1; // v1 will be larger, but must be negated.
-        vLo = v2;
-      }
-      else
-      {
-        vHi = -std::min(v1, v2); // Both are negative, but we need the larger.
-        vLo = 0;
-      }
-    }
-
-    // The compiler should optimize out this if statement entirely.
-    if (DistanceType::Power == 1)
-    {
-      loSum += vLo; // vLo is non-negative.
-      hiSum += vHi; // vHi is non-negative.
-    }
-    else if (DistanceType::Power == 2)
-    {
-      loSum += vLo * vLo;
-      hiSum += vHi * vHi;
-    }
-    else
-    {
-      loSum += std::pow(vLo, (ElemType) DistanceType::Power);
-      hiSum += std::pow(vHi, (ElemType) DistanceType::Power);
-    }
-  }
+  ElemType loSum, hiSum;
+  Kernels::RangeDistance(bounds, point, dim, loSum, hiSum);
 
-  if (DistanceType::TakeRoot)
-  {
-    if (DistanceType::Power == 1)
-      return RangeType<ElemType>(loSum, hiSum);
-    else if (DistanceType::Power == 2)
-      return RangeType<ElemType>((ElemType) std::sqrt(loSum),
-                                 (ElemType) std::sqrt(hiSum));
-    else
-    {
-      return RangeType<ElemType>(
-          (ElemType) std::pow((double) loSum,
-              1.0 / (double) DistanceType::Power),
-          (ElemType) std::pow((double) hiSum,
-              1.0 / (double) DistanceType::Power));
-    }
-  }
-  else
-    return RangeType<ElemType>(loSum, hiSum);
+  return RangeType<ElemType>(
+      Kernels::template Root<DistanceType::TakeRoot>(loSum),
+      Kernels::template Root<DistanceType::TakeRoot>(hiSum));
 }
 
 /**
@@ -0,0 +1,226 @@
+/**
+ * @file core/tree/hrectbound_kernels.hpp
+ *
+ * Branch-free kernels for the distance computations of HRectBound.  Each
+ * kernel sums a per-dimension term over all dimensions of the bound; the loops
+ * have no data-dependent branches, so that the compiler can vectorize them
+ * (with SSE, AVX2 or AVX-512, depending on the target architecture), and for
+ * low dimensionalities the number of dimensions is a compile-time constant, so
+ * that the loops can be fully unrolled.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_HRECTBOUND_KERNELS_HPP
+#define MLPACK_CORE_TREE_HRECTBOUND_KERNELS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/range.hpp>
+
+namespace mlpack {
+
+/**
+ * The distance kernels used by HRectBound<LMetric<Power, TakeRoot>, ElemType>.
+ * Every function returns the sum over all dimensions of the Power'th power of
+ * the per-dimension distance; taking the root is left to the caller.  For
+ * Power = 1 and Power = 2 the per-dimension terms are computed with min(),
+ * max() and fabs() only.
+ *
+ * @tparam Power Power of the LMetric.
+ * @tparam ElemType Element type of the bound.
+ */
+template<int Power, typename ElemType>
+class HRectBoundKernels
+{
+ public:
+  //! Dimensionalities up to this one are handled by loops with a compile-time
+  //! trip count.
+  static constexpr size_t MaxFixedDim = 16;
+
+  //! Sum of the minimum distances between the bound and the point.
+  template<typename VecType>
+  static ElemType MinDistance(const RangeType<ElemType>* bounds,
+                              const VecType& point,
+                              const size_t dim)
+  {
+    return Sum(dim, [&](const size_t d)
+    {
+      const ElemType lower = bounds[d].Lo() - point[d];
+      const ElemType higher = point[d] - bounds[d].Hi();
+      // At most one of lower and higher is positive.
+      return Pow(std::max(lower, ElemType(0)) + std::max(higher, ElemType(0)));
+    });
+  }
+
+  //! Sum of the minimum distances between the two bounds.
+  static ElemType MinDistanceToBound(const RangeType<ElemType>* bounds,
+                                     const RangeType<ElemType>* otherBounds,
+                                     const size_t dim)
+  {
+    return Sum(dim, [&](const size_t d)
+    {
+      const ElemType lower = otherBounds[d].Lo() - bounds[d].Hi();
+      const ElemType higher = bounds[d].Lo() - otherBounds[d].Hi();
+      return Pow(std::max(lower, ElemType(0)) + std::max(higher, ElemType(0)));
+    });
+  }
+
+  //! Sum of the maximum distances between the bound and the point.
+  template<typename VecType>
+  static ElemType MaxDistance(const RangeType<ElemType>* bounds,
+                              const VecType& point,
+                              const size_t dim)
+  {
+    return Sum(dim, [&](const size_t d)
+    {
+      return Pow(std::max(std::fabs(point[d] - bounds[d].Lo()),
+          std::fabs(bounds[d].Hi() - point[d])));
+    });
+  }
+
+  //! Sum of the maximum distances between the two bounds.
+  static ElemType MaxDistanceToBound(const RangeType<ElemType>* bounds,
+                                     const RangeType<ElemType>* otherBounds,
+                                     const size_t dim)
+  {
+    return Sum(dim, [&](const size_t d)
+    {
+      return Pow(std::max(std::fabs(otherBounds[d].Hi() - bounds[d].Lo()),
+          std::fabs(bounds[d].Hi() - otherBounds[d].Lo())));
+    });
+  }
+
+  //! Sums of the minimum and maximum distances between the bound and the
+  //! point.
+  template<typename VecType>
+  static void RangeDistance(const RangeType<ElemType>* bounds,
+                            const VecType& point,
+                            const size_t dim,
+                            ElemType& loSum,
+                            ElemType& hiSum)
+  {
+    SumRange(dim, [&](const size_t d, ElemType& lo, ElemType& hi)
+    {
+      const ElemType v1 = bounds[d].Lo() - point[d];
+      const ElemType v2 = point[d] - bounds[d].Hi();
+      // At least one of v1 and v2 is negative.
+      lo = Pow(std::max(std::max(v1, v2), ElemType(0)));
+      hi = Pow(-std::min(v1, v2));
+    }, loSum, hiSum);
+  }
+
+  //! Sums of the minimum and maximum distances between the two bounds.
+  static void RangeDistanceToBound(const RangeType<ElemType>* bounds,
+                                   const RangeType<ElemType>* otherBounds,
+                                   const size_t dim,
+                                   ElemType& loSum,
+                                   ElemType& hiSum)
+  {
+    SumRange(dim, [&](const size_t d, ElemType& lo, ElemType& hi)
+    {
+      const ElemType v1 = otherBounds[d].Lo() - bounds[d].Hi();
+      const ElemType v2 = bounds[d].Lo() - otherBounds[d].Hi();
+      lo = Pow(std::max(std::max(v1, v2), ElemType(0)));
+      hi = Pow(-std::min(v1, v2));
+    }, loSum, hiSum);
+  }
+
+  //! Turn a sum returned by one of the kernels into a distance, by taking the
+  //! Power'th root if TakeRoot is true.
+  template<bool TakeRoot>
+  static ElemType Root(const ElemType sum)
+  {
+    if (!TakeRoot || Power == 1)
+      return sum;
+    else if (Power == 2)
+      return (ElemType) std::sqrt(sum);
+    else
+      return (ElemType) std::pow((double) sum, 1.0 / (double) Power);
+  }
+
+ private:
+  //! Raise the given non-negative value to the Power'th power.
+  static ElemType Pow(const ElemType v)
+  {
+    if (Power == 1)
+      return v;
+    else if (Power == 2)
+      return v * v;
+    else
+      return std::pow(v, (ElemType) Power);
+  }
+
+  //! Sum the given term over the first FixedDim dimensions, or over the first
+  //! dim dimensions if FixedDim is 0.
+  template<size_t FixedDim, typename TermType>
+  static ElemType SumFixed(const size_t dim, const TermType& term)
+  {
+    const size_t n = (FixedDim == 0) ? dim : FixedDim;
+    ElemType sum = 0;
+
+    #pragma omp simd reduction(+:sum)
+    for (size_t d = 0; d < n; ++d)
+      sum += term(d);
+
+    return sum;
+  }
+
+  //! Sum both terms over the first FixedDim dimensions, or over the first dim
+  //! dimensions if FixedDim is 0.
+  template<size_t FixedDim, typename TermType>
+  static void SumRangeFixed(const size_t dim,
+                            const TermType& term,
+                            ElemType& loSum,
+                            ElemType& hiSum)
+  {
+    const size_t n = (FixedDim == 0) ? dim : FixedDim;
+    ElemType lo = 0, hi = 0;
+
+    #pragma omp simd reduction(+:lo, hi)
+    for (size_t d = 0; d < n; ++d)
+    {
+      ElemType loTerm, hiTerm;
+      term(d, loTerm, hiTerm);
+      lo += loTerm;
+      hi += hiTerm;
+    }
+
+    loSum = lo;
+    hiSum = hi;
+  }
+
+  //! Sum the given term over all dimensions, choosing the loop with a
+  //! compile-time trip count if there is one for dim.
+  template<typename TermType, size_t FixedDim = 1>
+  static ElemType Sum(const size_t dim, const TermType& term)
+  {
+    if constexpr (FixedDim > MaxFixedDim)
+      return SumFixed<0>(dim, term);
+    else if (dim == FixedDim)
+      return SumFixed<FixedDim>(dim, term);
+    else
+      return Sum<TermType, FixedDim + 1>(dim, term);
+  }
+
+  //! Sum both terms over all dimensions, choosing the loop with a compile-time
+  //! trip count if there is one for dim.
+  template<typename TermType, size_t FixedDim = 1>
+  static void SumRange(const size_t dim,
+                       const TermType& term,
+                       ElemType& loSum,
+                       ElemType& hiSum)
+  {
+    if constexpr (FixedDim > MaxFixedDim)
+      SumRangeFixed<0>(dim, term, loSum, hiSum);
+    else if (dim == FixedDim)
+      SumRangeFixed<FixedDim>(dim, term, loSum, hiSum);
+    else
+      SumRange<TermType, FixedDim + 1>(dim, term, loSum, hiSum);
+  }
+};
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,44 @@
+/**
+ * @file core/tree/leaf_base_case.hpp
+ *
+ * A utility to detect whether a RuleType provides the optional batched leaf
+ * base case, LeafBaseCase().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_LEAF_BASE_CASE_HPP
+#define MLPACK_CORE_TREE_LEAF_BASE_CASE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * HasLeafBaseCase<RuleType, TreeType>::value is true if RuleType has a method
+ *
+ * @code
+ * void LeafBaseCase(const std::vector<size_t>& queryIndices,
+ *                   TreeType& referenceNode);
+ * @endcode
+ *
+ * which must have the same effect as calling BaseCase(q, r) for every query
+ * point q in queryIndices and every point r held in the reference leaf, in
+ * that order.  Traversers that support it call it once per leaf-leaf
+ * combination (after the query points that can be pruned have been removed),
+ * so that the rules can compute the whole block of distances at once.
+ */
+template<typename RuleType, typename TreeType, typename = void>
+struct HasLeafBaseCase : std::false_type { };
+
+template<typename RuleType, typename TreeType>
+struct HasLeafBaseCase<RuleType, TreeType, std::void_t<decltype(
+    std::declval<RuleType&>().LeafBaseCase(
+        std::declval<const std::vector<size_t>&>(),
+        std::declval<TreeType&>()))>> : std::true_type { };
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,135 @@
+/**
+ * @file core/tree/node_arena.hpp
+ *
+ * Definition of NodeArena, which hands out the memory for the nodes of a tree
+ * from large contiguous slabs and frees it all at once, and ArenaAllocated, a
+ * base class that lets a tree node type be allocated from a NodeArena.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_NODE_ARENA_HPP
+#define MLPACK_CORE_TREE_NODE_ARENA_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mutex>
+
+namespace mlpack {
+
+/**
+ * A simple arena for tree nodes.  Memory is taken from slabs whose size doubles
+ * from minSlabSize up to maxSlabSize, so that building a tree with many nodes
+ * needs only a few calls to the system allocator and the nodes end up close to
+ * each other in memory.  Memory is never given back to the arena; all slabs are
+ * freed when the arena is destroyed.
+ *
+ * Allocate() may be called from several threads at once.  The slabs are counted
+ * by util::MemoryUsage when memory is tracked.
+ *
+ * The trees use this through ArenaAllocated: the root of the tree owns the
+ * arena, and the destructor of each node only calls the destructors of its
+ * children, without freeing their memory.
+ */
+class NodeArena
+{
+ public:
+  /**
+   * Create an empty arena.  No memory is allocated until the first call to
+   * Allocate().
+   *
+   * @param minSlabSize Size of the first slab, in bytes.
+   * @param maxSlabSize Maximum size of a slab, in bytes (larger allocations
+   *     still get a slab of their own).
+   */
+  NodeArena(const size_t minSlabSize = 65536,
+            const size_t maxSlabSize = 4194304);
+
+  //! Free all slabs.  Anything allocated from the arena is invalidated.
+  ~NodeArena();
+
+  // An arena can't be copied.
+  NodeArena(const NodeArena&) = delete;
+  NodeArena& operator=(const NodeArena&) = delete;
+
+  /**
+   * Allocate the given number of bytes, aligned like std::max_align_t.
+   *
+   * @param size Number of bytes to allocate.
+   */
+  void* Allocate(const size_t size);
+
+  //! Get the number of slabs that have been allocated.
+  size_t NumSlabs() const { return slabs.size(); }
+  //! Get the number of bytes that have been handed out.
+  size_t BytesAllocated() const { return bytesAllocated; }
+
+ private:
+  //! The slabs.
+  std::vector<char*> slabs;
+  //! The next free byte in the last slab.
+  char* next;
+  //! The number of free bytes in the last slab.
+  size_t remaining;
+  //! The size of the next slab.
+  size_t nextSlabSize;
+  //! The maximum size of a slab.
+  size_t maxSlabSize;
+  //! The number of bytes that have been handed out.
+  size_t bytesAllocated;
+  //! The total size of the slabs.
+  size_t slabMemory;
+  //! The lock held while allocating.
+  std::mutex mutex;
+};
+
+/**
+ * A base class for tree nodes that may be allocated from a NodeArena.  It adds
+ * no members to the node; instead, every allocation of the derived type is
+ * prefixed with a pointer to the arena it came from (or NULL for nodes that
+ * were allocated with plain new).  This means that any node can still be
+ * deleted with delete: nodes from the heap are freed, and nodes from an arena
+ * are only destroyed, since their memory belongs to the arena.
+ *
+ * To allocate a node from an arena, use
+ *
+ * @code
+ * TreeType* node = new (arena) TreeType(...);
+ * @endcode
+ *
+ * where arena is a NodeArena* (if it is NULL, the node comes from the heap).
+ * The arena must outlive the nodes allocated from it.
+ */
+class ArenaAllocated
+{
+ public:
+  //! Allocate an object from the heap.
+  static void* operator new(const size_t size);
+  //! Allocate an object from the given arena (or the heap, if arena is NULL).
+  static void* operator new(const size_t size, NodeArena* arena);
+  //! Placement new, which still constructs an object at the given address.
+  static void* operator new(const size_t /* size */, void* ptr) { return ptr; }
+
+  //! Free an object, if it was allocated from the heap.
+  static void operator delete(void* ptr);
+  //! Free an object whose constructor threw.
+  static void operator delete(void* ptr, NodeArena* /* arena */);
+  //! Placement delete, which does nothing.
+  static void operator delete(void* /* ptr */, void* /* place */) { }
+
+ private:
+  //! The size of the prefix that holds the arena pointer and the size of the
+  //! allocation (for util::MemoryUsage); this keeps the object aligned like
+  //! std::max_align_t.
+  static constexpr size_t HeaderSize =
+      ((sizeof(NodeArena*) + sizeof(size_t) + alignof(std::max_align_t) - 1) /
+      alignof(std::max_align_t)) * alignof(std::max_align_t);
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "node_arena_impl.hpp"
+
+#endif
@@ -0,0 +1,106 @@
+/**
+ * @file core/tree/node_arena_impl.hpp
+ *
+ * Implementation of NodeArena and ArenaAllocated.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_NODE_ARENA_IMPL_HPP
+#define MLPACK_CORE_TREE_NODE_ARENA_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "node_arena.hpp"
+
+namespace mlpack {
+
+inline NodeArena::NodeArena(const size_t minSlabSize,
+                            const size_t maxSlabSize) :
+    next(NULL),
+    remaining(0),
+    nextSlabSize(minSlabSize),
+    maxSlabSize(std::max(minSlabSize, maxSlabSize)),
+    bytesAllocated(0),
+    slabMemory(0)
+{
+  // Nothing to do.
+}
+
+inline NodeArena::~NodeArena()
+{
+  for (size_t i = 0; i < slabs.size(); ++i)
+    ::operator delete(slabs[i]);
+
+  util::MemoryUsage::Freed(slabMemory);
+}
+
+inline void* NodeArena::Allocate(const size_t size)
+{
+  // Keep every allocation aligned.
+  const size_t alignment = alignof(std::max_align_t);
+  const size_t alignedSize = ((size + alignment - 1) / alignment) * alignment;
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  if (alignedSize > remaining)
+  {
+    const size_t slabSize = std::max(nextSlabSize, alignedSize);
+    next = (char*) ::operator new(slabSize);
+    slabs.push_back(next);
+    slabMemory += slabSize;
+    util::MemoryUsage::Allocated(slabSize);
+    remaining = slabSize;
+    nextSlabSize = std::min(2 * nextSlabSize, maxSlabSize);
+  }
+
+  void* result = next;
+  next += alignedSize;
+  remaining -= alignedSize;
+  bytesAllocated += alignedSize;
+
+  return result;
+}
+
+inline void* ArenaAllocated::operator new(const size_t size)
+{
+  char* memory = (char*) ::operator new(HeaderSize + size);
+  *((NodeArena**) memory) = NULL;
+  *((size_t*) (memory + sizeof(NodeArena*))) = HeaderSize + size;
+  util::MemoryUsage::Allocated(HeaderSize + size);
+  return memory + HeaderSize;
+}
+
+inline void* ArenaAllocated::operator new(const size_t size, NodeArena* arena)
+{
+  if (!arena)
+    return operator new(size);
+
+  char* memory = (char*) arena->Allocate(HeaderSize + size);
+  *((NodeArena**) memory) = arena;
+  return memory + HeaderSize;
+}
+
+inline void ArenaAllocated::operator delete(void* ptr)
+{
+  if (!ptr)
+    return;
+
+  // Memory from an arena is freed along with the arena.
+  char* memory = ((char*) ptr) - HeaderSize;
+  if (*((NodeArena**) memory) == NULL)
+  {
+    util::MemoryUsage::Freed(*((size_t*) (memory + sizeof(NodeArena*))));
+    ::operator delete(memory);
+  }
+}
+
+inline void ArenaAllocated::operator delete(void* ptr, NodeArena* /* arena */)
+{
+  operator delete(ptr);
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,164 @@
+/**
+ * @file core/tree/octree/morton_code.hpp
+ *
+ * Utilities to compute the Morton codes (Z-order codes) of the points of a
+ * dataset and to radix sort them in parallel.  These are used by the
+ * Morton-code build of the Octree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_OCTREE_MORTON_CODE_HPP
+#define MLPACK_CORE_TREE_OCTREE_MORTON_CODE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+
+/**
+ * An empty tag type that selects the Morton-code build of the Octree: pass
+ * MortonBuild() to the Octree constructor instead of building the tree by
+ * splitting one node at a time.
+ */
+struct MortonBuild { };
+
+/**
+ * Compute the Morton code of every point in the given dataset.  The cube
+ * [lo, lo + width]^d is divided into 2^bitsPerDim cells along each dimension,
+ * and the cell coordinates of each point are interleaved so that the most
+ * significant d bits of the code give the child of the root cube that the point
+ * falls into, the next d bits give the child of that cube, and so on.  Bit j of
+ * each group of d bits corresponds to dimension j.  Points outside of the cube
+ * are clamped to the cells on its border.
+ *
+ * bitsPerDim * data.n_rows must be at most 64, and bitsPerDim must be at most
+ * 32.
+ *
+ * @param data Dataset to compute the codes of.
+ * @param lo Lower corner of the cube.
+ * @param width Width of the cube (in every dimension).
+ * @param bitsPerDim Number of bits to use for each dimension.
+ * @param codes Vector to store the codes in.
+ */
+template<typename MatType>
+void MortonCodes(const MatType& data,
+                 const arma::vec& lo,
+                 const double width,
+                 const size_t bitsPerDim,
+                 std::vector<uint64_t>& codes)
+{
+  const size_t dims = data.n_rows;
+  const uint64_t maxCell = ((uint64_t) 1 << bitsPerDim) - 1;
+  const double scale = (width > 0.0) ?
+      std::ldexp(1.0, (int) bitsPerDim) / width : 0.0;
+
+  codes.resize(data.n_cols);
+
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    uint64_t code = 0;
+    for (size_t d = 0; d < dims; ++d)
+    {
+      const double pos = std::floor((data(d, i) - lo[d]) * scale);
+      const uint64_t cell = (pos <= 0.0) ? 0 :
+          (pos >= (double) maxCell) ? maxCell : (uint64_t) pos;
+
+      // Spread the bits of the cell coordinate out over the code.
+      for (size_t b = 0; b < bitsPerDim; ++b)
+        code |= ((cell >> b) & 1) << (b * dims + d);
+    }
+
+    codes[i] = code;
+  }
+}
+
+/**
+ * Sort the given Morton codes with a least-significant-digit radix sort, and
+ * apply the same permutation to the given order.  Each pass sorts 8 bits; the
+ * histograms and the scatter of each pass are computed in parallel, with one
+ * contiguous block of the codes per OpenMP thread, so that the sort is stable.
+ *
+ * @param codes Codes to sort.
+ * @param order Vector of the same length as codes, permuted along with it.
+ * @param numBits Number of low bits of the codes that may be nonzero.
+ */
+inline void MortonRadixSort(std::vector<uint64_t>& codes,
+                            std::vector<size_t>& order,
+                            const size_t numBits)
+{
+  const size_t n = codes.size();
+  if (n < 2)
+    return;
+
+  size_t maxThreads = 1;
+  #ifdef MLPACK_USE_OPENMP
+  maxThreads = (size_t) omp_get_max_threads();
+  #endif
+
+  std::vector<uint64_t> tmpCodes(n);
+  std::vector<size_t> tmpOrder(n);
+  // counts[t * 256 + digit] holds the number of codes with the given digit in
+  // the block of thread t, and then the position the thread writes the next
+  // such code to.
+  std::vector<size_t> counts(maxThreads * 256);
+
+  for (size_t shift = 0; shift < numBits; shift += 8)
+  {
+    std::fill(counts.begin(), counts.end(), 0);
+
+    #pragma omp parallel num_threads(maxThreads)
+    {
+      size_t thread = 0;
+      size_t numThreads = 1;
+      #ifdef MLPACK_USE_OPENMP
+      thread = (size_t) omp_get_thread_num();
+      numThreads = (size_t) omp_get_num_threads();
+      #endif
+
+      const size_t blockBegin = (thread * n) / numThreads;
+      const size_t blockEnd = ((thread + 1) * n) / numThreads;
+      size_t* threadCounts = counts.data() + thread * 256;
+
+      for (size_t i = blockBegin; i < blockEnd; ++i)
+        ++threadCounts[(codes[i] >> shift) & 255];
+
+      // Turn the counts into output positions: all codes with a smaller digit
+      // come first, then the codes with the same digit in earlier blocks.
+      #pragma omp barrier
+      #pragma omp single
+      {
+        size_t position = 0;
+        for (size_t digit = 0; digit < 256; ++digit)
+        {
+          for (size_t t = 0; t < numThreads; ++t)
+          {
+            const size_t c = counts[t * 256 + digit];
+            counts[t * 256 + digit] = position;
+            position += c;
+          }
+        }
+      }
+
+      for (size_t i = blockBegin; i < blockEnd; ++i)
+      {
+        const size_t position = threadCounts[(codes[i] >> shift) & 255]++;
+        tmpCodes[position] = codes[i];
+        tmpOrder[position] = order[i];
+      }
+    }
+
+    codes.swap(tmpCodes);
+    order.swap(tmpOrder);
+  }
+}
+
+} // namespace mlpack
+
+#endif
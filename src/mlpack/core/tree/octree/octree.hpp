@@ -15,6 +15,7 @@
 #include <mlpack/prereqs.hpp>
 #include "../hrectbound.hpp"
 #include "../statistic.hpp"
+#include "morton_code.hpp"
 
 namespace mlpack {
 
@@ -37,6 +38,10 @@ class Octree
   template<typename RuleType>
   class DualTreeTraverser;
 
+  //! Nodes with at least this many points build their children in separate
+  //! OpenMP tasks during a Morton-code build.
+  static constexpr size_t ParallelBuildMinCount = 4096;
+
  private:
   //! The children held by this node.
   std::vector<Octree*> children;
@@ -156,6 +161,75 @@ class Octree
          std::vector<size_t>& newFromOld,
          const size_t maxLeafSize = 20);
 
+  /**
+   * Construct this as the root node of an octree on the given dataset, using
+   * the Morton-code build: the Morton code of every point is computed in
+   * parallel, the codes are radix sorted, and the structure of the tree is
+   * derived from the sorted codes, building large subtrees in separate OpenMP
+   * tasks.  This copies the dataset and modifies its ordering.
+   *
+   * The resulting tree has the same shape as the tree built by the other
+   * constructors, except that the cells are resolved to a finite precision:
+   * points that lie (almost) exactly on the boundary between two cells may be
+   * assigned to the other cell, and nodes at depth min(32, 64 / d) are always
+   * leaves, where d is the dimensionality of the data (which can be at most
+   * 64).
+   *
+   * @param data Dataset to create tree from.  This will be copied!
+   * @param build An instance of MortonBuild, to select this constructor.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(const MatType& data,
+         const MortonBuild& build,
+         const size_t maxLeafSize = 20);
+
+  /**
+   * Construct this as the root node of an octree on the given dataset, using
+   * the Morton-code build (see above).  This copies the dataset and modifies
+   * its ordering; a mapping of the old point indices to the new point indices
+   * is filled.
+   *
+   * @param data Dataset to create tree from.  This will be copied!
+   * @param build An instance of MortonBuild, to select this constructor.
+   * @param oldFromNew Vector which will be filled with the old positions for
+   *      each new point.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(const MatType& data,
+         const MortonBuild& build,
+         std::vector<size_t>& oldFromNew,
+         const size_t maxLeafSize = 20);
+
+  /**
+   * Construct this as the root node of an octree on the given dataset, using
+   * the Morton-code build (see above).  This will take ownership of the
+   * dataset.
+   *
+   * @param data Dataset to create tree from.
+   * @param build An instance of MortonBuild, to select this constructor.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(MatType&& data,
+         const MortonBuild& build,
+         const size_t maxLeafSize = 20);
+
+  /**
+   * Construct this as the root node of an octree on the given dataset, using
+   * the Morton-code build (see above).  This will take ownership of the
+   * dataset and modifies its ordering; a mapping of the old point indices to
+   * the new point indices is filled.
+   *
+   * @param data Dataset to create tree from.
+   * @param build An instance of MortonBuild, to select this constructor.
+   * @param oldFromNew Vector which will be filled with the old positions for
+   *      each new point.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(MatType&& data,
+         const MortonBuild& build,
+         std::vector<size_t>& oldFromNew,
+         const size_t maxLeafSize = 20);
+
   /**
    * Construct this node as a child of the given parent, starting at column
    * begin and using count points.  The ordering of that subset of points in the
@@ -442,6 +516,54 @@ class Octree
                  std::vector<size_t>& oldFromNew,
                  const size_t maxLeafSize);
 
+  /**
+   * Construct this node as a child of the given parent during a Morton-code
+   * build, holding the points from column begin to column (begin + count - 1),
+   * which must already be sorted by their Morton codes.
+   *
+   * @param parent Parent of this node.
+   * @param begin Index of the first point held in this node.
+   * @param count Number of points held in this node.
+   * @param codes Sorted Morton codes of all points in the dataset.
+   * @param level Depth of this node in the tree (the root has depth 0).
+   * @param bitsPerDim Number of bits per dimension in the Morton codes.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(Octree* parent,
+         const size_t begin,
+         const size_t count,
+         const std::vector<uint64_t>& codes,
+         const size_t level,
+         const size_t bitsPerDim,
+         const size_t maxLeafSize);
+
+  /**
+   * Build the tree below the root with the Morton-code build: compute and sort
+   * the Morton codes, reorder the dataset, and create the children.  The bound
+   * and the statistic of the root are also set.
+   *
+   * @param oldFromNew Vector which will be filled with the old positions for
+   *      each new point.
+   * @param maxLeafSize Maximum number of points allowed in a leaf.
+   */
+  void MortonBuildTree(std::vector<size_t>& oldFromNew,
+                       const size_t maxLeafSize);
+
+  /**
+   * Create the children of this node during a Morton-code build.  There is one
+   * child for each distinct group of bits in the codes of this node at the
+   * given level.  Large nodes build their children in separate OpenMP tasks.
+   *
+   * @param codes Sorted Morton codes of all points in the dataset.
+   * @param level Depth of this node in the tree.
+   * @param bitsPerDim Number of bits per dimension in the Morton codes.
+   * @param maxLeafSize Maximum number of points allowed in a leaf.
+   */
+  void MortonSplitNode(const std::vector<uint64_t>& codes,
+                       const size_t level,
+                       const size_t bitsPerDim,
+                       const size_t maxLeafSize);
+
   /**
    * This is used for sorting points while splitting.
    */
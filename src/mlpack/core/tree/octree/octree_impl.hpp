@@ -270,6 +270,74 @@ Octree<DistanceType, StatisticType, MatType>::Octree(
     newFromOld[oldFromNew[i]] = i;
 }
 
+//! Construct the tree with the Morton-code build.
+template<typename DistanceType, typename StatisticType, typename MatType>
+Octree<DistanceType, StatisticType, MatType>::Octree(
+    const MatType& dataset,
+    const MortonBuild& /* build */,
+    const size_t maxLeafSize) :
+    begin(0),
+    count(dataset.n_cols),
+    bound(dataset.n_rows),
+    dataset(new MatType(dataset)),
+    parent(NULL),
+    parentDistance(0.0)
+{
+  std::vector<size_t> oldFromNew;
+  MortonBuildTree(oldFromNew, maxLeafSize);
+}
+
+//! Construct the tree with the Morton-code build.
+template<typename DistanceType, typename StatisticType, typename MatType>
+Octree<DistanceType, StatisticType, MatType>::Octree(
+    const MatType& dataset,
+    const MortonBuild& /* build */,
+    std::vector<size_t>& oldFromNew,
+    const size_t maxLeafSize) :
+    begin(0),
+    count(dataset.n_cols),
+    bound(dataset.n_rows),
+    dataset(new MatType(dataset)),
+    parent(NULL),
+    parentDistance(0.0)
+{
+  MortonBuildTree(oldFromNew, maxLeafSize);
+}
+
+//! Construct the tree with the Morton-code build.
+template<typename DistanceType, typename StatisticType, typename MatType>
+Octree<DistanceType, StatisticType, MatType>::Octree(
+    MatType&& dataset,
+    const MortonBuild& /* build */,
+    const size_t maxLeafSize) :
+    begin(0),
+    count(dataset.n_cols),
+    bound(dataset.n_rows),
+    dataset(new MatType(std::move(dataset))),
+    parent(NULL),
+    parentDistance(0.0)
+{
+  std::vector<size_t> oldFromNew;
+  MortonBuildTree(oldFromNew, maxLeafSize);
+}
+
+//! Construct the tree with the Morton-code build.
+template<typename DistanceType, typename StatisticType, typename MatType>
+Octree<DistanceType, StatisticType, MatType>::Octree(
+    MatType&& dataset,
+    const MortonBuild& /* build */,
+    std::vector<size_t>& oldFromNew,
+    const size_t maxLeafSize) :
+    begin(0),
+    count(dataset.n_cols),
+    bound(dataset.n_rows),
+    dataset(new MatType(std::move(dataset))),
+    parent(NULL),
+    parentDistance(0.0)
+{
+  MortonBuildTree(oldFromNew, maxLeafSize);
+}
+
 //! Construct a child node.
 template<typename DistanceType, typename StatisticType, typename MatType>
 Octree<DistanceType, StatisticType, MatType>::Octree(
@@ -339,6 +407,41 @@ Octree<DistanceType, StatisticType, MatType>::Octree(
   stat = StatisticType(*this);
 }
 
+//! Construct a child node during a Morton-code build.
+template<typename DistanceType, typename StatisticType, typename MatType>
+Octree<DistanceType, StatisticType, MatType>::Octree(
+    Octree* parent,
+    const size_t begin,
+    const size_t count,
+    const std::vector<uint64_t>& codes,
+    const size_t level,
+    const size_t bitsPerDim,
+    const size_t maxLeafSize) :
+    begin(begin),
+    count(count),
+    bound(parent->dataset->n_rows),
+    dataset(parent->dataset),
+    parent(parent)
+{
+  // Calculate empirical center of data.
+  bound |= dataset->cols(begin, begin + count - 1);
+
+  // Now create the children.
+  MortonSplitNode(codes, level, bitsPerDim, maxLeafSize);
+
+  // Calculate the distance from the empirical center of this node to the
+  // empirical center of the parent.
+  arma::vec trueCenter, parentCenter;
+  bound.Center(trueCenter);
+  parent->Bound().Center(parentCenter);
+  parentDistance = distance.Evaluate(trueCenter, parentCenter);
+
+  furthestDescendantDistance = 0.5 * bound.Diameter();
+
+  // Initialize the statistic.
+  stat = StatisticType(*this);
+}
+
 //! Copy the given tree.
 template<typename DistanceType, typename StatisticType, typename MatType>
 Octree<DistanceType, StatisticType, MatType>::Octree(const Octree& other) :
@@ -972,6 +1075,154 @@ void Octree<DistanceType, StatisticType, MatType>::SplitNode(
   }
 }
 
+//! Build the tree from the Morton codes of the points.
+template<typename DistanceType, typename StatisticType, typename MatType>
+void Octree<DistanceType, StatisticType, MatType>::MortonBuildTree(
+    std::vector<size_t>& oldFromNew,
+    const size_t maxLeafSize)
+{
+  oldFromNew.resize(dataset->n_cols);
+  for (size_t i = 0; i < dataset->n_cols; ++i)
+    oldFromNew[i] = i;
+
+  if (count > 0)
+  {
+    if (dataset->n_rows > 64)
+    {
+      throw std::invalid_argument("Octree::Octree(): the Morton-code build "
+          "cannot be used with more than 64 dimensions!");
+    }
+
+    // Calculate empirical center of data.
+    bound |= *dataset;
+    arma::vec center;
+    bound.Center(center);
+
+    double maxWidth = 0.0;
+    for (size_t i = 0; i < bound.Dim(); ++i)
+      if (bound[i].Hi() - bound[i].Lo() > maxWidth)
+        maxWidth = bound[i].Hi() - bound[i].Lo();
+
+    if (count > maxLeafSize && maxWidth > 0.0)
+    {
+      // Use the same cells as SplitNode(): the root cell has center `center`
+      // and extends maxWidth in every direction.
+      const size_t bitsPerDim = std::min((size_t) 32, 64 / dataset->n_rows);
+      const arma::vec lo = center - maxWidth;
+
+      std::vector<uint64_t> codes;
+      MortonCodes(*dataset, lo, 2.0 * maxWidth, bitsPerDim, codes);
+      MortonRadixSort(codes, oldFromNew, bitsPerDim * dataset->n_rows);
+
+      // Reorder the dataset to match the sorted codes.
+      MatType sortedDataset(dataset->n_rows, dataset->n_cols);
+      #pragma omp parallel for schedule(static)
+      for (size_t i = 0; i < count; ++i)
+        sortedDataset.col(i) = dataset->col(oldFromNew[i]);
+      *dataset = std::move(sortedDataset);
+
+      MortonSplitNode(codes, 0, bitsPerDim, maxLeafSize);
+    }
+
+    furthestDescendantDistance = 0.5 * bound.Diameter();
+  }
+  else
+  {
+    furthestDescendantDistance = 0.0;
+  }
+
+  // Initialize the statistic.
+  stat = StatisticType(*this);
+}
+
+//! Create the children of a node from the sorted Morton codes.
+template<typename DistanceType, typename StatisticType, typename MatType>
+void Octree<DistanceType, StatisticType, MatType>::MortonSplitNode(
+    const std::vector<uint64_t>& codes,
+    const size_t level,
+    const size_t bitsPerDim,
+    const size_t maxLeafSize)
+{
+  // No need to split if we have fewer than the maximum number of points in this
+  // node, or if the codes cannot tell the points apart anymore.
+  if (count <= maxLeafSize || level == bitsPerDim)
+    return;
+
+  // The codes of the points in this node share their first (level * d) bits,
+  // so points in the same child are contiguous and the children are in the
+  // same order as SplitNode() creates them in.
+  const size_t dims = dataset->n_rows;
+  const size_t shift = (bitsPerDim - level - 1) * dims;
+  const uint64_t mask = (dims == 64) ? ~((uint64_t) 0) :
+      ((uint64_t) 1 << dims) - 1;
+
+  std::vector<size_t> childBegins;
+  size_t childBegin = begin;
+  while (childBegin < begin + count)
+  {
+    childBegins.push_back(childBegin);
+    const uint64_t child = (codes[childBegin] >> shift) & mask;
+    childBegin = std::partition_point(codes.begin() + childBegin,
+        codes.begin() + begin + count,
+        [shift, mask, child](const uint64_t code)
+        {
+          return ((code >> shift) & mask) == child;
+        }) - codes.begin();
+  }
+  childBegins.push_back(begin + count);
+
+  children.resize(childBegins.size() - 1);
+  auto buildChild = [&](const size_t i)
+  {
+    children[i] = new Octree(this, childBegins[i],
+        childBegins[i + 1] - childBegins[i], codes, level + 1, bitsPerDim,
+        maxLeafSize);
+  };
+
+  #ifdef MLPACK_USE_OPENMP
+  if (count >= ParallelBuildMinCount && omp_get_max_threads() > 1)
+  {
+    if (omp_in_parallel())
+    {
+      // We are already inside a task (or the user's parallel region), so just
+      // spawn more tasks.
+      for (size_t i = 0; i < children.size(); ++i)
+      {
+        #pragma omp task shared(buildChild) firstprivate(i)
+        {
+          buildChild(i);
+        }
+      }
+
+      #pragma omp taskwait
+    }
+    else
+    {
+      #pragma omp parallel
+      {
+        #pragma omp single
+        {
+          for (size_t i = 0; i < children.size(); ++i)
+          {
+            #pragma omp task shared(buildChild) firstprivate(i)
+            {
+              buildChild(i);
+            }
+          }
+
+          #pragma omp taskwait
+        }
+      }
+    }
+
+    return;
+  }
+  #endif
+
+  for (size_t i = 0; i < children.size(); ++i)
+    buildChild(i);
+}
+
 } // namespace mlpack
 
 #endif
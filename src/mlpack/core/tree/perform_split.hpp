@@ -16,13 +16,100 @@
 #ifndef MLPACK_CORE_TREE_PERFORM_SPLIT_HPP
 #define MLPACK_CORE_TREE_PERFORM_SPLIT_HPP
 
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 
+/**
+ * Nodes holding at least this many points are partitioned with all available
+ * OpenMP threads by PerformSplit(), as long as the dataset is dense and we are
+ * not already inside a parallel region.
+ */
+constexpr size_t ParallelSplitMinCount = 262144;
+
+/**
+ * Rearrange the points of a node according to the split information, using
+ * all available OpenMP threads.  First the side of every point is computed in
+ * parallel; then the points on the wrong side are swapped pairwise in parallel.
+ * The i-th misplaced point from the left is swapped with the i-th misplaced
+ * point from the right, so the resulting ordering (and oldFromNew mapping) is
+ * exactly the one that the sequential PerformSplit() produces.
+ *
+ * @param data The dataset used by the binary space tree.
+ * @param begin Index of the starting point in the dataset that belongs to
+ *    this node.
+ * @param count Number of points in this node.
+ * @param splitInfo The information about the split.
+ * @param oldFromNew If not NULL, vector holding the old positions for each new
+ *    point; it is updated alongside the dataset.
+ */
+template<typename MatType, typename SplitType>
+size_t ParallelPerformSplit(MatType& data,
+                            const size_t begin,
+                            const size_t count,
+                            const typename SplitType::SplitInfo& splitInfo,
+                            std::vector<size_t>* oldFromNew)
+{
+  // Determine which side every point belongs to.
+  std::vector<char> assignLeft(count);
+  size_t numLeft = 0;
+  #pragma omp parallel for reduction(+:numLeft) schedule(static)
+  for (size_t i = 0; i < count; ++i)
+  {
+    assignLeft[i] = SplitType::AssignToLeftNode(data.col(begin + i), splitInfo);
+    numLeft += (assignLeft[i] ? 1 : 0);
+  }
+
+  // Collect the points that are on the wrong side of the split column.  There
+  // are as many on the left side as there are on the right side.
+  std::vector<size_t> wrongLeft, wrongRight;
+  for (size_t i = 0; i < numLeft; ++i)
+    if (!assignLeft[i])
+      wrongLeft.push_back(begin + i);
+  for (size_t i = count; i > numLeft; --i)
+    if (assignLeft[i - 1])
+      wrongRight.push_back(begin + i - 1);
+
+  Log::Assert(wrongLeft.size() == wrongRight.size());
+
+  // Each swap touches a different pair of columns, so they can all be done at
+  // once.
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < wrongLeft.size(); ++i)
+  {
+    data.swap_cols(wrongLeft[i], wrongRight[i]);
+    if (oldFromNew != NULL)
+      std::swap((*oldFromNew)[wrongLeft[i]], (*oldFromNew)[wrongRight[i]]);
+  }
+
+  return begin + numLeft;
+}
+
+/**
+ * Return whether PerformSplit() should use ParallelPerformSplit() for a node
+ * with the given number of points.  Columns of sparse matrices cannot be
+ * swapped independently, so sparse data is always split sequentially.
+ */
+template<typename MatType>
+inline bool UseParallelSplit(const size_t count)
+{
+  #ifdef MLPACK_USE_OPENMP
+  return !arma::is_arma_sparse_type<MatType>::value &&
+      (count >= ParallelSplitMinCount) && !omp_in_parallel() &&
+      (omp_get_max_threads() > 1);
+  #else
+  (void) count;
+  return false;
+  #endif
+}
+
 /**
  * This function implements the default split behavior i.e. it rearranges
  * points according to the split information. The SplitType::AssignToLeftNode()
  * function is used in order to determine the child that contains any particular
- * point.
+ * point.  Large nodes are split with ParallelPerformSplit().
  *
  * @param data The dataset used by the binary space tree.
  * @param begin Index of the starting point in the dataset that belongs to
@@ -36,6 +123,12 @@ size_t PerformSplit(MatType& data,
                     const size_t count,
                     const typename SplitType::SplitInfo& splitInfo)
 {
+  if (UseParallelSplit<MatType>(count))
+  {
+    return ParallelPerformSplit<MatType, SplitType>(data, begin, count,
+        splitInfo, NULL);
+  }
+
   // This method modifies the input dataset.  We loop both from the left and
   // right sides of the points contained in this node.
   size_t left = begin;
@@ -85,7 +178,7 @@ size_t PerformSplit(MatType& data,
  * points according to the split information. The SplitType::AssignToLeftNode()
  * function is used in order to determine the child that contains any particular
  * point. The function takes care of indices and returns the list of changed
- * indices.
+ * indices.  Large nodes are split with ParallelPerformSplit().
  *
  * @param data The dataset used by the binary space tree.
  * @param begin Index of the starting point in the dataset that belongs to
@@ -102,6 +195,12 @@ size_t PerformSplit(MatType& data,
                     const typename SplitType::SplitInfo& splitInfo,
                     std::vector<size_t>& oldFromNew)
 {
+  if (UseParallelSplit<MatType>(count))
+  {
+    return ParallelPerformSplit<MatType, SplitType>(data, begin, count,
+        splitInfo, &oldFromNew);
+  }
+
   // This method modifies the input dataset.  We loop both from the left and
   // right sides of the points contained in this node.
   size_t left = begin;
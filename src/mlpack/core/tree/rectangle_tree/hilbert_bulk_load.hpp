@@ -0,0 +1,50 @@
+/**
+ * @file core/tree/rectangle_tree/hilbert_bulk_load.hpp
+ *
+ * Definition of HilbertBulkLoad, a class that orders the points of a dataset
+ * along the Hilbert curve so that a RectangleTree can be packed in one pass.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_RECTANGLE_TREE_HILBERT_BULK_LOAD_HPP
+#define MLPACK_CORE_TREE_RECTANGLE_TREE_HILBERT_BULK_LOAD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "discrete_hilbert_value.hpp"
+
+namespace mlpack {
+
+/**
+ * The Hilbert bulk loading order: the points are sorted by their discrete
+ * Hilbert value (as computed by DiscreteHilbertValue), so that points which are
+ * close along the Hilbert curve end up in the same node.  This is the order
+ * that a HilbertRTree keeps its points in, so it is the order to use when bulk
+ * loading a HilbertRTree.
+ */
+class HilbertBulkLoad
+{
+ public:
+  /**
+   * Compute the Hilbert order of the columns of the given dataset.
+   *
+   * @param data Dataset to order.
+   * @param nodeSize Number of points that fit in one node (unused; the order
+   *     does not depend on it).
+   * @param order Vector to store the order of the columns in.
+   */
+  template<typename MatType>
+  static void Order(const MatType& data,
+                    const size_t nodeSize,
+                    std::vector<size_t>& order);
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "hilbert_bulk_load_impl.hpp"
+
+#endif
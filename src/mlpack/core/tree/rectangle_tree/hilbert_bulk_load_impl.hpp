@@ -0,0 +1,54 @@
+/**
+ * @file core/tree/rectangle_tree/hilbert_bulk_load_impl.hpp
+ *
+ * Implementation of HilbertBulkLoad, the Hilbert curve bulk loading order.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_RECTANGLE_TREE_HILBERT_BULK_LOAD_IMPL_HPP
+#define MLPACK_CORE_TREE_RECTANGLE_TREE_HILBERT_BULK_LOAD_IMPL_HPP
+
+#include "hilbert_bulk_load.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+void HilbertBulkLoad::Order(const MatType& data,
+                            const size_t /* nodeSize */,
+                            std::vector<size_t>& order)
+{
+  typedef DiscreteHilbertValue<typename MatType::elem_type> HilbertValue;
+  typedef typename HilbertValue::HilbertElemType HilbertElemType;
+
+  // Compute the Hilbert value of every point once, instead of once per
+  // comparison.
+  arma::Mat<HilbertElemType> values(data.n_rows, data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    values.col(i) = HilbertValue::CalculateValue(data.col(i));
+
+  order.resize(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    order[i] = i;
+
+  // The values are compared lexicographically, just like
+  // DiscreteHilbertValue::CompareValues() does; ties are broken by index, so
+  // that the order is deterministic.
+  std::sort(order.begin(), order.end(),
+      [&values](const size_t a, const size_t b)
+      {
+        for (size_t d = 0; d < values.n_rows; ++d)
+        {
+          if (values(d, a) != values(d, b))
+            return values(d, a) < values(d, b);
+        }
+
+        return a < b;
+      });
+}
+
+} // namespace mlpack
+
+#endif
@@ -155,6 +155,63 @@ class RectangleTree
                 const size_t minNumChildren = 2,
                 const size_t firstDataIndex = 0);
 
+  /**
+   * Construct this as the root node of a rectangle type tree by bulk loading
+   * the given dataset, instead of inserting the points one at a time.  The
+   * points are ordered with the given BulkLoadType (STRBulkLoad or
+   * HilbertBulkLoad), consecutive runs of points are packed into full leaves,
+   * and consecutive runs of nodes are packed into full parents.  The dataset
+   * is copied, but its ordering is not modified.
+   *
+   * Trees that keep insertion-order information in their auxiliary
+   * information (that is, the HilbertRTree) are built by inserting the points
+   * in the given order instead; with HilbertBulkLoad, every point is then
+   * appended to the last leaf.  Trees without overlapping children (the R+
+   * and R++ trees) cannot be bulk loaded.
+   *
+   * @param data Dataset from which to create the tree.
+   * @param bulkLoad Instantiated bulk loading order.
+   * @param maxLeafSize Maximum size of each leaf in the tree.
+   * @param minLeafSize Minimum size of each leaf in the tree.
+   * @param maxNumChildren The maximum number of child nodes a non-leaf node may
+   *      have.
+   * @param minNumChildren The minimum number of child nodes a non-leaf node may
+   *      have.
+   */
+  template<typename BulkLoadType>
+  RectangleTree(const MatType& data,
+                const BulkLoadType& bulkLoad,
+                const size_t maxLeafSize = 20,
+                const size_t minLeafSize = 8,
+                const size_t maxNumChildren = 5,
+                const size_t minNumChildren = 2,
+                const typename std::enable_if_t<
+                    !std::is_arithmetic<BulkLoadType>::value>* = 0);
+
+  /**
+   * Construct this as the root node of a rectangle type tree by bulk loading
+   * the given dataset, and taking ownership of the given dataset.  See the
+   * constructor above for details.
+   *
+   * @param data Dataset from which to create the tree.
+   * @param bulkLoad Instantiated bulk loading order.
+   * @param maxLeafSize Maximum size of each leaf in the tree.
+   * @param minLeafSize Minimum size of each leaf in the tree.
+   * @param maxNumChildren The maximum number of child nodes a non-leaf node may
+   *      have.
+   * @param minNumChildren The minimum number of child nodes a non-leaf node may
+   *      have.
+   */
+  template<typename BulkLoadType>
+  RectangleTree(MatType&& data,
+                const BulkLoadType& bulkLoad,
+                const size_t maxLeafSize = 20,
+                const size_t minLeafSize = 8,
+                const size_t maxNumChildren = 5,
+                const size_t minNumChildren = 2,
+                const typename std::enable_if_t<
+                    !std::is_arithmetic<BulkLoadType>::value>* = 0);
+
   /**
    * Construct this as an empty node with the specified parent.  Copying the
    * parameters (maxLeafSize, minLeafSize, maxNumChildren, minNumChildren,
@@ -560,6 +617,25 @@ class RectangleTree
    */
   void SplitNode(std::vector<bool>& relevels);
 
+  /**
+   * Bulk load the whole dataset into this (empty) root node, using the order
+   * given by BulkLoadType.
+   */
+  template<typename BulkLoadType>
+  void BulkLoad();
+
+  /**
+   * Pack the given range of leaves into this node.  Leaf i holds the points
+   * order[leafBounds[i], leafBounds[i + 1]), and each child of this node holds
+   * at most leafCapacity / MaxNumChildren() leaves; if leafCapacity is 1, this
+   * node is a leaf.
+   */
+  void PackNode(const std::vector<size_t>& order,
+                const std::vector<size_t>& leafBounds,
+                const size_t firstLeaf,
+                const size_t lastLeaf,
+                const size_t leafCapacity);
+
   /**
    * Builds statistics for a node and all its descendants in a bottom-up way.
    *
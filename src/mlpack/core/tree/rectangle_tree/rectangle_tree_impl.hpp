@@ -14,6 +14,8 @@
 
 // In case it wasn't included already for some reason.
 #include "rectangle_tree.hpp"
+#include "hilbert_r_tree_descent_heuristic.hpp"
+#include "../tree_traits.hpp"
 
 #include <mlpack/core/util/log.hpp>
 
@@ -38,6 +40,103 @@ BuildStatistics(RectangleTree* node)
   node->Stat() = StatisticType(*node);
 }
 
+// Bulk load the dataset into this node.
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+template<typename BulkLoadType>
+void RectangleTree<DistanceType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+BulkLoad()
+{
+  static_assert(TreeTraits<RectangleTree>::HasOverlappingChildren,
+      "RectangleTree: trees without overlapping children (such as the R+ tree) "
+      "cannot be bulk loaded.");
+
+  std::vector<size_t> order;
+  BulkLoadType::Order(*dataset, maxLeafSize, order);
+
+  if constexpr (std::is_same<DescentType, HilbertRTreeDescentHeuristic>::value)
+  {
+    // The Hilbert R tree stores the Hilbert values of its points as they are
+    // inserted, so we insert the points in the given order.  In the Hilbert
+    // order, each point goes to the last leaf.
+    for (size_t i = 0; i < order.size(); ++i)
+      InsertPoint(order[i]);
+  }
+  else
+  {
+    if (order.empty())
+      return;
+
+    // Spread the points evenly over the smallest number of leaves that can
+    // hold them.  Each leaf then holds at least half of maxLeafSize points.
+    const size_t numLeaves = (order.size() + maxLeafSize - 1) / maxLeafSize;
+    std::vector<size_t> leafBounds(numLeaves + 1);
+    for (size_t i = 0; i <= numLeaves; ++i)
+      leafBounds[i] = (i * order.size()) / numLeaves;
+
+    // Find the height of the tree: every level multiplies the number of leaves
+    // that a node can hold by maxNumChildren.
+    size_t leafCapacity = 1;
+    while (leafCapacity < numLeaves)
+      leafCapacity *= maxNumChildren;
+
+    PackNode(order, leafBounds, 0, numLeaves, leafCapacity);
+  }
+}
+
+// Pack a range of leaves into this node.
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<DistanceType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+PackNode(const std::vector<size_t>& order,
+         const std::vector<size_t>& leafBounds,
+         const size_t firstLeaf,
+         const size_t lastLeaf,
+         const size_t leafCapacity)
+{
+  if (leafCapacity == 1)
+  {
+    // This is a leaf; it holds the points of exactly one leaf range.
+    for (size_t i = leafBounds[firstLeaf]; i < leafBounds[lastLeaf]; ++i)
+    {
+      bound |= dataset->col(order[i]);
+      if (!auxiliaryInfo.HandlePointInsertion(this, order[i]))
+        points[count++] = order[i];
+    }
+
+    numDescendants = leafBounds[lastLeaf] - leafBounds[firstLeaf];
+    return;
+  }
+
+  // Split the leaves evenly over as few children as possible.  Since every
+  // child holds at least one leaf, all leaves end up at the same depth.
+  const size_t childCapacity = leafCapacity / maxNumChildren;
+  const size_t numLeaves = lastLeaf - firstLeaf;
+  const size_t numNewChildren = (numLeaves + childCapacity - 1) / childCapacity;
+  for (size_t i = 0; i < numNewChildren; ++i)
+  {
+    RectangleTree* child = new RectangleTree(this);
+    child->PackNode(order, leafBounds,
+        firstLeaf + (i * numLeaves) / numNewChildren,
+        firstLeaf + ((i + 1) * numLeaves) / numNewChildren, childCapacity);
+
+    bound |= child->Bound();
+    numDescendants += child->numDescendants;
+    if (!auxiliaryInfo.HandleNodeInsertion(this, child, true))
+      children[numChildren++] = child;
+  }
+}
+
 template<typename DistanceType,
          typename StatisticType,
          typename MatType,
@@ -120,6 +219,86 @@ RectangleTree(MatType&& data,
   BuildStatistics(this);
 }
 
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+template<typename BulkLoadType>
+RectangleTree<DistanceType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+RectangleTree(const MatType& data,
+              const BulkLoadType& /* bulkLoad */,
+              const size_t maxLeafSize,
+              const size_t minLeafSize,
+              const size_t maxNumChildren,
+              const size_t minNumChildren,
+              const typename std::enable_if_t<
+                  !std::is_arithmetic<BulkLoadType>::value>*) :
+    maxNumChildren(maxNumChildren),
+    minNumChildren(minNumChildren),
+    numChildren(0),
+    children(maxNumChildren + 1), // Add one to make splitting the node simpler.
+    parent(NULL),
+    begin(0),
+    count(0),
+    numDescendants(0),
+    maxLeafSize(maxLeafSize),
+    minLeafSize(minLeafSize),
+    bound(data.n_rows),
+    parentDistance(0),
+    dataset(new MatType(data)),
+    ownsDataset(true),
+    points(maxLeafSize + 1), // Add one to make splitting the node simpler.
+    auxiliaryInfo(this)
+{
+  BulkLoad<BulkLoadType>();
+
+  // Initialize statistic recursively after tree construction is complete.
+  BuildStatistics(this);
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+template<typename BulkLoadType>
+RectangleTree<DistanceType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+RectangleTree(MatType&& data,
+              const BulkLoadType& /* bulkLoad */,
+              const size_t maxLeafSize,
+              const size_t minLeafSize,
+              const size_t maxNumChildren,
+              const size_t minNumChildren,
+              const typename std::enable_if_t<
+                  !std::is_arithmetic<BulkLoadType>::value>*) :
+    maxNumChildren(maxNumChildren),
+    minNumChildren(minNumChildren),
+    numChildren(0),
+    children(maxNumChildren + 1), // Add one to make splitting the node simpler.
+    parent(NULL),
+    begin(0),
+    count(0),
+    numDescendants(0),
+    maxLeafSize(maxLeafSize),
+    minLeafSize(minLeafSize),
+    bound(data.n_rows),
+    parentDistance(0),
+    dataset(new MatType(std::move(data))),
+    ownsDataset(true),
+    points(maxLeafSize + 1), // Add one to make splitting the node simpler.
+    auxiliaryInfo(this)
+{
+  BulkLoad<BulkLoadType>();
+
+  // Initialize statistic recursively after tree construction is complete.
+  BuildStatistics(this);
+}
+
 template<typename DistanceType,
          typename StatisticType,
          typename MatType,
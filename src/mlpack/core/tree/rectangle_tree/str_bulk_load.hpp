@@ -0,0 +1,75 @@
+/**
+ * @file core/tree/rectangle_tree/str_bulk_load.hpp
+ *
+ * Definition of STRBulkLoad, a class that orders the points of a dataset with
+ * the Sort-Tile-Recursive algorithm so that a RectangleTree can be packed in
+ * one pass.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_RECTANGLE_TREE_STR_BULK_LOAD_HPP
+#define MLPACK_CORE_TREE_RECTANGLE_TREE_STR_BULK_LOAD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * The Sort-Tile-Recursive (STR) bulk loading order.  The points are sorted
+ * along the first dimension and cut into roughly P^(1/d) slabs, where P is the
+ * number of nodes that are needed to hold all the points; each slab is then
+ * sorted along the next dimension and tiled in the same way, until the last
+ * dimension is reached.  Consecutive runs of nodeSize points of the resulting
+ * order each fill one tile.
+ *
+ * For more information, see the following paper.
+ *
+ * @code
+ * @inproceedings{leutenegger1997str,
+ *   title={STR: A simple and efficient algorithm for R-tree packing},
+ *   author={Leutenegger, S.T. and Lopez, M.A. and Edgington, J.},
+ *   booktitle={Proceedings of the 13th International Conference on Data
+ *       Engineering},
+ *   pages={497--506},
+ *   year={1997}
+ * }
+ * @endcode
+ */
+class STRBulkLoad
+{
+ public:
+  /**
+   * Compute the STR order of the columns of the given dataset.
+   *
+   * @param data Dataset to order.
+   * @param nodeSize Number of points that fit in one node.
+   * @param order Vector to store the order of the columns in.
+   */
+  template<typename MatType>
+  static void Order(const MatType& data,
+                    const size_t nodeSize,
+                    std::vector<size_t>& order);
+
+ private:
+  /**
+   * Sort the points order[begin, end) along the given dimension, cut them into
+   * slabs, and recurse into each slab with the next dimension.
+   */
+  template<typename MatType>
+  static void SortTiles(const MatType& data,
+                        const size_t nodeSize,
+                        const size_t dim,
+                        std::vector<size_t>& order,
+                        const size_t begin,
+                        const size_t end);
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "str_bulk_load_impl.hpp"
+
+#endif
@@ -0,0 +1,65 @@
+/**
+ * @file core/tree/rectangle_tree/str_bulk_load_impl.hpp
+ *
+ * Implementation of STRBulkLoad, the Sort-Tile-Recursive bulk loading order.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_RECTANGLE_TREE_STR_BULK_LOAD_IMPL_HPP
+#define MLPACK_CORE_TREE_RECTANGLE_TREE_STR_BULK_LOAD_IMPL_HPP
+
+#include "str_bulk_load.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+void STRBulkLoad::Order(const MatType& data,
+                        const size_t nodeSize,
+                        std::vector<size_t>& order)
+{
+  order.resize(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    order[i] = i;
+
+  if (data.n_rows > 0 && data.n_cols > 0)
+    SortTiles(data, std::max(nodeSize, size_t(1)), 0, order, 0, data.n_cols);
+}
+
+template<typename MatType>
+void STRBulkLoad::SortTiles(const MatType& data,
+                            const size_t nodeSize,
+                            const size_t dim,
+                            std::vector<size_t>& order,
+                            const size_t begin,
+                            const size_t end)
+{
+  std::sort(order.begin() + begin, order.begin() + end,
+      [&data, dim](const size_t a, const size_t b)
+      {
+        return data(dim, a) < data(dim, b);
+      });
+
+  const size_t count = end - begin;
+  if (dim + 1 == data.n_rows || count <= nodeSize)
+    return;
+
+  // Cut the points into numSlabs slabs, each of which holds a whole number of
+  // nodes, so that the remaining dimensions can tile every slab separately.
+  const size_t numNodes = (count + nodeSize - 1) / nodeSize;
+  const size_t numSlabs = (size_t) std::ceil(std::pow((double) numNodes,
+      1.0 / (data.n_rows - dim)));
+  const size_t slabSize = ((numNodes + numSlabs - 1) / numSlabs) * nodeSize;
+
+  for (size_t slabBegin = begin; slabBegin < end; slabBegin += slabSize)
+  {
+    SortTiles(data, nodeSize, dim + 1, order, slabBegin,
+        std::min(slabBegin + slabSize, end));
+  }
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,43 @@
+/**
+ * @file core/tree/rule_traits.hpp
+ *
+ * This file implements the basic, unspecialized RuleTraits class, which
+ * provides information about the rule sets used by tree traversers.  If you
+ * write a rule set, you may specialize this class with its characteristics.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_RULE_TRAITS_HPP
+#define MLPACK_CORE_TREE_RULE_TRAITS_HPP
+
+namespace mlpack {
+
+/**
+ * The RuleTraits class provides compile-time information on the
+ * characteristics of a given rule set (the RuleType of a traverser).  Like
+ * TreeTraits, each trait is a static const value, and the unspecialized
+ * implementation makes as few assumptions about the rules as possible.
+ */
+template<typename RuleType>
+class RuleTraits
+{
+ public:
+  /**
+   * This is true if the rule set only writes results and statistics that
+   * belong to the query points and query nodes it is given, and if copies of
+   * the rule set share the storage for those results.  Disjoint query subtrees
+   * can then be traversed at the same time with different copies of the rules,
+   * as the BinarySpaceTree::ParallelDualTreeTraverser does.
+   *
+   * This is not true of rule sets that write reference statistics or global
+   * state, such as the DTBRules used for EMST, which merge components.
+   */
+  static const bool HasPerQueryResults = false;
+};
+
+} // namespace mlpack
+
+#endif
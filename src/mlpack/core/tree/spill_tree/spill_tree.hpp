@@ -14,6 +14,7 @@
 #include <mlpack/prereqs.hpp>
 #include "../space_split/midpoint_space_split.hpp"
 #include "../statistic.hpp"
+#include "../node_arena.hpp"
 
 namespace mlpack {
 
@@ -69,7 +70,7 @@ template<typename DistanceType,
             class HyperplaneType = AxisOrthogonalHyperplane,
          template<typename SplitDistanceType, typename SplitMatType>
             class SplitType = MidpointSpaceSplit>
-class SpillTree
+class SpillTree : public ArenaAllocated
 {
  public:
   //! So other classes can use TreeType::Mat.
@@ -92,6 +93,14 @@ class SpillTree
   //! The list of indexes of points contained in this node (non-NULL if the node
   //! is a leaf or if overlappingNode is true).
   arma::Col<size_t>* pointsIndex;
+  //! The indexes of the points contained in this node, in the shared array of
+  //! the root, if the tree has been compacted with Compact() (NULL otherwise,
+  //! and then pointsIndex is used).
+  const uint32_t* packedIndex;
+  //! The shared array of the indexes of the points of all the nodes, if the
+  //! tree has been compacted and this is the root (NULL otherwise).  If we are
+  //! the root of the tree, we own the array and must delete it.
+  std::vector<uint32_t>* packedStorage;
   //! Flag to distinguish overlapping nodes from non-overlapping nodes.
   bool overlappingNode;
   //! Splitting hyperplane represented by this node.
@@ -112,6 +121,10 @@ class SpillTree
   const MatType* dataset;
   //! If true, we own the dataset and need to destroy it in the destructor.
   bool localDataset;
+  //! The arena that the children are allocated from (NULL if the root is a
+  //! leaf, or to allocate the children individually).  If we are the root of
+  //! the tree, we own the arena and must delete it.
+  NodeArena* arena;
 
   //! A generic single-tree traverser for hybrid spill trees; see
   //! spill_single_tree_traverser.hpp for implementation.  The Defeatist
@@ -239,6 +252,25 @@ class SpillTree
    */
   ~SpillTree();
 
+  /**
+   * Store the lists of indexes of the points of all the nodes of the tree in
+   * one contiguous array of 32-bit indexes, owned by the root, instead of one
+   * vector per leaf and per overlapping node.  This halves the memory used by
+   * the indexes, which are duplicated across the nodes when tau is positive,
+   * and avoids many small allocations.  The lists are stored in depth-first
+   * order, so the lists of neighboring leaves are close in memory, and each
+   * list is sorted, so a scan of a leaf reads the dataset in increasing order.
+   *
+   * This can only be called on the root of the tree, and the dataset must have
+   * fewer than 2^32 points.  Calling it on a compact tree does nothing.  Copies
+   * of a compact tree are compact, and compact trees are serialized as
+   * compact.
+   */
+  void Compact();
+
+  //! Return whether the tree has been compacted with Compact().
+  bool IsCompact() const { return packedStorage != NULL; }
+
   //! Return the bound object for this node.
   const BoundType& Bound() const { return bound; }
   //! Return the bound object for this node.
@@ -469,6 +501,11 @@ class SpillTree
                    const arma::Col<size_t>& points,
                    arma::Col<size_t>& leftPoints,
                    arma::Col<size_t>& rightPoints);
+
+  //! Return a copy of the list of indexes of the points of this node, or NULL
+  //! if the node holds no list.
+  arma::Col<size_t>* CopyPointsIndex() const;
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
@@ -491,6 +528,13 @@ class SpillTree
 
 } // namespace mlpack
 
+CEREAL_TEMPLATE_CLASS_VERSION((typename DistanceType,
+    typename StatisticType, typename MatType,
+    template<typename HyperplaneDistanceType> class HyperplaneType,
+    template<typename SplitDistanceType, typename SplitMatType>
+        class SplitType), (mlpack::SpillTree<DistanceType, StatisticType,
+    MatType, HyperplaneType, SplitType>), (1));
+
 // Include implementation.
 #include "spill_tree_impl.hpp"
 
@@ -15,6 +15,7 @@
 #include "spill_tree.hpp"
 
 #include <queue>
+#include <stack>
 
 namespace mlpack {
 
@@ -35,12 +36,15 @@ SpillTree(
     parent(NULL),
     count(data.n_cols),
     pointsIndex(NULL),
+    packedIndex(NULL),
+    packedStorage(NULL),
     overlappingNode(false),
     hyperplane(),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
     dataset(&data),
-    localDataset(false)
+    localDataset(false),
+    arena((dataset->n_cols > maxLeafSize) ? new NodeArena() : NULL)
 {
   arma::Col<size_t> points;
   if (dataset->n_cols > 0)
@@ -72,12 +76,15 @@ SpillTree(
     parent(NULL),
     count(data.n_cols),
     pointsIndex(NULL),
+    packedIndex(NULL),
+    packedStorage(NULL),
     overlappingNode(false),
     hyperplane(),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
     dataset(new MatType(std::move(data))),
-    localDataset(true)
+    localDataset(true),
+    arena((dataset->n_cols > maxLeafSize) ? new NodeArena() : NULL)
 {
   arma::Col<size_t> points;
   if (dataset->n_cols > 0)
@@ -110,11 +117,14 @@ SpillTree(
     parent(parent),
     count(points.n_elem),
     pointsIndex(NULL),
+    packedIndex(NULL),
+    packedStorage(NULL),
     overlappingNode(false),
     hyperplane(),
     bound(parent->Dataset().n_rows),
     dataset(&parent->Dataset()), // Point to the parent's dataset.
-    localDataset(false)
+    localDataset(false),
+    arena(parent->arena)
 {
   // Perform the actual splitting.
   SplitNode(points, maxLeafSize, tau, rho);
@@ -140,6 +150,8 @@ SpillTree(const SpillTree& other) :
     parent(other.parent),
     count(other.count),
     pointsIndex(NULL),
+    packedIndex(NULL),
+    packedStorage(NULL),
     overlappingNode(other.overlappingNode),
     hyperplane(other.hyperplane),
     bound(other.bound),
@@ -150,7 +162,9 @@ SpillTree(const SpillTree& other) :
     // copy of the dataset.
     dataset((other.parent == NULL && other.localDataset) ?
         new MatType(*other.dataset) : other.dataset),
-    localDataset(other.parent == NULL && other.localDataset)
+    localDataset(other.parent == NULL && other.localDataset),
+    // Copies allocate their nodes individually.
+    arena(NULL)
 {
   // Create left and right children (if any).
   if (other.Left())
@@ -166,8 +180,7 @@ SpillTree(const SpillTree& other) :
   }
 
   // If vector of indexes, copy it.
-  if (other.pointsIndex)
-    pointsIndex = new arma::Col<size_t>(*other.pointsIndex);
+  pointsIndex = other.CopyPointsIndex();
 
   // Propagate matrix, but only if we are the root.
   if (parent == NULL && localDataset)
@@ -189,6 +202,10 @@ SpillTree(const SpillTree& other) :
         queue.push(node->right);
     }
   }
+
+  // The children hold copies of their indexes, so pack them again.
+  if (parent == NULL && other.packedStorage)
+    Compact();
 }
 
 /**
@@ -214,12 +231,20 @@ operator=(const SpillTree& other)
   delete pointsIndex;
   delete left;
   delete right;
+  if (!parent)
+  {
+    delete arena;
+    delete packedStorage;
+  }
 
   left = NULL;
   right = NULL;
+  arena = NULL;
   parent = other.parent;
   count = other.count;
   pointsIndex = NULL;
+  packedIndex = NULL;
+  packedStorage = NULL;
   overlappingNode = other.overlappingNode;
   hyperplane = other.hyperplane;
   bound = other.bound;
@@ -247,8 +272,7 @@ operator=(const SpillTree& other)
   }
 
   // If vector of indexes, copy it.
-  if (other.pointsIndex)
-    pointsIndex = new arma::Col<size_t>(*other.pointsIndex);
+  pointsIndex = other.CopyPointsIndex();
 
   // Propagate matrix, but only if we are the root.
   if (parent == NULL && localDataset)
@@ -270,6 +294,11 @@ operator=(const SpillTree& other)
         queue.push(node->right);
     }
   }
+
+  // The children hold copies of their indexes, so pack them again.
+  if (parent == NULL && other.packedStorage)
+    Compact();
+
   return *this;
 }
 
@@ -289,6 +318,8 @@ SpillTree(SpillTree&& other) :
     parent(other.parent),
     count(other.count),
     pointsIndex(other.pointsIndex),
+    packedIndex(other.packedIndex),
+    packedStorage(other.packedStorage),
     overlappingNode(other.overlappingNode),
     hyperplane(other.hyperplane),
     bound(std::move(other.bound)),
@@ -297,7 +328,8 @@ SpillTree(SpillTree&& other) :
     furthestDescendantDistance(other.furthestDescendantDistance),
     minimumBoundDistance(other.minimumBoundDistance),
     dataset(other.dataset),
-    localDataset(other.localDataset)
+    localDataset(other.localDataset),
+    arena(other.arena)
 {
   // Now we are a clone of the other tree.  But we must also clear the other
   // tree's contents, so it doesn't delete anything when it is destructed.
@@ -305,11 +337,14 @@ SpillTree(SpillTree&& other) :
   other.right = NULL;
   other.count = 0;
   other.pointsIndex = NULL;
+  other.packedIndex = NULL;
+  other.packedStorage = NULL;
   other.parentDistance = 0.0;
   other.furthestDescendantDistance = 0.0;
   other.minimumBoundDistance = 0.0;
   other.dataset = NULL;
   other.localDataset = false;
+  other.arena = NULL;
 
   // Set new parent.
   if (left)
@@ -341,12 +376,19 @@ operator=(SpillTree&& other)
   delete pointsIndex;
   delete left;
   delete right;
+  if (!parent)
+  {
+    delete arena;
+    delete packedStorage;
+  }
 
   left = other.left;
   right = other.right;
   parent = other.parent;
   count = other.count;
   pointsIndex = other.pointsIndex;
+  packedIndex = other.packedIndex;
+  packedStorage = other.packedStorage;
   overlappingNode = other.overlappingNode;
   hyperplane = other.hyperplane;
   bound = std::move(other.bound);
@@ -356,6 +398,7 @@ operator=(SpillTree&& other)
   minimumBoundDistance = other.minimumBoundDistance;
   dataset = other.dataset;
   localDataset = other.localDataset;
+  arena = other.arena;
 
   // Now we are a clone of the other tree.  But we must also clear the other
   // tree's contents, so it doesn't delete anything when it is destructed.
@@ -363,11 +406,14 @@ operator=(SpillTree&& other)
   other.right = NULL;
   other.count = 0;
   other.pointsIndex = NULL;
+  other.packedIndex = NULL;
+  other.packedStorage = NULL;
   other.parentDistance = 0.0;
   other.furthestDescendantDistance = 0.0;
   other.minimumBoundDistance = 0.0;
   other.dataset = NULL;
   other.localDataset = false;
+  other.arena = NULL;
 
   // Set new parent.
   if (left)
@@ -420,6 +466,79 @@ SpillTree<DistanceType, StatisticType, MatType, HyperplaneType, SplitType>::
   // If we're the root and we own the dataset, delete it.
   if (!parent && localDataset)
     delete dataset;
+
+  // If we're the root, delete the arena that held the children, and the
+  // indexes of a compact tree.
+  if (!parent)
+  {
+    delete arena;
+    delete packedStorage;
+  }
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename HyperplaneDistanceType> class HyperplaneType,
+         template<typename SplitDistanceType, typename SplitMatType>
+             class SplitType>
+void SpillTree<DistanceType, StatisticType, MatType, HyperplaneType,
+    SplitType>::Compact()
+{
+  if (parent != NULL)
+  {
+    throw std::invalid_argument("SpillTree::Compact(): only the root of a "
+        "tree can be compacted!");
+  }
+
+  if (packedStorage != NULL)
+    return;
+
+  if (dataset->n_cols > (size_t) std::numeric_limits<uint32_t>::max())
+  {
+    std::ostringstream oss;
+    oss << "SpillTree::Compact(): the dataset has " << dataset->n_cols
+        << " points, but a compact tree can only index 2^32 - 1 points!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Collect the nodes that hold a list of indexes, in depth-first order.
+  std::vector<SpillTree*> nodes;
+  size_t total = 0;
+  std::stack<SpillTree*> stack;
+  stack.push(this);
+  while (!stack.empty())
+  {
+    SpillTree* node = stack.top();
+    stack.pop();
+
+    if (node->pointsIndex)
+    {
+      nodes.push_back(node);
+      total += node->pointsIndex->n_elem;
+    }
+
+    // Visit the left child first.
+    if (node->right)
+      stack.push(node->right);
+    if (node->left)
+      stack.push(node->left);
+  }
+
+  packedStorage = new std::vector<uint32_t>(total);
+  size_t offset = 0;
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    const arma::Col<size_t> sorted = arma::sort(*nodes[i]->pointsIndex);
+    for (size_t j = 0; j < sorted.n_elem; ++j)
+      (*packedStorage)[offset + j] = (uint32_t) sorted[j];
+
+    nodes[i]->packedIndex = packedStorage->data() + offset;
+    offset += sorted.n_elem;
+
+    delete nodes[i]->pointsIndex;
+    nodes[i]->pointsIndex = NULL;
+  }
 }
 
 template<typename DistanceType,
@@ -681,7 +800,7 @@ inline size_t SpillTree<DistanceType, StatisticType, MatType, HyperplaneType,
     SplitType>::Descendant(const size_t index) const
 {
   if (IsLeaf() || overlappingNode)
-    return (*pointsIndex)[index];
+    return packedIndex ? packedIndex[index] : (*pointsIndex)[index];
 
   // If this is not a leaf and not an overlapping node, then determine whether
   // we should get the descendant from the left or the right node.
@@ -705,7 +824,7 @@ inline size_t SpillTree<DistanceType, StatisticType, MatType, HyperplaneType,
     SplitType>::Point(const size_t index) const
 {
   if (IsLeaf())
-    return (*pointsIndex)[index];
+    return packedIndex ? packedIndex[index] : (*pointsIndex)[index];
   // This should never happen.
   return (size_t() - 1);
 }
@@ -768,8 +887,8 @@ SpillTree<DistanceType, StatisticType, MatType, HyperplaneType, SplitType>::
 
   // Now we will recursively split the children by calling their constructors
   // (which perform this splitting process).
-  left = new SpillTree(this, leftPoints, tau, maxLeafSize, rho);
-  right = new SpillTree(this, rightPoints, tau, maxLeafSize, rho);
+  left = new (arena) SpillTree(this, leftPoints, tau, maxLeafSize, rho);
+  right = new (arena) SpillTree(this, rightPoints, tau, maxLeafSize, rho);
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -872,6 +991,30 @@ SpillTree<DistanceType, StatisticType, MatType, HyperplaneType, SplitType>::
   return false;
 }
 
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename HyperplaneDistanceType> class HyperplaneType,
+         template<typename SplitDistanceType, typename SplitMatType>
+             class SplitType>
+arma::Col<size_t>*
+SpillTree<DistanceType, StatisticType, MatType, HyperplaneType, SplitType>::
+    CopyPointsIndex() const
+{
+  if (pointsIndex)
+    return new arma::Col<size_t>(*pointsIndex);
+
+  if (packedIndex)
+  {
+    arma::Col<size_t>* indexes = new arma::Col<size_t>(count);
+    for (size_t i = 0; i < count; ++i)
+      (*indexes)[i] = packedIndex[i];
+    return indexes;
+  }
+
+  return NULL;
+}
+
 // Default constructor (private), for cereal.
 template<typename DistanceType,
          typename StatisticType,
@@ -886,12 +1029,15 @@ SpillTree<DistanceType, StatisticType, MatType, HyperplaneType, SplitType>::
     parent(NULL),
     count(0),
     pointsIndex(NULL),
+    packedIndex(NULL),
+    packedStorage(NULL),
     overlappingNode(false),
     stat(*this),
     parentDistance(0),
     furthestDescendantDistance(0),
     dataset(NULL),
-    localDataset(false)
+    localDataset(false),
+    arena(NULL)
 {
   // Nothing to do.
 }
@@ -908,7 +1054,7 @@ template<typename DistanceType,
 template<typename Archive>
 void
 SpillTree<DistanceType, StatisticType, MatType, HyperplaneType, SplitType>::
-    serialize(Archive& ar, const uint32_t /* version */)
+    serialize(Archive& ar, const uint32_t version)
 {
   // If we're loading, and we have children, they need to be deleted.
   if (cereal::is_loading<Archive>())
@@ -919,10 +1065,18 @@ SpillTree<DistanceType, StatisticType, MatType, HyperplaneType, SplitType>::
       delete right;
     if (!parent && localDataset)
       delete dataset;
+    if (!parent)
+    {
+      delete arena;
+      delete packedStorage;
+    }
 
     parent = NULL;
     left = NULL;
     right = NULL;
+    arena = NULL;
+    packedIndex = NULL;
+    packedStorage = NULL;
   }
 
   if (cereal::is_loading<Archive>())
@@ -930,7 +1084,18 @@ SpillTree<DistanceType, StatisticType, MatType, HyperplaneType, SplitType>::
     localDataset = true;
   }
   ar(CEREAL_NVP(count));
-  ar(CEREAL_POINTER(pointsIndex));
+  if (!cereal::is_loading<Archive>() && packedIndex)
+  {
+    // The indexes of a compact tree are saved like the others, so the nodes
+    // are stored in the same way.
+    arma::Col<size_t>* indexes = CopyPointsIndex();
+    ar(CEREAL_POINTER(indexes));
+    delete indexes;
+  }
+  else
+  {
+    ar(CEREAL_POINTER(pointsIndex));
+  }
   ar(CEREAL_NVP(overlappingNode));
   ar(CEREAL_NVP(hyperplane));
   ar(CEREAL_NVP(bound));
@@ -989,6 +1154,17 @@ SpillTree<DistanceType, StatisticType, MatType, HyperplaneType, SplitType>::
        stack.push(node->right);
     }
   }
+
+  // Only the root knows whether the tree is compact; older versions were never
+  // compact.
+  if (!hasParent)
+  {
+    bool compact = (packedStorage != NULL);
+    if (version > 0)
+      ar(CEREAL_NVP(compact));
+    if (cereal::is_loading<Archive>() && compact)
+      Compact();
+  }
 }
 
 } // namespace mlpack
@@ -0,0 +1,283 @@
+/**
+ * @file core/tree/traversal_instrumentation.hpp
+ *
+ * Compile-time instrumentation of tree traversals.  InstrumentedRules wraps
+ * any RuleType, and counts the nodes visited, the prunes, and the base cases
+ * of any traverser that uses it, as well as the time spent in Score() and
+ * BaseCase().  With NoTraversalInstrumentation, nothing is wrapped and nothing
+ * is counted.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_TRAVERSAL_INSTRUMENTATION_HPP
+#define MLPACK_CORE_TREE_TRAVERSAL_INSTRUMENTATION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+#include <mlpack/core/util/timers.hpp>
+
+#include "rule_traits.hpp"
+
+namespace mlpack {
+
+/**
+ * The instrumentation policy that does nothing.  InstrumentedRules<RuleType,
+ * NoTraversalInstrumentation> calls straight into RuleType, so traversals that
+ * use it cost exactly as much as traversals that use RuleType.
+ */
+class NoTraversalInstrumentation
+{
+ public:
+  //! Reset the counters (does nothing).
+  void Reset() { }
+
+  //! Print the counters to Log::Info (does nothing).
+  void Report() const { }
+
+  //! Print the counters and add the times to the given timers (does nothing).
+  void Report(util::Timers& /* timers */,
+              const std::string& /* prefix */ = "traversal") const { }
+};
+
+/**
+ * The instrumentation policy that counts.  For every traversal that uses
+ * InstrumentedRules<RuleType, TraversalInstrumentation>, this holds
+ *
+ *  - the number of nodes visited: nodes that were scored and then pruned
+ *    neither by Score() nor by Rescore() (in a dual-tree traversal, these are
+ *    node combinations);
+ *  - the number of prunes, by reason: Score() prunes, where the node (or node
+ *    combination) could be pruned the first time it was scored, and Rescore()
+ *    prunes, where it could only be pruned after the bound was tightened;
+ *  - the number of base cases;
+ *  - the total time spent in Score() and Rescore(), and in BaseCase().
+ *
+ * The counters are atomic, so the same object may be used by all the copies
+ * of the rules that a parallel traverser makes.  Timing every call is not free,
+ * so this is meant for tuning (leaf size, tree type) and not for production.
+ */
+class TraversalInstrumentation
+{
+ public:
+  //! Create the object with all counters set to zero.
+  TraversalInstrumentation() { Reset(); }
+
+  //! Copy the counters of the given object.
+  TraversalInstrumentation(const TraversalInstrumentation& other);
+
+  //! Copy the counters of the given object.
+  TraversalInstrumentation& operator=(const TraversalInstrumentation& other);
+
+  //! Set all counters to zero.
+  void Reset();
+
+  //! Record a call to Score() that returned the given score.
+  void RecordScore(const double score, const std::chrono::nanoseconds& time);
+  //! Record a call to Rescore() that returned the given score.
+  void RecordRescore(const double score, const std::chrono::nanoseconds& time);
+  //! Record the given number of base cases.
+  void RecordBaseCases(const size_t baseCases,
+                       const std::chrono::nanoseconds& time);
+
+  //! Get the number of calls to Score().
+  size_t Scores() const { return scores; }
+  //! Get the number of nodes (or node combinations) visited, that is, scored
+  //! and not pruned.
+  size_t NodesVisited() const;
+  //! Get the number of prunes done by Score().
+  size_t ScorePrunes() const { return scorePrunes; }
+  //! Get the number of prunes done by Rescore().
+  size_t RescorePrunes() const { return rescorePrunes; }
+  //! Get the total number of prunes.
+  size_t Prunes() const { return scorePrunes + rescorePrunes; }
+  //! Get the number of base cases.
+  size_t BaseCases() const { return baseCases; }
+  //! Get the total time spent in Score() and Rescore().
+  std::chrono::microseconds ScoreTime() const;
+  //! Get the total time spent in BaseCase().
+  std::chrono::microseconds BaseCaseTime() const;
+
+  //! Print the counters to Log::Info.
+  void Report() const;
+
+  /**
+   * Print the counters to Log::Info, and add the time spent in Score() and in
+   * BaseCase() to the timers "<prefix>_score" and "<prefix>_base_case".
+   *
+   * @param timers Timers to add the times to.
+   * @param prefix Prefix of the names of the timers.
+   */
+  void Report(util::Timers& timers,
+              const std::string& prefix = "traversal") const;
+
+ private:
+  //! The number of calls to Score().
+  std::atomic<size_t> scores;
+  //! The number of prunes done by Score().
+  std::atomic<size_t> scorePrunes;
+  //! The number of prunes done by Rescore().
+  std::atomic<size_t> rescorePrunes;
+  //! The number of base cases.
+  std::atomic<size_t> baseCases;
+  //! The time spent in Score() and Rescore(), in nanoseconds.
+  std::atomic<int64_t> scoreTime;
+  //! The time spent in BaseCase(), in nanoseconds.
+  std::atomic<int64_t> baseCaseTime;
+};
+
+/**
+ * A wrapper around a RuleType that reports every call that a traverser makes
+ * to the given instrumentation policy (see TraversalInstrumentation), and is
+ * otherwise identical to RuleType.  Copies share the same policy object.
+ *
+ * For example, to count what a dual-tree traversal does:
+ *
+ * @code
+ * TraversalInstrumentation instrumentation;
+ * InstrumentedRules<RuleType, TraversalInstrumentation> rules(instrumentation,
+ *     ...); // The rest of the arguments are passed to RuleType.
+ * typename TreeType::template DualTreeTraverser<decltype(rules)>
+ *     traverser(rules);
+ * traverser.Traverse(queryTree, referenceTree);
+ * instrumentation.Report();
+ * @endcode
+ *
+ * @tparam RuleType The rules to wrap.
+ * @tparam InstrumentationType The instrumentation policy.
+ */
+template<typename RuleType, typename InstrumentationType>
+class InstrumentedRules : public RuleType
+{
+ public:
+  /**
+   * Construct the wrapped rules with the given arguments, and report to the
+   * given instrumentation policy.
+   */
+  template<typename... Args>
+  InstrumentedRules(InstrumentationType& instrumentation, Args&&... args) :
+      RuleType(std::forward<Args>(args)...),
+      instrumentation(&instrumentation)
+  {
+    // Nothing to do.
+  }
+
+  //! Compute the base case, recording it and its time.
+  template<typename... Args>
+  double BaseCase(Args&&... args)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    const double result = RuleType::BaseCase(std::forward<Args>(args)...);
+    instrumentation->RecordBaseCases(1, std::chrono::steady_clock::now() -
+        start);
+    return result;
+  }
+
+  /**
+   * Compute all base cases of a leaf-leaf combination at once, recording them
+   * and their time.  This only exists if RuleType has LeafBaseCase().
+   */
+  template<typename TreeType, typename WrappedRuleType = RuleType>
+  auto LeafBaseCase(const std::vector<size_t>& queryIndices,
+                    TreeType& referenceNode)
+      -> decltype(std::declval<WrappedRuleType&>().LeafBaseCase(queryIndices,
+          referenceNode))
+  {
+    const auto start = std::chrono::steady_clock::now();
+    RuleType::LeafBaseCase(queryIndices, referenceNode);
+    instrumentation->RecordBaseCases(
+        queryIndices.size() * referenceNode.NumPoints(),
+        std::chrono::steady_clock::now() - start);
+  }
+
+  /**
+   * Compute the base cases between two contiguous ranges of query and
+   * reference points at once, recording them and their time.  This only exists
+   * if RuleType has BlockBaseCase().
+   */
+  template<typename WrappedRuleType = RuleType, typename... Args>
+  auto BlockBaseCase(const size_t queryBegin,
+                     const size_t queryEnd,
+                     const size_t referenceBegin,
+                     const size_t referenceEnd,
+                     Args&&... args)
+      -> decltype(std::declval<WrappedRuleType&>().BlockBaseCase(queryBegin,
+          queryEnd, referenceBegin, referenceEnd, std::forward<Args>(args)...))
+  {
+    const auto start = std::chrono::steady_clock::now();
+    RuleType::BlockBaseCase(queryBegin, queryEnd, referenceBegin, referenceEnd,
+        std::forward<Args>(args)...);
+    instrumentation->RecordBaseCases(
+        (queryEnd - queryBegin) * (referenceEnd - referenceBegin),
+        std::chrono::steady_clock::now() - start);
+  }
+
+  //! Score the node (or node combination), recording the result and its time.
+  template<typename... Args>
+  double Score(Args&&... args)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    const double score = RuleType::Score(std::forward<Args>(args)...);
+    instrumentation->RecordScore(score, std::chrono::steady_clock::now() -
+        start);
+    return score;
+  }
+
+  //! Rescore the node (or node combination), recording the result and its
+  //! time.
+  template<typename... Args>
+  double Rescore(Args&&... args)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    const double score = RuleType::Rescore(std::forward<Args>(args)...);
+    instrumentation->RecordRescore(score, std::chrono::steady_clock::now() -
+        start);
+    return score;
+  }
+
+  //! Get the instrumentation policy.
+  InstrumentationType& Instrumentation() const { return *instrumentation; }
+
+ private:
+  //! The instrumentation policy that all calls are reported to.
+  InstrumentationType* instrumentation;
+};
+
+/**
+ * Without instrumentation, InstrumentedRules is just RuleType: the traversers
+ * call the methods of RuleType directly.
+ */
+template<typename RuleType>
+class InstrumentedRules<RuleType, NoTraversalInstrumentation> : public RuleType
+{
+ public:
+  //! Construct the wrapped rules with the given arguments.
+  template<typename... Args>
+  InstrumentedRules(NoTraversalInstrumentation& /* instrumentation */,
+                    Args&&... args) :
+      RuleType(std::forward<Args>(args)...)
+  {
+    // Nothing to do.
+  }
+};
+
+/**
+ * InstrumentedRules have the same traits as the rules they wrap: the counters
+ * of TraversalInstrumentation are atomic, and copies share the policy object.
+ */
+template<typename RuleType, typename InstrumentationType>
+class RuleTraits<InstrumentedRules<RuleType, InstrumentationType>>
+{
+ public:
+  static const bool HasPerQueryResults =
+      RuleTraits<RuleType>::HasPerQueryResults;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "traversal_instrumentation_impl.hpp"
+
+#endif
@@ -0,0 +1,126 @@
+/**
+ * @file core/tree/traversal_instrumentation_impl.hpp
+ *
+ * Implementation of TraversalInstrumentation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_TRAVERSAL_INSTRUMENTATION_IMPL_HPP
+#define MLPACK_CORE_TREE_TRAVERSAL_INSTRUMENTATION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "traversal_instrumentation.hpp"
+
+namespace mlpack {
+
+inline TraversalInstrumentation::TraversalInstrumentation(
+    const TraversalInstrumentation& other) :
+    scores(other.scores.load()),
+    scorePrunes(other.scorePrunes.load()),
+    rescorePrunes(other.rescorePrunes.load()),
+    baseCases(other.baseCases.load()),
+    scoreTime(other.scoreTime.load()),
+    baseCaseTime(other.baseCaseTime.load())
+{
+  // Nothing to do.
+}
+
+inline TraversalInstrumentation& TraversalInstrumentation::operator=(
+    const TraversalInstrumentation& other)
+{
+  scores = other.scores.load();
+  scorePrunes = other.scorePrunes.load();
+  rescorePrunes = other.rescorePrunes.load();
+  baseCases = other.baseCases.load();
+  scoreTime = other.scoreTime.load();
+  baseCaseTime = other.baseCaseTime.load();
+  return *this;
+}
+
+inline void TraversalInstrumentation::Reset()
+{
+  scores = 0;
+  scorePrunes = 0;
+  rescorePrunes = 0;
+  baseCases = 0;
+  scoreTime = 0;
+  baseCaseTime = 0;
+}
+
+inline void TraversalInstrumentation::RecordScore(
+    const double score,
+    const std::chrono::nanoseconds& time)
+{
+  scores.fetch_add(1, std::memory_order_relaxed);
+  if (score == DBL_MAX)
+    scorePrunes.fetch_add(1, std::memory_order_relaxed);
+
+  scoreTime.fetch_add(time.count(), std::memory_order_relaxed);
+}
+
+inline void TraversalInstrumentation::RecordRescore(
+    const double score,
+    const std::chrono::nanoseconds& time)
+{
+  // The node was already counted when it was scored, so only the prune is
+  // recorded here.
+  if (score == DBL_MAX)
+    rescorePrunes.fetch_add(1, std::memory_order_relaxed);
+
+  scoreTime.fetch_add(time.count(), std::memory_order_relaxed);
+}
+
+inline void TraversalInstrumentation::RecordBaseCases(
+    const size_t baseCases,
+    const std::chrono::nanoseconds& time)
+{
+  this->baseCases.fetch_add(baseCases, std::memory_order_relaxed);
+  baseCaseTime.fetch_add(time.count(), std::memory_order_relaxed);
+}
+
+inline size_t TraversalInstrumentation::NodesVisited() const
+{
+  // Nodes pruned by Rescore() were not pruned when they were scored.
+  const size_t prunes = Prunes();
+  return (scores > prunes) ? scores - prunes : 0;
+}
+
+inline std::chrono::microseconds TraversalInstrumentation::ScoreTime() const
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::nanoseconds(scoreTime.load()));
+}
+
+inline std::chrono::microseconds TraversalInstrumentation::BaseCaseTime() const
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::nanoseconds(baseCaseTime.load()));
+}
+
+inline void TraversalInstrumentation::Report() const
+{
+  Log::Info << NodesVisited() << " nodes (or node combinations) were visited."
+      << std::endl;
+  Log::Info << Prunes() << " prunes: " << ScorePrunes() << " by Score(), "
+      << RescorePrunes() << " by Rescore()." << std::endl;
+  Log::Info << BaseCases() << " base cases were calculated." << std::endl;
+  Log::Info << "Time spent scoring: " << util::Timers::Print(ScoreTime())
+      << "; time spent in base cases: " << util::Timers::Print(BaseCaseTime())
+      << "." << std::endl;
+}
+
+inline void TraversalInstrumentation::Report(util::Timers& timers,
+                                             const std::string& prefix) const
+{
+  Report();
+
+  timers.Add(prefix + "_score", ScoreTime());
+  timers.Add(prefix + "_base_case", BaseCaseTime());
+}
+
+} // namespace mlpack
+
+#endif
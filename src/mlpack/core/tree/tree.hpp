@@ -23,10 +23,12 @@
 #include "spill_tree.hpp"
 
 #include "tree_traits.hpp"
+#include "rule_traits.hpp"
 #include "build_tree.hpp"
 
 #include "statistic.hpp"
 #include "traversal_info.hpp"
+#include "traversal_instrumentation.hpp"
 #include "greedy_single_tree_traverser.hpp"
 
 #endif
@@ -192,8 +192,11 @@ inline util::Timers& IO::GetTimers()
  */
 inline util::Params IO::Parameters(const std::string& bindingName)
 {
-  // We don't need a mutex here, because we are only randomly accessing elements
-  // of the maps.
+  // The maps are not modified once the bindings are registered, but
+  // operator[] may insert a missing binding, so hold the locks; bindings may
+  // be started from several threads at once.
+  std::lock_guard<std::mutex> lock(GetSingleton().mapMutex);
+  std::lock_guard<std::mutex> docLock(GetSingleton().docMutex);
   std::map<char, std::string> resultAliases =
       GetSingleton().aliases[bindingName];
   // Merge in any persistent parameters (e.g. parameters in the "" binding map).
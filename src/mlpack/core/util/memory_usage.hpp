@@ -0,0 +1,215 @@
+/**
+ * @file core/util/memory_usage.hpp
+ *
+ * Accounting of the memory allocated by Armadillo and by the nodes of the
+ * trees, when mlpack is compiled with MLPACK_TRACK_MEMORY.
+ *
+ * This file is included by base.hpp before Armadillo, so it only depends on
+ * the standard library.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_MEMORY_USAGE_HPP
+#define MLPACK_CORE_UTIL_MEMORY_USAGE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * MemoryUsage counts the memory that is currently allocated by Armadillo
+ * matrices (those too large to be stored inside the matrix object) and by the
+ * nodes of the trees allocated through ArenaAllocated, and the peak of that
+ * memory.  The counts are kept for the whole process, so all threads
+ * contribute to them.
+ *
+ * Accounting is opt-in: it is only done if mlpack is compiled with
+ * MLPACK_TRACK_MEMORY defined (see config.hpp, or the TRACK_MEMORY CMake
+ * option); otherwise all counts stay at zero, and the accounting functions do
+ * nothing.  In that case Armadillo must not be included before mlpack, so that
+ * all Armadillo memory goes through TrackedAllocate() and TrackedFree().
+ *
+ * util::Timers uses these counts to record the peak memory and the number of
+ * allocations of each run of a timer.
+ */
+class MemoryUsage
+{
+ public:
+  //! Return whether or not memory is tracked (that is, whether mlpack was
+  //! compiled with MLPACK_TRACK_MEMORY).
+  static constexpr bool Enabled()
+  {
+    #ifdef MLPACK_TRACK_MEMORY
+    return true;
+    #else
+    return false;
+    #endif
+  }
+
+  /**
+   * Record an allocation of the given number of bytes.
+   *
+   * @param bytes Number of bytes that were allocated.
+   */
+  static void Allocated(const size_t bytes)
+  {
+    #ifdef MLPACK_TRACK_MEMORY
+    State& s = GetState();
+    const size_t current = (s.current += bytes);
+    ++s.allocations;
+    RaisePeak(current);
+    #else
+    (void) bytes;
+    #endif
+  }
+
+  /**
+   * Record that the given number of bytes were freed.
+   *
+   * @param bytes Number of bytes that were freed.
+   */
+  static void Freed(const size_t bytes)
+  {
+    #ifdef MLPACK_TRACK_MEMORY
+    GetState().current -= bytes;
+    #else
+    (void) bytes;
+    #endif
+  }
+
+  //! Get the number of bytes that are currently allocated.
+  static size_t Current() { return GetState().current; }
+
+  //! Get the largest number of bytes that were allocated at once since the
+  //! peak was last reset.
+  static size_t Peak() { return GetState().peak; }
+
+  //! Get the number of allocations so far.
+  static size_t Allocations() { return GetState().allocations; }
+
+  /**
+   * Set the peak to the memory that is currently allocated, and return the
+   * previous peak.  A phase of a program can then find its own peak with
+   * Peak(), and restore the peak of the enclosing phase with RaisePeak().
+   */
+  static size_t ResetPeak()
+  {
+    State& s = GetState();
+    return s.peak.exchange(s.current);
+  }
+
+  /**
+   * Set the peak to the given number of bytes, if it is lower.
+   *
+   * @param bytes Number of bytes that were allocated at once.
+   */
+  static void RaisePeak(const size_t bytes)
+  {
+    std::atomic<size_t>& peak = GetState().peak;
+    size_t oldPeak = peak;
+    while (oldPeak < bytes && !peak.compare_exchange_weak(oldPeak, bytes)) { }
+  }
+
+  /**
+   * Print the given number of bytes in a readable unit (for instance,
+   * "12.5 MB").
+   *
+   * @param bytes Number of bytes to print.
+   */
+  static std::string Print(const size_t bytes)
+  {
+    const char* units[] = { "B", "kB", "MB", "GB", "TB" };
+    double value = (double) bytes;
+    size_t unit = 0;
+    while (value >= 1024.0 && unit < 4)
+    {
+      value /= 1024.0;
+      ++unit;
+    }
+
+    std::ostringstream oss;
+    if (unit == 0)
+      oss << bytes << " B";
+    else
+      oss << std::fixed << std::setprecision(1) << value << " " << units[unit];
+    return oss.str();
+  }
+
+ private:
+  //! The counts, shared by all translation units.
+  struct State
+  {
+    State() : current(0), peak(0), allocations(0) { }
+
+    //! The number of bytes currently allocated.
+    std::atomic<size_t> current;
+    //! The peak number of bytes allocated.
+    std::atomic<size_t> peak;
+    //! The number of allocations.
+    std::atomic<size_t> allocations;
+  };
+
+  //! Get the counts.
+  static State& GetState()
+  {
+    static State state;
+    return state;
+  }
+};
+
+#ifdef MLPACK_TRACK_MEMORY
+
+//! The size of the prefix of each tracked allocation that holds its size; it
+//! keeps the memory aligned like std::max_align_t.
+constexpr size_t TrackedHeaderSize =
+    ((sizeof(size_t) + alignof(std::max_align_t) - 1) /
+    alignof(std::max_align_t)) * alignof(std::max_align_t);
+
+/**
+ * Allocate the given number of bytes, and record the allocation with
+ * MemoryUsage.  NULL is returned if the memory cannot be allocated.  This is
+ * the allocator of Armadillo when MLPACK_TRACK_MEMORY is defined.
+ *
+ * @param bytes Number of bytes to allocate.
+ */
+inline void* TrackedAllocate(const size_t bytes)
+{
+  char* memory = (char*) std::malloc(TrackedHeaderSize + bytes);
+  if (!memory)
+    return NULL;
+
+  *((size_t*) memory) = bytes;
+  MemoryUsage::Allocated(bytes);
+  return memory + TrackedHeaderSize;
+}
+
+/**
+ * Free memory allocated by TrackedAllocate(), and record it with MemoryUsage.
+ *
+ * @param ptr Memory to free.
+ */
+inline void TrackedFree(void* ptr)
+{
+  if (!ptr)
+    return;
+
+  char* memory = ((char*) ptr) - TrackedHeaderSize;
+  MemoryUsage::Freed(*((size_t*) memory));
+  std::free(memory);
+}
+
+#endif
+
+} // namespace util
+} // namespace mlpack
+
+#endif
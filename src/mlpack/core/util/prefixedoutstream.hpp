@@ -15,6 +15,9 @@
 
 #include <mlpack/base.hpp>
 
+#include <atomic>
+#include <mutex>
+
 namespace mlpack {
 namespace util {
 
@@ -42,6 +45,11 @@ namespace util {
  *
  * These objects are used for the mlpack::Log levels (DEBUG, INFO, WARN, and
  * FATAL).
+ *
+ * A PrefixedOutStream can be written to from several threads at once: each
+ * call to operator<< holds a lock, so that a line given in a single call is
+ * never interleaved with the output of other threads.  The ignoreInput and
+ * backtrace flags may also be changed while other threads are writing.
  */
 class PrefixedOutStream
 {
@@ -116,11 +124,11 @@ class PrefixedOutStream
   std::ostream& destination;
 
   //! Discards input, prints nothing if true.
-  bool ignoreInput;
+  std::atomic<bool> ignoreInput;
 
   //! If true, on a fatal error, a backtrace will be printed if
   //! MLPACK_HAS_BFD_DL is ! defined.
-  bool backtrace;
+  std::atomic<bool> backtrace;
 
  private:
   /**
@@ -166,6 +174,11 @@ class PrefixedOutStream
   //! If true, a std::runtime_error exception will be thrown when a CR is
   //! encountered.
   bool fatal;
+
+  //! Held by each call to BaseLogic(), so that writes from several threads
+  //! (and the carriageReturned state) are not interleaved.  It is recursive in
+  //! case the conversion of an object writes to the same stream.
+  std::recursive_mutex mutex;
 };
 
 } // namespace util
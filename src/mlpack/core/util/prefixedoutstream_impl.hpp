@@ -149,6 +149,8 @@ template<typename T>
 typename std::enable_if<!arma::is_arma_type<T>::value>::type
 PrefixedOutStream::BaseLogic(const T& val)
 {
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+
   // We will use this to track whether or not we need to terminate at the end of
   // this call (only for streams which terminate after a newline).
   bool newlined = false;
@@ -257,6 +259,8 @@ template<typename T>
 typename std::enable_if<arma::is_arma_type<T>::value>::type
 PrefixedOutStream::BaseLogic(const T& val)
 {
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+
   // Extract printable object from the input.
   const arma::Mat<typename T::elem_type>& printVal(val);
 
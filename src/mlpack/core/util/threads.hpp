@@ -0,0 +1,173 @@
+/**
+ * @file core/util/threads.hpp
+ *
+ * Functions to control the number of threads that mlpack (and the BLAS library
+ * it uses) runs with.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_THREADS_HPP
+#define MLPACK_CORE_UTIL_THREADS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <mutex>
+
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
+// The thread count functions of OpenBLAS and MKL are declared as weak symbols,
+// so that they are called if mlpack is linked against one of these libraries,
+// and ignored otherwise.  This needs an ELF platform.
+#if defined(__GNUC__) && defined(__ELF__)
+  #define MLPACK_HAS_WEAK_BLAS_THREADS
+
+extern "C" {
+void openblas_set_num_threads(int) __attribute__((weak));
+int openblas_get_num_threads() __attribute__((weak));
+void MKL_Set_Num_Threads(int) __attribute__((weak));
+int MKL_Get_Max_Threads() __attribute__((weak));
+}
+#endif
+
+namespace mlpack {
+
+/**
+ * Get the number of threads that the parallel code of mlpack will use (when
+ * called from within a parallel region, for regions nested in it).  This is 1
+ * if mlpack is compiled without OpenMP.
+ */
+inline size_t Threads()
+{
+  #ifdef MLPACK_USE_OPENMP
+  return (size_t) omp_get_max_threads();
+  #else
+  return 1;
+  #endif
+}
+
+/**
+ * Get the number of threads of the BLAS library, or 0 if it is not known
+ * (that is, if the library is neither OpenBLAS nor MKL).
+ */
+inline size_t BLASThreads()
+{
+  #ifdef MLPACK_HAS_WEAK_BLAS_THREADS
+  if (openblas_get_num_threads)
+    return (size_t) openblas_get_num_threads();
+  else if (MKL_Get_Max_Threads)
+    return (size_t) MKL_Get_Max_Threads();
+  #endif
+
+  return 0;
+}
+
+/**
+ * Set the number of threads of the BLAS library, if it is OpenBLAS or MKL;
+ * otherwise, nothing is done.  The BLAS thread count is shared by the whole
+ * process, so calls from different threads hold a lock.
+ *
+ * @param threads Number of threads.
+ */
+inline void SetBLASThreads(const size_t threads)
+{
+  #ifdef MLPACK_HAS_WEAK_BLAS_THREADS
+  static std::mutex blasThreadsMutex;
+  std::lock_guard<std::mutex> lock(blasThreadsMutex);
+  if (openblas_set_num_threads)
+    openblas_set_num_threads((int) threads);
+  if (MKL_Set_Num_Threads)
+    MKL_Set_Num_Threads((int) threads);
+  #else
+  (void) threads;
+  #endif
+}
+
+/**
+ * Set the number of threads that the parallel code of mlpack will use, and
+ * the number of threads of the BLAS library (if it is OpenBLAS or MKL).  All
+ * the parallel regions of mlpack that are started afterwards by the calling
+ * thread use at most this number of threads; regions nested in them run on
+ * one thread, unless nested parallelism is enabled with OpenMP (as
+ * KFoldCV::ParallelFolds() does, splitting the threads between the folds).
+ *
+ * When called from within a parallel region, only the regions started by the
+ * calling thread are affected.  The OpenMP thread count is a setting of the
+ * calling thread, so threads that run different mlpack calls at once (like
+ * Python threads calling bindings) can each set their own; the BLAS thread
+ * count is shared by the process.
+ *
+ * @param threads Number of threads; 0 uses one thread for each processor.
+ */
+inline void SetThreads(const size_t threads)
+{
+  #ifdef MLPACK_USE_OPENMP
+  const size_t numThreads = (threads == 0) ? (size_t) omp_get_num_procs() :
+      threads;
+  omp_set_num_threads((int) numThreads);
+  #else
+  const size_t numThreads = (threads == 0) ? 1 : threads;
+  #endif
+
+  SetBLASThreads(numThreads);
+}
+
+/**
+ * ScopedThreads sets the number of threads of mlpack and of the BLAS library
+ * (see SetThreads()) for the lifetime of the object, and restores the previous
+ * numbers when it is destroyed.  This limits the threads of a single call:
+ *
+ * @code
+ * {
+ *   // Train the forest with two threads only.
+ *   ScopedThreads threads(2);
+ *   rf.Train(data, labels, numClasses);
+ * }
+ * @endcode
+ */
+class ScopedThreads
+{
+ public:
+  /**
+   * Set the number of threads until the object is destroyed.
+   *
+   * @param threads Number of threads; 0 uses one thread for each processor.
+   */
+  ScopedThreads(const size_t threads) :
+      oldThreads(Threads()),
+      oldBLASThreads(BLASThreads())
+  {
+    SetThreads(threads);
+  }
+
+  //! Restore the previous number of threads.
+  ~ScopedThreads()
+  {
+    #ifdef MLPACK_USE_OPENMP
+    omp_set_num_threads((int) oldThreads);
+    #endif
+
+    if (oldBLASThreads > 0)
+      SetBLASThreads(oldBLASThreads);
+  }
+
+  // The object cannot be copied, or the number of threads would be restored
+  // twice.
+  ScopedThreads(const ScopedThreads&) = delete;
+  ScopedThreads& operator=(const ScopedThreads&) = delete;
+
+ private:
+  //! The number of threads of mlpack before the object was created.
+  size_t oldThreads;
+  //! The number of threads of the BLAS library before the object was created
+  //! (0 if it is not known).
+  size_t oldBLASThreads;
+};
+
+} // namespace mlpack
+
+#endif
@@ -22,6 +22,9 @@
 #include <mutex>
 #include <string>
 #include <thread> // std::thread is used for thread safety.
+#include <vector>
+
+#include "memory_usage.hpp"
 
 #if defined(_WIN32)
   // uint64_t isn't defined on every windows.
@@ -102,11 +105,34 @@ class Timer
 
 namespace util {
 
+/**
+ * The Timers class holds named timers.  Each timer sums the durations of all
+ * of its runs (from Start() to Stop()), and also keeps the number of runs and
+ * the shortest and longest one.  The runs of a timer may happen in different
+ * threads (for instance, inside an OpenMP parallel region), if each thread
+ * passes its own id to Start() and Stop(); the total is then the sum of the
+ * time spent by all threads.  ScopedTimer starts and stops a timer for a
+ * scope, and gives nested scopes hierarchical names.
+ *
+ * When memory is tracked (see MemoryUsage), each timer also keeps the peak
+ * memory of its runs and the number of allocations made during them.  These
+ * are counted for the whole process, and timers that run inside each other
+ * should be started and stopped in a nested order (as ScopedTimer does) for
+ * each of them to get its own peak.
+ *
+ * If Tracing() is set, every run is also recorded with the thread it ran on,
+ * so that the runs can be exported with ExportTrace() and displayed (for
+ * instance, with chrome://tracing or Perfetto) on a timeline.
+ */
 class Timers
 {
  public:
   //! Default to disabled.
-  Timers() : enabled(false) { }
+  Timers() :
+      enabled(false),
+      tracing(false),
+      traceStartTime(std::chrono::high_resolution_clock::now())
+  { }
 
   /**
    * Returns a copy of all the timers used via this interface.
@@ -156,27 +182,243 @@ class Timers
   void Stop(const std::string& timerName,
             const std::thread::id& threadId = std::thread::id());
 
+  /**
+   * Add the given duration to the timer, as if the timer had been started and
+   * stopped again that much later.  This is useful for time that was measured
+   * elsewhere, for instance summed over many short calls.
+   *
+   * @param timerName The name of the timer in question.
+   * @param duration The duration to add.
+   */
+  void Add(const std::string& timerName,
+           const std::chrono::microseconds& duration);
+
   /**
    * Stop all timers.
    */
   void StopAllTimers();
 
+  /**
+   * Get the number of runs of the given timer (the number of times it was
+   * stopped or added to).
+   *
+   * @param timerName The name of the timer in question.
+   */
+  size_t Count(const std::string& timerName);
+
+  /**
+   * Get the duration of the shortest run of the given timer (0 if it has not
+   * run).
+   *
+   * @param timerName The name of the timer in question.
+   */
+  std::chrono::microseconds Min(const std::string& timerName);
+
+  /**
+   * Get the duration of the longest run of the given timer (0 if it has not
+   * run).
+   *
+   * @param timerName The name of the timer in question.
+   */
+  std::chrono::microseconds Max(const std::string& timerName);
+
+  /**
+   * Get the largest number of bytes that were allocated at once during a run
+   * of the given timer (0 if memory is not tracked; see MemoryUsage).
+   *
+   * @param timerName The name of the timer in question.
+   */
+  size_t PeakMemory(const std::string& timerName);
+
+  /**
+   * Get the number of allocations made during the runs of the given timer (0
+   * if memory is not tracked; see MemoryUsage).
+   *
+   * @param timerName The name of the timer in question.
+   */
+  size_t Allocations(const std::string& timerName);
+
+  /**
+   * Write the runs recorded while Tracing() was set to the given stream, in
+   * the Chrome trace event format (JSON).  Each run is a complete event, with
+   * the index of the thread it ran on as its thread id.
+   *
+   * @param stream Stream to write the trace to.
+   */
+  void ExportTrace(std::ostream& stream);
+
+  /**
+   * Write the runs recorded while Tracing() was set to the given file, in the
+   * Chrome trace event format (JSON).  A std::runtime_error is thrown if the
+   * file cannot be opened.
+   *
+   * @param filename Name of the file to write the trace to.
+   */
+  void ExportTrace(const std::string& filename);
+
   //! Modify whether or not timing is enabled.
   std::atomic<bool>& Enabled() { return enabled; }
   //! Get whether or not timing is enabled.
   bool Enabled() const { return enabled; }
 
+  //! Modify whether or not the runs of the timers are recorded for
+  //! ExportTrace().
+  std::atomic<bool>& Tracing() { return tracing; }
+  //! Get whether or not the runs of the timers are recorded for
+  //! ExportTrace().
+  bool Tracing() const { return tracing; }
+
  private:
+  // ScopedTimer keeps the stack of scopes of each thread.
+  friend class ScopedTimer;
+
+  //! The statistics of the runs of a timer.
+  struct RunStatistics
+  {
+    //! The number of runs.
+    size_t count = 0;
+    //! The shortest run.
+    std::chrono::microseconds min = std::chrono::microseconds::max();
+    //! The longest run.
+    std::chrono::microseconds max = std::chrono::microseconds(0);
+    //! The peak memory of the runs.
+    size_t peakMemory = 0;
+    //! The number of allocations during the runs.
+    size_t allocations = 0;
+  };
+
+  //! The memory counts when a timer was started.
+  struct StartMemory
+  {
+    //! The peak memory before the timer was started.
+    size_t peak;
+    //! The number of allocations before the timer was started.
+    size_t allocations;
+  };
+
+  //! A run of a timer, recorded for the trace.
+  struct TraceEvent
+  {
+    //! The name of the timer.
+    std::string name;
+    //! The index of the thread of the run.
+    size_t thread;
+    //! The start of the run, from the creation (or reset) of the timers.
+    std::chrono::microseconds start;
+    //! The duration of the run.
+    std::chrono::microseconds duration;
+  };
+
+  /**
+   * Add a run of the given duration, peak memory and number of allocations to
+   * the given timer.  The mutex must be held.
+   */
+  void AddRun(const std::string& timerName,
+              const std::chrono::microseconds& duration,
+              const size_t peakMemory = 0,
+              const size_t allocations = 0);
+
+  /**
+   * Stop the given running timer of the given thread at the given time, and
+   * add its run.  The running timers should be stopped in the reverse order
+   * of their start, so that each gets its own peak memory.  The entries of the
+   * timer are not removed.  The mutex must be held.
+   */
+  void StopRun(const std::string& timerName,
+               const std::thread::id& threadId,
+               const std::chrono::high_resolution_clock::time_point& currTime);
+
+  /**
+   * Record the run of the given timer that started at the given time and
+   * lasted the given duration, in the given thread, if Tracing() is set.  The
+   * mutex must be held.
+   */
+  void AddTraceEvent(
+      const std::string& timerName,
+      const std::thread::id& threadId,
+      const std::chrono::high_resolution_clock::time_point& startTime,
+      const std::chrono::microseconds& duration);
+
   //! A map of all the timers that are being tracked.
   std::map<std::string, std::chrono::microseconds> timers;
+  //! The statistics of the runs of each timer.
+  std::map<std::string, RunStatistics> statistics;
   //! A mutex for modifying the timers.
   std::mutex timersMutex;
   //! A map for the starting values of the timers.
   std::map<std::thread::id, std::map<std::string,
       std::chrono::high_resolution_clock::time_point>> timerStartTime;
+  //! The memory counts when the running timers were started.
+  std::map<std::thread::id, std::map<std::string, StartMemory>>
+      timerStartMemory;
+
+  //! The names of the scopes of the ScopedTimers running in each thread.
+  std::map<std::thread::id, std::vector<std::string>> scopes;
+  //! The recorded runs.
+  std::vector<TraceEvent> traceEvents;
+  //! The index of each thread in the trace.
+  std::map<std::thread::id, size_t> threadIndices;
 
   //! Whether or not timing is enabled.
   std::atomic<bool> enabled;
+  //! Whether or not runs are recorded.
+  std::atomic<bool> tracing;
+  //! The origin of the times of the trace.
+  std::chrono::high_resolution_clock::time_point traceStartTime;
+};
+
+/**
+ * ScopedTimer runs a timer of a Timers object for the lifetime of the object,
+ * in the thread that creates it.  Timers of nested scopes of the same thread
+ * are named after the scopes that contain them, separated by slashes, so that
+ * they are never counted twice and the trace shows where the time of each
+ * scope goes:
+ *
+ * @code
+ * {
+ *   // This runs "training".
+ *   ScopedTimer t(timers, "training");
+ *   {
+ *     // This runs "training/tree_building".
+ *     ScopedTimer t2(timers, "tree_building");
+ *     ...
+ *   }
+ * }
+ * @endcode
+ *
+ * A ScopedTimer created in an OpenMP parallel region starts its own hierarchy
+ * in each thread; its runs in all threads are summed, and the trace shows each
+ * of them on its thread.
+ */
+class ScopedTimer
+{
+ public:
+  /**
+   * Start the timer with the given name, prefixed by the names of the
+   * ScopedTimers of the current thread that contain it.
+   *
+   * @param timers Timers object to run the timer in.
+   * @param name Name of the timer in its scope.
+   */
+  ScopedTimer(Timers& timers, const std::string& name);
+
+  //! Stop the timer.
+  ~ScopedTimer();
+
+  // A ScopedTimer cannot be copied, or the timer would be stopped twice.
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+  //! Get the full name of the timer.
+  const std::string& Name() const { return fullName; }
+
+ private:
+  //! The Timers object the timer runs in.
+  Timers& timers;
+  //! The full name of the timer.
+  std::string fullName;
+  //! Whether the timer was started (timing may be disabled).
+  bool started;
 };
 
 } // namespace util
@@ -17,8 +17,11 @@
 #include "io.hpp"
 #include "log.hpp"
 
+#include <algorithm>
+#include <fstream>
 #include <map>
 #include <string>
+#include <tuple>
 
 namespace mlpack {
 
@@ -76,7 +79,13 @@ inline void Timers::Reset()
 {
   std::lock_guard<std::mutex> lock(timersMutex);
   timers.clear();
+  statistics.clear();
   timerStartTime.clear();
+  timerStartMemory.clear();
+  scopes.clear();
+  traceEvents.clear();
+  threadIndices.clear();
+  traceStartTime = std::chrono::high_resolution_clock::now();
 }
 
 inline std::map<std::string, std::chrono::microseconds> Timers::GetAllTimers()
@@ -170,18 +179,27 @@ inline void Timers::StopAllTimers()
 
   std::chrono::high_resolution_clock::time_point currTime =
       std::chrono::high_resolution_clock::now();
+
+  // The timers are stopped from the last one started to the first one, so
+  // that nested timers get their own peak memory.
+  std::vector<std::tuple<std::chrono::high_resolution_clock::time_point,
+      std::thread::id, std::string>> running;
   for (auto it : timerStartTime)
-  {
     for (auto it2 : it.second)
-    {
-      timers[it2.first] +=
-          std::chrono::duration_cast<std::chrono::microseconds>(
-          currTime - it2.second);
-    }
-  }
+      running.push_back(std::make_tuple(it2.second, it.first, it2.first));
+  std::sort(running.begin(), running.end(),
+      [](const auto& a, const auto& b)
+      {
+        return std::get<0>(a) > std::get<0>(b);
+      });
+
+  for (size_t i = 0; i < running.size(); ++i)
+    StopRun(std::get<2>(running[i]), std::get<1>(running[i]), currTime);
 
   // If all timers are stopped, we can clear the maps.
   timerStartTime.clear();
+  timerStartMemory.clear();
+  scopes.clear();
 }
 
 inline void Timers::Start(const std::string& timerName,
@@ -212,6 +230,11 @@ inline void Timers::Start(const std::string& timerName,
   }
 
   timerStartTime[threadId][timerName] = currTime;
+
+  // The peak memory of the run starts from the memory allocated now.
+  StartMemory& startMemory = timerStartMemory[threadId][timerName];
+  startMemory.peak = MemoryUsage::ResetPeak();
+  startMemory.allocations = MemoryUsage::Allocations();
 }
 
 inline void Timers::Stop(const std::string& timerName,
@@ -232,17 +255,230 @@ inline void Timers::Stop(const std::string& timerName,
     throw std::runtime_error(error.str());
   }
 
-  std::chrono::high_resolution_clock::time_point currTime =
-      std::chrono::high_resolution_clock::now();
-
-  // Calculate the delta time.
-  timers[timerName] += std::chrono::duration_cast<std::chrono::microseconds>(
-      currTime - timerStartTime[threadId][timerName]);
+  StopRun(timerName, threadId, std::chrono::high_resolution_clock::now());
 
   // Remove the entries.
   timerStartTime[threadId].erase(timerName);
   if (timerStartTime[threadId].empty())
     timerStartTime.erase(threadId);
+  timerStartMemory[threadId].erase(timerName);
+  if (timerStartMemory[threadId].empty())
+    timerStartMemory.erase(threadId);
+}
+
+inline void Timers::Add(const std::string& timerName,
+                        const std::chrono::microseconds& duration)
+{
+  // Don't do anything if we aren't timing.
+  if (!enabled)
+    return;
+
+  std::lock_guard<std::mutex> lock(timersMutex);
+  AddRun(timerName, duration);
+}
+
+inline size_t Timers::Count(const std::string& timerName)
+{
+  std::lock_guard<std::mutex> lock(timersMutex);
+  std::map<std::string, RunStatistics>::const_iterator it =
+      statistics.find(timerName);
+  return (it == statistics.end()) ? 0 : it->second.count;
+}
+
+inline std::chrono::microseconds Timers::Min(const std::string& timerName)
+{
+  std::lock_guard<std::mutex> lock(timersMutex);
+  std::map<std::string, RunStatistics>::const_iterator it =
+      statistics.find(timerName);
+  return (it == statistics.end() || it->second.count == 0) ?
+      std::chrono::microseconds(0) : it->second.min;
+}
+
+inline std::chrono::microseconds Timers::Max(const std::string& timerName)
+{
+  std::lock_guard<std::mutex> lock(timersMutex);
+  std::map<std::string, RunStatistics>::const_iterator it =
+      statistics.find(timerName);
+  return (it == statistics.end()) ? std::chrono::microseconds(0) :
+      it->second.max;
+}
+
+inline size_t Timers::PeakMemory(const std::string& timerName)
+{
+  std::lock_guard<std::mutex> lock(timersMutex);
+  std::map<std::string, RunStatistics>::const_iterator it =
+      statistics.find(timerName);
+  return (it == statistics.end()) ? 0 : it->second.peakMemory;
+}
+
+inline size_t Timers::Allocations(const std::string& timerName)
+{
+  std::lock_guard<std::mutex> lock(timersMutex);
+  std::map<std::string, RunStatistics>::const_iterator it =
+      statistics.find(timerName);
+  return (it == statistics.end()) ? 0 : it->second.allocations;
+}
+
+inline void Timers::ExportTrace(std::ostream& stream)
+{
+  std::lock_guard<std::mutex> lock(timersMutex);
+
+  stream << "{\"traceEvents\": [";
+  for (size_t i = 0; i < traceEvents.size(); ++i)
+  {
+    const TraceEvent& e = traceEvents[i];
+
+    // Timer names are escaped as JSON strings.
+    std::string name;
+    for (const char c : e.name)
+    {
+      if (c == '"' || c == '\\')
+        name += '\\';
+      if ((unsigned char) c >= 0x20)
+        name += c;
+    }
+
+    stream << ((i == 0) ? "\n" : ",\n") << "  {\"name\": \"" << name
+        << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << e.thread
+        << ", \"ts\": " << e.start.count() << ", \"dur\": "
+        << e.duration.count() << "}";
+  }
+  stream << "\n], \"displayTimeUnit\": \"ms\"}" << std::endl;
+}
+
+inline void Timers::ExportTrace(const std::string& filename)
+{
+  std::ofstream stream(filename);
+  if (!stream.is_open())
+  {
+    throw std::runtime_error("Timers::ExportTrace(): cannot open '" +
+        filename + "' for writing!");
+  }
+
+  ExportTrace(stream);
+}
+
+inline void Timers::AddRun(const std::string& timerName,
+                           const std::chrono::microseconds& duration,
+                           const size_t peakMemory,
+                           const size_t allocations)
+{
+  timers[timerName] += duration;
+
+  RunStatistics& s = statistics[timerName];
+  ++s.count;
+  s.min = std::min(s.min, duration);
+  s.max = std::max(s.max, duration);
+  s.peakMemory = std::max(s.peakMemory, peakMemory);
+  s.allocations += allocations;
+}
+
+inline void Timers::StopRun(
+    const std::string& timerName,
+    const std::thread::id& threadId,
+    const std::chrono::high_resolution_clock::time_point& currTime)
+{
+  // Calculate the delta time.
+  const std::chrono::high_resolution_clock::time_point startTime =
+      timerStartTime[threadId][timerName];
+  const std::chrono::microseconds duration =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+      currTime - startTime);
+
+  // The peak of the enclosing timers must still include the peak from before
+  // this timer was started.
+  const StartMemory& startMemory = timerStartMemory[threadId][timerName];
+  const size_t peakMemory = MemoryUsage::Peak();
+  MemoryUsage::RaisePeak(startMemory.peak);
+  AddRun(timerName, duration, peakMemory,
+      MemoryUsage::Allocations() - startMemory.allocations);
+
+  // Timers of the default thread id are shown in the thread that stops them.
+  AddTraceEvent(timerName, (threadId == std::thread::id()) ?
+      std::this_thread::get_id() : threadId, startTime, duration);
+}
+
+inline void Timers::AddTraceEvent(
+    const std::string& timerName,
+    const std::thread::id& threadId,
+    const std::chrono::high_resolution_clock::time_point& startTime,
+    const std::chrono::microseconds& duration)
+{
+  if (!tracing)
+    return;
+
+  // Threads are numbered in the order they first appear in.
+  std::map<std::thread::id, size_t>::const_iterator it =
+      threadIndices.find(threadId);
+  size_t thread = threadIndices.size();
+  if (it == threadIndices.end())
+    threadIndices[threadId] = thread;
+  else
+    thread = it->second;
+
+  traceEvents.push_back({ timerName, thread,
+      std::chrono::duration_cast<std::chrono::microseconds>(
+      startTime - traceStartTime), duration });
+}
+
+inline ScopedTimer::ScopedTimer(Timers& timers, const std::string& name) :
+    timers(timers),
+    fullName(name),
+    started(false)
+{
+  if (!timers.Enabled())
+    return;
+
+  const std::thread::id threadId = std::this_thread::get_id();
+  {
+    std::lock_guard<std::mutex> lock(timers.timersMutex);
+    std::vector<std::string>& threadScopes = timers.scopes[threadId];
+    if (!threadScopes.empty())
+      fullName = threadScopes.back() + "/" + name;
+    threadScopes.push_back(fullName);
+  }
+
+  try
+  {
+    timers.Start(fullName, threadId);
+  }
+  catch (const std::runtime_error&)
+  {
+    // The timer is already running in this thread.
+    std::lock_guard<std::mutex> lock(timers.timersMutex);
+    timers.scopes[threadId].pop_back();
+    throw;
+  }
+
+  started = true;
+}
+
+inline ScopedTimer::~ScopedTimer()
+{
+  if (!started)
+    return;
+
+  const std::thread::id threadId = std::this_thread::get_id();
+  try
+  {
+    timers.Stop(fullName, threadId);
+  }
+  catch (const std::runtime_error&)
+  {
+    // The timers were reset or stopped while the scope was running; there is
+    // nothing to stop.
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(timers.timersMutex);
+  std::map<std::thread::id, std::vector<std::string>>::iterator it =
+      timers.scopes.find(threadId);
+  if (it != timers.scopes.end() && !it->second.empty())
+  {
+    it->second.pop_back();
+    if (it->second.empty())
+      timers.scopes.erase(it);
+  }
 }
 
 } // namespace util
@@ -191,21 +191,36 @@ void AdaBoost<WeakLearnerType, MatType>::Classify(
   probabilities.zeros(numClasses, test.n_cols);
   predictedLabels.set_size(test.n_cols);
 
-  for (size_t i = 0; i < wl.size(); ++i)
+  // The points are split into blocks that are classified in parallel.  Each
+  // weak learner still classifies a whole block at once, and the votes for
+  // each point are added in the same order as with a single thread.
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (test.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t b = 0; b < numBlocks; ++b)
   {
-    wl[i].Classify(test, predictedLabels);
+    const size_t begin = b * blockSize;
+    const size_t count = std::min(blockSize, (size_t) test.n_cols - begin);
 
-    for (size_t j = 0; j < predictedLabels.n_cols; ++j)
-      probabilities(predictedLabels(j), j) += alpha[i];
-  }
+    MatType block;
+    MakeAlias(block, test, test.n_rows, count, begin * test.n_rows);
+    arma::Row<size_t> blockLabels;
+    for (size_t i = 0; i < wl.size(); ++i)
+    {
+      wl[i].Classify(block, blockLabels);
 
-  arma::uword maxIndex = 0;
+      for (size_t j = 0; j < count; ++j)
+        probabilities(blockLabels(j), begin + j) += alpha[i];
+    }
 
-  for (size_t i = 0; i < predictedLabels.n_cols; ++i)
-  {
-    probabilities.col(i) /= accu(probabilities.col(i));
-    probabilities.col(i).max(maxIndex);
-    predictedLabels(i) = maxIndex;
+    arma::uword maxIndex = 0;
+    for (size_t j = begin; j < begin + count; ++j)
+    {
+      probabilities.col(j) /= accu(probabilities.col(j));
+      probabilities.col(j).max(maxIndex);
+      predictedLabels(j) = maxIndex;
+    }
   }
 }
 
@@ -391,6 +406,7 @@ typename MatType::elem_type AdaBoost<WeakLearnerType, MatType>::TrainInternal(
     w.Classify(tempData, predictedLabels);
 
     // Now, calculate alpha(t) using ht.
+    #pragma omp parallel for reduction(+: rt)
     for (size_t j = 0; j < D.n_cols; ++j) // instead of D, ht
     {
       if (predictedLabels(j) == labels(j))
@@ -420,10 +436,12 @@ typename MatType::elem_type AdaBoost<WeakLearnerType, MatType>::TrainInternal(
     alpha.push_back(alphat);
     wl.push_back(w);
 
-    // Now start modifying the weights.
+    // Now start modifying the weights.  Each point has its own column of D and
+    // of sumFinalH, so the points can be processed in parallel.
+    const ElemType expo = std::exp(alphat);
+    #pragma omp parallel for reduction(+: zt)
     for (size_t j = 0; j < D.n_cols; ++j)
     {
-      const ElemType expo = std::exp(alphat);
       if (predictedLabels(j) == labels(j))
       {
         for (size_t k = 0; k < D.n_rows; ++k)
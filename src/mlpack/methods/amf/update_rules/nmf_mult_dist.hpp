@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_LMF_UPDATE_RULES_NMF_MULT_DIST_UPDATE_RULES_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/sparse_products.hpp>
 
 namespace mlpack {
 
@@ -34,6 +35,10 @@ namespace mlpack {
  * This is a multiplicative rule that ensures that the Frobenius norm
  * \f$ \sqrt{\sum_i \sum_j(V-WH)^2} \f$ is non-increasing between subsequent
  * iterations. Both of the update rules for W and H are defined in this file.
+ *
+ * The products are grouped so that no matrix of the size of V is formed; when
+ * V is sparse, its products with W and H only visit its nonzero elements, and
+ * are computed in parallel with OpenMP.
  */
 class NMFMultiplicativeDistanceUpdate
 {
@@ -70,8 +75,16 @@ class NMFMultiplicativeDistanceUpdate
                              WHMatType& W,
                              const WHMatType& H)
   {
-    WHMatType zz = W * H * H.t();
-    W = (W % (V * H.t())) / (W * H * H.t() + 1e-15);
+    if constexpr (arma::is_SpMat<MatType>::value)
+    {
+      WHMatType vht;
+      SparseTimesDenseTrans(V, H, vht);
+      W = (W % vht) / (W * (H * H.t()) + 1e-15);
+    }
+    else
+    {
+      W = (W % (V * H.t())) / (W * (H * H.t()) + 1e-15);
+    }
   }
 
   /**
@@ -93,8 +106,16 @@ class NMFMultiplicativeDistanceUpdate
                              const WHMatType& W,
                              WHMatType& H)
   {
-    WHMatType zz = W.t() * W * H;
-    H = (H % (W.t() * V)) / (W.t() * W * H + 1e-15);
+    if constexpr (arma::is_SpMat<MatType>::value)
+    {
+      WHMatType wtv;
+      DenseTransTimesSparse(W, V, wtv);
+      H = (H % wtv) / ((W.t() * W) * H + 1e-15);
+    }
+    else
+    {
+      H = (H % (W.t() * V)) / ((W.t() * W) * H + 1e-15);
+    }
   }
 
   //! Serialize the object (in this case, there is nothing to serialize).
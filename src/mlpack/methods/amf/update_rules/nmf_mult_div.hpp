@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_LMF_UPDATE_RULES_NMF_MULT_DIV_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "nmf_sparse_quotient.hpp"
 
 namespace mlpack {
 
@@ -40,9 +41,10 @@ namespace mlpack {
  * is non-increasing between subsequent iterations. Both of the update rules
  * for W and H are defined in this file.
  *
- * This set of update rules is not meant to work with sparse matrices.  Using
- * sparse matrices often causes NaNs in the output, so other choices of update
- * rules are better in that situation.
+ * When V is sparse, V / (W H) is only computed at the nonzero elements of V
+ * (it is zero elsewhere), so W H is never formed as a dense matrix; the
+ * products with the quotient only visit its nonzero elements, and are
+ * computed in parallel with OpenMP.
  */
 class NMFMultiplicativeDivergenceUpdate
 {
@@ -80,9 +82,18 @@ class NMFMultiplicativeDivergenceUpdate
                              WHMatType& W,
                              const WHMatType& H)
   {
-    // Simple implementation left in the header file.
-    W %= ((V / (W * H + 1e-15)) * H.t()) /
-        (repmat(sum(H, 1).t(), W.n_rows, 1) + 1e-15);
+    if constexpr (arma::is_SpMat<MatType>::value)
+    {
+      WHMatType numerator;
+      SparseTimesDenseTrans(NMFSparseQuotient(V, W, H, 1e-15), H,
+          numerator);
+      W %= numerator / (repmat(sum(H, 1).t(), W.n_rows, 1) + 1e-15);
+    }
+    else
+    {
+      W %= ((V / (W * H + 1e-15)) * H.t()) /
+          (repmat(sum(H, 1).t(), W.n_rows, 1) + 1e-15);
+    }
   }
 
   /**
@@ -105,9 +116,18 @@ class NMFMultiplicativeDivergenceUpdate
                              const WHMatType& W,
                              WHMatType& H)
   {
-    // Simple implementation left in the header file.
-    H %= (W.t() * (V / (W * H + 1e-15))) /
-        (repmat(sum(W, 0).t(), 1, H.n_cols) + 1e-15);
+    if constexpr (arma::is_SpMat<MatType>::value)
+    {
+      WHMatType numerator;
+      DenseTransTimesSparse(W, NMFSparseQuotient(V, W, H, 1e-15),
+          numerator);
+      H %= numerator / (repmat(sum(W, 0).t(), 1, H.n_cols) + 1e-15);
+    }
+    else
+    {
+      H %= (W.t() * (V / (W * H + 1e-15))) /
+          (repmat(sum(W, 0).t(), 1, H.n_cols) + 1e-15);
+    }
   }
 
   //! Serialize the object (in this case, there is nothing to serialize).
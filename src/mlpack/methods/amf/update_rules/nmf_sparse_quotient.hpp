@@ -0,0 +1,68 @@
+/**
+ * @file methods/amf/update_rules/nmf_sparse_quotient.hpp
+ *
+ * The sparse quotient V / (W H) for the multiplicative NMF update rules.  It
+ * only visits the nonzero elements of V, never forms a dense matrix of the
+ * size of V, and is split between OpenMP threads.  The products with it are in
+ * core/math/sparse_products.hpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_AMF_UPDATE_RULES_NMF_SPARSE_QUOTIENT_HPP
+#define MLPACK_METHODS_AMF_UPDATE_RULES_NMF_SPARSE_QUOTIENT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/sparse_products.hpp>
+
+namespace mlpack {
+
+/**
+ * Compute V / (W * H) at the nonzero positions of V only; the result has the
+ * same sparsity pattern as V.  The positions where V is zero are zero in the
+ * quotient anyway, so (W * H) never needs to be computed there.
+ *
+ * @param V Sparse matrix.
+ * @param W Dense basis matrix.
+ * @param H Dense encoding matrix.
+ * @param epsilon Constant added to (W * H) to avoid division by zero.
+ * @return The sparse quotient.
+ */
+template<typename SpMatType, typename DenseMatType>
+arma::SpMat<typename DenseMatType::elem_type> NMFSparseQuotient(
+    const SpMatType& V,
+    const DenseMatType& W,
+    const DenseMatType& H,
+    const double epsilon)
+{
+  typedef typename DenseMatType::elem_type ElemType;
+
+  const DenseMatType wTrans = W.t();
+  const size_t rank = W.n_cols;
+
+  V.sync();
+  arma::Col<ElemType> values(V.n_nonzero);
+
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (size_t j = 0; j < V.n_cols; ++j)
+  {
+    const ElemType* h = H.colptr(j);
+    for (size_t k = V.col_ptrs[j]; k < V.col_ptrs[j + 1]; ++k)
+    {
+      const ElemType* w = wTrans.colptr(V.row_indices[k]);
+      ElemType wh = ElemType(epsilon);
+      for (size_t a = 0; a < rank; ++a)
+        wh += w[a] * h[a];
+      values[k] = ElemType(V.values[k]) / wh;
+    }
+  }
+
+  return arma::SpMat<ElemType>(arma::uvec(V.row_indices, V.n_nonzero),
+      arma::uvec(V.col_ptrs, V.n_cols + 1), values, V.n_rows, V.n_cols);
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,357 @@
+/**
+ * @file methods/amf/update_rules/svd_parallel_incremental_learning.hpp
+ *
+ * Parallel SVD incremental learning with stratified blocks of ratings, for use
+ * in AMF (Alternating Matrix Factorization).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_AMF_SVD_PARALLEL_INCREMENTAL_LEARNING_HPP
+#define MLPACK_METHODS_AMF_SVD_PARALLEL_INCREMENTAL_LEARNING_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * This class is a parallel version of SVDCompleteIncrementalLearning and
+ * SVDIncompleteIncrementalLearning.  The ratings are split into a grid of
+ * numBlocks x numBlocks blocks, by blocks of items and blocks of users, as in
+ * the stratified SGD of the following paper:
+ *
+ * @code
+ * @inproceedings{gemulla2011large,
+ *   title={Large-scale Matrix Factorization with Distributed Stochastic
+ *       Gradient Descent},
+ *   author={Gemulla, R. and Nijkamp, E. and Haas, P.J. and Sismanis, Y.},
+ *   booktitle={Proceedings of the 17th ACM SIGKDD International Conference on
+ *       Knowledge Discovery and Data Mining (KDD '11)},
+ *   pages={69--77},
+ *   year={2011}
+ * }
+ * @endcode
+ *
+ * A pass over the ratings has numBlocks steps; at each step, every thread
+ * processes one block, and no two blocks of a step share an item or a user,
+ * so the threads update disjoint rows of W and columns of H without any
+ * locking.  The blocks are chosen so that each block of items and each block
+ * of users holds about the same number of ratings.
+ *
+ * Inside a block, the ratings are processed in the same order and with the
+ * same updates as the sequential rules: after each rating if `complete` is
+ * true (SVDCompleteIncrementalLearning), or after all the ratings of a user in
+ * the block otherwise (SVDIncompleteIncrementalLearning).  So, with one block,
+ * one pass is exactly one pass of the sequential rule over all the ratings.
+ *
+ * Because W and H are updated together after each rating (or user), a whole
+ * pass over all the ratings is made by WUpdate() and HUpdate() does nothing;
+ * so, each iteration of AMF is one pass, and the termination policy should not
+ * be wrapped in CompleteIncrementalTermination or
+ * IncompleteIncrementalTermination.
+ *
+ * The input matrix is used in sparse form; if it is dense, a sparse copy is
+ * made in Initialize(), and in any case V must not change during the
+ * factorization.
+ *
+ * @see SVDCompleteIncrementalLearning, SVDIncompleteIncrementalLearning
+ */
+class SVDParallelIncrementalLearning
+{
+ public:
+  /**
+   * Initialize the SVDParallelIncrementalLearning class with the given
+   * parameters.
+   *
+   * @param u Step value used in incremental learning.
+   * @param kw Regularization constant for W matrix.
+   * @param kh Regularization constant for H matrix.
+   * @param complete If true, W and H are updated after each rating; otherwise,
+   *     they are updated after all the ratings of a user in a block.
+   * @param numBlocks Number of blocks of items and of users (0 means the
+   *     number of OpenMP threads).
+   */
+  SVDParallelIncrementalLearning(const double u = 0.0001,
+                                 const double kw = 0,
+                                 const double kh = 0,
+                                 const bool complete = true,
+                                 const size_t numBlocks = 0) :
+      u(u),
+      kw(kw),
+      kh(kh),
+      complete(complete),
+      numBlocks(numBlocks),
+      blocks(0)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Initialize parameters before factorization.  This splits the ratings into
+   * blocks, and stores a sparse copy of the dataset if it is dense.
+   *
+   * @param dataset Input matrix to be factorized.
+   * @param * (rank) Rank of factorization.
+   */
+  template<typename MatType>
+  void Initialize(const MatType& dataset, const size_t /* rank */)
+  {
+    if constexpr (arma::is_SpMat<MatType>::value)
+    {
+      datasetCopy.reset();
+      ComputeBlocks(dataset);
+    }
+    else
+    {
+      datasetCopy = arma::sp_mat(arma::conv_to<arma::mat>::from(dataset));
+      ComputeBlocks(datasetCopy);
+    }
+  }
+
+  /**
+   * Make one pass over all the ratings, updating both W and H.
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix to be updated.
+   * @param H Encoding matrix to be updated.
+   */
+  template<typename MatType, typename WHMatType>
+  inline void WUpdate(const MatType& V,
+                      WHMatType& W,
+                      const WHMatType& H)
+  {
+    // H is updated together with W; see the class documentation.
+    WHMatType& hRef = const_cast<WHMatType&>(H);
+    if constexpr (arma::is_SpMat<MatType>::value)
+      Pass(V, W, hRef);
+    else
+      Pass(datasetCopy, W, hRef);
+  }
+
+  /**
+   * Do nothing: H has already been updated by WUpdate().
+   *
+   * @param * (V) Input matrix to be factorized.
+   * @param * (W) Basis matrix.
+   * @param * (H) Encoding matrix.
+   */
+  template<typename MatType, typename WHMatType>
+  inline void HUpdate(const MatType& /* V */,
+                      const WHMatType& /* W */,
+                      WHMatType& /* H */)
+  {
+    // Nothing to do.
+  }
+
+  //! Get the step size.
+  double U() const { return u; }
+  //! Modify the step size.
+  double& U() { return u; }
+
+  //! Get the regularization constant of W.
+  double KW() const { return kw; }
+  //! Modify the regularization constant of W.
+  double& KW() { return kw; }
+
+  //! Get the regularization constant of H.
+  double KH() const { return kh; }
+  //! Modify the regularization constant of H.
+  double& KH() { return kh; }
+
+  //! Get whether W and H are updated after each rating.
+  bool Complete() const { return complete; }
+  //! Modify whether W and H are updated after each rating.
+  bool& Complete() { return complete; }
+
+  //! Get the number of blocks of items and users (0 means the number of
+  //! threads).
+  size_t NumBlocks() const { return numBlocks; }
+  //! Modify the number of blocks of items and users (0 means the number of
+  //! threads).  This takes effect at the next call to Initialize().
+  size_t& NumBlocks() { return numBlocks; }
+
+ private:
+  /**
+   * Split the items and the users of the given dataset into blocks with about
+   * the same number of ratings, and find where each block of items starts in
+   * each column.
+   */
+  template<typename SpMatType>
+  void ComputeBlocks(const SpMatType& dataset)
+  {
+    blocks = numBlocks;
+    if (blocks == 0)
+    {
+      #ifdef MLPACK_USE_OPENMP
+      blocks = omp_get_max_threads();
+      #else
+      blocks = 1;
+      #endif
+    }
+
+    dataset.sync();
+
+    // Count the ratings of each item and each user.
+    arma::Col<size_t> itemCounts(dataset.n_rows, arma::fill::zeros);
+    arma::Col<size_t> userCounts(dataset.n_cols);
+    for (size_t j = 0; j < dataset.n_cols; ++j)
+    {
+      userCounts[j] = dataset.col_ptrs[j + 1] - dataset.col_ptrs[j];
+      for (size_t k = dataset.col_ptrs[j]; k < dataset.col_ptrs[j + 1]; ++k)
+        ++itemCounts[dataset.row_indices[k]];
+    }
+
+    SplitCounts(itemCounts, dataset.n_nonzero, itemBounds);
+    SplitCounts(userCounts, dataset.n_nonzero, userBounds);
+
+    // The ratings of each column are sorted by item, so the ratings of each
+    // block of items are contiguous in the column.
+    blockStarts.set_size(blocks + 1, dataset.n_cols);
+    for (size_t j = 0; j < dataset.n_cols; ++j)
+    {
+      size_t k = dataset.col_ptrs[j];
+      for (size_t b = 0; b < blocks; ++b)
+      {
+        while (k < dataset.col_ptrs[j + 1] &&
+               dataset.row_indices[k] < itemBounds[b])
+          ++k;
+        blockStarts(b, j) = k;
+      }
+      blockStarts(blocks, j) = dataset.col_ptrs[j + 1];
+    }
+  }
+
+  /**
+   * Split the given counts into `blocks` contiguous ranges with about the same
+   * total; range b is [bounds[b], bounds[b + 1]).
+   */
+  void SplitCounts(const arma::Col<size_t>& counts,
+                   const size_t total,
+                   arma::Col<size_t>& bounds) const
+  {
+    bounds.set_size(blocks + 1);
+    bounds[0] = 0;
+    size_t index = 0, sum = 0;
+    for (size_t b = 1; b < blocks; ++b)
+    {
+      // Bucket b starts once b / blocks of the total has been reached.
+      const double target = ((double) total * b) / blocks;
+      while (index < counts.n_elem && (double) sum < target)
+        sum += counts[index++];
+      bounds[b] = index;
+    }
+    bounds[blocks] = counts.n_elem;
+  }
+
+  /**
+   * Make one pass over all the ratings of the given dataset.
+   */
+  template<typename SpMatType, typename WHMatType>
+  void Pass(const SpMatType& V, WHMatType& W, WHMatType& H) const
+  {
+    typedef typename WHMatType::elem_type ElemType;
+
+    V.sync();
+
+    for (size_t step = 0; step < blocks; ++step)
+    {
+      // At this step, the users of block b are paired with the items of block
+      // (b + step) % blocks, so the blocks of the step are independent.
+      #pragma omp parallel for schedule(dynamic)
+      for (size_t b = 0; b < blocks; ++b)
+      {
+        const size_t itemBlock = (b + step) % blocks;
+        for (size_t j = userBounds[b]; j < userBounds[b + 1]; ++j)
+        {
+          const size_t begin = blockStarts(itemBlock, j);
+          const size_t end = blockStarts(itemBlock + 1, j);
+          if (begin == end)
+            continue;
+
+          if (complete)
+          {
+            for (size_t k = begin; k < end; ++k)
+            {
+              const size_t i = V.row_indices[k];
+              const ElemType val = (ElemType) V.values[k];
+
+              arma::Row<ElemType> deltaW = (val - arma::dot(W.row(i),
+                  H.col(j))) * H.col(j).t();
+              if (kw != 0)
+                deltaW -= kw * W.row(i);
+              W.row(i) += u * deltaW;
+
+              arma::Col<ElemType> deltaH = (val - arma::dot(W.row(i),
+                  H.col(j))) * W.row(i).t();
+              if (kh != 0)
+                deltaH -= kh * H.col(j);
+              H.col(j) += u * deltaH;
+            }
+          }
+          else
+          {
+            // Each item appears once in the ratings of the user, so the rows
+            // of W can be updated right away.
+            for (size_t k = begin; k < end; ++k)
+            {
+              const size_t i = V.row_indices[k];
+              const ElemType val = (ElemType) V.values[k];
+              arma::Row<ElemType> deltaW = (val - arma::dot(W.row(i),
+                  H.col(j))) * H.col(j).t();
+              if (kw != 0)
+                deltaW -= kw * W.row(i);
+              W.row(i) += u * deltaW;
+            }
+
+            arma::Col<ElemType> deltaH(H.n_rows, arma::fill::zeros);
+            for (size_t k = begin; k < end; ++k)
+            {
+              const size_t i = V.row_indices[k];
+              const ElemType val = (ElemType) V.values[k];
+              deltaH += (val - arma::dot(W.row(i), H.col(j))) * W.row(i).t();
+            }
+
+            // The regularization of the user is split over its blocks, in
+            // proportion to its ratings in each block.
+            if (kh != 0)
+            {
+              const double fraction = double(end - begin) /
+                  double(V.col_ptrs[j + 1] - V.col_ptrs[j]);
+              deltaH -= (kh * fraction) * H.col(j);
+            }
+
+            H.col(j) += u * deltaH;
+          }
+        }
+      }
+    }
+  }
+
+  //! Step size of incremental learning.
+  double u;
+  //! Regularization parameter for matrix W.
+  double kw;
+  //! Regularization parameter for matrix H.
+  double kh;
+  //! Whether W and H are updated after each rating.
+  bool complete;
+  //! The requested number of blocks (0 means the number of threads).
+  size_t numBlocks;
+
+  //! The number of blocks used for the current factorization.
+  size_t blocks;
+  //! The first item of each block of items, and the number of items.
+  arma::Col<size_t> itemBounds;
+  //! The first user of each block of users, and the number of users.
+  arma::Col<size_t> userBounds;
+  //! The index of the first rating of each block of items in each column.
+  arma::Mat<size_t> blockStarts;
+  //! Sparse copy of the dataset, if it is dense.
+  arma::sp_mat datasetCopy;
+};
+
+} // namespace mlpack
+
+#endif
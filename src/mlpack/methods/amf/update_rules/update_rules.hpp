@@ -18,5 +18,7 @@
 #include "svd_batch_learning.hpp"
 #include "svd_incomplete_incremental_learning.hpp"
 #include "svd_complete_incremental_learning.hpp"
+#include "svd_parallel_incremental_learning.hpp"
+#include "weighted_als.hpp"
 
 #endif
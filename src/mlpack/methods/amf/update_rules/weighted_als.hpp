@@ -0,0 +1,276 @@
+/**
+ * @file methods/amf/update_rules/weighted_als.hpp
+ *
+ * Weighted alternating least squares update rule for sparse rating matrices.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_AMF_UPDATE_RULES_WEIGHTED_ALS_HPP
+#define MLPACK_METHODS_AMF_UPDATE_RULES_WEIGHTED_ALS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * This class implements weighted alternating least squares for sparse rating
+ * matrices, where only the nonzero elements of V are observed.  Each column of
+ * H (one user) and each row of W (one item) is the solution of its own small
+ * rank x rank regularized least squares system, which only involves the
+ * observed ratings of that user or item; the systems are solved in parallel.
+ *
+ * For explicit ratings, the objective is the one of the following paper:
+ *
+ * @code
+ * @inproceedings{zhou2008large,
+ *   title={Large-scale Parallel Collaborative Filtering for the Netflix
+ *       Prize},
+ *   author={Zhou, Y. and Wilkinson, D. and Schreiber, R. and Pan, R.},
+ *   booktitle={Algorithmic Aspects in Information and Management},
+ *   pages={337--348},
+ *   year={2008}
+ * }
+ * @endcode
+ *
+ * \f[
+ * \sum_{(i, j) observed} (V_{ij} - W_i H_j)^2 +
+ *     \lambda (\sum_i n_i \| W_i \|^2 + \sum_j n_j \| H_j \|^2),
+ * \f]
+ *
+ * where \f$ n_i \f$ and \f$ n_j \f$ are the numbers of observed ratings of
+ * item i and user j.
+ *
+ * For implicit feedback, the objective is the one of the following paper:
+ *
+ * @code
+ * @inproceedings{hu2008collaborative,
+ *   title={Collaborative Filtering for Implicit Feedback Datasets},
+ *   author={Hu, Y. and Koren, Y. and Volinsky, C.},
+ *   booktitle={Proceedings of the 8th IEEE International Conference on Data
+ *       Mining (ICDM '08)},
+ *   pages={263--272},
+ *   year={2008}
+ * }
+ * @endcode
+ *
+ * \f[
+ * \sum_{i, j} C_{ij} (P_{ij} - W_i H_j)^2 +
+ *     \lambda (\| W \|_F^2 + \| H \|_F^2),
+ * \f]
+ *
+ * where \f$ P_{ij} \f$ is 1 if \f$ V_{ij} \f$ is nonzero and 0 otherwise, and
+ * \f$ C_{ij} = 1 + \alpha V_{ij} \f$.  The sum is over all elements, but
+ * the contribution of the unobserved elements is the same for every user (or
+ * item), so it is computed once for each update.
+ *
+ * The transpose of V is computed in Initialize(), so that the observed ratings
+ * of each item are available without searching V; so, V must not change
+ * during the factorization.
+ */
+class WeightedALSUpdate
+{
+ public:
+  /**
+   * Initialize the WeightedALSUpdate class with the given parameters.
+   *
+   * @param lambda Regularization constant.
+   * @param implicit If true, V holds implicit feedback (for instance, counts of
+   *     interactions) instead of ratings.
+   * @param alpha Confidence scale of implicit feedback (ignored if implicit is
+   *     false).
+   */
+  WeightedALSUpdate(const double lambda = 0.01,
+                    const bool implicit = false,
+                    const double alpha = 40.0) :
+      lambda(lambda),
+      implicit(implicit),
+      alpha(alpha)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Set initial values for the factorization; this stores the transpose of the
+   * dataset.
+   *
+   * @param dataset Input matrix to be factorized.
+   * @param * (rank) Rank of factorization.
+   */
+  template<typename MatType>
+  void Initialize(const MatType& dataset, const size_t /* rank */)
+  {
+    if constexpr (arma::is_SpMat<MatType>::value)
+    {
+      arma::umat locations(2, dataset.n_nonzero);
+      arma::vec values(dataset.n_nonzero);
+      size_t i = 0;
+      for (typename MatType::const_iterator it = dataset.begin();
+           it != dataset.end(); ++it, ++i)
+      {
+        locations(0, i) = it.col();
+        locations(1, i) = it.row();
+        values[i] = (double) (*it);
+      }
+
+      datasetTrans = arma::sp_mat(locations, values, dataset.n_cols,
+          dataset.n_rows);
+    }
+    else
+    {
+      datasetTrans = arma::sp_mat(arma::conv_to<arma::mat>::from(dataset).t());
+    }
+  }
+
+  /**
+   * The update rule for the basis matrix W.  Each row of W is computed from the
+   * observed elements of the same row of V and the current H.
+   *
+   * @param * (V) Input matrix to be factorized (its transpose is used).
+   * @param W Basis matrix to be updated.
+   * @param H Encoding matrix.
+   */
+  template<typename MatType, typename WHMatType>
+  inline void WUpdate(const MatType& /* V */,
+                      WHMatType& W,
+                      const WHMatType& H)
+  {
+    WHMatType wTrans;
+    const WHMatType hTrans = H.t();
+    Solve(datasetTrans, hTrans, wTrans);
+    W = wTrans.t();
+  }
+
+  /**
+   * The update rule for the encoding matrix H.  Each column of H is computed
+   * from the observed elements of the same column of V and the current W.
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix.
+   * @param H Encoding matrix to be updated.
+   */
+  template<typename MatType, typename WHMatType>
+  inline void HUpdate(const MatType& V,
+                      const WHMatType& W,
+                      WHMatType& H)
+  {
+    if constexpr (arma::is_SpMat<MatType>::value)
+      Solve(V, W, H);
+    else
+      Solve(arma::sp_mat(arma::conv_to<arma::mat>::from(V)), W, H);
+  }
+
+  //! Get the regularization constant.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization constant.
+  double& Lambda() { return lambda; }
+
+  //! Get whether V holds implicit feedback.
+  bool Implicit() const { return implicit; }
+  //! Modify whether V holds implicit feedback.
+  bool& Implicit() { return implicit; }
+
+  //! Get the confidence scale of implicit feedback.
+  double Alpha() const { return alpha; }
+  //! Modify the confidence scale of implicit feedback.
+  double& Alpha() { return alpha; }
+
+  //! Serialize the WeightedALSUpdate object.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(lambda));
+    ar(CEREAL_NVP(implicit));
+    ar(CEREAL_NVP(alpha));
+  }
+
+ private:
+  /**
+   * Solve for each column of `factors` from the observed elements of the same
+   * column of `data` and the fixed factors of the rows of `data`.
+   *
+   * @param data Sparse data; each column is solved for separately.
+   * @param fixed Fixed factors, with one row for each row of data.
+   * @param factors Resulting factors, with one column for each column of data.
+   */
+  template<typename SpMatType, typename WHMatType>
+  void Solve(const SpMatType& data,
+             const WHMatType& fixed,
+             WHMatType& factors) const
+  {
+    typedef typename WHMatType::elem_type ElemType;
+
+    const size_t rank = fixed.n_cols;
+    factors.set_size(rank, data.n_cols);
+
+    // In the implicit case, every element contributes with confidence 1, so
+    // the Gram matrix of all the fixed factors is part of every system.
+    WHMatType gram;
+    if (implicit)
+      gram = fixed.t() * fixed;
+
+    // Make sure the CSC layout is up to date before it is used directly.
+    data.sync();
+
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t j = 0; j < data.n_cols; ++j)
+    {
+      // Collect the observed elements of column j directly from the CSC
+      // layout.
+      const size_t begin = data.col_ptrs[j];
+      const size_t count = data.col_ptrs[j + 1] - begin;
+      if (count == 0 && !implicit)
+      {
+        factors.col(j).zeros();
+        continue;
+      }
+
+      arma::uvec rows(count);
+      arma::Col<ElemType> values(count);
+      for (size_t k = 0; k < count; ++k)
+      {
+        rows[k] = data.row_indices[begin + k];
+        values[k] = (ElemType) data.values[begin + k];
+      }
+      const WHMatType observed = fixed.rows(rows);
+
+      WHMatType system;
+      arma::Col<ElemType> rhs;
+      if (implicit)
+      {
+        // C = 1 + alpha * V on the observed elements, and P is 1 there.
+        const arma::Col<ElemType> confidence = 1 + alpha * values;
+        system = gram + observed.t() *
+            (observed.each_col() % (confidence - 1));
+        system.diag() += lambda;
+        rhs = observed.t() * confidence;
+      }
+      else
+      {
+        system = observed.t() * observed;
+        system.diag() += lambda * count;
+        rhs = observed.t() * values;
+      }
+
+      arma::Col<ElemType> solution;
+      if (!arma::solve(solution, system, rhs))
+        solution.zeros(rank);
+      factors.col(j) = solution;
+    }
+  }
+
+  //! Regularization constant.
+  double lambda;
+  //! Whether V holds implicit feedback.
+  bool implicit;
+  //! Confidence scale of implicit feedback.
+  double alpha;
+  //! Transpose of the dataset, with one column for each row of the dataset.
+  arma::sp_mat datasetTrans;
+}; // class WeightedALSUpdate
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,204 @@
+/**
+ * @file methods/ann/activation_functions/fast_exp.hpp
+ *
+ * Definition of FastExp(), a branch-free approximation of the exponential
+ * function that the compiler can vectorize, and of FastApply(), which applies
+ * such an approximation to each element of a matrix.  These are used by the
+ * fast activation functions (FastLogisticFunction, FastTanhFunction,
+ * FastSwishFunction, FastGELUFunction and FastMishFunction).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_FAST_EXP_HPP
+#define MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_FAST_EXP_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <cstring>
+
+namespace mlpack {
+
+/**
+ * Constants used by FastExp() for each supported element type.  The input is
+ * clamped to [MinInput(), MaxInput()], so that the result is always a finite
+ * normal number; `Degree` is the degree of the polynomial used for e^r on
+ * [-ln(2) / 2, ln(2) / 2].
+ */
+template<typename eT>
+struct FastExpTraits;
+
+template<>
+struct FastExpTraits<double>
+{
+  typedef uint64_t UIntType;
+  static constexpr size_t Degree = 12;
+  static constexpr size_t MantissaBits = 52;
+  static constexpr UIntType ExponentBias = 1023;
+  static constexpr double MinInput() { return -708.0; }
+  static constexpr double MaxInput() { return 709.0; }
+  // 1.5 * 2^52: adding this rounds to the nearest integer, which is then kept
+  // in the lowest bits of the mantissa.
+  static constexpr double Shifter() { return 6755399441055744.0; }
+  // ln(2), split so that n * Ln2Hi() is exact for every n we use.
+  static constexpr double Ln2Hi() { return 6.93147180369123816490e-01; }
+  static constexpr double Ln2Lo() { return 1.90821492927058770002e-10; }
+};
+
+template<>
+struct FastExpTraits<float>
+{
+  typedef uint32_t UIntType;
+  static constexpr size_t Degree = 7;
+  static constexpr size_t MantissaBits = 23;
+  static constexpr UIntType ExponentBias = 127;
+  static constexpr float MinInput() { return -87.0f; }
+  static constexpr float MaxInput() { return 88.0f; }
+  // 1.5 * 2^23.
+  static constexpr float Shifter() { return 12582912.0f; }
+  static constexpr float Ln2Hi() { return 0.693145751953125f; }
+  static constexpr float Ln2Lo() { return 1.428606765330187045e-06f; }
+};
+
+/**
+ * Clamp x to [lower, upper]; NaN is propagated.  The bounds are selected with
+ * bit masks instead of branches or std::min() and std::max(): with the default
+ * floating-point settings, compilers do not vectorize a loop where a clamped
+ * value is used in further arithmetic.
+ */
+template<typename eT>
+inline eT FastClamp(const eT x, const eT lower, const eT upper)
+{
+  typedef typename FastExpTraits<eT>::UIntType UIntType;
+
+  UIntType bits, lowerBits, upperBits;
+  std::memcpy(&bits, &x, sizeof(eT));
+  std::memcpy(&lowerBits, &lower, sizeof(eT));
+  std::memcpy(&upperBits, &upper, sizeof(eT));
+
+  // All bits are set where the bound replaces x.
+  const UIntType belowMask = -((UIntType) (x < lower));
+  const UIntType aboveMask = -((UIntType) (x > upper));
+  bits = (bits & ~belowMask) | (lowerBits & belowMask);
+  bits = (bits & ~aboveMask) | (upperBits & aboveMask);
+
+  eT result;
+  std::memcpy(&result, &bits, sizeof(eT));
+  return result;
+}
+
+/**
+ * Evaluate the Taylor polynomial of e^r of degree `Degree` with Horner's rule,
+ * 1 + r (1 + r / 2 (1 + r / 3 (...))).  This is unrolled at compile time, so
+ * that loops calling FastExp() have no inner loop and can be vectorized.
+ */
+template<typename eT, size_t K, size_t Degree>
+struct FastExpPolynomial
+{
+  static eT Evaluate(const eT r)
+  {
+    return 1 + r * (eT(1) / eT(K)) *
+        FastExpPolynomial<eT, K + 1, Degree>::Evaluate(r);
+  }
+};
+
+template<typename eT, size_t Degree>
+struct FastExpPolynomial<eT, Degree, Degree>
+{
+  static eT Evaluate(const eT r) { return 1 + r * (eT(1) / eT(Degree)); }
+};
+
+/**
+ * Compute an approximation of e^x without branches or calls to libm, so that
+ * loops over many elements can be vectorized.  The input is reduced to
+ * x = n ln(2) + r with |r| <= ln(2) / 2; e^r is given by its Taylor
+ * polynomial, and 2^n is built directly from its bit pattern.
+ *
+ * For inputs in [-708, 709] (double) or [-87, 88] (float), the relative error
+ * is below 1e-15 for double and 5e-7 for float; inputs outside that range are
+ * clamped, so the result is never zero or infinite.  NaN is propagated.
+ *
+ * @param x Input value.
+ * @return Approximation of e^x.
+ */
+template<typename eT>
+inline eT FastExp(eT x)
+{
+  typedef FastExpTraits<eT> Traits;
+  typedef typename Traits::UIntType UIntType;
+
+  x = FastClamp(x, Traits::MinInput(), Traits::MaxInput());
+
+  // n = round(x / ln(2)), and r = x - n ln(2).
+  const eT shifted = x * eT(1.44269504088896340736) + Traits::Shifter();
+  const eT n = shifted - Traits::Shifter();
+  const eT r = (x - n * Traits::Ln2Hi()) - n * Traits::Ln2Lo();
+
+  const eT p = FastExpPolynomial<eT, 1, Traits::Degree>::Evaluate(r);
+
+  // The low bits of the mantissa of `shifted` hold n, and all the higher bits
+  // of the shifter are shifted out, so this gives the bit pattern of 2^n.
+  UIntType bits;
+  std::memcpy(&bits, &shifted, sizeof(eT));
+  bits = (bits + Traits::ExponentBias) << Traits::MantissaBits;
+  eT scale;
+  std::memcpy(&scale, &bits, sizeof(eT));
+
+  return p * scale;
+}
+
+/**
+ * Set `y` to the result of `f` on each element of `x`.  `x` and `y` must be
+ * dense matrices (they may be the same matrix); `f` should only use FastExp()
+ * and arithmetic, so that the loop is vectorized.
+ *
+ * @param x Input matrix.
+ * @param y Matrix to store the results into.
+ * @param f Function to apply to each element.
+ */
+template<typename InputVecType, typename OutputVecType, typename FunctionType>
+inline void FastApply(const InputVecType& x,
+                      OutputVecType& y,
+                      const FunctionType& f)
+{
+  y.set_size(arma::size(x));
+  const typename InputVecType::elem_type* in = x.memptr();
+  typename OutputVecType::elem_type* out = y.memptr();
+
+  #pragma omp simd
+  for (size_t i = 0; i < (size_t) x.n_elem; ++i)
+    out[i] = f(in[i]);
+}
+
+/**
+ * Set `dy` to the result of `f` on each pair of elements of `x` and `y`.
+ *
+ * @param x First input matrix.
+ * @param y Second input matrix, with the same size as `x`.
+ * @param dy Matrix to store the results into.
+ * @param f Function to apply to each pair of elements.
+ */
+template<typename InputVecType,
+         typename OutputVecType,
+         typename DerivVecType,
+         typename FunctionType>
+inline void FastApply(const InputVecType& x,
+                      const OutputVecType& y,
+                      DerivVecType& dy,
+                      const FunctionType& f)
+{
+  dy.set_size(arma::size(x));
+  const typename InputVecType::elem_type* in = x.memptr();
+  const typename OutputVecType::elem_type* out = y.memptr();
+  typename DerivVecType::elem_type* deriv = dy.memptr();
+
+  #pragma omp simd
+  for (size_t i = 0; i < (size_t) x.n_elem; ++i)
+    deriv[i] = f(in[i], out[i]);
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * @file methods/ann/activation_functions/fast_logistic_function.hpp
+ *
+ * Definition and implementation of a fast approximation of the logistic
+ * function.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_FAST_LOGISTIC_FUNCTION_HPP
+#define MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_FAST_LOGISTIC_FUNCTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "fast_exp.hpp"
+
+namespace mlpack {
+
+/**
+ * A fast approximation of the logistic function (see LogisticFunction),
+ *
+ * @f{eqnarray*}{
+ * f(x) &=& \frac{1}{1 + e^{-x}} \\
+ * f'(x) &=& f(x) * (1 - f(x))
+ * @f}
+ *
+ * where e^{-x} is computed with FastExp().  The loops over the elements are
+ * vectorized; the relative error of f(x) is below 1e-15 for double and 1e-6
+ * for float.
+ */
+class FastLogisticFunction
+{
+ public:
+  /**
+   * Computes the logistic function.
+   *
+   * @param x Input data.
+   * @return f(x).
+   */
+  template<typename eT>
+  static eT Fn(const eT x)
+  {
+    return eT(1) / (eT(1) + FastExp(-x));
+  }
+
+  /**
+   * Computes the logistic function.
+   *
+   * @param x Input data.
+   * @param y The resulting output activation.
+   */
+  template<typename InputVecType, typename OutputVecType>
+  static void Fn(const InputVecType& x, OutputVecType& y)
+  {
+    typedef typename InputVecType::elem_type eT;
+    FastApply(x, y, [](const eT v) { return Fn(v); });
+  }
+
+  /**
+   * Computes the first derivative of the logistic function.
+   *
+   * @param x Input activation.
+   * @param y Result of Fn(x).
+   * @return f'(x)
+   */
+  static double Deriv(const double /* x */, const double y)
+  {
+    return y * (1.0 - y);
+  }
+
+  /**
+   * Computes the first derivatives of the logistic function.
+   *
+   * @param x Input activation.
+   * @param y Result of Fn(x).
+   * @param dy The resulting derivatives.
+   */
+  template<typename InputVecType, typename OutputVecType, typename DerivVecType>
+  static void Deriv(const InputVecType& /* x */,
+                    const OutputVecType& y,
+                    DerivVecType& dy)
+  {
+    dy = y % (1.0 - y);
+  }
+}; // class FastLogisticFunction
+
+} // namespace mlpack
+
+#endif
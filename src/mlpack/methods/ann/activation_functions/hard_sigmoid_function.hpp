@@ -55,7 +55,7 @@ class HardSigmoidFunction
   {
     y.set_size(size(x));
 
-    #pragma omp for
+    #pragma omp parallel for
     for (size_t i = 0; i < (size_t) x.n_elem; ++i)
       y(i) = Fn(x(i));
   }
@@ -90,7 +90,7 @@ class HardSigmoidFunction
   {
     dy.set_size(size(y));
 
-    #pragma omp for
+    #pragma omp parallel for
     for (size_t i = 0; i < (size_t) y.n_elem; ++i)
     {
       dy(i) = Deriv(x(i), y(i));
@@ -73,7 +73,7 @@ class HardSwishFunction
   {
     y.set_size(size(x));
 
-    #pragma omp for
+    #pragma omp parallel for
     for (size_t i = 0; i < (size_t) x.n_elem; i++)
       y(i) = Fn(x(i));
   }
@@ -109,7 +109,7 @@ class HardSwishFunction
   {
     dy.set_size(size(x));
 
-    #pragma omp for
+    #pragma omp parallel for
     for (size_t i = 0; i < (size_t) x.n_elem; i++)
       dy(i) = Deriv(x(i), y(i));
   }
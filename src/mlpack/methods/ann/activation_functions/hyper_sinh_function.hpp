@@ -114,7 +114,7 @@ class HyperSinhFunction
                     DerivVecType& dy)
   {
     dy.set_size(size(y));
-    #pragma omp for
+    #pragma omp parallel for
     for (size_t i = 0; i < y.n_elem; ++i)
     {
       if (y(i) > 0)
@@ -64,9 +64,8 @@ class RectifierFunction
   template<typename MatType>
   static void Fn(const MatType& x, MatType& y)
   {
-    y.set_size(size(x));
-    y.zeros();
-    y = max(y, x);
+    // This is written so that `x` and `y` may be the same object.
+    y = clamp(x, 0, std::numeric_limits<typename MatType::elem_type>::max());
   }
 
   /**
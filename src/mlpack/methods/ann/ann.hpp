@@ -24,7 +24,9 @@
 #include "dists/dists.hpp"
 #include "init_rules/init_rules.hpp"
 #include "layer/layer.hpp"
+#include "layer_profiler.hpp"
 #include "loss_functions/loss_functions.hpp"
+#include "pipeline/pipeline.hpp"
 #include "regularizer/regularizer.hpp"
 
 #include "ffn.hpp"
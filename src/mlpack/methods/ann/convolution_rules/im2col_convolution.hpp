@@ -0,0 +1,602 @@
+/**
+ * @file methods/ann/convolution_rules/im2col_convolution.hpp
+ *
+ * Implementation of the convolution through matrix multiplication, by
+ * unfolding the patches of the input into the columns of a matrix (im2col).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_IM2COL_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_IM2COL_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "border_modes.hpp"
+
+namespace mlpack {
+
+/**
+ * Computes the two-dimensional convolution by unfolding every patch of the
+ * input that the filter is applied to into a column of a matrix (im2col), so
+ * that the convolution becomes a matrix multiplication.  This class allows the
+ * same specification of the border type as NaiveConvolution, and gives the same
+ * results.
+ *
+ * FullConvolution: returns the full two-dimensional convolution.
+ * ValidConvolution: returns only those parts of the convolution that are
+ * computed without the zero-padded edges.
+ *
+ * When it is used as a rule of the Convolution or GroupedConvolution layers,
+ * the layers do not convolve each input map with each filter separately;
+ * instead, the patches of all the input maps of a point are unfolded once, and
+ * all the output maps of the point (or the gradients of the backward pass and
+ * of the weights) are computed with a single BLAS matrix multiplication.  This
+ * is usually far faster than the other rules, at the cost of an unfolded
+ * matrix of (kernelWidth * kernelHeight * inMaps) x (outputWidth *
+ * outputHeight) elements per thread.  The ForwardLayer(), BackwardLayer() and
+ * GradientLayer() functions implement these passes.
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ */
+template<typename BorderMode = FullConvolution>
+class Im2ColConvolution
+{
+ public:
+  /**
+   * Perform a convolution (valid mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename InMatType, typename FilMatType, typename OutMatType,
+      typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, ValidConvolution>::value, void>::type
+  Convolution(const InMatType& input,
+              const FilMatType& filter,
+              OutMatType& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1,
+              const bool appending = false,
+              const typename std::enable_if_t<IsMatrix<InMatType>::value>* = 0)
+  {
+    typedef typename GetDenseMatType<InMatType>::type MatType;
+    typedef typename GetCubeType<InMatType>::type CubeType;
+
+    // As in NaiveConvolution, the x direction is along the columns.
+    CubeType inputCube;
+    MakeAlias(inputCube, input, input.n_rows, input.n_cols, 1);
+
+    MatType columns;
+    Im2Col(inputCube, filter.n_rows, filter.n_cols, dH, dW, dilationH,
+        dilationW, columns);
+
+    const size_t outputRows = OutputSize(input.n_rows, filter.n_rows, dH,
+        dilationH);
+    const size_t outputCols = OutputSize(input.n_cols, filter.n_cols, dW,
+        dilationW);
+    if (!appending)
+      output.zeros(outputRows, outputCols);
+
+    output += arma::reshape(columns.t() * arma::vectorise(filter), outputRows,
+        outputCols);
+  }
+
+  /**
+   * Perform a convolution (full mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename InMatType, typename FilMatType, typename OutMatType,
+      typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, FullConvolution>::value, void>::type
+  Convolution(const InMatType& input,
+              const FilMatType& filter,
+              OutMatType& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1,
+              const bool appending = false,
+              const typename std::enable_if_t<IsMatrix<InMatType>::value>* = 0)
+  {
+    // Pad the input by the size of the (dilated) filter minus one on each
+    // side, as NaiveConvolution does.
+    const size_t paddingRows = filter.n_rows * dilationH - dilationH;
+    const size_t paddingCols = filter.n_cols * dilationW - dilationW;
+
+    InMatType inputPadded(input.n_rows + 2 * paddingRows,
+        input.n_cols + 2 * paddingCols, arma::fill::zeros);
+    inputPadded.submat(paddingRows, paddingCols, paddingRows + input.n_rows - 1,
+        paddingCols + input.n_cols - 1) = input;
+
+    Im2ColConvolution<ValidConvolution>::Convolution(inputPadded, filter,
+        output, dW, dH, dilationW, dilationH, appending);
+  }
+
+  /**
+   * Perform a convolution using 3rd order tensors.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename CubeType>
+  static void Convolution(
+      const CubeType& input,
+      const CubeType& filter,
+      CubeType& output,
+      const size_t dW = 1,
+      const size_t dH = 1,
+      const size_t dilationW = 1,
+      const size_t dilationH = 1,
+      const bool appending = false,
+      const typename std::enable_if_t<IsCube<CubeType>::value>* = 0)
+  {
+    typedef typename GetDenseMatType<CubeType>::type MatType;
+    MatType convOutput;
+    Im2ColConvolution<BorderMode>::Convolution(input.slice(0),
+        filter.slice(0), convOutput, dW, dH, dilationW, dilationH, appending);
+
+    if (!appending)
+      output = CubeType(convOutput.n_rows, convOutput.n_cols, input.n_slices);
+
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      Im2ColConvolution<BorderMode>::Convolution(input.slice(i),
+          filter.slice(i), output.slice(i), dW, dH, dilationW, dilationH,
+          appending);
+    }
+  }
+
+  /**
+   * Perform a convolution using dense matrix as input and a 3rd order tensors
+   * as filter and output.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename MatType, typename CubeType>
+  static void Convolution(
+      const MatType& input,
+      const CubeType& filter,
+      CubeType& output,
+      const size_t dW = 1,
+      const size_t dH = 1,
+      const size_t dilationW = 1,
+      const size_t dilationH = 1,
+      const bool appending = false,
+      const typename std::enable_if_t<IsMatrix<MatType>::value>* = 0,
+      const typename std::enable_if_t<IsCube<CubeType>::value>* = 0)
+  {
+    MatType convOutput;
+    Im2ColConvolution<BorderMode>::Convolution(input, filter.slice(0),
+        convOutput, dW, dH, dilationW, dilationH, appending);
+
+    if (!appending)
+      output = CubeType(convOutput.n_rows, convOutput.n_cols, filter.n_slices);
+
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < filter.n_slices; ++i)
+    {
+      Im2ColConvolution<BorderMode>::Convolution(input, filter.slice(i),
+          output.slice(i), dW, dH, dilationW, dilationH, appending);
+    }
+  }
+
+  /**
+   * Perform a convolution using a 3rd order tensors as input and output and a
+   * dense matrix as filter.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename MatType, typename CubeType>
+  static void Convolution(
+      const CubeType& input,
+      const MatType& filter,
+      CubeType& output,
+      const size_t dW = 1,
+      const size_t dH = 1,
+      const size_t dilationW = 1,
+      const size_t dilationH = 1,
+      const bool appending = false,
+      const typename std::enable_if_t<IsMatrix<MatType>::value>* = 0,
+      const typename std::enable_if_t<IsCube<CubeType>::value>* = 0)
+  {
+    MatType convOutput;
+    Im2ColConvolution<BorderMode>::Convolution(input.slice(0), filter,
+        convOutput, dW, dH, dilationW, dilationH, appending);
+
+    if (!appending)
+      output = CubeType(convOutput.n_rows, convOutput.n_cols, input.n_slices);
+
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      Im2ColConvolution<BorderMode>::Convolution(input.slice(i), filter,
+          output.slice(i), dW, dH, dilationW, dilationH, appending);
+    }
+  }
+
+  /**
+   * Compute the forward pass of a convolution layer: every output map of every
+   * point is the sum of the (valid) convolutions of the input maps of its group
+   * with the corresponding filters.  The input and output hold the maps of the
+   * points one after another, and the filters are ordered by output map, then
+   * by input map, as in the Convolution and GroupedConvolution layers.
+   *
+   * @param input Input maps of all the points (inMaps slices per point).
+   * @param weight Filters ((maps * inMaps / groups) slices).
+   * @param inMaps Number of input maps of each point.
+   * @param groups Number of groups of maps (1 for a standard convolution).
+   * @param rowStride Stride of filter application along the rows.
+   * @param colStride Stride of filter application along the columns.
+   * @param output Output maps of all the points (maps slices per point); this
+   *     must already have the right size, and is overwritten.
+   */
+  template<typename CubeType>
+  static void ForwardLayer(const CubeType& input,
+                           const CubeType& weight,
+                           const size_t inMaps,
+                           const size_t groups,
+                           const size_t rowStride,
+                           const size_t colStride,
+                           CubeType& output)
+  {
+    typedef typename GetDenseMatType<CubeType>::type MatType;
+
+    const size_t inGroupSize = inMaps / groups;
+    const size_t maps = weight.n_slices / inGroupSize;
+    const size_t outGroupSize = maps / groups;
+    const size_t points = input.n_slices / inMaps;
+    const size_t inSize = input.n_rows * input.n_cols;
+    const size_t outSize = output.n_rows * output.n_cols;
+
+    // Each column holds all the filters of one output map.
+    MatType filters;
+    MakeAlias(filters, weight, weight.n_rows * weight.n_cols * inGroupSize,
+        maps);
+
+    #pragma omp parallel
+    {
+      CubeType groupInput;
+      MatType columns, pointOutput;
+
+      #pragma omp for schedule(dynamic)
+      for (size_t point = 0; point < points; ++point)
+      {
+        MakeAlias(pointOutput, output, outSize, maps, point * outSize * maps);
+        for (size_t group = 0; group < groups; ++group)
+        {
+          MakeAlias(groupInput, input, input.n_rows, input.n_cols, inGroupSize,
+              (point * inMaps + group * inGroupSize) * inSize);
+          Im2Col(groupInput, weight.n_rows, weight.n_cols, rowStride,
+              colStride, 1, 1, columns);
+
+          pointOutput.cols(group * outGroupSize,
+              (group + 1) * outGroupSize - 1) = columns.t() *
+              filters.cols(group * outGroupSize,
+                  (group + 1) * outGroupSize - 1);
+        }
+      }
+    }
+  }
+
+  /**
+   * Compute the backward pass of a convolution layer: the gradient of the
+   * error with respect to the input maps of ForwardLayer(), given the gradient
+   * with respect to its output maps.
+   *
+   * @param error Gradient with respect to the output maps (maps slices per
+   *     point).
+   * @param weight Filters ((maps * inMaps / groups) slices).
+   * @param inMaps Number of input maps of each point.
+   * @param groups Number of groups of maps (1 for a standard convolution).
+   * @param rowStride Stride of filter application along the rows.
+   * @param colStride Stride of filter application along the columns.
+   * @param delta Gradient with respect to the input maps (inMaps slices per
+   *     point); this must already have the size of the input of
+   *     ForwardLayer(), and is overwritten.
+   */
+  template<typename CubeType>
+  static void BackwardLayer(const CubeType& error,
+                            const CubeType& weight,
+                            const size_t inMaps,
+                            const size_t groups,
+                            const size_t rowStride,
+                            const size_t colStride,
+                            CubeType& delta)
+  {
+    typedef typename GetDenseMatType<CubeType>::type MatType;
+
+    const size_t inGroupSize = inMaps / groups;
+    const size_t maps = weight.n_slices / inGroupSize;
+    const size_t outGroupSize = maps / groups;
+    const size_t points = delta.n_slices / inMaps;
+    const size_t inSize = delta.n_rows * delta.n_cols;
+    const size_t outSize = error.n_rows * error.n_cols;
+
+    MatType filters;
+    MakeAlias(filters, weight, weight.n_rows * weight.n_cols * inGroupSize,
+        maps);
+
+    delta.zeros();
+
+    #pragma omp parallel
+    {
+      CubeType groupDelta;
+      MatType columns, pointError;
+
+      #pragma omp for schedule(dynamic)
+      for (size_t point = 0; point < points; ++point)
+      {
+        MakeAlias(pointError, error, outSize, maps, point * outSize * maps);
+        for (size_t group = 0; group < groups; ++group)
+        {
+          columns = filters.cols(group * outGroupSize,
+              (group + 1) * outGroupSize - 1) * pointError.cols(
+              group * outGroupSize, (group + 1) * outGroupSize - 1).t();
+
+          MakeAlias(groupDelta, delta, delta.n_rows, delta.n_cols, inGroupSize,
+              (point * inMaps + group * inGroupSize) * inSize);
+          Col2Im(columns, weight.n_rows, weight.n_cols, rowStride, colStride,
+              1, 1, groupDelta);
+        }
+      }
+    }
+  }
+
+  /**
+   * Compute the gradient of the error with respect to the filters of
+   * ForwardLayer(), given its input and the gradient with respect to its output
+   * maps.
+   *
+   * @param input Input maps of all the points (inMaps slices per point).
+   * @param error Gradient with respect to the output maps (maps slices per
+   *     point).
+   * @param inMaps Number of input maps of each point.
+   * @param groups Number of groups of maps (1 for a standard convolution).
+   * @param rowStride Stride of filter application along the rows.
+   * @param colStride Stride of filter application along the columns.
+   * @param gradient Gradient with respect to the filters; this must already
+   *     have the size of the filters, and is overwritten.
+   */
+  template<typename CubeType>
+  static void GradientLayer(const CubeType& input,
+                            const CubeType& error,
+                            const size_t inMaps,
+                            const size_t groups,
+                            const size_t rowStride,
+                            const size_t colStride,
+                            CubeType& gradient)
+  {
+    typedef typename GetDenseMatType<CubeType>::type MatType;
+
+    const size_t inGroupSize = inMaps / groups;
+    const size_t patchSize = gradient.n_rows * gradient.n_cols * inGroupSize;
+    const size_t maps = gradient.n_slices / inGroupSize;
+    const size_t outGroupSize = maps / groups;
+    const size_t points = input.n_slices / inMaps;
+    const size_t inSize = input.n_rows * input.n_cols;
+    const size_t outSize = error.n_rows * error.n_cols;
+
+    MatType gradientMat;
+    MakeAlias(gradientMat, gradient, patchSize, maps);
+    gradientMat.zeros();
+
+    #pragma omp parallel
+    {
+      // Each thread sums the gradient of its points separately.
+      MatType localGradient(patchSize, maps, arma::fill::zeros);
+      CubeType groupInput;
+      MatType columns, pointError;
+
+      #pragma omp for schedule(dynamic)
+      for (size_t point = 0; point < points; ++point)
+      {
+        MakeAlias(pointError, error, outSize, maps, point * outSize * maps);
+        for (size_t group = 0; group < groups; ++group)
+        {
+          MakeAlias(groupInput, input, input.n_rows, input.n_cols, inGroupSize,
+              (point * inMaps + group * inGroupSize) * inSize);
+          Im2Col(groupInput, gradient.n_rows, gradient.n_cols, rowStride,
+              colStride, 1, 1, columns);
+
+          localGradient.cols(group * outGroupSize,
+              (group + 1) * outGroupSize - 1) += columns * pointError.cols(
+              group * outGroupSize, (group + 1) * outGroupSize - 1);
+        }
+      }
+
+      #pragma omp critical
+      gradientMat += localGradient;
+    }
+  }
+
+  /**
+   * Unfold the patches of the given maps into the columns of a matrix: column
+   * i + j * outputRows holds the elements of the patch that the filter is
+   * applied to for output element (i, j), for each map in turn, in the same
+   * (column-major) order as the elements of the filters.
+   *
+   * @param input Maps to unfold.
+   * @param filterRows Number of rows of the filter.
+   * @param filterCols Number of columns of the filter.
+   * @param rowStride Stride of filter application along the rows.
+   * @param colStride Stride of filter application along the columns.
+   * @param rowDilation Dilation factor of the filter along the rows.
+   * @param colDilation Dilation factor of the filter along the columns.
+   * @param columns Matrix to store the unfolded patches into.
+   */
+  template<typename CubeType, typename MatType>
+  static void Im2Col(const CubeType& input,
+                     const size_t filterRows,
+                     const size_t filterCols,
+                     const size_t rowStride,
+                     const size_t colStride,
+                     const size_t rowDilation,
+                     const size_t colDilation,
+                     MatType& columns)
+  {
+    typedef typename CubeType::elem_type eT;
+
+    const size_t outputRows = OutputSize(input.n_rows, filterRows, rowStride,
+        rowDilation);
+    const size_t outputCols = OutputSize(input.n_cols, filterCols, colStride,
+        colDilation);
+    columns.set_size(filterRows * filterCols * input.n_slices,
+        outputRows * outputCols);
+
+    for (size_t j = 0; j < outputCols; ++j)
+    {
+      for (size_t i = 0; i < outputRows; ++i)
+      {
+        eT* columnPtr = columns.colptr(i + j * outputRows);
+        for (size_t s = 0; s < input.n_slices; ++s)
+        {
+          for (size_t kj = 0; kj < filterCols; ++kj)
+          {
+            const eT* inputPtr = input.slice_colptr(s, kj * colDilation +
+                j * colStride) + i * rowStride;
+            for (size_t ki = 0; ki < filterRows; ++ki, ++columnPtr,
+                inputPtr += rowDilation)
+              *columnPtr = *inputPtr;
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Fold the given columns back into maps, summing the elements of
+   * overlapping patches; this is the transpose of Im2Col().  The result is
+   * added to the given maps, which must already have the right size.
+   *
+   * @param columns Unfolded patches, as given by Im2Col().
+   * @param filterRows Number of rows of the filter.
+   * @param filterCols Number of columns of the filter.
+   * @param rowStride Stride of filter application along the rows.
+   * @param colStride Stride of filter application along the columns.
+   * @param rowDilation Dilation factor of the filter along the rows.
+   * @param colDilation Dilation factor of the filter along the columns.
+   * @param output Maps to add the folded patches to.
+   */
+  template<typename MatType, typename CubeType>
+  static void Col2Im(const MatType& columns,
+                     const size_t filterRows,
+                     const size_t filterCols,
+                     const size_t rowStride,
+                     const size_t colStride,
+                     const size_t rowDilation,
+                     const size_t colDilation,
+                     CubeType& output)
+  {
+    typedef typename CubeType::elem_type eT;
+
+    const size_t outputRows = OutputSize(output.n_rows, filterRows, rowStride,
+        rowDilation);
+    const size_t outputCols = OutputSize(output.n_cols, filterCols, colStride,
+        colDilation);
+
+    for (size_t j = 0; j < outputCols; ++j)
+    {
+      for (size_t i = 0; i < outputRows; ++i)
+      {
+        const eT* columnPtr = columns.colptr(i + j * outputRows);
+        for (size_t s = 0; s < output.n_slices; ++s)
+        {
+          for (size_t kj = 0; kj < filterCols; ++kj)
+          {
+            eT* outputPtr = output.slice_colptr(s, kj * colDilation +
+                j * colStride) + i * rowStride;
+            for (size_t ki = 0; ki < filterRows; ++ki, ++columnPtr,
+                outputPtr += rowDilation)
+              *outputPtr += *columnPtr;
+          }
+        }
+      }
+    }
+  }
+
+ private:
+  /**
+   * Compute the size of the (valid) convolution along one dimension.  Dilation
+   * only adds elements *between* filter elements, so e.g. a dilation of 2 on a
+   * filter of size 3 means an effective filter size of 5.
+   */
+  static size_t OutputSize(const size_t inputSize,
+                           const size_t filterSize,
+                           const size_t stride,
+                           const size_t dilation)
+  {
+    const size_t effectiveSize = filterSize * dilation - (dilation - 1);
+    return (inputSize - effectiveSize + stride) / stride;
+  }
+};  // class Im2ColConvolution
+
+/**
+ * Whether the given convolution rule is an Im2ColConvolution, so that the
+ * layers can compute their passes with ForwardLayer(), BackwardLayer() and
+ * GradientLayer().
+ */
+template<typename ConvolutionRule>
+struct IsIm2ColConvolution
+{
+  static const bool value = false;
+};
+
+template<typename BorderMode>
+struct IsIm2ColConvolution<Im2ColConvolution<BorderMode>>
+{
+  static const bool value = true;
+};
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,422 @@
+/**
+ * @file methods/ann/convolution_rules/winograd_convolution.hpp
+ *
+ * Implementation of the convolution with Winograd's minimal filtering
+ * algorithm F(2x2, 3x3).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_WINOGRAD_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_WINOGRAD_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "border_modes.hpp"
+#include "naive_convolution.hpp"
+
+namespace mlpack {
+
+/**
+ * Computes the two-dimensional convolution of an input with a 3x3 filter (with
+ * stride 1 and no dilation) with Winograd's minimal filtering algorithm
+ * F(2x2, 3x3): each 2x2 block of the output is computed from a 4x4 tile of the
+ * input with 16 multiplications instead of 36, as described in the following
+ * paper:
+ *
+ * @code
+ * @inproceedings{lavin2016fast,
+ *   title={Fast Algorithms for Convolutional Neural Networks},
+ *   author={Lavin, A. and Gray, S.},
+ *   booktitle={Proceedings of the IEEE Conference on Computer Vision and
+ *       Pattern Recognition (CVPR)},
+ *   pages={4013--4021},
+ *   year={2016}
+ * }
+ * @endcode
+ *
+ * For any other filter size, stride or dilation, the convolution is computed
+ * by NaiveConvolution instead.  This class allows specification of the type of
+ * the border type, and gives the same results as NaiveConvolution (up to
+ * floating-point rounding).
+ *
+ * FullConvolution: returns the full two-dimensional convolution.
+ * ValidConvolution: returns only those parts of the convolution that are
+ * computed without the zero-padded edges.
+ *
+ * The filter transform can be computed once with TransformFilter() and reused
+ * for many inputs with TransformedConvolution(); the Convolution layer does
+ * this when this class is its forward rule, so that the filters are only
+ * transformed once per forward pass (i.e., once per weight update).
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ */
+template<typename BorderMode = FullConvolution>
+class WinogradConvolution
+{
+ public:
+  /**
+   * Return whether the Winograd algorithm is used for a filter of the given
+   * size with the given strides and dilations.
+   */
+  static bool Supported(const size_t filterRows,
+                        const size_t filterCols,
+                        const size_t dW = 1,
+                        const size_t dH = 1,
+                        const size_t dilationW = 1,
+                        const size_t dilationH = 1)
+  {
+    return (filterRows == 3 && filterCols == 3 && dW == 1 && dH == 1 &&
+        dilationW == 1 && dilationH == 1);
+  }
+
+  /**
+   * Transform a 3x3 filter into the 4x4 matrix G g G^T used by
+   * TransformedConvolution().
+   *
+   * @param filter 3x3 filter to transform.
+   * @param transformedFilter Matrix to store the 4x4 transformed filter into.
+   */
+  template<typename FilMatType, typename OutMatType>
+  static void TransformFilter(const FilMatType& filter,
+                              OutMatType& transformedFilter)
+  {
+    typedef typename FilMatType::elem_type eT;
+
+    // First compute G g (4x3), then (G g) G^T.
+    eT temp[12];
+    for (size_t j = 0; j < 3; ++j)
+    {
+      const eT g0 = filter(0, j);
+      const eT g1 = filter(1, j);
+      const eT g2 = filter(2, j);
+      temp[4 * j] = g0;
+      temp[4 * j + 1] = (g0 + g1 + g2) / 2;
+      temp[4 * j + 2] = (g0 - g1 + g2) / 2;
+      temp[4 * j + 3] = g2;
+    }
+
+    transformedFilter.set_size(4, 4);
+    for (size_t i = 0; i < 4; ++i)
+    {
+      const eT g0 = temp[i];
+      const eT g1 = temp[4 + i];
+      const eT g2 = temp[8 + i];
+      transformedFilter(i, 0) = g0;
+      transformedFilter(i, 1) = (g0 + g1 + g2) / 2;
+      transformedFilter(i, 2) = (g0 - g1 + g2) / 2;
+      transformedFilter(i, 3) = g2;
+    }
+  }
+
+  /**
+   * Perform a (valid, stride 1) convolution of the input with a 3x3 filter
+   * that was transformed with TransformFilter().
+   *
+   * @param input Input used to perform the convolution (at least 3x3).
+   * @param transformedFilter Transformed filter, given by TransformFilter().
+   * @param output Output data that contains the results of the convolution.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename InMatType, typename FilMatType, typename OutMatType>
+  static void TransformedConvolution(const InMatType& input,
+                                     const FilMatType& transformedFilter,
+                                     OutMatType& output,
+                                     const bool appending = false)
+  {
+    typedef typename InMatType::elem_type eT;
+
+    const size_t outputRows = input.n_rows - 2;
+    const size_t outputCols = input.n_cols - 2;
+    if (!appending)
+      output.zeros(outputRows, outputCols);
+
+    const eT* u = transformedFilter.memptr();
+    eT d[16], t[16], m[16];
+    for (size_t tj = 0; tj < outputCols; tj += 2)
+    {
+      for (size_t ti = 0; ti < outputRows; ti += 2)
+      {
+        // Gather the 4x4 input tile; the tiles of the last row or column of
+        // an output with odd size extend one element past the input.
+        for (size_t c = 0; c < 4; ++c)
+        {
+          for (size_t r = 0; r < 4; ++r)
+          {
+            d[r + 4 * c] = (ti + r < input.n_rows && tj + c < input.n_cols) ?
+                input(ti + r, tj + c) : eT(0);
+          }
+        }
+
+        // Compute B^T d.
+        for (size_t c = 0; c < 16; c += 4)
+        {
+          t[c] = d[c] - d[c + 2];
+          t[c + 1] = d[c + 1] + d[c + 2];
+          t[c + 2] = d[c + 2] - d[c + 1];
+          t[c + 3] = d[c + 1] - d[c + 3];
+        }
+
+        // Compute (B^T d B) % u.
+        for (size_t r = 0; r < 4; ++r)
+        {
+          m[r] = (t[r] - t[r + 8]) * u[r];
+          m[r + 4] = (t[r + 4] + t[r + 8]) * u[r + 4];
+          m[r + 8] = (t[r + 8] - t[r + 4]) * u[r + 8];
+          m[r + 12] = (t[r + 4] - t[r + 12]) * u[r + 12];
+        }
+
+        // Compute A^T m A, and add it to the 2x2 output block.
+        for (size_t r = 0; r < 2 && ti + r < outputRows; ++r)
+        {
+          eT s[4];
+          for (size_t c = 0; c < 4; ++c)
+          {
+            s[c] = (r == 0) ? (m[4 * c] + m[4 * c + 1] + m[4 * c + 2]) :
+                (m[4 * c + 1] - m[4 * c + 2] - m[4 * c + 3]);
+          }
+
+          output(ti + r, tj) += s[0] + s[1] + s[2];
+          if (tj + 1 < outputCols)
+            output(ti + r, tj + 1) += s[1] - s[2] - s[3];
+        }
+      }
+    }
+  }
+
+  /**
+   * Perform a convolution (valid mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename InMatType, typename FilMatType, typename OutMatType,
+      typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, ValidConvolution>::value, void>::type
+  Convolution(const InMatType& input,
+              const FilMatType& filter,
+              OutMatType& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1,
+              const bool appending = false,
+              const typename std::enable_if_t<IsMatrix<InMatType>::value>* = 0)
+  {
+    if (!Supported(filter.n_rows, filter.n_cols, dW, dH, dilationW,
+        dilationH) || input.n_rows < 3 || input.n_cols < 3)
+    {
+      NaiveConvolution<ValidConvolution>::Convolution(input, filter, output,
+          dW, dH, dilationW, dilationH, appending);
+      return;
+    }
+
+    typename GetDenseMatType<FilMatType>::type transformedFilter;
+    TransformFilter(filter, transformedFilter);
+    TransformedConvolution(input, transformedFilter, output, appending);
+  }
+
+  /**
+   * Perform a convolution (full mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename InMatType, typename FilMatType, typename OutMatType,
+      typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, FullConvolution>::value, void>::type
+  Convolution(const InMatType& input,
+              const FilMatType& filter,
+              OutMatType& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1,
+              const bool appending = false,
+              const typename std::enable_if_t<IsMatrix<InMatType>::value>* = 0)
+  {
+    if (!Supported(filter.n_rows, filter.n_cols, dW, dH, dilationW,
+        dilationH))
+    {
+      NaiveConvolution<FullConvolution>::Convolution(input, filter, output,
+          dW, dH, dilationW, dilationH, appending);
+      return;
+    }
+
+    // Pad the input by two on each side.
+    InMatType inputPadded(input.n_rows + 4, input.n_cols + 4,
+        arma::fill::zeros);
+    inputPadded.submat(2, 2, input.n_rows + 1, input.n_cols + 1) = input;
+
+    WinogradConvolution<ValidConvolution>::Convolution(inputPadded, filter,
+        output, dW, dH, dilationW, dilationH, appending);
+  }
+
+  /**
+   * Perform a convolution using 3rd order tensors.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename CubeType>
+  static void Convolution(
+      const CubeType& input,
+      const CubeType& filter,
+      CubeType& output,
+      const size_t dW = 1,
+      const size_t dH = 1,
+      const size_t dilationW = 1,
+      const size_t dilationH = 1,
+      const bool appending = false,
+      const typename std::enable_if_t<IsCube<CubeType>::value>* = 0)
+  {
+    typedef typename GetDenseMatType<CubeType>::type MatType;
+    MatType convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input.slice(0),
+        filter.slice(0), convOutput, dW, dH, dilationW, dilationH, appending);
+
+    if (!appending)
+      output = CubeType(convOutput.n_rows, convOutput.n_cols, input.n_slices);
+
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input.slice(i),
+          filter.slice(i), output.slice(i), dW, dH, dilationW, dilationH,
+          appending);
+    }
+  }
+
+  /**
+   * Perform a convolution using dense matrix as input and a 3rd order tensors
+   * as filter and output.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename MatType, typename CubeType>
+  static void Convolution(
+      const MatType& input,
+      const CubeType& filter,
+      CubeType& output,
+      const size_t dW = 1,
+      const size_t dH = 1,
+      const size_t dilationW = 1,
+      const size_t dilationH = 1,
+      const bool appending = false,
+      const typename std::enable_if_t<IsMatrix<MatType>::value>* = 0,
+      const typename std::enable_if_t<IsCube<CubeType>::value>* = 0)
+  {
+    MatType convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input, filter.slice(0),
+        convOutput, dW, dH, dilationW, dilationH, appending);
+
+    if (!appending)
+      output = CubeType(convOutput.n_rows, convOutput.n_cols, filter.n_slices);
+
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < filter.n_slices; ++i)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input, filter.slice(i),
+          output.slice(i), dW, dH, dilationW, dilationH, appending);
+    }
+  }
+
+  /**
+   * Perform a convolution using a 3rd order tensors as input and output and a
+   * dense matrix as filter.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename MatType, typename CubeType>
+  static void Convolution(
+      const CubeType& input,
+      const MatType& filter,
+      CubeType& output,
+      const size_t dW = 1,
+      const size_t dH = 1,
+      const size_t dilationW = 1,
+      const size_t dilationH = 1,
+      const bool appending = false,
+      const typename std::enable_if_t<IsMatrix<MatType>::value>* = 0,
+      const typename std::enable_if_t<IsCube<CubeType>::value>* = 0)
+  {
+    MatType convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input.slice(0), filter,
+        convOutput, dW, dH, dilationW, dilationH, appending);
+
+    if (!appending)
+      output = CubeType(convOutput.n_rows, convOutput.n_cols, input.n_slices);
+
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input.slice(i), filter,
+          output.slice(i), dW, dH, dilationW, dilationH, appending);
+    }
+  }
+};  // class WinogradConvolution
+
+/**
+ * Whether the given convolution rule is a WinogradConvolution, so that the
+ * layers can transform their filters once with TransformFilter().
+ */
+template<typename ConvolutionRule>
+struct IsWinogradConvolution
+{
+  static const bool value = false;
+};
+
+template<typename BorderMode>
+struct IsWinogradConvolution<WinogradConvolution<BorderMode>>
+{
+  static const bool value = true;
+};
+
+} // namespace mlpack
+
+#endif
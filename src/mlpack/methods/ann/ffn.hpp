@@ -14,10 +14,13 @@
 #define MLPACK_METHODS_ANN_FFN_HPP
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/data/mapped_file.hpp>
 
 #include "forward_decls.hpp"
 #include "init_rules/init_rules.hpp"
 #include "loss_functions/loss_functions.hpp"
+#include "mixed_precision_function.hpp"
+#include "pipeline/pipeline_function.hpp"
 
 #include <ensmallen.hpp>
 
@@ -190,11 +193,64 @@ class FFN
                                     MatType responses,
                                     CallbackTypes&&... callbacks);
 
+  /**
+   * Train the network with mixed precision: the weights, activations and
+   * computations of the network use `MatType` (which should then be a
+   * reduced-precision type like `arma::fmat`), while the optimizer updates
+   * double-precision master weights, and dynamic loss scaling keeps small
+   * gradients from being lost in the backward pass.  See
+   * `MixedPrecisionFunction` for details; it can also be used directly, for
+   * other loss scaling settings.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors Input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the trained model (NaN or Inf on error).
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  double TrainMixedPrecision(MatType predictors,
+                             MatType responses,
+                             OptimizerType& optimizer,
+                             CallbackTypes&&... callbacks);
+
+  /**
+   * Train the network on the batches given by a pipeline (like
+   * `BatchPipeline`), instead of on matrices held in memory.  Each batch is
+   * loaded while the previous one is used, and shuffling only shuffles the
+   * order of the pipeline; so, the dataset can be larger than the memory.
+   * See `PipelineFunction` for details.  The optimizer must be a batch
+   * optimizer like ens::SGD or ens::Adam.
+   *
+   * @tparam PipelineType Type of the pipeline giving the batches.
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param pipeline Pipeline giving the batches of training points.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the trained model (NaN or Inf on error).
+   */
+  template<typename PipelineType,
+           typename OptimizerType,
+           typename... CallbackTypes>
+  typename MatType::elem_type TrainPipeline(PipelineType& pipeline,
+                                            OptimizerType& optimizer,
+                                            CallbackTypes&&... callbacks);
+
   /**
    * Predict the responses to a given set of predictors. The responses will be
    * the output of the output layer when `predictors` is passed through the
    * whole network (`OutputLayerType`).
    *
+   * Only the memory for inference is used: the outputs of the layers are not
+   * kept for a backward pass (see `MultiLayer::ForwardInference()`), so a
+   * manual `Backward()` must be preceded by `Forward()`.  With more than one
+   * worker (see `Workers()`), the batches are predicted in parallel.
+   *
    * @param predictors Input predictors.
    * @param results Matrix to put output predictions of responses into.
    * @param batchSize Batch size to use for prediction.
@@ -203,6 +259,66 @@ class FFN
                MatType& results,
                const size_t batchSize = 128);
 
+  /**
+   * Simplify a trained network for faster prediction.  Each BatchNorm layer
+   * that directly follows a layer that can absorb it (see
+   * `Layer::FoldAffine()`; for instance `Linear` and `Convolution`) is
+   * removed, and its normalization with the running mean and variance is
+   * folded into the weights and the bias of the previous layer.  The
+   * predictions of the network do not change (up to rounding), but since the
+   * BatchNorm layers are gone, the network should not be trained further.
+   *
+   * This should be called after training or after loading a trained model.
+   * Activations need no pass: `Predict()` always applies them in place on the
+   * output of the previous layer.
+   *
+   * @return The number of layers that were removed.
+   */
+  size_t FuseLayers();
+
+  /**
+   * Convert the layers of a trained network to 8-bit integer inference.  The
+   * given calibration data is passed through the network to find the range of
+   * the input of each layer; then, each layer that has a quantized version
+   * (see `Layer::Quantized()`; for instance `Linear` and `Convolution`) is
+   * replaced by it, with its weights quantized with one scale for each output
+   * and its inputs with one scale for the calibrated range.  The other layers
+   * keep using floating-point computations.
+   *
+   * The quantized network can be used with `Predict()` and serialized, but not
+   * trained.  It is best to call `FuseLayers()` first, so that BatchNorm layers
+   * are folded into the weights before they are quantized.
+   *
+   * @param calibrationData A representative sample of the input data.
+   * @return The number of layers that were quantized.
+   */
+  size_t Quantize(const MatType& calibrationData);
+
+  /**
+   * Prune the weights of a trained network for faster prediction.  Each layer
+   * that has a pruned version (see `Layer::Pruned()`; for instance `Linear` and
+   * `LinearNoBias`) is replaced by it: its weights are split into blocks of
+   * `blockRows` x `blockCols` weights, the given fraction of the blocks with
+   * the smallest magnitude is set to zero (see `PruneBlocks()`), and only the
+   * other blocks are stored, in a `BlockSparseLinear` layer.  The other layers
+   * are not changed.
+   *
+   * With 1x1 blocks, each weight is pruned individually; larger blocks (like
+   * 4x4) lose a little more accuracy at the same sparsity, but give faster
+   * inference.  The pruned network can be used with `Predict()` and
+   * serialized, but not trained.  It is best to call `FuseLayers()` first, so
+   * that BatchNorm layers are folded into the weights before they are pruned.
+   *
+   * @param sparsity Fraction of the blocks of weights of each layer to set to
+   *     zero, in [0, 1].
+   * @param blockRows Number of rows (outputs) of each block of weights.
+   * @param blockCols Number of columns (inputs) of each block of weights.
+   * @return The number of layers that were pruned.
+   */
+  size_t Prune(const double sparsity,
+               const size_t blockRows = 1,
+               const size_t blockCols = 1);
+
   // Return the number of weights in the model.
   size_t WeightSize();
 
@@ -239,6 +355,46 @@ class FFN
   //! time a forward pass is done.
   MatType& Parameters() { return parameters; }
 
+  //! Get the factor that the gradient of the loss is multiplied by before the
+  //! backward pass of `EvaluateWithGradient()` (for loss scaling; see
+  //! `MixedPrecisionFunction`).
+  double LossScale() const { return lossScale; }
+  //! Modify the loss scale.
+  double& LossScale() { return lossScale; }
+
+  /**
+   * Get the profiler that times the `Forward()`, `Backward()` and `Gradient()`
+   * methods of each layer of the network, or nullptr if the network is not
+   * profiled (the default).  With more than one worker (see `Workers()`), only
+   * the first shard of each batch is profiled.  See LayerProfiler.
+   */
+  LayerProfiler* Profiler() const { return network.Profiler(); }
+  //! Modify the profiler of the network; set it to nullptr to stop profiling.
+  LayerProfiler*& Profiler() { return network.Profiler(); }
+
+  /**
+   * Get the number of workers that each batch is split between for
+   * data-parallel training.  With more than one worker,
+   * `EvaluateWithGradient()` gives each worker a replica of the network (with
+   * its own workspaces and its own copy of the parameters, since some layers,
+   * such as DropConnect, write their weights during the forward pass) and a
+   * shard of the batch; the shards are passed forward and backward in
+   * parallel, and the gradients of the workers are summed with a tree
+   * reduction.  The loss of the output layer is computed on the whole batch,
+   * and the extra losses of the layers are summed over the shards, so the
+   * result is the same as with one worker (up to rounding), except for layers
+   * that use statistics of the batch: for
+   * example, BatchNorm normalizes each shard with its own statistics, and only
+   * the running statistics of the first worker are kept.  The default is 1 (no
+   * data parallelism).
+   *
+   * `Predict()` also uses the workers: the batches are split between the
+   * replicas, which are passed forward in parallel.
+   */
+  size_t Workers() const { return workers; }
+  //! Modify the number of workers for data-parallel training.
+  size_t& Workers() { return workers; }
+
   /**
    * Reset the stored data of the network entirely.  This resets all weights of
    * each layer using `InitializationRuleType`, and prepares the network to
@@ -322,6 +478,40 @@ class FFN
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
 
+  /**
+   * Save the network to the given file in a layout that LoadMapped() can use
+   * without copying the parameters: the parameters are stored as raw,
+   * page-aligned column-major data, followed by the binary serialization of
+   * the rest of the network (the layers, the output layer and the input
+   * dimensions).  The file is only valid on machines with the same endianness
+   * and word size.
+   *
+   * @param filename Name of the file to save to.
+   */
+  void SaveMapped(const std::string& filename);
+
+  /**
+   * Load a network that was saved with SaveMapped().  The architecture is
+   * deserialized as usual, but the parameters are not read: instead, the file
+   * is memory-mapped and the parameters point directly at the mapped data.
+   * This makes loading a large network nearly instantaneous, and several
+   * processes that load the same file share the same physical pages.
+   *
+   * The mapping is private: pages are only read from the file when they are
+   * first used, and changing the parameters (for instance by training the
+   * network) never modifies the file.  The mapping is released when the
+   * network is reloaded or destroyed.
+   *
+   * A std::runtime_error is thrown if the file is not a valid mapped network or
+   * if memory mapping is not supported on this platform.
+   *
+   * @param filename Name of the file to load from.
+   */
+  void LoadMapped(const std::string& filename);
+
+  //! Return whether the parameters are memory-mapped from a file.
+  bool IsMapped() const { return mappedFile != nullptr; }
+
   //
   // Only ensmallen utility functions for training are found below here.
   // They aren't generally useful otherwise.
@@ -450,6 +640,29 @@ class FFN
   //! SetWeightPtr() on each layer.
   void SetLayerMemory();
 
+  //! Copy the weights of all the layers into a new `parameters` matrix and make
+  //! the layers point at it; this is used after layers have been replaced or
+  //! removed.
+  void GatherParameters();
+
+  /**
+   * Make sure that there are at least `count` replicas of the network, and
+   * that the first `count` of them have their layers pointing at their own
+   * copy of the given parameters and are in the same mode as the network.
+   */
+  void PrepareReplicas(const size_t count, const MatType& parameters);
+
+  /**
+   * Compute the objective and the gradient of the given batch of training
+   * points, by splitting the batch between the replicas of the network (see
+   * `Workers()`).
+   */
+  typename MatType::elem_type ParallelEvaluateWithGradient(
+      const MatType& parameters,
+      const size_t begin,
+      MatType& gradient,
+      const size_t batchSize);
+
   /**
    * Ensure that all the locally-cached information about the network is valid,
    * all parameter memory is initialized, and we can make forward and backward
@@ -527,6 +740,33 @@ class FFN
    */
   MatType parameters;
 
+  /**
+   * If the network was loaded with LoadMapped(), this holds the mapping of the
+   * file that `parameters` points into.
+   */
+  std::shared_ptr<data::MappedFile> mappedFile;
+
+  //! The header at the start of files written by SaveMapped().
+  struct MappedHeader
+  {
+    //! Identifies the file type; always "MLPKFFNM".
+    char magic[8];
+    //! Version of the file layout.
+    uint64_t version;
+    //! Size of a single parameter, in bytes.
+    uint64_t elemSize;
+    //! Number of rows of the parameters.
+    uint64_t nRows;
+    //! Number of columns of the parameters.
+    uint64_t nCols;
+    //! Offset of the parameters in the file; this is page-aligned.
+    uint64_t dataOffset;
+    //! Offset of the serialized network (without parameters) in the file.
+    uint64_t modelOffset;
+    //! Size of the serialized network, in bytes.
+    uint64_t modelSize;
+  };
+
   //! Dimensions of input data.
   std::vector<size_t> inputDimensions;
 
@@ -539,6 +779,24 @@ class FFN
   //! except during training.
   MatType responses;
 
+  //! The factor that the gradient of the loss is multiplied by before the
+  //! backward pass.
+  double lossScale;
+
+  //! The number of workers that each batch is split between during training.
+  size_t workers;
+
+  //! The replicas of the network used by the workers other than the first one
+  //! (which uses `network`); the layers of each alias its copy of the
+  //! parameters in `replicaParameters`.
+  std::vector<MultiLayer<MatType>> replicas;
+
+  //! The copy of the parameters of each replica.
+  std::vector<MatType> replicaParameters;
+
+  //! The gradient of the shard of each replica.
+  std::vector<MatType> replicaGradients;
+
   //! Locally-stored output of the network from a forward pass; used by the
   //! backward pass.
   MatType networkOutput;
@@ -27,6 +27,8 @@ FFN<
 >::FFN(OutputLayerType outputLayer, InitializationRuleType initializeRule) :
     outputLayer(std::move(outputLayer)),
     initializeRule(std::move(initializeRule)),
+    lossScale(1.0),
+    workers(1),
     layerMemoryIsSet(false),
     inputDimensionsAreSet(false)
 {
@@ -48,6 +50,8 @@ FFN<
     inputDimensions(network.inputDimensions),
     predictors(network.predictors),
     responses(network.responses),
+    lossScale(network.lossScale),
+    workers(network.workers),
     // These will be set correctly in the first Forward() call.
     layerMemoryIsSet(false),
     inputDimensionsAreSet(false)
@@ -67,9 +71,12 @@ FFN<
     initializeRule(std::move(network.initializeRule)),
     network(std::move(network.network)),
     parameters(std::move(network.parameters)),
+    mappedFile(std::move(network.mappedFile)),
     inputDimensions(std::move(network.inputDimensions)),
     predictors(std::move(network.predictors)),
     responses(std::move(network.responses)),
+    lossScale(network.lossScale),
+    workers(network.workers),
     // Aliases will not be correct after a std::move(), so we will manually
     // reset them.
     layerMemoryIsSet(false),
@@ -92,10 +99,18 @@ FFN<OutputLayerType, InitializationRuleType, MatType>& FFN<
     outputLayer = other.outputLayer;
     initializeRule = other.initializeRule;
     network = other.network;
+    // A copy owns its parameters, so do not copy them into a mapped file.
+    if (mappedFile)
+    {
+      parameters.reset();
+      mappedFile.reset();
+    }
     parameters = other.parameters;
     inputDimensions = other.inputDimensions;
     predictors = other.predictors;
     responses = other.responses;
+    lossScale = other.lossScale;
+    workers = other.workers;
     networkOutput = other.networkOutput;
     networkDelta = other.networkDelta;
     error = other.error;
@@ -124,9 +139,13 @@ FFN<OutputLayerType, InitializationRuleType, MatType>& FFN<
     initializeRule = std::move(other.initializeRule);
     network = std::move(other.network);
     parameters = std::move(other.parameters);
+    // This must come after the parameters, which may point into the mapping.
+    mappedFile = std::move(other.mappedFile);
     inputDimensions = std::move(other.inputDimensions);
     predictors = std::move(other.predictors);
     responses = std::move(other.responses);
+    lossScale = other.lossScale;
+    workers = other.workers;
     networkOutput = std::move(other.networkOutput);
     networkDelta = std::move(other.networkDelta);
     error = std::move(other.error);
@@ -157,6 +176,11 @@ typename MatType::elem_type FFN<
   // Ensure that the network can be used.
   CheckNetwork("FFN::Train()", this->predictors.n_rows, true, true);
 
+  // The replicas for data-parallel training are built for the current network
+  // when they are first needed.
+  replicas.clear();
+  replicaParameters.clear();
+
   // Train the model.
   Timer::Start("ffn_optimization");
   const typename MatType::elem_type out =
@@ -185,6 +209,95 @@ typename MatType::elem_type FFN<
       callbacks...);
 }
 
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+template<typename OptimizerType, typename... CallbackTypes>
+double FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::TrainMixedPrecision(MatType predictors,
+                       MatType responses,
+                       OptimizerType& optimizer,
+                       CallbackTypes&&... callbacks)
+{
+  ResetData(std::move(predictors), std::move(responses));
+
+  WarnMessageMaxIterations<OptimizerType>(optimizer, this->predictors.n_cols);
+
+  // Ensure that the network can be used.
+  CheckNetwork("FFN::TrainMixedPrecision()", this->predictors.n_rows, true,
+      true);
+  replicas.clear();
+  replicaParameters.clear();
+
+  // The optimizer works on double-precision master weights; the network only
+  // holds a rounded copy of them.
+  arma::mat masterParameters = arma::conv_to<arma::mat>::from(parameters);
+  MixedPrecisionFunction<FFN> function(*this);
+
+  Timer::Start("ffn_optimization");
+  const double out = optimizer.Optimize(function, masterParameters,
+      callbacks...);
+  Timer::Stop("ffn_optimization");
+
+  function.SetParameters(masterParameters);
+
+  Log::Info << "FFN::TrainMixedPrecision(): final objective of trained model "
+      << "is " << out << "." << std::endl;
+  return out;
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+template<typename PipelineType,
+         typename OptimizerType,
+         typename... CallbackTypes>
+typename MatType::elem_type FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::TrainPipeline(PipelineType& pipeline,
+                 OptimizerType& optimizer,
+                 CallbackTypes&&... callbacks)
+{
+  if (pipeline.NumPoints() == 0)
+  {
+    throw std::invalid_argument("FFN::TrainPipeline(): the pipeline has no "
+        "training points!");
+  }
+
+  // Take a first point from the pipeline to find the dimensionality of the
+  // data.
+  MatType predictorsBatch, responsesBatch;
+  pipeline.Batch(0, 1, predictorsBatch, responsesBatch);
+  ResetData(std::move(predictorsBatch), std::move(responsesBatch));
+
+  WarnMessageMaxIterations<OptimizerType>(optimizer, pipeline.NumPoints());
+
+  // Ensure that the network can be used.
+  CheckNetwork("FFN::TrainPipeline()", this->predictors.n_rows, true, true);
+  replicas.clear();
+  replicaParameters.clear();
+
+  PipelineFunction<FFN, PipelineType> function(*this, pipeline);
+
+  Timer::Start("ffn_optimization");
+  const typename MatType::elem_type out =
+      optimizer.Optimize(function, parameters, callbacks...);
+  Timer::Stop("ffn_optimization");
+
+  // The training data of the network is an alias of a batch of the pipeline,
+  // which may not outlive the network.
+  ResetData(MatType(), MatType());
+
+  Log::Info << "FFN::TrainPipeline(): final objective of trained model is "
+      << out << "." << std::endl;
+  return out;
+}
+
 template<typename OutputLayerType,
          typename InitializationRuleType,
          typename MatType>
@@ -199,22 +312,164 @@ void FFN<
 
   results.set_size(network.OutputSize(), predictors.n_cols);
 
-  for (size_t i = 0; i < predictors.n_cols; i += batchSize)
+  // With more than one worker, each worker predicts a contiguous range of
+  // batches with its own replica (and so its own inference workspace).
+  const size_t batches = (predictors.n_cols + batchSize - 1) / batchSize;
+  const size_t shards = std::max(std::min(workers, batches), size_t(1));
+  if (shards > 1)
+    PrepareReplicas(shards - 1, parameters);
+
+  #pragma omp parallel for schedule(static) if (shards > 1)
+  for (size_t s = 0; s < shards; ++s)
   {
-    const size_t effectiveBatchSize = std::min(batchSize,
-        size_t(predictors.n_cols) - i);
+    MultiLayer<MatType>& worker = (s == 0) ? network : replicas[s - 1];
+    for (size_t b = s * batches / shards; b < (s + 1) * batches / shards; ++b)
+    {
+      const size_t i = b * batchSize;
+      const size_t effectiveBatchSize = std::min(batchSize,
+          size_t(predictors.n_cols) - i);
 
-    MatType predictorAlias, resultAlias;
+      MatType predictorAlias, resultAlias;
 
-    MakeAlias(predictorAlias, predictors, predictors.n_rows,
-        effectiveBatchSize, i * predictors.n_rows);
-    MakeAlias(resultAlias, results, results.n_rows, effectiveBatchSize,
-        i * results.n_rows);
+      MakeAlias(predictorAlias, predictors, predictors.n_rows,
+          effectiveBatchSize, i * predictors.n_rows);
+      MakeAlias(resultAlias, results, results.n_rows, effectiveBatchSize,
+          i * results.n_rows);
 
-    network.Forward(predictorAlias, resultAlias);
+      // No backward pass will follow, so the intermediate outputs need not be
+      // kept.
+      worker.ForwardInference(predictorAlias, resultAlias);
+    }
   }
 }
 
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+size_t FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::FuseLayers()
+{
+  if (parameters.is_empty() || inputDimensions.empty())
+  {
+    throw std::invalid_argument("FFN::FuseLayers(): the network must be "
+        "trained or loaded before its layers can be fused!");
+  }
+
+  // Make sure the dimensions and the weights of each layer are set, and that
+  // the BatchNorm layers use their running statistics.
+  CheckNetwork("FFN::FuseLayers()", 0, true, false);
+
+  std::vector<Layer<MatType>*>& layers = network.Network();
+  size_t removed = 0;
+  for (size_t i = 1; i < layers.size(); ++i)
+  {
+    BatchNormType<MatType>* batchNorm =
+        dynamic_cast<BatchNormType<MatType>*>(layers[i]);
+    if (batchNorm == nullptr)
+      continue;
+
+    MatType scale, shift;
+    batchNorm->InferenceAffine(scale, shift);
+    if (!layers[i - 1]->FoldAffine(scale, shift))
+      continue;
+
+    network.Remove(i);
+    --i;
+    ++removed;
+  }
+
+  if (removed > 0)
+    GatherParameters();
+
+  return removed;
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+size_t FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Quantize(const MatType& calibrationData)
+{
+  CheckNetwork("FFN::Quantize()", calibrationData.n_rows, true, false);
+
+  // Pass the calibration data through the network, and keep the range of the
+  // input of each layer.
+  std::vector<Layer<MatType>*>& layers = network.Network();
+  std::vector<double> inputRanges(layers.size());
+  MatType layerInput = calibrationData;
+  MatType layerOutput;
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    inputRanges[i] = (double) arma::max(arma::abs(vectorise(layerInput)));
+    layerOutput.set_size(layers[i]->OutputSize(), layerInput.n_cols);
+    layers[i]->Forward(layerInput, layerOutput);
+    std::swap(layerInput, layerOutput);
+  }
+
+  size_t quantized = 0;
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    Layer<MatType>* quantizedLayer = layers[i]->Quantized(inputRanges[i]);
+    if (quantizedLayer == nullptr)
+      continue;
+
+    quantizedLayer->InputDimensions() = layers[i]->InputDimensions();
+    delete layers[i];
+    layers[i] = quantizedLayer;
+    ++quantized;
+  }
+
+  if (quantized > 0)
+    GatherParameters();
+
+  return quantized;
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+size_t FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Prune(const double sparsity, const size_t blockRows, const size_t blockCols)
+{
+  if (parameters.is_empty() || inputDimensions.empty())
+  {
+    throw std::invalid_argument("FFN::Prune(): the network must be trained or "
+        "loaded before it can be pruned!");
+  }
+
+  // Make sure the dimensions and the weights of each layer are set.
+  CheckNetwork("FFN::Prune()", 0, true, false);
+
+  std::vector<Layer<MatType>*>& layers = network.Network();
+  size_t pruned = 0;
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    Layer<MatType>* prunedLayer = layers[i]->Pruned(sparsity, blockRows,
+        blockCols);
+    if (prunedLayer == nullptr)
+      continue;
+
+    prunedLayer->InputDimensions() = layers[i]->InputDimensions();
+    delete layers[i];
+    layers[i] = prunedLayer;
+    ++pruned;
+  }
+
+  if (pruned > 0)
+    GatherParameters();
+
+  return pruned;
+}
+
 template<typename OutputLayerType,
          typename InitializationRuleType,
          typename MatType>
@@ -386,6 +641,13 @@ void FFN<
           "build options\" section of the README for more information.");
     #endif
   #else
+    // Parameters that point into a mapped file are replaced when loading.
+    if (cereal::is_loading<Archive>())
+    {
+      parameters.reset();
+      mappedFile.reset();
+    }
+
     // Serialize the output layer and initialization rule.
     ar(CEREAL_NVP(outputLayer));
     ar(CEREAL_NVP(initializeRule));
@@ -417,6 +679,128 @@ void FFN<
   #endif
 }
 
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::SaveMapped(const std::string& filename)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  // The parameters are written separately, so take them out of the network
+  // while the rest of it is serialized.  The memory is moved back afterwards,
+  // so the layers still point to the right weights.
+  MatType savedParameters(std::move(parameters));
+
+  std::ostringstream modelStream(std::ios::binary);
+  try
+  {
+    cereal::BinaryOutputArchive ar(modelStream);
+    ar(cereal::make_nvp("model", *this));
+  }
+  catch (...)
+  {
+    parameters = std::move(savedParameters);
+    throw;
+  }
+  parameters = std::move(savedParameters);
+  const std::string model = modelStream.str();
+
+  // Put the parameters at the start of a page, so that they are aligned once
+  // mapped.
+  const uint64_t pageSize = 4096;
+  MappedHeader header;
+  std::memcpy(header.magic, "MLPKFFNM", 8);
+  header.version = 1;
+  header.elemSize = sizeof(ElemType);
+  header.nRows = parameters.n_rows;
+  header.nCols = parameters.n_cols;
+  header.dataOffset = ((sizeof(MappedHeader) + pageSize - 1) / pageSize) *
+      pageSize;
+  header.modelOffset = header.dataOffset + parameters.n_elem *
+      sizeof(ElemType);
+  header.modelSize = model.size();
+
+  std::ofstream stream(filename, std::ios::binary);
+  if (!stream.is_open())
+  {
+    throw std::runtime_error("FFN::SaveMapped(): cannot open '" + filename +
+        "' for writing!");
+  }
+
+  const std::vector<char> padding(header.dataOffset - sizeof(MappedHeader), 0);
+  stream.write((const char*) &header, sizeof(MappedHeader));
+  stream.write(padding.data(), padding.size());
+  stream.write((const char*) parameters.memptr(),
+      parameters.n_elem * sizeof(ElemType));
+  stream.write(model.data(), model.size());
+  if (!stream.good())
+  {
+    throw std::runtime_error("FFN::SaveMapped(): error writing to '" +
+        filename + "'!");
+  }
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::LoadMapped(const std::string& filename)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  std::shared_ptr<data::MappedFile> file =
+      std::make_shared<data::MappedFile>(filename);
+
+  MappedHeader header;
+  if (file->Size() < sizeof(MappedHeader))
+  {
+    throw std::runtime_error("FFN::LoadMapped(): '" + filename + "' is not a "
+        "mapped network!");
+  }
+  std::memcpy(&header, file->Data(), sizeof(MappedHeader));
+
+  if (std::memcmp(header.magic, "MLPKFFNM", 8) != 0 || header.version != 1)
+  {
+    throw std::runtime_error("FFN::LoadMapped(): '" + filename + "' is not a "
+        "mapped network!");
+  }
+  if (header.elemSize != sizeof(ElemType))
+  {
+    throw std::runtime_error("FFN::LoadMapped(): '" + filename + "' was saved "
+        "with a different element type!");
+  }
+  if (header.dataOffset + header.nRows * header.nCols * sizeof(ElemType) >
+          header.modelOffset ||
+      header.modelOffset + header.modelSize > file->Size())
+  {
+    throw std::runtime_error("FFN::LoadMapped(): '" + filename + "' is "
+        "truncated or corrupted!");
+  }
+
+  // Deserialize everything but the parameters.  This replaces the current
+  // network (and releases any previous mapping).
+  std::istringstream modelStream(std::string(file->Data() + header.modelOffset,
+      header.modelSize), std::ios::binary);
+  {
+    cereal::BinaryInputArchive ar(modelStream);
+    ar(cereal::make_nvp("model", *this));
+  }
+
+  // Now point the (empty) parameters at the mapped data.  The alias is not
+  // strict, so the network can still be reset or trained; the memory is
+  // private, so nothing written to it can reach the file.
+  parameters = MatType((ElemType*) (file->Data() + header.dataOffset),
+      header.nRows, header.nCols, false, false);
+  mappedFile = std::move(file);
+}
+
 template<typename OutputLayerType,
          typename InitializationRuleType,
          typename MatType>
@@ -495,6 +879,9 @@ typename MatType::elem_type FFN<
 {
   CheckNetwork("FFN::EvaluateWithGradient()", predictors.n_rows);
 
+  if (workers > 1 && batchSize > 1)
+    return ParallelEvaluateWithGradient(parameters, begin, gradient, batchSize);
+
   // Set networkOutput to the right size if needed, then perform the forward
   // pass.
   networkOutput.set_size(network.OutputSize(), batchSize);
@@ -513,6 +900,8 @@ typename MatType::elem_type FFN<
 
   // Now perform the backward pass.
   outputLayer.Backward(networkOutput, responsesBatch, error);
+  if (lossScale != 1.0)
+    error *= lossScale;
 
   // The delta should have the same size as the input.
   networkDelta.set_size(predictors.n_rows, batchSize);
@@ -526,6 +915,133 @@ typename MatType::elem_type FFN<
   return obj;
 }
 
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::PrepareReplicas(const size_t count, const MatType& parameters)
+{
+  // Make sure that there is a replica of the current network for each worker
+  // but the first, with its layers pointing at its own copy of the parameters,
+  // so that layers that write their weights in the forward pass cannot race.
+  // Extra replicas (from a call with more workers) are kept.
+  if (replicas.size() < count || (replicas.size() > 0 &&
+      replicas[0].Network().size() != network.Network().size()))
+  {
+    replicas.clear();
+    replicas.resize(count, network);
+    for (size_t i = 0; i < replicas.size(); ++i)
+    {
+      replicas[i].InputDimensions() = network.InputDimensions();
+      replicas[i].ComputeOutputDimensions();
+    }
+  }
+
+  replicaParameters.resize(replicas.size());
+  for (size_t i = 0; i < count; ++i)
+  {
+    replicaParameters[i] = parameters;
+    replicas[i].SetWeights(replicaParameters[i]);
+    replicas[i].Training() = network.Training();
+  }
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+typename MatType::elem_type FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::ParallelEvaluateWithGradient(const MatType& parameters,
+                                const size_t begin,
+                                MatType& gradient,
+                                const size_t batchSize)
+{
+  const size_t shards = std::min(workers, batchSize);
+  PrepareReplicas(shards - 1, parameters);
+  replicaGradients.resize(shards - 1);
+
+  networkOutput.set_size(network.OutputSize(), batchSize);
+  networkDelta.set_size(predictors.n_rows, batchSize);
+  gradient.set_size(parameters.n_rows, parameters.n_cols);
+
+  // Pass each shard of the batch forward through its replica.  The shard of
+  // worker i is the points [i * batchSize / shards, (i + 1) * batchSize /
+  // shards).
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < shards; ++i)
+  {
+    const size_t shardBegin = i * batchSize / shards;
+    const size_t shardSize = (i + 1) * batchSize / shards - shardBegin;
+
+    MatType predictorsShard, outputShard;
+    MakeAlias(predictorsShard, predictors, predictors.n_rows, shardSize,
+        (begin + shardBegin) * predictors.n_rows);
+    MakeAlias(outputShard, networkOutput, networkOutput.n_rows, shardSize,
+        shardBegin * networkOutput.n_rows);
+
+    MultiLayer<MatType>& worker = (i == 0) ? network : replicas[i - 1];
+    worker.Forward(predictorsShard, outputShard);
+  }
+
+  // The loss and its gradient are computed on the whole batch, so the result
+  // does not depend on how the loss reduces the points of the batch.  Each
+  // worker only holds the extra losses of the layers for its own shard.
+  MatType responsesBatch;
+  MakeAlias(responsesBatch, responses, responses.n_rows, batchSize,
+      begin * responses.n_rows);
+  typename MatType::elem_type obj = outputLayer.Forward(networkOutput,
+      responsesBatch) + network.Loss();
+  for (size_t i = 0; i < shards - 1; ++i)
+    obj += replicas[i].Loss();
+  outputLayer.Backward(networkOutput, responsesBatch, error);
+  if (lossScale != 1.0)
+    error *= lossScale;
+
+  // Pass the error of each shard backward through its replica.
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < shards; ++i)
+  {
+    const size_t shardBegin = i * batchSize / shards;
+    const size_t shardSize = (i + 1) * batchSize / shards - shardBegin;
+
+    MatType predictorsShard, outputShard, errorShard, deltaShard;
+    MakeAlias(predictorsShard, predictors, predictors.n_rows, shardSize,
+        (begin + shardBegin) * predictors.n_rows);
+    MakeAlias(outputShard, networkOutput, networkOutput.n_rows, shardSize,
+        shardBegin * networkOutput.n_rows);
+    MakeAlias(errorShard, error, error.n_rows, shardSize,
+        shardBegin * error.n_rows);
+    MakeAlias(deltaShard, networkDelta, networkDelta.n_rows, shardSize,
+        shardBegin * networkDelta.n_rows);
+
+    MultiLayer<MatType>& worker = (i == 0) ? network : replicas[i - 1];
+    MatType& workerGradient = (i == 0) ? gradient : replicaGradients[i - 1];
+    workerGradient.set_size(parameters.n_rows, parameters.n_cols);
+
+    worker.Backward(predictorsShard, outputShard, errorShard, deltaShard);
+    worker.Gradient(predictorsShard, errorShard, workerGradient);
+  }
+
+  // Sum the gradients of the workers with a tree reduction into the gradient
+  // of the first worker.
+  for (size_t stride = 1; stride < shards; stride *= 2)
+  {
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < shards - stride; i += 2 * stride)
+    {
+      MatType& target = (i == 0) ? gradient : replicaGradients[i - 1];
+      target += replicaGradients[i + stride - 1];
+    }
+  }
+
+  return obj;
+}
+
 template<typename OutputLayerType,
          typename InitializationRuleType,
          typename MatType>
@@ -550,7 +1066,8 @@ void FFN<
     MatType
 >::Shuffle()
 {
-  ShuffleData(predictors, responses, predictors, responses);
+  // Shuffle in place, so that no copy of the training set is held.
+  ShuffleData(predictors, responses);
 }
 
 template<typename OutputLayerType,
@@ -604,6 +1121,41 @@ void FFN<
   layerMemoryIsSet = true;
 }
 
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::GatherParameters()
+{
+  // The weights of the layers are copied into a new parameter matrix, and the
+  // layers are pointed at it.
+  const std::vector<Layer<MatType>*>& layers = network.Network();
+  network.ComputeOutputDimensions();
+
+  MatType newParameters(network.WeightSize(), 1);
+  size_t offset = 0;
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    const size_t weightSize = layers[i]->WeightSize();
+    if (weightSize == 0)
+      continue;
+
+    newParameters.rows(offset, offset + weightSize - 1) =
+        vectorise(layers[i]->Parameters());
+    offset += weightSize;
+  }
+
+  parameters = std::move(newParameters);
+  SetLayerMemory();
+
+  // The layers have changed, so the replicas must be built again.
+  replicas.clear();
+  replicaParameters.clear();
+}
+
 template<typename OutputLayerType,
          typename InitializationRuleType,
          typename MatType>
@@ -68,23 +68,18 @@ void AddMergeType<MatType>::Forward(
   for (size_t i = 0; i < this->network.size(); ++i)
     this->network[i]->Training() = this->training;
 
-  // Note that we use `output` for the last layer; layerOutputs is only used for
-  // intermediate values between layers.
   if (this->network.size() > 1)
   {
-    // Initialize temporary memory for the forward pass.
-    MatType tempOutput;
-    tempOutput.set_size(arma::size(output));
-
-    // Forward pass every layer in network with same input.
-    // Reduce the outputs to single output by adding element-wise.
-    this->network[0]->Forward(input, tempOutput);
-    output = tempOutput;
-    for (size_t i = 1; i < this->network.size(); i++)
-    {
-      this->network[i]->Forward(input, tempOutput);
-      output += tempOutput;
-    }
+    // Each layer writes its output into the preallocated memory of
+    // MultiLayer, where it is kept for the backward pass; the outputs are then
+    // summed directly into `output`.
+    this->InitializeForwardPassMemory(input.n_cols);
+    for (size_t i = 0; i < this->network.size(); ++i)
+      this->network[i]->Forward(input, this->layerOutputs[i]);
+
+    output = this->layerOutputs[0] + this->layerOutputs[1];
+    for (size_t i = 2; i < this->network.size(); ++i)
+      output += this->layerOutputs[i];
   }
   else if (this->network.size() == 1)
   {
@@ -106,15 +101,16 @@ void AddMergeType<MatType>::Backward(
 {
   if (this->network.size() > 1)
   {
-    // Initialize temporary memory for the backward pass.
-    MatType tempDelta;
-    tempDelta.set_size(arma::size(g));
-
-    g.zeros();
-    for (size_t i = 0; i < this->network.size(); i++)
+    // Every layer gets `gy` itself as its error.  The first layer writes its
+    // delta directly into `g`, and the deltas of the other layers are added to
+    // it.
+    this->InitializeBackwardPassMemory(gy.n_cols);
+    this->network[0]->Backward(input, this->layerOutputs[0], gy, g);
+    for (size_t i = 1; i < this->network.size(); ++i)
     {
-      this->network[i]->Backward(input, output, gy, tempDelta);
-      g += tempDelta;
+      this->network[i]->Backward(input, this->layerOutputs[i], gy,
+          this->layerDeltas[i]);
+      g += this->layerDeltas[i];
     }
   }
   else if (this->network.size() == 1)
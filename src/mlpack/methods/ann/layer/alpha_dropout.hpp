@@ -18,6 +18,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include "layer.hpp"
+#include "dropout_mask.hpp"
 
 namespace mlpack {
 
@@ -106,8 +107,8 @@ class AlphaDropoutType : public Layer<MatType>
   //! Value of alphaDash.
   double AlphaDash() const { return alphaDash; }
 
-  //! Get the mask.
-  const MatType& Mask() const { return mask; }
+  //! Get the mask, with 1 for the kept values and 0 for the dropped ones.
+  MatType Mask() const { return mask.Expand<MatType>(); }
 
   //! Modify the probability of setting a value to alphaDash. As
   //! 'a' and 'b' depend on 'ratio', modify them as well.
@@ -125,8 +126,8 @@ class AlphaDropoutType : public Layer<MatType>
   void serialize(Archive& ar, const uint32_t /* version */);
 
  private:
-  //! Locally-stored mask object.
-  MatType mask;
+  //! Locally-stored mask of the kept values.
+  DropoutMask mask;
 
   //! The probability of setting a value to aplhaDash.
   double ratio;
@@ -103,9 +103,8 @@ void AlphaDropoutType<MatType>::Forward(const MatType& input, MatType& output)
     // Set values to alphaDash with probability ratio.  Then apply affine
     // transformation so as to keep mean and variance of outputs to their
     // original values.
-    mask.randu(input.n_rows, input.n_cols);
-    mask.transform( [&](double val) { return (val > ratio); } );
-    output = (input % mask + alphaDash * (1 - mask)) * a + b;
+    mask.Generate(input.n_rows, input.n_cols, ratio);
+    mask.Apply(input, output, a, b, alphaDash * a + b);
   }
 }
 
@@ -116,7 +115,7 @@ void AlphaDropoutType<MatType>::Backward(
     const MatType& gy,
     MatType& g)
 {
-  g = gy % mask * a;
+  mask.Apply(gy, g, a);
 }
 
 template<typename MatType>
@@ -134,7 +133,7 @@ void AlphaDropoutType<MatType>::serialize(
   // No need to serialize the mask, since it will be recomputed on the next
   // forward pass.  But we should clear it if we are loading.
   if (Archive::is_loading::value)
-    mask.clear();
+    mask = DropoutMask();
 }
 
 } // namespace mlpack
@@ -32,6 +32,11 @@
 #include <mlpack/methods/ann/activation_functions/silu_function.hpp>
 #include <mlpack/methods/ann/activation_functions/hyper_sinh_function.hpp>
 #include <mlpack/methods/ann/activation_functions/bipolar_sigmoid_function.hpp>
+#include <mlpack/methods/ann/activation_functions/fast_logistic_function.hpp>
+#include <mlpack/methods/ann/activation_functions/fast_tanh_function.hpp>
+#include <mlpack/methods/ann/activation_functions/fast_swish_function.hpp>
+#include <mlpack/methods/ann/activation_functions/fast_gelu_function.hpp>
+#include <mlpack/methods/ann/activation_functions/fast_mish_function.hpp>
 #include "layer.hpp"
 
 namespace mlpack {
@@ -57,6 +62,8 @@ namespace mlpack {
  *  - HardSwish
  *  - TanhExp
  *  - SILU
+ *  - FastSigmoid, FastTanH, FastSwish, FastGELU and FastMish, which use
+ *    vectorized approximations of the exponential function
  *
  * @tparam ActivationFunction Activation function used for the embedding layer.
  */
@@ -96,6 +103,10 @@ class BaseLayer : public Layer<MatType>
     ActivationFunction::Fn(input, output);
   }
 
+  //! The activation is applied to each element separately, so the forward
+  //! pass can be computed in place.
+  bool ElementWise() const { return true; }
+
   /**
    * Backward pass: compute the function f(x) by propagating x backwards through
    * f, using the results from the forward pass.
@@ -264,6 +275,46 @@ typedef BaseLayer<BipolarSigmoidFunction, arma::mat> BipolarSigmoid;
 template<typename MatType = arma::mat>
 using BipolarSigmoidType = BaseLayer<BipolarSigmoidFunction, MatType>;
 
+/**
+ * Sigmoid-Layer using the fast approximation of the logistic function.
+ */
+typedef BaseLayer<FastLogisticFunction, arma::mat> FastSigmoid;
+
+template<typename MatType = arma::mat>
+using FastSigmoidType = BaseLayer<FastLogisticFunction, MatType>;
+
+/**
+ * TanH-Layer using the fast approximation of the tanh function.
+ */
+typedef BaseLayer<FastTanhFunction, arma::mat> FastTanH;
+
+template<typename MatType = arma::mat>
+using FastTanHType = BaseLayer<FastTanhFunction, MatType>;
+
+/**
+ * Swish-Layer using the fast approximation of the Swish function.
+ */
+typedef BaseLayer<FastSwishFunction, arma::mat> FastSwish;
+
+template<typename MatType = arma::mat>
+using FastSwishType = BaseLayer<FastSwishFunction, MatType>;
+
+/**
+ * GELU-Layer using the fast approximation of the GELU function.
+ */
+typedef BaseLayer<FastGELUFunction, arma::mat> FastGELU;
+
+template<typename MatType = arma::mat>
+using FastGELUType = BaseLayer<FastGELUFunction, MatType>;
+
+/**
+ * Mish-Layer using the fast approximation of the Mish function.
+ */
+typedef BaseLayer<FastMishFunction, arma::mat> FastMish;
+
+template<typename MatType = arma::mat>
+using FastMishType = BaseLayer<FastMishFunction, MatType>;
+
 } // namespace mlpack
 
 #endif
@@ -162,6 +162,17 @@ class BatchNormType : public Layer<MatType>
    */
   void Gradient(const MatType& input, const MatType& error, MatType& gradient);
 
+  /**
+   * Compute the element-wise affine transformation that the layer applies to
+   * each input point when it is not in training mode, so that Forward()
+   * computes `scale % x + shift` for each point `x`.  The output dimensions of
+   * the layer must have been computed.
+   *
+   * @param scale Column vector to store the scaling factors into.
+   * @param shift Column vector to store the offsets into.
+   */
+  void InferenceAffine(MatType& scale, MatType& shift) const;
+
   //! Get the parameters.
   const MatType& Parameters() const { return weights; }
   //! Modify the parameters.
@@ -326,6 +326,22 @@ void BatchNormType<MatType>::Gradient(
   gradient.submat(gamma.n_elem, 0, gradient.n_elem - 1, 0) = temp.t();
 }
 
+template<typename MatType>
+void BatchNormType<MatType>::InferenceAffine(
+    MatType& scale,
+    MatType& shift) const
+{
+  // Each channel is normalized with the running statistics, then scaled by
+  // gamma and shifted by beta.
+  const MatType channelScale = gamma / sqrt(runningVariance + eps);
+  const MatType channelShift = beta - channelScale % runningMean;
+
+  // The elements of a point are laid out as (inputDimension, size,
+  // higherDimension).
+  scale = vectorise(repmat(channelScale.t(), inputDimension, higherDimension));
+  shift = vectorise(repmat(channelShift.t(), inputDimension, higherDimension));
+}
+
 template<typename MatType>
 void BatchNormType<MatType>::ComputeOutputDimensions()
 {
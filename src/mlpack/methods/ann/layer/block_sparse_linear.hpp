@@ -0,0 +1,149 @@
+/**
+ * @file methods/ann/layer/block_sparse_linear.hpp
+ *
+ * Definition of the BlockSparseLinear layer, an inference-only version of the
+ * Linear layer for pruned weights stored in block-CSR form.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_BLOCK_SPARSE_LINEAR_HPP
+#define MLPACK_METHODS_ANN_LAYER_BLOCK_SPARSE_LINEAR_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/pruning/prune.hpp>
+
+#include "layer.hpp"
+
+namespace mlpack {
+
+/**
+ * The BlockSparseLinear layer computes the same affine transformation
+ * y = Ax + b as the Linear layer, for a pruned weight matrix A where most
+ * blocks of `blockRows` x `blockCols` weights are zero.  Only the nonzero
+ * blocks are stored, in block-CSR form: the blocks of each block row are
+ * stored one after another, with the index of their block column.  The cost of
+ * a forward pass, and the memory used by the weights, are proportional to the
+ * number of nonzero blocks.
+ *
+ * Blocks such as 4x4 or 8x1 keep the inner loops contiguous, and are usually
+ * faster than single weights at the same sparsity.  The layer is usually
+ * created from a trained network with `FFN::Prune()`.
+ *
+ * This layer is meant for inference only: it has no trainable weights, and
+ * Backward() throws an exception.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class BlockSparseLinearType : public Layer<MatType>
+{
+ public:
+  //! Create the BlockSparseLinear object.
+  BlockSparseLinearType();
+
+  /**
+   * Create the BlockSparseLinear layer object from the weights of a Linear
+   * layer.  The blocks of `weight` where all weights are zero are not stored;
+   * use `PruneBlocks()` first to set the smallest blocks to zero.
+   *
+   * @param weight Weight matrix (outSize x inSize).
+   * @param bias Bias vector (outSize x 1), or an empty matrix if there is no
+   *     bias.
+   * @param blockRows Number of rows of each block.
+   * @param blockCols Number of columns of each block.
+   */
+  BlockSparseLinearType(const MatType& weight,
+                        const MatType& bias,
+                        const size_t blockRows,
+                        const size_t blockCols);
+
+  virtual ~BlockSparseLinearType() { }
+
+  //! Clone the BlockSparseLinear object. This handles polymorphism correctly.
+  BlockSparseLinearType* Clone() const
+  {
+    return new BlockSparseLinearType(*this);
+  }
+
+  /**
+   * Ordinary feed forward pass of the layer, using only the nonzero blocks of
+   * the weights.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * The layer cannot be trained, so this throws a std::logic_error.
+   */
+  void Backward(const MatType& /* input */,
+                const MatType& /* output */,
+                const MatType& /* gy */,
+                MatType& /* g */);
+
+  //! Get the number of rows of each block.
+  size_t BlockRows() const { return blockRows; }
+  //! Get the number of columns of each block.
+  size_t BlockCols() const { return blockCols; }
+
+  //! Get the number of nonzero blocks that are stored.
+  size_t NonzeroBlocks() const { return blockColumns.size(); }
+
+  //! Get the bias of the layer.
+  MatType const& Bias() const { return bias; }
+
+  //! Compute the dense weight matrix (outSize x inSize) of the layer.
+  void DenseWeight(MatType& weight) const;
+
+  //! Compute the output dimensions of the layer given `InputDimensions()`.
+  void ComputeOutputDimensions();
+
+  //! Serialize the layer.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored number of input units.
+  size_t inSize;
+
+  //! Locally-stored number of output units.
+  size_t outSize;
+
+  //! Locally-stored number of rows of each block.
+  size_t blockRows;
+
+  //! Locally-stored number of columns of each block.
+  size_t blockCols;
+
+  //! The index of the first stored block of each block row; the blocks of
+  //! block row `i` are the blocks `rowOffsets[i]` to `rowOffsets[i + 1] - 1`.
+  std::vector<size_t> rowOffsets;
+
+  //! The block column of each stored block.
+  std::vector<size_t> blockColumns;
+
+  //! The weights of each stored block (column-major, blockRows x blockCols,
+  //! padded with zeros at the edges of the weight matrix), one block per
+  //! column.
+  MatType blocks;
+
+  //! The bias of each output (empty if there is no bias).
+  MatType bias;
+}; // class BlockSparseLinearType
+
+// Convenience typedefs.
+
+// Standard BlockSparseLinear layer.
+typedef BlockSparseLinearType<arma::mat> BlockSparseLinear;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "block_sparse_linear_impl.hpp"
+
+#endif
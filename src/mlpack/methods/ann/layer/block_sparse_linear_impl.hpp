@@ -0,0 +1,206 @@
+/**
+ * @file methods/ann/layer/block_sparse_linear_impl.hpp
+ *
+ * Implementation of the BlockSparseLinear layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_BLOCK_SPARSE_LINEAR_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_BLOCK_SPARSE_LINEAR_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "block_sparse_linear.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+BlockSparseLinearType<MatType>::BlockSparseLinearType() :
+    Layer<MatType>(),
+    inSize(0),
+    outSize(0),
+    blockRows(1),
+    blockCols(1),
+    rowOffsets(1, 0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+BlockSparseLinearType<MatType>::BlockSparseLinearType(
+    const MatType& weight,
+    const MatType& biasIn,
+    const size_t blockRows,
+    const size_t blockCols) :
+    Layer<MatType>(),
+    inSize(weight.n_cols),
+    outSize(weight.n_rows),
+    blockRows(blockRows),
+    blockCols(blockCols),
+    bias(biasIn)
+{
+  if (blockRows == 0 || blockCols == 0)
+  {
+    throw std::invalid_argument("BlockSparseLinear: the size of the blocks "
+        "must be positive!");
+  }
+
+  const size_t numBlockRows = (outSize + blockRows - 1) / blockRows;
+  const size_t numBlockCols = (inSize + blockCols - 1) / blockCols;
+
+  // Find the nonzero blocks of each block row.
+  rowOffsets.resize(numBlockRows + 1);
+  rowOffsets[0] = 0;
+  for (size_t br = 0; br < numBlockRows; ++br)
+  {
+    const size_t firstRow = br * blockRows;
+    const size_t lastRow = std::min(firstRow + blockRows, outSize) - 1;
+    for (size_t bc = 0; bc < numBlockCols; ++bc)
+    {
+      const size_t firstCol = bc * blockCols;
+      const size_t lastCol = std::min(firstCol + blockCols, inSize) - 1;
+      if (arma::any(arma::vectorise(weight.submat(firstRow, firstCol, lastRow,
+          lastCol)) != 0))
+      {
+        blockColumns.push_back(bc);
+      }
+    }
+
+    rowOffsets[br + 1] = blockColumns.size();
+  }
+
+  // Copy the weights of the nonzero blocks.
+  blocks.zeros(blockRows * blockCols, blockColumns.size());
+  for (size_t br = 0; br < numBlockRows; ++br)
+  {
+    const size_t firstRow = br * blockRows;
+    const size_t rows = std::min(blockRows, outSize - firstRow);
+    for (size_t k = rowOffsets[br]; k < rowOffsets[br + 1]; ++k)
+    {
+      const size_t firstCol = blockColumns[k] * blockCols;
+      const size_t cols = std::min(blockCols, inSize - firstCol);
+      for (size_t j = 0; j < cols; ++j)
+        for (size_t i = 0; i < rows; ++i)
+          blocks(i + j * blockRows, k) = weight(firstRow + i, firstCol + j);
+    }
+  }
+}
+
+template<typename MatType>
+void BlockSparseLinearType<MatType>::Forward(
+    const MatType& input, MatType& output)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const size_t numBlockRows = rowOffsets.size() - 1;
+  const size_t batchSize = input.n_cols;
+  output.set_size(outSize, batchSize);
+
+  // Each block row gives different outputs, so the block rows can be computed
+  // in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t br = 0; br < numBlockRows; ++br)
+  {
+    const size_t firstRow = br * blockRows;
+    const size_t rows = std::min(blockRows, outSize - firstRow);
+
+    for (size_t n = 0; n < batchSize; ++n)
+    {
+      ElemType* out = output.colptr(n) + firstRow;
+      for (size_t i = 0; i < rows; ++i)
+        out[i] = bias.is_empty() ? ElemType(0) : bias[firstRow + i];
+    }
+
+    for (size_t k = rowOffsets[br]; k < rowOffsets[br + 1]; ++k)
+    {
+      const size_t firstCol = blockColumns[k] * blockCols;
+      const size_t cols = std::min(blockCols, inSize - firstCol);
+      const ElemType* block = blocks.colptr(k);
+
+      for (size_t n = 0; n < batchSize; ++n)
+      {
+        ElemType* out = output.colptr(n) + firstRow;
+        const ElemType* in = input.colptr(n) + firstCol;
+        for (size_t j = 0; j < cols; ++j)
+        {
+          const ElemType* w = block + j * blockRows;
+          const ElemType x = in[j];
+          for (size_t i = 0; i < rows; ++i)
+            out[i] += w[i] * x;
+        }
+      }
+    }
+  }
+}
+
+template<typename MatType>
+void BlockSparseLinearType<MatType>::Backward(
+    const MatType& /* input */,
+    const MatType& /* output */,
+    const MatType& /* gy */,
+    MatType& /* g */)
+{
+  throw std::logic_error("BlockSparseLinear::Backward(): block-sparse layers "
+      "can only be used for inference!");
+}
+
+template<typename MatType>
+void BlockSparseLinearType<MatType>::DenseWeight(MatType& weight) const
+{
+  weight.zeros(outSize, inSize);
+  for (size_t br = 0; br + 1 < rowOffsets.size(); ++br)
+  {
+    const size_t firstRow = br * blockRows;
+    const size_t rows = std::min(blockRows, outSize - firstRow);
+    for (size_t k = rowOffsets[br]; k < rowOffsets[br + 1]; ++k)
+    {
+      const size_t firstCol = blockColumns[k] * blockCols;
+      const size_t cols = std::min(blockCols, inSize - firstCol);
+      for (size_t j = 0; j < cols; ++j)
+        for (size_t i = 0; i < rows; ++i)
+          weight(firstRow + i, firstCol + j) = blocks(i + j * blockRows, k);
+    }
+  }
+}
+
+template<typename MatType>
+void BlockSparseLinearType<MatType>::ComputeOutputDimensions()
+{
+  size_t totalInSize = this->inputDimensions[0];
+  for (size_t i = 1; i < this->inputDimensions.size(); ++i)
+    totalInSize *= this->inputDimensions[i];
+
+  if (totalInSize != inSize)
+  {
+    throw std::invalid_argument("BlockSparseLinear::ComputeOutputDimensions(): "
+        "input size does not match the size of the weights!");
+  }
+
+  // The layer flattens its input, like the Linear layer.
+  this->outputDimensions = std::vector<size_t>(this->inputDimensions.size(),
+      1);
+  this->outputDimensions[0] = outSize;
+}
+
+template<typename MatType>
+template<typename Archive>
+void BlockSparseLinearType<MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(outSize));
+  ar(CEREAL_NVP(blockRows));
+  ar(CEREAL_NVP(blockCols));
+  ar(CEREAL_NVP(rowOffsets));
+  ar(CEREAL_NVP(blockColumns));
+  ar(CEREAL_NVP(blocks));
+  ar(CEREAL_NVP(bias));
+}
+
+} // namespace mlpack
+
+#endif
@@ -69,7 +69,7 @@ void CReLUType<MatType>::Forward(
     const MatType& input, MatType& output)
 {
   typename MatType::elem_type zero = 0.0;
-  #pragma omp for
+  #pragma omp parallel for
   for (size_t i = 0; i < (size_t) input.n_cols; ++i)
   {
     for (size_t j = 0; j < (size_t) input.n_rows; ++j)
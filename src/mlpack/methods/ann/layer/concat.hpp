@@ -220,11 +220,27 @@ class ConcatType : public MultiLayer<MatType>
   void serialize(Archive& ar, const uint32_t /* version */);
 
  private:
+  /**
+   * Set `block` to the part of `m` (a matrix holding the concatenated outputs
+   * or errors of all layers) that belongs to the layer with the given index,
+   * with one column for each point.  When that part is contiguous (i.e. when
+   * there is only one slice), `block` is an alias of `m`; otherwise, it is
+   * copied into `blockMemory`, and is only valid until the next call.
+   *
+   * @param m Matrix holding the concatenated outputs or errors.
+   * @param index Index of the layer.
+   * @param block Matrix to store the part of the layer into.
+   */
+  void LayerBlock(const MatType& m, const size_t index, MatType& block);
+
   //! Parameter which indicates the axis of concatenation.
   size_t axis;
 
   //! Parameter which indicates whether to use the axis of concatenation.
   bool useAxis;
+
+  //! Memory for the part of the error of one layer, when it is not contiguous.
+  MatType blockMemory;
 }; // class ConcatType.
 
 // Standard Concat layer.
@@ -90,22 +90,11 @@ ConcatType<MatType>& ConcatType<MatType>::operator=(ConcatType&& other)
 template<typename MatType>
 void ConcatType<MatType>::Forward(const MatType& input, MatType& output)
 {
-  // The implementation of MultiLayer is fine: this will allocate a matrix that
-  // is able to hold each child layer's output.
-  this->InitializeForwardPassMemory(input.n_cols);
-
-  // Pass the input through all the layers in the network.
-  for (size_t i = 0; i < this->network.size(); ++i)
-  {
-    this->network[i]->Forward(input, this->layerOutputs[i]);
-  }
-
-  // Now concatenate the outputs along the correct axis.
-  // We can actually use Armadillo to do this for us---we will treat the axis of
-  // interest as "columns", any axes that come before the axis of interest as
-  // 'flattened slices', and any axes that come after the axis of interest as
-  // 'flattened rows'.  As a result, we will only have to do join_cols() to
-  // produce the right result.
+  // We can actually use Armadillo to do the concatenation for us---we will
+  // treat the axis of interest as "columns", any axes that come before the
+  // axis of interest as 'flattened slices', and any axes that come after the
+  // axis of interest as 'flattened rows'.  As a result, we will only have to
+  // do join_cols() to produce the right result.
   //
   // Note that we will have one "extra" axis in addition to
   // this->outputDimensions.size(); that is the batch size (represented as the
@@ -119,6 +108,32 @@ void ConcatType<MatType>::Forward(const MatType& input, MatType& output)
   for (size_t i = axis + 1; i < this->outputDimensions.size(); ++i)
     slices *= this->outputDimensions[i];
 
+  if (slices == 1)
+  {
+    // The output of each layer is a contiguous block of `output`, so each
+    // layer can write its output there directly.
+    size_t start = 0;
+    for (size_t i = 0; i < this->network.size(); ++i)
+    {
+      MakeAlias(this->layerOutputs[i], output, this->network[i]->OutputSize(),
+          1, start);
+      this->network[i]->Forward(input, this->layerOutputs[i]);
+      start += this->network[i]->OutputSize();
+    }
+
+    return;
+  }
+
+  // The implementation of MultiLayer is fine: this will allocate a matrix that
+  // is able to hold each child layer's output.
+  this->InitializeForwardPassMemory(input.n_cols);
+
+  // Pass the input through all the layers in the network.
+  for (size_t i = 0; i < this->network.size(); ++i)
+  {
+    this->network[i]->Forward(input, this->layerOutputs[i]);
+  }
+
   std::vector<arma::Cube<typename MatType::elem_type>> layerOutputAliases(
       this->layerOutputs.size());
   for (size_t i = 0; i < this->layerOutputs.size(); ++i)
@@ -152,39 +167,16 @@ void ConcatType<MatType>::Backward(
   // input).
   this->InitializeBackwardPassMemory(gy.n_cols);
 
-  // Just like the forward pass, we can treat our inputs as a cube, but here we
-  // have to distribute the correct parts of `gy` to the layers.
-
-  size_t rows = 1;
-  for (size_t i = 0; i < axis; ++i)
-    rows *= this->outputDimensions[i];
-
-  size_t slices = gy.n_cols;
-  for (size_t i = axis + 1; i < this->outputDimensions.size(); ++i)
-    slices *= this->outputDimensions[i];
-
-  arma::Cube<typename MatType::elem_type> gyTmp;
-  MakeAlias(gyTmp, gy, rows, this->outputDimensions[axis], slices);
-
-  size_t startCol = 0;
-  for (size_t i = 0; i < this->network.size(); ++i)
-  {
-    const size_t cols = this->network[i]->OutputDimensions()[axis];
-    MatType delta = gyTmp.cols(startCol, startCol + cols - 1);
-    // Reshape so that the batch size is the number of columns.
-    delta.reshape(delta.n_elem / gy.n_cols, gy.n_cols);
-    this->network[i]->Backward(
-        input,
-        this->layerOutputs[i],
-        delta,
-        this->layerDeltas[i]);
-
-    startCol += cols;
-  }
-
-  g = this->layerDeltas[0];
+  // Each layer gets its part of `gy`.  The first layer writes its delta
+  // directly into `g`, and the deltas of the other layers are added to it.
+  MatType delta;
+  LayerBlock(gy, 0, delta);
+  this->network[0]->Backward(input, this->layerOutputs[0], delta, g);
   for (size_t i = 1; i < this->network.size(); ++i)
   {
+    LayerBlock(gy, i, delta);
+    this->network[i]->Backward(input, this->layerOutputs[i], delta,
+        this->layerDeltas[i]);
     g += this->layerDeltas[i];
   }
 }
@@ -197,32 +189,10 @@ void ConcatType<MatType>::Backward(
     MatType& g,
     const size_t index)
 {
-  // We only intend to perform a backward pass on one layer.
-  // Thus, we need to extract the parts of gy that correspond to the desired
-  // layer (specified by `index`).
-
-  size_t rows = 1;
-  for (size_t i = 0; i < axis; ++i)
-    rows *= this->outputDimensions[i];
-
-  size_t slices = gy.n_cols;
-  for (size_t i = axis + 1; i < this->outputDimensions.size(); ++i)
-    slices *= this->outputDimensions[i];
-
-  arma::Cube<typename MatType::elem_type> gyTmp;
-  MakeAlias(gyTmp, gy, rows, this->outputDimensions[axis], slices);
-
-  size_t startCol = 0;
-  for (size_t i = 0; i < index; ++i)
-  {
-    startCol += this->network[i]->OutputDimensions()[axis];
-  }
-
-  const size_t cols = this->network[index]->OutputDimensions()[axis];
-  MatType delta = gyTmp.cols(startCol, startCol + cols - 1);
-  // Reshape so that the batch size is the number of columns.
-  delta.reshape(delta.n_elem / gy.n_cols, gy.n_cols);
-
+  // We only intend to perform a backward pass on one layer, so only the part
+  // of gy that corresponds to the desired layer is needed.
+  MatType delta;
+  LayerBlock(gy, index, delta);
   this->network[index]->Backward(input, this->layerOutputs[index], delta, g);
 }
 
@@ -232,34 +202,18 @@ void ConcatType<MatType>::Gradient(
     const MatType& error,
     MatType& gradient)
 {
-  // Just like the forward pass, we can treat our inputs as a cube, but here we
-  // have to distribute the correct parts of `error` to the layers.
-
-  size_t rows = 1;
-  for (size_t i = 0; i < axis; ++i)
-    rows *= this->outputDimensions[i];
-
-  size_t slices = input.n_cols;
-  for (size_t i = axis + 1; i < this->outputDimensions.size(); ++i)
-    slices *= this->outputDimensions[i];
-
-  arma::Cube<typename MatType::elem_type> errorTmp;
-  MakeAlias(errorTmp, error, rows, this->outputDimensions[axis], slices);
-
-  size_t startCol = 0;
+  // Just like the backward pass, each layer gets its part of `error`.
   size_t startParam = 0;
+  MatType err;
   for (size_t i = 0; i < this->network.size(); ++i)
   {
-    const size_t cols = this->network[i]->OutputDimensions()[axis];
     const size_t params = this->network[i]->WeightSize();
 
-    MatType err = errorTmp.cols(startCol, startCol + cols - 1);
-    err.reshape(err.n_elem / input.n_cols, input.n_cols);
+    LayerBlock(error, i, err);
     MatType gradientAlias;
     MakeAlias(gradientAlias, gradient, params, 1, startParam);
     this->network[i]->Gradient(input, err, gradientAlias);
 
-    startCol += cols;
     startParam += params;
   }
 }
@@ -271,36 +225,57 @@ void ConcatType<MatType>::Gradient(
     MatType& gradient,
     const size_t index)
 {
-  // Just like the forward pass, we can treat our inputs as a cube, but here we
-  // have to distribute the correct parts of `error` to the layers.
+  size_t startParam = 0;
+  for (size_t i = 0; i < index; ++i)
+    startParam += this->network[i]->WeightSize();
 
+  MatType err;
+  LayerBlock(error, index, err);
+  MatType gradientAlias;
+  MakeAlias(gradientAlias, gradient, this->network[index]->WeightSize(), 1,
+      startParam);
+  this->network[index]->Gradient(input, err, gradientAlias);
+}
+
+template<typename MatType>
+void ConcatType<MatType>::LayerBlock(const MatType& m,
+                                     const size_t index,
+                                     MatType& block)
+{
+  // As in Forward(), we treat `m` as a cube, where the concatenation axis is
+  // the columns.
   size_t rows = 1;
   for (size_t i = 0; i < axis; ++i)
     rows *= this->outputDimensions[i];
 
-  size_t slices = input.n_cols;
+  size_t slices = m.n_cols;
   for (size_t i = axis + 1; i < this->outputDimensions.size(); ++i)
     slices *= this->outputDimensions[i];
 
-  arma::Cube<typename MatType::elem_type> errorTmp;
-  MakeAlias(errorTmp, error, rows, this->outputDimensions[axis], slices);
-
   size_t startCol = 0;
-  size_t startParam = 0;
   for (size_t i = 0; i < index; ++i)
-  {
     startCol += this->network[i]->OutputDimensions()[axis];
-    startParam += this->network[i]->WeightSize();
-  }
 
   const size_t cols = this->network[index]->OutputDimensions()[axis];
-  const size_t params = this->network[index]->WeightSize();
+  const size_t layerOutputSize = this->network[index]->OutputSize();
 
-  MatType err = errorTmp.cols(startCol, startCol + cols - 1);
-  err.reshape(err.n_elem / input.n_cols, input.n_cols);
-  MatType gradientAlias;
-  MakeAlias(gradientAlias, gradient, params, 1, startParam);
-  this->network[index]->Gradient(input, err, gradientAlias);
+  if (slices == 1)
+  {
+    // The block of the layer is contiguous, so it does not need to be copied.
+    MakeAlias(block, m, layerOutputSize, 1, rows * startCol);
+    return;
+  }
+
+  // Otherwise, copy the block into memory that is reused by every layer.  We
+  // only resize that memory when it is too small.
+  if (blockMemory.n_elem < layerOutputSize * m.n_cols)
+    blockMemory.set_size(layerOutputSize * m.n_cols, 1);
+  MakeAlias(block, blockMemory, layerOutputSize, m.n_cols);
+
+  arma::Cube<typename MatType::elem_type> mAlias, blockAlias;
+  MakeAlias(mAlias, m, rows, this->outputDimensions[axis], slices);
+  MakeAlias(blockAlias, block, rows, cols, slices);
+  blockAlias = mAlias.cols(startCol, startCol + cols - 1);
 }
 
 template<typename MatType>
@@ -17,11 +17,14 @@
 #include <mlpack/methods/ann/convolution_rules/border_modes.hpp>
 #include <mlpack/methods/ann/convolution_rules/naive_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/fft_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/im2col_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/svd_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/winograd_convolution.hpp>
 #include <mlpack/core/util/to_lower.hpp>
 
 #include "layer.hpp"
 #include "padding.hpp"
+#include "quantized_convolution.hpp"
 
 namespace mlpack {
 
@@ -192,6 +195,32 @@ class ConvolutionType : public Layer<MatType>
                 const MatType& error,
                 MatType& gradient);
 
+  /**
+   * Fold the element-wise transformation `scale % y + shift` of the output `y`
+   * into the weights and the bias of the layer.  This is only possible if all
+   * the elements of each output map are transformed in the same way, and, if
+   * the layer has no bias, `shift` is zero.
+   *
+   * @param scale Column vector with `OutputSize()` scaling factors.
+   * @param shift Column vector with `OutputSize()` offsets.
+   * @return Whether the transformation was folded into the layer.
+   */
+  bool FoldAffine(const MatType& scale, const MatType& shift);
+
+  /**
+   * Create a QuantizedConvolution layer with the filters and the bias of this
+   * layer.
+   *
+   * @param inputRange Largest absolute value that the inputs of the layer are
+   *     expected to have.
+   */
+  QuantizedConvolutionType<MatType>* Quantized(const double inputRange) const
+  {
+    return new QuantizedConvolutionType<MatType>(weight,
+        (useBias ? bias : MatType()), inMaps, strideWidth, strideHeight,
+        padWLeft, padWRight, padHTop, padHBottom, inputRange);
+  }
+
   //! Get the parameters.
   MatType const& Parameters() const { return weights; }
   //! Modify the parameters.
@@ -404,6 +433,14 @@ typedef ConvolutionType<
     arma::mat
 > Convolution;
 
+// Convolution layer that computes each pass with matrix multiplications.
+typedef ConvolutionType<
+    Im2ColConvolution<ValidConvolution>,
+    Im2ColConvolution<FullConvolution>,
+    Im2ColConvolution<ValidConvolution>,
+    arma::mat
+> GEMMConvolution;
+
 } // namespace mlpack
 
 // Include implementation.
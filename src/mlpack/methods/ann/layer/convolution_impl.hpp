@@ -319,8 +319,46 @@ void ConvolutionType<
 
   MakeAlias(outputTemp, output, this->outputDimensions[0],
       this->outputDimensions[1], maps * higherInDimensions * batchSize);
+
+  if constexpr (IsIm2ColConvolution<ForwardConvolutionRule>::value)
+  {
+    // Compute all the output maps of each point with one matrix
+    // multiplication.  The rows of the maps are along the width.
+    ForwardConvolutionRule::ForwardLayer(inputTemp, weight, inMaps, 1,
+        strideWidth, strideHeight, outputTemp);
+
+    if (useBias)
+    {
+      #pragma omp parallel for
+      for (size_t i = 0; i < outputTemp.n_slices; ++i)
+        outputTemp.slice(i) += bias(i % maps);
+    }
+
+    return;
+  }
+
   outputTemp.zeros();
 
+  // The Winograd rule transforms each filter only once, for all the points.
+  CubeType transformedWeight;
+  bool useTransformedWeight = false;
+  if constexpr (IsWinogradConvolution<ForwardConvolutionRule>::value)
+  {
+    useTransformedWeight = ForwardConvolutionRule::Supported(kernelWidth,
+        kernelHeight, strideWidth, strideHeight) && inputTemp.n_rows >= 3 &&
+        inputTemp.n_cols >= 3;
+    if (useTransformedWeight)
+    {
+      transformedWeight.set_size(4, 4, weight.n_slices);
+      #pragma omp parallel for
+      for (size_t i = 0; i < weight.n_slices; ++i)
+      {
+        ForwardConvolutionRule::TransformFilter(weight.slice(i),
+            transformedWeight.slice(i));
+      }
+    }
+  }
+
   // We "ignore" dimensions higher than the third---that means that we just pass
   // them through and treat them like different input points.
   //
@@ -339,6 +377,19 @@ void ConvolutionType<
       // Iterate over input maps (we will apply the filter and sum).
       for (size_t inMap = 0; inMap < inMaps; ++inMap)
       {
+        if constexpr (IsWinogradConvolution<ForwardConvolutionRule>::value)
+        {
+          if (useTransformedWeight)
+          {
+            ForwardConvolutionRule::TransformedConvolution(
+                inputTemp.slice(inMap + fullInputOffset),
+                transformedWeight.slice((outMap * inMaps) + inMap),
+                convOutput,
+                true);
+            continue;
+          }
+        }
+
         ForwardConvolutionRule::Convolution(
             inputTemp.slice(inMap + fullInputOffset),
             weight.slice((outMap * inMaps) + inMap),
@@ -385,6 +436,31 @@ void ConvolutionType<
   const bool usingPadding =
       (padWLeft != 0 || padWRight != 0 || padHTop != 0 || padHBottom != 0);
 
+  if constexpr (IsIm2ColConvolution<BackwardConvolutionRule>::value)
+  {
+    if (!usingPadding)
+    {
+      BackwardConvolutionRule::BackwardLayer(mappedError, weight, inMaps, 1,
+          strideWidth, strideHeight, gTemp);
+    }
+    else
+    {
+      // Compute the gradient with respect to the padded input, and then drop
+      // the padding.
+      CubeType paddedG(this->inputDimensions[0] + padWLeft + padWRight,
+          this->inputDimensions[1] + padHTop + padHBottom, gTemp.n_slices);
+      BackwardConvolutionRule::BackwardLayer(mappedError, weight, inMaps, 1,
+          strideWidth, strideHeight, paddedG);
+      gTemp = paddedG.tube(
+          padWLeft,
+          padHTop,
+          padWLeft + gTemp.n_rows - 1,
+          padHTop + gTemp.n_cols - 1);
+    }
+
+    return;
+  }
+
   // To perform the backward pass, we need to rotate all the filters.
   CubeType rotatedFilters(weight.n_rows,
       weight.n_cols, weight.n_slices);
@@ -500,6 +576,27 @@ void ConvolutionType<
   const size_t paddedRows = this->inputDimensions[0] + padWLeft + padWRight;
   const size_t paddedCols = this->inputDimensions[1] + padHTop + padHBottom;
 
+  if constexpr (IsIm2ColConvolution<GradientConvolutionRule>::value)
+  {
+    CubeType inputTemp;
+    MakeAlias(inputTemp, (usingPadding ? inputPadded : input), paddedRows,
+        paddedCols, inMaps * higherInDimensions * batchSize);
+
+    MakeAlias(gradientTemp, gradient, weight.n_rows, weight.n_cols,
+        weight.n_slices);
+    GradientConvolutionRule::GradientLayer(inputTemp, mappedError, inMaps, 1,
+        strideWidth, strideHeight, gradientTemp);
+
+    if (useBias)
+    {
+      gradient.rows(weight.n_elem, gradient.n_elem - 1).zeros();
+      for (size_t i = 0; i < mappedError.n_slices; ++i)
+        gradient[weight.n_elem + (i % maps)] += accu(mappedError.slice(i));
+    }
+
+    return;
+  }
+
   CubeType inputTemp(
       const_cast<MatType&>(usingPadding ? inputPadded : input).memptr(),
       paddedRows, paddedCols, inMaps * batchSize, false, false);
@@ -548,6 +645,49 @@ void ConvolutionType<
   }
 }
 
+template<
+    typename ForwardConvolutionRule,
+    typename BackwardConvolutionRule,
+    typename GradientConvolutionRule,
+    typename MatType
+>
+bool ConvolutionType<
+    ForwardConvolutionRule,
+    BackwardConvolutionRule,
+    GradientConvolutionRule,
+    MatType
+>::FoldAffine(const MatType& scale, const MatType& shift)
+{
+  const size_t mapSize = this->outputDimensions[0] *
+      this->outputDimensions[1];
+  const size_t outputSize = mapSize * maps * higherInDimensions;
+  if (scale.n_elem != outputSize || shift.n_elem != outputSize)
+    return false;
+
+  // The output of a point is a series of maps; map i is computed with the
+  // filters of output map (i % maps).  The transformation of each output map
+  // must be the same for all of its elements.
+  for (size_t i = 0; i < outputSize; ++i)
+  {
+    const size_t first = ((i / mapSize) % maps) * mapSize;
+    if (scale(i) != scale(first) || shift(i) != shift(first))
+      return false;
+  }
+
+  if (!useBias && any(vectorise(shift) != 0))
+    return false;
+
+  for (size_t outMap = 0; outMap < maps; ++outMap)
+  {
+    const size_t first = outMap * mapSize;
+    weight.slices(outMap * inMaps, (outMap + 1) * inMaps - 1) *= scale(first);
+    if (useBias)
+      bias(outMap) = scale(first) * bias(outMap) + shift(first);
+  }
+
+  return true;
+}
+
 template<
     typename ForwardConvolutionRule,
     typename BackwardConvolutionRule,
@@ -17,6 +17,7 @@
 #include <mlpack/prereqs.hpp>
 
 #include "layer.hpp"
+#include "dropout_mask.hpp"
 
 namespace mlpack {
 
@@ -139,9 +140,6 @@ class DropConnectType : public Layer<MatType>
   //! The scale fraction.
   double scale;
 
-  //! Locally-stored mask object.
-  MatType mask;
-
   //! Denoise mask for the weights.
   MatType denoise;
 
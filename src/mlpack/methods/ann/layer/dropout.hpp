@@ -16,6 +16,7 @@
 #include <mlpack/prereqs.hpp>
 
 #include "layer.hpp"
+#include "dropout_mask.hpp"
 
 namespace mlpack {
 
@@ -23,7 +24,8 @@ namespace mlpack {
  * The dropout layer is a regularizer that randomly with probability 'ratio'
  * sets input values to zero and scales the remaining elements by factor 1 /
  * (1 - ratio) rather than during test time so as to keep the expected sum same.
- * When the layer is in testing mode, there is no change in the input.
+ * When the layer is in testing mode, there is no change in the input.  The
+ * mask of the dropped values is kept with one bit per value (see DropoutMask).
  *
  * For more information, see the following.
  *
@@ -107,8 +109,8 @@ class DropoutType : public Layer<MatType>
   void serialize(Archive& ar, const uint32_t /* version */);
 
  private:
-  //! Locally-stored mask object.
-  MatType mask;
+  //! Locally-stored mask of the kept values.
+  DropoutMask mask;
 
   //! The probability of setting a value to zero.
   double ratio;
@@ -86,16 +86,8 @@ void DropoutType<MatType>::Forward(const MatType& input, MatType& output)
   {
     // Scale with input / (1 - ratio) and set values to zero with probability
     // 'ratio'.
-    mask.randu(input.n_rows, input.n_cols);
-    #pragma omp parallel for collapse(2)
-    for (size_t i = 0; i < input.n_rows; ++i)
-    {
-      for (size_t j = 0; j < input.n_cols; ++j)
-      {
-        mask(i, j) = (mask(i, j) > this->ratio) ? 1.0 : 0.0;
-      }
-    }
-    output = input % mask * this->scale;
+    mask.Generate(input.n_rows, input.n_cols, this->ratio);
+    mask.Apply(input, output, this->scale);
   }
 }
 
@@ -106,7 +98,7 @@ void DropoutType<MatType>::Backward(
     const MatType& gy,
     MatType& g)
 {
-  g = gy % mask * scale;
+  mask.Apply(gy, g, scale);
 }
 
 template<typename MatType>
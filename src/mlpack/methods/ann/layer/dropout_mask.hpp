@@ -0,0 +1,178 @@
+/**
+ * @file methods/ann/layer/dropout_mask.hpp
+ *
+ * Definition of the DropoutMask class, a bit-packed random mask for the dropout
+ * layers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_DROPOUT_MASK_HPP
+#define MLPACK_METHODS_ANN_LAYER_DROPOUT_MASK_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+
+#include <bitset>
+
+namespace mlpack {
+
+/**
+ * The DropoutMask class holds a random mask of kept and dropped elements, with
+ * one bit per element.  The bits are generated by a counter-based generator:
+ * the bits of element i only depend on i and on a key drawn from RandGen() for
+ * each mask, so the mask is reproducible with RandomSeed(), every part of it
+ * can be generated independently (in parallel), and the generation loops have
+ * no dependencies between iterations, so they can be vectorized.  Each 64-bit
+ * hash (the SplitMix64 finalizer) gives the 32-bit uniform values of two
+ * elements.
+ *
+ * The mask is applied with branch-free loops, which expand the bits of each
+ * 64-bit word of the mask.
+ */
+class DropoutMask
+{
+ public:
+  //! Create an empty mask.
+  DropoutMask() : numRows(0), numCols(0) { }
+
+  /**
+   * Draw a new mask for a matrix of the given size, where each element is
+   * dropped with the given probability.
+   *
+   * @param rows Number of rows of the matrix.
+   * @param cols Number of columns of the matrix.
+   * @param ratio Probability of dropping each element.
+   */
+  void Generate(const size_t rows, const size_t cols, const double ratio)
+  {
+    numRows = rows;
+    numCols = cols;
+    const size_t n = rows * cols;
+    words.resize((n + 63) / 64);
+
+    // An element is kept if its 32-bit value is at least the threshold, so a
+    // ratio of 0 keeps every element and a ratio of 1 drops every element.
+    const uint64_t threshold = (uint64_t) std::min(std::ceil(ratio *
+        4294967296.0), 4294967296.0);
+    const uint64_t key = (((uint64_t) RandGen()()) << 32) |
+        ((uint64_t) RandGen()());
+
+    #pragma omp parallel for schedule(static)
+    for (size_t w = 0; w < words.size(); ++w)
+    {
+      uint64_t word = 0;
+      for (size_t p = 0; p < 32; ++p)
+      {
+        const uint64_t h = Hash(key + 0x9E3779B97F4A7C15ULL * (32 * w + p));
+        word |= ((uint64_t) ((h & 0xFFFFFFFFULL) >= threshold)) << (2 * p);
+        word |= ((uint64_t) ((h >> 32) >= threshold)) << (2 * p + 1);
+      }
+      words[w] = word;
+    }
+
+    // Clear the bits past the last element, so they are never counted.
+    if (n % 64 != 0)
+      words.back() &= (((uint64_t) 1) << (n % 64)) - 1;
+  }
+
+  /**
+   * Compute output = keptScale * input + keptOffset for the kept elements, and
+   * output = droppedValue for the dropped elements.  The input must have the
+   * size of the mask.
+   *
+   * @param input Input matrix.
+   * @param output Output matrix (may be the input).
+   * @param keptScale Scale of the kept elements.
+   * @param keptOffset Offset of the kept elements.
+   * @param droppedValue Value of the dropped elements.
+   */
+  template<typename InputType, typename OutputType>
+  void Apply(const InputType& input,
+             OutputType& output,
+             const typename InputType::elem_type keptScale,
+             const typename InputType::elem_type keptOffset = 0,
+             const typename InputType::elem_type droppedValue = 0) const
+  {
+    typedef typename InputType::elem_type ElemType;
+    if (input.n_rows != numRows || input.n_cols != numCols)
+    {
+      std::ostringstream oss;
+      oss << "DropoutMask::Apply(): the input has size " << input.n_rows
+          << " x " << input.n_cols << ", but the mask has size " << numRows
+          << " x " << numCols;
+      throw std::invalid_argument(oss.str());
+    }
+
+    output.set_size(input.n_rows, input.n_cols);
+    const ElemType* in = input.memptr();
+    ElemType* out = output.memptr();
+
+    #pragma omp parallel for schedule(static)
+    for (size_t w = 0; w < words.size(); ++w)
+    {
+      const uint64_t word = words[w];
+      const size_t begin = 64 * w;
+      const size_t end = std::min(begin + 64, (size_t) input.n_elem);
+      for (size_t i = begin; i < end; ++i)
+      {
+        const ElemType kept = (ElemType) ((word >> (i - begin)) & 1);
+        out[i] = kept * (keptScale * in[i] + keptOffset) +
+            (1 - kept) * droppedValue;
+      }
+    }
+  }
+
+  //! Return whether the given element is kept.
+  bool Kept(const size_t i) const { return (words[i / 64] >> (i % 64)) & 1; }
+
+  //! Get the number of rows of the mask.
+  size_t NumRows() const { return numRows; }
+  //! Get the number of columns of the mask.
+  size_t NumCols() const { return numCols; }
+
+  //! Get the number of kept elements.
+  size_t NumKept() const
+  {
+    size_t count = 0;
+    for (size_t w = 0; w < words.size(); ++w)
+      count += std::bitset<64>(words[w]).count();
+    return count;
+  }
+
+  //! Get the mask as a matrix, with 1 for the kept elements and 0 for the
+  //! dropped ones.
+  template<typename MatType>
+  MatType Expand() const
+  {
+    MatType ones(numRows, numCols, arma::fill::ones);
+    MatType mask;
+    Apply(ones, mask, 1);
+    return mask;
+  }
+
+  //! Get the words of the mask (element i is bit i % 64 of word i / 64).
+  const std::vector<uint64_t>& Words() const { return words; }
+
+ private:
+  //! The SplitMix64 finalizer.
+  static uint64_t Hash(uint64_t z)
+  {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  //! The number of rows of the mask.
+  size_t numRows;
+  //! The number of columns of the mask.
+  size_t numCols;
+  //! The bits of the mask, 64 elements per word.
+  std::vector<uint64_t> words;
+};
+
+} // namespace mlpack
+
+#endif
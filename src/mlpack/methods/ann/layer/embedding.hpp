@@ -0,0 +1,169 @@
+/**
+ * @file methods/ann/layer/embedding.hpp
+ *
+ * Definition of the Embedding layer, which stores one embedding vector for
+ * each token of a vocabulary and looks them up by index.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_EMBEDDING_HPP
+#define MLPACK_METHODS_ANN_LAYER_EMBEDDING_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "layer.hpp"
+
+namespace mlpack {
+
+/**
+ * The Embedding layer stores an embedding vector of length `embeddingSize`
+ * for each of the `vocabSize` tokens of a vocabulary, and replaces each token
+ * of its input by its embedding.  Each element of the input is the index of a
+ * token, between 0 and `vocabSize - 1`; an input point with `n` tokens gives
+ * an output point with `embeddingSize * n` elements, where the embedding of
+ * each token is contiguous.  This is the same as multiplying a one-hot
+ * encoding of each token with a Linear layer without bias, but the cost of a
+ * pass depends only on the number of tokens, not on the size of the
+ * vocabulary.
+ *
+ * In `Gradient()`, only the embeddings of the tokens in the batch get a
+ * nonzero gradient, which is accumulated directly into their columns.  The
+ * backpropagated error of the indices is zero, so this layer is usually the
+ * first layer of a network.
+ *
+ * The indices are stored as elements of `MatType`, so with single-precision
+ * matrices the vocabulary size must be at most 2^24.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class EmbeddingType : public Layer<MatType>
+{
+ public:
+  //! Create the Embedding object.
+  EmbeddingType();
+
+  /**
+   * Create the Embedding layer object with the given vocabulary size and
+   * embedding size.
+   *
+   * @param vocabSize Number of tokens in the vocabulary.
+   * @param embeddingSize Length of the embedding vector of each token.
+   */
+  EmbeddingType(const size_t vocabSize, const size_t embeddingSize);
+
+  virtual ~EmbeddingType() { }
+
+  //! Clone the EmbeddingType object. This handles polymorphism correctly.
+  EmbeddingType* Clone() const { return new EmbeddingType(*this); }
+
+  //! Copy the other Embedding layer (but not weights).
+  EmbeddingType(const EmbeddingType& layer);
+
+  //! Take ownership of the members of the other Embedding layer (but not
+  //! weights).
+  EmbeddingType(EmbeddingType&& layer);
+
+  //! Copy the other Embedding layer (but not weights).
+  EmbeddingType& operator=(const EmbeddingType& layer);
+
+  //! Take ownership of the members of the other Embedding layer (but not
+  //! weights).
+  EmbeddingType& operator=(EmbeddingType&& layer);
+
+  /**
+   * Reset the layer parameter (the embeddings). The method is called to
+   * assign the allocated memory to the internal learnable parameters.
+   */
+  void SetWeights(const MatType& weightsIn);
+
+  /**
+   * Ordinary feed forward pass of a neural network: replace each token of the
+   * input by its embedding.  A std::invalid_argument is thrown if a token is
+   * not in the vocabulary.
+   *
+   * @param input Indices of the tokens of each input point.
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * Ordinary feed backward pass of a neural network.  The indices of the
+   * tokens cannot be differentiated, so the backpropagated error is zero.
+   *
+   * @param input The input data (x) given to the forward pass.
+   * @param output The propagated data (f(x)) resulting from Forward()
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  void Backward(const MatType& input,
+                const MatType& /* output */,
+                const MatType& /* gy */,
+                MatType& g);
+
+  /**
+   * Calculate the gradient of the embeddings using the output delta and the
+   * tokens of the input.  Only the embeddings of the tokens of the batch get a
+   * nonzero gradient.
+   *
+   * @param input The input parameter used for calculating the gradient.
+   * @param error The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  void Gradient(const MatType& input,
+                const MatType& error,
+                MatType& gradient);
+
+  //! Get the parameters.
+  const MatType& Parameters() const { return weights; }
+  //! Modify the parameters.
+  MatType& Parameters() { return weights; }
+
+  //! Get the embeddings; each column is the embedding of one token.
+  MatType const& Weight() const { return weights; }
+  //! Modify the embeddings.
+  MatType& Weight() { return weights; }
+
+  //! Get the number of tokens in the vocabulary.
+  size_t VocabSize() const { return vocabSize; }
+
+  //! Get the length of the embedding vector of each token.
+  size_t EmbeddingSize() const { return embeddingSize; }
+
+  //! Get the size of the weights.
+  size_t WeightSize() const { return embeddingSize * vocabSize; }
+
+  //! Compute the output dimensions of the layer given `InputDimensions()`.
+  //! This layer adds a first dimension for the embeddings.
+  void ComputeOutputDimensions();
+
+  //! Serialize the layer.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored number of tokens in the vocabulary.
+  size_t vocabSize;
+
+  //! Locally-stored length of each embedding vector.
+  size_t embeddingSize;
+
+  //! Locally-stored embeddings (embeddingSize x vocabSize).
+  MatType weights;
+}; // class EmbeddingType
+
+// Convenience typedefs.
+
+// Standard Embedding layer.
+typedef EmbeddingType<arma::mat> Embedding;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "embedding_impl.hpp"
+
+#endif
@@ -0,0 +1,166 @@
+/**
+ * @file methods/ann/layer/embedding_impl.hpp
+ *
+ * Implementation of the Embedding layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_EMBEDDING_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_EMBEDDING_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "embedding.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+EmbeddingType<MatType>::EmbeddingType() :
+    Layer<MatType>(),
+    vocabSize(0),
+    embeddingSize(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+EmbeddingType<MatType>::EmbeddingType(const size_t vocabSize,
+                                      const size_t embeddingSize) :
+    Layer<MatType>(),
+    vocabSize(vocabSize),
+    embeddingSize(embeddingSize)
+{
+  // Nothing to do here.
+}
+
+// Copy constructor.
+template<typename MatType>
+EmbeddingType<MatType>::EmbeddingType(const EmbeddingType& layer) :
+    Layer<MatType>(layer),
+    vocabSize(layer.vocabSize),
+    embeddingSize(layer.embeddingSize)
+{
+  // Nothing else to do.
+}
+
+// Move constructor.
+template<typename MatType>
+EmbeddingType<MatType>::EmbeddingType(EmbeddingType&& layer) :
+    Layer<MatType>(std::move(layer)),
+    vocabSize(std::move(layer.vocabSize)),
+    embeddingSize(std::move(layer.embeddingSize))
+{
+  // Nothing else to do.
+}
+
+template<typename MatType>
+EmbeddingType<MatType>&
+EmbeddingType<MatType>::operator=(const EmbeddingType& layer)
+{
+  if (&layer != this)
+  {
+    Layer<MatType>::operator=(layer);
+    vocabSize = layer.vocabSize;
+    embeddingSize = layer.embeddingSize;
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+EmbeddingType<MatType>&
+EmbeddingType<MatType>::operator=(EmbeddingType&& layer)
+{
+  if (&layer != this)
+  {
+    Layer<MatType>::operator=(std::move(layer));
+    vocabSize = std::move(layer.vocabSize);
+    embeddingSize = std::move(layer.embeddingSize);
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+void EmbeddingType<MatType>::SetWeights(const MatType& weightsIn)
+{
+  MakeAlias(weights, weightsIn, embeddingSize, vocabSize);
+}
+
+template<typename MatType>
+void EmbeddingType<MatType>::Forward(const MatType& input, MatType& output)
+{
+  if (input.n_elem > 0 && (input.min() < 0 || input.max() >= vocabSize))
+  {
+    throw std::invalid_argument("Embedding::Forward(): token index outside "
+        "of the vocabulary!");
+  }
+
+  const size_t tokens = input.n_rows;
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) input.n_cols; ++i)
+  {
+    for (size_t t = 0; t < tokens; ++t)
+    {
+      output.submat(t * embeddingSize, i, (t + 1) * embeddingSize - 1, i) =
+          weights.col((size_t) input(t, i));
+    }
+  }
+}
+
+template<typename MatType>
+void EmbeddingType<MatType>::Backward(
+    const MatType& input,
+    const MatType& /* output */,
+    const MatType& /* gy */,
+    MatType& g)
+{
+  g.zeros(input.n_rows, input.n_cols);
+}
+
+template<typename MatType>
+void EmbeddingType<MatType>::Gradient(
+    const MatType& input,
+    const MatType& error,
+    MatType& gradient)
+{
+  // Scatter the error of each token into the gradient of its embedding.
+  MatType embeddingGradient;
+  MakeAlias(embeddingGradient, gradient, embeddingSize, vocabSize);
+  embeddingGradient.zeros();
+  for (size_t i = 0; i < (size_t) input.n_cols; ++i)
+  {
+    for (size_t t = 0; t < (size_t) input.n_rows; ++t)
+    {
+      embeddingGradient.col((size_t) input(t, i)) += error.submat(
+          t * embeddingSize, i, (t + 1) * embeddingSize - 1, i);
+    }
+  }
+}
+
+template<typename MatType>
+void EmbeddingType<MatType>::ComputeOutputDimensions()
+{
+  this->outputDimensions = std::vector<size_t>(
+      this->inputDimensions.size() + 1, embeddingSize);
+  for (size_t i = 0; i < this->inputDimensions.size(); ++i)
+    this->outputDimensions[i + 1] = this->inputDimensions[i];
+}
+
+template<typename MatType>
+template<typename Archive>
+void EmbeddingType<MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(vocabSize));
+  ar(CEREAL_NVP(embeddingSize));
+}
+
+} // namespace mlpack
+
+#endif
@@ -72,7 +72,7 @@ FTSwishType<MatType>::operator=(FTSwishType&& other)
 template<typename MatType>
 void FTSwishType<MatType>::Forward(const MatType& input, MatType& output)
 {
-  #pragma omp for
+  #pragma omp parallel for
   for (size_t i = 0; i < (size_t) input.n_elem; ++i)
   {
     if (input(i) >= 0)
@@ -89,7 +89,7 @@ void FTSwishType<MatType>::Backward(
     const MatType& gy,
     MatType& g)
 {
-  #pragma omp for
+  #pragma omp parallel for
   for (size_t i = 0; i < (size_t) input.n_elem; ++i)
   {
     if (input(i) >= 0)
@@ -18,6 +18,7 @@
 #include <mlpack/methods/ann/convolution_rules/border_modes.hpp>
 #include <mlpack/methods/ann/convolution_rules/naive_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/fft_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/im2col_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/svd_convolution.hpp>
 #include <mlpack/core/util/to_lower.hpp>
 
@@ -424,6 +425,14 @@ typedef GroupedConvolutionType<
     arma::mat
 > GroupedConvolution;
 
+// GroupedConvolution layer that computes each pass with matrix multiplications.
+typedef GroupedConvolutionType<
+    Im2ColConvolution<ValidConvolution>,
+    Im2ColConvolution<FullConvolution>,
+    Im2ColConvolution<ValidConvolution>,
+    arma::mat
+> GEMMGroupedConvolution;
+
 } // namespace mlpack
 
 // Include implementation.
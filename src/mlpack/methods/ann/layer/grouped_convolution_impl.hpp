@@ -329,6 +329,24 @@ void GroupedConvolutionType<
 
   MakeAlias(outputTemp, output, this->outputDimensions[0],
       this->outputDimensions[1], maps * higherInDimensions * batchSize);
+
+  if constexpr (IsIm2ColConvolution<ForwardConvolutionRule>::value)
+  {
+    // Compute all the output maps of each group of each point with one matrix
+    // multiplication.  The rows of the maps are along the width.
+    ForwardConvolutionRule::ForwardLayer(inputTemp, weight, inMaps, groups,
+        strideWidth, strideHeight, outputTemp);
+
+    if (useBias)
+    {
+      #pragma omp parallel for
+      for (size_t i = 0; i < outputTemp.n_slices; ++i)
+        outputTemp.slice(i) += bias(i % maps);
+    }
+
+    return;
+  }
+
   outputTemp.zeros();
 
   size_t inGroupSize = inMaps / groups;
@@ -403,6 +421,31 @@ void GroupedConvolutionType<
   const bool usingPadding =
       (padWLeft != 0 || padWRight != 0 || padHTop != 0 || padHBottom != 0);
 
+  if constexpr (IsIm2ColConvolution<BackwardConvolutionRule>::value)
+  {
+    if (!usingPadding)
+    {
+      BackwardConvolutionRule::BackwardLayer(mappedError, weight, inMaps,
+          groups, strideWidth, strideHeight, gTemp);
+    }
+    else
+    {
+      // Compute the gradient with respect to the padded input, and then drop
+      // the padding.
+      CubeType paddedG(this->inputDimensions[0] + padWLeft + padWRight,
+          this->inputDimensions[1] + padHTop + padHBottom, gTemp.n_slices);
+      BackwardConvolutionRule::BackwardLayer(mappedError, weight, inMaps,
+          groups, strideWidth, strideHeight, paddedG);
+      gTemp = paddedG.tube(
+          padWLeft,
+          padHTop,
+          padWLeft + gTemp.n_rows - 1,
+          padHTop + gTemp.n_cols - 1);
+    }
+
+    return;
+  }
+
   // To perform the backward pass, we need to rotate all the filters.
   CubeType rotatedFilters(weight.n_rows,
       weight.n_cols, weight.n_slices);
@@ -527,6 +570,27 @@ void GroupedConvolutionType<
   const size_t paddedRows = this->inputDimensions[0] + padWLeft + padWRight;
   const size_t paddedCols = this->inputDimensions[1] + padHTop + padHBottom;
 
+  if constexpr (IsIm2ColConvolution<GradientConvolutionRule>::value)
+  {
+    CubeType inputTemp;
+    MakeAlias(inputTemp, (usingPadding ? inputPadded : input), paddedRows,
+        paddedCols, inMaps * higherInDimensions * batchSize);
+
+    MakeAlias(gradientTemp, gradient, weight.n_rows, weight.n_cols,
+        weight.n_slices);
+    GradientConvolutionRule::GradientLayer(inputTemp, mappedError, inMaps,
+        groups, strideWidth, strideHeight, gradientTemp);
+
+    if (useBias)
+    {
+      gradient.rows(weight.n_elem, gradient.n_elem - 1).zeros();
+      for (size_t i = 0; i < mappedError.n_slices; ++i)
+        gradient[weight.n_elem + (i % maps)] += accu(mappedError.slice(i));
+    }
+
+    return;
+  }
+
   CubeType inputTemp(
       const_cast<MatType&>(usingPadding ? inputPadded : input).memptr(),
       paddedRows, paddedCols, inMaps * batchSize, false, false);
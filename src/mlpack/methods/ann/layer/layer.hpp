@@ -271,6 +271,62 @@ class Layer
       const size_t /* elements */)
   { /* Nothing to do here */ }
 
+  /**
+   * Fold an element-wise affine transformation of the output into the weights
+   * of the layer, so that afterwards Forward() computes `scale % y + shift` for
+   * each output point `y` it computed before.  This is used to remove layers
+   * like BatchNorm from a trained network (see `FFN::FuseLayers()`).  If the
+   * layer cannot represent the transformation, it is not modified and false is
+   * returned; this is what the default implementation does.
+   *
+   * @param * (scale) Column vector with `OutputSize()` scaling factors.
+   * @param * (shift) Column vector with `OutputSize()` offsets.
+   * @return Whether the transformation was folded into the layer.
+   */
+  virtual bool FoldAffine(const MatType& /* scale */,
+                          const MatType& /* shift */)
+  {
+    return false;
+  }
+
+  //! Return true if the forward pass of the layer is element-wise and can be
+  //! computed in place (with `input` and `output` the same object).  This is
+  //! used to apply activations directly on the output of the previous layer at
+  //! inference time.
+  virtual bool ElementWise() const { return false; }
+
+  /**
+   * Create an inference-only version of the layer that uses 8-bit integer
+   * weights and inputs, for faster prediction (see `FFN::Quantize()`).  The
+   * caller owns the returned layer.  If the layer has no quantized version,
+   * nullptr is returned; this is what the default implementation does.
+   *
+   * @param * (inputRange) Largest absolute value that the inputs of the layer
+   *     are expected to have.
+   */
+  virtual Layer* Quantized(const double /* inputRange */) const
+  {
+    return nullptr;
+  }
+
+  /**
+   * Create an inference-only version of the layer whose weights are pruned to
+   * the given sparsity and stored in a sparse form, for faster prediction (see
+   * `FFN::Prune()`).  The caller owns the returned layer.  If the layer has no
+   * pruned version, nullptr is returned; this is what the default
+   * implementation does.
+   *
+   * @param * (sparsity) Fraction of the blocks of weights to set to zero.
+   * @param * (blockRows) Number of rows of each block of weights.
+   * @param * (blockCols) Number of columns of each block of weights.
+   */
+  virtual Layer* Pruned(const double /* sparsity */,
+                        const size_t /* blockRows */,
+                        const size_t /* blockCols */) const
+  {
+    return nullptr;
+  }
+
   //! Compute the output dimensions.  This should be overloaded if the layer is
   //! meant to work on higher-dimensional objects.  When this is called, it is a
   //! safe assumption that InputDimensions() is correct.
@@ -73,7 +73,7 @@ LeakyReLUType<MatType>::operator=(LeakyReLUType&& other)
 template<typename MatType>
 void LeakyReLUType<MatType>::Forward(const MatType& input, MatType& output)
 {
-  #pragma omp for
+  #pragma omp parallel for
   for (size_t i = 0; i < (size_t) input.n_elem; ++i)
     output(i) = std::max(input(i), (typename MatType::elem_type) alpha *
         input(i));
@@ -86,7 +86,7 @@ void LeakyReLUType<MatType>::Backward(
     const MatType& gy,
     MatType& g)
 {
-  #pragma omp for
+  #pragma omp parallel for
   for (size_t i = 0; i < (size_t) input.n_elem; ++i)
     g(i) = gy(i) * ((input(i) >= 0) ? 1 : alpha);
 }
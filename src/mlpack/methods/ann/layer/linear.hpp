@@ -17,6 +17,8 @@
 #include <mlpack/methods/ann/regularizer/no_regularizer.hpp>
 
 #include "layer.hpp"
+#include "block_sparse_linear.hpp"
+#include "quantized_linear.hpp"
 
 namespace mlpack {
 
@@ -118,6 +120,47 @@ class LinearType : public Layer<MatType>
                 const MatType& error,
                 MatType& gradient);
 
+  /**
+   * Fold the element-wise transformation `scale % y + shift` of the output `y`
+   * into the weights and the bias of the layer.
+   *
+   * @param scale Column vector with `outSize` scaling factors.
+   * @param shift Column vector with `outSize` offsets.
+   * @return Whether the transformation was folded (it always is if the sizes
+   *     are right).
+   */
+  bool FoldAffine(const MatType& scale, const MatType& shift);
+
+  /**
+   * Create a QuantizedLinear layer with the weights and the bias of this
+   * layer.
+   *
+   * @param inputRange Largest absolute value that the inputs of the layer are
+   *     expected to have.
+   */
+  QuantizedLinearType<MatType>* Quantized(const double inputRange) const
+  {
+    return new QuantizedLinearType<MatType>(weight, bias, inputRange);
+  }
+
+  /**
+   * Create a BlockSparseLinear layer with the bias of this layer and its
+   * weights pruned by magnitude (see `PruneBlocks()`).
+   *
+   * @param sparsity Fraction of the blocks of weights to set to zero.
+   * @param blockRows Number of rows of each block of weights.
+   * @param blockCols Number of columns of each block of weights.
+   */
+  BlockSparseLinearType<MatType>* Pruned(const double sparsity,
+                                         const size_t blockRows,
+                                         const size_t blockCols) const
+  {
+    MatType prunedWeight(weight);
+    PruneBlocks(prunedWeight, sparsity, blockRows, blockCols);
+    return new BlockSparseLinearType<MatType>(prunedWeight, bias, blockRows,
+        blockCols);
+  }
+
   //! Get the parameters.
   const MatType& Parameters() const { return weights; }
   //! Modify the parameters.
@@ -106,7 +106,7 @@ void LinearType<MatType, RegularizerType>::Forward(
 {
   output = weight * input;
 
-  #pragma omp for
+  #pragma omp parallel for
   for (size_t c = 0; c < (size_t) output.n_cols; ++c)
     output.col(c) += bias;
 }
@@ -132,6 +132,20 @@ void LinearType<MatType, RegularizerType>::Gradient(
   regularizer.Evaluate(weights, gradient);
 }
 
+template<typename MatType, typename RegularizerType>
+bool LinearType<MatType, RegularizerType>::FoldAffine(
+    const MatType& scale,
+    const MatType& shift)
+{
+  if (scale.n_elem != outSize || shift.n_elem != outSize)
+    return false;
+
+  // Each row of the weight matrix gives one output.
+  weight.each_col() %= vectorise(scale);
+  bias = vectorise(scale) % bias + vectorise(shift);
+  return true;
+}
+
 template<typename MatType, typename RegularizerType>
 void LinearType<MatType, RegularizerType>::ComputeOutputDimensions()
 {
@@ -16,6 +16,7 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/methods/ann/regularizer/no_regularizer.hpp>
 
+#include "block_sparse_linear.hpp"
 #include "layer.hpp"
 
 namespace mlpack {
@@ -104,6 +105,24 @@ class LinearNoBiasType : public Layer<MatType>
                 const MatType& error,
                 MatType& gradient);
 
+  /**
+   * Create a BlockSparseLinear layer (without bias) with the weights of this
+   * layer pruned by magnitude (see `PruneBlocks()`).
+   *
+   * @param sparsity Fraction of the blocks of weights to set to zero.
+   * @param blockRows Number of rows of each block of weights.
+   * @param blockCols Number of columns of each block of weights.
+   */
+  BlockSparseLinearType<MatType>* Pruned(const double sparsity,
+                                         const size_t blockRows,
+                                         const size_t blockCols) const
+  {
+    MatType prunedWeight(weight);
+    PruneBlocks(prunedWeight, sparsity, blockRows, blockCols);
+    return new BlockSparseLinearType<MatType>(prunedWeight, MatType(),
+        blockRows, blockCols);
+  }
+
   //! Get the parameters.
   const MatType& Parameters() const { return weight; }
   //! Modify the parameters.
@@ -127,6 +127,8 @@ class LSTMType : public RecurrentLayer<MatType>
   /**
    * Reset the recurrent state of the LSTM layer, and allocate enough space to
    * hold `bpttSteps` of previous passes with a batch size of `batchSize`.
+   * This also stacks the weights of the four gates for Forward(), so it must
+   * be called again when the weights change.
    *
    * @param bpttSteps Number of steps of history to allocate space for.
    * @param batchSize Batch size to prepare for.
@@ -208,19 +210,23 @@ class LSTMType : public RecurrentLayer<MatType>
   //! Weights between cell and output gate.
   MatType cell2GateOutputWeight;
 
-  // Below here are recurrent state matrices.
+  //! Input weights of the input gate, forget gate, hidden layer and output
+  //! gate, stacked (set by ClearRecurrentState()).
+  MatType inputWeights;
 
-  //! Locally-stored input gate parameter.
-  MatType inputGate;
+  //! Weights between the output and the input gate, forget gate, hidden layer
+  //! and output gate, stacked (set by ClearRecurrentState()).
+  MatType recurrentWeights;
 
-  //! Locally-stored forget gate parameter.
-  MatType forgetGate;
+  //! Biases of the input gate, forget gate, hidden layer and output gate,
+  //! stacked (set by ClearRecurrentState()).
+  MatType gateBias;
 
-  //! Locally-stored hidden layer parameter.
-  MatType hiddenLayer;
+  // Below here are recurrent state matrices.
 
-  //! Locally-stored output gate parameter.
-  MatType outputGate;
+  //! Locally-stored connections of the four gates, before the bias and the
+  //! cell connections.
+  MatType gates;
 
   //! Locally-stored input to hidden weight.
   MatType input2HiddenWeight;
@@ -268,6 +274,10 @@ class LSTMType : public RecurrentLayer<MatType>
 
   //! Locally-stored hidden layer error.
   MatType hiddenError;
+
+  //! The number of sequences of the later step in the last call to
+  //! Backward() (0 if there was no later step).
+  size_t laterBatchSize;
 }; // class LSTMType
 
 // Convenience typedefs.
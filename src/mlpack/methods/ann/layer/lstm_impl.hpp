@@ -35,14 +35,18 @@ LSTMType<MatType>::LSTMType(const size_t outSize) :
 
 template<typename MatType>
 LSTMType<MatType>::LSTMType(const LSTMType& layer) :
-    RecurrentLayer<MatType>(layer)
+    RecurrentLayer<MatType>(layer),
+    inSize(layer.inSize),
+    outSize(layer.outSize)
 {
   // Nothing to do here.
 }
 
 template<typename MatType>
 LSTMType<MatType>::LSTMType(LSTMType&& layer) :
-    RecurrentLayer<MatType>(std::move(layer))
+    RecurrentLayer<MatType>(std::move(layer)),
+    inSize(std::move(layer.inSize)),
+    outSize(std::move(layer.outSize))
 {
   // Nothing to do here.
 }
@@ -53,6 +57,8 @@ LSTMType<MatType>& LSTMType<MatType>::operator=(const LSTMType& layer)
   if (this != &layer)
   {
     RecurrentLayer<MatType>::operator=(layer);
+    inSize = layer.inSize;
+    outSize = layer.outSize;
   }
 
   return *this;
@@ -64,6 +70,8 @@ LSTMType<MatType>& LSTMType<MatType>::operator=(LSTMType&& layer)
   if (this != &layer)
   {
     RecurrentLayer<MatType>::operator=(std::move(layer));
+    inSize = std::move(layer.inSize);
+    outSize = std::move(layer.outSize);
   }
 
   return *this;
@@ -73,12 +81,21 @@ template<typename MatType>
 void LSTMType<MatType>::ClearRecurrentState(
     const size_t bpttSteps, const size_t batchSize)
 {
+  // The weights do not change during the passes over a sequence, so this is
+  // where the weights of the four gates are stacked for Forward(), in the
+  // order input gate, forget gate, hidden layer, output gate.
+  inputWeights = join_cols(join_cols(input2GateInputWeight,
+      input2GateForgetWeight), join_cols(input2HiddenWeight,
+      input2GateOutputWeight));
+  recurrentWeights = join_cols(join_cols(output2GateInputWeight,
+      output2GateForgetWeight), join_cols(output2HiddenWeight,
+      output2GateOutputWeight));
+  gateBias = join_cols(join_cols(input2GateInputBias, input2GateForgetBias),
+      join_cols(input2HiddenBias, input2GateOutputBias));
+
   // Make sure all of the different matrices we will use to hold parameters are
   // at least as large as we need.
-  inputGate.set_size(outSize, batchSize);
-  forgetGate.set_size(outSize, batchSize);
-  hiddenLayer.set_size(outSize, batchSize);
-  outputGate.set_size(outSize, batchSize);
+  gates.set_size(4 * outSize, batchSize);
 
   inputGateActivation.set_size(outSize, batchSize, bpttSteps);
   forgetGateActivation.set_size(outSize, batchSize, bpttSteps);
@@ -90,6 +107,7 @@ void LSTMType<MatType>::ClearRecurrentState(
 
   // Now reset recurrent values to 0.
   cell.zeros(outSize, batchSize, bpttSteps);
+  laterBatchSize = 0;
 }
 
 template<typename MatType>
@@ -151,88 +169,61 @@ void LSTMType<MatType>::SetWeights(const MatType& weights)
 template<typename MatType>
 void LSTMType<MatType>::Forward(const MatType& input, MatType& output)
 {
+  typedef typename MatType::elem_type ElemType;
+
   // Convenience alias.
   const size_t batchSize = input.n_cols;
+  const size_t current = this->CurrentStep();
 
-  inputGate = input2GateInputWeight * input;
-  if (this->HasPreviousStep())
-  {
-    inputGate +=
-        output2GateInputWeight * outParameter.slice(this->PreviousStep());
-  }
-  inputGate.each_col() += input2GateInputBias;
-
-  forgetGate = input2GateForgetWeight * input;
-  if (this->HasPreviousStep())
-  {
-    forgetGate += output2GateForgetWeight * outParameter.slice(
-        this->PreviousStep());
-  }
-  forgetGate.each_col() += input2GateForgetBias;
-
+  // Compute the connections of all four gates with one product for the input
+  // and one for the previous output.  With packed sequences, the batch may
+  // only hold the first sequences of the batch of the previous step.
+  gates = inputWeights * input;
   if (this->HasPreviousStep())
   {
-    inputGate += repmat(cell2GateInputWeight, 1, batchSize) %
-        cell.slice(this->PreviousStep());
-
-    forgetGate += repmat(cell2GateForgetWeight, 1, batchSize) %
-        cell.slice(this->PreviousStep());
+    gates += recurrentWeights *
+        outParameter.slice(this->PreviousStep()).head_cols(batchSize);
   }
 
-  inputGateActivation.slice(this->CurrentStep()) =
-      1.0 / (1.0 + exp(-inputGate));
-  forgetGateActivation.slice(this->CurrentStep()) =
-      1.0 / (1.0 + exp(-forgetGate));
-
-  hiddenLayer = input2HiddenWeight * input;
-  if (this->HasPreviousStep())
+  // Now compute the activations and the cell in a single pass.  Without a
+  // previous step, the previous cell is taken as 0, so the peephole and
+  // forget terms vanish.
+  for (size_t j = 0; j < batchSize; ++j)
   {
-    hiddenLayer += output2HiddenWeight *
-        outParameter.slice(this->PreviousStep());
+    const ElemType* g = gates.colptr(j);
+    const ElemType* previousCell = this->HasPreviousStep() ?
+        cell.slice(this->PreviousStep()).colptr(j) : NULL;
+
+    for (size_t i = 0; i < outSize; ++i)
+    {
+      const ElemType cellPrev = (previousCell == NULL) ? 0 : previousCell[i];
+
+      const ElemType inputGateValue = 1 / (1 + std::exp(-(g[i] + gateBias[i] +
+          cell2GateInputWeight[i] * cellPrev)));
+      const ElemType forgetGateValue = 1 / (1 + std::exp(-(g[outSize + i] +
+          gateBias[outSize + i] + cell2GateForgetWeight[i] * cellPrev)));
+      const ElemType hiddenValue = std::tanh(g[2 * outSize + i] +
+          gateBias[2 * outSize + i]);
+      const ElemType cellValue = forgetGateValue * cellPrev +
+          inputGateValue * hiddenValue;
+      const ElemType outputGateValue = 1 / (1 + std::exp(-(g[3 * outSize + i] +
+          gateBias[3 * outSize + i] + cell2GateOutputWeight[i] * cellValue)));
+      const ElemType cellActivationValue = std::tanh(cellValue);
+
+      inputGateActivation(i, j, current) = inputGateValue;
+      forgetGateActivation(i, j, current) = forgetGateValue;
+      hiddenLayerActivation(i, j, current) = hiddenValue;
+      cell(i, j, current) = cellValue;
+      outputGateActivation(i, j, current) = outputGateValue;
+      cellActivation(i, j, current) = cellActivationValue;
+
+      // We need to preserve the output for the next time step, so it is also
+      // copied into `output` below.
+      outParameter(i, j, current) = cellActivationValue * outputGateValue;
+    }
   }
-  hiddenLayer.each_col() += input2HiddenBias;
-
-  hiddenLayerActivation.slice(this->CurrentStep()) = arma::tanh(hiddenLayer);
 
-  if (!this->HasPreviousStep())
-  {
-    cell.slice(this->CurrentStep()) =
-        inputGateActivation.slice(this->CurrentStep()) %
-        hiddenLayerActivation.slice(this->CurrentStep());
-  }
-  else
-  {
-    cell.slice(this->CurrentStep()) =
-        forgetGateActivation.slice(this->CurrentStep()) %
-        cell.slice(this->PreviousStep()) +
-        inputGateActivation.slice(this->CurrentStep()) %
-        hiddenLayerActivation.slice(this->CurrentStep());
-  }
-
-  outputGate = input2GateOutputWeight * input +
-      cell.slice(this->CurrentStep()).each_col() % cell2GateOutputWeight;
-  if (this->HasPreviousStep())
-  {
-    outputGate +=
-        output2GateOutputWeight * outParameter.slice(this->PreviousStep());
-  }
-  outputGate.each_col() += input2GateOutputBias;
-
-  outputGateActivation.slice(this->CurrentStep()) =
-      1.0 / (1.0 + exp(-outputGate));
-
-  cellActivation.slice(this->CurrentStep()) =
-      arma::tanh(cell.slice(this->CurrentStep()));
-
-  // There's a bit of an issue here: we need to preserve the output for the next
-  // time step, but we also need to set `output` to that.  Unfortunately for now
-  // we make a copy, but it's possible that we could instead use an alias here,
-  // or have `outParameter` hold a collection of aliases.
-  outParameter.slice(this->CurrentStep()) =
-      cellActivation.slice(this->CurrentStep()) %
-      outputGateActivation.slice(this->CurrentStep());
-
-  output = outParameter.slice(this->CurrentStep());
+  output = outParameter.slice(current).head_cols(batchSize);
 }
 
 template<typename MatType>
@@ -242,13 +233,32 @@ void LSTMType<MatType>::Backward(
     const MatType& gy,
     MatType& g)
 {
+  const size_t batchSize = gy.n_cols;
+  const size_t current = this->CurrentStep();
+
+  // With packed sequences, the batch of this step may be smaller than the
+  // batch the states were allocated for, and the errors of the later step
+  // (from the last call) only cover its first `laterBatchSize` sequences; the
+  // other sequences end at this step.
+  laterBatchSize = this->HasPreviousStep() ? outputGateError.n_cols : 0;
+  MatType inputGate, forgetGate, outputGate, hidden, cellAct;
+  MakeAlias(inputGate, inputGateActivation.slice(current), outSize, batchSize);
+  MakeAlias(forgetGate, forgetGateActivation.slice(current), outSize,
+      batchSize);
+  MakeAlias(outputGate, outputGateActivation.slice(current), outSize,
+      batchSize);
+  MakeAlias(hidden, hiddenLayerActivation.slice(current), outSize, batchSize);
+  MakeAlias(cellAct, cellActivation.slice(current), outSize, batchSize);
+
   MatType gyLocal;
   if (this->HasPreviousStep())
   {
-    gyLocal = gy + output2GateOutputWeight.t() * outputGateError +
-      output2GateForgetWeight.t() * forgetGateError +
-      output2GateInputWeight.t() * inputGateError +
-      output2HiddenWeight.t() * hiddenError;
+    gyLocal = gy;
+    gyLocal.head_cols(laterBatchSize) +=
+        output2GateOutputWeight.t() * outputGateError +
+        output2GateForgetWeight.t() * forgetGateError +
+        output2GateInputWeight.t() * inputGateError +
+        output2HiddenWeight.t() * hiddenError;
   }
   else
   {
@@ -257,40 +267,32 @@ void LSTMType<MatType>::Backward(
         false, false);
   }
 
-  outputGateError = gyLocal % cellActivation.slice(this->CurrentStep()) %
-      (outputGateActivation.slice(this->CurrentStep()) %
-      (1.0 - outputGateActivation.slice(this->CurrentStep())));
+  outputGateError = gyLocal % cellAct % (outputGate % (1.0 - outputGate));
 
-  MatType cellError = gyLocal %
-      outputGateActivation.slice(this->CurrentStep()) %
-      (1 - pow(cellActivation.slice(this->CurrentStep()), 2)) +
+  MatType cellError = gyLocal % outputGate % (1 - pow(cellAct, 2)) +
       outputGateError.each_col() % cell2GateOutputWeight;
 
   if (this->HasPreviousStep())
   {
-    cellError += inputCellError;
+    cellError.head_cols(laterBatchSize) += inputCellError;
   }
 
+  // The sequences without a later step get no forget gate error.
+  forgetGateError.zeros(outSize, batchSize);
   if (this->HasPreviousStep())
   {
-    forgetGateError = cell.slice(this->PreviousStep()) % cellError %
-        (forgetGateActivation.slice(this->CurrentStep()) %
-        (1.0 - forgetGateActivation.slice(this->CurrentStep())));
-  }
-  else
-  {
-    forgetGateError.zeros(forgetGateActivation.n_rows,
-        forgetGateActivation.n_cols);
+    forgetGateError.head_cols(laterBatchSize) =
+        cell.slice(this->PreviousStep()).head_cols(laterBatchSize) %
+        cellError.head_cols(laterBatchSize) %
+        (forgetGate.head_cols(laterBatchSize) %
+        (1.0 - forgetGate.head_cols(laterBatchSize)));
   }
 
-  inputGateError = hiddenLayerActivation.slice(this->CurrentStep()) %
-      cellError % (inputGateActivation.slice(this->CurrentStep()) %
-      (1.0 - inputGateActivation.slice(this->CurrentStep())));
+  inputGateError = hidden % cellError % (inputGate % (1.0 - inputGate));
 
-  hiddenError = inputGateActivation.slice(this->CurrentStep()) % cellError %
-      (1 - pow(hiddenLayerActivation.slice(this->CurrentStep()), 2));
+  hiddenError = inputGate % cellError % (1 - pow(hidden, 2));
 
-  inputCellError = forgetGateActivation.slice(this->CurrentStep()) % cellError +
+  inputCellError = forgetGate % cellError +
       forgetGateError.each_col() % cell2GateForgetWeight +
       inputGateError.each_col() % cell2GateInputWeight;
 
@@ -307,7 +309,13 @@ void LSTMType<MatType>::Gradient(
     MatType& gradient)
 {
   // This implementation depends on Gradient() being called just after
-  // Backward(), which is something we can safely assume.
+  // Backward(), which is something we can safely assume.  As in Backward(),
+  // only the first `input.n_cols` columns of the states belong to this step.
+  MatType currentOutput, currentCell;
+  MakeAlias(currentOutput, outParameter.slice(this->CurrentStep()), outSize,
+      input.n_cols);
+  MakeAlias(currentCell, cell.slice(this->CurrentStep()), outSize,
+      input.n_cols);
 
   // Input2GateOutputWeight and input2GateOutputBias gradients.
   gradient.submat(0, 0, input2GateOutputWeight.n_elem - 1, 0) =
@@ -343,37 +351,40 @@ void LSTMType<MatType>::Gradient(
 
   // output2GateOutputWeight gradients.
   gradient.submat(offset, 0, offset + output2GateOutputWeight.n_elem - 1, 0) =
-      vectorise(outputGateError * outParameter.slice(this->CurrentStep()).t());
+      vectorise(outputGateError * currentOutput.t());
   offset += output2GateOutputWeight.n_elem;
 
   // output2GateForgetWeight gradients.
   gradient.submat(offset, 0, offset + output2GateForgetWeight.n_elem - 1, 0) =
-      vectorise(forgetGateError * outParameter.slice(this->CurrentStep()).t());
+      vectorise(forgetGateError * currentOutput.t());
   offset += output2GateForgetWeight.n_elem;
 
   // output2GateInputWeight gradients.
   gradient.submat(offset, 0, offset + output2GateInputWeight.n_elem - 1, 0) =
-      vectorise(inputGateError * outParameter.slice(this->CurrentStep()).t());
+      vectorise(inputGateError * currentOutput.t());
   offset += output2GateInputWeight.n_elem;
 
   // output2HiddenWeight gradients.
   gradient.submat(offset, 0, offset + output2HiddenWeight.n_elem - 1, 0) =
-      vectorise(hiddenError * outParameter.slice(this->CurrentStep()).t());
+      vectorise(hiddenError * currentOutput.t());
   offset += output2HiddenWeight.n_elem;
 
   // cell2GateOutputWeight gradients.
   gradient.submat(offset, 0, offset + cell2GateOutputWeight.n_elem - 1, 0) =
-      sum(outputGateError % cell.slice(this->CurrentStep()), 1);
+      sum(outputGateError % currentCell, 1);
   offset += cell2GateOutputWeight.n_elem;
 
   // cell2GateForgetWeight and cell2GateInputWeight gradients.
   if (this->HasPreviousStep())
   {
+    // Only the sequences that go on to the later step contribute.
+    const MatType laterCell =
+        cell.slice(this->PreviousStep()).head_cols(laterBatchSize);
     gradient.submat(offset, 0, offset + cell2GateForgetWeight.n_elem - 1, 0) =
-        sum(forgetGateError % cell.slice(this->PreviousStep()), 1);
+        sum(forgetGateError.head_cols(laterBatchSize) % laterCell, 1);
     gradient.submat(offset + cell2GateForgetWeight.n_elem, 0, offset +
         cell2GateForgetWeight.n_elem + cell2GateInputWeight.n_elem - 1, 0) =
-        sum(inputGateError % cell.slice(this->PreviousStep()), 1);
+        sum(inputGateError.head_cols(laterBatchSize) % laterCell, 1);
   }
   else
   {
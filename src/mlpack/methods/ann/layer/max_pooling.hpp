@@ -52,6 +52,12 @@ class MaxPoolingRule
 /**
  * Implementation of the MaxPooling layer.
  *
+ * Each slice (one channel of one point) is pooled independently, in parallel.
+ * For the backward pass, the position of the maximum of each window is stored
+ * as its offset inside the window, using one byte per output element when the
+ * window has at most 256 elements, and two bytes otherwise (so the window can
+ * have at most 65536 elements).
+ *
  * @tparam MatType Matrix representation to accept as input and use for
  *    computation.
  */
@@ -152,135 +158,36 @@ class MaxPoolingType : public Layer<MatType>
   void serialize(Archive& ar, const uint32_t /* version */);
 
  private:
-  /**
-   * Apply pooling to the input and store the results.
-   *
-   * @param input The input to be apply the pooling rule.
-   * @param output The pooled result.
-   * @param poolingIndices The pooled indices.
-   */
-  void PoolingOperation(
-      const arma::Cube<typename MatType::elem_type>& input,
-      arma::Cube<typename MatType::elem_type>& output,
-      arma::Cube<size_t>& poolingIndices)
-  {
-    // Iterate over all slices individually.
-    #pragma omp parallel for
-    for (size_t s = 0; s < (size_t) input.n_slices; ++s)
-    {
-      for (size_t j = 0, colidx = 0; j < output.n_cols;
-          ++j, colidx += strideHeight)
-      {
-        size_t colEnd = colidx + kernelHeight - 1;
-        // Check if the kernel along column is out of bounds.
-        if (colEnd > input.n_cols - 1)
-        {
-          // If so, we need to reduce the kernel height or terminate.
-          if (floor)
-            continue;
-          colEnd = input.n_cols - 1;
-        }
-        for (size_t i = 0, rowidx = 0; i < output.n_rows;
-            ++i, rowidx += strideWidth)
-        {
-          size_t rowEnd = rowidx + kernelWidth - 1;
-          // Check if the kernel along row is out of bounds.
-          if (rowEnd > input.n_rows - 1)
-          {
-            // If so, we need to reduce the kernel width or terminate.
-            if (floor)
-              continue;
-            rowEnd = input.n_rows - 1;
-          }
-          const std::tuple<size_t, typename MatType::elem_type> poolResult =
-              pooling.PoolingWithIndex(input.slice(s).submat(
-                  rowidx,
-                  colidx,
-                  rowEnd,
-                  colEnd));
-
-          // Now map the returned pooling index, which corresponds to the
-          // submatrix we gave, back to its position in the (linearized) input.
-          const size_t poolIndex = std::get<0>(poolResult);
-          const size_t poolingCol = poolIndex / (kernelWidth);
-          const size_t poolingRow = poolIndex % (kernelWidth);
-          const size_t unmappedPoolingIndex = (rowidx + poolingRow) +
-              input.n_rows * (colidx + poolingCol);
-
-          poolingIndices(i, j, s) = unmappedPoolingIndex;
-          output(i, j, s) = std::get<1>(poolResult);
-        }
-      }
-    }
-  }
+  //! The type used to store the cube of the elements of the input.
+  typedef arma::Cube<typename MatType::elem_type> CubeType;
 
   /**
-   * Apply pooling to all slices of the input and store the results, but not the
-   * indices used.
+   * Apply max pooling to each slice of the input, in parallel, and store the
+   * results.  If `offsets` is given, the position of the maximum of each
+   * window is stored in it, as the offset `row + kernelWidth * col` inside
+   * the window; `offsets` must have the same size as `output`.
    *
    * @param input The input to apply the pooling rule to.
    * @param output The pooled result.
+   * @param offsets The offsets of the maxima inside their windows, or NULL.
    */
-  void PoolingOperation(
-      const arma::Cube<typename MatType::elem_type>& input,
-      arma::Cube<typename MatType::elem_type>& output)
-  {
-    // Iterate over all slices individually.
-    #pragma omp parallel for
-    for (size_t s = 0; s < (size_t) input.n_slices; ++s)
-    {
-      for (size_t j = 0, colidx = 0; j < output.n_cols;
-          ++j, colidx += strideHeight)
-      {
-        size_t colEnd = colidx + kernelHeight - 1;
-        // Check if the kernel along column is out of bounds.
-        if (colEnd > input.n_cols - 1)
-        {
-          // If so, we need to reduce the kernel height or terminate.
-          if (floor)
-            continue;
-          colEnd = input.n_cols - 1;
-        }
-        for (size_t i = 0, rowidx = 0; i < output.n_rows;
-            ++i, rowidx += strideWidth)
-        {
-          size_t rowEnd = rowidx + kernelWidth - 1;
-          // Check if the kernel along row is out of bounds.
-          if (rowEnd > input.n_rows - 1)
-          {
-            // If so, we need to reduce the kernel width or terminate.
-            if (floor)
-              continue;
-            rowEnd = input.n_rows - 1;
-          }
-
-          output(i, j, s) = pooling.Pooling(input.slice(s).submat(
-              rowidx,
-              colidx,
-              rowEnd,
-              colEnd));
-        }
-      }
-    }
-  }
+  template<typename OffsetType>
+  void PoolingOperation(const CubeType& input,
+                        CubeType& output,
+                        arma::Cube<OffsetType>* offsets);
 
   /**
-   * Apply unpooling to all slices of the input and store the results.
+   * Apply unpooling to each slice of the error, in parallel: the error of each
+   * window is added to the position of its maximum in `g`.
    *
    * @param error The backward error.
-   * @param output The pooled result.
-   * @param poolingIndices The pooled indices (from `PoolingOperation()`).
+   * @param g The unpooled error; this must be filled with zeros.
+   * @param offsets The offsets of the maxima (from `PoolingOperation()`).
    */
-  void UnpoolingOperation(
-      const MatType& error,
-      MatType& output,
-      const arma::Mat<size_t>& poolingIndices)
-  {
-    for (size_t i = 0; i < poolingIndices.n_elem; ++i)
-    {
-      output(poolingIndices(i)) += error(i);
-    }
-  }
+  template<typename OffsetType>
+  void UnpoolingOperation(const CubeType& error,
+                          CubeType& g,
+                          const arma::Cube<OffsetType>& offsets);
 
   //! Locally-stored width of the pooling window.
   size_t kernelWidth;
@@ -300,11 +207,13 @@ class MaxPoolingType : public Layer<MatType>
   //! Locally-stored number of channels.
   size_t channels;
 
-  //! Locally-stored pooling strategy.
-  MaxPoolingRule pooling;
+  //! Locally-stored offsets of the maxima inside their windows, when the
+  //! window has at most 256 elements.
+  arma::Cube<uint8_t> smallOffsets;
 
-  //! Locally-stored pooling indices.
-  arma::Cube<size_t> poolingIndices;
+  //! Locally-stored offsets of the maxima inside their windows, for larger
+  //! windows.
+  arma::Cube<uint16_t> largeOffsets;
 }; // class MaxPoolingType
 
 // Standard MaxPooling layer.
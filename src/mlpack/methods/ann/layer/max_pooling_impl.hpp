@@ -52,8 +52,7 @@ MaxPoolingType<MatType>::MaxPoolingType(
     strideWidth(other.strideWidth),
     strideHeight(other.strideHeight),
     floor(other.floor),
-    channels(other.channels),
-    pooling(other.pooling)
+    channels(other.channels)
 {
   // Nothing to do here.
 }
@@ -67,8 +66,7 @@ MaxPoolingType<MatType>::MaxPoolingType(
     strideWidth(std::move(other.strideWidth)),
     strideHeight(std::move(other.strideHeight)),
     floor(std::move(other.floor)),
-    channels(std::move(other.channels)),
-    pooling(std::move(other.pooling))
+    channels(std::move(other.channels))
 {
   // Nothing to do here.
 }
@@ -86,7 +84,6 @@ MaxPoolingType<MatType>::operator=(const MaxPoolingType& other)
     strideHeight = other.strideHeight;
     floor = other.floor;
     channels = other.channels;
-    pooling = other.pooling;
   }
 
   return *this;
@@ -105,7 +102,6 @@ MaxPoolingType<MatType>::operator=(MaxPoolingType&& other)
     strideHeight = std::move(other.strideHeight);
     floor = std::move(other.floor);
     channels = std::move(other.channels);
-    pooling = std::move(other.pooling);
   }
 
   return *this;
@@ -114,26 +110,30 @@ MaxPoolingType<MatType>::operator=(MaxPoolingType&& other)
 template<typename MatType>
 void MaxPoolingType<MatType>::Forward(const MatType& input, MatType& output)
 {
-  arma::Cube<typename MatType::elem_type> inputTemp(
-      const_cast<MatType&>(input).memptr(), this->inputDimensions[0],
-      this->inputDimensions[1], input.n_cols * channels, false, false);
+  CubeType inputTemp(const_cast<MatType&>(input).memptr(),
+      this->inputDimensions[0], this->inputDimensions[1],
+      input.n_cols * channels, false, false);
 
-  arma::Cube<typename MatType::elem_type> outputTemp(output.memptr(),
-      this->outputDimensions[0], this->outputDimensions[1],
-      input.n_cols * channels, false, true);
+  CubeType outputTemp(output.memptr(), this->outputDimensions[0],
+      this->outputDimensions[1], input.n_cols * channels, false, true);
 
-  if (this->training)
+  if (!this->training)
+  {
+    PoolingOperation<uint8_t>(inputTemp, outputTemp, NULL);
+  }
+  else if (kernelWidth * kernelHeight <= 256)
   {
     // If we are training, we'll do a backwards pass, so we need to ensure that
-    // we know what indices we used.
-    poolingIndices.set_size(this->outputDimensions[0],
-        this->outputDimensions[1], input.n_cols * channels);
-
-    PoolingOperation(inputTemp, outputTemp, poolingIndices);
+    // we know where the maxima were.
+    smallOffsets.set_size(arma::size(outputTemp));
+    largeOffsets.clear();
+    PoolingOperation(inputTemp, outputTemp, &smallOffsets);
   }
   else
   {
-    PoolingOperation(inputTemp, outputTemp);
+    largeOffsets.set_size(arma::size(outputTemp));
+    smallOffsets.clear();
+    PoolingOperation(inputTemp, outputTemp, &largeOffsets);
   }
 }
 
@@ -144,25 +144,21 @@ void MaxPoolingType<MatType>::Backward(
     const MatType& gy,
     MatType& g)
 {
-  arma::Cube<typename MatType::elem_type> mappedError =
-      arma::Cube<typename MatType::elem_type>(((MatType&) gy).memptr(),
+  const CubeType mappedError(const_cast<MatType&>(gy).memptr(),
       this->outputDimensions[0], this->outputDimensions[1],
       channels * input.n_cols, false, false);
 
-  arma::Cube<typename MatType::elem_type> gTemp(g.memptr(),
-      this->inputDimensions[0], this->inputDimensions[1],
-      channels * input.n_cols, false, true);
+  CubeType gTemp(g.memptr(), this->inputDimensions[0],
+      this->inputDimensions[1], channels * input.n_cols, false, true);
 
   gTemp.zeros();
 
-  // There's no version of UnpoolingOperation without pooling indices, because
-  // if we call `Backward()`, we know for sure we are training.
-  #pragma omp parallel for
-  for (size_t s = 0; s < (size_t) mappedError.n_slices; s++)
-  {
-    UnpoolingOperation(mappedError.slice(s), gTemp.slice(s),
-        poolingIndices.slice(s));
-  }
+  // There's no version of UnpoolingOperation without offsets, because if we
+  // call `Backward()`, we know for sure we are training.
+  if (kernelWidth * kernelHeight <= 256)
+    UnpoolingOperation(mappedError, gTemp, smallOffsets);
+  else
+    UnpoolingOperation(mappedError, gTemp, largeOffsets);
 }
 
 template<typename MatType>
@@ -186,6 +182,16 @@ void MaxPoolingType<MatType>::ComputeOutputDimensions()
         (double) kernelHeight) / (double) strideHeight + 1);
   }
 
+  // The offsets of the maxima are stored with at most two bytes.
+  if (kernelWidth * kernelHeight > 65536)
+  {
+    std::ostringstream oss;
+    oss << "MaxPooling::ComputeOutputDimensions(): the pooling window ("
+        << kernelWidth << " x " << kernelHeight << ") must have at most 65536 "
+        << "elements!";
+    throw std::invalid_argument(oss.str());
+  }
+
   // Higher dimensions are not modified.
 
   // Cache input size and output size.
@@ -212,8 +218,95 @@ void MaxPoolingType<MatType>::serialize(
 
   if (Archive::is_loading::value)
   {
-    // Clear any memory used by `poolingIndices`.
-    poolingIndices.clear();
+    // Clear any memory used by the offsets of the maxima.
+    smallOffsets.clear();
+    largeOffsets.clear();
+  }
+}
+
+template<typename MatType>
+template<typename OffsetType>
+void MaxPoolingType<MatType>::PoolingOperation(
+    const CubeType& input,
+    CubeType& output,
+    arma::Cube<OffsetType>* offsets)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  // Iterate over all slices individually.
+  #pragma omp parallel for
+  for (size_t s = 0; s < (size_t) input.n_slices; ++s)
+  {
+    for (size_t j = 0, colidx = 0; j < output.n_cols;
+        ++j, colidx += strideHeight)
+    {
+      size_t colEnd = colidx + kernelHeight - 1;
+      // Check if the kernel along column is out of bounds.
+      if (colEnd > input.n_cols - 1)
+      {
+        // If so, we need to reduce the kernel height or terminate.
+        if (floor)
+          continue;
+        colEnd = input.n_cols - 1;
+      }
+
+      for (size_t i = 0, rowidx = 0; i < output.n_rows;
+          ++i, rowidx += strideWidth)
+      {
+        size_t rowEnd = rowidx + kernelWidth - 1;
+        // Check if the kernel along row is out of bounds.
+        if (rowEnd > input.n_rows - 1)
+        {
+          // If so, we need to reduce the kernel width or terminate.
+          if (floor)
+            continue;
+          rowEnd = input.n_rows - 1;
+        }
+
+        // Find the first maximum of the window, in column-major order.
+        ElemType maxVal = input(rowidx, colidx, s);
+        size_t maxOffset = 0;
+        for (size_t c = colidx; c <= colEnd; ++c)
+        {
+          const ElemType* column = input.slice_colptr(s, c);
+          for (size_t r = rowidx; r <= rowEnd; ++r)
+          {
+            if (column[r] > maxVal)
+            {
+              maxVal = column[r];
+              maxOffset = (r - rowidx) + kernelWidth * (c - colidx);
+            }
+          }
+        }
+
+        output(i, j, s) = maxVal;
+        if (offsets)
+          (*offsets)(i, j, s) = (OffsetType) maxOffset;
+      }
+    }
+  }
+}
+
+template<typename MatType>
+template<typename OffsetType>
+void MaxPoolingType<MatType>::UnpoolingOperation(
+    const CubeType& error,
+    CubeType& g,
+    const arma::Cube<OffsetType>& offsets)
+{
+  // Windows can overlap, so each slice is handled by one thread.
+  #pragma omp parallel for
+  for (size_t s = 0; s < (size_t) error.n_slices; ++s)
+  {
+    for (size_t j = 0; j < offsets.n_cols; ++j)
+    {
+      for (size_t i = 0; i < offsets.n_rows; ++i)
+      {
+        const size_t offset = offsets(i, j, s);
+        g(i * strideWidth + offset % kernelWidth,
+            j * strideHeight + offset / kernelWidth, s) += error(i, j, s);
+      }
+    }
   }
 }
 
@@ -12,6 +12,8 @@
 #ifndef MLPACK_METHODS_ANN_LAYER_MULTI_LAYER_HPP
 #define MLPACK_METHODS_ANN_LAYER_MULTI_LAYER_HPP
 
+#include <mlpack/methods/ann/layer_profiler.hpp>
+
 #include "layer.hpp"
 
 namespace mlpack {
@@ -83,6 +85,22 @@ class MultiLayer : public Layer<MatType>
                const size_t start,
                const size_t end);
 
+  /**
+   * Perform a forward pass for inference only.  This computes the same output
+   * as `Forward()`, but the outputs of the intermediate layers are not kept for
+   * a backward pass: since each intermediate output is only needed by the next
+   * layer, the layers alternate between two buffers of the size of the largest
+   * intermediate output; element-wise layers (see `Layer::ElementWise()`) are
+   * computed in place, in the buffer of the previous layer.  The memory held
+   * for the forward and backward passes of training is released, so
+   * `Backward()` and `Gradient()` must not be called until `Forward()` has
+   * been called again.
+   *
+   * @param input Input data to pass through the MultiLayer.
+   * @param output Matrix to store output in.
+   */
+  void ForwardInference(const MatType& input, MatType& output);
+
   /**
    * Perform a backward pass with the given data.  `gy` is expected to be the
    * propagated error from the subsequent layer (or output), `input` is expected
@@ -185,6 +203,21 @@ class MultiLayer : public Layer<MatType>
     layerGradients.push_back(MatType());
   }
 
+  /**
+   * Remove a module from the model and free it.  `ComputeOutputDimensions()`
+   * must be called before the model is used again.
+   *
+   * @param index Index of the layer to remove.
+   */
+  void Remove(const size_t index)
+  {
+    delete network[index];
+    network.erase(network.begin() + index);
+    layerOutputs.pop_back();
+    layerDeltas.pop_back();
+    layerGradients.pop_back();
+  }
+
   //! Get the network (series of layers) held by this MultiLayer.
   const std::vector<Layer<MatType>*>& Network() const
   {
@@ -194,6 +227,13 @@ class MultiLayer : public Layer<MatType>
   //! careful!
   std::vector<Layer<MatType>*>& Network() { return network; }
 
+  //! Get the profiler that times each held layer (nullptr if profiling is
+  //! disabled).
+  LayerProfiler* Profiler() const { return profiler; }
+  //! Modify the profiler that times each held layer; set it to nullptr to
+  //! disable profiling.  See LayerProfiler for more information.
+  LayerProfiler*& Profiler() { return profiler; }
+
   //! Serialize the MultiLayer.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -225,6 +265,25 @@ class MultiLayer : public Layer<MatType>
    */
   void InitializeGradientPassMemory(MatType& gradient);
 
+  //! Call `Forward()` on the held layer with the given index, timing it with
+  //! the profiler if there is one.
+  void LayerForward(const size_t i, const MatType& input, MatType& output);
+
+  //! Call `Backward()` on the held layer with the given index, timing it with
+  //! the profiler if there is one.
+  void LayerBackward(const size_t i,
+                     const MatType& input,
+                     const MatType& output,
+                     const MatType& gy,
+                     MatType& g);
+
+  //! Call `Gradient()` on the held layer with the given index, timing it with
+  //! the profiler if there is one.
+  void LayerGradient(const size_t i,
+                     const MatType& input,
+                     const MatType& error,
+                     MatType& gradient);
+
   //! The internally-held network.
   std::vector<Layer<MatType>*> network;
 
@@ -247,10 +306,18 @@ class MultiLayer : public Layer<MatType>
   //! These are aliases of `layerDeltaMatrix` for each layer.
   std::vector<MatType> layerDeltas;
 
+  //! This matrix holds the two buffers that the layers alternately output into
+  //! when ForwardInference() is called.
+  MatType inferenceMatrix;
+
   //! Gradient aliases for each layer.  Note that this is *only* valid in the
   //! context of `Gradient()`!  We have it as a class member to avoid
   //! reallocating the `MatType`s each call to `Gradient()`.
   std::vector<MatType> layerGradients;
+
+  //! The profiler that times each held layer; copies of the MultiLayer are not
+  //! profiled.
+  LayerProfiler* profiler;
 };
 
 } // namespace mlpack
@@ -22,7 +22,8 @@ MultiLayer<MatType>::MultiLayer() :
     Layer<MatType>(),
     inSize(0),
     totalInputSize(0),
-    totalOutputSize(0)
+    totalOutputSize(0),
+    profiler(nullptr)
 {
   // Nothing to do.
 }
@@ -34,7 +35,8 @@ MultiLayer<MatType>::MultiLayer(const MultiLayer& other) :
     totalInputSize(other.totalInputSize),
     totalOutputSize(other.totalOutputSize),
     layerOutputMatrix(other.layerOutputMatrix),
-    layerDeltaMatrix(other.layerDeltaMatrix)
+    layerDeltaMatrix(other.layerDeltaMatrix),
+    profiler(nullptr)
 {
   // Copy each layer.
   for (size_t i = 0; i < other.network.size(); ++i)
@@ -57,7 +59,8 @@ MultiLayer<MatType>::MultiLayer(MultiLayer&& other) :
     totalInputSize(std::move(other.totalInputSize)),
     totalOutputSize(std::move(other.totalOutputSize)),
     layerOutputMatrix(std::move(other.layerOutputMatrix)),
-    layerDeltaMatrix(std::move(other.layerDeltaMatrix))
+    layerDeltaMatrix(std::move(other.layerDeltaMatrix)),
+    profiler(other.profiler)
 {
   // Ensure that the aliases for layers during passes have the right size.
   layerOutputs.resize(network.size(), MatType());
@@ -70,6 +73,7 @@ MultiLayer<MatType>::MultiLayer(MultiLayer&& other) :
   other.layerOutputs.clear();
   other.layerDeltas.clear();
   other.layerGradients.clear();
+  other.profiler = nullptr;
 }
 
 template<typename MatType>
@@ -119,6 +123,8 @@ MultiLayer<MatType>& MultiLayer<MatType>::operator=(MultiLayer&& other)
     totalOutputSize = std::move(other.totalOutputSize);
 
     network = std::move(other.network);
+    profiler = other.profiler;
+    other.profiler = nullptr;
 
     layerOutputs.resize(network.size(), MatType());
     layerDeltas.resize(network.size(), MatType());
@@ -157,14 +163,14 @@ void MultiLayer<MatType>::Forward(
     // Initialize memory for the forward pass (if needed).
     InitializeForwardPassMemory(input.n_cols);
 
-    network[start]->Forward(input, layerOutputs[start]);
+    LayerForward(start, input, layerOutputs[start]);
     for (size_t i = start + 1; i < end; ++i)
-      network[i]->Forward(layerOutputs[i - 1], layerOutputs[i]);
-    network[end]->Forward(layerOutputs[end - 1], output);
+      LayerForward(i, layerOutputs[i - 1], layerOutputs[i]);
+    LayerForward(end, layerOutputs[end - 1], output);
   }
   else if ((end - start) == 0 && network.size() > 0)
   {
-    network[start]->Forward(input, output);
+    LayerForward(start, input, output);
   }
   else
   {
@@ -173,6 +179,66 @@ void MultiLayer<MatType>::Forward(
   }
 }
 
+template<typename MatType>
+void MultiLayer<MatType>::ForwardInference(
+    const MatType& input, MatType& output)
+{
+  // Make sure training/testing mode is set right in each layer.
+  for (size_t i = 0; i < network.size(); ++i)
+    network[i]->Training() = this->training;
+
+  if (network.size() <= 1)
+  {
+    Forward(input, output);
+    return;
+  }
+
+  // The outputs kept for the backward pass are not needed.
+  layerOutputMatrix.clear();
+  layerDeltaMatrix.clear();
+  layerOutputs.clear();
+  layerDeltas.clear();
+  layerOutputs.resize(network.size(), MatType());
+  layerDeltas.resize(network.size(), MatType());
+
+  // Only the output of the previous layer is alive when a layer is computed,
+  // so two buffers are enough.  As in InitializeForwardPassMemory(), we avoid
+  // resizing the memory down unless we only need 10% or less of it.
+  const size_t batchSize = input.n_cols;
+  size_t maxOutputSize = 0;
+  for (size_t i = 0; i < network.size() - 1; ++i)
+    maxOutputSize = std::max(maxOutputSize, network[i]->OutputSize());
+
+  const size_t bufferSize = maxOutputSize * batchSize;
+  if (2 * bufferSize > inferenceMatrix.n_elem ||
+      2 * bufferSize < std::floor(0.1 * inferenceMatrix.n_elem))
+  {
+    inferenceMatrix = MatType(1, 2 * bufferSize);
+  }
+
+  MatType buffers[2];
+  size_t current = 0;
+  MakeAlias(buffers[0], inferenceMatrix, network[0]->OutputSize(), batchSize);
+  LayerForward(0, input, buffers[0]);
+  for (size_t i = 1; i < network.size() - 1; ++i)
+  {
+    // Element-wise layers (like activations) are applied in place, directly
+    // on the output of the previous layer.
+    if (network[i]->ElementWise())
+    {
+      LayerForward(i, buffers[current], buffers[current]);
+      continue;
+    }
+
+    const size_t next = 1 - current;
+    MakeAlias(buffers[next], inferenceMatrix, network[i]->OutputSize(),
+        batchSize, next * bufferSize);
+    LayerForward(i, buffers[current], buffers[next]);
+    current = next;
+  }
+  LayerForward(network.size() - 1, buffers[current], output);
+}
+
 template<typename MatType>
 void MultiLayer<MatType>::Backward(
     const MatType& input,
@@ -185,16 +251,16 @@ void MultiLayer<MatType>::Backward(
     // Initialize memory for the backward pass (if needed).
     InitializeBackwardPassMemory(input.n_cols);
 
-    network.back()->Backward(layerOutputs[network.size() - 2], output, gy,
-        layerDeltas.back());
+    LayerBackward(network.size() - 1, layerOutputs[network.size() - 2],
+        output, gy, layerDeltas.back());
     for (size_t i = network.size() - 2; i > 0; --i)
-      network[i]->Backward(layerOutputs[i - 1], layerOutputs[i],
+      LayerBackward(i, layerOutputs[i - 1], layerOutputs[i],
           layerDeltas[i + 1], layerDeltas[i]);
-    network[0]->Backward(input, layerOutputs[0], layerDeltas[1], g);
+    LayerBackward(0, input, layerOutputs[0], layerDeltas[1], g);
   }
   else if (network.size() == 1)
   {
-    network[0]->Backward(input, output, gy, g);
+    LayerBackward(0, input, output, gy, g);
   }
   else
   {
@@ -215,18 +281,18 @@ void MultiLayer<MatType>::Gradient(
     // Initialize memory for the gradient pass (if needed).
     InitializeGradientPassMemory(gradient);
 
-    network.front()->Gradient(input, layerDeltas[1], layerGradients.front());
+    LayerGradient(0, input, layerDeltas[1], layerGradients.front());
     for (size_t i = 1; i < network.size() - 1; ++i)
     {
-      network[i]->Gradient(layerOutputs[i - 1], layerDeltas[i + 1],
+      LayerGradient(i, layerOutputs[i - 1], layerDeltas[i + 1],
           layerGradients[i]);
     }
-    network.back()->Gradient(layerOutputs[network.size() - 2], error,
+    LayerGradient(network.size() - 1, layerOutputs[network.size() - 2], error,
         layerGradients.back());
   }
   else if (network.size() == 1)
   {
-    network[0]->Gradient(input, error, gradient);
+    LayerGradient(0, input, error, gradient);
   }
   else
   {
@@ -234,6 +300,58 @@ void MultiLayer<MatType>::Gradient(
   }
 }
 
+template<typename MatType>
+void MultiLayer<MatType>::LayerForward(
+    const size_t i, const MatType& input, MatType& output)
+{
+  if (profiler == nullptr)
+  {
+    network[i]->Forward(input, output);
+    return;
+  }
+
+  profiler->Start(i, LayerProfiler::FORWARD);
+  network[i]->Forward(input, output);
+  profiler->Stop(i, LayerProfiler::FORWARD, *network[i], output);
+}
+
+template<typename MatType>
+void MultiLayer<MatType>::LayerBackward(
+    const size_t i,
+    const MatType& input,
+    const MatType& output,
+    const MatType& gy,
+    MatType& g)
+{
+  if (profiler == nullptr)
+  {
+    network[i]->Backward(input, output, gy, g);
+    return;
+  }
+
+  profiler->Start(i, LayerProfiler::BACKWARD);
+  network[i]->Backward(input, output, gy, g);
+  profiler->Stop(i, LayerProfiler::BACKWARD, *network[i], g);
+}
+
+template<typename MatType>
+void MultiLayer<MatType>::LayerGradient(
+    const size_t i,
+    const MatType& input,
+    const MatType& error,
+    MatType& gradient)
+{
+  if (profiler == nullptr)
+  {
+    network[i]->Gradient(input, error, gradient);
+    return;
+  }
+
+  profiler->Start(i, LayerProfiler::GRADIENT);
+  network[i]->Gradient(input, error, gradient);
+  profiler->Stop(i, LayerProfiler::GRADIENT, *network[i], gradient);
+}
+
 template<typename MatType>
 void MultiLayer<MatType>::SetWeights(const MatType& weightsIn)
 {
@@ -190,6 +190,24 @@ class MultiheadAttentionType : public Layer<MatType>
   //! all come from the same input).
   bool& SelfAttention() { return selfAttention; }
 
+  /**
+   * Get the number of source positions in each block of the blocked attention
+   * computation.  If this is nonzero and smaller than the source sequence
+   * length, the attention weights are never stored as a whole: the scores of
+   * each block of `BlockSize()` keys (for all the target positions) are
+   * computed, normalized and multiplied with the values of the block, then
+   * discarded.  Only the log-normalizer of each key is kept, so that the
+   * backward pass can recompute the weights of each block.  This reduces the
+   * memory of the attention weights from tgtSeqLen * srcSeqLen to
+   * tgtSeqLen * BlockSize() per head and point, at the cost of computing the
+   * scores again in Backward() and Gradient().  The results are the same as
+   * without blocks.  The default is 0 (no blocks).
+   */
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of source positions in each block of the blocked
+  //! attention computation.
+  size_t& BlockSize() { return blockSize; }
+
   void ComputeOutputDimensions() override
   {
     if (this->inputDimensions.size() < 2)
@@ -267,6 +285,35 @@ class MultiheadAttentionType : public Layer<MatType>
   //! Element Type of the output.
   typedef typename MatType::elem_type ElemType;
 
+  //! Return whether the attention is computed in blocks of keys.
+  bool Blocked() const { return blockSize > 0 && blockSize < srcSeqLen; }
+
+  /**
+   * Compute the attention output `attnOut` block by block from the projected
+   * query, key and value, keeping only the log-normalizer of each key.
+   */
+  void BlockedForward();
+
+  /**
+   * Compute the masked scores of all the target positions for the keys
+   * `begin` to `end` of the given slice (head and point) of the projections.
+   */
+  void ScoreBlock(const size_t slice,
+                  const size_t begin,
+                  const size_t end,
+                  arma::Mat<ElemType>& block) const;
+
+  /**
+   * Compute the errors of the projected query, key and value (before the
+   * scaling of the query) from the error of the attention output `gy`, of
+   * shape (tgtSeqLen, headDim, numHeads * batchSize), by recomputing the
+   * attention weights block by block.
+   */
+  void BlockedBackward(const arma::Cube<ElemType>& gy,
+                       arma::Cube<ElemType>& dQuery,
+                       arma::Cube<ElemType>& dKey,
+                       arma::Cube<ElemType>& dValue) const;
+
   //! Target sequence length.
   size_t tgtSeqLen;
 
@@ -293,6 +340,9 @@ class MultiheadAttentionType : public Layer<MatType>
   //! come from the same input).
   bool selfAttention;
 
+  //! Number of keys in each block of the blocked attention (0 for no blocks).
+  size_t blockSize;
+
   //! Locally-stored weight matrix associated with query.
   MatType queryWt;
 
@@ -335,6 +385,10 @@ class MultiheadAttentionType : public Layer<MatType>
   //! Locally-stored attention output weight to be fed to last linear layer.
   arma::Cube<ElemType> attnOut;
 
+  //! Locally-stored log-normalizer of the attention weights of each key, of
+  //! shape (srcSeqLen, numHeads * batchSize); only used for blocked attention.
+  arma::Mat<ElemType> logNormalizer;
+
   //! Softmax layer to represent the probabilities of next sequence.
   SoftmaxType<MatType> softmax;
 
@@ -29,7 +29,8 @@ MultiheadAttentionType() :
     embedDim(0),
     numHeads(0),
     headDim(0),
-    selfAttention(false)
+    selfAttention(false),
+    blockSize(0)
 {
   // Nothing to do here.
 }
@@ -48,7 +49,8 @@ MultiheadAttentionType(
     numHeads(numHeads),
     attnMask(attnmask),
     keyPaddingMask(keypaddingmask),
-    selfAttention(selfAttention)
+    selfAttention(selfAttention),
+    blockSize(0)
 {
 }
 
@@ -132,41 +134,49 @@ Forward(const MatType& input, MatType& output)
   kProj.reshape(srcSeqLen, headDim, numHeads * batchSize);
   vProj.reshape(srcSeqLen, headDim, numHeads * batchSize);
 
-  // Calculate the scores i.e. perform the matrix multiplication operation
-  // on qProj and kProj. Here score = qProj . kProj'
-  scores = MultiplyCube2Cube(qProj, kProj, false, true);
-
-  // Apply the attention mask if provided. The attention mask is used to black-
-  // out future sequences and generally used in Encoder-Decoder attention.
-  // The attention mask has elements -inf or 0.
-  // The shape of the attention mask : (tgtSeqLen, srcSeqLen).
-  if (!attnMask.is_empty())
+  if (Blocked())
   {
-    if (attnMask.n_rows != tgtSeqLen || attnMask.n_cols != srcSeqLen)
-      Log::Fatal << "The size of the 'attn_mask' is not correct.\n";
-    scores.each_slice() += attnMask;
+    BlockedForward();
   }
-
-  // Apply the key padding mask when provided. It blacks-out any particular
-  // word in the sequence.
-  // The key padding mask has elements -inf or 0
-  // The shape of keyPaddingMask : (1, srcSeqLen).
-  if (!keyPaddingMask.is_empty())
+  else
   {
-    if (keyPaddingMask.n_rows != 1 || keyPaddingMask.n_cols != srcSeqLen)
-        Log::Fatal << "The size of the 'keyPaddingMask' is not correct.\n";
-    scores.each_slice() += repmat(keyPaddingMask, tgtSeqLen, 1);
-  }
+    // Calculate the scores i.e. perform the matrix multiplication operation
+    // on qProj and kProj. Here score = qProj . kProj'
+    scores = MultiplyCube2Cube(qProj, kProj, false, true);
+
+    // Apply the attention mask if provided. The attention mask is used to
+    // black-out future sequences and generally used in Encoder-Decoder
+    // attention.
+    // The attention mask has elements -inf or 0.
+    // The shape of the attention mask : (tgtSeqLen, srcSeqLen).
+    if (!attnMask.is_empty())
+    {
+      if (attnMask.n_rows != tgtSeqLen || attnMask.n_cols != srcSeqLen)
+        Log::Fatal << "The size of the 'attn_mask' is not correct.\n";
+      scores.each_slice() += attnMask;
+    }
 
-  for (size_t i = 0; i < numHeads * batchSize; ++i)
-  {
-    softmax.Forward(scores.slice(i), scores.slice(i));
-  }
+    // Apply the key padding mask when provided. It blacks-out any particular
+    // word in the sequence.
+    // The key padding mask has elements -inf or 0
+    // The shape of keyPaddingMask : (1, srcSeqLen).
+    if (!keyPaddingMask.is_empty())
+    {
+      if (keyPaddingMask.n_rows != 1 || keyPaddingMask.n_cols != srcSeqLen)
+          Log::Fatal << "The size of the 'keyPaddingMask' is not correct.\n";
+      scores.each_slice() += repmat(keyPaddingMask, tgtSeqLen, 1);
+    }
+
+    for (size_t i = 0; i < numHeads * batchSize; ++i)
+    {
+      softmax.Forward(scores.slice(i), scores.slice(i));
+    }
 
-  // Calculate the attention output i.e. matrix multiplication of softmax
-  // output and vProj.
-  // The shape of attnOutput : (tgtSeqLen, headDim, numHeads * batchSize).
-  attnOut = MultiplyCube2Cube(scores, vProj, false, false);
+    // Calculate the attention output i.e. matrix multiplication of softmax
+    // output and vProj.
+    // The shape of attnOutput : (tgtSeqLen, headDim, numHeads * batchSize).
+    attnOut = MultiplyCube2Cube(scores, vProj, false, false);
+  }
 
   // Now we will concatenate output of all the heads i.e. we will reshape
   // attnOut to (tgtSeqLen, embedDim, batchSize).
@@ -180,6 +190,99 @@ Forward(const MatType& input, MatType& output)
   }
 }
 
+template <typename MatType, typename RegularizerType>
+void MultiheadAttentionType<MatType, RegularizerType>::BlockedForward()
+{
+  const size_t slices = qProj.n_slices;
+
+  if (!attnMask.is_empty() &&
+      (attnMask.n_rows != tgtSeqLen || attnMask.n_cols != srcSeqLen))
+    Log::Fatal << "The size of the 'attn_mask' is not correct.\n";
+  if (!keyPaddingMask.is_empty() &&
+      (keyPaddingMask.n_rows != 1 || keyPaddingMask.n_cols != srcSeqLen))
+    Log::Fatal << "The size of the 'keyPaddingMask' is not correct.\n";
+
+  // The softmax normalizes the scores of each key over all the target
+  // positions, so each block of keys (for all the target positions) can be
+  // normalized and multiplied with its values on its own.
+  scores.clear();
+  logNormalizer.set_size(srcSeqLen, slices);
+  attnOut.zeros(tgtSeqLen, headDim, slices);
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < slices; ++i)
+  {
+    arma::Mat<ElemType> block;
+    for (size_t begin = 0; begin < srcSeqLen; begin += blockSize)
+    {
+      const size_t end = std::min(srcSeqLen, begin + blockSize) - 1;
+      ScoreBlock(i, begin, end, block);
+
+      const arma::Row<ElemType> maxScores = max(block, 0);
+      block = exp(block.each_row() - maxScores);
+      const arma::Row<ElemType> sums = sum(block, 0);
+      block.each_row() /= sums;
+      logNormalizer.col(i).subvec(begin, end) =
+          trans(maxScores + log(sums));
+
+      attnOut.slice(i) += block * vProj.slice(i).rows(begin, end);
+    }
+  }
+}
+
+template <typename MatType, typename RegularizerType>
+void MultiheadAttentionType<MatType, RegularizerType>::ScoreBlock(
+    const size_t slice,
+    const size_t begin,
+    const size_t end,
+    arma::Mat<ElemType>& block) const
+{
+  block = qProj.slice(slice) * trans(kProj.slice(slice).rows(begin, end));
+
+  if (!attnMask.is_empty())
+    block += attnMask.cols(begin, end);
+
+  if (!keyPaddingMask.is_empty())
+    block.each_row() += keyPaddingMask.cols(begin, end);
+}
+
+template <typename MatType, typename RegularizerType>
+void MultiheadAttentionType<MatType, RegularizerType>::BlockedBackward(
+    const arma::Cube<ElemType>& gy,
+    arma::Cube<ElemType>& dQuery,
+    arma::Cube<ElemType>& dKey,
+    arma::Cube<ElemType>& dValue) const
+{
+  dQuery.zeros(tgtSeqLen, headDim, gy.n_slices);
+  dKey.set_size(srcSeqLen, headDim, gy.n_slices);
+  dValue.set_size(srcSeqLen, headDim, gy.n_slices);
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < gy.n_slices; ++i)
+  {
+    arma::Mat<ElemType> block, blockError;
+    for (size_t begin = 0; begin < srcSeqLen; begin += blockSize)
+    {
+      const size_t end = std::min(srcSeqLen, begin + blockSize) - 1;
+
+      // Recompute the attention weights of the block.
+      ScoreBlock(i, begin, end, block);
+      block = exp(block.each_row() -
+          trans(logNormalizer.col(i).subvec(begin, end)));
+
+      dValue.slice(i).rows(begin, end) = trans(block) * gy.slice(i);
+
+      // Backpropagate through the softmax of each key.
+      blockError = gy.slice(i) * trans(vProj.slice(i).rows(begin, end));
+      blockError = block % (blockError.each_row() -
+          sum(blockError % block, 0));
+
+      dKey.slice(i).rows(begin, end) = trans(blockError) * qProj.slice(i);
+      dQuery.slice(i) += blockError * kProj.slice(i).rows(begin, end);
+    }
+  }
+}
+
 template <typename MatType, typename RegularizerType>
 void MultiheadAttentionType<MatType, RegularizerType>::
 Backward(const MatType& /* input */,
@@ -219,7 +322,17 @@ Backward(const MatType& /* input */,
   // Shape of gyTemp : (tgtSeqLen, headDim, numHeads * batchSize).
   // Shape of scores : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
   // The shape of tmp : (srcSeqLen, headDim, numHeads * batchSize).
-  CubeType tmp = MultiplyCube2Cube(scores, gyTemp, true, false);
+  CubeType tmp, dQuery, dKey;
+  if (Blocked())
+  {
+    // The attention weights were not stored; recompute them block by block,
+    // and backpropagate through them at the same time.
+    BlockedBackward(gyTemp, dQuery, dKey, tmp);
+  }
+  else
+  {
+    tmp = MultiplyCube2Cube(scores, gyTemp, true, false);
+  }
 
   // Concatenate results of all the attention heads.
   tmp.reshape(srcSeqLen, embedDim, batchSize);
@@ -238,23 +351,31 @@ Backward(const MatType& /* input */,
     }
   }
 
-  // The shape of gyTemp : (tgtSeqLen, headDim, numHeads * batchSize).
-  // The shape of vProj : (srcSeqLen, headDim, numHeads * batchSize).
-  // So the new shape of gyTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-  gyTemp = MultiplyCube2Cube(gyTemp, vProj, false, true);
-
-  for (size_t i = 0; i < numHeads * batchSize; ++i)
+  if (Blocked())
   {
-    // We will perform backpropagation of softmax over each slice of gyTemp.
-    softmax.Backward({} /* unused */, scores.slice(i), gyTemp.slice(i),
-        gyTemp.slice(i));
+    tmp = std::move(dKey);
   }
+  else
+  {
+    // The shape of gyTemp : (tgtSeqLen, headDim, numHeads * batchSize).
+    // The shape of vProj : (srcSeqLen, headDim, numHeads * batchSize).
+    // So the new shape of gyTemp :
+    // (tgtSeqLen, srcSeqLen, numHeads * batchSize).
+    gyTemp = MultiplyCube2Cube(gyTemp, vProj, false, true);
 
-  // Obtain backpropagated error of key.
-  // The shape of qProj : (tgtSeqLen, headDim, numHeads * batchSize).
-  // The shape of gyTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-  // The new shape of tmp : (srcSeqLen, headDim, numHeads * batchSize).
-  tmp = MultiplyCube2Cube(gyTemp, qProj, true, false);
+    for (size_t i = 0; i < numHeads * batchSize; ++i)
+    {
+      // We will perform backpropagation of softmax over each slice of gyTemp.
+      softmax.Backward({} /* unused */, scores.slice(i), gyTemp.slice(i),
+          gyTemp.slice(i));
+    }
+
+    // Obtain backpropagated error of key.
+    // The shape of qProj : (tgtSeqLen, headDim, numHeads * batchSize).
+    // The shape of gyTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
+    // The new shape of tmp : (srcSeqLen, headDim, numHeads * batchSize).
+    tmp = MultiplyCube2Cube(gyTemp, qProj, true, false);
+  }
 
   // Concatenate results of all the attention heads.
   tmp.reshape(srcSeqLen, embedDim, batchSize);
@@ -279,7 +400,10 @@ Backward(const MatType& /* input */,
   // The shape of kProj : (srcSeqLen, headDim, numHeads * batchSize).
   // The shape of gyTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
   // The new shape of tmp : (tgtSeqLen, headDim, numHeads * batchSize).
-  tmp = MultiplyCube2Cube(gyTemp, kProj) / std::sqrt(headDim);
+  if (Blocked())
+    tmp = dQuery / std::sqrt(headDim);
+  else
+    tmp = MultiplyCube2Cube(gyTemp, kProj) / std::sqrt(headDim);
 
   // Concatenate results of all the attention heads.
   tmp.reshape(tgtSeqLen, embedDim, batchSize);
@@ -372,7 +496,11 @@ Gradient(const MatType& input,
   // Shape of gyTemp : (tgtSeqLen, headDim, numHeads * batchSize).
   // Shape of scores : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
   // The new shape of errorTemp : (srcSeqLen, headDim, numHeads * batchSize).
-  errorTemp = MultiplyCube2Cube(scores, gyTemp, true, false);
+  CubeType dQuery, dKey;
+  if (Blocked())
+    BlockedBackward(gyTemp, dQuery, dKey, errorTemp);
+  else
+    errorTemp = MultiplyCube2Cube(scores, gyTemp, true, false);
 
   // Now we will concatenate the propagated errors from all heads i.e. we
   // will reshape errorTemp to (srcSeqLen, embedDim, batchSize).
@@ -392,24 +520,32 @@ Gradient(const MatType& input,
   // batches of errorTemp.
   gradient.rows(2 * wtSize, 3 * wtSize - 1) = vectorise(sum(errorTemp, 2));
 
-  // Now, the shape of gyTemp : (tgtSeqLen, headDim, numHeads * batchSize).
-  // The shape of vProj : (srcSeqLen, headDim, numHeads * batchSize).
-  // The new shape of errorTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-  errorTemp = MultiplyCube2Cube(gyTemp, vProj, false, true);
-
-  for (size_t i = 0; i < numHeads * batchSize; ++i)
+  if (Blocked())
   {
-    // The shape of scores : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-    // The shape of errorTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-    // The new shape of errorTemp remain same.
-    softmax.Backward({} /* unused */, scores.slice(i), errorTemp.slice(i),
-        errorTemp.slice(i));
+    gyTemp = std::move(dKey);
   }
+  else
+  {
+    // Now, the shape of gyTemp : (tgtSeqLen, headDim, numHeads * batchSize).
+    // The shape of vProj : (srcSeqLen, headDim, numHeads * batchSize).
+    // The new shape of errorTemp :
+    // (tgtSeqLen, srcSeqLen, numHeads * batchSize).
+    errorTemp = MultiplyCube2Cube(gyTemp, vProj, false, true);
 
-  // The shape of qProj : (tgtSeqLen, headDim, numHeads * batchSize).
-  // The shape of errorTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-  // The shape of gyTemp : (srcSeqLen, headDim, numHeads * batchSize).
-  gyTemp = MultiplyCube2Cube(errorTemp, qProj, true, false);
+    for (size_t i = 0; i < numHeads * batchSize; ++i)
+    {
+      // The shape of scores : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
+      // The shape of errorTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
+      // The new shape of errorTemp remain same.
+      softmax.Backward({} /* unused */, scores.slice(i), errorTemp.slice(i),
+          errorTemp.slice(i));
+    }
+
+    // The shape of qProj : (tgtSeqLen, headDim, numHeads * batchSize).
+    // The shape of errorTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
+    // The shape of gyTemp : (srcSeqLen, headDim, numHeads * batchSize).
+    gyTemp = MultiplyCube2Cube(errorTemp, qProj, true, false);
+  }
 
   // We will now conctenate the propagated errors from all heads.
   // The new shape of gyTemp : (srcSeqLen, embedDim, batchSize).
@@ -432,7 +568,10 @@ Gradient(const MatType& input,
   // The shape of kProj : (srcSeqLen, headDim, numHeads * batchSize).
   // The shape of errorTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
   // The shape of gyTemp : (tgtSeqLen, headDim, numHeads * batchSize).
-  gyTemp = MultiplyCube2Cube(errorTemp, kProj, false, false);
+  if (Blocked())
+    gyTemp = std::move(dQuery);
+  else
+    gyTemp = MultiplyCube2Cube(errorTemp, kProj, false, false);
 
   // Now, we will concatenate propagated error of all heads.
   gyTemp.reshape(tgtSeqLen, embedDim, batchSize);
@@ -490,6 +629,7 @@ serialize(Archive& ar, const uint32_t /* version */)
     vProj.clear();
     scores.clear();
     attnOut.clear();
+    logNormalizer.clear();
   }
 }
 
@@ -97,7 +97,7 @@ void PReLUType<MatType>::Forward(
     const MatType& input, MatType& output)
 {
   output = input;
-  #pragma omp for
+  #pragma omp parallel for
   for (size_t i = 0; i < input.n_elem; ++i)
     output(i) *= (input(i) >= 0) ? 1 : alpha(0);
 }
@@ -111,7 +111,7 @@ void PReLUType<MatType>::Backward(
 {
   MatType derivative;
   derivative.set_size(arma::size(input));
-  #pragma omp for
+  #pragma omp parallel for
   for (size_t i = 0; i < input.n_elem; ++i)
     derivative(i) = (input(i) >= 0) ? 1 : alpha(0);
 
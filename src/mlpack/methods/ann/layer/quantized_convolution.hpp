@@ -0,0 +1,178 @@
+/**
+ * @file methods/ann/layer/quantized_convolution.hpp
+ *
+ * Definition of the QuantizedConvolution layer, an inference-only version of
+ * the Convolution layer with 8-bit integer filters and inputs.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/convolution_rules/im2col_convolution.hpp>
+#include <mlpack/methods/ann/quantization/quantize.hpp>
+
+#include "layer.hpp"
+
+namespace mlpack {
+
+/**
+ * The QuantizedConvolution layer computes the same output as the Convolution
+ * layer, but with the filters quantized to 8-bit integers with one scale for
+ * each output map, and the input quantized to 8-bit integers with one scale
+ * for the whole layer, chosen from the range of the inputs seen during
+ * calibration.  The patches of each input point are unfolded into columns
+ * (see Im2ColConvolution::Im2Col()) and quantized, then multiplied with the
+ * filters; the products are accumulated in 32-bit integers, then scaled back
+ * and added to the (floating-point) bias.
+ *
+ * This layer is meant for inference only: it has no trainable weights, and
+ * Backward() throws an exception.  It is usually created from a trained
+ * network with `FFN::Quantize()`.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class QuantizedConvolutionType : public Layer<MatType>
+{
+ public:
+  //! Create the QuantizedConvolution object.
+  QuantizedConvolutionType();
+
+  /**
+   * Create the QuantizedConvolution layer object from the filters of a
+   * Convolution layer.
+   *
+   * @param weight Filters (kernelWidth x kernelHeight x (maps * inMaps)),
+   *     ordered by output map, then by input map.
+   * @param bias Bias of each output map, or an empty matrix if there is no
+   *     bias.
+   * @param inMaps Number of input maps.
+   * @param strideWidth Stride of filter application in the x direction.
+   * @param strideHeight Stride of filter application in the y direction.
+   * @param padWLeft Left padding width of the input.
+   * @param padWRight Right padding width of the input.
+   * @param padHTop Top padding height of the input.
+   * @param padHBottom Bottom padding height of the input.
+   * @param inputRange Largest absolute value that the inputs are expected to
+   *     have; larger inputs are clamped.
+   */
+  template<typename CubeType>
+  QuantizedConvolutionType(const CubeType& weight,
+                           const MatType& bias,
+                           const size_t inMaps,
+                           const size_t strideWidth,
+                           const size_t strideHeight,
+                           const size_t padWLeft,
+                           const size_t padWRight,
+                           const size_t padHTop,
+                           const size_t padHBottom,
+                           const double inputRange);
+
+  virtual ~QuantizedConvolutionType() { }
+
+  //! Clone the QuantizedConvolution object. This handles polymorphism
+  //! correctly.
+  QuantizedConvolutionType* Clone() const
+  {
+    return new QuantizedConvolutionType(*this);
+  }
+
+  /**
+   * Ordinary feed forward pass of the layer.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * The layer cannot be trained, so this throws a std::logic_error.
+   */
+  void Backward(const MatType& /* input */,
+                const MatType& /* output */,
+                const MatType& /* gy */,
+                MatType& /* g */);
+
+  //! Get the number of output maps.
+  size_t Maps() const { return maps; }
+
+  //! Get the scale of the quantized filters of each output map.
+  MatType const& WeightScale() const { return weightScale; }
+  //! Get the scale of the quantized inputs.
+  double InputScale() const { return inputScale; }
+
+  //! Get the bias of the layer.
+  MatType const& Bias() const { return bias; }
+
+  //! Compute the output dimensions of the layer given `InputDimensions()`.
+  void ComputeOutputDimensions();
+
+  //! Serialize the layer.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored number of output maps.
+  size_t maps;
+
+  //! Locally-stored number of input maps.
+  size_t inMaps;
+
+  //! Locally-stored number of input points in the higher dimensions.
+  size_t higherInDimensions;
+
+  //! Locally-stored filter width.
+  size_t kernelWidth;
+
+  //! Locally-stored filter height.
+  size_t kernelHeight;
+
+  //! Locally-stored stride of the filter in x-direction.
+  size_t strideWidth;
+
+  //! Locally-stored stride of the filter in y-direction.
+  size_t strideHeight;
+
+  //! Locally-stored left padding width.
+  size_t padWLeft;
+
+  //! Locally-stored right padding width.
+  size_t padWRight;
+
+  //! Locally-stored top padding height.
+  size_t padHTop;
+
+  //! Locally-stored bottom padding height.
+  size_t padHBottom;
+
+  //! The quantized filters; the filters of each output map (for all the input
+  //! maps) are stored one after another.
+  std::vector<std::int8_t> weight;
+
+  //! The scale of the quantized filters of each output map.
+  MatType weightScale;
+
+  //! The bias of each output map (empty if there is no bias).
+  MatType bias;
+
+  //! The scale of the quantized inputs.
+  double inputScale;
+}; // class QuantizedConvolutionType
+
+// Convenience typedefs.
+
+// Standard QuantizedConvolution layer.
+typedef QuantizedConvolutionType<arma::mat> QuantizedConvolution;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "quantized_convolution_impl.hpp"
+
+#endif
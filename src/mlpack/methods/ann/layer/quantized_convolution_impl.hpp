@@ -0,0 +1,192 @@
+/**
+ * @file methods/ann/layer/quantized_convolution_impl.hpp
+ *
+ * Implementation of the QuantizedConvolution layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_CONVOLUTION_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_CONVOLUTION_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "quantized_convolution.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+QuantizedConvolutionType<MatType>::QuantizedConvolutionType() :
+    Layer<MatType>(),
+    maps(0),
+    inMaps(0),
+    higherInDimensions(0),
+    kernelWidth(0),
+    kernelHeight(0),
+    strideWidth(1),
+    strideHeight(1),
+    padWLeft(0),
+    padWRight(0),
+    padHTop(0),
+    padHBottom(0),
+    inputScale(1.0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+template<typename CubeType>
+QuantizedConvolutionType<MatType>::QuantizedConvolutionType(
+    const CubeType& weightIn,
+    const MatType& biasIn,
+    const size_t inMaps,
+    const size_t strideWidth,
+    const size_t strideHeight,
+    const size_t padWLeft,
+    const size_t padWRight,
+    const size_t padHTop,
+    const size_t padHBottom,
+    const double inputRange) :
+    Layer<MatType>(),
+    maps(weightIn.n_slices / inMaps),
+    inMaps(inMaps),
+    higherInDimensions(0),
+    kernelWidth(weightIn.n_rows),
+    kernelHeight(weightIn.n_cols),
+    strideWidth(strideWidth),
+    strideHeight(strideHeight),
+    padWLeft(padWLeft),
+    padWRight(padWRight),
+    padHTop(padHTop),
+    padHBottom(padHBottom),
+    bias(biasIn),
+    inputScale(QuantizationScale(inputRange))
+{
+  // The filters of each output map are contiguous, in the same order as the
+  // elements of the columns given by Im2Col(); so, each column of this alias
+  // holds the filters of one output map.
+  MatType filters;
+  MakeAlias(filters, weightIn, kernelWidth * kernelHeight * inMaps, maps);
+  QuantizeColumns(filters, weight, weightScale);
+}
+
+template<typename MatType>
+void QuantizedConvolutionType<MatType>::Forward(
+    const MatType& input, MatType& output)
+{
+  typedef typename GetCubeType<MatType>::type CubeType;
+
+  const size_t rows = this->inputDimensions[0];
+  const size_t cols = this->inputDimensions[1];
+  const size_t points = higherInDimensions * input.n_cols;
+  const size_t outSize = this->outputDimensions[0] * this->outputDimensions[1];
+  const size_t filterSize = kernelWidth * kernelHeight * inMaps;
+
+  const bool usingPadding =
+      (padWLeft != 0 || padWRight != 0 || padHTop != 0 || padHBottom != 0);
+  CubeType paddedInput;
+  if (usingPadding)
+  {
+    paddedInput.zeros(rows + padWLeft + padWRight, cols + padHTop + padHBottom,
+        inMaps);
+  }
+
+  CubeType inputTemp, pointInput;
+  MakeAlias(inputTemp, input, rows, cols, inMaps * points);
+
+  MatType columns, pointOutput;
+  std::vector<std::int8_t> quantizedColumns;
+  for (size_t point = 0; point < points; ++point)
+  {
+    MakeAlias(pointInput, inputTemp, rows, cols, inMaps,
+        point * rows * cols * inMaps);
+    if (usingPadding)
+    {
+      paddedInput.tube(padWLeft, padHTop, padWLeft + rows - 1,
+          padHTop + cols - 1) = pointInput;
+    }
+
+    // Each column holds the patch of one output element.
+    Im2ColConvolution<>::Im2Col((usingPadding ? paddedInput : pointInput),
+        kernelWidth, kernelHeight, strideWidth, strideHeight, 1, 1, columns);
+    Quantize(columns, inputScale, quantizedColumns);
+
+    // Each column of the output of a point is one output map.
+    MakeAlias(pointOutput, output, outSize, maps, point * outSize * maps);
+    QuantizedProduct(quantizedColumns.data(), weight.data(), filterSize,
+        pointOutput);
+
+    pointOutput.each_row() %= inputScale * weightScale.t();
+    if (!bias.is_empty())
+      pointOutput.each_row() += bias.t();
+  }
+}
+
+template<typename MatType>
+void QuantizedConvolutionType<MatType>::Backward(
+    const MatType& /* input */,
+    const MatType& /* output */,
+    const MatType& /* gy */,
+    MatType& /* g */)
+{
+  throw std::logic_error("QuantizedConvolution::Backward(): quantized layers "
+      "can only be used for inference!");
+}
+
+template<typename MatType>
+void QuantizedConvolutionType<MatType>::ComputeOutputDimensions()
+{
+  const size_t inputMaps = (this->inputDimensions.size() >= 3) ?
+      this->inputDimensions[2] : 1;
+  if (inputMaps != inMaps)
+  {
+    throw std::invalid_argument("QuantizedConvolution::"
+        "ComputeOutputDimensions(): number of input maps does not match the "
+        "filters!");
+  }
+
+  // The output has the same size as the output of the Convolution layer.
+  this->outputDimensions = std::vector<size_t>(
+      std::max(this->inputDimensions.size(), size_t(3)), 1);
+  this->outputDimensions[0] = (this->inputDimensions[0] + padWLeft + padWRight
+      - kernelWidth) / strideWidth + 1;
+  this->outputDimensions[1] = (this->inputDimensions[1] + padHTop + padHBottom
+      - kernelHeight) / strideHeight + 1;
+  this->outputDimensions[2] = maps;
+
+  higherInDimensions = 1;
+  for (size_t i = 3; i < this->inputDimensions.size(); ++i)
+  {
+    higherInDimensions *= this->inputDimensions[i];
+    this->outputDimensions[i] = this->inputDimensions[i];
+  }
+}
+
+template<typename MatType>
+template<typename Archive>
+void QuantizedConvolutionType<MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(maps));
+  ar(CEREAL_NVP(inMaps));
+  ar(CEREAL_NVP(higherInDimensions));
+  ar(CEREAL_NVP(kernelWidth));
+  ar(CEREAL_NVP(kernelHeight));
+  ar(CEREAL_NVP(strideWidth));
+  ar(CEREAL_NVP(strideHeight));
+  ar(CEREAL_NVP(padWLeft));
+  ar(CEREAL_NVP(padWRight));
+  ar(CEREAL_NVP(padHTop));
+  ar(CEREAL_NVP(padHBottom));
+  ar(CEREAL_NVP(weight));
+  ar(CEREAL_NVP(weightScale));
+  ar(CEREAL_NVP(bias));
+  ar(CEREAL_NVP(inputScale));
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,128 @@
+/**
+ * @file methods/ann/layer/quantized_linear.hpp
+ *
+ * Definition of the QuantizedLinear layer, an inference-only version of the
+ * Linear layer with 8-bit integer weights and inputs.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/quantization/quantize.hpp>
+
+#include "layer.hpp"
+
+namespace mlpack {
+
+/**
+ * The QuantizedLinear layer computes the same affine transformation y = Ax + b
+ * as the Linear layer, but with the weights A quantized to 8-bit integers with
+ * one scale for each output, and the input x quantized to 8-bit integers with
+ * one scale for the whole layer, chosen from the range of the inputs seen
+ * during calibration.  The products are accumulated in 32-bit integers, then
+ * scaled back and added to the (floating-point) bias.
+ *
+ * This layer is meant for inference only: it has no trainable weights, and
+ * Backward() throws an exception.  It is usually created from a trained
+ * network with `FFN::Quantize()`.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class QuantizedLinearType : public Layer<MatType>
+{
+ public:
+  //! Create the QuantizedLinear object.
+  QuantizedLinearType();
+
+  /**
+   * Create the QuantizedLinear layer object from the weights of a Linear
+   * layer.
+   *
+   * @param weight Weight matrix (outSize x inSize).
+   * @param bias Bias vector (outSize x 1), or an empty matrix if there is no
+   *     bias.
+   * @param inputRange Largest absolute value that the inputs are expected to
+   *     have; larger inputs are clamped.
+   */
+  QuantizedLinearType(const MatType& weight,
+                      const MatType& bias,
+                      const double inputRange);
+
+  virtual ~QuantizedLinearType() { }
+
+  //! Clone the QuantizedLinear object. This handles polymorphism correctly.
+  QuantizedLinearType* Clone() const { return new QuantizedLinearType(*this); }
+
+  /**
+   * Ordinary feed forward pass of the layer.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * The layer cannot be trained, so this throws a std::logic_error.
+   */
+  void Backward(const MatType& /* input */,
+                const MatType& /* output */,
+                const MatType& /* gy */,
+                MatType& /* g */);
+
+  //! Get the scale of the quantized weights of each output.
+  MatType const& WeightScale() const { return weightScale; }
+  //! Get the scale of the quantized inputs.
+  double InputScale() const { return inputScale; }
+
+  //! Get the bias of the layer.
+  MatType const& Bias() const { return bias; }
+
+  //! Compute the output dimensions of the layer given `InputDimensions()`.
+  void ComputeOutputDimensions();
+
+  //! Serialize the layer.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored number of input units.
+  size_t inSize;
+
+  //! Locally-stored number of output units.
+  size_t outSize;
+
+  //! The quantized weights; the inSize weights of each output are stored one
+  //! after another.
+  std::vector<std::int8_t> weight;
+
+  //! The scale of the quantized weights of each output.
+  MatType weightScale;
+
+  //! The bias of each output (empty if there is no bias).
+  MatType bias;
+
+  //! The scale of the quantized inputs.
+  double inputScale;
+
+  //! The quantized input of the last forward pass.
+  std::vector<std::int8_t> quantizedInput;
+}; // class QuantizedLinearType
+
+// Convenience typedefs.
+
+// Standard QuantizedLinear layer.
+typedef QuantizedLinearType<arma::mat> QuantizedLinear;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "quantized_linear_impl.hpp"
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * @file methods/ann/layer/quantized_linear_impl.hpp
+ *
+ * Implementation of the QuantizedLinear layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "quantized_linear.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+QuantizedLinearType<MatType>::QuantizedLinearType() :
+    Layer<MatType>(),
+    inSize(0),
+    outSize(0),
+    inputScale(1.0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+QuantizedLinearType<MatType>::QuantizedLinearType(
+    const MatType& weightIn,
+    const MatType& biasIn,
+    const double inputRange) :
+    Layer<MatType>(),
+    inSize(weightIn.n_cols),
+    outSize(weightIn.n_rows),
+    bias(biasIn),
+    inputScale(QuantizationScale(inputRange))
+{
+  // Each column of the transposed weight matrix holds the weights of one
+  // output.
+  const MatType weightT = weightIn.t();
+  QuantizeColumns(weightT, weight, weightScale);
+}
+
+template<typename MatType>
+void QuantizedLinearType<MatType>::Forward(
+    const MatType& input, MatType& output)
+{
+  Quantize(input, inputScale, quantizedInput);
+  QuantizedProduct(weight.data(), quantizedInput.data(), inSize, output);
+
+  output.each_col() %= inputScale * weightScale;
+  if (!bias.is_empty())
+    output.each_col() += bias;
+}
+
+template<typename MatType>
+void QuantizedLinearType<MatType>::Backward(
+    const MatType& /* input */,
+    const MatType& /* output */,
+    const MatType& /* gy */,
+    MatType& /* g */)
+{
+  throw std::logic_error("QuantizedLinear::Backward(): quantized layers can "
+      "only be used for inference!");
+}
+
+template<typename MatType>
+void QuantizedLinearType<MatType>::ComputeOutputDimensions()
+{
+  size_t totalInSize = this->inputDimensions[0];
+  for (size_t i = 1; i < this->inputDimensions.size(); ++i)
+    totalInSize *= this->inputDimensions[i];
+
+  if (totalInSize != inSize)
+  {
+    throw std::invalid_argument("QuantizedLinear::ComputeOutputDimensions(): "
+        "input size does not match the size of the weights!");
+  }
+
+  // The layer flattens its input, like the Linear layer.
+  this->outputDimensions = std::vector<size_t>(this->inputDimensions.size(),
+      1);
+  this->outputDimensions[0] = outSize;
+}
+
+template<typename MatType>
+template<typename Archive>
+void QuantizedLinearType<MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(outSize));
+  ar(CEREAL_NVP(weight));
+  ar(CEREAL_NVP(weightScale));
+  ar(CEREAL_NVP(bias));
+  ar(CEREAL_NVP(inputScale));
+}
+
+} // namespace mlpack
+
+#endif
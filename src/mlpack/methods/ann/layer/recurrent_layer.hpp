@@ -28,6 +28,13 @@ namespace mlpack {
  * allocate space to store previous states with the given batch size.  See the
  * documentation for that function for more details.
  *
+ * When the `RNN` is given packed sequences of different lengths (see
+ * `RNN::Train()`), each step is only passed the sequences that have not ended
+ * yet, which are always the first columns of the batch: the batch of a step
+ * may have fewer columns than the batch given to `ClearRecurrentState()`, and
+ * fewer columns than the previous step.  Recurrent layers must then use only
+ * the first `input.n_cols` columns of their stored states.
+ *
  * @tparam MatType Matrix representation to accept as input and use for
  *    computation.
  */
@@ -89,7 +89,7 @@ void ReLU6Type<MatType>::Backward(
     const MatType& gy,
     MatType& g)
 {
-  #pragma omp for
+  #pragma omp parallel for
   for (size_t i = 0; i < input.n_elem; ++i)
   {
     if (input(i) < 6 && input(i) > 0)
@@ -36,8 +36,14 @@
     CEREAL_REGISTER_TYPE(mlpack::ElliotType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::ElishType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::GaussianType<__VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::FastSigmoidType<__VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::FastTanHType<__VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::FastSwishType<__VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::FastGELUType<__VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::FastMishType<__VA_ARGS__>); \
     /* (end of base_layer.hpp) */ \
     CEREAL_REGISTER_TYPE(mlpack::BatchNormType<__VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::BlockSparseLinearType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::ConcatType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::ConcatenateType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::ConvolutionType< \
@@ -45,17 +51,28 @@
         mlpack::NaiveConvolution<mlpack::FullConvolution>, \
         mlpack::NaiveConvolution<mlpack::ValidConvolution>, \
         __VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::ConvolutionType< \
+        mlpack::Im2ColConvolution<mlpack::ValidConvolution>, \
+        mlpack::Im2ColConvolution<mlpack::FullConvolution>, \
+        mlpack::Im2ColConvolution<mlpack::ValidConvolution>, \
+        __VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::CELUType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::CReLUType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::DropConnectType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::DropoutType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::ELUType<__VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::EmbeddingType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::FlexibleReLUType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::GroupedConvolutionType< \
         mlpack::NaiveConvolution<mlpack::ValidConvolution>, \
         mlpack::NaiveConvolution<mlpack::FullConvolution>, \
         mlpack::NaiveConvolution<mlpack::ValidConvolution>, \
         __VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::GroupedConvolutionType< \
+        mlpack::Im2ColConvolution<mlpack::ValidConvolution>, \
+        mlpack::Im2ColConvolution<mlpack::FullConvolution>, \
+        mlpack::Im2ColConvolution<mlpack::ValidConvolution>, \
+        __VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::IdentityType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::LeakyReLUType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::LayerNormType<__VA_ARGS__>); \
@@ -70,11 +87,14 @@
     CEREAL_REGISTER_TYPE(mlpack::NoisyLinearType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::PaddingType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::PReLUType<__VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::QuantizedConvolutionType<__VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::QuantizedLinearType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::RBFType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::ReLU6Type<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::RepeatType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::SoftmaxType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::SoftminType<__VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::SparseLinearType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::HardTanHType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::FTSwishType<__VA_ARGS__>); \
 
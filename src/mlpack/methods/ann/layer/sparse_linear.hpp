@@ -0,0 +1,226 @@
+/**
+ * @file methods/ann/layer/sparse_linear.hpp
+ *
+ * Definition of the SparseLinear layer, a Linear layer for sparse inputs given
+ * as the indices and values of their nonzero elements.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_SPARSE_LINEAR_HPP
+#define MLPACK_METHODS_ANN_LAYER_SPARSE_LINEAR_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/regularizer/no_regularizer.hpp>
+
+#include "layer.hpp"
+
+namespace mlpack {
+
+/**
+ * The SparseLinear layer applies the same affine transformation y = Ax + b as
+ * the Linear layer, for very high-dimensional sparse inputs x (like hashed
+ * one-hot features).  Only the columns of A for the nonzero elements of x are
+ * used, so the cost of a forward pass depends on the number of nonzero
+ * elements instead of the dimensionality of x; this is like an "embedding bag"
+ * that computes the weighted sum of the embeddings of its indices.
+ *
+ * Since networks use dense matrices, each sparse input point is given to the
+ * layer as a column with `2 * maxNonzeros` rows: the first `maxNonzeros` rows
+ * hold the indices of the nonzero elements, and the next `maxNonzeros` rows
+ * hold their values.  Unused entries have a value of zero.  Use `Encode()` to
+ * convert a sparse matrix to this representation:
+ *
+ * ```
+ * arma::sp_mat sparseData; // 1000000 x N, at most 50 nonzeros per column.
+ * arma::mat data;
+ * SparseLinear::Encode(sparseData, 50, data);
+ *
+ * FFN<> model;
+ * model.Add<SparseLinear>(1000000, 64, 50);
+ * model.Add<ReLU>();
+ * model.Add<Linear>(10);
+ * model.Train(data, labels);
+ * ```
+ *
+ * The indices are stored as elements of `MatType`, so with single-precision
+ * matrices the input dimensionality must be at most 2^24.
+ *
+ * In `Gradient()`, only the columns of the weight gradient for the indices
+ * given in the batch are computed; the other columns are zero.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ * @tparam RegularizerType Type of the regularizer to be used (Default no
+ *    regularizer).
+ */
+template<
+    typename MatType = arma::mat,
+    typename RegularizerType = NoRegularizer
+>
+class SparseLinearType : public Layer<MatType>
+{
+ public:
+  //! Create the SparseLinear object.
+  SparseLinearType();
+
+  /**
+   * Create the SparseLinear layer object.
+   *
+   * @param inSize Dimensionality of the sparse input points.
+   * @param outSize The output dimension.
+   * @param maxNonzeros Largest number of nonzero elements of an input point.
+   * @param regularizer The regularizer to use, optional (default: no
+   *     regularizer).
+   */
+  SparseLinearType(const size_t inSize,
+                   const size_t outSize,
+                   const size_t maxNonzeros,
+                   RegularizerType regularizer = RegularizerType());
+
+  virtual ~SparseLinearType() { }
+
+  //! Clone the SparseLinearType object. This handles polymorphism correctly.
+  SparseLinearType* Clone() const { return new SparseLinearType(*this); }
+
+  //! Copy the other SparseLinear layer (but not weights).
+  SparseLinearType(const SparseLinearType& layer);
+
+  //! Take ownership of the members of the other SparseLinear layer (but not
+  //! weights).
+  SparseLinearType(SparseLinearType&& layer);
+
+  //! Copy the other SparseLinear layer (but not weights).
+  SparseLinearType& operator=(const SparseLinearType& layer);
+
+  //! Take ownership of the members of the other SparseLinear layer (but not
+  //! weights).
+  SparseLinearType& operator=(SparseLinearType&& layer);
+
+  /**
+   * Reset the layer parameter (weights and bias). The method is called to
+   * assign the allocated memory to the internal learnable parameters.
+   */
+  void SetWeights(const MatType& weightsIn);
+
+  /**
+   * Ordinary feed forward pass of a neural network: compute Ax + b using only
+   * the columns of A for the nonzero elements of each input point x.
+   *
+   * @param input Indices and values of the nonzero elements of each input
+   *     point (see `Encode()`).
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * Ordinary feed backward pass of a neural network.  The backpropagated
+   * error of each value is computed; the error of the indices is zero.
+   *
+   * @param input The input data (x) given to the forward pass.
+   * @param output The propagated data (f(x)) resulting from Forward()
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  void Backward(const MatType& input,
+                const MatType& /* output */,
+                const MatType& gy,
+                MatType& g);
+
+  /**
+   * Calculate the gradient using the output delta and the input activation.
+   * Only the columns of the weight gradient for the indices of the batch are
+   * nonzero.
+   *
+   * @param input The input parameter used for calculating the gradient.
+   * @param error The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  void Gradient(const MatType& input,
+                const MatType& error,
+                MatType& gradient);
+
+  /**
+   * Convert the given sparse matrix to the input representation of the layer:
+   * each column of `encoded` holds the indices of the nonzero elements of the
+   * corresponding column of `input`, then their values.  A
+   * std::invalid_argument is thrown if a column of `input` has more than
+   * `maxNonzeros` nonzero elements.
+   *
+   * @param input Sparse matrix to convert.
+   * @param maxNonzeros Largest number of nonzero elements of a column.
+   * @param encoded Matrix to store the input representation into.
+   */
+  template<typename SpMatType>
+  static void Encode(const SpMatType& input,
+                     const size_t maxNonzeros,
+                     MatType& encoded);
+
+  //! Get the parameters.
+  const MatType& Parameters() const { return weights; }
+  //! Modify the parameters.
+  MatType& Parameters() { return weights; }
+
+  //! Get the weight of the layer.
+  MatType const& Weight() const { return weight; }
+  //! Modify the weight of the layer.
+  MatType& Weight() { return weight; }
+
+  //! Get the bias of the layer.
+  MatType const& Bias() const { return bias; }
+  //! Modify the bias weights of the layer.
+  MatType& Bias() { return bias; }
+
+  //! Get the dimensionality of the sparse input points.
+  size_t InSize() const { return inSize; }
+
+  //! Get the largest number of nonzero elements of an input point.
+  size_t MaxNonzeros() const { return maxNonzeros; }
+
+  //! Get the size of the weights.
+  size_t WeightSize() const { return (inSize * outSize) + outSize; }
+
+  //! Compute the output dimensions of the layer given `InputDimensions()`.
+  void ComputeOutputDimensions();
+
+  //! Serialize the layer.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored dimensionality of the sparse input points.
+  size_t inSize;
+
+  //! Locally-stored number of output units.
+  size_t outSize;
+
+  //! Locally-stored largest number of nonzero elements of an input point.
+  size_t maxNonzeros;
+
+  //! Locally-stored weight object.  This holds all the weights in a vectorized
+  //! form; i.e., the weight and the bias.
+  MatType weights;
+
+  //! Locally-stored weight parameters.
+  MatType weight;
+
+  //! Locally-stored bias term parameters.
+  MatType bias;
+
+  //! Locally-stored regularizer object.
+  RegularizerType regularizer;
+}; // class SparseLinearType
+
+// Convenience typedefs.
+
+// Standard SparseLinear layer using no regularization.
+typedef SparseLinearType<arma::mat, NoRegularizer> SparseLinear;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "sparse_linear_impl.hpp"
+
+#endif
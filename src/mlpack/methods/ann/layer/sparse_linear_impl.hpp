@@ -0,0 +1,241 @@
+/**
+ * @file methods/ann/layer/sparse_linear_impl.hpp
+ *
+ * Implementation of the SparseLinear layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_SPARSE_LINEAR_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_SPARSE_LINEAR_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "sparse_linear.hpp"
+
+namespace mlpack {
+
+template<typename MatType, typename RegularizerType>
+SparseLinearType<MatType, RegularizerType>::SparseLinearType() :
+    Layer<MatType>(),
+    inSize(0),
+    outSize(0),
+    maxNonzeros(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType, typename RegularizerType>
+SparseLinearType<MatType, RegularizerType>::SparseLinearType(
+    const size_t inSize,
+    const size_t outSize,
+    const size_t maxNonzeros,
+    RegularizerType regularizer) :
+    Layer<MatType>(),
+    inSize(inSize),
+    outSize(outSize),
+    maxNonzeros(maxNonzeros),
+    regularizer(regularizer)
+{
+  weights.set_size(WeightSize(), 1);
+}
+
+// Copy constructor.
+template<typename MatType, typename RegularizerType>
+SparseLinearType<MatType, RegularizerType>::SparseLinearType(
+    const SparseLinearType& layer) :
+    Layer<MatType>(layer),
+    inSize(layer.inSize),
+    outSize(layer.outSize),
+    maxNonzeros(layer.maxNonzeros),
+    regularizer(layer.regularizer)
+{
+  // Nothing else to do.
+}
+
+// Move constructor.
+template<typename MatType, typename RegularizerType>
+SparseLinearType<MatType, RegularizerType>::SparseLinearType(
+    SparseLinearType&& layer) :
+    Layer<MatType>(std::move(layer)),
+    inSize(std::move(layer.inSize)),
+    outSize(std::move(layer.outSize)),
+    maxNonzeros(std::move(layer.maxNonzeros)),
+    regularizer(std::move(layer.regularizer))
+{
+  // Nothing else to do.
+}
+
+template<typename MatType, typename RegularizerType>
+SparseLinearType<MatType, RegularizerType>&
+SparseLinearType<MatType, RegularizerType>::operator=(
+    const SparseLinearType& layer)
+{
+  if (&layer != this)
+  {
+    Layer<MatType>::operator=(layer);
+    inSize = layer.inSize;
+    outSize = layer.outSize;
+    maxNonzeros = layer.maxNonzeros;
+    regularizer = layer.regularizer;
+  }
+
+  return *this;
+}
+
+template<typename MatType, typename RegularizerType>
+SparseLinearType<MatType, RegularizerType>&
+SparseLinearType<MatType, RegularizerType>::operator=(
+    SparseLinearType&& layer)
+{
+  if (&layer != this)
+  {
+    Layer<MatType>::operator=(std::move(layer));
+    inSize = std::move(layer.inSize);
+    outSize = std::move(layer.outSize);
+    maxNonzeros = std::move(layer.maxNonzeros);
+    regularizer = std::move(layer.regularizer);
+  }
+
+  return *this;
+}
+
+template<typename MatType, typename RegularizerType>
+void SparseLinearType<MatType, RegularizerType>::SetWeights(
+    const MatType& weightsIn)
+{
+  MakeAlias(weights, weightsIn, outSize * inSize + outSize, 1);
+  MakeAlias(weight, weightsIn, outSize, inSize);
+  MakeAlias(bias, weightsIn, outSize, 1, weight.n_elem);
+}
+
+template<typename MatType, typename RegularizerType>
+void SparseLinearType<MatType, RegularizerType>::Forward(
+    const MatType& input, MatType& output)
+{
+  #pragma omp parallel for
+  for (size_t c = 0; c < (size_t) input.n_cols; ++c)
+  {
+    output.col(c) = bias;
+    for (size_t j = 0; j < maxNonzeros; ++j)
+    {
+      const typename MatType::elem_type value = input(maxNonzeros + j, c);
+      if (value != 0)
+        output.col(c) += value * weight.col((size_t) input(j, c));
+    }
+  }
+}
+
+template<typename MatType, typename RegularizerType>
+void SparseLinearType<MatType, RegularizerType>::Backward(
+    const MatType& input,
+    const MatType& /* output */,
+    const MatType& gy,
+    MatType& g)
+{
+  g.set_size(input.n_rows, input.n_cols);
+  g.rows(0, maxNonzeros - 1).zeros();
+
+  #pragma omp parallel for
+  for (size_t c = 0; c < (size_t) input.n_cols; ++c)
+  {
+    for (size_t j = 0; j < maxNonzeros; ++j)
+    {
+      g(maxNonzeros + j, c) = dot(weight.col((size_t) input(j, c)),
+          gy.col(c));
+    }
+  }
+}
+
+template<typename MatType, typename RegularizerType>
+void SparseLinearType<MatType, RegularizerType>::Gradient(
+    const MatType& input,
+    const MatType& error,
+    MatType& gradient)
+{
+  // Only the columns of the weights for the indices of the batch get a
+  // nonzero gradient.
+  MatType weightGradient;
+  MakeAlias(weightGradient, gradient, outSize, inSize);
+  weightGradient.zeros();
+  for (size_t c = 0; c < (size_t) input.n_cols; ++c)
+  {
+    for (size_t j = 0; j < maxNonzeros; ++j)
+    {
+      const typename MatType::elem_type value = input(maxNonzeros + j, c);
+      if (value != 0)
+        weightGradient.col((size_t) input(j, c)) += value * error.col(c);
+    }
+  }
+
+  gradient.submat(weight.n_elem, 0, gradient.n_elem - 1, 0) = sum(error, 1);
+  regularizer.Evaluate(weights, gradient);
+}
+
+template<typename MatType, typename RegularizerType>
+template<typename SpMatType>
+void SparseLinearType<MatType, RegularizerType>::Encode(
+    const SpMatType& input,
+    const size_t maxNonzeros,
+    MatType& encoded)
+{
+  encoded.zeros(2 * maxNonzeros, input.n_cols);
+  for (size_t c = 0; c < (size_t) input.n_cols; ++c)
+  {
+    size_t j = 0;
+    for (typename SpMatType::const_iterator it = input.begin_col(c);
+         it != input.end_col(c); ++it, ++j)
+    {
+      if (j == maxNonzeros)
+      {
+        std::ostringstream oss;
+        oss << "SparseLinear::Encode(): column " << c << " has more than "
+            << maxNonzeros << " nonzero elements!";
+        throw std::invalid_argument(oss.str());
+      }
+
+      encoded(j, c) = it.row();
+      encoded(maxNonzeros + j, c) = *it;
+    }
+  }
+}
+
+template<typename MatType, typename RegularizerType>
+void SparseLinearType<MatType, RegularizerType>::ComputeOutputDimensions()
+{
+  size_t totalInputSize = this->inputDimensions[0];
+  for (size_t i = 1; i < this->inputDimensions.size(); ++i)
+    totalInputSize *= this->inputDimensions[i];
+
+  if (totalInputSize != 2 * maxNonzeros)
+  {
+    std::ostringstream oss;
+    oss << "SparseLinear::ComputeOutputDimensions(): the input must hold the "
+        << "indices and values of " << maxNonzeros << " nonzero elements ("
+        << 2 * maxNonzeros << " rows), but it has " << totalInputSize
+        << " rows!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  this->outputDimensions = std::vector<size_t>(this->inputDimensions.size(),
+      1);
+  this->outputDimensions[0] = outSize;
+}
+
+template<typename MatType, typename RegularizerType>
+template<typename Archive>
+void SparseLinearType<MatType, RegularizerType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(outSize));
+  ar(CEREAL_NVP(maxNonzeros));
+  ar(CEREAL_NVP(regularizer));
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,167 @@
+/**
+ * @file methods/ann/layer_profiler.hpp
+ *
+ * Definition of the LayerProfiler class, which records the time spent in the
+ * forward pass, backward pass and gradient computation of each layer of a
+ * network, and the size of their results.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_PROFILER_HPP
+#define MLPACK_METHODS_ANN_LAYER_PROFILER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <chrono>
+
+namespace mlpack {
+
+/**
+ * The LayerProfiler records, for each layer held by a MultiLayer (and so for
+ * each layer of an `FFN` or an `RNN`), the number of calls and the total time
+ * of its `Forward()`, `Backward()` and `Gradient()` methods, along with the
+ * shape and size of the last output and the last backpropagated error that it
+ * computed.  Profiling is enabled by giving a profiler to the network:
+ *
+ * ```
+ * LayerProfiler profiler;
+ * model.Profiler() = &profiler;
+ * model.Train(data, labels, optimizer);
+ * model.Profiler() = nullptr;
+ *
+ * profiler.Print();            // Print a table with Log::Info.
+ * profiler.ExportJSON(stream); // Or export the results as JSON.
+ * ```
+ *
+ * When no profiler is given (the default), the layers are not timed at all.
+ * If `useTimers` is `true`, each pass of each layer is also timed with the
+ * mlpack `Timer` named `<prefix><layer>_forward`, `<prefix><layer>_backward`
+ * or `<prefix><layer>_gradient`, so that it is reported with the other timers
+ * of a program.
+ *
+ * A profiler must only be used by one network at a time; copies of a network
+ * (like the replicas used for data-parallel training) are not profiled.
+ */
+class LayerProfiler
+{
+ public:
+  //! The passes of a layer that are profiled.
+  enum Pass
+  {
+    FORWARD = 0,
+    BACKWARD = 1,
+    GRADIENT = 2
+  };
+
+  //! The profile of one layer.
+  struct LayerProfile
+  {
+    LayerProfile() :
+        calls{ 0, 0, 0 },
+        time{ },
+        outputRows(0),
+        outputCols(0),
+        outputBytes(0),
+        deltaBytes(0)
+    { }
+
+    //! The type of the layer (without its template parameters).
+    std::string name;
+    //! The number of calls of each pass.
+    size_t calls[3];
+    //! The total time of each pass.
+    std::chrono::nanoseconds time[3];
+    //! The number of rows of the last output of the layer.
+    size_t outputRows;
+    //! The number of columns of the last output of the layer.
+    size_t outputCols;
+    //! The size of the last output of the layer, in bytes.
+    size_t outputBytes;
+    //! The size of the last backpropagated error of the layer, in bytes.
+    size_t deltaBytes;
+  };
+
+  /**
+   * Create the LayerProfiler.
+   *
+   * @param useTimers Whether to also time each pass of each layer with the
+   *     mlpack `Timer`.
+   * @param timerPrefix Prefix of the names of the timers.
+   */
+  LayerProfiler(const bool useTimers = false,
+                const std::string& timerPrefix = "layer_");
+
+  /**
+   * Start timing the given pass of the given layer.
+   *
+   * @param layer Index of the layer.
+   * @param pass Pass to time.
+   */
+  void Start(const size_t layer, const Pass pass);
+
+  /**
+   * Stop timing the given pass of the given layer, and record the size of its
+   * result.
+   *
+   * @param layer Index of the layer.
+   * @param pass Pass that was timed.
+   * @param layerObject The layer itself, used to find its name.
+   * @param result Result of the pass (the output for `FORWARD`, the
+   *     backpropagated error for `BACKWARD`).
+   */
+  template<typename LayerType, typename MatType>
+  void Stop(const size_t layer,
+            const Pass pass,
+            const LayerType& layerObject,
+            const MatType& result);
+
+  //! Get the profile of each layer.
+  const std::vector<LayerProfile>& Profiles() const { return profiles; }
+
+  //! Remove all the recorded profiles.
+  void Reset() { profiles.clear(); }
+
+  //! Print a table with the profile of each layer to `Log::Info`.
+  void Print() const;
+
+  /**
+   * Print a table with the profile of each layer to the given stream.
+   *
+   * @param stream Stream to print to.
+   */
+  void Print(std::ostream& stream) const;
+
+  /**
+   * Export the profile of each layer to the given stream, as a JSON array with
+   * one object per layer; times are given in microseconds.
+   *
+   * @param stream Stream to export to.
+   */
+  void ExportJSON(std::ostream& stream) const;
+
+ private:
+  //! Return the name of the timer of the given pass of the given layer.
+  std::string TimerName(const size_t layer, const Pass pass) const;
+
+  //! Whether each pass is also timed with the mlpack `Timer`.
+  bool useTimers;
+
+  //! The prefix of the names of the timers.
+  std::string timerPrefix;
+
+  //! The time at which the current pass started.
+  std::chrono::steady_clock::time_point start;
+
+  //! The profile of each layer.
+  std::vector<LayerProfile> profiles;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "layer_profiler_impl.hpp"
+
+#endif
@@ -0,0 +1,167 @@
+/**
+ * @file methods/ann/layer_profiler_impl.hpp
+ *
+ * Implementation of the LayerProfiler class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_PROFILER_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_PROFILER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "layer_profiler.hpp"
+
+#include <cereal/details/util.hpp>
+#include <iomanip>
+#include <sstream>
+#include <typeinfo>
+
+namespace mlpack {
+
+inline LayerProfiler::LayerProfiler(const bool useTimers,
+                                    const std::string& timerPrefix) :
+    useTimers(useTimers),
+    timerPrefix(timerPrefix)
+{
+  // Nothing to do here.
+}
+
+inline void LayerProfiler::Start(const size_t layer, const Pass pass)
+{
+  if (useTimers)
+    Timer::Start(TimerName(layer, pass));
+
+  start = std::chrono::steady_clock::now();
+}
+
+template<typename LayerType, typename MatType>
+void LayerProfiler::Stop(const size_t layer,
+                         const Pass pass,
+                         const LayerType& layerObject,
+                         const MatType& result)
+{
+  const std::chrono::steady_clock::time_point end =
+      std::chrono::steady_clock::now();
+  if (useTimers)
+    Timer::Stop(TimerName(layer, pass));
+
+  if (layer >= profiles.size())
+    profiles.resize(layer + 1);
+
+  LayerProfile& profile = profiles[layer];
+  if (profile.name.empty())
+  {
+    // Keep only the name of the class, like "Linear" for
+    // "mlpack::LinearType<arma::Mat<double>, mlpack::NoRegularizer>".
+    std::string name = cereal::util::demangle(typeid(layerObject).name());
+    name = name.substr(0, name.find('<'));
+    const size_t lastScope = name.rfind("::");
+    if (lastScope != std::string::npos)
+      name = name.substr(lastScope + 2);
+    if (name.size() > 4 && name.compare(name.size() - 4, 4, "Type") == 0)
+      name = name.substr(0, name.size() - 4);
+    profile.name = name;
+  }
+
+  ++profile.calls[pass];
+  profile.time[pass] += std::chrono::duration_cast<std::chrono::nanoseconds>(
+      end - start);
+
+  const size_t bytes = result.n_elem * sizeof(typename MatType::elem_type);
+  if (pass == FORWARD)
+  {
+    profile.outputRows = result.n_rows;
+    profile.outputCols = result.n_cols;
+    profile.outputBytes = bytes;
+  }
+  else if (pass == BACKWARD)
+  {
+    profile.deltaBytes = bytes;
+  }
+}
+
+inline void LayerProfiler::Print() const
+{
+  std::ostringstream stream;
+  Print(stream);
+  Log::Info << stream.str();
+}
+
+inline void LayerProfiler::Print(std::ostream& stream) const
+{
+  const auto milliseconds = [](const std::chrono::nanoseconds& time)
+  {
+    return std::chrono::duration<double, std::milli>(time).count();
+  };
+
+  stream << std::left << std::setw(6) << "layer" << std::setw(20) << "type"
+      << std::setw(16) << "output" << std::right << std::setw(14)
+      << "forward (ms)" << std::setw(15) << "backward (ms)" << std::setw(15)
+      << "gradient (ms)" << std::setw(14) << "output (KiB)" << std::endl;
+
+  std::chrono::nanoseconds total[3] = { };
+  size_t totalBytes = 0;
+  for (size_t i = 0; i < profiles.size(); ++i)
+  {
+    const LayerProfile& profile = profiles[i];
+    std::ostringstream shape;
+    shape << profile.outputRows << "x" << profile.outputCols;
+
+    stream << std::left << std::setw(6) << i << std::setw(20) << profile.name
+        << std::setw(16) << shape.str() << std::right << std::fixed
+        << std::setprecision(3) << std::setw(14)
+        << milliseconds(profile.time[FORWARD]) << std::setw(15)
+        << milliseconds(profile.time[BACKWARD]) << std::setw(15)
+        << milliseconds(profile.time[GRADIENT]) << std::setw(14)
+        << profile.outputBytes / 1024.0 << std::endl;
+
+    for (size_t p = 0; p < 3; ++p)
+      total[p] += profile.time[p];
+    totalBytes += profile.outputBytes;
+  }
+
+  stream << std::left << std::setw(42) << "total" << std::right << std::fixed
+      << std::setprecision(3) << std::setw(14) << milliseconds(total[FORWARD])
+      << std::setw(15) << milliseconds(total[BACKWARD]) << std::setw(15)
+      << milliseconds(total[GRADIENT]) << std::setw(14) << totalBytes / 1024.0
+      << std::endl;
+}
+
+inline void LayerProfiler::ExportJSON(std::ostream& stream) const
+{
+  const char* passNames[3] = { "forward", "backward", "gradient" };
+
+  stream << "[";
+  for (size_t i = 0; i < profiles.size(); ++i)
+  {
+    const LayerProfile& profile = profiles[i];
+    stream << (i == 0 ? "\n" : ",\n") << "  { \"layer\": " << i
+        << ", \"type\": \"" << profile.name << "\", \"outputRows\": "
+        << profile.outputRows << ", \"outputCols\": " << profile.outputCols
+        << ", \"outputBytes\": " << profile.outputBytes << ", \"deltaBytes\": "
+        << profile.deltaBytes;
+    for (size_t p = 0; p < 3; ++p)
+    {
+      stream << ", \"" << passNames[p] << "\": { \"calls\": "
+          << profile.calls[p] << ", \"microseconds\": "
+          << std::chrono::duration_cast<std::chrono::microseconds>(
+              profile.time[p]).count() << " }";
+    }
+    stream << " }";
+  }
+  stream << "\n]" << std::endl;
+}
+
+inline std::string LayerProfiler::TimerName(const size_t layer,
+                                            const Pass pass) const
+{
+  const char* passNames[3] = { "forward", "backward", "gradient" };
+  return timerPrefix + std::to_string(layer) + "_" + passNames[pass];
+}
+
+} // namespace mlpack
+
+#endif
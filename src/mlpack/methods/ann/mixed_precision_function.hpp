@@ -0,0 +1,163 @@
+/**
+ * @file methods/ann/mixed_precision_function.hpp
+ *
+ * Definition of the MixedPrecisionFunction class, which lets an ensmallen
+ * optimizer train a network that computes in reduced precision on
+ * full-precision master weights, with dynamic loss scaling.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_MIXED_PRECISION_FUNCTION_HPP
+#define MLPACK_METHODS_ANN_MIXED_PRECISION_FUNCTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * MixedPrecisionFunction wraps a network (like `FFN<..., arma::fmat>`) whose
+ * weights, activations and computations use a reduced-precision matrix type,
+ * so that an ensmallen optimizer can train it on master weights of type
+ * `MasterMatType` (by default, double precision).  At each step, the master
+ * weights are rounded to the precision of the network, the gradient is
+ * computed by the network, and it is converted back to the precision of the
+ * master weights before the optimizer applies it; so, small updates are not
+ * lost to rounding.
+ *
+ * Dynamic loss scaling is used so that small gradients are not lost in the
+ * reduced-precision backward pass: the gradient of the loss is multiplied by
+ * the loss scale before the backward pass (see `FFN::LossScale()`), and the
+ * resulting gradient is divided by it.  If the scaled gradient overflows, the
+ * step is skipped (the optimizer is given a zero gradient) and the loss scale
+ * is halved; after `growthInterval` steps without overflow, the loss scale is
+ * doubled.  Note that the gradients of layer regularizers are not scaled, so
+ * their effect is divided by the loss scale; use a loss scale of 1 without
+ * growth for networks with regularizers.
+ *
+ * The training data of the network must be set with `ResetData()` before
+ * optimization; `FFN::TrainMixedPrecision()` does all of this.
+ *
+ * @tparam NetworkType Type of the network to train.
+ * @tparam MasterMatType Matrix type of the master weights.
+ */
+template<typename NetworkType, typename MasterMatType = arma::mat>
+class MixedPrecisionFunction
+{
+ public:
+  //! Matrix type of the network.
+  typedef typename std::remove_const<typename std::remove_reference<
+      decltype(std::declval<NetworkType&>().Parameters())>::type>::type
+      NetworkMatType;
+
+  /**
+   * Create the MixedPrecisionFunction for the given network.
+   *
+   * @param network Network to train; its training data must be set.
+   * @param lossScale Initial loss scale.
+   * @param growthInterval Number of steps without overflow after which the
+   *     loss scale is doubled (0 means that it is never increased).
+   */
+  MixedPrecisionFunction(NetworkType& network,
+                         const double lossScale = 65536.0,
+                         const size_t growthInterval = 2000);
+
+  /**
+   * Evaluate the objective of the network on all the training points, with the
+   * given master weights.
+   *
+   * @param parameters Master weights.
+   */
+  double Evaluate(const MasterMatType& parameters);
+
+  /**
+   * Evaluate the objective of the network on the given batch of training
+   * points, with the given master weights.
+   *
+   * @param parameters Master weights.
+   * @param begin Index of the first point of the batch.
+   * @param batchSize Number of points in the batch.
+   */
+  double Evaluate(const MasterMatType& parameters,
+                  const size_t begin,
+                  const size_t batchSize);
+
+  /**
+   * Evaluate the objective and the gradient of the network on the given batch
+   * of training points, with the given master weights.  This also updates the
+   * loss scale.
+   *
+   * @param parameters Master weights.
+   * @param begin Index of the first point of the batch.
+   * @param gradient Matrix to store the (unscaled) gradient into.
+   * @param batchSize Number of points in the batch.
+   */
+  double EvaluateWithGradient(const MasterMatType& parameters,
+                              const size_t begin,
+                              MasterMatType& gradient,
+                              const size_t batchSize);
+
+  /**
+   * Compute the gradient of the network on the given batch of training points,
+   * with the given master weights.
+   *
+   * @param parameters Master weights.
+   * @param begin Index of the first point of the batch.
+   * @param gradient Matrix to store the (unscaled) gradient into.
+   * @param batchSize Number of points in the batch.
+   */
+  void Gradient(const MasterMatType& parameters,
+                const size_t begin,
+                MasterMatType& gradient,
+                const size_t batchSize);
+
+  //! Return the number of training points.
+  size_t NumFunctions() const { return network.NumFunctions(); }
+
+  //! Shuffle the training points.
+  void Shuffle() { network.Shuffle(); }
+
+  /**
+   * Round the given master weights to the precision of the network, and store
+   * them as the weights of the network.
+   *
+   * @param parameters Master weights.
+   */
+  void SetParameters(const MasterMatType& parameters);
+
+  //! Get the current loss scale.
+  double LossScale() const { return lossScale; }
+  //! Modify the current loss scale.
+  double& LossScale() { return lossScale; }
+
+  //! Get the number of steps without overflow before the loss scale grows.
+  size_t GrowthInterval() const { return growthInterval; }
+  //! Modify the number of steps without overflow before the loss scale grows.
+  size_t& GrowthInterval() { return growthInterval; }
+
+ private:
+  //! The network to train.
+  NetworkType& network;
+
+  //! The current loss scale.
+  double lossScale;
+
+  //! The number of steps without overflow before the loss scale grows.
+  size_t growthInterval;
+
+  //! The number of steps without overflow since the last change of the loss
+  //! scale.
+  size_t goodSteps;
+
+  //! The gradient computed by the network, in its own precision.
+  NetworkMatType networkGradient;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "mixed_precision_function_impl.hpp"
+
+#endif
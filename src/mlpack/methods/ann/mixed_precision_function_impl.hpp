@@ -0,0 +1,117 @@
+/**
+ * @file methods/ann/mixed_precision_function_impl.hpp
+ *
+ * Implementation of the MixedPrecisionFunction class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_MIXED_PRECISION_FUNCTION_IMPL_HPP
+#define MLPACK_METHODS_ANN_MIXED_PRECISION_FUNCTION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mixed_precision_function.hpp"
+
+namespace mlpack {
+
+template<typename NetworkType, typename MasterMatType>
+MixedPrecisionFunction<NetworkType, MasterMatType>::MixedPrecisionFunction(
+    NetworkType& network,
+    const double lossScale,
+    const size_t growthInterval) :
+    network(network),
+    lossScale(lossScale),
+    growthInterval(growthInterval),
+    goodSteps(0)
+{
+  if (lossScale <= 0.0)
+  {
+    throw std::invalid_argument("MixedPrecisionFunction: loss scale must be "
+        "positive!");
+  }
+}
+
+template<typename NetworkType, typename MasterMatType>
+double MixedPrecisionFunction<NetworkType, MasterMatType>::Evaluate(
+    const MasterMatType& parameters)
+{
+  SetParameters(parameters);
+  return network.Evaluate(network.Parameters());
+}
+
+template<typename NetworkType, typename MasterMatType>
+double MixedPrecisionFunction<NetworkType, MasterMatType>::Evaluate(
+    const MasterMatType& parameters,
+    const size_t begin,
+    const size_t batchSize)
+{
+  SetParameters(parameters);
+  return network.Evaluate(network.Parameters(), begin, batchSize);
+}
+
+template<typename NetworkType, typename MasterMatType>
+double MixedPrecisionFunction<NetworkType, MasterMatType>::EvaluateWithGradient(
+    const MasterMatType& parameters,
+    const size_t begin,
+    MasterMatType& gradient,
+    const size_t batchSize)
+{
+  SetParameters(parameters);
+
+  network.LossScale() = lossScale;
+  const double objective = network.EvaluateWithGradient(network.Parameters(),
+      begin, networkGradient, batchSize);
+  network.LossScale() = 1.0;
+
+  gradient = arma::conv_to<MasterMatType>::from(networkGradient) / lossScale;
+  if (!gradient.is_finite())
+  {
+    // The scaled gradient overflowed: skip this step, and use a smaller scale
+    // for the next ones.
+    gradient.zeros();
+    lossScale = std::max(lossScale / 2.0, 1.0);
+    goodSteps = 0;
+  }
+  else if (growthInterval > 0 && ++goodSteps == growthInterval)
+  {
+    lossScale *= 2.0;
+    goodSteps = 0;
+  }
+
+  return objective;
+}
+
+template<typename NetworkType, typename MasterMatType>
+void MixedPrecisionFunction<NetworkType, MasterMatType>::Gradient(
+    const MasterMatType& parameters,
+    const size_t begin,
+    MasterMatType& gradient,
+    const size_t batchSize)
+{
+  EvaluateWithGradient(parameters, begin, gradient, batchSize);
+}
+
+template<typename NetworkType, typename MasterMatType>
+void MixedPrecisionFunction<NetworkType, MasterMatType>::SetParameters(
+    const MasterMatType& parameters)
+{
+  typedef typename NetworkMatType::elem_type ElemType;
+
+  // The layers of the network are aliases of its parameters, so the
+  // parameters must be overwritten in place.
+  NetworkMatType& networkParameters = network.Parameters();
+  if (networkParameters.n_elem != parameters.n_elem)
+  {
+    throw std::invalid_argument("MixedPrecisionFunction::SetParameters(): "
+        "number of master weights does not match the network!");
+  }
+
+  for (size_t i = 0; i < parameters.n_elem; ++i)
+    networkParameters[i] = (ElemType) parameters[i];
+}
+
+} // namespace mlpack
+
+#endif
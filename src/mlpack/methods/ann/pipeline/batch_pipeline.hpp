@@ -0,0 +1,150 @@
+/**
+ * @file methods/ann/pipeline/batch_pipeline.hpp
+ *
+ * Definition of the BatchPipeline class, which assembles batches of training
+ * points from a loader in a background thread while the current batch is used.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_PIPELINE_BATCH_PIPELINE_HPP
+#define MLPACK_METHODS_ANN_PIPELINE_BATCH_PIPELINE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <future>
+
+namespace mlpack {
+
+/**
+ * BatchPipeline gives batches of training points to a network that may be too
+ * large to hold in memory, or that is expensive to load (for instance because
+ * the points are images that must be read and decoded).  After each batch is
+ * given out, the batch that will most likely be asked for next (the following
+ * points in the current order, or the first points of the next epoch) is
+ * loaded in a background thread, so that loading overlaps with training.
+ *
+ * Two buffers are used: one holds the batch that was last given out, and the
+ * other one is filled by the background thread.  If a batch other than the
+ * prefetched one is asked for, it is loaded in the calling thread.
+ *
+ * The points themselves are loaded by the `LoaderType`, which must implement
+ * the following functions:
+ *
+ * @code
+ * // Return the number of points in the dataset.
+ * size_t NumPoints() const;
+ *
+ * // Load the points with the given indices into the columns of `predictors`
+ * // and `responses`, in the order of the indices.
+ * void Load(const arma::uvec& indices, MatType& predictors,
+ *           MatType& responses);
+ * @endcode
+ *
+ * `Load()` is called from the background thread, but never by two threads at
+ * once.  See `MatrixLoader` and `ImageLoader` for examples.
+ *
+ * A BatchPipeline is usually passed to `FFN::TrainPipeline()`.
+ *
+ * @tparam LoaderType Type of the loader of the training points.
+ * @tparam MatType Type of the matrices of the batches.
+ */
+template<typename LoaderType, typename MatType = arma::mat>
+class BatchPipeline
+{
+ public:
+  /**
+   * Create the BatchPipeline for the given loader.  The points are initially
+   * visited in order.
+   *
+   * @param loader Loader of the training points.
+   */
+  BatchPipeline(LoaderType loader);
+
+  //! The background thread refers to the pipeline, so it cannot be copied.
+  BatchPipeline(const BatchPipeline&) = delete;
+  //! The background thread refers to the pipeline, so it cannot be copied.
+  BatchPipeline& operator=(const BatchPipeline&) = delete;
+
+  //! Wait for the background thread to finish.
+  ~BatchPipeline();
+
+  /**
+   * Make `predictors` and `responses` aliases of the batch of `batchSize`
+   * points starting at position `begin` of the current order, and start
+   * loading the next batch in the background.  The aliases are valid until
+   * the next call to `Batch()` or `Shuffle()`.
+   *
+   * @param begin Position of the first point of the batch in the order.
+   * @param batchSize Number of points in the batch.
+   * @param predictors Alias to set to the predictors of the batch.
+   * @param responses Alias to set to the responses of the batch.
+   */
+  void Batch(const size_t begin,
+             const size_t batchSize,
+             MatType& predictors,
+             MatType& responses);
+
+  /**
+   * Visit the points in a new random order.  The first batch of the new
+   * order (with the size of the last batch) is loaded in the background.
+   */
+  void Shuffle();
+
+  //! Get the number of points in the dataset.
+  size_t NumPoints() const { return loader.NumPoints(); }
+
+  //! Get the order in which the points are visited.
+  const arma::uvec& Order() const { return order; }
+
+  //! Get the loader.
+  const LoaderType& Loader() const { return loader; }
+  //! Modify the loader.  Do not modify it while a batch is being loaded.
+  LoaderType& Loader() { return loader; }
+
+ private:
+  //! Load the batch starting at position `begin` into the given buffer.
+  void Load(const size_t buffer, const size_t begin, const size_t batchSize);
+
+  //! Start loading the given batch in the background, in the buffer that is
+  //! not in use.
+  void Prefetch(const size_t begin, const size_t batchSize);
+
+  //! Wait for the background thread to finish; if `rethrow` is true and it
+  //! failed, rethrow its exception.
+  void Wait(const bool rethrow);
+
+  //! The loader of the training points.
+  LoaderType loader;
+
+  //! The order in which the points are visited.
+  arma::uvec order;
+
+  //! The two buffers of predictors.
+  MatType predictorsBuffers[2];
+
+  //! The two buffers of responses.
+  MatType responsesBuffers[2];
+
+  //! The buffer holding the batch that was last given out.
+  size_t current;
+
+  //! The position of the first point of the prefetched batch.
+  size_t prefetchBegin;
+
+  //! The number of points of the prefetched batch (0 if nothing is
+  //! prefetched).
+  size_t prefetchSize;
+
+  //! The result of the background thread.
+  std::future<void> pending;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "batch_pipeline_impl.hpp"
+
+#endif
@@ -0,0 +1,135 @@
+/**
+ * @file methods/ann/pipeline/batch_pipeline_impl.hpp
+ *
+ * Implementation of the BatchPipeline class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_PIPELINE_BATCH_PIPELINE_IMPL_HPP
+#define MLPACK_METHODS_ANN_PIPELINE_BATCH_PIPELINE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "batch_pipeline.hpp"
+
+namespace mlpack {
+
+template<typename LoaderType, typename MatType>
+BatchPipeline<LoaderType, MatType>::BatchPipeline(LoaderType loader) :
+    loader(std::move(loader)),
+    current(0),
+    prefetchBegin(0),
+    prefetchSize(0)
+{
+  const size_t numPoints = this->loader.NumPoints();
+  if (numPoints > 0)
+    order = arma::regspace<arma::uvec>(0, numPoints - 1);
+}
+
+template<typename LoaderType, typename MatType>
+BatchPipeline<LoaderType, MatType>::~BatchPipeline()
+{
+  // Errors of the last prefetched batch are not reported, since it will not
+  // be used.
+  if (pending.valid())
+    pending.wait();
+}
+
+template<typename LoaderType, typename MatType>
+void BatchPipeline<LoaderType, MatType>::Batch(const size_t begin,
+                                               const size_t batchSize,
+                                               MatType& predictors,
+                                               MatType& responses)
+{
+  if (batchSize == 0 || begin + batchSize > order.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "BatchPipeline::Batch(): batch of " << batchSize << " points "
+        << "starting at " << begin << " is out of range for a dataset of "
+        << order.n_elem << " points!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // The batch that was given out last is no longer in use, so its buffer can
+  // be refilled.
+  const bool prefetched = (prefetchSize == batchSize &&
+      prefetchBegin == begin);
+  Wait(prefetched);
+  current = 1 - current;
+  if (!prefetched)
+    Load(current, begin, batchSize);
+
+  // The aliases are not strict, so that they can be moved into other matrices
+  // (like the training data of a network) without copying the batch.
+  MakeAlias(predictors, predictorsBuffers[current],
+      predictorsBuffers[current].n_rows, predictorsBuffers[current].n_cols, 0,
+      false);
+  MakeAlias(responses, responsesBuffers[current],
+      responsesBuffers[current].n_rows, responsesBuffers[current].n_cols, 0,
+      false);
+
+  // The optimizer will most likely ask for the following points next, or for
+  // the first points of the next epoch.
+  const size_t nextBegin = (begin + batchSize < order.n_elem) ?
+      begin + batchSize : 0;
+  Prefetch(nextBegin, std::min(batchSize, order.n_elem - nextBegin));
+}
+
+template<typename LoaderType, typename MatType>
+void BatchPipeline<LoaderType, MatType>::Shuffle()
+{
+  const size_t batchSize = prefetchSize;
+  Wait(false);
+
+  order = arma::shuffle(order);
+
+  if (batchSize > 0)
+    Prefetch(0, std::min(batchSize, order.n_elem));
+}
+
+template<typename LoaderType, typename MatType>
+void BatchPipeline<LoaderType, MatType>::Load(const size_t buffer,
+                                              const size_t begin,
+                                              const size_t batchSize)
+{
+  const arma::uvec indices = order.subvec(begin, begin + batchSize - 1);
+  loader.Load(indices, predictorsBuffers[buffer], responsesBuffers[buffer]);
+}
+
+template<typename LoaderType, typename MatType>
+void BatchPipeline<LoaderType, MatType>::Prefetch(const size_t begin,
+                                                  const size_t batchSize)
+{
+  prefetchBegin = begin;
+  prefetchSize = batchSize;
+  pending = std::async(std::launch::async, &BatchPipeline::Load, this,
+      1 - current, begin, batchSize);
+}
+
+template<typename LoaderType, typename MatType>
+void BatchPipeline<LoaderType, MatType>::Wait(const bool rethrow)
+{
+  prefetchSize = 0;
+  if (!pending.valid())
+    return;
+
+  if (rethrow)
+  {
+    pending.get();
+  }
+  else
+  {
+    // The prefetched batch is discarded, so its errors do not matter.
+    try
+    {
+      pending.get();
+    }
+    catch (...) { }
+  }
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * @file methods/ann/pipeline/image_loader.hpp
+ *
+ * Definition of the ImageLoader class, a BatchPipeline loader that reads and
+ * decodes the images of each batch from disk.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_PIPELINE_IMAGE_LOADER_HPP
+#define MLPACK_METHODS_ANN_PIPELINE_IMAGE_LOADER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "image_transforms.hpp"
+
+namespace mlpack {
+
+/**
+ * ImageLoader is a loader for BatchPipeline that reads the images of each
+ * batch from their files with `data::Load()`, so that only the images of the
+ * batches being used are held in memory.  After the images of a batch are
+ * decoded, they are passed to the `TransformType`, which can normalize or
+ * augment them; it must implement
+ *
+ * @code
+ * void Transform(MatType& images, const data::ImageInfo& info);
+ * @endcode
+ *
+ * All the images must have the dimensions of the given `data::ImageInfo`.
+ * The responses (for instance, the labels) are held in memory.
+ *
+ * @tparam MatType Type of the matrices of the batches.
+ * @tparam TransformType Transform applied to each batch of images.
+ */
+template<typename MatType = arma::mat,
+         typename TransformType = ScaleImageTransform>
+class ImageLoader
+{
+ public:
+  /**
+   * Create the ImageLoader for the given images.
+   *
+   * @param files Files of the images.
+   * @param responses Responses of the images, one per column.
+   * @param info Dimensions of the images.
+   * @param transform Transform to apply to each batch of images.
+   */
+  ImageLoader(std::vector<std::string> files,
+              MatType responses,
+              const data::ImageInfo& info,
+              TransformType transform = TransformType());
+
+  //! Get the number of images.
+  size_t NumPoints() const { return files.size(); }
+
+  /**
+   * Read, decode and transform the images with the given indices into
+   * `predictors`, and copy their responses into `responsesBatch`.  A
+   * std::runtime_error is thrown if an image cannot be loaded.
+   */
+  void Load(const arma::uvec& indices,
+            MatType& predictors,
+            MatType& responsesBatch);
+
+  //! Get the files of the images.
+  const std::vector<std::string>& Files() const { return files; }
+  //! Get the responses of the images.
+  const MatType& Responses() const { return responses; }
+  //! Get the dimensions of the images.
+  const data::ImageInfo& Info() const { return info; }
+
+  //! Get the transform.
+  const TransformType& Transform() const { return transform; }
+  //! Modify the transform.
+  TransformType& Transform() { return transform; }
+
+ private:
+  //! The files of the images.
+  std::vector<std::string> files;
+
+  //! The responses of the images.
+  MatType responses;
+
+  //! The dimensions of the images.
+  data::ImageInfo info;
+
+  //! The transform applied to each batch.
+  TransformType transform;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "image_loader_impl.hpp"
+
+#endif
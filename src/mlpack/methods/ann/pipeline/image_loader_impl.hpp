@@ -0,0 +1,67 @@
+/**
+ * @file methods/ann/pipeline/image_loader_impl.hpp
+ *
+ * Implementation of the ImageLoader class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_PIPELINE_IMAGE_LOADER_IMPL_HPP
+#define MLPACK_METHODS_ANN_PIPELINE_IMAGE_LOADER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "image_loader.hpp"
+
+namespace mlpack {
+
+template<typename MatType, typename TransformType>
+ImageLoader<MatType, TransformType>::ImageLoader(
+    std::vector<std::string> files,
+    MatType responses,
+    const data::ImageInfo& info,
+    TransformType transform) :
+    files(std::move(files)),
+    responses(std::move(responses)),
+    info(info),
+    transform(std::move(transform))
+{
+  if (this->files.size() != this->responses.n_cols)
+  {
+    throw std::invalid_argument("ImageLoader: number of files does not match "
+        "the number of responses!");
+  }
+}
+
+template<typename MatType, typename TransformType>
+void ImageLoader<MatType, TransformType>::Load(const arma::uvec& indices,
+                                               MatType& predictors,
+                                               MatType& responsesBatch)
+{
+  std::vector<std::string> batchFiles(indices.n_elem);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+    batchFiles[i] = files[indices[i]];
+
+  data::ImageInfo batchInfo(info);
+  if (!data::Load(batchFiles, predictors, batchInfo, false))
+  {
+    throw std::runtime_error("ImageLoader::Load(): could not load the images "
+        "of the batch!");
+  }
+
+  if (batchInfo.Width() != info.Width() ||
+      batchInfo.Height() != info.Height() ||
+      batchInfo.Channels() != info.Channels())
+  {
+    throw std::runtime_error("ImageLoader::Load(): dimensions of the images "
+        "do not match the given image information!");
+  }
+
+  transform.Transform(predictors, batchInfo);
+  responsesBatch = responses.cols(indices);
+}
+
+} // namespace mlpack
+
+#endif
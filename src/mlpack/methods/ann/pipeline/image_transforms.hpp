@@ -0,0 +1,85 @@
+/**
+ * @file methods/ann/pipeline/image_transforms.hpp
+ *
+ * Transforms that ImageLoader can apply to each batch of images it loads.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_PIPELINE_IMAGE_TRANSFORMS_HPP
+#define MLPACK_METHODS_ANN_PIPELINE_IMAGE_TRANSFORMS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Transform that scales the pixels of the images from [0, 255] to [0, 1].
+ */
+class ScaleImageTransform
+{
+ public:
+  /**
+   * Scale the pixels of the given batch of images.
+   *
+   * @param images Images, one per column.
+   * @param info Dimensions of the images.
+   */
+  template<typename MatType>
+  void Transform(MatType& images, const data::ImageInfo& /* info */) const
+  {
+    images /= 255;
+  }
+};
+
+/**
+ * Data augmentation transform that flips each image horizontally with
+ * probability 0.5, then scales its pixels to [0, 1] like ScaleImageTransform.
+ * The images are stored as loaded by `data::Load()`: the channels of each
+ * pixel are interleaved, and the pixels are stored row by row.
+ *
+ * The random numbers come from `Random()`, which has a separate generator for
+ * each thread; so the flips do not depend on the seed of the main thread.
+ */
+class RandomFlipImageTransform
+{
+ public:
+  /**
+   * Flip some of the images of the given batch, and scale their pixels.
+   *
+   * @param images Images, one per column.
+   * @param info Dimensions of the images.
+   */
+  template<typename MatType>
+  void Transform(MatType& images, const data::ImageInfo& info) const
+  {
+    const size_t width = info.Width();
+    const size_t height = info.Height();
+    const size_t channels = info.Channels();
+
+    for (size_t i = 0; i < images.n_cols; ++i)
+    {
+      if (Random() < 0.5)
+        continue;
+
+      for (size_t y = 0; y < height; ++y)
+      {
+        for (size_t x = 0; x < width / 2; ++x)
+        {
+          const size_t left = (y * width + x) * channels;
+          const size_t right = (y * width + width - 1 - x) * channels;
+          for (size_t c = 0; c < channels; ++c)
+            std::swap(images(left + c, i), images(right + c, i));
+        }
+      }
+    }
+
+    images /= 255;
+  }
+};
+
+} // namespace mlpack
+
+#endif
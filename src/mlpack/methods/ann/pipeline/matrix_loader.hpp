@@ -0,0 +1,77 @@
+/**
+ * @file methods/ann/pipeline/matrix_loader.hpp
+ *
+ * Definition of the MatrixLoader class, a BatchPipeline loader for a dataset
+ * held in memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_PIPELINE_MATRIX_LOADER_HPP
+#define MLPACK_METHODS_ANN_PIPELINE_MATRIX_LOADER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * MatrixLoader is a loader for BatchPipeline that copies the points of each
+ * batch out of matrices held in memory.  Unlike `FFN::Shuffle()`, shuffling
+ * the pipeline does not permute copies of the whole dataset.
+ *
+ * @tparam MatType Type of the matrices of the dataset.
+ */
+template<typename MatType = arma::mat>
+class MatrixLoader
+{
+ public:
+  /**
+   * Create the MatrixLoader for the given dataset.
+   *
+   * @param predictors Input points, one per column.
+   * @param responses Responses of the points, one per column.
+   */
+  MatrixLoader(MatType predictors, MatType responses) :
+      predictors(std::move(predictors)),
+      responses(std::move(responses))
+  {
+    if (this->predictors.n_cols != this->responses.n_cols)
+    {
+      throw std::invalid_argument("MatrixLoader: number of predictors does "
+          "not match the number of responses!");
+    }
+  }
+
+  //! Get the number of points in the dataset.
+  size_t NumPoints() const { return predictors.n_cols; }
+
+  /**
+   * Copy the points with the given indices into `predictorsBatch` and
+   * `responsesBatch`.
+   */
+  void Load(const arma::uvec& indices,
+            MatType& predictorsBatch,
+            MatType& responsesBatch) const
+  {
+    predictorsBatch = predictors.cols(indices);
+    responsesBatch = responses.cols(indices);
+  }
+
+  //! Get the input points.
+  const MatType& Predictors() const { return predictors; }
+  //! Get the responses.
+  const MatType& Responses() const { return responses; }
+
+ private:
+  //! The input points.
+  MatType predictors;
+
+  //! The responses of the points.
+  MatType responses;
+};
+
+} // namespace mlpack
+
+#endif
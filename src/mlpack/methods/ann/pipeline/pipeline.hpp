@@ -0,0 +1,21 @@
+/**
+ * @file methods/ann/pipeline/pipeline.hpp
+ *
+ * Convenience include for the batch pipelines of the neural network toolkit
+ * in mlpack.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_PIPELINE_PIPELINE_HPP
+#define MLPACK_METHODS_ANN_PIPELINE_PIPELINE_HPP
+
+#include "batch_pipeline.hpp"
+#include "image_loader.hpp"
+#include "image_transforms.hpp"
+#include "matrix_loader.hpp"
+#include "pipeline_function.hpp"
+
+#endif
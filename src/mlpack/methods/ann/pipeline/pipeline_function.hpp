@@ -0,0 +1,119 @@
+/**
+ * @file methods/ann/pipeline/pipeline_function.hpp
+ *
+ * Definition of the PipelineFunction class, which lets an ensmallen optimizer
+ * train a network on batches given by a BatchPipeline.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_PIPELINE_PIPELINE_FUNCTION_HPP
+#define MLPACK_METHODS_ANN_PIPELINE_PIPELINE_FUNCTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * PipelineFunction wraps a network (like `FFN`) and a pipeline (like
+ * `BatchPipeline`) into a separable function for ensmallen's optimizers: for
+ * each batch that the optimizer asks for, the batch is taken from the
+ * pipeline and set as the training data of the network, which then computes
+ * the objective and the gradient.  Shuffling shuffles the order of the
+ * pipeline, so the dataset is never copied or held in memory as a whole.
+ *
+ * Only the separable functions are implemented, so the optimizer must be a
+ * batch optimizer like ens::SGD or ens::Adam.  `FFN::TrainPipeline()` does all
+ * of this.
+ *
+ * @tparam NetworkType Type of the network to train.
+ * @tparam PipelineType Type of the pipeline giving the batches.
+ */
+template<typename NetworkType, typename PipelineType>
+class PipelineFunction
+{
+ public:
+  //! Matrix type of the network.
+  typedef typename std::remove_const<typename std::remove_reference<
+      decltype(std::declval<NetworkType&>().Parameters())>::type>::type
+      MatType;
+
+  /**
+   * Create the PipelineFunction for the given network and pipeline.
+   *
+   * @param network Network to train.
+   * @param pipeline Pipeline giving the batches of training points.
+   */
+  PipelineFunction(NetworkType& network, PipelineType& pipeline) :
+      network(network),
+      pipeline(pipeline)
+  {
+    // Nothing to do here.
+  }
+
+  /**
+   * Evaluate the objective of the network on the batch of training points
+   * starting at position `begin` of the order of the pipeline.
+   *
+   * @param parameters Parameters of the network.
+   * @param begin Position of the first point of the batch.
+   * @param batchSize Number of points in the batch.
+   */
+  typename MatType::elem_type Evaluate(const MatType& parameters,
+                                       const size_t begin,
+                                       const size_t batchSize);
+
+  /**
+   * Evaluate the objective and the gradient of the network on the batch of
+   * training points starting at position `begin` of the order of the
+   * pipeline.
+   *
+   * @param parameters Parameters of the network.
+   * @param begin Position of the first point of the batch.
+   * @param gradient Matrix to store the gradient into.
+   * @param batchSize Number of points in the batch.
+   */
+  typename MatType::elem_type EvaluateWithGradient(const MatType& parameters,
+                                                   const size_t begin,
+                                                   MatType& gradient,
+                                                   const size_t batchSize);
+
+  /**
+   * Compute the gradient of the network on the batch of training points
+   * starting at position `begin` of the order of the pipeline.
+   *
+   * @param parameters Parameters of the network.
+   * @param begin Position of the first point of the batch.
+   * @param gradient Matrix to store the gradient into.
+   * @param batchSize Number of points in the batch.
+   */
+  void Gradient(const MatType& parameters,
+                const size_t begin,
+                MatType& gradient,
+                const size_t batchSize);
+
+  //! Return the number of training points.
+  size_t NumFunctions() const { return pipeline.NumPoints(); }
+
+  //! Shuffle the order of the training points.
+  void Shuffle() { pipeline.Shuffle(); }
+
+ private:
+  //! Take the given batch from the pipeline and give it to the network.
+  void SetBatch(const size_t begin, const size_t batchSize);
+
+  //! The network to train.
+  NetworkType& network;
+
+  //! The pipeline giving the batches.
+  PipelineType& pipeline;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "pipeline_function_impl.hpp"
+
+#endif
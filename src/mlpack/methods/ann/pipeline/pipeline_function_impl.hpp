@@ -0,0 +1,68 @@
+/**
+ * @file methods/ann/pipeline/pipeline_function_impl.hpp
+ *
+ * Implementation of the PipelineFunction class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_PIPELINE_PIPELINE_FUNCTION_IMPL_HPP
+#define MLPACK_METHODS_ANN_PIPELINE_PIPELINE_FUNCTION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "pipeline_function.hpp"
+
+namespace mlpack {
+
+template<typename NetworkType, typename PipelineType>
+typename PipelineFunction<NetworkType, PipelineType>::MatType::elem_type
+PipelineFunction<NetworkType, PipelineType>::Evaluate(
+    const MatType& parameters,
+    const size_t begin,
+    const size_t batchSize)
+{
+  SetBatch(begin, batchSize);
+  return network.Evaluate(parameters, 0, batchSize);
+}
+
+template<typename NetworkType, typename PipelineType>
+typename PipelineFunction<NetworkType, PipelineType>::MatType::elem_type
+PipelineFunction<NetworkType, PipelineType>::EvaluateWithGradient(
+    const MatType& parameters,
+    const size_t begin,
+    MatType& gradient,
+    const size_t batchSize)
+{
+  SetBatch(begin, batchSize);
+  return network.EvaluateWithGradient(parameters, 0, gradient, batchSize);
+}
+
+template<typename NetworkType, typename PipelineType>
+void PipelineFunction<NetworkType, PipelineType>::Gradient(
+    const MatType& parameters,
+    const size_t begin,
+    MatType& gradient,
+    const size_t batchSize)
+{
+  SetBatch(begin, batchSize);
+  network.Gradient(parameters, 0, gradient, batchSize);
+}
+
+template<typename NetworkType, typename PipelineType>
+void PipelineFunction<NetworkType, PipelineType>::SetBatch(
+    const size_t begin,
+    const size_t batchSize)
+{
+  MatType predictors, responses;
+  pipeline.Batch(begin, batchSize, predictors, responses);
+
+  // Moving the aliases keeps them as aliases, so the batch is not copied
+  // into the network.
+  network.ResetData(std::move(predictors), std::move(responses));
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,102 @@
+/**
+ * @file methods/ann/pruning/prune.hpp
+ *
+ * Functions for the magnitude pruning of weight matrices, by single weights or
+ * by blocks of weights, used to create block-sparse layers for inference.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_PRUNING_PRUNE_HPP
+#define MLPACK_METHODS_ANN_PRUNING_PRUNE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Split the given weight matrix into blocks of `blockRows` x `blockCols`
+ * weights (the blocks of the last rows and columns may be smaller), and set
+ * the weights of the `floor(sparsity * n)` blocks with the smallest mean
+ * squared weight to zero, where `n` is the number of blocks.  With 1x1 blocks,
+ * this is plain magnitude pruning of the individual weights; larger blocks
+ * give structured sparsity that can be used efficiently by
+ * BlockSparseLinear.
+ *
+ * A std::invalid_argument is thrown if `sparsity` is not in [0, 1] or if a
+ * block size is zero.
+ *
+ * @param weight Weight matrix to prune.
+ * @param sparsity Fraction of the blocks to set to zero.
+ * @param blockRows Number of rows of each block.
+ * @param blockCols Number of columns of each block.
+ * @return The number of blocks that were set to zero.
+ */
+template<typename MatType>
+size_t PruneBlocks(MatType& weight,
+                   const double sparsity,
+                   const size_t blockRows = 1,
+                   const size_t blockCols = 1)
+{
+  if (sparsity < 0.0 || sparsity > 1.0)
+  {
+    std::ostringstream oss;
+    oss << "PruneBlocks(): sparsity must be in [0, 1] (given " << sparsity
+        << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (blockRows == 0 || blockCols == 0)
+  {
+    throw std::invalid_argument("PruneBlocks(): the size of the blocks must "
+        "be positive!");
+  }
+
+  const size_t numBlockRows = (weight.n_rows + blockRows - 1) / blockRows;
+  const size_t numBlockCols = (weight.n_cols + blockCols - 1) / blockCols;
+  const size_t pruned = (size_t) std::floor(sparsity * numBlockRows *
+      numBlockCols);
+  if (pruned == 0)
+    return 0;
+
+  // The mean squared weight of each block, in column-major order of the
+  // blocks.  The mean is used so that the smaller blocks at the edges are not
+  // pruned first.
+  arma::vec magnitude(numBlockRows * numBlockCols);
+  #pragma omp parallel for
+  for (size_t bc = 0; bc < numBlockCols; ++bc)
+  {
+    const size_t firstCol = bc * blockCols;
+    const size_t lastCol = std::min(firstCol + blockCols, (size_t)
+        weight.n_cols) - 1;
+    for (size_t br = 0; br < numBlockRows; ++br)
+    {
+      const size_t firstRow = br * blockRows;
+      const size_t lastRow = std::min(firstRow + blockRows, (size_t)
+          weight.n_rows) - 1;
+      magnitude[br + bc * numBlockRows] = (double) arma::accu(arma::square(
+          weight.submat(firstRow, firstCol, lastRow, lastCol))) /
+          ((lastRow - firstRow + 1) * (lastCol - firstCol + 1));
+    }
+  }
+
+  const arma::uvec order = arma::stable_sort_index(magnitude);
+  for (size_t i = 0; i < pruned; ++i)
+  {
+    const size_t br = order[i] % numBlockRows;
+    const size_t bc = order[i] / numBlockRows;
+    const size_t firstRow = br * blockRows;
+    const size_t firstCol = bc * blockCols;
+    weight.submat(firstRow, firstCol,
+        std::min(firstRow + blockRows, (size_t) weight.n_rows) - 1,
+        std::min(firstCol + blockCols, (size_t) weight.n_cols) - 1).zeros();
+  }
+
+  return pruned;
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,151 @@
+/**
+ * @file methods/ann/quantization/quantize.hpp
+ *
+ * Functions for the symmetric 8-bit quantization of matrices and for the
+ * products of quantized matrices, used by the quantized layers for inference.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_QUANTIZATION_QUANTIZE_HPP
+#define MLPACK_METHODS_ANN_QUANTIZATION_QUANTIZE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <cstdint>
+
+namespace mlpack {
+
+/**
+ * Return the scale that maps values in [-range, range] onto the 8-bit integers
+ * in [-127, 127]; that is, x is represented by round(x / scale).  If `range`
+ * is zero, 1 is returned.
+ *
+ * @param range Largest absolute value to represent.
+ */
+inline double QuantizationScale(const double range)
+{
+  return (range > 0.0) ? range / 127.0 : 1.0;
+}
+
+/**
+ * Quantize the elements of the given matrix with the given scale, in
+ * column-major order; values outside of the range of the scale are clamped to
+ * [-127, 127].
+ *
+ * @param input Matrix to quantize.
+ * @param scale Scale of the quantization (see QuantizationScale()).
+ * @param output Vector to store the quantized elements into.
+ */
+template<typename MatType>
+void Quantize(const MatType& input,
+              const double scale,
+              std::vector<std::int8_t>& output)
+{
+  output.resize(input.n_elem);
+  const double invScale = 1.0 / scale;
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) input.n_elem; ++i)
+  {
+    const double q = std::round(input[i] * invScale);
+    output[i] = (std::int8_t) std::min(std::max(q, -127.0), 127.0);
+  }
+}
+
+/**
+ * Quantize each column of the given matrix with its own scale, chosen so that
+ * the largest absolute value of the column is represented by 127 (see
+ * QuantizationScale()).  This is used for the per-channel quantization of
+ * weights: each column holds the weights of one output.
+ *
+ * @param input Matrix to quantize.
+ * @param output Vector to store the quantized elements into, in column-major
+ *     order.
+ * @param scales Column vector to store the scale of each column into.
+ */
+template<typename MatType>
+void QuantizeColumns(const MatType& input,
+                     std::vector<std::int8_t>& output,
+                     MatType& scales)
+{
+  output.resize(input.n_elem);
+  scales.set_size(input.n_cols, 1);
+
+  #pragma omp parallel for
+  for (size_t j = 0; j < (size_t) input.n_cols; ++j)
+  {
+    const double scale = QuantizationScale(
+        (double) arma::max(arma::abs(input.col(j))));
+    scales[j] = scale;
+    for (size_t i = 0; i < input.n_rows; ++i)
+    {
+      const double q = std::round(input(i, j) / scale);
+      output[i + j * input.n_rows] =
+          (std::int8_t) std::min(std::max(q, -127.0), 127.0);
+    }
+  }
+}
+
+/**
+ * Compute the dot product of two vectors of 8-bit integers; the products are
+ * accumulated into a 32-bit integer.  The loop is simple enough for compilers
+ * to vectorize it.
+ */
+inline std::int32_t QuantizedDot(const std::int8_t* a,
+                                 const std::int8_t* b,
+                                 const size_t n)
+{
+  std::int32_t sum = 0;
+  for (size_t i = 0; i < n; ++i)
+    sum += (std::int32_t) a[i] * (std::int32_t) b[i];
+
+  return sum;
+}
+
+/**
+ * Compute the products of the quantized vectors of length `n` held one after
+ * another in `a` and `b`, so that `output(i, j)` is the dot product of the
+ * i'th vector of `a` and the j'th vector of `b`.  The output is split into
+ * blocks that are computed in parallel.
+ *
+ * @param a First set of quantized vectors (output.n_rows vectors).
+ * @param b Second set of quantized vectors (output.n_cols vectors).
+ * @param n Length of each vector.
+ * @param output Matrix to store the products into; this must already have the
+ *     right size.
+ */
+template<typename MatType>
+void QuantizedProduct(const std::int8_t* a,
+                      const std::int8_t* b,
+                      const size_t n,
+                      MatType& output)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  // The number of vectors on each side of a block.
+  const size_t blockSize = 64;
+  const size_t rowBlocks = (output.n_rows + blockSize - 1) / blockSize;
+  const size_t colBlocks = (output.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < rowBlocks * colBlocks; ++block)
+  {
+    const size_t rowBegin = (block % rowBlocks) * blockSize;
+    const size_t rowEnd = std::min(rowBegin + blockSize,
+        (size_t) output.n_rows);
+    const size_t colBegin = (block / rowBlocks) * blockSize;
+    const size_t colEnd = std::min(colBegin + blockSize,
+        (size_t) output.n_cols);
+
+    for (size_t j = colBegin; j < colEnd; ++j)
+      for (size_t i = rowBegin; i < rowEnd; ++i)
+        output(i, j) = (ElemType) QuantizedDot(a + i * n, b + j * n, n);
+  }
+}
+
+} // namespace mlpack
+
+#endif
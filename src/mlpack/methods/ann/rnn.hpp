@@ -27,6 +27,12 @@ namespace mlpack {
  * each column is a data point, the `RNN` takes a cube format where each column
  * is a data point and each slice is a time step.
  *
+ * Sequences of different lengths can be given in a packed form, with the
+ * length of each sequence (see the overloads of `Train()` and `Predict()` that
+ * take `sequenceLengths`).  The batches are then sorted by decreasing length,
+ * and at each time step only the sequences that have not ended are passed
+ * through the network, so no computation is spent on padding.
+ *
  * @tparam OutputLayerType The output layer type used to evaluate the network.
  * @tparam InitializationRuleType Rule used to initialize the weight matrix.
  */
@@ -160,6 +166,41 @@ class RNN
       arma::Cube<typename MatType::elem_type> responses,
       CallbackTypes&&... callbacks);
 
+  /**
+   * Train the recurrent network on sequences of different lengths, using the
+   * given optimizer.  Sequence `i` is column `i` of `predictors` (and
+   * `responses`), and only its first `sequenceLengths[i]` time steps are used;
+   * the other slices are padding, and are never passed through the network or
+   * compared to the responses.  If the network is `single`, each sequence is
+   * compared to its response at every one of its steps, as for sequences of
+   * equal length.
+   *
+   * The sequences of each batch are sorted by decreasing length when the batch
+   * is used, so that the sequences still active at a time step are the first
+   * ones; the recurrent layers then only process that prefix of the batch.
+   * Sorting the whole dataset by length beforehand (and using an optimizer
+   * that does not shuffle) avoids the reordering.
+   *
+   * A std::invalid_argument is thrown if `sequenceLengths` does not have one
+   * length in [1, predictors.n_slices] for each sequence.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors Input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param sequenceLengths Number of time steps of each sequence.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   * @return The final objective of the trained model (NaN or Inf on error).
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  typename MatType::elem_type Train(
+      arma::Cube<typename MatType::elem_type> predictors,
+      arma::Cube<typename MatType::elem_type> responses,
+      arma::urowvec sequenceLengths,
+      OptimizerType& optimizer,
+      CallbackTypes&&... callbacks);
+
   /**
    * Predict the responses to a given set of predictors. The responses will
    * reflect the output of the given output layer as returned by the
@@ -173,6 +214,23 @@ class RNN
                arma::Cube<typename MatType::elem_type>& results,
                const size_t batchSize = 128);
 
+  /**
+   * Predict the responses to sequences of different lengths (see the overload
+   * of `Train()` that takes `sequenceLengths`).  The sequences are processed
+   * in batches of similar lengths, and at each time step only the sequences
+   * that have not ended are passed through the network.  The results of the
+   * time steps after the end of a sequence are zero.
+   *
+   * @param predictors Input predictors.
+   * @param results Matrix to put output predictions of responses into.
+   * @param sequenceLengths Number of time steps of each sequence.
+   * @param batchSize Batch size to use for prediction.
+   */
+  void Predict(const arma::Cube<typename MatType::elem_type>& predictors,
+               arma::Cube<typename MatType::elem_type>& results,
+               const arma::urowvec& sequenceLengths,
+               const size_t batchSize = 128);
+
   // Return the nujmber of weights in the model.
   size_t WeightSize() { return network.WeightSize(); }
 
@@ -202,11 +260,38 @@ class RNN
   //! Modify the initial point for the optimization.
   MatType& Parameters() { return network.Parameters(); }
 
+  //! Get the profiler that times each layer of the network over all the time
+  //! steps, or nullptr if the network is not profiled.  See LayerProfiler.
+  LayerProfiler* Profiler() const { return network.Profiler(); }
+  //! Modify the profiler of the network; set it to nullptr to stop profiling.
+  LayerProfiler*& Profiler() { return network.Profiler(); }
+
   //! Return the number of steps allowed for BPTT.
   size_t BPTTSteps() const { return bpttSteps; }
   //! Modify the number of steps allowed for BPTT.
   size_t& BPTTSteps() { return bpttSteps; }
 
+  /**
+   * Get whether gradient checkpointing is used for BPTT.  Without
+   * checkpointing, the recurrent layers hold the state of each of the BPTT
+   * steps until the backward pass, so their memory grows linearly with the
+   * number of steps.  With checkpointing, the T BPTT steps are split into
+   * segments of about sqrt(T) steps, and only the state of the last step of
+   * each segment (plus the states of two segments) is held; during the
+   * backward pass, the forward pass of each segment is recomputed from the
+   * checkpoint before it.  The forward pass of each step is also repeated just
+   * before its backward pass, so that the non-recurrent layers see the
+   * activations of that step.
+   *
+   * This needs about 2 sqrt(T) states instead of T, at the cost of up to two
+   * more forward passes of each step; it is only used when it saves memory.
+   * Layers that are random in training mode (like Dropout) will not give the
+   * same output when a step is recomputed.  The default is false.
+   */
+  bool Checkpointing() const { return checkpointing; }
+  //! Modify whether gradient checkpointing is used for BPTT.
+  bool& Checkpointing() { return checkpointing; }
+
   /**
    * Reset the stored data of the network entirely.  This reset all weights of
    * each layer using `InitializationRuleType`, and prepares the network to
@@ -341,6 +426,18 @@ class RNN
   void ResetData(arma::Cube<typename MatType::elem_type> predictors,
                  arma::Cube<typename MatType::elem_type> responses);
 
+  /**
+   * Prepare the network for the given sequences of different lengths (see the
+   * overload of `Train()` that takes `sequenceLengths`).
+   *
+   * @param predictors Input data variables.
+   * @param responses Outputs results from input data variables.
+   * @param sequenceLengths Number of time steps of each sequence.
+   */
+  void ResetData(arma::Cube<typename MatType::elem_type> predictors,
+                 arma::Cube<typename MatType::elem_type> responses,
+                 arma::urowvec sequenceLengths);
+
  private:
   // Helper functions.
 
@@ -356,11 +453,67 @@ class RNN
   //! Set the current step index of all recurrent layers to `step`.
   void SetCurrentStep(const size_t step);
 
+  /**
+   * Compute the objective and the gradient of the given batch like
+   * EvaluateWithGradient(), but with gradient checkpointing over the last
+   * `steps` time steps (see `Checkpointing()`).
+   */
+  template<typename GradType>
+  typename MatType::elem_type CheckpointedEvaluateWithGradient(
+      const size_t begin,
+      GradType& gradient,
+      const size_t batchSize,
+      const size_t steps);
+
+  //! Pass the batch of time step `t` starting at point `begin` (only its
+  //! sequences that are still active) forward through the network.
+  void ForwardStep(const size_t t,
+                   const size_t begin,
+                   const size_t batchSize,
+                   MatType& output);
+
+  //! Return the number of steps in each checkpointing segment, for `steps`
+  //! BPTT steps.
+  static size_t SegmentLength(const size_t steps);
+
+  //! Return the number of recurrent states that checkpointing holds for
+  //! `steps` BPTT steps.
+  static size_t CheckpointSlots(const size_t steps);
+
+  //! Return the index of the recurrent state holding BPTT step `i` when
+  //! checkpointing `steps` BPTT steps.
+  static size_t CheckpointSlot(const size_t i, const size_t steps);
+
+  //! Throw a std::invalid_argument if `sequenceLengths` does not hold one
+  //! valid length for each of the `sequences` sequences of `steps` steps.
+  static void CheckSequenceLengths(const std::string& functionName,
+                                   const arma::urowvec& sequenceLengths,
+                                   const size_t sequences,
+                                   const size_t steps);
+
+  //! Sort the sequences of the batch starting at point `begin` by decreasing
+  //! length, if sequence lengths are given.
+  void SortBatch(const size_t begin, const size_t batchSize);
+
+  //! Return the number of time steps of the batch starting at point `begin`:
+  //! the length of its longest sequence.  The batch must be sorted.
+  size_t BatchSteps(const size_t begin) const;
+
+  //! Return the number of sequences of the (sorted) batch starting at point
+  //! `begin` that are still active at time step `t`; they are the first ones
+  //! of the batch.  If `sequenceLengths` is empty, this is `batchSize`.
+  static size_t StepBatchSize(const arma::urowvec& sequenceLengths,
+                              const size_t t,
+                              const size_t begin,
+                              const size_t batchSize);
+
   //! Number of timesteps to consider for backpropagation through time (BPTT).
   size_t bpttSteps;
   //! Whether the network expects only one single response per sequence, or one
   //! response per time step.
   bool single;
+  //! Whether gradient checkpointing is used for BPTT.
+  bool checkpointing;
 
   //! The network itself is stored in this FFN object.  Note that this network
   //! may contain recursive layers, and thus we will be responsible for
@@ -375,6 +528,11 @@ class RNN
   //! The matrix of responses to the input data points.  This member is empty,
   //! except during training.
   arma::Cube<typename MatType::elem_type> responses;
+
+  //! The number of time steps of each sequence of `predictors`, or empty if
+  //! all the sequences have `predictors.n_slices` steps.  This member is empty,
+  //! except during training.
+  arma::urowvec sequenceLengths;
 }; // class RNNType
 
 } // namespace mlpack
@@ -34,6 +34,7 @@ RNN<
     InitializationRuleType initializeRule) :
     bpttSteps(bpttSteps),
     single(single),
+    checkpointing(false),
     network(std::move(outputLayer), std::move(initializeRule))
 {
   /* Nothing to do here */
@@ -52,6 +53,7 @@ RNN<
     const RNN& network) :
     bpttSteps(network.bpttSteps),
     single(network.single),
+    checkpointing(network.checkpointing),
     network(network.network)
 {
   // Nothing else to do.
@@ -70,6 +72,7 @@ RNN<
     RNN&& network) :
     bpttSteps(std::move(network.bpttSteps)),
     single(std::move(network.single)),
+    checkpointing(std::move(network.checkpointing)),
     network(std::move(network.network))
 {
   // Nothing to do here.
@@ -95,9 +98,11 @@ RNN<
   {
     bpttSteps = other.bpttSteps;
     single = other.single;
+    checkpointing = other.checkpointing;
     network = other.network;
     predictors.clear();
     responses.clear();
+    sequenceLengths.clear();
   }
 
   return *this;
@@ -123,9 +128,11 @@ RNN<
   {
     bpttSteps = std::move(other.bpttSteps);
     single = std::move(other.single);
+    checkpointing = std::move(other.checkpointing);
     network = std::move(other.network);
     predictors.clear();
     responses.clear();
+    sequenceLengths.clear();
   }
 
   return *this;
@@ -199,6 +206,42 @@ typename MatType::elem_type RNN<
       callbacks...);
 }
 
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+template<typename OptimizerType, typename... CallbackTypes>
+typename MatType::elem_type RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Train(
+    arma::Cube<typename MatType::elem_type> predictors,
+    arma::Cube<typename MatType::elem_type> responses,
+    arma::urowvec sequenceLengths,
+    OptimizerType& optimizer,
+    CallbackTypes&&... callbacks)
+{
+  ResetData(std::move(predictors), std::move(responses),
+      std::move(sequenceLengths));
+
+  network.WarnMessageMaxIterations(optimizer, this->predictors.n_cols);
+
+  // Ensure that the network can be used.
+  network.CheckNetwork("RNN::Train()", this->predictors.n_rows, true, true);
+
+  // Train the model.
+  Timer::Start("rnn_optimization");
+  const typename MatType::elem_type out =
+      optimizer.Optimize(*this, network.Parameters(), callbacks...);
+  Timer::Stop("rnn_optimization");
+
+  Log::Info << "RNN::Train(): final objective of trained model is " << out
+      << "." << std::endl;
+  return out;
+}
+
 template<
     typename OutputLayerType,
     typename InitializationRuleType,
@@ -249,6 +292,62 @@ void RNN<
   }
 }
 
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+void RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Predict(
+    const arma::Cube<typename MatType::elem_type>& predictors,
+    arma::Cube<typename MatType::elem_type>& results,
+    const arma::urowvec& sequenceLengths,
+    const size_t batchSize)
+{
+  // Ensure that the network is configured correctly.
+  network.CheckNetwork("RNN::Predict()", predictors.n_rows, true, false);
+  CheckSequenceLengths("RNN::Predict()", sequenceLengths, predictors.n_cols,
+      predictors.n_slices);
+
+  results.zeros(network.network.OutputSize(), predictors.n_cols,
+      predictors.n_slices);
+
+  // Visit the sequences by decreasing length, so that each batch holds
+  // sequences of similar lengths, and the sequences that are still active at a
+  // time step are the first ones of the batch.
+  const arma::uvec order = arma::stable_sort_index(sequenceLengths,
+      "descend");
+  const arma::urowvec sortedLengths = sequenceLengths.cols(order);
+
+  MatType stepInput, stepOutput;
+  for (size_t i = 0; i < predictors.n_cols; i += batchSize)
+  {
+    const size_t effectiveBatchSize = std::min(batchSize,
+        size_t(predictors.n_cols) - i);
+
+    // As in the other overload, one buffer is enough for the state.
+    ResetMemoryState(1, effectiveBatchSize);
+    SetPreviousStep(size_t(-1));
+    SetCurrentStep(size_t(0));
+
+    for (size_t t = 0; t < sortedLengths[i]; ++t)
+    {
+      if (t == 1)
+        SetPreviousStep(size_t(0));
+
+      const size_t stepBatchSize = StepBatchSize(sortedLengths, t, i,
+          effectiveBatchSize);
+      const arma::uvec stepPoints = order.subvec(i, i + stepBatchSize - 1);
+      stepInput = predictors.slice(t).cols(stepPoints);
+      network.Forward(stepInput, stepOutput);
+      results.slice(t).cols(stepPoints) = stepOutput;
+    }
+  }
+}
+
 template<
     typename OutputLayerType,
     typename InitializationRuleType,
@@ -310,6 +409,7 @@ void RNN<
       // middle of training and resume.
       predictors.clear();
       responses.clear();
+      sequenceLengths.clear();
     }
   #endif
 }
@@ -331,6 +431,10 @@ typename MatType::elem_type RNN<
   // Ensure the network is valid.
   network.CheckNetwork("RNN::Evaluate()", predictors.n_rows);
 
+  // With sequences of different lengths, the active sequences of each step
+  // must be the first ones of the batch.
+  SortBatch(begin, batchSize);
+
   // The core of the computation here is to pass through each step.  Since we
   // are not computing the gradient, we can be "clever" and use only one memory
   // cell---we don't need to know about the past.
@@ -341,21 +445,21 @@ typename MatType::elem_type RNN<
 
   typename MatType::elem_type loss = 0.0;
   MatType stepData, responseData;
-  for (size_t t = 0; t < predictors.n_slices; ++t)
+  for (size_t t = 0; t < BatchSteps(begin); ++t)
   {
     if (t == 1)
       SetPreviousStep(0);
 
     // Manually reset the data of the network to be an alias of the current time
-    // step.
+    // step; only the sequences that are still active are evaluated.
     MakeAlias(network.predictors, predictors.slice(t), predictors.n_rows,
-        batchSize, begin * predictors.slice(t).n_rows);
+        predictors.n_cols);
     const size_t responseStep = (single) ? 0 : t;
     MakeAlias(network.responses, responses.slice(responseStep),
-        responses.n_rows, batchSize,
-        begin * responses.slice(responseStep).n_rows);
+        responses.n_rows, responses.n_cols);
 
-    loss += network.Evaluate(output, begin, batchSize);
+    loss += network.Evaluate(output, begin,
+        StepBatchSize(sequenceLengths, t, begin, batchSize));
   }
 
   return loss;
@@ -396,12 +500,25 @@ typename MatType::elem_type RNN<
 {
   network.CheckNetwork("RNN::EvaluateWithGradient()", predictors.n_rows);
 
+  // With sequences of different lengths, the active sequences of each step
+  // must be the first ones of the batch, and only the steps of the longest
+  // sequence are used.
+  SortBatch(begin, batchSize);
+  const size_t steps = BatchSteps(begin);
+
   typename MatType::elem_type loss = 0;
 
   // We must save anywhere between 1 and `bpttSteps` states, but we are limited
-  // by `predictors.n_slices`.
+  // by the number of time steps of the batch.
   const size_t effectiveBPTTSteps = std::max(size_t(1),
-      std::min(bpttSteps, size_t(predictors.n_slices)));
+      std::min(bpttSteps, steps));
+
+  if (checkpointing &&
+      CheckpointSlots(effectiveBPTTSteps) < effectiveBPTTSteps)
+  {
+    return CheckpointedEvaluateWithGradient(begin, gradient, batchSize,
+        effectiveBPTTSteps);
+  }
 
   ResetMemoryState(effectiveBPTTSteps, batchSize);
   SetPreviousStep(size_t(-1));
@@ -411,21 +528,23 @@ typename MatType::elem_type RNN<
   // If `bpttSteps` is less than the number of time steps in the data, then for
   // the first few steps, we won't actually need to hold onto any historical
   // information, since BPTT will never go back that far.
-  const size_t extraSteps = (predictors.n_slices - effectiveBPTTSteps + 1);
+  const size_t extraSteps = (steps - effectiveBPTTSteps + 1);
   MatType stepData, outputData, responseData;
-  for (size_t t = 0; t < std::min(size_t(predictors.n_slices), extraSteps); ++t)
+  for (size_t t = 0; t < std::min(steps, extraSteps); ++t)
   {
     SetCurrentStep(0);
+    const size_t stepBatchSize = StepBatchSize(sequenceLengths, t, begin,
+        batchSize);
 
     // Make an alias of the step's data.
-    MakeAlias(stepData, predictors.slice(t), predictors.n_rows, batchSize,
+    MakeAlias(stepData, predictors.slice(t), predictors.n_rows, stepBatchSize,
         begin * predictors.slice(t).n_rows);
-    MakeAlias(outputData, outputs.slice(t), outputs.n_rows, outputs.n_cols);
+    MakeAlias(outputData, outputs.slice(t), outputs.n_rows, stepBatchSize);
     network.network.Forward(stepData, outputData);
 
     const size_t responseStep = (single) ? 0 : t;
     MakeAlias(responseData, responses.slice(responseStep),
-        responses.n_rows, batchSize,
+        responses.n_rows, stepBatchSize,
         begin * responses.slice(responseStep).n_rows);
 
     loss += network.outputLayer.Forward(outputData, responseData);
@@ -435,19 +554,21 @@ typename MatType::elem_type RNN<
 
   // Next, we reach the time steps that will be used for BPTT, for which we must
   // preserve step data.
-  for (size_t t = extraSteps; t < predictors.n_slices; ++t)
+  for (size_t t = extraSteps; t < steps; ++t)
   {
     SetCurrentStep(t - extraSteps + 1);
+    const size_t stepBatchSize = StepBatchSize(sequenceLengths, t, begin,
+        batchSize);
 
     // Wrap a matrix around our data to avoid a copy.
-    MakeAlias(stepData, predictors.slice(t), predictors.n_rows, batchSize,
+    MakeAlias(stepData, predictors.slice(t), predictors.n_rows, stepBatchSize,
         begin * predictors.slice(t).n_rows);
-    MakeAlias(outputData, outputs.slice(t), outputs.n_rows, outputs.n_cols);
+    MakeAlias(outputData, outputs.slice(t), outputs.n_rows, stepBatchSize);
     network.network.Forward(stepData, outputData);
 
     const size_t responseStep = (single) ? 0 : t;
     MakeAlias(responseData, responses.slice(responseStep),
-        responses.n_rows, batchSize,
+        responses.n_rows, stepBatchSize,
         begin * responses.slice(responseStep).n_rows);
 
     loss += network.outputLayer.Forward(outputData, responseData);
@@ -466,13 +587,15 @@ typename MatType::elem_type RNN<
       network.Parameters().n_cols);
 
   SetPreviousStep(size_t(-1));
-  const size_t minStep = predictors.n_slices - effectiveBPTTSteps + 1;
-  for (size_t t = predictors.n_slices; t >= minStep; --t)
+  const size_t minStep = steps - effectiveBPTTSteps + 1;
+  for (size_t t = steps; t >= minStep; --t)
   {
     SetCurrentStep(t - 1);
+    const size_t stepBatchSize = StepBatchSize(sequenceLengths, t - 1, begin,
+        batchSize);
 
     currentGradient.zeros();
-    MatType error(outputs.n_rows, outputs.n_cols);
+    MatType error(outputs.n_rows, stepBatchSize);
 
     // Set up the response by backpropagating through the output layer.  Note
     // that if we are in 'single' mode, we don't care what the network outputs
@@ -485,18 +608,18 @@ typename MatType::elem_type RNN<
     else
     {
       MakeAlias(outputData, outputs.slice(t - 1), outputs.n_rows,
-          outputs.n_cols);
+          stepBatchSize);
       const size_t respStep = (single) ? 0 : t - 1;
       MakeAlias(responseData, responses.slice(respStep), responses.n_rows,
-          batchSize, begin * responses.slice(respStep).n_rows);
+          stepBatchSize, begin * responses.slice(respStep).n_rows);
       network.outputLayer.Backward(outputData, responseData, error);
     }
 
     // Now pass that error backwards through the network.
-    MakeAlias(stepData, predictors.slice(t - 1), predictors.n_rows, batchSize,
-        begin * predictors.slice(t - 1).n_rows);
+    MakeAlias(stepData, predictors.slice(t - 1), predictors.n_rows,
+        stepBatchSize, begin * predictors.slice(t - 1).n_rows);
     MakeAlias(outputData, outputs.slice(t - 1), outputs.n_rows,
-        outputs.n_cols);
+        stepBatchSize);
 
     MatType networkDelta;
     network.network.Backward(stepData, outputData, error, networkDelta);
@@ -540,7 +663,29 @@ void RNN<
     MatType
 >::Shuffle()
 {
-  ShuffleData(predictors, responses, predictors, responses);
+  if (sequenceLengths.is_empty())
+  {
+    ShuffleData(predictors, responses, predictors, responses);
+    return;
+  }
+
+  // The sequence lengths must be shuffled with the same ordering.
+  const arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
+      predictors.n_cols - 1, predictors.n_cols));
+  for (size_t s = 0; s < predictors.n_slices; ++s)
+  {
+    const arma::Mat<typename MatType::elem_type> slice =
+        predictors.slice(s).cols(ordering);
+    predictors.slice(s) = slice;
+  }
+  for (size_t s = 0; s < responses.n_slices; ++s)
+  {
+    const arma::Mat<typename MatType::elem_type> slice =
+        responses.slice(s).cols(ordering);
+    responses.slice(s) = slice;
+  }
+  const arma::urowvec lengths = sequenceLengths.cols(ordering);
+  sequenceLengths = lengths;
 }
 
 template<
@@ -558,6 +703,368 @@ void RNN<
 {
   this->predictors = std::move(predictors);
   this->responses = std::move(responses);
+  this->sequenceLengths.clear();
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+void RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::ResetData(
+    arma::Cube<typename MatType::elem_type> predictors,
+    arma::Cube<typename MatType::elem_type> responses,
+    arma::urowvec sequenceLengths)
+{
+  CheckSequenceLengths("RNN::ResetData()", sequenceLengths, predictors.n_cols,
+      predictors.n_slices);
+
+  this->predictors = std::move(predictors);
+  this->responses = std::move(responses);
+  this->sequenceLengths = std::move(sequenceLengths);
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+template<typename GradType>
+typename MatType::elem_type RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::CheckpointedEvaluateWithGradient(
+    const size_t begin,
+    GradType& gradient,
+    const size_t batchSize,
+    const size_t steps)
+{
+  typename MatType::elem_type loss = 0;
+
+  // The time steps before the last `steps` ones are only passed forward, and
+  // their state is kept in a slot after the ones used for BPTT.  (The batch is
+  // already sorted by EvaluateWithGradient().)
+  const size_t extraSteps = BatchSteps(begin) - steps;
+  const size_t extraSlot = CheckpointSlots(steps) - 1;
+  const size_t segmentLength = SegmentLength(steps);
+  const size_t segments = (steps + segmentLength - 1) / segmentLength;
+
+  ResetMemoryState(CheckpointSlots(steps), batchSize);
+  SetPreviousStep(size_t(-1));
+  arma::Cube<typename MatType::elem_type> outputs(
+      network.network.OutputSize(), batchSize, steps);
+
+  MatType stepData, outputData, responseData;
+  for (size_t t = 0; t < extraSteps; ++t)
+  {
+    SetCurrentStep(extraSlot);
+    ForwardStep(t, begin, batchSize, outputData);
+
+    const size_t responseStep = (single) ? 0 : t;
+    MakeAlias(responseData, responses.slice(responseStep),
+        responses.n_rows, outputData.n_cols,
+        begin * responses.slice(responseStep).n_rows);
+    loss += network.outputLayer.Forward(outputData, responseData);
+
+    SetPreviousStep(extraSlot);
+  }
+
+  // The first slot of the BPTT steps follows the extra steps, if there are
+  // any.
+  const size_t firstPreviousSlot = (extraSteps > 0) ? extraSlot : size_t(-1);
+  for (size_t i = 0; i < steps; ++i)
+  {
+    SetCurrentStep(CheckpointSlot(i, steps));
+    MakeAlias(outputData, outputs.slice(i), outputs.n_rows,
+        StepBatchSize(sequenceLengths, extraSteps + i, begin, batchSize));
+    ForwardStep(extraSteps + i, begin, batchSize, outputData);
+
+    const size_t responseStep = (single) ? 0 : extraSteps + i;
+    MakeAlias(responseData, responses.slice(responseStep),
+        responses.n_rows, outputData.n_cols,
+        begin * responses.slice(responseStep).n_rows);
+    loss += network.outputLayer.Forward(outputData, responseData);
+
+    SetPreviousStep(CheckpointSlot(i, steps));
+  }
+
+  // Add loss (this is not dependent on time steps, and should only be added
+  // once).
+  loss += network.network.Loss();
+
+  // Initialize current/working gradient.
+  gradient.zeros(network.Parameters().n_rows, network.Parameters().n_cols);
+  GradType currentGradient;
+  currentGradient.zeros(network.Parameters().n_rows,
+      network.Parameters().n_cols);
+
+  // The segments are visited backwards.  The states of the last segment are
+  // still held from the forward pass, but the states of each earlier segment
+  // are recomputed from the checkpoint before it.
+  size_t laterSlot = size_t(-1);
+  for (size_t j = segments; j > 0; --j)
+  {
+    const size_t first = (j - 1) * segmentLength;
+    const size_t last = std::min(steps, first + segmentLength) - 1;
+
+    if (j < segments)
+    {
+      SetPreviousStep((first == 0) ? firstPreviousSlot :
+          CheckpointSlot(first - 1, steps));
+      for (size_t i = first; i <= last; ++i)
+      {
+        SetCurrentStep(CheckpointSlot(i, steps));
+        MakeAlias(outputData, outputs.slice(i), outputs.n_rows,
+            StepBatchSize(sequenceLengths, extraSteps + i, begin, batchSize));
+        ForwardStep(extraSteps + i, begin, batchSize, outputData);
+        SetPreviousStep(CheckpointSlot(i, steps));
+      }
+    }
+
+    for (size_t i = last + 1; i-- > first; )
+    {
+      const size_t t = extraSteps + i;
+      const size_t stepBatchSize = StepBatchSize(sequenceLengths, t, begin,
+          batchSize);
+      MakeAlias(outputData, outputs.slice(i), outputs.n_rows, stepBatchSize);
+
+      // Pass the step forward again (unless it was the last one passed
+      // forward), so that the non-recurrent layers hold its activations.
+      if (i != last)
+      {
+        SetPreviousStep((i == 0) ? firstPreviousSlot :
+            CheckpointSlot(i - 1, steps));
+        SetCurrentStep(CheckpointSlot(i, steps));
+        ForwardStep(t, begin, batchSize, outputData);
+      }
+
+      SetCurrentStep(CheckpointSlot(i, steps));
+      SetPreviousStep(laterSlot);
+
+      currentGradient.zeros();
+      MatType error(outputs.n_rows, stepBatchSize);
+
+      // As in EvaluateWithGradient(), in 'single' mode there is no error for
+      // the time steps before the response.
+      if (single && t < responses.n_slices - 1)
+      {
+        error.zeros();
+      }
+      else
+      {
+        const size_t respStep = (single) ? 0 : t;
+        MakeAlias(responseData, responses.slice(respStep), responses.n_rows,
+            stepBatchSize, begin * responses.slice(respStep).n_rows);
+        network.outputLayer.Backward(outputData, responseData, error);
+      }
+
+      MakeAlias(stepData, predictors.slice(t), predictors.n_rows,
+          stepBatchSize, begin * predictors.slice(t).n_rows);
+
+      MatType networkDelta;
+      network.network.Backward(stepData, outputData, error, networkDelta);
+
+      network.network.Gradient(stepData, error, currentGradient);
+      gradient += currentGradient;
+
+      laterSlot = CheckpointSlot(i, steps);
+    }
+  }
+
+  return loss;
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+void RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::ForwardStep(const size_t t,
+               const size_t begin,
+               const size_t batchSize,
+               MatType& output)
+{
+  MatType stepData;
+  MakeAlias(stepData, predictors.slice(t), predictors.n_rows,
+      StepBatchSize(sequenceLengths, t, begin, batchSize),
+      begin * predictors.slice(t).n_rows);
+  network.network.Forward(stepData, output);
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+size_t RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::SegmentLength(const size_t steps)
+{
+  return std::max(size_t(1), (size_t) std::ceil(std::sqrt((double) steps)));
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+size_t RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::CheckpointSlots(const size_t steps)
+{
+  // One checkpoint for each segment, two segments of working states (so that
+  // recomputing a segment does not overwrite the states of the segment after
+  // it), and one slot for the steps before BPTT.
+  const size_t segmentLength = SegmentLength(steps);
+  const size_t segments = (steps + segmentLength - 1) / segmentLength;
+  return segments + 2 * segmentLength + 1;
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+size_t RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::CheckpointSlot(const size_t i, const size_t steps)
+{
+  const size_t segmentLength = SegmentLength(steps);
+  const size_t segments = (steps + segmentLength - 1) / segmentLength;
+  const size_t segment = i / segmentLength;
+
+  // The last step of each segment is its checkpoint.
+  if ((i % segmentLength) == segmentLength - 1 || i == steps - 1)
+    return segment;
+
+  return segments + (segment % 2) * segmentLength + (i % segmentLength);
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+void RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::CheckSequenceLengths(const std::string& functionName,
+                        const arma::urowvec& sequenceLengths,
+                        const size_t sequences,
+                        const size_t steps)
+{
+  if (sequenceLengths.n_elem != sequences)
+  {
+    std::ostringstream oss;
+    oss << functionName << ": the number of sequence lengths ("
+        << sequenceLengths.n_elem << ") does not match the number of "
+        << "sequences (" << sequences << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (sequences > 0 &&
+      (sequenceLengths.min() == 0 || sequenceLengths.max() > steps))
+  {
+    std::ostringstream oss;
+    oss << functionName << ": each sequence length must be between 1 and the "
+        << "number of time steps (" << steps << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+void RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::SortBatch(const size_t begin, const size_t batchSize)
+{
+  if (sequenceLengths.is_empty() || batchSize == 0)
+    return;
+
+  const size_t end = begin + batchSize - 1;
+  const arma::urowvec batchLengths = sequenceLengths.cols(begin, end);
+  if (batchLengths.is_sorted("descend"))
+    return;
+
+  // The loss and the gradient of a batch do not depend on the order of its
+  // points, so the batch can be reordered in place.
+  const arma::uvec order = arma::stable_sort_index(batchLengths, "descend");
+  sequenceLengths.cols(begin, end) = batchLengths.cols(order);
+  for (size_t s = 0; s < predictors.n_slices; ++s)
+  {
+    const arma::Mat<typename MatType::elem_type> batch =
+        predictors.slice(s).cols(begin, end);
+    predictors.slice(s).cols(begin, end) = batch.cols(order);
+  }
+  for (size_t s = 0; s < responses.n_slices; ++s)
+  {
+    const arma::Mat<typename MatType::elem_type> batch =
+        responses.slice(s).cols(begin, end);
+    responses.slice(s).cols(begin, end) = batch.cols(order);
+  }
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+size_t RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::BatchSteps(const size_t begin) const
+{
+  // The first sequence of a sorted batch is the longest one.
+  if (sequenceLengths.is_empty())
+    return predictors.n_slices;
+
+  return sequenceLengths[begin];
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+size_t RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::StepBatchSize(const arma::urowvec& sequenceLengths,
+                 const size_t t,
+                 const size_t begin,
+                 const size_t batchSize)
+{
+  if (sequenceLengths.is_empty())
+    return batchSize;
+
+  size_t active = 0;
+  while (active < batchSize && sequenceLengths[begin + active] > t)
+    ++active;
+
+  return active;
 }
 
 template<
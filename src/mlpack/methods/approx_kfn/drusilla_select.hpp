@@ -38,6 +38,9 @@ template<typename MatType = arma::mat>
 class DrusillaSelect
 {
  public:
+  //! The type of element held in MatType.
+  typedef typename MatType::elem_type ElemType;
+
   /**
    * Construct the DrusillaSelect object with the given reference set (this is
    * the set that will be searched).  The resulting set of candidate points that
@@ -82,6 +85,10 @@ class DrusillaSelect
    * the k'th row in that column will refer to the k'th candidate neighbor or
    * distance for that query point.
    *
+   * The distances between the query points and the candidate set are computed
+   * in blocks of queries with one matrix product each, and the query points are
+   * split between OpenMP threads.
+   *
    * @param querySet Set of query points to search.
    * @param k Number of furthest neighbors to search for.
    * @param neighbors Matrix to store resulting neighbors in.
@@ -90,7 +97,7 @@ class DrusillaSelect
   void Search(const MatType& querySet,
               const size_t k,
               arma::Mat<size_t>& neighbors,
-              arma::mat& distances);
+              arma::Mat<ElemType>& distances);
 
   /**
    * Serialize the model.
@@ -109,6 +116,10 @@ class DrusillaSelect
   arma::Col<size_t>& CandidateIndices() { return candidateIndices; }
 
  private:
+  //! The number of query points whose distances to the candidate set are
+  //! computed with each matrix product during Search().
+  static constexpr size_t QueryBlockSize = 256;
+
   //! The reference set.
   MatType candidateSet;
   //! Indices of each point in the reference set.
@@ -16,9 +16,6 @@
 #include "drusilla_select.hpp"
 
 #include <queue>
-#include <mlpack/methods/neighbor_search/neighbor_search_rules.hpp>
-#include <mlpack/methods/neighbor_search/sort_policies/furthest_neighbor_sort.hpp>
-#include <mlpack/core/tree/binary_space_tree.hpp>
 #include <algorithm>
 
 namespace mlpack {
@@ -80,7 +77,7 @@ void DrusillaSelect<MatType>::Train(
   candidateSet.set_size(referenceSet.n_rows, l * m);
   candidateIndices.set_size(l * m);
 
-  arma::vec dataMean(arma::mean(referenceSet, 1));
+  arma::Col<ElemType> dataMean(arma::mean(referenceSet, 1));
   arma::vec norms(referenceSet.n_cols);
 
   MatType refCopy(referenceSet.n_rows, referenceSet.n_cols);
@@ -97,7 +94,8 @@ void DrusillaSelect<MatType>::Train(
     arma::uword maxIndex = 0;
     norms.max(maxIndex);
 
-    arma::vec line(refCopy.col(maxIndex) / norm(refCopy.col(maxIndex)));
+    arma::Col<ElemType> line(refCopy.col(maxIndex) /
+        norm(refCopy.col(maxIndex)));
 
     // Calculate distortion and offset and make scores.
     std::vector<bool> closeAngle(referenceSet.n_cols, false);
@@ -168,7 +166,7 @@ template<typename MatType>
 void DrusillaSelect<MatType>::Search(const MatType& querySet,
                                      const size_t k,
                                      arma::Mat<size_t>& neighbors,
-                                     arma::mat& distances)
+                                     arma::Mat<ElemType>& distances)
 {
   if (candidateSet.n_cols == 0)
     throw std::runtime_error("DrusillaSelect::Search(): candidate set not "
@@ -178,23 +176,94 @@ void DrusillaSelect<MatType>::Search(const MatType& querySet,
     throw std::invalid_argument("DrusillaSelect::Search(): requested k is "
         "greater than number of points in candidate set!  Increase l or m.");
 
-  // We'll use the NeighborSearchRules class to perform our brute-force search.
-  // Note that we aren't using trees for our search, so we can use 'int' as a
-  // TreeType.
-  EuclideanDistance metric;
-  NeighborSearchRules<FurthestNeighborSort, EuclideanDistance,
-      KDTree<EuclideanDistance, EmptyStatistic, MatType>>
-      rules(candidateSet, querySet, k, metric, 0, false);
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+  if (k == 0 || querySet.n_cols == 0)
+    return;
 
-  for (size_t q = 0; q < querySet.n_cols; ++q)
-    for (size_t r = 0; r < candidateSet.n_cols; ++r)
-      rules.BaseCase(q, r);
+  // The squared distance between a query point q and a candidate point c is
+  // ||q||^2 + ||c||^2 - 2 q^T c, so the distances to a whole block of query
+  // points take one matrix product.  The expansion is only used to find the
+  // furthest candidates; their distances are then computed exactly.
+  const size_t numCandidates = candidateSet.n_cols;
+  arma::vec candidateNorms(numCandidates);
+  for (size_t j = 0; j < numCandidates; ++j)
+    candidateNorms[j] = arma::dot(candidateSet.col(j), candidateSet.col(j));
 
-  rules.GetResults(neighbors, distances);
+  // Rounding error bound of the expansion, relative to the norms.
+  const double relativeError = 4.0 * (querySet.n_rows + 2) *
+      std::numeric_limits<ElemType>::epsilon();
+  const double maxCandidateNorm = candidateNorms.max();
 
-  // Map the neighbors back to their original indices in the reference set.
-  for (size_t i = 0; i < neighbors.n_elem; ++i)
-    neighbors[i] = candidateIndices[neighbors[i]];
+  const size_t numBlocks = (querySet.n_cols + QueryBlockSize - 1) /
+      QueryBlockSize;
+
+  #pragma omp parallel
+  {
+    std::vector<double> selection;
+    std::vector<std::pair<double, size_t>> furthest;
+
+    #pragma omp for schedule(dynamic)
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      const size_t queryBegin = b * QueryBlockSize;
+      const size_t queryEnd = std::min(queryBegin + QueryBlockSize,
+          (size_t) querySet.n_cols);
+
+      // products(j, i) is the inner product of candidate j and query i.
+      const arma::Mat<ElemType> products(candidateSet.t() *
+          querySet.cols(queryBegin, queryEnd - 1));
+
+      for (size_t i = 0; i < products.n_cols; ++i)
+      {
+        const size_t q = queryBegin + i;
+        const double queryNorm = arma::dot(querySet.col(q), querySet.col(q));
+
+        // Approximate squared distances to each candidate.
+        selection.resize(numCandidates);
+        for (size_t j = 0; j < numCandidates; ++j)
+        {
+          selection[j] = queryNorm + candidateNorms[j] -
+              2.0 * double(products(j, i));
+        }
+
+        // Any candidate that may be among the k furthest is within the rounding
+        // error of the k'th largest approximate distance.
+        std::vector<double> kth(selection);
+        std::nth_element(kth.begin(), kth.begin() + (numCandidates - k),
+            kth.end());
+        const double bound = kth[numCandidates - k] - relativeError *
+            (queryNorm + maxCandidateNorm);
+
+        furthest.clear();
+        for (size_t j = 0; j < numCandidates; ++j)
+        {
+          if (selection[j] >= bound)
+          {
+            furthest.push_back(std::make_pair(EuclideanDistance::Evaluate(
+                querySet.col(q), candidateSet.col(j)), j));
+          }
+        }
+
+        // Sort by decreasing distance (ties go to the earlier candidate), and
+        // map the neighbors back to their original indices in the reference
+        // set.
+        std::partial_sort(furthest.begin(), furthest.begin() + k,
+            furthest.end(), [](const std::pair<double, size_t>& a,
+                               const std::pair<double, size_t>& b)
+            {
+              return (a.first > b.first) ||
+                  ((a.first == b.first) && (a.second < b.second));
+            });
+
+        for (size_t j = 0; j < k; ++j)
+        {
+          neighbors(j, q) = candidateIndices[furthest[j].second];
+          distances(j, q) = furthest[j].first;
+        }
+      }
+    }
+  }
 }
 
 //! Serialize the model.
@@ -32,6 +32,9 @@ template<typename MatType = arma::mat>
 class QDAFN
 {
  public:
+  //! The type of element held in MatType.
+  typedef typename MatType::elem_type ElemType;
+
   /**
    * Construct the QDAFN object but do not train it.  Be sure to call Train()
    * before calling Search().
@@ -71,11 +74,14 @@ class QDAFN
    * can contain just one point, that is okay.)  The results will be stored in
    * the given neighbors and distances matrices, in the same format as the
    * mlpack NeighborSearch and LSHSearch classes.
+   *
+   * The query points are projected onto all of the random lines in blocks, with
+   * one matrix product per block, and are then split between OpenMP threads.
    */
   void Search(const MatType& querySet,
               const size_t k,
               arma::Mat<size_t>& neighbors,
-              arma::mat& distances);
+              arma::Mat<ElemType>& distances);
 
   //! Serialize the model.
   template<typename Archive>
@@ -90,19 +96,23 @@ class QDAFN
   MatType& CandidateSet(const size_t t) { return candidateSet[t]; }
 
  private:
+  //! The number of query points projected onto the lines with each matrix
+  //! product during Search().
+  static constexpr size_t QueryBlockSize = 256;
+
   //! The number of projections.
   size_t l;
   //! The number of elements to store for each projection.
   size_t m;
   //! The random lines we are projecting onto.  Has l columns.
-  arma::mat lines;
+  arma::Mat<ElemType> lines;
   //! Projections of each point onto each random line.
-  arma::mat projections;
+  arma::Mat<ElemType> projections;
 
   //! Indices of the points for each S.
   arma::Mat<size_t> sIndices;
   //! Values of a_i * x for each point in S.
-  arma::mat sValues;
+  arma::Mat<ElemType> sValues;
 
   // Candidate sets; one element in the vector for each table.
   std::vector<MatType> candidateSet;
@@ -63,7 +63,7 @@ void QDAFN<MatType>::Train(const MatType& referenceSet,
   GaussianDistribution<> gd(referenceSet.n_rows);
   lines.set_size(referenceSet.n_rows, l);
   for (size_t i = 0; i < l; ++i)
-    lines.col(i) = gd.Random();
+    lines.col(i) = arma::conv_to<arma::Col<ElemType>>::from(gd.Random());
 
   // Now, project each of the reference points onto each line, and collect the
   // top m elements.
@@ -93,7 +93,7 @@ template<typename MatType>
 void QDAFN<MatType>::Search(const MatType& querySet,
                             const size_t k,
                             arma::Mat<size_t>& neighbors,
-                            arma::mat& distances)
+                            arma::Mat<ElemType>& distances)
 {
   if (k > m)
     throw std::invalid_argument("QDAFN::Search(): requested k is greater than "
@@ -103,76 +103,92 @@ void QDAFN<MatType>::Search(const MatType& querySet,
   neighbors.fill(size_t() - 1);
   distances.zeros(k, querySet.n_cols);
 
-  // Search for each point.
-  for (size_t q = 0; q < querySet.n_cols; ++q)
+  const size_t numBlocks = (querySet.n_cols + QueryBlockSize - 1) /
+      QueryBlockSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t b = 0; b < numBlocks; ++b)
   {
-    // Initialize a priority queue.
-    // The size_t represents the index of the table, and the double represents
-    // the value of l_i * S_i - l_i * query (see line 6 of Algorithm 1).
-    std::priority_queue<std::pair<double, size_t>> queue;
-    for (size_t i = 0; i < l; ++i)
-    {
-      const double val = sValues(0, i) - dot(querySet.col(q),
-          lines.col(i));
-      queue.push(std::make_pair(val, i));
-    }
+    const size_t queryBegin = b * QueryBlockSize;
+    const size_t queryEnd = std::min(queryBegin + QueryBlockSize,
+        (size_t) querySet.n_cols);
 
-    // To track where we are in each S table, we keep the next index to look at
-    // in each table (they start at 0).
-    arma::Col<size_t> tableLocations = zeros<arma::Col<size_t>>(l);
+    // Project the whole block of query points onto every line at once;
+    // queryProjections(i, j) is a_i * q_j.
+    const arma::Mat<ElemType> queryProjections(lines.t() *
+        querySet.cols(queryBegin, queryEnd - 1));
 
-    // Now that the queue is initialized, iterate over m elements.
-    std::vector<std::pair<double, size_t>> v(k, std::make_pair(-1.0,
-        size_t(-1)));
-    std::priority_queue<std::pair<double, size_t>>
-        resultsQueue(std::less<std::pair<double, size_t>>(), std::move(v));
-    for (size_t i = 0; i < m; ++i)
+    for (size_t q = queryBegin; q < queryEnd; ++q)
     {
-      std::pair<size_t, double> p = queue.top();
-      queue.pop();
-
-      // Get index of reference point to look at.
-      const size_t tableIndex = tableLocations[p.second];
-
-      // Calculate distance from query point.
-      const double dist = EuclideanDistance::Evaluate(querySet.col(q),
-          candidateSet[p.second].col(tableIndex));
-
-      resultsQueue.push(std::make_pair(dist, sIndices(tableIndex, p.second)));
-
-      // Now (line 14) get the next element and insert into the queue.  Do this
-      // by adjusting the previous value.  Don't insert anything if we are at
-      // the end of the search, though.
-      if (i < m - 1)
+      // Initialize a priority queue.
+      // The size_t represents the index of the table, and the double represents
+      // the value of l_i * S_i - l_i * query (see line 6 of Algorithm 1).
+      std::priority_queue<std::pair<double, size_t>> queue;
+      for (size_t i = 0; i < l; ++i)
       {
-        tableLocations[p.second]++;
-        const double val = p.first - sValues(tableIndex, p.second) +
-            sValues(tableIndex + 1, p.second);
-
-        queue.push(std::make_pair(val, p.second));
+        const double val = sValues(0, i) -
+            queryProjections(i, q - queryBegin);
+        queue.push(std::make_pair(val, i));
       }
-    }
 
-    // Extract the results and deduplicate them.
-    size_t extracted = 1;
-    neighbors(0, q) = resultsQueue.top().second;
-    distances(0, q) = resultsQueue.top().first;
-    resultsQueue.pop();
+      // To track where we are in each S table, we keep the next index to look
+      // at in each table (they start at 0).
+      arma::Col<size_t> tableLocations = zeros<arma::Col<size_t>>(l);
 
-    while (!resultsQueue.empty())
-    {
-      if (extracted == k)
-        break;
+      // Now that the queue is initialized, iterate over m elements.
+      std::vector<std::pair<double, size_t>> v(k, std::make_pair(-1.0,
+          size_t(-1)));
+      std::priority_queue<std::pair<double, size_t>>
+          resultsQueue(std::less<std::pair<double, size_t>>(), std::move(v));
+      for (size_t i = 0; i < m; ++i)
+      {
+        std::pair<double, size_t> p = queue.top();
+        queue.pop();
+
+        // Get index of reference point to look at.
+        const size_t tableIndex = tableLocations[p.second];
+
+        // Calculate distance from query point.
+        const double dist = EuclideanDistance::Evaluate(querySet.col(q),
+            candidateSet[p.second].col(tableIndex));
+
+        resultsQueue.push(std::make_pair(dist, sIndices(tableIndex,
+            p.second)));
+
+        // Now (line 14) get the next element and insert into the queue.  Do
+        // this by adjusting the previous value.  Don't insert anything if we
+        // are at the end of the search, though.
+        if (i < m - 1)
+        {
+          tableLocations[p.second]++;
+          const double val = p.first - sValues(tableIndex, p.second) +
+              sValues(tableIndex + 1, p.second);
+
+          queue.push(std::make_pair(val, p.second));
+        }
+      }
 
-      std::pair<double, size_t> result = resultsQueue.top();
+      // Extract the results and deduplicate them.
+      size_t extracted = 1;
+      neighbors(0, q) = resultsQueue.top().second;
+      distances(0, q) = resultsQueue.top().first;
       resultsQueue.pop();
 
-      // Avoid inserting any duplicates.
-      if (neighbors(extracted - 1, q) != result.second)
+      while (!resultsQueue.empty())
       {
-        neighbors(extracted, q) = resultsQueue.top().second;
-        distances(extracted, q) = resultsQueue.top().first;
-        ++extracted;
+        if (extracted == k)
+          break;
+
+        std::pair<double, size_t> result = resultsQueue.top();
+        resultsQueue.pop();
+
+        // Avoid inserting any duplicates.
+        if (neighbors(extracted - 1, q) != result.second)
+        {
+          neighbors(extracted, q) = result.second;
+          distances(extracted, q) = result.first;
+          ++extracted;
+        }
       }
     }
   }
@@ -197,6 +197,35 @@ class BayesianLinearRegression
                  const size_t maxIterations,
                  const double tolerance);
 
+  /**
+   * Update the trained model with a new batch of points, without revisiting
+   * the points it was trained on.  The model keeps the sufficient statistics
+   * of all the points seen so far (\f$ \Phi \Phi^T \f$, \f$ \Phi t^T \f$,
+   * \f$ t t^T \f$ and the number of points), and the Cholesky factor of the
+   * posterior precision \f$ \alpha I + \beta \Phi \Phi^T \f$.  The new
+   * points are centered and scaled with the offsets and scales of the first
+   * call to Train(), which are not changed.
+   *
+   * If tuneIterations is 0, alpha and beta are kept, and the Cholesky factor
+   * is updated with one rank-1 update for each new point, so that the cost of
+   * the update is \f$ O(d^2) \f$ for each point.  Otherwise, alpha and beta
+   * are re-estimated for at most tuneIterations iterations (or until the
+   * tolerance is reached), starting from their current values, with the
+   * accumulated statistics; each iteration costs \f$ O(d^3) \f$.
+   *
+   * If the model has not been trained yet, this is the same as Train().
+   *
+   * @param data Column-major new points, dim(P, N).
+   * @param responses A vector of targets of the new points, dim(N).
+   * @param tuneIterations Maximum number of iterations for re-estimating alpha
+   *     and beta.
+   * @return Root mean squared error on the new points.
+   */
+  template<typename MatType, typename ResponsesType>
+  ElemType Update(const MatType& data,
+                  const ResponsesType& responses,
+                  const size_t tuneIterations = 0);
+
   /**
    * Predict \f$y\f$ for a single data point \f$x\f$ using the currently-trained
    * Bayesian ridge regression model.
@@ -389,6 +418,36 @@ class BayesianLinearRegression
   //! Covariance matrix of the solution vector omega.
   ModelMatType matCovariance;
 
+  //! Sum of the outer products of the processed points seen so far.
+  ModelMatType dataGram;
+
+  //! Sum of the processed points weighted by their processed responses.
+  DenseVecType dataResponses;
+
+  //! Sum of the squared processed responses.
+  ElemType responsesSquares;
+
+  //! Number of points seen so far.
+  size_t numPoints;
+
+  //! Upper Cholesky factor of the posterior precision matrix.
+  ModelMatType precisionCholesky;
+
+  /**
+   * Compute the solution vector omega from the Cholesky factor of the
+   * posterior precision matrix and the accumulated statistics.
+   */
+  void SolveOmega();
+
+  /**
+   * Replace the upper Cholesky factor R of a matrix A with the Cholesky factor
+   * of A + x x^T.
+   *
+   * @param r Upper Cholesky factor to update.
+   * @param x Vector to add; it is overwritten.
+   */
+  static void CholeskyUpdate(ModelMatType& r, DenseVecType& x);
+
   /**
    * Center and scale the data accordind to centerData and scaleData.
    * Allows future modifications of new points.
@@ -421,7 +480,7 @@ class BayesianLinearRegression
 } // namespace mlpack
 
 CEREAL_TEMPLATE_CLASS_VERSION((typename ModelMatType),
-    (mlpack::BayesianLinearRegression<ModelMatType>), (1));
+    (mlpack::BayesianLinearRegression<ModelMatType>), (2));
 
 // Include implementation of serialize.
 #include "bayesian_linear_regression_impl.hpp"
@@ -29,7 +29,9 @@ inline BayesianLinearRegression<ModelMatType>::BayesianLinearRegression(
     responsesOffset(0.0),
     alpha(0.0),
     beta(0.0),
-    gamma(0.0)
+    gamma(0.0),
+    responsesSquares(0.0),
+    numPoints(0)
 { /* Nothing to do */ }
 
 template<typename ModelMatType>
@@ -48,7 +50,9 @@ inline BayesianLinearRegression<ModelMatType>::BayesianLinearRegression(
     responsesOffset(0.0),
     alpha(0.0),
     beta(0.0),
-    gamma(0.0)
+    gamma(0.0),
+    responsesSquares(0.0),
+    numPoints(0)
 {
   // Train the model.
   Train(data, responses);
@@ -109,7 +113,9 @@ BayesianLinearRegression<ModelMatType>::Train(
   // Preprocess the data. Center and scale.
   responsesOffset = CenterScaleData(data, responses, phi, t);
 
-  if (!arma::eig_sym(eigVal, eigVec, arma::symmatu(phi * phi.t())))
+  // The sum of the outer products of the points is kept for Update().
+  dataGram = arma::symmatu(phi * phi.t());
+  if (!arma::eig_sym(eigVal, eigVec, dataGram))
   {
     Log::Fatal << "BayesianLinearRegression::Train(): Eigendecomposition "
                << "of covariance failed!" << std::endl;
@@ -152,6 +158,131 @@ BayesianLinearRegression<ModelMatType>::Train(
   matCovariance = eigVec * diagmat(((ElemType) 1) / (beta * eigVal + alpha)) *
       eigVecInv;
 
+  // Keep the sufficient statistics of the training points, so that the model
+  // can be updated later with Update().
+  dataResponses = phi * t.t();
+  responsesSquares = dot(t, t);
+  numPoints = data.n_cols;
+  if (!arma::chol(precisionCholesky, arma::symmatu(beta * dataGram +
+      alpha * arma::eye<ModelMatType>(phi.n_rows, phi.n_rows))))
+  {
+    Log::Fatal << "BayesianLinearRegression::Train(): Cholesky decomposition "
+               << "of posterior precision failed!" << std::endl;
+  }
+
+  return RMSE(data, responses);
+}
+
+template<typename ModelMatType>
+template<typename MatType, typename ResponsesType>
+inline
+typename BayesianLinearRegression<ModelMatType>::ElemType
+BayesianLinearRegression<ModelMatType>::Update(
+    const MatType& data,
+    const ResponsesType& responses,
+    const size_t tuneIterations)
+{
+  if (numPoints == 0)
+  {
+    return Train(data, responses, centerData, scaleData, maxIterations,
+        tolerance);
+  }
+
+  util::CheckSameSizes(data, responses, "BayesianLinearRegression::Update()",
+      "responses");
+  if (data.n_rows != omega.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "BayesianLinearRegression::Update(): dimensionality of data ("
+        << data.n_rows << ") does not match dimensionality of model ("
+        << omega.n_elem << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Preprocess the new points in the same way as the training points.
+  ModelMatType phi;
+  if (!centerData && !scaleData)
+    phi = data;
+  else
+    CenterScaleDataPred(data, phi);
+  const DenseRowType t = responses - responsesOffset;
+
+  dataGram += phi * phi.t();
+  dataResponses += phi * t.t();
+  responsesSquares += dot(t, t);
+  numPoints += data.n_cols;
+
+  const size_t dims = phi.n_rows;
+  if (tuneIterations == 0)
+  {
+    // With fixed hyperparameters each new point adds beta * phi_i phi_i^T to
+    // the precision, so the factor can be updated one point at a time.
+    DenseVecType x;
+    for (size_t i = 0; i < phi.n_cols; ++i)
+    {
+      x = std::sqrt(beta) * phi.col(i);
+      CholeskyUpdate(precisionCholesky, x);
+    }
+    SolveOmega();
+
+    // Woodbury identity: (P + beta Phi Phi^T)^-1
+    //   = C - C Phi (I / beta + Phi^T C Phi)^-1 Phi^T C.
+    const ModelMatType covPhi = matCovariance * phi;
+    const ModelMatType inner = arma::symmatu(phi.t() * covPhi +
+        arma::eye<ModelMatType>(phi.n_cols, phi.n_cols) / beta);
+    matCovariance -= covPhi * arma::solve(inner, covPhi.t());
+    gamma = dims - alpha * trace(matCovariance);
+
+    return RMSE(data, responses);
+  }
+
+  // Re-estimate the hyperparameters from their current values with the
+  // accumulated statistics, as in Train().
+  const ModelMatType identity = arma::eye<ModelMatType>(dims, dims);
+  size_t i = 0;
+  ElemType crit = ((ElemType) 1.0);
+  while (((double) crit > tolerance) && (i < tuneIterations))
+  {
+    ElemType deltaAlpha = -alpha;
+    ElemType deltaBeta = -beta;
+
+    if (!arma::chol(precisionCholesky,
+        arma::symmatu(beta * dataGram + alpha * identity)))
+    {
+      Log::Fatal << "BayesianLinearRegression::Update(): Cholesky "
+                 << "decomposition of posterior precision failed!" << std::endl;
+    }
+    SolveOmega();
+
+    // The trace of the posterior covariance is the squared Frobenius norm of
+    // the inverse of the factor.
+    const ModelMatType rInv = arma::solve(arma::trimatu(precisionCholesky),
+        identity);
+    gamma = dims - alpha * accu(square(rInv));
+    alpha = gamma / dot(omega, omega);
+
+    // Sum of the squared residuals, from the statistics.
+    const ElemType residuals = responsesSquares - 2 * dot(omega, dataResponses)
+        + dot(omega, dataGram * omega);
+    beta = (numPoints - gamma) / residuals;
+
+    deltaAlpha += alpha;
+    deltaBeta += beta;
+    crit = std::abs(deltaAlpha / alpha + deltaBeta / beta);
+    i++;
+  }
+
+  if (!arma::chol(precisionCholesky,
+      arma::symmatu(beta * dataGram + alpha * identity)))
+  {
+    Log::Fatal << "BayesianLinearRegression::Update(): Cholesky decomposition "
+               << "of posterior precision failed!" << std::endl;
+  }
+  SolveOmega();
+  const ModelMatType rInv = arma::solve(arma::trimatu(precisionCholesky),
+      identity);
+  matCovariance = rInv * rInv.t();
+
   return RMSE(data, responses);
 }
 
@@ -330,6 +461,34 @@ inline void BayesianLinearRegression<ModelMatType>::CenterScaleDataPred(
   }
 }
 
+template<typename ModelMatType>
+inline void BayesianLinearRegression<ModelMatType>::SolveOmega()
+{
+  // The posterior mean is beta * (R^T R)^-1 * Phi t^T.
+  omega = beta * arma::solve(arma::trimatu(precisionCholesky),
+      arma::solve(arma::trimatl(precisionCholesky.t()), dataResponses));
+}
+
+template<typename ModelMatType>
+inline void BayesianLinearRegression<ModelMatType>::CholeskyUpdate(
+    ModelMatType& r,
+    DenseVecType& x)
+{
+  // Apply one Givens rotation for each row of the factor.
+  for (size_t k = 0; k < x.n_elem; ++k)
+  {
+    const ElemType rkk = std::hypot(r(k, k), x[k]);
+    const ElemType c = rkk / r(k, k);
+    const ElemType s = x[k] / r(k, k);
+    r(k, k) = rkk;
+    for (size_t j = k + 1; j < x.n_elem; ++j)
+    {
+      r(k, j) = (r(k, j) + s * x[j]) / c;
+      x[j] = c * x[j] - s * r(k, j);
+    }
+  }
+}
+
 /**
  * Serialize the Bayesian linear regression model.
  */
@@ -386,6 +545,25 @@ void BayesianLinearRegression<ModelMatType>::serialize(Archive& ar,
     ar(CEREAL_NVP(omega));
     ar(CEREAL_NVP(matCovariance));
   }
+
+  // Version 2 added the statistics needed by Update().  Older models can only
+  // be retrained.
+  if (version >= 2)
+  {
+    ar(CEREAL_NVP(dataGram));
+    ar(CEREAL_NVP(dataResponses));
+    ar(CEREAL_NVP(responsesSquares));
+    ar(CEREAL_NVP(numPoints));
+    ar(CEREAL_NVP(precisionCholesky));
+  }
+  else if (cereal::is_loading<Archive>())
+  {
+    dataGram.clear();
+    dataResponses.clear();
+    responsesSquares = 0.0;
+    numPoints = 0;
+    precisionCholesky.clear();
+  }
 }
 
 } // namespace mlpack
@@ -85,7 +85,35 @@ class BiasSVD
              VecType& p,
              VecType& q);
 
+  /**
+   * Trains the model and obtains user/item matrices and user/item bias, using
+   * the provided rating triples directly (without conversion to double
+   * precision).
+   *
+   * @param data Rating triples (possibly memory-mapped).
+   * @param rank Rank parameter to be used for optimization.
+   * @param u Item matrix obtained on decomposition.
+   * @param v User matrix obtained on decomposition.
+   * @param p Item bias.
+   * @param q User bias.
+   */
+  void Apply(const data::RatingTriples& data,
+             const size_t rank,
+             MatType& u,
+             MatType& v,
+             VecType& p,
+             VecType& q);
+
  private:
+  //! Train the model for any type of rating data.
+  template<typename DataType>
+  void ApplyInternal(const DataType& data,
+                     const size_t rank,
+                     MatType& u,
+                     MatType& v,
+                     VecType& p,
+                     VecType& q);
+
   //! Number of optimization iterations.
   size_t iterations;
   //! Learning rate for the SGD optimizer.
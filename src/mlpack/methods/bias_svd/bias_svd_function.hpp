@@ -16,6 +16,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/math/make_alias.hpp>
+#include <mlpack/core/data/rating_triples.hpp>
 #include <ensmallen.hpp>
 
 namespace mlpack {
@@ -25,7 +26,7 @@ namespace mlpack {
  * BiasSVD's objective function, to calculate gradient of parameters with
  * respect to the objective function, etc.
  *
- * @tparam MatType The matrix type of the dataset.
+ * @tparam MatType The matrix type of the dataset (or data::RatingTriples).
  */
 template <typename MatType = arma::mat>
 class BiasSVDFunction
@@ -55,7 +56,7 @@ class BiasSVDFunction
    * @param parameters Parameters(user/item matrices/bias) of the
    *     decomposition.
    */
-  double Evaluate(const MatType& parameters) const;
+  double Evaluate(const arma::mat& parameters) const;
 
   /**
    * Evaluates the cost function for one training example. Useful for the SGD
@@ -66,7 +67,7 @@ class BiasSVDFunction
    * @param start First index of the training examples to be used.
    * @param batchSize Size of batch to evaluate.
    */
-  double Evaluate(const MatType& parameters,
+  double Evaluate(const arma::mat& parameters,
                   const size_t start,
                   const size_t batchSize = 1) const;
 
@@ -78,8 +79,8 @@ class BiasSVDFunction
    *     decomposition.
    * @param gradient Calculated gradient for the parameters.
    */
-  void Gradient(const MatType& parameters,
-                MatType& gradient) const;
+  void Gradient(const arma::mat& parameters,
+                arma::mat& gradient) const;
 
   /**
    * Evaluates the gradient of the cost function over one training example.
@@ -95,13 +96,13 @@ class BiasSVDFunction
    * @param batchSize Size of batch to calculate gradient for.
    */
   template <typename GradType>
-  void Gradient(const MatType& parameters,
+  void Gradient(const arma::mat& parameters,
                 const size_t start,
                 GradType& gradient,
                 const size_t batchSize = 1) const;
 
   //! Return the initial point for the optimization.
-  const MatType& GetInitialPoint() const { return initialPoint; }
+  const arma::mat& GetInitialPoint() const { return initialPoint; }
 
   //! Return the dataset passed into the constructor.
   const MatType& Dataset() const { return data; }
@@ -125,7 +126,7 @@ class BiasSVDFunction
   //! Rating data.  This will be an alias until Shuffle() is called.
   MatType data;
   //! Initial parameter point.
-  MatType initialPoint;
+  arma::mat initialPoint;
   //! Rank used for matrix factorization.
   size_t rank;
   //! Regularization parameter for the optimization.
@@ -136,6 +137,21 @@ class BiasSVDFunction
   size_t numItems;
 };
 
+/**
+ * Run the specialized SGD for BiasSVDFunction; this is the body of the
+ * specializations of ens::StandardSGD::Optimize() below, for any dataset type.
+ *
+ * @param function BiasSVDFunction to optimize.
+ * @param parameters Starting point, and resulting parameters.
+ * @param stepSize Step size of SGD.
+ * @param maxIterations Maximum number of iterations (0 means no limit).
+ */
+template<typename MatType>
+double OptimizeBiasSVD(BiasSVDFunction<MatType>& function,
+                       arma::mat& parameters,
+                       const double stepSize,
+                       const size_t maxIterations);
+
 } // namespace mlpack
 
 namespace ens {
@@ -152,6 +168,12 @@ namespace ens {
       mlpack::BiasSVDFunction<arma::mat>& function,
       arma::mat& parameters);
 
+  template <>
+  template <>
+  inline double StandardSGD::Optimize(
+      mlpack::BiasSVDFunction<mlpack::data::RatingTriples>& function,
+      arma::mat& parameters);
+
   template <>
   template <>
   inline double ParallelSGD<ExponentialBackoff>::Optimize(
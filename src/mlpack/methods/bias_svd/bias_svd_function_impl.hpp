@@ -24,11 +24,21 @@ BiasSVDFunction<MatType>::BiasSVDFunction(const MatType& dataIn,
     rank(rank),
     lambda(lambda)
 {
-  MakeAlias(data, dataIn, dataIn.n_rows, dataIn.n_cols, false);
+  if constexpr (std::is_same<MatType, data::RatingTriples>::value)
+  {
+    // Copies of RatingTriples share the triples.
+    data = dataIn;
+    numUsers = data.NumUsers();
+    numItems = data.NumItems();
+  }
+  else
+  {
+    MakeAlias(data, dataIn, dataIn.n_rows, dataIn.n_cols, false);
 
-  // Number of users and items in the data.
-  numUsers = max(data.row(0)) + 1;
-  numItems = max(data.row(1)) + 1;
+    // Number of users and items in the data.
+    numUsers = max(data.row(0)) + 1;
+    numItems = max(data.row(1)) + 1;
+  }
 
   // Initialize the parameters.
   // The last row in initialPoint saves use/item bias.
@@ -38,18 +48,25 @@ BiasSVDFunction<MatType>::BiasSVDFunction(const MatType& dataIn,
 template<typename MatType>
 void BiasSVDFunction<MatType>::Shuffle()
 {
-  data = data.cols(arma::shuffle(arma::linspace<arma::uvec>(0, data.n_cols - 1,
-      data.n_cols)));
+  if constexpr (std::is_same<MatType, data::RatingTriples>::value)
+  {
+    data.Shuffle();
+  }
+  else
+  {
+    data = data.cols(arma::shuffle(arma::linspace<arma::uvec>(0,
+        data.n_cols - 1, data.n_cols)));
+  }
 }
 
 template <typename MatType>
-double BiasSVDFunction<MatType>::Evaluate(const MatType& parameters) const
+double BiasSVDFunction<MatType>::Evaluate(const arma::mat& parameters) const
 {
   return Evaluate(parameters, 0, data.n_cols);
 }
 
 template <typename MatType>
-double BiasSVDFunction<MatType>::Evaluate(const MatType& parameters,
+double BiasSVDFunction<MatType>::Evaluate(const arma::mat& parameters,
                                           const size_t start,
                                           const size_t batchSize) const
 {
@@ -91,8 +108,8 @@ double BiasSVDFunction<MatType>::Evaluate(const MatType& parameters,
 }
 
 template <typename MatType>
-void BiasSVDFunction<MatType>::Gradient(const MatType& parameters,
-                                        MatType& gradient) const
+void BiasSVDFunction<MatType>::Gradient(const arma::mat& parameters,
+                                        arma::mat& gradient) const
 {
   // For an example with rating corresponding to user 'i' and item 'j', the
   // gradients for the parameters is as follows:
@@ -138,7 +155,7 @@ void BiasSVDFunction<MatType>::Gradient(const MatType& parameters,
 
 template <typename MatType>
 template <typename GradType>
-void BiasSVDFunction<MatType>::Gradient(const MatType& parameters,
+void BiasSVDFunction<MatType>::Gradient(const arma::mat& parameters,
                                         const size_t start,
                                         GradType& gradient,
                                         const size_t batchSize) const
@@ -177,16 +194,11 @@ void BiasSVDFunction<MatType>::Gradient(const MatType& parameters,
   }
 }
 
-} // namespace mlpack
-
-// Template specialization for the SGD optimizer.
-namespace ens {
-
-template <>
-template <>
-double StandardSGD::Optimize(
-    mlpack::BiasSVDFunction<arma::mat>& function,
-    arma::mat& parameters)
+template<typename MatType>
+double OptimizeBiasSVD(BiasSVDFunction<MatType>& function,
+                       arma::mat& parameters,
+                       const double stepSize,
+                       const size_t maxIterations)
 {
   // Find the number of functions to use.
   const size_t numFunctions = function.NumFunctions();
@@ -199,7 +211,7 @@ double StandardSGD::Optimize(
   for (size_t i = 0; i < numFunctions; ++i)
     overallObjective += function.Evaluate(parameters, i);
 
-  const arma::mat data = function.Dataset();
+  const MatType& data = function.Dataset();
 
   // Rank of decomposition.
   const size_t rank = function.Rank();
@@ -255,6 +267,30 @@ double StandardSGD::Optimize(
   return overallObjective;
 }
 
+} // namespace mlpack
+
+// Template specialization for the SGD optimizer.
+namespace ens {
+
+template <>
+template <>
+inline double StandardSGD::Optimize(
+    mlpack::BiasSVDFunction<arma::mat>& function,
+    arma::mat& parameters)
+{
+  return mlpack::OptimizeBiasSVD(function, parameters, stepSize,
+      maxIterations);
+}
+
+template <>
+template <>
+inline double StandardSGD::Optimize(
+    mlpack::BiasSVDFunction<mlpack::data::RatingTriples>& function,
+    arma::mat& parameters)
+{
+  return mlpack::OptimizeBiasSVD(function, parameters, stepSize,
+      maxIterations);
+}
 
 template <>
 template <>
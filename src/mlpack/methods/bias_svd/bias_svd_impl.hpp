@@ -34,6 +34,31 @@ void BiasSVD<OptimizerType, MatType, VecType>::Apply(const MatType& data,
                                                      MatType& v,
                                                      VecType& p,
                                                      VecType& q)
+{
+  ApplyInternal(data, rank, u, v, p, q);
+}
+
+template<typename OptimizerType, typename MatType, typename VecType>
+void BiasSVD<OptimizerType, MatType, VecType>::Apply(
+    const data::RatingTriples& data,
+    const size_t rank,
+    MatType& u,
+    MatType& v,
+    VecType& p,
+    VecType& q)
+{
+  ApplyInternal(data, rank, u, v, p, q);
+}
+
+template<typename OptimizerType, typename MatType, typename VecType>
+template<typename DataType>
+void BiasSVD<OptimizerType, MatType, VecType>::ApplyInternal(
+    const DataType& data,
+    const size_t rank,
+    MatType& u,
+    MatType& v,
+    VecType& p,
+    VecType& q)
 {
   // batchSize is 1 in our implementation of Bias SVD.
   // batchSize other than 1 has not been supported yet.
@@ -42,17 +67,17 @@ void BiasSVD<OptimizerType, MatType, VecType>::Apply(const MatType& data,
       << std::endl;
 
   // Make the optimizer object using a BiasSVDFunction object.
-  BiasSVDFunction<arma::mat> biasSVDFunc(data, rank, lambda);
+  BiasSVDFunction<DataType> biasSVDFunc(data, rank, lambda);
   ens::StandardSGD optimizer(alpha, batchSize,
       iterations * data.n_cols);
 
   // Get optimized parameters.
-  MatType parameters = biasSVDFunc.GetInitialPoint();
+  arma::mat parameters = biasSVDFunc.GetInitialPoint();
   optimizer.Optimize(biasSVDFunc, parameters);
 
   // Constants for extracting user and item matrices.
-  const size_t numUsers = max(data.row(0)) + 1;
-  const size_t numItems = max(data.row(1)) + 1;
+  const size_t numUsers = biasSVDFunc.NumUsers();
+  const size_t numItems = biasSVDFunc.NumItems();
 
   // Extract user and item matrices, user and item bias from the optimized
   // parameters.
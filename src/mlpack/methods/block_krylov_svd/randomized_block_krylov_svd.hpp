@@ -38,6 +38,11 @@ namespace mlpack {
  * }
  * @endcode
  *
+ * The data can be dense or sparse (e.g. `arma::mat`, `arma::fmat`,
+ * `arma::sp_mat`); it is only used in products with dense matrices, so sparse
+ * data is never converted to a dense matrix.  Note that, unlike RandomizedSVD,
+ * the data is not centered.
+ *
  * An example of how to use the interface is shown below:
  *
  * @code
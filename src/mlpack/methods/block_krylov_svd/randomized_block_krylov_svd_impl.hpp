@@ -54,50 +54,104 @@ inline void RandomizedBlockKrylovSVD::Apply(const InMatType& data,
                                             MatType& v,
                                             const size_t rank)
 {
-  MatType Q, R, block, blockIteration;
+  typedef typename MatType::elem_type ElemType;
+  typedef typename InMatType::elem_type InElemType;
 
-  if (blockSize == 0)
+  // All the products are computed in the precision of the output (so that
+  // arma::fmat outputs give a single-precision decomposition); data in another
+  // precision is converted once.
+  if constexpr (!std::is_same<InElemType, ElemType>::value)
   {
-    // The block size cannot be greater than the number of points in the
-    // dataset or the dimensionality of the dataset.
-    blockSize = std::min((size_t) data.n_rows, std::min((size_t) data.n_cols,
-        rank + 10));
+    if constexpr (arma::is_SpMat<InMatType>::value)
+    {
+      data.sync();
+      const arma::Col<InElemType> values(data.values, data.n_nonzero);
+      const arma::SpMat<ElemType> convertedData(
+          arma::uvec(data.row_indices, data.n_nonzero),
+          arma::uvec(data.col_ptrs, data.n_cols + 1),
+          arma::conv_to<arma::Col<ElemType>>::from(values), data.n_rows,
+          data.n_cols);
+      Apply(convertedData, u, s, v, rank);
+    }
+    else
+    {
+      Apply(arma::conv_to<arma::Mat<ElemType>>::from(data), u, s, v, rank);
+    }
+    return;
   }
-
-  // Random block initialization.
-  MatType G = arma::randn<MatType>(data.n_cols, blockSize);
-
-  // Construct and orthonormalize Krylov subspace.
-  MatType K(data.n_rows, blockSize * (maxIterations + 1));
-
-  // Create a working matrix using data from writable auxiliary memory
-  // (K matrix). Doing so avoids an unnecessary copy in upcoming step.
-  MakeAlias(block, K, data.n_rows, blockSize, false);
-  arma::qr_econ(block, R, data * G);
-
-  for (size_t blockOffset = block.n_elem; blockOffset < K.n_elem;
-      blockOffset += block.n_elem)
+  else
   {
-    // Temporary working matrix to store the result in the correct place.
-    MakeAlias(blockIteration, K, block.n_rows, block.n_cols, blockOffset,
-        false);
-
-    arma::qr_econ(blockIteration, R, data * (data.t() * block));
-
-    // Update working matrix for the next iteration.
-    MakeAlias(block, K, block.n_rows, block.n_cols, blockOffset,
-        false);
+    MatType Q, R, block, blockIteration;
+
+    if (blockSize == 0)
+    {
+      // The block size cannot be greater than the number of points in the
+      // dataset or the dimensionality of the dataset.
+      blockSize = std::min((size_t) data.n_rows, std::min((size_t) data.n_cols,
+          rank + 10));
+    }
+
+    // Random block initialization.
+    MatType G = arma::randn<MatType>(data.n_cols, blockSize);
+
+    // Construct and orthonormalize Krylov subspace.
+    MatType K(data.n_rows, blockSize * (maxIterations + 1));
+
+    // The workspaces of the power iterations, allocated once: each iteration
+    // computes data * (data^T * block), without forming data * data^T.
+    // (For sparse data, the transposed product is stored as block^T * data, so
+    // that no transposed copy of the data is built.)
+    MatType transProduct, product(data.n_rows, blockSize);
+
+    // Create a working matrix using data from writable auxiliary memory
+    // (K matrix). Doing so avoids an unnecessary copy in upcoming step.
+    MakeAlias(block, K, data.n_rows, blockSize, false);
+    product = data * G;
+    arma::qr_econ(block, R, product);
+
+    for (size_t blockOffset = block.n_elem; blockOffset < K.n_elem;
+        blockOffset += block.n_elem)
+    {
+      // Temporary working matrix to store the result in the correct place.
+      MakeAlias(blockIteration, K, block.n_rows, block.n_cols, blockOffset,
+          false);
+
+      if constexpr (arma::is_SpMat<InMatType>::value)
+      {
+        DenseTransTimesSparse(block, data, transProduct);
+        SparseTimesDenseTrans(data, transProduct, product);
+      }
+      else
+      {
+        transProduct = data.t() * block;
+        product = data * transProduct;
+      }
+      arma::qr_econ(blockIteration, R, product);
+
+      // Update working matrix for the next iteration.
+      MakeAlias(block, K, block.n_rows, block.n_cols, blockOffset,
+          false);
+    }
+
+    arma::qr_econ(Q, R, K);
+
+    // Approximate eigenvalues and eigenvectors using Rayleigh-Ritz method.
+    if constexpr (arma::is_SpMat<InMatType>::value)
+    {
+      MatType projection;
+      DenseTransTimesSparse(Q, data, projection);
+      arma::svd_econ(u, s, v, projection);
+    }
+    else
+    {
+      arma::svd_econ(u, s, v, Q.t() * data);
+    }
+
+    // Do economical singular value decomposition and compute only the
+    // approximations of the left singular vectors by using the centered data
+    // applied to Q.
+    u = Q * u;
   }
-
-  arma::qr_econ(Q, R, K);
-
-  // Approximate eigenvalues and eigenvectors using Rayleigh-Ritz method.
-  arma::svd_econ(u, s, v, Q.t() * data);
-
-  // Do economical singular value decomposition and compute only the
-  // approximations of the left singular vectors by using the centered data
-  // applied to Q.
-  u = Q * u;
 }
 
 } // namespace mlpack
@@ -24,6 +24,7 @@
 #include "normalization/normalization.hpp"
 #include "decomposition_policies/decomposition_policies.hpp"
 #include "neighbor_search_policies/neighbor_search_policies.hpp"
+#include "item_search_policies/item_search_policies.hpp"
 #include "interpolation_policies/interpolation_policies.hpp"
 
 namespace mlpack {
@@ -213,6 +214,59 @@ class CFType
                           arma::Mat<size_t>& recommendations,
                           const arma::Col<size_t>& users);
 
+  /**
+   * Generates the given number of recommendations for all users, by searching
+   * for the items with the largest inner products between their item factors
+   * and the interpolated user factors (see the GetItemFactors() and
+   * GetWeightedUserFactors() methods of the decomposition policy), instead of
+   * computing the ratings of all items.  With an item search policy that is
+   * sublinear in the number of items (like FastMKSItemSearch), this is much
+   * faster than GetRecommendations() for large numbers of items.
+   *
+   * The items are ranked by normalized rating.  For normalizations that do
+   * not depend on the item (all but ItemMeanNormalization), the
+   * recommendations are the same as the recommendations of
+   * GetRecommendations(), up to ties.
+   *
+   * @tparam ItemSearchPolicy The policy used to search for the items with the
+   *     largest inner products.
+   * @tparam NeighborSearchPolicy The policy used to search neighbors of
+   *     query set in referece set.
+   * @tparam InterpolationPolicy The policy used to calculate interpolation
+   *     weights.
+   *
+   * @param numRecs Number of Recommendations.
+   * @param recommendations Matrix to save recommendations into.
+   */
+  template<typename ItemSearchPolicy = FastMKSItemSearch,
+           typename NeighborSearchPolicy = EuclideanSearch,
+           typename InterpolationPolicy = AverageInterpolation>
+  void SearchRecommendations(const size_t numRecs,
+                             arma::Mat<size_t>& recommendations);
+
+  /**
+   * Generates the given number of recommendations for the specified users by
+   * searching the item factors; see the other overload of
+   * SearchRecommendations().
+   *
+   * @tparam ItemSearchPolicy The policy used to search for the items with the
+   *     largest inner products.
+   * @tparam NeighborSearchPolicy The policy used to search neighbors of
+   *     query set in referece set.
+   * @tparam InterpolationPolicy The policy used to calculate interpolation
+   *     weights.
+   *
+   * @param numRecs Number of Recommendations.
+   * @param recommendations Matrix to save recommendations.
+   * @param users Users for which recommendations are to be generated.
+   */
+  template<typename ItemSearchPolicy = FastMKSItemSearch,
+           typename NeighborSearchPolicy = EuclideanSearch,
+           typename InterpolationPolicy = AverageInterpolation>
+  void SearchRecommendations(const size_t numRecs,
+                             arma::Mat<size_t>& recommendations,
+                             const arma::Col<size_t>& users);
+
   //! Converts the User, Item, Value Matrix to User-Item Table.
   static void CleanData(const arma::mat& data, arma::sp_mat& cleanedData);
 
@@ -271,6 +325,21 @@ class CFType
   //! Data normalization object.
   NormalizationType normalization;
 
+  /**
+   * Compute the neighborhoods of the given users and the interpolation weights
+   * of the neighbors.  Note that the query user is part of the
+   * neighborhood---this is intentional.
+   *
+   * @param users Users whose neighborhoods are computed.
+   * @param neighborhood Resulting neighborhoods, one column for each user.
+   * @param weights Resulting interpolation weights, one column for each user.
+   */
+  template<typename NeighborSearchPolicy,
+           typename InterpolationPolicy>
+  void GetNeighborhoodWeights(const arma::Col<size_t>& users,
+                              arma::Mat<size_t>& neighborhood,
+                              arma::mat& weights) const;
+
   //! Candidate represents a possible recommendation (value, item).
   typedef std::pair<double, size_t> Candidate;
 
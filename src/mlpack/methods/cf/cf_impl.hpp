@@ -180,91 +180,218 @@ GetRecommendations(const size_t numRecs,
                    arma::Mat<size_t>& recommendations,
                    const arma::Col<size_t>& users)
 {
-  // Temporary storage for neighborhood of the queried users.
+  // Calculate the neighborhood of the queried users and the interpolation
+  // weights.
   arma::Mat<size_t> neighborhood;
-  // Resulting similarities.
-  arma::mat similarities;
-
-  // Calculate the neighborhood of the queried users.  Note that the query user
-  // is part of the neighborhood---this is intentional.  We want to use the
-  // weighted sum of both the query user and the local neighborhood of the
-  // query user.
-  // Calculate the neighborhood of the queried users.
-  decomposition.template GetNeighborhood<NeighborSearchPolicy>(
-      users, numUsersForSimilarity, neighborhood, similarities);
+  arma::mat weights;
+  GetNeighborhoodWeights<NeighborSearchPolicy, InterpolationPolicy>(users,
+      neighborhood, weights);
 
   // Generate recommendations for each query user by finding the maximum numRecs
-  // elements in the ratings vector.
+  // elements in the ratings vector.  The ratings of a block of users are
+  // computed together with one matrix product, and blocks are handled in
+  // parallel; the size of the block keeps the ratings matrix of each block
+  // (items x users) at roughly 32MB.
   recommendations.set_size(numRecs, users.n_elem);
-  arma::mat values(numRecs, users.n_elem);
   recommendations.fill(SIZE_MAX);
-  values.fill(DBL_MAX);
+  const size_t blockSize = std::max((size_t) 1,
+      ((size_t) 1 << 22) / std::max((size_t) 1, (size_t) cleanedData.n_rows));
+  const size_t numBlocks = (users.n_elem + blockSize - 1) / blockSize;
+  std::vector<char> incomplete(users.n_elem, 0);
 
-  // Initialization of an InterpolationPolicy object should be put ahead of the
-  // following loop, because the initialization may takes a relatively long
-  // time and we don't want to repeat the initialization process in each loop.
-  InterpolationPolicy interpolation(cleanedData);
-
-  for (size_t i = 0; i < users.n_elem; ++i)
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t b = 0; b < numBlocks; ++b)
   {
-    // First, calculate the weighted sum of neighborhood values.
-    arma::vec ratings;
-    ratings.zeros(cleanedData.n_rows);
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) users.n_elem) - 1;
 
-    // Calculate interpolation weights.
-    arma::vec weights(numUsersForSimilarity);
-    interpolation.GetWeights(weights, decomposition, users(i),
-        neighborhood.col(i), similarities.col(i), cleanedData);
+    // First, calculate the weighted sum of neighborhood values.
+    arma::mat ratings;
+    decomposition.GetWeightedRatings(neighborhood.cols(begin, end),
+        weights.cols(begin, end), ratings);
 
-    for (size_t j = 0; j < neighborhood.n_rows; ++j)
+    for (size_t i = begin; i <= end; ++i)
     {
-      arma::vec neighborRatings;
-      decomposition.GetRatingOfUser(neighborhood(j, i), neighborRatings);
-      ratings += weights(j) * neighborRatings;
-    }
-
-    // Let's build the list of candidate recomendations for the given user.
-    // Default candidate: the smallest possible value and invalid item number.
-    const Candidate def = std::make_pair(-DBL_MAX, cleanedData.n_rows);
-    std::vector<Candidate> vect(numRecs, def);
-    typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
-        CandidateList;
-    CandidateList pqueue(CandidateCmp(), std::move(vect));
+      // Let's build the list of candidate recomendations for the given user.
+      // Default candidate: the smallest possible value and invalid item number.
+      const Candidate def = std::make_pair(-DBL_MAX, cleanedData.n_rows);
+      std::vector<Candidate> vect(numRecs, def);
+      typedef std::priority_queue<Candidate, std::vector<Candidate>,
+          CandidateCmp> CandidateList;
+      CandidateList pqueue(CandidateCmp(), std::move(vect));
+
+      // Look through the ratings column corresponding to the current user.
+      // The items the user already rated are the nonzero elements of the
+      // user's column, in increasing order; the algorithm omits rating of zero,
+      // so when normalizing original ratings in Normalize(), if normalized
+      // rating equals zero, it is set to the smallest positive double value.
+      arma::sp_mat::const_iterator it = cleanedData.begin_col(users(i));
+      arma::sp_mat::const_iterator itEnd = cleanedData.end_col(users(i));
+      const double* userRatings = ratings.colptr(i - begin);
+      for (size_t j = 0; j < ratings.n_rows; ++j)
+      {
+        // Ensure that the user hasn't already rated the item.
+        if (it != itEnd && it.row() == j)
+        {
+          ++it;
+          continue; // The user already rated the item.
+        }
+
+        // Is the estimated value better than the worst candidate?
+        // Denormalize rating before comparison.
+        double realRating = normalization.Denormalize(users(i), j,
+            userRatings[j]);
+        if (realRating > pqueue.top().first)
+        {
+          Candidate c = std::make_pair(realRating, j);
+          pqueue.pop();
+          pqueue.push(c);
+        }
+      }
 
-    // Look through the ratings column corresponding to the current user.
-    for (size_t j = 0; j < ratings.n_rows; ++j)
-    {
-      // Ensure that the user hasn't already rated the item.
-      // The algorithm omits rating of zero. Thus, when normalizing original
-      // ratings in Normalize(), if normalized rating equals zero, it is set
-      // to the smallest positive double value.
-      if (cleanedData(j, users(i)) != 0.0)
-        continue; // The user already rated the item.
-
-      // Is the estimated value better than the worst candidate?
-      // Denormalize rating before comparison.
-      double realRating = normalization.Denormalize(users(i), j, ratings[j]);
-      if (realRating > pqueue.top().first)
+      for (size_t p = 1; p <= numRecs; p++)
       {
-        Candidate c = std::make_pair(realRating, j);
+        recommendations(numRecs - p, i) = pqueue.top().second;
         pqueue.pop();
-        pqueue.push(c);
       }
+
+      if (recommendations(numRecs - 1, i) == def.second)
+        incomplete[i] = 1;
     }
+  }
+
+  // If we were not able to come up with enough recommendations, issue a
+  // warning.
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    if (incomplete[i])
+      Log::Warn << "Could not provide " << numRecs << " recommendations "
+          << "for user " << users(i) << " (not enough un-rated items)!"
+          << std::endl;
+  }
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename ItemSearchPolicy,
+         typename NeighborSearchPolicy,
+         typename InterpolationPolicy>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+SearchRecommendations(const size_t numRecs,
+                      arma::Mat<size_t>& recommendations)
+{
+  // Generate list of users.
+  arma::Col<size_t> users = arma::linspace<arma::Col<size_t> >(0,
+      cleanedData.n_cols - 1, cleanedData.n_cols);
+
+  // Call the main overload for recommendations.
+  SearchRecommendations<ItemSearchPolicy,
+                        NeighborSearchPolicy,
+                        InterpolationPolicy>(numRecs, recommendations, users);
+}
 
-    for (size_t p = 1; p <= numRecs; p++)
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename ItemSearchPolicy,
+         typename NeighborSearchPolicy,
+         typename InterpolationPolicy>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+SearchRecommendations(const size_t numRecs,
+                      arma::Mat<size_t>& recommendations,
+                      const arma::Col<size_t>& users)
+{
+  // Calculate the neighborhood of the queried users and the interpolation
+  // weights.
+  arma::Mat<size_t> neighborhood;
+  arma::mat weights;
+  GetNeighborhoodWeights<NeighborSearchPolicy, InterpolationPolicy>(users,
+      neighborhood, weights);
+
+  // The interpolated rating of an item is, up to a value that is the same for
+  // all items, the inner product of the item factors and the weighted user
+  // factors; so, the best items are the items with the largest inner products.
+  arma::mat itemFactors, userFactors;
+  decomposition.GetItemFactors(itemFactors);
+  decomposition.GetWeightedUserFactors(neighborhood, weights, userFactors);
+
+  // Items that the user already rated are skipped, so search for enough items
+  // that numRecs are left for every user.
+  size_t maxRated = 0;
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    maxRated = std::max(maxRated,
+        (size_t) cleanedData.col(users(i)).n_nonzero);
+  }
+  const size_t k = std::min(numRecs + maxRated, (size_t) itemFactors.n_cols);
+
+  ItemSearchPolicy itemSearch(itemFactors);
+  arma::Mat<size_t> items;
+  arma::mat products;
+  itemSearch.Search(userFactors, k, items, products);
+
+  recommendations.set_size(numRecs, users.n_elem);
+  recommendations.fill(SIZE_MAX);
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    // Take the best items that the user hasn't already rated.
+    size_t found = 0;
+    for (size_t j = 0; j < k && found < numRecs; ++j)
     {
-      recommendations(numRecs - p, i) = pqueue.top().second;
-      values(numRecs - p, i) = pqueue.top().first;
-      pqueue.pop();
+      if (items(j, i) == SIZE_MAX || cleanedData(items(j, i), users(i)) != 0.0)
+        continue;
+
+      recommendations(found++, i) = items(j, i);
     }
 
     // If we were not able to come up with enough recommendations, issue a
     // warning.
-    if (recommendations(numRecs - 1, i) == def.second)
+    if (found < numRecs)
+    {
+      for (; found < numRecs; ++found)
+        recommendations(found, i) = cleanedData.n_rows;
+
       Log::Warn << "Could not provide " << numRecs << " recommendations "
           << "for user " << users(i) << " (not enough un-rated items)!"
           << std::endl;
+    }
+  }
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename NeighborSearchPolicy,
+         typename InterpolationPolicy>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+GetNeighborhoodWeights(const arma::Col<size_t>& users,
+                       arma::Mat<size_t>& neighborhood,
+                       arma::mat& weights) const
+{
+  // Resulting similarities.
+  arma::mat similarities;
+
+  // Calculate the neighborhood of the queried users.  Note that the query user
+  // is part of the neighborhood---this is intentional.  We want to use the
+  // weighted sum of both the query user and the local neighborhood of the
+  // query user.
+  // Calculate the neighborhood of the queried users.
+  decomposition.template GetNeighborhood<NeighborSearchPolicy>(
+      users, numUsersForSimilarity, neighborhood, similarities);
+
+  // Initialization of an InterpolationPolicy object should be put ahead of the
+  // following loop, because the initialization may takes a relatively long
+  // time and we don't want to repeat the initialization process in each loop.
+  InterpolationPolicy interpolation(cleanedData);
+
+  // Calculate interpolation weights.  The interpolation policy may keep state
+  // between calls, so this is done on one thread.
+  weights.set_size(numUsersForSimilarity, users.n_elem);
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    interpolation.GetWeights(weights.col(i), decomposition, users(i),
+        neighborhood.col(i), similarities.col(i), cleanedData);
   }
 }
 
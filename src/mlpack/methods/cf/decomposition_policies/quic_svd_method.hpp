@@ -107,6 +107,55 @@ class QUIC_SVDPolicy
     rating = w * h.col(user);
   }
 
+  /**
+   * Get the weighted sums of the predicted ratings of groups of users.  Column
+   * i of the result is the sum over j of weights(j, i) times the predicted
+   * ratings of user users(j, i).
+   *
+   * @param users Users of each group; each column is one group.
+   * @param weights Weight of each user in each group.
+   * @param ratings Resulting rating matrix, with one column for each group.
+   */
+  void GetWeightedRatings(const arma::Mat<size_t>& users,
+                          const arma::mat& weights,
+                          arma::mat& ratings) const
+  {
+    // The ratings are linear in the user vectors, so the user vectors of each
+    // group are combined first, and the ratings of all groups are computed
+    // with one product.
+    arma::mat combined;
+    GetWeightedUserFactors(users, weights, combined);
+    ratings = w * combined;
+  }
+
+  /**
+   * Get the item factors, with one column for each item.  For any group of
+   * users, the inner products of the item factors with the weighted user
+   * factors of the group (see GetWeightedUserFactors()) are the weighted
+   * ratings of the group (see GetWeightedRatings()), up to a value that is the
+   * same for all items; so, they can be used to search for the items with the
+   * highest ratings.
+   *
+   * @param factors Resulting item factors.
+   */
+  void GetItemFactors(arma::mat& factors) const { factors = w.t(); }
+
+  /**
+   * Get the weighted user factors of groups of users; see GetItemFactors().
+   *
+   * @param users Users of each group; each column is one group.
+   * @param weights Weight of each user in each group.
+   * @param factors Resulting user factors, with one column for each group.
+   */
+  void GetWeightedUserFactors(const arma::Mat<size_t>& users,
+                              const arma::mat& weights,
+                              arma::mat& factors) const
+  {
+    factors.set_size(h.n_rows, users.n_cols);
+    for (size_t i = 0; i < users.n_cols; ++i)
+      factors.col(i) = h.cols(users.col(i)) * weights.col(i);
+  }
+
   /**
    * Get the neighborhood and corresponding similarities for a set of users.
    *
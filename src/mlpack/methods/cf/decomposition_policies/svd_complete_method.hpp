@@ -43,6 +43,18 @@ namespace mlpack {
 class SVDCompletePolicy
 {
  public:
+  /**
+   * Create the SVDCompletePolicy object.
+   *
+   * @param parallel If true, use SVDParallelIncrementalLearning, which
+   *     processes independent blocks of ratings in parallel; then, each
+   *     iteration is one pass over all the ratings.
+   */
+  SVDCompletePolicy(const bool parallel = false) : parallel(parallel)
+  {
+    /* Nothing to do here */
+  }
+
   /**
    * Apply Collaborative Filtering to the provided data set using the
    * SVD complete incremental policy.
@@ -63,7 +75,29 @@ class SVDCompletePolicy
              const double minResidue,
              const bool mit)
   {
-    if (mit)
+    if (parallel)
+    {
+      // The parallel rule makes a whole pass over the ratings at each
+      // iteration, so the termination policy is not wrapped.
+      SVDParallelIncrementalLearning update(0.0001, 0, 0, true);
+      if (mit)
+      {
+        AMF<MaxIterationTermination, RandomAMFInitialization,
+            SVDParallelIncrementalLearning> svdpi(
+            MaxIterationTermination(maxIterations), RandomAMFInitialization(),
+            update);
+        svdpi.Apply(cleanedData, rank, w, h);
+      }
+      else
+      {
+        AMF<SimpleResidueTermination, RandomAcolInitialization<>,
+            SVDParallelIncrementalLearning> svdpi(
+            SimpleResidueTermination(minResidue, maxIterations),
+            RandomAcolInitialization<>(), update);
+        svdpi.Apply(cleanedData, rank, w, h);
+      }
+    }
+    else if (mit)
     {
       MaxIterationTermination iter(maxIterations);
 
@@ -109,6 +143,55 @@ class SVDCompletePolicy
     rating = w * h.col(user);
   }
 
+  /**
+   * Get the weighted sums of the predicted ratings of groups of users.  Column
+   * i of the result is the sum over j of weights(j, i) times the predicted
+   * ratings of user users(j, i).
+   *
+   * @param users Users of each group; each column is one group.
+   * @param weights Weight of each user in each group.
+   * @param ratings Resulting rating matrix, with one column for each group.
+   */
+  void GetWeightedRatings(const arma::Mat<size_t>& users,
+                          const arma::mat& weights,
+                          arma::mat& ratings) const
+  {
+    // The ratings are linear in the user vectors, so the user vectors of each
+    // group are combined first, and the ratings of all groups are computed
+    // with one product.
+    arma::mat combined;
+    GetWeightedUserFactors(users, weights, combined);
+    ratings = w * combined;
+  }
+
+  /**
+   * Get the item factors, with one column for each item.  For any group of
+   * users, the inner products of the item factors with the weighted user
+   * factors of the group (see GetWeightedUserFactors()) are the weighted
+   * ratings of the group (see GetWeightedRatings()), up to a value that is the
+   * same for all items; so, they can be used to search for the items with the
+   * highest ratings.
+   *
+   * @param factors Resulting item factors.
+   */
+  void GetItemFactors(arma::mat& factors) const { factors = w.t(); }
+
+  /**
+   * Get the weighted user factors of groups of users; see GetItemFactors().
+   *
+   * @param users Users of each group; each column is one group.
+   * @param weights Weight of each user in each group.
+   * @param factors Resulting user factors, with one column for each group.
+   */
+  void GetWeightedUserFactors(const arma::Mat<size_t>& users,
+                              const arma::mat& weights,
+                              arma::mat& factors) const
+  {
+    factors.set_size(h.n_rows, users.n_cols);
+    for (size_t i = 0; i < users.n_cols; ++i)
+      factors.col(i) = h.cols(users.col(i)) * weights.col(i);
+  }
+
   /**
    * Get the neighborhood and corresponding similarities for a set of users.
    *
@@ -148,6 +231,11 @@ class SVDCompletePolicy
         query, numUsersForSimilarity, neighborhood, similarities);
   }
 
+  //! Get whether the ratings are processed in parallel.
+  bool Parallel() const { return parallel; }
+  //! Modify whether the ratings are processed in parallel.
+  bool& Parallel() { return parallel; }
+
   //! Get the Item Matrix.
   const arma::mat& W() const { return w; }
   //! Get the User Matrix.
@@ -164,6 +252,8 @@ class SVDCompletePolicy
   }
 
  private:
+  //! Whether the ratings are processed in parallel.
+  bool parallel;
   //! Item matrix.
   arma::mat w;
   //! User matrix.
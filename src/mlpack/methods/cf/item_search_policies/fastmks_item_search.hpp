@@ -0,0 +1,68 @@
+/**
+ * @file methods/cf/item_search_policies/fastmks_item_search.hpp
+ *
+ * Maximum inner product search over item factors with FastMKS.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_CF_ITEM_SEARCH_POLICIES_FASTMKS_ITEM_SEARCH_HPP
+#define MLPACK_METHODS_CF_ITEM_SEARCH_POLICIES_FASTMKS_ITEM_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/fastmks/fastmks.hpp>
+#include <mlpack/core/kernels/linear_kernel.hpp>
+
+namespace mlpack {
+
+/**
+ * Maximum inner product search over item factors, with FastMKS and the linear
+ * kernel.  The item factors are indexed with a cover tree once, and each search
+ * is then typically sublinear in the number of items.
+ *
+ * An example of how to use FastMKSItemSearch in CF is shown below:
+ *
+ * @code
+ * extern arma::mat data; // data is a (user, item, rating) table.
+ * arma::Mat<size_t> recommendations; // Resulting recommendations.
+ *
+ * CFType<> cf(data);
+ *
+ * // Generate 10 recommendations for all users.
+ * cf.template SearchRecommendations<FastMKSItemSearch>(10, recommendations);
+ * @endcode
+ */
+class FastMKSItemSearch
+{
+ public:
+  /**
+   * @param itemFactors Item factors; each column is one item.
+   */
+  FastMKSItemSearch(const arma::mat& itemFactors) : fastmks(itemFactors)
+  { }
+
+  /**
+   * Given a set of query user factors, find the k items with the largest
+   * inner products for each query, and return the inner products.
+   *
+   * @param query A set of query user factors.
+   * @param k Number of items to search.
+   * @param items Items with the largest inner products, in decreasing order.
+   * @param products Inner products of the query and the items.
+   */
+  void Search(const arma::mat& query, const size_t k,
+              arma::Mat<size_t>& items, arma::mat& products)
+  {
+    fastmks.Search(query, k, items, products);
+  }
+
+ private:
+  //! FastMKS object.
+  FastMKS<LinearKernel> fastmks;
+};
+
+} // namespace mlpack
+
+#endif
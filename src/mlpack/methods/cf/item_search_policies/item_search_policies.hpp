@@ -0,0 +1,16 @@
+/**
+ * @file methods/cf/item_search_policies/item_search_policies.hpp
+ *
+ * Convenience include for all item search policies implemented for CF.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_CF_ITEM_SEARCH_POLICIES_ITEM_SEARCH_POLICIES_HPP
+#define MLPACK_METHODS_CF_ITEM_SEARCH_POLICIES_ITEM_SEARCH_POLICIES_HPP
+
+#include "fastmks_item_search.hpp"
+
+#endif
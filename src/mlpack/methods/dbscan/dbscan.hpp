@@ -15,6 +15,7 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/methods/range_search/range_search.hpp>
+#include <mlpack/methods/range_search/grid_range_search.hpp>
 #include <mlpack/methods/emst/union_find.hpp>
 #include "random_point_selection.hpp"
 #include "ordered_point_selection.hpp"
@@ -42,6 +43,19 @@ namespace mlpack {
  * range search technique used and the point selection strategy by means of
  * template parameters.
  *
+ * For low-dimensional data (such as geospatial coordinates), GridRangeSearch
+ * can be used as the RangeSearchType instead of a tree-based RangeSearch.
+ *
+ * In parallel mode, the core points are first found with one counting range
+ * search (RangeSearchType::Count()), and then the neighborhoods of the core
+ * points are searched in blocks (with the CSR overload of
+ * RangeSearchType::Search()) and merged with a lock-free ConcurrentUnionFind
+ * by all OpenMP threads.  Each non-core point joins the cluster of the core
+ * point with the smallest index in its neighborhood, so the point selection
+ * policy is not used and the result does not depend on the number of threads.
+ * The range searches themselves run in parallel when the RangeSearchType uses
+ * single-tree or naive search.
+ *
  * @tparam RangeSearchType Class to use for range searching.
  * @tparam PointSelectionPolicy Strategy for selecting next point to cluster
  *      with.
@@ -55,6 +69,10 @@ class DBSCAN
   typedef typename RangeSearchType::Mat MatType;
   //! Easy access to Element Type of the matrix.
   typedef typename RangeSearchType::Mat::elem_type ElemType;
+
+  //! Number of core points whose neighborhoods are searched at once in
+  //! parallel mode.
+  static constexpr size_t CoreBlockSize = 65536;
   /**
    * Construct the DBSCAN object with the given parameters.  The batchMode
    * parameter should be set to false in the case where RAM issues will be
@@ -67,12 +85,15 @@ class DBSCAN
    * @param batchMode If true, all points are searched in batch.
    * @param rangeSearch Optional instantiated RangeSearch object.
    * @param pointSelector OptionL instantiated PointSelectionPolicy object.
+   * @param parallel If true, cluster in parallel mode (see the class
+   *     documentation); batchMode and pointSelector are then ignored.
    */
   DBSCAN(const ElemType epsilon,
          const size_t minPoints,
          const bool batchMode = true,
          RangeSearchType rangeSearch = RangeSearchType(),
-         PointSelectionPolicy pointSelector = PointSelectionPolicy());
+         PointSelectionPolicy pointSelector = PointSelectionPolicy(),
+         const bool parallel = false);
 
   /**
    * Performs DBSCAN clustering on the data, returning number of clusters
@@ -122,6 +143,9 @@ class DBSCAN
   //! Whether or not to perform the search in batch mode.  If false, single
   bool batchMode;
 
+  //! Whether or not to cluster in parallel mode.
+  bool parallel;
+
   //! Instantiated range search policy.
   RangeSearchType rangeSearch;
 
@@ -150,6 +174,16 @@ class DBSCAN
    * @param uf UnionFind structure that will be modified.
    */
   void BatchCluster(const MatType& data, UnionFind& uf);
+
+  /**
+   * Performs DBSCAN clustering on the data with all threads: count the
+   * neighbors of every point to find the core points, then search the
+   * neighborhoods of the core points in blocks and union them concurrently.
+   *
+   * @param data Dataset to cluster.
+   * @param uf ConcurrentUnionFind structure that will be modified.
+   */
+  void ParallelCluster(const MatType& data, ConcurrentUnionFind& uf);
 };
 
 } // namespace mlpack
@@ -25,10 +25,12 @@ DBSCAN<RangeSearchType, PointSelectionPolicy>::DBSCAN(
     const size_t minPoints,
     const bool batchMode,
     RangeSearchType rangeSearch,
-    PointSelectionPolicy pointSelector) :
+    PointSelectionPolicy pointSelector,
+    const bool parallel) :
     epsilon(epsilon),
     minPoints(minPoints),
     batchMode(batchMode),
+    parallel(parallel),
     rangeSearch(rangeSearch),
     pointSelector(pointSelector)
 {
@@ -96,19 +98,33 @@ size_t DBSCAN<RangeSearchType, PointSelectionPolicy>::Cluster(
     const MatType& data,
     arma::Row<size_t>& assignments)
 {
-  // Initialize the UnionFind object.
-  UnionFind uf(data.n_cols);
   rangeSearch.Train(data);
+  assignments.set_size(data.n_cols);
+
+  if (parallel)
+  {
+    ConcurrentUnionFind uf(data.n_cols);
+    ParallelCluster(data, uf);
 
-  if (batchMode)
-    BatchCluster(data, uf);
+    // Now set assignments.
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < (size_t) data.n_cols; ++i)
+      assignments[i] = uf.Find(i);
+  }
   else
-    PointwiseCluster(data, uf);
+  {
+    // Initialize the UnionFind object.
+    UnionFind uf(data.n_cols);
 
-  // Now set assignments.
-  assignments.set_size(data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
-    assignments[i] = uf.Find(i);
+    if (batchMode)
+      BatchCluster(data, uf);
+    else
+      PointwiseCluster(data, uf);
+
+    // Now set assignments.
+    for (size_t i = 0; i < data.n_cols; ++i)
+      assignments[i] = uf.Find(i);
+  }
 
   // Get a count of all clusters.
   const size_t numClusters = max(assignments) + 1;
@@ -267,6 +283,89 @@ void DBSCAN<RangeSearchType, PointSelectionPolicy>::BatchCluster(
   }
 }
 
+/**
+ * Performs DBSCAN clustering on the data with all threads.  Core points are
+ * found with a counting range search, and the neighborhoods of the core points
+ * are then searched in blocks and merged concurrently.
+ */
+template<typename RangeSearchType, typename PointSelectionPolicy>
+void DBSCAN<RangeSearchType, PointSelectionPolicy>::ParallelCluster(
+    const MatType& data,
+    ConcurrentUnionFind& uf)
+{
+  const RangeType<ElemType> range(ElemType(0.0), epsilon);
+
+  // The monochromatic count does not include the point itself, so core points
+  // have at least `minPoints - 1` neighbors.
+  Log::Info << "Counting neighbors of each point." << std::endl;
+  arma::Col<size_t> counts;
+  rangeSearch.Count(range, counts);
+
+  std::vector<char> core(data.n_cols, 0);
+  std::vector<size_t> corePoints;
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    if (counts[i] + 1 >= minPoints)
+    {
+      core[i] = 1;
+      corePoints.push_back(i);
+    }
+  }
+  Log::Info << corePoints.size() << " core points found." << std::endl;
+
+  // For each non-core point, the core point with the smallest index that has it
+  // in its neighborhood.
+  std::vector<std::atomic<size_t>> borderOwners(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    borderOwners[i].store(SIZE_MAX, std::memory_order_relaxed);
+
+  arma::Col<size_t> offsets, neighbors;
+  arma::Col<ElemType> distances;
+  for (size_t begin = 0; begin < corePoints.size(); begin += CoreBlockSize)
+  {
+    const size_t end = std::min(begin + CoreBlockSize, corePoints.size());
+    arma::uvec blockIndices(end - begin);
+    for (size_t i = begin; i < end; ++i)
+      blockIndices[i - begin] = corePoints[i];
+
+    // The results include the query point itself, which does no harm.
+    const MatType block = data.cols(blockIndices);
+    rangeSearch.Search(block, range, offsets, neighbors, distances);
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (size_t q = 0; q < end - begin; ++q)
+    {
+      const size_t point = corePoints[begin + q];
+      for (size_t n = offsets[q]; n < offsets[q + 1]; ++n)
+      {
+        const size_t neighbor = neighbors[n];
+        if (core[neighbor])
+        {
+          // Both core points will see each other; only one needs to union.
+          if (neighbor > point)
+            uf.Union(point, neighbor);
+        }
+        else
+        {
+          size_t owner = borderOwners[neighbor].load(std::memory_order_relaxed);
+          while (point < owner && !borderOwners[neighbor].compare_exchange_weak(
+              owner, point, std::memory_order_relaxed)) { }
+        }
+      }
+    }
+  }
+
+  // Now add each non-core point to the cluster of its owner.  Non-core points
+  // without an owner are noise.
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < (size_t) data.n_cols; ++i)
+  {
+    const size_t owner = borderOwners[i].load(std::memory_order_relaxed);
+    if (owner != SIZE_MAX)
+      uf.Union(owner, i);
+  }
+}
+
 } // namespace mlpack
 
 #endif
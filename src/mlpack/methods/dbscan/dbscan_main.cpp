@@ -54,10 +54,21 @@ BINDING_LONG_DESC(
     PRINT_PARAM_STRING("naive") + " parameters.  " +
     PRINT_PARAM_STRING("tree_type") + " can control the type of tree used for "
     "range search; this can take a variety of values: 'kd', 'r', 'r-star', 'x',"
-    " 'hilbert-r', 'r-plus', 'r-plus-plus', 'cover', 'ball'. The " +
+    " 'hilbert-r', 'r-plus', 'r-plus-plus', 'cover', 'ball', 'grid'.  'grid' "
+    "uses a uniform grid instead of a tree, which is usually faster for "
+    "low-dimensional data such as 2-D or 3-D coordinates.  The " +
     PRINT_PARAM_STRING("single_mode") + " parameter will force single-tree "
     "search (as opposed to the default dual-tree search), and '" +
-    PRINT_PARAM_STRING("naive") + " will force brute-force range search.");
+    PRINT_PARAM_STRING("naive") + " will force brute-force range search."
+    "\n\n"
+    "If the " + PRINT_PARAM_STRING("parallel") + " flag is set, the clustering "
+    "is done with all available threads; each point that is not a core point "
+    "then joins the cluster of the lowest-index core point in its "
+    "neighborhood, and " + PRINT_PARAM_STRING("selection_type") + " is "
+    "ignored.  This works best together with " +
+    PRINT_PARAM_STRING("single_mode") + ", " + PRINT_PARAM_STRING("naive") +
+    ", or the 'grid' tree type, since then the range searches are also "
+    "parallel.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -85,13 +96,25 @@ PARAM_INT_IN("min_size", "Minimum number of points for a cluster.", "m", 5);
 
 PARAM_STRING_IN("tree_type", "If using single-tree or dual-tree search, the "
     "type of tree to use ('kd', 'r', 'r-star', 'x', 'hilbert-r', 'r-plus', "
-    "'r-plus-plus', 'cover', 'ball').", "t", "kd");
+    "'r-plus-plus', 'cover', 'ball', 'grid').", "t", "kd");
 PARAM_STRING_IN("selection_type", "If using point selection policy, the "
     "type of selection to use ('ordered', 'random').", "s", "ordered");
 PARAM_FLAG("single_mode", "If set, single-tree range search (not dual-tree) "
     "will be used.", "S");
 PARAM_FLAG("naive", "If set, brute-force range search (not tree-based) "
     "will be used.", "N");
+PARAM_FLAG("parallel", "If set, cluster with all available threads.", "P");
+
+// Use single-tree search.  GridRangeSearch has no tree, so there is nothing to
+// set.
+template<typename RangeSearchType>
+void SetSingleMode(RangeSearchType& rs)
+{
+  rs.SingleMode() = true;
+}
+
+template<typename MatType>
+void SetSingleMode(GridRangeSearch<MatType>& /* rs */) { }
 
 // Actually run the clustering, and process the output.
 template<typename RangeSearchType, typename PointSelectionPolicy>
@@ -100,7 +123,7 @@ void RunDBSCAN(util::Params& params,
                PointSelectionPolicy pointSelector = PointSelectionPolicy())
 {
   if (params.Has("single_mode"))
-    rs.SingleMode() = true;
+    SetSingleMode(rs);
 
   // Load dataset.
   arma::mat dataset = std::move(params.Get<arma::mat>("input"));
@@ -109,7 +132,7 @@ void RunDBSCAN(util::Params& params,
   arma::Row<size_t> assignments;
 
   DBSCAN<RangeSearchType, PointSelectionPolicy> d(epsilon, minSize,
-      !params.Has("single_mode"), rs, pointSelector);
+      !params.Has("single_mode"), rs, pointSelector, params.Has("parallel"));
 
   // If possible, avoid the overhead of calculating centroids.
   if (params.Has("centroids"))
@@ -150,7 +173,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& /* timers */)
   ReportIgnoredParam(params, {{ "naive", true }}, "single_mode");
 
   RequireParamInSet<string>(params, "tree_type", { "kd", "cover", "r", "r-star",
-      "x", "hilbert-r", "r-plus", "r-plus-plus", "ball" }, true,
+      "x", "hilbert-r", "r-plus", "r-plus-plus", "ball", "grid" }, true,
       "unknown tree type");
 
   // Value of epsilon should be positive.
@@ -214,5 +237,9 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& /* timers */)
       ChoosePointSelectionPolicy<RangeSearch<EuclideanDistance, arma::mat,
           BallTree>>(params);
     }
+    else if (treeType == "grid")
+    {
+      ChoosePointSelectionPolicy<GridRangeSearch<>>(params);
+    }
   }
 }
@@ -45,6 +45,16 @@ class DecisionTree :
   //! Allow access to the dimension selection type.
   typedef DimensionSelectionType DimensionSelection;
 
+  //! Nodes with at least this many points search their candidate dimensions
+  //! in parallel with OpenMP.
+  static constexpr size_t ParallelSearchMinCount = 8192;
+  //! Nodes with at least this many points train their children in separate
+  //! OpenMP tasks.
+  static constexpr size_t ParallelTrainMinCount = 4096;
+  //! The points given to the batch Classify() methods are routed down the tree
+  //! in blocks of this many points, in parallel with OpenMP.
+  static constexpr size_t ClassifyBlockSize = 4096;
+
   /**
    * Construct the decision tree on the given data and labels, where the data
    * can be both numeric and categorical. Setting minimumLeafSize and
@@ -394,6 +404,66 @@ class DecisionTree :
                const std::enable_if_t<arma::is_arma_type<typename
                    std::remove_reference<WeightsType>::type>::value>* = 0);
 
+  /**
+   * Train the decision tree on the given data, assuming that all dimensions
+   * are numeric, by sorting each dimension only once.  The points of each
+   * node are kept sorted along every dimension in a matrix of indices, which
+   * is stably partitioned between the children of each node (as in the SLIQ
+   * algorithm); so, the splits are searched without sorting, and the data is
+   * not copied or reordered.  This uses one index per point and dimension.
+   * The tree is the same as the one Train() builds.  This will overwrite the
+   * existing model.
+   *
+   * The numeric split type must implement SplitIfBetterSorted(), as
+   * BestBinaryNumericSplit does.
+   *
+   * @param data Dataset to train on.
+   * @param labels Labels for each training point.
+   * @param numClasses Number of classes in the dataset.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @return The final entropy of decision tree.
+   */
+  template<typename MatType>
+  double TrainPresorted(const MatType& data,
+                        const arma::Row<size_t>& labels,
+                        const size_t numClasses,
+                        const size_t minimumLeafSize = 10,
+                        const double minimumGainSplit = 1e-7,
+                        const size_t maximumDepth = 0,
+                        DimensionSelectionType dimensionSelector =
+                            DimensionSelectionType());
+
+  /**
+   * Train the decision tree on the given weighted data, assuming that all
+   * dimensions are numeric, by sorting each dimension only once.  See the
+   * unweighted overload for details.
+   *
+   * @param data Dataset to train on.
+   * @param labels Labels for each training point.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights of all the labels
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @return The final entropy of decision tree.
+   */
+  template<typename MatType, typename WeightsType>
+  double TrainPresorted(const MatType& data,
+                        const arma::Row<size_t>& labels,
+                        const size_t numClasses,
+                        const WeightsType& weights,
+                        const size_t minimumLeafSize = 10,
+                        const double minimumGainSplit = 1e-7,
+                        const size_t maximumDepth = 0,
+                        DimensionSelectionType dimensionSelector =
+                            DimensionSelectionType(),
+                        const std::enable_if_t<arma::is_arma_type<
+                            WeightsType>::value>* = 0);
+
   /**
    * Classify the given point, using the entire tree.  The predicted label is
    * returned.
@@ -419,7 +489,9 @@ class DecisionTree :
 
   /**
    * Classify the given points, using the entire tree.  The predicted labels for
-   * each point are stored in the given vector.
+   * each point are stored in the given vector.  The points are routed down the
+   * tree in blocks of ClassifyBlockSize points, one level at a time (see
+   * RouteBlock()), and the blocks are classified in parallel.
    *
    * @param data Set of points to classify.
    * @param predictions This will be filled with predictions for each point.
@@ -431,7 +503,8 @@ class DecisionTree :
   /**
    * Classify the given points and also return estimates of the probabilities
    * for each class in the given matrix.  The predicted labels for each point
-   * are stored in the given vector.
+   * are stored in the given vector.  The points are routed down the tree in
+   * blocks, as in the other overload.
    *
    * @param data Set of points to classify.
    * @param predictions This will be filled with predictions for each point.
@@ -461,10 +534,20 @@ class DecisionTree :
   //! trained tree).
   size_t SplitDimension() const { return splitDimension; }
 
+  //! Get the type of the split dimension (only meaningful if this is a
+  //! non-leaf in a trained tree).
+  data::Datatype SplitDimensionType() const
+  {
+    return (data::Datatype) dimensionType;
+  }
+
   //! Get the class probabilities, if this is a leaf node in the trained tree.
   //! Note that if this is not a leaf, then this may contain arbitrary
   //! information used by the split in the tree!
   const arma::vec& ClassProbabilities() const { return classProbabilities; }
+  //! Modify the class probabilities, or the split information if this is not
+  //! a leaf (be careful!).
+  arma::vec& ClassProbabilities() { return classProbabilities; }
 
   /**
    * Given a point and that this node is not a leaf, calculate the index of the
@@ -520,6 +603,53 @@ class DecisionTree :
                                    const size_t numClasses,
                                    const WeightsRowType& weights);
 
+  /**
+   * Find the dimension with the best split of a node, among the dimensions
+   * given by the dimension selector.  This is called by the Train() methods
+   * below; searchDimension(i, bestGain, splitInfo, numericAux, categoricalAux)
+   * must check dimension i of the node for a split better than bestGain, as
+   * SplitIfBetter() does, and return its gain.
+   *
+   * For nodes with at least ParallelSearchMinCount points, the dimensions are
+   * searched in parallel, each against the gain of the node; the results are
+   * then reduced in the order of the dimensions, so the chosen split is the
+   * same as the serial search.  The split information of the best split is
+   * stored in classProbabilities and the auxiliary split information.
+   *
+   * @param count Number of points in the node.
+   * @param noSplit Value to return if no split was found.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @param bestGain Gain of the node; set to the gain of the best split.
+   * @param searchDimension Function that searches one dimension.
+   * @return The dimension of the best split, or noSplit.
+   */
+  template<typename SearchFunctionType>
+  size_t SearchDimensions(const size_t count,
+                          const size_t noSplit,
+                          const double minimumGainSplit,
+                          DimensionSelectionType& dimensionSelector,
+                          double& bestGain,
+                          SearchFunctionType& searchDimension);
+
+  /**
+   * Train the children of a node, once the points of each child have been
+   * moved into a contiguous range.  trainChild(i, dimensionSelector) must
+   * train child i.  For nodes with at least ParallelTrainMinCount points, the
+   * children are trained in separate OpenMP tasks, each with its own copy of
+   * the dimension selector.
+   *
+   * @param count Number of points in the node.
+   * @param numChildren Number of children of the node.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @param trainChild Function that trains one child.
+   */
+  template<typename TrainFunctionType>
+  void TrainChildren(const size_t count,
+                     const size_t numChildren,
+                     DimensionSelectionType& dimensionSelector,
+                     TrainFunctionType& trainChild);
+
   /**
    * Corresponding to the public Train() method, this method is designed for
    * avoiding unnecessary copies during training.  This function is called to
@@ -577,6 +707,41 @@ class DecisionTree :
                const double minimumGainSplit,
                const size_t maximumDepth,
                DimensionSelectionType& dimensionSelector);
+
+  /**
+   * Corresponding to the public TrainPresorted() method, this method trains a
+   * node whose points are sortedIndices(begin, d) to
+   * sortedIndices(begin + count - 1, d), sorted along each dimension d.
+   *
+   * @param data Dataset to train on.
+   * @param begin Index of the first row of sortedIndices that belongs to this
+   *      node.
+   * @param count Number of points in this node.
+   * @param sortedIndices Indices of the points, sorted along each dimension
+   *      (one column for each dimension) within each node.
+   * @param labels Labels for each training point.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights of all the labels.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @param childAssignments Workspace that holds the child of each point.
+   * @return The final entropy of decision tree.
+   */
+  template<bool UseWeights, typename MatType, typename WeightsType>
+  double TrainPresorted(const MatType& data,
+                        const size_t begin,
+                        const size_t count,
+                        arma::Mat<size_t>& sortedIndices,
+                        const arma::Row<size_t>& labels,
+                        const size_t numClasses,
+                        const WeightsType& weights,
+                        const size_t minimumLeafSize,
+                        const double minimumGainSplit,
+                        const size_t maximumDepth,
+                        DimensionSelectionType& dimensionSelector,
+                        arma::Row<size_t>& childAssignments);
 };
 
 /**
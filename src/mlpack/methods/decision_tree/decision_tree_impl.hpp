@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_DECISION_TREE_DECISION_TREE_IMPL_HPP
 
 #include "decision_tree.hpp"
+#include "utils.hpp"
 
 namespace mlpack {
 
@@ -608,6 +609,95 @@ double DecisionTree<FitnessFunction,
       dimensionSelector);
 }
 
+//! Train on the given data by sorting each dimension once.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<typename MatType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    NoRecursion>::TrainPresorted(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType dimensionSelector)
+{
+  // Sanity check on data.
+  util::CheckSameSizes(data, labels, "DecisionTree::TrainPresorted()");
+
+  // Set the correct dimensionality for the dimension selector.
+  dimensionSelector.Dimensions() = data.n_rows;
+
+  // Sort each dimension once.
+  arma::Mat<size_t> sortedIndices(data.n_cols, data.n_rows);
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (size_t d = 0; d < data.n_rows; ++d)
+  {
+    sortedIndices.col(d) = arma::conv_to<arma::Col<size_t>>::from(
+        arma::stable_sort_index(data.row(d)));
+  }
+
+  // Pass off work to the TrainPresorted() method.
+  arma::rowvec weights; // Fake weights, not used.
+  arma::Row<size_t> childAssignments(data.n_cols);
+  return TrainPresorted<false>(data, 0, data.n_cols, sortedIndices, labels,
+      numClasses, weights, minimumLeafSize, minimumGainSplit, maximumDepth,
+      dimensionSelector, childAssignments);
+}
+
+//! Train on the given weighted data by sorting each dimension once.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<typename MatType, typename WeightsType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    NoRecursion>::TrainPresorted(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightsType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType dimensionSelector,
+    const std::enable_if_t<arma::is_arma_type<WeightsType>::value>*)
+{
+  // Sanity check on data.
+  util::CheckSameSizes(data, labels, "DecisionTree::TrainPresorted()");
+  util::CheckSameSizes(data, weights, "DecisionTree::TrainPresorted()",
+      "weights");
+
+  // Set the correct dimensionality for the dimension selector.
+  dimensionSelector.Dimensions() = data.n_rows;
+
+  // Sort each dimension once.
+  arma::Mat<size_t> sortedIndices(data.n_cols, data.n_rows);
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (size_t d = 0; d < data.n_rows; ++d)
+  {
+    sortedIndices.col(d) = arma::conv_to<arma::Col<size_t>>::from(
+        arma::stable_sort_index(data.row(d)));
+  }
+
+  // Pass off work to the TrainPresorted() method.
+  arma::Row<size_t> childAssignments(data.n_cols);
+  return TrainPresorted<true>(data, 0, data.n_cols, sortedIndices, labels,
+      numClasses, weights, minimumLeafSize, minimumGainSplit, maximumDepth,
+      dimensionSelector, childAssignments);
+}
+
 //! Train on the given data, assuming all dimensions are numeric.
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
@@ -647,17 +737,20 @@ double DecisionTree<FitnessFunction,
       numClasses,
       UseWeights ? weights.subvec(begin, begin + count - 1) : weights);
   size_t bestDim = datasetInfo.Dimensionality(); // This means "no split".
-  const size_t end = dimensionSelector.End();
 
   if (maximumDepth != 1)
   {
-    for (size_t i = dimensionSelector.Begin(); i != end;
-         i = dimensionSelector.Next())
+    auto searchDimension = [&](const size_t i,
+                               const double currentGain,
+                               arma::vec& splitInfo,
+                               NumericAuxiliarySplitInfo& numericAux,
+                               CategoricalAuxiliarySplitInfo& categoricalAux)
     {
-      double dimGain = -DBL_MAX;
+      double dimGain = DBL_MAX;
       if (datasetInfo.Type(i) == data::Datatype::categorical)
       {
-        dimGain = CategoricalSplit::template SplitIfBetter<UseWeights>(bestGain,
+        dimGain = CategoricalSplit::template SplitIfBetter<UseWeights>(
+            currentGain,
             data.cols(begin, begin + count - 1).row(i),
             datasetInfo.NumMappings(i),
             labels.subvec(begin, begin + count - 1),
@@ -665,35 +758,27 @@ double DecisionTree<FitnessFunction,
             UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
             minimumLeafSize,
             minimumGainSplit,
-            classProbabilities,
-            *this);
+            splitInfo,
+            categoricalAux);
       }
       else if (datasetInfo.Type(i) == data::Datatype::numeric)
       {
-        dimGain = NumericSplit::template SplitIfBetter<UseWeights>(bestGain,
+        dimGain = NumericSplit::template SplitIfBetter<UseWeights>(currentGain,
             data.cols(begin, begin + count - 1).row(i),
             labels.subvec(begin, begin + count - 1),
             numClasses,
             UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
             minimumLeafSize,
             minimumGainSplit,
-            classProbabilities,
-            *this);
+            splitInfo,
+            numericAux);
       }
 
-      // If the splitter reported that it did not split, move to the next
-      // dimension.
-      if (dimGain == DBL_MAX)
-        continue;
-
-      // Was there an improvement?  If so mark that it's the new best dimension.
-      bestDim = i;
-      bestGain = dimGain;
+      return dimGain;
+    };
 
-      // If the gain is the best possible, no need to keep looking.
-      if (bestGain >= 0.0)
-        break;
-    }
+    bestDim = SearchDimensions(count, bestDim, minimumGainSplit,
+        dimensionSelector, bestGain, searchDimension);
   }
 
   // Did we split or not?  If so, then split the data and create the children.
@@ -731,18 +816,14 @@ double DecisionTree<FitnessFunction,
     for (size_t i = begin; i < begin + count; ++i)
       childCounts[childAssignments[i - begin]]++;
 
-    // Initialize bestGain if recursive split is allowed.
-    if (!NoRecursion)
-    {
-      bestGain = 0.0;
-    }
-
-    // Split into children.
+    // Split into children: move the points of each child into a contiguous
+    // range.
+    std::vector<size_t> childBegins(numChildren + 1);
     size_t currentCol = begin;
     for (size_t i = 0; i < numChildren; ++i)
     {
-      size_t currentChildBegin = currentCol;
-      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      childBegins[i] = currentCol;
+      for (size_t j = currentCol; j < begin + count; ++j)
       {
         if (childAssignments[j - begin] == i)
         {
@@ -754,26 +835,33 @@ double DecisionTree<FitnessFunction,
           ++currentCol;
         }
       }
-
-      // Now build the child recursively.
+    }
+    childBegins[numChildren] = begin + count;
+
+    // Now build the children recursively.  The ranges of the children are
+    // disjoint, so they can be trained at the same time.
+    children.resize(numChildren);
+    arma::vec childGains(numChildren);
+    auto trainChild = [&](const size_t i,
+                          DimensionSelectionType& childDimensionSelector)
+    {
+      const size_t childCount = childBegins[i + 1] - childBegins[i];
       DecisionTree* child = new DecisionTree();
-      if (NoRecursion)
-      {
-        child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, datasetInfo, labels, numClasses,
-            weights, currentCol - currentChildBegin, minimumGainSplit,
-            maximumDepth - 1, dimensionSelector);
-      }
-      else
-      {
-        // During recursion entropy of child node may change.
-        double childGain = child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, datasetInfo, labels, numClasses,
-            weights, minimumLeafSize, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
-        bestGain += double(childCounts[i]) / double(count) * (-childGain);
-      }
-      children.push_back(child);
+      childGains[i] = child->Train<UseWeights>(data, childBegins[i],
+          childCount, datasetInfo, labels, numClasses, weights,
+          NoRecursion ? childCount : minimumLeafSize, minimumGainSplit,
+          maximumDepth - 1, childDimensionSelector);
+      children[i] = child;
+    };
+
+    TrainChildren(count, numChildren, dimensionSelector, trainChild);
+
+    // During recursion entropy of child node may change.
+    if (!NoRecursion)
+    {
+      bestGain = 0.0;
+      for (size_t i = 0; i < numChildren; ++i)
+        bestGain += double(childCounts[i]) / double(count) * (-childGains[i]);
     }
   }
   else
@@ -836,34 +924,25 @@ double DecisionTree<FitnessFunction,
 
   if (maximumDepth != 1)
   {
-    for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
-         i = dimensionSelector.Next())
+    auto searchDimension = [&](const size_t i,
+                               const double currentGain,
+                               arma::vec& splitInfo,
+                               NumericAuxiliarySplitInfo& numericAux,
+                               CategoricalAuxiliarySplitInfo& /* aux */)
     {
-      const double dimGain = NumericSplitType<FitnessFunction>::template
-          SplitIfBetter<UseWeights>(bestGain,
-                                    data.cols(begin, begin + count - 1).row(i),
-                                    labels.cols(begin, begin + count - 1),
-                                    numClasses,
-                                    UseWeights ?
-                                        weights.cols(begin, begin + count - 1) :
-                                        weights,
-                                    minimumLeafSize,
-                                    minimumGainSplit,
-                                    classProbabilities,
-                                    *this);
-
-      // If the splitter did not report that it improved, then move to the next
-      // dimension.
-      if (dimGain == DBL_MAX)
-        continue;
-
-      bestDim = i;
-      bestGain = dimGain;
-
-      // If the gain is the best possible, no need to keep looking.
-      if (bestGain >= 0.0)
-        break;
-    }
+      return NumericSplit::template SplitIfBetter<UseWeights>(currentGain,
+          data.cols(begin, begin + count - 1).row(i),
+          labels.cols(begin, begin + count - 1),
+          numClasses,
+          UseWeights ? weights.cols(begin, begin + count - 1) : weights,
+          minimumLeafSize,
+          minimumGainSplit,
+          splitInfo,
+          numericAux);
+    };
+
+    bestDim = SearchDimensions(count, bestDim, minimumGainSplit,
+        dimensionSelector, bestGain, searchDimension);
   }
 
   // Did we split or not?  If so, then split the data and create the children.
@@ -890,17 +969,14 @@ double DecisionTree<FitnessFunction,
     for (size_t j = begin; j < begin + count; ++j)
       childCounts[childAssignments[j - begin]]++;
 
-    // Initialize bestGain if recursive split is allowed.
-    if (!NoRecursion)
-    {
-      bestGain = 0.0;
-    }
-
+    // Split into children: move the points of each child into a contiguous
+    // range.
+    std::vector<size_t> childBegins(numChildren + 1);
     size_t currentCol = begin;
     for (size_t i = 0; i < numChildren; ++i)
     {
-      size_t currentChildBegin = currentCol;
-      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      childBegins[i] = currentCol;
+      for (size_t j = currentCol; j < begin + count; ++j)
       {
         if (childAssignments[j - begin] == i)
         {
@@ -912,26 +988,33 @@ double DecisionTree<FitnessFunction,
           ++currentCol;
         }
       }
-
-      // Now build the child recursively.
+    }
+    childBegins[numChildren] = begin + count;
+
+    // Now build the children recursively.  The ranges of the children are
+    // disjoint, so they can be trained at the same time.
+    children.resize(numChildren);
+    arma::vec childGains(numChildren);
+    auto trainChild = [&](const size_t i,
+                          DimensionSelectionType& childDimensionSelector)
+    {
+      const size_t childCount = childBegins[i + 1] - childBegins[i];
       DecisionTree* child = new DecisionTree();
-      if (NoRecursion)
-      {
-        child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, labels, numClasses, weights,
-            currentCol - currentChildBegin, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
-      }
-      else
-      {
-        // During recursion entropy of child node may change.
-        double childGain = child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, labels, numClasses, weights,
-            minimumLeafSize, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
-        bestGain += double(childCounts[i]) / double(count) * (-childGain);
-      }
-      children.push_back(child);
+      childGains[i] = child->Train<UseWeights>(data, childBegins[i],
+          childCount, labels, numClasses, weights,
+          NoRecursion ? childCount : minimumLeafSize, minimumGainSplit,
+          maximumDepth - 1, childDimensionSelector);
+      children[i] = child;
+    };
+
+    TrainChildren(count, numChildren, dimensionSelector, trainChild);
+
+    // During recursion entropy of child node may change.
+    if (!NoRecursion)
+    {
+      bestGain = 0.0;
+      for (size_t i = 0; i < numChildren; ++i)
+        bestGain += double(childCounts[i]) / double(count) * (-childGains[i]);
     }
   }
   else
@@ -949,6 +1032,354 @@ double DecisionTree<FitnessFunction,
   return -bestGain;
 }
 
+//! Train a node whose points are sorted along each dimension.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<bool UseWeights, typename MatType, typename WeightsType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    NoRecursion>::TrainPresorted(
+    const MatType& data,
+    const size_t begin,
+    const size_t count,
+    arma::Mat<size_t>& sortedIndices,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightsType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType& dimensionSelector,
+    arma::Row<size_t>& childAssignments)
+{
+  typedef typename WeightsType::elem_type WType;
+
+  // Clear children if needed.
+  for (size_t i = 0; i < children.size(); ++i)
+    delete children[i];
+  children.clear();
+
+  // We won't be using these members, so reset them.
+  CategoricalAuxiliarySplitInfo::operator=(CategoricalAuxiliarySplitInfo());
+
+  // Collect the labels (and weights) of the points in this node.
+  const size_t* points = sortedIndices.colptr(0) + begin;
+  arma::Row<size_t> nodeLabels(count);
+  arma::Row<WType> nodeWeights;
+  if (UseWeights)
+    nodeWeights.set_size(count);
+  for (size_t j = 0; j < count; ++j)
+  {
+    nodeLabels[j] = labels[points[j]];
+    if (UseWeights)
+      nodeWeights[j] = weights[points[j]];
+  }
+
+  // Look through the list of dimensions and obtain the best split, as the
+  // other Train() methods do; the points of the node are already sorted along
+  // each dimension.
+  double bestGain = FitnessFunction::template Evaluate<UseWeights>(nodeLabels,
+      numClasses, nodeWeights);
+  size_t bestDim = data.n_rows; // This means "no split".
+
+  if (maximumDepth != 1)
+  {
+    auto searchDimension = [&](const size_t i,
+                               const double currentGain,
+                               arma::vec& splitInfo,
+                               NumericAuxiliarySplitInfo& numericAux,
+                               CategoricalAuxiliarySplitInfo& /* aux */)
+    {
+      return NumericSplit::template SplitIfBetterSorted<UseWeights>(
+          currentGain,
+          data.row(i),
+          sortedIndices.col(i).subvec(begin, begin + count - 1),
+          labels,
+          numClasses,
+          weights,
+          minimumLeafSize,
+          minimumGainSplit,
+          splitInfo,
+          numericAux);
+    };
+
+    bestDim = SearchDimensions(count, bestDim, minimumGainSplit,
+        dimensionSelector, bestGain, searchDimension);
+  }
+
+  // Did we split or not?  If so, then partition the points and create the
+  // children.
+  if (bestDim != data.n_rows)
+  {
+    // We know that the split is numeric.
+    const size_t numChildren =
+        NumericSplit::NumChildren(classProbabilities, *this);
+    splitDimension = bestDim;
+    dimensionType = (size_t) data::Datatype::numeric;
+
+    // Calculate all child assignments, and the counts of each child.
+    arma::Row<size_t> childCounts(numChildren, arma::fill::zeros);
+    for (size_t j = 0; j < count; ++j)
+    {
+      childAssignments[points[j]] = NumericSplit::CalculateDirection(
+          data(bestDim, points[j]), classProbabilities, *this);
+      ++childCounts[childAssignments[points[j]]];
+    }
+
+    std::vector<size_t> childBegins(numChildren + 1);
+    childBegins[0] = begin;
+    for (size_t i = 0; i < numChildren; ++i)
+      childBegins[i + 1] = childBegins[i] + childCounts[i];
+
+    // Stably partition the points of the node along each dimension, so that
+    // the points of each child stay sorted.
+    arma::Col<size_t> buffer(count);
+    std::vector<size_t> positions(numChildren);
+    for (size_t d = 0; d < sortedIndices.n_cols; ++d)
+    {
+      size_t* dimPoints = sortedIndices.colptr(d) + begin;
+      for (size_t i = 0; i < numChildren; ++i)
+        positions[i] = childBegins[i] - begin;
+      for (size_t j = 0; j < count; ++j)
+        buffer[positions[childAssignments[dimPoints[j]]]++] = dimPoints[j];
+      std::copy(buffer.begin(), buffer.end(), dimPoints);
+    }
+
+    // Now build the children recursively.  The children use disjoint rows of
+    // sortedIndices, so they can be trained at the same time.
+    children.resize(numChildren);
+    arma::vec childGains(numChildren);
+    auto trainChild = [&](const size_t i,
+                          DimensionSelectionType& childDimensionSelector)
+    {
+      DecisionTree* child = new DecisionTree();
+      childGains[i] = child->TrainPresorted<UseWeights>(data, childBegins[i],
+          childCounts[i], sortedIndices, labels, numClasses, weights,
+          NoRecursion ? childCounts[i] : minimumLeafSize, minimumGainSplit,
+          maximumDepth - 1, childDimensionSelector, childAssignments);
+      children[i] = child;
+    };
+
+    TrainChildren(count, numChildren, dimensionSelector, trainChild);
+
+    // During recursion entropy of child node may change.
+    if (!NoRecursion)
+    {
+      bestGain = 0.0;
+      for (size_t i = 0; i < numChildren; ++i)
+        bestGain += double(childCounts[i]) / double(count) * (-childGains[i]);
+    }
+  }
+  else
+  {
+    // We won't be needing these members, so reset them.
+    NumericAuxiliarySplitInfo::operator=(NumericAuxiliarySplitInfo());
+
+    // Calculate class probabilities because we are a leaf.
+    CalculateClassProbabilities<UseWeights>(nodeLabels, numClasses,
+        nodeWeights);
+  }
+
+  return -bestGain;
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<typename SearchFunctionType>
+size_t DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    NoRecursion>::SearchDimensions(
+    const size_t count,
+    const size_t noSplit,
+    const double minimumGainSplit,
+    DimensionSelectionType& dimensionSelector,
+    double& bestGain,
+    SearchFunctionType& searchDimension)
+{
+  size_t bestDim = noSplit;
+
+  #ifdef MLPACK_USE_OPENMP
+  if (count >= ParallelSearchMinCount && omp_get_max_threads() > 1)
+  {
+    std::vector<size_t> dimensions;
+    for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
+         i = dimensionSelector.Next())
+      dimensions.push_back(i);
+
+    // Check every dimension against the gain of the node, each with its own
+    // split information.
+    const double nodeGain = bestGain;
+    arma::vec gains(dimensions.size());
+    std::vector<arma::vec> splitInfos(dimensions.size());
+    std::vector<NumericAuxiliarySplitInfo> numericAux(dimensions.size());
+    std::vector<CategoricalAuxiliarySplitInfo> categoricalAux(
+        dimensions.size());
+    auto search = [&](const size_t d)
+    {
+      gains[d] = searchDimension(dimensions[d], nodeGain, splitInfos[d],
+          numericAux[d], categoricalAux[d]);
+    };
+
+    if (omp_in_parallel())
+    {
+      // We are already inside a task (or the user's parallel region), so just
+      // spawn more tasks.
+      for (size_t d = 0; d < dimensions.size(); ++d)
+      {
+        #pragma omp task shared(search) firstprivate(d)
+        {
+          search(d);
+        }
+      }
+
+      #pragma omp taskwait
+    }
+    else
+    {
+      #pragma omp parallel for schedule(dynamic, 1)
+      for (size_t d = 0; d < dimensions.size(); ++d)
+        search(d);
+    }
+
+    // Now reduce in the order of the dimensions.  As in the serial search, a
+    // dimension is only taken if it improves on the best split so far by
+    // minimumGainSplit, and the search stops at the first perfect split.
+    size_t bestIndex = dimensions.size();
+    for (size_t d = 0; d < dimensions.size(); ++d)
+    {
+      if (gains[d] == DBL_MAX)
+        continue;
+
+      if (bestIndex != dimensions.size() && gains[d] < 0.0 &&
+          gains[d] <= std::min(bestGain + minimumGainSplit, 0.0))
+        continue;
+
+      bestIndex = d;
+      bestGain = gains[d];
+
+      // If the gain is the best possible, no need to keep looking.
+      if (bestGain >= 0.0)
+        break;
+    }
+
+    if (bestIndex != dimensions.size())
+    {
+      bestDim = dimensions[bestIndex];
+      classProbabilities = std::move(splitInfos[bestIndex]);
+      NumericAuxiliarySplitInfo::operator=(numericAux[bestIndex]);
+      CategoricalAuxiliarySplitInfo::operator=(categoricalAux[bestIndex]);
+    }
+
+    return bestDim;
+  }
+  #else
+  (void) count;
+  (void) minimumGainSplit;
+  #endif
+
+  for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
+       i = dimensionSelector.Next())
+  {
+    const double dimGain = searchDimension(i, bestGain, classProbabilities,
+        *this, *this);
+
+    // If the splitter reported that it did not split, move to the next
+    // dimension.
+    if (dimGain == DBL_MAX)
+      continue;
+
+    // Was there an improvement?  If so mark that it's the new best dimension.
+    bestDim = i;
+    bestGain = dimGain;
+
+    // If the gain is the best possible, no need to keep looking.
+    if (bestGain >= 0.0)
+      break;
+  }
+
+  return bestDim;
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<typename TrainFunctionType>
+void DecisionTree<FitnessFunction,
+                  NumericSplitType,
+                  CategoricalSplitType,
+                  DimensionSelectionType,
+                  NoRecursion>::TrainChildren(
+    const size_t count,
+    const size_t numChildren,
+    DimensionSelectionType& dimensionSelector,
+    TrainFunctionType& trainChild)
+{
+  #ifdef MLPACK_USE_OPENMP
+  if (count >= ParallelTrainMinCount && numChildren > 1 &&
+      omp_get_max_threads() > 1)
+  {
+    // Dimension selectors may have state, so each task gets its own.
+    auto trainTask = [&](const size_t i)
+    {
+      DimensionSelectionType childDimensionSelector(dimensionSelector);
+      trainChild(i, childDimensionSelector);
+    };
+
+    if (omp_in_parallel())
+    {
+      // We are already inside a task (or the user's parallel region), so just
+      // spawn more tasks.
+      for (size_t i = 0; i < numChildren; ++i)
+      {
+        #pragma omp task shared(trainTask) firstprivate(i)
+        {
+          trainTask(i);
+        }
+      }
+
+      #pragma omp taskwait
+    }
+    else
+    {
+      #pragma omp parallel
+      {
+        #pragma omp single
+        {
+          for (size_t i = 0; i < numChildren; ++i)
+          {
+            #pragma omp task shared(trainTask) firstprivate(i)
+            {
+              trainTask(i);
+            }
+          }
+
+          #pragma omp taskwait
+        }
+      }
+    }
+
+    return;
+  }
+  #else
+  (void) count;
+  #endif
+
+  for (size_t i = 0; i < numChildren; ++i)
+    trainChild(i, dimensionSelector);
+}
+
 //! Return the class.
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
@@ -1018,9 +1449,14 @@ void DecisionTree<FitnessFunction,
     return;
   }
 
-  // Loop over each point.
-  for (size_t i = 0; i < data.n_cols; ++i)
-    predictions[i] = Classify(data.col(i));
+  auto classifyLeaf = [&](const DecisionTree& leaf,
+                          const arma::uword* points,
+                          const size_t count)
+  {
+    for (size_t i = 0; i < count; ++i)
+      predictions[points[i]] = leaf.majorityClass;
+  };
+  RoutePoints(*this, data, ClassifyBlockSize, classifyLeaf);
 }
 
 //! Return the class probabilities for a set of points.
@@ -1053,11 +1489,17 @@ void DecisionTree<FitnessFunction,
     node = &node->Child(0);
   probabilities.set_size(node->classProbabilities.n_elem, data.n_cols);
 
-  for (size_t i = 0; i < data.n_cols; ++i)
+  auto classifyLeaf = [&](const DecisionTree& leaf,
+                          const arma::uword* points,
+                          const size_t count)
   {
-    arma::vec v = probabilities.unsafe_col(i); // Alias of column.
-    Classify(data.col(i), predictions[i], v);
-  }
+    for (size_t i = 0; i < count; ++i)
+    {
+      predictions[points[i]] = leaf.majorityClass;
+      probabilities.col(points[i]) = leaf.classProbabilities;
+    }
+  };
+  RoutePoints(*this, data, ClassifyBlockSize, classifyLeaf);
 }
 
 //! Serialize the tree.
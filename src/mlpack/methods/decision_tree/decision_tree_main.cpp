@@ -16,6 +16,7 @@
 
 #include <mlpack/core/util/mlpack_main.hpp>
 #include "decision_tree.hpp"
+#include <mlpack/methods/random_forest/flat_forest.hpp>
 
 using namespace std;
 using namespace mlpack;
@@ -66,7 +67,14 @@ BINDING_LONG_DESC(
     " parameter.  Predictions for each test point may be saved via the " +
     PRINT_PARAM_STRING("predictions") + " output parameter.  Class "
     "probabilities for each prediction may be saved with the " +
-    PRINT_PARAM_STRING("probabilities") + " output parameter.");
+    PRINT_PARAM_STRING("probabilities") + " output parameter."
+    "\n\n"
+    "For fast scoring without mlpack, the " + PRINT_PARAM_STRING("export_cpp") +
+    " parameter may be used to write the tree to a self-contained C++ header "
+    "file that defines a function `model::Predict(const double* point, "
+    "double* probabilities = 0)`, in which the tree is compiled into nested "
+    "if/else statements.  Categorical values of the point must be given as "
+    "their mapped category indices.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -120,6 +128,8 @@ PARAM_FLAG("print_training_accuracy", "Print the training accuracy.", "a");
 PARAM_MATRIX_OUT("probabilities", "Class probabilities for each test point.",
     "P");
 PARAM_UROW_OUT("predictions", "Class predictions for each test point.", "p");
+PARAM_STRING_IN("export_cpp", "If specified, a C++ header file with a "
+    "Predict() function for the tree is written to this file.", "E", "");
 
 /**
  * This is the class that we will serialize.  It is a pretty simple wrapper
@@ -159,7 +169,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& /* timers */)
   RequireOnlyOnePassed(params, { "training", "input_model" }, true);
   ReportIgnoredParam(params, {{ "test", false }}, "test_labels");
   RequireAtLeastOnePassed(params, { "output_model", "probabilities",
-      "predictions" }, false, "no output will be saved");
+      "predictions", "export_cpp" }, false, "no output will be saved");
   ReportIgnoredParam(params, {{ "training", false }},
       "print_training_accuracy");
 
@@ -298,6 +308,22 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& /* timers */)
     params.Get<arma::mat>("probabilities") = probabilities;
   }
 
+  // Do we need to export the tree as C++ code?
+  if (params.Has("export_cpp"))
+  {
+    const string filename = params.Get<string>("export_cpp");
+    ofstream stream(filename);
+    if (!stream.is_open())
+    {
+      Log::Fatal << "Cannot open '" << filename << "' to export the tree to!"
+          << endl;
+    }
+
+    FlatForest flat;
+    flat.AddTree(model->tree);
+    flat.ExportCpp(stream);
+  }
+
   // Do we need to save the model?
   params.Get<DecisionTreeModel*>("output_model") = model;
 }
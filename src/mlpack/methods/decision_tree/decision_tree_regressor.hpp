@@ -45,6 +45,10 @@ class DecisionTreeRegressor :
   //! Allow access to the dimension selection type.
   typedef DimensionSelectionType DimensionSelection;
 
+  //! The points given to the batch Predict() method are routed down the tree
+  //! in blocks of this many points, in parallel with OpenMP.
+  static constexpr size_t PredictBlockSize = 4096;
+
   /**
    * Construct a decision tree without training it.  It will be a leaf node.
    */
@@ -394,7 +398,9 @@ class DecisionTreeRegressor :
 
   /**
    * Make prediction for the given points, using the entire tree. The predicted
-   * responses for each point are stored in the given vector.
+   * responses for each point are stored in the given vector.  The points are
+   * routed down the tree in blocks of PredictBlockSize points, one level at a
+   * time (see RouteBlock()), and the blocks are predicted in parallel.
    *
    * @param data Set of points to predict.
    * @param predictions This will be filled with predictions for each point.
@@ -974,9 +974,14 @@ void DecisionTreeRegressor<FitnessFunction,
     return;
   }
 
-  // Loop over each point.
-  for (size_t i = 0; i < data.n_cols; ++i)
-    predictions[i] = (ElemType) Predict(data.col(i));
+  auto predictLeaf = [&](const DecisionTreeRegressor& leaf,
+                         const arma::uword* points,
+                         const size_t count)
+  {
+    for (size_t i = 0; i < count; ++i)
+      predictions[points[i]] = (ElemType) leaf.prediction;
+  };
+  RoutePoints(*this, data, PredictBlockSize, predictLeaf);
 }
 
 template<typename FitnessFunction,
@@ -84,6 +84,41 @@ class BestBinaryNumericSplit
       arma::vec& splitInfo,
       AuxiliarySplitInfo& aux);
 
+  /**
+   * Check if we can split a node whose points have already been sorted along
+   * the dimension, as SplitIfBetter() does for classification.  The points of
+   * the node are data[sortedIndices[0]], data[sortedIndices[1]] and so on;
+   * labels and weights are indexed the same way as data.  This is used by
+   * DecisionTree::TrainPresorted(), which sorts each dimension only once.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param sortedIndices Indices of the points of the node, sorted by value.
+   * @param labels Labels for each point.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights associated with labels.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param splitInfo Stores split information on a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   */
+  template<bool UseWeights, typename VecType, typename IndicesType,
+           typename WeightVecType>
+  static double SplitIfBetterSorted(
+      const double bestGain,
+      const VecType& data,
+      const IndicesType& sortedIndices,
+      const arma::Row<size_t>& labels,
+      const size_t numClasses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::vec& splitInfo,
+      AuxiliarySplitInfo& aux);
+
   /**
    * Check if we can split a node.  If we can split a node in a way that
    * improves on 'bestGain', then we return the improved gain.  Otherwise we
@@ -0,0 +1,185 @@
+/**
+ * @file methods/decision_tree/split_functions/histogram_numeric_split.hpp
+ *
+ * A tree splitter that finds the best binary numeric split between the buckets
+ * of a quantile histogram of the dimension.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_HPP
+#define MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/decision_tree/fitness_functions/mse_gain.hpp>
+
+namespace mlpack {
+
+/**
+ * The HistogramNumericSplit is a splitting function for decision trees that
+ * bins the values of a numeric dimension into at most 256 buckets, and then
+ * searches for the best binary split between buckets.  Instead of sorting all
+ * of the points of the node, the bucket boundaries are quantiles of a
+ * deterministic sample of at most 2048 points; each point is then assigned a
+ * one-byte bucket index with a binary search over the boundaries, and the class
+ * counts (or the response sums) of each bucket are accumulated.  The split is
+ * found with a single scan over the buckets, where the statistics of the right
+ * child are the statistics of the node minus those of the left child.
+ *
+ * If the sample has at most 256 distinct values, every distinct value of the
+ * sample gets its own bucket; so, for nodes with at most 2048 points and 256
+ * distinct values, the split is the same as the one BestBinaryNumericSplit
+ * finds.  Otherwise, only splits between buckets are considered, which is
+ * usually a good approximation and much faster for large nodes.
+ *
+ * For regression, only MSEGain is supported, since the children's gains are
+ * computed from the sums and sums of squares of the responses of each bucket.
+ *
+ * @tparam FitnessFunction Fitness function to use to calculate gain.
+ */
+template<typename FitnessFunction>
+class HistogramNumericSplit
+{
+ public:
+  // No extra info needed for split.
+  class AuxiliarySplitInfo { };
+
+  //! The maximum number of buckets of a dimension.
+  static constexpr size_t MaxBins = 256;
+  //! The maximum number of points sampled to compute the bucket boundaries.
+  static constexpr size_t SampleSize = 8 * MaxBins;
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on 'bestGain', then we return the improved gain.  Otherwise we
+   * return the value 'bestGain'.  If a split is made, then splitInfo and aux
+   * may be modified.
+   *
+   * This overload is used only for classification tasks.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param labels Labels for each point.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights associated with labels.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param splitInfo Stores split information on a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   */
+  template<bool UseWeights, typename VecType, typename WeightVecType>
+  static double SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const arma::Row<size_t>& labels,
+      const size_t numClasses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::vec& splitInfo,
+      AuxiliarySplitInfo& aux);
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on 'bestGain', then we return the improved gain.  Otherwise we
+   * return the value 'bestGain'.  If a split is made, then splitInfo and aux
+   * may be modified.
+   *
+   * This overload is used only for regression tasks, and FitnessFunction must
+   * be MSEGain.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param responses Responses for each point.
+   * @param weights Weights associated with responses.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param splitInfo Stores split information on a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   * @param fitnessFunction The FitnessFunction object instance (unused).
+   */
+  template<bool UseWeights, typename VecType, typename ResponsesType,
+           typename WeightVecType>
+  static double SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const ResponsesType& responses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::vec& splitInfo,
+      AuxiliarySplitInfo& aux,
+      FitnessFunction& fitnessFunction);
+
+  /**
+   * If a split was found, returns the number of children of the split.
+   * Otherwise returns zero. A binary split always has two children.
+   */
+  static size_t NumChildren(const arma::vec& splitInfo,
+                            const AuxiliarySplitInfo& /* aux */)
+  {
+    return splitInfo.n_elem == 0 ? 0 : 2;
+  }
+
+  /**
+   * In the case that a split was found, given a point, calculate
+   * which child it should go to (left or right). Otherwise if
+   * there was no split, returns SIZE_MAX.
+   *
+   * @param point Point to calculate direction of.
+   * @param splitInfo Auxiliary information for the split.
+   * @param * (aux) Auxiliary information for the split (Unused).
+   */
+  template<typename ElemType>
+  static size_t CalculateDirection(
+      const ElemType& point,
+      const arma::vec& splitInfo,
+      const AuxiliarySplitInfo& /* aux */);
+
+  /**
+   * Assign each value of the given dimension to a bucket.  The bucket
+   * boundaries are quantiles of a sample of the values, and there are at most
+   * MaxBins buckets; buckets are ordered by value.  The smallest and largest
+   * value in each bucket are also computed (empty buckets have a minimum of
+   * DBL_MAX and a maximum of -DBL_MAX).
+   *
+   * @param data The dimension of data points to bin.
+   * @param bins Will hold the bucket of each point.
+   * @param binCounts Will hold the number of points in each bucket.
+   * @param binMin Will hold the smallest value of each bucket.
+   * @param binMax Will hold the largest value of each bucket.
+   * @return The number of buckets.
+   */
+  template<typename VecType>
+  static size_t Bin(const VecType& data,
+                    arma::Row<unsigned char>& bins,
+                    arma::Col<size_t>& binCounts,
+                    arma::vec& binMin,
+                    arma::vec& binMax);
+
+ private:
+  /**
+   * Compute the split point between the given bucket and the next nonempty
+   * bucket: halfway between the largest value of the first and the smallest
+   * value of the second.
+   */
+  static double SplitPoint(const arma::Col<size_t>& binCounts,
+                           const arma::vec& binMin,
+                           const arma::vec& binMax,
+                           const size_t bin);
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "histogram_numeric_split_impl.hpp"
+
+#endif
@@ -0,0 +1,369 @@
+/**
+ * @file methods/decision_tree/split_functions/histogram_numeric_split_impl.hpp
+ *
+ * Implementation of the strategy that finds the best binary numeric split
+ * between the buckets of a quantile histogram.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "histogram_numeric_split.hpp"
+
+namespace mlpack {
+
+// Overload used for classification.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double HistogramNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
+    AuxiliarySplitInfo& /* aux */)
+{
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2) || data.n_elem < 2)
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  arma::Row<unsigned char> bins;
+  arma::Col<size_t> binCounts;
+  arma::vec binMin, binMax;
+  const size_t numBins = Bin(data, bins, binCounts, binMin, binMax);
+
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  // Count the number of points (or the weight) of each class in each bucket.
+  arma::Mat<size_t> classCounts;
+  arma::Col<size_t> totalCounts, leftCounts, rightCounts;
+  arma::mat classWeightSums;
+  arma::vec totalWeightSums, leftWeightSums, rightWeightSums;
+  double totalWeight = 0.0;
+  double leftWeight = 0.0;
+  if (UseWeights)
+  {
+    classWeightSums.zeros(numClasses, numBins);
+    for (size_t i = 0; i < data.n_elem; ++i)
+      classWeightSums(labels[i], bins[i]) += weights[i];
+
+    totalWeightSums = sum(classWeightSums, 1);
+    totalWeight = accu(totalWeightSums);
+    leftWeightSums.zeros(numClasses);
+    bestFoundGain *= totalWeight;
+  }
+  else
+  {
+    classCounts.zeros(numClasses, numBins);
+    for (size_t i = 0; i < data.n_elem; ++i)
+      ++classCounts(labels[i], bins[i]);
+
+    totalCounts = sum(classCounts, 1);
+    leftCounts.zeros(numClasses);
+    bestFoundGain *= data.n_elem;
+  }
+
+  // Scan the buckets in order; each split puts the buckets up to and including
+  // the current one in the left child.  The counts of the right child are
+  // those of the node minus those of the left child.
+  size_t leftCount = 0;
+  for (size_t b = 0; b + 1 < numBins; ++b)
+  {
+    if (binCounts[b] == 0)
+      continue;
+
+    leftCount += binCounts[b];
+    if (UseWeights)
+    {
+      leftWeightSums += classWeightSums.col(b);
+      leftWeight += accu(classWeightSums.col(b));
+    }
+    else
+    {
+      leftCounts += classCounts.col(b);
+    }
+
+    if (leftCount < minimum)
+      continue;
+    if (data.n_elem - leftCount < minimum)
+      break;
+
+    // Calculate the gain for the left and right child.  Only use weights if
+    // needed.
+    double gain;
+    if (UseWeights)
+    {
+      rightWeightSums = totalWeightSums - leftWeightSums;
+      const double rightWeight = totalWeight - leftWeight;
+      gain = leftWeight * FitnessFunction::template EvaluatePtr<true>(
+              leftWeightSums.memptr(), numClasses, leftWeight) +
+          rightWeight * FitnessFunction::template EvaluatePtr<true>(
+              rightWeightSums.memptr(), numClasses, rightWeight);
+    }
+    else
+    {
+      rightCounts = totalCounts - leftCounts;
+      const size_t rightCount = data.n_elem - leftCount;
+      gain = double(leftCount) * FitnessFunction::template EvaluatePtr<false>(
+              leftCounts.memptr(), numClasses, leftCount) +
+          double(rightCount) * FitnessFunction::template EvaluatePtr<false>(
+              rightCounts.memptr(), numClasses, rightCount);
+    }
+
+    // Corner case: is this the best possible split?  If so, take it.
+    if (gain >= 0.0)
+    {
+      splitInfo.set_size(1);
+      splitInfo[0] = SplitPoint(binCounts, binMin, binMax, b);
+      return gain / (UseWeights ? totalWeight : double(data.n_elem));
+    }
+    else if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      splitInfo.set_size(1);
+      splitInfo[0] = SplitPoint(binCounts, binMin, binMax, b);
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+// Overload used for regression.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename ResponsesType,
+         typename WeightVecType>
+double HistogramNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const ResponsesType& responses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
+    AuxiliarySplitInfo& /* aux */,
+    FitnessFunction& /* fitnessFunction */)
+{
+  static_assert(std::is_same<FitnessFunction, MSEGain>::value,
+      "HistogramNumericSplit only supports MSEGain for regression.");
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2) || data.n_elem < 2)
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  arma::Row<unsigned char> bins;
+  arma::Col<size_t> binCounts;
+  arma::vec binMin, binMax;
+  const size_t numBins = Bin(data, bins, binCounts, binMin, binMax);
+
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  // The responses are centered on their mean, so that the sums of squares do
+  // not lose precision when the responses are far from zero.
+  double totalWeight = 0.0;
+  double mean = 0.0;
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const double w = UseWeights ? (double) weights[i] : 1.0;
+    totalWeight += w;
+    mean += w * responses[i];
+  }
+  if (totalWeight <= 0.0)
+    return DBL_MAX;
+  mean /= totalWeight;
+  bestFoundGain *= totalWeight;
+
+  // Each column holds the weight, the sum of the responses, and the sum of the
+  // squared responses of one bucket.
+  arma::mat binStats(3, numBins, arma::fill::zeros);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const double w = UseWeights ? (double) weights[i] : 1.0;
+    const double r = responses[i] - mean;
+    binStats(0, bins[i]) += w;
+    binStats(1, bins[i]) += w * r;
+    binStats(2, bins[i]) += w * r * r;
+  }
+
+  // Scan the buckets in order; the statistics of the right child are those of
+  // the node minus those of the left child.  The gain of a child with weight w
+  // is -(sumSquares / w - (sum / w)^2), and it is multiplied by w.
+  const arma::vec totalStats = sum(binStats, 1);
+  arma::vec leftStats(3, arma::fill::zeros);
+  size_t leftCount = 0;
+  for (size_t b = 0; b + 1 < numBins; ++b)
+  {
+    if (binCounts[b] == 0)
+      continue;
+
+    leftCount += binCounts[b];
+    leftStats += binStats.col(b);
+
+    if (leftCount < minimum)
+      continue;
+    if (data.n_elem - leftCount < minimum)
+      break;
+
+    const arma::vec rightStats = totalStats - leftStats;
+    double gain = 0.0;
+    if (leftStats[0] > 0.0)
+      gain += leftStats[1] * leftStats[1] / leftStats[0] - leftStats[2];
+    if (rightStats[0] > 0.0)
+      gain += rightStats[1] * rightStats[1] / rightStats[0] - rightStats[2];
+
+    // Corner case: is this the best possible split?  If so, take it.
+    if (gain >= 0.0)
+    {
+      splitInfo.set_size(1);
+      splitInfo[0] = SplitPoint(binCounts, binMin, binMax, b);
+      return gain / totalWeight;
+    }
+    else if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      splitInfo.set_size(1);
+      splitInfo[0] = SplitPoint(binCounts, binMin, binMax, b);
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  return bestFoundGain / totalWeight;
+}
+
+template<typename FitnessFunction>
+template<typename ElemType>
+size_t HistogramNumericSplit<FitnessFunction>::CalculateDirection(
+    const ElemType& point,
+    const arma::vec& splitInfo,
+    const AuxiliarySplitInfo& /* aux */)
+{
+  if (splitInfo.n_elem == 0)
+    return SIZE_MAX;
+  else if (point <= splitInfo[0])
+    return 0; // Go left.
+  else
+    return 1; // Go right.
+}
+
+template<typename FitnessFunction>
+template<typename VecType>
+size_t HistogramNumericSplit<FitnessFunction>::Bin(
+    const VecType& data,
+    arma::Row<unsigned char>& bins,
+    arma::Col<size_t>& binCounts,
+    arma::vec& binMin,
+    arma::vec& binMax)
+{
+  const size_t n = data.n_elem;
+
+  // Take an evenly strided sample of the values.
+  const size_t sampleSize = std::min(n, SampleSize);
+  arma::vec sample(sampleSize);
+  for (size_t i = 0; i < sampleSize; ++i)
+    sample[i] = data[(i * n) / sampleSize];
+
+  // Find the lower boundary of each bucket but the first.  If there are few
+  // enough distinct values in the sample, each gets its own bucket; otherwise,
+  // the boundaries are evenly spaced quantiles of the sample.
+  const arma::vec distinct = arma::unique(sample);
+  arma::vec edges;
+  if (distinct.n_elem <= MaxBins)
+  {
+    if (distinct.n_elem > 1)
+      edges = distinct.subvec(1, distinct.n_elem - 1);
+  }
+  else
+  {
+    sample = arma::sort(sample);
+    edges.set_size(MaxBins - 1);
+    for (size_t b = 1; b < MaxBins; ++b)
+      edges[b - 1] = sample[(b * sampleSize) / MaxBins];
+    edges = arma::unique(edges);
+  }
+
+  // Assign each point to the bucket of the last boundary that is not greater
+  // than its value.
+  const size_t numBins = edges.n_elem + 1;
+  bins.set_size(n);
+  binCounts.zeros(numBins);
+  binMin.set_size(numBins);
+  binMin.fill(DBL_MAX);
+  binMax.set_size(numBins);
+  binMax.fill(-DBL_MAX);
+  for (size_t i = 0; i < n; ++i)
+  {
+    const double value = data[i];
+    const size_t bin = std::upper_bound(edges.begin(), edges.end(), value) -
+        edges.begin();
+    bins[i] = (unsigned char) bin;
+    ++binCounts[bin];
+    binMin[bin] = std::min(binMin[bin], value);
+    binMax[bin] = std::max(binMax[bin], value);
+  }
+
+  return numBins;
+}
+
+template<typename FitnessFunction>
+double HistogramNumericSplit<FitnessFunction>::SplitPoint(
+    const arma::Col<size_t>& binCounts,
+    const arma::vec& binMin,
+    const arma::vec& binMax,
+    const size_t bin)
+{
+  // The scan only splits when there are points to the right, so there is a
+  // nonempty bucket after this one.
+  size_t next = bin + 1;
+  while (binCounts[next] == 0)
+    ++next;
+
+  double splitPoint = (binMax[bin] + binMin[next]) / 2.0;
+
+  // In some very extreme cases, floating-point inaccuracies can lead to the
+  // split result being the upper bound, which is problematic for later as all
+  // the child points will be sent to the left child.  If this happens, bump it
+  // down incrementally.
+  if (splitPoint == binMin[next])
+    splitPoint = std::nexttoward(splitPoint, binMax[bin]);
+
+  return splitPoint;
+}
+
+} // namespace mlpack
+
+#endif
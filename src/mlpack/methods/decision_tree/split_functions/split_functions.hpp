@@ -15,6 +15,7 @@
 #include "all_categorical_split.hpp"
 #include "best_binary_numeric_split.hpp"
 #include "random_binary_numeric_split.hpp"
+#include "histogram_numeric_split.hpp"
 #include "best_binary_categorical_split.hpp"
 
 #endif
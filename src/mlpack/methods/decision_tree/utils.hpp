@@ -134,6 +134,112 @@ inline void Sum(const VecType& values,
   mean = total[0];
 }
 
+/**
+ * Route a block of points down a trained decision tree (a DecisionTree or a
+ * DecisionTreeRegressor) one level at a time.  The split of each node of a
+ * level is applied to all the points that reach the node at once, and the
+ * points are then stably partitioned between its children, so that the points
+ * of each node are contiguous in the list of points.  For each leaf that is
+ * reached, leafFunction(leaf, leafPoints, count) is called with the indexes of
+ * the count points that reach the leaf.
+ *
+ * @param tree Root of the tree.
+ * @param data Dataset that holds the points.
+ * @param points Indexes of the points to route; they are reordered.
+ * @param leafFunction Function to call for each leaf.
+ */
+template<typename TreeType, typename MatType, typename LeafFunctionType>
+inline void RouteBlock(const TreeType& tree,
+                       const MatType& data,
+                       arma::uvec& points,
+                       LeafFunctionType& leafFunction)
+{
+  struct NodeRange
+  {
+    const TreeType* node;
+    size_t begin;
+    size_t count;
+  };
+
+  if (points.n_elem == 0)
+    return;
+
+  std::vector<NodeRange> level(1, NodeRange{ &tree, 0, points.n_elem });
+  std::vector<NodeRange> nextLevel;
+  arma::uvec directions(points.n_elem);
+  arma::uvec partitioned(points.n_elem);
+  std::vector<size_t> offsets;
+  while (!level.empty())
+  {
+    nextLevel.clear();
+    for (size_t n = 0; n < level.size(); ++n)
+    {
+      const TreeType& node = *level[n].node;
+      const size_t begin = level[n].begin;
+      const size_t end = begin + level[n].count;
+      if (node.NumChildren() == 0)
+      {
+        leafFunction(node, points.memptr() + begin, level[n].count);
+        continue;
+      }
+
+      offsets.assign(node.NumChildren() + 1, 0);
+      for (size_t i = begin; i < end; ++i)
+      {
+        directions[i] = node.CalculateDirection(data.col(points[i]));
+        ++offsets[directions[i] + 1];
+      }
+
+      for (size_t c = 1; c < offsets.size(); ++c)
+        offsets[c] += offsets[c - 1];
+      for (size_t c = 0; c < node.NumChildren(); ++c)
+      {
+        const size_t count = offsets[c + 1] - offsets[c];
+        if (count > 0)
+        {
+          nextLevel.push_back(NodeRange{ &node.Child(c), begin + offsets[c],
+              count });
+        }
+      }
+
+      for (size_t i = begin; i < end; ++i)
+        partitioned[begin + offsets[directions[i]]++] = points[i];
+      points.subvec(begin, end - 1) = partitioned.subvec(begin, end - 1);
+    }
+
+    level.swap(nextLevel);
+  }
+}
+
+/**
+ * Route all the points of the given dataset down a trained decision tree, in
+ * blocks of blockSize consecutive points that are routed in parallel with
+ * RouteBlock().  leafFunction(leaf, leafPoints, count) is called for each leaf
+ * reached by the points of each block; it may be called from several threads
+ * at once, but never twice for the same point.
+ *
+ * @param tree Root of the tree.
+ * @param data Dataset that holds the points.
+ * @param blockSize Number of points of each block.
+ * @param leafFunction Function to call for each leaf.
+ */
+template<typename TreeType, typename MatType, typename LeafFunctionType>
+inline void RoutePoints(const TreeType& tree,
+                        const MatType& data,
+                        const size_t blockSize,
+                        LeafFunctionType& leafFunction)
+{
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) data.n_cols);
+    arma::uvec points = arma::regspace<arma::uvec>(begin, end - 1);
+    RouteBlock(tree, data, points, leafFunction);
+  }
+}
+
 } // namespace mlpack
 
 #endif
@@ -176,12 +176,16 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
   const MatType cvData(dataset);
   const size_t testSize = dataset.n_cols / folds;
 
-  arma::vec regularizationConstants(prunedSequence.size());
-  regularizationConstants.fill(0.0);
+  // Each fold stores its own regularization constants, which are added in the
+  // order of the folds afterwards, so the result does not depend on the number
+  // of threads.
+  arma::mat foldRegularizationConstants(prunedSequence.size(), folds);
 
   timers.Start("cross_validation");
-  // Go through each fold.
-  #pragma omp parallel for shared(prunedSequence, regularizationConstants)
+  // Go through each fold.  The folds are independent, so they are run in
+  // parallel; the growing of each fold's tree can spawn more tasks.
+  #pragma omp parallel for schedule(dynamic) \
+      shared(prunedSequence, foldRegularizationConstants)
   for (size_t fold = 0; fold < (size_t) folds; fold++)
   {
     // Break up data into train and test sets.
@@ -221,18 +225,17 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
     // Sequentially prune with all the values of available alphas and adding
     // values for test values.  Don't enter this loop if there are less than two
     // trees in the pruned sequence.
-    arma::vec cvRegularizationConstants(prunedSequence.size());
+    arma::vec cvRegularizationConstants(
+        foldRegularizationConstants.colptr(fold), prunedSequence.size(), false,
+        true);
     cvRegularizationConstants.fill(0.0);
+    arma::vec cvValues;
     for (size_t i = 0;
          i < ((prunedSequence.size() < 2) ? 0 : prunedSequence.size() - 2); ++i)
     {
       // Compute test values for this state of the tree.
-      double cvVal = 0.0;
-      for (size_t j = 0; j < test.n_cols; ++j)
-      {
-        arma::vec testPoint = test.unsafe_col(j);
-        cvVal += cvDTree.ComputeValue(testPoint);
-      }
+      cvDTree.ComputeValue(test, cvValues);
+      const double cvVal = arma::accu(cvValues);
 
       // Update the cv regularization constant.
       cvRegularizationConstants[i] = 2.0 * cvVal / (double) cvData.n_cols;
@@ -244,24 +247,22 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
     }
 
     // Compute test values for this state of the tree.
-    double cvVal = 0.0;
-    for (size_t i = 0; i < test.n_cols; ++i)
-    {
-      typename GetColType<MatType>::type testPoint = test.unsafe_col(i);
-      cvVal += cvDTree.ComputeValue(testPoint);
-    }
+    cvDTree.ComputeValue(test, cvValues);
+    const double cvVal = arma::accu(cvValues);
 
     if (prunedSequence.size() > 2)
     {
       cvRegularizationConstants[prunedSequence.size() - 2] = 2.0 * cvVal
         / (double) cvData.n_cols;
     }
-
-    #pragma omp critical(DTreeCVUpdate)
-    regularizationConstants += cvRegularizationConstants;
   }
   timers.Stop("cross_validation");
 
+  arma::vec regularizationConstants(prunedSequence.size(),
+      arma::fill::zeros);
+  for (size_t fold = 0; fold < (size_t) folds; ++fold)
+    regularizationConstants += foldRegularizationConstants.col(fold);
+
   double optimalAlpha = -1.0;
   long double cvBestNegError = -std::numeric_limits<long double>::max();
 
@@ -52,6 +52,10 @@ class DTree
   //! The statistic type we are holding.
   typedef typename arma::Col<ElemType> StatType;
 
+  //! The minimum number of points in a node for its children to be grown in
+  //! parallel (with OpenMP tasks) when the data is dense.
+  static constexpr size_t ParallelGrowMinPoints = 10000;
+
   /**
    * Create an empty density estimation tree.
    */
@@ -148,7 +152,10 @@ class DTree
 
   /**
    * Greedily expand the tree.  The points in the dataset will be reordered
-   * during tree growth.
+   * during tree growth.  If OpenMP is enabled and the data is dense, the two
+   * children of nodes with at least ParallelGrowMinPoints points are grown in
+   * parallel; they hold disjoint ranges of points, so they do not depend on
+   * each other.
    *
    * @param data Dataset to build tree on.
    * @param oldFromNew Mappings from old points to new points.
@@ -181,6 +188,15 @@ class DTree
    */
   double ComputeValue(const VecType& query) const;
 
+  /**
+   * Compute the density estimate of each of the given query points, in
+   * parallel with OpenMP.
+   *
+   * @param queries Points to estimate density of.
+   * @param values Will hold the density estimate of each point.
+   */
+  void ComputeValue(const MatType& queries, arma::vec& values) const;
+
   /**
    * Index the buckets for possible usage later; this results in every leaf in
    * the tree having a specific tag (accessible with BucketTag()).  This
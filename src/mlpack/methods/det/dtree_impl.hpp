@@ -631,10 +631,54 @@ double DTree<MatType, TagType>::Grow(MatType& data,
       left = new DTree(maxValsL, minValsL, start, splitIndex, leftError);
       right = new DTree(maxValsR, minValsR, splitIndex, end, rightError);
 
-      leftG = left->Grow(data, oldFromNew, useVolReg, maxLeafSize,
-                         minLeafSize);
-      rightG = right->Grow(data, oldFromNew, useVolReg, maxLeafSize,
-                           minLeafSize);
+      auto growChild = [&](DTree* child)
+      {
+        return child->Grow(data, oldFromNew, useVolReg, maxLeafSize,
+            minLeafSize);
+      };
+
+      // The children hold disjoint ranges of the columns of the data, so they
+      // can be grown at the same time, unless the data is sparse (swapping
+      // columns of a sparse matrix changes the whole matrix).
+      #ifdef MLPACK_USE_OPENMP
+      if (!arma::is_SpMat<MatType>::value &&
+          (end - start) >= ParallelGrowMinPoints && omp_get_max_threads() > 1)
+      {
+        if (omp_in_parallel())
+        {
+          // We are already inside a task (or the user's parallel region), so
+          // just spawn another task.
+          #pragma omp task shared(growChild, leftG)
+          {
+            leftG = growChild(left);
+          }
+
+          rightG = growChild(right);
+          #pragma omp taskwait
+        }
+        else
+        {
+          #pragma omp parallel
+          {
+            #pragma omp single
+            {
+              #pragma omp task shared(growChild, leftG)
+              {
+                leftG = growChild(left);
+              }
+
+              rightG = growChild(right);
+              #pragma omp taskwait
+            }
+          }
+        }
+      }
+      else
+      #endif
+      {
+        leftG = growChild(left);
+        rightG = growChild(right);
+      }
 
       // Store values of R(T~) and |T~|.
       subtreeLeaves = left->SubtreeLeaves() + right->SubtreeLeaves();
@@ -877,6 +921,17 @@ double DTree<MatType, TagType>::ComputeValue(const VecType& query) const
       right->ComputeValue(query);
 }
 
+template<typename MatType, typename TagType>
+void DTree<MatType, TagType>::ComputeValue(const MatType& queries,
+                                           arma::vec& values) const
+{
+  values.set_size(queries.n_cols);
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) queries.n_cols; ++i)
+    values[i] = ComputeValue(VecType(queries.col(i)));
+}
+
 // Index the buckets for possible usage later.
 template<typename MatType, typename TagType>
 TagType DTree<MatType, TagType>::TagTree(const TagType& tag, bool every)
@@ -29,6 +29,7 @@
 
 #include "dtb_stat.hpp"
 #include "edge_pair.hpp"
+#include "union_find.hpp"
 
 namespace mlpack {
 
@@ -64,6 +65,13 @@ namespace mlpack {
  * More advanced usage of the class can use different types of trees, pass in an
  * already-built tree, or compute the MST using the O(n^2) naive algorithm.
  *
+ * If OpenMP is enabled, each Boruvka round is split between threads: the tree
+ * is split into a few disjoint query subtrees per thread, each traversed against
+ * the whole tree, and the components found are then merged in parallel with a
+ * lock-free ConcurrentUnionFind.  Ties between candidate edges are broken by
+ * the indices of their points, so the result does not depend on the number of
+ * threads.
+ *
  * @tparam DistanceType The distance metric to use.
  * @tparam MatType The type of data matrix to use.
  * @tparam TreeType Type of tree to use.  This should follow the TreeType policy
@@ -99,7 +107,7 @@ class DualTreeBoruvka
   std::vector<EdgePair> edges; // We must use vector with non-numerical types.
 
   //! Connections.
-  UnionFind connections;
+  ConcurrentUnionFind connections;
 
   //! List of edge nodes.
   arma::Col<size_t> neighborsInComponent;
@@ -114,15 +122,25 @@ class DualTreeBoruvka
   //! The instantiated distance metric.
   DistanceType distance;
 
-  //! For sorting the edge list after the computation.
+  //! For sorting the edge list after the computation.  Edges of equal length
+  //! are sorted by their points, so that the order does not depend on the
+  //! order the edges were found in.
   struct SortEdgesHelper
   {
     bool operator()(const EdgePair& pairA, const EdgePair& pairB)
     {
-      return (pairA.Distance() < pairB.Distance());
+      if (pairA.Distance() != pairB.Distance())
+        return (pairA.Distance() < pairB.Distance());
+      if (pairA.Lesser() != pairB.Lesser())
+        return (pairA.Lesser() < pairB.Lesser());
+      return (pairA.Greater() < pairB.Greater());
     }
   } SortFun;
 
+  //! Subtrees with fewer descendants than this are cleaned up by
+  //! CleanupHelper() in the same task as their parent.
+  static constexpr size_t TaskMinDescendants = 1024;
+
  public:
   /**
    * Create the tree from the given dataset.  This copies the dataset to an
@@ -173,15 +191,25 @@ class DualTreeBoruvka
 
  private:
   /**
-   * Adds a single edge to the edge list
+   * Adds a single edge to the given edge list.
    */
-  void AddEdge(const size_t e1, const size_t e2, const double distance);
+  void AddEdge(const size_t e1,
+               const size_t e2,
+               const double distance,
+               std::vector<EdgePair>& edgeList);
 
   /**
    * Adds all the edges found in one iteration to the list of neighbors.
    */
   void AddAllEdges();
 
+  /**
+   * Find the candidate edge of every component with a dual-tree traversal,
+   * split between threads by query subtree.
+   */
+  template<typename RuleType>
+  void DualTreeTraversal(RuleType& rules);
+
   /**
    * Unpermute the edge list and output it to results.
    */
@@ -106,14 +106,19 @@ void DualTreeBoruvka<DistanceType, MatType, TreeType>::ComputeMST(
     if (naive)
     {
       // Full O(N^2) traversal.
-      for (size_t i = 0; i < data.n_cols; ++i)
-        for (size_t j = 0; j < data.n_cols; ++j)
-          rules.BaseCase(i, j);
+      #pragma omp parallel
+      {
+        RuleType threadRules(rules);
+
+        #pragma omp for schedule(dynamic, 16)
+        for (size_t i = 0; i < (size_t) data.n_cols; ++i)
+          for (size_t j = 0; j < data.n_cols; ++j)
+            threadRules.BaseCase(i, j);
+      }
     }
     else
     {
-      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-      traverser.Traverse(*tree, *tree);
+      DualTreeTraversal(rules);
     }
 
     AddAllEdges();
@@ -135,7 +140,78 @@ void DualTreeBoruvka<DistanceType, MatType, TreeType>::ComputeMST(
 }
 
 /**
- * Adds a single edge to the edge list
+ * Split the tree into disjoint query subtrees and traverse each of them against
+ * the whole tree.
+ */
+template<
+    typename DistanceType,
+    typename MatType,
+    template<typename TreeDistanceType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+template<typename RuleType>
+void DualTreeBoruvka<DistanceType, MatType, TreeType>::DualTreeTraversal(
+    RuleType& rules)
+{
+  #ifdef MLPACK_USE_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  #else
+  const size_t numThreads = 1;
+  #endif
+
+  // Split the tree into disjoint subtrees, by repeatedly replacing the largest
+  // subtree with its children, until there are a few subtrees for each thread.
+  // With one thread, the whole tree is traversed at once, as before.
+  std::vector<Tree*> subtrees(1, tree);
+  const size_t numSubtrees = (numThreads == 1) ? 1 : 8 * numThreads;
+  while (subtrees.size() < numSubtrees)
+  {
+    size_t largest = 0;
+    for (size_t i = 1; i < subtrees.size(); ++i)
+    {
+      if (subtrees[i]->NumDescendants() > subtrees[largest]->NumDescendants())
+        largest = i;
+    }
+
+    Tree* node = subtrees[largest];
+    if (node->NumChildren() == 0)
+      break;
+
+    subtrees[largest] = &node->Child(0);
+    for (size_t i = 1; i < node->NumChildren(); ++i)
+      subtrees.push_back(&node->Child(i));
+  }
+
+  const typename RuleType::TraversalInfoType initialInfo =
+      rules.TraversalInfo();
+
+  #pragma omp parallel
+  {
+    // Each thread has its own copy of the rules, which holds the traversal
+    // state and the counters but shares the candidate edges.  The query
+    // subtrees are disjoint, so the bounds in their nodes need no locking.
+    RuleType threadRules(rules);
+    threadRules.Scores() = 0;
+    threadRules.BaseCases() = 0;
+    typename Tree::template DualTreeTraverser<RuleType> traverser(threadRules);
+
+    #pragma omp for schedule(dynamic, 1)
+    for (size_t i = 0; i < subtrees.size(); ++i)
+    {
+      threadRules.TraversalInfo() = initialInfo;
+      traverser.Traverse(*subtrees[i], *tree);
+    }
+
+    #pragma omp critical
+    {
+      rules.Scores() += threadRules.Scores();
+      rules.BaseCases() += threadRules.BaseCases();
+    }
+  }
+}
+
+/**
+ * Adds a single edge to the given edge list.
  */
 template<
     typename DistanceType,
@@ -146,15 +222,16 @@ template<
 void DualTreeBoruvka<DistanceType, MatType, TreeType>::AddEdge(
     const size_t e1,
     const size_t e2,
-    const double distance)
+    const double distance,
+    std::vector<EdgePair>& edgeList)
 {
   Log::Assert((distance >= 0.0),
       "DualTreeBoruvka::AddEdge(): distance cannot be negative.");
 
   if (e1 < e2)
-    edges.push_back(EdgePair(e1, e2, distance));
+    edgeList.push_back(EdgePair(e1, e2, distance));
   else
-    edges.push_back(EdgePair(e2, e1, distance));
+    edgeList.push_back(EdgePair(e2, e1, distance));
 }
 
 /**
@@ -168,18 +245,39 @@ template<
              typename TreeMatType> class TreeType>
 void DualTreeBoruvka<DistanceType, MatType, TreeType>::AddAllEdges()
 {
+  // Collect the components of this round before any of them are merged.
+  std::vector<size_t> components;
   for (size_t i = 0; i < data.n_cols; ++i)
+    if (connections.Find(i) == i && neighborsDistances[i] != DBL_MAX)
+      components.push_back(i);
+
+  #pragma omp parallel
   {
-    size_t component = connections.Find(i);
-    size_t inEdge = neighborsInComponent[component];
-    size_t outEdge = neighborsOutComponent[component];
-    if (connections.Find(inEdge) != connections.Find(outEdge))
+    std::vector<EdgePair> threadEdges;
+    double threadDist = 0.0;
+
+    #pragma omp for schedule(static)
+    for (size_t i = 0; i < components.size(); ++i)
+    {
+      const size_t component = components[i];
+      const size_t inEdge = neighborsInComponent[component];
+      const size_t outEdge = neighborsOutComponent[component];
+
+      // Two components may have found the same edge; only the union that
+      // actually joins them adds it.
+      if (connections.Union(inEdge, outEdge))
+      {
+        // totalDist = totalDist + dist;
+        // changed to make this agree with the cover tree code
+        threadDist += neighborsDistances[component];
+        AddEdge(inEdge, outEdge, neighborsDistances[component], threadEdges);
+      }
+    }
+
+    #pragma omp critical
     {
-      // totalDist = totalDist + dist;
-      // changed to make this agree with the cover tree code
-      totalDist += neighborsDistances[component];
-      AddEdge(inEdge, outEdge, neighborsDistances[component]);
-      connections.Union(inEdge, outEdge);
+      edges.insert(edges.end(), threadEdges.begin(), threadEdges.end());
+      totalDist += threadDist;
     }
   }
 }
@@ -256,9 +354,15 @@ void DualTreeBoruvka<DistanceType, MatType, TreeType>::CleanupHelper(Tree* tree)
   tree->Stat().MinNeighborDistance() = DBL_MAX;
   tree->Stat().Bound() = DBL_MAX;
 
-  // Recurse into all children.
+  // Recurse into all children.  Children only touch their own subtrees, so
+  // large ones are cleaned up in parallel tasks.
   for (size_t i = 0; i < tree->NumChildren(); ++i)
+  {
+    #pragma omp task default(shared) firstprivate(i) \
+        if(tree->Child(i).NumDescendants() >= TaskMinDescendants)
     CleanupHelper(&tree->Child(i));
+  }
+  #pragma omp taskwait
 
   // Get the component of the first child or point.  Then we will check to see
   // if all other components of children and points are the same.
@@ -291,11 +395,18 @@ template<
              typename TreeMatType> class TreeType>
 void DualTreeBoruvka<DistanceType, MatType, TreeType>::Cleanup()
 {
-  for (size_t i = 0; i < data.n_cols; ++i)
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < (size_t) data.n_cols; ++i)
     neighborsDistances[i] = DBL_MAX;
 
   if (!naive)
-    CleanupHelper(tree);
+  {
+    #pragma omp parallel
+    {
+      #pragma omp single
+      CleanupHelper(tree);
+    }
+  }
 }
 
 } // namespace mlpack
@@ -15,6 +15,7 @@
 #include <mlpack/prereqs.hpp>
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include "union_find.hpp"
 
 namespace mlpack {
 
@@ -23,7 +24,7 @@ class DTBRules
 {
  public:
   DTBRules(const arma::mat& dataSet,
-           UnionFind& connections,
+           ConcurrentUnionFind& connections,
            arma::vec& neighborsDistances,
            arma::Col<size_t>& neighborsInComponent,
            arma::Col<size_t>& neighborsOutComponent,
@@ -101,7 +102,7 @@ class DTBRules
   const arma::mat& dataSet;
 
   //! Stores the tree structure so far
-  UnionFind& connections;
+  ConcurrentUnionFind& connections;
 
   //! The distance to the candidate nearest neighbor for each component.
   arma::vec& neighborsDistances;
@@ -122,6 +123,22 @@ class DTBRules
    */
   inline double CalculateBound(TreeType& queryNode) const;
 
+  /**
+   * Get the distance of the candidate edge of the given component.  Other
+   * threads may update it at the same time.
+   */
+  double NeighborDistance(const size_t component) const;
+
+  /**
+   * Make the given edge the candidate edge of the given component, if it is
+   * better than the current candidate.  Edges of equal length are ordered by
+   * their points.
+   */
+  void UpdateNeighbor(const size_t component,
+                      const size_t queryIndex,
+                      const size_t referenceIndex,
+                      const double dist);
+
   TraversalInfoType traversalInfo;
 
   //! The number of base cases calculated.
@@ -17,7 +17,7 @@ namespace mlpack {
 template<typename DistanceType, typename TreeType>
 DTBRules<DistanceType, TreeType>::
 DTBRules(const arma::mat& dataSet,
-         UnionFind& connections,
+         ConcurrentUnionFind& connections,
          arma::vec& neighborsDistances,
          arma::Col<size_t>& neighborsInComponent,
          arma::Col<size_t>& neighborsOutComponent,
@@ -56,18 +56,17 @@ double DTBRules<DistanceType, TreeType>::BaseCase(const size_t queryIndex,
     double dist = distance.Evaluate(dataSet.col(queryIndex),
                                     dataSet.col(referenceIndex));
 
-    if (dist < neighborsDistances[queryComponentIndex])
+    if (dist <= NeighborDistance(queryComponentIndex))
     {
       Log::Assert(queryIndex != referenceIndex);
 
-      neighborsDistances[queryComponentIndex] = dist;
-      neighborsInComponent[queryComponentIndex] = queryIndex;
-      neighborsOutComponent[queryComponentIndex] = referenceIndex;
+      UpdateNeighbor(queryComponentIndex, queryIndex, referenceIndex, dist);
     }
   }
 
-  if (newUpperBound < neighborsDistances[queryComponentIndex])
-    newUpperBound = neighborsDistances[queryComponentIndex];
+  const double neighborDistance = NeighborDistance(queryComponentIndex);
+  if (newUpperBound < neighborDistance)
+    newUpperBound = neighborDistance;
 
   Log::Assert(newUpperBound >= 0.0);
 
@@ -92,7 +91,7 @@ double DTBRules<DistanceType, TreeType>::Score(const size_t queryIndex,
 
   // If all the points in the reference node are farther than the candidate
   // nearest neighbor for the query's component, we prune.
-  return neighborsDistances[queryComponentIndex] < distance
+  return NeighborDistance(queryComponentIndex) < distance
       ? DBL_MAX : distance;
 }
 
@@ -103,7 +102,7 @@ double DTBRules<DistanceType, TreeType>::Rescore(const size_t queryIndex,
 {
   // We don't need to check component membership again, because it can't
   // change inside a single iteration.
-  return (oldScore > neighborsDistances[connections.Find(queryIndex)])
+  return (oldScore > NeighborDistance(connections.Find(queryIndex)))
       ? DBL_MAX : oldScore;
 }
 
@@ -152,7 +151,7 @@ inline double DTBRules<DistanceType, TreeType>::CalculateBound(
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
     const size_t pointComponent = connections.Find(queryNode.Point(i));
-    const double bound = neighborsDistances[pointComponent];
+    const double bound = NeighborDistance(pointComponent);
 
     if (bound > worstPointBound)
       worstPointBound = bound;
@@ -187,6 +186,51 @@ inline double DTBRules<DistanceType, TreeType>::CalculateBound(
   return queryNode.Stat().Bound();
 }
 
+template<typename DistanceType, typename TreeType>
+inline double DTBRules<DistanceType, TreeType>::NeighborDistance(
+    const size_t component) const
+{
+  double neighborDistance;
+  #pragma omp atomic read
+  neighborDistance = neighborsDistances[component];
+  return neighborDistance;
+}
+
+template<typename DistanceType, typename TreeType>
+inline void DTBRules<DistanceType, TreeType>::UpdateNeighbor(
+    const size_t component,
+    const size_t queryIndex,
+    const size_t referenceIndex,
+    const double dist)
+{
+  // Several threads may search for the neighbors of points of the same
+  // component.
+  #pragma omp critical(DTBRulesUpdateNeighbor)
+  {
+    const double current = neighborsDistances[component];
+    bool better = (dist < current);
+    if (!better && dist == current)
+    {
+      // Break ties by the points of the edge, so that the candidate does not
+      // depend on the order of the traversal.  This also keeps the candidate
+      // edges of one round from forming a cycle.
+      const size_t in = neighborsInComponent[component];
+      const size_t out = neighborsOutComponent[component];
+      better = std::make_pair(std::min(queryIndex, referenceIndex),
+          std::max(queryIndex, referenceIndex)) <
+          std::make_pair(std::min(in, out), std::max(in, out));
+    }
+
+    if (better)
+    {
+      #pragma omp atomic write
+      neighborsDistances[component] = dist;
+      neighborsInComponent[component] = queryIndex;
+      neighborsOutComponent[component] = referenceIndex;
+    }
+  }
+}
+
 } // namespace mlpack
 
 #endif
@@ -6,6 +6,7 @@
  * of a graph.  Each point in the graph is initially in its own component.
  * Calling unionfind.Union(x, y) unites the components indexed by x and y.
  * unionfind.Find(x) returns the index of the component containing point x.
+ * ConcurrentUnionFind is a lock-free version that can be shared by threads.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
@@ -17,6 +18,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include <atomic>
+
 namespace mlpack {
 
 /**
@@ -97,6 +100,93 @@ class UnionFind
   }
 }; // class UnionFind
 
+/**
+ * A lock-free Union-Find data structure that can be used by several threads at
+ * once.  Find() and Union() can be called concurrently; each parent pointer is
+ * an atomic, roots are linked with a compare-and-swap, and paths are halved
+ * during Find().
+ *
+ * To keep concurrent unions from creating cycles, the root with the larger
+ * index is always linked below the root with the smaller index (instead of
+ * using ranks).  As a result, once all unions are done, Find(x) returns the
+ * smallest index of the component containing x, whatever the order the unions
+ * were done in.
+ */
+class ConcurrentUnionFind
+{
+ private:
+  std::vector<std::atomic<size_t>> parent;
+
+ public:
+  //! Construct the object with the given size.
+  ConcurrentUnionFind(const size_t size) : parent(size)
+  {
+    for (size_t i = 0; i < size; ++i)
+      parent[i].store(i, std::memory_order_relaxed);
+  }
+
+  /**
+   * Returns the component containing an element.  If other threads are doing
+   * unions at the same time, the result may already be out of date when this
+   * returns.
+   *
+   * @param x the component to be found
+   * @return The index of the component containing x
+   */
+  size_t Find(size_t x)
+  {
+    size_t p = parent[x].load(std::memory_order_relaxed);
+    while (p != x)
+    {
+      // Path halving: point x at its grandparent.  If another thread changed
+      // the parent of x in the meantime, it is still an ancestor, so a failed
+      // exchange does no harm.
+      const size_t grandparent = parent[p].load(std::memory_order_relaxed);
+      if (grandparent != p)
+      {
+        parent[x].compare_exchange_weak(p, grandparent,
+            std::memory_order_relaxed);
+      }
+
+      x = p;
+      p = parent[x].load(std::memory_order_relaxed);
+    }
+
+    return x;
+  }
+
+  /**
+   * Union the components containing x and y.  Exactly one of several
+   * concurrent calls that would join the same two components returns true.
+   *
+   * @param x one component
+   * @param y the other component
+   * @return true if x and y were in different components.
+   */
+  bool Union(const size_t x, const size_t y)
+  {
+    size_t xRoot = Find(x);
+    size_t yRoot = Find(y);
+    while (xRoot != yRoot)
+    {
+      // Link the larger root below the smaller one.
+      if (xRoot < yRoot)
+        std::swap(xRoot, yRoot);
+
+      size_t expected = xRoot;
+      if (parent[xRoot].compare_exchange_strong(expected, yRoot,
+          std::memory_order_relaxed))
+        return true;
+
+      // Another thread linked xRoot first; try again from the new roots.
+      xRoot = Find(xRoot);
+      yRoot = Find(yRoot);
+    }
+
+    return false;
+  }
+}; // class ConcurrentUnionFind
+
 } // namespace mlpack
 
 #endif // MLPACK_METHODS_EMST_UNION_FIND_HPP
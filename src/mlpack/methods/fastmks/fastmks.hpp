@@ -307,6 +307,12 @@ class FastMKS
   //! Modify whether or not brute-force (naive) search is used.
   bool& Naive() { return naive; }
 
+  //! Get the number of base cases (kernel evaluations between a query and a
+  //! reference point) of the last search.
+  size_t BaseCases() const { return baseCases; }
+  //! Get the number of node combinations scored during the last search.
+  size_t Scores() const { return scores; }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -331,6 +337,54 @@ class FastMKS
   //! kernel.
   IPMetric<KernelType> distance;
 
+  //! The number of base cases of the last search.
+  size_t baseCases = 0;
+  //! The number of node combinations scored during the last search.
+  size_t scores = 0;
+
+  /**
+   * Run the single-tree traversal of the reference tree for each of the first
+   * numQueries query points of the given rules.  The queries are split between
+   * OpenMP threads.
+   *
+   * @param rules Rules to traverse with; the counters of all threads are added
+   *     to them.
+   * @param numQueries Number of query points.
+   */
+  template<typename RuleType>
+  void SingleTreeSearch(RuleType& rules, const size_t numQueries);
+
+  /**
+   * Run the dual-tree traversal of the given query tree and the reference tree.
+   * The query tree is split into subtrees, which are traversed by different
+   * OpenMP threads.
+   *
+   * @param rules Rules to traverse with; the counters of all threads are added
+   *     to them.
+   * @param queryTree Tree built on the query points of the rules.
+   */
+  template<typename RuleType>
+  void DualTreeSearch(RuleType& rules, Tree& queryTree);
+
+  /**
+   * Find the k candidates with the largest kernel values for each query point
+   * by brute force.  The kernel values are computed by blocks of query and
+   * reference points, and the blocks of query points are split between OpenMP
+   * threads.
+   *
+   * @param querySet Set of query points.
+   * @param monochromatic If true, the query set is the reference set, and a
+   *     point is never its own candidate.
+   * @param k Number of candidates to find.
+   * @param indices Matrix to store the indices of the candidates into.
+   * @param kernels Matrix to store the kernel values of the candidates into.
+   */
+  void NaiveSearch(const MatType& querySet,
+                   const bool monochromatic,
+                   const size_t k,
+                   arma::Mat<size_t>& indices,
+                   arma::mat& kernels);
+
   //! Candidate represents a possible candidate point (value, index).
   typedef std::pair<double, size_t> Candidate;
 
@@ -436,34 +436,7 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < querySet.n_cols; ++q)
-    {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-      std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
-
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
-      {
-        const double eval = distance.Kernel().Evaluate(querySet.col(q),
-                                                       referenceSet->col(r));
-
-        if (eval > pqueue.top().first)
-        {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
-        }
-      }
-
-      for (size_t j = 1; j <= k; ++j)
-      {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
-      }
-    }
-
+    NaiveSearch(querySet, false, k, indices, kernels);
     return;
   }
 
@@ -475,13 +448,12 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
     typedef FastMKSRules<KernelType, Tree> RuleType;
     RuleType rules(*referenceSet, querySet, k, distance.Kernel());
 
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+    SingleTreeSearch(rules, querySet.n_cols);
 
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
-
-    Log::Info << rules.BaseCases() << " base cases." << std::endl;
-    Log::Info << rules.Scores() << " scores." << std::endl;
+    baseCases = rules.BaseCases();
+    scores = rules.Scores();
+    Log::Info << baseCases << " base cases." << std::endl;
+    Log::Info << scores << " scores." << std::endl;
 
     rules.GetResults(indices, kernels);
 
@@ -536,12 +508,12 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   typedef FastMKSRules<KernelType, Tree> RuleType;
   RuleType rules(*referenceSet, queryTree->Dataset(), k, distance.Kernel());
 
-  typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-
-  traverser.Traverse(*queryTree, *referenceTree);
+  DualTreeSearch(rules, *queryTree);
 
-  Log::Info << rules.BaseCases() << " base cases." << std::endl;
-  Log::Info << rules.Scores() << " scores." << std::endl;
+  baseCases = rules.BaseCases();
+  scores = rules.Scores();
+  Log::Info << baseCases << " base cases." << std::endl;
+  Log::Info << scores << " scores." << std::endl;
 
   rules.GetResults(indices, kernels);
 }
@@ -563,68 +535,229 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < referenceSet->n_cols; ++q)
-    {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-      std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
+    NaiveSearch(*referenceSet, true, k, indices, kernels);
+    return;
+  }
 
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
-      {
-        if (q == r)
-          continue; // Don't return the point as its own candidate.
+  // Single-tree implementation.
+  if (singleMode)
+  {
+    // Create rules object (this will store the results).  This constructor
+    // precalculates each self-kernel value.
+    typedef FastMKSRules<KernelType, Tree> RuleType;
+    RuleType rules(*referenceSet, *referenceSet, k, distance.Kernel());
+
+    SingleTreeSearch(rules, referenceSet->n_cols);
+
+    baseCases = rules.BaseCases();
+    scores = rules.Scores();
+    Log::Info << baseCases << " base cases." << std::endl;
+    Log::Info << scores << " scores." << std::endl;
+
+    rules.GetResults(indices, kernels);
 
-        const double eval = distance.Kernel().Evaluate(referenceSet->col(q),
-                                                       referenceSet->col(r));
+    return;
+  }
+
+  // Dual-tree implementation.
+  Search(referenceTree, k, indices, kernels);
+}
 
-        if (eval > pqueue.top().first)
+//! Run a brute-force search for each query point.
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void FastMKS<KernelType, MatType, TreeType>::NaiveSearch(
+    const MatType& querySet,
+    const bool monochromatic,
+    const size_t k,
+    arma::Mat<size_t>& indices,
+    arma::mat& kernels)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  // The kernel values between a block of query points and a block of
+  // reference points are computed at once with KernelMatrix() (with a single
+  // matrix multiplication for many kernels).  Each block of query points is
+  // independent, so the blocks are split between threads.
+  const size_t queryBlockSize = 64;
+  const size_t referenceBlockSize = 1024;
+  const size_t queryBlocks = (querySet.n_cols + queryBlockSize - 1) /
+      queryBlockSize;
+  baseCases = querySet.n_cols * referenceSet->n_cols -
+      (monochromatic ? querySet.n_cols : 0);
+  scores = 0;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < queryBlocks; ++block)
+  {
+    const size_t queryBegin = block * queryBlockSize;
+    const size_t queryEnd = std::min(queryBegin + queryBlockSize,
+        (size_t) querySet.n_cols);
+    const MatType queries = querySet.cols(queryBegin, queryEnd - 1);
+
+    const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
+    std::vector<CandidateList> pqueues;
+    pqueues.reserve(queries.n_cols);
+    for (size_t q = 0; q < queries.n_cols; ++q)
+      pqueues.emplace_back(CandidateCmp(), std::vector<Candidate>(k, def));
+
+    arma::Mat<ElemType> evals;
+    for (size_t refBegin = 0; refBegin < referenceSet->n_cols;
+         refBegin += referenceBlockSize)
+    {
+      const size_t refEnd = std::min(refBegin + referenceBlockSize,
+          (size_t) referenceSet->n_cols);
+      const MatType references = referenceSet->cols(refBegin, refEnd - 1);
+      KernelMatrix(distance.Kernel(), references, queries, evals);
+
+      for (size_t q = 0; q < queries.n_cols; ++q)
+      {
+        CandidateList& pqueue = pqueues[q];
+        for (size_t r = 0; r < references.n_cols; ++r)
         {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
+          // Don't return the point as its own candidate.
+          if (monochromatic && queryBegin + q == refBegin + r)
+            continue;
+
+          const double eval = (double) evals(r, q);
+          if (eval > pqueue.top().first)
+          {
+            Candidate c = std::make_pair(eval, refBegin + r);
+            pqueue.pop();
+            pqueue.push(c);
+          }
         }
       }
+    }
 
+    for (size_t q = 0; q < queries.n_cols; ++q)
+    {
       for (size_t j = 1; j <= k; ++j)
       {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
+        indices(k - j, queryBegin + q) = pqueues[q].top().second;
+        kernels(k - j, queryBegin + q) = pqueues[q].top().first;
+        pqueues[q].pop();
       }
     }
-
-    return;
   }
+}
 
-  // Single-tree implementation.
-  if (singleMode)
-  {
-    // Create rules object (this will store the results).  This constructor
-    // precalculates each self-kernel value.
-    typedef FastMKSRules<KernelType, Tree> RuleType;
-    RuleType rules(*referenceSet, *referenceSet, k, distance.Kernel());
-
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+//! Run a single-tree traversal for each query point.
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename RuleType>
+void FastMKS<KernelType, MatType, TreeType>::SingleTreeSearch(
+    RuleType& rules,
+    const size_t numQueries)
+{
+  size_t numPrunes = 0;
 
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+  #pragma omp parallel
+  {
+    // Each thread has its own copy of the rules, which holds the traversal
+    // state and the counters but shares the candidate lists; since every query
+    // point is handled by a single thread, the results need no locking.
+    RuleType threadRules(rules);
+    threadRules.Scores() = 0;
+    threadRules.BaseCases() = 0;
+    typename Tree::template SingleTreeTraverser<RuleType> traverser(
+        threadRules);
+
+    #pragma omp for schedule(dynamic, 16)
+    for (size_t i = 0; i < numQueries; ++i)
       traverser.Traverse(i, *referenceTree);
 
-    // Save the number of pruned nodes.
-    const size_t numPrunes = traverser.NumPrunes();
+    #pragma omp critical
+    {
+      rules.Scores() += threadRules.Scores();
+      rules.BaseCases() += threadRules.BaseCases();
+      numPrunes += traverser.NumPrunes();
+    }
+  }
+
+  Log::Info << "Pruned " << numPrunes << " nodes." << std::endl;
+}
 
-    Log::Info << "Pruned " << numPrunes << " nodes." << std::endl;
+//! Run a dual-tree traversal, splitting the query tree between threads.
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename RuleType>
+void FastMKS<KernelType, MatType, TreeType>::DualTreeSearch(
+    RuleType& rules,
+    Tree& queryTree)
+{
+  #ifdef MLPACK_USE_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  #else
+  const size_t numThreads = 1;
+  #endif
+
+  // Split the query tree into disjoint subtrees that cover every query point,
+  // by repeatedly replacing the largest subtree with its children, until there
+  // are a few subtrees for each thread.  With one thread, the whole tree is
+  // traversed at once, as before.
+  std::vector<Tree*> subtrees(1, &queryTree);
+  const size_t numSubtrees = (numThreads == 1) ? 1 : 8 * numThreads;
+  while (subtrees.size() < numSubtrees)
+  {
+    size_t largest = 0;
+    for (size_t i = 1; i < subtrees.size(); ++i)
+    {
+      if (subtrees[i]->NumDescendants() > subtrees[largest]->NumDescendants())
+        largest = i;
+    }
 
-    Log::Info << rules.BaseCases() << " base cases." << std::endl;
-    Log::Info << rules.Scores() << " scores." << std::endl;
+    Tree* node = subtrees[largest];
+    if (node->NumChildren() == 0)
+      break;
 
-    rules.GetResults(indices, kernels);
+    // The bound of a node above the subtrees is used by its children, but is
+    // never updated during the traversal, so it must not be left over from an
+    // earlier search.
+    node->Stat().Bound() = -DBL_MAX;
 
-    return;
+    subtrees[largest] = &node->Child(0);
+    for (size_t i = 1; i < node->NumChildren(); ++i)
+      subtrees.push_back(&node->Child(i));
   }
 
-  // Dual-tree implementation.
-  Search(referenceTree, k, indices, kernels);
+  const typename RuleType::TraversalInfoType initialInfo =
+      rules.TraversalInfo();
+
+  #pragma omp parallel
+  {
+    // Each thread has its own copy of the rules, which holds the traversal
+    // state and the counters but shares the candidate lists; the subtrees hold
+    // disjoint sets of query points, so the results need no locking.
+    RuleType threadRules(rules);
+    threadRules.Scores() = 0;
+    threadRules.BaseCases() = 0;
+    typename Tree::template DualTreeTraverser<RuleType> traverser(threadRules);
+
+    #pragma omp for schedule(dynamic, 1)
+    for (size_t i = 0; i < subtrees.size(); ++i)
+    {
+      // Each subtree is traversed from the reference root, so it starts from
+      // the initial traversal state.
+      threadRules.TraversalInfo() = initialInfo;
+      traverser.Traverse(*subtrees[i], *referenceTree);
+    }
+
+    #pragma omp critical
+    {
+      rules.Scores() += threadRules.Scores();
+      rules.BaseCases() += threadRules.BaseCases();
+    }
+  }
 }
 
 //! Serialize the model.
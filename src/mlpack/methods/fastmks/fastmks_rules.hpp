@@ -17,6 +17,8 @@
 #include <mlpack/core/tree/cover_tree/cover_tree.hpp>
 #include <mlpack/core/tree/traversal_info.hpp>
 #include <algorithm>
+#include <memory>
+#include <unordered_map>
 
 namespace mlpack {
 
@@ -25,6 +27,11 @@ namespace mlpack {
  * performing exact max-kernel search. For each point in the query dataset, it
  * keeps track of the k best candidates in the reference dataset.
  *
+ * Copies of a FastMKSRules object share the candidate lists, but not the
+ * traversal state or the counters, so that several threads can each traverse
+ * with their own copy as long as each query point is handled by only one of
+ * them.
+ *
  * @tparam KernelType Type of kernel to run FastMKS with.
  * @tparam TreeType Type of tree to run FastMKS with; it must satisfy the
  *     TreeType policy API.
@@ -146,8 +153,8 @@ class FastMKSRules
 
   //! Set of candidates for each point.  We use a min-heap built on a
   //! std::vector to represent the list of candidate points for each query
-  //! point.
-  std::vector<std::vector<Candidate>> candidates;
+  //! point.  This is shared between copies of the rules.
+  std::shared_ptr<std::vector<std::vector<Candidate>>> candidates;
 
   //! Number of points to search for.
   const size_t k;
@@ -167,6 +174,13 @@ class FastMKSRules
   //! The last kernel evaluation resulting from BaseCase().
   double lastKernel;
 
+  //! The kernel evaluation of each reference node scored by single-tree
+  //! Score() for the current query point.  This is kept here instead of in the
+  //! statistic of each node, so that threads may share the reference tree.
+  std::unordered_map<const TreeType*, double> nodeKernels;
+  //! The query point that the kernel evaluations in nodeKernels are for.
+  size_t nodeKernelsQuery;
+
   //! Calculate the bound for a given query node.
   double CalculateBound(TreeType& queryNode) const;
 
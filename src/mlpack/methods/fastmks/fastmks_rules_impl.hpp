@@ -30,6 +30,7 @@ FastMKSRules<KernelType, TreeType>::FastMKSRules(
     lastQueryIndex(-1),
     lastReferenceIndex(-1),
     lastKernel(0.0),
+    nodeKernelsQuery(querySet.n_cols),
     baseCases(0),
     scores(0)
 {
@@ -57,7 +58,8 @@ FastMKSRules<KernelType, TreeType>::FastMKSRules(
 
   std::vector<Candidate> pqueue(k, def);
   std::make_heap(pqueue.begin(), pqueue.end(), CandidateCmp());
-  candidates = std::vector<std::vector<Candidate>>(querySet.n_cols, pqueue);
+  candidates.reset(new std::vector<std::vector<Candidate>>(querySet.n_cols,
+      pqueue));
 }
 
 template<typename KernelType, typename TreeType>
@@ -68,9 +70,10 @@ void FastMKSRules<KernelType, TreeType>::GetResults(
   indices.set_size(k, querySet.n_cols);
   products.set_size(k, querySet.n_cols);
 
+  #pragma omp parallel for schedule(static)
   for (size_t i = 0; i < querySet.n_cols; ++i)
   {
-    std::vector<Candidate>& pqueue = candidates[i];
+    std::vector<Candidate>& pqueue = (*candidates)[i];
     std::sort_heap(pqueue.begin(), pqueue.end(), CandidateCmp());
     for (size_t j = 0; j < k; ++j)
     {
@@ -125,16 +128,30 @@ double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
                                                  TreeType& referenceNode)
 {
   // Compare with the current best.
-  const double bestKernel = candidates[queryIndex].front().first;
+  const double bestKernel = (*candidates)[queryIndex].front().first;
+
+  // The kernel evaluations of the nodes scored for another query point are of
+  // no use for this one.
+  if (queryIndex != nodeKernelsQuery)
+  {
+    nodeKernels.clear();
+    nodeKernelsQuery = queryIndex;
+  }
+
+  // The parent of the reference node (if any) has always been scored for this
+  // query point before the reference node itself.
+  typename std::unordered_map<const TreeType*, double>::const_iterator
+      parentKernel = (referenceNode.Parent() == NULL) ? nodeKernels.end() :
+      nodeKernels.find(referenceNode.Parent());
 
   // See if we can perform a parent-child prune.
   const double furthestDist = referenceNode.FurthestDescendantDistance();
-  if (referenceNode.Parent() != NULL)
+  if (parentKernel != nodeKernels.end())
   {
     double maxKernelBound;
     const double parentDist = referenceNode.ParentDistance();
     const double combinedDistBound = parentDist + furthestDist;
-    const double lastKernel = referenceNode.Parent()->Stat().LastKernel();
+    const double lastKernel = parentKernel->second;
     if (KernelTraits<KernelType>::IsNormalized)
     {
       const double squaredDist = std::pow(combinedDistBound, 2.0);
@@ -169,10 +186,10 @@ double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
   {
     // Could it be that this kernel evaluation has already been calculated?
     if (TreeTraits<TreeType>::HasSelfChildren &&
-        referenceNode.Parent() != NULL &&
+        parentKernel != nodeKernels.end() &&
         referenceNode.Point(0) == referenceNode.Parent()->Point(0))
     {
-      kernelEval = referenceNode.Parent()->Stat().LastKernel();
+      kernelEval = parentKernel->second;
     }
     else
     {
@@ -187,7 +204,7 @@ double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
     kernelEval = kernel.Evaluate(querySet.col(queryIndex), refCenter);
   }
 
-  referenceNode.Stat().LastKernel() = kernelEval;
+  nodeKernels[&referenceNode] = kernelEval;
 
   double maxKernel;
   if (KernelTraits<KernelType>::IsNormalized)
@@ -410,7 +427,7 @@ double FastMKSRules<KernelType, TreeType>::Rescore(const size_t queryIndex,
                                                    TreeType& /*referenceNode*/,
                                                    const double oldScore) const
 {
-  const double bestKernel = candidates[queryIndex].front().first;
+  const double bestKernel = (*candidates)[queryIndex].front().first;
 
   return ((1.0 / oldScore) >= bestKernel) ? oldScore : DBL_MAX;
 }
@@ -457,7 +474,7 @@ double FastMKSRules<KernelType, TreeType>::CalculateBound(TreeType& queryNode)
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
     const size_t point = queryNode.Point(i);
-    const std::vector<Candidate>& candidatesPoints = candidates[point];
+    const std::vector<Candidate>& candidatesPoints = (*candidates)[point];
     if (candidatesPoints.front().first < worstPointKernel)
       worstPointKernel = candidatesPoints.front().first;
 
@@ -527,7 +544,7 @@ inline void FastMKSRules<KernelType, TreeType>::InsertNeighbor(
     const size_t index,
     const double product)
 {
-  std::vector<Candidate>& pqueue = candidates[queryIndex];
+  std::vector<Candidate>& pqueue = (*candidates)[queryIndex];
   if (product > pqueue.front().first)
   {
     Candidate c = std::make_pair(product, index);
@@ -19,6 +19,8 @@
 
 // This is the default fitting method class.
 #include "em_fit.hpp"
+// Online fitting method class.
+#include "stepwise_em_fit.hpp"
 
 // This is the default covariance matrix constraint.
 #include "diagonal_constraint.hpp"
@@ -69,9 +71,37 @@ namespace mlpack {
  * // Get a random observation from the DiagonalGMM.
  * arma::vec observation = g.Random();
  * @endcode
+ *
+ * The model can hold its parameters with other element types than double by
+ * using DiagonalGMMType with another MatType (for instance, arma::fmat); the
+ * log-probabilities are then computed in that type, which halves the memory
+ * traffic and doubles the width of the vectorized loops for float.  Models
+ * are trained in double precision, so a model with another element type is
+ * obtained from a trained DiagonalGMM:
+ *
+ * @code
+ * DiagonalGMM g(1024, 40);
+ * g.Train(data);
+ *
+ * DiagonalGMMType<arma::fmat> fg(g);
+ * arma::fvec logProbs;
+ * fg.LogProbability(arma::conv_to<arma::fmat>::from(data), logProbs);
+ * @endcode
+ *
+ * @tparam MatType Type of the matrices of observations (and of the
+ *     parameters of the model).
  */
-class DiagonalGMM
+template<typename MatType = arma::mat>
+class DiagonalGMMType
 {
+ public:
+  //! The element type of the model.
+  using ElemType = typename MatType::elem_type;
+  //! The vector type of the model.
+  using VecType = typename GetColType<MatType>::type;
+  //! The type of the components.
+  using DistributionType = DiagonalGaussianDistribution<MatType>;
+
  private:
   //! The number of Gaussians in the model.
   size_t gaussians;
@@ -79,16 +109,16 @@ class DiagonalGMM
   size_t dimensionality;
 
   //! Vector of Gaussians.
-  std::vector<DiagonalGaussianDistribution<>> dists;
+  std::vector<DistributionType> dists;
 
   //! Vector of a priori weights for each Gaussian.
-  arma::vec weights;
+  VecType weights;
 
  public:
   /**
    * Create an empty Diagonal Gaussian Mixture Model, with zero gaussians.
    */
-  DiagonalGMM() :
+  DiagonalGMMType() :
       gaussians(0),
       dimensionality(0)
   {
@@ -106,7 +136,7 @@ class DiagonalGMM
    * @param gaussians Number of Gaussians in this DiagonalGMM.
    * @param dimensionality Dimensionality of each Gaussian.
    */
-  DiagonalGMM(const size_t gaussians, const size_t dimensionality);
+  DiagonalGMMType(const size_t gaussians, const size_t dimensionality);
 
   /**
    * Create a DiagonalGMM with the given dists and weights.
@@ -114,18 +144,30 @@ class DiagonalGMM
    * @param dists Distributions of the model.
    * @param weights Weights of the model.
    */
-  DiagonalGMM(const std::vector<DiagonalGaussianDistribution<>>& dists,
-              const arma::vec& weights) :
+  DiagonalGMMType(const std::vector<DistributionType>& dists,
+                  const VecType& weights) :
       gaussians(dists.size()),
       dimensionality((!dists.empty()) ? dists[0].Mean().n_elem : 0),
       dists(dists),
       weights(weights) { /* Nothing to do. */ }
 
   //! Copy constructor for DiagonalGMMs.
-  DiagonalGMM(const DiagonalGMM& other);
+  DiagonalGMMType(const DiagonalGMMType& other);
+
+  /**
+   * Create a DiagonalGMM from one with another element type, converting its
+   * parameters (for instance, to evaluate a model trained in double precision
+   * in single precision).
+   *
+   * @param other Model to convert.
+   */
+  template<typename OtherMatType,
+           typename = std::enable_if_t<
+               !std::is_same<OtherMatType, MatType>::value>>
+  explicit DiagonalGMMType(const DiagonalGMMType<OtherMatType>& other);
 
   //! Copy operator for DiagonalGMMs.
-  DiagonalGMM& operator=(const DiagonalGMM& other);
+  DiagonalGMMType& operator=(const DiagonalGMMType& other);
 
   //! Return the number of Gaussians in the model.
   size_t Gaussians() const { return gaussians; }
@@ -137,7 +179,7 @@ class DiagonalGMM
    *
    * @param i Index of component.
    */
-  const DiagonalGaussianDistribution<>& Component(size_t i) const
+  const DistributionType& Component(size_t i) const
   {
     return dists[i];
   }
@@ -147,15 +189,15 @@ class DiagonalGMM
    *
    * @param i Index of component.
    */
-  DiagonalGaussianDistribution<>& Component(size_t i)
+  DistributionType& Component(size_t i)
   {
     return dists[i];
   }
 
   //! Return a const reference to the a priori weights of each Gaussian.
-  const arma::vec& Weights() const { return weights; }
+  const VecType& Weights() const { return weights; }
   //! Return a reference to the a priori weights of each Gaussian.
-  arma::vec& Weights() { return weights; }
+  VecType& Weights() { return weights; }
 
   /**
    * Return the probability that the given observation came from this
@@ -163,7 +205,7 @@ class DiagonalGMM
    *
    * @param observation Observation to evaluate the probability of.
    */
-  double Probability(const arma::vec& observation) const;
+  ElemType Probability(const VecType& observation) const;
 
   /**
    * Return the probability that the given observation matrix.
@@ -171,7 +213,7 @@ class DiagonalGMM
    * @param observation Observation to evaluate the probability of.
    * @param probs Stores the value of probability for observation.
    */
-  void Probability(const arma::mat& observation, arma::vec& probs) const;
+  void Probability(const MatType& observation, VecType& probs) const;
 
   /**
    * Return the log probability that the given observation came from this
@@ -179,7 +221,7 @@ class DiagonalGMM
    *
    * @param observation Observation to evaluate the log-probability of.
    */
-  double LogProbability(const arma::vec& observation) const;
+  ElemType LogProbability(const VecType& observation) const;
 
   /**
    * Return the log probability that the given observation matrix.
@@ -187,7 +229,7 @@ class DiagonalGMM
    * @param observation Observation to evaluate the log-probability of.
    * @param logProbs Stores the value of log-probability for observation.
    */
-  void LogProbability(const arma::mat& observation, arma::vec& logProbs) const;
+  void LogProbability(const MatType& observation, VecType& logProbs) const;
 
   /**
    * Return the probability that the given observation came from the given
@@ -196,8 +238,8 @@ class DiagonalGMM
    * @param observation Observation to evaluate the probability of.
    * @param component Index of the component of the DiagonalGMM.
    */
-  double Probability(const arma::vec& observation,
-                     const size_t component) const;
+  ElemType Probability(const VecType& observation,
+                       const size_t component) const;
 
   /**
    * Return the log probability that the given observation came from the given
@@ -206,15 +248,15 @@ class DiagonalGMM
    * @param observation Observation to evaluate the probability of.
    * @param component Index of the component of the DiagonalGMM.
    */
-  double LogProbability(const arma::vec& observation,
-                        const size_t component) const;
+  ElemType LogProbability(const VecType& observation,
+                          const size_t component) const;
   /**
    * Return a randomly generated observation according to the probability
    * distribution defined by this object.
    *
    * @return Random observation from this DiagonalGMM.
    */
-  arma::vec Random() const;
+  VecType Random() const;
 
   /**
    * Estimate the probability distribution directly from the given
@@ -237,6 +279,9 @@ class DiagonalGMM
    *     model for the estimation.
    * @param fitter Fitting type that estimates observations.
    * @return The log-likelihood of the best fit.
+   *
+   * @pre MatType is arma::mat; models with other element types are converted
+   *     from a trained DiagonalGMM.
    */
   template<typename FittingType = EMFit<KMeans<>, DiagonalConstraint,
       DiagonalGaussianDistribution<>>>
@@ -269,6 +314,9 @@ class DiagonalGMM
    *     model for the estimation.
    * @param fitter Fitting type that estimates observations.
    * @return The log-likelihood of the best fit.
+   *
+   * @pre MatType is arma::mat; models with other element types are converted
+   *     from a trained DiagonalGMM.
    */
   template<typename FittingType = EMFit<KMeans<>, DiagonalConstraint,
       DiagonalGaussianDistribution<>>>
@@ -278,6 +326,31 @@ class DiagonalGMM
                const bool useExistingModel = false,
                FittingType fitter = FittingType());
 
+  /**
+   * Update the model with one mini-batch of observations, using an online
+   * fitter such as StepwiseEMFit that keeps running statistics between calls.
+   * This can be used to train on datasets that do not fit in memory, by
+   * loading and passing one chunk at a time.  The first batch after the
+   * fitter is reset is used to fit the initial model, unless useExistingModel
+   * is true.
+   *
+   * @tparam FittingType The type of online fitting method (it must provide
+   *     Step()).
+   * @param batch Mini-batch of observations.
+   * @param fitter The fitter to use; it must be the same object for every
+   *     batch.
+   * @param useExistingModel If true, the existing model is used as the initial
+   *     model.
+   * @return The log-likelihood of the batch under the model before the update.
+   *
+   * @pre MatType is arma::mat.
+   */
+  template<typename FittingType = StepwiseEMFit<KMeans<>, DiagonalConstraint,
+      DiagonalGaussianDistribution<>>>
+  double TrainBatch(const arma::mat& batch,
+                    FittingType& fitter,
+                    const bool useExistingModel = false);
+
   /**
    * Classify the given observations as being from an individual component in
    * this DiagonalGMM. The resultant classifications are stored in the 'labels'
@@ -295,7 +368,7 @@ class DiagonalGMM
    * @param observations Matrix of observations to classify.
    * @param labels Object which will be filled with labels.
    */
-  void Classify(const arma::mat& observations,
+  void Classify(const MatType& observations,
                 arma::Row<size_t>& labels) const;
 
   /**
@@ -315,11 +388,37 @@ class DiagonalGMM
    * @param weights Weights of the given mixture model.
    */
   double LogLikelihood(
-      const arma::mat& observations,
-      const std::vector<DiagonalGaussianDistribution<>>& dists,
-      const arma::vec& weights) const;
+      const MatType& observations,
+      const std::vector<DistributionType>& dists,
+      const VecType& weights) const;
+
+  /**
+   * Compute the weighted log-probabilities of the given observations for every
+   * component of the given mixture model, a block of points at a time, in
+   * parallel.  Each component is evaluated for the whole block before moving
+   * on to the next, so that the block stays in cache, and the sum over the
+   * dimensions is a vectorized loop.  For each block, f(begin, blockLogProbs)
+   * is called, where column i of blockLogProbs holds the log-probabilities of
+   * point (begin + i), plus the log of each weight.
+   *
+   * @param observations Observations to compute the log-probabilities of.
+   * @param distsL Components of the mixture model.
+   * @param weightsL Weights of the components.
+   * @param f Function to call for each block of points.
+   */
+  template<typename BlockFunctionType>
+  void ForEachBlockLogProbabilities(
+      const MatType& observations,
+      const std::vector<DistributionType>& distsL,
+      const VecType& weightsL,
+      BlockFunctionType f) const;
 };
 
+/**
+ * A Diagonal Gaussian Mixture Model with double precision parameters.
+ */
+using DiagonalGMM = DiagonalGMMType<arma::mat>;
+
 } // namespace mlpack
 
 // Include implementation.
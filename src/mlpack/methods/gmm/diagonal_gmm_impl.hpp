@@ -19,12 +19,17 @@
 namespace mlpack {
 
 //! Fit the DiagonalGMM to the given observations.
+template<typename MatType>
 template<typename FittingType>
-double DiagonalGMM::Train(const arma::mat& observations,
-                          const size_t trials,
-                          const bool useExistingModel,
-                          FittingType fitter)
+double DiagonalGMMType<MatType>::Train(const arma::mat& observations,
+                                       const size_t trials,
+                                       const bool useExistingModel,
+                                       FittingType fitter)
 {
+  static_assert(std::is_same<MatType, arma::mat>::value, "DiagonalGMMType::"
+      "Train(): models are trained in double precision; train a DiagonalGMM "
+      "and convert it");
+
   double bestLikelihood; // This will be reported later.
 
   // We don't need to store temporary models if we are only doing one trial.
@@ -43,7 +48,7 @@ double DiagonalGMM::Train(const arma::mat& observations,
 
     // If each trial must start from the same initial location,
     // we must save it.
-    std::vector<DiagonalGaussianDistribution<>> distsOrig;
+    std::vector<DistributionType> distsOrig;
     arma::vec weightsOrig;
     if (useExistingModel)
     {
@@ -61,8 +66,8 @@ double DiagonalGMM::Train(const arma::mat& observations,
         << bestLikelihood << "." << std::endl;
 
     // Now the temporary model.
-    std::vector<DiagonalGaussianDistribution<>> distsTrial(
-        gaussians, DiagonalGaussianDistribution<>(dimensionality));
+    std::vector<DistributionType> distsTrial(gaussians,
+        DistributionType(dimensionality));
     arma::vec weightsTrial(gaussians);
 
     for (size_t trial = 1; trial < trials; ++trial)
@@ -107,27 +112,48 @@ double DiagonalGMM::Train(const arma::mat& observations,
  * @param gaussians Number of Gaussians in this GMM.
  * @param dimensionality Dimensionality of each Gaussian.
  */
-inline DiagonalGMM::DiagonalGMM(
+template<typename MatType>
+DiagonalGMMType<MatType>::DiagonalGMMType(
     const size_t gaussians,
     const size_t dimensionality) :
     gaussians(gaussians),
     dimensionality(dimensionality),
-    dists(gaussians,
-    DiagonalGaussianDistribution<>(dimensionality)),
+    dists(gaussians, DistributionType(dimensionality)),
     weights(gaussians)
 {
   // Set equal weights. Technically this model is still valid, but only barely.
-  weights.fill(1.0 / gaussians);
+  weights.fill(ElemType(1) / gaussians);
 }
 
 // Copy constructor for when the other GMM uses the same fitting type.
-inline DiagonalGMM::DiagonalGMM(const DiagonalGMM& other) :
+template<typename MatType>
+DiagonalGMMType<MatType>::DiagonalGMMType(const DiagonalGMMType& other) :
     gaussians(other.Gaussians()),
     dimensionality(other.dimensionality),
     dists(other.dists),
     weights(other.weights) { /* Nothing to do. */ }
 
-inline DiagonalGMM& DiagonalGMM::operator=(const DiagonalGMM& other)
+// Convert a DiagonalGMM with another element type.
+template<typename MatType>
+template<typename OtherMatType, typename>
+DiagonalGMMType<MatType>::DiagonalGMMType(
+    const DiagonalGMMType<OtherMatType>& other) :
+    gaussians(other.Gaussians()),
+    dimensionality(other.Dimensionality()),
+    weights(arma::conv_to<VecType>::from(other.Weights()))
+{
+  dists.reserve(gaussians);
+  for (size_t i = 0; i < gaussians; ++i)
+  {
+    dists.push_back(DistributionType(
+        arma::conv_to<VecType>::from(other.Component(i).Mean()),
+        arma::conv_to<VecType>::from(other.Component(i).Covariance())));
+  }
+}
+
+template<typename MatType>
+DiagonalGMMType<MatType>& DiagonalGMMType<MatType>::operator=(
+    const DiagonalGMMType& other)
 {
   gaussians = other.gaussians;
   dimensionality = other.dimensionality;
@@ -140,15 +166,17 @@ inline DiagonalGMM& DiagonalGMM::operator=(const DiagonalGMM& other)
 /**
  * Return the log probability of the given observation being from this GMM.
  */
-inline double DiagonalGMM::LogProbability(const arma::vec& observation) const
+template<typename MatType>
+typename DiagonalGMMType<MatType>::ElemType
+DiagonalGMMType<MatType>::LogProbability(const VecType& observation) const
 {
   // Sum the probability for each Gaussian in our mixture (and we have to
   // multiply by the prior for each Gaussian too).
-  double sum = -std::numeric_limits<double>::infinity();
+  ElemType sum = -std::numeric_limits<ElemType>::infinity();
   for (size_t i = 0; i < gaussians; ++i)
   {
-    sum = LogAdd(sum, std::log(weights[i]) +
-        dists[i].LogProbability(observation));
+    sum = LogAdd(sum, ElemType(std::log(weights[i]) +
+        dists[i].LogProbability(observation)));
   }
   return sum;
 }
@@ -159,35 +187,27 @@ inline double DiagonalGMM::LogProbability(const arma::vec& observation) const
  * @param observation Observation matrix to compute log-probabilty.
  * @param logProbs Stores the value of log-probability for input.
  */
-inline void DiagonalGMM::LogProbability(const arma::mat& observation,
-                                        arma::vec& logProbs) const
+template<typename MatType>
+void DiagonalGMMType<MatType>::LogProbability(const MatType& observation,
+                                              VecType& logProbs) const
 {
   // Sum the probability for each Gaussian in our mixture (and we have to
   // multiply by the prior for each Gaussian too).
   logProbs.set_size(observation.n_cols);
-
-  // Store log-probability value in a matrix.
-  arma::mat logProb(observation.n_cols, gaussians);
-
-  // Assign value to the matrix.
-  for (size_t i = 0; i < gaussians; i++)
+  ForEachBlockLogProbabilities(observation, dists, weights,
+      [&](const size_t begin, const MatType& blockLogProbs)
   {
-    arma::vec temp(logProb.colptr(i), observation.n_cols, false, true);
-    dists[i].LogProbability(observation, temp);
-  }
-
-  // Save log(weights) as a vector.
-  arma::vec logWeights = log(weights);
-
-  // Compute log-probability.
-  logProb += repmat(logWeights.t(), logProb.n_rows, 1);
-  LogSumExp(logProb, logProbs);
+    for (size_t i = 0; i < blockLogProbs.n_cols; ++i)
+      logProbs[begin + i] = AccuLog(blockLogProbs.unsafe_col(i));
+  });
 }
 
 /**
  * Return the probability of the given observation being from this GMM.
  */
-inline double DiagonalGMM::Probability(const arma::vec& observation) const
+template<typename MatType>
+typename DiagonalGMMType<MatType>::ElemType
+DiagonalGMMType<MatType>::Probability(const VecType& observation) const
 {
   return std::exp(LogProbability(observation));
 }
@@ -198,8 +218,9 @@ inline double DiagonalGMM::Probability(const arma::vec& observation) const
  * @param observation Observation matrix to compute probabilty.
  * @param probs Stores the value of probability for observation.
  */
-inline void DiagonalGMM::Probability(const arma::mat& observation,
-                                     arma::vec& probs) const
+template<typename MatType>
+void DiagonalGMMType<MatType>::Probability(const MatType& observation,
+                                           VecType& probs) const
 {
   LogProbability(observation, probs);
   probs = exp(probs);
@@ -210,8 +231,10 @@ inline void DiagonalGMM::Probability(const arma::mat& observation,
  * Return the log probability of the given observation being from the given
  * component in the mixture.
  */
-inline double DiagonalGMM::LogProbability(const arma::vec& observation,
-                                          const size_t component) const
+template<typename MatType>
+typename DiagonalGMMType<MatType>::ElemType
+DiagonalGMMType<MatType>::LogProbability(const VecType& observation,
+                                         const size_t component) const
 {
   // We are only considering one Gaussian component -- so we only need to call
   // Probability() once.  We do consider the prior probability!
@@ -223,8 +246,10 @@ inline double DiagonalGMM::LogProbability(const arma::vec& observation,
  * Return the probability of the given observation being from the given
  * component in the mixture.
  */
-inline double DiagonalGMM::Probability(const arma::vec& observation,
-                                       const size_t component) const
+template<typename MatType>
+typename DiagonalGMMType<MatType>::ElemType
+DiagonalGMMType<MatType>::Probability(const VecType& observation,
+                                      const size_t component) const
 {
   return std::exp(LogProbability(observation, component));
 }
@@ -233,7 +258,9 @@ inline double DiagonalGMM::Probability(const arma::vec& observation,
  * Return a randomly generated observation according to the probability
  * distribution defined by this object.
  */
-inline arma::vec DiagonalGMM::Random() const
+template<typename MatType>
+typename DiagonalGMMType<MatType>::VecType
+DiagonalGMMType<MatType>::Random() const
 {
   // Determine which Gaussian it will be coming from.
   double gaussRand = mlpack::Random();
@@ -251,78 +278,153 @@ inline arma::vec DiagonalGMM::Random() const
   }
 
   return sqrt(dists[gaussian].Covariance()) %
-      randn<arma::vec>(dimensionality) + dists[gaussian].Mean();
+      arma::randn<VecType>(dimensionality) + dists[gaussian].Mean();
 }
 
 /**
  * Classify the given observations as being from an individual component in
  * this GMM.
  */
-inline void DiagonalGMM::Classify(const arma::mat& observations,
-                                  arma::Row<size_t>& labels) const
+template<typename MatType>
+void DiagonalGMMType<MatType>::Classify(const MatType& observations,
+                                        arma::Row<size_t>& labels) const
 {
-  // This is not the best way to do this!
-
   // We should not have to fill this with values, because each one should be
   // overwritten.
   labels.set_size(observations.n_cols);
-  for (size_t i = 0; i < observations.n_cols; ++i)
+  ForEachBlockLogProbabilities(observations, dists, weights,
+      [&](const size_t begin, const MatType& blockLogProbs)
   {
-    // Find maximum probability component.
-    double probability = 0;
-    for (size_t j = 0; j < gaussians; ++j)
+    for (size_t i = 0; i < blockLogProbs.n_cols; ++i)
     {
-      double newProb = Probability(observations.unsafe_col(i), j);
-      if (newProb >= probability)
+      // Find maximum probability component.  Log-probabilities are compared,
+      // so that distant points do not underflow to zero probability.
+      ElemType probability = -std::numeric_limits<ElemType>::infinity();
+      for (size_t j = 0; j < gaussians; ++j)
       {
-        probability = newProb;
-        labels[i] = j;
+        if (blockLogProbs(j, i) >= probability)
+        {
+          probability = blockLogProbs(j, i);
+          labels[begin + i] = j;
+        }
       }
     }
-  }
+  });
 }
 
 /**
  * Get the log-likelihood of this data's fit to the model.
  */
-inline double DiagonalGMM::LogLikelihood(
-    const arma::mat& observations,
-    const std::vector<DiagonalGaussianDistribution<>>& dists,
-    const arma::vec& weights) const
+template<typename MatType>
+double DiagonalGMMType<MatType>::LogLikelihood(
+    const MatType& observations,
+    const std::vector<DistributionType>& dists,
+    const VecType& weights) const
 {
-  double logLikelihood = 0;
-  arma::vec phis;
-  arma::mat likelihoods(gaussians, observations.n_cols);
-
-  for (size_t i = 0; i < gaussians; ++i)
+  // The likelihood of each point is kept so that the sum does not depend on
+  // the number of threads.
+  arma::vec logLikelihoods(observations.n_cols);
+  ForEachBlockLogProbabilities(observations, dists, weights,
+      [&](const size_t begin, const MatType& blockLogProbs)
   {
-    dists[i].Probability(observations, phis);
-    likelihoods.row(i) = weights(i) * trans(phis);
-  }
+    for (size_t i = 0; i < blockLogProbs.n_cols; ++i)
+      logLikelihoods[begin + i] = AccuLog(blockLogProbs.unsafe_col(i));
+  });
 
   // Now sum over every point.
   for (size_t j = 0; j < observations.n_cols; ++j)
   {
-    if (accu(likelihoods.col(j)) == 0)
+    if (logLikelihoods[j] == -std::numeric_limits<double>::infinity())
       Log::Info << "Likelihood of point " << j << " is 0!  It is probably an "
           << "outlier." << std::endl;
-    logLikelihood += std::log(accu(likelihoods.col(j)));
   }
 
-  return logLikelihood;
+  return arma::accu(logLikelihoods);
+}
+
+/**
+ * Compute the weighted log-probabilities of every component for blocks of
+ * points.
+ */
+template<typename MatType>
+template<typename BlockFunctionType>
+void DiagonalGMMType<MatType>::ForEachBlockLogProbabilities(
+    const MatType& observations,
+    const std::vector<DistributionType>& distsL,
+    const VecType& weightsL,
+    BlockFunctionType f) const
+{
+  const size_t k = distsL.size();
+  const size_t d = observations.n_rows;
+  if (observations.n_cols == 0 || k == 0)
+    return;
+
+  // Gather the parameters of the components, so that each one is contiguous.
+  MatType means(d, k), invCovs(d, k);
+  VecType constants(k);
+  for (size_t j = 0; j < k; ++j)
+  {
+    means.col(j) = distsL[j].Mean();
+    invCovs.col(j) = distsL[j].InvCov();
+    constants[j] = std::log(weightsL[j]) -
+        ElemType(0.5 * d * std::log(2.0 * M_PI)) -
+        ElemType(0.5) * distsL[j].LogDetCov();
+  }
+
+  // A block of 64 points stays in the L1 cache for moderate dimensionalities,
+  // while the parameters of each component are read once for each block.
+  const size_t blockSize = 64;
+  const size_t numBlocks = (observations.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for schedule(static)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize,
+        size_t(observations.n_cols));
+
+    MatType blockLogProbs(k, end - begin);
+    for (size_t j = 0; j < k; ++j)
+    {
+      const ElemType* mean = means.colptr(j);
+      const ElemType* invCov = invCovs.colptr(j);
+      for (size_t i = begin; i < end; ++i)
+      {
+        const ElemType* x = observations.colptr(i);
+        ElemType distance = 0;
+
+        #pragma omp simd reduction(+:distance)
+        for (size_t r = 0; r < d; ++r)
+        {
+          const ElemType diff = x[r] - mean[r];
+          distance += diff * diff * invCov[r];
+        }
+
+        blockLogProbs(j, i - begin) = constants[j] -
+            ElemType(0.5) * distance;
+      }
+    }
+
+    f(begin, blockLogProbs);
+  }
 }
 
 /**
  * Fit the DiagonalGMM to the given observations, each of which has a certain
  * probability of being from this distribution.
  */
+template<typename MatType>
 template<typename FittingType>
-double DiagonalGMM::Train(const arma::mat& observations,
-                          const arma::vec& probabilities,
-                          const size_t trials,
-                          const bool useExistingModel,
-                          FittingType fitter)
+double DiagonalGMMType<MatType>::Train(const arma::mat& observations,
+                                       const arma::vec& probabilities,
+                                       const size_t trials,
+                                       const bool useExistingModel,
+                                       FittingType fitter)
 {
+  static_assert(std::is_same<MatType, arma::mat>::value, "DiagonalGMMType::"
+      "Train(): models are trained in double precision; train a DiagonalGMM "
+      "and convert it");
+
   double bestLikelihood; // This will be reported later.
 
   // We don't need to store temporary models if we are only doing one trial.
@@ -342,7 +444,7 @@ double DiagonalGMM::Train(const arma::mat& observations,
       return -DBL_MAX; // It's what they asked for...
 
     // If each trial must start from the same initial location, we must save it.
-    std::vector<DiagonalGaussianDistribution<>> distsOrig;
+    std::vector<DistributionType> distsOrig;
     arma::vec weightsOrig;
     if (useExistingModel)
     {
@@ -361,8 +463,8 @@ double DiagonalGMM::Train(const arma::mat& observations,
         << bestLikelihood << "." << std::endl;
 
     // Now the temporary model.
-    std::vector<DiagonalGaussianDistribution<>> distsTrial(gaussians,
-        DiagonalGaussianDistribution<>(dimensionality));
+    std::vector<DistributionType> distsTrial(gaussians,
+        DistributionType(dimensionality));
     arma::vec weightsTrial(gaussians);
 
     for (size_t trial = 1; trial < trials; ++trial)
@@ -400,9 +502,26 @@ double DiagonalGMM::Train(const arma::mat& observations,
   return bestLikelihood;
 }
 
+/**
+ * Update the model with one mini-batch of observations.
+ */
+template<typename MatType>
+template<typename FittingType>
+double DiagonalGMMType<MatType>::TrainBatch(const arma::mat& batch,
+                                            FittingType& fitter,
+                                            const bool useExistingModel)
+{
+  static_assert(std::is_same<MatType, arma::mat>::value, "DiagonalGMMType::"
+      "TrainBatch(): models are trained in double precision; train a "
+      "DiagonalGMM and convert it");
+
+  return fitter.Step(batch, dists, weights, useExistingModel);
+}
+
 //! Serialize the object.
+template<typename MatType>
 template<typename Archive>
-void DiagonalGMM::serialize(Archive& ar, const uint32_t /* version */)
+void DiagonalGMMType<MatType>::serialize(Archive& ar, const uint32_t /* version */)
 {
   ar(CEREAL_NVP(gaussians));
   ar(CEREAL_NVP(dimensionality));
@@ -145,20 +145,79 @@ class EMFit
       std::vector<Distribution>& dists,
       arma::vec& weights);
 
+  //! Whether the covariances are diagonal (held as vectors).
+  static constexpr bool IsDiagonal =
+      std::is_same<Distribution, DiagonalGaussianDistribution<>>::value;
+  //! The type of the covariance of a component.
+  typedef typename std::conditional<IsDiagonal, arma::vec, arma::mat>::type
+      CovarianceType;
+
+  //! The number of points each thread processes at a time in the E-step.
+  static constexpr size_t BlockSize = 1024;
+
   /**
-   * Calculate the log-likelihood of a model.  Yes, this is reimplemented in the
-   * GMM code.  Intuition suggests that the log-likelihood is not the best way
-   * to determine if the EM algorithm has converged.
+   * Run the EM algorithm from the given initial model, until the
+   * log-likelihood converges or the maximum number of iterations is reached.
+   * This is a helper function for both overloads of Estimate().
    *
-   * @param data Data matrix.
-   * @param means Vector of means.
-   * @param dists Distributions to store model in.
-   * @param weights Vector of a priori weights.
+   * @param observations List of observations.
+   * @param probabilities Probability of each point being from this model, or
+   *     NULL if every point is from this model.
+   * @param dists Distributions of the initial model, to be updated.
+   * @param weights A priori weights of the initial model, to be updated.
+   */
+  void Iterate(const arma::mat& observations,
+               const arma::vec* probabilities,
+               std::vector<Distribution>& dists,
+               arma::vec& weights);
+
+  /**
+   * Run the E-step of the EM algorithm, fused with the accumulation of the
+   * sufficient statistics of the M-step.  Blocks of points are split between
+   * threads; for each block the conditional probabilities of each component
+   * are computed and normalized, and then added to thread-local statistics, so
+   * the conditional probabilities of all the points are never stored.  The
+   * statistics of each component are centered on its current mean.
+   *
+   * @param observations List of observations.
+   * @param probabilities Probability of each point being from this model, or
+   *     NULL.
+   * @param dists Distributions of the current model.
+   * @param weights A priori weights of the current model.
+   * @param weightSums Will hold the total conditional probability of each
+   *     component.
+   * @param meanSums Will hold the weighted sum of the offsets of the points
+   *     from the mean of each component.
+   * @param covSums Will hold the weighted sum of the outer products (or the
+   *     squares, for diagonal covariances) of those offsets.
+   * @return Log-likelihood of the current model.
+   */
+  double Expectation(const arma::mat& observations,
+                     const arma::vec* probabilities,
+                     const std::vector<Distribution>& dists,
+                     const arma::vec& weights,
+                     arma::vec& weightSums,
+                     arma::mat& meanSums,
+                     std::vector<CovarianceType>& covSums) const;
+
+  /**
+   * Run the M-step of the EM algorithm, updating the model from the sufficient
+   * statistics computed by Expectation().  The covariance statistics are moved
+   * from.
+   *
+   * @param weightSums Total conditional probability of each component.
+   * @param meanSums Weighted sums of the offsets from each mean.
+   * @param covSums Weighted sums of the outer products of those offsets.
+   * @param totalWeight Total probability of all the points.
+   * @param dists Distributions to update.
+   * @param weights A priori weights to update.
    */
-  double LogLikelihood(
-      const arma::mat& data,
-      const std::vector<Distribution>& dists,
-      const arma::vec& weights) const;
+  void Maximization(const arma::vec& weightSums,
+                    const arma::mat& meanSums,
+                    std::vector<CovarianceType>& covSums,
+                    const double totalWeight,
+                    std::vector<Distribution>& dists,
+                    arma::vec& weights);
 
   /**
    * Use the Armadillo gmm_diag clusterer to train a GMM with diagonal
@@ -69,13 +69,50 @@ Estimate(const arma::mat& observations,
   if (!useInitialModel)
     InitialClustering(observations, dists, weights);
 
-  double l = LogLikelihood(observations, dists, weights);
+  Iterate(observations, NULL, dists, weights);
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+Estimate(const arma::mat& observations,
+         const arma::vec& probabilities,
+         std::vector<Distribution>& dists,
+         arma::vec& weights,
+         const bool useInitialModel)
+{
+  if (!useInitialModel)
+    InitialClustering(observations, dists, weights);
+
+  Iterate(observations, &probabilities, dists, weights);
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+Iterate(const arma::mat& observations,
+        const arma::vec* probabilities,
+        std::vector<Distribution>& dists,
+        arma::vec& weights)
+{
+  const double totalWeight = (probabilities == NULL) ?
+      double(observations.n_cols) : arma::accu(*probabilities);
+
+  // Each E-step also gives the log-likelihood of the model it was run with, so
+  // the sufficient statistics for the next model are always computed along
+  // with the log-likelihood of the current model.
+  arma::vec weightSums;
+  arma::mat meanSums;
+  std::vector<CovarianceType> covSums;
+  double l = Expectation(observations, probabilities, dists, weights,
+      weightSums, meanSums, covSums);
 
   Log::Debug << "EMFit::Estimate(): initial clustering log-likelihood: "
       << l << std::endl;
 
   double lOld = -DBL_MAX;
-  arma::mat condLogProb(observations.n_cols, dists.size());
 
   // Iterate to update the model until no more improvement is found.
   size_t iteration = 1;
@@ -84,80 +121,12 @@ Estimate(const arma::mat& observations,
     Log::Info << "EMFit::Estimate(): iteration " << iteration << ", "
         << "log-likelihood " << l << "." << std::endl;
 
-    // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      // Store conditional log probabilities into condLogProb vector for each
-      // Gaussian.  First we make an alias of the condLogProb vector.
-      arma::vec condLogProbAlias = condLogProb.unsafe_col(i);
-      dists[i].LogProbability(observations, condLogProbAlias);
-      condLogProbAlias += std::log(weights[i]);
-    }
-
-    // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; ++i)
-    {
-      // Avoid dividing by zero; if the probability for everything is 0, we
-      // don't want to make it NaN.
-      const double probSum = AccuLog(condLogProb.row(i));
-      if (probSum != -std::numeric_limits<double>::infinity())
-        condLogProb.row(i) -= probSum;
-    }
-
-    // Store the sum of the probability of each state over all the observations.
-    arma::vec probRowSums(dists.size());
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      probRowSums(i) = AccuLog(condLogProb.col(i));
-    }
-
-    // Calculate the new value of the means using the updated conditional
-    // probabilities.
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      // Don't update if there's no probability of the Gaussian having points.
-      if (probRowSums[i] != -std::numeric_limits<double>::infinity())
-        dists[i].Mean() = observations * exp(condLogProb.col(i) -
-                                                   probRowSums[i]);
-      else
-        continue;
-
-      // Calculate the new value of the covariances using the updated
-      // conditional probabilities and the updated means.
-      arma::mat tmp = observations.each_col() - dists[i].Mean();
-
-      // If the distribution is DiagonalGaussianDistribution, calculate the
-      // covariance only with diagonal components.
-      if (std::is_same<Distribution, DiagonalGaussianDistribution<>>::value)
-      {
-        arma::vec covariance = sum((tmp % tmp) %
-            (ones<arma::vec>(observations.n_rows) *
-            trans(exp(condLogProb.col(i) - probRowSums[i]))), 1);
-
-        // Apply covariance constraint.
-        constraint.ApplyConstraint(covariance);
-        dists[i].Covariance(std::move(covariance));
-      }
-      else
-      {
-        arma::mat tmpB = tmp.each_row() % trans(exp(condLogProb.col(i) -
-                                                          probRowSums[i]));
-        arma::mat covariance = tmp * trans(tmpB);
-
-        // Apply covariance constraint.
-        constraint.ApplyConstraint(covariance);
-        dists[i].Covariance(std::move(covariance));
-      }
-    }
-
-    // Calculate the new values for omega using the updated conditional
-    // probabilities.
-    weights = exp(probRowSums - std::log(observations.n_cols));
+    Maximization(weightSums, meanSums, covSums, totalWeight, dists, weights);
 
     // Update values of l; calculate new log-likelihood.
     lOld = l;
-    l = LogLikelihood(observations, dists, weights);
+    l = Expectation(observations, probabilities, dists, weights, weightSums,
+        meanSums, covSums);
 
     iteration++;
   }
@@ -166,113 +135,157 @@ Estimate(const arma::mat& observations,
 template<typename InitialClusteringType,
          typename CovarianceConstraintPolicy,
          typename Distribution>
-void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
-Estimate(const arma::mat& observations,
-         const arma::vec& probabilities,
-         std::vector<Distribution>& dists,
-         arma::vec& weights,
-         const bool useInitialModel)
+double EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+Expectation(const arma::mat& observations,
+            const arma::vec* probabilities,
+            const std::vector<Distribution>& dists,
+            const arma::vec& weights,
+            arma::vec& weightSums,
+            arma::mat& meanSums,
+            std::vector<CovarianceType>& covSums) const
 {
-  if (!useInitialModel)
-    InitialClustering(observations, dists, weights);
-
-  double l = LogLikelihood(observations, dists, weights);
-
-  Log::Debug << "EMFit::Estimate(): initial clustering log-likelihood: "
-      << l << std::endl;
+  const size_t dimensionality = observations.n_rows;
+  const size_t numPoints = observations.n_cols;
+  const size_t numBlocks = (numPoints + BlockSize - 1) / BlockSize;
+  const arma::vec logWeights = arma::log(weights);
+
+  weightSums.zeros(dists.size());
+  meanSums.zeros(dimensionality, dists.size());
+  covSums.resize(dists.size());
+  for (size_t i = 0; i < dists.size(); ++i)
+  {
+    if constexpr (IsDiagonal)
+      covSums[i].zeros(dimensionality);
+    else
+      covSums[i].zeros(dimensionality, dimensionality);
+  }
 
-  double lOld = -DBL_MAX;
-  arma::mat condLogProb(observations.n_cols, dists.size());
+  double logLikelihood = 0.0;
+  size_t zeroPoints = 0;
 
-  // Iterate to update the model until no more improvement is found.
-  size_t iteration = 1;
-  while (std::abs(l - lOld) > tolerance && iteration != maxIterations)
+  #pragma omp parallel
   {
-    // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      // Store conditional log probabilities into condLogProb vector for each
-      // Gaussian.  First we make an alias of the condLogProb vector.
-      arma::vec condLogProbAlias = condLogProb.unsafe_col(i);
-      dists[i].LogProbability(observations, condLogProbAlias);
-      condLogProbAlias += std::log(weights[i]);
-    }
-
-    // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; ++i)
-    {
-      // Avoid dividing by zero; if the probability for everything is 0, we
-      // don't want to make it NaN.
-      const double probSum = AccuLog(condLogProb.row(i));
-      if (probSum != -std::numeric_limits<double>::infinity())
-        condLogProb.row(i) -= probSum;
-    }
+    // Thread-local sufficient statistics.
+    arma::vec threadWeightSums(dists.size(), arma::fill::zeros);
+    arma::mat threadMeanSums(dimensionality, dists.size(), arma::fill::zeros);
+    std::vector<CovarianceType> threadCovSums(covSums);
+    double threadLogLikelihood = 0.0;
+    size_t threadZeroPoints = 0;
 
-    // This will store the sum of probabilities of each state over all the
-    // observations.
-    arma::vec probRowSums(dists.size());
+    arma::mat block, condLogProb, condProb, centered;
 
-    // Calculate the new value of the means using the updated conditional
-    // probabilities.
-    arma::vec logProbabilities = log(probabilities);
-    for (size_t i = 0; i < dists.size(); ++i)
+    #pragma omp for schedule(dynamic, 1)
+    for (size_t b = 0; b < numBlocks; ++b)
     {
-      // Calculate the sum of probabilities of points, which is the
-      // conditional probability of each point being from Gaussian i
-      // multiplied by the probability of the point being from this mixture
-      // model.
-      arma::vec tmpProb = condLogProb.col(i) + logProbabilities;
-      probRowSums[i] = AccuLog(tmpProb);
-
-      // Don't update if there's no probability of the Gaussian having points.
-      if (probRowSums[i] != -std::numeric_limits<double>::infinity())
+      const size_t begin = b * BlockSize;
+      const size_t count = std::min(BlockSize, numPoints - begin);
+      MakeAlias(block, observations, dimensionality, count,
+          begin * dimensionality, false);
+
+      // Calculate the log-probability of each point of the block under each
+      // weighted component.
+      condLogProb.set_size(count, dists.size());
+      for (size_t i = 0; i < dists.size(); ++i)
       {
-        dists[i].Mean() = observations *
-              exp(condLogProb.col(i) + logProbabilities - probRowSums[i]);
+        arma::vec condLogProbAlias = condLogProb.unsafe_col(i);
+        dists[i].LogProbability(block, condLogProbAlias);
+        condLogProbAlias += logWeights[i];
       }
-      else
-        continue;
-
-      // Calculate the new value of the covariances using the updated
-      // conditional probabilities and the updated means.
-      arma::mat tmp = observations.each_col() - dists[i].Mean();
 
-      // If the distribution is DiagonalGaussianDistribution, calculate the
-      // covariance only with diagonal components.
-      if (std::is_same<Distribution, DiagonalGaussianDistribution<>>::value)
+      // Normalize row-wise.
+      for (size_t j = 0; j < count; ++j)
       {
-        arma::vec cov = sum((tmp % tmp) %
-            (ones<arma::vec>(observations.n_rows) *
-            trans(exp(condLogProb.col(i) +
-                            logProbabilities - probRowSums[i]))), 1);
-
-        // Apply covariance constraint.
-        constraint.ApplyConstraint(cov);
-        dists[i].Covariance(std::move(cov));
+        // Avoid dividing by zero; if the probability for everything is 0, we
+        // don't want to make it NaN.
+        const double probSum = AccuLog(condLogProb.row(j));
+        threadLogLikelihood += probSum;
+        if (probSum != -std::numeric_limits<double>::infinity())
+          condLogProb.row(j) -= probSum;
+        else
+          ++threadZeroPoints;
       }
-      else
-      {
-        arma::mat tmpB = tmp.each_row() % trans(exp(condLogProb.col(i) +
-            logProbabilities - probRowSums[i]));
-        arma::mat cov = (tmp * trans(tmpB));
 
-        // Apply covariance constraint.
-        constraint.ApplyConstraint(cov);
-        dists[i].Covariance(std::move(cov));
+      condProb = arma::exp(condLogProb);
+      if (probabilities != NULL)
+        condProb.each_col() %= probabilities->subvec(begin, begin + count - 1);
+
+      // Accumulate the statistics of each component around its current mean,
+      // which keeps the covariance accurate when the mean is far from 0.
+      threadWeightSums += arma::sum(condProb, 0).t();
+      for (size_t i = 0; i < dists.size(); ++i)
+      {
+        centered = block.each_col() - dists[i].Mean();
+        threadMeanSums.col(i) += centered * condProb.col(i);
+        if constexpr (IsDiagonal)
+        {
+          threadCovSums[i] += (centered % centered) * condProb.col(i);
+        }
+        else
+        {
+          // Scaling by the square root keeps the sum exactly symmetric.
+          centered.each_row() %= arma::sqrt(condProb.col(i)).t();
+          threadCovSums[i] += centered * centered.t();
+        }
       }
     }
 
-    // Calculate the new values for omega using the updated conditional
-    // probabilities.
-    weights = exp(probRowSums - AccuLog(logProbabilities));
+    #pragma omp critical
+    {
+      weightSums += threadWeightSums;
+      meanSums += threadMeanSums;
+      for (size_t i = 0; i < dists.size(); ++i)
+        covSums[i] += threadCovSums[i];
+      logLikelihood += threadLogLikelihood;
+      zeroPoints += threadZeroPoints;
+    }
+  }
 
-    // Update values of l; calculate new log-likelihood.
-    lOld = l;
-    l = LogLikelihood(observations, dists, weights);
+  if (zeroPoints > 0)
+  {
+    Log::Info << "Likelihood of " << zeroPoints << " points is 0!  They are "
+        << "probably outliers." << std::endl;
+  }
 
-    iteration++;
+  return logLikelihood;
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+Maximization(const arma::vec& weightSums,
+             const arma::mat& meanSums,
+             std::vector<CovarianceType>& covSums,
+             const double totalWeight,
+             std::vector<Distribution>& dists,
+             arma::vec& weights)
+{
+  for (size_t i = 0; i < dists.size(); ++i)
+  {
+    // Don't update if there's no probability of the Gaussian having points.
+    if (weightSums[i] <= 0.0)
+      continue;
+
+    // The statistics are centered on the old mean, so shift them to the new
+    // mean.
+    const arma::vec shift = meanSums.col(i) / weightSums[i];
+    CovarianceType covariance = std::move(covSums[i]);
+    covariance /= weightSums[i];
+    if constexpr (IsDiagonal)
+      covariance -= shift % shift;
+    else
+      covariance -= shift * shift.t();
+
+    dists[i].Mean() += shift;
+
+    // Apply covariance constraint.
+    constraint.ApplyConstraint(covariance);
+    dists[i].Covariance(std::move(covariance));
   }
+
+  // Calculate the new values for omega using the updated conditional
+  // probabilities.
+  weights = weightSums / totalWeight;
 }
 
 template<typename InitialClusteringType,
@@ -369,40 +382,6 @@ InitialClustering(const arma::mat& observations,
   weights /= accu(weights);
 }
 
-template<typename InitialClusteringType,
-         typename CovarianceConstraintPolicy,
-         typename Distribution>
-double EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
-LogLikelihood(const arma::mat& observations,
-              const std::vector<Distribution>& dists,
-              const arma::vec& weights) const
-{
-  double logLikelihood = 0;
-
-  arma::vec logPhis;
-  arma::mat logLikelihoods(dists.size(), observations.n_cols);
-
-  // It has to be LogProbability() otherwise Probability() would overflow easily
-  for (size_t i = 0; i < dists.size(); ++i)
-  {
-    dists[i].LogProbability(observations, logPhis);
-    logLikelihoods.row(i) = std::log(weights(i)) + trans(logPhis);
-  }
-  // Now sum over every point.
-  for (size_t j = 0; j < observations.n_cols; ++j)
-  {
-    if (AccuLog(logLikelihoods.col(j)) ==
-        -std::numeric_limits<double>::infinity())
-    {
-      Log::Info << "Likelihood of point " << j << " is 0!  It is probably an "
-          << "outlier." << std::endl;
-    }
-    logLikelihood += AccuLog(logLikelihoods.col(j));
-  }
-
-  return logLikelihood;
-}
-
 template<typename InitialClusteringType,
          typename CovarianceConstraintPolicy,
          typename Distribution>
@@ -23,6 +23,8 @@
 
 // This is the default fitting method class.
 #include "em_fit.hpp"
+// Online fitting method class.
+#include "stepwise_em_fit.hpp"
 
 namespace mlpack {
 
@@ -219,6 +221,19 @@ class GMM
    */
   arma::vec Random() const;
 
+  /**
+   * Generate the given number of random observations according to the
+   * probability distribution defined by this object.  The components of all
+   * the observations are drawn at once, and the observations of each component
+   * are generated with one matrix product, in parallel across components when
+   * OpenMP is available.  The random numbers are all drawn by the calling
+   * thread, so the observations only depend on the random seed.
+   *
+   * @param n Number of observations to generate.
+   * @param observations Matrix to store the observations in (one per column).
+   */
+  void Random(const size_t n, arma::mat& observations) const;
+
   /**
    * Estimate the probability distribution directly from the given observations,
    * using the given algorithm in the FittingType class to fit the data.
@@ -280,6 +295,28 @@ class GMM
                const bool useExistingModel = false,
                FittingType fitter = FittingType());
 
+  /**
+   * Update the model with one mini-batch of observations, using an online
+   * fitter such as StepwiseEMFit that keeps running statistics between calls.
+   * This can be used to train on datasets that do not fit in memory, by
+   * loading and passing one chunk at a time.  The first batch after the
+   * fitter is reset is used to fit the initial model, unless useExistingModel
+   * is true.
+   *
+   * @tparam FittingType The type of online fitting method (it must provide
+   *     Step()).
+   * @param batch Mini-batch of observations.
+   * @param fitter The fitter to use; it must be the same object for every
+   *     batch.
+   * @param useExistingModel If true, the existing model is used as the initial
+   *     model.
+   * @return The log-likelihood of the batch under the model before the update.
+   */
+  template<typename FittingType = StepwiseEMFit<>>
+  double TrainBatch(const arma::mat& batch,
+                    FittingType& fitter,
+                    const bool useExistingModel = false);
+
   /**
    * Classify the given observations as being from an individual component in
    * this GMM.  The resultant classifications are stored in the 'labels' object,
@@ -319,6 +356,27 @@ class GMM
       const arma::mat& dataPoints,
       const std::vector<GaussianDistribution<>>& distsL,
       const arma::vec& weights) const;
+
+  /**
+   * Compute the weighted log-probabilities of the given observations for every
+   * component of the given mixture model, a block of points at a time, in
+   * parallel.  The inverse Cholesky factor of each covariance is computed once,
+   * and stacked so that the Mahalanobis terms of all components for a block of
+   * points come from a single matrix product.  For each block, f(begin,
+   * blockLogProbs) is called, where column i of blockLogProbs holds the
+   * log-probabilities of point (begin + i), plus the log of each weight.
+   *
+   * @param observations Observations to compute the log-probabilities of.
+   * @param distsL Components of the mixture model.
+   * @param weightsL Weights of the components.
+   * @param f Function to call for each block of points.
+   */
+  template<typename BlockFunctionType>
+  void ForEachBlockLogProbabilities(
+      const arma::mat& observations,
+      const std::vector<GaussianDistribution<>>& distsL,
+      const arma::vec& weightsL,
+      BlockFunctionType f) const;
 };
 
 } // namespace mlpack
@@ -80,9 +80,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& /* timers */)
 
   size_t length = (size_t) params.Get<int>("samples");
   Log::Info << "Generating " << length << " samples..." << endl;
-  arma::mat samples(gmm->Dimensionality(), length);
-  for (size_t i = 0; i < length; ++i)
-    samples.col(i) = gmm->Random();
+  arma::mat samples;
+  gmm->Random(length, samples);
 
   // Save, if the user asked for it.
   params.Get<arma::mat>("output") = std::move(samples);
@@ -82,23 +82,12 @@ inline void GMM::LogProbability(const arma::mat& observation,
   // Sum the probability for each Gaussian in our mixture (and we have to
   // multiply by the prior for each Gaussian too).
   logProbs.set_size(observation.n_cols);
-
-  // Store log-probability value in a matrix.
-  arma::mat logProb(observation.n_cols, gaussians);
-
-  // Assign value to the matrix.
-  for (size_t i = 0; i < gaussians; i++)
+  ForEachBlockLogProbabilities(observation, dists, weights,
+      [&](const size_t begin, const arma::mat& blockLogProbs)
   {
-    arma::vec temp(logProb.colptr(i), observation.n_cols, false, true);
-    dists[i].LogProbability(observation, temp);
-  }
-
-  // Save log(weights) as a vector.
-  arma::vec logWeights = log(weights);
-
-  // Compute log-probability.
-  logProb += repmat(logWeights.t(), logProb.n_rows, 1);
-  LogSumExp(logProb, logProbs);
+    for (size_t i = 0; i < blockLogProbs.n_cols; ++i)
+      logProbs[begin + i] = AccuLog(blockLogProbs.col(i));
+  });
 }
 
 /**
@@ -175,13 +164,51 @@ inline arma::vec GMM::Random() const
     }
   }
 
-  arma::mat cholDecomp;
-  if (!arma::chol(cholDecomp, dists[gaussian].Covariance()))
+  // The Cholesky factor of the covariance is cached by the component.
+  return dists[gaussian].Random();
+}
+
+/**
+ * Generate the given number of random observations according to the
+ * probability distribution defined by this object.
+ */
+inline void GMM::Random(const size_t n, arma::mat& observations) const
+{
+  // Determine which Gaussian each observation will be coming from.
+  const arma::vec cumulativeWeights = arma::cumsum(weights);
+  const arma::vec gaussRands = arma::randu<arma::vec>(n);
+  arma::Col<size_t> components(n);
+  arma::Col<size_t> counts(gaussians, arma::fill::zeros);
+  for (size_t i = 0; i < n; ++i)
+  {
+    const size_t g = std::lower_bound(cumulativeWeights.begin(),
+        cumulativeWeights.end(), gaussRands[i]) - cumulativeWeights.begin();
+    // Rounding errors may make the total weight slightly less than 1.
+    components[i] = std::min(g, gaussians - 1);
+    ++counts[components[i]];
+  }
+
+  // Group the observations by component.
+  std::vector<arma::uvec> indices(gaussians);
+  for (size_t g = 0; g < gaussians; ++g)
+    indices[g].set_size(counts[g]);
+  counts.zeros();
+  for (size_t i = 0; i < n; ++i)
+    indices[components[i]][counts[components[i]]++] = i;
+
+  // Transform standard normal observations with the Cholesky factor and the
+  // mean of their component; each component writes its own columns.
+  observations = arma::randn<arma::mat>(dimensionality, n);
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t g = 0; g < gaussians; ++g)
   {
-    Log::Fatal << "Cholesky decomposition failed." << std::endl;
+    if (indices[g].n_elem == 0)
+      continue;
+
+    arma::mat samples = dists[g].CovLower() * observations.cols(indices[g]);
+    samples.each_col() += dists[g].Mean();
+    observations.cols(indices[g]) = samples;
   }
-  return trans(cholDecomp) *
-      randn<arma::vec>(dimensionality) + dists[gaussian].Mean();
 }
 
 /**
@@ -194,27 +221,27 @@ inline arma::vec GMM::Random() const
 inline void GMM::Classify(const arma::mat& observations,
                           arma::Row<size_t>& labels) const
 {
-  // This is not the best way to do this!
-
   // We should not have to fill this with values, because each one should be
   // overwritten.
   labels.set_size(observations.n_cols);
-  for (size_t i = 0; i < observations.n_cols; ++i)
+  ForEachBlockLogProbabilities(observations, dists, weights,
+      [&](const size_t begin, const arma::mat& blockLogProbs)
   {
-    // Find maximum probability component.
-    double probability = -std::numeric_limits<double>::infinity();
-    for (size_t j = 0; j < gaussians; ++j)
+    for (size_t i = 0; i < blockLogProbs.n_cols; ++i)
     {
-      // We have to use LogProbability() otherwise Probability() would overflow
-      // easily.
-      double newProb = LogProbability(observations.unsafe_col(i), j);
-      if (newProb >= probability)
+      // Find maximum probability component.  We have to use log-probabilities
+      // otherwise the probabilities would overflow easily.
+      double probability = -std::numeric_limits<double>::infinity();
+      for (size_t j = 0; j < gaussians; ++j)
       {
-        probability = newProb;
-        labels[i] = j;
+        if (blockLogProbs(j, i) >= probability)
+        {
+          probability = blockLogProbs(j, i);
+          labels[begin + i] = j;
+        }
       }
     }
-  }
+  });
 }
 
 /**
@@ -229,21 +256,90 @@ inline double GMM::LogLikelihood(
     const std::vector<GaussianDistribution<>>& distsL,
     const arma::vec& weightsL) const
 {
-  double loglikelihood = 0;
-  arma::vec logPhis;
-  arma::mat logLikelihoods(gaussians, data.n_cols);
+  // It has to be log-probabilities otherwise the probabilities would overflow
+  // easily.  The likelihood of each point is kept so that the sum does not
+  // depend on the number of threads.
+  arma::vec logLikelihoods(data.n_cols);
+  ForEachBlockLogProbabilities(data, distsL, weightsL,
+      [&](const size_t begin, const arma::mat& blockLogProbs)
+  {
+    for (size_t i = 0; i < blockLogProbs.n_cols; ++i)
+      logLikelihoods[begin + i] = AccuLog(blockLogProbs.col(i));
+  });
 
-  // It has to be LogProbability() otherwise Probability() would overflow easily
-  for (size_t i = 0; i < gaussians; ++i)
+  return arma::accu(logLikelihoods);
+}
+
+/**
+ * Compute the weighted log-probabilities of every component for blocks of
+ * points.
+ */
+template<typename BlockFunctionType>
+void GMM::ForEachBlockLogProbabilities(
+    const arma::mat& observations,
+    const std::vector<GaussianDistribution<>>& distsL,
+    const arma::vec& weightsL,
+    BlockFunctionType f) const
+{
+  const size_t k = distsL.size();
+  const size_t d = observations.n_rows;
+  if (observations.n_cols == 0 || k == 0)
+    return;
+
+  // With L the lower Cholesky factor of the covariance of a component, the
+  // Mahalanobis distance of x is ||L^-1 x - L^-1 mu||^2.  The inverse factors
+  // of all components are stacked, so that they are applied to a block with
+  // one matrix product.
+  arma::mat factors(k * d, d);
+  arma::vec offsets(k * d);
+  arma::vec constants(k);
+  for (size_t j = 0; j < k; ++j)
   {
-    distsL[i].LogProbability(data, logPhis);
-    logLikelihoods.row(i) = std::log(weightsL(i)) + trans(logPhis);
+    arma::mat covLower;
+    if (!arma::chol(covLower, distsL[j].Covariance(), "lower"))
+    {
+      Log::Fatal << "Cholesky decomposition failed." << std::endl;
+    }
+
+    const arma::mat factor = arma::inv(arma::trimatl(covLower));
+    factors.rows(j * d, (j + 1) * d - 1) = factor;
+    offsets.subvec(j * d, (j + 1) * d - 1) = factor * distsL[j].Mean();
+    constants[j] = std::log(weightsL[j]) - 0.5 * d * std::log(2.0 * M_PI) -
+        0.5 * distsL[j].LogDetCov();
   }
 
-  // Now sum over every point.
-  for (size_t j = 0; j < data.n_cols; ++j)
-    loglikelihood += AccuLog(logLikelihoods.col(j));
-  return loglikelihood;
+  // Keep the projections of a block to about 512kB, but make blocks large
+  // enough for the matrix product to be efficient.
+  const size_t blockSize = std::min(std::max(size_t(65536) /
+      std::max(k * d, size_t(1)), size_t(16)), size_t(1024));
+  const size_t numBlocks = (observations.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for schedule(static)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize,
+        size_t(observations.n_cols));
+
+    arma::mat projections = factors * observations.cols(begin, end - 1);
+    projections.each_col() -= offsets;
+
+    arma::mat blockLogProbs(k, end - begin);
+    for (size_t i = 0; i < end - begin; ++i)
+    {
+      const double* projection = projections.colptr(i);
+      for (size_t j = 0; j < k; ++j)
+      {
+        double distance = 0.0;
+        for (size_t r = j * d; r < (j + 1) * d; ++r)
+          distance += projection[r] * projection[r];
+
+        blockLogProbs(j, i) = constants[j] - 0.5 * distance;
+      }
+    }
+
+    f(begin, blockLogProbs);
+  }
 }
 
 /**
@@ -413,6 +509,17 @@ double GMM::Train(const arma::mat& observations,
   return bestLikelihood;
 }
 
+/**
+ * Update the model with one mini-batch of observations.
+ */
+template<typename FittingType>
+double GMM::TrainBatch(const arma::mat& batch,
+                       FittingType& fitter,
+                       const bool useExistingModel)
+{
+  return fitter.Step(batch, dists, weights, useExistingModel);
+}
+
 /**
  * Serialize the object.
  */
@@ -0,0 +1,295 @@
+/**
+ * @file methods/gmm/stepwise_em_fit.hpp
+ *
+ * Stepwise (online) EM algorithm for fitting GMMs from mini-batches of
+ * observations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_STEPWISE_EM_FIT_HPP
+#define MLPACK_METHODS_GMM_STEPWISE_EM_FIT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/distributions/distributions.hpp>
+
+// The initial model is fit with a few iterations of batch EM.
+#include "em_fit.hpp"
+
+namespace mlpack {
+
+/**
+ * This class fits a GMM with the stepwise EM algorithm, which only ever looks
+ * at one mini-batch of observations at a time.  For each mini-batch, the
+ * conditional probabilities of each component are computed with the current
+ * model, the averaged sufficient statistics of the batch (the total
+ * probability, and the first and second moments of each component) are mixed
+ * into running statistics with step size
+ *
+ *   eta_t = (t + 1)^(-stepExponent),
+ *
+ * where t is the number of batches seen so far, and the model is then updated
+ * from the running statistics.  The step exponent must be in (0.5, 1]; smaller
+ * values forget old batches faster.  The initial model is fit by batch EM on
+ * the first mini-batch, with the given clusterer and covariance constraint.
+ *
+ * StepwiseEMFit is a FittingType for GMM::Train() and DiagonalGMM::Train(), in
+ * which case the observations are held in memory and visited in shuffled
+ * mini-batches for a number of epochs.  For datasets that do not fit in memory,
+ * the chunks of data can instead be passed one at a time to Step() (or to
+ * GMM::TrainBatch()):
+ *
+ * @code
+ * GMM gmm(10, dimensionality);
+ * StepwiseEMFit<> fitter;
+ * for (size_t i = 0; i < numChunks; ++i)
+ * {
+ *   arma::mat chunk;
+ *   data::Load("features-" + std::to_string(i) + ".bin", chunk);
+ *   gmm.TrainBatch(chunk, fitter);
+ * }
+ * @endcode
+ *
+ * The statistics of each component are centered on its mean when the running
+ * statistics were started, so that the covariances stay accurate for data far
+ * from the origin.
+ *
+ * For more information, see
+ *
+ * @code
+ * @inproceedings{liang2009online,
+ *   title={Online EM for Unsupervised Models},
+ *   author={Liang, Percy and Klein, Dan},
+ *   booktitle={Proceedings of Human Language Technologies: The 2009 Annual
+ *       Conference of the North American Chapter of the Association for
+ *       Computational Linguistics},
+ *   pages={611--619},
+ *   year={2009}
+ * }
+ * @endcode
+ *
+ * @tparam InitialClusteringType Clusterer used for the initial model.
+ * @tparam CovarianceConstraintPolicy Constraint applied to each covariance.
+ * @tparam Distribution Type of the components (GaussianDistribution<> or
+ *     DiagonalGaussianDistribution<>).
+ */
+template<typename InitialClusteringType = KMeans<>,
+         typename CovarianceConstraintPolicy = PositiveDefiniteConstraint,
+         typename Distribution = GaussianDistribution<>>
+class StepwiseEMFit
+{
+ public:
+  /**
+   * Construct the StepwiseEMFit object.  Setting the maximum number of epochs
+   * to 0 means that the epochs are repeated until the log-likelihood converges
+   * (with the given tolerance).
+   *
+   * @param batchSize Number of observations in each mini-batch.
+   * @param maxEpochs Maximum number of passes over the data in Estimate().
+   * @param stepExponent Exponent of the decay of the step size, in (0.5, 1].
+   * @param tolerance Tolerance on the change of the average log-likelihood of
+   *     the batches of an epoch, required for convergence in Estimate().
+   * @param shuffle If true, the observations are visited in a random order in
+   *     each epoch.
+   * @param initialIterations Number of iterations of batch EM used to fit the
+   *     initial model on the first mini-batch.
+   * @param clusterer Object which will perform the initial clustering.
+   * @param constraint Constraint policy of covariance.
+   */
+  StepwiseEMFit(const size_t batchSize = 1000,
+                const size_t maxEpochs = 10,
+                const double stepExponent = 0.7,
+                const double tolerance = 1e-5,
+                const bool shuffle = true,
+                const size_t initialIterations = 10,
+                InitialClusteringType clusterer = InitialClusteringType(),
+                CovarianceConstraintPolicy constraint =
+                    CovarianceConstraintPolicy());
+
+  /**
+   * Fit the observations to a GMM with stepwise EM over mini-batches of the
+   * observations.  The size of the vectors (indicating the number of
+   * components) must already be set.  If useInitialModel is true, the given
+   * model is used as the initial model instead of fitting one to the first
+   * mini-batch.  The running statistics are restarted.
+   *
+   * @param observations List of observations to train on.
+   * @param dists Distributions to store model in.
+   * @param weights Vector to store a priori weights in.
+   * @param useInitialModel If true, the given model is used as the initial
+   *     model.
+   */
+  void Estimate(const arma::mat& observations,
+                std::vector<Distribution>& dists,
+                arma::vec& weights,
+                const bool useInitialModel = false);
+
+  /**
+   * Fit the observations to a GMM with stepwise EM over mini-batches of the
+   * observations, taking into account the probability of each point being from
+   * this mixture.
+   *
+   * @param observations List of observations to train on.
+   * @param probabilities Probability of each point being from this model.
+   * @param dists Distributions to store model in.
+   * @param weights Vector to store a priori weights in.
+   * @param useInitialModel If true, the given model is used as the initial
+   *     model.
+   */
+  void Estimate(const arma::mat& observations,
+                const arma::vec& probabilities,
+                std::vector<Distribution>& dists,
+                arma::vec& weights,
+                const bool useInitialModel = false);
+
+  /**
+   * Update the model with one mini-batch of observations.  If no batch has
+   * been seen since the last Reset() and useInitialModel is false, the initial
+   * model is first fit to this batch.
+   *
+   * @param batch Mini-batch of observations.
+   * @param dists Distributions of the model, to be updated.
+   * @param weights A priori weights of the model, to be updated.
+   * @param useInitialModel If true, the given model is used as the initial
+   *     model.
+   * @return Log-likelihood of the batch under the model before the update.
+   */
+  double Step(const arma::mat& batch,
+              std::vector<Distribution>& dists,
+              arma::vec& weights,
+              const bool useInitialModel = false);
+
+  /**
+   * Update the model with one mini-batch of observations, each with the given
+   * probability of being from this mixture.
+   *
+   * @param batch Mini-batch of observations.
+   * @param probabilities Probability of each observation of the batch being
+   *     from this model.
+   * @param dists Distributions of the model, to be updated.
+   * @param weights A priori weights of the model, to be updated.
+   * @param useInitialModel If true, the given model is used as the initial
+   *     model.
+   * @return Log-likelihood of the batch under the model before the update.
+   */
+  double Step(const arma::mat& batch,
+              const arma::vec& probabilities,
+              std::vector<Distribution>& dists,
+              arma::vec& weights,
+              const bool useInitialModel = false);
+
+  //! Forget the running statistics, so that the next Step() starts over.
+  void Reset() { steps = 0; }
+
+  //! Get the number of mini-batches seen since the last Reset().
+  size_t Steps() const { return steps; }
+
+  //! Get the number of observations in each mini-batch.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of observations in each mini-batch.
+  size_t& BatchSize() { return batchSize; }
+
+  //! Get the maximum number of epochs of Estimate().
+  size_t MaxEpochs() const { return maxEpochs; }
+  //! Modify the maximum number of epochs of Estimate().
+  size_t& MaxEpochs() { return maxEpochs; }
+
+  //! Get the exponent of the decay of the step size.
+  double StepExponent() const { return stepExponent; }
+  //! Modify the exponent of the decay of the step size.
+  double& StepExponent() { return stepExponent; }
+
+  //! Get the tolerance for the convergence of Estimate().
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance for the convergence of Estimate().
+  double& Tolerance() { return tolerance; }
+
+  //! Get whether the observations are shuffled in each epoch.
+  bool Shuffle() const { return shuffle; }
+  //! Modify whether the observations are shuffled in each epoch.
+  bool& Shuffle() { return shuffle; }
+
+  //! Get the number of batch EM iterations for the initial model.
+  size_t InitialIterations() const { return initialIterations; }
+  //! Modify the number of batch EM iterations for the initial model.
+  size_t& InitialIterations() { return initialIterations; }
+
+  //! Get the clusterer.
+  const InitialClusteringType& Clusterer() const { return clusterer; }
+  //! Modify the clusterer.
+  InitialClusteringType& Clusterer() { return clusterer; }
+
+  //! Get the covariance constraint policy class.
+  const CovarianceConstraintPolicy& Constraint() const { return constraint; }
+  //! Modify the covariance constraint policy class.
+  CovarianceConstraintPolicy& Constraint() { return constraint; }
+
+  //! Serialize the fitter, including the running statistics.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t version);
+
+ private:
+  //! Whether the covariances are diagonal (held as vectors).
+  static constexpr bool IsDiagonal =
+      std::is_same<Distribution, DiagonalGaussianDistribution<>>::value;
+  //! The type of the covariance of a component.
+  typedef typename std::conditional<IsDiagonal, arma::vec, arma::mat>::type
+      CovarianceType;
+
+  /**
+   * Run Estimate() for the given (possibly NULL) probabilities.
+   */
+  void EstimateImpl(const arma::mat& observations,
+                    const arma::vec* probabilities,
+                    std::vector<Distribution>& dists,
+                    arma::vec& weights,
+                    const bool useInitialModel);
+
+  /**
+   * Run Step() for the given (possibly NULL) probabilities.
+   */
+  double StepImpl(const arma::mat& batch,
+                  const arma::vec* probabilities,
+                  std::vector<Distribution>& dists,
+                  arma::vec& weights,
+                  const bool useInitialModel);
+
+  //! Number of observations in each mini-batch.
+  size_t batchSize;
+  //! Maximum number of epochs of Estimate().
+  size_t maxEpochs;
+  //! Exponent of the decay of the step size.
+  double stepExponent;
+  //! Tolerance for convergence of Estimate().
+  double tolerance;
+  //! Whether to shuffle the observations in each epoch.
+  bool shuffle;
+  //! Number of batch EM iterations for the initial model.
+  size_t initialIterations;
+  //! Object which will perform the clustering.
+  InitialClusteringType clusterer;
+  //! Object which applies constraints to the covariance matrix.
+  CovarianceConstraintPolicy constraint;
+
+  //! Number of mini-batches seen since the last Reset().
+  size_t steps;
+  //! The point each component's statistics are centered on (one column for
+  //! each component).
+  arma::mat centers;
+  //! Running average probability of each component.
+  arma::vec weightStats;
+  //! Running average of the weighted offsets of the points from each center.
+  arma::mat meanStats;
+  //! Running average of the weighted outer products (or squares) of those
+  //! offsets.
+  std::vector<CovarianceType> covStats;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "stepwise_em_fit_impl.hpp"
+
+#endif
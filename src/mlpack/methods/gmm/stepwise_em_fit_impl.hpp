@@ -0,0 +1,327 @@
+/**
+ * @file methods/gmm/stepwise_em_fit_impl.hpp
+ *
+ * Implementation of the stepwise EM algorithm for fitting GMMs.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_STEPWISE_EM_FIT_IMPL_HPP
+#define MLPACK_METHODS_GMM_STEPWISE_EM_FIT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "stepwise_em_fit.hpp"
+#include <mlpack/core/math/log_add.hpp>
+
+namespace mlpack {
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+StepwiseEMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+StepwiseEMFit(const size_t batchSize,
+              const size_t maxEpochs,
+              const double stepExponent,
+              const double tolerance,
+              const bool shuffle,
+              const size_t initialIterations,
+              InitialClusteringType clusterer,
+              CovarianceConstraintPolicy constraint) :
+    batchSize(batchSize),
+    maxEpochs(maxEpochs),
+    stepExponent(stepExponent),
+    tolerance(tolerance),
+    shuffle(shuffle),
+    initialIterations(initialIterations),
+    clusterer(clusterer),
+    constraint(constraint),
+    steps(0)
+{ /* Nothing to do. */ }
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void StepwiseEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    Distribution>::Estimate(const arma::mat& observations,
+                            std::vector<Distribution>& dists,
+                            arma::vec& weights,
+                            const bool useInitialModel)
+{
+  EstimateImpl(observations, NULL, dists, weights, useInitialModel);
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void StepwiseEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    Distribution>::Estimate(const arma::mat& observations,
+                            const arma::vec& probabilities,
+                            std::vector<Distribution>& dists,
+                            arma::vec& weights,
+                            const bool useInitialModel)
+{
+  EstimateImpl(observations, &probabilities, dists, weights, useInitialModel);
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+double StepwiseEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    Distribution>::Step(const arma::mat& batch,
+                        std::vector<Distribution>& dists,
+                        arma::vec& weights,
+                        const bool useInitialModel)
+{
+  return StepImpl(batch, NULL, dists, weights, useInitialModel);
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+double StepwiseEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    Distribution>::Step(const arma::mat& batch,
+                        const arma::vec& probabilities,
+                        std::vector<Distribution>& dists,
+                        arma::vec& weights,
+                        const bool useInitialModel)
+{
+  return StepImpl(batch, &probabilities, dists, weights, useInitialModel);
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void StepwiseEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    Distribution>::EstimateImpl(const arma::mat& observations,
+                                const arma::vec* probabilities,
+                                std::vector<Distribution>& dists,
+                                arma::vec& weights,
+                                const bool useInitialModel)
+{
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("StepwiseEMFit::Estimate(): the batch size "
+        "must be positive!");
+  }
+
+  const size_t numPoints = observations.n_cols;
+  if (numPoints == 0)
+    return;
+
+  Reset();
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, numPoints - 1, numPoints);
+  double lOld = -DBL_MAX;
+  for (size_t epoch = 0; maxEpochs == 0 || epoch < maxEpochs; ++epoch)
+  {
+    if (shuffle)
+      order = arma::randperm(numPoints);
+
+    double l = 0.0;
+    for (size_t begin = 0; begin < numPoints; begin += batchSize)
+    {
+      const size_t end = std::min(begin + batchSize, numPoints);
+      const arma::uvec indices = order.subvec(begin, end - 1);
+      const arma::mat batch = observations.cols(indices);
+      if (probabilities == NULL)
+      {
+        l += StepImpl(batch, NULL, dists, weights, useInitialModel);
+      }
+      else
+      {
+        const arma::vec batchProbabilities = probabilities->elem(indices);
+        l += StepImpl(batch, &batchProbabilities, dists, weights,
+            useInitialModel);
+      }
+    }
+
+    // The average log-likelihood of the batches, each under the model that was
+    // current when it was seen.
+    l /= numPoints;
+    Log::Info << "StepwiseEMFit::Estimate(): epoch " << epoch << ", average "
+        << "log-likelihood " << l << "." << std::endl;
+
+    if (std::abs(l - lOld) <= tolerance)
+      break;
+    lOld = l;
+  }
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+double StepwiseEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    Distribution>::StepImpl(const arma::mat& batch,
+                            const arma::vec* probabilities,
+                            std::vector<Distribution>& dists,
+                            arma::vec& weights,
+                            const bool useInitialModel)
+{
+  if (stepExponent <= 0.5 || stepExponent > 1.0)
+  {
+    throw std::invalid_argument("StepwiseEMFit::Step(): the step exponent "
+        "must be in (0.5, 1]!");
+  }
+
+  if (dists.empty() || batch.n_cols == 0)
+    return 0.0;
+
+  if (batch.n_rows != dists[0].Mean().n_elem)
+  {
+    std::ostringstream oss;
+    oss << "StepwiseEMFit::Step(): dimensionality of batch (" << batch.n_rows
+        << ") does not match the dimensionality of the model ("
+        << dists[0].Mean().n_elem << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (probabilities != NULL && probabilities->n_elem != batch.n_cols)
+  {
+    throw std::invalid_argument("StepwiseEMFit::Step(): the number of "
+        "probabilities must match the number of points in the batch!");
+  }
+
+  const size_t dimensionality = batch.n_rows;
+  const size_t gaussians = dists.size();
+
+  if (steps == 0)
+  {
+    // Fit the initial model to this batch, if needed.
+    if (!useInitialModel)
+    {
+      EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>
+          em(initialIterations, 1e-10, clusterer, constraint);
+      if (probabilities == NULL)
+        em.Estimate(batch, dists, weights);
+      else
+        em.Estimate(batch, *probabilities, dists, weights);
+    }
+
+    // Start the running statistics, centered on the current means.
+    centers.set_size(dimensionality, gaussians);
+    for (size_t i = 0; i < gaussians; ++i)
+      centers.col(i) = dists[i].Mean();
+
+    weightStats.zeros(gaussians);
+    meanStats.zeros(dimensionality, gaussians);
+    covStats.resize(gaussians);
+    for (size_t i = 0; i < gaussians; ++i)
+    {
+      if constexpr (IsDiagonal)
+        covStats[i].zeros(dimensionality);
+      else
+        covStats[i].zeros(dimensionality, dimensionality);
+    }
+  }
+
+  // Calculate the conditional probabilities of each component for each point
+  // of the batch.
+  arma::mat condLogProb(batch.n_cols, gaussians);
+  for (size_t i = 0; i < gaussians; ++i)
+  {
+    arma::vec condLogProbAlias = condLogProb.unsafe_col(i);
+    dists[i].LogProbability(batch, condLogProbAlias);
+    condLogProbAlias += std::log(weights[i]);
+  }
+
+  // Normalize row-wise.
+  double logLikelihood = 0.0;
+  for (size_t j = 0; j < condLogProb.n_rows; ++j)
+  {
+    // Avoid dividing by zero; if the probability for everything is 0, we
+    // don't want to make it NaN.
+    const double probSum = AccuLog(condLogProb.row(j));
+    logLikelihood += probSum;
+    if (probSum != -std::numeric_limits<double>::infinity())
+      condLogProb.row(j) -= probSum;
+  }
+
+  arma::mat condProb = arma::exp(condLogProb);
+  double batchWeight = batch.n_cols;
+  if (probabilities != NULL)
+  {
+    condProb.each_col() %= *probabilities;
+    batchWeight = arma::accu(*probabilities);
+    if (batchWeight <= 0.0)
+      return logLikelihood;
+  }
+
+  // Mix the averaged statistics of the batch into the running statistics.
+  const double stepSize = std::pow(double(steps + 1), -stepExponent);
+  ++steps;
+
+  weightStats *= (1.0 - stepSize);
+  weightStats += (stepSize / batchWeight) * arma::sum(condProb, 0).t();
+  arma::mat centered;
+  for (size_t i = 0; i < gaussians; ++i)
+  {
+    centered = batch.each_col() - centers.col(i);
+    meanStats.col(i) *= (1.0 - stepSize);
+    meanStats.col(i) += (stepSize / batchWeight) * (centered * condProb.col(i));
+
+    covStats[i] *= (1.0 - stepSize);
+    if constexpr (IsDiagonal)
+    {
+      covStats[i] += (stepSize / batchWeight) *
+          ((centered % centered) * condProb.col(i));
+    }
+    else
+    {
+      // Scaling by the square root keeps the sum exactly symmetric.
+      centered.each_row() %= arma::sqrt(condProb.col(i)).t();
+      covStats[i] += (stepSize / batchWeight) * (centered * centered.t());
+    }
+  }
+
+  // Update the model from the running statistics.
+  for (size_t i = 0; i < gaussians; ++i)
+  {
+    // Don't update if there's no probability of the Gaussian having points.
+    if (weightStats[i] <= 0.0)
+      continue;
+
+    const arma::vec shift = meanStats.col(i) / weightStats[i];
+    CovarianceType covariance = covStats[i] / weightStats[i];
+    if constexpr (IsDiagonal)
+      covariance -= shift % shift;
+    else
+      covariance -= shift * shift.t();
+
+    // Apply covariance constraint.
+    constraint.ApplyConstraint(covariance);
+    dists[i].Mean() = centers.col(i) + shift;
+    dists[i].Covariance(std::move(covariance));
+  }
+
+  weights = weightStats / arma::accu(weightStats);
+
+  return logLikelihood;
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+template<typename Archive>
+void StepwiseEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    Distribution>::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(batchSize));
+  ar(CEREAL_NVP(maxEpochs));
+  ar(CEREAL_NVP(stepExponent));
+  ar(CEREAL_NVP(tolerance));
+  ar(CEREAL_NVP(shuffle));
+  ar(CEREAL_NVP(initialIterations));
+  ar(CEREAL_NVP(clusterer));
+  ar(CEREAL_NVP(constraint));
+  ar(CEREAL_NVP(steps));
+  ar(CEREAL_NVP(centers));
+  ar(CEREAL_NVP(weightStats));
+  ar(CEREAL_NVP(meanStats));
+  ar(CEREAL_NVP(covStats));
+}
+
+} // namespace mlpack
+
+#endif
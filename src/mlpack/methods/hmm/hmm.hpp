@@ -292,6 +292,51 @@ class HMM
    */
   double LogLikelihood(const arma::mat& dataSeq) const;
 
+  /**
+   * Compute the most probable hidden state sequence of each of the given data
+   * sequences, using the Viterbi algorithm.  The sequences are split between
+   * threads if OpenMP is enabled.
+   *
+   * @param dataSeq Sequences of observations.
+   * @param stateSeq Will hold the most probable state sequence of each data
+   *     sequence.
+   * @param logLikelihoods Will hold the log-likelihood of each most probable
+   *     state sequence.
+   */
+  void Predict(const std::vector<arma::mat>& dataSeq,
+               std::vector<arma::Row<size_t>>& stateSeq,
+               arma::vec& logLikelihoods) const;
+
+  /**
+   * Compute the most probable hidden state sequence of each of the given data
+   * sequences, which must all have the same length, using the Viterbi
+   * algorithm.  All the sequences are decoded at once: the recursion at each
+   * time step runs over contiguous vectors with one element for each sequence,
+   * which is much faster than decoding many short sequences one at a time.
+   * The results are the same as those of Predict() for each sequence.
+   *
+   * @param dataSeq Sequences of observations; slice i holds sequence i, with
+   *     one observation in each column.
+   * @param stateSeq Will hold the most probable state sequence of each data
+   *     sequence, in the corresponding row.
+   * @param logLikelihoods Will hold the log-likelihood of each most probable
+   *     state sequence.
+   */
+  void Predict(const arma::cube& dataSeq,
+               arma::Mat<size_t>& stateSeq,
+               arma::vec& logLikelihoods) const;
+
+  /**
+   * Compute the log-likelihood of each of the given data sequences.  The
+   * sequences are split between threads if OpenMP is enabled.
+   *
+   * @param dataSeq Data sequences to evaluate the likelihood of.
+   * @param logLikelihoods Will hold the log-likelihood of each sequence.
+   * @return Total log-likelihood of the sequences.
+   */
+  double LogLikelihood(const std::vector<arma::mat>& dataSeq,
+                       arma::vec& logLikelihoods) const;
+
   /**
    * Compute the log of the scaling factor of the given emission probability
    * at time t. To calculate the log-likelihood for the whole sequence,
@@ -100,10 +100,13 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
   // Maximum iterations?
   size_t iterations = 1000;
 
-  // Find length of all sequences and ensure they are the correct size.
+  // Find length of all sequences and ensure they are the correct size.  The
+  // observations of each sequence start at seqOffsets[seq] in emissionList.
   size_t totalLength = 0;
+  std::vector<size_t> seqOffsets(dataSeq.size());
   for (size_t seq = 0; seq < dataSeq.size(); seq++)
   {
+    seqOffsets[seq] = totalLength;
     totalLength += dataSeq[seq].n_cols;
 
     if (dataSeq[seq].n_rows != dimensionality)
@@ -112,6 +115,10 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
           << dimensionality << " dimensions)." << std::endl;
   }
 
+  // The sequences are processed in parallel, so the log-space parameters must
+  // be up to date before any of them is.
+  ConvertToLogSpace();
+
   // These are used later for training of each distribution.  We initialize it
   // all now so we don't have to do any allocation later on.
   std::vector<arma::vec> emissionProb(logTransition.n_cols,
@@ -132,70 +139,96 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
     // Reset log likelihood.
     loglik = 0;
 
-    // Sum over time.
-    size_t sumTime = 0;
-
-    // Loop over each sequence.
-    for (size_t seq = 0; seq < dataSeq.size(); seq++)
+    // The sequences are independent, so they are split between threads, each
+    // of which accumulates its own initial and transition estimates.  Each
+    // sequence writes its own part of emissionList and emissionProb.
+    #pragma omp parallel
     {
-      arma::mat stateLogProb;
-      arma::mat forwardLog;
-      arma::mat backwardLog;
-      arma::vec logScales;
-
-      // Add the log-likelihood of this sequence.  This is the E-step.
-      loglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
-          backwardLog, logScales);
-
-      // Add to estimate of initial probability for state j.
-      LogSumExp<arma::vec, true>(stateLogProb.unsafe_col(0),
-          newLogInitial);
-
-      // Define a variable to store the value of log-probability for data.
-      arma::mat logProbs(dataSeq[seq].n_cols, logTransition.n_rows);
-      // Save the values of log-probability to logProbs.
-      for (size_t i = 0; i < logTransition.n_rows; i++)
-      {
-        // Define alias of desired column.
-        arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
-        // Use advanced constructor for using logProbs directly.
-        emission[i].LogProbability(dataSeq[seq], alias);
-      }
-
-      // Now re-estimate the parameters.  This is the M-step.
-      //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
-      //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t]) b(i,
-      //           t + 1)))
-      //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t) b(i, t)
-      // We store the new estimates in a different matrix.
-      for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+      arma::vec threadLogInitial(logTransition.n_rows);
+      threadLogInitial.fill(-std::numeric_limits<double>::infinity());
+      arma::mat threadLogTransition(logTransition.n_rows, logTransition.n_cols);
+      threadLogTransition.fill(-std::numeric_limits<double>::infinity());
+      double threadLoglik = 0;
+
+      // Loop over each sequence.
+      #pragma omp for schedule(dynamic, 1)
+      for (size_t seq = 0; seq < dataSeq.size(); seq++)
       {
-        // Assemble temporary vector that's used in log-sum computation.
-        if (t < dataSeq[seq].n_cols - 1)
+        arma::mat stateLogProb;
+        arma::mat forwardLog;
+        arma::mat backwardLog;
+        arma::vec logScales;
+
+        // Sum over time.
+        size_t sumTime = seqOffsets[seq];
+
+        // Add the log-likelihood of this sequence.  This is the E-step.
+        threadLoglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
+            backwardLog, logScales);
+
+        // Add to estimate of initial probability for state j.
+        LogSumExp<arma::vec, true>(stateLogProb.unsafe_col(0),
+            threadLogInitial);
+
+        // Define a variable to store the value of log-probability for data.
+        arma::mat logProbs(dataSeq[seq].n_cols, logTransition.n_rows);
+        // Save the values of log-probability to logProbs.
+        for (size_t i = 0; i < logTransition.n_rows; i++)
         {
-          // This term is the same across all states, so compute it once and
-          // cache it.
-          const arma::vec tmp = backwardLog.col(t + 1) +
-              logProbs.row(t + 1).t() - logScales[t + 1];
-          arma::vec output;
-          LogSumExp(tmp, output);
+          // Define alias of desired column.
+          arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
+          // Use advanced constructor for using logProbs directly.
+          emission[i].LogProbability(dataSeq[seq], alias);
+        }
 
-          for (size_t j = 0; j < logTransition.n_cols; ++j)
+        // Now re-estimate the parameters.  This is the M-step.
+        //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
+        //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t])
+        //           b(i, t + 1)))
+        //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t)
+        //           b(i, t)
+        // We store the new estimates in a different matrix.
+        for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+        {
+          // Assemble temporary vector that's used in log-sum computation.
+          if (t < dataSeq[seq].n_cols - 1)
           {
-            // Compute the estimate of T_ij (probability of transition from
-            // state j to state i).  We postpone multiplication of the old T_ij
-            // until later.
-            arma::vec tmp2 = output + forwardLog(j, t);
-            arma::vec alias = newLogTransition.unsafe_col(j);
-            LogSumExp<arma::vec, true>(tmp2, alias);
+            // This term is the same across all states, so compute it once and
+            // cache it.
+            const arma::vec tmp = backwardLog.col(t + 1) +
+                logProbs.row(t + 1).t() - logScales[t + 1];
+            arma::vec output;
+            LogSumExp(tmp, output);
+
+            for (size_t j = 0; j < logTransition.n_cols; ++j)
+            {
+              // Compute the estimate of T_ij (probability of transition from
+              // state j to state i).  We postpone multiplication of the old
+              // T_ij until later.
+              arma::vec tmp2 = output + forwardLog(j, t);
+              arma::vec alias = threadLogTransition.unsafe_col(j);
+              LogSumExp<arma::vec, true>(tmp2, alias);
+            }
           }
+
+          // Add to list of emission observations, for Distribution::Train().
+          for (size_t j = 0; j < logTransition.n_cols; ++j)
+            emissionProb[j][sumTime] = std::exp(stateLogProb(j, t));
+          emissionList.col(sumTime) = dataSeq[seq].col(t);
+          sumTime++;
         }
+      }
 
-        // Add to list of emission observations, for Distribution::Train().
-        for (size_t j = 0; j < logTransition.n_cols; ++j)
-          emissionProb[j][sumTime] = std::exp(stateLogProb(j, t));
-        emissionList.col(sumTime) = dataSeq[seq].col(t);
-        sumTime++;
+      #pragma omp critical
+      {
+        loglik += threadLoglik;
+        for (size_t i = 0; i < newLogInitial.n_elem; ++i)
+          newLogInitial[i] = LogAdd(newLogInitial[i], threadLogInitial[i]);
+        for (size_t i = 0; i < newLogTransition.n_elem; ++i)
+        {
+          newLogTransition[i] = LogAdd(newLogTransition[i],
+              threadLogTransition[i]);
+        }
       }
     }
 
@@ -520,16 +553,23 @@ double HMM<Distribution>::Predict(const arma::mat& dataSeq,
     emission[i].LogProbability(dataSeq, alias);
   }
 
+  // Column j of the transposed transition matrix holds the log-probabilities
+  // of moving to state j from every state, so each step below needs only
+  // contiguous column operations.
+  const arma::mat logTransitionT = logTransition.t();
+  arma::mat prob(logTransition.n_rows, logTransition.n_rows);
   for (size_t t = 1; t < dataSeq.n_cols; t++)
   {
     // Assemble the state probability for this element.
     // Given that we are in state j, we use state with the highest probability
     // of being the previous state.
+    prob = logTransitionT;
+    prob.each_col() += logStateProb.col(t - 1);
+    const arma::urowvec best = arma::index_max(prob, 0);
     for (size_t j = 0; j < logTransition.n_rows; j++)
     {
-      arma::vec prob = logStateProb.col(t - 1) + logTransition.row(j).t();
-      logStateProb(j, t) = prob.max(index) + logProbs(t, j);
-      stateSeqBack(j, t) = index;
+      logStateProb(j, t) = prob(best[j], j) + logProbs(t, j);
+      stateSeqBack(j, t) = best[j];
     }
   }
 
@@ -572,6 +612,140 @@ double HMM<Distribution>::LogLikelihood(const arma::mat& dataSeq) const
   return accu(logScales);
 }
 
+/**
+ * Compute the most probable hidden state sequence of each given data sequence.
+ */
+template<typename Distribution>
+void HMM<Distribution>::Predict(const std::vector<arma::mat>& dataSeq,
+                                std::vector<arma::Row<size_t>>& stateSeq,
+                                arma::vec& logLikelihoods) const
+{
+  // This may modify the model, so it can't be done by each thread.
+  ConvertToLogSpace();
+
+  stateSeq.resize(dataSeq.size());
+  logLikelihoods.set_size(dataSeq.size());
+
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (size_t seq = 0; seq < dataSeq.size(); ++seq)
+    logLikelihoods[seq] = Predict(dataSeq[seq], stateSeq[seq]);
+}
+
+/**
+ * Compute the most probable hidden state sequence of each of the given
+ * equal-length data sequences at once.
+ */
+template<typename Distribution>
+void HMM<Distribution>::Predict(const arma::cube& dataSeq,
+                                arma::Mat<size_t>& stateSeq,
+                                arma::vec& logLikelihoods) const
+{
+  const size_t states = logTransition.n_rows;
+  const size_t length = dataSeq.n_cols;
+  const size_t numSeqs = dataSeq.n_slices;
+
+  stateSeq.set_size(numSeqs, length);
+  logLikelihoods.set_size(numSeqs);
+  if (length == 0 || numSeqs == 0)
+    return;
+
+  if (dataSeq.n_rows != dimensionality)
+  {
+    Log::Fatal << "HMM::Predict(): data sequences have dimensionality "
+        << dataSeq.n_rows << " (expected " << dimensionality << " dimensions)."
+        << std::endl;
+  }
+
+  ConvertToLogSpace();
+
+  // Compute the emission log-probabilities of all the observations at once,
+  // and lay them out so that column t of slice j holds the log-probability of
+  // the observation at time t of each sequence under state j.
+  arma::mat observations;
+  MakeAlias(observations, dataSeq, dataSeq.n_rows, length * numSeqs, 0, false);
+  arma::cube logProbs(numSeqs, length, states);
+  arma::vec stateLogProbs;
+  for (size_t j = 0; j < states; ++j)
+  {
+    emission[j].LogProbability(observations, stateLogProbs);
+    logProbs.slice(j) = arma::reshape(stateLogProbs, length, numSeqs).t();
+  }
+
+  // Column j of logStateProb holds, for each sequence, the log-probability of
+  // the most probable state sequence ending in state j at the current time.
+  arma::mat logStateProb(numSeqs, states);
+  arma::mat nextLogStateProb(numSeqs, states);
+  for (size_t j = 0; j < states; ++j)
+    logStateProb.col(j) = logInitial[j] + logProbs.slice(j).col(0);
+
+  // Slice t holds the best previous state for each sequence and each state.
+  arma::Cube<size_t> stateSeqBack(numSeqs, states, length);
+  for (size_t t = 1; t < length; ++t)
+  {
+    for (size_t j = 0; j < states; ++j)
+    {
+      // Take the maximum over the previous states, keeping the first of equal
+      // maxima as Predict() does.
+      double* best = nextLogStateProb.colptr(j);
+      size_t* back = stateSeqBack.slice_colptr(t, j);
+      const double* prev = logStateProb.colptr(0);
+      for (size_t b = 0; b < numSeqs; ++b)
+      {
+        best[b] = prev[b] + logTransition(j, 0);
+        back[b] = 0;
+      }
+
+      for (size_t i = 1; i < states; ++i)
+      {
+        const double logTrans = logTransition(j, i);
+        prev = logStateProb.colptr(i);
+        for (size_t b = 0; b < numSeqs; ++b)
+        {
+          const double prob = prev[b] + logTrans;
+          if (prob > best[b])
+          {
+            best[b] = prob;
+            back[b] = i;
+          }
+        }
+      }
+
+      nextLogStateProb.col(j) += logProbs.slice(j).col(t);
+    }
+
+    logStateProb.swap(nextLogStateProb);
+  }
+
+  // Backtrack to find the most probable state sequences.
+  for (size_t b = 0; b < numSeqs; ++b)
+  {
+    const size_t last = logStateProb.row(b).index_max();
+    logLikelihoods[b] = logStateProb(b, last);
+    stateSeq(b, length - 1) = last;
+    for (size_t t = length - 1; t > 0; --t)
+      stateSeq(b, t - 1) = stateSeqBack(b, stateSeq(b, t), t);
+  }
+}
+
+/**
+ * Compute the log-likelihood of each given data sequence.
+ */
+template<typename Distribution>
+double HMM<Distribution>::LogLikelihood(const std::vector<arma::mat>& dataSeq,
+                                        arma::vec& logLikelihoods) const
+{
+  // This may modify the model, so it can't be done by each thread.
+  ConvertToLogSpace();
+
+  logLikelihoods.set_size(dataSeq.size());
+
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (size_t seq = 0; seq < dataSeq.size(); ++seq)
+    logLikelihoods[seq] = LogLikelihood(dataSeq[seq]);
+
+  return accu(logLikelihoods);
+}
+
 /**
  * Compute the log of the scaling factor of the given emission probability
  * at time t. To calculate the log-likelihood for the whole sequence,
@@ -745,13 +919,21 @@ arma::vec HMM<Distribution>::ForwardAtTn(const arma::vec& emissionLogProb,
 
   // The forward probability of state j at time t is the sum over all states of
   // the probability of the previous state transitioning to the current state
-  // and emitting the given observation.  To do this computation in log-space,
-  // we can use LogSumExp().
+  // and emitting the given observation.  After shifting the previous forward
+  // probabilities by their maximum, this sum can be done in linear space with a
+  // single matrix-vector product, instead of a log-sum-exp for each state.
+  const double shift = prevForwardLogProb.max();
   arma::vec forwardLogProb;
-  arma::mat tmp = logTransition + repmat(prevForwardLogProb.t(),
-      logTransition.n_rows, 1);
-  LogSumExp(tmp, forwardLogProb);
-  forwardLogProb += emissionLogProb;
+  if (std::isfinite(shift))
+  {
+    forwardLogProb = arma::log(transitionProxy *
+        arma::exp(prevForwardLogProb - shift)) + shift + emissionLogProb;
+  }
+  else
+  {
+    forwardLogProb.set_size(logTransition.n_rows);
+    forwardLogProb.fill(-std::numeric_limits<double>::infinity());
+  }
 
   // Normalize probability.
   logScales = AccuLog(forwardLogProb);
@@ -808,18 +990,22 @@ void HMM<Distribution>::Backward(const arma::mat& dataSeq,
   backwardLogProb.col(dataSeq.n_cols - 1).fill(0);
 
   // Now step backwards through all other observations.
+  arma::vec next;
   for (size_t t = dataSeq.n_cols - 2; t + 1 > 0; t--)
   {
     // The backward probability of state j at time t is the sum over all
     // states of the probability of the next state having been a transition
     // from the current state multiplied by the probability of each of those
-    // states emitting the given observation.  To compute this in log-space, we
-    // can use LogSumExpT().
-    const arma::mat tmp = logTransition +
-        repmat(backwardLogProb.col(t + 1), 1, logTransition.n_cols) +
-        repmat(logProbs.row(t + 1).t(), 1, logTransition.n_cols);
-    arma::vec alias = backwardLogProb.unsafe_col(t);
-    LogSumExpT<arma::mat, true>(tmp, alias);
+    // states emitting the given observation.  As in Forward(), this is a
+    // matrix-vector product (with the transposed transition matrix) in linear
+    // space, after shifting by the maximum.
+    next = backwardLogProb.col(t + 1) + logProbs.row(t + 1).t();
+    const double shift = next.max();
+    if (!std::isfinite(shift))
+      continue;
+
+    backwardLogProb.col(t) = arma::log(transitionProxy.t() *
+        arma::exp(next - shift)) + shift;
 
     // Normalize by the weights from the forward algorithm.
     if (std::isfinite(logScales[t + 1]))
@@ -0,0 +1,233 @@
+/**
+ * @file methods/hnsw/hnsw_main.cpp
+ *
+ * This file computes approximate nearest neighbors with a Hierarchical
+ * Navigable Small World graph.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#undef BINDING_NAME
+#define BINDING_NAME hnsw
+
+#include <mlpack/core/util/mlpack_main.hpp>
+
+#include "hnsw_search.hpp"
+
+using namespace std;
+using namespace mlpack;
+using namespace mlpack::util;
+
+// Program Name.
+BINDING_USER_NAME("K-Approximate-Nearest-Neighbor Search with HNSW");
+
+// Short description.
+BINDING_SHORT_DESC(
+    "An implementation of approximate k-nearest-neighbor search with a "
+    "Hierarchical Navigable Small World (HNSW) graph.  Given a set of "
+    "reference points and a set of query points, this will compute the k "
+    "approximate nearest neighbors of each query point in the reference set; "
+    "models can be saved for future use.");
+
+// Long description.
+BINDING_LONG_DESC(
+    "This program will calculate the k approximate-nearest-neighbors of a set "
+    "of points using a Hierarchical Navigable Small World graph.  You may "
+    "specify a separate set of reference points and query points, or just a "
+    "reference set which will be used as both the reference and query set."
+    "\n\n"
+    "Each reference point is linked to up to " + PRINT_PARAM_STRING("links") +
+    " of its neighbors in each layer of the graph (twice as many in the "
+    "bottom layer); the " + PRINT_PARAM_STRING("ef_construction") + " and " +
+    PRINT_PARAM_STRING("ef_search") + " parameters control how many "
+    "candidate neighbors are kept while building the graph and while "
+    "searching it.  Larger values give a better recall, at the cost of more "
+    "time.");
+
+// Example.
+BINDING_EXAMPLE(
+    "For example, the following will return 5 neighbors from the data for each "
+    "point in " + PRINT_DATASET("input") + " and store the distances in " +
+    PRINT_DATASET("distances") + " and the neighbors in " +
+    PRINT_DATASET("neighbors") + ":"
+    "\n\n" +
+    PRINT_CALL("hnsw", "k", 5, "reference", "input", "distances", "distances",
+        "neighbors", "neighbors") +
+    "\n\n"
+    "The output is organized such that row i and column j in the neighbors "
+    "output corresponds to the index of the point in the reference set which "
+    "is the j'th nearest neighbor from the point in the query set with index "
+    "i.  Row j and column i in the distances output file corresponds to the "
+    "distance between those two points."
+    "\n\n"
+    "The graph that is built depends on the random seed, which can be set "
+    "with the " + PRINT_PARAM_STRING("seed") + " parameter, and, when the "
+    "graph is built with several threads, on the order in which the points "
+    "are inserted.");
+
+// See also...
+BINDING_SEE_ALSO("@knn", "#knn");
+BINDING_SEE_ALSO("@lsh", "#lsh");
+BINDING_SEE_ALSO("Efficient and robust approximate nearest neighbor search "
+    "using Hierarchical Navigable Small World graphs (pdf)",
+    "https://arxiv.org/pdf/1603.09320.pdf");
+BINDING_SEE_ALSO("HNSWSearch C++ class documentation",
+    "@src/mlpack/methods/hnsw/hnsw.hpp");
+
+// Define our input parameters that this program will take.
+PARAM_MATRIX_IN("reference", "Matrix containing the reference dataset.", "r");
+PARAM_MATRIX_OUT("distances", "Matrix to output distances into.", "d");
+PARAM_UMATRIX_OUT("neighbors", "Matrix to output neighbors into.", "n");
+
+// We can load or save models.
+PARAM_MODEL_IN(HNSWSearch<>, "input_model", "Input HNSW model.", "m");
+PARAM_MODEL_OUT(HNSWSearch<>, "output_model", "Output for trained HNSW model.",
+    "M");
+
+// For testing recall.
+PARAM_UMATRIX_IN("true_neighbors", "Matrix of true neighbors to compute "
+    "recall with (the recall is printed when -v is specified).", "t");
+
+PARAM_INT_IN("k", "Number of nearest neighbors to find.", "k", 0);
+PARAM_MATRIX_IN("query", "Matrix containing query points (optional).", "q");
+
+PARAM_INT_IN("links", "The number of links of each point in each layer of the "
+    "graph (M); points have twice as many links in the bottom layer.", "L",
+    16);
+PARAM_INT_IN("ef_construction", "The number of candidate neighbors kept while "
+    "building the graph.", "c", 200);
+PARAM_INT_IN("ef_search", "The number of candidate neighbors kept while "
+    "searching the graph; if 0, the value stored in the model is used.", "e",
+    0);
+PARAM_INT_IN("seed", "Random seed.  If 0, 'std::time(NULL)' is used.", "s", 0);
+
+void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
+{
+  if (params.Get<int>("seed") != 0)
+    RandomSeed((size_t) params.Get<int>("seed"));
+  else
+    RandomSeed((size_t) time(NULL));
+
+  // Get all the parameters after checking them.
+  if (params.Has("k"))
+  {
+    RequireParamValue<int>(params, "k", [](int x) { return x > 0; }, true,
+        "k must be greater than 0");
+  }
+  RequireParamValue<int>(params, "links", [](int x) { return x >= 2; }, true,
+      "number of links must be at least 2");
+  RequireParamValue<int>(params, "ef_construction",
+      [](int x) { return x > 0; }, true, "ef_construction must be positive");
+  RequireParamValue<int>(params, "ef_search", [](int x) { return x >= 0; },
+      true, "ef_search must be non-negative");
+
+  const size_t k = params.Get<int>("k");
+  const size_t links = params.Get<int>("links");
+  const size_t efConstruction = params.Get<int>("ef_construction");
+  const size_t efSearch = params.Get<int>("ef_search");
+
+  RequireOnlyOnePassed(params, { "input_model", "reference" }, true);
+  RequireAtLeastOnePassed(params, { "neighbors", "distances", "output_model" },
+      false, "no results will be saved");
+
+  ReportIgnoredParam(params, {{ "k", false }}, "neighbors");
+  ReportIgnoredParam(params, {{ "k", false }}, "distances");
+
+  ReportIgnoredParam(params, {{ "reference", false }}, "links");
+  ReportIgnoredParam(params, {{ "reference", false }}, "ef_construction");
+
+  if (params.Has("input_model") && !params.Has("k"))
+  {
+    Log::Warn << PRINT_PARAM_STRING("k") << " not passed; no search will be "
+        << "performed!" << std::endl;
+  }
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+
+  HNSWSearch<>* hnsw;
+  if (params.Has("reference"))
+  {
+    Log::Info << "Using reference data from "
+        << params.GetPrintable<arma::mat>("reference") << "." << endl;
+    Log::Info << "Building HNSW graph with " << links << " links per point "
+        << "and ef_construction " << efConstruction << "." << endl;
+
+    hnsw = new HNSWSearch<>(links, efConstruction);
+    timers.Start("graph_building");
+    hnsw->Train(std::move(params.Get<arma::mat>("reference")));
+    timers.Stop("graph_building");
+  }
+  else // We must have an input model.
+  {
+    hnsw = params.Get<HNSWSearch<>*>("input_model");
+  }
+
+  if (efSearch > 0)
+    hnsw->EfSearch() = efSearch;
+
+  if (params.Has("k"))
+  {
+    Log::Info << "Computing " << k << " distance approximate nearest neighbors "
+        << "with ef_search " << std::max(hnsw->EfSearch(), k) << "." << endl;
+    if (params.Has("query"))
+    {
+      Log::Info << "Loaded query data from "
+          << params.GetPrintable<arma::mat>("query") << "." << endl;
+      const arma::mat& queryData = params.Get<arma::mat>("query");
+
+      timers.Start("computing_neighbors");
+      hnsw->Search(queryData, k, neighbors, distances);
+      timers.Stop("computing_neighbors");
+    }
+    else
+    {
+      timers.Start("computing_neighbors");
+      hnsw->Search(k, neighbors, distances);
+      timers.Stop("computing_neighbors");
+    }
+
+    Log::Info << "Neighbors computed with " << hnsw->DistanceEvaluations()
+        << " distance evaluations." << endl;
+  }
+
+  // Compute recall, if desired.
+  if (params.Has("true_neighbors") && params.Has("k"))
+  {
+    Log::Info << "Using true neighbor indices from '"
+        << params.GetPrintable<arma::Mat<size_t>>("true_neighbors") << "'."
+        << endl;
+
+    // Load the true neighbors.
+    arma::Mat<size_t> trueNeighbors =
+        std::move(params.Get<arma::Mat<size_t>>("true_neighbors"));
+
+    if (trueNeighbors.n_rows != neighbors.n_rows ||
+        trueNeighbors.n_cols != neighbors.n_cols)
+    {
+      // Delete the model if needed.
+      if (params.Has("reference"))
+        delete hnsw;
+      Log::Fatal << "The true neighbors file must have the same number of "
+          << "values as the set of neighbors being queried!" << endl;
+    }
+
+    // Compute recall and print it.
+    const double recallPercentage = 100 * HNSWSearch<>::ComputeRecall(
+        neighbors, trueNeighbors);
+
+    Log::Info << "Recall: " << recallPercentage << endl;
+  }
+
+  // Save output, if we did a search.
+  if (params.Has("k"))
+  {
+    params.Get<arma::mat>("distances") = std::move(distances);
+    params.Get<arma::Mat<size_t>>("neighbors") = std::move(neighbors);
+  }
+  params.Get<HNSWSearch<>*>("output_model") = hnsw;
+}
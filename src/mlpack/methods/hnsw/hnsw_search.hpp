@@ -0,0 +1,387 @@
+/**
+ * @file methods/hnsw/hnsw_search.hpp
+ *
+ * Defines the HNSWSearch class, which performs approximate nearest neighbor
+ * search with a Hierarchical Navigable Small World graph.
+ *
+ * The details of this method can be found in the following paper:
+ *
+ * @code
+ * @article{malkov2020efficient,
+ *   title={Efficient and Robust Approximate Nearest Neighbor Search Using
+ *       Hierarchical Navigable Small World Graphs},
+ *   author={Malkov, Yu A. and Yashunin, D. A.},
+ *   journal={IEEE Transactions on Pattern Analysis and Machine Intelligence},
+ *   volume={42},
+ *   number={4},
+ *   pages={824--836},
+ *   year={2020}
+ * }
+ * @endcode
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HNSW_HNSW_SEARCH_HPP
+#define MLPACK_METHODS_HNSW_HNSW_SEARCH_HPP
+
+#include <mlpack/core.hpp>
+#include <mutex>
+
+namespace mlpack {
+
+/**
+ * The HNSWSearch class builds a Hierarchical Navigable Small World graph on the
+ * reference set, and uses it to find the approximate nearest neighbors of the
+ * given queries.  Every reference point is a node of layer 0 and, with
+ * exponentially decreasing probability, of the layers above it; in each layer,
+ * a node is linked to up to M of its nearby nodes (2 * M in layer 0).  A search
+ * descends greedily through the upper layers, and then does a best-first search
+ * of layer 0 that keeps the efSearch best nodes seen so far.
+ *
+ * Points can be added to the graph one at a time with Insert(), and the graph
+ * is built in parallel by Train() when OpenMP is available.
+ *
+ * Any distance class with an Evaluate() function can be used, for instance
+ * LMetric (the default is EuclideanDistance) or IPMetric.  IPMetric searches
+ * in the space induced by its kernel; for instance,
+ * IPMetric<CosineSimilarity> finds the neighbors with the largest cosine
+ * similarity, which is inner-product search for normalized points.
+ *
+ * @tparam DistanceType The distance to search with.
+ * @tparam MatType Type of matrix to use to store the data.
+ */
+template<
+    typename DistanceType = EuclideanDistance,
+    typename MatType = arma::mat
+>
+class HNSWSearch
+{
+ public:
+  //! The type of element held in MatType.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Build the graph on the given reference set.  In order to avoid copying the
+   * reference set, consider passing it with std::move().
+   *
+   * @param referenceSet Set of reference points.
+   * @param m Number of links of each node in the upper layers; nodes in layer 0
+   *     have up to 2 * m links.  This must be at least 2.
+   * @param efConstruction Number of candidate neighbors kept while inserting a
+   *     point; larger values give a better graph and a slower build.
+   * @param efSearch Default number of candidate neighbors kept while searching;
+   *     larger values give a better recall and slower searches.
+   * @param distance Instantiated distance (for distances that hold state).
+   */
+  HNSWSearch(MatType referenceSet,
+             const size_t m = 16,
+             const size_t efConstruction = 200,
+             const size_t efSearch = 50,
+             DistanceType distance = DistanceType());
+
+  /**
+   * Create an empty model.  Points can be added with Insert(), or a graph can
+   * be built with Train().
+   *
+   * @param m Number of links of each node in the upper layers.
+   * @param efConstruction Number of candidate neighbors kept while inserting a
+   *     point.
+   * @param efSearch Default number of candidate neighbors kept while searching.
+   * @param distance Instantiated distance (for distances that hold state).
+   */
+  HNSWSearch(const size_t m = 16,
+             const size_t efConstruction = 200,
+             const size_t efSearch = 50,
+             DistanceType distance = DistanceType());
+
+  /**
+   * Build the graph on the given reference set, replacing the current one.
+   * The points are inserted in parallel when OpenMP is available.  In order to
+   * avoid copying the reference set, consider passing it with std::move().
+   *
+   * @param referenceSet Set of reference points.
+   * @param m Number of links of each node in the upper layers.
+   * @param efConstruction Number of candidate neighbors kept while inserting a
+   *     point.
+   */
+  void Train(MatType referenceSet,
+             const size_t m,
+             const size_t efConstruction);
+
+  /**
+   * Build the graph on the given reference set with the current M and
+   * efConstruction, replacing the current one.
+   *
+   * @param referenceSet Set of reference points.
+   */
+  void Train(MatType referenceSet);
+
+  /**
+   * Add the given point to the reference set and to the graph.  The new point
+   * has index ReferenceSet().n_cols - 1.  This must not be called while a
+   * search is running.
+   *
+   * @param point Point to insert.
+   */
+  template<typename VecType>
+  void Insert(const VecType& point);
+
+  /**
+   * Compute the approximate nearest neighbors of the points in the given query
+   * set.  The output matrices will have k rows and one column per query point;
+   * the neighbors of each point are sorted from nearest to furthest.  The query
+   * points are searched in parallel when OpenMP is available.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix to store the neighbors in.
+   * @param distances Matrix to store the distances in.
+   * @param ef Number of candidate neighbors to keep; if 0, EfSearch() is used.
+   *     At least k candidates are kept.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances,
+              const size_t ef = 0);
+
+  /**
+   * Compute the approximate nearest neighbors of every point in the reference
+   * set, not counting the point itself.  The output matrices are organized as
+   * with the other overload of Search().
+   *
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix to store the neighbors in.
+   * @param distances Matrix to store the distances in.
+   * @param ef Number of candidate neighbors to keep; if 0, EfSearch() is used.
+   *     At least k + 1 candidates are kept.
+   */
+  void Search(const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances,
+              const size_t ef = 0);
+
+  /**
+   * Compute the recall (% of neighbors found) given the neighbors returned by
+   * HNSWSearch::Search() and a "ground truth" set of neighbors.  The recall
+   * returned will be in the range [0, 1].
+   *
+   * @param foundNeighbors Set of neighbors to compute recall of.
+   * @param realNeighbors Set of "ground truth" neighbors to compute recall
+   *     against.
+   */
+  static double ComputeRecall(const arma::Mat<size_t>& foundNeighbors,
+                              const arma::Mat<size_t>& realNeighbors);
+
+  /**
+   * Serialize the HNSW model.
+   *
+   * @param ar Archive to serialize to.
+   * @param version Version of the serialized model.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t version);
+
+  //! Get the reference set.
+  const MatType& ReferenceSet() const { return referenceSet; }
+
+  //! Get the number of links of each node in the upper layers.
+  size_t M() const { return m; }
+  //! Get the number of candidate neighbors kept while inserting a point.
+  size_t EfConstruction() const { return efConstruction; }
+  //! Modify the number of candidate neighbors kept while inserting a point.
+  size_t& EfConstruction() { return efConstruction; }
+  //! Get the default number of candidate neighbors kept while searching.
+  size_t EfSearch() const { return efSearch; }
+  //! Modify the default number of candidate neighbors kept while searching.
+  size_t& EfSearch() { return efSearch; }
+
+  //! Get the number of layers of the graph (0 if the graph is empty).
+  size_t NumLayers() const { return links.empty() ? 0 : maxLevel + 1; }
+  //! Get the highest layer that the given point is a node of.
+  size_t Level(const size_t point) const { return links[point].size() - 1; }
+  //! Get the links of the given point in the given layer.
+  const std::vector<size_t>& Links(const size_t point,
+                                   const size_t layer) const
+  { return links[point][layer]; }
+  //! Get the point that searches start from.
+  size_t EntryPoint() const { return entryPoint; }
+
+  //! Get the number of distance evaluations performed.
+  size_t DistanceEvaluations() const { return distanceEvaluations; }
+  //! Modify the number of distance evaluations performed.
+  size_t& DistanceEvaluations() { return distanceEvaluations; }
+
+  //! Get the distance.
+  const DistanceType& Distance() const { return distance; }
+  //! Modify the distance.
+  DistanceType& Distance() { return distance; }
+
+ private:
+  //! Candidate represents a possible neighbor (distance, index).
+  typedef std::pair<ElemType, size_t> Candidate;
+
+  /**
+   * The set of nodes that a search has visited.  Resetting it is O(1), so that
+   * one object can be reused by all the searches of a thread.
+   */
+  class VisitedSet
+  {
+   public:
+    //! Create an empty set for the given number of nodes.
+    VisitedSet(const size_t numNodes) : marks(numNodes, 0), tag(0) { }
+
+    //! Empty the set.
+    void Clear()
+    {
+      if (++tag == 0)
+      {
+        std::fill(marks.begin(), marks.end(), 0);
+        tag = 1;
+      }
+    }
+
+    //! Add the given node; return false if it was already in the set.
+    bool Insert(const size_t node)
+    {
+      if (marks[node] == tag)
+        return false;
+      marks[node] = tag;
+      return true;
+    }
+
+   private:
+    //! The tag of the last search that visited each node.
+    std::vector<uint32_t> marks;
+    //! The tag of the current search.
+    uint32_t tag;
+  };
+
+  /**
+   * Draw the level of a new node: floor(-ln(u) / ln(M)) for u uniform in
+   * (0, 1].
+   */
+  size_t RandomLevel() const;
+
+  //! Get the maximum number of links of a node in the given layer.
+  size_t MaxLinks(const size_t layer) const
+  { return (layer == 0) ? 2 * m : m; }
+
+  /**
+   * Get the links of the given node in the given layer.  If locks is not NULL,
+   * the links are copied into buffer while holding the lock of the node, and
+   * buffer is returned.
+   */
+  const std::vector<size_t>& NodeLinks(const size_t node,
+                                       const size_t layer,
+                                       std::mutex* locks,
+                                       std::vector<size_t>& buffer) const;
+
+  /**
+   * Insert the given reference point, whose links must already be allocated,
+   * into the graph.  If locks is not NULL, other points may be inserted at the
+   * same time: locks[i] protects the links of point i, and graphLock protects
+   * the entry point and the number of layers.
+   *
+   * @param point Index of the point to insert.
+   * @param visited Visited set of the calling thread.
+   * @param evaluations Counter of distance evaluations of the calling thread.
+   * @param locks Locks of the links of each point, or NULL.
+   * @param graphLock Lock of the entry point, or NULL.
+   */
+  void InsertPoint(const size_t point,
+                   VisitedSet& visited,
+                   size_t& evaluations,
+                   std::mutex* locks,
+                   std::mutex* graphLock);
+
+  /**
+   * Move greedily from the given node towards the query point in the given
+   * layer, until no link is closer; the node and its distance are updated.
+   */
+  template<typename VecType>
+  void GreedySearch(const VecType& query,
+                    const size_t layer,
+                    size_t& node,
+                    ElemType& nodeDistance,
+                    size_t& evaluations,
+                    std::mutex* locks);
+
+  /**
+   * Search the given layer best-first from the given entry points, keeping the
+   * ef best nodes seen so far.  On return, results holds those nodes, sorted
+   * from nearest to furthest.
+   *
+   * @param query Query point.
+   * @param layer Layer to search.
+   * @param entryPoints Nodes to start from, with their distances.
+   * @param ef Number of nodes to keep.
+   * @param visited Visited set of the calling thread.
+   * @param evaluations Counter of distance evaluations of the calling thread.
+   * @param locks Locks of the links of each point, or NULL.
+   * @param results The ef nearest nodes that were found.
+   */
+  template<typename VecType>
+  void SearchLayer(const VecType& query,
+                   const size_t layer,
+                   const std::vector<Candidate>& entryPoints,
+                   const size_t ef,
+                   VisitedSet& visited,
+                   size_t& evaluations,
+                   std::mutex* locks,
+                   std::vector<Candidate>& results);
+
+  /**
+   * Choose at most maxLinks neighbors among the given candidates (sorted from
+   * nearest to furthest) with the heuristic of the paper: a candidate is kept
+   * only if it is closer to the point than to every kept candidate, so that the
+   * links go in diverse directions.
+   */
+  void SelectNeighbors(std::vector<Candidate>& candidates,
+                       const size_t maxLinks,
+                       size_t& evaluations);
+
+  /**
+   * Search for the approximate nearest neighbors of one query point, and store
+   * them in the given column of the output matrices.  If skip is a valid
+   * reference index, that point is not returned.
+   */
+  template<typename VecType>
+  void SearchPoint(const VecType& query,
+                   const size_t k,
+                   const size_t ef,
+                   const size_t skip,
+                   VisitedSet& visited,
+                   size_t& evaluations,
+                   size_t* neighbors,
+                   ElemType* distances);
+
+  //! The reference set.
+  MatType referenceSet;
+  //! The number of links of each node in the upper layers.
+  size_t m;
+  //! The number of candidate neighbors kept while inserting a point.
+  size_t efConstruction;
+  //! The default number of candidate neighbors kept while searching.
+  size_t efSearch;
+  //! The links of each point, for each layer from 0 to the level of the point.
+  std::vector<std::vector<std::vector<size_t>>> links;
+  //! The point that searches start from; its level is maxLevel.
+  size_t entryPoint;
+  //! The highest level of any point.
+  size_t maxLevel;
+  //! The number of distance evaluations.
+  size_t distanceEvaluations;
+  //! The instantiated distance.
+  DistanceType distance;
+}; // class HNSWSearch
+
+} // namespace mlpack
+
+// Include implementation.
+#include "hnsw_search_impl.hpp"
+
+#endif
@@ -0,0 +1,568 @@
+/**
+ * @file methods/hnsw/hnsw_search_impl.hpp
+ *
+ * Implementation of the HNSWSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HNSW_HNSW_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_HNSW_HNSW_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "hnsw_search.hpp"
+
+#include <mlpack/core/math/random.hpp>
+
+namespace mlpack {
+
+// Build the graph on the given reference set.
+template<typename DistanceType, typename MatType>
+HNSWSearch<DistanceType, MatType>::HNSWSearch(MatType referenceSet,
+                                              const size_t m,
+                                              const size_t efConstruction,
+                                              const size_t efSearch,
+                                              DistanceType distance) :
+    m(m),
+    efConstruction(efConstruction),
+    efSearch(efSearch),
+    entryPoint(0),
+    maxLevel(0),
+    distanceEvaluations(0),
+    distance(std::move(distance))
+{
+  Train(std::move(referenceSet), m, efConstruction);
+}
+
+// Create an empty model.
+template<typename DistanceType, typename MatType>
+HNSWSearch<DistanceType, MatType>::HNSWSearch(const size_t m,
+                                              const size_t efConstruction,
+                                              const size_t efSearch,
+                                              DistanceType distance) :
+    m(m),
+    efConstruction(efConstruction),
+    efSearch(efSearch),
+    entryPoint(0),
+    maxLevel(0),
+    distanceEvaluations(0),
+    distance(std::move(distance))
+{
+  if (m < 2)
+    throw std::invalid_argument("HNSWSearch::HNSWSearch(): m must be at least "
+        "2");
+}
+
+// Build the graph, inserting the points in parallel.
+template<typename DistanceType, typename MatType>
+void HNSWSearch<DistanceType, MatType>::Train(MatType referenceSetIn,
+                                              const size_t mIn,
+                                              const size_t efConstructionIn)
+{
+  if (mIn < 2)
+    throw std::invalid_argument("HNSWSearch::Train(): m must be at least 2");
+
+  referenceSet = std::move(referenceSetIn);
+  m = mIn;
+  efConstruction = efConstructionIn;
+  distanceEvaluations = 0;
+
+  // The levels are drawn before the points are inserted, so that they do not
+  // depend on the order in which the threads insert the points.
+  const size_t numPoints = referenceSet.n_cols;
+  links.clear();
+  links.resize(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+    links[i].resize(RandomLevel() + 1);
+
+  entryPoint = 0;
+  maxLevel = 0;
+  if (numPoints == 0)
+    return;
+
+  maxLevel = Level(0);
+
+  // Every point may be linked to by several threads at once, so each point has
+  // its own lock.
+  std::unique_ptr<std::mutex[]> locks(new std::mutex[numPoints]);
+  std::mutex graphLock;
+  size_t evaluations = 0;
+
+  #pragma omp parallel reduction(+:evaluations)
+  {
+    VisitedSet visited(numPoints);
+
+    #pragma omp for schedule(dynamic, 64)
+    for (size_t i = 1; i < numPoints; ++i)
+      InsertPoint(i, visited, evaluations, locks.get(), &graphLock);
+  }
+
+  distanceEvaluations += evaluations;
+}
+
+// Build the graph with the current parameters.
+template<typename DistanceType, typename MatType>
+void HNSWSearch<DistanceType, MatType>::Train(MatType referenceSetIn)
+{
+  Train(std::move(referenceSetIn), m, efConstruction);
+}
+
+// Insert a single point.
+template<typename DistanceType, typename MatType>
+template<typename VecType>
+void HNSWSearch<DistanceType, MatType>::Insert(const VecType& point)
+{
+  if (referenceSet.n_cols > 0 && point.n_elem != referenceSet.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "HNSWSearch::Insert(): dimensionality of point (" << point.n_elem
+        << ") is not equal to the dimensionality of the reference set ("
+        << referenceSet.n_rows << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  referenceSet.insert_cols(referenceSet.n_cols, point);
+  links.emplace_back(RandomLevel() + 1);
+
+  const size_t index = referenceSet.n_cols - 1;
+  if (index == 0)
+  {
+    entryPoint = 0;
+    maxLevel = Level(0);
+    return;
+  }
+
+  VisitedSet visited(referenceSet.n_cols);
+  InsertPoint(index, visited, distanceEvaluations, NULL, NULL);
+}
+
+// Search for the neighbors of the given query points.
+template<typename DistanceType, typename MatType>
+void HNSWSearch<DistanceType, MatType>::Search(const MatType& querySet,
+                                               const size_t k,
+                                               arma::Mat<size_t>& neighbors,
+                                               arma::Mat<ElemType>& distances,
+                                               const size_t ef)
+{
+  if (k > referenceSet.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "HNSWSearch::Search(): requested " << k << " approximate nearest "
+        << "neighbors, but reference set has " << referenceSet.n_cols
+        << " points!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (k > 0 && querySet.n_rows != referenceSet.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "HNSWSearch::Search(): dimensionality of query set ("
+        << querySet.n_rows << ") is not equal to the dimensionality of the "
+        << "reference set (" << referenceSet.n_rows << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+  if (k == 0)
+    return;
+
+  const size_t searchEf = std::max((ef == 0) ? efSearch : ef, k);
+  size_t evaluations = 0;
+
+  #pragma omp parallel reduction(+:evaluations)
+  {
+    VisitedSet visited(referenceSet.n_cols);
+
+    #pragma omp for schedule(dynamic, 16)
+    for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
+    {
+      SearchPoint(querySet.col(i), k, searchEf, referenceSet.n_cols, visited,
+          evaluations, neighbors.colptr(i), distances.colptr(i));
+    }
+  }
+
+  distanceEvaluations += evaluations;
+}
+
+// Search for the neighbors of each reference point.
+template<typename DistanceType, typename MatType>
+void HNSWSearch<DistanceType, MatType>::Search(const size_t k,
+                                               arma::Mat<size_t>& neighbors,
+                                               arma::Mat<ElemType>& distances,
+                                               const size_t ef)
+{
+  if (k >= referenceSet.n_cols && k > 0)
+  {
+    std::ostringstream oss;
+    oss << "HNSWSearch::Search(): requested " << k << " approximate nearest "
+        << "neighbors, but reference set has " << referenceSet.n_cols
+        << " points!  Each point is not its own neighbor, so fewer than "
+        << referenceSet.n_cols << " neighbors must be requested.";
+    throw std::invalid_argument(oss.str());
+  }
+
+  neighbors.set_size(k, referenceSet.n_cols);
+  distances.set_size(k, referenceSet.n_cols);
+  if (k == 0)
+    return;
+
+  // One more candidate is kept, since the point itself will be found.
+  const size_t searchEf = std::max((ef == 0) ? efSearch : ef, k + 1);
+  size_t evaluations = 0;
+
+  #pragma omp parallel reduction(+:evaluations)
+  {
+    VisitedSet visited(referenceSet.n_cols);
+
+    #pragma omp for schedule(dynamic, 16)
+    for (size_t i = 0; i < (size_t) referenceSet.n_cols; ++i)
+    {
+      SearchPoint(referenceSet.col(i), k, searchEf, i, visited, evaluations,
+          neighbors.colptr(i), distances.colptr(i));
+    }
+  }
+
+  distanceEvaluations += evaluations;
+}
+
+template<typename DistanceType, typename MatType>
+double HNSWSearch<DistanceType, MatType>::ComputeRecall(
+    const arma::Mat<size_t>& foundNeighbors,
+    const arma::Mat<size_t>& realNeighbors)
+{
+  if (foundNeighbors.n_rows != realNeighbors.n_rows ||
+      foundNeighbors.n_cols != realNeighbors.n_cols)
+    throw std::invalid_argument("HNSWSearch::ComputeRecall(): matrices "
+        "provided must have equal size");
+
+  const size_t queries = foundNeighbors.n_cols;
+  const size_t neighbors = foundNeighbors.n_rows; // Should be equal to k.
+
+  // The recall is the set intersection of found and real neighbors.
+  size_t found = 0;
+  for (size_t col = 0; col < queries; ++col)
+    for (size_t row = 0; row < neighbors; ++row)
+      for (size_t nei = 0; nei < realNeighbors.n_rows; ++nei)
+        if (realNeighbors(row, col) == foundNeighbors(nei, col))
+        {
+          found++;
+          break;
+        }
+
+  return ((double) found) / realNeighbors.n_elem;
+}
+
+template<typename DistanceType, typename MatType>
+template<typename Archive>
+void HNSWSearch<DistanceType, MatType>::serialize(Archive& ar,
+                                                  const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(referenceSet));
+  ar(CEREAL_NVP(m));
+  ar(CEREAL_NVP(efConstruction));
+  ar(CEREAL_NVP(efSearch));
+  ar(CEREAL_NVP(links));
+  ar(CEREAL_NVP(entryPoint));
+  ar(CEREAL_NVP(maxLevel));
+  ar(CEREAL_NVP(distanceEvaluations));
+  ar(CEREAL_NVP(distance));
+}
+
+template<typename DistanceType, typename MatType>
+size_t HNSWSearch<DistanceType, MatType>::RandomLevel() const
+{
+  // Random() is in [0, 1), so the argument of the logarithm is never 0.
+  const double u = 1.0 - Random();
+  return (size_t) std::floor(-std::log(u) / std::log((double) m));
+}
+
+template<typename DistanceType, typename MatType>
+const std::vector<size_t>& HNSWSearch<DistanceType, MatType>::NodeLinks(
+    const size_t node,
+    const size_t layer,
+    std::mutex* locks,
+    std::vector<size_t>& buffer) const
+{
+  if (!locks)
+    return links[node][layer];
+
+  std::lock_guard<std::mutex> lock(locks[node]);
+  buffer = links[node][layer];
+  return buffer;
+}
+
+template<typename DistanceType, typename MatType>
+void HNSWSearch<DistanceType, MatType>::InsertPoint(const size_t point,
+                                                    VisitedSet& visited,
+                                                    size_t& evaluations,
+                                                    std::mutex* locks,
+                                                    std::mutex* graphLock)
+{
+  size_t node, topLevel;
+  if (graphLock)
+  {
+    std::lock_guard<std::mutex> lock(*graphLock);
+    node = entryPoint;
+    topLevel = maxLevel;
+  }
+  else
+  {
+    node = entryPoint;
+    topLevel = maxLevel;
+  }
+
+  const size_t level = Level(point);
+  const auto query = referenceSet.col(point);
+  ElemType nodeDistance = distance.Evaluate(query, referenceSet.col(node));
+  ++evaluations;
+
+  // Descend greedily through the layers above the level of the new point.
+  for (size_t layer = topLevel; layer > level; --layer)
+    GreedySearch(query, layer, node, nodeDistance, evaluations, locks);
+
+  // Link the point in each of its layers, starting from the highest one that
+  // already exists.
+  std::vector<Candidate> entryPoints(1, Candidate(nodeDistance, node));
+  std::vector<Candidate> candidates, linkCandidates;
+  for (size_t layer = std::min(level, topLevel) + 1; layer-- > 0; )
+  {
+    SearchLayer(query, layer, entryPoints, efConstruction, visited,
+        evaluations, locks, candidates);
+    entryPoints = candidates;
+    SelectNeighbors(candidates, m, evaluations);
+
+    {
+      std::unique_lock<std::mutex> lock;
+      if (locks)
+        lock = std::unique_lock<std::mutex>(locks[point]);
+
+      links[point][layer].resize(candidates.size());
+      for (size_t i = 0; i < candidates.size(); ++i)
+        links[point][layer][i] = candidates[i].second;
+    }
+
+    // Add the reverse links, and prune the links of the neighbors that have
+    // too many.
+    const size_t maxLinks = MaxLinks(layer);
+    for (size_t i = 0; i < candidates.size(); ++i)
+    {
+      const size_t neighbor = candidates[i].second;
+      std::unique_lock<std::mutex> lock;
+      if (locks)
+        lock = std::unique_lock<std::mutex>(locks[neighbor]);
+
+      std::vector<size_t>& neighborLinks = links[neighbor][layer];
+      if (neighborLinks.size() < maxLinks)
+      {
+        neighborLinks.push_back(point);
+        continue;
+      }
+
+      const auto neighborPoint = referenceSet.col(neighbor);
+      linkCandidates.resize(neighborLinks.size() + 1);
+      linkCandidates[0] = Candidate(candidates[i].first, point);
+      for (size_t j = 0; j < neighborLinks.size(); ++j)
+      {
+        linkCandidates[j + 1] = Candidate(distance.Evaluate(neighborPoint,
+            referenceSet.col(neighborLinks[j])), neighborLinks[j]);
+      }
+      evaluations += neighborLinks.size();
+
+      std::sort(linkCandidates.begin(), linkCandidates.end());
+      SelectNeighbors(linkCandidates, maxLinks, evaluations);
+
+      neighborLinks.resize(linkCandidates.size());
+      for (size_t j = 0; j < linkCandidates.size(); ++j)
+        neighborLinks[j] = linkCandidates[j].second;
+    }
+  }
+
+  // The point becomes the entry point if it is the highest one.
+  if (level > topLevel)
+  {
+    std::unique_lock<std::mutex> lock;
+    if (graphLock)
+      lock = std::unique_lock<std::mutex>(*graphLock);
+
+    if (level > maxLevel)
+    {
+      maxLevel = level;
+      entryPoint = point;
+    }
+  }
+}
+
+template<typename DistanceType, typename MatType>
+template<typename VecType>
+void HNSWSearch<DistanceType, MatType>::GreedySearch(const VecType& query,
+                                                     const size_t layer,
+                                                     size_t& node,
+                                                     ElemType& nodeDistance,
+                                                     size_t& evaluations,
+                                                     std::mutex* locks)
+{
+  std::vector<size_t> buffer;
+  bool changed = true;
+  while (changed)
+  {
+    changed = false;
+    const std::vector<size_t>& nodeLinks = NodeLinks(node, layer, locks,
+        buffer);
+    for (size_t i = 0; i < nodeLinks.size(); ++i)
+    {
+      const ElemType d = distance.Evaluate(query,
+          referenceSet.col(nodeLinks[i]));
+      if (d < nodeDistance)
+      {
+        nodeDistance = d;
+        node = nodeLinks[i];
+        changed = true;
+      }
+    }
+    evaluations += nodeLinks.size();
+  }
+}
+
+template<typename DistanceType, typename MatType>
+template<typename VecType>
+void HNSWSearch<DistanceType, MatType>::SearchLayer(
+    const VecType& query,
+    const size_t layer,
+    const std::vector<Candidate>& entryPoints,
+    const size_t ef,
+    VisitedSet& visited,
+    size_t& evaluations,
+    std::mutex* locks,
+    std::vector<Candidate>& results)
+{
+  // The nodes still to expand, nearest first, and the ef best nodes found so
+  // far, furthest first.
+  std::priority_queue<Candidate, std::vector<Candidate>,
+      std::greater<Candidate>> toExpand;
+  std::priority_queue<Candidate> best;
+
+  visited.Clear();
+  for (size_t i = 0; i < entryPoints.size(); ++i)
+  {
+    visited.Insert(entryPoints[i].second);
+    toExpand.push(entryPoints[i]);
+    best.push(entryPoints[i]);
+    if (best.size() > ef)
+      best.pop();
+  }
+
+  std::vector<size_t> buffer;
+  while (!toExpand.empty())
+  {
+    const Candidate c = toExpand.top();
+    if (best.size() >= ef && c.first > best.top().first)
+      break; // Every node left is further than the ef best nodes.
+    toExpand.pop();
+
+    const std::vector<size_t>& nodeLinks = NodeLinks(c.second, layer, locks,
+        buffer);
+    for (size_t i = 0; i < nodeLinks.size(); ++i)
+    {
+      const size_t node = nodeLinks[i];
+      if (!visited.Insert(node))
+        continue;
+
+      const ElemType d = distance.Evaluate(query, referenceSet.col(node));
+      ++evaluations;
+      if (best.size() < ef || d < best.top().first)
+      {
+        toExpand.push(Candidate(d, node));
+        best.push(Candidate(d, node));
+        if (best.size() > ef)
+          best.pop();
+      }
+    }
+  }
+
+  results.resize(best.size());
+  for (size_t i = best.size(); i-- > 0; )
+  {
+    results[i] = best.top();
+    best.pop();
+  }
+}
+
+template<typename DistanceType, typename MatType>
+void HNSWSearch<DistanceType, MatType>::SelectNeighbors(
+    std::vector<Candidate>& candidates,
+    const size_t maxLinks,
+    size_t& evaluations)
+{
+  if (candidates.size() <= maxLinks)
+    return;
+
+  size_t selected = 0;
+  for (size_t i = 0; i < candidates.size() && selected < maxLinks; ++i)
+  {
+    const auto candidatePoint = referenceSet.col(candidates[i].second);
+    bool keep = true;
+    for (size_t j = 0; j < selected; ++j)
+    {
+      ++evaluations;
+      if (distance.Evaluate(candidatePoint,
+          referenceSet.col(candidates[j].second)) < candidates[i].first)
+      {
+        keep = false;
+        break;
+      }
+    }
+
+    if (keep)
+      candidates[selected++] = candidates[i];
+  }
+
+  candidates.resize(selected);
+}
+
+template<typename DistanceType, typename MatType>
+template<typename VecType>
+void HNSWSearch<DistanceType, MatType>::SearchPoint(const VecType& query,
+                                                    const size_t k,
+                                                    const size_t ef,
+                                                    const size_t skip,
+                                                    VisitedSet& visited,
+                                                    size_t& evaluations,
+                                                    size_t* neighbors,
+                                                    ElemType* distances)
+{
+  size_t node = entryPoint;
+  ElemType nodeDistance = distance.Evaluate(query, referenceSet.col(node));
+  ++evaluations;
+
+  for (size_t layer = maxLevel; layer > 0; --layer)
+    GreedySearch(query, layer, node, nodeDistance, evaluations, NULL);
+
+  std::vector<Candidate> entryPoints(1, Candidate(nodeDistance, node));
+  std::vector<Candidate> results;
+  SearchLayer(query, 0, entryPoints, ef, visited, evaluations, NULL, results);
+
+  size_t found = 0;
+  for (size_t i = 0; i < results.size() && found < k; ++i)
+  {
+    if (results[i].second == skip)
+      continue;
+
+    neighbors[found] = results[i].second;
+    distances[found] = results[i].first;
+    ++found;
+  }
+
+  // If the graph is not connected, fewer than k points may have been reached.
+  for (; found < k; ++found)
+  {
+    neighbors[found] = size_t(-1);
+    distances[found] = std::numeric_limits<ElemType>::max();
+  }
+}
+
+} // namespace mlpack
+
+#endif
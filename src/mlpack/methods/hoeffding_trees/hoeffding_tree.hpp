@@ -54,6 +54,16 @@ namespace mlpack {
  * categorical attributes are handled.  As far as the actual splitting goes,
  * the meat of the splitting procedure will be contained in those two classes.
  *
+ * To bound the memory used on long streams, a maximum number of active leaves
+ * can be set with MaxActiveLeaves().  As in the VFDT paper, when the tree has
+ * more leaves than that, the least promising leaves (those with the smallest
+ * number of samples times error rate) are deactivated: their split statistics
+ * are dropped and they only count the classes of the points they see.
+ * Deactivated leaves are reactivated (with empty statistics) when they become
+ * more promising than active leaves.  In this mode, each leaf also drops the
+ * statistics of dimensions whose gain is worse than the best gain by more than
+ * the Hoeffding bound.
+ *
  * @tparam FitnessFunction Fitness function to use.
  * @tparam NumericSplitType Technique for splitting numeric features.
  * @tparam CategoricalSplitType Technique for splitting categorical features.
@@ -359,6 +369,27 @@ class HoeffdingTree
   template<typename VecType>
   void Train(const VecType& point, const size_t label);
 
+  /**
+   * Train on a set of points in streaming mode, a mini-batch of batchSize
+   * points at a time.  The points of each mini-batch are routed to the leaves
+   * of the tree in parallel, and then the statistics of each leaf are updated
+   * in parallel (each leaf and dimension is handled by one thread).  Split
+   * checks are performed once per mini-batch, for every leaf whose number of
+   * samples passed a multiple of CheckInterval() in that mini-batch; so, a
+   * batchSize of 1 gives the same tree as streaming training with Train().
+   *
+   * The tree must already have been initialized with the dimensionality of
+   * the data and the number of classes, and it is not reset.
+   *
+   * @param data Data points to train on.
+   * @param labels Labels of data points.
+   * @param batchSize Number of points in each mini-batch.
+   */
+  template<typename MatType>
+  void TrainMiniBatch(const MatType& data,
+                      const arma::Row<size_t>& labels,
+                      const size_t batchSize = 1024);
+
   /**
    * Check if a split would satisfy the conditions of the Hoeffding bound with
    * the node's specified success probability.  If so, the number of children
@@ -410,6 +441,18 @@ class HoeffdingTree
   //! Get the number of points seen so far.
   size_t NumSamples() const { return numSamples; }
 
+  //! Get the maximum number of active leaves (0 means no limit).
+  size_t MaxActiveLeaves() const { return maxActiveLeaves; }
+  //! Modify the maximum number of active leaves (0 means no limit).  This
+  //! should be called on the root of the tree.
+  void MaxActiveLeaves(const size_t maxActiveLeaves);
+
+  //! Get whether or not this leaf is active (keeps split statistics).
+  bool IsActive() const { return active; }
+
+  //! Get the number of active leaves in the tree.
+  size_t NumActiveLeaves() const;
+
   //! Get the number of classes the tree is trained on.
   size_t NumClasses() const { return numClasses; }
 
@@ -532,6 +575,17 @@ class HoeffdingTree
   bool ownsInfo;
   //! The required probability of success for a split to be performed.
   double successProbability;
+  //! The maximum number of active leaves in the tree (0 means no limit).
+  size_t maxActiveLeaves;
+  //! Whether or not this leaf keeps split statistics.
+  bool active;
+  //! The number of points of each class seen by this leaf.
+  arma::Col<size_t> classCounts;
+  //! The number of samples this leaf had seen when its split statistics were
+  //! started.
+  size_t statisticsStart;
+  //! Whether the statistics of each dimension have been dropped.
+  std::vector<bool> removedDimensions;
 
   // And we need to keep some information for after we have split.
 
@@ -549,6 +603,26 @@ class HoeffdingTree
   //! If the split has occurred, these are the children.
   std::vector<HoeffdingTree*> children;
 
+  /**
+   * Train on a single point, and return true if a leaf reached a multiple of
+   * its check interval, so that the active leaves should be updated.
+   */
+  template<typename VecType>
+  bool TrainPoint(const VecType& point, const size_t label);
+
+  //! Set the majority class and probability from the statistics of the leaf.
+  void UpdateMajorityClass();
+
+  //! Drop the split statistics of this leaf.
+  void Deactivate();
+
+  //! Restart the split statistics of this leaf.
+  void Reactivate();
+
+  //! Deactivate and reactivate leaves so that at most maxActiveLeaves are
+  //! active.  This is only called on the root.
+  void UpdateActiveLeaves();
+
   /**
    * Perform training (typically after a reset, but not necessarily).  This
    * assumes datasetInfo and dimensionMappings are set correctly.
@@ -570,6 +644,12 @@ class HoeffdingTree
 
 } // namespace mlpack
 
+CEREAL_TEMPLATE_CLASS_VERSION((typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType),
+    (mlpack::HoeffdingTree<FitnessFunction, NumericSplitType,
+    CategoricalSplitType>), (1));
+
 #include "hoeffding_tree_impl.hpp"
 
 #endif
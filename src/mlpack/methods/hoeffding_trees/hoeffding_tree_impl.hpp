@@ -36,6 +36,9 @@ HoeffdingTree<
     datasetInfo(new data::DatasetInfo()),
     ownsInfo(true),
     successProbability(0.95),
+    maxActiveLeaves(0),
+    active(true),
+    statisticsStart(0),
     splitDimension(size_t(-1)),
     majorityClass(0),
     majorityProbability(0.0),
@@ -74,6 +77,9 @@ HoeffdingTree<
     datasetInfo(new data::DatasetInfo(dimensionality)),
     ownsInfo(true),
     successProbability(successProbability),
+    maxActiveLeaves(0),
+    active(true),
+    statisticsStart(0),
     splitDimension(size_t(-1)),
     majorityClass(0),
     majorityProbability(0.0),
@@ -93,6 +99,9 @@ HoeffdingTree<
       numericSplits.push_back(NumericSplitType<FitnessFunction>(numClasses,
           numericSplitIn));
     }
+
+    classCounts.zeros(numClasses);
+    removedDimensions.assign(datasetInfo->Dimensionality(), false);
   }
 }
 
@@ -127,6 +136,9 @@ HoeffdingTree<
         &datasetInfo),
     ownsInfo(copyDatasetInfo),
     successProbability(successProbability),
+    maxActiveLeaves(0),
+    active(true),
+    statisticsStart(0),
     splitDimension(size_t(-1)),
     majorityClass(0),
     majorityProbability(0.0),
@@ -153,6 +165,9 @@ HoeffdingTree<
             numericSplitIn));
       }
     }
+
+    classCounts.zeros(numClasses);
+    removedDimensions.assign(datasetInfo.Dimensionality(), false);
   }
 }
 
@@ -185,6 +200,9 @@ HoeffdingTree<
     datasetInfo(new data::DatasetInfo(data.n_rows)),
     ownsInfo(true),
     successProbability(successProbability),
+    maxActiveLeaves(0),
+    active(true),
+    statisticsStart(0),
     splitDimension(size_t(-1)),
     majorityClass(0),
     majorityProbability(0.0),
@@ -228,6 +246,9 @@ HoeffdingTree<
     datasetInfo(new data::DatasetInfo(datasetInfoIn)),
     ownsInfo(true),
     successProbability(successProbability),
+    maxActiveLeaves(0),
+    active(true),
+    statisticsStart(0),
     splitDimension(size_t(-1)),
     majorityClass(0),
     majorityProbability(0.0),
@@ -260,6 +281,11 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>::
     datasetInfo(new data::DatasetInfo(*other.datasetInfo)),
     ownsInfo(true),
     successProbability(other.successProbability),
+    maxActiveLeaves(other.maxActiveLeaves),
+    active(other.active),
+    classCounts(other.classCounts),
+    statisticsStart(other.statisticsStart),
+    removedDimensions(other.removedDimensions),
     splitDimension(other.splitDimension),
     majorityClass(other.majorityClass),
     majorityProbability(other.majorityProbability),
@@ -300,6 +326,11 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>::
     datasetInfo(other.datasetInfo),
     ownsInfo(true),
     successProbability(other.successProbability),
+    maxActiveLeaves(other.maxActiveLeaves),
+    active(other.active),
+    classCounts(std::move(other.classCounts)),
+    statisticsStart(other.statisticsStart),
+    removedDimensions(std::move(other.removedDimensions)),
     splitDimension(other.splitDimension),
     majorityClass(other.majorityClass),
     majorityProbability(other.majorityProbability),
@@ -344,6 +375,11 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>&
     datasetInfo = new data::DatasetInfo(*other.datasetInfo);
     ownsInfo = true;
     successProbability = other.successProbability;
+    maxActiveLeaves = other.maxActiveLeaves;
+    active = other.active;
+    classCounts = other.classCounts;
+    statisticsStart = other.statisticsStart;
+    removedDimensions = other.removedDimensions;
     splitDimension = other.splitDimension;
     majorityClass = other.majorityClass;
     majorityProbability = other.majorityProbability;
@@ -390,6 +426,11 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>&
     datasetInfo = other.datasetInfo;
     ownsInfo = true;
     successProbability = other.successProbability;
+    maxActiveLeaves = other.maxActiveLeaves;
+    active = other.active;
+    classCounts = std::move(other.classCounts);
+    statisticsStart = other.statisticsStart;
+    removedDimensions = std::move(other.removedDimensions);
     splitDimension = other.splitDimension;
     majorityClass = other.majorityClass;
     majorityProbability = other.majorityProbability;
@@ -588,31 +629,53 @@ void HoeffdingTree<
     NumericSplitType,
     CategoricalSplitType
 >::Train(const VecType& point, const size_t label)
+{
+  // Only the root of the tree keeps the number of active leaves in check.
+  if (TrainPoint(point, label) && maxActiveLeaves != 0 && ownsMappings)
+    UpdateActiveLeaves();
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename VecType>
+bool HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::TrainPoint(const VecType& point, const size_t label)
 {
   if (splitDimension == size_t(-1))
   {
     ++numSamples;
+    ++classCounts[label];
+
+    // An inactive leaf only counts the classes of the points it sees.
+    if (!active)
+    {
+      UpdateMajorityClass();
+      return (numSamples % checkInterval == 0);
+    }
+
     size_t numericIndex = 0;
     size_t categoricalIndex = 0;
     for (size_t i = 0; i < point.n_rows; ++i)
     {
       if (datasetInfo->Type(i) == data::Datatype::categorical)
-        categoricalSplits[categoricalIndex++].Train(point[i], label);
+      {
+        if (!removedDimensions[i])
+          categoricalSplits[categoricalIndex].Train(point[i], label);
+        ++categoricalIndex;
+      }
       else if (datasetInfo->Type(i) == data::Datatype::numeric)
-        numericSplits[numericIndex++].Train(point[i], label);
+      {
+        if (!removedDimensions[i])
+          numericSplits[numericIndex].Train(point[i], label);
+        ++numericIndex;
+      }
     }
 
-    // Grab majority class from splits.
-    if (categoricalSplits.size() > 0)
-    {
-      majorityClass = categoricalSplits[0].MajorityClass();
-      majorityProbability = categoricalSplits[0].MajorityProbability();
-    }
-    else
-    {
-      majorityClass = numericSplits[0].MajorityClass();
-      majorityProbability = numericSplits[0].MajorityProbability();
-    }
+    UpdateMajorityClass();
 
     // Check for a split, if we should.
     if (numSamples % checkInterval == 0)
@@ -624,14 +687,162 @@ void HoeffdingTree<
         // Delete children, if we have them.
         children.clear();
         CreateChildren();
+        return true;
       }
     }
+
+    return false;
   }
   else
   {
     // Already split.  Pass the training point to the relevant child.
     size_t direction = CalculateDirection(point);
-    children[direction]->Train(point, label);
+    return children[direction]->TrainPoint(point, label);
+  }
+}
+
+//! Train on mini-batches of points.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::TrainMiniBatch(const MatType& data,
+                  const arma::Row<size_t>& labels,
+                  const size_t batchSize)
+{
+  if (numClasses == 0 || data.n_rows != datasetInfo->Dimensionality())
+  {
+    throw std::invalid_argument("HoeffdingTree::TrainMiniBatch(): tree must "
+        "be initialized with the dimensionality of the data and the number of "
+        "classes!");
+  }
+
+  if (data.n_cols != labels.n_elem)
+  {
+    throw std::invalid_argument("HoeffdingTree::TrainMiniBatch(): number of "
+        "points (" + std::to_string(data.n_cols) + ") does not match number "
+        "of labels (" + std::to_string(labels.n_elem) + ")!");
+  }
+
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("HoeffdingTree::TrainMiniBatch(): batch size "
+        "must be positive!");
+  }
+
+  // The type of each dimension and its index in numericSplits or
+  // categoricalSplits, as in Train() on a single point.
+  std::vector<std::pair<bool, size_t>> splitIndices(data.n_rows);
+  size_t numericIndex = 0;
+  size_t categoricalIndex = 0;
+  for (size_t d = 0; d < data.n_rows; ++d)
+  {
+    if (datasetInfo->Type(d) == data::Datatype::categorical)
+      splitIndices[d] = std::make_pair(true, categoricalIndex++);
+    else
+      splitIndices[d] = std::make_pair(false, numericIndex++);
+  }
+
+  std::vector<HoeffdingTree*> pointLeaves;
+  std::unordered_map<HoeffdingTree*, size_t> leafIndices;
+  std::vector<HoeffdingTree*> leaves;
+  std::vector<std::vector<size_t>> leafPoints;
+  for (size_t begin = 0; begin < data.n_cols; begin += batchSize)
+  {
+    const size_t end = std::min(begin + batchSize, (size_t) data.n_cols);
+
+    // Find the leaf of each point of the mini-batch.  The tree is not modified
+    // here, so this can be done in parallel.
+    pointLeaves.resize(end - begin);
+    #pragma omp parallel for schedule(static)
+    for (size_t i = begin; i < end; ++i)
+    {
+      HoeffdingTree* node = this;
+      while (node->splitDimension != size_t(-1))
+        node = node->children[node->CalculateDirection(data.col(i))];
+      pointLeaves[i - begin] = node;
+    }
+
+    // Collect the points of each leaf, in order.
+    leafIndices.clear();
+    leaves.clear();
+    leafPoints.clear();
+    for (size_t i = begin; i < end; ++i)
+    {
+      HoeffdingTree* leaf = pointLeaves[i - begin];
+      auto it = leafIndices.find(leaf);
+      if (it == leafIndices.end())
+      {
+        it = leafIndices.insert(std::make_pair(leaf, leaves.size())).first;
+        leaves.push_back(leaf);
+        leafPoints.push_back(std::vector<size_t>());
+      }
+      leafPoints[it->second].push_back(i);
+    }
+
+    // Update the statistics of each leaf.  Every split object is updated by
+    // only one thread, so the statistics are the same as if the points had
+    // been seen one at a time.
+    const size_t numWork = leaves.size() * data.n_rows;
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t w = 0; w < numWork; ++w)
+    {
+      HoeffdingTree* leaf = leaves[w / data.n_rows];
+      const std::vector<size_t>& points = leafPoints[w / data.n_rows];
+      const size_t d = w % data.n_rows;
+      if (!leaf->active || leaf->removedDimensions[d])
+        continue;
+
+      if (splitIndices[d].first)
+      {
+        CategoricalSplitType<FitnessFunction>& split =
+            leaf->categoricalSplits[splitIndices[d].second];
+        for (size_t j = 0; j < points.size(); ++j)
+          split.Train(data(d, points[j]), labels[points[j]]);
+      }
+      else
+      {
+        NumericSplitType<FitnessFunction>& split =
+            leaf->numericSplits[splitIndices[d].second];
+        for (size_t j = 0; j < points.size(); ++j)
+          split.Train(data(d, points[j]), labels[points[j]]);
+      }
+    }
+
+    // Now check each leaf for a split, if it has passed a check interval.
+    size_t numUpdates = 0;
+    #pragma omp parallel for schedule(dynamic) reduction(+: numUpdates)
+    for (size_t l = 0; l < leaves.size(); ++l)
+    {
+      HoeffdingTree* leaf = leaves[l];
+      const size_t oldSamples = leaf->numSamples;
+      leaf->numSamples += leafPoints[l].size();
+      for (size_t j = 0; j < leafPoints[l].size(); ++j)
+        ++leaf->classCounts[labels[leafPoints[l][j]]];
+
+      leaf->UpdateMajorityClass();
+      if (leaf->numSamples / leaf->checkInterval ==
+          oldSamples / leaf->checkInterval)
+        continue;
+
+      if (!leaf->active)
+      {
+        ++numUpdates;
+      }
+      else if (leaf->SplitCheck() > 0)
+      {
+        leaf->children.clear();
+        leaf->CreateChildren();
+        ++numUpdates;
+      }
+    }
+
+    if (numUpdates > 0 && maxActiveLeaves != 0 && ownsMappings)
+      UpdateActiveLeaves();
   }
 }
 
@@ -644,12 +855,13 @@ size_t HoeffdingTree<
     CategoricalSplitType
 >::SplitCheck()
 {
-  // Do nothing if we've already split.
-  if (splitDimension != size_t(-1))
+  // Do nothing if we've already split, or if we have no statistics.
+  if (splitDimension != size_t(-1) || !active)
     return 0;
 
   // If not enough points have been seen, we cannot split.
-  if (numSamples <= minSamples)
+  const size_t statisticsSamples = numSamples - statisticsStart;
+  if (statisticsSamples <= minSamples)
     return 0;
 
   // Check the fitness of each dimension.  Then we'll use a Hoeffding bound
@@ -658,14 +870,20 @@ size_t HoeffdingTree<
   // Calculate epsilon, the value we need things to be greater than.
   const double rSquared = std::pow(FitnessFunction::Range(numClasses), 2.0);
   const double epsilon = std::sqrt(rSquared *
-      std::log(1.0 / (1.0 - successProbability)) / (2 * numSamples));
+      std::log(1.0 / (1.0 - successProbability)) / (2 * statisticsSamples));
 
   // Find the best and second best possible splits.
   double largest = -DBL_MAX;
   size_t largestIndex = 0;
   double secondLargest = -DBL_MAX;
-  for (size_t i = 0; i < categoricalSplits.size() + numericSplits.size(); ++i)
+  const size_t numDimensions = categoricalSplits.size() + numericSplits.size();
+  arma::vec gains(numDimensions, arma::fill::zeros);
+  for (size_t i = 0; i < numDimensions; ++i)
   {
+    // Skip dimensions whose statistics have been dropped.
+    if (removedDimensions[i])
+      continue;
+
     size_t type = dimensionMappings->at(i).first;
     size_t index = dimensionMappings->at(i).second;
 
@@ -678,6 +896,7 @@ size_t HoeffdingTree<
           secondBestGain);
     else if (type == data::Datatype::numeric)
       numericSplits[index].EvaluateFitnessFunction(bestGain, secondBestGain);
+    gains[i] = bestGain;
 
     // See if these gains are better than the previous.
     if (bestGain > largest)
@@ -699,8 +918,8 @@ size_t HoeffdingTree<
 
   // Are these far enough apart to split?
   if ((largest > 0.0) &&
-      ((largest - secondLargest > epsilon) || (numSamples > maxSamples) ||
-       (epsilon <= 0.05)))
+      ((largest - secondLargest > epsilon) ||
+       (statisticsSamples > maxSamples) || (epsilon <= 0.05)))
   {
     // Split!
     splitDimension = largestIndex;
@@ -720,6 +939,31 @@ size_t HoeffdingTree<
   }
   else
   {
+    // When the memory is bounded, drop the statistics of dimensions that are
+    // worse than the best dimension by more than the Hoeffding bound, since
+    // they are very unlikely to ever be chosen.
+    if (maxActiveLeaves != 0 && largest > 0.0)
+    {
+      for (size_t i = 0; i < numDimensions; ++i)
+      {
+        if (removedDimensions[i] || largest - gains[i] <= epsilon)
+          continue;
+
+        const size_t index = dimensionMappings->at(i).second;
+        if (dimensionMappings->at(i).first == data::Datatype::categorical)
+        {
+          categoricalSplits[index] = CategoricalSplitType<FitnessFunction>(0,
+              0, categoricalSplits[index]);
+        }
+        else
+        {
+          numericSplits[index] = NumericSplitType<FitnessFunction>(0,
+              numericSplits[index]);
+        }
+        removedDimensions[i] = true;
+      }
+    }
+
     return 0; // Don't split.
   }
 }
@@ -982,11 +1226,204 @@ void HoeffdingTree<
     }
 
     children[i]->MajorityClass() = childMajorities[i];
+    children[i]->maxActiveLeaves = maxActiveLeaves;
   }
 
   // Eliminate now-unnecessary split information.
   numericSplits.clear();
   categoricalSplits.clear();
+  classCounts.clear();
+  removedDimensions.clear();
+}
+
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::MaxActiveLeaves(const size_t maxActiveLeaves)
+{
+  this->maxActiveLeaves = maxActiveLeaves;
+  for (size_t i = 0; i < children.size(); ++i)
+    children[i]->MaxActiveLeaves(maxActiveLeaves);
+
+  // Apply the new limit right away.
+  if (ownsMappings)
+    UpdateActiveLeaves();
+}
+
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+size_t HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::NumActiveLeaves() const
+{
+  if (splitDimension == size_t(-1))
+    return active ? 1 : 0;
+
+  size_t numActiveLeaves = 0;
+  for (size_t i = 0; i < children.size(); ++i)
+    numActiveLeaves += children[i]->NumActiveLeaves();
+
+  return numActiveLeaves;
+}
+
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::UpdateMajorityClass()
+{
+  // The split statistics only hold all the points of the leaf if it has never
+  // been deactivated and no dimension has been dropped; otherwise, use the
+  // class counts.
+  const bool useSplits = active && statisticsStart == 0 &&
+      std::find(removedDimensions.begin(), removedDimensions.end(), true) ==
+      removedDimensions.end();
+  if (useSplits && categoricalSplits.size() > 0)
+  {
+    majorityClass = categoricalSplits[0].MajorityClass();
+    majorityProbability = categoricalSplits[0].MajorityProbability();
+  }
+  else if (useSplits)
+  {
+    majorityClass = numericSplits[0].MajorityClass();
+    majorityProbability = numericSplits[0].MajorityProbability();
+  }
+  else if (numSamples > 0)
+  {
+    majorityClass = classCounts.index_max();
+    majorityProbability = double(classCounts[majorityClass]) /
+        double(numSamples);
+  }
+}
+
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::Deactivate()
+{
+  // Keep the parameters of each split, but none of its statistics.
+  for (size_t i = 0; i < categoricalSplits.size(); ++i)
+  {
+    categoricalSplits[i] = CategoricalSplitType<FitnessFunction>(0, 0,
+        categoricalSplits[i]);
+  }
+  for (size_t i = 0; i < numericSplits.size(); ++i)
+    numericSplits[i] = NumericSplitType<FitnessFunction>(0, numericSplits[i]);
+
+  active = false;
+}
+
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::Reactivate()
+{
+  for (size_t i = 0; i < removedDimensions.size(); ++i)
+  {
+    const size_t index = dimensionMappings->at(i).second;
+    if (dimensionMappings->at(i).first == data::Datatype::categorical)
+    {
+      categoricalSplits[index] = CategoricalSplitType<FitnessFunction>(
+          datasetInfo->NumMappings(i), numClasses, categoricalSplits[index]);
+    }
+    else
+    {
+      numericSplits[index] = NumericSplitType<FitnessFunction>(numClasses,
+          numericSplits[index]);
+    }
+    removedDimensions[i] = false;
+  }
+
+  // The new statistics start from here.
+  statisticsStart = numSamples;
+  active = true;
+}
+
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::UpdateActiveLeaves()
+{
+  // Collect all the leaves of the tree.
+  std::vector<HoeffdingTree*> leaves;
+  std::vector<HoeffdingTree*> stack(1, this);
+  while (!stack.empty())
+  {
+    HoeffdingTree* node = stack.back();
+    stack.pop_back();
+    if (node->splitDimension == size_t(-1))
+      leaves.push_back(node);
+    for (size_t i = 0; i < node->children.size(); ++i)
+      stack.push_back(node->children[i]);
+  }
+
+  if (maxActiveLeaves == 0 || leaves.size() <= maxActiveLeaves)
+  {
+    for (size_t i = 0; i < leaves.size(); ++i)
+      if (!leaves[i]->active)
+        leaves[i]->Reactivate();
+    return;
+  }
+
+  // Rank the leaves by how promising they are: the number of points they have
+  // seen times their error rate, since that is the most a split of the leaf
+  // can improve the accuracy of the tree.
+  std::vector<std::pair<double, size_t>> promise(leaves.size());
+  for (size_t i = 0; i < leaves.size(); ++i)
+  {
+    promise[i] = std::make_pair(leaves[i]->numSamples *
+        (1.0 - leaves[i]->majorityProbability), i);
+  }
+  std::sort(promise.begin(), promise.end(),
+      [](const std::pair<double, size_t>& a,
+         const std::pair<double, size_t>& b)
+      {
+        return (a.first > b.first) ||
+            (a.first == b.first && a.second < b.second);
+      });
+
+  for (size_t i = 0; i < leaves.size(); ++i)
+  {
+    HoeffdingTree* leaf = leaves[promise[i].second];
+    if (i < maxActiveLeaves && !leaf->active)
+      leaf->Reactivate();
+    else if (i >= maxActiveLeaves && leaf->active)
+      leaf->Deactivate();
+  }
 }
 
 template<
@@ -1055,10 +1492,16 @@ void HoeffdingTree<
     FitnessFunction,
     NumericSplitType,
     CategoricalSplitType
->::serialize(Archive& ar, const uint32_t /* version */)
+>::serialize(Archive& ar, const uint32_t version)
 {
   ar(CEREAL_NVP(splitDimension));
 
+  // Older versions did not bound the number of active leaves.
+  if (version > 0)
+    ar(CEREAL_NVP(maxActiveLeaves));
+  else if (cereal::is_loading<Archive>())
+    maxActiveLeaves = 0;
+
   // Clear memory for the mappings if necessary.
   if (cereal::is_loading<Archive>() && ownsMappings && dimensionMappings)
     delete dimensionMappings;
@@ -1099,6 +1542,28 @@ void HoeffdingTree<
     ar(CEREAL_NVP(maxSamples));
     ar(CEREAL_NVP(successProbability));
 
+    if (version > 0)
+    {
+      ar(CEREAL_NVP(active));
+      ar(CEREAL_NVP(classCounts));
+      ar(CEREAL_NVP(statisticsStart));
+      ar(CEREAL_NVP(removedDimensions));
+    }
+    else if (cereal::is_loading<Archive>())
+    {
+      // Older versions did not count the classes of each leaf, so we can only
+      // count the points of the majority class.
+      active = true;
+      classCounts.zeros(numClasses);
+      if (numClasses > 0)
+      {
+        classCounts[majorityClass] = (size_t) std::round(majorityProbability *
+            numSamples);
+      }
+      statisticsStart = 0;
+      removedDimensions.assign(datasetInfo->Dimensionality(), false);
+    }
+
     // Serialize the splits, but not if we haven't seen any samples yet (in
     // which case we can just reinitialize).
     if (cereal::is_loading<Archive>())
@@ -1157,6 +1622,9 @@ void HoeffdingTree<
 
       numericSplits.clear();
       categoricalSplits.clear();
+      classCounts.clear();
+      removedDimensions.clear();
+      active = true;
 
       numSamples = 0;
       numClasses = 0;
@@ -1247,6 +1715,9 @@ void HoeffdingTree<
         children[i]->Train(childData, childLabels, numClasses, true);
       }
     }
+
+    if (maxActiveLeaves != 0 && ownsMappings)
+      UpdateActiveLeaves();
   }
   else
   {
@@ -1303,6 +1774,10 @@ void HoeffdingTree<
 
   // Reset statistics.
   numSamples = 0;
+  active = true;
+  classCounts.zeros(numClasses);
+  statisticsStart = 0;
+  removedDimensions.assign(datasetInfo->Dimensionality(), false);
   splitDimension = size_t(-1);
   majorityClass = 0;
   majorityProbability = 0.0;
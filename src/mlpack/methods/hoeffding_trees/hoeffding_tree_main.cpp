@@ -51,11 +51,28 @@ BINDING_LONG_DESC(
     PRINT_PARAM_STRING("labels") + " is not specified, the labels are assumed "
     "to be the last dimension of the training dataset."
     "\n\n"
+    "Alternately, a large training set may be streamed from a file (CSV, "
+    "ASCII or binary) given with the " +
+    PRINT_PARAM_STRING("training_file") + " parameter instead of being "
+    "loaded at once: the file is read and trained on " +
+    PRINT_PARAM_STRING("chunk_size") + " points at a time, so memory usage "
+    "does not depend on the size of the file.  In this case the labels must "
+    "be the last dimension of the file, and the types of the dimensions, the "
+    "categories, and the number of classes are taken from the first chunk; "
+    "later points with unknown categories or classes are skipped."
+    "\n\n"
     "The training may be performed in batch mode "
     "(like a typical decision tree algorithm) by specifying the " +
     PRINT_PARAM_STRING("batch_mode") + " option, but this may not be the best "
     "option for large datasets."
     "\n\n"
+    "To bound the memory used when training on long streams, the " +
+    PRINT_PARAM_STRING("max_active_leaves") + " parameter may be set: only "
+    "that many of the most promising leaves keep split statistics, and the "
+    "other leaves only keep their majority class until they become more "
+    "promising.  Statistics of dimensions that are clearly worse than the best "
+    "one are also dropped."
+    "\n\n"
     "When a model is trained, it may be saved via the " +
     PRINT_PARAM_STRING("output_model") + " output parameter.  A model may be "
     "loaded from file for further training or testing with the " +
@@ -97,6 +114,11 @@ BINDING_SEE_ALSO("HoeffdingTree class documentation",
 PARAM_MATRIX_AND_INFO_IN("training", "Training dataset (may be categorical).",
     "t");
 PARAM_UROW_IN("labels", "Labels for training dataset.", "l");
+PARAM_STRING_IN("training_file", "File of training data (CSV files may be "
+    "categorical; labels are in the last dimension) to stream in chunks "
+    "instead of loading it at once.", "S", "");
+PARAM_INT_IN("chunk_size", "Number of points read at a time from the "
+    "training file when streaming.", "C", 10000);
 
 PARAM_DOUBLE_IN("confidence", "Confidence before splitting (between 0 and 1).",
     "c", 0.95);
@@ -131,6 +153,8 @@ PARAM_INT_IN("bins", "If the 'domingos' split strategy is used, this specifies "
 PARAM_INT_IN("observations_before_binning", "If the 'domingos' split strategy "
     "is used, this specifies the number of samples observed before binning is "
     "performed.", "o", 100);
+PARAM_INT_IN("max_active_leaves", "Maximum number of leaves that keep split "
+    "statistics, to bound memory usage (0 means no limit).", "A", 0);
 
 // Convenience typedef.
 typedef tuple<DatasetInfo, arma::mat> TupleType;
@@ -141,7 +165,9 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   const string numericSplitStrategy =
       params.Get<string>("numeric_split_strategy");
 
-  RequireAtLeastOnePassed(params, { "training", "input_model" }, true);
+  RequireAtLeastOnePassed(params, { "training", "training_file",
+      "input_model" }, true);
+  RequireOnlyOnePassed(params, { "training", "training_file" }, true, "", true);
 
   RequireAtLeastOnePassed(params, { "output_model", "predictions",
       "probabilities", "test_labels" }, false, "no output will be given");
@@ -150,7 +176,10 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   ReportIgnoredParam(params, {{ "test", false }}, "predictions");
 
   ReportIgnoredParam(params, {{ "training", false }}, "batch_mode");
-  ReportIgnoredParam(params, {{ "training", false }}, "passes");
+  ReportIgnoredParam(params, {{ "training", false },
+      { "training_file", false }}, "passes");
+  ReportIgnoredParam(params, {{ "training", false }}, "labels");
+  ReportIgnoredParam(params, {{ "training_file", false }}, "chunk_size");
 
   if (params.Has("test"))
   {
@@ -160,6 +189,14 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 
   RequireParamInSet<string>(params, "numeric_split_strategy", { "domingos",
       "binary" }, true, "unrecognized numeric split strategy");
+  RequireParamValue<int>(params, "max_active_leaves",
+      [](int x) { return x >= 0; }, true, "maximum number of active leaves "
+      "must not be negative");
+  if (params.Has("training_file"))
+  {
+    RequireParamValue<int>(params, "chunk_size", [](int x) { return x > 0; },
+        true, "chunk size must be positive");
+  }
 
   // Do we need to load a model or do we already have one?
   HoeffdingTreeModel* model;
@@ -194,6 +231,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     const size_t bins = (size_t) params.Get<int>("bins");
     const size_t observationsBeforeBinning = (size_t)
         params.Get<int>("observations_before_binning");
+    const size_t maxActiveLeaves = (size_t)
+        params.Get<int>("max_active_leaves");
     size_t passes = (size_t) params.Get<int>("passes");
     if (passes > 1)
       batchTraining = false; // We already warned about this earlier.
@@ -231,9 +270,13 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
       // Build the model.
       model->BuildModel(trainingSet, datasetInfo, labels,
           max(labels) + 1, batchTraining, confidence, maxSamples,
-          100, minSamples, bins, observationsBeforeBinning);
+          100, minSamples, bins, observationsBeforeBinning, maxActiveLeaves);
       --passes; // This model-building takes one pass.
     }
+    else if (params.Has("max_active_leaves"))
+    {
+      model->MaxActiveLeaves(maxActiveLeaves);
+    }
 
     // Now pass over the trees as many times as we need to.
     if (batchTraining)
@@ -251,6 +294,123 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 
     timers.Stop("tree_training");
   }
+  else if (params.Has("training_file"))
+  {
+    const double confidence = params.Get<double>("confidence");
+    const size_t maxSamples = (size_t) params.Get<int>("max_samples");
+    const size_t minSamples = (size_t) params.Get<int>("min_samples");
+    const size_t bins = (size_t) params.Get<int>("bins");
+    const size_t observationsBeforeBinning = (size_t)
+        params.Get<int>("observations_before_binning");
+    const size_t maxActiveLeaves = (size_t)
+        params.Get<int>("max_active_leaves");
+    const size_t passes = (size_t) params.Get<int>("passes");
+    const size_t chunkSize = (size_t) params.Get<int>("chunk_size");
+
+    // Only one chunk of the file is held in memory at a time.  Each chunk of
+    // the last pass is classified before the tree is trained on it, which
+    // gives an estimate of the accuracy of the tree on unseen points.
+    ChunkedReader<> reader(params.Get<string>("training_file"));
+    arma::mat chunk;
+    arma::Row<size_t> chunkLabels;
+    size_t numClasses = params.Has("input_model") ? model->NumClasses() : 0;
+    size_t skippedPoints = 0, correct = 0, total = 0;
+
+    timers.Start("tree_training");
+    for (size_t p = 0; p < passes; ++p)
+    {
+      if (p > 0)
+        reader.Reset();
+
+      while (reader.Read(chunk, chunkSize) > 0)
+      {
+        chunkLabels = ConvTo<arma::Row<size_t>>::From(
+            chunk.row(chunk.n_rows - 1));
+        chunk.shed_row(chunk.n_rows - 1);
+
+        if (datasetInfo.Dimensionality() == 0)
+        {
+          // The last dimension of the file holds the labels, so the tree gets
+          // the DatasetInfo of the other dimensions.
+          const DatasetInfo& fileInfo = reader.Info();
+          datasetInfo = DatasetInfo(chunk.n_rows);
+          for (size_t d = 0; d < chunk.n_rows; ++d)
+          {
+            if (fileInfo.Type(d) == Datatype::numeric)
+              continue;
+
+            datasetInfo.Type(d) = Datatype::categorical;
+            for (size_t v = 0; v < fileInfo.NumMappings(d); ++v)
+              datasetInfo.MapString<double>(fileInfo.UnmapString(v, d), d);
+          }
+
+          for (size_t i = 0; i < chunk.n_rows; ++i)
+            Log::Info << datasetInfo.NumMappings(i) << " mappings in dimension "
+                << i << "." << endl;
+
+          if (!params.Has("input_model"))
+          {
+            numClasses = max(chunkLabels) + 1;
+            model->BuildModel(chunk, datasetInfo, chunkLabels, numClasses,
+                false, confidence, maxSamples, 100, minSamples, bins,
+                observationsBeforeBinning, maxActiveLeaves);
+            continue;
+          }
+          else if (params.Has("max_active_leaves"))
+          {
+            model->MaxActiveLeaves(maxActiveLeaves);
+          }
+        }
+
+        // Points of classes that were not in the first chunk cannot be
+        // trained on.
+        const arma::uvec known = arma::find(chunkLabels < numClasses);
+        if (known.n_elem < chunkLabels.n_elem)
+        {
+          skippedPoints += chunkLabels.n_elem - known.n_elem;
+          chunk = chunk.cols(known);
+          chunkLabels = chunkLabels.cols(known);
+          if (chunk.n_cols == 0)
+            continue;
+        }
+
+        if (p == passes - 1)
+        {
+          arma::Row<size_t> predictions;
+          model->Classify(chunk, predictions);
+          correct += arma::accu(predictions == chunkLabels);
+          total += chunkLabels.n_elem;
+        }
+
+        model->Train(chunk, chunkLabels, false);
+      }
+    }
+    timers.Stop("tree_training");
+
+    // Free the last chunk.
+    chunk.reset();
+
+    if (datasetInfo.Dimensionality() == 0)
+    {
+      throw std::invalid_argument("hoeffding_tree: no points in training file "
+          "'" + params.Get<string>("training_file") + "'!");
+    }
+
+    skippedPoints += reader.SkippedLines();
+    if (skippedPoints > 0)
+    {
+      Log::Warn << skippedPoints << " points of the training file were skipped "
+          << "because their categories or classes were not in the first chunk "
+          << "or they could not be parsed." << endl;
+    }
+
+    if (total > 0)
+    {
+      Log::Info << correct << " out of " << total << " correct on training "
+          << "points classified before training on them (" << double(correct) /
+          double(total) * 100.0 << ")." << endl;
+    }
+  }
 
   // Do we need to evaluate the training set error?
   if (params.Has("training"))
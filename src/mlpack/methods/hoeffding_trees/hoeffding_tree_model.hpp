@@ -110,6 +110,8 @@ class HoeffdingTreeModel
    * @param bins Number of bins, for Hoeffding numeric split.
    * @param observationsBeforeBinning Number of observations before binning, for
    *      Hoeffding numeric split.
+   * @param maxActiveLeaves Maximum number of leaves that keep split statistics
+   *      (0 means no limit).
    */
   void BuildModel(const arma::mat& dataset,
                   const data::DatasetInfo& datasetInfo,
@@ -121,7 +123,8 @@ class HoeffdingTreeModel
                   const size_t checkInterval,
                   const size_t minSamples,
                   const size_t bins,
-                  const size_t observationsBeforeBinning);
+                  const size_t observationsBeforeBinning,
+                  const size_t maxActiveLeaves = 0);
 
   /**
    * Train in streaming mode on the given dataset.  This takes one pass.  Be
@@ -162,6 +165,19 @@ class HoeffdingTreeModel
    */
   size_t NumNodes() const;
 
+  /**
+   * Get the number of classes the tree was built for.
+   */
+  size_t NumClasses() const;
+
+  /**
+   * Set the maximum number of leaves of the tree that keep split statistics (0
+   * means no limit).  Be sure that BuildModel() has been called first!
+   *
+   * @param maxActiveLeaves Maximum number of active leaves.
+   */
+  void MaxActiveLeaves(const size_t maxActiveLeaves);
+
   /**
    * Serialize the model.
    */
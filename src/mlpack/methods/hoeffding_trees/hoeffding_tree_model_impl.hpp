@@ -138,7 +138,8 @@ inline void HoeffdingTreeModel::BuildModel(
     const size_t checkInterval,
     const size_t minSamples,
     const size_t bins,
-    const size_t observationsBeforeBinning)
+    const size_t observationsBeforeBinning,
+    const size_t maxActiveLeaves)
 {
   // Clean memory, if needed.
   delete giniHoeffdingTree;
@@ -146,7 +147,8 @@ inline void HoeffdingTreeModel::BuildModel(
   delete infoHoeffdingTree;
   delete infoBinaryTree;
 
-  // Depending on the type, create the tree.
+  // Depending on the type, create the tree, and then train it (so that the
+  // limit on the number of active leaves applies during the first pass).
   switch (type)
   {
     case GINI_HOEFFDING:
@@ -155,17 +157,19 @@ inline void HoeffdingTreeModel::BuildModel(
         HoeffdingDoubleNumericSplit<GiniImpurity> ns(0, bins,
             observationsBeforeBinning);
 
-        giniHoeffdingTree = new GiniHoeffdingTreeType(dataset, datasetInfo,
-            labels, numClasses, batchTraining, successProbability, maxSamples,
-            checkInterval, minSamples,
+        giniHoeffdingTree = new GiniHoeffdingTreeType(datasetInfo, numClasses,
+            successProbability, maxSamples, checkInterval, minSamples,
             HoeffdingCategoricalSplit<GiniImpurity>(0, 0), ns);
+        giniHoeffdingTree->MaxActiveLeaves(maxActiveLeaves);
+        giniHoeffdingTree->Train(dataset, labels, numClasses, batchTraining);
       }
       break;
 
     case GINI_BINARY:
-      giniBinaryTree = new GiniBinaryTreeType(dataset, datasetInfo, labels,
-          numClasses, batchTraining, successProbability, maxSamples,
-          checkInterval, minSamples);
+      giniBinaryTree = new GiniBinaryTreeType(datasetInfo, numClasses,
+          successProbability, maxSamples, checkInterval, minSamples);
+      giniBinaryTree->MaxActiveLeaves(maxActiveLeaves);
+      giniBinaryTree->Train(dataset, labels, numClasses, batchTraining);
       break;
 
     case INFO_HOEFFDING:
@@ -174,17 +178,19 @@ inline void HoeffdingTreeModel::BuildModel(
         HoeffdingDoubleNumericSplit<HoeffdingInformationGain> ns(0, bins,
             observationsBeforeBinning);
 
-        infoHoeffdingTree = new InfoHoeffdingTreeType(dataset, datasetInfo,
-            labels, numClasses, batchTraining, successProbability, maxSamples,
-            checkInterval, minSamples,
+        infoHoeffdingTree = new InfoHoeffdingTreeType(datasetInfo, numClasses,
+            successProbability, maxSamples, checkInterval, minSamples,
             HoeffdingCategoricalSplit<HoeffdingInformationGain>(0, 0), ns);
+        infoHoeffdingTree->MaxActiveLeaves(maxActiveLeaves);
+        infoHoeffdingTree->Train(dataset, labels, numClasses, batchTraining);
       }
       break;
 
     case INFO_BINARY:
-      infoBinaryTree = new InfoBinaryTreeType(dataset, datasetInfo, labels,
-          numClasses, batchTraining, successProbability, maxSamples,
-          checkInterval, minSamples);
+      infoBinaryTree = new InfoBinaryTreeType(datasetInfo, numClasses,
+          successProbability, maxSamples, checkInterval, minSamples);
+      infoBinaryTree->MaxActiveLeaves(maxActiveLeaves);
+      infoBinaryTree->Train(dataset, labels, numClasses, batchTraining);
       break;
   }
 }
@@ -311,6 +317,46 @@ inline size_t HoeffdingTreeModel::NumNodes() const
   return 0; // This should never happen!
 }
 
+inline size_t HoeffdingTreeModel::NumClasses() const
+{
+  switch (type)
+  {
+    case GINI_HOEFFDING:
+      return giniHoeffdingTree->NumClasses();
+    case GINI_BINARY:
+      return giniBinaryTree->NumClasses();
+    case INFO_HOEFFDING:
+      return infoHoeffdingTree->NumClasses();
+    case INFO_BINARY:
+      return infoBinaryTree->NumClasses();
+  }
+
+  return 0; // This should never happen!
+}
+
+// Set the maximum number of active leaves.
+inline void HoeffdingTreeModel::MaxActiveLeaves(const size_t maxActiveLeaves)
+{
+  switch (type)
+  {
+    case GINI_HOEFFDING:
+      giniHoeffdingTree->MaxActiveLeaves(maxActiveLeaves);
+      break;
+
+    case GINI_BINARY:
+      giniBinaryTree->MaxActiveLeaves(maxActiveLeaves);
+      break;
+
+    case INFO_HOEFFDING:
+      infoHoeffdingTree->MaxActiveLeaves(maxActiveLeaves);
+      break;
+
+    case INFO_BINARY:
+      infoBinaryTree->MaxActiveLeaves(maxActiveLeaves);
+      break;
+  }
+}
+
 } // namespace mlpack
 
 #endif
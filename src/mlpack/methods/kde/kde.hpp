@@ -53,6 +53,9 @@ struct KDEDefaultParams
 
   //! Monte Carlo break coefficient.
   static constexpr double mcBreakCoef = 0.4;
+
+  //! Maximum number of added reference points held outside of the tree.
+  static constexpr size_t maxBufferSize = 10000;
 };
 
 /**
@@ -62,6 +65,12 @@ struct KDEDefaultParams
  * This implementation performs this estimation using a tree-independent
  * dual-tree algorithm. Details about this algorithm are available in KDERules.
  *
+ * Reference points can be added to a trained model with AddReferences()
+ * without rebuilding the tree each time: they are kept in a buffer whose
+ * contribution to every estimation is computed exactly, and the tree is
+ * rebuilt with all the reference points once the buffer holds more than
+ * MaxBufferSize() points.
+ *
  * @tparam KernelType Kernel function to use for KDE calculations.
  * @tparam DistanceType Metric to use for KDE calculations.
  * @tparam MatType Type of data to use.
@@ -221,6 +230,19 @@ class KDE
    */
   void Evaluate(arma::vec& estimations);
 
+  /**
+   * Add the given points to the reference set.  They are held in a buffer,
+   * which is evaluated exactly alongside the reference tree; once the buffer
+   * holds more than MaxBufferSize() points, the reference tree is rebuilt with
+   * all the reference points (and owned by this object, even if the previous
+   * one was given to Train()).  In monochromatic evaluation, the added points
+   * come after the original reference points, in the order they were added.
+   *
+   * @pre The model has to be previously trained.
+   * @param newReferences Points to add to the reference set.
+   */
+  void AddReferences(const MatType& newReferences);
+
   //! Get the kernel.
   const KernelType& Kernel() const { return kernel; }
 
@@ -242,6 +264,23 @@ class KDE
   //! Get the reference tree.
   Tree* ReferenceTree() { return referenceTree; }
 
+  //! Get the added reference points that are not in the reference tree yet.
+  const MatType& ReferenceBuffer() const { return referenceBuffer; }
+
+  //! Get the total number of reference points.
+  size_t NumReferences() const
+  {
+    return (referenceTree ? referenceTree->Dataset().n_cols : 0) +
+        referenceBuffer.n_cols;
+  }
+
+  //! Get the maximum number of added reference points held outside of the
+  //! reference tree.
+  size_t MaxBufferSize() const { return maxBufferSize; }
+  //! Modify the maximum number of added reference points held outside of the
+  //! reference tree.
+  size_t& MaxBufferSize() { return maxBufferSize; }
+
   //! Get relative error tolerance.
   double RelativeError() const { return relError; }
 
@@ -260,6 +299,13 @@ class KDE
   //! Check whether KDE model is trained or not.
   bool IsTrained() const { return trained; }
 
+  //! Get the number of base cases (kernel evaluations between a query and a
+  //! reference point) of the last evaluation.
+  size_t BaseCases() const { return baseCases; }
+
+  //! Get the number of node combinations scored during the last evaluation.
+  size_t Scores() const { return scores; }
+
   //! Get the mode of KDE.
   KDEMode Mode() const { return mode; }
 
@@ -348,9 +394,55 @@ class KDE
   //! is the limit before Monte Carlo estimation recurses.
   double mcBreakCoef;
 
+  //! Added reference points that are not in the reference tree yet.
+  MatType referenceBuffer;
+
+  //! Maximum number of reference points held in the buffer.
+  size_t maxBufferSize;
+
+  //! The number of base cases of the last evaluation.
+  size_t baseCases;
+
+  //! The number of node combinations scored during the last evaluation.
+  size_t scores;
+
   //! Check whether absolute and relative error values are compatible.
   static void CheckErrorValues(const double relError, const double absError);
 
+  //! Rebuild the reference tree with the points of the tree and the buffer,
+  //! and empty the buffer.
+  void RebuildReferenceTree();
+
+  /**
+   * Add the sum of the kernel values between each query point and the points
+   * of the reference buffer to the given estimations.
+   *
+   * @param querySet Query points.
+   * @param estimations Estimations of the query points.
+   * @param sameSet Whether the query points are the points of the buffer (so
+   *     that a point is not evaluated with itself).
+   */
+  void AddBufferEstimations(const MatType& querySet,
+                            arma::vec& estimations,
+                            const bool sameSet);
+
+  /**
+   * Run a single-tree traversal of the reference tree for each of the given
+   * number of query points, splitting the query points between threads.  The
+   * counters of the rules are updated with the ones of every thread.
+   */
+  template<typename RuleType>
+  void SingleTreeEvaluate(RuleType& rules, const size_t numQueries);
+
+  /**
+   * Run a dual-tree traversal of the given query tree against the reference
+   * tree, splitting the query tree into disjoint subtrees that are traversed
+   * by different threads.  The counters of the rules are updated with the
+   * ones of every thread.
+   */
+  template<typename RuleType>
+  void DualTreeEvaluate(RuleType& rules, Tree& queryTree);
+
   //! Rearrange estimations vector if required.
   static void RearrangeEstimations(const std::vector<size_t>& oldFromNew,
                                    arma::vec& estimations);
@@ -358,6 +450,14 @@ class KDE
 
 } // namespace mlpack
 
+CEREAL_TEMPLATE_CLASS_VERSION((typename KernelType, typename DistanceType,
+    typename MatType, template<typename TreeDistanceType,
+    typename TreeStatType, typename TreeMatType> class TreeType,
+    template<typename> class DualTreeTraversalType,
+    template<typename> class SingleTreeTraversalType),
+    (mlpack::KDE<KernelType, DistanceType, MatType, TreeType,
+    DualTreeTraversalType, SingleTreeTraversalType>), (1));
+
 // Include implementation.
 #include "kde_impl.hpp"
 
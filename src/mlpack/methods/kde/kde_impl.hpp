@@ -49,7 +49,10 @@ KDE(const double relError,
     trained(false),
     mode(mode),
     monteCarlo(monteCarlo),
-    initialSampleSize(initialSampleSize)
+    initialSampleSize(initialSampleSize),
+    maxBufferSize(KDEDefaultParams::maxBufferSize),
+    baseCases(0),
+    scores(0)
 {
   CheckErrorValues(relError, absError);
   MCProb(mcProb);
@@ -83,7 +86,11 @@ KDE(const KDE& other) :
     mcProb(other.mcProb),
     initialSampleSize(other.initialSampleSize),
     mcEntryCoef(other.mcEntryCoef),
-    mcBreakCoef(other.mcBreakCoef)
+    mcBreakCoef(other.mcBreakCoef),
+    referenceBuffer(other.referenceBuffer),
+    maxBufferSize(other.maxBufferSize),
+    baseCases(other.baseCases),
+    scores(other.scores)
 {
   if (trained)
   {
@@ -129,7 +136,11 @@ KDE(KDE&& other) :
     mcProb(other.mcProb),
     initialSampleSize(other.initialSampleSize),
     mcEntryCoef(other.mcEntryCoef),
-    mcBreakCoef(other.mcBreakCoef)
+    mcBreakCoef(other.mcBreakCoef),
+    referenceBuffer(std::move(other.referenceBuffer)),
+    maxBufferSize(other.maxBufferSize),
+    baseCases(other.baseCases),
+    scores(other.scores)
 {
   other.kernel = std::move(KernelType());
   other.distance = std::move(DistanceType());
@@ -145,6 +156,7 @@ KDE(KDE&& other) :
   other.initialSampleSize = KDEDefaultParams::initialSampleSize;
   other.mcEntryCoef = KDEDefaultParams::mcEntryCoef;
   other.mcBreakCoef = KDEDefaultParams::mcBreakCoef;
+  other.maxBufferSize = KDEDefaultParams::maxBufferSize;
 }
 
 template<typename KernelType,
@@ -189,6 +201,10 @@ operator=(const KDE& other)
     initialSampleSize = other.initialSampleSize;
     mcEntryCoef = other.mcEntryCoef;
     mcBreakCoef = other.mcBreakCoef;
+    referenceBuffer = other.referenceBuffer;
+    maxBufferSize = other.maxBufferSize;
+    baseCases = other.baseCases;
+    scores = other.scores;
     if (trained)
     {
       if (ownsReferenceTree)
@@ -253,6 +269,10 @@ operator=(KDE&& other)
     this->initialSampleSize = other.initialSampleSize;
     this->mcEntryCoef = other.mcEntryCoef;
     this->mcBreakCoef = other.mcBreakCoef;
+    this->referenceBuffer = std::move(other.referenceBuffer);
+    this->maxBufferSize = other.maxBufferSize;
+    this->baseCases = other.baseCases;
+    this->scores = other.scores;
   }
   return *this;
 }
@@ -313,6 +333,7 @@ Train(MatType referenceSet)
   this->oldFromNewReferences = new std::vector<size_t>;
   this->referenceTree = BuildTree<Tree>(std::move(referenceSet),
                                         *oldFromNewReferences);
+  this->referenceBuffer.reset();
   this->trained = true;
 }
 
@@ -348,6 +369,7 @@ Train(Tree* referenceTree, std::vector<size_t>* oldFromNewReferences)
   this->ownsReferenceTree = false;
   this->referenceTree = referenceTree;
   this->oldFromNewReferences = oldFromNewReferences;
+  this->referenceBuffer.reset();
   this->trained = true;
 }
 
@@ -428,19 +450,16 @@ Evaluate(MatType querySet, arma::vec& estimations)
                               monteCarlo,
                               false);
 
-    // Create traverser.
-    SingleTreeTraversalType<RuleType> traverser(rules);
-
     // Traverse for each point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+    SingleTreeEvaluate(rules, querySet.n_cols);
+    baseCases = rules.BaseCases();
+    scores = rules.Scores();
 
-    estimations /= referenceTree->Dataset().n_cols;
+    AddBufferEstimations(querySet, estimations, false);
+    estimations /= NumReferences();
 
-    Log::Info << rules.Scores() << " node combinations were scored."
-              << std::endl;
-    Log::Info << rules.BaseCases() << " base cases were calculated."
-              << std::endl;
+    Log::Info << scores << " node combinations were scored." << std::endl;
+    Log::Info << baseCases << " base cases were calculated." << std::endl;
   }
 }
 
@@ -521,16 +540,18 @@ Evaluate(Tree* queryTree,
                             monteCarlo,
                             false);
 
-  // Create traverser.
-  DualTreeTraversalType<RuleType> traverser(rules);
-  traverser.Traverse(*queryTree, *referenceTree);
-  estimations /= referenceTree->Dataset().n_cols;
+  DualTreeEvaluate(rules, *queryTree);
+  baseCases = rules.BaseCases();
+  scores = rules.Scores();
+
+  AddBufferEstimations(queryTree->Dataset(), estimations, false);
+  estimations /= NumReferences();
 
   // Rearrange if necessary.
   RearrangeEstimations(oldFromNewQueries, estimations);
 
-  Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
-  Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
+  Log::Info << scores << " node combinations were scored." << std::endl;
+  Log::Info << baseCases << " base cases were calculated." << std::endl;
 }
 
 template<typename KernelType,
@@ -556,9 +577,11 @@ Evaluate(arma::vec& estimations)
                              "trained before evaluation");
   }
 
-  // Get estimations vector ready.
+  // Get estimations vector ready; the points of the reference buffer come
+  // after the points of the tree.
+  const size_t numTreePoints = referenceTree->Dataset().n_cols;
   estimations.clear();
-  estimations.set_size(referenceTree->Dataset().n_cols);
+  estimations.set_size(NumReferences());
   estimations.fill(arma::fill::zeros);
 
   // Clean accumulated alpha if Monte Carlo estimations are available.
@@ -586,24 +609,88 @@ Evaluate(arma::vec& estimations)
                             true);
 
   if (mode == KDE_DUAL_TREE_MODE)
+    DualTreeEvaluate(rules, *referenceTree);
+  else if (mode == KDE_SINGLE_TREE_MODE)
+    SingleTreeEvaluate(rules, numTreePoints);
+  baseCases = rules.BaseCases();
+  scores = rules.Scores();
+
+  if (referenceBuffer.n_cols > 0)
   {
-    // Create traverser.
-    DualTreeTraversalType<RuleType> traverser(rules);
-    traverser.Traverse(*referenceTree, *referenceTree);
+    // The points of the tree against the buffer, and the points of the buffer
+    // against the tree (with single-tree traversals) and each other.
+    arma::vec treeEstimations = estimations.head(numTreePoints);
+    AddBufferEstimations(referenceTree->Dataset(), treeEstimations, false);
+
+    arma::vec bufferEstimations(referenceBuffer.n_cols, arma::fill::zeros);
+    RuleType bufferRules(referenceTree->Dataset(),
+                         referenceBuffer,
+                         bufferEstimations,
+                         relError,
+                         absError,
+                         mcProb,
+                         initialSampleSize,
+                         mcEntryCoef,
+                         mcBreakCoef,
+                         distance,
+                         kernel,
+                         monteCarlo,
+                         false);
+    SingleTreeEvaluate(bufferRules, referenceBuffer.n_cols);
+    baseCases += bufferRules.BaseCases();
+    scores += bufferRules.Scores();
+    AddBufferEstimations(referenceBuffer, bufferEstimations, true);
+
+    RearrangeEstimations(*oldFromNewReferences, treeEstimations);
+    estimations.head(numTreePoints) = treeEstimations;
+    estimations.tail(referenceBuffer.n_cols) = bufferEstimations;
   }
-  else if (mode == KDE_SINGLE_TREE_MODE)
+  else
   {
-    SingleTreeTraversalType<RuleType> traverser(rules);
-    for (size_t i = 0; i < referenceTree->Dataset().n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+    // Rearrange if necessary.
+    RearrangeEstimations(*oldFromNewReferences, estimations);
   }
 
-  estimations /= referenceTree->Dataset().n_cols;
-  // Rearrange if necessary.
-  RearrangeEstimations(*oldFromNewReferences, estimations);
+  estimations /= NumReferences();
 
-  Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
-  Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
+  Log::Info << scores << " node combinations were scored." << std::endl;
+  Log::Info << baseCases << " base cases were calculated." << std::endl;
+}
+
+template<typename KernelType,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         DistanceType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+AddReferences(const MatType& newReferences)
+{
+  // Check whether has already been trained.
+  if (!trained)
+  {
+    throw std::runtime_error("cannot add references to KDE model: model needs "
+                             "to be trained first");
+  }
+
+  // Check whether dimensions match.
+  if (newReferences.n_rows != referenceTree->Dataset().n_rows)
+  {
+    throw std::invalid_argument("cannot add references to KDE model: new "
+                                "and existing reference points dimensions "
+                                "don't match");
+  }
+
+  referenceBuffer.insert_cols(referenceBuffer.n_cols, newReferences);
+  if (referenceBuffer.n_cols > maxBufferSize)
+    RebuildReferenceTree();
 }
 
 template<typename KernelType,
@@ -734,7 +821,7 @@ void KDE<KernelType,
          TreeType,
          DualTreeTraversalType,
          SingleTreeTraversalType>::
-serialize(Archive& ar, const uint32_t /* version */)
+serialize(Archive& ar, const uint32_t version)
 {
   // Serialize preferences.
   ar(CEREAL_NVP(relError));
@@ -764,6 +851,240 @@ serialize(Archive& ar, const uint32_t /* version */)
   ar(CEREAL_NVP(distance));
   ar(CEREAL_POINTER(referenceTree));
   ar(CEREAL_POINTER(oldFromNewReferences));
+
+  // Models from before version 1 have no reference buffer.
+  if (cereal::is_loading<Archive>() && version == 0)
+  {
+    referenceBuffer.reset();
+    maxBufferSize = KDEDefaultParams::maxBufferSize;
+  }
+  else
+  {
+    ar(CEREAL_NVP(referenceBuffer));
+    ar(CEREAL_NVP(maxBufferSize));
+  }
+}
+
+template<typename KernelType,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+template<typename RuleType>
+void KDE<KernelType,
+         DistanceType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+SingleTreeEvaluate(RuleType& rules, const size_t numQueries)
+{
+  // The Monte Carlo alpha of the reference nodes is computed lazily, so it is
+  // computed for the whole tree first; the threads then only read it.
+  if (monteCarlo && std::is_same<KernelType, GaussianKernel>::value)
+    rules.InitializeAlpha(*referenceTree);
+
+  #pragma omp parallel
+  {
+    // Each thread has its own copy of the rules, which holds the traversal
+    // state and the counters but shares the estimations and the accumulated
+    // error tolerances; since every query point is handled by a single
+    // thread, they need no locking.  Monte Carlo samples are drawn from the
+    // random number generator of each thread.
+    RuleType threadRules(rules);
+    threadRules.Scores() = 0;
+    threadRules.BaseCases() = 0;
+    SingleTreeTraversalType<RuleType> traverser(threadRules);
+
+    #pragma omp for schedule(dynamic, 16)
+    for (size_t i = 0; i < numQueries; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    #pragma omp critical
+    {
+      rules.Scores() += threadRules.Scores();
+      rules.BaseCases() += threadRules.BaseCases();
+    }
+  }
+}
+
+template<typename KernelType,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+template<typename RuleType>
+void KDE<KernelType,
+         DistanceType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+DualTreeEvaluate(RuleType& rules, Tree& queryTree)
+{
+  #ifdef MLPACK_USE_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  #else
+  const size_t numThreads = 1;
+  #endif
+
+  // With one thread, the whole tree is traversed at once, as before.
+  if (numThreads == 1)
+  {
+    DualTreeTraversalType<RuleType> traverser(rules);
+    traverser.Traverse(queryTree, *referenceTree);
+    return;
+  }
+
+  if (monteCarlo && std::is_same<KernelType, GaussianKernel>::value)
+    rules.InitializeAlpha(*referenceTree);
+
+  // Split the query tree into disjoint subtrees that cover every query point,
+  // by repeatedly replacing the largest subtree with its children, until there
+  // are a few subtrees for each thread.
+  std::vector<Tree*> subtrees(1, &queryTree);
+  while (subtrees.size() < 8 * numThreads)
+  {
+    size_t largest = 0;
+    for (size_t i = 1; i < subtrees.size(); ++i)
+    {
+      if (subtrees[i]->NumDescendants() > subtrees[largest]->NumDescendants())
+        largest = i;
+    }
+
+    Tree* node = subtrees[largest];
+    if (node->NumChildren() == 0)
+      break;
+
+    subtrees[largest] = &node->Child(0);
+    for (size_t i = 1; i < node->NumChildren(); ++i)
+      subtrees.push_back(&node->Child(i));
+  }
+
+  const typename RuleType::TraversalInfoType initialInfo =
+      rules.TraversalInfo();
+
+  #pragma omp parallel
+  {
+    // Each thread has its own copy of the rules.  The subtrees hold disjoint
+    // sets of query points, and the statistics of a query node are only
+    // changed by the thread that traverses it, so the estimations need no
+    // locking.
+    RuleType threadRules(rules);
+    threadRules.Scores() = 0;
+    threadRules.BaseCases() = 0;
+    DualTreeTraversalType<RuleType> traverser(threadRules);
+
+    #pragma omp for schedule(dynamic, 1)
+    for (size_t i = 0; i < subtrees.size(); ++i)
+    {
+      // Each subtree is traversed from the reference root, so it starts from
+      // the initial traversal state.
+      threadRules.TraversalInfo() = initialInfo;
+      traverser.Traverse(*subtrees[i], *referenceTree);
+    }
+
+    #pragma omp critical
+    {
+      rules.Scores() += threadRules.Scores();
+      rules.BaseCases() += threadRules.BaseCases();
+    }
+  }
+}
+
+template<typename KernelType,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         DistanceType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+RebuildReferenceTree()
+{
+  // Put the points of the tree back in their original order, followed by the
+  // points of the buffer.
+  const MatType& treeSet = referenceTree->Dataset();
+  MatType references(treeSet.n_rows, treeSet.n_cols + referenceBuffer.n_cols);
+  if (TreeTraits<Tree>::RearrangesDataset && oldFromNewReferences &&
+      oldFromNewReferences->size() == treeSet.n_cols)
+  {
+    for (size_t i = 0; i < treeSet.n_cols; ++i)
+      references.col((*oldFromNewReferences)[i]) = treeSet.col(i);
+  }
+  else
+  {
+    references.head_cols(treeSet.n_cols) = treeSet;
+  }
+  references.tail_cols(referenceBuffer.n_cols) = referenceBuffer;
+
+  if (ownsReferenceTree)
+  {
+    delete referenceTree;
+    delete oldFromNewReferences;
+  }
+
+  // The new tree has fresh statistics, so no Monte Carlo alpha or
+  // accumulated tolerance is carried over from the old one.
+  ownsReferenceTree = true;
+  oldFromNewReferences = new std::vector<size_t>;
+  referenceTree = BuildTree<Tree>(std::move(references),
+      *oldFromNewReferences);
+  referenceBuffer.reset();
+}
+
+template<typename KernelType,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         DistanceType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+AddBufferEstimations(const MatType& querySet,
+                     arma::vec& estimations,
+                     const bool sameSet)
+{
+  if (referenceBuffer.n_cols == 0)
+    return;
+
+  // The buffer is small, so its contribution is computed exactly.
+  baseCases += querySet.n_cols * referenceBuffer.n_cols;
+  if (sameSet)
+    baseCases -= querySet.n_cols;
+
+  #pragma omp parallel for schedule(static)
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    double sum = 0.0;
+    for (size_t r = 0; r < referenceBuffer.n_cols; ++r)
+    {
+      if (!sameSet || r != q)
+      {
+        sum += kernel.Evaluate(distance.Evaluate(querySet.col(q),
+            referenceBuffer.col(r)));
+      }
+    }
+    estimations[q] += sum;
+  }
 }
 
 template<typename KernelType,
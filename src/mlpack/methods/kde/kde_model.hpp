@@ -124,6 +124,10 @@ class KDEWrapperBase
 
   //! Perform monochromatic KDE (i.e. with the reference set as the query set).
   virtual void Evaluate(util::Timers& timers, arma::vec& estimates) = 0;
+
+  //! Add points to the reference set.
+  virtual void AddReferences(util::Timers& timers,
+                             const arma::mat& newReferences) = 0;
 };
 
 /**
@@ -204,6 +208,10 @@ class KDEWrapper : public KDEWrapperBase
   //! Perform monochromatic KDE (i.e. with the reference set as the query set).
   virtual void Evaluate(util::Timers& timers, arma::vec& estimates);
 
+  //! Add points to the reference set.
+  virtual void AddReferences(util::Timers& timers,
+                             const arma::mat& newReferences);
+
   //! Serialize the KDE model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
@@ -455,6 +463,16 @@ class KDEModel
    */
   void Evaluate(util::Timers& timers, arma::vec& estimations);
 
+  /**
+   * Add the given points to the reference set, without rebuilding the tree
+   * each time (see KDE::AddReferences()).
+   *
+   * @pre The model has to be previously created with BuildModel.
+   * @param timers Object to hold timing information in.
+   * @param newReferences Points to add to the reference set.
+   */
+  void AddReferences(util::Timers& timers, const arma::mat& newReferences);
+
 
  private:
   //! Clean memory.
@@ -259,6 +259,13 @@ inline void KDEModel::Evaluate(util::Timers& timers,
   kdeModel->Evaluate(timers, estimates);
 }
 
+// Add reference points.
+inline void KDEModel::AddReferences(util::Timers& timers,
+                                    const arma::mat& newReferences)
+{
+  kdeModel->AddReferences(timers, newReferences);
+}
+
 // Clean memory.
 inline void KDEModel::CleanMemory()
 {
@@ -393,6 +400,20 @@ void KDEWrapper<KernelType, TreeType>::Evaluate(util::Timers& timers,
   timers.Stop("applying_normalizer");
 }
 
+//! Add points to the reference set.
+template<typename KernelType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void KDEWrapper<KernelType, TreeType>::AddReferences(
+    util::Timers& timers,
+    const arma::mat& newReferences)
+{
+  timers.Start("tree_building");
+  kde.AddReferences(newReferences);
+  timers.Stop("tree_building");
+}
+
 template<template<typename TreeDistanceType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
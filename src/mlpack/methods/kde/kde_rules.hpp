@@ -13,6 +13,7 @@
 #ifndef MLPACK_METHODS_KDE_RULES_HPP
 #define MLPACK_METHODS_KDE_RULES_HPP
 
+#include <mlpack/core/tree/rule_traits.hpp>
 #include <mlpack/core/tree/traversal_info.hpp>
 
 namespace mlpack {
@@ -88,9 +89,22 @@ class KDERules
 
   //! Get the number of base cases.
   size_t BaseCases() const { return baseCases; }
+  //! Modify the number of base cases.
+  size_t& BaseCases() { return baseCases; }
 
   //! Get the number of scores.
   size_t Scores() const { return scores; }
+  //! Modify the number of scores.
+  size_t& Scores() { return scores; }
+
+  /**
+   * Compute the Monte Carlo alpha of every node of the given reference tree
+   * for the current significance level, so that traversals only read it; this
+   * must be done before several threads traverse the same reference tree.
+   *
+   * @param node Root of the reference tree.
+   */
+  void InitializeAlpha(TreeType& node);
 
   //! Get the minimum number of base cases we need to perform to have acceptable
   //! results.
@@ -148,11 +162,13 @@ class KDERules
   //! Whether Monte Carlo estimations are going to be applied.
   const bool monteCarlo;
 
-  //! Accumulated not used MC alpha values for each query point.
-  arma::vec accumMCAlpha;
+  //! Accumulated not used MC alpha values for each query point (shared between
+  //! copies of the rules, each of which handles different query points).
+  std::shared_ptr<arma::vec> accumMCAlpha;
 
-  //! Accumulated not used error tolerance for each query point.
-  arma::vec accumError;
+  //! Accumulated not used error tolerance for each query point (shared between
+  //! copies of the rules).
+  std::shared_ptr<arma::vec> accumError;
 
   //! Whether reference and query sets are the same.
   const bool sameSet;
@@ -180,6 +196,21 @@ class KDERules
   size_t scores;
 };
 
+/**
+ * The dual-tree Score() and BaseCase() of KDERules only write the densities,
+ * the accumulated error and alpha of the query points, and the statistics of
+ * the query nodes; copies share those vectors.  The Monte Carlo alpha of the
+ * reference nodes is computed lazily, so with Monte Carlo estimations
+ * InitializeAlpha() must be called on the reference tree before disjoint query
+ * subtrees are traversed in parallel.
+ */
+template<typename DistanceType, typename KernelType, typename TreeType>
+class RuleTraits<KDERules<DistanceType, KernelType, TreeType>>
+{
+ public:
+  static const bool HasPerQueryResults = true;
+};
+
 /**
  * A dual-tree traversal Rules class for cleaning used trees before performing
  * kernel density estimation.
@@ -56,11 +56,14 @@ KDERules<DistanceType, KernelType, TreeType>::KDERules(
     scores(0)
 {
   // Initialize accumError.
-  accumError = arma::vec(querySet.n_cols);
+  accumError = std::make_shared<arma::vec>(querySet.n_cols, arma::fill::zeros);
 
   // Initialize accumMCAlpha only if Monte Carlo estimations are available.
   if (monteCarlo && kernelIsGaussian)
-    accumMCAlpha = arma::vec(querySet.n_cols);
+  {
+    accumMCAlpha = std::make_shared<arma::vec>(querySet.n_cols,
+        arma::fill::zeros);
+  }
 }
 
 //! The base case.
@@ -86,7 +89,7 @@ double KDERules<DistanceType, KernelType, TreeType>::BaseCase(
   densities(queryIndex) += kernelValue;
 
   // Update accumulated relative error tolerance for single-tree pruning.
-  accumError(queryIndex) += 2 * relError * kernelValue;
+  (*accumError)(queryIndex) += 2 * relError * kernelValue;
 
   ++baseCases;
   lastQueryIndex = queryIndex;
@@ -155,9 +158,9 @@ Score(const size_t queryIndex, TreeType& referenceNode)
   // it here to prune more.
   double pointAccumErrorTol;
   if (alreadyDidRefPoint0)
-    pointAccumErrorTol = accumError(queryIndex) / (refNumDesc - 1);
+    pointAccumErrorTol = (*accumError)(queryIndex) / (refNumDesc - 1);
   else
-    pointAccumErrorTol = accumError(queryIndex) / refNumDesc;
+    pointAccumErrorTol = (*accumError)(queryIndex) / refNumDesc;
 
   if (bound <= 2 * errorTolerance + pointAccumErrorTol)
   {
@@ -175,13 +178,18 @@ Score(const size_t queryIndex, TreeType& referenceNode)
     // Subtract used error tolerance or add extra available tolerace from this
     // prune.
     if (alreadyDidRefPoint0)
-      accumError(queryIndex) -= (refNumDesc - 1) * (bound - 2 * errorTolerance);
+    {
+      (*accumError)(queryIndex) -=
+          (refNumDesc - 1) * (bound - 2 * errorTolerance);
+    }
     else
-      accumError(queryIndex) -= refNumDesc * (bound - 2 * errorTolerance);
+    {
+      (*accumError)(queryIndex) -= refNumDesc * (bound - 2 * errorTolerance);
+    }
 
     // Store not used alpha for Monte Carlo.
     if (kernelIsGaussian && monteCarlo)
-      accumMCAlpha(queryIndex) += depthAlpha;
+      (*accumMCAlpha)(queryIndex) += depthAlpha;
   }
   else if (monteCarlo &&
            refNumDesc >= mcAccessCoef * initialSampleSize &&
@@ -189,7 +197,7 @@ Score(const size_t queryIndex, TreeType& referenceNode)
   {
     // Monte Carlo probabilistic estimation.
     // Calculate z using accumulated alpha if possible.
-    const double alpha = depthAlpha + accumMCAlpha(queryIndex);
+    const double alpha = depthAlpha + (*accumMCAlpha)(queryIndex);
     const double z = std::abs(Quantile(alpha / 2.0));
 
     // Auxiliary variables.
@@ -250,7 +258,7 @@ Score(const size_t queryIndex, TreeType& referenceNode)
       score = DBL_MAX;
 
       // Accumulated alpha has been used.
-      accumMCAlpha(queryIndex) = 0;
+      (*accumMCAlpha)(queryIndex) = 0;
     }
     else
     {
@@ -260,7 +268,7 @@ Score(const size_t queryIndex, TreeType& referenceNode)
       if (referenceNode.IsLeaf())
       {
         // Reclaim not used alpha since the node will be exactly computed.
-        accumMCAlpha(queryIndex) += depthAlpha;
+        (*accumMCAlpha)(queryIndex) += depthAlpha;
       }
     }
   }
@@ -273,15 +281,15 @@ Score(const size_t queryIndex, TreeType& referenceNode)
     if (referenceNode.IsLeaf())
     {
       if (alreadyDidRefPoint0)
-        accumError(queryIndex) += (refNumDesc - 1) * 2 * absErrorTol;
+        (*accumError)(queryIndex) += (refNumDesc - 1) * 2 * absErrorTol;
       else
-        accumError(queryIndex) += refNumDesc * 2 * absErrorTol;
+        (*accumError)(queryIndex) += refNumDesc * 2 * absErrorTol;
     }
 
     // If node is going to be exactly computed, reclaim not used alpha for
     // Monte Carlo estimations.
     if (kernelIsGaussian && monteCarlo && referenceNode.IsLeaf())
-      accumMCAlpha(queryIndex) += depthAlpha;
+      (*accumMCAlpha)(queryIndex) += depthAlpha;
   }
 
   ++scores;
@@ -568,6 +576,17 @@ CalculateAlpha(TreeType* node)
   return stat.MCAlpha();
 }
 
+template<typename DistanceType, typename KernelType, typename TreeType>
+void KDERules<DistanceType, KernelType, TreeType>::InitializeAlpha(
+    TreeType& node)
+{
+  // The alpha of a node depends on the alpha of its parent, so the tree is
+  // walked from the root down.
+  CalculateAlpha(&node);
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    InitializeAlpha(node.Child(i));
+}
+
 //! Clean rules base case.
 template<typename TreeType>
 inline mlpack_force_inline
@@ -18,6 +18,7 @@
 
 #include "kernel_rules/naive_method.hpp"
 #include "kernel_rules/nystroem_method.hpp"
+#include "kernel_rules/random_fourier_features_method.hpp"
 
 namespace mlpack {
 
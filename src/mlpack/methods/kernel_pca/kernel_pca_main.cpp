@@ -69,6 +69,9 @@ BINDING_LONG_DESC(
     " * 'cosine': cosine distance:\n"
     "    `K(x, y) = 1 - (x^T y) / (|| x || * || y ||)`\n"
     "\n"
+    " * 'cauchy': Cauchy kernel; requires bandwidth:\n"
+    "    `K(x, y) = 1 / (1 + (|| x - y || / bandwidth) ^ 2)`\n"
+    "\n"
     "The parameters for each of the kernels should be specified with the "
     "options " + PRINT_PARAM_STRING("bandwidth") + ", " +
     PRINT_PARAM_STRING("kernel_scale") + ", " +
@@ -82,7 +85,15 @@ BINDING_LONG_DESC(
     "the kernel matrix; to specify the sampling scheme, the " +
     PRINT_PARAM_STRING("sampling") + " parameter is used.  The "
     "sampling scheme for the Nystroem method can be chosen from the "
-    "following list: 'kmeans', 'random', 'ordered'.");
+    "following list: 'kmeans', 'random', 'ordered'."
+    "\n\n"
+    "For the 'gaussian', 'laplacian' and 'cauchy' kernels, random Fourier "
+    "features (\"Random Features for Large-Scale Kernel Machines\", 2007) can "
+    "be used instead by specifying the " +
+    PRINT_PARAM_STRING("random_fourier_features") + " parameter.  The points "
+    "are mapped to " + PRINT_PARAM_STRING("num_features") + " random features "
+    "whose dot products approximate the kernel, and the principal components "
+    "of the features are computed, so the kernel matrix is never built.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -115,14 +126,18 @@ PARAM_FLAG("center", "If set, the transformed data will be centered about the "
 
 PARAM_FLAG("nystroem_method", "If set, the Nystroem method will be used.", "n");
 
+PARAM_FLAG("random_fourier_features", "If set, random Fourier features will be "
+    "used.", "F");
+PARAM_INT_IN("num_features", "Number of random Fourier features.", "N", 1000);
+
 PARAM_STRING_IN("sampling", "Sampling scheme to use for the Nystroem method: "
     "'kmeans', 'random', 'ordered'", "s", "kmeans");
 
 PARAM_DOUBLE_IN("kernel_scale", "Scale, for 'hyptan' kernel.", "S", 1.0);
 PARAM_DOUBLE_IN("offset", "Offset, for 'hyptan' and 'polynomial' kernels.", "O",
     0.0);
-PARAM_DOUBLE_IN("bandwidth", "Bandwidth, for 'gaussian' and 'laplacian' "
-    "kernels.", "b", 1.0);
+PARAM_DOUBLE_IN("bandwidth", "Bandwidth, for 'gaussian', 'laplacian', "
+    "'epanechnikov' and 'cauchy' kernels.", "b", 1.0);
 PARAM_DOUBLE_IN("degree", "Degree of polynomial, for 'polynomial' kernel.", "D",
     1.0);
 
@@ -170,6 +185,28 @@ void RunKPCA(arma::mat& dataset,
   }
 }
 
+//! Run KPCA on the specified dataset with random Fourier features.
+template<typename KernelType>
+void RunRandomFourierFeaturesKPCA(arma::mat& dataset,
+                                  const size_t newDim,
+                                  const size_t numFeatures,
+                                  KernelType& kernel)
+{
+  RandomFourierFeatures<KernelType> rff(std::max(numFeatures, newDim), kernel);
+  rff.Fit(dataset);
+
+  // The projections onto the principal components of the centered features
+  // are already centered.
+  arma::mat features, eigvec;
+  arma::vec eigval;
+  rff.Transform(dataset, features);
+  RandomFourierFeaturesKernelRule<KernelType>::ApplyFeatures(features, dataset,
+      eigval, eigvec);
+
+  if (newDim < dataset.n_rows)
+    dataset.shed_rows(newDim, dataset.n_rows - 1);
+}
+
 void BINDING_FUNCTION(util::Params& params, util::Timers& /* timers */)
 {
   RequireAtLeastOnePassed(params, { "output" }, false,
@@ -194,10 +231,45 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& /* timers */)
 
   // Get the kernel type and make sure it is valid.
   RequireParamInSet<string>(params, "kernel", { "linear", "gaussian",
-      "polynomial", "hyptan", "laplacian", "epanechnikov", "cosine" }, true,
-      "unknown kernel type");
+      "polynomial", "hyptan", "laplacian", "epanechnikov", "cosine",
+      "cauchy" }, true, "unknown kernel type");
   const string kernelType = params.Get<string>("kernel");
 
+  RequireOnlyOnePassed(params, { "nystroem_method", "random_fourier_features" },
+      true, "only one kernel approximation can be used", true);
+  ReportIgnoredParam(params, {{ "random_fourier_features", false }},
+      "num_features");
+  if (params.Has("random_fourier_features"))
+  {
+    RequireParamInSet<string>(params, "kernel", { "gaussian", "laplacian",
+        "cauchy" }, true, "random Fourier features need a shift-invariant "
+        "kernel");
+    RequireParamValue<int>(params, "num_features", [](int x) { return x > 0; },
+        true, "number of features must be positive");
+
+    const double bandwidth = params.Get<double>("bandwidth");
+    const size_t numFeatures = (size_t) params.Get<int>("num_features");
+    if (kernelType == "gaussian")
+    {
+      GaussianKernel kernel(bandwidth);
+      RunRandomFourierFeaturesKPCA(dataset, newDim, numFeatures, kernel);
+    }
+    else if (kernelType == "laplacian")
+    {
+      LaplacianKernel kernel(bandwidth);
+      RunRandomFourierFeaturesKPCA(dataset, newDim, numFeatures, kernel);
+    }
+    else
+    {
+      CauchyKernel kernel(bandwidth);
+      RunRandomFourierFeaturesKPCA(dataset, newDim, numFeatures, kernel);
+    }
+
+    if (params.Has("output"))
+      params.Get<arma::mat>("output") = std::move(dataset);
+    return;
+  }
+
   const bool centerTransformedData = params.Has("center");
   const bool nystroem = params.Has("nystroem_method");
   const string sampling = params.Get<string>("sampling");
@@ -256,6 +328,14 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& /* timers */)
     RunKPCA<CosineDistance>(dataset, centerTransformedData, nystroem, newDim,
         sampling, kernel);
   }
+  else if (kernelType == "cauchy")
+  {
+    const double bandwidth = params.Get<double>("bandwidth");
+
+    CauchyKernel kernel(bandwidth);
+    RunKPCA<CauchyKernel>(dataset, centerTransformedData, nystroem, newDim,
+        sampling, kernel);
+  }
 
   // Save the output dataset.
   if (params.Has("output"))
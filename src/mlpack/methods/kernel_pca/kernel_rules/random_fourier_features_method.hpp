@@ -0,0 +1,99 @@
+/**
+ * @file methods/kernel_pca/kernel_rules/random_fourier_features_method.hpp
+ *
+ * Use random Fourier features to approximate kernel PCA.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KERNEL_PCA_RANDOM_FOURIER_FEATURES_METHOD_HPP
+#define MLPACK_METHODS_KERNEL_PCA_RANDOM_FOURIER_FEATURES_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/random_fourier_features/random_fourier_features.hpp>
+
+namespace mlpack {
+
+/**
+ * Approximate kernel PCA with random Fourier features: the points are mapped
+ * to the features, and the principal components of the features are computed
+ * from their D x D covariance, so that the n x n kernel matrix is never built.
+ * The number of features is the largest of NumFeatures and the rank.
+ *
+ * @tparam KernelType Shift-invariant kernel (see RandomFourierFeatures).
+ * @tparam NumFeatures Number of random Fourier features.
+ */
+template<typename KernelType, size_t NumFeatures = 1000>
+class RandomFourierFeaturesKernelRule
+{
+ public:
+  /**
+   * Compute the random Fourier features of the data and their principal
+   * components.
+   *
+   * @param data Input data points.
+   * @param transformedData Matrix to output results into.
+   * @param eigval KPCA eigenvalues will be written to this vector.
+   * @param eigvec KPCA eigenvectors (in the space of the features) will be
+   *     written to this matrix.
+   * @param rank Rank to be used for matrix approximation.
+   * @param kernel Kernel to be used for computation.
+   */
+  static void ApplyKernelMatrix(const arma::mat& data,
+                                arma::mat& transformedData,
+                                arma::vec& eigval,
+                                arma::mat& eigvec,
+                                const size_t rank,
+                                KernelType kernel = KernelType())
+  {
+    RandomFourierFeatures<KernelType> rff(std::max(NumFeatures, rank),
+        kernel);
+    rff.Fit(data);
+
+    arma::mat features;
+    rff.Transform(data, features);
+    ApplyFeatures(features, transformedData, eigval, eigvec);
+  }
+
+  /**
+   * Compute the principal components of features that were already computed
+   * (for instance with a number of features chosen at runtime).  The features
+   * are centered in place.
+   *
+   * @param features Features of the data points, one point in each column.
+   * @param transformedData Matrix to output results into.
+   * @param eigval KPCA eigenvalues will be written to this vector.
+   * @param eigvec KPCA eigenvectors (in the space of the features) will be
+   *     written to this matrix.
+   */
+  static void ApplyFeatures(arma::mat& features,
+                            arma::mat& transformedData,
+                            arma::vec& eigval,
+                            arma::mat& eigvec)
+  {
+    // Centering the features is the same as centering the approximate kernel
+    // matrix, and the nonzero eigenvalues of the centered kernel matrix are
+    // those of the (much smaller) scatter matrix of the features.
+    features.each_col() -= arma::mean(features, 1);
+    const arma::mat scatter = arma::symmatu(features * features.t());
+    if (!arma::eig_sym(eigval, eigvec, scatter))
+    {
+      Log::Fatal << "Failed to construct the kernel matrix." << std::endl;
+    }
+
+    // Swap the eigenvalues since they are ordered backwards (we need largest
+    // to smallest).
+    eigval = arma::flipud(eigval);
+    eigvec = arma::fliplr(eigvec);
+
+    // The projections onto the principal components are the same as those of
+    // NaiveKernelRule, for the approximate kernel matrix.
+    transformedData = eigvec.t() * features;
+  }
+};
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,213 @@
+/**
+ * @file methods/kmeans/centroid_distances.hpp
+ *
+ * A helper for the k-means classes that computes distances between the points
+ * of a dataset of any element type, dense or sparse, and a set of centroids
+ * stored as an arma::mat.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_CENTROID_DISTANCES_HPP
+#define MLPACK_METHODS_KMEANS_CENTROID_DISTANCES_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+
+/**
+ * Compute distances between the points of a dataset and a set of centroids.
+ * The centroids are always held in double precision, while the dataset may be
+ * dense or sparse and of any element type (for instance arma::fmat, to halve
+ * the memory used by the data); all the arithmetic is done in double
+ * precision.
+ *
+ * For dense data that is not double precision, the (squared) Euclidean
+ * distance is computed directly from the elements of the point; other distance
+ * metrics are given a double-precision copy of the point.
+ *
+ * For sparse data and the (squared) Euclidean distance, the squared norms of
+ * the points and of the centroids are cached, so that each distance only takes
+ * a dot product over the nonzero elements of the point:
+ *
+ *   ||x - c||^2 = ||x||^2 - 2 x^T c + ||c||^2.
+ *
+ * This is much faster than subtracting a dense centroid from a sparse point,
+ * but it loses some precision when a point is very close to a centroid
+ * (relative to their norms).
+ *
+ * @tparam DistanceType Type of distance metric to use.
+ * @tparam MatType Type of the dataset.
+ */
+template<typename DistanceType, typename MatType>
+class CentroidDistances
+{
+ public:
+  //! The element type of the dataset.
+  typedef typename MatType::elem_type ElemType;
+
+  //! Whether the distance metric is the (squared) Euclidean distance.
+  static constexpr bool Euclidean =
+      std::is_same<DistanceType, EuclideanDistance>::value ||
+      std::is_same<DistanceType, SquaredEuclideanDistance>::value;
+  //! Whether distances are computed from cached norms.
+  static constexpr bool UseNorms = arma::is_SpMat<MatType>::value && Euclidean;
+
+  /**
+   * Prepare to compute distances for the given dataset.  If norms are used,
+   * the squared norm of each point is computed here.  SetCentroids() must be
+   * called before Evaluate().
+   *
+   * @param dataset Dataset.
+   * @param distance Instantiated distance metric.
+   */
+  CentroidDistances(const MatType& dataset, DistanceType& distance) :
+      dataset(dataset),
+      distance(distance),
+      centroids(NULL)
+  {
+    if constexpr (UseNorms)
+    {
+      pointNorms.zeros(dataset.n_cols);
+      for (size_t i = 0; i < dataset.n_cols; ++i)
+      {
+        for (typename MatType::const_iterator it = dataset.begin_col(i);
+             it != dataset.end_col(i); ++it)
+        {
+          pointNorms[i] += double(*it) * double(*it);
+        }
+      }
+    }
+  }
+
+  /**
+   * Set the centroids that distances will be computed to.  The matrix must not
+   * change (or be destroyed) while distances are computed.
+   */
+  void SetCentroids(const arma::mat& newCentroids)
+  {
+    centroids = &newCentroids;
+    if constexpr (UseNorms)
+      centroidNorms = arma::sum(arma::square(newCentroids), 0).t();
+  }
+
+  /**
+   * Compute the distance between the given point of the dataset and the given
+   * centroid.
+   */
+  double Evaluate(const size_t point, const size_t centroid) const
+  {
+    if constexpr (UseNorms)
+    {
+      double dot = 0.0;
+      for (typename MatType::const_iterator it = dataset.begin_col(point);
+           it != dataset.end_col(point); ++it)
+      {
+        dot += double(*it) * (*centroids)(it.row(), centroid);
+      }
+
+      // Rounding can make the result slightly negative.
+      const double squared = std::max(pointNorms[point] - 2.0 * dot +
+          centroidNorms[centroid], 0.0);
+      if constexpr (std::is_same<DistanceType, EuclideanDistance>::value)
+        return std::sqrt(squared);
+      else
+        return squared;
+    }
+    else if constexpr (std::is_same<ElemType, double>::value)
+    {
+      return distance.Evaluate(dataset.col(point), centroids->col(centroid));
+    }
+    else if constexpr (Euclidean && !arma::is_SpMat<MatType>::value)
+    {
+      const ElemType* p = dataset.colptr(point);
+      const double* c = centroids->colptr(centroid);
+      double squared = 0.0;
+      for (size_t r = 0; r < dataset.n_rows; ++r)
+      {
+        const double diff = double(p[r]) - c[r];
+        squared += diff * diff;
+      }
+
+      if constexpr (std::is_same<DistanceType, EuclideanDistance>::value)
+        return std::sqrt(squared);
+      else
+        return squared;
+    }
+    else
+    {
+      return distance.Evaluate(Point(dataset, point),
+          centroids->col(centroid));
+    }
+  }
+
+  /**
+   * Get the given point of the dataset as a dense double-precision vector.
+   */
+  static arma::vec Point(const MatType& dataset, const size_t point)
+  {
+    if constexpr (arma::is_SpMat<MatType>::value)
+    {
+      arma::vec result(dataset.n_rows, arma::fill::zeros);
+      for (typename MatType::const_iterator it = dataset.begin_col(point);
+           it != dataset.end_col(point); ++it)
+      {
+        result[it.row()] = double(*it);
+      }
+      return result;
+    }
+    else
+    {
+      return ConvTo<arma::vec>::From(dataset.col(point));
+    }
+  }
+
+  /**
+   * Add the given point of the dataset to the given column of sums (for
+   * instance, the sums of the points assigned to each centroid).
+   */
+  static void AddPoint(const MatType& dataset,
+                       const size_t point,
+                       arma::mat& sums,
+                       const size_t column)
+  {
+    if constexpr (arma::is_SpMat<MatType>::value)
+    {
+      for (typename MatType::const_iterator it = dataset.begin_col(point);
+           it != dataset.end_col(point); ++it)
+      {
+        sums(it.row(), column) += double(*it);
+      }
+    }
+    else if constexpr (std::is_same<ElemType, double>::value)
+    {
+      sums.col(column) += dataset.col(point);
+    }
+    else
+    {
+      const ElemType* p = dataset.colptr(point);
+      double* s = sums.colptr(column);
+      for (size_t r = 0; r < dataset.n_rows; ++r)
+        s[r] += double(p[r]);
+    }
+  }
+
+ private:
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated distance metric.
+  DistanceType& distance;
+  //! The centroids.
+  const arma::mat* centroids;
+
+  //! Squared norms of each point, if norms are used.
+  arma::vec pointNorms;
+  //! Squared norms of each centroid, if norms are used.
+  arma::vec centroidNorms;
+};
+
+} // namespace mlpack
+
+#endif
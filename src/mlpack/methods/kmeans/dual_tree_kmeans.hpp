@@ -62,7 +62,9 @@ class DualTreeKMeans
 
   /**
    * Run a single iteration of the dual-tree nearest neighbor algorithm for
-   * k-means, updating the given centroids into the newCentroids matrix.
+   * k-means, updating the given centroids into the newCentroids matrix.  If
+   * OpenMP is enabled, the tree of points is split into disjoint subtrees that
+   * are traversed, updated and summarized by different threads.
    *
    * @param centroids Current cluster centroids.
    * @param newCentroids New cluster centroids.
@@ -96,12 +98,13 @@ class DualTreeKMeans
   arma::vec upperBounds;
   //! Lower bounds on second closest cluster distance for each point.
   arma::vec lowerBounds;
-  //! Indicator of whether or not the point is pruned.
-  std::vector<bool> prunedPoints;
+  //! Indicator of whether or not the point is pruned.  (This is not a
+  //! std::vector<bool>, so that different threads can set different points.)
+  std::vector<char> prunedPoints;
 
   arma::Row<size_t> assignments;
 
-  std::vector<bool> visited; // Was the point visited this iteration?
+  std::vector<char> visited; // Was the point visited this iteration?
 
   arma::mat lastIterationCentroids; // For sanity checks.
 
@@ -109,8 +112,18 @@ class DualTreeKMeans
 
   arma::mat interclusterDistances; // Static storage for intercluster distances.
 
+  //! Subtrees with fewer descendants than this are updated by UpdateTree() in
+  //! the same task as their parent.
+  static constexpr size_t TaskMinDescendants = 1024;
+
+  //! Traverse the (coalesced) tree of points with the given centroid tree,
+  //! splitting the tree of points between threads.
+  template<typename RuleType>
+  void DualTreeTraversal(RuleType& rules, Tree& centroidTree);
+
   //! Update the bounds in the tree before the next iteration.
-  //! centroids is the current (not yet searched) centroids.
+  //! centroids is the current (not yet searched) centroids.  Large subtrees
+  //! are updated in OpenMP tasks, if called from inside a parallel region.
   void UpdateTree(Tree& node,
                   const arma::mat& centroids,
                   const double parentUpperBound = 0.0,
@@ -118,7 +131,8 @@ class DualTreeKMeans
                   const double parentLowerBound = DBL_MAX,
                   const double adjustedParentLowerBound = 0.0);
 
-  //! Extract the centroids of the clusters.
+  //! Extract the centroids of the clusters, for the points in the subtree rooted
+  //! at the given node.
   void ExtractCentroids(Tree& node,
                         arma::mat& newCentroids,
                         arma::Col<size_t>& newCounts,
@@ -131,8 +131,14 @@ double DualTreeKMeans<DistanceType, MatType, TreeType>::Iterate(
       delete interclusterDistancesTemp;
     }
 
-    UpdateTree(*tree, centroids);
+    // Large subtrees are updated in parallel tasks.
+    #pragma omp parallel
+    {
+      #pragma omp single
+      UpdateTree(*tree, centroids);
+    }
 
+    #pragma omp parallel for schedule(static)
     for (size_t i = 0; i < dataset.n_cols; ++i)
       visited[i] = false;
   }
@@ -150,22 +156,62 @@ double DualTreeKMeans<DistanceType, MatType, TreeType>::Iterate(
       upperBounds, lowerBounds, distance, prunedPoints, oldFromNewCentroids,
       visited);
 
-  typename Tree::template BreadthFirstDualTreeTraverser<RuleType>
-      traverser(rules);
-
   CoalesceTree(*tree);
 
   // Set the number of pruned centroids in the root to 0.
   tree->Stat().Pruned() = 0;
-  traverser.Traverse(*tree, nns.ReferenceTree());
+  DualTreeTraversal(rules, nns.ReferenceTree());
   distanceCalculations += rules.BaseCases() + rules.Scores();
 
   DecoalesceTree(*tree);
 
-  // Now we need to extract the clusters.
+  // Now we need to extract the clusters.  Split the tree into subtrees by
+  // expanding the largest subtree whose points are not all owned by one
+  // cluster; each thread sums the points of its subtrees into its own copy of
+  // the new centroids and counts.
+  #ifdef MLPACK_USE_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  #else
+  const size_t numThreads = 1;
+  #endif
+
+  std::vector<Tree*> subtrees(1, tree);
+  const size_t numSubtrees = (numThreads == 1) ? 1 : 8 * numThreads;
+  while (subtrees.size() < numSubtrees)
+  {
+    size_t largest = subtrees.size();
+    for (size_t i = 0; i < subtrees.size(); ++i)
+    {
+      const Tree& node = *subtrees[i];
+      const bool owned = (node.Stat().Pruned() == centroids.n_cols) ||
+          (node.Stat().StaticPruned() &&
+           node.Stat().Owner() < centroids.n_cols);
+      if (owned || node.NumChildren() == 0)
+        continue;
+
+      if (largest == subtrees.size() ||
+          node.NumDescendants() > subtrees[largest]->NumDescendants())
+        largest = i;
+    }
+
+    // Stop if no subtree can be expanded.
+    if (largest == subtrees.size())
+      break;
+
+    // A node that is not owned by a cluster only holds points itself if it is
+    // a leaf, so it contributes nothing once its children are subtrees.
+    Tree* node = subtrees[largest];
+    subtrees[largest] = &node->Child(0);
+    for (size_t i = 1; i < node->NumChildren(); ++i)
+      subtrees.push_back(&node->Child(i));
+  }
+
   newCentroids.zeros(centroids.n_rows, centroids.n_cols);
   counts.zeros(centroids.n_cols);
-  ExtractCentroids(*tree, newCentroids, counts, centroids);
+  #pragma omp parallel for reduction(matAdd:newCentroids) \
+      reduction(colAdd:counts) schedule(dynamic, 1)
+  for (size_t i = 0; i < subtrees.size(); ++i)
+    ExtractCentroids(*subtrees[i], newCentroids, counts, centroids);
 
   // Now, calculate how far the clusters moved, after normalizing them.
   double residual = 0.0;
@@ -197,6 +243,86 @@ double DualTreeKMeans<DistanceType, MatType, TreeType>::Iterate(
   return std::sqrt(residual);
 }
 
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename RuleType>
+void DualTreeKMeans<DistanceType, MatType, TreeType>::DualTreeTraversal(
+    RuleType& rules,
+    Tree& centroidTree)
+{
+  #ifdef MLPACK_USE_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  #else
+  const size_t numThreads = 1;
+  #endif
+
+  // Split the tree of points into disjoint subtrees, by repeatedly replacing
+  // the largest subtree with its children, until there are a few subtrees for
+  // each thread.  Statically pruned children are never visited by the
+  // traversal, so they are dropped.  With one thread, the whole tree is
+  // traversed at once, as before.
+  std::vector<Tree*> subtrees(1, tree);
+  const size_t numSubtrees = (numThreads == 1) ? 1 : 8 * numThreads;
+  while (subtrees.size() < numSubtrees && !subtrees.empty())
+  {
+    size_t largest = 0;
+    for (size_t i = 1; i < subtrees.size(); ++i)
+    {
+      if (subtrees[i]->NumDescendants() > subtrees[largest]->NumDescendants())
+        largest = i;
+    }
+
+    Tree* node = subtrees[largest];
+    if (node->NumChildren() == 0)
+      break;
+
+    subtrees.erase(subtrees.begin() + largest);
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+    {
+      Tree& child = node->Child(i);
+      if (child.Stat().StaticPruned())
+        continue;
+
+      // Each subtree is traversed as if it were the root, so its children do
+      // not take an unset number of pruned clusters from a node above the
+      // subtrees.  The nodes above the subtrees are left unowned.
+      child.Stat().Pruned() = 0;
+      subtrees.push_back(&child);
+    }
+  }
+
+  const typename RuleType::TraversalInfoType initialInfo =
+      rules.TraversalInfo();
+
+  #pragma omp parallel
+  {
+    // Each thread has its own copy of the rules, which holds the traversal
+    // state and the counters but shares the bounds and assignments; the
+    // subtrees hold disjoint sets of points, so these need no locking.
+    RuleType threadRules(rules);
+    threadRules.Scores() = 0;
+    threadRules.BaseCases() = 0;
+    typename Tree::template BreadthFirstDualTreeTraverser<RuleType>
+        traverser(threadRules);
+
+    #pragma omp for schedule(dynamic, 1)
+    for (size_t i = 0; i < subtrees.size(); ++i)
+    {
+      threadRules.TraversalInfo() = initialInfo;
+      traverser.Traverse(*subtrees[i], centroidTree);
+    }
+
+    #pragma omp critical
+    {
+      rules.Scores() += threadRules.Scores();
+      rules.BaseCases() += threadRules.BaseCases();
+    }
+  }
+}
+
 template<typename DistanceType,
          typename MatType,
          template<typename TreeDistanceType,
@@ -213,6 +339,10 @@ void DualTreeKMeans<DistanceType, MatType, TreeType>::UpdateTree(
   const bool prunedLastIteration = node.Stat().StaticPruned();
   node.Stat().StaticPruned() = false;
 
+  // Distance calculations are counted locally, since subtrees may be updated
+  // by different threads.
+  size_t nodeDistanceCalculations = 0;
+
   // Grab information from the parent, if we can.
   if (node.Parent() != NULL &&
       node.Parent()->Stat().Pruned() == centroids.n_cols &&
@@ -267,7 +397,7 @@ void DualTreeKMeans<DistanceType, MatType, TreeType>::UpdateTree(
                    node.MaxDistance(centroids.col(node.Stat().Owner())));
       adjustedUpperBound = node.Stat().UpperBound();
 
-      ++distanceCalculations;
+      ++nodeDistanceCalculations;
       if (node.Stat().UpperBound() < node.Stat().LowerBound())
         node.Stat().StaticPruned() = true;
     }
@@ -278,12 +408,20 @@ void DualTreeKMeans<DistanceType, MatType, TreeType>::UpdateTree(
   }
 
   // Recurse into children, and if all the children (and all the points) are
-  // pruned, then we can mark this as statically pruned.
-  bool allChildrenPruned = true;
+  // pruned, then we can mark this as statically pruned.  Children only touch
+  // their own subtrees and points, so large ones are updated in parallel tasks.
   for (size_t i = 0; i < node.NumChildren(); ++i)
   {
+    #pragma omp task default(shared) firstprivate(i) \
+        if(node.Child(i).NumDescendants() >= TaskMinDescendants)
     UpdateTree(node.Child(i), centroids, unadjustedUpperBound,
         adjustedUpperBound, unadjustedLowerBound, adjustedLowerBound);
+  }
+  #pragma omp taskwait
+
+  bool allChildrenPruned = true;
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+  {
     if (!node.Child(i).Stat().StaticPruned())
       allChildrenPruned = false;
   }
@@ -339,7 +477,7 @@ void DualTreeKMeans<DistanceType, MatType, TreeType>::UpdateTree(
         // Attempt to tighten the bound.
         upperBounds[index] = distance.Evaluate(dataset.col(index),
                                                centroids.col(owner));
-        ++distanceCalculations;
+        ++nodeDistanceCalculations;
         if (upperBounds[index] < pruningLowerBound)
         {
           prunedPoints[index] = true;
@@ -408,6 +546,9 @@ void DualTreeKMeans<DistanceType, MatType, TreeType>::UpdateTree(
           clusterDistances[centroids.n_cols];
     }
   }
+
+  #pragma omp atomic
+  distanceCalculations += nodeDistanceCalculations;
 }
 
 template<typename DistanceType,
@@ -25,7 +25,8 @@ class ElkanKMeans
 
   /**
    * Run a single iteration of Elkan's algorithm, updating the given centroids
-   * into the newCentroids matrix.
+   * into the newCentroids matrix.  If OpenMP is enabled, the points are split
+   * between threads.
    *
    * @param centroids Current cluster centroids.
    * @param newCentroids New cluster centroids.
@@ -53,8 +54,12 @@ class ElkanKMeans
 
   //! Upper bounds on the distance between each point and its closest cluster.
   arma::vec upperBounds;
-  //! Lower bounds on the distance between each point and each cluster.
+  //! Lower bounds on the distance between each point and each cluster.  Each
+  //! column holds the bounds of one point, so the bounds a thread works with
+  //! while processing a point are contiguous.
   arma::mat lowerBounds;
+  //! The centroids computed by the last iteration, which the bounds hold for.
+  arma::mat lastCentroids;
 
   //! Track distance calculations.
   size_t distanceCalculations;
@@ -45,9 +45,6 @@ double ElkanKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
   // being the closest cluster centroid.
   clusterDistances.diag().fill(DBL_MAX);
 
-  // Initially set r(x) to true.
-  std::vector<bool> mustRecalculate(dataset.n_cols, true);
-
   // If this is the first iteration, we must reset all the bounds.
   if (lowerBounds.n_rows != centroids.n_cols)
   {
@@ -59,9 +56,29 @@ double ElkanKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
     upperBounds.fill(DBL_MAX);
     assignments.fill(0);
   }
+  else if (lastCentroids.n_cols == centroids.n_cols &&
+      arma::any(arma::vectorise(lastCentroids != centroids)))
+  {
+    // The centroids are not the ones computed by the last iteration (an empty
+    // cluster was moved, or they were reduced from several partitions of the
+    // data), so the bounds are loosened by how far each centroid moved.
+    arma::vec shifts(centroids.n_cols);
+    for (size_t c = 0; c < centroids.n_cols; ++c)
+      shifts(c) = distance.Evaluate(lastCentroids.col(c), centroids.col(c));
+    distanceCalculations += centroids.n_cols;
+
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+    {
+      lowerBounds.unsafe_col(i) -= shifts;
+      upperBounds(i) += shifts(assignments[i]);
+    }
+  }
 
   // Step 1: for all centers, compute between-cluster distances.  For all
   // centers, compute s(c) = 1/2 min d(c, c').
+  #pragma omp parallel for reduction(+:distanceCalculations) \
+      schedule(dynamic, 16)
   for (size_t i = 0; i < centroids.n_cols; ++i)
   {
     for (size_t j = i + 1; j < centroids.n_cols; ++j)
@@ -78,7 +95,12 @@ double ElkanKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
   // that this is equivalent to s(c) for each cluster c.
   minClusterDistances = 0.5 * min(clusterDistances).t();
 
-  // Now loop over all points, and see which ones need to be updated.
+  // Now loop over all points, and see which ones need to be updated.  Each
+  // thread accumulates its own new centroids and counts, which are summed at
+  // the end of the loop.
+  #pragma omp parallel for reduction(+:distanceCalculations) \
+      reduction(matAdd:newCentroids) reduction(colAdd:counts) \
+      schedule(dynamic, 256)
   for (size_t i = 0; i < dataset.n_cols; ++i)
   {
     // Step 2: identify all points such that u(x) <= s(c(x)).
@@ -91,6 +113,8 @@ double ElkanKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
     }
     else
     {
+      // r(x) is true at the start of every iteration.
+      bool mustRecalculate = true;
       for (size_t c = 0; c < centroids.n_cols; ++c)
       {
         // Step 3: for all remaining points x and centers c such that c != c(x),
@@ -107,9 +131,9 @@ double ElkanKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
         // Step 3a: if r(x) then compute d(x, c(x)) and assign r(x) = false.
         // Otherwise, d(x, c(x)) = u(x).
         double dist;
-        if (mustRecalculate[i])
+        if (mustRecalculate)
         {
-          mustRecalculate[i] = false;
+          mustRecalculate = false;
           dist = distance.Evaluate(dataset.col(i),
                                    centroids.col(assignments[i]));
           lowerBounds(assignments[i], i) = dist;
@@ -156,6 +180,8 @@ double ElkanKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
   // Now, normalize and calculate the distance each cluster has moved.
   arma::vec moveDistances(centroids.n_cols);
   double cNorm = 0.0; // Cluster movement for residual.
+  #pragma omp parallel for reduction(+:distanceCalculations, cNorm) \
+      schedule(static)
   for (size_t c = 0; c < centroids.n_cols; ++c)
   {
     if (counts[c] > 0)
@@ -166,6 +192,7 @@ double ElkanKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
     distanceCalculations++;
   }
 
+  #pragma omp parallel for schedule(static)
   for (size_t i = 0; i < dataset.n_cols; ++i)
   {
     // Step 5: for each point x and center c, assign
@@ -180,6 +207,8 @@ double ElkanKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
     upperBounds(i) += moveDistances(assignments[i]);
   }
 
+  lastCentroids = newCentroids;
+
   return std::sqrt(cNorm);
 }
 
@@ -12,6 +12,8 @@
 #ifndef MLPACK_METHODS_KMEANS_HAMERLY_KMEANS_HPP
 #define MLPACK_METHODS_KMEANS_HAMERLY_KMEANS_HPP
 
+#include "centroid_distances.hpp"
+
 namespace mlpack {
 
 template<typename DistanceType, typename MatType>
@@ -20,7 +22,9 @@ class HamerlyKMeans
  public:
   /**
    * Construct the HamerlyKMeans object, which must store several sets of
-   * bounds.
+   * bounds.  The dataset may be dense or sparse and of any element type (for
+   * instance arma::fmat); the centroids are always computed in double
+   * precision.
    */
   HamerlyKMeans(const MatType& dataset, DistanceType& metric);
 
@@ -43,6 +47,8 @@ class HamerlyKMeans
   const MatType& dataset;
   //! The instantiated distance metric.
   DistanceType& distance;
+  //! Computes distances between points and centroids.
+  CentroidDistances<DistanceType, MatType> centroidDistances;
 
   //! Minimum cluster distances from each cluster.
   arma::vec minClusterDistances;
@@ -53,6 +59,8 @@ class HamerlyKMeans
   arma::vec lowerBounds;
   //! Assignments for each point.
   arma::Col<size_t> assignments;
+  //! The centroids computed by the last iteration, which the bounds hold for.
+  arma::mat lastCentroids;
 
   //! Track distance calculations.
   size_t distanceCalculations;
@@ -22,6 +22,7 @@ HamerlyKMeans<DistanceType, MatType>::HamerlyKMeans(const MatType& dataset,
                                                     DistanceType& distance) :
     dataset(dataset),
     distance(distance),
+    centroidDistances(dataset, distance),
     distanceCalculations(0)
 {
   // Nothing to do.
@@ -43,10 +44,30 @@ double HamerlyKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
     assignments.zeros(dataset.n_cols);
     minClusterDistances.set_size(centroids.n_cols);
   }
+  else if (lastCentroids.n_cols == centroids.n_cols &&
+      arma::any(arma::vectorise(lastCentroids != centroids)))
+  {
+    // The centroids are not the ones computed by the last iteration (an empty
+    // cluster was moved, or they were reduced from several partitions of the
+    // data), so the bounds are loosened by how far each centroid moved.
+    arma::vec shifts(centroids.n_cols);
+    for (size_t c = 0; c < centroids.n_cols; ++c)
+      shifts(c) = distance.Evaluate(lastCentroids.col(c), centroids.col(c));
+    distanceCalculations += centroids.n_cols;
+
+    const double maxShift = shifts.max();
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+    {
+      upperBounds(i) += shifts(assignments[i]);
+      lowerBounds(i) -= maxShift;
+    }
+  }
 
   // Reset new centroids.
   newCentroids.zeros(centroids.n_rows, centroids.n_cols);
   counts.zeros(centroids.n_cols);
+  centroidDistances.SetCentroids(centroids);
 
   // Calculate minimum intra-cluster distance for each cluster.
   minClusterDistances.fill(DBL_MAX);
@@ -76,20 +97,21 @@ double HamerlyKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
     if (upperBounds(i) <= m)
     {
       ++hamerlyPruned;
-      newCentroids.col(assignments[i]) += dataset.col(i);
+      CentroidDistances<DistanceType, MatType>::AddPoint(dataset, i,
+          newCentroids, assignments[i]);
       ++counts(assignments[i]);
       continue;
     }
 
     // Tighten upper bound.
-    upperBounds(i) = distance.Evaluate(dataset.col(i),
-                                       centroids.col(assignments[i]));
+    upperBounds(i) = centroidDistances.Evaluate(i, assignments[i]);
     ++distanceCalculations;
 
     // Second bound test.
     if (upperBounds(i) <= m)
     {
-      newCentroids.col(assignments[i]) += dataset.col(i);
+      CentroidDistances<DistanceType, MatType>::AddPoint(dataset, i,
+          newCentroids, assignments[i]);
       ++counts(assignments[i]);
       continue;
     }
@@ -103,7 +125,7 @@ double HamerlyKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
       if (c == assignments[i])
         continue;
 
-      const double dist = distance.Evaluate(dataset.col(i), centroids.col(c));
+      const double dist = centroidDistances.Evaluate(i, c);
 
       // Is this a better cluster?  At this point, upperBounds[i] = d(i, c(i)).
       if (dist < upperBounds(i))
@@ -122,7 +144,8 @@ double HamerlyKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
     distanceCalculations += centroids.n_cols - 1;
 
     // Update new centroids.
-    newCentroids.col(assignments[i]) += dataset.col(i);
+    CentroidDistances<DistanceType, MatType>::AddPoint(dataset, i,
+        newCentroids, assignments[i]);
     ++counts(assignments[i]);
   }
 
@@ -173,6 +196,8 @@ double HamerlyKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
       lowerBounds(i) -= furthestMovement;
   }
 
+  lastCentroids = newCentroids;
+
   Log::Info << "Hamerly prunes: " << hamerlyPruned << ".\n";
 
   return std::sqrt(centroidMovement);
@@ -14,9 +14,12 @@
 
 #include <mlpack/core.hpp>
 
+#include "centroid_distances.hpp"
+
 // Include initialization strategies.
 #include "sample_initialization.hpp"
 #include "kmeans_plus_plus_initialization.hpp"
+#include "kmeans_parallel_initialization.hpp"
 #include "random_partition.hpp"
 
 // Include empty cluster policies.
@@ -30,6 +33,9 @@
 #include "elkan_kmeans.hpp"
 #include "hamerly_kmeans.hpp"
 #include "pelleg_moore_kmeans.hpp"
+#include "mini_batch_kmeans.hpp"
+#include "yinyang_kmeans.hpp"
+#include "partitioned_kmeans.hpp"
 
 namespace mlpack {
 
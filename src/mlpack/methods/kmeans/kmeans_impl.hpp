@@ -185,7 +185,8 @@ Cluster(const MatType& data,
       centroids.zeros(data.n_rows, clusters);
       for (size_t i = 0; i < data.n_cols; ++i)
       {
-        centroids.col(assignments[i]) += arma::vec(data.col(i));
+        CentroidDistances<DistanceType, MatType>::AddPoint(data, i, centroids,
+            assignments[i]);
         counts[assignments[i]]++;
       }
 
@@ -289,7 +290,8 @@ Cluster(const MatType& data,
     centroids.zeros(data.n_rows, clusters);
     for (size_t i = 0; i < data.n_cols; ++i)
     {
-      centroids.col(assignments[i]) += arma::vec(data.col(i));
+      CentroidDistances<DistanceType, MatType>::AddPoint(data, i, centroids,
+          assignments[i]);
       counts[assignments[i]]++;
     }
 
@@ -303,6 +305,8 @@ Cluster(const MatType& data,
 
   // Calculate final assignments in parallel over the entire dataset.
   assignments.set_size(data.n_cols);
+  CentroidDistances<DistanceType, MatType> centroidDistances(data, distance);
+  centroidDistances.SetCentroids(centroids);
 
   #pragma omp parallel for
   for (size_t i = 0; i < (size_t) data.n_cols; ++i)
@@ -313,7 +317,7 @@ Cluster(const MatType& data,
 
     for (size_t j = 0; j < centroids.n_cols; ++j)
     {
-      const double dist = distance.Evaluate(data.col(i), centroids.col(j));
+      const double dist = centroidDistances.Evaluate(i, j);
 
       if (dist < minDistance)
       {
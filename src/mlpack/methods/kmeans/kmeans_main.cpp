@@ -21,10 +21,13 @@
 #include "kill_empty_clusters.hpp"
 #include "refined_start.hpp"
 #include "kmeans_plus_plus_initialization.hpp"
+#include "kmeans_parallel_initialization.hpp"
 #include "elkan_kmeans.hpp"
 #include "hamerly_kmeans.hpp"
 #include "pelleg_moore_kmeans.hpp"
 #include "dual_tree_kmeans.hpp"
+#include "mini_batch_kmeans.hpp"
+#include "yinyang_kmeans.hpp"
 
 using namespace mlpack;
 using namespace mlpack::util;
@@ -49,7 +52,9 @@ BINDING_LONG_DESC(
     "\n\n"
     "Optionally, the strategy to choose initial centroids can be specified.  "
     "The k-means++ algorithm can be used to choose initial centroids with "
-    "the " + PRINT_PARAM_STRING("kmeans_plus_plus") + " parameter.  The "
+    "the " + PRINT_PARAM_STRING("kmeans_plus_plus") + " parameter, and its "
+    "parallel k-means|| variant, which needs only a few passes over the data, "
+    "with the " + PRINT_PARAM_STRING("kmeans_parallel") + " parameter.  The "
     "Bradley and Fayyad approach (\"Refining initial points for k-means "
     "clustering\", 1998) can be used to select initial points by specifying "
     "the " + PRINT_PARAM_STRING("refined_start") + " parameter.  This approach "
@@ -64,9 +69,20 @@ BINDING_LONG_DESC(
     " option.  The standard O(kN) approach can be used ('naive').  Other "
     "options include the Pelleg-Moore tree-based algorithm ('pelleg-moore'), "
     "Elkan's triangle-inequality based algorithm ('elkan'), Hamerly's "
-    "modification to Elkan's algorithm ('hamerly'), the dual-tree k-means "
-    "algorithm ('dualtree'), and the dual-tree k-means algorithm using the "
-    "cover tree ('dualtree-covertree')."
+    "modification to Elkan's algorithm ('hamerly'), the Yinyang algorithm "
+    "('yinyang'), which keeps bounds for groups of clusters and works well for "
+    "large numbers of clusters, the dual-tree k-means algorithm "
+    "('dualtree'), the dual-tree k-means algorithm using the cover tree "
+    "('dualtree-covertree'), and the approximate mini-batch k-means "
+    "algorithm ('minibatch'), which updates the centroids with a random batch "
+    "of 1000 points in each iteration."
+    "\n\n"
+    "While clustering, the dataset can be held in single precision or as a "
+    "sparse matrix (for instance, for TF-IDF data) instead of as a dense "
+    "double-precision matrix, with the " + PRINT_PARAM_STRING("matrix_type") +
+    " parameter ('dense', 'float' or 'sparse').  The centroids are always "
+    "computed in double precision.  Only the 'naive' and 'hamerly' algorithms "
+    "support 'float' and 'sparse'."
     "\n\n"
     "The behavior for when an empty cluster is encountered can be modified with"
     " the " + PRINT_PARAM_STRING("allow_empty_clusters") + " option.  When "
@@ -155,10 +171,14 @@ PARAM_DOUBLE_IN("percentage", "Percentage of dataset to use for each refined "
     "start sampling (use when --refined_start is specified).", "p", 0.02);
 PARAM_FLAG("kmeans_plus_plus", "Use the k-means++ initialization strategy to "
     "choose initial points.", "K");
+PARAM_FLAG("kmeans_parallel", "Use the k-means|| (parallel k-means++) "
+    "initialization strategy to choose initial points.", "L");
 
 PARAM_STRING_IN("algorithm", "Algorithm to use for the Lloyd iteration "
-    "('naive', 'pelleg-moore', 'elkan', 'hamerly', 'dualtree', or "
-    "'dualtree-covertree').", "a", "naive");
+    "('naive', 'pelleg-moore', 'elkan', 'hamerly', 'yinyang', 'dualtree', "
+    "'dualtree-covertree', or 'minibatch').", "a", "naive");
+PARAM_STRING_IN("matrix_type", "Type of matrix to hold the dataset in while "
+    "clustering ('dense', 'float', or 'sparse').", "t", "dense");
 
 // Given the type of initial partition policy, figure out the empty cluster
 // policy and run k-means.
@@ -174,10 +194,20 @@ void FindLloydStepType(util::Params& params,
                        util::Timers& timers,
                        const InitialPartitionPolicy& ipp);
 
-// Given the template parameters, sanitize/load input and run k-means.
+// Given the initial partitioning policy, empty cluster policy and Lloyd
+// iteration step type, figure out the matrix type and run k-means.
 template<typename InitialPartitionPolicy,
          typename EmptyClusterPolicy,
          template<class, class> class LloydStepType>
+void FindMatrixType(util::Params& params,
+                    util::Timers& timers,
+                    const InitialPartitionPolicy& ipp);
+
+// Given the template parameters, sanitize/load input and run k-means.
+template<typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         template<class, class> class LloydStepType,
+         typename MatType = arma::mat>
 void RunKMeans(util::Params& params,
                util::Timers& timers,
                const InitialPartitionPolicy& ipp);
@@ -190,7 +220,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   else
     RandomSeed((size_t) std::time(NULL));
 
-  RequireOnlyOnePassed(params, { "refined_start", "kmeans_plus_plus" }, true,
+  RequireOnlyOnePassed(params, { "refined_start", "kmeans_plus_plus",
+      "kmeans_parallel" }, true,
       "Only one initialization strategy can be specified!", true);
 
   // Now, start building the KMeans type that we'll be using.  Start with the
@@ -214,6 +245,11 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     FindEmptyClusterPolicy<KMeansPlusPlusInitialization>(params, timers,
         KMeansPlusPlusInitialization());
   }
+  else if (params.Has("kmeans_parallel"))
+  {
+    FindEmptyClusterPolicy<KMeansParallelInitialization>(params, timers,
+        KMeansParallelInitialization());
+  }
   else
   {
     FindEmptyClusterPolicy<SampleInitialization>(params, timers,
@@ -260,10 +296,21 @@ void FindLloydStepType(util::Params& params,
                        const InitialPartitionPolicy& ipp)
 {
   RequireParamInSet<string>(params, "algorithm", { "elkan", "hamerly",
-      "pelleg-moore", "dualtree", "dualtree-covertree", "naive" }, true,
-      "unknown k-means algorithm");
+      "yinyang", "pelleg-moore", "dualtree", "dualtree-covertree", "naive",
+      "minibatch" },
+      true, "unknown k-means algorithm");
+  RequireParamInSet<string>(params, "matrix_type", { "dense", "float",
+      "sparse" }, true, "unknown matrix type");
 
   const string algorithm = params.Get<string>("algorithm");
+  if (params.Get<string>("matrix_type") != "dense" && algorithm != "naive" &&
+      algorithm != "hamerly")
+  {
+    Log::Fatal << "Only the 'naive' and 'hamerly' algorithms can be used with "
+        << "a " << PRINT_PARAM_STRING("matrix_type") << " of '"
+        << params.Get<string>("matrix_type") << "'!" << endl;
+  }
+
   if (algorithm == "elkan")
   {
     RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, ElkanKMeans>(params,
@@ -271,7 +318,12 @@ void FindLloydStepType(util::Params& params,
   }
   else if (algorithm == "hamerly")
   {
-    RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, HamerlyKMeans>(
+    FindMatrixType<InitialPartitionPolicy, EmptyClusterPolicy, HamerlyKMeans>(
+        params, timers, ipp);
+  }
+  else if (algorithm == "yinyang")
+  {
+    RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, YinyangKMeans>(
         params, timers, ipp);
   }
   else if (algorithm == "pelleg-moore")
@@ -291,15 +343,60 @@ void FindLloydStepType(util::Params& params,
   }
   else if (algorithm == "naive")
   {
-    RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, NaiveKMeans>(params,
-        timers, ipp);
+    FindMatrixType<InitialPartitionPolicy, EmptyClusterPolicy, NaiveKMeans>(
+        params, timers, ipp);
+  }
+  else if (algorithm == "minibatch")
+  {
+    RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, MiniBatchKMeans>(
+        params, timers, ipp);
   }
 }
 
-// Given the template parameters, sanitize/load input and run k-means.
+// Given the initial partitioning policy, empty cluster policy and Lloyd
+// iteration step type, figure out the matrix type and run k-means.
 template<typename InitialPartitionPolicy,
          typename EmptyClusterPolicy,
          template<class, class> class LloydStepType>
+void FindMatrixType(util::Params& params,
+                    util::Timers& timers,
+                    const InitialPartitionPolicy& ipp)
+{
+  const string matrixType = params.Get<string>("matrix_type");
+  if (matrixType == "float")
+  {
+    RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, LloydStepType,
+        arma::fmat>(params, timers, ipp);
+  }
+  else if (matrixType == "sparse")
+  {
+    RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, LloydStepType,
+        arma::sp_mat>(params, timers, ipp);
+  }
+  else
+  {
+    RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, LloydStepType>(
+        params, timers, ipp);
+  }
+}
+
+// Convert the dataset to a dense double-precision matrix that can be saved.
+template<typename MatType>
+arma::mat DatasetToOutput(MatType& dataset)
+{
+  if constexpr (std::is_same<MatType, arma::mat>::value)
+    return std::move(dataset);
+  else if constexpr (arma::is_SpMat<MatType>::value)
+    return arma::mat(dataset);
+  else
+    return ConvTo<arma::mat>::From(dataset);
+}
+
+// Given the template parameters, sanitize/load input and run k-means.
+template<typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         template<class, class> class LloydStepType,
+         typename MatType>
 void RunKMeans(util::Params& params,
                util::Timers& timers,
                const InitialPartitionPolicy& ipp)
@@ -330,7 +427,22 @@ void RunKMeans(util::Params& params,
   RequireOnlyOnePassed(params, { "in_place", "output", "centroid" }, false,
       "no results will be saved");
 
-  arma::mat dataset = params.Get<arma::mat>("input");  // Load our dataset.
+  // Load our dataset.  If it is to be held in another type of matrix, convert
+  // it and release the double-precision copy.
+  MatType dataset;
+  if constexpr (std::is_same<MatType, arma::mat>::value)
+  {
+    dataset = params.Get<arma::mat>("input");
+  }
+  else
+  {
+    if constexpr (arma::is_SpMat<MatType>::value)
+      dataset = MatType(params.Get<arma::mat>("input"));
+    else
+      dataset = ConvTo<MatType>::From(params.Get<arma::mat>("input"));
+
+    params.Get<arma::mat>("input").reset();
+  }
   arma::mat centroids;
 
   const bool initialCentroidGuess = params.Has("initial_centroids");
@@ -352,7 +464,8 @@ void RunKMeans(util::Params& params,
   KMeans<EuclideanDistance,
          InitialPartitionPolicy,
          EmptyClusterPolicy,
-         LloydStepType> kmeans(maxIterations, EuclideanDistance(), ipp);
+         LloydStepType,
+         MatType> kmeans(maxIterations, EuclideanDistance(), ipp);
 
   if (params.Has("output") || params.Has("in_place"))
   {
@@ -371,11 +484,12 @@ void RunKMeans(util::Params& params,
       for (size_t i = 0; i < assignments.n_elem; ++i)
         converted(i) = (double) assignments(i);
 
-      dataset.insert_rows(dataset.n_rows, converted);
+      arma::mat output = DatasetToOutput(dataset);
+      output.insert_rows(output.n_rows, converted);
 
       // Save the dataset.
       params.MakeInPlaceCopy("output", "input");
-      params.Get<arma::mat>("output") = std::move(dataset);
+      params.Get<arma::mat>("output") = std::move(output);
     }
     else
     {
@@ -393,10 +507,11 @@ void RunKMeans(util::Params& params,
         for (size_t i = 0; i < assignments.n_elem; ++i)
           converted(i) = (double) assignments(i);
 
-        dataset.insert_rows(dataset.n_rows, converted);
+        arma::mat output = DatasetToOutput(dataset);
+        output.insert_rows(output.n_rows, converted);
 
         // Now save, in the different file.
-        params.Get<arma::mat>("output") = std::move(dataset);
+        params.Get<arma::mat>("output") = std::move(output);
       }
     }
   }
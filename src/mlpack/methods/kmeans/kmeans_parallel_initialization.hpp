@@ -0,0 +1,142 @@
+/**
+ * @file methods/kmeans/kmeans_parallel_initialization.hpp
+ *
+ * This file implements the k-means|| ("scalable k-means++") initialization
+ * strategy.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_HPP
+#define MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "centroid_distances.hpp"
+
+namespace mlpack {
+
+/**
+ * This class implements the k-means|| initialization, as described in the
+ * following paper:
+ *
+ * @code
+ * @article{bahmani2012scalable,
+ *   title={Scalable k-means++},
+ *   author={Bahmani, Bahman and Moseley, Benjamin and Vattani, Andrea and
+ *       Kumar, Ravi and Vassilvitskii, Sergei},
+ *   journal={Proceedings of the VLDB Endowment},
+ *   volume={5},
+ *   number={7},
+ *   pages={622--633},
+ *   year={2012}
+ * }
+ * @endcode
+ *
+ * Instead of the k passes over the data that k-means++ needs, k-means|| runs a
+ * small number of rounds.  In each round, every point is sampled independently
+ * with probability proportional to its squared distance to the closest
+ * candidate chosen so far, so that about (oversampling * k) new candidates are
+ * chosen per round; the points are split between OpenMP threads.  Then, each
+ * candidate is weighted by the number of points closest to it, and the weighted
+ * candidates are clustered into k centroids with k-means++ seeding and a few
+ * weighted Lloyd iterations.
+ *
+ * Because each thread draws its own random numbers, the result depends on the
+ * number of threads, even with a fixed random seed.
+ */
+class KMeansParallelInitialization
+{
+ public:
+  /**
+   * Create the KMeansParallelInitialization object, optionally specifying the
+   * number of sampling rounds and the oversampling factor.
+   *
+   * @param rounds Number of sampling rounds.
+   * @param oversampling Expected number of candidates chosen in each round,
+   *     as a multiple of the number of clusters.
+   * @param reclusterIterations Number of weighted Lloyd iterations used to
+   *     cluster the candidates.
+   */
+  KMeansParallelInitialization(const size_t rounds = 5,
+                               const double oversampling = 2.0,
+                               const size_t reclusterIterations = 10) :
+      rounds(rounds),
+      oversampling(oversampling),
+      reclusterIterations(reclusterIterations) { }
+
+  /**
+   * Initialize the centroids matrix with the k-means|| algorithm.
+   *
+   * @tparam MatType Type of data (arma::mat or arma::sp_mat).
+   * @param data Dataset.
+   * @param clusters Number of clusters.
+   * @param centroids Matrix to put initial centroids into.
+   */
+  template<typename MatType>
+  void Cluster(const MatType& data,
+               const size_t clusters,
+               arma::mat& centroids) const;
+
+  //! Get the number of sampling rounds.
+  size_t Rounds() const { return rounds; }
+  //! Modify the number of sampling rounds.
+  size_t& Rounds() { return rounds; }
+
+  //! Get the oversampling factor.
+  double Oversampling() const { return oversampling; }
+  //! Modify the oversampling factor.
+  double& Oversampling() { return oversampling; }
+
+  //! Get the number of weighted Lloyd iterations used to cluster candidates.
+  size_t ReclusterIterations() const { return reclusterIterations; }
+  //! Modify the number of weighted Lloyd iterations used to cluster candidates.
+  size_t& ReclusterIterations() { return reclusterIterations; }
+
+  //! Serialize the object.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(rounds));
+    ar(CEREAL_NVP(oversampling));
+    ar(CEREAL_NVP(reclusterIterations));
+  }
+
+ private:
+  /**
+   * Update the squared distance of each point to its closest candidate, and
+   * the index of that candidate, with the candidates from firstCandidate to
+   * the end of the candidate matrix.
+   */
+  template<typename MatType>
+  static void UpdateDistances(const MatType& data,
+                              const arma::mat& candidates,
+                              const size_t firstCandidate,
+                              arma::vec& distances,
+                              arma::Col<size_t>& closest);
+
+  /**
+   * Cluster the given weighted candidates into the given number of centroids,
+   * with weighted k-means++ seeding followed by weighted Lloyd iterations.
+   */
+  void Recluster(const arma::mat& candidates,
+                 const arma::vec& weights,
+                 const size_t clusters,
+                 arma::mat& centroids) const;
+
+  //! The number of sampling rounds.
+  size_t rounds;
+  //! The expected number of candidates per round, as a multiple of k.
+  double oversampling;
+  //! The number of weighted Lloyd iterations used to cluster the candidates.
+  size_t reclusterIterations;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "kmeans_parallel_initialization_impl.hpp"
+
+#endif
@@ -0,0 +1,224 @@
+/**
+ * @file methods/kmeans/kmeans_parallel_initialization_impl.hpp
+ *
+ * Implementation of the k-means|| ("scalable k-means++") initialization
+ * strategy.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "kmeans_parallel_initialization.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+void KMeansParallelInitialization::Cluster(const MatType& data,
+                                           const size_t clusters,
+                                           arma::mat& centroids) const
+{
+  if (clusters > data.n_cols)
+  {
+    throw std::invalid_argument("KMeansParallelInitialization::Cluster(): "
+        "number of clusters must not be greater than the number of points!");
+  }
+
+  // The first candidate is sampled fully randomly.
+  arma::mat candidates(data.n_rows, 1);
+  candidates.col(0) = CentroidDistances<SquaredEuclideanDistance,
+      MatType>::Point(data, RandInt(0, data.n_cols));
+
+  // The squared distance of each point to its closest candidate, and the index
+  // of that candidate.
+  arma::vec distances(data.n_cols);
+  arma::Col<size_t> closest(data.n_cols);
+  distances.fill(DBL_MAX);
+  closest.zeros();
+  UpdateDistances(data, candidates, 0, distances, closest);
+
+  const double expectedSamples = oversampling * clusters;
+  for (size_t r = 0; r < rounds; ++r)
+  {
+    const double cost = arma::accu(distances);
+    if (cost == 0.0)
+      break; // Every point is already a candidate.
+
+    // Sample each point independently, with probability proportional to its
+    // squared distance to the closest candidate.
+    std::vector<size_t> sampled;
+    #pragma omp parallel
+    {
+      std::vector<size_t> threadSampled;
+
+      #pragma omp for schedule(static) nowait
+      for (size_t i = 0; i < (size_t) data.n_cols; ++i)
+      {
+        if (Random() < expectedSamples * distances[i] / cost)
+          threadSampled.push_back(i);
+      }
+
+      #pragma omp critical
+      sampled.insert(sampled.end(), threadSampled.begin(),
+          threadSampled.end());
+    }
+
+    if (sampled.empty())
+      continue;
+
+    // Keep the candidates in dataset order, whatever the thread scheduling.
+    std::sort(sampled.begin(), sampled.end());
+
+    const size_t firstCandidate = candidates.n_cols;
+    candidates.resize(data.n_rows, firstCandidate + sampled.size());
+    for (size_t i = 0; i < sampled.size(); ++i)
+    {
+      candidates.col(firstCandidate + i) = CentroidDistances<
+          SquaredEuclideanDistance, MatType>::Point(data, sampled[i]);
+    }
+
+    UpdateDistances(data, candidates, firstCandidate, distances, closest);
+  }
+
+  // If there are not enough candidates, use all of them and fill the rest of
+  // the centroids with random points.
+  if (candidates.n_cols <= clusters)
+  {
+    centroids.set_size(data.n_rows, clusters);
+    centroids.cols(0, candidates.n_cols - 1) = candidates;
+    for (size_t i = candidates.n_cols; i < clusters; ++i)
+    {
+      centroids.col(i) = CentroidDistances<SquaredEuclideanDistance,
+          MatType>::Point(data, RandInt(0, data.n_cols));
+    }
+
+    return;
+  }
+
+  // Weight each candidate by the number of points closest to it.
+  arma::vec weights(candidates.n_cols);
+  weights.zeros();
+  for (size_t i = 0; i < data.n_cols; ++i)
+    weights[closest[i]] += 1.0;
+
+  Recluster(candidates, weights, clusters, centroids);
+}
+
+template<typename MatType>
+void KMeansParallelInitialization::UpdateDistances(
+    const MatType& data,
+    const arma::mat& candidates,
+    const size_t firstCandidate,
+    arma::vec& distances,
+    arma::Col<size_t>& closest)
+{
+  SquaredEuclideanDistance metric;
+  CentroidDistances<SquaredEuclideanDistance, MatType> candidateDistances(data,
+      metric);
+  candidateDistances.SetCentroids(candidates);
+
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < (size_t) data.n_cols; ++i)
+  {
+    for (size_t j = firstCandidate; j < candidates.n_cols; ++j)
+    {
+      const double distance = candidateDistances.Evaluate(i, j);
+      if (distance < distances[i])
+      {
+        distances[i] = distance;
+        closest[i] = j;
+      }
+    }
+  }
+}
+
+inline void KMeansParallelInitialization::Recluster(
+    const arma::mat& candidates,
+    const arma::vec& weights,
+    const size_t clusters,
+    arma::mat& centroids) const
+{
+  centroids.set_size(candidates.n_rows, clusters);
+
+  // Weighted k-means++ seeding: a candidate is chosen with probability
+  // proportional to its weight times its squared distance to the closest
+  // chosen centroid.
+  arma::vec distances(candidates.n_cols);
+  distances.fill(DBL_MAX);
+  arma::vec cdf(candidates.n_cols);
+  for (size_t c = 0; c < clusters; ++c)
+  {
+    if (c == 0)
+      cdf = arma::cumsum(weights);
+    else
+      cdf = arma::cumsum(weights % distances);
+
+    size_t position;
+    if (cdf[cdf.n_elem - 1] > 0.0)
+    {
+      const double sampleValue = Random() * cdf[cdf.n_elem - 1];
+      position = (size_t) (std::upper_bound(cdf.begin(), cdf.end(),
+          sampleValue) - cdf.begin());
+      position = std::min(position, (size_t) cdf.n_elem - 1);
+    }
+    else
+    {
+      // All remaining candidates coincide with chosen centroids.
+      position = RandInt(0, candidates.n_cols);
+    }
+    centroids.col(c) = candidates.col(position);
+
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < candidates.n_cols; ++i)
+    {
+      distances[i] = std::min(distances[i],
+          SquaredEuclideanDistance::Evaluate(candidates.col(i),
+          centroids.col(c)));
+    }
+  }
+
+  // Now refine the centroids with weighted Lloyd iterations on the candidates.
+  for (size_t it = 0; it < reclusterIterations; ++it)
+  {
+    arma::mat sums(centroids.n_rows, clusters);
+    arma::mat clusterWeights(1, clusters);
+    sums.zeros();
+    clusterWeights.zeros();
+
+    #pragma omp parallel for reduction(matAdd:sums) \
+        reduction(matAdd:clusterWeights) schedule(static)
+    for (size_t i = 0; i < candidates.n_cols; ++i)
+    {
+      double minDistance = DBL_MAX;
+      size_t closestCluster = 0;
+      for (size_t c = 0; c < clusters; ++c)
+      {
+        const double distance = SquaredEuclideanDistance::Evaluate(
+            candidates.col(i), centroids.col(c));
+        if (distance < minDistance)
+        {
+          minDistance = distance;
+          closestCluster = c;
+        }
+      }
+
+      sums.col(closestCluster) += weights[i] * candidates.col(i);
+      clusterWeights[closestCluster] += weights[i];
+    }
+
+    // Centroids that own no weight stay where they are.
+    for (size_t c = 0; c < clusters; ++c)
+    {
+      if (clusterWeights[c] > 0.0)
+        centroids.col(c) = sums.col(c) / clusterWeights[c];
+    }
+  }
+}
+
+} // namespace mlpack
+
+#endif
@@ -14,6 +14,8 @@
 
 #include <mlpack/core.hpp>
 
+#include "centroid_distances.hpp"
+
 namespace mlpack {
 
 /**
@@ -55,11 +57,16 @@ class KMeansPlusPlusInitialization
                              const size_t clusters,
                              arma::mat& centroids)
   {
-    centroids.set_size(data.n_rows, clusters);
+    typedef CentroidDistances<SquaredEuclideanDistance, MatType>
+        DistancesType;
+
+    centroids.zeros(data.n_rows, clusters);
 
     // We'll sample our first point fully randomly.
     size_t firstPoint = RandInt(0, data.n_cols);
-    centroids.col(0) = data.col(firstPoint);
+    centroids.col(0) = DistancesType::Point(data, firstPoint);
+    SquaredEuclideanDistance metric;
+    DistancesType centroidDistances(data, metric);
 
     // Utility variable.
     arma::vec distribution(data.n_cols);
@@ -74,13 +81,13 @@ class KMeansPlusPlusInitialization
       // This computation is ripe for speedup with trees!  I am not sure exactly
       // how much we would need to approximate, but I think it could be done
       // without breaking the O(log k)-competitive guarantee (I think).
+      centroidDistances.SetCentroids(centroids);
       for (size_t p = 0; p < data.n_cols; ++p)
       {
         double minDistance = std::numeric_limits<double>::max();
         for (size_t j = 0; j < i; ++j)
         {
-          const double distance = SquaredEuclideanDistance::Evaluate(
-              data.col(p), centroids.col(j));
+          const double distance = centroidDistances.Evaluate(p, j);
           minDistance = std::min(distance, minDistance);
         }
 
@@ -101,7 +108,7 @@ class KMeansPlusPlusInitialization
           distribution.end(), sampleValue);
       const size_t position = (size_t)
           (elem - distribution.begin()) / sizeof(double);
-      centroids.col(i) = data.col(position);
+      centroids.col(i) = DistancesType::Point(data, position);
     }
   }
 };
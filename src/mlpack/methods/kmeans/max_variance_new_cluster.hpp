@@ -16,6 +16,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "centroid_distances.hpp"
+
 namespace mlpack {
 
 /**
@@ -44,14 +44,17 @@ void MaxVarianceNewCluster::EmptyCluster(const MatType& data,
     return;
 
   // Now, inside this cluster, find the point which is furthest away.
+  typedef CentroidDistances<DistanceType, MatType> DistancesType;
+  DistancesType centroidDistances(data, distance);
+  centroidDistances.SetCentroids(newCentroids);
   size_t furthestPoint = data.n_cols;
   double maxDistance = -DBL_MAX;
   for (size_t i = 0; i < data.n_cols; ++i)
   {
     if (assignments[i] == maxVarCluster)
     {
-      const double dist = std::pow(distance.Evaluate(data.col(i),
-          newCentroids.col(maxVarCluster)), 2.0);
+      const double dist = std::pow(centroidDistances.Evaluate(i,
+          maxVarCluster), 2.0);
 
       if (dist > maxDistance)
       {
@@ -62,13 +65,14 @@ void MaxVarianceNewCluster::EmptyCluster(const MatType& data,
   }
 
   // Take that point and add it to the empty cluster.
+  const arma::vec point = DistancesType::Point(data, furthestPoint);
   newCentroids.col(maxVarCluster) *= (double(clusterCounts[maxVarCluster]) /
       double(clusterCounts[maxVarCluster] - 1));
   newCentroids.col(maxVarCluster) -= (1.0 / (clusterCounts[maxVarCluster] -
-      1.0)) * arma::vec(data.col(furthestPoint));
+      1.0)) * point;
   clusterCounts[maxVarCluster]--;
   clusterCounts[emptyCluster]++;
-  newCentroids.col(emptyCluster) = arma::vec(data.col(furthestPoint));
+  newCentroids.col(emptyCluster) = point;
   assignments[furthestPoint] = emptyCluster;
 
   // Modify the variances, as necessary.
@@ -121,6 +125,8 @@ void MaxVarianceNewCluster::Precalculate(const MatType& data,
   // dataset.
   variances.zeros(oldCentroids.n_cols);
   assignments.set_size(data.n_cols);
+  CentroidDistances<DistanceType, MatType> centroidDistances(data, distance);
+  centroidDistances.SetCentroids(oldCentroids);
 
   // Add the variance of each point's distance away from the cluster.  I think
   // this is the sensible thing to do.
@@ -132,7 +138,7 @@ void MaxVarianceNewCluster::Precalculate(const MatType& data,
 
     for (size_t j = 0; j < oldCentroids.n_cols; ++j)
     {
-      const double dist = distance.Evaluate(data.col(i), oldCentroids.col(j));
+      const double dist = centroidDistances.Evaluate(i, j);
 
       if (dist < minDistance)
       {
@@ -142,8 +148,7 @@ void MaxVarianceNewCluster::Precalculate(const MatType& data,
     }
 
     assignments[i] = closestCluster;
-    variances[closestCluster] += std::pow(distance.Evaluate(data.col(i),
-        oldCentroids.col(closestCluster)), 2.0);
+    variances[closestCluster] += std::pow(minDistance, 2.0);
   }
 
   // Divide by the number of points in the cluster to produce the variance,
@@ -0,0 +1,109 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans.hpp
+ *
+ * An implementation of a mini-batch step for k-means clustering, which updates
+ * the centroids using only a random batch of points in each iteration.  This
+ * can be a good choice for very large datasets, where full Lloyd iterations are
+ * too expensive.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * An implementation of the mini-batch k-means step of Sculley.  Instead of
+ * assigning every point in the dataset, each call to Iterate() samples a batch
+ * of points (with replacement), finds the closest centroid to each of them, and
+ * moves each centroid towards its batch points with a per-centroid learning
+ * rate of 1 / (number of points assigned to the centroid so far).  Each
+ * centroid is therefore the running mean of all the batch points that were ever
+ * assigned to it.
+ *
+ * The result is only an approximation of the result of Lloyd's algorithm, and
+ * the residual returned by Iterate() is the movement of the centroids for one
+ * batch, so KMeans will usually run until its maximum number of iterations.
+ *
+ * For more information, see
+ *
+ * @code
+ * @inproceedings{sculley2010web,
+ *   title={Web-scale k-means clustering},
+ *   author={Sculley, David},
+ *   booktitle={Proceedings of the 19th International Conference on World Wide
+ *       Web (WWW '10)},
+ *   pages={1177--1178},
+ *   year={2010}
+ * }
+ * @endcode
+ *
+ * @tparam DistanceType Type of distance metric used with this implementation.
+ * @tparam MatType Matrix type (arma::mat or arma::sp_mat).
+ */
+template<typename DistanceType, typename MatType>
+class MiniBatchKMeans
+{
+ public:
+  /**
+   * Construct the MiniBatchKMeans object with the given dataset and distance
+   * metric.  KMeans uses the default batch size.
+   *
+   * @param dataset Dataset.
+   * @param distance Instantiated distance metric.
+   * @param batchSize Number of points sampled in each iteration.
+   */
+  MiniBatchKMeans(const MatType& dataset,
+                  DistanceType& distance,
+                  const size_t batchSize = 1000);
+
+  /**
+   * Run a single mini-batch iteration, updating the given centroids into the
+   * newCentroids matrix.  The counts are the number of batch points that have
+   * been assigned to each cluster in all iterations so far; the counts are
+   * reset if the number of clusters changes.
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Number of points assigned to each cluster so far.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  //! Get the number of distance calculations.
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+  //! Get the number of points sampled in each iteration.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of points sampled in each iteration.
+  size_t& BatchSize() { return batchSize; }
+
+ private:
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated distance metric.
+  DistanceType& distance;
+
+  //! The number of points sampled in each iteration.
+  size_t batchSize;
+  //! The number of batch points assigned to each cluster so far; the learning
+  //! rate of each cluster is the inverse of this.
+  arma::Col<size_t> clusterCounts;
+
+  //! Number of distance calculations.
+  size_t distanceCalculations;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "mini_batch_kmeans_impl.hpp"
+
+#endif
@@ -0,0 +1,112 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans_impl.hpp
+ *
+ * Implementation of the mini-batch step for k-means clustering.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mini_batch_kmeans.hpp"
+
+namespace mlpack {
+
+template<typename DistanceType, typename MatType>
+MiniBatchKMeans<DistanceType, MatType>::MiniBatchKMeans(
+    const MatType& dataset,
+    DistanceType& distance,
+    const size_t batchSize) :
+    dataset(dataset),
+    distance(distance),
+    batchSize(batchSize),
+    distanceCalculations(0)
+{
+  if (batchSize == 0)
+    throw std::invalid_argument("MiniBatchKMeans::MiniBatchKMeans(): batch "
+        "size must be greater than 0!");
+}
+
+// Run a single iteration.
+template<typename DistanceType, typename MatType>
+double MiniBatchKMeans<DistanceType, MatType>::Iterate(
+    const arma::mat& centroids,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts)
+{
+  // If this is the first iteration (or the number of clusters changed), no
+  // points have been assigned yet.
+  if (clusterCounts.n_elem != centroids.n_cols)
+    clusterCounts.zeros(centroids.n_cols);
+
+  // Sample the batch.
+  arma::Col<size_t> batch(batchSize);
+  for (size_t i = 0; i < batchSize; ++i)
+    batch[i] = RandInt(0, dataset.n_cols);
+
+  // Find the closest centroid to each batch point, and sum the batch points
+  // assigned to each centroid.
+  arma::mat batchSums(centroids.n_rows, centroids.n_cols);
+  arma::Col<size_t> batchCounts(centroids.n_cols);
+  batchSums.zeros();
+  batchCounts.zeros();
+
+  #pragma omp parallel for reduction(matAdd:batchSums) \
+      reduction(colAdd:batchCounts) schedule(static)
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    double minDistance = std::numeric_limits<double>::infinity();
+    size_t closestCluster = centroids.n_cols; // Invalid value.
+
+    for (size_t j = 0; j < centroids.n_cols; ++j)
+    {
+      const double dist = distance.Evaluate(dataset.col(batch[i]),
+          centroids.col(j));
+      if (dist < minDistance)
+      {
+        minDistance = dist;
+        closestCluster = j;
+      }
+    }
+
+    Log::Assert(closestCluster != centroids.n_cols);
+
+    batchSums.col(closestCluster) += dataset.col(batch[i]);
+    ++batchCounts[closestCluster];
+  }
+  distanceCalculations += batchSize * centroids.n_cols;
+
+  // Taking a gradient step with learning rate 1 / v(c) for each batch point,
+  // where v(c) counts the points assigned to c so far, makes every centroid the
+  // running mean of its points; so the steps for a whole batch are
+  //   c <- (v(c) c + sum of new points) / (v(c) + number of new points).
+  // Clusters that got no batch points do not move.
+  newCentroids = centroids;
+  double cNorm = 0.0;
+  for (size_t c = 0; c < centroids.n_cols; ++c)
+  {
+    if (batchCounts[c] == 0)
+      continue;
+
+    const size_t total = clusterCounts[c] + batchCounts[c];
+    newCentroids.col(c) = (double(clusterCounts[c]) * centroids.col(c) +
+        batchSums.col(c)) / total;
+    clusterCounts[c] = total;
+
+    cNorm += std::pow(distance.Evaluate(centroids.col(c), newCentroids.col(c)),
+        2.0);
+    ++distanceCalculations;
+  }
+
+  counts = clusterCounts;
+
+  return std::sqrt(cNorm);
+}
+
+} // namespace mlpack
+
+#endif
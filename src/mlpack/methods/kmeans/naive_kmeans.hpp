@@ -17,6 +17,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "centroid_distances.hpp"
+
 namespace mlpack {
 
 /**
@@ -25,8 +27,13 @@ namespace mlpack {
  * looking for the KMeans class instead of this one.  This class is used by
  * KMeans as the actual implementation of the Lloyd iteration.
  *
+ * The dataset may be dense or sparse and of any element type (for instance
+ * arma::fmat); the centroids are always computed in double precision.  For
+ * sparse data and the Euclidean distance, distances are computed with cached
+ * norms (see CentroidDistances).
+ *
  * @param DistanceType Type of distance metric used with this implementation.
- * @param MatType Matrix type (arma::mat or arma::sp_mat).
+ * @param MatType Matrix type (arma::mat, arma::fmat, arma::sp_mat, ...).
  */
 template<typename DistanceType, typename MatType>
 class NaiveKMeans
@@ -62,6 +69,8 @@ class NaiveKMeans
   const MatType& dataset;
   //! The instantiated distance metric.
   DistanceType& distance;
+  //! Computes distances between points and centroids.
+  CentroidDistances<DistanceType, MatType> centroidDistances;
 
   //! Number of distance calculations.
   size_t distanceCalculations;
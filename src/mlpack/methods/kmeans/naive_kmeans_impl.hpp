@@ -26,6 +26,7 @@ NaiveKMeans<DistanceType, MatType>::NaiveKMeans(const MatType& dataset,
                                                 DistanceType& distance) :
     dataset(dataset),
     distance(distance),
+    centroidDistances(dataset, distance),
     distanceCalculations(0)
 { /* Nothing to do. */ }
 
@@ -37,6 +38,7 @@ double NaiveKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
 {
   newCentroids.zeros(centroids.n_rows, centroids.n_cols);
   counts.zeros(centroids.n_cols);
+  centroidDistances.SetCentroids(centroids);
 
   // Find the closest centroid to each point and update the new centroids.
   // Computed in parallel over the complete dataset
@@ -55,8 +57,7 @@ double NaiveKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
 
       for (size_t j = 0; j < centroids.n_cols; ++j)
       {
-        const double dist = distance.Evaluate(dataset.col(i),
-            centroids.col(j));
+        const double dist = centroidDistances.Evaluate(i, j);
         if (dist < minDistance)
         {
           minDistance = dist;
@@ -67,7 +68,8 @@ double NaiveKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
       Log::Assert(closestCluster != centroids.n_cols);
 
       // We now have the minimum distance centroid index.  Update that centroid.
-      localCentroids.col(closestCluster) += dataset.col(i);
+      CentroidDistances<DistanceType, MatType>::AddPoint(dataset, i,
+          localCentroids, closestCluster);
       localCounts(closestCluster)++;
     }
     // Combine calculated state from each thread
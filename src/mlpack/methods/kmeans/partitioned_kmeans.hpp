@@ -0,0 +1,123 @@
+/**
+ * @file methods/kmeans/partitioned_kmeans.hpp
+ *
+ * A step of the Lloyd algorithm for k-means clustering that splits the dataset
+ * into partitions, runs another Lloyd step on each partition independently, and
+ * reduces the centroids and counts of the partitions into the new centroids.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_PARTITIONED_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_PARTITIONED_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "naive_kmeans.hpp"
+
+namespace mlpack {
+
+/**
+ * A single iteration of Lloyd's algorithm in which the dataset is split into
+ * partitions of contiguous points, and each partition is handled by its own
+ * Lloyd step (NaiveKMeans, HamerlyKMeans or ElkanKMeans), with its own bounds.
+ * The partitions are processed in parallel, and the new centroids are the
+ * means of the centroids of the partitions, weighted by their counts.  This is
+ * the same scheme that is used when each partition is held by a different
+ * process: each one runs its Lloyd step with the reduced centroids, and only
+ * its centroids and counts are reduced at each iteration.
+ *
+ * To use another Lloyd step than NaiveKMeans with KMeans, use an alias
+ * template:
+ *
+ * @code
+ * template<typename DistanceType, typename MatType>
+ * using PartitionedHamerlyKMeans =
+ *     PartitionedKMeans<DistanceType, MatType, HamerlyKMeans>;
+ *
+ * KMeans<EuclideanDistance, SampleInitialization, MaxVarianceNewCluster,
+ *     PartitionedHamerlyKMeans> kmeans;
+ * @endcode
+ *
+ * @tparam DistanceType Type of distance metric used with this implementation.
+ * @tparam MatType Matrix type (arma::mat, arma::fmat, arma::sp_mat, ...).
+ * @tparam LloydStepType Lloyd step to run on each partition.
+ */
+template<typename DistanceType,
+         typename MatType,
+         template<class, class> class LloydStepType = NaiveKMeans>
+class PartitionedKMeans
+{
+ public:
+  /**
+   * Construct the PartitionedKMeans object, splitting the dataset into the
+   * given number of partitions.
+   *
+   * @param dataset Dataset.
+   * @param distance Instantiated distance metric.
+   * @param numPartitions Number of partitions; if 0, one for each OpenMP
+   *     thread.
+   */
+  PartitionedKMeans(const MatType& dataset,
+                    DistanceType& distance,
+                    const size_t numPartitions = 0);
+
+  /**
+   * Run a single iteration of the Lloyd step on each partition, and reduce the
+   * results into the new centroids.  As with NaiveKMeans, the centroids of
+   * empty clusters are filled with zeros (they will be corrected later).
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Number of points in each cluster at the end of the iteration.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  /**
+   * Reduce the centroids and counts computed on several partitions of a
+   * dataset into the centroids and counts of the whole dataset.
+   *
+   * @param partialCentroids Centroids computed on each partition.
+   * @param partialCounts Counts computed on each partition.
+   * @param newCentroids Centroids of the whole dataset.
+   * @param counts Counts of the whole dataset.
+   */
+  static void Reduce(const std::vector<arma::mat>& partialCentroids,
+                     const std::vector<arma::Col<size_t>>& partialCounts,
+                     arma::mat& newCentroids,
+                     arma::Col<size_t>& counts);
+
+  //! Get the number of partitions.
+  size_t NumPartitions() const { return partitions.size(); }
+
+  //! Get the number of distance calculations, over all partitions.
+  size_t DistanceCalculations() const;
+
+ private:
+  //! The instantiated distance metric.
+  DistanceType& distance;
+
+  //! The partitions of the dataset (aliases, for dense matrices).
+  std::vector<MatType> partitions;
+  //! The Lloyd step of each partition.
+  std::vector<std::unique_ptr<LloydStepType<DistanceType, MatType>>> steps;
+
+  //! The centroids of each partition, computed by the last iteration.
+  std::vector<arma::mat> partialCentroids;
+  //! The counts of each partition, computed by the last iteration.
+  std::vector<arma::Col<size_t>> partialCounts;
+
+  //! Track distance calculations for the residuals.
+  size_t distanceCalculations;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "partitioned_kmeans_impl.hpp"
+
+#endif
@@ -0,0 +1,157 @@
+/**
+ * @file methods/kmeans/partitioned_kmeans_impl.hpp
+ *
+ * Implementation of the PartitionedKMeans Lloyd step.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_PARTITIONED_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_PARTITIONED_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "partitioned_kmeans.hpp"
+
+namespace mlpack {
+
+template<typename DistanceType,
+         typename MatType,
+         template<class, class> class LloydStepType>
+PartitionedKMeans<DistanceType, MatType, LloydStepType>::PartitionedKMeans(
+    const MatType& dataset,
+    DistanceType& distance,
+    const size_t numPartitions) :
+    distance(distance),
+    distanceCalculations(0)
+{
+  size_t partitionCount = numPartitions;
+  if (partitionCount == 0)
+  {
+    #ifdef MLPACK_USE_OPENMP
+      partitionCount = omp_get_max_threads();
+    #else
+      partitionCount = 1;
+    #endif
+  }
+  partitionCount = std::max(std::min(partitionCount, (size_t) dataset.n_cols),
+      (size_t) 1);
+
+  // Each partition holds contiguous points.  All the partitions must exist
+  // before the Lloyd steps are built, since they hold references to them.
+  partitions.resize(partitionCount);
+  for (size_t p = 0; p < partitionCount; ++p)
+  {
+    const size_t begin = p * dataset.n_cols / partitionCount;
+    const size_t end = (p + 1) * dataset.n_cols / partitionCount;
+    if constexpr (arma::is_SpMat<MatType>::value)
+    {
+      if (end > begin)
+        partitions[p] = dataset.cols(begin, end - 1);
+      else
+        partitions[p].set_size(dataset.n_rows, 0);
+    }
+    else
+    {
+      MakeAlias(partitions[p], dataset, dataset.n_rows, end - begin,
+          begin * dataset.n_rows);
+    }
+  }
+
+  for (size_t p = 0; p < partitionCount; ++p)
+  {
+    steps.emplace_back(new LloydStepType<DistanceType, MatType>(partitions[p],
+        distance));
+  }
+
+  partialCentroids.resize(partitionCount);
+  partialCounts.resize(partitionCount);
+}
+
+// Run a single iteration.
+template<typename DistanceType,
+         typename MatType,
+         template<class, class> class LloydStepType>
+double PartitionedKMeans<DistanceType, MatType, LloydStepType>::Iterate(
+    const arma::mat& centroids,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts)
+{
+  // Each partition is independent until the reduction.
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (size_t p = 0; p < steps.size(); ++p)
+    steps[p]->Iterate(centroids, partialCentroids[p], partialCounts[p]);
+
+  Reduce(partialCentroids, partialCounts, newCentroids, counts);
+
+  // The residual is the movement of the reduced centroids; the residuals of
+  // the partitions are not meaningful on their own.
+  double cNorm = 0.0;
+  #pragma omp parallel for reduction(+:cNorm) schedule(static)
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+  {
+    cNorm += std::pow(distance.Evaluate(centroids.col(i), newCentroids.col(i)),
+        2.0);
+  }
+  distanceCalculations += centroids.n_cols;
+
+  return std::sqrt(cNorm);
+}
+
+// Reduce the results of the partitions.
+template<typename DistanceType,
+         typename MatType,
+         template<class, class> class LloydStepType>
+void PartitionedKMeans<DistanceType, MatType, LloydStepType>::Reduce(
+    const std::vector<arma::mat>& partialCentroids,
+    const std::vector<arma::Col<size_t>>& partialCounts,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts)
+{
+  if (partialCentroids.empty() ||
+      partialCentroids.size() != partialCounts.size())
+  {
+    throw std::invalid_argument("PartitionedKMeans::Reduce(): there must be "
+        "centroids and counts for each of at least one partition");
+  }
+
+  newCentroids.zeros(partialCentroids[0].n_rows, partialCentroids[0].n_cols);
+  counts.zeros(partialCentroids[0].n_cols);
+
+  // The partitions are reduced in order, so that the result does not depend
+  // on the scheduling of the partitions.  The centroids of empty clusters may
+  // be invalid, so they are skipped.
+  for (size_t p = 0; p < partialCentroids.size(); ++p)
+  {
+    for (size_t c = 0; c < newCentroids.n_cols; ++c)
+    {
+      if (partialCounts[p][c] == 0)
+        continue;
+
+      newCentroids.col(c) += (double) partialCounts[p][c] *
+          partialCentroids[p].col(c);
+      counts[c] += partialCounts[p][c];
+    }
+  }
+
+  for (size_t c = 0; c < newCentroids.n_cols; ++c)
+    if (counts[c] != 0)
+      newCentroids.col(c) /= counts[c];
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<class, class> class LloydStepType>
+size_t PartitionedKMeans<DistanceType, MatType, LloydStepType>::
+DistanceCalculations() const
+{
+  size_t total = distanceCalculations;
+  for (size_t p = 0; p < steps.size(); ++p)
+    total += steps[p]->DistanceCalculations();
+  return total;
+}
+
+} // namespace mlpack
+
+#endif
@@ -53,7 +53,8 @@ class PellegMooreKMeans
 
   /**
    * Run a single iteration of the Pelleg-Moore blacklist algorithm, updating
-   * the given centroids into the newCentroids matrix.
+   * the given centroids into the newCentroids matrix.  If OpenMP is enabled,
+   * disjoint subtrees of the kd-tree are traversed by different threads.
    *
    * @param centroids Current cluster centroids.
    * @param newCentroids New cluster centroids.
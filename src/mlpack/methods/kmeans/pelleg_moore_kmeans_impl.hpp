@@ -52,12 +52,74 @@ double PellegMooreKMeans<DistanceType, MatType>::Iterate(
   typedef PellegMooreKMeansRules<DistanceType, TreeType> RulesType;
   RulesType rules(dataset, centroids, newCentroids, counts, distance);
 
-  // Use single-tree traverser.
-  typename TreeType::template SingleTreeTraverser<RulesType> traverser(rules);
+  #ifdef MLPACK_USE_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  #else
+  const size_t numThreads = 1;
+  #endif
 
-  // Now, do a traversal with a fake query index (since the query index is
-  // irrelevant; we are checking each node with all clusters.
-  traverser.Traverse(0, *tree);
+  // Split the tree into disjoint subtrees, by repeatedly replacing the largest
+  // subtree with its children, until there are a few subtrees for each thread.
+  // A node's blacklist depends only on its parent, so the children of each
+  // replaced node are scored here, as the traverser would do; children that
+  // are dominated by one cluster need no traversal.  With one thread, the whole
+  // tree is traversed at once, as before.
+  std::vector<TreeType*> subtrees(1, tree);
+  const size_t numSubtrees = (numThreads == 1) ? 1 : 8 * numThreads;
+  while (subtrees.size() < numSubtrees && !subtrees.empty())
+  {
+    size_t largest = 0;
+    for (size_t i = 1; i < subtrees.size(); ++i)
+    {
+      if (subtrees[i]->NumDescendants() > subtrees[largest]->NumDescendants())
+        largest = i;
+    }
+
+    TreeType* node = subtrees[largest];
+    if (node->IsLeaf())
+      break;
+
+    subtrees.erase(subtrees.begin() + largest);
+
+    // The traverser scores the root itself.
+    if (node->Parent() == NULL && rules.Score(0, *node) == DBL_MAX)
+      continue;
+
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+    {
+      if (rules.Score(0, node->Child(i)) != DBL_MAX)
+        subtrees.push_back(&node->Child(i));
+    }
+  }
+
+  #pragma omp parallel
+  {
+    // Each thread sums the points of its subtrees into its own new centroids
+    // and counts.
+    arma::mat threadCentroids(newCentroids.n_rows, newCentroids.n_cols);
+    arma::Col<size_t> threadCounts(counts.n_elem);
+    threadCentroids.zeros();
+    threadCounts.zeros();
+    RulesType threadRules(dataset, centroids, threadCentroids, threadCounts,
+        distance);
+
+    // Use single-tree traverser.
+    typename TreeType::template SingleTreeTraverser<RulesType>
+        traverser(threadRules);
+
+    // Now, do a traversal with a fake query index (since the query index is
+    // irrelevant; we are checking each node with all clusters.
+    #pragma omp for schedule(dynamic, 1)
+    for (size_t i = 0; i < subtrees.size(); ++i)
+      traverser.Traverse(0, *subtrees[i]);
+
+    #pragma omp critical
+    {
+      newCentroids += threadCentroids;
+      counts += threadCounts;
+      rules.DistanceCalculations() += threadRules.DistanceCalculations();
+    }
+  }
 
   distanceCalculations += rules.DistanceCalculations();
 
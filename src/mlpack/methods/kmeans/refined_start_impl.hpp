@@ -79,6 +79,9 @@ void RefinedStart::Cluster(const MatType& data,
   Cluster(data, clusters, centroids);
 
   // Turn the final centroids into assignments.
+  EuclideanDistance metric;
+  CentroidDistances<EuclideanDistance, MatType> centroidDistances(data, metric);
+  centroidDistances.SetCentroids(centroids);
   assignments.set_size(data.n_cols);
   for (size_t i = 0; i < data.n_cols; ++i)
   {
@@ -92,8 +95,7 @@ void RefinedStart::Cluster(const MatType& data,
       // a lot of refactoring and redesign to make this more general... we would
       // probably need to have KMeans take a template template parameter for the
       // initial partition policy.  It's not clear how to best do this.
-      const double distance = EuclideanDistance::Evaluate(data.col(i),
-          centroids.col(j));
+      const double distance = centroidDistances.Evaluate(i, j);
 
       if (distance < minDistance)
       {
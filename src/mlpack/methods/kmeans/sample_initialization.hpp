@@ -17,6 +17,8 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/math/random.hpp>
 
+#include "centroid_distances.hpp"
+
 namespace mlpack {
 
 class SampleInitialization
@@ -43,7 +45,8 @@ class SampleInitialization
     {
       // Randomly sample a point.
       const size_t index = RandInt(0, data.n_cols);
-      centroids.col(i) = data.col(index);
+      centroids.col(i) = CentroidDistances<EuclideanDistance, MatType>::Point(
+          data, index);
     }
   }
 };
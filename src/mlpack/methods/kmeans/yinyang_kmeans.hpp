@@ -0,0 +1,137 @@
+/**
+ * @file methods/kmeans/yinyang_kmeans.hpp
+ *
+ * An implementation of the Yinyang k-means algorithm, which keeps one lower
+ * bound for each group of centroids instead of one for each centroid.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_YINYANG_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_YINYANG_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * An implementation of the Yinyang k-means algorithm of Ding et al.  The
+ * centroids are clustered into t groups when Iterate() is first called, and for
+ * each point an upper bound on the distance to its assigned centroid and a
+ * lower bound on the distance to every other centroid of each group are kept.
+ * After each iteration the group bounds are loosened by the largest movement
+ * of any centroid in the group.  A point whose upper bound is below all of its
+ * group bounds keeps its assignment; otherwise only the centroids of groups
+ * whose bound is below the (tightened) upper bound are checked.
+ *
+ * This needs O(nt) memory for the bounds, between Hamerly's algorithm (one
+ * lower bound per point) and Elkan's algorithm (k lower bounds per point), and
+ * prunes much better than Hamerly's algorithm for large k.  If OpenMP is
+ * enabled, the points are split between threads.
+ *
+ * For more information, see
+ *
+ * @code
+ * @inproceedings{ding2015yinyang,
+ *   title={Yinyang K-Means: A Drop-In Replacement of the Classic K-Means with
+ *       Consistent Speedup},
+ *   author={Ding, Yufei and Zhao, Yue and Shen, Xipeng and Musuvathi, Madanlal
+ *       and Mytkowicz, Todd},
+ *   booktitle={Proceedings of the 32nd International Conference on Machine
+ *       Learning (ICML '15)},
+ *   pages={579--587},
+ *   year={2015}
+ * }
+ * @endcode
+ *
+ * @tparam DistanceType Type of distance metric used with this implementation;
+ *     it must satisfy the triangle inequality.
+ * @tparam MatType Matrix type (arma::mat or arma::sp_mat).
+ */
+template<typename DistanceType, typename MatType>
+class YinyangKMeans
+{
+ public:
+  /**
+   * Construct the YinyangKMeans object, which must store several sets of
+   * bounds.  KMeans uses the default number of groups.
+   *
+   * @param dataset Dataset.
+   * @param distance Instantiated distance metric.
+   * @param groups Number of groups to cluster the centroids into.  If 0, k / 10
+   *     groups (at least one) are used, as suggested by the paper.
+   */
+  YinyangKMeans(const MatType& dataset,
+                DistanceType& distance,
+                const size_t groups = 0);
+
+  /**
+   * Run a single iteration of the Yinyang algorithm, updating the given
+   * centroids into the newCentroids matrix.  The centroids are grouped again
+   * if the number of clusters changes.
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Current counts, to be overwritten with new counts.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  //! Get the number of distance calculations.
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+  //! Get the number of groups that was requested (0 means k / 10).
+  size_t Groups() const { return groups; }
+  //! Modify the number of groups (0 means k / 10).  This only has an effect
+  //! before the first iteration.
+  size_t& Groups() { return groups; }
+
+ private:
+  /**
+   * Cluster the given centroids into groups with a few iterations of Lloyd's
+   * algorithm, filling groupMembers.
+   */
+  void GroupCentroids(const arma::mat& centroids);
+
+  /**
+   * Assign every point to its closest centroid and compute all the bounds from
+   * scratch.
+   */
+  void InitializeBounds(const arma::mat& centroids);
+
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated distance metric.
+  DistanceType& distance;
+
+  //! The number of groups that was requested.
+  size_t groups;
+  //! The group of each centroid.
+  arma::Col<size_t> centroidGroups;
+  //! The centroids that belong to each group.
+  std::vector<std::vector<size_t>> groupMembers;
+
+  //! The centroids that the bounds were computed for.
+  arma::mat boundCentroids;
+  //! Holds the index of the cluster that owns each point.
+  arma::Col<size_t> assignments;
+  //! Upper bounds on the distance between each point and its closest cluster.
+  arma::vec upperBounds;
+  //! Lower bounds on the distance between each point and the clusters in each
+  //! group (not counting the cluster owning the point).  Each column holds the
+  //! bounds of one point.
+  arma::mat lowerBounds;
+
+  //! Track distance calculations.
+  size_t distanceCalculations;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "yinyang_kmeans_impl.hpp"
+
+#endif
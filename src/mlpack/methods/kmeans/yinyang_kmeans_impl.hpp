@@ -0,0 +1,349 @@
+/**
+ * @file methods/kmeans/yinyang_kmeans_impl.hpp
+ *
+ * Implementation of the Yinyang k-means algorithm.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_YINYANG_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_YINYANG_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "yinyang_kmeans.hpp"
+
+namespace mlpack {
+
+template<typename DistanceType, typename MatType>
+YinyangKMeans<DistanceType, MatType>::YinyangKMeans(const MatType& dataset,
+                                                    DistanceType& distance,
+                                                    const size_t groups) :
+    dataset(dataset),
+    distance(distance),
+    groups(groups),
+    distanceCalculations(0)
+{
+  // Nothing to do.
+}
+
+template<typename DistanceType, typename MatType>
+double YinyangKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
+                                                     arma::mat& newCentroids,
+                                                     arma::Col<size_t>& counts)
+{
+  size_t globalPruned = 0;
+  size_t groupPruned = 0;
+
+  // If this is the first iteration, we need to group the centroids and set all
+  // the bounds.
+  if (centroidGroups.n_elem != centroids.n_cols ||
+      assignments.n_elem != dataset.n_cols)
+  {
+    GroupCentroids(centroids);
+    InitializeBounds(centroids);
+  }
+  else
+  {
+    const size_t numGroups = groupMembers.size();
+
+    // The bounds hold for the centroids of the last iteration; loosen them by
+    // how far each centroid has moved since.  (The centroids may not be the
+    // ones we returned, if the empty cluster policy changed them.)
+    arma::vec centroidMovements(centroids.n_cols);
+    #pragma omp parallel for schedule(static)
+    for (size_t c = 0; c < centroids.n_cols; ++c)
+    {
+      centroidMovements(c) = distance.Evaluate(boundCentroids.col(c),
+          centroids.col(c));
+    }
+    distanceCalculations += centroids.n_cols;
+
+    arma::vec groupMovements(numGroups, arma::fill::zeros);
+    for (size_t c = 0; c < centroids.n_cols; ++c)
+    {
+      groupMovements(centroidGroups[c]) = std::max(
+          groupMovements(centroidGroups[c]), centroidMovements(c));
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+    {
+      upperBounds(i) += centroidMovements(assignments[i]);
+      lowerBounds.col(i) -= groupMovements;
+    }
+
+    #pragma omp parallel reduction(+:globalPruned, groupPruned, \
+        distanceCalculations)
+    {
+      // Per-thread storage for the closest and second closest distance (or
+      // lower bound) to the clusters of each group.
+      arma::vec groupFirst(numGroups);
+      arma::vec groupSecond(numGroups);
+      arma::Col<size_t> groupClosest(numGroups);
+      std::vector<char> examined(numGroups);
+
+      #pragma omp for schedule(dynamic, 256)
+      for (size_t i = 0; i < dataset.n_cols; ++i)
+      {
+        // Global filter: if the point is closer to its cluster than to any
+        // other cluster, it does not move.
+        const double globalLowerBound = arma::min(lowerBounds.col(i));
+        if (upperBounds(i) <= globalLowerBound)
+        {
+          ++globalPruned;
+          continue;
+        }
+
+        // Tighten the upper bound and try again.
+        const size_t oldAssignment = assignments[i];
+        const double oldDistance = distance.Evaluate(dataset.col(i),
+            centroids.col(oldAssignment));
+        ++distanceCalculations;
+        upperBounds(i) = oldDistance;
+        if (upperBounds(i) <= globalLowerBound)
+        {
+          ++globalPruned;
+          continue;
+        }
+
+        size_t bestCluster = oldAssignment;
+        double bestDistance = oldDistance;
+        for (size_t g = 0; g < numGroups; ++g)
+        {
+          // Group filter: no cluster of this group can be closer.
+          if (lowerBounds(g, i) >= bestDistance)
+          {
+            examined[g] = 0;
+            ++groupPruned;
+            continue;
+          }
+
+          examined[g] = 1;
+          groupFirst(g) = DBL_MAX;
+          groupSecond(g) = DBL_MAX;
+          groupClosest[g] = centroids.n_cols; // Invalid value.
+          for (const size_t c : groupMembers[g])
+          {
+            double dist;
+            if (c == oldAssignment)
+            {
+              dist = oldDistance;
+            }
+            else
+            {
+              // Local filter: the bound of the group before it was loosened,
+              // minus the movement of this cluster, is a bound for this
+              // cluster.
+              const double bound = lowerBounds(g, i) + groupMovements(g) -
+                  centroidMovements(c);
+              if (bound >= bestDistance)
+              {
+                dist = bound;
+              }
+              else
+              {
+                dist = distance.Evaluate(dataset.col(i), centroids.col(c));
+                ++distanceCalculations;
+              }
+            }
+
+            if (dist < groupFirst(g))
+            {
+              groupSecond(g) = groupFirst(g);
+              groupFirst(g) = dist;
+              groupClosest[g] = c;
+            }
+            else if (dist < groupSecond(g))
+            {
+              groupSecond(g) = dist;
+            }
+
+            if (dist < bestDistance)
+            {
+              bestDistance = dist;
+              bestCluster = c;
+            }
+          }
+        }
+
+        // Now update the bounds of the groups we looked at.  Their bounds must
+        // not count the new owner of the point.
+        for (size_t g = 0; g < numGroups; ++g)
+        {
+          if (examined[g])
+          {
+            lowerBounds(g, i) = (groupClosest[g] == bestCluster) ?
+                groupSecond(g) : groupFirst(g);
+          }
+        }
+
+        // If the point moved and we did not look at the group of its old
+        // cluster, that bound must now count the old cluster.
+        const size_t oldGroup = centroidGroups[oldAssignment];
+        if (bestCluster != oldAssignment && !examined[oldGroup])
+          lowerBounds(oldGroup, i) = std::min(lowerBounds(oldGroup, i),
+              oldDistance);
+
+        upperBounds(i) = bestDistance;
+        assignments[i] = bestCluster;
+      }
+    }
+  }
+
+  boundCentroids = centroids;
+
+  // Calculate the new centroids.
+  newCentroids.zeros(centroids.n_rows, centroids.n_cols);
+  counts.zeros(centroids.n_cols);
+  #pragma omp parallel for reduction(matAdd:newCentroids) \
+      reduction(colAdd:counts) schedule(static)
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    newCentroids.col(assignments[i]) += dataset.col(i);
+    ++counts(assignments[i]);
+  }
+
+  double cNorm = 0.0;
+  #pragma omp parallel for reduction(+:cNorm, distanceCalculations) \
+      schedule(static)
+  for (size_t c = 0; c < centroids.n_cols; ++c)
+  {
+    if (counts(c) > 0)
+      newCentroids.col(c) /= counts(c);
+
+    cNorm += std::pow(distance.Evaluate(centroids.col(c), newCentroids.col(c)),
+        2.0);
+    ++distanceCalculations;
+  }
+
+  Log::Info << "Yinyang prunes: " << globalPruned << " points, "
+      << groupPruned << " groups.\n";
+
+  return std::sqrt(cNorm);
+}
+
+template<typename DistanceType, typename MatType>
+void YinyangKMeans<DistanceType, MatType>::GroupCentroids(
+    const arma::mat& centroids)
+{
+  const size_t k = centroids.n_cols;
+  const size_t numGroups = (groups == 0) ? std::max(k / 10, (size_t) 1) :
+      std::min(groups, k);
+
+  // Start from evenly spaced centroids, and run a few iterations of Lloyd's
+  // algorithm; the grouping only needs to be good, not converged.
+  arma::mat groupCentroids(centroids.n_rows, numGroups);
+  for (size_t g = 0; g < numGroups; ++g)
+    groupCentroids.col(g) = centroids.col(g * k / numGroups);
+
+  centroidGroups.zeros(k);
+  for (size_t iteration = 0; iteration < 5; ++iteration)
+  {
+    #pragma omp parallel for schedule(static)
+    for (size_t c = 0; c < k; ++c)
+    {
+      double minDistance = DBL_MAX;
+      for (size_t g = 0; g < numGroups; ++g)
+      {
+        const double dist = distance.Evaluate(centroids.col(c),
+            groupCentroids.col(g));
+        if (dist < minDistance)
+        {
+          minDistance = dist;
+          centroidGroups[c] = g;
+        }
+      }
+    }
+    distanceCalculations += k * numGroups;
+
+    arma::mat newGroupCentroids(centroids.n_rows, numGroups,
+        arma::fill::zeros);
+    arma::Col<size_t> groupCounts(numGroups, arma::fill::zeros);
+    for (size_t c = 0; c < k; ++c)
+    {
+      newGroupCentroids.col(centroidGroups[c]) += centroids.col(c);
+      ++groupCounts[centroidGroups[c]];
+    }
+
+    // Groups that lost all their centroids keep their old center.
+    for (size_t g = 0; g < numGroups; ++g)
+    {
+      if (groupCounts[g] > 0)
+        groupCentroids.col(g) = newGroupCentroids.col(g) / groupCounts[g];
+    }
+  }
+
+  groupMembers.clear();
+  groupMembers.resize(numGroups);
+  for (size_t c = 0; c < k; ++c)
+    groupMembers[centroidGroups[c]].push_back(c);
+}
+
+template<typename DistanceType, typename MatType>
+void YinyangKMeans<DistanceType, MatType>::InitializeBounds(
+    const arma::mat& centroids)
+{
+  const size_t numGroups = groupMembers.size();
+
+  assignments.set_size(dataset.n_cols);
+  upperBounds.set_size(dataset.n_cols);
+  lowerBounds.set_size(numGroups, dataset.n_cols);
+
+  #pragma omp parallel
+  {
+    arma::vec groupFirst(numGroups);
+    arma::vec groupSecond(numGroups);
+    arma::Col<size_t> groupClosest(numGroups);
+
+    #pragma omp for schedule(static)
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+    {
+      size_t bestCluster = centroids.n_cols; // Invalid value.
+      double bestDistance = DBL_MAX;
+      for (size_t g = 0; g < numGroups; ++g)
+      {
+        groupFirst(g) = DBL_MAX;
+        groupSecond(g) = DBL_MAX;
+        groupClosest[g] = centroids.n_cols;
+        for (const size_t c : groupMembers[g])
+        {
+          const double dist = distance.Evaluate(dataset.col(i),
+              centroids.col(c));
+          if (dist < groupFirst(g))
+          {
+            groupSecond(g) = groupFirst(g);
+            groupFirst(g) = dist;
+            groupClosest[g] = c;
+          }
+          else if (dist < groupSecond(g))
+          {
+            groupSecond(g) = dist;
+          }
+
+          if (dist < bestDistance)
+          {
+            bestDistance = dist;
+            bestCluster = c;
+          }
+        }
+      }
+
+      Log::Assert(bestCluster != centroids.n_cols);
+
+      for (size_t g = 0; g < numGroups; ++g)
+      {
+        lowerBounds(g, i) = (groupClosest[g] == bestCluster) ?
+            groupSecond(g) : groupFirst(g);
+      }
+      upperBounds(i) = bestDistance;
+      assignments[i] = bestCluster;
+    }
+  }
+  distanceCalculations += dataset.n_cols * centroids.n_cols;
+}
+
+} // namespace mlpack
+
+#endif
@@ -491,6 +491,60 @@ class LARS
                  const bool fitIntercept,
                  const bool normalizeData);
 
+  /**
+   * Solve a separate LARS problem for each column of `responses`, all against
+   * the same data, with the settings of this object (`UseCholesky()`,
+   * `Lambda1()`, `Lambda2()`, `Tolerance()`, `FitIntercept()` and
+   * `NormalizeData()`).  The solution for the targets in column i of
+   * `responses` is stored in column i of `betas`, and its intercept (0 if no
+   * intercept is fit) in `intercepts[i]`.  The model of this object is not
+   * changed.
+   *
+   * The data is transposed, centered and normalized once, and its Gram matrix
+   * is computed once (unless `gramMatrix` is given), for all the targets; the
+   * problems are then solved in parallel with OpenMP.  This is much faster
+   * than calling `Train()` once for each target.  A given `gramMatrix` must
+   * match the settings of `FitIntercept()` and `NormalizeData()`, as for
+   * `Train()`.
+   *
+   * @param data Input data.
+   * @param responses Matrix of targets; each column holds the targets of one
+   *     problem (one for each point).
+   * @param betas Matrix to store the solution of each problem in.
+   * @param intercepts Row to store the intercept of each problem in.
+   * @param colMajor Should be true if the input data is column-major.  Passing
+   *     row-major data can avoid a transpose operation.
+   * @param gramMatrix Precomputed Gram matrix (ignored if empty).
+   */
+  template<typename MatType, typename ResponsesType>
+  void SolveBatch(const MatType& data,
+                  const ResponsesType& responses,
+                  DenseMatType& betas,
+                  arma::Row<ElemType>& intercepts,
+                  const bool colMajor = true,
+                  const DenseMatType& gramMatrix = DenseMatType()) const;
+
+  /**
+   * Solve a separate LARS problem for each column of `responses`, all against
+   * the same data, and store the solution of column i of `responses` in column
+   * i of `betas`; the intercepts are not returned.  See the other overload of
+   * `SolveBatch()` for details.
+   *
+   * @param data Input data.
+   * @param responses Matrix of targets; each column holds the targets of one
+   *     problem (one for each point).
+   * @param betas Matrix to store the solution of each problem in.
+   * @param colMajor Should be true if the input data is column-major.  Passing
+   *     row-major data can avoid a transpose operation.
+   * @param gramMatrix Precomputed Gram matrix (ignored if empty).
+   */
+  template<typename MatType, typename ResponsesType>
+  void SolveBatch(const MatType& data,
+                  const ResponsesType& responses,
+                  DenseMatType& betas,
+                  const bool colMajor = true,
+                  const DenseMatType& gramMatrix = DenseMatType()) const;
+
   /**
    * Predict y_i for the given data point.
    *
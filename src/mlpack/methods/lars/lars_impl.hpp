@@ -932,6 +932,95 @@ LARS<ModelMatType>::Train(const MatType& matX,
   return ComputeError(matX, y, colMajor);
 }
 
+template<typename ModelMatType>
+template<typename MatType, typename ResponsesType>
+inline void LARS<ModelMatType>::SolveBatch(
+    const MatType& data,
+    const ResponsesType& responses,
+    typename LARS<ModelMatType>::DenseMatType& betas,
+    arma::Row<ElemType>& intercepts,
+    const bool colMajor,
+    const typename LARS<ModelMatType>::DenseMatType& gramMatrix) const
+{
+  // Transform the data to row-major form once, as Train() would for each
+  // target; as in Train(), the given data is used directly if possible.
+  MatType dataTrans;
+  if (colMajor)
+    dataTrans = data.t();
+  else if (fitIntercept || normalizeData)
+    dataTrans = data;
+  const MatType& dataRef =
+      (colMajor || fitIntercept || normalizeData) ? dataTrans : data;
+
+  arma::Row<ElemType> offsetX; // used only if fitting an intercept
+  arma::Row<ElemType> stdX; // used only if normalizing
+  if (fitIntercept)
+  {
+    offsetX = arma::mean(dataTrans, 0);
+    dataTrans.each_row() -= offsetX;
+  }
+
+  if (normalizeData)
+  {
+    stdX = arma::stddev(dataTrans, 0, 0);
+    stdX.replace(0.0, 1.0); // Make sure we don't divide by 0!
+    dataTrans.each_row() /= stdX;
+  }
+
+  // The transformed data is not centered or normalized again for each target,
+  // so the Gram matrix is computed from it in the same way as Train() does.
+  DenseMatType gram;
+  const DenseMatType* gramRef = &gramMatrix;
+  if (gramMatrix.n_elem == 0)
+  {
+    gram = DenseMatType(dataRef.t() * dataRef);
+    if (lambda1 != 0 && lambda2 != 0 && !useCholesky)
+      gram += lambda2 * arma::eye<DenseMatType>(gram.n_rows, gram.n_cols);
+    gramRef = &gram;
+  }
+
+  betas.set_size(dataRef.n_cols, responses.n_cols);
+  intercepts.set_size(responses.n_cols);
+
+  #pragma omp parallel
+  {
+    // Each thread reuses its own LARS object for all of its targets.
+    LARS<ModelMatType> lars(useCholesky, lambda1, lambda2, tolerance, false,
+        false);
+    arma::Row<ElemType> y;
+
+    #pragma omp for schedule(dynamic)
+    for (size_t i = 0; i < (size_t) responses.n_cols; ++i)
+    {
+      y = ConvTo<arma::Row<ElemType>>::From(responses.col(i).t());
+      const ElemType offsetY = (fitIntercept) ? arma::mean(y) : 0;
+      if (fitIntercept)
+        y -= offsetY;
+
+      lars.Train(dataRef, y, false, useCholesky, *gramRef);
+
+      betas.col(i) = lars.Beta();
+      if (normalizeData)
+        betas.col(i) /= stdX.t();
+      intercepts[i] = (fitIntercept) ?
+          offsetY - arma::dot(offsetX, betas.col(i)) : 0;
+    }
+  }
+}
+
+template<typename ModelMatType>
+template<typename MatType, typename ResponsesType>
+inline void LARS<ModelMatType>::SolveBatch(
+    const MatType& data,
+    const ResponsesType& responses,
+    typename LARS<ModelMatType>::DenseMatType& betas,
+    const bool colMajor,
+    const typename LARS<ModelMatType>::DenseMatType& gramMatrix) const
+{
+  arma::Row<ElemType> intercepts;
+  SolveBatch(data, responses, betas, intercepts, colMajor, gramMatrix);
+}
+
 template<typename ModelMatType>
 template<typename VecType>
 inline typename LARS<ModelMatType>::ElemType LARS<ModelMatType>::Predict(
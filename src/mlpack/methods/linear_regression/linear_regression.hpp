@@ -80,7 +80,7 @@ class LinearRegression
    * called (or make sure the model parameters are set) before calling
    * Predict()!
    */
-  LinearRegression() : lambda(0.0), intercept(true) { }
+  LinearRegression() : lambda(0.0), intercept(true), partialPoints(0) { }
 
   /**
    * Train the LinearRegression model on the given data. Careful! This will
@@ -204,6 +204,34 @@ class LinearRegression
                  const std::optional<double> lambda = std::nullopt,
                  const std::optional<bool> intercept = std::nullopt);
 
+  /**
+   * Add a batch of points to the statistics of an incremental fit: the
+   * predictor products X X^T, the predictor sums, the products X y^T and the
+   * response sums are accumulated over the batch (in parallel with OpenMP),
+   * and the points themselves are not kept.  So, the model can be trained on
+   * a dataset that does not fit in memory, one chunk at a time (for instance,
+   * with data::CSVChunkReader), with only O(d^2) memory.  Once all batches
+   * are given, call Finalize() to solve for the model.
+   *
+   * All batches must have the same dimensionality; a std::invalid_argument is
+   * thrown otherwise.
+   *
+   * @param predictors X, the batch of data points.
+   * @param responses y, the responses to the data points of the batch.
+   */
+  template<typename MatType, typename ResponsesType>
+  void Partial(const MatType& predictors, const ResponsesType& responses);
+
+  /**
+   * Solve for the model from the statistics accumulated by Partial(), with
+   * the current Lambda() and Intercept() settings, and clear the statistics.
+   * The solution is the same as the one of Train() on all the batches at
+   * once.  A std::runtime_error is thrown if no points were given.
+   *
+   * @return The least squares error of the model on all the batches.
+   */
+  ElemType Finalize();
+
   /**
    * Calculate y_i for a single data point.
    *
@@ -276,6 +304,19 @@ class LinearRegression
 
   //! Indicates whether first parameter is intercept.
   bool intercept;
+
+  //! The sum of x x^T over the points given to Partial().
+  arma::Mat<ElemType> partialGram;
+  //! The sum of the points given to Partial().
+  ModelColType partialSums;
+  //! The sum of y x over the points given to Partial().
+  ModelColType partialMoments;
+  //! The sum of the responses given to Partial().
+  ElemType partialResponseSum;
+  //! The sum of the squared responses given to Partial().
+  ElemType partialResponseSquares;
+  //! The number of points given to Partial().
+  size_t partialPoints;
 };
 
 } // namespace mlpack
@@ -40,7 +40,8 @@ inline LinearRegression<ModelMatType>::LinearRegression(
     const double lambda,
     const bool intercept) :
     lambda(lambda),
-    intercept(intercept)
+    intercept(intercept),
+    partialPoints(0)
 {
   Train(predictors, responses, weights, lambda, intercept);
 }
@@ -170,6 +171,121 @@ LinearRegression<ModelMatType>::Train(const MatType& predictors,
   return ComputeError(predictors, responses);
 }
 
+template<typename ModelMatType>
+template<typename MatType, typename ResponsesType>
+inline void LinearRegression<ModelMatType>::Partial(
+    const MatType& predictors,
+    const ResponsesType& responses)
+{
+  util::CheckSameSizes(predictors, responses, "LinearRegression::Partial()");
+
+  const size_t dims = predictors.n_rows;
+  if (partialPoints == 0)
+  {
+    partialGram.zeros(dims, dims);
+    partialSums.zeros(dims);
+    partialMoments.zeros(dims);
+    partialResponseSum = 0;
+    partialResponseSquares = 0;
+  }
+  else if (dims != partialGram.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "LinearRegression::Partial(): batch has " << dims << " dimensions, "
+        << "but earlier batches had " << partialGram.n_rows << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Each thread accumulates the statistics of its blocks of points, which are
+  // then added to the statistics of the earlier batches.
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (predictors.n_cols + blockSize - 1) / blockSize;
+  #pragma omp parallel
+  {
+    arma::Mat<ElemType> gram(dims, dims, arma::fill::zeros);
+    ModelColType sums(dims, arma::fill::zeros);
+    ModelColType moments(dims, arma::fill::zeros);
+    ElemType responseSum = 0;
+    ElemType responseSquares = 0;
+
+    #pragma omp for schedule(static)
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      const size_t begin = b * blockSize;
+      const size_t end = std::min(begin + blockSize, (size_t) predictors.n_cols)
+          - 1;
+
+      const arma::Mat<ElemType> block =
+          ConvTo<arma::Mat<ElemType>>::From(predictors.cols(begin, end));
+      const arma::Row<ElemType> r =
+          ConvTo<arma::Row<ElemType>>::From(responses.subvec(begin, end));
+
+      gram += block * block.t();
+      sums += arma::sum(block, 1);
+      moments += block * r.t();
+      responseSum += arma::accu(r);
+      responseSquares += arma::dot(r, r);
+    }
+
+    #pragma omp critical
+    {
+      partialGram += gram;
+      partialSums += sums;
+      partialMoments += moments;
+      partialResponseSum += responseSum;
+      partialResponseSquares += responseSquares;
+    }
+  }
+
+  partialPoints += predictors.n_cols;
+}
+
+template<typename ModelMatType>
+inline
+typename LinearRegression<ModelMatType>::ElemType
+LinearRegression<ModelMatType>::Finalize()
+{
+  if (partialPoints == 0)
+  {
+    throw std::runtime_error("LinearRegression::Finalize(): no points were "
+        "given to Partial()!");
+  }
+
+  // Assemble the same system that Train() solves: with an intercept, the
+  // first dimension is a row of ones, so its products are the sums of the
+  // points and of the responses.
+  const size_t dims = partialGram.n_rows;
+  const size_t offset = (intercept) ? 1 : 0;
+  arma::Mat<ElemType> gram(dims + offset, dims + offset);
+  ModelColType moments(dims + offset);
+  gram.submat(offset, offset, dims + offset - 1, dims + offset - 1) =
+      partialGram;
+  moments.subvec(offset, dims + offset - 1) = partialMoments;
+  if (intercept)
+  {
+    gram(0, 0) = (ElemType) partialPoints;
+    gram.submat(1, 0, dims, 0) = partialSums;
+    gram.submat(0, 1, 0, dims) = partialSums.t();
+    moments[0] = partialResponseSum;
+  }
+
+  parameters = arma::solve(gram + ((ElemType) lambda) *
+      arma::eye<arma::Mat<ElemType>>(gram.n_rows, gram.n_rows), moments);
+
+  // The squared error is y y^T - 2 b^T X y^T + b^T X X^T b.
+  const ElemType squaredError = partialResponseSquares -
+      2 * arma::dot(parameters, moments) +
+      arma::as_scalar(parameters.t() * gram * parameters);
+  const ElemType error = std::max(squaredError, (ElemType) 0) / partialPoints;
+
+  partialGram.clear();
+  partialSums.clear();
+  partialMoments.clear();
+  partialPoints = 0;
+
+  return error;
+}
+
 template<typename ModelMatType>
 template<typename VecType>
 inline
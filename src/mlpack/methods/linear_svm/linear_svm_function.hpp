@@ -127,6 +127,27 @@ class LinearSVMFunction
                 GradType& gradient,
                 const size_t batchSize = 1) const;
 
+  /**
+   * Evaluate the gradient of the hinge loss function on the given batch into a
+   * sparse matrix; this is the overload used by ens::ParallelSGD (Hogwild!).
+   * If the dataset is sparse, only the rows of the dimensions that are nonzero
+   * in the batch (and the intercept row) are filled, and the regularization is
+   * only applied to those rows, so that each update of ParallelSGD only touches
+   * the weights that the batch depends on.  For dense datasets this is the same
+   * as the dense gradient.
+   *
+   * @tparam eT Element type of the gradient.
+   * @param parameters The parameters of the SVM.
+   * @param firstId Index of the datapoint to use for the gradient evaluation.
+   * @param gradient Sparse matrix to output the gradient into.
+   * @param batchSize Size of the batch to process.
+   */
+  template<typename eT>
+  void Gradient(const ParametersType& parameters,
+                const size_t firstId,
+                arma::SpMat<eT>& gradient,
+                const size_t batchSize = 1) const;
+
   /**
    * Evaluate the gradient of the hinge loss function, following
    * the LinearFunctionType requirements on the Gradient function
@@ -358,6 +358,93 @@ void LinearSVMFunction<MatType, ParametersType>::Gradient(
   gradient += lambda * parameters;
 }
 
+template<typename MatType, typename ParametersType>
+template<typename eT>
+void LinearSVMFunction<MatType, ParametersType>::Gradient(
+    const ParametersType& parameters,
+    const size_t firstId,
+    arma::SpMat<eT>& gradient,
+    const size_t batchSize) const
+{
+  if constexpr (!arma::is_SpMat<MatType>::value)
+  {
+    // Every row of the gradient depends on a dense batch.
+    DenseMatType denseGradient;
+    Gradient(parameters, firstId, denseGradient, batchSize);
+    gradient = arma::SpMat<eT>(denseGradient);
+  }
+  else
+  {
+    const size_t lastId = firstId + batchSize - 1;
+    const size_t dims = dataset.n_rows;
+
+    // The scores, margins and differences are computed as in Gradient().
+    DenseMatType scores = parameters.rows(0, dims - 1).t() *
+        dataset.cols(firstId, lastId);
+    if (fitIntercept)
+      scores.each_col() += parameters.row(dims).t();
+
+    DenseMatType margin = scores - (repmat(ones(numClasses).t()
+        * (scores % groundTruth.cols(firstId, lastId)), numClasses, 1))
+        + delta - (delta * groundTruth.cols(firstId, lastId));
+
+    DenseMatType mask = margin.for_each([](typename DenseMatType::elem_type&
+        val) { val = (val > 0) ? 1 : 0; });
+
+    DenseMatType difference = groundTruth.cols(firstId, lastId)
+        % (-repmat(sum(mask), numClasses, 1)) + mask;
+
+    // Find the dimensions that are nonzero in the batch; the gradient of all
+    // the other dimensions (and their regularization) is left out.
+    std::vector<size_t> rows;
+    for (size_t i = firstId; i <= lastId; ++i)
+      for (auto it = dataset.begin_col(i); it != dataset.end_col(i); ++it)
+        rows.push_back(it.row());
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+    DenseMatType batchGradient(rows.size(), numClasses, arma::fill::zeros);
+    for (size_t i = firstId; i <= lastId; ++i)
+    {
+      for (auto it = dataset.begin_col(i); it != dataset.end_col(i); ++it)
+      {
+        const size_t r = std::lower_bound(rows.begin(), rows.end(),
+            (size_t) it.row()) - rows.begin();
+        batchGradient.row(r) += (*it) * difference.col(i - firstId).t();
+      }
+    }
+
+    // The locations are filled in column-major order, with the intercept as
+    // the last row of each column.
+    const size_t numRows = rows.size() + (fitIntercept ? 1 : 0);
+    arma::umat locations(2, numRows * numClasses);
+    arma::Col<eT> values(numRows * numClasses);
+    for (size_t c = 0; c < numClasses; ++c)
+    {
+      for (size_t r = 0; r < rows.size(); ++r)
+      {
+        const size_t index = c * numRows + r;
+        locations(0, index) = rows[r];
+        locations(1, index) = c;
+        values[index] = batchGradient(r, c) / batchSize +
+            lambda * parameters(rows[r], c);
+      }
+
+      if (fitIntercept)
+      {
+        const size_t index = c * numRows + rows.size();
+        locations(0, index) = dims;
+        locations(1, index) = c;
+        values[index] = accu(difference.row(c)) / batchSize +
+            lambda * parameters(dims, c);
+      }
+    }
+
+    gradient = arma::SpMat<eT>(locations, values, parameters.n_rows,
+        parameters.n_cols);
+  }
+}
+
 template<typename MatType, typename ParametersType>
 template<typename GradType>
 typename LinearSVMFunction<MatType, ParametersType>::ElemType
@@ -263,6 +263,46 @@ class LMNNFunction
                         const MatType& transformation,
                         const size_t begin,
                         const size_t batchSize);
+
+  //! Compute transformedDataset for the given transformation, unless it was
+  //! already computed for the same transformation.
+  inline void TransformDataset(const MatType& transformation);
+
+  /**
+   * Compute the terms of the objective function and of the gradient due to the
+   * points in [begin, end), in parallel.  Each thread accumulates its part of
+   * the gradient in its own d x d matrices, with one outer product for each
+   * (point, target neighbor) and (point, impostor) pair weighted by the number
+   * of active triplets it is part of.
+   *
+   * @tparam Batch If true, the bounds over the triplets use the cached
+   *     transformation of each point (see TransDiff()); otherwise, they use
+   *     transformationDiff.
+   * @tparam ResetCache If true, the cache of a triplet is reset when it is
+   *     active.
+   * @param begin First point to use.
+   * @param end One past the last point to use.
+   * @param transformationDiff Norm of the change in transformation.
+   * @param transformationDiffs Norms of the change in transformation for each
+   *     cached transformation (if Batch is true).
+   * @param computeCost If true, the objective function is returned.
+   * @param cij If not NULL, the gradient terms due to target neighbors are
+   *     added to this matrix.
+   * @param cil If not NULL, the gradient terms due to impostors are added to
+   *     this matrix.
+   */
+  template<bool Batch, bool ResetCache>
+  ElemType TripletTerms(
+      const size_t begin,
+      const size_t end,
+      const ElemType transformationDiff,
+      const std::unordered_map<size_t, ElemType>& transformationDiffs,
+      const bool computeCost,
+      MatType* cij,
+      MatType* cil);
+
+  //! The transformation that transformedDataset was computed with.
+  MatType transformedWith;
 };
 
 } // namespace mlpack
@@ -121,6 +121,9 @@ void LMNNFunction<MatType, LabelsType, DistanceType>::Shuffle()
     evalOld.slice(i) = newEvalOld.slice(ordering(i));
   }
 
+  // The transformed dataset must be recomputed, since the points moved.
+  transformedWith.reset();
+
   // Re-calculate target neighbors as indices changed.
   constraint.PreCalulated() = false;
   constraint.TargetNeighbors(targetNeighbors, dataset, labels, norm);
@@ -200,7 +203,7 @@ LMNNFunction<MatType, LabelsType, DistanceType>::Evaluate(
   ElemType cost = 0;
 
   // Apply distance metric over dataset.
-  transformedDataset = transformation * dataset;
+  TransformDataset(transformation);
 
   ElemType transformationDiff = 0;
   if (!transformationOld.is_empty())
@@ -243,78 +246,9 @@ LMNNFunction<MatType, LabelsType, DistanceType>::Evaluate(
         norm);
   }
 
-  for (size_t i = 0; i < dataset.n_cols; ++i)
-  {
-    for (size_t j = 0; j < k ; ++j)
-    {
-      // Calculate cost due to distance between target neighbors & data point.
-      ElemType eval = distance.Evaluate(transformedDataset.col(i),
-                          transformedDataset.col(targetNeighbors(j, i)));
-      cost += (1 - regularization) * eval;
-    }
-
-    for (int j = k - 1; j >= 0; j--)
-    {
-      // Bound constraints to avoid uneccesary computation. Here bp stands for
-      // breaking point.
-      for (size_t l = 0, bp = k; l < bp ; l++)
-      {
-        // Calculate cost due to {data point, target neighbors, impostors}
-        // triplets.
-        ElemType eval = 0;
-
-        // Bounds for eval.
-        if (!transformationOld.is_empty() && evalOld(l, j, i) < -1)
-        {
-          // Update cache max impostor norm.
-          maxImpNorm(l, i) = std::max(maxImpNorm(l, i), norm(impostors(l, i)));
-
-          eval = evalOld(l, j, i) + transformationDiff *
-              (norm(targetNeighbors(j, i)) + maxImpNorm(l, i) +
-              2 * norm(i));
-        }
-
-        // Calculate exact eval value.
-        if (eval > -1)
-        {
-          if (iteration - 1 % updateInterval == 0)
-          {
-            eval = distance.Evaluate(transformedDataset.col(i),
-                     transformedDataset.col(targetNeighbors(j, i))) -
-                 distanceMat(l, i);
-          }
-          else
-          {
-            eval = distance.Evaluate(transformedDataset.col(i),
-                     transformedDataset.col(targetNeighbors(j, i))) -
-                   distance.Evaluate(transformedDataset.col(i),
-                       transformedDataset.col(impostors(l, i)));
-          }
-        }
-
-        // Update cache eval value.
-        evalOld(l, j, i) = eval;
-
-        // Check bounding condition.
-        if (eval <= -1)
-        {
-          // update bound.
-          bp = l;
-          break;
-        }
-
-        cost += regularization * (1 + eval);
-
-        // Reset cache.
-        if (eval > -1)
-        {
-          // update bound.
-          evalOld(l, j, i) = 0;
-          maxImpNorm(l, i) = 0;
-        }
-      }
-    }
-  }
+  const std::unordered_map<size_t, ElemType> noTransformationDiffs;
+  cost += TripletTerms<false, true>(0, dataset.n_cols, transformationDiff,
+      noTransformationDiffs, true, NULL, NULL);
 
   // Update cache transformation matrix.
   transformationOld = transformation;
@@ -337,7 +271,7 @@ LMNNFunction<MatType, LabelsType, DistanceType>::Evaluate(
   TransDiff(transformationDiffs, transformation, begin, batchSize);
 
   // Apply distance metric over dataset.
-  transformedDataset = transformation * dataset;
+  TransformDataset(transformation);
 
   if (impBounds && iteration++ % updateInterval == 0)
   {
@@ -372,80 +306,8 @@ LMNNFunction<MatType, LabelsType, DistanceType>::Evaluate(
         norm, begin, batchSize);
   }
 
-  for (size_t i = begin; i < begin + batchSize; ++i)
-  {
-    for (size_t j = 0; j < k ; ++j)
-    {
-      // Calculate cost due to distance between target neighbors & data point.
-      ElemType eval = distance.Evaluate(transformedDataset.col(i),
-                          transformedDataset.col(targetNeighbors(j, i)));
-      cost += (1 - regularization) * eval;
-    }
-
-    for (int j = k - 1; j >= 0; j--)
-    {
-      // Bound constraints to avoid uneccesary computation. Here bp stands for
-      // breaking point.
-      for (size_t l = 0, bp = k; l < bp ; l++)
-      {
-        // Calculate cost due to {data point, target neighbors, impostors}
-        // triplets.
-        ElemType eval = 0;
-
-        // Bounds for eval.
-        if (lastTransformationIndices(i) && evalOld(l, j, i) < -1)
-        {
-          // Update cache max impostor norm.
-          maxImpNorm(l, i) = std::max(maxImpNorm(l, i), norm(impostors(l, i)));
-
-          eval = evalOld(l, j, i) +
-              transformationDiffs[lastTransformationIndices[i]] *
-              (norm(targetNeighbors(j, i)) + maxImpNorm(l, i) + 2 * norm(i));
-        }
-
-        // Calculate exact eval value.
-        if (eval > -1)
-        {
-          if (iteration - 1 % updateInterval == 0)
-          {
-            eval = distance.Evaluate(transformedDataset.col(i),
-                     transformedDataset.col(targetNeighbors(j, i))) -
-                 distanceMat(l, i);
-          }
-          else
-          {
-            eval = distance.Evaluate(transformedDataset.col(i),
-                     transformedDataset.col(targetNeighbors(j, i))) -
-                   distance.Evaluate(transformedDataset.col(i),
-                       transformedDataset.col(impostors(l, i)));
-          }
-        }
-
-        // Update cache eval value.
-        evalOld(l, j, i) = eval;
-
-        // Check bounding condition.
-        if (eval <= -1)
-        {
-          // update bound.
-          bp = l;
-          break;
-        }
-
-        cost += regularization * (1 + eval);
-
-        // Reset cache.
-        if (eval > -1 && lastTransformationIndices(i))
-        {
-          // update bound.
-          evalOld(l, j, i) = 0;
-          maxImpNorm(l, i) = 0;
-          --oldTransformationCounts[lastTransformationIndices(i)];
-          lastTransformationIndices(i) = 0;
-        }
-      }
-    }
-  }
+  cost += TripletTerms<true, true>(begin, begin + batchSize, 0,
+      transformationDiffs, true, NULL, NULL);
 
   // Update cache.
   UpdateCache(transformation, begin, batchSize);
@@ -460,7 +322,7 @@ void LMNNFunction<MatType, LabelsType, DistanceType>::Gradient(
     const MatType& transformation, GradType& gradient)
 {
   // Apply distance metric over dataset.
-  transformedDataset = transformation * dataset;
+  TransformDataset(transformation);
 
   ElemType transformationDiff = 0;
   if (!transformationOld.is_empty() && iteration++ % updateInterval == 0)
@@ -508,74 +370,9 @@ void LMNNFunction<MatType, LabelsType, DistanceType>::Gradient(
   // Calculate gradient due to impostors.
   MatType cil = zeros<MatType>(dataset.n_rows, dataset.n_rows);
 
-  for (size_t i = 0; i < dataset.n_cols; ++i)
-  {
-    for (int j = k - 1; j >= 0; j--)
-    {
-      // Bound constraints to avoid uneccesary computation.
-      for (size_t l = 0, bp = k; l < bp ; l++)
-      {
-        // Calculate cost due to {data point, target neighbors, impostors}
-        // triplets.
-        ElemType eval = 0;
-
-        // Bounds for eval.
-        if (!transformationOld.is_empty() && evalOld(l, j, i) < -1)
-        {
-          // Update cache max impostor norm.
-          maxImpNorm(l, i) = std::max(maxImpNorm(l, i), norm(impostors(l, i)));
-
-          eval = evalOld(l, j, i) + transformationDiff *
-              (norm(targetNeighbors(j, i)) + maxImpNorm(l, i) +
-              2 * norm(i));
-        }
-
-        // Calculate exact eval value.
-        if (eval > -1)
-        {
-          if (iteration - 1 % updateInterval == 0)
-          {
-            eval = distance.Evaluate(transformedDataset.col(i),
-                     transformedDataset.col(targetNeighbors(j, i))) -
-                 distanceMat(l, i);
-          }
-          else
-          {
-            eval = distance.Evaluate(transformedDataset.col(i),
-                     transformedDataset.col(targetNeighbors(j, i))) -
-                   distance.Evaluate(transformedDataset.col(i),
-                       transformedDataset.col(impostors(l, i)));
-          }
-        }
-
-        // Update cache eval value.
-        evalOld(l, j, i) = eval;
-
-        // Check bounding condition.
-        if (eval <= -1)
-        {
-          // update bound.
-          bp = l;
-          break;
-        }
-
-        // Reset cache.
-        if (eval > -1)
-        {
-          // update bound.
-          evalOld(l, j, i) = 0;
-          maxImpNorm(l, i) = 0;
-        }
-
-        // Caculate gradient due to impostors.
-        VecType diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
-        cil += diff * trans(diff);
-
-        diff = dataset.col(i) - dataset.col(impostors(l, i));
-        cil -= diff * trans(diff);
-      }
-    }
-  }
+  const std::unordered_map<size_t, ElemType> noTransformationDiffs;
+  TripletTerms<false, true>(0, dataset.n_cols, transformationDiff,
+      noTransformationDiffs, false, NULL, &cil);
 
   gradient = 2 * transformation * ((1 - regularization) * cij +
       regularization * cil);
@@ -594,7 +391,7 @@ void LMNNFunction<MatType, LabelsType, DistanceType>::Gradient(
     const size_t batchSize)
 {
   // Apply distance metric over dataset.
-  transformedDataset = transformation * dataset;
+  TransformDataset(transformation);
 
   // Calculate norm of change in transformation.
   std::unordered_map<size_t, ElemType> transformationDiffs;
@@ -638,83 +435,8 @@ void LMNNFunction<MatType, LabelsType, DistanceType>::Gradient(
   MatType cij = zeros<MatType>(dataset.n_rows, dataset.n_rows);
   MatType cil = zeros<MatType>(dataset.n_rows, dataset.n_rows);
 
-  for (size_t i = begin; i < begin + batchSize; ++i)
-  {
-    for (size_t j = 0; j < k ; ++j)
-    {
-      // Calculate gradient due to target neighbors.
-      VecType diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
-      cij += diff * trans(diff);
-    }
-
-    for (int j = k - 1; j >= 0; j--)
-    {
-      // Bound constraints to avoid uneccesary computation.
-      for (size_t l = 0, bp = k; l < bp ; l++)
-      {
-        // Calculate cost due to {data point, target neighbors, impostors}
-        // triplets.
-        ElemType eval = 0;
-
-        // Bounds for eval.
-        if (lastTransformationIndices(i) && evalOld(l, j, i) < -1)
-        {
-          // Update cache max impostor norm.
-          maxImpNorm(l, i) = std::max(maxImpNorm(l, i), norm(impostors(l, i)));
-
-          eval = evalOld(l, j, i) +
-              transformationDiffs[lastTransformationIndices[i]] *
-              (norm(targetNeighbors(j, i)) + maxImpNorm(l, i) + 2 * norm(i));
-        }
-
-        // Calculate exact eval value.
-        if (eval > -1)
-        {
-          if (iteration - 1 % updateInterval == 0)
-          {
-            eval = distance.Evaluate(transformedDataset.col(i),
-                     transformedDataset.col(targetNeighbors(j, i))) -
-                 distanceMat(l, i);
-          }
-          else
-          {
-            eval = distance.Evaluate(transformedDataset.col(i),
-                     transformedDataset.col(targetNeighbors(j, i))) -
-                   distance.Evaluate(transformedDataset.col(i),
-                       transformedDataset.col(impostors(l, i)));
-          }
-        }
-
-        // Update cache eval value.
-        evalOld(l, j, i) = eval;
-
-        // Check bounding condition.
-        if (eval <= -1)
-        {
-          // update bound.
-          bp = l;
-          break;
-        }
-
-        // Reset cache.
-        if (eval > -1 && lastTransformationIndices(i))
-        {
-          // update bound.
-          evalOld(l, j, i) = 0;
-          maxImpNorm(l, i) = 0;
-          --oldTransformationCounts[lastTransformationIndices(i)];
-          lastTransformationIndices(i) = 0;
-        }
-
-        // Caculate gradient due to impostors.
-        VecType diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
-        cil += diff * trans(diff);
-
-        diff = dataset.col(i) - dataset.col(impostors(l, i));
-        cil -= diff * trans(diff);
-      }
-    }
-  }
+  TripletTerms<true, true>(begin, begin + batchSize, 0, transformationDiffs,
+      false, &cij, &cil);
 
   gradient = 2 * transformation * ((1 - regularization) * cij +
       regularization * cil);
@@ -734,7 +456,7 @@ LMNNFunction<MatType, LabelsType, DistanceType>::EvaluateWithGradient(
   ElemType cost = 0;
 
   // Apply distance metric over dataset.
-  transformedDataset = transformation * dataset;
+  TransformDataset(transformation);
 
   ElemType transformationDiff = 0;
   if (!transformationOld.is_empty())
@@ -785,76 +507,9 @@ LMNNFunction<MatType, LabelsType, DistanceType>::EvaluateWithGradient(
   // Calculate gradient due to impostors.
   MatType cil = zeros<MatType>(dataset.n_rows, dataset.n_rows);
 
-  for (size_t i = 0; i < dataset.n_cols; ++i)
-  {
-    for (size_t j = 0; j < k ; ++j)
-    {
-      // Calculate cost due to distance between target neighbors & data point.
-      ElemType eval = distance.Evaluate(transformedDataset.col(i),
-                        transformedDataset.col(targetNeighbors(j, i)));
-      cost += (1 - regularization) * eval;
-    }
-
-    for (int j = k - 1; j >= 0; j--)
-    {
-      // Bound constraints to avoid uneccesary computation.
-      for (size_t l = 0, bp = k; l < bp ; l++)
-      {
-        // Calculate cost due to {data point, target neighbors, impostors}
-        // triplets.
-        ElemType eval = 0;
-
-        // Bounds for eval.
-        if (!transformationOld.is_empty() && evalOld(l, j, i) < -1)
-        {
-          // Update cache max impostor norm.
-          maxImpNorm(l, i) = std::max(maxImpNorm(l, i), norm(impostors(l, i)));
-
-          eval = evalOld(l, j, i) + transformationDiff *
-              (norm(targetNeighbors(j, i)) + maxImpNorm(l, i) +
-              2 * norm(i));
-        }
-
-        // Calculate exact eval value.
-        if (eval > -1)
-        {
-          if (iteration - 1 % updateInterval == 0)
-          {
-            eval = distance.Evaluate(transformedDataset.col(i),
-                     transformedDataset.col(targetNeighbors(j, i))) -
-                 distanceMat(l, i);
-          }
-          else
-          {
-            eval = distance.Evaluate(transformedDataset.col(i),
-                     transformedDataset.col(targetNeighbors(j, i))) -
-                   distance.Evaluate(transformedDataset.col(i),
-                       transformedDataset.col(impostors(l, i)));
-          }
-        }
-
-        // Update cache eval value.
-        evalOld(l, j, i) = eval;
-
-        // Check bounding condition.
-        if (eval <= -1)
-        {
-          // update bound.
-          bp = l;
-          break;
-        }
-
-        cost += regularization * (1 + eval);
-
-        // Caculate gradient due to impostors.
-        VecType diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
-        cil += diff * trans(diff);
-
-        diff = dataset.col(i) - dataset.col(impostors(l, i));
-        cil -= diff * trans(diff);
-      }
-    }
-  }
+  const std::unordered_map<size_t, ElemType> noTransformationDiffs;
+  cost += TripletTerms<false, false>(0, dataset.n_cols, transformationDiff,
+      noTransformationDiffs, true, NULL, &cil);
 
   gradient = 2 * transformation * ((1 - regularization) * cij +
       regularization * cil);
@@ -882,7 +537,7 @@ LMNNFunction<MatType, LabelsType, DistanceType>::EvaluateWithGradient(
   TransDiff(transformationDiffs, transformation, begin, batchSize);
 
   // Apply distance metric over dataset.
-  transformedDataset = transformation * dataset;
+  TransformDataset(transformation);
 
   if (impBounds && iteration++ % updateInterval == 0)
   {
@@ -922,86 +577,191 @@ LMNNFunction<MatType, LabelsType, DistanceType>::EvaluateWithGradient(
   MatType cij = zeros<MatType>(dataset.n_rows, dataset.n_rows);
   MatType cil = zeros<MatType>(dataset.n_rows, dataset.n_rows);
 
-  for (size_t i = begin; i < begin + batchSize; ++i)
-  {
-    for (size_t j = 0; j < k ; ++j)
-    {
-      // Calculate cost due to distance between target neighbors & data point.
-      ElemType eval = distance.Evaluate(transformedDataset.col(i),
-                        transformedDataset.col(targetNeighbors(j, i)));
-      cost += (1 - regularization) * eval;
+  cost += TripletTerms<true, false>(begin, begin + batchSize, 0,
+      transformationDiffs, true, &cij, &cil);
 
-      // Calculate gradient due to target neighbors.
-      VecType diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
-      cij += diff * trans(diff);
-    }
+  gradient = 2 * transformation * ((1 - regularization) * cij +
+      regularization * cil);
 
-    for (int j = k - 1; j >= 0; j--)
+  // Update cache.
+  UpdateCache(transformation, begin, batchSize);
+
+  return cost;
+}
+
+template<typename MatType, typename LabelsType, typename DistanceType>
+inline void LMNNFunction<MatType, LabelsType, DistanceType>::TransformDataset(
+    const MatType& transformation)
+{
+  // Optimizers often evaluate the objective and the gradient at the same
+  // point, so there is no need to transform the dataset twice.
+  if (transformedWith.n_elem == transformation.n_elem &&
+      arma::all(arma::vectorise(transformedWith == transformation)))
+    return;
+
+  transformedDataset = transformation * dataset;
+  transformedWith = transformation;
+}
+
+template<typename MatType, typename LabelsType, typename DistanceType>
+template<bool Batch, bool ResetCache>
+typename MatType::elem_type
+LMNNFunction<MatType, LabelsType, DistanceType>::TripletTerms(
+    const size_t begin,
+    const size_t end,
+    const ElemType transformationDiff,
+    const std::unordered_map<size_t, ElemType>& transformationDiffs,
+    const bool computeCost,
+    MatType* cij,
+    MatType* cil)
+{
+  const bool useDistanceMat = (iteration - 1 % updateInterval == 0);
+  const size_t dims = dataset.n_rows;
+  ElemType cost = 0;
+
+  #pragma omp parallel reduction(+:cost)
+  {
+    // Each thread accumulates its own part of the gradient.
+    MatType cijLocal, cilLocal;
+    if (cij)
+      cijLocal.zeros(dims, dims);
+    if (cil)
+      cilLocal.zeros(dims, dims);
+
+    // The number of active triplets each target neighbor and each impostor of
+    // the current point is part of.
+    VecType targetWeights(k), impostorWeights(k);
+
+    #pragma omp for schedule(dynamic, 64)
+    for (size_t i = begin; i < end; ++i)
     {
-      // Bound constraints to avoid uneccesary computation.
-      for (size_t l = 0, bp = k; l < bp ; l++)
+      for (size_t j = 0; j < k; ++j)
       {
-        // Calculate cost due to {data point, target neighbors, impostors}
-        // triplets.
-        ElemType eval = 0;
-
-        // Bounds for eval.
-        if (lastTransformationIndices(i) && evalOld(l, j, i) < -1)
+        // Calculate cost due to distance between target neighbors & data
+        // point.
+        if (computeCost)
         {
-          // Update cache max impostor norm.
-          maxImpNorm(l, i) = std::max(maxImpNorm(l, i), norm(impostors(l, i)));
+          ElemType eval = distance.Evaluate(transformedDataset.col(i),
+              transformedDataset.col(targetNeighbors(j, i)));
+          cost += (1 - regularization) * eval;
+        }
 
-          eval = evalOld(l, j, i) +
-              transformationDiffs[lastTransformationIndices[i]] *
-              (norm(targetNeighbors(j, i)) + maxImpNorm(l, i) + 2 * norm(i));
+        // Calculate gradient due to target neighbors.
+        if (cij)
+        {
+          VecType diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
+          cijLocal += diff * trans(diff);
         }
+      }
 
-        // Calculate exact eval value.
-        if (eval > -1)
+      targetWeights.zeros();
+      impostorWeights.zeros();
+      for (int j = k - 1; j >= 0; j--)
+      {
+        // Bound constraints to avoid uneccesary computation. Here bp stands
+        // for breaking point.
+        for (size_t l = 0, bp = k; l < bp; l++)
         {
-          if (iteration - 1 % updateInterval == 0)
+          // Calculate cost due to {data point, target neighbors, impostors}
+          // triplets.
+          ElemType eval = 0;
+
+          // Bounds for eval.
+          const bool bounded = Batch ? (lastTransformationIndices(i) != 0) :
+              !transformationOld.is_empty();
+          if (bounded && evalOld(l, j, i) < -1)
           {
-            eval = distance.Evaluate(transformedDataset.col(i),
-                     transformedDataset.col(targetNeighbors(j, i))) -
-                 distanceMat(l, i);
+            const ElemType diffNorm = Batch ? transformationDiffs.at(
+                (size_t) lastTransformationIndices[i]) : transformationDiff;
+
+            // Update cache max impostor norm.
+            maxImpNorm(l, i) = std::max(maxImpNorm(l, i),
+                norm(impostors(l, i)));
+
+            eval = evalOld(l, j, i) + diffNorm * (norm(targetNeighbors(j, i)) +
+                maxImpNorm(l, i) + 2 * norm(i));
           }
-          else
+
+          // Calculate exact eval value.
+          if (eval > -1)
           {
-            eval = distance.Evaluate(transformedDataset.col(i),
-                     transformedDataset.col(targetNeighbors(j, i))) -
-                   distance.Evaluate(transformedDataset.col(i),
-                       transformedDataset.col(impostors(l, i)));
+            if (useDistanceMat)
+            {
+              eval = distance.Evaluate(transformedDataset.col(i),
+                       transformedDataset.col(targetNeighbors(j, i))) -
+                   distanceMat(l, i);
+            }
+            else
+            {
+              eval = distance.Evaluate(transformedDataset.col(i),
+                       transformedDataset.col(targetNeighbors(j, i))) -
+                     distance.Evaluate(transformedDataset.col(i),
+                         transformedDataset.col(impostors(l, i)));
+            }
           }
-        }
 
-        // Update cache eval value.
-        evalOld(l, j, i) = eval;
+          // Update cache eval value.
+          evalOld(l, j, i) = eval;
 
-        // Check bounding condition.
-        if (eval <= -1)
-        {
-          // update bound.
-          bp = l;
-          break;
-        }
+          // Check bounding condition.
+          if (eval <= -1)
+          {
+            // update bound.
+            bp = l;
+            break;
+          }
 
-        cost += regularization * (1 + eval);
+          if (computeCost)
+            cost += regularization * (1 + eval);
 
-        // Caculate gradient due to impostors.
-        VecType diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
-        cil += diff * trans(diff);
+          // Reset cache.
+          if (ResetCache && (!Batch || lastTransformationIndices(i)))
+          {
+            // update bound.
+            evalOld(l, j, i) = 0;
+            maxImpNorm(l, i) = 0;
+            if (Batch)
+            {
+              #pragma omp atomic
+              --oldTransformationCounts[lastTransformationIndices(i)];
+              lastTransformationIndices(i) = 0;
+            }
+          }
 
-        diff = dataset.col(i) - dataset.col(impostors(l, i));
-        cil -= diff * trans(diff);
+          // Count the triplet for the gradient due to impostors.
+          targetWeights(j) += 1;
+          impostorWeights(l) += 1;
+        }
       }
-    }
-  }
 
-  gradient = 2 * transformation * ((1 - regularization) * cij +
-      regularization * cil);
+      // Calculate gradient due to impostors.
+      if (cil)
+      {
+        for (size_t j = 0; j < k; ++j)
+        {
+          if (targetWeights(j) > 0)
+          {
+            VecType diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
+            cilLocal += targetWeights(j) * diff * trans(diff);
+          }
 
-  // Update cache.
-  UpdateCache(transformation, begin, batchSize);
+          if (impostorWeights(j) > 0)
+          {
+            VecType diff = dataset.col(i) - dataset.col(impostors(j, i));
+            cilLocal -= impostorWeights(j) * diff * trans(diff);
+          }
+        }
+      }
+    }
+
+    #pragma omp critical
+    {
+      if (cij)
+        *cij += cijLocal;
+      if (cil)
+        *cil += cilLocal;
+    }
+  }
 
   return cost;
 }
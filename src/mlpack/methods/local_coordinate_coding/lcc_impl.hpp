@@ -127,35 +127,39 @@ inline void LocalCoordinateCoding<MatType>::Encode(const MatType& data,
       * data);
 
   MatType dictGram = trans(dictionary) * dictionary;
-  MatType dictGramTD(dictGram.n_rows, dictGram.n_cols);
 
-  codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
-  {
-    // Report progress.
-    if ((i % 100) == 0)
-    {
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
-    }
+  // Normalization and fitting and intercept are disabled.
+  const bool useCholesky = false;
+  const double tol = std::is_same<typename MatType::elem_type, float>::value ?
+      1e-8 : 1e-16;
 
-    ColType invW = invSqDists.unsafe_col(i);
-    MatType dictPrime = dictionary * diagmat(invW);
-
-    MatType dictGramTD = diagmat(invW) * dictGram * diagmat(invW);
+  codes.set_size(atoms, data.n_cols);
 
-    bool useCholesky = false;
-    // Normalization and fitting and intercept are disabled.
-    const double tol = std::is_same<typename MatType::elem_type, float>::value ?
-        1e-8 : 1e-16;
+  // The LARS problem of each point is independent.  Each thread reuses its own
+  // LARS object and weighted dictionary and Gram matrix for all of its points.
+  #pragma omp parallel
+  {
     LARS<MatType> lars(useCholesky, 0.5 * lambda, 0, tol, false, false);
+    MatType dictPrime, dictGramTD;
+    RowType responses;
 
-    // Run LARS for this point, by making an alias of the point and passing
-    // that.
-    ColType beta = codes.unsafe_col(i);
-    RowType responses = data.unsafe_col(i).t();
-    lars.Train(dictPrime, responses, false, useCholesky, dictGramTD);
-    beta = lars.Beta();
-    beta %= invW; // Remember, beta is an alias of codes.col(i).
+    #pragma omp for schedule(dynamic)
+    for (size_t i = 0; i < (size_t) data.n_cols; ++i)
+    {
+      // The weighted dictionary is dictionary * diagmat(invW), and its Gram
+      // matrix is diagmat(invW) * dictGram * diagmat(invW).
+      ColType invW = invSqDists.unsafe_col(i);
+      dictPrime = dictionary.each_row() % invW.t();
+      dictGramTD = dictGram % (invW * invW.t());
+
+      // Run LARS for this point, by making an alias of the point and passing
+      // that.
+      ColType beta = codes.unsafe_col(i);
+      responses = data.col(i).t();
+      lars.Train(dictPrime, responses, false, useCholesky, dictGramTD);
+      beta = lars.Beta();
+      beta %= invW; // Remember, beta is an alias of codes.col(i).
+    }
   }
 }
 
@@ -40,6 +40,7 @@ class LogisticRegression
   typedef typename MatType::elem_type ElemType;
   typedef typename GetDenseRowType<MatType>::type RowType;
   typedef typename GetDenseColType<MatType>::type ColType;
+  typedef typename GetDenseMatType<MatType>::type DenseMatType;
 
   /**
    * Construct the LogisticRegression class without performing any training.
@@ -351,7 +352,7 @@ class LogisticRegression
    */
   void Classify(const MatType& dataset,
                 arma::Row<size_t>& predictions,
-                MatType& probabilities,
+                DenseMatType& probabilities,
                 const double decisionBoundary = 0.5) const;
 
   /**
@@ -363,7 +364,7 @@ class LogisticRegression
   [[deprecated("Will be removed in mlpack 5.0.0; use other Classify() "
       "variants")]]
   void Classify(const MatType& dataset,
-                MatType& probabilities) const;
+                DenseMatType& probabilities) const;
 
   /**
    * Reset the weights in the model to zeros.  This function can be used between
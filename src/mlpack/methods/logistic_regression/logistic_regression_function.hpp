@@ -24,6 +24,11 @@ namespace mlpack {
  * The log-likelihood function for the logistic regression objective function.
  * This is used by various mlpack optimizers to train a logistic regression
  * model.
+ *
+ * MatType may be a sparse matrix type such as arma::sp_mat.  The objective and
+ * all of the gradients (including the separable ones used by SGD) only
+ * multiply the data with dense vectors, so sparse data is never densified or
+ * transposed.
  */
 template<typename MatType = arma::mat>
 class LogisticRegressionFunction
@@ -123,6 +128,28 @@ class LogisticRegressionFunction
                 GradType& gradient,
                 const size_t batchSize = 1) const;
 
+  /**
+   * Evaluate the gradient of the logistic regression log-likelihood function
+   * for the given batch into a sparse matrix; this is the overload used by
+   * ens::ParallelSGD (Hogwild!).  If the predictors are sparse, only the
+   * intercept and the features that are nonzero in the batch get a gradient
+   * (and the regularization is only applied to those features), so that each
+   * update of ParallelSGD only touches the parameters that the batch depends
+   * on.  For dense predictors this is the same as the dense gradient.
+   *
+   * @param parameters Vector of logistic regression parameters.
+   * @param begin Index of the starting point to use for objective function
+   *     gradient evaluation.
+   * @param gradient Sparse vector to output gradient into.
+   * @param batchSize Number of points to be processed as a batch for objective
+   *     function gradient evaluation.
+   */
+  template<typename CoordinatesType, typename eT>
+  void Gradient(const CoordinatesType& parameters,
+                const size_t begin,
+                arma::SpMat<eT>& gradient,
+                const size_t batchSize = 1) const;
+
   /**
    * Evaluate the gradient of the logistic regression log-likelihood function
    * with the given parameters, and with respect to only one feature in the
@@ -175,8 +175,8 @@ void LogisticRegressionFunction<MatType>::Gradient(
 
   gradient.set_size(size(parameters));
   gradient[0] = -accu(responses - sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - responses) *
-      predictors.t() + regularization;
+  gradient.tail_cols(parameters.n_elem - 1) = (predictors *
+      (sigmoids - responses).t()).t() + regularization;
 }
 
 //! Evaluate the gradient of the logistic regression objective function for a
@@ -210,9 +210,76 @@ void LogisticRegressionFunction<MatType>::Gradient(
   gradient.set_size(parameters.n_rows, parameters.n_cols);
   gradient[0] = -accu(responses.subvec(begin, begin + batchSize - 1) -
       sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids -
-      responses.subvec(begin, begin + batchSize - 1)) *
-      predictors.cols(begin, begin + batchSize - 1).t() + regularization;
+  gradient.tail_cols(parameters.n_elem - 1) =
+      (predictors.cols(begin, begin + batchSize - 1) * (sigmoids -
+      responses.subvec(begin, begin + batchSize - 1)).t()).t() +
+      regularization;
+}
+
+//! Evaluate the gradient of the logistic regression objective function for a
+//! given batch size into a sparse matrix.
+template<typename MatType>
+template<typename CoordinatesType, typename eT>
+void LogisticRegressionFunction<MatType>::Gradient(
+                const CoordinatesType& parameters,
+                const size_t begin,
+                arma::SpMat<eT>& gradient,
+                const size_t batchSize) const
+{
+  if constexpr (!arma::is_SpMat<MatType>::value)
+  {
+    // Every feature of the gradient depends on a dense batch.
+    CoordinatesType denseGradient;
+    Gradient(parameters, begin, denseGradient, batchSize);
+    gradient = arma::SpMat<eT>(denseGradient);
+  }
+  else
+  {
+    typedef typename CoordinatesType::elem_type ElemType;
+    constexpr ElemType one = ((ElemType) 1);
+    const size_t end = begin + batchSize - 1;
+
+    const CoordinatesType exponents = parameters(0, 0) +
+        parameters.tail_cols(parameters.n_elem - 1) *
+        predictors.cols(begin, end);
+    const CoordinatesType sigmoids = one / (one + exp(-exponents));
+    const CoordinatesType diffs = sigmoids -
+        arma::conv_to<CoordinatesType>::from(responses.subvec(begin, end));
+
+    // Find the features that are nonzero in the batch; the gradient of all the
+    // other features (and their regularization) is left out.
+    std::vector<size_t> features;
+    for (size_t i = begin; i <= end; ++i)
+      for (auto it = predictors.begin_col(i); it != predictors.end_col(i); ++it)
+        features.push_back(it.row());
+    std::sort(features.begin(), features.end());
+    features.erase(std::unique(features.begin(), features.end()),
+        features.end());
+
+    arma::Col<eT> values(features.size() + 1, arma::fill::zeros);
+    for (size_t i = begin; i <= end; ++i)
+    {
+      for (auto it = predictors.begin_col(i); it != predictors.end_col(i); ++it)
+      {
+        const size_t f = std::lower_bound(features.begin(), features.end(),
+            (size_t) it.row()) - features.begin();
+        values[f + 1] += (*it) * diffs[i - begin];
+      }
+    }
+
+    // The intercept is the first element of the parameters.
+    arma::umat locations(2, features.size() + 1, arma::fill::zeros);
+    values[0] = accu(diffs);
+    for (size_t f = 0; f < features.size(); ++f)
+    {
+      locations(1, f + 1) = features[f] + 1;
+      values[f + 1] += lambda * parameters[features[f] + 1] /
+          predictors.n_cols * batchSize;
+    }
+
+    gradient = arma::SpMat<eT>(locations, values, parameters.n_rows,
+        parameters.n_cols);
+  }
 }
 
 /**
@@ -244,7 +311,7 @@ void LogisticRegressionFunction<MatType>::PartialGradient(
   }
   else
   {
-    gradient[j] = dot(-predictors.row(j - 1), diffs) + lambda *
+    gradient[j] = -dot(predictors.row(j - 1), diffs) + lambda *
         parameters(0, j);
   }
 }
@@ -278,8 +345,8 @@ LogisticRegressionFunction<MatType>::EvaluateWithGradient(
 
   gradient.set_size(size(parameters));
   gradient[0] = -accu(responses - sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - responses) *
-      predictors.t() + regularization;
+  gradient.tail_cols(parameters.n_elem - 1) = (predictors *
+      (sigmoids - responses).t()).t() + regularization;
 
   // Now compute the objective function using the sigmoids.
   ElemType result = accu(log(one -
@@ -325,9 +392,10 @@ LogisticRegressionFunction<MatType>::EvaluateWithGradient(
   gradient.set_size(parameters.n_rows, parameters.n_cols);
   gradient[0] = -accu(responses.subvec(begin, begin + batchSize - 1) -
       sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids -
-      responses.subvec(begin, begin + batchSize - 1)) *
-      predictors.cols(begin, begin + batchSize - 1).t() + regularization;
+  gradient.tail_cols(parameters.n_elem - 1) =
+      (predictors.cols(begin, begin + batchSize - 1) * (sigmoids -
+      responses.subvec(begin, begin + batchSize - 1)).t()).t() +
+      regularization;
 
   // Now compute the objective function using the sigmoids.
   CoordinatesType respD = ConvTo<CoordinatesType>::From(
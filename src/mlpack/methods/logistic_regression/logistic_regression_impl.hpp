@@ -207,7 +207,7 @@ void LogisticRegression<MatType>::Classify(const MatType& dataset,
 
 template<typename MatType>
 void LogisticRegression<MatType>::Classify(const MatType& dataset,
-                                           MatType& probabilities) const
+                                           DenseMatType& probabilities) const
 {
   // Set correct size of output matrix.
   probabilities.set_size(2, dataset.n_cols);
@@ -220,7 +220,7 @@ void LogisticRegression<MatType>::Classify(const MatType& dataset,
 template<typename MatType>
 void LogisticRegression<MatType>::Classify(const MatType& dataset,
                                            arma::Row<size_t>& predictions,
-                                           MatType& probabilities,
+                                           DenseMatType& probabilities,
                                            const double decisionBoundary) const
 {
   // Used to prevent automatic casting to double.
@@ -251,7 +251,7 @@ double LogisticRegression<MatType>::ComputeError(
     const arma::Row<size_t>& responses) const
 {
   // Construct a new error function.
-  LogisticRegressionFunction<> newErrorFunction(predictors, responses,
+  LogisticRegressionFunction<MatType> newErrorFunction(predictors, responses,
       lambda);
 
   return newErrorFunction.Evaluate(parameters);
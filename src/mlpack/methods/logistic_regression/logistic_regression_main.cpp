@@ -34,7 +34,8 @@ BINDING_SHORT_DESC(
 // Long description.
 BINDING_LONG_DESC(
     "An implementation of L2-regularized logistic regression using either the "
-    "L-BFGS optimizer or SGD (stochastic gradient descent).  This solves the "
+    "L-BFGS optimizer, SGD (stochastic gradient descent), or parallel SGD.  "
+    "This solves the "
     "regression problem"
     "\n\n"
     "  y = (1 / 1 + e^-(X * b))."
@@ -56,17 +57,29 @@ BINDING_LONG_DESC(
     "dimension.  Alternately, the " + PRINT_PARAM_STRING("labels") + " "
     "parameter may be used to specify a separate matrix of labels."
     "\n\n"
+    "For sparse data (for instance, hashed features), the " +
+    PRINT_PARAM_STRING("sparse_training") + " and " +
+    PRINT_PARAM_STRING("sparse_test") + " parameters may be given instead of " +
+    PRINT_PARAM_STRING("training") + " and " + PRINT_PARAM_STRING("test") +
+    ".  They are names of files holding coordinate lists, where each line "
+    "gives the index of a point, a dimension, and the nonzero value of the "
+    "point in that dimension; the data is never converted to a dense matrix.  "
+    "The labels of a sparse training set must be given with " +
+    PRINT_PARAM_STRING("labels") + "."
+    "\n\n"
     "When a model is being trained, there are many options.  L2 regularization "
     "(to prevent overfitting) can be specified with the " +
     PRINT_PARAM_STRING("lambda") + " option, and the "
     "optimizer used to train the model can be specified with the " +
     PRINT_PARAM_STRING("optimizer") + " parameter.  Available options are "
-    "'sgd' (stochastic gradient descent) and 'lbfgs' (the L-BFGS optimizer).  "
+    "'sgd' (stochastic gradient descent), 'psgd' (lock-free parallel "
+    "stochastic gradient descent, also known as Hogwild!) and 'lbfgs' (the "
+    "L-BFGS optimizer).  "
     "There are also various parameters for the optimizer; the " +
     PRINT_PARAM_STRING("max_iterations") + " parameter specifies the maximum "
     "number of allowed iterations, and the " +
     PRINT_PARAM_STRING("tolerance") + " parameter specifies the tolerance for "
-    "convergence.  For the SGD optimizer, the " +
+    "convergence.  For the SGD and parallel SGD optimizers, the " +
     PRINT_PARAM_STRING("step_size") + " parameter controls the step size taken "
     "at each iteration by the optimizer.  The batch size for SGD is controlled "
     "with the " + PRINT_PARAM_STRING("batch_size") + " parameter. If the "
@@ -78,6 +91,12 @@ BINDING_LONG_DESC(
     "over the dataset with SGD, " + PRINT_PARAM_STRING("max_iterations") +
     " should be set to the number of points in the dataset."
     "\n\n"
+    "Parallel SGD splits each pass over the dataset between all threads, "
+    "which update the model without locking; with sparse data (given with " +
+    PRINT_PARAM_STRING("sparse_training") + "), each update only touches the "
+    "features of its point, so the threads rarely conflict.  As for SGD, an "
+    "iteration refers to a single point."
+    "\n\n"
     "Optionally, the model can be used to predict the responses for another "
     "matrix of data points, if " + PRINT_PARAM_STRING("test") + " is "
     "specified.  The " + PRINT_PARAM_STRING("test") + " parameter can be "
@@ -125,16 +144,19 @@ PARAM_MATRIX_IN("training", "A matrix containing the training set (the matrix "
 PARAM_UROW_IN("labels", "A matrix containing labels (0 or 1) for the points "
     "in the training set (y).", "l");
 
+PARAM_STRING_IN("sparse_training", "File containing a sparse training set as a "
+    "coordinate list (may be given instead of 'training').", "S", "");
+
 // Optimizer parameters.
 PARAM_DOUBLE_IN("lambda", "L2-regularization parameter for training.", "L",
     0.0);
-PARAM_STRING_IN("optimizer", "Optimizer to use for training ('lbfgs' or "
-    "'sgd').", "O", "lbfgs");
+PARAM_STRING_IN("optimizer", "Optimizer to use for training ('lbfgs', "
+    "'sgd', or 'psgd').", "O", "lbfgs");
 PARAM_DOUBLE_IN("tolerance", "Convergence tolerance for optimizer.", "e",
     1e-10);
 PARAM_INT_IN("max_iterations", "Maximum iterations for optimizer (0 indicates "
     "no limit).", "n", 10000);
-PARAM_DOUBLE_IN("step_size", "Step size for SGD optimizer.",
+PARAM_DOUBLE_IN("step_size", "Step size for SGD and parallel SGD optimizers.",
     "s", 0.01);
 PARAM_INT_IN("batch_size", "Batch size for SGD.", "b", 64);
 
@@ -146,6 +168,8 @@ PARAM_MODEL_OUT(LogisticRegression<>, "output_model", "Output for trained "
 
 // Testing.
 PARAM_MATRIX_IN("test", "Matrix containing test dataset.", "T");
+PARAM_STRING_IN("sparse_test", "File containing a sparse test dataset as a "
+    "coordinate list (may be given instead of 'test').", "X", "");
 PARAM_UROW_OUT("predictions", "If test data is specified, this matrix is where "
     "the predictions for the test set will be saved.", "P");
 PARAM_MATRIX_OUT("probabilities", "If test data is specified, this "
@@ -158,23 +182,144 @@ PARAM_FLAG("print_training_accuracy", "If set, then the accuracy of the model "
     "on the training set will be printed (verbose must also be specified).",
     "a");
 
-void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
+// Train the model with the chosen optimizer, and print the accuracy on the
+// training set if requested.
+template<typename MatType>
+void TrainModel(util::Params& params,
+                util::Timers& timers,
+                LogisticRegression<MatType>& model,
+                const MatType& regressors,
+                const arma::Row<size_t>& responses)
 {
-  // Collect command-line options.
-  const double lambda = params.Get<double>("lambda");
   const string optimizerType = params.Get<string>("optimizer");
   const double tolerance = params.Get<double>("tolerance");
-  const double stepSize = params.Get<double>("step_size");
-  const size_t batchSize = (size_t) params.Get<int>("batch_size");
   const size_t maxIterations = (size_t) params.Get<int>("max_iterations");
+
+  if (optimizerType == "sgd")
+  {
+    ens::SGD<> sgdOpt;
+    sgdOpt.MaxIterations() = maxIterations;
+    sgdOpt.Tolerance() = tolerance;
+    sgdOpt.StepSize() = params.Get<double>("step_size");
+    sgdOpt.BatchSize() = (size_t) params.Get<int>("batch_size");
+    Log::Info << "Training model with SGD optimizer." << endl;
+
+    // This will train the model.
+    timers.Start("logistic_regression_optimization");
+    model.Train(regressors, responses, sgdOpt);
+    timers.Stop("logistic_regression_optimization");
+  }
+  else if (optimizerType == "psgd")
+  {
+    #ifdef MLPACK_USE_OPENMP
+    const size_t threads = omp_get_max_threads();
+    #else
+    const size_t threads = 1;
+    Log::Warn << "Using parallel SGD, but OpenMP support is "
+              << "not available!" << endl;
+    #endif
+
+    // Each iteration of ParallelSGD is a pass over the dataset, split between
+    // the threads.
+    const size_t passes = (maxIterations == 0) ? 0 :
+        (maxIterations + regressors.n_cols - 1) / regressors.n_cols;
+    ens::ParallelSGD<ens::ConstantStep> psgdOpt(passes, std::ceil(
+        (float) regressors.n_cols / threads), tolerance, true,
+        ens::ConstantStep(params.Get<double>("step_size")));
+    Log::Info << "Training model with ParallelSGD optimizer." << endl;
+
+    // This will train the model.
+    timers.Start("logistic_regression_optimization");
+    model.Train(regressors, responses, psgdOpt);
+    timers.Stop("logistic_regression_optimization");
+  }
+  else if (optimizerType == "lbfgs")
+  {
+    ens::L_BFGS lbfgsOpt;
+    lbfgsOpt.MaxIterations() = maxIterations;
+    lbfgsOpt.MinGradientNorm() = tolerance;
+    Log::Info << "Training model with L-BFGS optimizer." << endl;
+
+    // This will train the model.
+    timers.Start("logistic_regression_optimization");
+    model.Train(regressors, responses, lbfgsOpt);
+    timers.Stop("logistic_regression_optimization");
+  }
+
+  // Did we want training accuracy?
+  if (params.Has("print_training_accuracy"))
+  {
+    timers.Start("lr_prediction");
+    arma::Row<size_t> predictions;
+    model.Classify(regressors, predictions);
+
+    const size_t correct = accu(predictions == responses);
+
+    Log::Info << correct << " of " << responses.n_elem << " correct on "
+        << "training set ("
+        << (double(correct) / double(responses.n_elem) * 100) << ")." << endl;
+    timers.Stop("lr_prediction");
+  }
+}
+
+// Compute the predictions and probabilities on the test set that were
+// requested.
+template<typename MatType>
+void ClassifyTestSet(util::Params& params,
+                     const LogisticRegression<MatType>& model,
+                     const MatType& testSet,
+                     const string& testName)
+{
   const double decisionBoundary = params.Get<double>("decision_boundary");
 
-  // One of training and input_model must be specified.
-  RequireAtLeastOnePassed(params, { "training", "input_model" }, true);
+  // We must perform predictions on the test set.  Training (and the
+  // optimizer) are irrelevant here; we'll pass in the model we have.
+  arma::Row<size_t> predictions;
+  if (params.Has("predictions"))
+  {
+    Log::Info << "Predicting classes of points in '" << testName << "'."
+        << endl;
+    model.Classify(testSet, predictions, decisionBoundary);
+    params.Get<arma::Row<size_t>>("predictions") = predictions;
+  }
+
+  if (params.Has("probabilities"))
+  {
+    Log::Info << "Calculating class probabilities of points in '" << testName
+        << "'." << endl;
+    arma::mat probabilities;
+    model.Classify(testSet, predictions, probabilities);
+    params.Get<arma::mat>("probabilities") = std::move(probabilities);
+  }
+}
+
+void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
+{
+  // Collect command-line options.
+  const double lambda = params.Get<double>("lambda");
+  const string optimizerType = params.Get<string>("optimizer");
+
+  // One of training, sparse_training and input_model must be specified, and
+  // a dense and a sparse dataset cannot both be given.
+  RequireAtLeastOnePassed(params, { "training", "sparse_training",
+      "input_model" }, true);
+  RequireOnlyOnePassed(params, { "training", "sparse_training" }, true, "",
+      true);
+  RequireOnlyOnePassed(params, { "test", "sparse_test" }, true, "", true);
+  const bool hasTraining = params.Has("training") ||
+      params.Has("sparse_training");
+  const bool hasTest = params.Has("test") || params.Has("sparse_test");
+
+  // The labels of sparse data must be given separately.
+  if (params.Has("sparse_training"))
+  {
+    RequireAtLeastOnePassed(params, { "labels" }, true, "the labels of a "
+        "sparse training set must be given");
+  }
 
   // If no output file is given, the user should know that the model will not be
   // saved, but only if a model is being trained.
-  if (params.Has("training"))
+  if (hasTraining)
   {
     RequireAtLeastOnePassed(params, { "output_model" }, false, "trained model "
         "will not be saved");
@@ -183,14 +328,17 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   RequireAtLeastOnePassed(params, { "output_model", "predictions",
       "probabilities"}, false, "no output will be saved");
 
-  ReportIgnoredParam(params, {{ "test", false }}, "predictions");
-  ReportIgnoredParam(params, {{ "test", false }}, "probabilities");
+  ReportIgnoredParam(params, {{ "test", false }, { "sparse_test", false }},
+      "predictions");
+  ReportIgnoredParam(params, {{ "test", false }, { "sparse_test", false }},
+      "probabilities");
 
-  ReportIgnoredParam(params, {{ "training", false }},
-      "print_training_accuracy");
+  ReportIgnoredParam(params, {{ "training", false },
+      { "sparse_training", false }}, "print_training_accuracy");
 
   RequireAtLeastOnePassed(params,
-      { "test", "output_model", "print_training_accuracy" }, false,
+      { "test", "sparse_test", "output_model", "print_training_accuracy" },
+      false,
       "the trained logistic regression model will not be used or saved");
 
   // Max Iterations needs to be positive.
@@ -207,7 +355,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
       true, "tolerance must be positive or zero");
 
   // Optimizer has to be L-BFGS or SGD.
-  RequireParamInSet<string>(params, "optimizer", { "lbfgs", "sgd" },
+  RequireParamInSet<string>(params, "optimizer", { "lbfgs", "sgd", "psgd" },
       true, "unknown optimizer");
 
   // Lambda must be positive.
@@ -222,29 +370,35 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   RequireParamValue<double>(params, "step_size",
       [](double x) { return x >= 0.0; }, true, "step size must be positive");
 
-  if (optimizerType != "sgd")
+  if (optimizerType == "lbfgs" && params.Has("step_size"))
   {
-    if (params.Has("step_size"))
-    {
-      Log::Warn << PRINT_PARAM_STRING("step_size") << " ignored because "
-          << "optimizer type is not 'sgd'." << std::endl;
-    }
-    if (params.Has("batch_size"))
-    {
-      Log::Warn << PRINT_PARAM_STRING("batch_size") << " ignored because "
-          << "optimizer type is not 'sgd'." << std::endl;
-    }
+    Log::Warn << PRINT_PARAM_STRING("step_size") << " ignored because "
+        << "optimizer type is not 'sgd' or 'psgd'." << std::endl;
+  }
+  if (optimizerType != "sgd" && params.Has("batch_size"))
+  {
+    Log::Warn << PRINT_PARAM_STRING("batch_size") << " ignored because "
+        << "optimizer type is not 'sgd'." << std::endl;
   }
 
   // These are the matrices we might use.
   arma::mat regressors;
+  arma::sp_mat sparseRegressors;
   arma::Row<size_t> responses;
-  arma::mat testSet;
-  arma::Row<size_t> predictions;
 
   // Load data matrix.
   if (params.Has("training"))
+  {
     regressors = std::move(params.Get<arma::mat>("training"));
+  }
+  else if (params.Has("sparse_training"))
+  {
+    data::Load(params.Get<string>("sparse_training"), sparseRegressors, true);
+  }
+  const size_t dimensionality = params.Has("sparse_training") ?
+      sparseRegressors.n_rows : regressors.n_rows;
+  const size_t numPoints = params.Has("sparse_training") ?
+      sparseRegressors.n_cols : regressors.n_cols;
 
   // Load the model, if necessary.
   LogisticRegression<>* model;
@@ -256,16 +410,25 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 
     // Set the size of the parameters vector, if necessary.
     if (!params.Has("labels"))
-      model->Parameters() = zeros<arma::rowvec>(regressors.n_rows);
+      model->Parameters() = zeros<arma::rowvec>(dimensionality);
     else
-      model->Parameters() = zeros<arma::rowvec>(regressors.n_rows + 1);
+      model->Parameters() = zeros<arma::rowvec>(dimensionality + 1);
+  }
+
+  // A coordinate list does not store trailing dimensions that are zero for
+  // every point, so the sparse training set may have fewer dimensions than the
+  // model.
+  if (params.Has("sparse_training") && params.Has("input_model") &&
+      sparseRegressors.n_rows + 1 < model->Parameters().n_elem)
+  {
+    sparseRegressors.resize(model->Parameters().n_elem - 1, numPoints);
   }
 
   // Check if the responses are in a separate file.
-  if (params.Has("training") && params.Has("labels"))
+  if (hasTraining && params.Has("labels"))
   {
     responses = std::move(params.Get<arma::Row<size_t>>("labels"));
-    if (responses.n_cols != regressors.n_cols)
+    if (responses.n_cols != numPoints)
     {
       // Clean memory if needed.
       if (!params.Has("input_model"))
@@ -295,7 +458,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   }
 
   // Verify the labels.
-  if (params.Has("training") && max(responses) > 1)
+  if (hasTraining && max(responses) > 1)
   {
     // Clean memory if needed.
     if (!params.Has("input_model"))
@@ -309,88 +472,65 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   if (params.Has("training"))
   {
     model->Lambda() = lambda;
+    TrainModel(params, timers, *model, regressors, responses);
+  }
+  else if (params.Has("sparse_training"))
+  {
+    // The parameters of a sparse model are the same as those of a dense one.
+    LogisticRegression<arma::sp_mat> sparseModel(0, lambda);
+    sparseModel.Parameters() = model->Parameters();
+    TrainModel(params, timers, sparseModel, sparseRegressors, responses);
 
-    if (optimizerType == "sgd")
+    model->Lambda() = lambda;
+    model->Parameters() = std::move(sparseModel.Parameters());
+  }
+
+  if (hasTest)
+  {
+    arma::mat testSet;
+    arma::sp_mat sparseTestSet;
+    if (params.Has("test"))
     {
-      ens::SGD<> sgdOpt;
-      sgdOpt.MaxIterations() = maxIterations;
-      sgdOpt.Tolerance() = tolerance;
-      sgdOpt.StepSize() = stepSize;
-      sgdOpt.BatchSize() = batchSize;
-      Log::Info << "Training model with SGD optimizer." << endl;
-
-      // This will train the model.
-      timers.Start("logistic_regression_optimization");
-      model->Train(regressors, responses, sgdOpt);
-      timers.Stop("logistic_regression_optimization");
+      testSet = std::move(params.Get<arma::mat>("test"));
     }
-    else if (optimizerType == "lbfgs")
+    else
     {
-      ens::L_BFGS lbfgsOpt;
-      lbfgsOpt.MaxIterations() = maxIterations;
-      lbfgsOpt.MinGradientNorm() = tolerance;
-      Log::Info << "Training model with L-BFGS optimizer." << endl;
-
-      // This will train the model.
-      timers.Start("logistic_regression_optimization");
-      model->Train(regressors, responses, lbfgsOpt);
-      timers.Stop("logistic_regression_optimization");
+      data::Load(params.Get<string>("sparse_test"), sparseTestSet, true);
+
+      // Trailing dimensions that are zero for every point may be missing.
+      if (sparseTestSet.n_rows + 1 < model->Parameters().n_elem)
+      {
+        sparseTestSet.resize(model->Parameters().n_elem - 1,
+            sparseTestSet.n_cols);
+      }
     }
 
-    // Did we want training accuracy?
-    if (params.Has("print_training_accuracy"))
-    {
-      timers.Start("lr_prediction");
-      arma::Row<size_t> predictions;
-      model->Classify(regressors, predictions);
-
-      const size_t correct = accu(predictions == responses);
-
-      Log::Info << correct << " of " << responses.n_elem << " correct on "
-          << "training set ("
-          << (double(correct) / double(responses.n_elem) * 100) << ")." << endl;
-      timers.Stop("lr_prediction");
-    }
-  }
-
-  if (params.Has("test"))
-  {
-    const arma::mat& testSet = params.Get<arma::mat>("test");
-
     // Checking the dimensionality of the test data.
-    if (testSet.n_rows != model->Parameters().n_cols - 1)
+    const size_t testDimensionality = params.Has("test") ? testSet.n_rows :
+        sparseTestSet.n_rows;
+    if (testDimensionality != model->Parameters().n_cols - 1)
     {
       // Clean memory if needed.
       const size_t trainingDimensionality = model->Parameters().n_cols - 1;
       if (!params.Has("input_model"))
         delete model;
 
-      Log::Fatal << "Test data dimensionality (" << testSet.n_rows << ") must "
-          << "be the same as the dimensionality of the training data ("
+      Log::Fatal << "Test data dimensionality (" << testDimensionality << ") "
+          << "must be the same as the dimensionality of the training data ("
           << trainingDimensionality << ")!" << endl;
     }
 
-    // We must perform predictions on the test set.  Training (and the
-    // optimizer) are irrelevant here; we'll pass in the model we have.
-    if (params.Has("predictions"))
+    if (params.Has("test"))
     {
-      Log::Info << "Predicting classes of points in '"
-          << params.GetPrintable<arma::mat>("test") << "'." << endl;
-      model->Classify(testSet, predictions, decisionBoundary);
-
-      if (params.Has("predictions"))
-        params.Get<arma::Row<size_t>>("predictions") = predictions;
+      ClassifyTestSet(params, *model, testSet,
+          params.GetPrintable<arma::mat>("test"));
     }
-
-    if (params.Has("probabilities"))
+    else
     {
-      Log::Info << "Calculating class probabilities of points in '"
-          << params.GetPrintable<arma::mat>("test") << "'." << endl;
-      arma::mat probabilities;
-      model->Classify(testSet, predictions, probabilities);
-
-      if (params.Has("probabilities"))
-        params.Get<arma::mat>("probabilities") = std::move(probabilities);
+      LogisticRegression<arma::sp_mat> sparseModel(0, model->Lambda());
+      sparseModel.Parameters() = model->Parameters();
+      ClassifyTestSet(params, sparseModel, sparseTestSet,
+          params.Get<string>("sparse_test"));
     }
   }
 
@@ -103,6 +103,9 @@ PARAM_INT_IN("second_hash_size", "The size of the second level hash table.",
     "S", 99901);
 PARAM_INT_IN("bucket_size", "The size of a bucket in the second level hash.",
     "B", 500);
+PARAM_FLAG("compact", "If set, store the second level hash table in the "
+    "compact format, which packs the points of all buckets as 32-bit indices "
+    "and needs much less memory.", "c");
 PARAM_INT_IN("seed", "Random seed.  If 0, 'std::time(NULL)' is used.", "s", 0);
 
 void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
@@ -152,6 +155,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   ReportIgnoredParam(params, {{ "reference", false }}, "bucket_size");
   ReportIgnoredParam(params, {{ "reference", false }}, "second_hash_size");
   ReportIgnoredParam(params, {{ "reference", false }}, "hash_width");
+  ReportIgnoredParam(params, {{ "reference", false }}, "compact");
 
   if (params.Has("input_model") && !params.Has("k"))
   {
@@ -189,7 +193,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 
     timers.Start("hash_building");
     allkann->Train(std::move(referenceData), numProj, numTables, hashWidth,
-        secondHashSize, bucketSize);
+        secondHashSize, bucketSize, arma::cube(), params.Get<bool>("compact"));
     timers.Stop("hash_building");
   }
   else // We must have an input model.
@@ -89,12 +89,15 @@ class LSHSearch
    *     the maximum number of points that can be hashed into single bucket.  A
    *     value of 0 indicates that there is no limit (so the second hash table
    *     can be arbitrarily large---be careful!).
+   * @param compactStorage If true, store the second hash table in the compact
+   *     format (see CompactStorage()).
    */
   LSHSearch(MatType referenceSet,
             const arma::cube& projections,
             const double hashWidth = 0.0,
             const size_t secondHashSize = 99901,
-            const size_t bucketSize = 500);
+            const size_t bucketSize = 500,
+            const bool compactStorage = false);
 
   /**
    * This function initializes the LSH class. It builds the hash one the
@@ -117,13 +120,16 @@ class LSHSearch
    *     the maximum number of points that can be hashed into single bucket.  A
    *     value of 0 indicates that there is no limit (so the second hash table
    *     can be arbitrarily large---be careful!).
+   * @param compactStorage If true, store the second hash table in the compact
+   *     format (see CompactStorage()).
    */
   LSHSearch(MatType referenceSet,
             const size_t numProj,
             const size_t numTables,
             const double hashWidth = 0.0,
             const size_t secondHashSize = 99901,
-            const size_t bucketSize = 500);
+            const size_t bucketSize = 500,
+            const bool compactStorage = false);
 
   /**
    * Create an untrained LSH model.  Be sure to call Train() before calling
@@ -183,6 +189,9 @@ class LSHSearch
    * @param projection Cube of projection tables. For a cube of size (a, b, c)
    *     we set numProj = a, numTables = c. b is the reference set
    *     dimensionality.
+   * @param compactStorage If true, store the second hash table in the compact
+   *     format (see CompactStorage()).  This requires fewer than 2^32 - 1
+   *     reference points and a second hash size below 2^32 - 1.
    */
   void Train(MatType referenceSet,
              const size_t numProj,
@@ -190,7 +199,31 @@ class LSHSearch
              const double hashWidth = 0.0,
              const size_t secondHashSize = 99901,
              const size_t bucketSize = 500,
-             const arma::cube& projection = arma::cube());
+             const arma::cube& projection = arma::cube(),
+             const bool compactStorage = false);
+
+  /**
+   * Add the given points to the reference set.  The points are hashed with the
+   * existing projections and appended to their buckets (up to the bucket size),
+   * so nothing is rehashed; the new points get the indices after the current
+   * last reference point.  In the compact format (see CompactStorage()), the
+   * packed bucket vector is rebuilt, which takes time linear in its size, so it
+   * is best to insert points in batches.  The model must be trained.
+   *
+   * @param newPoints Points to add to the reference set.
+   */
+  void Insert(const MatType& newPoints);
+
+  /**
+   * Remove the given points from the model.  This is lazy: the points are only
+   * marked as removed, and they are never returned as neighbors, but they stay
+   * in the reference set and in their buckets (so their indices do not change,
+   * and they still count towards the bucket size) until the model is trained
+   * again.
+   *
+   * @param ids Indices of the reference points to remove.
+   */
+  void Remove(const arma::uvec& ids);
 
   /**
    * Compute the nearest neighbors of the points in the given query set and
@@ -277,6 +310,11 @@ class LSHSearch
   //! Get the number of projections.
   size_t NumProjections() const { return projections.n_slices; }
 
+  //! Get whether the given reference point has been removed with Remove().
+  bool IsRemoved(const size_t index) const { return removed[index]; }
+  //! Get the number of reference points that have been removed.
+  size_t NumRemoved() const { return numRemoved; }
+
   //! Get the offsets 'b' for each of the projections.  (One 'b' per column.)
   const arma::mat& Offsets() const { return offsets; }
 
@@ -286,10 +324,29 @@ class LSHSearch
   //! Get the bucket size of the second hash.
   size_t BucketSize() const { return bucketSize; }
 
-  //! Get the second hash table.
+  //! Get the second hash table.  This is empty if CompactStorage() is true.
   const std::vector<arma::Col<size_t>>& SecondHashTable() const
       { return secondHashTable; }
 
+  /**
+   * Get whether the second hash table is stored in the compact format.  In that
+   * format, the points of all buckets are packed as 32-bit indices into one
+   * vector, BucketPoints(), and bucket i holds the points from BucketOffsets()[i]
+   * to BucketOffsets()[i + 1]; the row of each second-level hash code is also
+   * stored as a 32-bit integer.  This avoids the overhead of one vector per
+   * bucket and halves the size of the indices.  Search results are the same in
+   * both formats.
+   */
+  bool CompactStorage() const { return compactStorage; }
+
+  //! Get the offset of each bucket in BucketPoints(), followed by the total
+  //! number of points (empty unless CompactStorage() is true).
+  const arma::Col<size_t>& BucketOffsets() const { return bucketOffsets; }
+
+  //! Get the points of all buckets, packed (empty unless CompactStorage() is
+  //! true).
+  const arma::Col<uint32_t>& BucketPoints() const { return bucketPoints; }
+
   //! Get the projection tables.
   const arma::cube& Projections() { return projections; }
 
@@ -298,29 +355,102 @@ class LSHSearch
   {
     // Simply call Train() with the given projection tables.
     Train(referenceSet, numProj, numTables, hashWidth, secondHashSize,
-        bucketSize, projTables);
+        bucketSize, projTables, compactStorage);
   }
 
  private:
+  //! Get the row of the second hash table that holds the bucket of the given
+  //! second-level hash code, or secondHashSize if that bucket is empty.
+  size_t BucketRow(const size_t hashCode) const
+  {
+    if (!compactStorage)
+      return bucketRowInHashTable[hashCode];
+
+    const uint32_t row = compactBucketRow[hashCode];
+    return (row == std::numeric_limits<uint32_t>::max()) ? secondHashSize :
+        (size_t) row;
+  }
+
+  //! Get the number of points in the given row of the second hash table.
+  size_t RowSize(const size_t row) const
+  {
+    return compactStorage ? bucketOffsets[row + 1] - bucketOffsets[row] :
+        bucketContentSize[row];
+  }
+
+  //! Get the number of rows of the second hash table.
+  size_t NumRows() const
+  {
+    if (compactStorage)
+      return (bucketOffsets.n_elem == 0) ? 0 : bucketOffsets.n_elem - 1;
+    return secondHashTable.size();
+  }
+
+  //! Get the j'th point in the given row of the second hash table.
+  size_t RowPoint(const size_t row, const size_t j) const
+  {
+    return compactStorage ? (size_t) bucketPoints[bucketOffsets[row] + j] :
+        secondHashTable[row](j);
+  }
+
+  /**
+   * Compute the second-level hash code of each of the given points in each of
+   * the hash tables, with the current projections, offsets and second hash
+   * weights.
+   *
+   * @param points Points to hash.
+   * @param secondHashVectors Matrix to store the codes in; the code of point j
+   *     in table i is stored at (i, j).
+   */
+  void SecondHashCodes(const MatType& points,
+                       arma::Mat<size_t>& secondHashVectors) const;
+
+  /**
+   * Put points with the given second-level hash codes into the second hash
+   * table, in whichever format is used.  Buckets that are empty get new rows,
+   * and points that do not fit in a full bucket are dropped.
+   *
+   * @param secondHashVectors Second-level hash codes of the points, as computed
+   *     by SecondHashCodes().
+   * @param firstIndex Index of the first of the points in the reference set.
+   */
+  void AddToSecondHashTable(const arma::Mat<size_t>& secondHashVectors,
+                            const size_t firstIndex);
+
   /**
-   * This function takes a query and hashes it into each of the hash tables to
-   * get keys for the query and then the key is hashed to a bucket of the second
-   * hash table and all the points (if any) in those buckets are collected as
-   * the potential neighbor candidates.
+   * Project the given points into the first numTablesToSearch hash tables at
+   * once, with one product against the projections of all these tables, and
+   * add the offsets.  Row (i * numProj + p) of the result holds
+   * <proj_p, point> + offset_p of table i; this is the code of the point before
+   * division by the hash width and flooring.
    *
-   * @param queryPoint The query point currently being processed.
+   * @param points Points to project.
+   * @param numTablesToSearch Number of tables to project the points into.
+   * @param codes Matrix to store the projections in, with one column for each
+   *     point.
+   */
+  template<typename PointsType>
+  void ProjectPoints(const PointsType& points,
+                     const size_t numTablesToSearch,
+                     arma::mat& codes) const;
+
+  /**
+   * This function takes the projections of a query into each of the hash
+   * tables to get keys for the query and then the key is hashed to a bucket of
+   * the second hash table and all the points (if any) in those buckets are
+   * collected as the potential neighbor candidates.
+   *
+   * @param queryCodesNotFloored The projections of the query in each of the
+   *    tables to search, as computed by ProjectPoints(), with one column for
+   *    each table.
    * @param referenceIndices The list of neighbor candidates obtained from
    *    hashing the query into all the hash tables and eventually into
    *    multiple buckets of the second hash table.
-   * @param numTablesToSearch The number of tables to perform the search in. If
-   *    0, all tables are searched.
    * @param T The number of additional probing bins for multiprobe LSH. If 0,
    *    single-probe is used.
    */
-  template<typename VecType>
-  void ReturnIndicesFromTable(const VecType& queryPoint,
+  void ReturnIndicesFromTable(const arma::mat& queryCodesNotFloored,
                               arma::uvec& referenceIndices,
-                              size_t numTablesToSearch,
                               const size_t T) const;
 
   /**
@@ -458,6 +588,26 @@ class LSHSearch
   //! corresponding to this value. Length secondHashSize.
   arma::Col<size_t> bucketRowInHashTable;
 
+  //! If true, the second hash table is stored in bucketOffsets, bucketPoints
+  //! and compactBucketRow instead of the three members above.
+  bool compactStorage;
+
+  //! The offset of each row of the compact second hash table in bucketPoints,
+  //! followed by the length of bucketPoints.
+  arma::Col<size_t> bucketOffsets;
+
+  //! The points of all rows of the compact second hash table.
+  arma::Col<uint32_t> bucketPoints;
+
+  //! The row of the compact second hash table for a particular hash value, or
+  //! the largest uint32_t if the bucket is empty.  Length secondHashSize.
+  arma::Col<uint32_t> compactBucketRow;
+
+  //! For each reference point, whether it has been removed with Remove().
+  std::vector<bool> removed;
+  //! The number of reference points that have been removed.
+  size_t numRemoved;
+
   //! The number of distance evaluations.
   size_t distanceEvaluations;
 
@@ -479,6 +629,9 @@ class LSHSearch
 
 } // namespace mlpack
 
+CEREAL_TEMPLATE_CLASS_VERSION((typename SortPolicy, typename MatType),
+    (mlpack::LSHSearch<SortPolicy, MatType>), (2));
+
 // Include implementation.
 #include "lsh_search_impl.hpp"
 
@@ -25,17 +25,20 @@ LSHSearch(MatType referenceSet,
           const size_t numTables,
           const double hashWidthIn,
           const size_t secondHashSize,
-          const size_t bucketSize) :
+          const size_t bucketSize,
+          const bool compactStorage) :
   numProj(numProj),
   numTables(numTables),
   hashWidth(hashWidthIn),
   secondHashSize(secondHashSize),
   bucketSize(bucketSize),
+  compactStorage(compactStorage),
+  numRemoved(0),
   distanceEvaluations(0)
 {
   // Pass work to training function.
   Train(std::move(referenceSet), numProj, numTables, hashWidthIn,
-      secondHashSize, bucketSize);
+      secondHashSize, bucketSize, arma::cube(), compactStorage);
 }
 
 // Construct the object with given tables
@@ -45,17 +48,20 @@ LSHSearch(MatType referenceSet,
           const arma::cube& projections,
           const double hashWidthIn,
           const size_t secondHashSize,
-          const size_t bucketSize) :
+          const size_t bucketSize,
+          const bool compactStorage) :
   numProj(projections.n_cols),
   numTables(projections.n_slices),
   hashWidth(hashWidthIn),
   secondHashSize(secondHashSize),
   bucketSize(bucketSize),
+  compactStorage(compactStorage),
+  numRemoved(0),
   distanceEvaluations(0)
 {
   // Pass work to training function.
   Train(std::move(referenceSet), numProj, numTables, hashWidthIn,
-      secondHashSize, bucketSize, projections);
+      secondHashSize, bucketSize, projections, compactStorage);
 }
 
 // Empty constructor.
@@ -66,6 +72,8 @@ LSHSearch<SortPolicy, MatType>::LSHSearch() :
     hashWidth(0),
     secondHashSize(99901),
     bucketSize(500),
+    compactStorage(false),
+    numRemoved(0),
     distanceEvaluations(0)
 {
 }
@@ -85,6 +93,12 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(const LSHSearch& other) :
     secondHashTable(other.secondHashTable),
     bucketContentSize(other.bucketContentSize),
     bucketRowInHashTable(other.bucketRowInHashTable),
+    compactStorage(other.compactStorage),
+    bucketOffsets(other.bucketOffsets),
+    bucketPoints(other.bucketPoints),
+    compactBucketRow(other.compactBucketRow),
+    removed(other.removed),
+    numRemoved(other.numRemoved),
     distanceEvaluations(other.distanceEvaluations)
 {
   // Nothing to do.
@@ -105,6 +119,12 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(LSHSearch&& other) :
     secondHashTable(std::move(other.secondHashTable)),
     bucketContentSize(std::move(other.bucketContentSize)),
     bucketRowInHashTable(std::move(other.bucketRowInHashTable)),
+    compactStorage(other.compactStorage),
+    bucketOffsets(std::move(other.bucketOffsets)),
+    bucketPoints(std::move(other.bucketPoints)),
+    compactBucketRow(std::move(other.compactBucketRow)),
+    removed(std::move(other.removed)),
+    numRemoved(other.numRemoved),
     distanceEvaluations(other.distanceEvaluations)
 {
   // Reset other model to defaults.
@@ -113,6 +133,8 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(LSHSearch&& other) :
   other.hashWidth = 0;
   other.secondHashSize = 99901;
   other.bucketSize = 500;
+  other.compactStorage = false;
+  other.numRemoved = 0;
   other.distanceEvaluations = 0;
 }
 
@@ -133,6 +155,12 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   secondHashTable = other.secondHashTable;
   bucketContentSize = other.bucketContentSize;
   bucketRowInHashTable = other.bucketRowInHashTable;
+  compactStorage = other.compactStorage;
+  bucketOffsets = other.bucketOffsets;
+  bucketPoints = other.bucketPoints;
+  compactBucketRow = other.compactBucketRow;
+  removed = other.removed;
+  numRemoved = other.numRemoved;
   distanceEvaluations = other.distanceEvaluations;
 
   return *this;
@@ -155,6 +183,12 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   secondHashTable = std::move(other.secondHashTable);
   bucketContentSize = std::move(other.bucketContentSize);
   bucketRowInHashTable = std::move(other.bucketRowInHashTable);
+  compactStorage = other.compactStorage;
+  bucketOffsets = std::move(other.bucketOffsets);
+  bucketPoints = std::move(other.bucketPoints);
+  compactBucketRow = std::move(other.compactBucketRow);
+  removed = std::move(other.removed);
+  numRemoved = other.numRemoved;
   distanceEvaluations = other.distanceEvaluations;
 
   // Reset other model to defaults.
@@ -163,6 +197,8 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   other.hashWidth = 0;
   other.secondHashSize = 99901;
   other.bucketSize = 500;
+  other.compactStorage = false;
+  other.numRemoved = 0;
   other.distanceEvaluations = 0;
 
   return *this;
@@ -176,8 +212,20 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
                                            const double hashWidthIn,
                                            const size_t secondHashSize,
                                            const size_t bucketSize,
-                                           const arma::cube& projection)
+                                           const arma::cube& projection,
+                                           const bool compactStorageIn)
 {
+  // The compact format stores points and rows as 32-bit integers, and uses the
+  // largest one to mark empty buckets.
+  if (compactStorageIn &&
+      (referenceSet.n_cols >= std::numeric_limits<uint32_t>::max() ||
+       secondHashSize >= std::numeric_limits<uint32_t>::max()))
+  {
+    throw std::invalid_argument("LSHSearch::Train(): compact storage requires "
+        "fewer than 2^32 - 1 reference points and a second hash size below "
+        "2^32 - 1");
+  }
+
   // Set new reference set.
   this->referenceSet = std::move(referenceSet);
 
@@ -187,6 +235,7 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
   this->hashWidth = hashWidthIn;
   this->secondHashSize = secondHashSize;
   this->bucketSize = bucketSize;
+  this->compactStorage = compactStorageIn;
 
   if (hashWidth == 0.0) // The user has not provided any value.
   {
@@ -218,12 +267,24 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
   secondHashWeights = arma::floor(arma::randu(numProj) *
                                   (double) secondHashSize);
 
-  // Instead of putting the points in the row corresponding to the bucket, we
-  // chose the next empty row and keep track of the row in which the bucket
-  // lies. This allows us to stack together and slice out the empty buckets at
-  // the end of the hashing.
-  bucketRowInHashTable.set_size(secondHashSize);
-  bucketRowInHashTable.fill(secondHashSize);
+  // Empty the second hash table.  Only one of its two formats is filled.
+  secondHashTable.clear();
+  bucketContentSize.reset();
+  bucketRowInHashTable.reset();
+  bucketOffsets.reset();
+  bucketPoints.reset();
+  compactBucketRow.reset();
+  if (compactStorage)
+  {
+    bucketOffsets.zeros(1);
+    compactBucketRow.set_size(secondHashSize);
+    compactBucketRow.fill(std::numeric_limits<uint32_t>::max());
+  }
+  else
+  {
+    bucketRowInHashTable.set_size(secondHashSize);
+    bucketRowInHashTable.fill(secondHashSize);
+  }
 
   // Step II: The offsets for all projections in all tables.
   // Since the 'offsets' are in [0, hashWidth], we obtain the 'offsets'
@@ -252,100 +313,258 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
         "tables provided must be equal to numProj");
   }
 
-  // We will store the second hash vectors in this matrix; the second hash
-  // vector for table i will be held in row i.  We have to use int and not
-  // size_t, otherwise negative numbers are cast to 0.
-  arma::Mat<size_t> secondHashVectors(numTables, this->referenceSet.n_cols);
+  // Step IV: compute the second-level hash code of each point in each table,
+  // and put the points into the second hash table.
+  arma::Mat<size_t> secondHashVectors;
+  SecondHashCodes(this->referenceSet, secondHashVectors);
+  AddToSecondHashTable(secondHashVectors, 0);
+
+  // No point has been removed yet.
+  removed.assign(this->referenceSet.n_cols, false);
+  numRemoved = 0;
+
+  size_t maxRowSize = 0;
+  for (size_t i = 0; i < NumRows(); ++i)
+    maxRowSize = std::max(maxRowSize, RowSize(i));
+
+  Log::Info << "Final hash table size: " << NumRows() << " rows, with a "
+      << "maximum length of " << maxRowSize << ", totaling "
+      << (compactStorage ? bucketPoints.n_elem : accu(bucketContentSize))
+      << " elements" << (compactStorage ? " (compact storage)." : ".")
+      << std::endl;
+}
 
-  for (size_t i = 0; i < numTables; ++i)
+// Add new points to the model.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::Insert(const MatType& newPoints)
+{
+  if (projections.n_slices == 0)
+  {
+    throw std::invalid_argument("LSHSearch::Insert(): the model must be "
+        "trained before points can be inserted");
+  }
+
+  util::CheckSameDimensionality(newPoints, referenceSet, "LSHSearch::Insert()",
+      "new points");
+
+  if (compactStorage && referenceSet.n_cols + newPoints.n_cols >=
+      std::numeric_limits<uint32_t>::max())
+  {
+    throw std::invalid_argument("LSHSearch::Insert(): compact storage requires "
+        "fewer than 2^32 - 1 reference points");
+  }
+
+  // Hash the new points with the existing projections, offsets and second hash
+  // weights, so that the points already in the tables keep their buckets.
+  arma::Mat<size_t> secondHashVectors;
+  SecondHashCodes(newPoints, secondHashVectors);
+
+  const size_t firstIndex = referenceSet.n_cols;
+  referenceSet = arma::join_rows(referenceSet, newPoints);
+  AddToSecondHashTable(secondHashVectors, firstIndex);
+  removed.resize(referenceSet.n_cols, false);
+}
+
+// Mark points as removed.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::Remove(const arma::uvec& ids)
+{
+  for (size_t i = 0; i < ids.n_elem; ++i)
   {
-    // Step IV: create the 'numProj'-dimensional key for each point in each
-    // table.
+    if (ids[i] >= referenceSet.n_cols)
+    {
+      std::ostringstream oss;
+      oss << "LSHSearch::Remove(): point " << ids[i] << " is out of bounds; "
+          << "the reference set has " << referenceSet.n_cols << " points!";
+      throw std::invalid_argument(oss.str());
+    }
+  }
+
+  for (size_t i = 0; i < ids.n_elem; ++i)
+  {
+    if (!removed[ids[i]])
+    {
+      removed[ids[i]] = true;
+      ++numRemoved;
+    }
+  }
+}
+
+// Project points into the first numTablesToSearch tables at once.
+template<typename SortPolicy, typename MatType>
+template<typename PointsType>
+void LSHSearch<SortPolicy, MatType>::ProjectPoints(
+    const PointsType& points,
+    const size_t numTablesToSearch,
+    arma::mat& codes) const
+{
+  // The projection matrices of consecutive tables are contiguous in the cube,
+  // so together they form one (dims x (numProj * numTables)) matrix, and a
+  // single product projects the points into all the tables.  The offsets
+  // stored column by column are in the same order as the rows of the result.
+  arma::mat allProjections;
+  MakeAlias(allProjections, projections, projections.n_rows,
+      numProj * numTablesToSearch);
+  arma::vec allOffsets;
+  MakeAlias(allOffsets, offsets, numProj * numTablesToSearch);
+
+  codes = allProjections.t() * points;
+  codes.each_col() += allOffsets;
+}
+
+// Compute the second-level hash codes of the given points.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::SecondHashCodes(
+    const MatType& points,
+    arma::Mat<size_t>& secondHashVectors) const
+{
+  // We will store the second hash vectors in this matrix; the second hash
+  // vector for table i will be held in row i.
+  secondHashVectors.set_size(numTables, points.n_cols);
+
+  // The points are projected into all the tables in blocks, which bounds the
+  // memory used for the codes.
+  const size_t blockSize = 4096;
+  const double shs = (double) secondHashSize; // Convenience cast.
+  arma::mat hashMat;
+  for (size_t start = 0; start < points.n_cols; start += blockSize)
+  {
+    const size_t end = std::min(start + blockSize, (size_t) points.n_cols);
 
     // The following code performs the task of hashing each point to a
-    // 'numProj'-dimensional integer key.  Hence you get a ('numProj' x
-    // 'referenceSet.n_cols') key matrix.
+    // 'numProj'-dimensional integer key in each table.
     //
     // For a single table, let the 'numProj' projections be denoted by 'proj_i'
     // and the corresponding offset be 'offset_i'.  Then the key of a single
     // point is obtained as:
     // key = { floor((<proj_i, point> + offset_i) / 'hashWidth') forall i }
-    arma::mat offsetMat = repmat(offsets.unsafe_col(i), 1,
-                                 this->referenceSet.n_cols);
-    arma::mat hashMat = projections.slice(i).t() * (this->referenceSet);
-    hashMat += offsetMat;
-    hashMat /= hashWidth;
-
-    // Step V: Putting the points in the 'secondHashTable' by hashing the key.
-    // Now we hash every key, point ID to its corresponding bucket.  We must
-    // also normalize the hashes to the range [0, secondHashSize).
-    arma::rowvec unmodVector = secondHashWeights.t() * arma::floor(hashMat);
-    for (size_t j = 0; j < unmodVector.n_elem; ++j)
+    ProjectPoints(points.cols(start, end - 1), numTables, hashMat);
+    hashMat = arma::floor(hashMat / hashWidth);
+
+    for (size_t i = 0; i < numTables; ++i)
     {
-      double shs = (double) secondHashSize; // Convenience cast.
-      if (unmodVector[j] >= 0.0)
+      // Now we hash every key to its corresponding bucket.  We must also
+      // normalize the hashes to the range [0, secondHashSize).  The negative
+      // values are handled separately, otherwise they would be cast to 0.
+      const arma::rowvec unmodVector = secondHashWeights.t() *
+          hashMat.rows(i * numProj, (i + 1) * numProj - 1);
+      for (size_t j = 0; j < unmodVector.n_elem; ++j)
       {
-        const size_t key = size_t(fmod(unmodVector[j], shs));
-        secondHashVectors(i, j) = key;
+        if (unmodVector[j] >= 0.0)
+        {
+          const size_t key = size_t(fmod(unmodVector[j], shs));
+          secondHashVectors(i, start + j) = key;
+        }
+        else
+        {
+          const double mod = fmod(-unmodVector[j], shs);
+          const size_t key = (mod < 1.0) ? 0 : secondHashSize - size_t(mod);
+          secondHashVectors(i, start + j) = key;
+        }
       }
-      else
+    }
+  }
+}
+
+// Put points into the second hash table.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::AddToSecondHashTable(
+    const arma::Mat<size_t>& secondHashVectors,
+    const size_t firstIndex)
+{
+  // Instead of putting the points in the row corresponding to the bucket, we
+  // chose the next empty row and keep track of the row in which the bucket
+  // lies.  Rows are numbered in the order in which their buckets are first
+  // seen, and points are added in order of table and then index, so whether
+  // the points are added all at once or in batches only changes which points
+  // do not fit in a full bucket.
+  const size_t oldNumRows = NumRows();
+  size_t numRows = oldNumRows;
+  for (size_t i = 0; i < numTables; ++i)
+  {
+    for (size_t j = 0; j < secondHashVectors.n_cols; ++j)
+    {
+      // If this is currently an empty bucket, start a new row and keep track
+      // of which row corresponds to the bucket.
+      const size_t hashInd = secondHashVectors(i, j);
+      if (BucketRow(hashInd) == secondHashSize)
       {
-        const double mod = fmod(-unmodVector[j], shs);
-        const size_t key = (mod < 1.0) ? 0 : secondHashSize - size_t(mod);
-        secondHashVectors(i, j) = key;
+        if (compactStorage)
+          compactBucketRow[hashInd] = (uint32_t) numRows;
+        else
+          bucketRowInHashTable[hashInd] = numRows;
+        numRows++;
       }
     }
   }
 
-  // Now, using the hash vectors for each table, count the number of rows we
-  // have in the second hash table.
-  arma::Row<size_t> secondHashBinCounts(secondHashSize);
+  // Compute the new size of each row, enforcing the maximum bucket size.
+  const size_t effectiveBucketSize = (bucketSize == 0) ? SIZE_MAX : bucketSize;
+  arma::Col<size_t> oldRowSizes(numRows, arma::fill::zeros);
+  for (size_t r = 0; r < oldNumRows; ++r)
+    oldRowSizes[r] = RowSize(r);
+  arma::Col<size_t> rowSizes(oldRowSizes);
   for (size_t i = 0; i < secondHashVectors.n_elem; ++i)
-    secondHashBinCounts[secondHashVectors[i]]++;
+  {
+    const size_t row = BucketRow(secondHashVectors[i]);
+    if (rowSizes[row] < effectiveBucketSize)
+      rowSizes[row]++;
+  }
 
-  // Enforce the maximum bucket size.
-  const size_t effectiveBucketSize = (bucketSize == 0) ? SIZE_MAX : bucketSize;
-  secondHashBinCounts.transform([effectiveBucketSize](size_t val)
-      { return std::min(val, effectiveBucketSize); });
+  if (compactStorage)
+  {
+    // The offsets of the rows follow from their sizes; the old points of each
+    // row are copied to the new packed vector before the new points.
+    arma::Col<size_t> newOffsets(numRows + 1);
+    newOffsets[0] = 0;
+    for (size_t r = 0; r < numRows; ++r)
+      newOffsets[r + 1] = newOffsets[r] + rowSizes[r];
+
+    arma::Col<uint32_t> newPoints(newOffsets[numRows]);
+    for (size_t r = 0; r < oldNumRows; ++r)
+    {
+      std::copy(bucketPoints.begin() + bucketOffsets[r],
+          bucketPoints.begin() + bucketOffsets[r + 1],
+          newPoints.begin() + newOffsets[r]);
+    }
 
-  const size_t numRowsInTable = accu(secondHashBinCounts > 0);
-  bucketContentSize.zeros(numRowsInTable);
-  secondHashTable.resize(numRowsInTable);
+    arma::Col<size_t> rowFill(newOffsets.head(numRows) + oldRowSizes);
+    for (size_t i = 0; i < numTables; ++i)
+    {
+      for (size_t j = 0; j < secondHashVectors.n_cols; ++j)
+      {
+        const size_t row = compactBucketRow[secondHashVectors(i, j)];
+        if (rowFill[row] < newOffsets[row + 1])
+          newPoints[rowFill[row]++] = (uint32_t) (firstIndex + j);
+      }
+    }
+
+    bucketOffsets = std::move(newOffsets);
+    bucketPoints = std::move(newPoints);
+    return;
+  }
+
+  // Resize each row that grows only once.
+  secondHashTable.resize(numRows);
+  bucketContentSize.resize(numRows);
+  for (size_t r = oldNumRows; r < numRows; ++r)
+    bucketContentSize[r] = 0;
+  for (size_t r = 0; r < numRows; ++r)
+    if (rowSizes[r] != oldRowSizes[r])
+      secondHashTable[r].resize(rowSizes[r]);
 
   // Next we must assign each point in each table to the right second hash
   // table.
-  size_t currentRow = 0;
   for (size_t i = 0; i < numTables; ++i)
   {
-    // Insert the point in the corresponding row to its bucket in the
-    // 'secondHashTable'.
     for (size_t j = 0; j < secondHashVectors.n_cols; ++j)
     {
-      // This is the bucket number.
-      size_t hashInd = (size_t) secondHashVectors(i, j);
-      // The point ID is 'j'.
-
-      // If this is currently an empty bucket, start a new row keep track of
-      // which row corresponds to the bucket.
-      const size_t maxSize = secondHashBinCounts[hashInd];
-      if (bucketRowInHashTable[hashInd] == secondHashSize)
-      {
-        bucketRowInHashTable[hashInd] = currentRow;
-        secondHashTable[currentRow].set_size(maxSize);
-        currentRow++;
-      }
-
       // If this vector in the hash table is not full, add the point.
-      const size_t index = bucketRowInHashTable[hashInd];
-      if (bucketContentSize[index] < maxSize)
-        secondHashTable[index](bucketContentSize[index]++) = j;
-    } // Loop over all points in the reference set.
-  } // Loop over tables.
-
-  Log::Info << "Final hash table size: " << numRowsInTable << " rows, with a "
-            << "maximum length of " << max(secondHashBinCounts) << ", "
-            << "totaling " << accu(secondHashBinCounts) << " elements."
-            << std::endl;
+      const size_t row = bucketRowInHashTable[secondHashVectors(i, j)];
+      if (bucketContentSize[row] < rowSizes[row])
+        secondHashTable[row](bucketContentSize[row]++) = firstIndex + j;
+    }
+  }
 }
 
 // Base case where the query set is the reference set.  (So, we can't return
@@ -702,35 +921,18 @@ void LSHSearch<SortPolicy, MatType>::GetAdditionalProbingBins(
 }
 
 template<typename SortPolicy, typename MatType>
-template<typename VecType>
 void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
-    const VecType& queryPoint,
+    const arma::mat& queryCodesNotFloored,
     arma::uvec& referenceIndices,
-    size_t numTablesToSearch,
     const size_t T) const
 {
-  // Decide on the number of tables to look into.
-  if (numTablesToSearch == 0) // If no user input is given, search all.
-    numTablesToSearch = numTables;
-
-  // Sanity check to make sure that the existing number of tables is not
-  // exceeded.
-  if (numTablesToSearch > numTables)
-    numTablesToSearch = numTables;
-
-  // Hash the query in each of the 'numTablesToSearch' hash tables using the
-  // 'numProj' projections for each table. This gives us 'numTablesToSearch'
-  // keys for the query where each key is a 'numProj' dimensional integer
-  // vector.
-
-  // Compute the projection of the query in each table.
-  arma::mat allProjInTables(numProj, numTablesToSearch);
-  arma::mat queryCodesNotFloored(numProj, numTablesToSearch);
-  for (size_t i = 0; i < numTablesToSearch; ++i)
-    queryCodesNotFloored.unsafe_col(i) = projections.slice(i).t() * queryPoint;
-
-  queryCodesNotFloored += offsets.cols(0, numTablesToSearch - 1);
-  allProjInTables = arma::floor(queryCodesNotFloored / hashWidth);
+  // The query was hashed in each of the 'numTablesToSearch' hash tables using
+  // the 'numProj' projections for each table by ProjectPoints(). This gives us
+  // 'numTablesToSearch' keys for the query where each key is a 'numProj'
+  // dimensional integer vector.
+  const size_t numTablesToSearch = queryCodesNotFloored.n_cols;
+  const arma::mat allProjInTables = arma::floor(queryCodesNotFloored /
+      hashWidth);
 
   // Use hashMat to store the primary probing codes and any additional codes
   // from multiprobe LSH.
@@ -774,9 +976,9 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
     for (size_t p = 0; p < T + 1; ++p)
     {
       const size_t hashInd = hashMat(p, i); // find query's bucket
-      const size_t tableRow = bucketRowInHashTable[hashInd];
+      const size_t tableRow = BucketRow(hashInd);
       if (tableRow < secondHashSize)
-        maxNumPoints += bucketContentSize[tableRow]; // count bucket contents
+        maxNumPoints += RowSize(tableRow); // count bucket contents
     }
   }
 
@@ -805,17 +1007,26 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
       {
         // get the sequence code
         size_t hashInd = hashMat(p, i);
-        size_t tableRow = bucketRowInHashTable[hashInd];
+        size_t tableRow = BucketRow(hashInd);
 
-        if (tableRow < secondHashSize && bucketContentSize[tableRow] > 0)
+        if (tableRow < secondHashSize)
         {
           // Pick the indices in the bucket corresponding to hashInd.
-          for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
-            refPointsConsidered[ secondHashTable[tableRow](j) ]++;
+          const size_t rowSize = RowSize(tableRow);
+          for (size_t j = 0; j < rowSize; ++j)
+            refPointsConsidered[RowPoint(tableRow, j)]++;
         }
       }
     }
 
+    // Removed points are never candidates.
+    if (numRemoved > 0)
+    {
+      for (size_t j = 0; j < refPointsConsidered.n_elem; ++j)
+        if (removed[j])
+          refPointsConsidered[j] = 0;
+    }
+
     // Only keep reference points found in at least one bucket.
     referenceIndices = arma::find(refPointsConsidered > 0);
     return;
@@ -836,19 +1047,25 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
       for (size_t p = 0; p < T + 1; ++p)
       {
         const size_t hashInd =  hashMat(p, i); // Find the query's bucket.
-        const size_t tableRow = bucketRowInHashTable[hashInd];
+        const size_t tableRow = BucketRow(hashInd);
 
         if (tableRow < secondHashSize)
         {
           // Store all secondHashTable points in the candidates set.
-          for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
-            refPointsConsideredSmall(start++) = secondHashTable[tableRow](j);
+          // Removed points are never candidates.
+          const size_t rowSize = RowSize(tableRow);
+          for (size_t j = 0; j < rowSize; ++j)
+          {
+            const size_t point = RowPoint(tableRow, j);
+            if (numRemoved == 0 || !removed[point])
+              refPointsConsideredSmall(start++) = point;
+          }
        }
       }
     }
 
     // Keep only one copy of each candidate.
-    referenceIndices = arma::unique(refPointsConsideredSmall);
+    referenceIndices = arma::unique(refPointsConsideredSmall.head(start));
     return;
   }
 }
@@ -867,12 +1084,12 @@ void LSHSearch<SortPolicy, MatType>::Search(
   util::CheckSameDimensionality(querySet, referenceSet, "LSHSearch::Search()",
       "query set");
 
-  if (k > referenceSet.n_cols)
+  if (k > referenceSet.n_cols - numRemoved)
   {
     std::ostringstream oss;
     oss << "LSHSearch::Search(): requested " << k << " approximate nearest "
-        << "neighbors, but reference set has " << referenceSet.n_cols
-        << " points!" << std::endl;
+        << "neighbors, but reference set has " << referenceSet.n_cols -
+        numRemoved << " points that are not removed!" << std::endl;
     throw std::invalid_argument(oss.str());
   }
 
@@ -900,31 +1117,49 @@ void LSHSearch<SortPolicy, MatType>::Search(
     Log::Info << "Running multiprobe LSH with " << Teffective
         <<" additional probing bins per table per query." << std::endl;
 
+  // Decide on the number of tables to look into; if no user input is given,
+  // search all, and never exceed the existing number of tables.
+  const size_t tablesToSearch = (numTablesToSearch == 0 ||
+      numTablesToSearch > numTables) ? numTables : numTablesToSearch;
+
   size_t avgIndicesReturned = 0;
 
-  // Parallelization to process more than one query at a time.
-  #pragma omp parallel for \
-      shared(resultingNeighbors, distances) \
-      schedule(dynamic)\
-      reduction(+:avgIndicesReturned)
-  for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
+  // The queries are projected into all the tables in blocks, with one product
+  // for each block, and then the queries of the block are processed in
+  // parallel.
+  const size_t blockSize = 4096;
+  arma::mat queryCodes;
+  for (size_t start = 0; start < (size_t) querySet.n_cols; start += blockSize)
   {
-    // Go through every query point.
-    // Hash every query into every hash table and eventually into the
-    // 'secondHashTable' to obtain the neighbor candidates.
-    arma::uvec refIndices;
-    ReturnIndicesFromTable(querySet.col(i), refIndices, numTablesToSearch,
-        Teffective);
-
-    // An informative book-keeping for the number of neighbor candidates
-    // returned on average.
-    // Make atomic to avoid race conditions when multiple threads are running
-    // #pragma omp atomic
-    avgIndicesReturned = avgIndicesReturned + refIndices.n_elem;
-
-    // Sequentially go through all the candidates and save the best 'k'
-    // candidates.
-    BaseCase(i, refIndices, k, querySet, resultingNeighbors, distances);
+    const size_t end = std::min(start + blockSize, (size_t) querySet.n_cols);
+    ProjectPoints(querySet.cols(start, end - 1), tablesToSearch, queryCodes);
+
+    // Parallelization to process more than one query at a time.
+    #pragma omp parallel for \
+        shared(resultingNeighbors, distances, queryCodes) \
+        schedule(dynamic)\
+        reduction(+:avgIndicesReturned)
+    for (size_t i = start; i < end; ++i)
+    {
+      // Go through every query point.
+      // Hash every query into every hash table and eventually into the
+      // 'secondHashTable' to obtain the neighbor candidates.
+      arma::mat queryCodesNotFloored;
+      MakeAlias(queryCodesNotFloored, queryCodes, numProj, tablesToSearch,
+          (i - start) * queryCodes.n_rows);
+      arma::uvec refIndices;
+      ReturnIndicesFromTable(queryCodesNotFloored, refIndices, Teffective);
+
+      // An informative book-keeping for the number of neighbor candidates
+      // returned on average.
+      // Make atomic to avoid race conditions when multiple threads are running
+      // #pragma omp atomic
+      avgIndicesReturned += refIndices.n_elem;
+
+      // Sequentially go through all the candidates and save the best 'k'
+      // candidates.
+      BaseCase(i, refIndices, k, querySet, resultingNeighbors, distances);
+    }
   }
 
   distanceEvaluations += avgIndicesReturned;
@@ -962,31 +1197,52 @@ Search(const size_t k,
     Log::Info << "Running multiprobe LSH with " << Teffective <<
       " additional probing bins per table per query."<< std::endl;
 
+  // Decide on the number of tables to look into; if no user input is given,
+  // search all, and never exceed the existing number of tables.
+  const size_t tablesToSearch = (numTablesToSearch == 0 ||
+      numTablesToSearch > numTables) ? numTables : numTablesToSearch;
+
   size_t avgIndicesReturned = 0;
 
-  // Parallelization to process more than one query at a time.
-  #pragma omp parallel for \
-      shared(resultingNeighbors, distances) \
-      schedule(dynamic)\
-      reduction(+:avgIndicesReturned)
-  for (size_t i = 0; i < (size_t) referenceSet.n_cols; ++i)
+  // The queries are projected into all the tables in blocks, with one product
+  // for each block, and then the queries of the block are processed in
+  // parallel.
+  const size_t blockSize = 4096;
+  arma::mat queryCodes;
+  for (size_t start = 0; start < (size_t) referenceSet.n_cols;
+       start += blockSize)
   {
-    // Go through every query point.
-    // Hash every query into every hash table and eventually into the
-    // 'secondHashTable' to obtain the neighbor candidates.
-    arma::uvec refIndices;
-    ReturnIndicesFromTable(referenceSet.col(i), refIndices, numTablesToSearch,
-        Teffective);
-
-    // An informative book-keeping for the number of neighbor candidates
-    // returned on average.
-    // Make atomic to avoid race conditions when multiple threads are running.
-    // #pragma omp atomic
-    avgIndicesReturned += refIndices.n_elem;
-
-    // Sequentially go through all the candidates and save the best 'k'
-    // candidates.
-    BaseCase(i, refIndices, k, resultingNeighbors, distances);
+    const size_t end = std::min(start + blockSize,
+        (size_t) referenceSet.n_cols);
+    ProjectPoints(referenceSet.cols(start, end - 1), tablesToSearch,
+        queryCodes);
+
+    // Parallelization to process more than one query at a time.
+    #pragma omp parallel for \
+        shared(resultingNeighbors, distances, queryCodes) \
+        schedule(dynamic)\
+        reduction(+:avgIndicesReturned)
+    for (size_t i = start; i < end; ++i)
+    {
+      // Go through every query point.
+      // Hash every query into every hash table and eventually into the
+      // 'secondHashTable' to obtain the neighbor candidates.
+      arma::mat queryCodesNotFloored;
+      MakeAlias(queryCodesNotFloored, queryCodes, numProj, tablesToSearch,
+          (i - start) * queryCodes.n_rows);
+      arma::uvec refIndices;
+      ReturnIndicesFromTable(queryCodesNotFloored, refIndices, Teffective);
+
+      // An informative book-keeping for the number of neighbor candidates
+      // returned on average.
+      // Make atomic to avoid race conditions when multiple threads are running.
+      // #pragma omp atomic
+      avgIndicesReturned += refIndices.n_elem;
+
+      // Sequentially go through all the candidates and save the best 'k'
+      // candidates.
+      BaseCase(i, refIndices, k, resultingNeighbors, distances);
+    }
   }
 
   distanceEvaluations += avgIndicesReturned;
@@ -1025,7 +1281,7 @@ double LSHSearch<SortPolicy, MatType>::ComputeRecall(
 template<typename SortPolicy, typename MatType>
 template<typename Archive>
 void LSHSearch<SortPolicy, MatType>::serialize(Archive& ar,
-                                               const uint32_t /* version */)
+                                               const uint32_t version)
 {
   ar(CEREAL_NVP(referenceSet));
   ar(CEREAL_NVP(numProj));
@@ -1044,6 +1300,35 @@ void LSHSearch<SortPolicy, MatType>::serialize(Archive& ar,
   ar(CEREAL_NVP(secondHashTable));
   ar(CEREAL_NVP(bucketContentSize));
   ar(CEREAL_NVP(bucketRowInHashTable));
+
+  // Models from before version 1 only have the regular format.
+  if (cereal::is_loading<Archive>() && version == 0)
+  {
+    compactStorage = false;
+    bucketOffsets.reset();
+    bucketPoints.reset();
+    compactBucketRow.reset();
+  }
+  else
+  {
+    ar(CEREAL_NVP(compactStorage));
+    ar(CEREAL_NVP(bucketOffsets));
+    ar(CEREAL_NVP(bucketPoints));
+    ar(CEREAL_NVP(compactBucketRow));
+  }
+
+  // Models from before version 2 have no removed points.
+  if (cereal::is_loading<Archive>() && version < 2)
+  {
+    removed.assign(referenceSet.n_cols, false);
+    numRemoved = 0;
+  }
+  else
+  {
+    ar(CEREAL_NVP(removed));
+    ar(CEREAL_NVP(numRemoved));
+  }
+
   ar(CEREAL_NVP(distanceEvaluations));
 }
 
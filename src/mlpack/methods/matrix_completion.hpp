@@ -13,5 +13,6 @@
 #define MLPACK_MATRIX_COMPLETION_HPP
 
 #include "matrix_completion/matrix_completion.hpp"
+#include "matrix_completion/als_matrix_completion.hpp"
 
 #endif
@@ -0,0 +1,195 @@
+/**
+ * @file methods/matrix_completion/als_matrix_completion.hpp
+ *
+ * A low-rank matrix completion solver with alternating least squares, for
+ * matrices that are too large for the SDP formulation of MatrixCompletion.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_MATRIX_COMPLETION_ALS_MATRIX_COMPLETION_HPP
+#define MLPACK_METHODS_MATRIX_COMPLETION_ALS_MATRIX_COMPLETION_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+
+/**
+ * This class completes a matrix from some of its entries with a rank-r
+ * factorization X = W^T H, where W is r x m and H is r x n, found by
+ * alternating least squares on the known entries with weighted-lambda
+ * regularization (ALS-WR):
+ *
+ *   min sum_{(i, j) known} (M_ij - w_i^T h_j)^2 +
+ *       lambda (sum_i n_i ||w_i||^2 + sum_j n_j ||h_j||^2)
+ *
+ * where n_i and n_j are the numbers of known entries of row i and column j.
+ * With H fixed, each column w_i is the solution of an r x r linear system built
+ * from the known entries of row i only, so the rows are solved in parallel, and
+ * then the columns are solved in the same way with W fixed.  Unlike the SDP of
+ * MatrixCompletion, whose size grows with (m + n)^2, this needs
+ * O((m + n) r + p) memory for p known entries, and each iteration costs
+ * O(p r^2 + (m + n) r^3) time.
+ *
+ * For more details, see the following paper:
+ *
+ * @code
+ * @inproceedings{zhou2008large,
+ *   title = {Large-Scale Parallel Collaborative Filtering for the Netflix
+ *       Prize},
+ *   author = {Zhou, Yunhong and Wilkinson, Dennis and Schreiber, Robert and
+ *       Pan, Rong},
+ *   booktitle = {Algorithmic Aspects in Information and Management},
+ *   pages = {337--348},
+ *   year = {2008}
+ * }
+ * @endcode
+ *
+ * An example of how to use this class is shown below:
+ *
+ * @code
+ * size_t m, n;         // size of unknown matrix
+ * arma::umat indices;  // contains the known indices [2 x n_entries]
+ * arma::vec values;    // contains the known values [n_entries]
+ *
+ * ALSMatrixCompletion mc(m, n, indices, values, 10);
+ * mc.Recover();
+ *
+ * // The entries can be predicted without forming the whole matrix.
+ * const double x = mc.Predict(3, 5);
+ * @endcode
+ *
+ * @see MatrixCompletion
+ */
+class ALSMatrixCompletion
+{
+ public:
+  /**
+   * Construct a matrix completion problem.  The known entries are stored once
+   * by row and once by column.
+   *
+   * @param m Number of rows of original matrix.
+   * @param n Number of columns of original matrix.
+   * @param indices Matrix containing the indices of the known entries (must be
+   *    [2 x p]).
+   * @param values Vector containing the values of the known entries (must be
+   *    length p).
+   * @param rank Rank of the factorization.
+   * @param lambda Regularization parameter (must be positive).
+   * @param maxIterations Maximum number of iterations (one iteration solves
+   *    all the rows and all the columns).
+   * @param tolerance The iterations stop once the relative change in the
+   *    root mean squared error on the known entries is below this tolerance.
+   */
+  ALSMatrixCompletion(const size_t m,
+                      const size_t n,
+                      const arma::umat& indices,
+                      const arma::vec& values,
+                      const size_t rank,
+                      const double lambda = 1e-6,
+                      const size_t maxIterations = 100,
+                      const double tolerance = 1e-10);
+
+  /**
+   * Compute the factorization, starting from a random one.
+   *
+   * @return The root mean squared error on the known entries.
+   */
+  double Recover();
+
+  /**
+   * Compute the factorization and store the whole completed matrix (m x n) in
+   * the given matrix.  For large matrices, use Recover() and Predict()
+   * instead.
+   *
+   * @param recovered Will contain the completed matrix.
+   * @return The root mean squared error on the known entries.
+   */
+  double Recover(arma::mat& recovered);
+
+  //! Predict the entry (i, j) of the completed matrix.
+  double Predict(const size_t i, const size_t j) const
+  { return arma::dot(w.col(i), h.col(j)); }
+
+  /**
+   * Predict the given entries of the completed matrix.
+   *
+   * @param entries Indices of the entries (must be [2 x k]).
+   * @param predictions Will contain the predicted entries.
+   */
+  void Predict(const arma::umat& entries, arma::vec& predictions) const;
+
+  //! Get the row factors W (r x m).
+  const arma::mat& W() const { return w; }
+  //! Get the column factors H (r x n).
+  const arma::mat& H() const { return h; }
+  //! Get the number of iterations of the last call to Recover().
+  size_t Iterations() const { return iterations; }
+
+ private:
+  /**
+   * The known entries grouped by row or by column, in compressed form: the
+   * entries of group g are at positions offsets[g] to offsets[g + 1] - 1 of
+   * others (the index in the other dimension) and values.  Unlike a sparse
+   * matrix, this keeps the known entries that are zero.
+   */
+  struct KnownEntries
+  {
+    arma::uvec offsets;
+    arma::uvec others;
+    arma::vec values;
+  };
+
+  //! Group the known entries by the given row of the indices (0 for rows, 1
+  //! for columns).
+  static void Group(const arma::umat& indices,
+                    const arma::vec& values,
+                    const size_t dimension,
+                    const size_t numGroups,
+                    KnownEntries& entries);
+
+  /**
+   * Solve the factor of each group of known entries, with the other factors
+   * fixed.
+   */
+  void SolveFactors(const KnownEntries& entries,
+                    const arma::mat& fixedFactors,
+                    arma::mat& factors) const;
+
+  //! Compute the root mean squared error on the known entries.
+  double TrainingError() const;
+
+  //! Number of rows in original matrix.
+  size_t m;
+  //! Number of columns in original matrix.
+  size_t n;
+  //! The rank of the factorization.
+  size_t rank;
+  //! The regularization parameter.
+  double lambda;
+  //! The maximum number of iterations.
+  size_t maxIterations;
+  //! The tolerance on the relative change of the error.
+  double tolerance;
+  //! The number of iterations of the last call to Recover().
+  size_t iterations;
+
+  //! The known entries of each column.
+  KnownEntries byColumn;
+  //! The known entries of each row.
+  KnownEntries byRow;
+
+  //! The row factors (r x m).
+  arma::mat w;
+  //! The column factors (r x n).
+  arma::mat h;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "als_matrix_completion_impl.hpp"
+
+#endif
@@ -0,0 +1,216 @@
+/**
+ * @file methods/matrix_completion/als_matrix_completion_impl.hpp
+ *
+ * Implementation of ALSMatrixCompletion.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_MATRIX_COMPLETION_ALS_MATRIX_COMPLETION_IMPL_HPP
+#define MLPACK_METHODS_MATRIX_COMPLETION_ALS_MATRIX_COMPLETION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "als_matrix_completion.hpp"
+#include <mlpack/core/util/size_checks.hpp>
+
+namespace mlpack {
+
+inline ALSMatrixCompletion::ALSMatrixCompletion(
+    const size_t m,
+    const size_t n,
+    const arma::umat& indices,
+    const arma::vec& values,
+    const size_t rank,
+    const double lambda,
+    const size_t maxIterations,
+    const double tolerance) :
+    m(m),
+    n(n),
+    rank(rank),
+    lambda(lambda),
+    maxIterations(maxIterations),
+    tolerance(tolerance),
+    iterations(0)
+{
+  if (indices.n_rows != 2)
+  {
+    throw std::invalid_argument("ALSMatrixCompletion: matrix of indices does "
+        "not have 2 rows!");
+  }
+
+  util::CheckSameSizes(indices, values, "ALSMatrixCompletion",
+      "values", false, true);
+
+  if (rank == 0)
+    throw std::invalid_argument("ALSMatrixCompletion: rank must be positive!");
+  if (lambda <= 0.0)
+  {
+    throw std::invalid_argument("ALSMatrixCompletion: lambda must be "
+        "positive!");
+  }
+
+  for (size_t i = 0; i < indices.n_cols; ++i)
+  {
+    if (indices(0, i) >= m || indices(1, i) >= n)
+    {
+      std::ostringstream oss;
+      oss << "ALSMatrixCompletion: indices (" << indices(0, i) << ", "
+          << indices(1, i) << ") are out of bounds for matrix of size " << m
+          << " x " << n << "!";
+      throw std::invalid_argument(oss.str());
+    }
+  }
+
+  Group(indices, values, 0, m, byRow);
+  Group(indices, values, 1, n, byColumn);
+
+  // Repeated entries would be given more weight than the others, so they are
+  // not allowed.
+  for (size_t i = 0; i < m; ++i)
+  {
+    for (size_t k = byRow.offsets[i] + 1; k < byRow.offsets[i + 1]; ++k)
+    {
+      if (byRow.others[k] == byRow.others[k - 1])
+      {
+        std::ostringstream oss;
+        oss << "ALSMatrixCompletion: the known entry (" << i << ", "
+            << byRow.others[k] << ") is repeated!";
+        throw std::invalid_argument(oss.str());
+      }
+    }
+  }
+}
+
+inline double ALSMatrixCompletion::Recover()
+{
+  // Only the column factors need a starting point, since the row factors are
+  // solved first.
+  w.zeros(rank, m);
+  h = arma::randu<arma::mat>(rank, n);
+
+  double error = DBL_MAX;
+  for (iterations = 1; iterations <= maxIterations; ++iterations)
+  {
+    SolveFactors(byRow, h, w);
+    SolveFactors(byColumn, w, h);
+
+    const double newError = TrainingError();
+    Log::Info << "ALSMatrixCompletion: iteration " << iterations << ", RMSE "
+        << newError << "." << std::endl;
+
+    const bool converged = std::abs(error - newError) <=
+        tolerance * std::max(error, 1e-10) || newError <= 1e-12;
+    error = newError;
+    if (converged)
+      break;
+  }
+
+  iterations = std::min(iterations, maxIterations);
+  return error;
+}
+
+inline double ALSMatrixCompletion::Recover(arma::mat& recovered)
+{
+  const double error = Recover();
+  recovered = w.t() * h;
+  return error;
+}
+
+inline void ALSMatrixCompletion::Predict(const arma::umat& entries,
+                                         arma::vec& predictions) const
+{
+  predictions.set_size(entries.n_cols);
+  #pragma omp parallel for
+  for (size_t i = 0; i < entries.n_cols; ++i)
+    predictions[i] = Predict(entries(0, i), entries(1, i));
+}
+
+inline void ALSMatrixCompletion::Group(const arma::umat& indices,
+                                       const arma::vec& values,
+                                       const size_t dimension,
+                                       const size_t numGroups,
+                                       KnownEntries& entries)
+{
+  // Count the entries of each group, then place them with a stable counting
+  // sort on the group; entries are first sorted by their other index, so they
+  // are sorted within each group.
+  const arma::uvec order = arma::stable_sort_index(
+      indices.row(1 - dimension).t());
+
+  entries.offsets.zeros(numGroups + 1);
+  for (size_t k = 0; k < indices.n_cols; ++k)
+    ++entries.offsets[indices(dimension, k) + 1];
+  entries.offsets = arma::cumsum(entries.offsets);
+
+  arma::uvec next = entries.offsets.head(numGroups);
+  entries.others.set_size(indices.n_cols);
+  entries.values.set_size(indices.n_cols);
+  for (size_t k = 0; k < order.n_elem; ++k)
+  {
+    const size_t entry = order[k];
+    const size_t position = next[indices(dimension, entry)]++;
+    entries.others[position] = indices(1 - dimension, entry);
+    entries.values[position] = values[entry];
+  }
+}
+
+inline void ALSMatrixCompletion::SolveFactors(const KnownEntries& entries,
+                                              const arma::mat& fixedFactors,
+                                              arma::mat& factors) const
+{
+  // Each factor only depends on the fixed factors, so they are all solved in
+  // parallel; the groups have different sizes, hence the dynamic schedule.
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (size_t g = 0; g < factors.n_cols; ++g)
+  {
+    const size_t begin = entries.offsets[g];
+    const size_t count = entries.offsets[g + 1] - begin;
+    if (count == 0)
+    {
+      // Nothing is known about this row or column, so it is predicted as 0.
+      factors.col(g).zeros();
+      continue;
+    }
+
+    // Gather the fixed factors F of the known entries, and solve
+    // (F F^T + lambda * count * I) x = F values.
+    arma::mat known(rank, count);
+    for (size_t k = 0; k < count; ++k)
+      known.col(k) = fixedFactors.col(entries.others[begin + k]);
+
+    arma::mat gram = known * known.t();
+    gram.diag() += lambda * count;
+    arma::vec solution;
+    if (!arma::solve(solution, gram, known * entries.values.subvec(begin,
+        begin + count - 1), arma::solve_opts::likely_sympd))
+    {
+      solution.zeros(rank);
+    }
+
+    factors.col(g) = solution;
+  }
+}
+
+inline double ALSMatrixCompletion::TrainingError() const
+{
+  double sumSquares = 0.0;
+  #pragma omp parallel for reduction(+:sumSquares) schedule(dynamic, 64)
+  for (size_t j = 0; j < n; ++j)
+  {
+    for (size_t k = byColumn.offsets[j]; k < byColumn.offsets[j + 1]; ++k)
+    {
+      const double diff = byColumn.values[k] -
+          arma::dot(w.col(byColumn.others[k]), h.col(j));
+      sumSquares += diff * diff;
+    }
+  }
+
+  return std::sqrt(sumSquares /
+      std::max((double) byColumn.values.n_elem, 1.0));
+}
+
+} // namespace mlpack
+
+#endif
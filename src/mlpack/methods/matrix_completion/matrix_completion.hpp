@@ -46,7 +46,10 @@ namespace mlpack {
  * mc.Recover(recovered);
  * @endcode
  *
- * @see LRSDP
+ * The size of the SDP grows with (m + n)^2, so for large matrices, use
+ * ALSMatrixCompletion instead.
+ *
+ * @see LRSDP, ALSMatrixCompletion
  */
 class MatrixCompletion
 {
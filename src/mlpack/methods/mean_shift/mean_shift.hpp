@@ -22,6 +22,15 @@ namespace mlpack {
  * apply mean shift algorithm until maximum iterations or convergence.  Then
  * remove duplicate centroids.
  *
+ * One kd-tree is built on the dataset, and the neighborhood of each centroid is
+ * found with a single-tree range search on it.  The seeds converge
+ * independently, so if OpenMP is enabled they are split between threads that
+ * share the tree; duplicate centroids are removed afterwards in seed order, so
+ * the result does not depend on the number of threads.  Without a kernel (a
+ * flat kernel), only the sum and the number of the points in range are kept
+ * during each search, and the points of tree nodes entirely in range are added
+ * without computing their distances.
+ *
  * A simple example of how to run mean shift clustering is shown below.
  *
  * @code
@@ -154,27 +163,33 @@ class MeanShift
    * @param distances Distances to neighbors
    # @param centroid Store calculated centroid
    */
-  template<bool ApplyKernel = UseKernel, typename MatType, typename VecType>
-  typename std::enable_if<ApplyKernel, bool>::type
-  CalculateCentroid(const MatType& data,
-                    const std::vector<size_t>& neighbors,
-                    const std::vector<typename MatType::elem_type>& distances,
-                    VecType& centroid);
+  template<typename MatType, typename VecType>
+  bool CalculateCentroid(const MatType& data,
+                         const std::vector<size_t>& neighbors,
+                         const std::vector<typename MatType::elem_type>&
+                             distances,
+                         VecType& centroid);
 
   /**
-   * Use mean to calculate new centroid given dataset and valid neighbors.
+   * Search the tree for the points in range of the given centroid, and
+   * calculate the shifted centroid from them (with the kernel, or as their
+   * mean).  Returns false if there are no points in range.
    *
-   * @param data The whole dataset
-   * @param neighbors Valid neighbors
-   * @param distances Distances to neighbors
-   # @param centroid Store calculated centroid
+   * @param tree Tree built on the dataset.
+   * @param query Matrix holding the current centroid as its only column.
+   * @param range Range of distances to search in.
+   * @param neighbors Storage for the neighbors, if the kernel is used.
+   * @param distances Storage for the distances, if the kernel is used.
+   * @param newCentroid Zero vector to store the shifted centroid in.
    */
-  template<bool ApplyKernel = UseKernel, typename MatType, typename VecType>
-  typename std::enable_if<!ApplyKernel, bool>::type
-  CalculateCentroid(const MatType& data,
-                    const std::vector<size_t>& neighbors,
-                    const std::vector<typename MatType::elem_type>&, /*unused*/
-                    VecType& centroid);
+  template<typename TreeType, typename MatType, typename VecType>
+  bool ShiftCentroid(TreeType& tree,
+                     const MatType& query,
+                     const RangeType<typename MatType::elem_type>& range,
+                     std::vector<std::vector<size_t>>& neighbors,
+                     std::vector<std::vector<typename MatType::elem_type>>&
+                         distances,
+                     VecType& newCentroid);
 
   /**
    * If distance of two centroids is less than radius, one will be removed.
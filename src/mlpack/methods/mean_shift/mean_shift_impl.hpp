@@ -17,6 +17,7 @@
 #include <mlpack/core/distances/lmetric.hpp>
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 #include <mlpack/methods/range_search/range_search.hpp>
+#include "mean_shift_sum_results.hpp"
 
 #include "map"
 
@@ -130,9 +131,8 @@ void MeanShift<UseKernel, KernelType>::GenSeeds(const MatType& data,
 
 // Calculate new centroid with given kernel.
 template<bool UseKernel, typename KernelType>
-template<bool ApplyKernel, typename MatType, typename VecType>
-typename std::enable_if<ApplyKernel, bool>::type
-MeanShift<UseKernel, KernelType>::CalculateCentroid(
+template<typename MatType, typename VecType>
+bool MeanShift<UseKernel, KernelType>::CalculateCentroid(
     const MatType& data,
     const std::vector<size_t>& neighbors,
     const std::vector<typename MatType::elem_type>& distances,
@@ -160,20 +160,57 @@ MeanShift<UseKernel, KernelType>::CalculateCentroid(
   return false;
 }
 
-// Calculate new centroid by mean.
+// Find the points in range of a centroid and calculate the shifted centroid.
 template<bool UseKernel, typename KernelType>
-template<bool ApplyKernel, typename MatType, typename VecType>
-typename std::enable_if<!ApplyKernel, bool>::type
-MeanShift<UseKernel, KernelType>::CalculateCentroid(
-    const MatType& data,
-    const std::vector<size_t>& neighbors,
-    const std::vector<typename MatType::elem_type>&, /*unused*/
-    VecType& centroid)
+template<typename TreeType, typename MatType, typename VecType>
+bool MeanShift<UseKernel, KernelType>::ShiftCentroid(
+    TreeType& tree,
+    const MatType& query,
+    const RangeType<typename MatType::elem_type>& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<typename MatType::elem_type>>& distances,
+    VecType& newCentroid)
 {
-  for (size_t i = 0; i < neighbors.size(); ++i)
-    centroid += data.unsafe_col(neighbors[i]);
+  EuclideanDistance distance;
+  if constexpr (UseKernel)
+  {
+    neighbors[0].clear();
+    distances[0].clear();
+
+    typedef RangeSearchRules<EuclideanDistance, TreeType> RuleType;
+    RuleType rules(tree.Dataset(), query, range, neighbors, distances,
+        distance);
+    typename TreeType::template SingleTreeTraverser<RuleType> traverser(rules);
+    traverser.Traverse(0, tree);
+
+    // There are no points in the cluster.
+    if (neighbors[0].size() == 0)
+      return false;
+
+    if (!CalculateCentroid(tree.Dataset(), neighbors[0], distances[0],
+        newCentroid))
+      newCentroid = query.col(0);
+  }
+  else
+  {
+    // Calculate the new centroid by mean, keeping only the running sum.
+    typedef MeanShiftSumResults<MatType, VecType> ResultsType;
+    typedef RangeSearchRules<EuclideanDistance, TreeType, ResultsType>
+        RuleType;
+
+    size_t count = 0;
+    RuleType rules(tree.Dataset(), query, range,
+        ResultsType(tree.Dataset(), newCentroid, count), distance);
+    typename TreeType::template SingleTreeTraverser<RuleType> traverser(rules);
+    traverser.Traverse(0, tree);
+
+    // There are no points in the cluster.
+    if (count == 0)
+      return false;
+
+    newCentroid /= count;
+  }
 
-  centroid /= neighbors.size();
   return true;
 }
 
@@ -191,6 +228,7 @@ inline void MeanShift<UseKernel, KernelType>::Cluster(
   // Convenience typedefs.
   typedef typename MatType::elem_type ElemType;
   typedef typename GetColType<MatType>::type VecType;
+  typedef KDTree<EuclideanDistance, RangeSearchStat, MatType> TreeType;
 
   if (radius <= 0)
   {
@@ -208,59 +246,71 @@ inline void MeanShift<UseKernel, KernelType>::Cluster(
 
   // Holds all centroids before removing duplicate ones.
   CentroidsType allCentroids(pSeeds->n_rows, pSeeds->n_cols);
+  // Whether each seed converged.
+  std::vector<char> converged(pSeeds->n_cols, 0);
 
-  RangeSearch<EuclideanDistance, MatType> rangeSearcher(data);
+  // All threads search the same tree.  The tree rearranges its copy of the
+  // dataset, but only the points in range matter, not their indices.
+  TreeType tree(data);
   RangeType<ElemType> validRadius((ElemType) 0, (ElemType) radius);
-  std::vector<std::vector<size_t>> neighbors;
-  std::vector<std::vector<ElemType>> distances;
 
   // For each seed, perform mean shift algorithm.
-  for (size_t i = 0; i < pSeeds->n_cols; ++i)
+  #pragma omp parallel
   {
-    // Initial centroid is the seed itself.
-    allCentroids.col(i) = pSeeds->unsafe_col(i);
-    for (size_t completedIterations = 0; completedIterations < maxIterations
-        || forceConvergence; completedIterations++)
-    {
-      // Store new centroid in this.
-      VecType newCentroid = zeros<VecType>(pSeeds->n_rows);
+    std::vector<std::vector<size_t>> neighbors(1);
+    std::vector<std::vector<ElemType>> distances(1);
+    MatType query(pSeeds->n_rows, 1);
 
-      rangeSearcher.Search(allCentroids.unsafe_col(i), validRadius,
-          neighbors, distances);
-      if (neighbors[0].size() == 0) // There are no points in the cluster.
-        break;
+    #pragma omp for schedule(dynamic, 1)
+    for (size_t i = 0; i < (size_t) pSeeds->n_cols; ++i)
+    {
+      // Initial centroid is the seed itself.
+      allCentroids.col(i) = pSeeds->unsafe_col(i);
+      for (size_t completedIterations = 0; completedIterations < maxIterations
+          || forceConvergence; completedIterations++)
+      {
+        // Store new centroid in this.
+        VecType newCentroid = zeros<VecType>(pSeeds->n_rows);
 
-      // Calculate new centroid.
-      if (!CalculateCentroid(data, neighbors[0], distances[0], newCentroid))
-        newCentroid = allCentroids.unsafe_col(i);
+        query.col(0) = allCentroids.col(i);
+        if (!ShiftCentroid(tree, query, validRadius, neighbors, distances,
+            newCentroid))
+          break;
 
-      // If the mean shift vector is small enough, it has converged.
-      if (EuclideanDistance::Evaluate(newCentroid,
-          allCentroids.unsafe_col(i)) < 1e-3 * radius)
-      {
-        // Determine if the new centroid is duplicate with old ones.
-        bool isDuplicated = false;
-        for (size_t k = 0; k < centroids.n_cols; ++k)
+        // If the mean shift vector is small enough, it has converged.
+        if (EuclideanDistance::Evaluate(newCentroid,
+            allCentroids.unsafe_col(i)) < 1e-3 * radius)
         {
-          const ElemType distance = EuclideanDistance::Evaluate(
-              allCentroids.unsafe_col(i), centroids.unsafe_col(k));
-          if (distance < radius)
-          {
-            isDuplicated = true;
-            break;
-          }
+          converged[i] = 1;
+          break;
         }
 
-        if (!isDuplicated)
-          centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
+        // Update the centroid.
+        allCentroids.col(i) = newCentroid;
+      }
+    }
+  }
+
+  // Keep the converged centroids that are not duplicates of earlier ones.
+  for (size_t i = 0; i < pSeeds->n_cols; ++i)
+  {
+    if (!converged[i])
+      continue;
 
-        // Get out of the loop.
+    bool isDuplicated = false;
+    for (size_t k = 0; k < centroids.n_cols; ++k)
+    {
+      const ElemType distance = EuclideanDistance::Evaluate(
+          allCentroids.unsafe_col(i), centroids.unsafe_col(k));
+      if (distance < radius)
+      {
+        isDuplicated = true;
         break;
       }
-
-      // Update the centroid.
-      allCentroids.col(i) = newCentroid;
     }
+
+    if (!isDuplicated)
+      centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
   }
 
   // If no centroid has converged due to too little iterations and without
@@ -0,0 +1,78 @@
+/**
+ * @file methods/mean_shift/mean_shift_sum_results.hpp
+ *
+ * A range search result policy that keeps the running sum and count of the
+ * points in range, for flat-kernel mean shift.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_MEAN_SHIFT_MEAN_SHIFT_SUM_RESULTS_HPP
+#define MLPACK_METHODS_MEAN_SHIFT_MEAN_SHIFT_SUM_RESULTS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Accumulate the sum and the number of the reference points in range of a
+ * single query point, instead of storing them; see range_search_results.hpp
+ * for the other result policies of RangeSearchRules.  The flat-kernel mean
+ * shift step is then just the sum divided by the count.  No distances are
+ * needed, so when a whole tree node is in range its points are added without
+ * computing any distance.
+ *
+ * @tparam MatType Type of the reference dataset.
+ * @tparam VecType Type of the vector to hold the sum in.
+ */
+template<typename MatType, typename VecType>
+class MeanShiftSumResults
+{
+ public:
+  //! The type of element held in MatType.
+  typedef typename MatType::elem_type ElemType;
+
+  //! The rules do not need to compute the distances of points that are added
+  //! without a base case.
+  static constexpr bool NeedsDistances = false;
+
+  /**
+   * Accumulate results into the given sum and count, which should already be
+   * initialized.
+   *
+   * @param dataset Reference dataset (the dataset of the tree).
+   * @param sum Vector to add the points in range to.
+   * @param count Number of points in range, to be incremented.
+   */
+  MeanShiftSumResults(const MatType& dataset, VecType& sum, size_t& count) :
+      dataset(&dataset),
+      sum(&sum),
+      count(&count)
+  { }
+
+  //! Prepare to add up to the given number of results to the given query point.
+  void Reserve(const size_t /* queryIndex */, const size_t /* numResults */) { }
+
+  //! Add the given reference point to the sum.
+  void Add(const size_t /* queryIndex */,
+           const size_t referenceIndex,
+           const ElemType /* distance */)
+  {
+    (*sum) += dataset->unsafe_col(referenceIndex);
+    ++(*count);
+  }
+
+ private:
+  //! The reference dataset.
+  const MatType* dataset;
+  //! The sum of the points in range.
+  VecType* sum;
+  //! The number of points in range.
+  size_t* count;
+};
+
+} // namespace mlpack
+
+#endif
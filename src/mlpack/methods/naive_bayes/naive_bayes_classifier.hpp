@@ -285,6 +285,27 @@ class NaiveBayesClassifier
   template<typename MatType>
   void LogLikelihood(const MatType& data,
                      ModelMatType& logLikelihoods) const;
+
+  /**
+   * Merge the per-class statistics of a second set of points into the
+   * statistics of a first set of points: the number of points of each class,
+   * the mean of each class, and the sum of squared deviations from the mean of
+   * each class.
+   *
+   * @param counts Number of points of each class in the first set.
+   * @param classMeans Means of each class in the first set.
+   * @param squares Sums of squared deviations of each class in the first set.
+   * @param otherCounts Number of points of each class in the second set.
+   * @param otherMeans Means of each class in the second set.
+   * @param otherSquares Sums of squared deviations of each class in the second
+   *     set.
+   */
+  static void MergeStatistics(arma::Col<ElemType>& counts,
+                              ModelMatType& classMeans,
+                              ModelMatType& squares,
+                              const arma::Col<ElemType>& otherCounts,
+                              const ModelMatType& otherMeans,
+                              const ModelMatType& otherSquares);
 };
 
 } // namespace mlpack
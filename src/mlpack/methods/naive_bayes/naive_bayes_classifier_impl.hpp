@@ -94,24 +94,60 @@ void NaiveBayesClassifier<ModelMatType>::Train(
     if (probabilities.n_elem != numClasses || data.n_rows != means.n_rows)
       Reset(data.n_rows, numClasses);
 
-    // Use incremental algorithm.
-    // Fist, de-normalize probabilities.
-    probabilities *= trainingPoints;
-
-    for (size_t j = 0; j < data.n_cols; ++j)
+    // Use incremental algorithm.  Each thread collects the count, the mean,
+    // and the sum of squared deviations of each class over its points with
+    // Welford's algorithm, and these are merged afterwards.
+    arma::Col<ElemType> counts(numClasses, arma::fill::zeros);
+    ModelMatType batchMeans(data.n_rows, numClasses, arma::fill::zeros);
+    ModelMatType batchSquares(data.n_rows, numClasses, arma::fill::zeros);
+
+    #pragma omp parallel
     {
-      const size_t label = labels[j];
-      ++probabilities[label];
+      arma::Col<ElemType> threadCounts(numClasses, arma::fill::zeros);
+      ModelMatType threadMeans(data.n_rows, numClasses, arma::fill::zeros);
+      ModelMatType threadSquares(data.n_rows, numClasses, arma::fill::zeros);
+
+      #pragma omp for schedule(static)
+      for (size_t j = 0; j < data.n_cols; ++j)
+      {
+        const size_t label = labels[j];
+        ++threadCounts[label];
+
+        arma::Col<ElemType> delta = data.col(j) - threadMeans.col(label);
+        threadMeans.col(label) += delta / threadCounts[label];
+        threadSquares.col(label) += delta % (data.col(j) -
+            threadMeans.col(label));
+      }
+
+      #pragma omp critical
+      {
+        MergeStatistics(counts, batchMeans, batchSquares, threadCounts,
+            threadMeans, threadSquares);
+      }
+    }
 
-      arma::Col<ElemType> delta = data.col(j) - means.col(label);
-      means.col(label) += delta / probabilities[label];
-      variances.col(label) += delta % (data.col(j) - means.col(label));
+    // Now merge the new points into the current model; first, de-normalize
+    // the probabilities and the variances.
+    arma::Col<ElemType> modelCounts = round(vectorise(probabilities) *
+        ((ElemType) trainingPoints));
+    ModelMatType modelSquares(variances);
+    for (size_t i = 0; i < numClasses; ++i)
+    {
+      if (modelCounts[i] > 1)
+        modelSquares.col(i) *= (modelCounts[i] - 1);
+      else
+        modelSquares.col(i).zeros();
     }
 
-    for (size_t i = 0; i < probabilities.n_elem; ++i)
+    MergeStatistics(modelCounts, means, modelSquares, counts, batchMeans,
+        batchSquares);
+
+    probabilities = modelCounts;
+    variances = modelSquares;
+    for (size_t i = 0; i < numClasses; ++i)
     {
-      if (probabilities[i] > 2)
-        variances.col(i) /= (probabilities[i] - 1);
+      if (modelCounts[i] > 1)
+        variances.col(i) /= (modelCounts[i] - 1);
     }
   }
   else
@@ -120,19 +156,34 @@ void NaiveBayesClassifier<ModelMatType>::Train(
     probabilities.zeros(numClasses);
     means.zeros(data.n_rows, numClasses);
     variances.zeros(data.n_rows, numClasses);
+    trainingPoints = 0;
 
     // Don't use incremental algorithm.  This is a two-pass algorithm.  It is
     // possible to calculate the means and variances using a faster one-pass
     // algorithm but there are some precision and stability issues.  If this is
     // too slow, it's an option to use the faster algorithm by default and then
-    // have this (and the incremental algorithm) be other options.
+    // have this (and the incremental algorithm) be other options.  Each pass
+    // sums over the points on each thread separately.
 
     // Calculate the means.
-    for (size_t j = 0; j < data.n_cols; ++j)
+    #pragma omp parallel
     {
-      const size_t label = labels[j];
-      ++probabilities[label];
-      means.col(label) += data.col(j);
+      ModelMatType threadCounts(numClasses, 1, arma::fill::zeros);
+      ModelMatType threadSums(data.n_rows, numClasses, arma::fill::zeros);
+
+      #pragma omp for schedule(static)
+      for (size_t j = 0; j < data.n_cols; ++j)
+      {
+        const size_t label = labels[j];
+        ++threadCounts[label];
+        threadSums.col(label) += data.col(j);
+      }
+
+      #pragma omp critical
+      {
+        probabilities += threadCounts;
+        means += threadSums;
+      }
     }
 
     // Normalize means.
@@ -141,10 +192,19 @@ void NaiveBayesClassifier<ModelMatType>::Train(
         means.col(i) /= probabilities[i];
 
     // Calculate variances.
-    for (size_t j = 0; j < data.n_cols; ++j)
+    #pragma omp parallel
     {
-      const size_t label = labels[j];
-      variances.col(label) += square(data.col(j) - means.col(label));
+      ModelMatType threadSums(data.n_rows, numClasses, arma::fill::zeros);
+
+      #pragma omp for schedule(static)
+      for (size_t j = 0; j < data.n_cols; ++j)
+      {
+        const size_t label = labels[j];
+        threadSums.col(label) += square(data.col(j) - means.col(label));
+      }
+
+      #pragma omp critical
+      variances += threadSums;
     }
 
     // Normalize variances.
@@ -156,8 +216,8 @@ void NaiveBayesClassifier<ModelMatType>::Train(
   // Add epsilon to prevent log of zero.
   variances += epsilon;
 
-  probabilities /= data.n_cols;
   trainingPoints += data.n_cols;
+  probabilities /= trainingPoints;
 }
 
 template<typename ModelMatType>
@@ -217,23 +277,56 @@ void NaiveBayesClassifier<ModelMatType>::LogLikelihood(
       "NaiveBayesClassifier: element type of given data must match the element "
       "type of the model!");
 
-  logLikelihoods = log(repmat(probabilities, 1, data.n_cols));
-  ModelMatType invVar = 1.0 / variances;
+  // The log likelihood of point x for class c is
+  //   log(p_c) - d / 2 log(2 pi) - 0.5 sum(log(v_c)) - 0.5 sum((x - m_c)^2 / v_c),
+  // and the last sum expands into terms that are linear in x and in x^2, so
+  // that the log likelihoods of all classes can be computed with two matrix
+  // multiplications.  Dense points are shifted by the mean of the class means
+  // first, to avoid cancellation in the expansion; sparse points are not, so
+  // that they stay sparse.
+  constexpr bool isSparse = arma::is_arma_sparse_type<MatType>::value;
+  arma::Col<ElemType> shift;
+  if (isSparse)
+    shift.zeros(means.n_rows);
+  else
+    shift = mean(means, 1);
+
+  const ModelMatType invVar = 1.0 / variances;
+  const ModelMatType shiftedMeans = means.each_col() - shift;
+  const ModelMatType linearWeights = trans(shiftedMeans % invVar);
+  const ModelMatType squareWeights = -0.5 * trans(invVar);
+  const arma::Col<ElemType> constants = log(vectorise(probabilities)) +
+      trans(data.n_rows / -2.0 * std::log(2 * M_PI) -
+      0.5 * sum(log(variances), 0) -
+      0.5 * sum(square(shiftedMeans) % invVar, 0));
+
+  // Compute the log likelihoods in blocks of points, so that the temporaries
+  // stay small.
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+  logLikelihoods.set_size(means.n_cols, data.n_cols);
+
+  #pragma omp parallel for schedule(static)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) data.n_cols) - 1;
 
-  // Calculate the joint log likelihood of point for each of the
-  // means.n_cols.
+    if constexpr (isSparse)
+    {
+      const arma::SpMat<ElemType> block = data.cols(begin, end);
+      logLikelihoods.cols(begin, end) = linearWeights * block +
+          squareWeights * square(block);
+    }
+    else
+    {
+      const arma::Mat<ElemType> block = data.cols(begin, end).each_col() -
+          shift;
+      logLikelihoods.cols(begin, end) = linearWeights * block +
+          squareWeights * square(block);
+    }
 
-  // Loop over every class.
-  for (size_t i = 0; i < means.n_cols; ++i)
-  {
-    // This is an adaptation of phi() for the case where the covariance is a
-    // diagonal matrix.
-    ModelMatType diffs = data - repmat(means.col(i), 1, data.n_cols);
-    ModelMatType rhs = -0.5 * arma::diagmat(invVar.col(i)) * diffs;
-    arma::Mat<ElemType> exponents = sum(diffs % rhs, 0);
-
-    logLikelihoods.row(i) += (data.n_rows / -2.0 * std::log(2 * M_PI) - 0.5 *
-        accu(log(variances.col(i))) + exponents);
+    logLikelihoods.cols(begin, end).each_col() += constants;
   }
 }
 
@@ -330,6 +423,7 @@ void NaiveBayesClassifier<ModelMatType>::Classify(
   ModelMatType logLikelihoods;
   LogLikelihood(data, logLikelihoods);
 
+  #pragma omp parallel for schedule(static)
   for (size_t i = 0; i < data.n_cols; ++i)
   {
     arma::uword maxIndex = 0;
@@ -368,25 +462,52 @@ void NaiveBayesClassifier<ModelMatType>::Classify(
   LogLikelihood(data, logLikelihoods);
 
   predictionProbs.set_size(arma::size(logLikelihoods));
-  double maxValue, logProbX;
+  #pragma omp parallel for schedule(static)
   for (size_t j = 0; j < data.n_cols; ++j)
   {
     // The LogLikelihood() gives us the unnormalized log likelihood which is
     // Log(Prob(X|Y)) + Log(Prob(Y)), so we subtract the normalization term.
     // Besides, to prevent underflow in log of sum of exp of x operation (where
     // x is a small negative value), we use logsumexp(x - max(x)) + max(x).
-    maxValue = max(logLikelihoods.col(j));
-    logProbX = std::log(accu(exp(logLikelihoods.col(j) -
+    // The maximum also gives the prediction of the point.
+    arma::uword maxIndex = 0;
+    const double maxValue = logLikelihoods.unsafe_col(j).max(maxIndex);
+    const double logProbX = std::log(accu(exp(logLikelihoods.col(j) -
         maxValue))) + maxValue;
     predictionProbs.col(j) = exp(logLikelihoods.col(j) - logProbX);
+    predictions[j] = maxIndex;
   }
+}
 
-  // Now calculate maximum probabilities for each point.
-  for (size_t i = 0; i < data.n_cols; ++i)
+template<typename ModelMatType>
+void NaiveBayesClassifier<ModelMatType>::MergeStatistics(
+    arma::Col<ElemType>& counts,
+    ModelMatType& classMeans,
+    ModelMatType& squares,
+    const arma::Col<ElemType>& otherCounts,
+    const ModelMatType& otherMeans,
+    const ModelMatType& otherSquares)
+{
+  for (size_t i = 0; i < counts.n_elem; ++i)
   {
-    arma::uword maxIndex = 0;
-    logLikelihoods.unsafe_col(i).max(maxIndex);
-    predictions[i] = maxIndex;
+    if (otherCounts[i] == 0)
+      continue;
+
+    if (counts[i] == 0)
+    {
+      counts[i] = otherCounts[i];
+      classMeans.col(i) = otherMeans.col(i);
+      squares.col(i) = otherSquares.col(i);
+      continue;
+    }
+
+    // This is the pairwise update of Chan, Golub, and LeVeque.
+    const ElemType total = counts[i] + otherCounts[i];
+    const arma::Col<ElemType> delta = otherMeans.col(i) - classMeans.col(i);
+    classMeans.col(i) += delta * (otherCounts[i] / total);
+    squares.col(i) += otherSquares.col(i) +
+        square(delta) * (counts[i] * otherCounts[i] / total);
+    counts[i] = total;
   }
 }
 
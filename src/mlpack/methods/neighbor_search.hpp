@@ -12,5 +12,8 @@
 #define MLPACK_NEIGHBOR_SEARCH_HPP
 
 #include "neighbor_search/neighbor_search.hpp"
+#include "neighbor_search/concurrent_neighbor_search.hpp"
+#include "neighbor_search/dynamic_neighbor_search.hpp"
+#include "neighbor_search/sparse_cosine_search.hpp"
 
 #endif
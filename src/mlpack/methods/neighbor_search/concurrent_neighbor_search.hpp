@@ -0,0 +1,205 @@
+/**
+ * @file methods/neighbor_search/concurrent_neighbor_search.hpp
+ *
+ * Defines the ConcurrentNeighborSearch class, which serves neighbor and range
+ * searches on a rectangle tree while points are inserted and deleted.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_CONCURRENT_NEIGHBOR_SEARCH_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_CONCURRENT_NEIGHBOR_SEARCH_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/core/tree/rectangle_tree.hpp>
+#include <mlpack/methods/range_search/range_search_rules.hpp>
+
+#include "neighbor_search_rules.hpp"
+#include "neighbor_search_stat.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace mlpack {
+
+/**
+ * The ConcurrentNeighborSearch class lets any number of threads search a
+ * dynamic tree (like an RStarTree) while another thread inserts or deletes
+ * points.  InsertPoint() and DeletePoint() of RectangleTree change the nodes
+ * (and the dataset) in place, so they can't run while the tree is traversed;
+ * instead, two copies of the tree are kept, with the left-right technique:
+ *
+ *  - readers search the active copy, after registering with the reader count
+ *    of that copy;
+ *  - a writer changes the inactive copy, makes it the active one, waits until
+ *    the readers of the other copy are done, and applies the same change to
+ *    it.
+ *
+ * Readers never wait, and always see a consistent tree, which holds every
+ * change that was made before their search started; writers are serialized,
+ * and do each change twice, so points are best inserted by batches.  Both
+ * copies hold the full dataset.
+ *
+ * Points are identified by their index in the dataset, which is kept by
+ * deleted points, so the indices of the other points don't change.
+ *
+ * @code
+ * ConcurrentNeighborSearch<> search(referenceSet);
+ *
+ * // In any number of reader threads:
+ * search.Search(queries, 5, neighbors, distances);
+ *
+ * // In a writer thread:
+ * const size_t first = search.Insert(newPoints);
+ * search.Remove(first);
+ * @endcode
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam DistanceType The distance metric to use for computation.
+ * @tparam MatType The type of data matrix.
+ * @tparam TreeType The dynamic tree type to use (RectangleTree variants).
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         typename DistanceType = EuclideanDistance,
+         typename MatType = arma::mat,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = RStarTree>
+class ConcurrentNeighborSearch
+{
+ public:
+  //! The type of tree.
+  typedef TreeType<DistanceType, NeighborSearchStat<SortPolicy>, MatType> Tree;
+  //! The type of element held in MatType.
+  typedef typename MatType::elem_type ElemType;
+
+  static_assert(!TreeTraits<Tree>::HasSelfChildren &&
+      !TreeTraits<Tree>::RearrangesDataset, "ConcurrentNeighborSearch: the "
+      "tree type must not have self-children or rearrange the dataset");
+
+  /**
+   * Build the two copies of the tree on the given reference set.
+   *
+   * @param referenceSet Set of reference points.
+   * @param epsilon Relative approximate error of the neighbor searches.
+   * @param distance An optional instance of the DistanceType class.
+   */
+  ConcurrentNeighborSearch(const MatType& referenceSet,
+                           const double epsilon = 0,
+                           const DistanceType distance = DistanceType());
+
+  // The reader counts can't be copied.
+  ConcurrentNeighborSearch(const ConcurrentNeighborSearch& other) = delete;
+  ConcurrentNeighborSearch& operator=(const ConcurrentNeighborSearch& other) =
+      delete;
+
+  /**
+   * Insert the given points in the tree; they get consecutive indices,
+   * starting with the returned one.  This can be called while other threads
+   * search the tree.
+   *
+   * @param points Points to insert.
+   * @return Index of the first inserted point.
+   */
+  size_t Insert(const MatType& points);
+
+  /**
+   * Delete the point with the given index from the tree.  This can be called
+   * while other threads search the tree.
+   *
+   * @param point Index of the point to delete.
+   * @return false if the point is not in the tree.
+   */
+  bool Remove(const size_t point);
+
+  /**
+   * Search for the k nearest neighbors of the given queries with single-tree
+   * traversals of the active tree.  The output matrices have k rows and one
+   * column per query point.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix to store the indices of the neighbors in.
+   * @param distances Matrix to store the distances in.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances) const;
+
+  /**
+   * Search for the points of the active tree within the given range of the
+   * given queries.  The results of each query are not sorted.
+   *
+   * @param querySet Set of query points.
+   * @param range Range of distances to search for.
+   * @param neighbors Indices of the points found for each query.
+   * @param distances Distances to the points found for each query.
+   */
+  void Search(const MatType& querySet,
+              const RangeType<ElemType>& range,
+              std::vector<std::vector<size_t>>& neighbors,
+              std::vector<std::vector<ElemType>>& distances) const;
+
+  /**
+   * Call the given function with the active tree, which is not changed until
+   * the function returns (though the other copy may be).  This lets other
+   * computations run on a consistent tree.
+   *
+   * @param function Function taking a const Tree&.
+   */
+  template<typename FuncType>
+  void Read(FuncType&& function) const;
+
+  //! Get the number of points in the tree.
+  size_t NumPoints() const;
+
+ private:
+  //! Register a reader with the reader count of the active copy, while it is
+  //! alive.
+  class ReaderGuard
+  {
+   public:
+    ReaderGuard(const ConcurrentNeighborSearch& search);
+    ~ReaderGuard() { --search.readers[copy]; }
+
+    //! Get the tree that can be read.
+    const Tree& ReadTree() const { return *search.trees[copy]; }
+
+   private:
+    const ConcurrentNeighborSearch& search;
+    size_t copy;
+  };
+
+  /**
+   * Apply the given change to both copies of the tree, as described above.
+   * The change must return false if it did nothing, in which case the active
+   * copy is not changed.
+   */
+  template<typename FuncType>
+  bool Write(FuncType&& change);
+
+  //! The two copies of the tree.
+  std::unique_ptr<Tree> trees[2];
+  //! The copy that readers search.
+  std::atomic<size_t> active;
+  //! The number of readers of each copy.
+  mutable std::atomic<size_t> readers[2];
+  //! The lock held by writers.
+  std::mutex writeMutex;
+
+  //! The relative approximate error of the neighbor searches.
+  double epsilon;
+  //! The instantiated distance metric.
+  DistanceType distance;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "concurrent_neighbor_search_impl.hpp"
+
+#endif
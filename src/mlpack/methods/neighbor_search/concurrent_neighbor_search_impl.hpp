@@ -0,0 +1,259 @@
+/**
+ * @file methods/neighbor_search/concurrent_neighbor_search_impl.hpp
+ *
+ * Implementation of the ConcurrentNeighborSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_CONCURRENT_NEIGHBOR_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_CONCURRENT_NEIGHBOR_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "concurrent_neighbor_search.hpp"
+
+namespace mlpack {
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+ConcurrentNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+ConcurrentNeighborSearch(const MatType& referenceSet,
+                         const double epsilon,
+                         const DistanceType distance) :
+    active(0),
+    epsilon(epsilon),
+    distance(distance)
+{
+  if (epsilon < 0)
+    throw std::invalid_argument("epsilon must be non-negative");
+
+  trees[0].reset(new Tree(referenceSet));
+  trees[1].reset(new Tree(referenceSet));
+  readers[0] = 0;
+  readers[1] = 0;
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+size_t ConcurrentNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+Insert(const MatType& points)
+{
+  std::lock_guard<std::mutex> lock(writeMutex);
+
+  const size_t first = trees[0]->Dataset().n_cols;
+  if (points.n_rows != trees[0]->Dataset().n_rows)
+  {
+    throw std::invalid_argument("ConcurrentNeighborSearch::Insert(): the "
+        "points have " + std::to_string(points.n_rows) + " dimensions, but the "
+        "reference set has " + std::to_string(trees[0]->Dataset().n_rows));
+  }
+  if (points.n_cols == 0)
+    return first;
+
+  Write([&](Tree& tree)
+  {
+    tree.Dataset().insert_cols(first, points);
+    for (size_t i = 0; i < points.n_cols; ++i)
+      tree.InsertPoint(first + i);
+    return true;
+  });
+
+  return first;
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+bool ConcurrentNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+Remove(const size_t point)
+{
+  std::lock_guard<std::mutex> lock(writeMutex);
+
+  if (point >= trees[0]->Dataset().n_cols)
+    return false;
+
+  return Write([point](Tree& tree) { return tree.DeletePoint(point); });
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void ConcurrentNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+Search(const MatType& querySet,
+       const size_t k,
+       arma::Mat<size_t>& neighbors,
+       arma::Mat<ElemType>& distances) const
+{
+  ReaderGuard guard(*this);
+  const Tree& tree = guard.ReadTree();
+  if (k == 0 || k > tree.NumDescendants())
+  {
+    throw std::invalid_argument("ConcurrentNeighborSearch::Search(): k must "
+        "be between 1 and the number of points in the tree (" +
+        std::to_string(tree.NumDescendants()) + ")");
+  }
+  if (querySet.n_rows != tree.Dataset().n_rows)
+  {
+    throw std::invalid_argument("ConcurrentNeighborSearch::Search(): the "
+        "queries have " + std::to_string(querySet.n_rows) + " dimensions, but "
+        "the reference set has " + std::to_string(tree.Dataset().n_rows));
+  }
+
+  typedef NeighborSearchRules<SortPolicy, DistanceType, Tree> RuleType;
+  DistanceType metric(distance);
+  RuleType rules(tree.Dataset(), querySet, k, metric, epsilon);
+
+  // As in NeighborSearch, each thread has its own copy of the rules, which
+  // shares the candidate lists.
+  #pragma omp parallel if (querySet.n_cols > 16)
+  {
+    RuleType threadRules(rules);
+    typename Tree::template SingleTreeTraverser<RuleType>
+        traverser(threadRules);
+
+    #pragma omp for schedule(dynamic, 16)
+    for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
+      traverser.Traverse(i, tree);
+  }
+
+  rules.GetResults(neighbors, distances);
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void ConcurrentNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+Search(const MatType& querySet,
+       const RangeType<ElemType>& range,
+       std::vector<std::vector<size_t>>& neighbors,
+       std::vector<std::vector<ElemType>>& distances) const
+{
+  ReaderGuard guard(*this);
+  const Tree& tree = guard.ReadTree();
+  if (querySet.n_rows != tree.Dataset().n_rows)
+  {
+    throw std::invalid_argument("ConcurrentNeighborSearch::Search(): the "
+        "queries have " + std::to_string(querySet.n_rows) + " dimensions, but "
+        "the reference set has " + std::to_string(tree.Dataset().n_rows));
+  }
+
+  neighbors.clear();
+  neighbors.resize(querySet.n_cols);
+  distances.clear();
+  distances.resize(querySet.n_cols);
+
+  typedef RangeSearchRules<DistanceType, Tree> RuleType;
+  DistanceType metric(distance);
+
+  // As in RangeSearch, each thread traverses the tree for some of the query
+  // points, with its own rules.
+  #pragma omp parallel if (querySet.n_cols > 16)
+  {
+    RuleType threadRules(tree.Dataset(), querySet, range, neighbors,
+        distances, metric);
+    typename Tree::template SingleTreeTraverser<RuleType>
+        traverser(threadRules);
+
+    #pragma omp for schedule(dynamic, 16)
+    for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
+      traverser.Traverse(i, tree);
+  }
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename FuncType>
+void ConcurrentNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+Read(FuncType&& function) const
+{
+  ReaderGuard guard(*this);
+  function(guard.ReadTree());
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+size_t ConcurrentNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+NumPoints() const
+{
+  ReaderGuard guard(*this);
+  return guard.ReadTree().NumDescendants();
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+ConcurrentNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+ReaderGuard::ReaderGuard(const ConcurrentNeighborSearch& search) :
+    search(search)
+{
+  // If the active copy changes after this reader is registered, the writer may
+  // not have seen it, so the registration is retried with the new copy.  Once
+  // the active copy is the same after the registration, the writer waits for
+  // this reader before changing that copy.
+  while (true)
+  {
+    copy = search.active.load();
+    ++search.readers[copy];
+    if (search.active.load() == copy)
+      break;
+    --search.readers[copy];
+  }
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename FuncType>
+bool ConcurrentNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+Write(FuncType&& change)
+{
+  // The inactive copy has no readers: the last writer waited for them, and
+  // new readers don't stay registered with it.
+  const size_t inactive = 1 - active.load();
+  if (!change(*trees[inactive]))
+    return false;
+
+  active.store(inactive);
+  while (readers[1 - inactive].load() != 0)
+    std::this_thread::yield();
+
+  change(*trees[1 - inactive]);
+  return true;
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,220 @@
+/**
+ * @file methods/neighbor_search/dynamic_neighbor_search.hpp
+ *
+ * Defines the DynamicNeighborSearch class, which supports insertions and
+ * deletions of reference points without rebuilding the full reference tree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_DYNAMIC_NEIGHBOR_SEARCH_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_DYNAMIC_NEIGHBOR_SEARCH_HPP
+
+#include <mlpack/core.hpp>
+
+#include "neighbor_search.hpp"
+
+#include <unordered_map>
+
+namespace mlpack {
+
+/**
+ * The DynamicNeighborSearch class performs exact k-nearest-neighbor (or
+ * furthest-neighbor) search on a reference set that changes over time, with
+ * the logarithmic method: the reference points are held in a forest of static
+ * trees (NeighborSearch objects), where level i holds at most baseSize * 2^i
+ * points.  Inserted points are merged with the points of the smallest levels
+ * into the first level that can hold them, like a carry in a binary counter,
+ * so each point takes part in O(log n) rebuilds, and only small trees are
+ * built for most insertions.
+ *
+ * A removed point is marked as deleted in its tree, whose bounds and
+ * statistics stay valid, and it is skipped by the searches; once more than half
+ * of the points of a tree are deleted, that tree alone is rebuilt without
+ * them.  A search queries each tree for enough neighbors to get k points that
+ * are not deleted, and merges the results.
+ *
+ * Each point gets an identifier when it is inserted, which is the index
+ * returned in the neighbors of a search, and which is given to Remove().
+ *
+ * @code
+ * DynamicKNN knn(referenceSet); // The points get the identifiers 0 to n - 1.
+ * const size_t first = knn.Insert(newPoints);
+ * knn.Remove(3);
+ * knn.Search(querySet, 5, neighbors, distances);
+ * @endcode
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam DistanceType The distance metric to use for computation.
+ * @tparam MatType The type of data matrix.
+ * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         typename DistanceType = EuclideanDistance,
+         typename MatType = arma::mat,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = KDTree>
+class DynamicNeighborSearch
+{
+ public:
+  //! The type of the static search of each level.
+  typedef NeighborSearch<SortPolicy, DistanceType, MatType, TreeType>
+      SearchType;
+  //! The type of element held in MatType.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Create an empty model.
+   *
+   * @param baseSize Maximum number of points of the first level.
+   * @param mode Search mode of the trees of each level.
+   * @param epsilon Relative approximate error (non-negative).
+   * @param distance An optional instance of the DistanceType class.
+   */
+  DynamicNeighborSearch(const size_t baseSize = 64,
+                        const NeighborSearchMode mode = DUAL_TREE_MODE,
+                        const double epsilon = 0,
+                        const DistanceType distance = DistanceType());
+
+  /**
+   * Create a model holding the given reference set, whose points get the
+   * identifiers 0 to referenceSet.n_cols - 1.
+   *
+   * @param referenceSet Set of reference points.
+   * @param baseSize Maximum number of points of the first level.
+   * @param mode Search mode of the trees of each level.
+   * @param epsilon Relative approximate error (non-negative).
+   * @param distance An optional instance of the DistanceType class.
+   */
+  DynamicNeighborSearch(const MatType& referenceSet,
+                        const size_t baseSize = 64,
+                        const NeighborSearchMode mode = DUAL_TREE_MODE,
+                        const double epsilon = 0,
+                        const DistanceType distance = DistanceType());
+
+  /**
+   * Insert the given points in the reference set.  They get consecutive
+   * identifiers, starting with the returned one.
+   *
+   * @param points Points to insert.
+   * @return Identifier of the first inserted point.
+   */
+  size_t Insert(const MatType& points);
+
+  /**
+   * Remove the point with the given identifier from the reference set.
+   *
+   * @param id Identifier of the point to remove.
+   * @return false if no point has this identifier.
+   */
+  bool Remove(const size_t id);
+
+  /**
+   * Search for the k nearest neighbors of the given query points among the
+   * points of the reference set.  The output matrices have k rows and one
+   * column per query point, and the neighbors are given by their identifiers.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for (at most NumPoints()).
+   * @param neighbors Matrix to store the identifiers of the neighbors in.
+   * @param distances Matrix to store the distances in.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances);
+
+  //! Return whether a point with the given identifier is in the reference set.
+  bool Contains(const size_t id) const
+  { return locations.find(id) != locations.end(); }
+
+  //! Get the number of points in the reference set.
+  size_t NumPoints() const { return numPoints; }
+  //! Get the dimensionality of the points (0 if none were inserted).
+  size_t Dimensionality() const { return dimensionality; }
+  //! Get the maximum number of points of the first level.
+  size_t BaseSize() const { return baseSize; }
+  //! Get the number of levels.
+  size_t NumLevels() const { return levels.size(); }
+  //! Get the static search of the given level, which includes the deleted
+  //! points of the level.
+  const SearchType& Level(const size_t level) const { return levels[level]; }
+  //! Get the identifiers of the points of the given level, in their original
+  //! order in the level (SIZE_MAX for deleted points).
+  const arma::Col<size_t>& LevelIds(const size_t level) const
+  { return ids[level]; }
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Get the maximum number of points of the given level.
+  size_t Capacity(const size_t level) const { return baseSize << level; }
+
+  //! Copy the points of the given level that are not deleted, and their
+  //! identifiers, to the given matrices, starting at column begin, which is
+  //! moved past them.
+  void CollectPoints(const size_t level,
+                     MatType& points,
+                     arma::Col<size_t>& pointIds,
+                     size_t& begin) const;
+
+  //! Build the tree of the given level on the given points.
+  void BuildLevel(const size_t level,
+                  MatType points,
+                  arma::Col<size_t> pointIds);
+
+  //! Remove all the points of the given level.
+  void ClearLevel(const size_t level);
+
+  //! Search the given level for the identifiers of the k nearest neighbors of
+  //! the given queries that are not deleted (at most the number of points of
+  //! the level that are not deleted; the other neighbors are SIZE_MAX).
+  void SearchLevel(const size_t level,
+                   const MatType& querySet,
+                   const size_t k,
+                   arma::Mat<size_t>& neighbors,
+                   arma::Mat<ElemType>& distances);
+
+  //! The maximum number of points of the first level.
+  size_t baseSize;
+  //! The search mode of the trees.
+  NeighborSearchMode mode;
+  //! The relative approximate error of the searches.
+  double epsilon;
+  //! The instantiated distance metric.
+  DistanceType distance;
+  //! The dimensionality of the points.
+  size_t dimensionality;
+  //! The number of points that are not deleted.
+  size_t numPoints;
+  //! The identifier of the next inserted point.
+  size_t nextId;
+
+  //! The static search of each level.
+  std::vector<SearchType> levels;
+  //! The identifiers of the points of each level (SIZE_MAX if deleted).
+  std::vector<arma::Col<size_t>> ids;
+  //! The number of deleted points of each level.
+  std::vector<size_t> numDeleted;
+  //! The level and the index in the level of each point.
+  std::unordered_map<size_t, std::pair<size_t, size_t>> locations;
+};
+
+/**
+ * The DynamicKNN class is a dynamic k-nearest-neighbor search, with insertions
+ * and deletions of reference points, on a forest of kd-trees.
+ */
+typedef DynamicNeighborSearch<NearestNeighborSort, EuclideanDistance>
+    DynamicKNN;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "dynamic_neighbor_search_impl.hpp"
+
+#endif
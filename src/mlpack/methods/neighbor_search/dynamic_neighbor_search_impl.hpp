@@ -0,0 +1,377 @@
+/**
+ * @file methods/neighbor_search/dynamic_neighbor_search_impl.hpp
+ *
+ * Implementation of the DynamicNeighborSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_DYNAMIC_NEIGHBOR_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_DYNAMIC_NEIGHBOR_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "dynamic_neighbor_search.hpp"
+
+namespace mlpack {
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+DynamicNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+DynamicNeighborSearch(const size_t baseSize,
+                      const NeighborSearchMode mode,
+                      const double epsilon,
+                      const DistanceType distance) :
+    baseSize(baseSize),
+    mode(mode),
+    epsilon(epsilon),
+    distance(distance),
+    dimensionality(0),
+    numPoints(0),
+    nextId(0)
+{
+  if (baseSize == 0)
+  {
+    throw std::invalid_argument("DynamicNeighborSearch: the base size must be "
+        "positive");
+  }
+  if (epsilon < 0)
+    throw std::invalid_argument("epsilon must be non-negative");
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+DynamicNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+DynamicNeighborSearch(const MatType& referenceSet,
+                      const size_t baseSize,
+                      const NeighborSearchMode mode,
+                      const double epsilon,
+                      const DistanceType distance) :
+    DynamicNeighborSearch(baseSize, mode, epsilon, distance)
+{
+  Insert(referenceSet);
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+size_t DynamicNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+Insert(const MatType& points)
+{
+  if (numPoints > 0 && points.n_rows != dimensionality)
+  {
+    throw std::invalid_argument("DynamicNeighborSearch::Insert(): the points "
+        "have " + std::to_string(points.n_rows) + " dimensions, but the "
+        "reference set has " + std::to_string(dimensionality));
+  }
+
+  const size_t firstId = nextId;
+  if (points.n_cols == 0)
+    return firstId;
+
+  // Find the first level that is empty and can hold the new points and those of
+  // the non-empty levels below it, which are merged into it.
+  size_t total = points.n_cols;
+  size_t level = 0;
+  while (level < levels.size() &&
+      (!ids[level].is_empty() || total > Capacity(level)))
+  {
+    total += ids[level].n_elem - numDeleted[level];
+    ++level;
+  }
+
+  MatType merged(points.n_rows, total);
+  arma::Col<size_t> mergedIds(total);
+  merged.cols(0, points.n_cols - 1) = points;
+  mergedIds.subvec(0, points.n_cols - 1) = arma::regspace<arma::Col<size_t>>(
+      firstId, firstId + points.n_cols - 1);
+  size_t begin = points.n_cols;
+  for (size_t l = 0; l < level; ++l)
+  {
+    if (!ids[l].is_empty())
+    {
+      CollectPoints(l, merged, mergedIds, begin);
+      ClearLevel(l);
+    }
+  }
+
+  if (level == levels.size())
+  {
+    levels.push_back(SearchType(mode, epsilon, distance));
+    ids.push_back(arma::Col<size_t>());
+    numDeleted.push_back(0);
+  }
+
+  BuildLevel(level, std::move(merged), std::move(mergedIds));
+  dimensionality = points.n_rows;
+  numPoints += points.n_cols;
+  nextId += points.n_cols;
+  return firstId;
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+bool DynamicNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+Remove(const size_t id)
+{
+  typename std::unordered_map<size_t, std::pair<size_t, size_t>>::iterator it =
+      locations.find(id);
+  if (it == locations.end())
+    return false;
+
+  const size_t level = it->second.first;
+  ids[level][it->second.second] = SIZE_MAX;
+  locations.erase(it);
+  ++numDeleted[level];
+  --numPoints;
+
+  // Rebuild the tree of the level once most of its points are deleted, so that
+  // the searches don't skip too many of them.
+  if (numDeleted[level] == ids[level].n_elem)
+  {
+    ClearLevel(level);
+  }
+  else if (2 * numDeleted[level] > ids[level].n_elem)
+  {
+    const size_t livePoints = ids[level].n_elem - numDeleted[level];
+    MatType points(dimensionality, livePoints);
+    arma::Col<size_t> pointIds(livePoints);
+    size_t begin = 0;
+    CollectPoints(level, points, pointIds, begin);
+    BuildLevel(level, std::move(points), std::move(pointIds));
+  }
+
+  return true;
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void DynamicNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::Mat<ElemType>& distances)
+{
+  if (k == 0 || k > numPoints)
+  {
+    throw std::invalid_argument("DynamicNeighborSearch::Search(): k must be "
+        "between 1 and the number of reference points (" +
+        std::to_string(numPoints) + ")");
+  }
+  if (querySet.n_rows != dimensionality)
+  {
+    throw std::invalid_argument("DynamicNeighborSearch::Search(): the queries "
+        "have " + std::to_string(querySet.n_rows) + " dimensions, but the "
+        "reference set has " + std::to_string(dimensionality));
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  neighbors.fill(SIZE_MAX);
+  distances.set_size(k, querySet.n_cols);
+  distances.fill(SortPolicy::WorstDistance());
+
+  arma::Mat<size_t> levelNeighbors;
+  arma::Mat<ElemType> levelDistances;
+  for (size_t level = 0; level < levels.size(); ++level)
+  {
+    if (ids[level].is_empty())
+      continue;
+
+    SearchLevel(level, querySet, k, levelNeighbors, levelDistances);
+    SearchType::MergeNeighbors(neighbors, distances, levelNeighbors,
+        levelDistances);
+  }
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename Archive>
+void DynamicNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(baseSize));
+  ar(CEREAL_NVP(mode));
+  ar(CEREAL_NVP(epsilon));
+  ar(CEREAL_NVP(distance));
+  ar(CEREAL_NVP(dimensionality));
+  ar(CEREAL_NVP(nextId));
+  ar(CEREAL_NVP(levels));
+  ar(CEREAL_NVP(ids));
+
+  // The other members are recomputed from the identifiers of each level.
+  if (cereal::is_loading<Archive>())
+  {
+    numPoints = 0;
+    numDeleted.assign(ids.size(), 0);
+    locations.clear();
+    for (size_t level = 0; level < ids.size(); ++level)
+    {
+      for (size_t i = 0; i < ids[level].n_elem; ++i)
+      {
+        if (ids[level][i] == SIZE_MAX)
+        {
+          ++numDeleted[level];
+        }
+        else
+        {
+          locations[ids[level][i]] = std::make_pair(level, i);
+          ++numPoints;
+        }
+      }
+    }
+  }
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void DynamicNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+CollectPoints(const size_t level,
+              MatType& points,
+              arma::Col<size_t>& pointIds,
+              size_t& begin) const
+{
+  // The tree may have reordered the points of the level, whose identifiers are
+  // in the original order.
+  const MatType& referenceSet = levels[level].ReferenceSet();
+  const std::vector<size_t>& oldFromNew = levels[level].OldFromNewReferences();
+  for (size_t i = 0; i < referenceSet.n_cols; ++i)
+  {
+    const size_t id = ids[level][oldFromNew.empty() ? i : oldFromNew[i]];
+    if (id == SIZE_MAX)
+      continue;
+
+    points.col(begin) = referenceSet.col(i);
+    pointIds[begin] = id;
+    ++begin;
+  }
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void DynamicNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+BuildLevel(const size_t level,
+           MatType points,
+           arma::Col<size_t> pointIds)
+{
+  levels[level] = SearchType(std::move(points), mode, epsilon, distance);
+  ids[level] = std::move(pointIds);
+  numDeleted[level] = 0;
+  for (size_t i = 0; i < ids[level].n_elem; ++i)
+    locations[ids[level][i]] = std::make_pair(level, i);
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void DynamicNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+ClearLevel(const size_t level)
+{
+  levels[level] = SearchType(mode, epsilon, distance);
+  ids[level].reset();
+  numDeleted[level] = 0;
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void DynamicNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+SearchLevel(const size_t level,
+            const MatType& querySet,
+            const size_t k,
+            arma::Mat<size_t>& neighbors,
+            arma::Mat<ElemType>& distances)
+{
+  const size_t levelPoints = ids[level].n_elem;
+  const size_t livePoints = levelPoints - numDeleted[level];
+  const size_t wanted = std::min(k, livePoints);
+
+  neighbors.set_size(k, querySet.n_cols);
+  neighbors.fill(SIZE_MAX);
+  distances.set_size(k, querySet.n_cols);
+  distances.fill(SortPolicy::WorstDistance());
+
+  // Search for as many neighbors as should hold the wanted number of points
+  // that are not deleted, given the fraction of deleted points of the level.
+  // The queries that don't get enough of them are searched again, for twice as
+  // many neighbors, until all the points of the level are searched.
+  size_t levelK = std::min(levelPoints,
+      (wanted * levelPoints + livePoints - 1) / livePoints);
+  arma::uvec queries = arma::regspace<arma::uvec>(0, querySet.n_cols - 1);
+  arma::Mat<size_t> found;
+  arma::Mat<ElemType> foundDistances;
+  while (!queries.is_empty())
+  {
+    if (queries.n_elem == querySet.n_cols)
+      levels[level].Search(querySet, levelK, found, foundDistances);
+    else
+      levels[level].Search(MatType(querySet.cols(queries)), levelK, found,
+          foundDistances);
+
+    std::vector<arma::uword> shortQueries;
+    for (size_t j = 0; j < queries.n_elem; ++j)
+    {
+      const size_t q = queries[j];
+      size_t count = 0;
+      for (size_t r = 0; r < levelK && count < wanted; ++r)
+      {
+        const size_t id = ids[level][found(r, j)];
+        if (id == SIZE_MAX)
+          continue;
+
+        neighbors(count, q) = id;
+        distances(count, q) = foundDistances(r, j);
+        ++count;
+      }
+
+      if (count < wanted)
+        shortQueries.push_back(q);
+    }
+
+    // Once all the points of the level are searched, every query gets all the
+    // points that are not deleted.
+    queries = arma::uvec(shortQueries);
+    levelK = std::min(levelPoints, 2 * levelK);
+  }
+}
+
+} // namespace mlpack
+
+#endif
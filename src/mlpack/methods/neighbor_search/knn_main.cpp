@@ -44,7 +44,28 @@ BINDING_LONG_DESC(
     "points using kd-trees or cover trees (cover tree support is experimental "
     "and may be slow). You may specify a separate set of "
     "reference points and query points, or just a reference set which will be "
-    "used as both the reference and query set.");
+    "used as both the reference and query set."
+    "\n\n"
+    "A reference set that is too large for one machine can be split into "
+    "shards, each searched separately (for instance, on different machines) "
+    "with the same query set.  For each shard, " +
+    PRINT_PARAM_STRING("reference_offset") + " gives the index of its first "
+    "point in the full reference set, so that the output neighbors have "
+    "indices in the full set.  The results of other shards can be given with " +
+    PRINT_PARAM_STRING("input_neighbors") + " and " +
+    PRINT_PARAM_STRING("input_distances") + ", and are merged with the "
+    "results of this search; only the k best neighbors of each shard are "
+    "merged."
+    "\n\n"
+    "Sparse datasets (like TF-IDF vectors) can be searched without densifying "
+    "them, with the cosine distance (1 - x^T y / (|| x || || y ||)): " +
+    PRINT_PARAM_STRING("sparse_reference_file") + " gives a file holding the "
+    "reference set as a coordinate list, with one line 'point dimension value' "
+    "for each nonzero element, and " +
+    PRINT_PARAM_STRING("sparse_query_file") + " optionally gives the query "
+    "set in the same format.  The search is exact, and uses an inverted index "
+    "of the reference set instead of a tree, so the tree options are ignored "
+    "and no model is saved.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -81,6 +102,23 @@ PARAM_MATRIX_IN("true_distances", "Matrix of true distances to compute "
 PARAM_UMATRIX_IN("true_neighbors", "Matrix of true neighbors to compute the "
     "recall (it is printed when -v is specified).", "T");
 
+// Sparse datasets are searched with the cosine distance.
+PARAM_STRING_IN("sparse_reference_file", "File holding a sparse reference set "
+    "as a coordinate list, searched with the cosine distance.", "S", "");
+PARAM_STRING_IN("sparse_query_file", "File holding a sparse query set as a "
+    "coordinate list (used with " +
+    PRINT_PARAM_STRING("sparse_reference_file") + ").", "Q", "");
+
+// Searches of shards of the reference set can be merged.
+PARAM_INT_IN("reference_offset", "Index of the first point of the reference "
+    "set in the full reference set, if the reference set (or that of the input "
+    "model) is a shard of it; it is added to the output neighbors.", "O", 0);
+PARAM_UMATRIX_IN("input_neighbors", "Neighbors of the query points found in "
+    "other shards of the reference set, to merge with the neighbors found in "
+    "this search.", "N");
+PARAM_MATRIX_IN("input_distances", "Distances to the neighbors given with "
+    "input_neighbors.", "I");
+
 // The option exists to load or save models.
 PARAM_MODEL_IN(KNNModel, "input_model", "Pre-trained kNN model.", "m");
 PARAM_MODEL_OUT(KNNModel, "output_model", "If specified, the kNN model will be "
@@ -114,6 +152,98 @@ PARAM_STRING_IN("algorithm", "Type of neighbor search: 'naive', 'single_tree', "
     "'dual_tree', 'greedy'.", "a", "dual_tree");
 PARAM_DOUBLE_IN("epsilon", "If specified, will do approximate nearest neighbor "
     "search with given relative error.", "e", 0);
+PARAM_FLAG("auto_tune", "If set, the tree type, leaf size and algorithm are "
+    "chosen by running searches on samples of the reference and query sets "
+    "with several configurations, and keeping the one with the fewest base "
+    "cases and node scores; the choice is saved in the output model, and is "
+    "used again when that model is given as input.", "A");
+
+//! Search a sparse reference set with the cosine distance.
+void SparseCosineKNN(util::Params& params, util::Timers& timers)
+{
+  RequireOnlyOnePassed(params, { "sparse_reference_file", "reference",
+      "input_model" }, true);
+  RequireAtLeastOnePassed(params, { "k" }, true, "nothing would be searched");
+  RequireAtLeastOnePassed(params, { "neighbors", "distances" }, false,
+      "nearest neighbor search results will not be saved");
+  for (const string& name : { "query", "tree_type", "leaf_size", "tau", "rho",
+      "random_basis", "algorithm", "epsilon", "auto_tune", "output_model",
+      "true_neighbors", "true_distances" })
+  {
+    ReportIgnoredParam(params, name, "a sparse reference set is searched");
+  }
+  RequireNoneOrAllPassed(params, { "input_neighbors", "input_distances" },
+      true, "the results of other shards must have neighbors and distances");
+  RequireParamValue<int>(params, "reference_offset",
+      [](int x) { return x >= 0; }, true, "offset must be non-negative");
+
+  arma::sp_mat referenceSet;
+  data::Load(params.Get<string>("sparse_reference_file"), referenceSet, true);
+  Log::Info << "Loaded sparse reference set with " << referenceSet.n_cols
+      << " points and " << referenceSet.n_nonzero << " nonzero elements."
+      << endl;
+
+  timers.Start("tree_building");
+  SparseCosineSearch<> search(referenceSet);
+  timers.Stop("tree_building");
+
+  const size_t k = (size_t) params.Get<int>("k");
+  const bool monochromatic = !params.Has("sparse_query_file");
+  if (k == 0 || k > search.NumPoints() ||
+      (monochromatic && k == search.NumPoints()))
+  {
+    Log::Fatal << "Invalid k: " << k << "; must be greater than 0 and less "
+        << "than " << (monochromatic ? "" : "or equal to ") << "the number of "
+        << "reference points (" << search.NumPoints() << ")." << endl;
+  }
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  if (monochromatic)
+  {
+    timers.Start("computing_neighbors");
+    search.Search(k, neighbors, distances);
+    timers.Stop("computing_neighbors");
+  }
+  else
+  {
+    arma::sp_mat querySet;
+    data::Load(params.Get<string>("sparse_query_file"), querySet, true);
+    // The dimensionality of a coordinate list is given by its last nonzero
+    // dimension, so the query set may have fewer dimensions.
+    if (querySet.n_rows < search.Dimensionality())
+      querySet.resize(search.Dimensionality(), querySet.n_cols);
+    if (querySet.n_rows != search.Dimensionality())
+    {
+      Log::Fatal << "Query has invalid dimensions(" << querySet.n_rows <<
+          "); should be " << search.Dimensionality() << "!" << endl;
+    }
+
+    timers.Start("computing_neighbors");
+    search.Search(querySet, k, neighbors, distances);
+    timers.Stop("computing_neighbors");
+  }
+
+  neighbors += (size_t) params.Get<int>("reference_offset");
+  if (params.Has("input_neighbors"))
+  {
+    const arma::Mat<size_t>& inputNeighbors =
+        params.Get<arma::Mat<size_t>>("input_neighbors");
+    const arma::mat& inputDistances = params.Get<arma::mat>("input_distances");
+    if (inputNeighbors.n_cols != neighbors.n_cols ||
+        inputDistances.n_rows != inputNeighbors.n_rows ||
+        inputDistances.n_cols != inputNeighbors.n_cols)
+    {
+      Log::Fatal << "The input neighbors and distances must have the same "
+          << "size, with one column for each query point!" << endl;
+    }
+
+    KNN::MergeNeighbors(neighbors, distances, inputNeighbors, inputDistances);
+  }
+
+  params.Get<arma::Mat<size_t>>("neighbors") = std::move(neighbors);
+  params.Get<arma::mat>("distances") = std::move(distances);
+}
 
 void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 {
@@ -122,6 +252,15 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   else
     RandomSeed((size_t) std::time(NULL));
 
+  // Sparse reference sets are searched with an inverted index instead.
+  if (params.Has("sparse_reference_file"))
+  {
+    SparseCosineKNN(params, timers);
+    return;
+  }
+  ReportIgnoredParam(params, {{ "sparse_reference_file", false }},
+      "sparse_query_file");
+
   // A user cannot specify both reference data and a model.
   RequireOnlyOnePassed(params, { "reference", "input_model" }, true);
 
@@ -129,6 +268,10 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   ReportIgnoredParam(params, {{ "input_model", true }}, "random_basis");
   ReportIgnoredParam(params, {{ "input_model", true }}, "tau");
   ReportIgnoredParam(params, {{ "input_model", true }}, "rho");
+  ReportIgnoredParam(params, {{ "input_model", true }}, "auto_tune");
+  ReportIgnoredParam(params, {{ "auto_tune", true }}, "tree_type");
+  ReportIgnoredParam(params, {{ "auto_tune", true }}, "algorithm");
+  ReportIgnoredParam(params, {{ "auto_tune", true }}, "leaf_size");
   if (params.Has("input_model") && params.Has("leaf_size"))
   {
     Log::Warn << PRINT_PARAM_STRING("leaf_size") << " will only be considered"
@@ -153,6 +296,13 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   ReportIgnoredParam(params, {{ "k", false }}, "true_neighbors");
   ReportIgnoredParam(params, {{ "k", false }}, "true_distances");
   ReportIgnoredParam(params, {{ "k", false }}, "query");
+  ReportIgnoredParam(params, {{ "k", false }}, "reference_offset");
+  ReportIgnoredParam(params, {{ "k", false }}, "input_neighbors");
+  ReportIgnoredParam(params, {{ "k", false }}, "input_distances");
+  RequireNoneOrAllPassed(params, { "input_neighbors", "input_distances" },
+      true, "the results of other shards must have neighbors and distances");
+  RequireParamValue<int>(params, "reference_offset",
+      [](int x) { return x >= 0; }, true, "offset must be non-negative");
 
   // Sanity check on leaf size.
   RequireParamValue<int>(params, "leaf_size", [](int x) { return x > 0; },
@@ -253,6 +403,17 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 
     arma::mat referenceSet = std::move(params.Get<arma::mat>("reference"));
 
+    if (params.Has("auto_tune"))
+    {
+      const size_t k = params.Has("k") ? (size_t) params.Get<int>("k") : 1;
+      const arma::mat* querySet = params.Has("query") ?
+          &params.Get<arma::mat>("query") : NULL;
+      searchMode = knn->AutoTune(timers, referenceSet, querySet, k, epsilon);
+
+      Log::Info << "Auto-tuning chose " << knn->TreeName() << " with leaf size "
+          << knn->LeafSize() << "." << endl;
+    }
+
     knn->BuildModel(timers, std::move(referenceSet), searchMode, epsilon);
   }
   else
@@ -260,8 +421,9 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     // Load the model from file.
     knn = params.Get<KNNModel*>("input_model");
 
-    // Adjust search mode.
-    knn->SearchMode() = searchMode;
+    // Adjust search mode, unless it was chosen by auto-tuning.
+    if (!knn->AutoTuned() || params.Has("algorithm"))
+      knn->SearchMode() = searchMode;
     knn->Epsilon() = epsilon;
 
     // If leaf_size wasn't provided, let's consider the current value in the
@@ -336,6 +498,29 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 
     Log::Info << "Search complete." << endl;
 
+    // Give the neighbors indices in the full reference set, and merge the
+    // results of the other shards, if any.
+    neighbors += (size_t) params.Get<int>("reference_offset");
+    if (params.Has("input_neighbors"))
+    {
+      const arma::Mat<size_t>& inputNeighbors =
+          params.Get<arma::Mat<size_t>>("input_neighbors");
+      const arma::mat& inputDistances =
+          params.Get<arma::mat>("input_distances");
+      if (inputNeighbors.n_cols != neighbors.n_cols ||
+          inputDistances.n_rows != inputNeighbors.n_rows ||
+          inputDistances.n_cols != inputNeighbors.n_cols)
+      {
+        if (params.Has("reference"))
+          delete knn;
+        Log::Fatal << "The input neighbors and distances must have the same "
+            << "size, with one column for each query point!" << endl;
+      }
+
+      KNN::MergeNeighbors(neighbors, distances, inputNeighbors,
+          inputDistances);
+    }
+
     // Calculate the effective error, if desired.
     if (params.Has("true_distances"))
     {
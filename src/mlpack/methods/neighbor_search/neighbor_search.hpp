@@ -28,6 +28,8 @@ template<typename SortPolicy,
          template<typename TreeDistanceType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
+         typename MatType,
+         typename DistanceType,
          template<typename RuleType> class DualTreeTraversalType,
          template<typename RuleType> class SingleTreeTraversalType>
 class LeafSizeNSWrapper;
@@ -62,6 +64,10 @@ enum NeighborSearchMode
  *     (defaults to the tree's default traverser).
  * @tparam SingleTreeTraversalType The type of single tree traversal to use
  *     (defaults to the tree's default traverser).
+ * @tparam InstrumentationType The traversal instrumentation policy; use
+ *     TraversalInstrumentation to count the nodes visited, prunes, and base
+ *     cases of each search, and the time spent scoring and in base cases.
+ *     The default, NoTraversalInstrumentation, adds no overhead.
  */
 template<typename SortPolicy = NearestNeighborSort,
          typename DistanceType = EuclideanDistance,
@@ -76,7 +82,8 @@ template<typename SortPolicy = NearestNeighborSort,
          template<typename RuleType> class SingleTreeTraversalType =
              TreeType<DistanceType,
                       NeighborSearchStat<SortPolicy>,
-                      MatType>::template SingleTreeTraverser>
+                      MatType>::template SingleTreeTraverser,
+         typename InstrumentationType = NoTraversalInstrumentation>
 class NeighborSearch
 {
  public:
@@ -236,10 +243,9 @@ class NeighborSearch
    * number of points in the query dataset and k is the number of neighbors
    * being searched for.
    *
-   * Note that if you are calling Search() multiple times with a single query
-   * tree, you need to reset the bounds in the statistic of each query node,
-   * otherwise the result may be wrong!  You can do this by calling
-   * \c TreeType::Stat().Reset() on each node in the query tree.
+   * The bounds in the statistic of each query node are reset before the
+   * search, so a single query tree can be used for several calls to Search()
+   * (with any k) without being rebuilt.
    *
    * @param queryTree Tree built on query points.
    * @param k Number of neighbors to search for.
@@ -311,6 +317,32 @@ class NeighborSearch
   static double Recall(arma::Mat<IndexType>& foundNeighbors,
                        arma::Mat<IndexType>& realNeighbors);
 
+  /**
+   * Merge the results of a search for the same query points in another shard
+   * of the reference set into the given results, so that they hold the best
+   * neighbors among both sets of results (as many as the longer of the two
+   * lists of each query point).  This lets a reference set that is split into
+   * shards be searched one shard at a time, or on different machines, with only
+   * the k best neighbors of each shard to merge.  For equal distances, the
+   * neighbors of the given results come first.
+   *
+   * @param neighbors Neighbors found in this shard; overwritten with the merged
+   *     neighbors.
+   * @param distances Distances to the neighbors found in this shard;
+   *     overwritten with the merged distances.
+   * @param otherNeighbors Neighbors found in the other shard.
+   * @param otherDistances Distances to the neighbors found in the other shard.
+   * @param otherOffset Offset added to the indices of otherNeighbors, such as
+   *     the index of the first point of the other shard, to give indices in the
+   *     full reference set.
+   */
+  template<typename IndexType = size_t>
+  static void MergeNeighbors(arma::Mat<IndexType>& neighbors,
+                             arma::Mat<ElemType>& distances,
+                             const arma::Mat<IndexType>& otherNeighbors,
+                             const arma::Mat<ElemType>& otherDistances,
+                             const size_t otherOffset = 0);
+
   //! Return the total number of base case evaluations performed during the last
   //! search.
   size_t BaseCases() const { return baseCases; }
@@ -318,6 +350,13 @@ class NeighborSearch
   //! Return the number of node combination scores during the last search.
   size_t Scores() const { return scores; }
 
+  //! Access the traversal instrumentation of the last search.  With
+  //! TraversalInstrumentation, the counters are also printed to Log::Info
+  //! after each search.
+  const InstrumentationType& Instrumentation() const { return instrumentation; }
+  //! Modify the traversal instrumentation.
+  InstrumentationType& Instrumentation() { return instrumentation; }
+
   //! Access the search mode.
   NeighborSearchMode SearchMode() const { return searchMode; }
   //! Modify the search mode.
@@ -331,6 +370,14 @@ class NeighborSearch
   //! Access the reference dataset.
   const MatType& ReferenceSet() const { return *referenceSet; }
 
+  //! Access the mapping from the indices of the points in ReferenceSet() to
+  //! the original indices of the reference points.  This is empty if the
+  //! reference points were not reordered.
+  const std::vector<size_t>& OldFromNewReferences() const
+  {
+    return oldFromNewReferences;
+  }
+
   //! Access the reference tree.
   const Tree& ReferenceTree() const { return *referenceTree; }
   //! Modify the reference tree.
@@ -360,14 +407,50 @@ class NeighborSearch
   size_t baseCases;
   //! The total number of scores (applicable for non-naive search).
   size_t scores;
+  //! The instrumentation policy that the rules report to.
+  InstrumentationType instrumentation;
 
   //! If this is true, the reference tree bounds need to be reset on a call to
   //! Search() without a query set.
   bool treeNeedsReset;
 
+  /**
+   * Run the given single-tree traversal of the reference tree for each of the
+   * first numQueries query points of the given rules.  The queries are split
+   * between OpenMP threads, unless the tree has self-children.
+   *
+   * @param rules Rules to traverse with; the counters of all threads are added
+   *     to them.
+   * @param numQueries Number of query points.
+   */
+  template<typename TraversalType, typename RuleType>
+  void SingleTreeSearch(RuleType& rules, const size_t numQueries);
+
+  //! The number of query points in each tile of a brute-force search.
+  static constexpr size_t NaiveQueryTileSize = 256;
+  //! The number of reference points in each tile of a brute-force search.
+  static constexpr size_t NaiveReferenceTileSize = 1024;
+
+  /**
+   * Compute the base cases between every query point of the given rules and
+   * every reference point.  The query points are split into tiles between
+   * OpenMP threads; when the rules can compute blocks of distances with a
+   * matrix product (see NeighborSearchRules::BlockableBaseCases), each pair of
+   * tiles is one call to BlockBaseCase().
+   *
+   * @param rules Rules to compute the base cases with.
+   * @param querySet Set of query points.
+   */
+  template<typename RuleType>
+  void NaiveSearch(RuleType& rules, const MatType& querySet);
+
+  //! Reset the bounds in the statistic of every node of the given tree, which
+  //! are left by a previous dual-tree search.
+  static void ResetTree(Tree& tree);
+
   //! The NSModel class should have access to internal members.
-  friend class LeafSizeNSWrapper<SortPolicy, TreeType, DualTreeTraversalType,
-      SingleTreeTraversalType>;
+  friend class LeafSizeNSWrapper<SortPolicy, TreeType, MatType, DistanceType,
+      DualTreeTraversalType, SingleTreeTraversalType>;
 }; // class NeighborSearch
 
 } // namespace mlpack
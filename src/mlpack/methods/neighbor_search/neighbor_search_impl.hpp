@@ -28,9 +28,10 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename InstrumentationType>
 NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-    DualTreeTraversalType, SingleTreeTraversalType>::
+    DualTreeTraversalType, SingleTreeTraversalType, InstrumentationType>::
 NeighborSearch(MatType referenceSetIn,
                const NeighborSearchMode mode,
                const double epsilon,
@@ -58,9 +59,10 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename InstrumentationType>
 NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-    DualTreeTraversalType, SingleTreeTraversalType>::
+    DualTreeTraversalType, SingleTreeTraversalType, InstrumentationType>::
 NeighborSearch(Tree referenceTree,
                const NeighborSearchMode mode,
                const double epsilon,
@@ -86,9 +88,10 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename InstrumentationType>
 NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-    DualTreeTraversalType, SingleTreeTraversalType>::
+    DualTreeTraversalType, SingleTreeTraversalType, InstrumentationType>::
 NeighborSearch(const NeighborSearchMode mode,
                const double epsilon,
                const DistanceType distance) :
@@ -121,9 +124,10 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename InstrumentationType>
 NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-    DualTreeTraversalType, SingleTreeTraversalType>::
+    DualTreeTraversalType, SingleTreeTraversalType, InstrumentationType>::
 NeighborSearch(const NeighborSearch& other) :
     oldFromNewReferences(other.oldFromNewReferences),
     referenceTree(other.referenceTree ? new Tree(*other.referenceTree) : NULL),
@@ -134,6 +138,7 @@ NeighborSearch(const NeighborSearch& other) :
     distance(other.distance),
     baseCases(other.baseCases),
     scores(other.scores),
+    instrumentation(other.instrumentation),
     treeNeedsReset(false)
 {
   // Nothing else to do.
@@ -147,9 +152,10 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename InstrumentationType>
 NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-    DualTreeTraversalType, SingleTreeTraversalType>::
+    DualTreeTraversalType, SingleTreeTraversalType, InstrumentationType>::
 NeighborSearch(NeighborSearch&& other) :
     oldFromNewReferences(std::move(other.oldFromNewReferences)),
     referenceTree(other.referenceTree),
@@ -159,6 +165,7 @@ NeighborSearch(NeighborSearch&& other) :
     distance(std::move(other.distance)),
     baseCases(other.baseCases),
     scores(other.scores),
+    instrumentation(other.instrumentation),
     treeNeedsReset(other.treeNeedsReset)
 {
   // Clear the other model.
@@ -180,19 +187,22 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename InstrumentationType>
 NeighborSearch<SortPolicy,
                DistanceType,
                MatType,
                TreeType,
                DualTreeTraversalType,
-               SingleTreeTraversalType>&
+               SingleTreeTraversalType,
+               InstrumentationType>&
 NeighborSearch<SortPolicy,
                DistanceType,
                MatType,
                TreeType,
                DualTreeTraversalType,
-               SingleTreeTraversalType>::operator=(const NeighborSearch& other)
+               SingleTreeTraversalType,
+               InstrumentationType>::operator=(const NeighborSearch& other)
 {
   if (&other == this)
     return *this; // Nothing to do.
@@ -212,6 +222,7 @@ NeighborSearch<SortPolicy,
   distance = other.distance;
   baseCases = other.baseCases;
   scores = other.scores;
+  instrumentation = other.instrumentation;
   treeNeedsReset = false;
 }
 
@@ -223,19 +234,22 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename InstrumentationType>
 NeighborSearch<SortPolicy,
                DistanceType,
                MatType,
                TreeType,
                DualTreeTraversalType,
-               SingleTreeTraversalType>&
+               SingleTreeTraversalType,
+               InstrumentationType>&
 NeighborSearch<SortPolicy,
                DistanceType,
                MatType,
                TreeType,
                DualTreeTraversalType,
-               SingleTreeTraversalType>::operator=(NeighborSearch&& other)
+               SingleTreeTraversalType,
+               InstrumentationType>::operator=(NeighborSearch&& other)
 {
   if (&other == this)
     return *this; // Nothing to do.
@@ -254,6 +268,7 @@ NeighborSearch<SortPolicy,
   distance = other.distance;
   baseCases = other.baseCases;
   scores = other.scores;
+  instrumentation = other.instrumentation;
   treeNeedsReset = other.treeNeedsReset;
 
   // Reset the other object.  Clean memory if needed.
@@ -278,9 +293,11 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename InstrumentationType>
 NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-    DualTreeTraversalType, SingleTreeTraversalType>::~NeighborSearch()
+    DualTreeTraversalType, SingleTreeTraversalType, InstrumentationType>::
+~NeighborSearch()
 {
   if (referenceTree)
     delete referenceTree;
@@ -295,9 +312,10 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename InstrumentationType>
 void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-    DualTreeTraversalType, SingleTreeTraversalType>::
+    DualTreeTraversalType, SingleTreeTraversalType, InstrumentationType>::
 Train(MatType referenceSetIn)
 {
   // Clean up the old tree, if we built one.
@@ -332,9 +350,11 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename InstrumentationType>
 void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-DualTreeTraversalType, SingleTreeTraversalType>::Train(Tree referenceTree)
+DualTreeTraversalType, SingleTreeTraversalType, InstrumentationType>::
+Train(Tree referenceTree)
 {
   if (searchMode == NAIVE_MODE)
     throw std::invalid_argument("cannot train on given reference tree when "
@@ -365,10 +385,11 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename InstrumentationType>
 template<typename IndexType>
 void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-DualTreeTraversalType, SingleTreeTraversalType>::Search(
+DualTreeTraversalType, SingleTreeTraversalType, InstrumentationType>::Search(
     const MatType& querySet,
     const size_t k,
     arma::Mat<IndexType>& neighbors,
@@ -384,6 +405,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
   baseCases = 0;
   scores = 0;
+  instrumentation.Reset();
 
   // This will hold mappings for query points, if necessary.
   std::vector<size_t> oldFromNewQueries;
@@ -411,19 +433,19 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   neighborPtr->set_size(k, querySet.n_cols);
   distancePtr->set_size(k, querySet.n_cols);
 
-  typedef NeighborSearchRules<SortPolicy, DistanceType, Tree> RuleType;
+  typedef InstrumentedRules<NeighborSearchRules<SortPolicy, DistanceType,
+      Tree>, InstrumentationType> RuleType;
 
   switch (searchMode)
   {
     case NAIVE_MODE:
     {
       // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, distance, epsilon);
+      RuleType rules(instrumentation, *referenceSet, querySet, k, distance,
+          epsilon);
 
       // The naive brute-force traversal.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        for (size_t j = 0; j < referenceSet->n_cols; ++j)
-          rules.BaseCase(i, j);
+      NaiveSearch(rules, querySet);
 
       baseCases += querySet.n_cols * referenceSet->n_cols;
 
@@ -433,14 +455,12 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     case SINGLE_TREE_MODE:
     {
       // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, distance, epsilon);
+      RuleType rules(instrumentation, *referenceSet, querySet, k, distance,
+          epsilon);
 
-      // Create the traverser.
-      SingleTreeTraversalType<RuleType> traverser(rules);
-
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+      // Traverse for each point.
+      SingleTreeSearch<SingleTreeTraversalType<RuleType>>(rules,
+          querySet.n_cols);
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
@@ -459,7 +479,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
 
       // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, queryTree->Dataset(), k, distance, epsilon);
+      RuleType rules(instrumentation, *referenceSet, queryTree->Dataset(), k,
+          distance, epsilon);
 
       // Create the traverser.
       DualTreeTraversalType<RuleType> traverser(rules);
@@ -482,14 +503,11 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     case GREEDY_SINGLE_TREE_MODE:
     {
       // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, distance);
-
-      // Create the traverser.
-      GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
+      RuleType rules(instrumentation, *referenceSet, querySet, k, distance);
 
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+      // Traverse for each point.
+      SingleTreeSearch<GreedySingleTreeTraverser<Tree, RuleType>>(rules,
+          querySet.n_cols);
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
@@ -504,6 +522,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     }
   }
 
+  instrumentation.Report();
+
   // Map points back to original indices, if necessary.
   if (TreeTraits<Tree>::RearrangesDataset)
   {
@@ -571,10 +591,11 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename InstrumentationType>
 template<typename IndexType>
 void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-DualTreeTraversalType, SingleTreeTraversalType>::Search(
+DualTreeTraversalType, SingleTreeTraversalType, InstrumentationType>::Search(
     Tree& queryTree,
     const size_t k,
     arma::Mat<IndexType>& neighbors,
@@ -596,6 +617,10 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
   baseCases = 0;
   scores = 0;
+  instrumentation.Reset();
+
+  // The query tree may have been used for a previous search.
+  ResetTree(queryTree);
 
   // Get a reference to the query set.
   const MatType& querySet = queryTree.Dataset();
@@ -610,8 +635,10 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   distances.set_size(k, querySet.n_cols);
 
   // Create the helper object for the traversal.
-  typedef NeighborSearchRules<SortPolicy, DistanceType, Tree> RuleType;
-  RuleType rules(*referenceSet, querySet, k, distance, epsilon, sameSet);
+  typedef InstrumentedRules<NeighborSearchRules<SortPolicy, DistanceType,
+      Tree>, InstrumentationType> RuleType;
+  RuleType rules(instrumentation, *referenceSet, querySet, k, distance,
+      epsilon, sameSet);
 
   // Create the traverser.
   DualTreeTraversalType<RuleType> traverser(rules);
@@ -628,6 +655,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   Log::Info << rules.Scores() << " node combinations were scored.\n";
   Log::Info << rules.BaseCases() << " base cases were calculated.\n";
 
+  instrumentation.Report();
+
   // Do we need to map indices?
   if (!oldFromNewReferences.empty() && TreeTraits<Tree>::RearrangesDataset)
   {
@@ -651,10 +680,11 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename InstrumentationType>
 template<typename IndexType>
 void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-DualTreeTraversalType, SingleTreeTraversalType>::Search(
+DualTreeTraversalType, SingleTreeTraversalType, InstrumentationType>::Search(
     const size_t k,
     arma::Mat<IndexType>& neighbors,
     arma::Mat<ElemType>& distances)
@@ -677,6 +707,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
   baseCases = 0;
   scores = 0;
+  instrumentation.Reset();
 
   arma::Mat<IndexType>* neighborPtr = &neighbors;
   arma::Mat<ElemType>* distancePtr = &distances;
@@ -693,30 +724,26 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   distancePtr->set_size(k, referenceSet->n_cols);
 
   // Create the helper object for the traversal.
-  typedef NeighborSearchRules<SortPolicy, DistanceType, Tree> RuleType;
-  RuleType rules(*referenceSet, *referenceSet, k, distance, epsilon,
-      true /* don't return the same point as nearest neighbor */);
+  typedef InstrumentedRules<NeighborSearchRules<SortPolicy, DistanceType,
+      Tree>, InstrumentationType> RuleType;
+  RuleType rules(instrumentation, *referenceSet, *referenceSet, k, distance,
+      epsilon, true /* don't return the same point as nearest neighbor */);
 
   switch (searchMode)
   {
     case NAIVE_MODE:
     {
       // The naive brute-force solution.
-      for (size_t i = 0; i < referenceSet->n_cols; ++i)
-        for (size_t j = 0; j < referenceSet->n_cols; ++j)
-          rules.BaseCase(i, j);
+      NaiveSearch(rules, *referenceSet);
 
       baseCases += referenceSet->n_cols * referenceSet->n_cols;
       break;
     }
     case SINGLE_TREE_MODE:
     {
-      // Create the traverser.
-      SingleTreeTraversalType<RuleType> traverser(rules);
-
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < referenceSet->n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+      // Traverse for each point.
+      SingleTreeSearch<SingleTreeTraversalType<RuleType>>(rules,
+          referenceSet->n_cols);
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
@@ -732,22 +759,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       // The dual-tree monochromatic search case may require resetting the
       // bounds in the tree.
       if (treeNeedsReset)
-      {
-        std::stack<Tree*> nodes;
-        nodes.push(referenceTree);
-        while (!nodes.empty())
-        {
-          Tree* node = nodes.top();
-          nodes.pop();
-
-          // Reset bounds of this node.
-          node->Stat().Reset();
-
-          // Then add the children.
-          for (size_t i = 0; i < node->NumChildren(); ++i)
-            nodes.push(&node->Child(i));
-        }
-      }
+        ResetTree(*referenceTree);
 
       // Create the traverser.
       DualTreeTraversalType<RuleType> traverser(rules);
@@ -780,12 +792,9 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     }
     case GREEDY_SINGLE_TREE_MODE:
     {
-      // Create the traverser.
-      GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
-
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < referenceSet->n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+      // Traverse for each point.
+      SingleTreeSearch<GreedySingleTreeTraverser<Tree, RuleType>>(rules,
+          referenceSet->n_cols);
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
@@ -800,6 +809,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
   rules.GetResults(*neighborPtr, *distancePtr);
 
+  instrumentation.Report();
+
   // Do we need to map the reference indices?
   if (!oldFromNewReferences.empty() && TreeTraits<Tree>::RearrangesDataset)
   {
@@ -831,9 +842,11 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename InstrumentationType>
 double NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-DualTreeTraversalType, SingleTreeTraversalType>::EffectiveError(
+DualTreeTraversalType, SingleTreeTraversalType, InstrumentationType>::
+EffectiveError(
     arma::Mat<ElemType>& foundDistances,
     arma::Mat<ElemType>& realDistances)
 {
@@ -869,10 +882,11 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename InstrumentationType>
 template<typename IndexType>
 double NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-DualTreeTraversalType, SingleTreeTraversalType>::Recall(
+DualTreeTraversalType, SingleTreeTraversalType, InstrumentationType>::Recall(
     arma::Mat<IndexType>& foundNeighbors,
     arma::Mat<IndexType>& realNeighbors)
 {
@@ -893,6 +907,201 @@ DualTreeTraversalType, SingleTreeTraversalType>::Recall(
   return ((double) found) / realNeighbors.n_elem;
 }
 
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename InstrumentationType>
+template<typename IndexType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType, InstrumentationType>::
+MergeNeighbors(arma::Mat<IndexType>& neighbors,
+               arma::Mat<ElemType>& distances,
+               const arma::Mat<IndexType>& otherNeighbors,
+               const arma::Mat<ElemType>& otherDistances,
+               const size_t otherOffset)
+{
+  if (neighbors.n_rows != distances.n_rows ||
+      neighbors.n_cols != distances.n_cols ||
+      otherNeighbors.n_rows != otherDistances.n_rows ||
+      otherNeighbors.n_cols != otherDistances.n_cols)
+  {
+    throw std::invalid_argument("NeighborSearch::MergeNeighbors(): neighbor "
+        "and distance matrices must have the same size");
+  }
+
+  if (neighbors.n_cols != otherNeighbors.n_cols)
+  {
+    throw std::invalid_argument("NeighborSearch::MergeNeighbors(): results "
+        "must be for the same number of query points");
+  }
+
+  // Each list of neighbors is sorted, so the lists of each query point are
+  // merged with one pass over both.
+  const size_t k = std::max(neighbors.n_rows, otherNeighbors.n_rows);
+  arma::Mat<IndexType> mergedNeighbors(k, neighbors.n_cols);
+  arma::Mat<ElemType> mergedDistances(k, neighbors.n_cols);
+
+  #pragma omp parallel for schedule(static)
+  for (size_t q = 0; q < (size_t) neighbors.n_cols; ++q)
+  {
+    size_t i = 0;
+    size_t j = 0;
+    for (size_t r = 0; r < k; ++r)
+    {
+      // The other neighbor is taken only if it is strictly better.
+      if (i == neighbors.n_rows || (j < otherNeighbors.n_rows &&
+          SortPolicy::IsBetter(otherDistances(j, q), distances(i, q))))
+      {
+        mergedNeighbors(r, q) = otherNeighbors(j, q) + otherOffset;
+        mergedDistances(r, q) = otherDistances(j, q);
+        ++j;
+      }
+      else
+      {
+        mergedNeighbors(r, q) = neighbors(i, q);
+        mergedDistances(r, q) = distances(i, q);
+        ++i;
+      }
+    }
+  }
+
+  neighbors = std::move(mergedNeighbors);
+  distances = std::move(mergedDistances);
+}
+
+//! Run a single-tree traversal for each query point.
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename InstrumentationType>
+template<typename TraversalType, typename RuleType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType, InstrumentationType>::
+SingleTreeSearch(RuleType& rules, const size_t numQueries)
+{
+  // Trees with self-children cache the last distance in the statistic of each
+  // reference node during the traversal, so the queries can't run in parallel.
+  if (TreeTraits<Tree>::HasSelfChildren)
+  {
+    TraversalType traverser(rules);
+    for (size_t i = 0; i < numQueries; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    return;
+  }
+
+  #pragma omp parallel
+  {
+    // Each thread has its own copy of the rules, which holds the traversal
+    // state and the counters but shares the candidate lists; since every query
+    // point is handled by a single thread, the results need no locking.
+    RuleType threadRules(rules);
+    threadRules.Scores() = 0;
+    threadRules.BaseCases() = 0;
+    TraversalType traverser(threadRules);
+
+    #pragma omp for schedule(dynamic, 16)
+    for (size_t i = 0; i < numQueries; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    #pragma omp critical
+    {
+      rules.Scores() += threadRules.Scores();
+      rules.BaseCases() += threadRules.BaseCases();
+    }
+  }
+}
+
+//! Compute all base cases by brute force.
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename InstrumentationType>
+template<typename RuleType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType, InstrumentationType>::
+NaiveSearch(RuleType& rules, const MatType& querySet)
+{
+  // The squared norms are only needed for blocks of distances.
+  arma::Col<ElemType> queryNorms, referenceNorms;
+  if constexpr (RuleType::BlockableBaseCases)
+  {
+    queryNorms = arma::sum(arma::square(querySet), 0).t();
+    referenceNorms = arma::sum(arma::square(*referenceSet), 0).t();
+  }
+
+  const size_t numQueryTiles = (querySet.n_cols + NaiveQueryTileSize - 1) /
+      NaiveQueryTileSize;
+  const size_t numReferences = referenceSet->n_cols;
+
+  #pragma omp parallel
+  {
+    // As in SingleTreeSearch(), each thread works on its own copy of the rules,
+    // and each query point is handled by a single thread.
+    RuleType threadRules(rules);
+
+    #pragma omp for schedule(dynamic)
+    for (size_t t = 0; t < numQueryTiles; ++t)
+    {
+      const size_t queryBegin = t * NaiveQueryTileSize;
+      const size_t queryEnd = std::min(queryBegin + NaiveQueryTileSize,
+          (size_t) querySet.n_cols);
+
+      for (size_t r = 0; r < numReferences; r += NaiveReferenceTileSize)
+      {
+        threadRules.BlockBaseCase(queryBegin, queryEnd, r,
+            std::min(r + NaiveReferenceTileSize, numReferences), queryNorms,
+            referenceNorms);
+      }
+    }
+  }
+}
+
+//! Reset the bounds of every node of the given tree.
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename InstrumentationType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType, InstrumentationType>::
+ResetTree(Tree& tree)
+{
+  std::stack<Tree*> nodes;
+  nodes.push(&tree);
+  while (!nodes.empty())
+  {
+    Tree* node = nodes.top();
+    nodes.pop();
+
+    // Reset bounds of this node.
+    node->Stat().Reset();
+
+    // Then add the children.
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+      nodes.push(&node->Child(i));
+  }
+}
+
 //! Serialize the NeighborSearch model.
 template<typename SortPolicy,
          typename DistanceType,
@@ -901,10 +1110,11 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename InstrumentationType>
 template<typename Archive>
 void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-DualTreeTraversalType, SingleTreeTraversalType>::serialize(
+DualTreeTraversalType, SingleTreeTraversalType, InstrumentationType>::serialize(
     Archive& ar, const uint32_t /* version */)
 {
   // Serialize preferences for search.
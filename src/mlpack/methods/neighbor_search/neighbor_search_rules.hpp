@@ -13,8 +13,10 @@
 #ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_RULES_HPP
 #define MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_RULES_HPP
 
+#include <mlpack/core/tree/rule_traits.hpp>
 #include <mlpack/core/tree/traversal_info.hpp>
 
+#include <memory>
 #include <queue>
 
 namespace mlpack {
@@ -37,6 +39,16 @@ class NeighborSearchRules
   //! The type of element held in MatType.
   typedef typename TreeType::Mat::elem_type ElemType;
 
+  //! True if LeafBaseCase() and BlockBaseCase() compute blocks of distances
+  //! with a matrix product: for k-nearest-neighbor search with the (squared)
+  //! Euclidean distance on dense floating-point data.
+  static constexpr bool BlockableBaseCases =
+      std::is_same<SortPolicy, NearestNeighborSort>::value &&
+      (std::is_same<DistanceType, EuclideanDistance>::value ||
+       std::is_same<DistanceType, SquaredEuclideanDistance>::value) &&
+      std::is_floating_point<ElemType>::value &&
+      !arma::is_arma_sparse_type<typename TreeType::Mat>::value;
+
   /**
    * Construct the NeighborSearchRules object.  This is usually done from within
    * the NeighborSearch class at search time.
@@ -78,6 +90,48 @@ class NeighborSearchRules
    */
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
+  /**
+   * Compute the base cases between each of the given query points and every
+   * point held in the given reference leaf; this has the same effect as
+   * calling BaseCase() for each pair.  For k-nearest-neighbor search with the
+   * (squared) Euclidean distance on dense data, the whole block of squared
+   * distances is computed at once as ||q||^2 + ||r||^2 - 2 q^T r with one
+   * matrix product, and only the pairs that may improve the candidate list are
+   * then evaluated exactly.  Otherwise, this simply calls BaseCase().
+   *
+   * @param queryIndices Indices of query points.
+   * @param referenceNode Reference leaf.
+   */
+  void LeafBaseCase(const std::vector<size_t>& queryIndices,
+                    TreeType& referenceNode);
+
+  /**
+   * Compute the base cases between the contiguous range of query points
+   * [queryBegin, queryEnd) and the contiguous range of reference points
+   * [referenceBegin, referenceEnd); this has the same effect as calling
+   * BaseCase() for each pair, and is what brute-force search uses.  If
+   * BlockableBaseCases is true, the block of squared distances is computed
+   * with one matrix product from the given squared norms, the k best
+   * distances of each query point in the block are found by partial selection
+   * while its candidate list is not yet full, and only the pairs that may
+   * improve the candidate list are evaluated exactly.
+   *
+   * @param queryBegin Index of the first query point.
+   * @param queryEnd One past the index of the last query point.
+   * @param referenceBegin Index of the first reference point.
+   * @param referenceEnd One past the index of the last reference point.
+   * @param queryNorms Squared norms of all query points (only used if
+   *     BlockableBaseCases is true).
+   * @param referenceNorms Squared norms of all reference points (only used if
+   *     BlockableBaseCases is true).
+   */
+  void BlockBaseCase(const size_t queryBegin,
+                     const size_t queryEnd,
+                     const size_t referenceBegin,
+                     const size_t referenceEnd,
+                     const arma::Col<ElemType>& queryNorms,
+                     const arma::Col<ElemType>& referenceNorms);
+
   /**
    * Get the score for recursion order.  A low score indicates priority for
    * recursion, while DBL_MAX indicates that the node should not be recursed
@@ -119,6 +173,32 @@ class NeighborSearchRules
                  TreeType& referenceNode,
                  const double oldScore) const;
 
+  /**
+   * Get the score for recursion order, for a node of a FrozenTree.  A low score
+   * indicates priority for recursion, while DBL_MAX indicates that the node
+   * should not be recursed into at all (it should be pruned).
+   *
+   * @param queryIndex Index of query point.
+   * @param referenceNode Candidate node to be recursed into.
+   */
+  template<typename FrozenTreeType>
+  double Score(const size_t queryIndex,
+               const FrozenTreeNode<FrozenTreeType>& referenceNode);
+
+  /**
+   * Re-evaluate the score for recursion order, for a node of a FrozenTree.
+   * This is used when the score has already been calculated, but another
+   * recursion may have modified the bounds for pruning.
+   *
+   * @param queryIndex Index of query point.
+   * @param referenceNode Candidate node to be recursed into.
+   * @param oldScore Old score produced by Score() (or Rescore()).
+   */
+  template<typename FrozenTreeType>
+  double Rescore(const size_t queryIndex,
+                 const FrozenTreeNode<FrozenTreeType>& referenceNode,
+                 const double oldScore) const;
+
   /**
    * Get the score for recursion order.  A low score indicates priority for
    * recursionm while DBL_MAX indicates that the node should not be recursed
@@ -188,8 +268,14 @@ class NeighborSearchRules
   typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
       CandidateList;
 
-  //! Set of candidate neighbors for each point.
-  std::vector<CandidateList> candidates;
+  //! Set of candidate neighbors for each point.  This is shared between copies
+  //! of the rules, so that each task of a parallel traversal can hold its own
+  //! traversal state while writing into the same results.
+  std::shared_ptr<std::vector<CandidateList>> candidates;
+
+  //! The minimum number of pairs for which LeafBaseCase() computes a block of
+  //! distances instead of calling BaseCase() for each pair.
+  static constexpr size_t LeafBlockMinPairs = 256;
 
   //! Number of neighbors to search for.
   const size_t k;
@@ -236,6 +322,18 @@ class NeighborSearchRules
                       const double distance);
 };
 
+/**
+ * The NeighborSearchRules only write results of the query points they are
+ * given, and copies share the candidate lists, so disjoint query subtrees can
+ * be traversed in parallel.
+ */
+template<typename SortPolicy, typename DistanceType, typename TreeType>
+class RuleTraits<NeighborSearchRules<SortPolicy, DistanceType, TreeType>>
+{
+ public:
+  static const bool HasPerQueryResults = true;
+};
+
 } // namespace mlpack
 
 // Include implementation.
@@ -53,9 +53,8 @@ NeighborSearchRules<SortPolicy, DistanceType, TreeType>::NeighborSearchRules(
   std::vector<Candidate> vect(k, def);
   CandidateList pqueue(CandidateCmp(), std::move(vect));
 
-  candidates.reserve(querySet.n_cols);
-  for (size_t i = 0; i < querySet.n_cols; ++i)
-    candidates.push_back(pqueue);
+  candidates = std::make_shared<std::vector<CandidateList>>(querySet.n_cols,
+      pqueue);
 }
 
 template<typename SortPolicy, typename DistanceType, typename TreeType>
@@ -67,9 +66,10 @@ void NeighborSearchRules<SortPolicy, DistanceType, TreeType>::GetResults(
   neighbors.set_size(k, querySet.n_cols);
   distances.set_size(k, querySet.n_cols);
 
+  #pragma omp parallel for schedule(static)
   for (size_t i = 0; i < querySet.n_cols; ++i)
   {
-    CandidateList& pqueue = candidates[i];
+    CandidateList& pqueue = (*candidates)[i];
     for (size_t j = 1; j <= k; ++j)
     {
       neighbors(k - j, i) = (IndexType) pqueue.top().second;
@@ -107,6 +107,150 @@ BaseCase(const size_t queryIndex, const size_t referenceIndex)
   return dist;
 }
 
+template<typename SortPolicy, typename DistanceType, typename TreeType>
+void NeighborSearchRules<SortPolicy, DistanceType, TreeType>::LeafBaseCase(
+    const std::vector<size_t>& queryIndices,
+    TreeType& referenceNode)
+{
+  constexpr bool isEuclidean =
+      std::is_same<DistanceType, EuclideanDistance>::value;
+
+  const size_t numReferences = referenceNode.NumPoints();
+  if constexpr (BlockableBaseCases)
+  {
+    if (queryIndices.size() * numReferences >= LeafBlockMinPairs)
+    {
+      arma::Mat<ElemType> queries(querySet.n_rows, queryIndices.size());
+      for (size_t i = 0; i < queryIndices.size(); ++i)
+        queries.col(i) = querySet.col(queryIndices[i]);
+      arma::Mat<ElemType> references(referenceSet.n_rows, numReferences);
+      for (size_t j = 0; j < numReferences; ++j)
+        references.col(j) = referenceSet.col(referenceNode.Point(j));
+
+      // block(i, j) is the squared distance between query i and reference j,
+      // up to rounding error.
+      const arma::Col<ElemType> queryNorms =
+          arma::sum(arma::square(queries), 0).t();
+      const arma::Row<ElemType> referenceNorms =
+          arma::sum(arma::square(references), 0);
+      arma::Mat<ElemType> block = ElemType(-2) * queries.t() * references;
+      block.each_col() += queryNorms;
+      block.each_row() += referenceNorms;
+
+      // The rounding error of the expansion is bounded relative to the norms
+      // of the two points.  Any pair that may be at least as good as the
+      // current k'th candidate, up to that error, is evaluated exactly by
+      // BaseCase(), so the results are the same as without blocking.
+      const double relativeError = 4.0 * (querySet.n_rows + 2) *
+          std::numeric_limits<ElemType>::epsilon();
+      for (size_t i = 0; i < queryIndices.size(); ++i)
+      {
+        const size_t queryIndex = queryIndices[i];
+        for (size_t j = 0; j < numReferences; ++j)
+        {
+          const size_t referenceIndex = referenceNode.Point(j);
+          double bound = (*candidates)[queryIndex].top().first;
+          if (isEuclidean)
+            bound *= bound;
+
+          if (block(i, j) <= bound + relativeError *
+              (queryNorms[i] + referenceNorms[j]))
+            BaseCase(queryIndex, referenceIndex);
+          else if (!sameSet || queryIndex != referenceIndex)
+            ++baseCases; // The pair was evaluated, but can't be a neighbor.
+        }
+      }
+
+      return;
+    }
+  }
+
+  for (size_t i = 0; i < queryIndices.size(); ++i)
+    for (size_t j = 0; j < numReferences; ++j)
+      BaseCase(queryIndices[i], referenceNode.Point(j));
+}
+
+template<typename SortPolicy, typename DistanceType, typename TreeType>
+void NeighborSearchRules<SortPolicy, DistanceType, TreeType>::BlockBaseCase(
+    const size_t queryBegin,
+    const size_t queryEnd,
+    const size_t referenceBegin,
+    const size_t referenceEnd,
+    const arma::Col<ElemType>& queryNorms,
+    const arma::Col<ElemType>& referenceNorms)
+{
+  if (queryBegin >= queryEnd || referenceBegin >= referenceEnd)
+    return;
+
+  if constexpr (BlockableBaseCases)
+  {
+    constexpr bool isEuclidean =
+        std::is_same<DistanceType, EuclideanDistance>::value;
+    const size_t numReferences = referenceEnd - referenceBegin;
+
+    // block(j, i) is the squared distance between reference j and query i, up
+    // to rounding error; each column holds one query point.
+    arma::Mat<ElemType> block = ElemType(-2) *
+        referenceSet.cols(referenceBegin, referenceEnd - 1).t() *
+        querySet.cols(queryBegin, queryEnd - 1);
+    block.each_col() += referenceNorms.subvec(referenceBegin,
+        referenceEnd - 1);
+    block.each_row() += queryNorms.subvec(queryBegin, queryEnd - 1).t();
+
+    // See LeafBaseCase() for the rounding error of the expansion.
+    const double relativeError = 4.0 * (querySet.n_rows + 2) *
+        std::numeric_limits<ElemType>::epsilon();
+    const double maxReferenceNorm = referenceNorms.subvec(referenceBegin,
+        referenceEnd - 1).max();
+
+    std::vector<ElemType> selection;
+    for (size_t i = 0; i < block.n_cols; ++i)
+    {
+      const size_t queryIndex = queryBegin + i;
+      const double queryNorm = queryNorms[queryIndex];
+
+      double bound = (*candidates)[queryIndex].top().first;
+      if (bound == SortPolicy::WorstDistance())
+      {
+        // The candidate list is not full yet, so every pair would be evaluated
+        // exactly.  Instead, bound the k'th best distance in this block by the
+        // k'th best approximate distance (skipping the query point itself if
+        // the sets are the same), and only evaluate the pairs that may beat it.
+        const size_t rank = (sameSet && queryIndex >= referenceBegin &&
+            queryIndex < referenceEnd) ? k : k - 1;
+        if (rank < numReferences)
+        {
+          selection.assign(block.colptr(i), block.colptr(i) + numReferences);
+          std::nth_element(selection.begin(), selection.begin() + rank,
+              selection.end());
+          bound = selection[rank] + relativeError *
+              (queryNorm + maxReferenceNorm);
+        }
+      }
+      else if (isEuclidean)
+      {
+        bound *= bound;
+      }
+
+      for (size_t j = 0; j < numReferences; ++j)
+      {
+        const size_t referenceIndex = referenceBegin + j;
+        if (block(j, i) <= bound + relativeError *
+            (queryNorm + referenceNorms[referenceIndex]))
+          BaseCase(queryIndex, referenceIndex);
+        else if (!sameSet || queryIndex != referenceIndex)
+          ++baseCases; // The pair was evaluated, but can't be a neighbor.
+      }
+    }
+  }
+  else
+  {
+    for (size_t i = queryBegin; i < queryEnd; ++i)
+      for (size_t j = referenceBegin; j < referenceEnd; ++j)
+        BaseCase(i, j);
+  }
+}
+
 template<typename SortPolicy, typename DistanceType, typename TreeType>
 inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::Score(
     const size_t queryIndex,
@@ -143,7 +287,7 @@ inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::Score(
   }
 
   // Compare against the best k'th distance for this query point so far.
-  double bestDistance = candidates[queryIndex].top().first;
+  double bestDistance = (*candidates)[queryIndex].top().first;
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
   return (SortPolicy::IsBetter(dist, bestDistance)) ?
@@ -179,7 +323,45 @@ inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::Rescore(
   const double dist = SortPolicy::ConvertToDistance(oldScore);
 
   // Just check the score again against the distances.
-  double bestDistance = candidates[queryIndex].top().first;
+  double bestDistance = (*candidates)[queryIndex].top().first;
+  bestDistance = SortPolicy::Relax(bestDistance, epsilon);
+
+  return (SortPolicy::IsBetter(dist, bestDistance)) ? oldScore : DBL_MAX;
+}
+
+template<typename SortPolicy, typename DistanceType, typename TreeType>
+template<typename FrozenTreeType>
+inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::Score(
+    const size_t queryIndex,
+    const FrozenTreeNode<FrozenTreeType>& referenceNode)
+{
+  ++scores; // Count number of Score() calls.
+  const double dist = SortPolicy::BestPointToNodeDistance(
+      querySet.col(queryIndex), &referenceNode);
+
+  // Compare against the best k'th distance for this query point so far.
+  double bestDistance = (*candidates)[queryIndex].top().first;
+  bestDistance = SortPolicy::Relax(bestDistance, epsilon);
+
+  return (SortPolicy::IsBetter(dist, bestDistance)) ?
+      SortPolicy::ConvertToScore(dist) : DBL_MAX;
+}
+
+template<typename SortPolicy, typename DistanceType, typename TreeType>
+template<typename FrozenTreeType>
+inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::Rescore(
+    const size_t queryIndex,
+    const FrozenTreeNode<FrozenTreeType>& /* referenceNode */,
+    const double oldScore) const
+{
+  // If we are already pruning, still prune.
+  if (oldScore == DBL_MAX)
+    return oldScore;
+
+  const double dist = SortPolicy::ConvertToDistance(oldScore);
+
+  // Just check the score again against the distances.
+  double bestDistance = (*candidates)[queryIndex].top().first;
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
   return (SortPolicy::IsBetter(dist, bestDistance)) ? oldScore : DBL_MAX;
@@ -402,7 +584,7 @@ inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::
   // Loop over points held in the node.
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double dist = candidates[queryNode.Point(i)].top().first;
+    const double dist = (*candidates)[queryNode.Point(i)].top().first;
     if (SortPolicy::IsBetter(worstDistance, dist))
       worstDistance = dist;
     if (SortPolicy::IsBetter(dist, bestPointDistance))
@@ -497,7 +679,7 @@ InsertNeighbor(
     const size_t neighbor,
     const double dist)
 {
-  CandidateList& pqueue = candidates[queryIndex];
+  CandidateList& pqueue = (*candidates)[queryIndex];
   Candidate c = std::make_pair(dist, neighbor);
 
   if (CandidateCmp()(c, pqueue.top()))
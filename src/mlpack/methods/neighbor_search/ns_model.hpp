@@ -16,6 +16,10 @@
 #ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_NS_MODEL_HPP
 #define MLPACK_METHODS_NEIGHBOR_SEARCH_NS_MODEL_HPP
 
+#include <fstream>
+#include <sstream>
+
+#include <mlpack/core/data/mapped_file.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
 #include <mlpack/core/tree/rectangle_tree.hpp>
@@ -30,10 +34,16 @@ namespace mlpack {
  * supported by NSModel.  All NeighborSearch type wrappers inherit from this
  * class, allowing a simple interface via inheritance for all the different
  * types we want to support.
+ *
+ * @tparam MatType Type of matrix that holds the data (arma::mat or arma::fmat).
  */
+template<typename MatType = arma::mat>
 class NSWrapperBase
 {
  public:
+  //! The type of element held in the data.
+  typedef typename MatType::elem_type ElemType;
+
   //! Create the NSWrapperBase object.  The base class does not hold anything,
   //! so this constructor does not do anything.
   NSWrapperBase() { }
@@ -46,7 +56,12 @@ class NSWrapperBase
   virtual ~NSWrapperBase() { }
 
   //! Return a reference to the dataset.
-  virtual const arma::mat& Dataset() const = 0;
+  virtual const MatType& Dataset() const = 0;
+
+  //! Return the mapping from the indices of the points in Dataset() to the
+  //! original indices of the reference points.  This is empty if the points
+  //! were not reordered.
+  virtual const std::vector<size_t>& OldFromNewReferences() const = 0;
 
   //! Get the search mode.
   virtual NeighborSearchMode SearchMode() const = 0;
@@ -58,9 +73,14 @@ class NSWrapperBase
   //! Modify the approximation parameter epsilon.
   virtual double& Epsilon() = 0;
 
+  //! Get the number of base cases computed by the last search.
+  virtual size_t BaseCases() const = 0;
+  //! Get the number of node combinations scored by the last search.
+  virtual size_t Scores() const = 0;
+
   //! Train the NeighborSearch model with the given parameters.
   virtual void Train(util::Timers& timers,
-                     arma::mat&& referenceSet,
+                     MatType&& referenceSet,
                      const size_t leafSize,
                      const double tau,
                      const double rho) = 0;
@@ -68,10 +88,10 @@ class NSWrapperBase
   //! Perform bichromatic neighbor search (i.e. search with a separate query
   //! set).
   virtual void Search(util::Timers& timers,
-                      arma::mat&& querySet,
+                      MatType&& querySet,
                       const size_t k,
                       arma::Mat<size_t>& neighbors,
-                      arma::mat& distances,
+                      arma::Mat<ElemType>& distances,
                       const size_t leafSize,
                       const double rho) = 0;
 
@@ -80,32 +100,71 @@ class NSWrapperBase
   virtual void Search(util::Timers& timers,
                       const size_t k,
                       arma::Mat<size_t>& neighbors,
-                      arma::mat& distances) = 0;
+                      arma::Mat<ElemType>& distances) = 0;
+
+  //! Build a query tree on the given query set (or, if the search mode does not
+  //! use one, keep the query set), to be used by SearchQueryTree().
+  virtual void BuildQueryTree(util::Timers& timers,
+                              MatType&& querySet,
+                              const size_t leafSize,
+                              const double rho) = 0;
+
+  //! Return whether BuildQueryTree() was called (and ClearQueryTree() was not).
+  virtual bool HasQueryTree() const = 0;
+
+  //! Free the query tree built by BuildQueryTree().
+  virtual void ClearQueryTree() = 0;
+
+  //! Return the query set given to BuildQueryTree(), in its original order.
+  virtual MatType QuerySet() const = 0;
+
+  //! Perform bichromatic neighbor search with the query tree built by
+  //! BuildQueryTree().  The results are in the original order of the queries.
+  virtual void SearchQueryTree(util::Timers& timers,
+                               const size_t k,
+                               arma::Mat<size_t>& neighbors,
+                               arma::Mat<ElemType>& distances) = 0;
 };
 
 /**
- * NSWrapper is a wrapper class for most NeighborSearch types.
+ * NSWrapper is a wrapper class for most NeighborSearch types.  The distance is
+ * the Euclidean distance, unless another DistanceType (such as a FixedLMetric
+ * for low-dimensional data) is given.
  */
 template<typename SortPolicy,
          template<typename TreeDistanceType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
+         typename MatType = arma::mat,
+         typename DistanceType = EuclideanDistance,
          template<typename RuleType> class DualTreeTraversalType =
-             TreeType<EuclideanDistance,
+             TreeType<DistanceType,
                       NeighborSearchStat<SortPolicy>,
-                      arma::mat>::template DualTreeTraverser,
+                      MatType>::template DualTreeTraverser,
          template<typename RuleType> class SingleTreeTraversalType =
-             TreeType<EuclideanDistance,
+             TreeType<DistanceType,
                       NeighborSearchStat<SortPolicy>,
-                      arma::mat>::template SingleTreeTraverser>
-class NSWrapper : public NSWrapperBase
+                      MatType>::template SingleTreeTraverser>
+class NSWrapper : public NSWrapperBase<MatType>
 {
  public:
+  //! The type of element held in the data.
+  typedef typename MatType::elem_type ElemType;
+
   //! Construct the NSWrapper object, initializing the internally-held
   //! NeighborSearch object.
   NSWrapper(const NeighborSearchMode searchMode,
             const double epsilon) :
-      ns(searchMode, epsilon)
+      ns(searchMode, epsilon),
+      hasQueries(false)
+  {
+    // Nothing else to do.
+  }
+
+  //! Copy the NSWrapper object.  The query tree is not copied.
+  NSWrapper(const NSWrapper& other) :
+      ns(other.ns),
+      hasQueries(false)
   {
     // Nothing else to do.
   }
@@ -118,7 +177,14 @@ class NSWrapper : public NSWrapperBase
   virtual NSWrapper* Clone() const { return new NSWrapper(*this); }
 
   //! Get a reference to the reference set.
-  const arma::mat& Dataset() const { return ns.ReferenceSet(); }
+  const MatType& Dataset() const { return ns.ReferenceSet(); }
+
+  //! Get the mapping from the indices of the points in Dataset() to the
+  //! original indices of the reference points.
+  const std::vector<size_t>& OldFromNewReferences() const
+  {
+    return ns.OldFromNewReferences();
+  }
 
   //! Get the search mode.
   NeighborSearchMode SearchMode() const { return ns.SearchMode(); }
@@ -130,10 +196,15 @@ class NSWrapper : public NSWrapperBase
   //! Modify epsilon, the approximation parameter.
   double& Epsilon() { return ns.Epsilon(); }
 
+  //! Get the number of base cases computed by the last search.
+  size_t BaseCases() const { return ns.BaseCases(); }
+  //! Get the number of node combinations scored by the last search.
+  size_t Scores() const { return ns.Scores(); }
+
   //! Train the model with the given options.  For NSWrapper, we ignore the
   //! extra parameters.
   virtual void Train(util::Timers& timers,
-                     arma::mat&& referenceSet,
+                     MatType&& referenceSet,
                      const size_t /* leafSize */,
                      const double /* tau */,
                      const double /* rho */);
@@ -141,10 +212,10 @@ class NSWrapper : public NSWrapperBase
   //! Perform bichromatic neighbor search (i.e. search with a separate query
   //! set).  For NSWrapper, we ignore the extra parameters.
   virtual void Search(util::Timers& timers,
-                      arma::mat&& querySet,
+                      MatType&& querySet,
                       const size_t k,
                       arma::Mat<size_t>& neighbors,
-                      arma::mat& distances,
+                      arma::Mat<ElemType>& distances,
                       const size_t /* leafSize */,
                       const double /* rho */);
 
@@ -153,9 +224,32 @@ class NSWrapper : public NSWrapperBase
   virtual void Search(util::Timers& timers,
                       const size_t k,
                       arma::Mat<size_t>& neighbors,
-                      arma::mat& distances);
+                      arma::Mat<ElemType>& distances);
 
-  //! Serialize the NeighborSearch model.
+  //! Build a query tree on the given query set (with NewQueryTree()), or keep
+  //! the query set if the search mode is not dual-tree.
+  virtual void BuildQueryTree(util::Timers& timers,
+                              MatType&& querySet,
+                              const size_t leafSize,
+                              const double rho);
+
+  //! Return whether a query tree was built.
+  virtual bool HasQueryTree() const { return hasQueries; }
+
+  //! Free the query tree.
+  virtual void ClearQueryTree();
+
+  //! Return the query set of the query tree, in its original order.
+  virtual MatType QuerySet() const;
+
+  //! Perform bichromatic neighbor search with the query tree.  The bounds of
+  //! the query tree are reset by the search, so it does not need rebuilding.
+  virtual void SearchQueryTree(util::Timers& timers,
+                               const size_t k,
+                               arma::Mat<size_t>& neighbors,
+                               arma::Mat<ElemType>& distances);
+
+  //! Serialize the NeighborSearch model.  The query tree is not serialized.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
   {
@@ -165,14 +259,35 @@ class NSWrapper : public NSWrapperBase
  protected:
   // Convenience typedef for the neighbor search type held by this class.
   typedef NeighborSearch<SortPolicy,
-                         EuclideanDistance,
-                         arma::mat,
+                         DistanceType,
+                         MatType,
                          TreeType,
                          DualTreeTraversalType,
                          SingleTreeTraversalType> NSType;
 
   //! The instantiated NeighborSearch object that we are wrapping.
   NSType ns;
+
+  //! Build a query tree for dual-tree search on the given query set, as
+  //! Search() does; the mapping of the query points is stored in
+  //! oldFromNewQueries if the tree reorders them.
+  virtual typename NSType::Tree* NewQueryTree(
+      MatType&& querySet,
+      std::vector<size_t>& /* oldFromNewQueries */,
+      const size_t /* leafSize */,
+      const double /* rho */)
+  {
+    return new typename NSType::Tree(std::move(querySet));
+  }
+
+  //! The query tree built by BuildQueryTree(), in dual-tree mode.
+  std::unique_ptr<typename NSType::Tree> queryTree;
+  //! Permutations of the query points when the query tree was built.
+  std::vector<size_t> oldFromNewQueries;
+  //! The query set given to BuildQueryTree(), in the other modes.
+  MatType queryPoints;
+  //! Whether BuildQueryTree() was called.
+  bool hasQueries;
 };
 
 /**
@@ -184,27 +299,36 @@ template<typename SortPolicy,
          template<typename TreeDistanceType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
+         typename MatType = arma::mat,
+         typename DistanceType = EuclideanDistance,
          template<typename RuleType> class DualTreeTraversalType =
-             TreeType<EuclideanDistance,
+             TreeType<DistanceType,
                       NeighborSearchStat<SortPolicy>,
-                      arma::mat>::template DualTreeTraverser,
+                      MatType>::template DualTreeTraverser,
          template<typename RuleType> class SingleTreeTraversalType =
-             TreeType<EuclideanDistance,
+             TreeType<DistanceType,
                       NeighborSearchStat<SortPolicy>,
-                      arma::mat>::template SingleTreeTraverser>
+                      MatType>::template SingleTreeTraverser>
 class LeafSizeNSWrapper :
     public NSWrapper<SortPolicy,
                      TreeType,
+                     MatType,
+                     DistanceType,
                      DualTreeTraversalType,
                      SingleTreeTraversalType>
 {
  public:
+  //! The type of element held in the data.
+  typedef typename MatType::elem_type ElemType;
+
   //! Construct the LeafSizeNSWrapper by delegating to the NSWrapper
   //! constructor.
   LeafSizeNSWrapper(const NeighborSearchMode searchMode,
                     const double epsilon) :
       NSWrapper<SortPolicy,
                 TreeType,
+                MatType,
+                DistanceType,
                 DualTreeTraversalType,
                 SingleTreeTraversalType>(searchMode, epsilon)
   {
@@ -223,7 +347,7 @@ class LeafSizeNSWrapper :
   //! Train a model with the given parameters.  This overload uses leafSize but
   //! ignores the other parameters.
   virtual void Train(util::Timers& timers,
-                     arma::mat&& referenceSet,
+                     MatType&& referenceSet,
                      const size_t leafSize,
                      const double /* tau */,
                      const double /* rho */);
@@ -231,10 +355,10 @@ class LeafSizeNSWrapper :
   //! Perform bichromatic search (e.g. search with a separate query set).  This
   //! overload uses the leaf size, but ignores the other parameters.
   virtual void Search(util::Timers& timers,
-                      arma::mat&& querySet,
+                      MatType&& querySet,
                       const size_t k,
                       arma::Mat<size_t>& neighbors,
-                      arma::mat& distances,
+                      arma::Mat<ElemType>& distances,
                       const size_t leafSize,
                       const double /* rho */);
 
@@ -248,39 +372,59 @@ class LeafSizeNSWrapper :
  protected:
   using NSWrapper<SortPolicy,
                   TreeType,
+                  MatType,
+                  DistanceType,
                   DualTreeTraversalType,
                   SingleTreeTraversalType>::ns;
+
+  //! Build a query tree with the given leaf size, as Search() does.
+  virtual typename decltype(ns)::Tree* NewQueryTree(
+      MatType&& querySet,
+      std::vector<size_t>& oldFromNewQueries,
+      const size_t leafSize,
+      const double /* rho */)
+  {
+    return new typename decltype(ns)::Tree(std::move(querySet),
+        oldFromNewQueries, leafSize);
+  }
 };
 
 /**
  * The SpillNSWrapper class wraps the NeighborSearch class when the spill tree
  * is used.
  */
-template<typename SortPolicy>
+template<typename SortPolicy, typename MatType = arma::mat>
 class SpillNSWrapper :
     public NSWrapper<
         SortPolicy,
         SPTree,
+        MatType,
+        EuclideanDistance,
         SPTree<EuclideanDistance,
                NeighborSearchStat<SortPolicy>,
-               arma::mat>::template DefeatistDualTreeTraverser,
+               MatType>::template DefeatistDualTreeTraverser,
         SPTree<EuclideanDistance,
                NeighborSearchStat<SortPolicy>,
-               arma::mat>::template DefeatistSingleTreeTraverser>
+               MatType>::template DefeatistSingleTreeTraverser>
 {
  public:
+  //! The type of element held in the data.
+  typedef typename MatType::elem_type ElemType;
+
   //! Construct the SpillNSWrapper.
   SpillNSWrapper(const NeighborSearchMode searchMode,
                  const double epsilon) :
       NSWrapper<
           SortPolicy,
           SPTree,
+          MatType,
+          EuclideanDistance,
           SPTree<EuclideanDistance,
                  NeighborSearchStat<SortPolicy>,
-                 arma::mat>::template DefeatistDualTreeTraverser,
+                 MatType>::template DefeatistDualTreeTraverser,
           SPTree<EuclideanDistance,
                  NeighborSearchStat<SortPolicy>,
-                 arma::mat>::template DefeatistSingleTreeTraverser>(
+                 MatType>::template DefeatistSingleTreeTraverser>(
           searchMode, epsilon)
   {
     // Nothing to do.
@@ -294,7 +438,7 @@ class SpillNSWrapper :
 
   //! Train the model using the given parameters.
   virtual void Train(util::Timers& timers,
-                     arma::mat&& referenceSet,
+                     MatType&& referenceSet,
                      const size_t leafSize,
                      const double tau,
                      const double rho);
@@ -302,10 +446,10 @@ class SpillNSWrapper :
   //! Perform bichromatic search (i.e. search with a different query set) using
   //! the given parameters.
   virtual void Search(util::Timers& timers,
-                      arma::mat&& querySet,
+                      MatType&& querySet,
                       const size_t k,
                       arma::Mat<size_t>& neighbors,
-                      arma::mat& distances,
+                      arma::Mat<ElemType>& distances,
                       const size_t leafSize,
                       const double rho);
 
@@ -320,12 +464,25 @@ class SpillNSWrapper :
   using NSWrapper<
       SortPolicy,
       SPTree,
+      MatType,
+      EuclideanDistance,
       SPTree<EuclideanDistance,
              NeighborSearchStat<SortPolicy>,
-             arma::mat>::template DefeatistDualTreeTraverser,
+             MatType>::template DefeatistDualTreeTraverser,
       SPTree<EuclideanDistance,
              NeighborSearchStat<SortPolicy>,
-             arma::mat>::template DefeatistSingleTreeTraverser>::ns;
+             MatType>::template DefeatistSingleTreeTraverser>::ns;
+
+  //! Build a query tree without overlapping (tau = 0), as Search() does.
+  virtual typename decltype(ns)::Tree* NewQueryTree(
+      MatType&& querySet,
+      std::vector<size_t>& /* oldFromNewQueries */,
+      const size_t leafSize,
+      const double rho)
+  {
+    return new typename decltype(ns)::Tree(std::move(querySet), 0 /* tau */,
+        leafSize, rho);
+  }
 };
 
 /**
@@ -336,12 +493,32 @@ class SpillNSWrapper :
  * flexibility as the NeighborSearch class.  So if you are using it outside of
  * mlpack_knn and mlpack_kfn, be aware that it is limited!
  *
+ * The data may be held in single precision (MatType = arma::fmat), which
+ * halves the memory used by the reference set and the trees.  The distances
+ * returned by Search() are always double-precision; if the rerank option of
+ * Search() is given, they are recomputed in double precision from the data and
+ * each list of neighbors is sorted again.  For element types other than
+ * double, only the trees based on BinarySpaceTree (KD_TREE, BALL_TREE,
+ * VP_TREE, RP_TREE, MAX_RP_TREE and UB_TREE) are available; the other tree
+ * types throw a std::invalid_argument.
+ *
+ * When a kd-tree is built on 2-, 3- or 4-dimensional data for a tree-based
+ * search, the Euclidean distance is computed with FixedLMetric, whose loop
+ * over the dimensions has a compile-time trip count; FixedDimension()
+ * returns the dimensionality that was chosen (or 0).  Naive search keeps the
+ * Euclidean distance, since it computes blocks of distances with matrix
+ * products.
+ *
  * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam MatType Type of matrix that holds the data (arma::mat or arma::fmat).
  */
-template<typename SortPolicy>
+template<typename SortPolicy, typename MatType = arma::mat>
 class NSModel
 {
  public:
+  //! The type of element held in the data.
+  typedef typename MatType::elem_type ElemType;
+
   //! Enum type to identify each accepted tree type.
   enum TreeTypes
   {
@@ -369,17 +546,57 @@ class NSModel
   //! If true, random projections are used.
   bool randomBasis;
   //! This is the random projection matrix; only used if randomBasis is true.
-  arma::mat q;
+  MatType q;
 
   size_t leafSize;
   double tau;
   double rho;
 
+  //! If true, the tree type, leaf size and search mode were chosen by
+  //! AutoTune().
+  bool autoTuned;
+
+  //! If nonzero, the kd-tree uses FixedLMetric for data of this
+  //! dimensionality; this is set by BuildModel().
+  size_t fixedDimension;
+
+  //! The wrapper type of a kd-tree that uses FixedLMetric for Dim dimensions.
+  template<size_t Dim>
+  using FixedKDWrapper = LeafSizeNSWrapper<SortPolicy, KDTree, MatType,
+      FixedLMetric<2, Dim>>;
+
   /**
    * nSearch holds an instance of the NeighborSearch class for the current
    * treeType. It is initialized every time BuildModel is executed.
    */
-  NSWrapperBase* nSearch;
+  NSWrapperBase<MatType>* nSearch;
+
+  /**
+   * If the model was loaded with LoadMapped(), this holds the mapping of the
+   * file that the reference set points into.  It must outlive nSearch.
+   */
+  std::shared_ptr<data::MappedFile> mappedFile;
+
+  //! The header at the start of files written by SaveMapped().
+  struct MappedHeader
+  {
+    //! Identifies the file type; always "MLPKNSMF".
+    char magic[8];
+    //! Version of the file layout.
+    uint64_t version;
+    //! Size of a single element of the reference set, in bytes.
+    uint64_t elemSize;
+    //! Number of rows of the reference set.
+    uint64_t nRows;
+    //! Number of columns of the reference set.
+    uint64_t nCols;
+    //! Offset of the reference set in the file; this is page-aligned.
+    uint64_t dataOffset;
+    //! Offset of the serialized model (without reference set) in the file.
+    uint64_t modelOffset;
+    //! Size of the serialized model, in bytes.
+    uint64_t modelSize;
+  };
 
  public:
   /**
@@ -425,10 +642,40 @@ class NSModel
 
   //! Serialize the neighbor search model.
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */);
+  void serialize(Archive& ar, const uint32_t version);
+
+  /**
+   * Save the model to the given file in a layout that LoadMapped() can use
+   * without copying the reference set: the (already permuted) reference set is
+   * stored as raw, page-aligned column-major data, followed by the binary
+   * serialization of the rest of the model (the tree structure, the bounds,
+   * the statistics and the mappings).  The file is only valid on machines with
+   * the same endianness and word size.  The model must have been trained.
+   *
+   * @param filename Name of the file to save to.
+   */
+  void SaveMapped(const std::string& filename);
+
+  /**
+   * Load a model that was saved with SaveMapped().  The tree structure is
+   * deserialized as usual, but the reference set is not read: instead, the
+   * file is memory-mapped and the reference set points directly at the mapped
+   * data.  This makes loading a large model nearly instantaneous, and several
+   * processes that load the same file share the same physical pages.  The
+   * mapping is released when the model is retrained, reloaded, or destroyed.
+   *
+   * A std::runtime_error is thrown if the file is not a valid mapped model or
+   * if memory mapping is not supported on this platform.
+   *
+   * @param filename Name of the file to load from.
+   */
+  void LoadMapped(const std::string& filename);
+
+  //! Return whether the reference set is memory-mapped from a file.
+  bool IsMapped() const { return mappedFile != nullptr; }
 
   //! Expose the dataset.
-  const arma::mat& Dataset() const;
+  const MatType& Dataset() const;
 
   //! Expose SearchMode.
   NeighborSearchMode SearchMode() const;
@@ -458,35 +705,135 @@ class NSModel
   bool RandomBasis() const { return randomBasis; }
   bool& RandomBasis() { return randomBasis; }
 
+  //! Get whether the tree type, leaf size and search mode were chosen by
+  //! AutoTune().
+  bool AutoTuned() const { return autoTuned; }
+  //! Modify whether the configuration was chosen by AutoTune().
+  bool& AutoTuned() { return autoTuned; }
+
+  //! Get the dimensionality that the kd-tree's FixedLMetric is specialized
+  //! for, or 0 if the Euclidean distance is used.
+  size_t FixedDimension() const { return fixedDimension; }
+
+  //! Get the number of base cases computed by the last search.
+  size_t BaseCases() const;
+  //! Get the number of node combinations scored by the last search.
+  size_t Scores() const;
+
+  /**
+   * Choose the tree type, leaf size and search mode for the given data.  A
+   * random sample of at most sampleSize points is taken from the reference set
+   * (and from the query set, if given), and a search for k neighbors on the
+   * samples is run with each candidate configuration: kd-trees, ball trees and
+   * VP trees with leaf sizes 5, 10, 20, 40 and 80, cover trees (for double
+   * precision data), each in single-tree and dual-tree mode, and naive
+   * search.  The configuration with the fewest base cases and node scores
+   * (the traversal counters) is kept in TreeType() and LeafSize(), and
+   * AutoTuned() is set, so that a saved model keeps the choice.  Call
+   * BuildModel() with the returned search mode afterwards.
+   *
+   * @param timers Timers; the whole tuning is timed as "auto_tuning".
+   * @param referenceSet Reference set that the model will be built on.
+   * @param querySet Query set that will be searched, or NULL if the reference
+   *     set is the query set.
+   * @param k Number of neighbors that will be searched for.
+   * @param epsilon Approximation parameter of the searches.
+   * @param sampleSize Maximum number of points of each sample.
+   * @return The search mode of the chosen configuration.
+   */
+  NeighborSearchMode AutoTune(util::Timers& timers,
+                              const MatType& referenceSet,
+                              const MatType* querySet,
+                              const size_t k,
+                              const double epsilon = 0,
+                              const size_t sampleSize = 1000);
+
   //! Initialize the model type.  (This does not perform any training.)
   void InitializeModel(const NeighborSearchMode searchMode,
                        const double epsilon);
 
   //! Build the reference tree.
   void BuildModel(util::Timers& timers,
-                  arma::mat&& referenceSet,
+                  MatType&& referenceSet,
                   const NeighborSearchMode searchMode,
                   const double epsilon = 0);
 
-  //! Perform neighbor search.  The query set will be reordered.
+  /**
+   * Perform neighbor search.  The query set will be reordered.  If rerank is
+   * true, the distances to the k neighbors that were found are recomputed in
+   * double precision and the neighbors of each point are sorted again by those
+   * distances; this is useful when MatType holds single-precision data and an
+   * exact ordering is needed.
+   */
   void Search(util::Timers& timers,
-              arma::mat&& querySet,
+              MatType&& querySet,
               const size_t k,
               arma::Mat<size_t>& neighbors,
-              arma::mat& distances);
+              arma::mat& distances,
+              const bool rerank = false);
 
-  //! Perform monochromatic neighbor search.
+  //! Perform monochromatic neighbor search.  If rerank is true, the distances
+  //! are recomputed in double precision, as in the other overload.
   void Search(util::Timers& timers,
               const size_t k,
               arma::Mat<size_t>& neighbors,
-              arma::mat& distances);
+              arma::mat& distances,
+              const bool rerank = false);
+
+  /**
+   * Build a query tree on the given query set and keep it, so that several
+   * searches with the same query set (for instance with different k) can be
+   * done with SearchQueryTree() without rebuilding the tree.  The tree is kept
+   * until ClearQueryTree(), or the next call to BuildQueryTree() or
+   * BuildModel(); it is not copied or serialized with the model.
+   */
+  void BuildQueryTree(util::Timers& timers, MatType&& querySet);
+
+  //! Return whether a query tree was built with BuildQueryTree().
+  bool HasQueryTree() const;
+
+  //! Free the query tree built with BuildQueryTree().
+  void ClearQueryTree();
+
+  /**
+   * Perform neighbor search with the query tree built by BuildQueryTree().
+   * The results are the same as those of Search() with the query set; rerank
+   * works in the same way.  Throws std::logic_error if no query tree was
+   * built.
+   */
+  void SearchQueryTree(util::Timers& timers,
+                       const size_t k,
+                       arma::Mat<size_t>& neighbors,
+                       arma::mat& distances,
+                       const bool rerank = false);
 
   //! Return a string representation of the current tree type.
   std::string TreeName() const;
+
+ private:
+  /**
+   * Recompute the distances between each query point and its neighbors in
+   * double precision, and sort the neighbors of each query point again.  If
+   * querySet is NULL, the reference set is the query set.
+   */
+  void Rerank(const MatType* querySet,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances) const;
+
+  //! Serialize nSearch, which must be of type WrapperType.
+  template<typename WrapperType, typename Archive>
+  void SerializeSearch(Archive& ar)
+  {
+    WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
+    ar(CEREAL_NVP(typedSearch));
+  }
 };
 
 } // namespace mlpack
 
+CEREAL_TEMPLATE_CLASS_VERSION((typename SortPolicy, typename MatType),
+    (mlpack::NSModel<SortPolicy, MatType>), (2));
+
 // Include implementation.
 #include "ns_model_impl.hpp"
 
@@ -26,12 +26,15 @@ template<typename SortPolicy,
          template<typename TreeDistanceType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
+         typename MatType,
+         typename DistanceType,
          template<typename RuleType> class DualTreeTraversalType,
          template<typename RuleType> class SingleTreeTraversalType>
 void NSWrapper<
-    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
+    SortPolicy, TreeType, MatType, DistanceType, DualTreeTraversalType,
+    SingleTreeTraversalType
 >::Train(util::Timers& timers,
-         arma::mat&& referenceSet,
+         MatType&& referenceSet,
          const size_t /* leafSize */,
          const double /* tau */,
          const double /* rho */)
@@ -51,15 +54,18 @@ template<typename SortPolicy,
          template<typename TreeDistanceType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
+         typename MatType,
+         typename DistanceType,
          template<typename RuleType> class DualTreeTraversalType,
          template<typename RuleType> class SingleTreeTraversalType>
 void NSWrapper<
-    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
+    SortPolicy, TreeType, MatType, DistanceType, DualTreeTraversalType,
+    SingleTreeTraversalType
 >::Search(util::Timers& timers,
-          arma::mat&& querySet,
+          MatType&& querySet,
           const size_t k,
           arma::Mat<size_t>& neighbors,
-          arma::mat& distances,
+          arma::Mat<ElemType>& distances,
           const size_t /* leafSize */,
           const double /* rho */)
 {
@@ -88,32 +94,180 @@ template<typename SortPolicy,
          template<typename TreeDistanceType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
+         typename MatType,
+         typename DistanceType,
          template<typename RuleType> class DualTreeTraversalType,
          template<typename RuleType> class SingleTreeTraversalType>
 void NSWrapper<
-    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
+    SortPolicy, TreeType, MatType, DistanceType, DualTreeTraversalType,
+    SingleTreeTraversalType
 >::Search(util::Timers& timers,
           const size_t k,
           arma::Mat<size_t>& neighbors,
-          arma::mat& distances)
+          arma::Mat<ElemType>& distances)
 {
   timers.Start("computing_neighbors");
   ns.Search(k, neighbors, distances);
   timers.Stop("computing_neighbors");
 }
 
+//! Build a query tree on the given query set, or keep the query set if the
+//! search mode is not dual-tree.
+template<typename SortPolicy,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         typename MatType,
+         typename DistanceType,
+         template<typename RuleType> class DualTreeTraversalType,
+         template<typename RuleType> class SingleTreeTraversalType>
+void NSWrapper<
+    SortPolicy, TreeType, MatType, DistanceType, DualTreeTraversalType,
+    SingleTreeTraversalType
+>::BuildQueryTree(util::Timers& timers,
+                  MatType&& querySet,
+                  const size_t leafSize,
+                  const double rho)
+{
+  ClearQueryTree();
+
+  if (ns.SearchMode() == DUAL_TREE_MODE)
+  {
+    timers.Start("tree_building");
+    queryTree.reset(NewQueryTree(std::move(querySet), oldFromNewQueries,
+        leafSize, rho));
+    timers.Stop("tree_building");
+  }
+  else
+  {
+    queryPoints = std::move(querySet);
+  }
+
+  hasQueries = true;
+}
+
+//! Free the query tree.
+template<typename SortPolicy,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         typename MatType,
+         typename DistanceType,
+         template<typename RuleType> class DualTreeTraversalType,
+         template<typename RuleType> class SingleTreeTraversalType>
+void NSWrapper<
+    SortPolicy, TreeType, MatType, DistanceType, DualTreeTraversalType,
+    SingleTreeTraversalType
+>::ClearQueryTree()
+{
+  queryTree.reset();
+  oldFromNewQueries.clear();
+  queryPoints.reset();
+  hasQueries = false;
+}
+
+//! Return the query set of the query tree, in its original order.
+template<typename SortPolicy,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         typename MatType,
+         typename DistanceType,
+         template<typename RuleType> class DualTreeTraversalType,
+         template<typename RuleType> class SingleTreeTraversalType>
+MatType NSWrapper<
+    SortPolicy, TreeType, MatType, DistanceType, DualTreeTraversalType,
+    SingleTreeTraversalType
+>::QuerySet() const
+{
+  if (!queryTree)
+    return queryPoints;
+
+  const MatType& treeQueries = queryTree->Dataset();
+  if (oldFromNewQueries.empty())
+    return treeQueries;
+
+  MatType querySet(treeQueries.n_rows, treeQueries.n_cols);
+  for (size_t i = 0; i < treeQueries.n_cols; ++i)
+    querySet.col(oldFromNewQueries[i]) = treeQueries.col(i);
+
+  return querySet;
+}
+
+//! Perform bichromatic neighbor search with the query tree.
+template<typename SortPolicy,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         typename MatType,
+         typename DistanceType,
+         template<typename RuleType> class DualTreeTraversalType,
+         template<typename RuleType> class SingleTreeTraversalType>
+void NSWrapper<
+    SortPolicy, TreeType, MatType, DistanceType, DualTreeTraversalType,
+    SingleTreeTraversalType
+>::SearchQueryTree(util::Timers& timers,
+                   const size_t k,
+                   arma::Mat<size_t>& neighbors,
+                   arma::Mat<ElemType>& distances)
+{
+  if (!hasQueries)
+  {
+    throw std::logic_error("NSModel::SearchQueryTree(): no query tree was "
+        "built; call BuildQueryTree() first!");
+  }
+
+  if (!queryTree)
+  {
+    timers.Start("computing_neighbors");
+    ns.Search(queryPoints, k, neighbors, distances);
+    timers.Stop("computing_neighbors");
+    return;
+  }
+
+  // The search mode may have changed since the tree was built; then the points
+  // of the tree are searched directly.
+  arma::Mat<size_t> neighborsOut;
+  arma::Mat<ElemType> distancesOut;
+  timers.Start("computing_neighbors");
+  if (ns.SearchMode() == DUAL_TREE_MODE)
+    ns.Search(*queryTree, k, neighborsOut, distancesOut);
+  else
+    ns.Search(queryTree->Dataset(), k, neighborsOut, distancesOut);
+  timers.Stop("computing_neighbors");
+
+  if (oldFromNewQueries.empty())
+  {
+    neighbors = std::move(neighborsOut);
+    distances = std::move(distancesOut);
+    return;
+  }
+
+  // Unmap the query points.
+  distances.set_size(distancesOut.n_rows, distancesOut.n_cols);
+  neighbors.set_size(neighborsOut.n_rows, neighborsOut.n_cols);
+  for (size_t i = 0; i < neighborsOut.n_cols; ++i)
+  {
+    neighbors.col(oldFromNewQueries[i]) = neighborsOut.col(i);
+    distances.col(oldFromNewQueries[i]) = distancesOut.col(i);
+  }
+}
+
 //! Train a model with the given parameters.  This overload uses leafSize but
 //! ignores the other parameters.
 template<typename SortPolicy,
          template<typename TreeDistanceType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
+         typename MatType,
+         typename DistanceType,
          template<typename RuleType> class DualTreeTraversalType,
          template<typename RuleType> class SingleTreeTraversalType>
 void LeafSizeNSWrapper<
-    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
+    SortPolicy, TreeType, MatType, DistanceType, DualTreeTraversalType,
+    SingleTreeTraversalType
 >::Train(util::Timers& timers,
-         arma::mat&& referenceSet,
+         MatType&& referenceSet,
          const size_t leafSize,
          const double /* tau */,
          const double /* rho */)
@@ -141,15 +295,18 @@ template<typename SortPolicy,
          template<typename TreeDistanceType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
+         typename MatType,
+         typename DistanceType,
          template<typename RuleType> class DualTreeTraversalType,
          template<typename RuleType> class SingleTreeTraversalType>
 void LeafSizeNSWrapper<
-    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
+    SortPolicy, TreeType, MatType, DistanceType, DualTreeTraversalType,
+    SingleTreeTraversalType
 >::Search(util::Timers& timers,
-          arma::mat&& querySet,
+          MatType&& querySet,
           const size_t k,
           arma::Mat<size_t>& neighbors,
-          arma::mat& distances,
+          arma::Mat<ElemType>& distances,
           const size_t leafSize,
           const double /* rho */)
 {
@@ -166,7 +323,7 @@ void LeafSizeNSWrapper<
     timers.Stop("tree_building");
 
     arma::Mat<size_t> neighborsOut;
-    arma::mat distancesOut;
+    arma::Mat<ElemType> distancesOut;
     timers.Start("computing_neighbors");
     ns.Search(queryTree, k, neighborsOut, distancesOut);
     timers.Stop("computing_neighbors");
@@ -189,16 +346,21 @@ void LeafSizeNSWrapper<
 }
 
 //! Train the model using the given parameters.
-template<typename SortPolicy>
-void SpillNSWrapper<SortPolicy>::Train(util::Timers& timers,
-                                       arma::mat&& referenceSet,
-                                       const size_t leafSize,
-                                       const double tau,
-                                       const double rho)
+template<typename SortPolicy, typename MatType>
+void SpillNSWrapper<SortPolicy, MatType>::Train(
+    util::Timers& timers,
+    MatType&& referenceSet,
+    const size_t leafSize,
+    const double tau,
+    const double rho)
 {
   timers.Start("tree_building");
   typename decltype(ns)::Tree tree(std::move(referenceSet), tau, leafSize,
       rho);
+  // The indexes of the points are duplicated across the overlapping nodes, so
+  // store them compactly when they fit in 32 bits.
+  if (tree.Dataset().n_cols <= (size_t) std::numeric_limits<uint32_t>::max())
+    tree.Compact();
   timers.Stop("tree_building");
 
   ns.Train(std::move(tree));
@@ -206,14 +368,15 @@ void SpillNSWrapper<SortPolicy>::Train(util::Timers& timers,
 
 //! Perform bichromatic search (i.e. search with a different query set) using
 //! the given parameters.
-template<typename SortPolicy>
-void SpillNSWrapper<SortPolicy>::Search(util::Timers& timers,
-                                        arma::mat&& querySet,
-                                        const size_t k,
-                                        arma::Mat<size_t>& neighbors,
-                                        arma::mat& distances,
-                                        const size_t leafSize,
-                                        const double rho)
+template<typename SortPolicy, typename MatType>
+void SpillNSWrapper<SortPolicy, MatType>::Search(
+    util::Timers& timers,
+    MatType&& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::Mat<ElemType>& distances,
+    const size_t leafSize,
+    const double rho)
 {
   if (ns.SearchMode() == DUAL_TREE_MODE)
   {
@@ -240,40 +403,48 @@ void SpillNSWrapper<SortPolicy>::Search(util::Timers& timers,
  * Initialize the NSModel with the given type and whether or not a random
  * basis should be used.
  */
-template<typename SortPolicy>
-NSModel<SortPolicy>::NSModel(TreeTypes treeType, bool randomBasis) :
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>::NSModel(TreeTypes treeType,
+                                      bool randomBasis) :
     treeType(treeType),
     randomBasis(randomBasis),
     leafSize(20),
     tau(0.0),
     rho(0.7),
+    autoTuned(false),
+    fixedDimension(0),
     nSearch(NULL)
 {
   // Nothing to do.
 }
 
-template<typename SortPolicy>
-NSModel<SortPolicy>::NSModel(const NSModel& other) :
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>::NSModel(const NSModel& other) :
     treeType(other.treeType),
     randomBasis(other.randomBasis),
     q(other.q),
     leafSize(other.leafSize),
     tau(other.tau),
     rho(other.rho),
+    autoTuned(other.autoTuned),
+    fixedDimension(other.fixedDimension),
     nSearch(other.nSearch->Clone())
 {
   // Nothing to do.
 }
 
-template<typename SortPolicy>
-NSModel<SortPolicy>::NSModel(NSModel&& other) :
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>::NSModel(NSModel&& other) :
     treeType(other.treeType),
     randomBasis(other.randomBasis),
     q(std::move(other.q)),
     leafSize(other.leafSize),
     tau(other.tau),
     rho(other.rho),
-    nSearch(other.nSearch)
+    autoTuned(other.autoTuned),
+    fixedDimension(other.fixedDimension),
+    nSearch(other.nSearch),
+    mappedFile(std::move(other.mappedFile))
 {
   // Reset parameters of the other model.
   other.treeType = TreeTypes::KD_TREE;
@@ -281,11 +452,14 @@ NSModel<SortPolicy>::NSModel(NSModel&& other) :
   other.leafSize = 20;
   other.tau = 0.0;
   other.rho = 0.7;
+  other.autoTuned = false;
+  other.fixedDimension = 0;
   other.nSearch = NULL;
 }
 
-template<typename SortPolicy>
-NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(const NSModel& other)
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>& NSModel<SortPolicy, MatType>::operator=(
+    const NSModel& other)
 {
   if (this != &other)
   {
@@ -297,14 +471,19 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(const NSModel& other)
     leafSize = other.leafSize;
     tau = other.tau;
     rho = other.rho;
+    autoTuned = other.autoTuned;
+    fixedDimension = other.fixedDimension;
     nSearch = other.nSearch->Clone();
+    // The copied reference set does not point into the other model's mapping.
+    mappedFile.reset();
   }
 
   return *this;
 }
 
-template<typename SortPolicy>
-NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>& NSModel<SortPolicy, MatType>::operator=(
+    NSModel&& other)
 {
   if (this != &other)
   {
@@ -316,7 +495,10 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
     leafSize = other.leafSize;
     tau = other.tau;
     rho = other.rho;
+    autoTuned = other.autoTuned;
+    fixedDimension = other.fixedDimension;
     nSearch = other.nSearch;
+    mappedFile = std::move(other.mappedFile);
 
     // Reset parameters of the other model.
     other.treeType = TreeTypes::KD_TREE;
@@ -324,6 +506,8 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
     other.leafSize = 20;
     other.tau = 0.0;
     other.rho = 0.7;
+    other.autoTuned = false;
+    other.fixedDimension = 0;
     other.nSearch = NULL;
   }
 
@@ -331,16 +515,17 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
 }
 
 //! Clean memory, if necessary.
-template<typename SortPolicy>
-NSModel<SortPolicy>::~NSModel()
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>::~NSModel()
 {
   delete nSearch;
 }
 
 //! Serialize the kNN model.
-template<typename SortPolicy>
+template<typename SortPolicy, typename MatType>
 template<typename Archive>
-void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
+void NSModel<SortPolicy, MatType>::serialize(Archive& ar,
+                                            const uint32_t version)
 {
   ar(CEREAL_NVP(treeType));
   ar(CEREAL_NVP(randomBasis));
@@ -349,6 +534,18 @@ void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
   ar(CEREAL_NVP(tau));
   ar(CEREAL_NVP(rho));
 
+  // Models from before version 1 were never auto-tuned.
+  if (cereal::is_loading<Archive>() && version == 0)
+    autoTuned = false;
+  else
+    ar(CEREAL_NVP(autoTuned));
+
+  // Models from before version 2 always used the Euclidean distance.
+  if (cereal::is_loading<Archive>() && version < 2)
+    fixedDimension = 0;
+  else
+    ar(CEREAL_NVP(fixedDimension));
+
   // This should never happen, but just in case, be clean with memory.
   if (cereal::is_loading<Archive>())
     InitializeModel(DUAL_TREE_MODE, 0.0); // Values will be overwritten.
@@ -357,214 +554,521 @@ void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
   switch (treeType)
   {
     case KD_TREE:
-      {
-        LeafSizeNSWrapper<SortPolicy, KDTree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy, KDTree>&>(*nSearch);
-        ar(CEREAL_NVP(typedSearch));
-        break;
-      }
-    case COVER_TREE:
-      {
-        NSWrapper<SortPolicy, StandardCoverTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, StandardCoverTree>&>(*nSearch);
-        ar(CEREAL_NVP(typedSearch));
-        break;
-      }
-    case R_TREE:
-      {
-        NSWrapper<SortPolicy, RTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, RTree>&>(*nSearch);
-        ar(CEREAL_NVP(typedSearch));
-        break;
-      }
-    case R_STAR_TREE:
-      {
-        NSWrapper<SortPolicy, RStarTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, RStarTree>&>(*nSearch);
-        ar(CEREAL_NVP(typedSearch));
-        break;
-      }
+      if (fixedDimension == 2)
+        SerializeSearch<FixedKDWrapper<2>>(ar);
+      else if (fixedDimension == 3)
+        SerializeSearch<FixedKDWrapper<3>>(ar);
+      else if (fixedDimension == 4)
+        SerializeSearch<FixedKDWrapper<4>>(ar);
+      else
+        SerializeSearch<LeafSizeNSWrapper<SortPolicy, KDTree, MatType>>(ar);
+      break;
     case BALL_TREE:
       {
-        LeafSizeNSWrapper<SortPolicy, BallTree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy, BallTree>&>(*nSearch);
-        ar(CEREAL_NVP(typedSearch));
-        break;
-      }
-    case X_TREE:
-      {
-        NSWrapper<SortPolicy, XTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, XTree>&>(*nSearch);
-        ar(CEREAL_NVP(typedSearch));
-        break;
-      }
-    case HILBERT_R_TREE:
-      {
-        NSWrapper<SortPolicy, HilbertRTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, HilbertRTree>&>(*nSearch);
-        ar(CEREAL_NVP(typedSearch));
-        break;
-      }
-    case R_PLUS_TREE:
-      {
-        NSWrapper<SortPolicy, RPlusTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, RPlusTree>&>(*nSearch);
-        ar(CEREAL_NVP(typedSearch));
-        break;
-      }
-    case R_PLUS_PLUS_TREE:
-      {
-        NSWrapper<SortPolicy, RPlusPlusTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, RPlusPlusTree>&>(*nSearch);
-        ar(CEREAL_NVP(typedSearch));
-        break;
-      }
-    case SPILL_TREE:
-      {
-        SpillNSWrapper<SortPolicy>& typedSearch =
-            dynamic_cast<SpillNSWrapper<SortPolicy>&>(*nSearch);
+        LeafSizeNSWrapper<SortPolicy, BallTree, MatType>& typedSearch =
+            dynamic_cast<LeafSizeNSWrapper<SortPolicy, BallTree, MatType>&>(
+                *nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case VP_TREE:
       {
-        LeafSizeNSWrapper<SortPolicy, VPTree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy, VPTree>&>(*nSearch);
+        LeafSizeNSWrapper<SortPolicy, VPTree, MatType>& typedSearch =
+            dynamic_cast<LeafSizeNSWrapper<SortPolicy, VPTree, MatType>&>(
+                *nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case RP_TREE:
       {
-        LeafSizeNSWrapper<SortPolicy, RPTree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy, RPTree>&>(*nSearch);
+        LeafSizeNSWrapper<SortPolicy, RPTree, MatType>& typedSearch =
+            dynamic_cast<LeafSizeNSWrapper<SortPolicy, RPTree, MatType>&>(
+                *nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case MAX_RP_TREE:
       {
-        LeafSizeNSWrapper<SortPolicy, MaxRPTree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy, MaxRPTree>&>(*nSearch);
+        LeafSizeNSWrapper<SortPolicy, MaxRPTree, MatType>& typedSearch =
+            dynamic_cast<LeafSizeNSWrapper<SortPolicy, MaxRPTree, MatType>&>(
+                *nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case UB_TREE:
       {
-        LeafSizeNSWrapper<SortPolicy, UBTree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy, UBTree>&>(*nSearch);
+        LeafSizeNSWrapper<SortPolicy, UBTree, MatType>& typedSearch =
+            dynamic_cast<LeafSizeNSWrapper<SortPolicy, UBTree, MatType>&>(
+                *nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
-    case OCTREE:
+    default:
+      // The other trees are only instantiated for double-precision data.
+      if constexpr (std::is_same<ElemType, double>::value)
       {
-        LeafSizeNSWrapper<SortPolicy, Octree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy, Octree>&>(*nSearch);
-        ar(CEREAL_NVP(typedSearch));
-        break;
+        switch (treeType)
+        {
+          case COVER_TREE:
+            {
+              typedef NSWrapper<SortPolicy, StandardCoverTree, MatType>
+                  WrapperType;
+              WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
+              ar(CEREAL_NVP(typedSearch));
+              break;
+            }
+          case R_TREE:
+            {
+              NSWrapper<SortPolicy, RTree, MatType>& typedSearch =
+                  dynamic_cast<NSWrapper<SortPolicy, RTree, MatType>&>(
+                      *nSearch);
+              ar(CEREAL_NVP(typedSearch));
+              break;
+            }
+          case R_STAR_TREE:
+            {
+              NSWrapper<SortPolicy, RStarTree, MatType>& typedSearch =
+                  dynamic_cast<NSWrapper<SortPolicy, RStarTree, MatType>&>(
+                      *nSearch);
+              ar(CEREAL_NVP(typedSearch));
+              break;
+            }
+          case X_TREE:
+            {
+              NSWrapper<SortPolicy, XTree, MatType>& typedSearch =
+                  dynamic_cast<NSWrapper<SortPolicy, XTree, MatType>&>(
+                      *nSearch);
+              ar(CEREAL_NVP(typedSearch));
+              break;
+            }
+          case HILBERT_R_TREE:
+            {
+              NSWrapper<SortPolicy, HilbertRTree, MatType>& typedSearch =
+                  dynamic_cast<NSWrapper<SortPolicy, HilbertRTree, MatType>&>(
+                      *nSearch);
+              ar(CEREAL_NVP(typedSearch));
+              break;
+            }
+          case R_PLUS_TREE:
+            {
+              NSWrapper<SortPolicy, RPlusTree, MatType>& typedSearch =
+                  dynamic_cast<NSWrapper<SortPolicy, RPlusTree, MatType>&>(
+                      *nSearch);
+              ar(CEREAL_NVP(typedSearch));
+              break;
+            }
+          case R_PLUS_PLUS_TREE:
+            {
+              NSWrapper<SortPolicy, RPlusPlusTree, MatType>& typedSearch =
+                  dynamic_cast<NSWrapper<SortPolicy, RPlusPlusTree, MatType>&>(
+                      *nSearch);
+              ar(CEREAL_NVP(typedSearch));
+              break;
+            }
+          case SPILL_TREE:
+            {
+              SpillNSWrapper<SortPolicy, MatType>& typedSearch =
+                  dynamic_cast<SpillNSWrapper<SortPolicy, MatType>&>(*nSearch);
+              ar(CEREAL_NVP(typedSearch));
+              break;
+            }
+          case OCTREE:
+            {
+              LeafSizeNSWrapper<SortPolicy, Octree, MatType>& typedSearch =
+                  dynamic_cast<LeafSizeNSWrapper<SortPolicy, Octree, MatType>&>(
+                      *nSearch);
+              ar(CEREAL_NVP(typedSearch));
+              break;
+            }
+          default:
+            break;
+        }
       }
+      else
+      {
+        throw std::invalid_argument("NSModel::serialize(): the " +
+            TreeName() + " is only available with double-precision data!");
+      }
+      break;
   }
 }
 
+//! Save the model in a memory-mappable layout.
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::SaveMapped(const std::string& filename)
+{
+  if (!nSearch)
+  {
+    throw std::invalid_argument("NSModel::SaveMapped(): the model has not "
+        "been trained!");
+  }
+
+  // The reference set is written separately, so take it out of the model while
+  // the rest of the model is serialized.  Every node of the tree refers to the
+  // same matrix object, so it can be put back afterwards.
+  MatType& dataset = const_cast<MatType&>(nSearch->Dataset());
+  MatType referenceSet(std::move(dataset));
+
+  std::ostringstream modelStream(std::ios::binary);
+  try
+  {
+    cereal::BinaryOutputArchive ar(modelStream);
+    ar(cereal::make_nvp("model", *this));
+  }
+  catch (...)
+  {
+    dataset = std::move(referenceSet);
+    throw;
+  }
+  dataset = std::move(referenceSet);
+  const std::string model = modelStream.str();
+
+  // Put the data at the start of a page, so that it is aligned once mapped.
+  const uint64_t pageSize = 4096;
+  MappedHeader header;
+  std::memcpy(header.magic, "MLPKNSMF", 8);
+  header.version = 1;
+  header.elemSize = sizeof(ElemType);
+  header.nRows = dataset.n_rows;
+  header.nCols = dataset.n_cols;
+  header.dataOffset = ((sizeof(MappedHeader) + pageSize - 1) / pageSize) *
+      pageSize;
+  header.modelOffset = header.dataOffset + dataset.n_elem * sizeof(ElemType);
+  header.modelSize = model.size();
+
+  std::ofstream stream(filename, std::ios::binary);
+  if (!stream.is_open())
+  {
+    throw std::runtime_error("NSModel::SaveMapped(): cannot open '" + filename +
+        "' for writing!");
+  }
+
+  const std::vector<char> padding(header.dataOffset - sizeof(MappedHeader), 0);
+  stream.write((const char*) &header, sizeof(MappedHeader));
+  stream.write(padding.data(), padding.size());
+  stream.write((const char*) dataset.memptr(),
+      dataset.n_elem * sizeof(ElemType));
+  stream.write(model.data(), model.size());
+  if (!stream.good())
+  {
+    throw std::runtime_error("NSModel::SaveMapped(): error writing to '" +
+        filename + "'!");
+  }
+}
+
+//! Load a model saved with SaveMapped(), mapping the reference set.
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::LoadMapped(const std::string& filename)
+{
+  std::shared_ptr<data::MappedFile> file =
+      std::make_shared<data::MappedFile>(filename);
+
+  MappedHeader header;
+  if (file->Size() < sizeof(MappedHeader))
+  {
+    throw std::runtime_error("NSModel::LoadMapped(): '" + filename + "' is "
+        "not a mapped neighbor search model!");
+  }
+  std::memcpy(&header, file->Data(), sizeof(MappedHeader));
+
+  if (std::memcmp(header.magic, "MLPKNSMF", 8) != 0 || header.version != 1)
+  {
+    throw std::runtime_error("NSModel::LoadMapped(): '" + filename + "' is "
+        "not a mapped neighbor search model!");
+  }
+  if (header.elemSize != sizeof(ElemType))
+  {
+    throw std::runtime_error("NSModel::LoadMapped(): '" + filename + "' was "
+        "saved with a different element type!");
+  }
+  if (header.dataOffset + header.nRows * header.nCols * sizeof(ElemType) >
+          header.modelOffset ||
+      header.modelOffset + header.modelSize > file->Size())
+  {
+    throw std::runtime_error("NSModel::LoadMapped(): '" + filename + "' is "
+        "truncated or corrupted!");
+  }
+
+  // Deserialize everything but the reference set.  This replaces the current
+  // model (and releases any previous mapping).
+  std::istringstream modelStream(std::string(file->Data() + header.modelOffset,
+      header.modelSize), std::ios::binary);
+  {
+    cereal::BinaryInputArchive ar(modelStream);
+    ar(cereal::make_nvp("model", *this));
+  }
+
+  // Now point the (empty) reference set at the mapped data.  The memory is
+  // private, so nothing written to it can reach the file.
+  MatType& dataset = const_cast<MatType&>(nSearch->Dataset());
+  dataset = MatType((ElemType*) (file->Data() + header.dataOffset),
+      header.nRows, header.nCols, false, true);
+  mappedFile = std::move(file);
+}
+
 //! Expose the dataset.
-template<typename SortPolicy>
-const arma::mat& NSModel<SortPolicy>::Dataset() const
+template<typename SortPolicy, typename MatType>
+const MatType& NSModel<SortPolicy, MatType>::Dataset() const
 {
   return nSearch->Dataset();
 }
 
 //! Access the search mode.
-template<typename SortPolicy>
-NeighborSearchMode NSModel<SortPolicy>::SearchMode() const
+template<typename SortPolicy, typename MatType>
+NeighborSearchMode NSModel<SortPolicy, MatType>::SearchMode() const
 {
   return nSearch->SearchMode();
 }
 
 //! Modify the search mode.
-template<typename SortPolicy>
-NeighborSearchMode& NSModel<SortPolicy>::SearchMode()
+template<typename SortPolicy, typename MatType>
+NeighborSearchMode& NSModel<SortPolicy, MatType>::SearchMode()
 {
   return nSearch->SearchMode();
 }
 
-template<typename SortPolicy>
-double NSModel<SortPolicy>::Epsilon() const
+template<typename SortPolicy, typename MatType>
+double NSModel<SortPolicy, MatType>::Epsilon() const
 {
   return nSearch->Epsilon();
 }
 
-template<typename SortPolicy>
-double& NSModel<SortPolicy>::Epsilon()
+template<typename SortPolicy, typename MatType>
+double& NSModel<SortPolicy, MatType>::Epsilon()
 {
   return nSearch->Epsilon();
 }
 
+//! Get the number of base cases computed by the last search.
+template<typename SortPolicy, typename MatType>
+size_t NSModel<SortPolicy, MatType>::BaseCases() const
+{
+  return (nSearch != NULL) ? nSearch->BaseCases() : 0;
+}
+
+//! Get the number of node combinations scored by the last search.
+template<typename SortPolicy, typename MatType>
+size_t NSModel<SortPolicy, MatType>::Scores() const
+{
+  return (nSearch != NULL) ? nSearch->Scores() : 0;
+}
+
+//! Choose the tree type, leaf size and search mode for the given data.
+template<typename SortPolicy, typename MatType>
+NeighborSearchMode NSModel<SortPolicy, MatType>::AutoTune(
+    util::Timers& timers,
+    const MatType& referenceSet,
+    const MatType* querySet,
+    const size_t k,
+    const double epsilon,
+    const size_t sampleSize)
+{
+  if (referenceSet.n_cols < 2)
+  {
+    throw std::invalid_argument("NSModel::AutoTune(): the reference set must "
+        "have at least two points!");
+  }
+
+  timers.Start("auto_tuning");
+
+  // Take the samples.
+  const size_t referenceSamples = std::min(sampleSize,
+      (size_t) referenceSet.n_cols);
+  const MatType referenceSample = referenceSet.cols(
+      arma::randperm(referenceSet.n_cols, referenceSamples));
+  MatType querySample;
+  if (querySet != NULL)
+  {
+    const size_t querySamples = std::min(sampleSize,
+        (size_t) querySet->n_cols);
+    querySample = querySet->cols(arma::randperm(querySet->n_cols,
+        querySamples));
+  }
+
+  // A point is not its own neighbor in monochromatic search.
+  const size_t maxK = (querySet == NULL) ? referenceSamples - 1 :
+      referenceSamples;
+  const size_t sampleK = std::max(std::min(k, maxK), (size_t) 1);
+
+  // The candidate configurations.  Cover trees do not use the leaf size, and
+  // are only available for double precision data.
+  std::vector<std::pair<TreeTypes, size_t>> trees;
+  for (const TreeTypes tree : { KD_TREE, BALL_TREE, VP_TREE })
+    for (const size_t candidateLeafSize : { 5, 10, 20, 40, 80 })
+      trees.push_back(std::make_pair(tree, candidateLeafSize));
+  if constexpr (std::is_same<ElemType, double>::value)
+    trees.push_back(std::make_pair(COVER_TREE, leafSize));
+
+  std::vector<std::pair<std::pair<TreeTypes, size_t>, NeighborSearchMode>>
+      candidates;
+  candidates.push_back(std::make_pair(std::make_pair(treeType, leafSize),
+      NAIVE_MODE));
+  for (size_t i = 0; i < trees.size(); ++i)
+  {
+    candidates.push_back(std::make_pair(trees[i], SINGLE_TREE_MODE));
+    candidates.push_back(std::make_pair(trees[i], DUAL_TREE_MODE));
+  }
+
+  // The searches on the samples are neither logged nor timed.
+  util::Timers tuningTimers;
+  const bool ignoring = Log::Info.ignoreInput;
+
+  size_t bestCost = std::numeric_limits<size_t>::max();
+  size_t best = 0;
+  for (size_t i = 0; i < candidates.size(); ++i)
+  {
+    NSModel candidate(candidates[i].first.first, false);
+    candidate.LeafSize() = candidates[i].first.second;
+    candidate.Tau() = tau;
+    candidate.Rho() = rho;
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    Log::Info.ignoreInput = true;
+    candidate.BuildModel(tuningTimers, MatType(referenceSample),
+        candidates[i].second, epsilon);
+    if (querySet != NULL)
+    {
+      candidate.Search(tuningTimers, MatType(querySample), sampleK, neighbors,
+          distances);
+    }
+    else
+    {
+      candidate.Search(tuningTimers, sampleK, neighbors, distances);
+    }
+    Log::Info.ignoreInput = ignoring;
+
+    const size_t cost = candidate.BaseCases() + candidate.Scores();
+    Log::Info << "Auto-tuning: " << candidate.TreeName() << " with leaf size "
+        << candidate.LeafSize() << ", " << ((candidates[i].second ==
+        NAIVE_MODE) ? "naive" : (candidates[i].second == SINGLE_TREE_MODE) ?
+        "single-tree" : "dual-tree") << " search: " << candidate.BaseCases()
+        << " base cases, " << candidate.Scores() << " scores." << std::endl;
+
+    if (cost < bestCost)
+    {
+      bestCost = cost;
+      best = i;
+    }
+  }
+
+  treeType = candidates[best].first.first;
+  leafSize = candidates[best].first.second;
+  autoTuned = true;
+  timers.Stop("auto_tuning");
+
+  return candidates[best].second;
+}
+
 //! Initialize a model given the tree type.  (No training happens here.)
-template<typename SortPolicy>
-void NSModel<SortPolicy>::InitializeModel(const NeighborSearchMode searchMode,
-                                          const double epsilon)
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::InitializeModel(
+    const NeighborSearchMode searchMode,
+    const double epsilon)
 {
-  // Clear existing memory.
+  // Clear existing memory.  The old reference set may point into a mapped
+  // file, so the mapping can only be released once the old model is gone.
+  // nSearch is reset first, in case no wrapper can be created below.
   if (nSearch)
     delete nSearch;
+  nSearch = NULL;
+  mappedFile.reset();
 
   switch (treeType)
   {
     case KD_TREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, KDTree>(searchMode, epsilon);
-      break;
-    case COVER_TREE:
-      nSearch = new NSWrapper<SortPolicy, StandardCoverTree>(searchMode,
-          epsilon);
-      break;
-    case R_TREE:
-      nSearch = new NSWrapper<SortPolicy, RTree>(searchMode, epsilon);
-      break;
-    case R_STAR_TREE:
-      nSearch = new NSWrapper<SortPolicy, RStarTree>(searchMode, epsilon);
+      if (fixedDimension == 2)
+        nSearch = new FixedKDWrapper<2>(searchMode, epsilon);
+      else if (fixedDimension == 3)
+        nSearch = new FixedKDWrapper<3>(searchMode, epsilon);
+      else if (fixedDimension == 4)
+        nSearch = new FixedKDWrapper<4>(searchMode, epsilon);
+      else
+        nSearch = new LeafSizeNSWrapper<SortPolicy, KDTree, MatType>(
+            searchMode, epsilon);
       break;
     case BALL_TREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, BallTree>(searchMode,
-          epsilon);
-      break;
-    case X_TREE:
-      nSearch = new NSWrapper<SortPolicy, XTree>(searchMode, epsilon);
-      break;
-    case HILBERT_R_TREE:
-      nSearch = new NSWrapper<SortPolicy, HilbertRTree>(searchMode, epsilon);
-      break;
-    case R_PLUS_TREE:
-      nSearch = new NSWrapper<SortPolicy, RPlusTree>(searchMode, epsilon);
-      break;
-    case R_PLUS_PLUS_TREE:
-      nSearch = new NSWrapper<SortPolicy, RPlusPlusTree>(searchMode, epsilon);
+      nSearch = new LeafSizeNSWrapper<SortPolicy, BallTree, MatType>(
+          searchMode, epsilon);
       break;
     case VP_TREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, VPTree>(searchMode, epsilon);
+      nSearch = new LeafSizeNSWrapper<SortPolicy, VPTree, MatType>(
+          searchMode, epsilon);
       break;
     case RP_TREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, RPTree>(searchMode, epsilon);
+      nSearch = new LeafSizeNSWrapper<SortPolicy, RPTree, MatType>(
+          searchMode, epsilon);
       break;
     case MAX_RP_TREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, MaxRPTree>(searchMode,
-          epsilon);
-      break;
-    case SPILL_TREE:
-      nSearch = new SpillNSWrapper<SortPolicy>(searchMode, epsilon);
+      nSearch = new LeafSizeNSWrapper<SortPolicy, MaxRPTree, MatType>(
+          searchMode, epsilon);
       break;
     case UB_TREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, UBTree>(searchMode, epsilon);
+      nSearch = new LeafSizeNSWrapper<SortPolicy, UBTree, MatType>(
+          searchMode, epsilon);
       break;
-    case OCTREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, Octree>(searchMode, epsilon);
+    default:
+      // The other trees are only instantiated for double-precision data.
+      if constexpr (std::is_same<ElemType, double>::value)
+      {
+        switch (treeType)
+        {
+          case COVER_TREE:
+            nSearch = new NSWrapper<SortPolicy, StandardCoverTree, MatType>(
+                searchMode, epsilon);
+            break;
+          case R_TREE:
+            nSearch = new NSWrapper<SortPolicy, RTree, MatType>(
+                searchMode, epsilon);
+            break;
+          case R_STAR_TREE:
+            nSearch = new NSWrapper<SortPolicy, RStarTree, MatType>(
+                searchMode, epsilon);
+            break;
+          case X_TREE:
+            nSearch = new NSWrapper<SortPolicy, XTree, MatType>(
+                searchMode, epsilon);
+            break;
+          case HILBERT_R_TREE:
+            nSearch = new NSWrapper<SortPolicy, HilbertRTree, MatType>(
+                searchMode, epsilon);
+            break;
+          case R_PLUS_TREE:
+            nSearch = new NSWrapper<SortPolicy, RPlusTree, MatType>(
+                searchMode, epsilon);
+            break;
+          case R_PLUS_PLUS_TREE:
+            nSearch = new NSWrapper<SortPolicy, RPlusPlusTree, MatType>(
+                searchMode, epsilon);
+            break;
+          case SPILL_TREE:
+            nSearch = new SpillNSWrapper<SortPolicy, MatType>(
+                searchMode, epsilon);
+            break;
+          case OCTREE:
+            nSearch = new LeafSizeNSWrapper<SortPolicy, Octree, MatType>(
+                searchMode, epsilon);
+            break;
+          default:
+            break;
+        }
+      }
+      else
+      {
+        throw std::invalid_argument("NSModel::InitializeModel(): the " +
+            TreeName() + " is only available with double-precision data!");
+      }
       break;
   }
 }
 
 //! Build the reference tree.
-template<typename SortPolicy>
-void NSModel<SortPolicy>::BuildModel(util::Timers& timers,
-                                     arma::mat&& referenceSet,
-                                     const NeighborSearchMode searchMode,
-                                     const double epsilon)
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::BuildModel(
+    util::Timers& timers,
+    MatType&& referenceSet,
+    const NeighborSearchMode searchMode,
+    const double epsilon)
 {
   // Initialize random basis if necessary.
   if (randomBasis)
@@ -575,11 +1079,11 @@ void NSModel<SortPolicy>::BuildModel(util::Timers& timers,
     {
       // [Q, R] = qr(randn(d, d));
       // Q = Q * diag(sign(diag(R)));
-      arma::mat r;
-      if (arma::qr(q, r, randn<arma::mat>(referenceSet.n_rows,
+      MatType r;
+      if (arma::qr(q, r, randn<MatType>(referenceSet.n_rows,
               referenceSet.n_rows)))
       {
-        arma::vec rDiag(r.n_rows);
+        arma::Col<ElemType> rDiag(r.n_rows);
         for (size_t i = 0; i < rDiag.n_elem; ++i)
         {
           if (r(i, i) < 0)
@@ -605,6 +1109,12 @@ void NSModel<SortPolicy>::BuildModel(util::Timers& timers,
   if (searchMode != NAIVE_MODE)
     Log::Info << "Building reference tree..." << std::endl;
 
+  // Low-dimensional kd-trees use a distance with a compile-time
+  // dimensionality.
+  const size_t dim = referenceSet.n_rows;
+  fixedDimension = (treeType == KD_TREE && searchMode != NAIVE_MODE &&
+      dim >= 2 && dim <= 4) ? dim : 0;
+
   InitializeModel(searchMode, epsilon);
   nSearch->Train(timers, std::move(referenceSet), leafSize, tau, rho);
 
@@ -613,13 +1123,23 @@ void NSModel<SortPolicy>::BuildModel(util::Timers& timers,
 }
 
 //! Perform neighbor search.  The query set will be reordered.
-template<typename SortPolicy>
-void NSModel<SortPolicy>::Search(util::Timers& timers,
-                                 arma::mat&& querySet,
-                                 const size_t k,
-                                 arma::Mat<size_t>& neighbors,
-                                 arma::mat& distances)
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::Search(util::Timers& timers,
+                                          MatType&& querySet,
+                                          const size_t k,
+                                          arma::Mat<size_t>& neighbors,
+                                          arma::mat& distances,
+                                          const bool rerank)
 {
+  // FixedLMetric does not check the dimensionality of the points.
+  if (fixedDimension != 0 && querySet.n_rows != fixedDimension)
+  {
+    std::ostringstream oss;
+    oss << "NSModel::Search(): the query set has " << querySet.n_rows
+        << " dimensions, but the reference set has " << fixedDimension << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
   // We may need to map the query set randomly.
   if (randomBasis)
   {
@@ -647,16 +1167,41 @@ void NSModel<SortPolicy>::Search(util::Timers& timers,
       break;
   }
 
-  nSearch->Search(timers, std::move(querySet), k, neighbors, distances,
-      leafSize, rho);
+  // The query set is consumed by the search, so keep a copy if the distances
+  // have to be recomputed.
+  MatType rerankQuerySet;
+  if (rerank)
+    rerankQuerySet = querySet;
+
+  // The distances are always returned in double precision.
+  if constexpr (std::is_same<ElemType, double>::value)
+  {
+    nSearch->Search(timers, std::move(querySet), k, neighbors, distances,
+        leafSize, rho);
+  }
+  else
+  {
+    arma::Mat<ElemType> elemDistances;
+    nSearch->Search(timers, std::move(querySet), k, neighbors, elemDistances,
+        leafSize, rho);
+    distances = arma::conv_to<arma::mat>::from(elemDistances);
+  }
+
+  if (rerank)
+  {
+    timers.Start("reranking_neighbors");
+    Rerank(&rerankQuerySet, neighbors, distances);
+    timers.Stop("reranking_neighbors");
+  }
 }
 
 //! Perform neighbor search.
-template<typename SortPolicy>
-void NSModel<SortPolicy>::Search(util::Timers& timers,
-                                 const size_t k,
-                                 arma::Mat<size_t>& neighbors,
-                                 arma::mat& distances)
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::Search(util::Timers& timers,
+                                          const size_t k,
+                                          arma::Mat<size_t>& neighbors,
+                                          arma::mat& distances,
+                                          const bool rerank)
 {
   Log::Info << "Searching for " << k << " neighbors with ";
 
@@ -681,12 +1226,167 @@ void NSModel<SortPolicy>::Search(util::Timers& timers,
     Log::Info << "Maximum of " << Epsilon() * 100 << "% relative error."
         << std::endl;
 
-  nSearch->Search(timers, k, neighbors, distances);
+  // The distances are always returned in double precision.
+  if constexpr (std::is_same<ElemType, double>::value)
+  {
+    nSearch->Search(timers, k, neighbors, distances);
+  }
+  else
+  {
+    arma::Mat<ElemType> elemDistances;
+    nSearch->Search(timers, k, neighbors, elemDistances);
+    distances = arma::conv_to<arma::mat>::from(elemDistances);
+  }
+
+  if (rerank)
+  {
+    timers.Start("reranking_neighbors");
+    Rerank(NULL, neighbors, distances);
+    timers.Stop("reranking_neighbors");
+  }
+}
+
+//! Build a query tree and keep it for SearchQueryTree().
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::BuildQueryTree(util::Timers& timers,
+                                                  MatType&& querySet)
+{
+  // FixedLMetric does not check the dimensionality of the points.
+  if (fixedDimension != 0 && querySet.n_rows != fixedDimension)
+  {
+    std::ostringstream oss;
+    oss << "NSModel::BuildQueryTree(): the query set has " << querySet.n_rows
+        << " dimensions, but the reference set has " << fixedDimension << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // We may need to map the query set randomly.
+  if (randomBasis)
+  {
+    timers.Start("applying_random_basis");
+    querySet = q * querySet;
+    timers.Stop("applying_random_basis");
+  }
+
+  if (SearchMode() == DUAL_TREE_MODE)
+    Log::Info << "Building query tree..." << std::endl;
+
+  nSearch->BuildQueryTree(timers, std::move(querySet), leafSize, rho);
+}
+
+//! Return whether a query tree was built.
+template<typename SortPolicy, typename MatType>
+bool NSModel<SortPolicy, MatType>::HasQueryTree() const
+{
+  return (nSearch != NULL) && nSearch->HasQueryTree();
+}
+
+//! Free the query tree.
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::ClearQueryTree()
+{
+  if (nSearch != NULL)
+    nSearch->ClearQueryTree();
+}
+
+//! Perform neighbor search with the query tree built by BuildQueryTree().
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::SearchQueryTree(
+    util::Timers& timers,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances,
+    const bool rerank)
+{
+  if (!HasQueryTree())
+  {
+    throw std::logic_error("NSModel::SearchQueryTree(): no query tree was "
+        "built; call BuildQueryTree() first!");
+  }
+
+  Log::Info << "Searching for " << k << " neighbors with the query tree..."
+      << std::endl;
+
+  // The distances are always returned in double precision.
+  if constexpr (std::is_same<ElemType, double>::value)
+  {
+    nSearch->SearchQueryTree(timers, k, neighbors, distances);
+  }
+  else
+  {
+    arma::Mat<ElemType> elemDistances;
+    nSearch->SearchQueryTree(timers, k, neighbors, elemDistances);
+    distances = arma::conv_to<arma::mat>::from(elemDistances);
+  }
+
+  if (rerank)
+  {
+    timers.Start("reranking_neighbors");
+    const MatType rerankQuerySet = nSearch->QuerySet();
+    Rerank(&rerankQuerySet, neighbors, distances);
+    timers.Stop("reranking_neighbors");
+  }
+}
+
+//! Recompute the distances to the neighbors in double precision.
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::Rerank(const MatType* querySet,
+                                          arma::Mat<size_t>& neighbors,
+                                          arma::mat& distances) const
+{
+  const MatType& referenceSet = nSearch->Dataset();
+
+  // The neighbors are given as indices into the original reference set, but
+  // the points may have been reordered when the tree was built.
+  const std::vector<size_t>& oldFromNew = nSearch->OldFromNewReferences();
+  std::vector<size_t> newFromOld(oldFromNew.size());
+  for (size_t i = 0; i < oldFromNew.size(); ++i)
+    newFromOld[oldFromNew[i]] = i;
+
+  typedef std::pair<double, size_t> Candidate;
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+  {
+    const size_t queryColumn = (querySet != NULL || newFromOld.empty()) ? i :
+        newFromOld[i];
+    const arma::vec query = arma::conv_to<arma::vec>::from((querySet != NULL) ?
+        querySet->col(i) : referenceSet.col(queryColumn));
+
+    std::vector<Candidate> candidates;
+    candidates.reserve(neighbors.n_rows);
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+    {
+      // Slots with no neighbor are always at the end of the list.
+      const size_t neighbor = neighbors(j, i);
+      if (neighbor == size_t() - 1)
+        break;
+
+      const size_t column = newFromOld.empty() ? neighbor :
+          newFromOld[neighbor];
+      const arma::vec reference =
+          arma::conv_to<arma::vec>::from(referenceSet.col(column));
+      candidates.push_back(Candidate(arma::norm(query - reference, 2),
+          neighbor));
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(),
+        [](const Candidate& a, const Candidate& b)
+        {
+          return (a.first != b.first) && SortPolicy::IsBetter(a.first, b.first);
+        });
+
+    for (size_t j = 0; j < candidates.size(); ++j)
+    {
+      neighbors(j, i) = candidates[j].second;
+      distances(j, i) = candidates[j].first;
+    }
+  }
 }
 
 //! Get the name of the tree type.
-template<typename SortPolicy>
-std::string NSModel<SortPolicy>::TreeName() const
+template<typename SortPolicy, typename MatType>
+std::string NSModel<SortPolicy, MatType>::TreeName() const
 {
   switch (treeType)
   {
@@ -0,0 +1,159 @@
+/**
+ * @file methods/neighbor_search/sparse_cosine_search.hpp
+ *
+ * Defines the SparseCosineSearch class, which finds the nearest neighbors of
+ * sparse points (like TF-IDF vectors) with the cosine distance, with an
+ * inverted index of the reference set.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SPARSE_COSINE_SEARCH_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SPARSE_COSINE_SEARCH_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+
+/**
+ * The SparseCosineSearch class computes the exact k nearest neighbors of sparse
+ * query points in a sparse reference set with the cosine distance,
+ * 1 - x^T y / (|| x || || y ||), without densifying either set.  The
+ * normalized reference points are stored as an inverted index: one posting
+ * list for each dimension (term), holding the points where the term is
+ * nonzero and their weights.  The similarities of a query are accumulated by
+ * going through the posting lists of its terms only, so that the cost of a
+ * query depends on the number of points that share a term with it, not on the
+ * size of the reference set.
+ *
+ * The terms of a query are processed by decreasing bound on their
+ * contribution (the weight of the term in the query times its largest weight
+ * in the reference set).  Once the sum of the bounds of the remaining terms is
+ * smaller than the k'th best similarity accumulated so far, no point that
+ * has not been seen yet can be a neighbor, so the remaining posting lists only
+ * update the points already seen.  The results are the same as those of a
+ * brute-force search (up to the order of points at the same distance).
+ *
+ * Points without nonzero elements have a similarity of 0 with every point.
+ *
+ * @tparam SpMatType Type of sparse matrix (arma::sp_mat, arma::sp_fmat).
+ */
+template<typename SpMatType = arma::sp_mat>
+class SparseCosineSearch
+{
+ public:
+  //! The type of element held in SpMatType.
+  typedef typename SpMatType::elem_type ElemType;
+
+  //! Create an empty model.
+  SparseCosineSearch();
+
+  /**
+   * Build the inverted index of the given reference set.
+   *
+   * @param referenceSet Set of reference points, one in each column.
+   */
+  SparseCosineSearch(const SpMatType& referenceSet);
+
+  /**
+   * Build the inverted index of the given reference set, replacing the
+   * current one.
+   *
+   * @param referenceSet Set of reference points, one in each column.
+   */
+  void Train(const SpMatType& referenceSet);
+
+  /**
+   * Compute the k nearest neighbors of the given query points.  The output
+   * matrices have k rows and one column per query point; the neighbors of each
+   * point are sorted from nearest to furthest (ties by index), and the
+   * distances are cosine distances.  The query points are searched in
+   * parallel when OpenMP is available.
+   *
+   * @param querySet Set of query points, one in each column.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix to store the neighbors in.
+   * @param distances Matrix to store the distances in.
+   */
+  void Search(const SpMatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances) const;
+
+  /**
+   * Compute the k nearest neighbors of every point in the reference set, not
+   * counting the point itself (for instance, to find near-duplicates).  The
+   * output matrices are organized as with the other overload of Search().
+   *
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix to store the neighbors in.
+   * @param distances Matrix to store the distances in.
+   */
+  void Search(const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances) const;
+
+  //! Get the number of reference points.
+  size_t NumPoints() const { return postings.n_rows; }
+  //! Get the dimensionality of the reference points.
+  size_t Dimensionality() const { return postings.n_cols; }
+  //! Get the posting lists: column t holds the normalized weights of term t
+  //! in the reference points.
+  const SpMatType& Postings() const { return postings; }
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! The buffers that a thread reuses for all its queries.
+  struct Accumulators
+  {
+    //! The similarity accumulated for each reference point.
+    std::vector<ElemType> scores;
+    //! Whether each reference point has been seen by the current query.
+    std::vector<char> seen;
+    //! The reference points seen by the current query.
+    std::vector<size_t> touched;
+  };
+
+  /**
+   * Search for the nearest neighbors of one query, given by the rows and the
+   * values of its nonzero elements, and store them in the given columns of the
+   * output matrices.  If skip is a valid reference index, that point is not
+   * returned.
+   */
+  void SearchPoint(const arma::uword* rows,
+                   const ElemType* values,
+                   const size_t numNonzeros,
+                   const size_t k,
+                   const size_t skip,
+                   Accumulators& accumulators,
+                   size_t* neighbors,
+                   ElemType* distances) const;
+
+  //! Search each column of the given queries; if monochromatic, query i is
+  //! reference point i, and it is skipped.
+  void SearchAll(const SpMatType& querySet,
+                 const size_t k,
+                 const bool monochromatic,
+                 arma::Mat<size_t>& neighbors,
+                 arma::Mat<ElemType>& distances) const;
+
+  //! The normalized reference points (one in each row), so that the posting
+  //! list of each term is a column.
+  SpMatType postings;
+  //! The largest absolute weight of each term in the reference points.
+  arma::Col<ElemType> maxWeights;
+  //! Whether all the weights of the reference points are non-negative.
+  bool nonNegative;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "sparse_cosine_search_impl.hpp"
+
+#endif
@@ -0,0 +1,267 @@
+/**
+ * @file methods/neighbor_search/sparse_cosine_search_impl.hpp
+ *
+ * Implementation of the SparseCosineSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SPARSE_COSINE_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SPARSE_COSINE_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "sparse_cosine_search.hpp"
+
+namespace mlpack {
+
+template<typename SpMatType>
+SparseCosineSearch<SpMatType>::SparseCosineSearch() :
+    nonNegative(true)
+{
+  // Nothing to do.
+}
+
+template<typename SpMatType>
+SparseCosineSearch<SpMatType>::SparseCosineSearch(
+    const SpMatType& referenceSet)
+{
+  Train(referenceSet);
+}
+
+template<typename SpMatType>
+void SparseCosineSearch<SpMatType>::Train(const SpMatType& referenceSet)
+{
+  // Normalize the reference points with a sparse diagonal matrix, so that only
+  // the nonzero elements are visited; empty points are left as they are.
+  arma::Row<ElemType> norms = arma::sqrt(arma::Row<ElemType>(
+      arma::sum(arma::square(referenceSet), 0)));
+  norms.transform([](ElemType x) { return (x == 0) ? 1 : 1 / x; });
+
+  SpMatType scaling(referenceSet.n_cols, referenceSet.n_cols);
+  scaling.diag() = norms.t();
+  postings = (referenceSet * scaling).t();
+
+  maxWeights = arma::Row<ElemType>(arma::max(arma::abs(postings), 0)).t();
+  nonNegative = (postings.n_nonzero == 0) || (postings.min() >= 0);
+}
+
+template<typename SpMatType>
+void SparseCosineSearch<SpMatType>::Search(
+    const SpMatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::Mat<ElemType>& distances) const
+{
+  if (querySet.n_rows != Dimensionality())
+  {
+    throw std::invalid_argument("SparseCosineSearch::Search(): the queries "
+        "have " + std::to_string(querySet.n_rows) + " dimensions, but the "
+        "reference set has " + std::to_string(Dimensionality()));
+  }
+  if (k == 0 || k > NumPoints())
+  {
+    throw std::invalid_argument("SparseCosineSearch::Search(): k must be "
+        "between 1 and the number of reference points (" +
+        std::to_string(NumPoints()) + ")");
+  }
+
+  SearchAll(querySet, k, false, neighbors, distances);
+}
+
+template<typename SpMatType>
+void SparseCosineSearch<SpMatType>::Search(
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::Mat<ElemType>& distances) const
+{
+  if (k == 0 || k >= NumPoints())
+  {
+    throw std::invalid_argument("SparseCosineSearch::Search(): k must be "
+        "between 1 and the number of reference points minus one (" +
+        std::to_string(NumPoints() - 1) + ")");
+  }
+
+  // The queries are the (normalized) reference points.
+  const SpMatType referenceSet = postings.t();
+  SearchAll(referenceSet, k, true, neighbors, distances);
+}
+
+template<typename SpMatType>
+template<typename Archive>
+void SparseCosineSearch<SpMatType>::serialize(Archive& ar,
+                                              const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(postings));
+  ar(CEREAL_NVP(maxWeights));
+  ar(CEREAL_NVP(nonNegative));
+}
+
+template<typename SpMatType>
+void SparseCosineSearch<SpMatType>::SearchAll(
+    const SpMatType& querySet,
+    const size_t k,
+    const bool monochromatic,
+    arma::Mat<size_t>& neighbors,
+    arma::Mat<ElemType>& distances) const
+{
+  // Make sure the CSC layouts are up to date before they are used directly.
+  querySet.sync();
+  postings.sync();
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  #pragma omp parallel
+  {
+    Accumulators accumulators;
+    accumulators.scores.assign(NumPoints(), 0);
+    accumulators.seen.assign(NumPoints(), 0);
+
+    #pragma omp for schedule(dynamic, 16)
+    for (size_t q = 0; q < querySet.n_cols; ++q)
+    {
+      const size_t begin = querySet.col_ptrs[q];
+      SearchPoint(querySet.row_indices + begin, querySet.values + begin,
+          querySet.col_ptrs[q + 1] - begin, k, monochromatic ? q : SIZE_MAX,
+          accumulators, neighbors.colptr(q), distances.colptr(q));
+    }
+  }
+}
+
+template<typename SpMatType>
+void SparseCosineSearch<SpMatType>::SearchPoint(
+    const arma::uword* rows,
+    const ElemType* values,
+    const size_t numNonzeros,
+    const size_t k,
+    const size_t skip,
+    Accumulators& accumulators,
+    size_t* neighbors,
+    ElemType* distances) const
+{
+  std::vector<ElemType>& scores = accumulators.scores;
+  std::vector<char>& seen = accumulators.seen;
+  std::vector<size_t>& touched = accumulators.touched;
+
+  // Order the terms of the query by decreasing bound on their contribution to
+  // any similarity.
+  ElemType norm = 0;
+  bool queryNonNegative = true;
+  for (size_t i = 0; i < numNonzeros; ++i)
+  {
+    norm += values[i] * values[i];
+    queryNonNegative &= (values[i] >= 0);
+  }
+  norm = std::sqrt(norm);
+
+  // An empty query has a similarity of 0 with every point.
+  std::vector<std::pair<ElemType, size_t>> terms;
+  terms.reserve(numNonzeros);
+  ElemType remaining = 0;
+  for (size_t i = 0; (norm > 0) && (i < numNonzeros); ++i)
+  {
+    const ElemType bound = std::abs(values[i]) / norm * maxWeights[rows[i]];
+    terms.push_back(std::make_pair(bound, i));
+    remaining += bound;
+  }
+  std::sort(terms.begin(), terms.end(),
+      std::greater<std::pair<ElemType, size_t>>());
+
+  // With non-negative weights, the accumulated similarities can only grow;
+  // otherwise, the remaining terms can decrease them as much as they can
+  // increase them.
+  const bool lowerBounds = nonNegative && queryNonNegative;
+
+  if (skip < NumPoints())
+    seen[skip] = 1;
+
+  bool addPoints = true;
+  ElemType maxScore = -std::numeric_limits<ElemType>::max();
+  std::vector<ElemType> best;
+  for (size_t t = 0; t < terms.size(); ++t)
+  {
+    const size_t i = terms[t].second;
+    const ElemType weight = values[i] / norm;
+    remaining -= terms[t].first;
+
+    for (size_t p = postings.col_ptrs[rows[i]];
+         p < postings.col_ptrs[rows[i] + 1]; ++p)
+    {
+      const size_t point = postings.row_indices[p];
+      if (point == skip)
+        continue;
+
+      if (!seen[point])
+      {
+        if (!addPoints)
+          continue;
+        seen[point] = 1;
+        touched.push_back(point);
+      }
+
+      scores[point] += weight * postings.values[p];
+      if (addPoints)
+        maxScore = std::max(maxScore, scores[point]);
+    }
+
+    // If the k'th best similarity is certainly at least the sum of the bounds
+    // of the remaining terms, no point that has not been seen can be a
+    // neighbor.  The best similarity so far is checked first, since finding
+    // the k'th best one takes a pass over the points seen.
+    const ElemType slack = lowerBounds ? 0 : remaining;
+    if (addPoints && touched.size() >= k && maxScore - slack >= remaining)
+    {
+      best.resize(touched.size());
+      for (size_t j = 0; j < touched.size(); ++j)
+        best[j] = scores[touched[j]];
+      std::nth_element(best.begin(), best.begin() + (k - 1), best.end(),
+          std::greater<ElemType>());
+      if (best[k - 1] - slack >= remaining)
+        addPoints = false;
+    }
+  }
+
+  std::vector<std::pair<ElemType, size_t>> candidates;
+  candidates.reserve(touched.size() + k);
+  for (size_t j = 0; j < touched.size(); ++j)
+    candidates.push_back(std::make_pair(1 - scores[touched[j]], touched[j]));
+
+  // If every point sharing a term with the query was seen, the others have a
+  // similarity of 0, and the first k of them may be neighbors too.
+  if (addPoints)
+  {
+    size_t unseen = 0;
+    for (size_t point = 0; point < NumPoints() && unseen < k; ++point)
+    {
+      if (!seen[point])
+      {
+        candidates.push_back(std::make_pair(ElemType(1), point));
+        ++unseen;
+      }
+    }
+  }
+
+  std::partial_sort(candidates.begin(), candidates.begin() + k,
+      candidates.end());
+  for (size_t j = 0; j < k; ++j)
+  {
+    neighbors[j] = candidates[j].second;
+    distances[j] = std::max(candidates[j].first, ElemType(0));
+  }
+
+  // Reset the accumulators for the next query.
+  for (size_t j = 0; j < touched.size(); ++j)
+  {
+    scores[touched[j]] = 0;
+    seen[touched[j]] = 0;
+  }
+  touched.clear();
+  if (skip < NumPoints())
+    seen[skip] = 0;
+}
+
+} // namespace mlpack
+
+#endif
@@ -137,9 +137,9 @@ void SaveWH(util::Params& params,
   }
 }
 
-template<typename UpdateRuleType>
+template<typename UpdateRuleType, typename MatType>
 void ApplyFactorization(util::Params& params,
-                        const arma::mat& V,
+                        const MatType& V,
                         const size_t r,
                         arma::mat& W,
                         arma::mat& H)
@@ -200,6 +200,31 @@ void ApplyFactorization(util::Params& params,
   }
 }
 
+// The multiplicative update rules only visit the nonzero elements of sparse
+// inputs, so inputs with at most 10% of nonzero elements are factorized as
+// sparse matrices (and the dense copy is released).
+template<typename UpdateRuleType>
+void ApplyMultiplicativeFactorization(util::Params& params,
+                                      arma::mat& V,
+                                      const size_t r,
+                                      arma::mat& W,
+                                      arma::mat& H)
+{
+  const size_t nonzeros = arma::accu(V != 0);
+  if (V.n_elem > 0 && nonzeros <= 0.1 * V.n_elem)
+  {
+    Log::Info << "Input has " << nonzeros << " nonzero elements; using a "
+        << "sparse representation." << std::endl;
+    arma::sp_mat sparseV(V);
+    V.reset();
+    ApplyFactorization<UpdateRuleType>(params, sparseV, r, W, H);
+  }
+  else
+  {
+    ApplyFactorization<UpdateRuleType>(params, V, r, W, H);
+  }
+}
+
 void BINDING_FUNCTION(util::Params& params, util::Timers& /* timers */)
 {
   // Initialize random seed.
@@ -233,13 +258,15 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& /* timers */)
   {
     Log::Info << "Performing NMF with multiplicative distance-based update "
         << "rules." << std::endl;
-    ApplyFactorization<NMFMultiplicativeDistanceUpdate>(params, V, r, W, H);
+    ApplyMultiplicativeFactorization<NMFMultiplicativeDistanceUpdate>(params, V,
+        r, W, H);
   }
   else if (updateRules == "multdiv")
   {
     Log::Info << "Performing NMF with multiplicative divergence-based update "
         << "rules." << std::endl;
-    ApplyFactorization<NMFMultiplicativeDivergenceUpdate>(params, V, r, W, H);
+    ApplyMultiplicativeFactorization<NMFMultiplicativeDivergenceUpdate>(params,
+        V, r, W, H);
   }
   else if (updateRules == "als")
   {
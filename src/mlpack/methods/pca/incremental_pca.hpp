@@ -0,0 +1,167 @@
+/**
+ * @file methods/pca/incremental_pca.hpp
+ *
+ * Defines the IncrementalPCAType class, which performs principal components
+ * analysis on a dataset given in batches, without holding the whole dataset in
+ * memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PCA_INCREMENTAL_PCA_HPP
+#define MLPACK_METHODS_PCA_INCREMENTAL_PCA_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+
+/**
+ * This class implements incremental principal components analysis: the mean
+ * and a rank-k basis of the principal components are updated from batches of
+ * points, so that the whole dataset never has to be held in memory (unlike the
+ * PCA class, which needs the whole centered dataset).  Each update makes an
+ * economical SVD of a d x (k + m + 1) matrix, where d is the dimensionality of
+ * the data and m is the number of points in the batch, as in the incremental
+ * SVD with a mean update of the following paper:
+ *
+ * @code
+ * @article{ross2008incremental,
+ *   title={Incremental Learning for Robust Visual Tracking},
+ *   author={Ross, D.A. and Lim, J. and Lin, R.-S. and Yang, M.-H.},
+ *   journal={International Journal of Computer Vision},
+ *   volume={77},
+ *   number={1--3},
+ *   pages={125--141},
+ *   year={2008}
+ * }
+ * @endcode
+ *
+ * If the rank is at least the dimensionality of the data, the result is the
+ * same as the exact PCA of all the points seen so far (up to the signs of the
+ * components); otherwise, each update keeps the k largest components, which is
+ * a (usually very good) approximation.
+ *
+ * Once some batches have been seen, new points can be projected onto the
+ * components with Transform(), without refitting.
+ *
+ * @code
+ * IncrementalPCA pca(10);
+ * for (size_t i = 0; i < numBatches; ++i)
+ * {
+ *   arma::mat batch;
+ *   data::Load("batch-" + std::to_string(i) + ".csv", batch, true);
+ *   pca.Update(batch);
+ * }
+ *
+ * arma::mat transformed;
+ * pca.Transform(newPoints, transformed);
+ * @endcode
+ *
+ * @tparam MatType Type of matrix to hold the components (and the batches).
+ */
+template<typename MatType = arma::mat>
+class IncrementalPCAType
+{
+ public:
+  //! The element type of the matrices.
+  typedef typename MatType::elem_type ElemType;
+  //! The type of the mean and of the singular values.
+  typedef typename GetColType<MatType>::type ColType;
+
+  /**
+   * Create the IncrementalPCAType object, with the given number of components
+   * to keep.
+   *
+   * @param rank Number of principal components to keep (0 means the
+   *     dimensionality of the data).
+   */
+  IncrementalPCAType(const size_t rank = 0);
+
+  /**
+   * Update the mean and the principal components with the given batch of
+   * points (one point per column).  All the batches must have the same
+   * dimensionality; a std::invalid_argument is thrown otherwise.
+   *
+   * @param batch Batch of points.
+   */
+  template<typename InMatType>
+  void Update(const InMatType& batch);
+
+  /**
+   * Project the given points onto the principal components, after centering
+   * them with the current mean.  A std::runtime_error is thrown if no points
+   * have been seen yet, and a std::invalid_argument if the points do not have
+   * the dimensionality of the data.  It is safe to pass the same matrix for
+   * both data and transformedData.
+   *
+   * @param data Points to transform.
+   * @param transformedData Matrix to store the transformed points into (one
+   *     row for each component).
+   */
+  template<typename InMatType, typename OutMatType>
+  void Transform(const InMatType& data, OutMatType& transformedData) const;
+
+  /**
+   * Return the fraction of the variance of the data seen so far that is
+   * retained by the given number of components (between 0 and 1).
+   *
+   * @param dimensions Number of components (at most Components().n_cols).
+   */
+  double VarianceRetained(const size_t dimensions) const;
+
+  //! Forget all the points seen so far.
+  void Reset();
+
+  //! Get the number of components to keep (0 means the dimensionality).
+  size_t Rank() const { return rank; }
+  //! Modify the number of components to keep (0 means the dimensionality).
+  //! This takes effect at the next update.
+  size_t& Rank() { return rank; }
+
+  //! Get the number of points seen so far.
+  size_t NumPoints() const { return numPoints; }
+
+  //! Get the mean of the points seen so far.
+  const ColType& Mean() const { return mean; }
+
+  //! Get the principal components (one per column, by decreasing variance).
+  const MatType& Components() const { return components; }
+
+  //! Get the singular values of the centered data seen so far.
+  const ColType& SingularValues() const { return singularValues; }
+
+  //! Get the variance of the data along each principal component (the
+  //! eigenvalues of the covariance matrix).
+  ColType Eigenvalues() const;
+
+  //! Serialize the IncrementalPCAType object.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! The number of components to keep.
+  size_t rank;
+  //! The number of points seen so far.
+  size_t numPoints;
+  //! The mean of the points seen so far.
+  ColType mean;
+  //! The sum of the squared deviations from the mean in each dimension, for
+  //! the total variance.
+  ColType squaredDeviations;
+  //! The principal components.
+  MatType components;
+  //! The singular values of the centered data.
+  ColType singularValues;
+};
+
+//! Incremental PCA with dense double-precision matrices.
+typedef IncrementalPCAType<arma::mat> IncrementalPCA;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "incremental_pca_impl.hpp"
+
+#endif
@@ -0,0 +1,172 @@
+/**
+ * @file methods/pca/incremental_pca_impl.hpp
+ *
+ * Implementation of the IncrementalPCAType class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PCA_INCREMENTAL_PCA_IMPL_HPP
+#define MLPACK_METHODS_PCA_INCREMENTAL_PCA_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "incremental_pca.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+IncrementalPCAType<MatType>::IncrementalPCAType(const size_t rank) :
+    rank(rank),
+    numPoints(0)
+{
+  // Nothing to do.
+}
+
+template<typename MatType>
+template<typename InMatType>
+void IncrementalPCAType<MatType>::Update(const InMatType& batchIn)
+{
+  MatType centered = arma::conv_to<MatType>::from(batchIn);
+  if (centered.n_cols == 0)
+    return;
+
+  if (numPoints > 0 && centered.n_rows != mean.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "IncrementalPCA::Update(): the batch has dimensionality "
+        << centered.n_rows << ", but the data seen so far has dimensionality "
+        << mean.n_elem << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const ColType batchMean = arma::mean(centered, 1);
+  centered.each_col() -= batchMean;
+
+  const size_t dimensionality = centered.n_rows;
+  const size_t batchSize = centered.n_cols;
+  const double n = (double) numPoints;
+  const double m = (double) batchSize;
+
+  MatType stacked;
+  if (numPoints == 0)
+  {
+    mean = batchMean;
+    squaredDeviations = arma::sum(arma::square(centered), 1);
+    stacked = std::move(centered);
+  }
+  else
+  {
+    // The previous points are represented by their components, scaled by the
+    // singular values; the last column accounts for the shift of the mean.
+    const ColType meanShift = batchMean - mean;
+    const ElemType shiftScale = (ElemType) std::sqrt(n * m / (n + m));
+
+    squaredDeviations += arma::sum(arma::square(centered), 1) +
+        (ElemType) (n * m / (n + m)) * arma::square(meanShift);
+
+    stacked.set_size(dimensionality, components.n_cols + batchSize + 1);
+    stacked.cols(0, components.n_cols - 1) = components *
+        arma::diagmat(singularValues);
+    stacked.cols(components.n_cols, components.n_cols + batchSize - 1) =
+        centered;
+    stacked.col(stacked.n_cols - 1) = shiftScale * meanShift;
+
+    mean += (ElemType) (m / (n + m)) * meanShift;
+  }
+  numPoints += batchSize;
+
+  // Only the left singular vectors are needed.
+  MatType v;
+  if (!arma::svd_econ(components, singularValues, v, stacked, 'l'))
+  {
+    Reset();
+    throw std::runtime_error("IncrementalPCA::Update(): SVD failed!");
+  }
+
+  const size_t keep = std::min((rank == 0) ? dimensionality : rank,
+      (size_t) singularValues.n_elem);
+  if (keep < components.n_cols)
+  {
+    components.shed_cols(keep, components.n_cols - 1);
+    singularValues.shed_rows(keep, singularValues.n_elem - 1);
+  }
+}
+
+template<typename MatType>
+template<typename InMatType, typename OutMatType>
+void IncrementalPCAType<MatType>::Transform(const InMatType& data,
+                                            OutMatType& transformedData) const
+{
+  if (numPoints == 0)
+  {
+    throw std::runtime_error("IncrementalPCA::Transform(): no points have "
+        "been seen yet; call Update() first!");
+  }
+
+  MatType centered = arma::conv_to<MatType>::from(data);
+  if (centered.n_rows != mean.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "IncrementalPCA::Transform(): the data has dimensionality "
+        << centered.n_rows << ", but the data seen so far has dimensionality "
+        << mean.n_elem << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  centered.each_col() -= mean;
+  transformedData = components.t() * centered;
+}
+
+template<typename MatType>
+double IncrementalPCAType<MatType>::VarianceRetained(
+    const size_t dimensions) const
+{
+  const double total = arma::accu(squaredDeviations);
+  if (total == 0.0)
+    return 1.0;
+  else if (dimensions == 0)
+    return 0.0;
+
+  const size_t last = std::min(dimensions, (size_t) singularValues.n_elem) - 1;
+  return std::min(1.0, (double) arma::accu(arma::square(
+      singularValues.subvec(0, last))) / total);
+}
+
+template<typename MatType>
+void IncrementalPCAType<MatType>::Reset()
+{
+  numPoints = 0;
+  mean.clear();
+  squaredDeviations.clear();
+  components.clear();
+  singularValues.clear();
+}
+
+template<typename MatType>
+typename IncrementalPCAType<MatType>::ColType
+IncrementalPCAType<MatType>::Eigenvalues() const
+{
+  if (numPoints < 2)
+    return ColType(singularValues.n_elem, arma::fill::zeros);
+
+  return arma::square(singularValues) / (ElemType) (numPoints - 1);
+}
+
+template<typename MatType>
+template<typename Archive>
+void IncrementalPCAType<MatType>::serialize(Archive& ar,
+                                            const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(rank));
+  ar(CEREAL_NVP(numPoints));
+  ar(CEREAL_NVP(mean));
+  ar(CEREAL_NVP(squaredDeviations));
+  ar(CEREAL_NVP(components));
+  ar(CEREAL_NVP(singularValues));
+}
+
+} // namespace mlpack
+
+#endif
@@ -36,7 +36,8 @@ BINDING_SHORT_DESC(
 // Long description.
 BINDING_LONG_DESC(
     "This program performs principal components analysis on the given dataset "
-    "using the exact, randomized, randomized block Krylov, or QUIC SVD method. "
+    "using the exact, randomized, randomized block Krylov, or QUIC SVD method, "
+    "or incrementally from batches of points. "
     "It will transform the data onto its principal components, optionally "
     "performing dimensionality reduction by ignoring the principal components "
     "with the smallest eigenvalues."
@@ -52,7 +53,12 @@ BINDING_LONG_DESC(
     "Multiple different decomposition techniques can be used.  The method to "
     "use can be specified with the " +
     PRINT_PARAM_STRING("decomposition_method") + " parameter, and it may take "
-    "the values 'exact', 'randomized', or 'quic'.");
+    "the values 'exact', 'randomized', 'randomized-block-krylov', 'quic', or "
+    "'incremental'.  The 'incremental' method updates the principal components "
+    "from batches of " + PRINT_PARAM_STRING("batch_size") + " points, so that "
+    "no centered copy of the whole dataset is built, and the memory used by "
+    "the decomposition only depends on the batch size; it cannot be used with "
+    + PRINT_PARAM_STRING("scale") + ".");
 
 // Example.
 BINDING_EXAMPLE(
@@ -83,7 +89,9 @@ PARAM_FLAG("scale", "If set, the data will be scaled before running PCA, such "
 
 PARAM_STRING_IN("decomposition_method", "Method used for the principal "
     "components analysis: 'exact', 'randomized', 'randomized-block-krylov', "
-    "'quic'.", "c", "exact");
+    "'quic', 'incremental'.", "c", "exact");
+PARAM_INT_IN("batch_size", "Number of points in each batch for the "
+    "'incremental' decomposition method.", "b", 10000);
 
 
 //! Run RunPCA on the specified dataset with the given decomposition method.
@@ -119,6 +127,58 @@ void RunPCA(util::Params& params,
       dataset.n_rows << " dimensions)." << endl;
 }
 
+//! Run incremental PCA on the specified dataset, one batch at a time.
+void RunIncrementalPCA(util::Params& params,
+                       util::Timers& timers,
+                       arma::mat& dataset,
+                       const size_t newDimension,
+                       const double varToRetain,
+                       const size_t batchSize)
+{
+  // If the variance to retain is given, all the components are needed to
+  // choose the dimensionality.
+  const bool useVariance = params.Has("var_to_retain");
+  if (useVariance && params.Has("new_dimensionality"))
+  {
+    Log::Warn << "New dimensionality (-d) ignored because --var_to_retain "
+        << "(-r) was specified." << endl;
+  }
+  IncrementalPCA p(useVariance ? dataset.n_rows : newDimension);
+
+  Log::Info << "Performing incremental PCA on dataset..." << endl;
+
+  timers.Start("pca");
+  for (size_t begin = 0; begin < dataset.n_cols; begin += batchSize)
+  {
+    const size_t end = std::min(begin + batchSize, (size_t) dataset.n_cols);
+    p.Update(dataset.cols(begin, end - 1));
+  }
+
+  size_t dimensions = p.Components().n_cols;
+  if (useVariance)
+  {
+    dimensions = 1;
+    while (dimensions < p.Components().n_cols &&
+           p.VarianceRetained(dimensions) < varToRetain)
+      ++dimensions;
+  }
+
+  // Transform the dataset one batch at a time too.
+  arma::mat transformed(dimensions, dataset.n_cols);
+  for (size_t begin = 0; begin < dataset.n_cols; begin += batchSize)
+  {
+    const size_t end = std::min(begin + batchSize, (size_t) dataset.n_cols);
+    arma::mat batch;
+    p.Transform(dataset.cols(begin, end - 1), batch);
+    transformed.cols(begin, end - 1) = batch.rows(0, dimensions - 1);
+  }
+  timers.Stop("pca");
+
+  Log::Info << (p.VarianceRetained(dimensions) * 100) << "% of variance "
+      << "retained (" << dimensions << " dimensions)." << endl;
+  dataset = std::move(transformed);
+}
+
 void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 {
   // Load input dataset.
@@ -130,7 +190,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 
   // Check decomposition method validity.
   RequireParamInSet<string>(params, "decomposition_method",
-      { "exact", "randomized", "randomized-block-krylov", "quic" }, true,
+      { "exact", "randomized", "randomized-block-krylov", "quic",
+        "incremental" }, true,
       "unknown decomposition method");
 
   // Find out what dimension we want.
@@ -150,6 +211,9 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   size_t newDimension = (params.Get<int>("new_dimensionality") == 0) ?
       dataset.n_rows : params.Get<int>("new_dimensionality");
 
+  RequireParamValue<int>(params, "batch_size", [](int x) { return x > 0; },
+      true, "batch size must be positive");
+
   // Get the options for running PCA.
   const bool scale = params.Has("scale");
   const double varToRetain = params.Get<double>("var_to_retain");
@@ -177,6 +241,17 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     RunPCA<QUICSVDPolicy>(params, timers, dataset, newDimension, scale,
         varToRetain);
   }
+  else if (decompositionMethod == "incremental")
+  {
+    if (scale)
+    {
+      Log::Fatal << "Cannot use --scale (-s) with the 'incremental' "
+          << "decomposition method!" << endl;
+    }
+
+    RunIncrementalPCA(params, timers, dataset, newDimension, varToRetain,
+        (size_t) params.Get<int>("batch_size"));
+  }
 
   // Now save the results.
   if (params.Has("output"))
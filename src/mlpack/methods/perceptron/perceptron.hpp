@@ -24,6 +24,13 @@ namespace mlpack {
  * network).  It converges if the supplied training dataset is linearly
  * separable.
  *
+ * By default, the weights are updated after each misclassified point.  If the
+ * batch size is set to more than one point (see BatchSize()), the points of
+ * each mini-batch are all scored with the same weights, with one matrix
+ * product, and the updates of the misclassified points are then applied
+ * together.  This usually needs a few more passes over the data, but each pass
+ * is much faster when there are many classes.
+ *
  * @tparam LearnPolicy Options of SimpleWeightUpdate and GradientDescent.
  * @tparam WeightInitializationPolicy Option of ZeroInitialization and
  *      RandomPerceptronInitialization.
@@ -193,13 +200,19 @@ class Perceptron
    * Serialize the perceptron.
    */
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */);
+  void serialize(Archive& ar, const uint32_t version);
 
   //! Get the maximum number of iterations.
   size_t MaxIterations() const { return maxIterations; }
   //! Modify the maximum number of iterations.
   size_t& MaxIterations() { return maxIterations; }
 
+  //! Get the number of points in each mini-batch during training (1 for the
+  //! classic online updates).
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of points in each mini-batch during training.
+  size_t& BatchSize() { return batchSize; }
+
   //! Get the number of classes this perceptron has been trained for.
   size_t NumClasses() const { return weights.n_cols; }
 
@@ -226,9 +239,22 @@ class Perceptron
                      const size_t numClasses,
                      const WeightsType& instanceWeights = WeightsType());
 
+  /**
+   * Compute the predicted class of the points with the given indices (from
+   * begin to end, inclusive) in the given dataset.  The points are scored by
+   * blocks, with one matrix product per block, in parallel.
+   */
+  void Predict(const MatType& data,
+               const size_t begin,
+               const size_t end,
+               arma::Row<size_t>& predictions) const;
+
   //! The maximum number of iterations during training.
   size_t maxIterations;
 
+  //! The number of points in each mini-batch during training.
+  size_t batchSize;
+
   /**
    * Stores the weights for each of the input class labels.  Each column
    * corresponds to the weights for one class label, and each row corresponds to
@@ -243,6 +269,11 @@ class Perceptron
 
 } // namespace mlpack
 
+CEREAL_TEMPLATE_CLASS_VERSION((typename LearnPolicy,
+    typename WeightInitializationPolicy, typename MatType),
+    (mlpack::Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>),
+    (1));
+
 #include "perceptron_impl.hpp"
 
 #endif
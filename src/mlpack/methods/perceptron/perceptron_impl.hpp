@@ -29,7 +29,8 @@ Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Perceptron(
     const size_t numClasses,
     const size_t dimensionality,
     const size_t maxIterations) :
-    maxIterations(maxIterations)
+    maxIterations(maxIterations),
+    batchSize(1)
 {
   WeightInitializationPolicy wip;
   wip.Initialize(weights, biases, dimensionality, numClasses);
@@ -55,7 +56,8 @@ Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Perceptron(
     const arma::Row<size_t>& labels,
     const size_t numClasses,
     const size_t maxIterations) :
-    maxIterations(maxIterations)
+    maxIterations(maxIterations),
+    batchSize(1)
 {
   // Start training.
   TrainInternal<false, arma::Row<typename MatType::elem_type>>(data, labels,
@@ -85,7 +87,8 @@ Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Perceptron(
     const size_t maxIterations,
     const typename std::enable_if<
         arma::is_arma_type<WeightsType>::value>::type*) :
-    maxIterations(maxIterations)
+    maxIterations(maxIterations),
+    batchSize(1)
 {
   // Start training.
   TrainInternal<true>(data, labels, numClasses, instanceWeights);
@@ -116,7 +119,8 @@ Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Perceptron(
     const WeightsType& instanceWeights,
     const typename std::enable_if<
         arma::is_arma_type<WeightsType>::value>::type*) :
-    maxIterations(other.maxIterations)
+    maxIterations(other.maxIterations),
+    batchSize(other.batchSize)
 {
   TrainInternal<true>(data, labels, numClasses, instanceWeights);
 }
@@ -224,14 +228,16 @@ void Perceptron<
     wip.Initialize(weights, biases, data.n_rows, numClasses);
   }
 
-  size_t j, i = 0;
+  size_t i = 0;
   bool converged = false;
-  size_t tempLabel;
-  arma::uword maxIndexRow = 0, maxIndexCol = 0;
-  arma::Mat<ElemType> tempLabelMat;
+  arma::Row<size_t> predictions;
 
   LearnPolicy LP;
 
+  // With one point per batch, this is the classic perceptron, where each point
+  // is scored after the updates of the previous point.
+  const size_t pointsPerBatch = std::max(batchSize, (size_t) 1);
+
   while ((i < maxIterations) && (!converged))
   {
     // This outer loop is for each iteration, and we use the 'converged'
@@ -239,31 +245,35 @@ void Perceptron<
     ++i;
     converged = true;
 
-    // Now this inner loop is for going through the dataset in each iteration.
-    for (j = 0; j < data.n_cols; ++j)
+    // Now this inner loop is for going through the dataset in each iteration,
+    // one batch at a time.
+    for (size_t begin = 0; begin < data.n_cols; begin += pointsPerBatch)
     {
-      // Multiply for each variable and check whether the current weight vector
-      // correctly classifies this.
-      tempLabelMat = weights.t() * data.col(j) + biases;
+      const size_t end = std::min(begin + pointsPerBatch,
+          (size_t) data.n_cols) - 1;
 
-      tempLabelMat.max(maxIndexRow, maxIndexCol);
+      // Check whether the current weights correctly classify each point of the
+      // batch.
+      Predict(data, begin, end, predictions);
 
-      // Check whether prediction is correct.
-      if (maxIndexRow != labels(0, j))
+      for (size_t j = begin; j <= end; ++j)
       {
-        // Due to incorrect prediction, convergence set to false.
-        converged = false;
-        tempLabel = labels(0, j);
-
-        // Send maxIndexRow for knowing which weight to update, send j to know
-        // the value of the vector to update it with.  Send tempLabel to know
-        // the correct class.
-        if (HasWeights)
-          LP.UpdateWeights(data.col(j), weights, biases, maxIndexRow, tempLabel,
-              (typename MatType::elem_type) instanceWeights(j));
-        else
-          LP.UpdateWeights(data.col(j), weights, biases, maxIndexRow,
-              tempLabel);
+        const size_t predictedLabel = predictions[j - begin];
+        if (predictedLabel != labels(0, j))
+        {
+          // Due to incorrect prediction, convergence set to false.
+          converged = false;
+
+          // Send predictedLabel for knowing which weight to update, send j to
+          // know the value of the vector to update it with.  Send the label to
+          // know the correct class.
+          if (HasWeights)
+            LP.UpdateWeights(data.col(j), weights, biases, predictedLabel,
+                labels(0, j), (typename MatType::elem_type) instanceWeights(j));
+          else
+            LP.UpdateWeights(data.col(j), weights, biases, predictedLabel,
+                labels(0, j));
+        }
       }
     }
   }
@@ -316,16 +326,58 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Classify(
   util::CheckSameDimensionality(test, weights.n_rows, "Perceptron::Classify()",
       "points");
 
-  arma::Col<ElemType> tempLabelMat;
-  arma::uword maxIndex = 0;
-  predictedLabels.set_size(test.n_cols);
+  if (test.n_cols == 0)
+  {
+    predictedLabels.clear();
+    return;
+  }
+
+  Predict(test, 0, test.n_cols - 1, predictedLabels);
+}
 
-  // Could probably be faster if done in batch.
-  for (size_t i = 0; i < test.n_cols; ++i)
+/**
+ * Compute the predicted class of the points with the given indices, by blocks.
+ */
+template<
+    typename LearnPolicy,
+    typename WeightInitializationPolicy,
+    typename MatType
+>
+void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Predict(
+    const MatType& data,
+    const size_t begin,
+    const size_t end,
+    arma::Row<size_t>& predictions) const
+{
+  predictions.set_size(end - begin + 1);
+
+  // A single point is scored directly, which is the common case during the
+  // classic online training.
+  if (begin == end)
   {
-    tempLabelMat = weights.t() * test.col(i) + biases;
-    tempLabelMat.max(maxIndex);
-    predictedLabels(i) = maxIndex;
+    arma::uword maxIndex = 0;
+    arma::Col<ElemType> scores = weights.t() * data.col(begin) + biases;
+    scores.max(maxIndex);
+    predictions[0] = maxIndex;
+    return;
+  }
+
+  // Each block of points is scored with one matrix product; ties are broken
+  // towards the first class, like with a single point.
+  const size_t blockSize = 64;
+  const size_t numBlocks = (end - begin + blockSize) / blockSize;
+
+  #pragma omp parallel for schedule(static)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t blockBegin = begin + b * blockSize;
+    const size_t blockEnd = std::min(blockBegin + blockSize - 1, end);
+
+    arma::Mat<ElemType> scores = weights.t() * data.cols(blockBegin, blockEnd);
+    scores.each_col() += biases;
+    const arma::urowvec maxIndices = arma::index_max(scores, 0);
+    for (size_t k = 0; k < maxIndices.n_elem; ++k)
+      predictions[blockBegin - begin + k] = maxIndices[k];
   }
 }
 
@@ -349,11 +401,16 @@ template<typename LearnPolicy,
 template<typename Archive>
 void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::serialize(
     Archive& ar,
-    const uint32_t /* version */)
+    const uint32_t version)
 {
-  // We just need to serialize the maximum number of iterations, the weights,
-  // and the biases.
+  // We just need to serialize the maximum number of iterations, the batch
+  // size, the weights, and the biases.
   ar(CEREAL_NVP(maxIterations));
+  if (version > 0)
+    ar(CEREAL_NVP(batchSize));
+  else if (cereal::is_loading<Archive>())
+    batchSize = 1;
+
   ar(CEREAL_NVP(weights));
   ar(CEREAL_NVP(biases));
 }
@@ -45,7 +45,10 @@ BINDING_LONG_DESC(
     "(specified using the " + PRINT_PARAM_STRING("max_iterations") +
     " parameter), if the data supplied is linearly separable.  The perceptron "
     "is parameterized by a matrix of weight vectors that denote the numerical "
-    "weights of the neural network."
+    "weights of the neural network.  By default the weights are updated after "
+    "each misclassified point; with the " + PRINT_PARAM_STRING("batch_size") +
+    " parameter, the points are scored by mini-batches, which is much faster "
+    "for datasets with many classes."
     "\n\n"
     "This program allows loading a perceptron from a model (via the " +
     PRINT_PARAM_STRING("input_model") + " parameter) or training a perceptron "
@@ -129,6 +132,9 @@ PARAM_UROW_IN("labels", "A matrix containing labels for the training set.",
     "l");
 PARAM_INT_IN("max_iterations", "The maximum number of iterations the "
     "perceptron is to be run", "n", 1000);
+PARAM_INT_IN("batch_size", "The number of points in each mini-batch during "
+    "training; the points of a mini-batch are scored together before the "
+    "weights are updated.", "b", 1);
 
 // Model loading/saving.
 PARAM_MODEL_IN(PerceptronModel, "input_model", "Input perceptron model.", "m");
@@ -144,6 +150,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 {
   // First, get all parameters and validate them.
   const size_t maxIterations = (size_t) params.Get<int>("max_iterations");
+  const size_t batchSize = (size_t) params.Get<int>("batch_size");
 
   // We must either load a model or train a model.
   RequireAtLeastOnePassed(params, { "input_model", "training" }, true);
@@ -157,6 +164,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   // Check parameter validity.
   RequireParamValue<int>(params, "max_iterations", [](int x) { return x >= 0; },
       true, "maximum number of iterations must be nonnegative");
+  RequireParamValue<int>(params, "batch_size", [](int x) { return x > 0; },
+      true, "batch size must be positive");
 
   // Now, load our model, if there is one.
   PerceptronModel* p;
@@ -247,7 +256,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     {
       // Create and train the classifier.
       timers.Start("training");
-      p->P() = Perceptron<>(trainingData, labels, numClasses, maxIterations);
+      p->P().BatchSize() = batchSize;
+      p->P().Train(trainingData, labels, numClasses, maxIterations);
       timers.Stop("training");
     }
     else
@@ -274,6 +284,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
       // Now train.
       timers.Start("training");
       p->P().MaxIterations() = maxIterations;
+      p->P().BatchSize() = batchSize;
       p->P().Train(trainingData, labels.t(), numClasses);
       timers.Stop("training");
     }
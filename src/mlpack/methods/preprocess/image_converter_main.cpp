@@ -40,7 +40,11 @@ BINDING_LONG_DESC(
     PRINT_PARAM_STRING("height") + " width " + PRINT_PARAM_STRING("width")
     + " and channel " + PRINT_PARAM_STRING("channels") + " of the images that"
     " needs to be loaded; otherwise, these parameters will be automatically"
-    " detected from the image."
+    " detected from the image.  If the height and width are given, every "
+    "image is resized to that size (so images of different sizes can be "
+    "loaded together), and the images are converted to the given number of "
+    "channels (between 1 and 4; 3, for RGB, by default).  The images are "
+    "decoded in parallel."
     "\n"
     "There are other options too, that can be specified such as " +
     PRINT_PARAM_STRING("quality")
@@ -93,14 +97,33 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& /* timers */)
 
   if (!params.Has("save"))
   {
-    ReportIgnoredParam(params, "width", "Width of image is determined from "
-        "file.");
-    ReportIgnoredParam(params, "height", "Height of image is determined from "
-        "file.");
-    ReportIgnoredParam(params, "channels", "Number of channels determined from "
-        "file.");
+    // If the size is given, every image is resized to it.
+    RequireNoneOrAllPassed(params, { "width", "height" }, true, "both the "
+        "width and the height are needed to resize the images");
+    const bool resize = params.Has("width");
+    if (resize)
+    {
+      RequireParamValue<int>(params, "width", [](int x) { return x > 0; },
+          true, "width must be positive");
+      RequireParamValue<int>(params, "height", [](int x) { return x > 0; },
+          true, "height must be positive");
+    }
+    if (params.Has("channels"))
+    {
+      RequireParamValue<int>(params, "channels",
+          [](int x) { return x >= 1 && x <= 4; }, true,
+          "channels must be between 1 and 4");
+    }
+
     data::ImageInfo info;
-    Load(fileNames, out, info, true);
+    if (resize)
+    {
+      info.Width() = params.Get<int>("width");
+      info.Height() = params.Get<int>("height");
+    }
+    if (params.Has("channels"))
+      info.Channels() = params.Get<int>("channels");
+    Load(fileNames, out, info, true, resize);
     if (params.Has("output"))
       params.Get<arma::mat>("output") = std::move(out);
   }
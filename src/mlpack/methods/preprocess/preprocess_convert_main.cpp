@@ -0,0 +1,131 @@
+/**
+ * @file methods/preprocess/preprocess_convert_main.cpp
+ *
+ * A utility that converts a dataset to mlpack's native binary dataset format,
+ * so that it can be memory-mapped instead of parsed.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#undef BINDING_NAME
+#define BINDING_NAME preprocess_convert
+
+#include <mlpack/core/util/mlpack_main.hpp>
+
+// Program Name.
+BINDING_USER_NAME("Convert Dataset");
+
+// Short description.
+BINDING_SHORT_DESC(
+    "A utility to convert a dataset to mlpack's native binary dataset format "
+    "(.mlds), which can be memory-mapped instead of parsed.");
+
+// Long description.
+BINDING_LONG_DESC(
+    "This utility loads a dataset (in any format mlpack can load, including "
+    "CSV and ARFF files with categorical dimensions) and saves it, with the "
+    "type of each dimension, in mlpack's native binary dataset format.  The "
+    "output file, specified with " + PRINT_PARAM_STRING("output_file") +
+    ", must have the .mlds extension.  Loading the converted dataset does "
+    "not parse anything, and data::MappedDataset maps it into memory without "
+    "copying it."
+    "\n\n"
+    "The elements are stored with the type given by " +
+    PRINT_PARAM_STRING("element_type") + ", which must be one of 'double', "
+    "'float', 'int8', 'int16', 'int32', 'int64', 'uint8', 'uint16', 'uint32' "
+    "or 'uint64'; a converted dataset can be loaded into a matrix of any "
+    "element type.  Converted files are only valid on machines with the same "
+    "byte order.");
+
+// Example.
+BINDING_EXAMPLE(
+    "For example, to convert the dataset " + PRINT_DATASET("dataset") +
+    " to " + PRINT_DATASET("converted") + " (which should have the .mlds "
+    "extension), storing single-precision elements, we could run:"
+    "\n\n" +
+    PRINT_CALL("preprocess_convert", "input_file", "dataset", "output_file",
+        "converted", "element_type", "float"));
+
+// See also...
+BINDING_SEE_ALSO("@preprocess_imputer", "#preprocess_imputer");
+BINDING_SEE_ALSO("@preprocess_describe", "#preprocess_describe");
+
+PARAM_STRING_IN_REQ("input_file", "File containing the dataset to convert.",
+    "i");
+PARAM_STRING_IN_REQ("output_file", "File to save the converted dataset to "
+    "(with the .mlds extension).", "o");
+PARAM_STRING_IN("element_type", "Type of the elements of the converted "
+    "dataset.", "e", "double");
+
+using namespace mlpack;
+using namespace mlpack::util;
+using namespace std;
+
+// Save the given dataset with elements of type eT.
+template<typename eT>
+void SaveConverted(const string& outputFile,
+                   const arma::mat& dataset,
+                   const data::DatasetInfo& info)
+{
+  data::MappedDataset<eT>::Save(outputFile,
+      arma::conv_to<arma::Mat<eT>>::from(dataset), info);
+}
+
+void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
+{
+  const string inputFile = params.Get<string>("input_file");
+  const string outputFile = params.Get<string>("output_file");
+  const string elementType = params.Get<string>("element_type");
+
+  RequireParamInSet<string>(params, "element_type", { "double", "float",
+      "int8", "int16", "int32", "int64", "uint8", "uint16", "uint32",
+      "uint64" }, true, "unknown element type");
+
+  if (data::Extension(outputFile) != "mlds")
+  {
+    Log::Fatal << "The output file '" << outputFile << "' must have the .mlds "
+        << "extension!" << endl;
+  }
+
+  // Only some formats can hold categorical dimensions.
+  arma::mat dataset;
+  data::DatasetInfo info;
+  const string extension = data::Extension(inputFile);
+  if (extension == "csv" || extension == "tsv" || extension == "txt" ||
+      extension == "arff" || extension == "mlds")
+  {
+    data::Load(inputFile, dataset, info, true, true);
+  }
+  else
+  {
+    data::Load(inputFile, dataset, true, true);
+    info = data::DatasetInfo(dataset.n_rows);
+  }
+
+  timers.Start("converting_data");
+  if (elementType == "double")
+    SaveConverted<double>(outputFile, dataset, info);
+  else if (elementType == "float")
+    SaveConverted<float>(outputFile, dataset, info);
+  else if (elementType == "int8")
+    SaveConverted<int8_t>(outputFile, dataset, info);
+  else if (elementType == "int16")
+    SaveConverted<int16_t>(outputFile, dataset, info);
+  else if (elementType == "int32")
+    SaveConverted<int32_t>(outputFile, dataset, info);
+  else if (elementType == "int64")
+    SaveConverted<int64_t>(outputFile, dataset, info);
+  else if (elementType == "uint8")
+    SaveConverted<uint8_t>(outputFile, dataset, info);
+  else if (elementType == "uint16")
+    SaveConverted<uint16_t>(outputFile, dataset, info);
+  else if (elementType == "uint32")
+    SaveConverted<uint32_t>(outputFile, dataset, info);
+  else
+    SaveConverted<uint64_t>(outputFile, dataset, info);
+  timers.Stop("converting_data");
+}
@@ -46,7 +46,16 @@ BINDING_LONG_DESC(
     "specific dimension to analyze if there are too many dimensions. The " +
     PRINT_PARAM_STRING("population") + " parameter can be specified when the "
     "dataset should be considered as a population.  Otherwise, the dataset "
-    "will be considered as a sample.");
+    "will be considered as a sample."
+    "\n\n"
+    "Datasets that do not fit in memory can be described by giving their file "
+    "with the " + PRINT_PARAM_STRING("input_file") + " parameter instead of " +
+    PRINT_PARAM_STRING("input") + ": the file is read " +
+    PRINT_PARAM_STRING("chunk_size") + " points at a time, and the statistics "
+    "are computed in one pass, in constant memory.  The median of each "
+    "dimension can't be computed that way, so it is not printed (unless " +
+    PRINT_PARAM_STRING("row_major") + " is given, since each point is then "
+    "described on its own).");
 
 // Example.
 BINDING_EXAMPLE(
@@ -70,7 +79,11 @@ BINDING_SEE_ALSO("@preprocess_imputer", "#preprocess_imputer");
 BINDING_SEE_ALSO("@preprocess_split", "#preprocess_split");
 
 // Define parameters for data.
-PARAM_MATRIX_IN_REQ("input", "Matrix containing data,", "i");
+PARAM_MATRIX_IN("input", "Matrix containing data,", "i");
+PARAM_STRING_IN("input_file", "File containing data to read in chunks instead "
+    "of loading it at once.", "f", "");
+PARAM_INT_IN("chunk_size", "Number of points read at a time from the input "
+    "file.", "c", 10000);
 PARAM_INT_IN("dimension", "Dimension of the data. Use this to specify a "
     "dimension", "d", 0);
 PARAM_INT_IN("precision", "Precision of the output statistics.", "p", 4);
@@ -82,108 +95,21 @@ PARAM_FLAG("row_major", "If specified, the program will calculate statistics "
     "across rows, not across columns.  (Remember that in mlpack, a column "
     "represents a point, so this option is generally not necessary.)", "r");
 
-/**
- * Calculates the sum of deviations to the Nth Power.
- *
- * @param input Vector that captures a dimension of a dataset.
- * @param rowMean Mean of the given vector.
- * @param n Degree of power.
- * @return sum of nth power deviations.
- */
-double SumNthPowerDeviations(const arma::rowvec& input,
-                             const double& fMean,
-                             size_t n)
-{
-  return sum(pow(input - fMean, static_cast<double>(n)));
-}
-
-/**
- * Calculates Skewness of the given vector.
- *
- * @param input Vector that captures a dimension of a dataset
- * @param rowStd Standard Deviation of the given vector.
- * @param rowMean Mean of the given vector.
- * @return Skewness of the given vector.
- */
-double Skewness(const arma::rowvec& input,
-                const double& fStd,
-                const double& fMean,
-                const bool population)
-{
-  double skewness = 0;
-  const double S3 = pow(fStd, 3);
-  const double M3 = SumNthPowerDeviations(input, fMean, 3);
-  const double n = input.n_elem;
-  if (population)
-  {
-    // Calculate population skewness
-    skewness = M3 / (n * S3);
-  }
-  else
-  {
-    // Calculate sample skewness.
-    skewness = n * M3 / ((n - 1) * (n - 2) * S3);
-  }
-  return skewness;
-}
-
-/**
- * Calculates excess kurtosis of the given vector.
- *
- * @param input Vector that captures a dimension of a dataset
- * @param rowStd Standard Deviation of the given vector.
- * @param rowMean Mean of the given vector.
- * @return Kurtosis of the given vector.
- */
-double Kurtosis(const arma::rowvec& input,
-                const double& fStd,
-                const double& fMean,
-                const bool population)
-{
-  double kurtosis = 0;
-  const double M4 = SumNthPowerDeviations(input, fMean, 4);
-  const double n = input.n_elem;
-  if (population)
-  {
-    // Calculate population excess kurtosis.
-    const double M2 = SumNthPowerDeviations(input, fMean, 2);
-    kurtosis = n * (M4 / pow(M2, 2)) - 3;
-  }
-  else
-  {
-    // Calculate sample excess kurtosis.
-    const double S4 = pow(fStd, 4);
-    const double norm3 = (3 * (n - 1) * (n - 1)) / ((n - 2) * (n - 3));
-    const double normC = (n * (n + 1)) / ((n - 1) * (n - 2) * (n - 3));
-    const double normM = M4 / S4;
-    kurtosis = normC * normM - norm3;
-  }
-  return kurtosis;
-}
-
-/**
- * Calculates standard error of standard deviation.
- *
- * @param input Vector that captures a dimension of a dataset
- * @param rowStd Standard Deviation of the given vector.
- * @return Standard error of the stanrdard devation of the given vector.
- */
-double StandardError(const size_t size, const double& fStd)
-{
-  return fStd / sqrt(size);
-}
-
 void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 {
+  RequireOnlyOnePassed(params, { "input", "input_file" }, true);
+  ReportIgnoredParam(params, {{ "input_file", false }}, "chunk_size");
+  RequireParamValue<int>(params, "chunk_size", [](int x) { return x > 0; },
+      true, "chunk size must be positive");
+  RequireParamValue<int>(params, "dimension", [](int x) { return x >= 0; },
+      true, "dimension must not be negative");
+
   const size_t dimension = static_cast<size_t>(params.Get<int>("dimension"));
   const size_t precision = static_cast<size_t>(params.Get<int>("precision"));
   const size_t width = static_cast<size_t>(params.Get<int>("width"));
   const bool population = params.Has("population");
   const bool rowMajor = params.Has("row_major");
 
-  // Load the data.
-  arma::mat& data = params.Get<arma::mat>("input");
-
   timers.Start("statistics");
   // Print the headers.
   Log::Info << setw(width) << "dim" << setw(width) << "var" << setw(width)
@@ -192,47 +118,138 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
       << "max" << setw(width) << "range" << setw(width)
       << "skew" << setw(width) << "kurt" << setw(width) << "SE" << endl;
 
-  // Lambda function to print out the results.
-  auto PrintStatResults = [&](size_t dim, bool rowMajor)
+  // Lambda function to print out the results of the dimensions described by
+  // the given accumulator, starting with the given dimension.  The medians are
+  // not printed if they are empty.
+  auto PrintStatResults = [&](const size_t firstDim,
+                              const MomentsAccumulator& moments,
+                              const arma::vec& medians)
   {
-    arma::rowvec feature;
-    if (rowMajor)
-      feature = ConvTo<arma::rowvec>::From(data.col(dim));
-    else
-      feature = data.row(dim);
-
     // f at the front of the variable names means "feature".
-    const double fMax = max(feature);
-    const double fMin = min(feature);
-    const double fMean = arma::mean(feature);
-    const double fStd = arma::stddev(feature, population);
-
-    // Print statistics of the given dimension.
-    Log::Info << setprecision(precision) << setw(width) << dim <<
-        setw(width) << arma::var(feature, population) <<
-        setw(width) << fMean <<
-        setw(width) << fStd <<
-        setw(width) << arma::median(feature) <<
-        setw(width) << fMin <<
-        setw(width) << fMax <<
-        setw(width) << (fMax - fMin) <<
-        setw(width) << Skewness(feature, fStd, fMean, population) <<
-        setw(width) << Kurtosis(feature, fStd, fMean, population) <<
-        setw(width) << StandardError(feature.n_elem, fStd) << endl;
+    const arma::vec fVar = moments.Variance(population);
+    const arma::vec fStd = moments.Stddev(population);
+    const arma::vec fSkew = moments.Skewness(population);
+    const arma::vec fKurt = moments.Kurtosis(population);
+    for (size_t i = 0; i < moments.Dimensionality(); ++i)
+    {
+      const double fMax = moments.Max()[i];
+      const double fMin = moments.Min()[i];
+
+      // Print statistics of the given dimension.
+      Log::Info << setprecision(precision) << setw(width) << firstDim + i <<
+          setw(width) << fVar[i] <<
+          setw(width) << moments.Mean()[i] <<
+          setw(width) << fStd[i];
+      if (medians.n_elem > 0)
+        Log::Info << setw(width) << medians[i];
+      else
+        Log::Info << setw(width) << "-";
+      Log::Info << setw(width) << fMin <<
+          setw(width) << fMax <<
+          setw(width) << (fMax - fMin) <<
+          setw(width) << fSkew[i] <<
+          setw(width) << fKurt[i] <<
+          setw(width) << fStd[i] / sqrt(moments.Count()) << endl;
+    }
   };
 
-  // If the user specified dimension, describe statistics of the given
-  // dimension. If a dimension is not specified, describe all dimensions.
-  if (params.Has("dimension"))
+  // Describe the given points, one per column; if the user specified a
+  // dimension, only that dimension is described.  One pass over the points
+  // computes all of the statistics but the median.
+  auto Describe = [&](const size_t firstDim, const arma::mat& points,
+                      const bool withMedians)
   {
-    PrintStatResults(dimension, rowMajor);
+    if (params.Has("dimension") && dimension >= points.n_rows)
+    {
+      Log::Fatal << "Dimension " << dimension << " is out of range; the data "
+          << "has " << points.n_rows << " dimensions!" << endl;
+    }
+
+    MomentsAccumulator moments;
+    arma::vec medians;
+    if (params.Has("dimension"))
+    {
+      moments.Update(points.row(dimension));
+      if (withMedians)
+        medians = arma::median(points.row(dimension), 1);
+      PrintStatResults(dimension, moments, medians);
+    }
+    else
+    {
+      moments.Update(points);
+      if (withMedians)
+        medians = arma::median(points, 1);
+      PrintStatResults(firstDim, moments, medians);
+    }
+  };
+
+  if (params.Has("input"))
+  {
+    arma::mat& data = params.Get<arma::mat>("input");
+    if (rowMajor)
+      Describe(0, data.t(), true);
+    else
+      Describe(0, data, true);
   }
   else
   {
-    const size_t dimensions = rowMajor ? data.n_cols : data.n_rows;
-    for (size_t i = 0; i < dimensions; ++i)
+    // Only one chunk of the file is held in memory at a time.
+    ChunkedReader<> reader(params.Get<string>("input_file"));
+    const size_t chunkSize = (size_t) params.Get<int>("chunk_size");
+    arma::mat chunk;
+    if (rowMajor)
+    {
+      // Each point is complete in its chunk, so the chunks are described one
+      // after the other.
+      size_t firstPoint = 0;
+      while (reader.Read(chunk, chunkSize) > 0)
+      {
+        if (!params.Has("dimension"))
+        {
+          Describe(firstPoint, chunk.t(), true);
+        }
+        else if (dimension >= firstPoint &&
+                 dimension < firstPoint + chunk.n_cols)
+        {
+          const arma::mat point = chunk.col(dimension - firstPoint).t();
+          MomentsAccumulator moments;
+          moments.Update(point);
+          PrintStatResults(dimension, moments, arma::median(point, 1));
+        }
+        firstPoint += chunk.n_cols;
+      }
+
+      if (params.Has("dimension") && dimension >= firstPoint)
+      {
+        Log::Fatal << "Dimension " << dimension << " is out of range; the data "
+            << "has " << firstPoint << " points!" << endl;
+      }
+    }
+    else
+    {
+      MomentsAccumulator moments;
+      while (reader.Read(chunk, chunkSize) > 0)
+      {
+        if (params.Has("dimension") && dimension >= chunk.n_rows)
+        {
+          Log::Fatal << "Dimension " << dimension << " is out of range; the "
+              << "data has " << chunk.n_rows << " dimensions!" << endl;
+        }
+
+        if (params.Has("dimension"))
+          moments.Update(chunk.row(dimension));
+        else
+          moments.Update(chunk);
+      }
+
+      PrintStatResults(params.Has("dimension") ? dimension : 0, moments,
+          arma::vec());
+    }
+
+    if (reader.SkippedLines() > 0)
     {
-      PrintStatResults(i, rowMajor);
+      Log::Warn << reader.SkippedLines() << " lines of the input file were "
+          << "skipped because they could not be read." << endl;
     }
   }
   timers.Stop("statistics");
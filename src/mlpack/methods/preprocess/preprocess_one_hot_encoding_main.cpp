@@ -34,7 +34,15 @@ BINDING_LONG_DESC(
     PRINT_PARAM_STRING("dimensions") + " will be one-hot encoded."
     "\n\n"
     "The output matrix with encoded features may be saved with the " +
-    PRINT_PARAM_STRING("output") + " parameters.");
+    PRINT_PARAM_STRING("output") + " parameters."
+    "\n\n"
+    "Since one-hot encoded dimensions are mostly zeros, the encoded features "
+    "may instead be saved as a sparse matrix with the " +
+    PRINT_PARAM_STRING("sparse_output") + " parameter, which is the name of a "
+    "file to save a coordinate list to (where each line gives the index of a "
+    "point, a dimension, and the nonzero value of the point in that "
+    "dimension).  The dense encoded matrix is then never built, so this is "
+    "preferable for categorical dimensions with many levels.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -58,6 +66,9 @@ BINDING_SEE_ALSO("One-hot encoding on Wikipedia",
 PARAM_MATRIX_AND_INFO_IN_REQ("input", "Matrix containing data.", "i");
 PARAM_MATRIX_OUT("output", "Matrix to save one-hot encoded features "
     "data to.", "o");
+PARAM_STRING_IN("sparse_output", "File to save the one-hot encoded features "
+    "to as a sparse coordinate list (may be given instead of 'output').", "s",
+    "");
 
 PARAM_VECTOR_IN(int, "dimensions", "Index of dimensions that need to be one-hot"
     " encoded (if unspecified, all categorical dimensions are one-hot "
@@ -123,13 +134,30 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& /* timers */)
       copyIndices[i] = (size_t)indices[i];
     }
 
-    arma::mat output;
-    data::OneHotEncoding(data, (arma::Col<size_t>)(copyIndices), output);
+    if (params.Has("sparse_output"))
+    {
+      arma::sp_mat sparseOutput;
+      data::OneHotEncoding(data, (arma::Col<size_t>)(copyIndices),
+          sparseOutput);
+      data::Save(params.Get<string>("sparse_output"), sparseOutput, true);
+    }
+
     if (params.Has("output"))
+    {
+      arma::mat output;
+      data::OneHotEncoding(data, (arma::Col<size_t>)(copyIndices), output);
       params.Get<arma::mat>("output") = std::move(output);
+    }
   }
-  else if (params.Has("output"))
+  else
   {
-    params.Get<arma::mat>("output") = data; // Copy input to output.
+    if (params.Has("sparse_output"))
+    {
+      data::Save(params.Get<string>("sparse_output"), arma::sp_mat(data),
+          true);
+    }
+
+    if (params.Has("output"))
+      params.Get<arma::mat>("output") = data; // Copy input to output.
   }
 }
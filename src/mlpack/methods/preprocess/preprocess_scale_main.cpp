@@ -47,7 +47,16 @@ BINDING_LONG_DESC(
     "\n\n"
     "The model to scale features can be saved using " +
     PRINT_PARAM_STRING("output_model") + " and later can be loaded back using"
-    + PRINT_PARAM_STRING("input_model") + ".");
+    + PRINT_PARAM_STRING("input_model") + "."
+    "\n\n"
+    "A dataset too large to fit in memory can be fitted in parts: if " +
+    PRINT_PARAM_STRING("partial_fit") + " is given, the scaler of " +
+    PRINT_PARAM_STRING("input_model") + " is updated with the points of " +
+    PRINT_PARAM_STRING("input") + " (as if it had been fitted on all the "
+    "points at once) before it is applied.  A model fitted on another part of "
+    "the dataset (for instance, by another process) may also be merged into "
+    "the model with " + PRINT_PARAM_STRING("merge_model") + "; it must have "
+    "the same scaler method.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -103,9 +112,13 @@ PARAM_INT_IN("min_value", "Starting value of range for min_max_scaler.",
 PARAM_INT_IN("max_value", "Ending value of range for min_max_scaler.",
     "e", 1);
 PARAM_FLAG("inverse_scaling", "Inverse Scaling to get original dataset", "f");
+PARAM_FLAG("partial_fit", "Update the scaler of 'input_model' with the points "
+    "of 'input' before applying it.", "p");
 // Loading/saving of a model.
 PARAM_MODEL_IN(ScalingModel, "input_model", "Input Scaling model.", "m");
 PARAM_MODEL_OUT(ScalingModel, "output_model", "Output scaling model.", "M");
+PARAM_MODEL_IN(ScalingModel, "merge_model", "Scaling model fitted on other "
+    "points to merge into the model.", "g");
 
 void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 {
@@ -125,6 +138,9 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     "standard_scaler", "max_abs_scaler", "mean_normalization", "pca_whitening",
     "zca_whitening" }, true, "unknown scaler type");
 
+  // Only a given model can be updated.
+  ReportIgnoredParam(params, {{ "input_model", false }}, "partial_fit");
+
   // Load the data.
   arma::mat& input = params.Get<arma::mat>("input");
   arma::mat output;
@@ -133,6 +149,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   if (params.Has("input_model"))
   {
     m = params.Get<ScalingModel*>("input_model");
+    if (params.Has("partial_fit"))
+      m->PartialFit(input);
   }
   else
   {
@@ -177,6 +195,20 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     }
   }
 
+  if (params.Has("merge_model"))
+  {
+    try
+    {
+      m->Merge(*params.Get<ScalingModel*>("merge_model"));
+    }
+    catch (std::exception& e)
+    {
+      if (!params.Has("input_model"))
+        delete m;
+      throw;
+    }
+  }
+
   if (!params.Has("inverse_scaling"))
   {
     m->Transform(input, output);
@@ -84,6 +84,25 @@ class ScalingModel
   template<typename MatType>
   void Fit(const MatType& input);
 
+  /**
+   * Update the scaler with another batch of points, as if it had been fitted
+   * on every batch at once; if the model has not been fitted, this is the same
+   * as Fit().
+   *
+   * @param batch Batch of points to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& batch);
+
+  /**
+   * Merge the scaler of another model, fitted on other points, into the scaler
+   * of this model.  A std::invalid_argument is thrown if the models do not
+   * have the same type of scaler.
+   *
+   * @param other Model to merge into this one.
+   */
+  void Merge(const ScalingModel& other);
+
   // Scale back the dataset to their original values.
   template<typename MatType>
   void InverseTransform(const MatType& input, MatType& output);
@@ -204,6 +204,95 @@ void ScalingModel::Fit(const MatType& input)
   }
 }
 
+template<typename MatType>
+void ScalingModel::PartialFit(const MatType& batch)
+{
+  if (scalerType == ScalerTypes::STANDARD_SCALER)
+  {
+    if (!standardscale)
+      standardscale = new data::StandardScaler();
+    standardscale->PartialFit(batch);
+  }
+  else if (scalerType == ScalerTypes::MIN_MAX_SCALER)
+  {
+    if (!minmaxscale)
+      minmaxscale = new data::MinMaxScaler(minValue, maxValue);
+    minmaxscale->PartialFit(batch);
+  }
+  else if (scalerType == ScalerTypes::MEAN_NORMALIZATION)
+  {
+    if (!meanscale)
+      meanscale = new data::MeanNormalization();
+    meanscale->PartialFit(batch);
+  }
+  else if (scalerType == ScalerTypes::MAX_ABS_SCALER)
+  {
+    if (!maxabsscale)
+      maxabsscale = new data::MaxAbsScaler();
+    maxabsscale->PartialFit(batch);
+  }
+  else if (scalerType == ScalerTypes::PCA_WHITENING)
+  {
+    if (!pcascale)
+      pcascale = new data::PCAWhitening(epsilon);
+    pcascale->PartialFit(batch);
+  }
+  else if (scalerType == ScalerTypes::ZCA_WHITENING)
+  {
+    if (!zcascale)
+      zcascale = new data::ZCAWhitening(epsilon);
+    zcascale->PartialFit(batch);
+  }
+}
+
+inline void ScalingModel::Merge(const ScalingModel& other)
+{
+  if (scalerType != other.scalerType)
+  {
+    throw std::invalid_argument("ScalingModel::Merge(): cannot merge models "
+        "with different types of scalers!");
+  }
+
+  // Merge the scaler of the other model into this one, or copy it if this
+  // model has not been fitted.
+  if (scalerType == ScalerTypes::STANDARD_SCALER && other.standardscale)
+  {
+    if (!standardscale)
+      standardscale = new data::StandardScaler();
+    standardscale->Merge(*other.standardscale);
+  }
+  else if (scalerType == ScalerTypes::MIN_MAX_SCALER && other.minmaxscale)
+  {
+    if (!minmaxscale)
+      minmaxscale = new data::MinMaxScaler(minValue, maxValue);
+    minmaxscale->Merge(*other.minmaxscale);
+  }
+  else if (scalerType == ScalerTypes::MEAN_NORMALIZATION && other.meanscale)
+  {
+    if (!meanscale)
+      meanscale = new data::MeanNormalization();
+    meanscale->Merge(*other.meanscale);
+  }
+  else if (scalerType == ScalerTypes::MAX_ABS_SCALER && other.maxabsscale)
+  {
+    if (!maxabsscale)
+      maxabsscale = new data::MaxAbsScaler();
+    maxabsscale->Merge(*other.maxabsscale);
+  }
+  else if (scalerType == ScalerTypes::PCA_WHITENING && other.pcascale)
+  {
+    if (!pcascale)
+      pcascale = new data::PCAWhitening(epsilon);
+    pcascale->Merge(*other.pcascale);
+  }
+  else if (scalerType == ScalerTypes::ZCA_WHITENING && other.zcascale)
+  {
+    if (!zcascale)
+      zcascale = new data::ZCAWhitening(epsilon);
+    zcascale->Merge(*other.zcascale);
+  }
+}
+
 template<typename MatType>
 void ScalingModel::Transform(const MatType& input, MatType& output)
 {
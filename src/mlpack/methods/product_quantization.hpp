@@ -0,0 +1,17 @@
+/**
+ * @file product_quantization.hpp
+ *
+ * Convenience include for mlpack/methods/product_quantization/.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_PRODUCT_QUANTIZATION_HPP
+#define MLPACK_PRODUCT_QUANTIZATION_HPP
+
+#include "product_quantization/product_quantizer.hpp"
+#include "product_quantization/ivf_pq_search.hpp"
+
+#endif
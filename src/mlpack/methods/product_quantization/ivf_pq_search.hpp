@@ -0,0 +1,203 @@
+/**
+ * @file methods/product_quantization/ivf_pq_search.hpp
+ *
+ * Defines the IVFPQSearch class, which performs approximate nearest neighbor
+ * search on a compressed reference set with an inverted file index and product
+ * quantization.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PRODUCT_QUANTIZATION_IVF_PQ_SEARCH_HPP
+#define MLPACK_METHODS_PRODUCT_QUANTIZATION_IVF_PQ_SEARCH_HPP
+
+#include <mlpack/core.hpp>
+
+#include "product_quantizer.hpp"
+
+namespace mlpack {
+
+/**
+ * The IVFPQSearch class finds approximate nearest neighbors (with the Euclidean
+ * distance) in a reference set that is not held in memory: the points are
+ * assigned to the nearest of numLists coarse centroids learned with k-means (an
+ * inverted file index), and the residual of each point with its centroid is
+ * encoded with a ProductQuantizer, so each point takes numSubspaces bytes, plus
+ * its index.  A search probes the lists of the numProbes centroids nearest to
+ * the query, and computes the distance to each point of these lists from a
+ * table of distances between the residual of the query and the codebooks.
+ *
+ * The approximate distances can be refined by re-ranking: the best candidates
+ * are searched for with the codes, and their exact distances are computed with
+ * the original reference set, which can be memory-mapped (data::MappedDataset)
+ * so that only the candidates are read from disk.
+ *
+ * @code
+ * // Train the index on a sample, then add the reference set by batches.
+ * IVFPQSearch<> ivfpq;
+ * ivfpq.Train(sample, 1024, 16);
+ * for (size_t i = 0; i < numBatches; ++i)
+ *   ivfpq.Add(batches[i]);
+ *
+ * // Search with the codes only, or re-rank 100 candidates with the
+ * // memory-mapped reference set.
+ * ivfpq.Search(queries, 10, neighbors, distances, 8);
+ * data::MappedDataset<double> reference("reference.mlds");
+ * ivfpq.Search(queries, reference.Matrix(), 10, neighbors, distances, 8, 100);
+ * @endcode
+ *
+ * @tparam MatType Type of matrix of the points (arma::mat, arma::fmat).
+ */
+template<typename MatType = arma::mat>
+class IVFPQSearch
+{
+ public:
+  //! The type of element held in MatType.
+  typedef typename MatType::elem_type ElemType;
+
+  //! Create an empty, untrained index.
+  IVFPQSearch();
+
+  /**
+   * Train the index on the given reference set, and add its points.
+   *
+   * @param referenceSet Set of reference points.
+   * @param numLists Number of coarse centroids (inverted lists).
+   * @param numSubspaces Number of subspaces of the product quantizer (bytes of
+   *     each code).
+   * @param numCentroids Number of centroids of each subspace (at most 256).
+   * @param opqIterations Number of iterations to learn the rotation of the
+   *     product quantizer with; if 0, the residuals are not rotated.
+   * @param maxIterations Maximum number of iterations of k-means.
+   */
+  IVFPQSearch(const MatType& referenceSet,
+              const size_t numLists,
+              const size_t numSubspaces,
+              const size_t numCentroids = 256,
+              const size_t opqIterations = 0,
+              const size_t maxIterations = 100);
+
+  /**
+   * Train the coarse centroids and the product quantizer on the given points,
+   * and empty the index.  The points are not added to the index; a sample of
+   * the reference set is usually enough to train on.
+   *
+   * @param trainingSet Set of training points.
+   * @param numLists Number of coarse centroids (inverted lists).
+   * @param numSubspaces Number of subspaces of the product quantizer.
+   * @param numCentroids Number of centroids of each subspace (at most 256).
+   * @param opqIterations Number of iterations to learn the rotation of the
+   *     product quantizer with.
+   * @param maxIterations Maximum number of iterations of k-means.
+   */
+  void Train(const MatType& trainingSet,
+             const size_t numLists,
+             const size_t numSubspaces,
+             const size_t numCentroids = 256,
+             const size_t opqIterations = 0,
+             const size_t maxIterations = 100);
+
+  /**
+   * Encode the given points and add them to the index.  The points get the
+   * indices NumPoints() to NumPoints() + points.n_cols - 1, so a reference set
+   * can be added by batches.
+   *
+   * @param points Points to add.
+   */
+  void Add(const MatType& points);
+
+  /**
+   * Compute the approximate nearest neighbors of the given queries, with the
+   * distances approximated by the codes.  The output matrices have k rows and
+   * one column per query; the neighbors of each query are sorted from nearest
+   * to furthest.  If fewer than k points are in the probed lists, the missing
+   * neighbors are SIZE_MAX, at the largest distance.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix to store the neighbors in.
+   * @param distances Matrix to store the approximate distances in.
+   * @param numProbes Number of inverted lists to search.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances,
+              const size_t numProbes = 1) const;
+
+  /**
+   * Compute the approximate nearest neighbors of the given queries, and
+   * re-rank the numCandidates best candidates of each query with their exact
+   * distances, computed with the given reference set (the points that were
+   * added, in the same order).  The output matrices are organized as with the
+   * other overload of Search(), and the distances are exact.
+   *
+   * @param querySet Set of query points.
+   * @param referenceSet The original reference set (for instance, the matrix
+   *     of a data::MappedDataset).
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix to store the neighbors in.
+   * @param distances Matrix to store the exact distances in.
+   * @param numProbes Number of inverted lists to search.
+   * @param numCandidates Number of candidates to re-rank (at least k).
+   */
+  void Search(const MatType& querySet,
+              const MatType& referenceSet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances,
+              const size_t numProbes,
+              const size_t numCandidates) const;
+
+  //! Get the number of points in the index.
+  size_t NumPoints() const { return numPoints; }
+  //! Get the number of inverted lists.
+  size_t NumLists() const { return listIndices.size(); }
+  //! Get the coarse centroids.
+  const arma::Mat<ElemType>& CoarseCentroids() const { return coarseCentroids; }
+  //! Get the product quantizer of the residuals.
+  const ProductQuantizer<MatType>& Quantizer() const { return quantizer; }
+  //! Get the indices of the points of the given list.
+  const arma::Col<size_t>& ListIndices(const size_t list) const
+  { return listIndices[list]; }
+  //! Get the codes of the points of the given list, one point in each row.
+  const arma::Mat<uint8_t>& ListCodes(const size_t list) const
+  { return listCodes[list]; }
+
+  //! Serialize the index.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Candidate represents a possible neighbor (distance, index).
+  typedef std::pair<ElemType, size_t> Candidate;
+
+  //! Compute the numCandidates nearest points of the probed lists to the given
+  //! query, with their squared approximate distances, sorted.
+  template<typename VecType>
+  void SearchPoint(const VecType& query,
+                   const size_t numProbes,
+                   const size_t numCandidates,
+                   std::vector<Candidate>& candidates) const;
+
+  //! The number of points in the index.
+  size_t numPoints;
+  //! The coarse centroids, one for each inverted list.
+  arma::Mat<ElemType> coarseCentroids;
+  //! The product quantizer of the residuals.
+  ProductQuantizer<MatType> quantizer;
+  //! The indices of the points of each list.
+  std::vector<arma::Col<size_t>> listIndices;
+  //! The codes of the points of each list, one point in each row, so that the
+  //! codes of each subspace are contiguous.
+  std::vector<arma::Mat<uint8_t>> listCodes;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "ivf_pq_search_impl.hpp"
+
+#endif
@@ -0,0 +1,314 @@
+/**
+ * @file methods/product_quantization/ivf_pq_search_impl.hpp
+ *
+ * Implementation of the IVFPQSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PRODUCT_QUANTIZATION_IVF_PQ_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_PRODUCT_QUANTIZATION_IVF_PQ_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "ivf_pq_search.hpp"
+
+#include <queue>
+
+namespace mlpack {
+
+template<typename MatType>
+IVFPQSearch<MatType>::IVFPQSearch() :
+    numPoints(0)
+{
+  // Nothing to do.
+}
+
+template<typename MatType>
+IVFPQSearch<MatType>::IVFPQSearch(const MatType& referenceSet,
+                                  const size_t numLists,
+                                  const size_t numSubspaces,
+                                  const size_t numCentroids,
+                                  const size_t opqIterations,
+                                  const size_t maxIterations) :
+    numPoints(0)
+{
+  Train(referenceSet, numLists, numSubspaces, numCentroids, opqIterations,
+      maxIterations);
+  Add(referenceSet);
+}
+
+template<typename MatType>
+void IVFPQSearch<MatType>::Train(const MatType& trainingSet,
+                                 const size_t numLists,
+                                 const size_t numSubspaces,
+                                 const size_t numCentroids,
+                                 const size_t opqIterations,
+                                 const size_t maxIterations)
+{
+  if (numLists == 0 || numLists > trainingSet.n_cols)
+  {
+    throw std::invalid_argument("IVFPQSearch::Train(): the number of lists "
+        "must be between 1 and the number of training points");
+  }
+
+  KMeans<EuclideanDistance, SampleInitialization, MaxVarianceNewCluster,
+      NaiveKMeans, MatType> kmeans(maxIterations);
+  arma::Row<size_t> assignments;
+  arma::mat centroids;
+  kmeans.Cluster(trainingSet, numLists, assignments, centroids);
+  coarseCentroids = arma::conv_to<arma::Mat<ElemType>>::from(centroids);
+
+  // The product quantizer encodes the residuals of the points with their
+  // coarse centroids.
+  const MatType residuals = trainingSet - coarseCentroids.cols(
+      arma::conv_to<arma::uvec>::from(assignments));
+  quantizer.Train(residuals, numSubspaces, numCentroids, opqIterations,
+      maxIterations);
+
+  numPoints = 0;
+  listIndices.assign(numLists, arma::Col<size_t>());
+  listCodes.assign(numLists, arma::Mat<uint8_t>(0, numSubspaces));
+}
+
+template<typename MatType>
+void IVFPQSearch<MatType>::Add(const MatType& points)
+{
+  if (coarseCentroids.is_empty())
+  {
+    throw std::runtime_error("IVFPQSearch::Add(): call Train() before Add()");
+  }
+  if (points.n_rows != coarseCentroids.n_rows)
+  {
+    throw std::invalid_argument("IVFPQSearch::Add(): the points have " +
+        std::to_string(points.n_rows) + " dimensions, but the index was "
+        "trained on " + std::to_string(coarseCentroids.n_rows));
+  }
+
+  // Assign each point to its nearest coarse centroid, which minimizes
+  // || c ||^2 - 2 c^T x, by blocks of points.
+  const size_t blockSize = 4096;
+  const arma::Col<ElemType> norms =
+      arma::sum(arma::square(coarseCentroids), 0).t();
+  arma::uvec assignments(points.n_cols);
+  for (size_t begin = 0; begin < points.n_cols; begin += blockSize)
+  {
+    const size_t end = std::min(begin + blockSize, (size_t) points.n_cols) - 1;
+    arma::Mat<ElemType> scores = -2 * coarseCentroids.t() *
+        points.cols(begin, end);
+    scores.each_col() += norms;
+    assignments.subvec(begin, end) = arma::index_min(scores, 0).t();
+  }
+
+  arma::Mat<uint8_t> codes;
+  quantizer.Encode(MatType(points - coarseCentroids.cols(assignments)), codes);
+
+  // Append the points to their lists.
+  std::vector<size_t> positions(NumLists());
+  arma::Col<size_t> counts(NumLists(), arma::fill::zeros);
+  for (size_t i = 0; i < assignments.n_elem; ++i)
+    ++counts[assignments[i]];
+  for (size_t l = 0; l < NumLists(); ++l)
+  {
+    positions[l] = listIndices[l].n_elem;
+    listIndices[l].resize(positions[l] + counts[l]);
+    listCodes[l].resize(positions[l] + counts[l], codes.n_rows);
+  }
+
+  for (size_t i = 0; i < assignments.n_elem; ++i)
+  {
+    const size_t l = assignments[i];
+    listIndices[l][positions[l]] = numPoints + i;
+    listCodes[l].row(positions[l]) = codes.col(i).t();
+    ++positions[l];
+  }
+
+  numPoints += points.n_cols;
+}
+
+template<typename MatType>
+void IVFPQSearch<MatType>::Search(const MatType& querySet,
+                                  const size_t k,
+                                  arma::Mat<size_t>& neighbors,
+                                  arma::Mat<ElemType>& distances,
+                                  const size_t numProbes) const
+{
+  if (numProbes == 0)
+  {
+    throw std::invalid_argument("IVFPQSearch::Search(): at least one list "
+        "must be probed");
+  }
+  if (querySet.n_rows != coarseCentroids.n_rows)
+  {
+    throw std::invalid_argument("IVFPQSearch::Search(): the queries have " +
+        std::to_string(querySet.n_rows) + " dimensions, but the index was "
+        "trained on " + std::to_string(coarseCentroids.n_rows));
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  #pragma omp parallel for schedule(dynamic, 16)
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    std::vector<Candidate> candidates;
+    SearchPoint(querySet.col(q), numProbes, k, candidates);
+
+    for (size_t j = 0; j < k; ++j)
+    {
+      if (j < candidates.size())
+      {
+        neighbors(j, q) = candidates[j].second;
+        distances(j, q) = std::sqrt(candidates[j].first);
+      }
+      else
+      {
+        neighbors(j, q) = SIZE_MAX;
+        distances(j, q) = std::numeric_limits<ElemType>::max();
+      }
+    }
+  }
+}
+
+template<typename MatType>
+void IVFPQSearch<MatType>::Search(const MatType& querySet,
+                                  const MatType& referenceSet,
+                                  const size_t k,
+                                  arma::Mat<size_t>& neighbors,
+                                  arma::Mat<ElemType>& distances,
+                                  const size_t numProbes,
+                                  const size_t numCandidates) const
+{
+  if (numProbes == 0)
+  {
+    throw std::invalid_argument("IVFPQSearch::Search(): at least one list "
+        "must be probed");
+  }
+  if (numCandidates < k)
+  {
+    throw std::invalid_argument("IVFPQSearch::Search(): the number of "
+        "candidates to re-rank must be at least k");
+  }
+  if (querySet.n_rows != coarseCentroids.n_rows)
+  {
+    throw std::invalid_argument("IVFPQSearch::Search(): the queries have " +
+        std::to_string(querySet.n_rows) + " dimensions, but the index was "
+        "trained on " + std::to_string(coarseCentroids.n_rows));
+  }
+  if (referenceSet.n_rows != coarseCentroids.n_rows ||
+      referenceSet.n_cols != numPoints)
+  {
+    throw std::invalid_argument("IVFPQSearch::Search(): the reference set must "
+        "hold the " + std::to_string(numPoints) + " points of the index");
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  #pragma omp parallel for schedule(dynamic, 16)
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    std::vector<Candidate> candidates;
+    SearchPoint(querySet.col(q), numProbes, numCandidates, candidates);
+
+    // Only the reference points of the candidates are read.
+    for (Candidate& c : candidates)
+    {
+      c.first = EuclideanDistance::Evaluate(querySet.col(q),
+          referenceSet.col(c.second));
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    for (size_t j = 0; j < k; ++j)
+    {
+      if (j < candidates.size())
+      {
+        neighbors(j, q) = candidates[j].second;
+        distances(j, q) = candidates[j].first;
+      }
+      else
+      {
+        neighbors(j, q) = SIZE_MAX;
+        distances(j, q) = std::numeric_limits<ElemType>::max();
+      }
+    }
+  }
+}
+
+template<typename MatType>
+template<typename Archive>
+void IVFPQSearch<MatType>::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(numPoints));
+  ar(CEREAL_NVP(coarseCentroids));
+  ar(CEREAL_NVP(quantizer));
+  ar(CEREAL_NVP(listIndices));
+  ar(CEREAL_NVP(listCodes));
+}
+
+template<typename MatType>
+template<typename VecType>
+void IVFPQSearch<MatType>::SearchPoint(
+    const VecType& query,
+    const size_t numProbes,
+    const size_t numCandidates,
+    std::vector<Candidate>& candidates) const
+{
+  // Probe the lists of the nearest coarse centroids.
+  const arma::uvec lists = arma::sort_index(
+      arma::sum(arma::square(coarseCentroids.each_col() - query), 0));
+  const size_t probes = std::min(numProbes, (size_t) lists.n_elem);
+
+  // The worst of the best candidates so far is at the top of the heap.
+  std::priority_queue<Candidate> heap;
+  arma::Mat<ElemType> table;
+  arma::Col<ElemType> listDistances;
+  for (size_t p = 0; p < probes; ++p)
+  {
+    const size_t l = lists[p];
+    const arma::Mat<uint8_t>& codes = listCodes[l];
+    if (codes.n_rows == 0)
+      continue;
+
+    // The codes of the list hold the residuals with the centroid of the list.
+    const arma::Col<ElemType> residual = query - coarseCentroids.col(l);
+    quantizer.DistanceTable(residual, table);
+
+    // Accumulate the distances one subspace at a time, so that both the codes
+    // and the column of the table are read contiguously.
+    listDistances.zeros(codes.n_rows);
+    ElemType* d = listDistances.memptr();
+    for (size_t s = 0; s < codes.n_cols; ++s)
+    {
+      const uint8_t* c = codes.colptr(s);
+      const ElemType* t = table.colptr(s);
+      for (size_t i = 0; i < codes.n_rows; ++i)
+        d[i] += t[c[i]];
+    }
+
+    for (size_t i = 0; i < codes.n_rows; ++i)
+    {
+      if (heap.size() < numCandidates)
+      {
+        heap.push(Candidate(d[i], listIndices[l][i]));
+      }
+      else if (d[i] < heap.top().first)
+      {
+        heap.pop();
+        heap.push(Candidate(d[i], listIndices[l][i]));
+      }
+    }
+  }
+
+  candidates.resize(heap.size());
+  for (size_t i = candidates.size(); i > 0; --i)
+  {
+    candidates[i - 1] = heap.top();
+    heap.pop();
+  }
+}
+
+} // namespace mlpack
+
+#endif
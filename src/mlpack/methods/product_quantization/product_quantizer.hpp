@@ -0,0 +1,182 @@
+/**
+ * @file methods/product_quantization/product_quantizer.hpp
+ *
+ * Defines the ProductQuantizer class, which compresses points into one byte
+ * per subspace with a codebook learned by k-means in each subspace, optionally
+ * after a learned rotation (optimized product quantization).
+ *
+ * The details of these methods can be found in the following papers:
+ *
+ * @code
+ * @article{jegou2011product,
+ *   title={Product Quantization for Nearest Neighbor Search},
+ *   author={J{\'e}gou, Herv{\'e} and Douze, Matthijs and Schmid, Cordelia},
+ *   journal={IEEE Transactions on Pattern Analysis and Machine Intelligence},
+ *   volume={33},
+ *   number={1},
+ *   pages={117--128},
+ *   year={2011}
+ * }
+ *
+ * @inproceedings{ge2013optimized,
+ *   title={Optimized Product Quantization for Approximate Nearest Neighbor
+ *       Search},
+ *   author={Ge, Tiezheng and He, Kaiming and Ke, Qifa and Sun, Jian},
+ *   booktitle={IEEE Conference on Computer Vision and Pattern Recognition},
+ *   pages={2946--2953},
+ *   year={2013}
+ * }
+ * @endcode
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PRODUCT_QUANTIZATION_PRODUCT_QUANTIZER_HPP
+#define MLPACK_METHODS_PRODUCT_QUANTIZATION_PRODUCT_QUANTIZER_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/kmeans/kmeans.hpp>
+
+namespace mlpack {
+
+/**
+ * A product quantizer splits the dimensions of the points into numSubspaces
+ * contiguous subspaces and learns a codebook of at most 256 centroids in each
+ * subspace with k-means; a point is then stored as the index of the nearest
+ * centroid in each subspace, so as numSubspaces bytes.  The squared Euclidean
+ * distance between a query and an encoded point is the sum over the subspaces
+ * of the squared distance between the query and the centroid of the point, so
+ * after one table of (numCentroids x numSubspaces) distances is computed for
+ * the query (DistanceTable()), the distance to each encoded point costs
+ * numSubspaces table lookups (asymmetric distance computation).
+ *
+ * If opqIterations is not 0, an orthogonal rotation of the points is learned
+ * along with the codebooks (non-parametric optimized product quantization),
+ * which balances the variance of the subspaces and usually gives a much lower
+ * quantization error on correlated data.  The rotation is applied by Encode()
+ * and DistanceTable(), and undone by Decode().
+ *
+ * @tparam MatType Type of matrix of the points (arma::mat, arma::fmat).
+ */
+template<typename MatType = arma::mat>
+class ProductQuantizer
+{
+ public:
+  //! The type of element held in MatType.
+  typedef typename MatType::elem_type ElemType;
+
+  //! Create an untrained quantizer.
+  ProductQuantizer();
+
+  /**
+   * Train the quantizer on the given points.
+   *
+   * @param data Training points.
+   * @param numSubspaces Number of subspaces (bytes of each code).
+   * @param numCentroids Number of centroids of each subspace (at most 256).
+   * @param opqIterations Number of iterations to learn the rotation with; if 0,
+   *     the points are not rotated.
+   * @param maxIterations Maximum number of iterations of k-means.
+   */
+  ProductQuantizer(const MatType& data,
+                   const size_t numSubspaces,
+                   const size_t numCentroids = 256,
+                   const size_t opqIterations = 0,
+                   const size_t maxIterations = 100);
+
+  /**
+   * Train the quantizer on the given points, replacing the current codebooks.
+   *
+   * @param data Training points.
+   * @param numSubspaces Number of subspaces (bytes of each code).
+   * @param numCentroids Number of centroids of each subspace (at most 256).
+   * @param opqIterations Number of iterations to learn the rotation with; if 0,
+   *     the points are not rotated.
+   * @param maxIterations Maximum number of iterations of k-means.
+   */
+  void Train(const MatType& data,
+             const size_t numSubspaces,
+             const size_t numCentroids = 256,
+             const size_t opqIterations = 0,
+             const size_t maxIterations = 100);
+
+  /**
+   * Encode the given points; column i of the codes holds the numSubspaces
+   * codes of point i.
+   *
+   * @param data Points to encode.
+   * @param codes Matrix to store the codes in.
+   */
+  void Encode(const MatType& data, arma::Mat<uint8_t>& codes) const;
+
+  /**
+   * Reconstruct the points with the given codes from the codebooks.
+   *
+   * @param codes Codes of the points, one point in each column.
+   * @param data Matrix to store the reconstructed points in.
+   */
+  void Decode(const arma::Mat<uint8_t>& codes, MatType& data) const;
+
+  /**
+   * Compute the squared Euclidean distances between the given query and every
+   * centroid of every subspace: table(c, s) is the squared distance between
+   * the query and centroid c in subspace s, so the squared distance to a point
+   * with codes x is the sum over s of table(x[s], s).
+   *
+   * @param query Query point.
+   * @param table Matrix to store the (numCentroids x numSubspaces) table in.
+   */
+  template<typename VecType>
+  void DistanceTable(const VecType& query, arma::Mat<ElemType>& table) const;
+
+  //! Get the first dimension of the given subspace (s = NumSubspaces() gives
+  //! the dimensionality).
+  size_t SubspaceBegin(const size_t s) const
+  { return s * centroids.n_rows / numSubspaces; }
+
+  //! Get the dimensionality of the points.
+  size_t Dimensionality() const { return centroids.n_rows; }
+  //! Get the number of subspaces.
+  size_t NumSubspaces() const { return numSubspaces; }
+  //! Get the number of centroids of each subspace.
+  size_t NumCentroids() const { return numCentroids; }
+
+  //! Get the codebooks: rows SubspaceBegin(s) to SubspaceBegin(s + 1) - 1 of
+  //! column c hold centroid c of subspace s.
+  const arma::Mat<ElemType>& Centroids() const { return centroids; }
+  //! Get the rotation applied to the points before they are encoded (empty if
+  //! there is none).
+  const arma::Mat<ElemType>& Rotation() const { return rotation; }
+
+  //! Serialize the quantizer.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Learn the codebooks on the given (rotated) points.
+  void TrainCodebooks(const MatType& data, const size_t maxIterations);
+
+  //! Encode the given (rotated) points.
+  void EncodeRotated(const MatType& data, arma::Mat<uint8_t>& codes) const;
+
+  //! Reconstruct the given points in the rotated space.
+  void DecodeRotated(const arma::Mat<uint8_t>& codes, MatType& data) const;
+
+  //! The number of subspaces.
+  size_t numSubspaces;
+  //! The number of centroids of each subspace.
+  size_t numCentroids;
+  //! The codebooks of all the subspaces, one centroid index in each column.
+  arma::Mat<ElemType> centroids;
+  //! The rotation of the points, or an empty matrix.
+  arma::Mat<ElemType> rotation;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "product_quantizer_impl.hpp"
+
+#endif
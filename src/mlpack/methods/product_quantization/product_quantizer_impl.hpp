@@ -0,0 +1,250 @@
+/**
+ * @file methods/product_quantization/product_quantizer_impl.hpp
+ *
+ * Implementation of the ProductQuantizer class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PRODUCT_QUANTIZATION_PRODUCT_QUANTIZER_IMPL_HPP
+#define MLPACK_METHODS_PRODUCT_QUANTIZATION_PRODUCT_QUANTIZER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "product_quantizer.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+ProductQuantizer<MatType>::ProductQuantizer() :
+    numSubspaces(0),
+    numCentroids(0)
+{
+  // Nothing to do.
+}
+
+template<typename MatType>
+ProductQuantizer<MatType>::ProductQuantizer(const MatType& data,
+                                            const size_t numSubspaces,
+                                            const size_t numCentroids,
+                                            const size_t opqIterations,
+                                            const size_t maxIterations)
+{
+  Train(data, numSubspaces, numCentroids, opqIterations, maxIterations);
+}
+
+template<typename MatType>
+void ProductQuantizer<MatType>::Train(const MatType& data,
+                                      const size_t numSubspaces,
+                                      const size_t numCentroids,
+                                      const size_t opqIterations,
+                                      const size_t maxIterations)
+{
+  if (numSubspaces == 0 || numSubspaces > data.n_rows)
+  {
+    throw std::invalid_argument("ProductQuantizer::Train(): the number of "
+        "subspaces must be between 1 and the dimensionality of the data");
+  }
+  if (numCentroids == 0 || numCentroids > 256)
+  {
+    throw std::invalid_argument("ProductQuantizer::Train(): the number of "
+        "centroids must be between 1 and 256, so that codes fit in one byte");
+  }
+  if (data.n_cols < numCentroids)
+  {
+    throw std::invalid_argument("ProductQuantizer::Train(): there must be at "
+        "least as many training points as centroids");
+  }
+
+  this->numSubspaces = numSubspaces;
+  this->numCentroids = numCentroids;
+  rotation.reset();
+
+  if (opqIterations == 0)
+  {
+    TrainCodebooks(data, maxIterations);
+    return;
+  }
+
+  // Alternate between learning the codebooks of the rotated points and finding
+  // the rotation R minimizing || R X - Y ||, with Y the reconstruction of the
+  // rotated points: with X Y^T = U S V^T, this is R = V U^T.
+  rotation.eye(data.n_rows, data.n_rows);
+  MatType rotated, reconstruction;
+  arma::Mat<uint8_t> codes;
+  for (size_t i = 0; i < opqIterations; ++i)
+  {
+    rotated = rotation * data;
+    TrainCodebooks(rotated, maxIterations);
+    EncodeRotated(rotated, codes);
+    DecodeRotated(codes, reconstruction);
+
+    arma::Mat<ElemType> u, v;
+    arma::Col<ElemType> s;
+    if (!arma::svd(u, s, v, data * reconstruction.t()))
+    {
+      throw std::runtime_error("ProductQuantizer::Train(): the SVD of the "
+          "rotation failed");
+    }
+    rotation = v * u.t();
+  }
+
+  rotated = rotation * data;
+  TrainCodebooks(rotated, maxIterations);
+}
+
+template<typename MatType>
+void ProductQuantizer<MatType>::Encode(const MatType& data,
+                                       arma::Mat<uint8_t>& codes) const
+{
+  if (data.n_rows != centroids.n_rows)
+  {
+    throw std::invalid_argument("ProductQuantizer::Encode(): the points have " +
+        std::to_string(data.n_rows) + " dimensions, but the quantizer was "
+        "trained on " + std::to_string(centroids.n_rows));
+  }
+
+  if (rotation.is_empty())
+  {
+    EncodeRotated(data, codes);
+    return;
+  }
+
+  // Rotate the points by blocks, so that a large dataset is not copied.
+  const size_t blockSize = 4096;
+  codes.set_size(numSubspaces, data.n_cols);
+  MatType rotated;
+  arma::Mat<uint8_t> blockCodes;
+  for (size_t begin = 0; begin < data.n_cols; begin += blockSize)
+  {
+    const size_t end = std::min(begin + blockSize, (size_t) data.n_cols) - 1;
+    rotated = rotation * data.cols(begin, end);
+    EncodeRotated(rotated, blockCodes);
+    codes.cols(begin, end) = blockCodes;
+  }
+}
+
+template<typename MatType>
+void ProductQuantizer<MatType>::Decode(const arma::Mat<uint8_t>& codes,
+                                       MatType& data) const
+{
+  if (codes.n_rows != numSubspaces)
+  {
+    throw std::invalid_argument("ProductQuantizer::Decode(): the codes have " +
+        std::to_string(codes.n_rows) + " subspaces, but the quantizer has " +
+        std::to_string(numSubspaces));
+  }
+
+  DecodeRotated(codes, data);
+  if (!rotation.is_empty())
+    data = rotation.t() * data;
+}
+
+template<typename MatType>
+template<typename VecType>
+void ProductQuantizer<MatType>::DistanceTable(
+    const VecType& query,
+    arma::Mat<ElemType>& table) const
+{
+  arma::Mat<ElemType> squares;
+  if (rotation.is_empty())
+    squares = arma::square(centroids.each_col() - query);
+  else
+    squares = arma::square(centroids.each_col() - rotation * query);
+
+  table.set_size(numCentroids, numSubspaces);
+  for (size_t s = 0; s < numSubspaces; ++s)
+  {
+    table.col(s) = arma::sum(squares.rows(SubspaceBegin(s),
+        SubspaceBegin(s + 1) - 1), 0).t();
+  }
+}
+
+template<typename MatType>
+template<typename Archive>
+void ProductQuantizer<MatType>::serialize(Archive& ar,
+                                          const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(numSubspaces));
+  ar(CEREAL_NVP(numCentroids));
+  ar(CEREAL_NVP(centroids));
+  ar(CEREAL_NVP(rotation));
+}
+
+template<typename MatType>
+void ProductQuantizer<MatType>::TrainCodebooks(const MatType& data,
+                                               const size_t maxIterations)
+{
+  centroids.set_size(data.n_rows, numCentroids);
+
+  KMeans<EuclideanDistance, SampleInitialization, MaxVarianceNewCluster,
+      NaiveKMeans, MatType> kmeans(maxIterations);
+  for (size_t s = 0; s < numSubspaces; ++s)
+  {
+    const size_t begin = SubspaceBegin(s);
+    const size_t end = SubspaceBegin(s + 1) - 1;
+
+    const MatType subspace = data.rows(begin, end);
+    arma::mat subspaceCentroids;
+    kmeans.Cluster(subspace, numCentroids, subspaceCentroids);
+    centroids.rows(begin, end) =
+        arma::conv_to<arma::Mat<ElemType>>::from(subspaceCentroids);
+  }
+}
+
+template<typename MatType>
+void ProductQuantizer<MatType>::EncodeRotated(const MatType& data,
+                                              arma::Mat<uint8_t>& codes) const
+{
+  codes.set_size(numSubspaces, data.n_cols);
+
+  // The nearest centroid minimizes || c ||^2 - 2 c^T x, which is computed for
+  // blocks of points with one matrix multiplication in each subspace.
+  const size_t blockSize = 4096;
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) data.n_cols) - 1;
+    arma::Mat<ElemType> scores;
+    for (size_t s = 0; s < numSubspaces; ++s)
+    {
+      const size_t first = SubspaceBegin(s);
+      const size_t last = SubspaceBegin(s + 1) - 1;
+
+      scores = -2 * centroids.rows(first, last).t() *
+          data.submat(first, begin, last, end);
+      scores.each_col() += arma::sum(arma::square(centroids.rows(first, last)),
+          0).t();
+
+      const arma::urowvec nearest = arma::index_min(scores, 0);
+      for (size_t i = 0; i < nearest.n_elem; ++i)
+        codes(s, begin + i) = (uint8_t) nearest[i];
+    }
+  }
+}
+
+template<typename MatType>
+void ProductQuantizer<MatType>::DecodeRotated(const arma::Mat<uint8_t>& codes,
+                                              MatType& data) const
+{
+  data.set_size(centroids.n_rows, codes.n_cols);
+
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < codes.n_cols; ++i)
+  {
+    for (size_t s = 0; s < numSubspaces; ++s)
+    {
+      const size_t first = SubspaceBegin(s);
+      const size_t last = SubspaceBegin(s + 1) - 1;
+      data.col(i).subvec(first, last) =
+          centroids.col(codes(s, i)).subvec(first, last);
+    }
+  }
+}
+
+} // namespace mlpack
+
+#endif
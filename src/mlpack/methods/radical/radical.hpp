@@ -112,7 +112,8 @@ class Radical
   template<typename MatType>
   void CopyAndPerturb(MatType& xNew, const MatType& x) const;
 
-  //! Two-dimensional version of RADICAL.
+  //! Two-dimensional version of RADICAL.  The angles are evaluated in
+  //! parallel, and candidate holds a pair of columns for each thread.
   template<typename MatType>
   typename MatType::elem_type Apply2D(
       const MatType& matX,
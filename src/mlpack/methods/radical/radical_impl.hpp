@@ -82,23 +82,34 @@ inline typename MatType::elem_type Radical::Apply2D(const MatType& matX,
   CopyAndPerturb(perturbed, matX);
   timers.Stop("radical_copy_and_perturb");
 
-  typename MatType::template fixed<2, 2> matJacobi;
+  size_t numThreads = 1;
+#ifdef MLPACK_USE_OPENMP
+  numThreads = omp_get_max_threads();
+#endif
+
+  // The angles are evaluated in parallel; each thread rotates the perturbed
+  // data into its own pair of columns of candidate (which are then sorted by
+  // Vasicek()).
+  candidate.set_size(perturbed.n_rows, 2 * numThreads);
   VecType values(angles);
 
+  #pragma omp parallel for schedule(dynamic)
   for (size_t i = 0; i < angles; ++i)
   {
+    size_t thread = 0;
+#ifdef MLPACK_USE_OPENMP
+    thread = omp_get_thread_num();
+#endif
+
     const ElemType theta = (i / (ElemType) angles) * M_PI / 2.0;
     const ElemType cosTheta = cos(theta);
     const ElemType sinTheta = sin(theta);
 
-    matJacobi(0, 0) = cosTheta;
-    matJacobi(1, 0) = -sinTheta;
-    matJacobi(0, 1) = sinTheta;
-    matJacobi(1, 1) = cosTheta;
-
-    candidate = perturbed * matJacobi;
-    VecType candidateY1 = candidate.unsafe_col(0);
-    VecType candidateY2 = candidate.unsafe_col(1);
+    // This is perturbed times the Jacobi rotation matrix of theta.
+    VecType candidateY1 = candidate.unsafe_col(2 * thread);
+    VecType candidateY2 = candidate.unsafe_col(2 * thread + 1);
+    candidateY1 = cosTheta * perturbed.col(0) - sinTheta * perturbed.col(1);
+    candidateY2 = sinTheta * perturbed.col(0) + cosTheta * perturbed.col(1);
 
     values(i) = Vasicek(candidateY1, m) + Vasicek(candidateY2, m);
   }
@@ -169,8 +180,6 @@ inline void Radical::Apply(const MatType& matXT,
 
   MatType matYSubspace(nPoints, 2);
 
-  MatType matJ = arma::eye<MatType>(nDims, nDims);
-
   for (size_t sweepNum = 0; sweepNum < localSweeps; sweepNum++)
   {
     Log::Info << "RADICAL: sweep " << sweepNum << "." << std::endl;
@@ -191,19 +200,13 @@ inline void Radical::Apply(const MatType& matXT,
         const ElemType cosThetaOpt = cos(thetaOpt);
         const ElemType sinThetaOpt = sin(thetaOpt);
 
-        // Set elements of transformation matrix.
-        matJ(i, i) = cosThetaOpt;
-        matJ(j, i) = -sinThetaOpt;
-        matJ(i, j) = sinThetaOpt;
-        matJ(j, j) = cosThetaOpt;
-
-        matY *= matJ;
-
-        // Unset elements of transformation matrix, so matJ = eye() again.
-        matJ(i, i) = 1;
-        matJ(j, i) = 0;
-        matJ(i, j) = 0;
-        matJ(j, j) = 1;
+        // Rotate dimensions i and j; this is the same as multiplying matY by
+        // the Jacobi rotation matrix, but only touches the two columns
+        // (matYSubspace is reused as scratch space).
+        matYSubspace.col(0) = cosThetaOpt * matY.col(i) -
+            sinThetaOpt * matY.col(j);
+        matY.col(j) = sinThetaOpt * matY.col(i) + cosThetaOpt * matY.col(j);
+        matY.col(i) = matYSubspace.col(0);
       }
     }
   }
@@ -12,5 +12,6 @@
 #define MLPACK_RANDOM_FOREST_HPP
 
 #include "random_forest/random_forest.hpp"
+#include "random_forest/flat_forest.hpp"
 
 #endif
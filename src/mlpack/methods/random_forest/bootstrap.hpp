@@ -3,7 +3,8 @@
  * @author Ryan Curtin
  *
  * Implementation of the Bootstrap() function, which creates a bootstrapped
- * dataset from the given input dataset.
+ * dataset from the given input dataset, and of the BootstrapCounts() function,
+ * which draws a bootstrap sample as counts of each point.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
@@ -43,6 +44,20 @@ void Bootstrap(const MatType& dataset,
     bootstrapWeights = weights.cols(indices);
 }
 
+/**
+ * Draw a bootstrap sample of the given number of points, and store it as the
+ * number of times each point is drawn, without copying any data.
+ */
+inline void BootstrapCounts(const size_t numPoints, arma::rowvec& counts)
+{
+  // Random sampling with replacement.
+  arma::uvec indices = randi<arma::uvec>(numPoints,
+      arma::distr_param(0, numPoints - 1));
+  counts.zeros(numPoints);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+    counts[indices[i]] += 1.0;
+}
+
 } // namespace mlpack
 
 #endif
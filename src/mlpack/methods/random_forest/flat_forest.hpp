@@ -0,0 +1,284 @@
+/**
+ * @file methods/random_forest/flat_forest.hpp
+ *
+ * Definition of the FlatForest class, which holds a trained forest of decision
+ * trees in contiguous arrays for fast classification.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_FLAT_FOREST_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_FLAT_FOREST_HPP
+
+#include <mlpack/methods/decision_tree/decision_tree.hpp>
+
+namespace mlpack {
+
+/**
+ * FlatNumericSplit describes how a numeric split type sends points to its
+ * children, so that FlatForest can store the split as a threshold: points with
+ * value at most Threshold(splitInfo) go to the first child, and the others go
+ * to the second child.  It is specialized for the binary numeric splits of
+ * mlpack; a specialization can be written for custom numeric split types that
+ * behave the same way.
+ */
+template<typename NumericSplitType>
+struct FlatNumericSplit;
+
+template<typename FitnessFunction>
+struct FlatNumericSplit<BestBinaryNumericSplit<FitnessFunction>>
+{
+  static double Threshold(const arma::vec& splitInfo) { return splitInfo[0]; }
+};
+
+template<typename FitnessFunction>
+struct FlatNumericSplit<RandomBinaryNumericSplit<FitnessFunction>>
+{
+  static double Threshold(const arma::vec& splitInfo) { return splitInfo[0]; }
+};
+
+template<typename FitnessFunction>
+struct FlatNumericSplit<HistogramNumericSplit<FitnessFunction>>
+{
+  static double Threshold(const arma::vec& splitInfo) { return splitInfo[0]; }
+};
+
+/**
+ * FlatCategoricalSplit describes how a categorical split type sends points to
+ * its children, so that FlatForest can store the split as a table from each
+ * category to a child.  It is specialized for the categorical splits of
+ * mlpack.
+ */
+template<typename CategoricalSplitType>
+struct FlatCategoricalSplit;
+
+template<typename FitnessFunction>
+struct FlatCategoricalSplit<AllCategoricalSplit<FitnessFunction>>
+{
+  //! Get the number of categories of the split.
+  static size_t NumCategories(const arma::vec& /* splitInfo */,
+                              const size_t numChildren)
+  {
+    return numChildren;
+  }
+
+  //! Get the child that points of the given category go to.
+  static size_t Child(const arma::vec& /* splitInfo */, const size_t category)
+  {
+    return category;
+  }
+};
+
+template<typename FitnessFunction>
+struct FlatCategoricalSplit<BestBinaryCategoricalSplit<FitnessFunction>>
+{
+  //! Get the number of categories of the split.
+  static size_t NumCategories(const arma::vec& splitInfo,
+                              const size_t /* numChildren */)
+  {
+    return splitInfo.n_elem;
+  }
+
+  //! Get the child that points of the given category go to.
+  static size_t Child(const arma::vec& splitInfo, const size_t category)
+  {
+    return (size_t) splitInfo[category];
+  }
+};
+
+/**
+ * The FlatForest class holds a trained forest of decision trees (for instance,
+ * the trees of a RandomForest) as a few contiguous arrays, with the split
+ * dimension, the threshold and the offset of the children of each node; the
+ * children of a node are stored next to each other.  Classification of a
+ * batch of points proceeds in blocks of points: each tree is walked for every
+ * point of the block before moving on to the next tree, so that the nodes of
+ * the tree stay in cache, and blocks are split between threads with OpenMP.
+ *
+ * The predictions are the same as those of the forest the FlatForest was built
+ * from, but the forest cannot be trained further.  A FlatForest can be
+ * serialized, and is much faster to load than the forest.
+ *
+ * @code
+ * RandomForest<> rf(data, labels, numClasses, 100);
+ * FlatForest flat(rf);
+ * data::Save("forest.bin", "forest", flat);
+ *
+ * // In the scoring service:
+ * FlatForest flat;
+ * data::Load("forest.bin", "forest", flat);
+ * flat.Classify(points, predictions, probabilities);
+ * @endcode
+ */
+class FlatForest
+{
+ public:
+  //! The number of points classified at once by each thread.
+  static constexpr size_t BlockSize = 64;
+
+  /**
+   * Create an empty FlatForest.  Classify() will throw an exception until a
+   * forest is flattened or loaded.
+   */
+  FlatForest();
+
+  /**
+   * Flatten the given trained forest.  The forest type must have NumTrees()
+   * and Tree(i) methods, like RandomForest.
+   *
+   * @param forest Trained forest to flatten.
+   */
+  template<typename ForestType>
+  FlatForest(const ForestType& forest);
+
+  /**
+   * Flatten the given trained forest, replacing the current one.
+   *
+   * @param forest Trained forest to flatten.
+   */
+  template<typename ForestType>
+  void Flatten(const ForestType& forest);
+
+  /**
+   * Add the given trained decision tree to the forest.  The class
+   * probabilities of a point are the average of the probabilities given by
+   * each tree.
+   *
+   * @param tree Trained decision tree to add.
+   */
+  template<typename TreeType>
+  void AddTree(const TreeType& tree);
+
+  /**
+   * Predict the class of the given point.
+   *
+   * @param point Point to be classified.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Predict the class of the given point and return the predicted class
+   * probabilities for each class.
+   *
+   * @param point Point to be classified.
+   * @param prediction size_t to store predicted class in.
+   * @param probabilities Output vector of class probabilities.
+   */
+  template<typename VecType>
+  void Classify(const VecType& point,
+                size_t& prediction,
+                arma::vec& probabilities) const;
+
+  /**
+   * Predict the classes of each point in the given dataset.
+   *
+   * @param data Dataset to be classified.
+   * @param predictions Output predictions for each point in the dataset.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const;
+
+  /**
+   * Predict the classes of each point in the given dataset, also returning the
+   * predicted class probabilities for each point.
+   *
+   * @param data Dataset to be classified.
+   * @param predictions Output predictions for each point in the dataset.
+   * @param probabilities Output matrix of class probabilities for each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  /**
+   * Write the forest as a self-contained C++ header, in which each tree is a
+   * function of nested if/else statements with constant thresholds.  The
+   * header defines, in the given namespace,
+   *
+   * @code
+   * std::size_t Predict(const double* point, double* probabilities = 0);
+   * @endcode
+   *
+   * which returns the same class as Classify() for the point (an array of at
+   * least Dimensionality() values), and also stores the class probabilities
+   * if probabilities is not NULL.  The header only needs a C++98 compiler and
+   * the standard library.
+   *
+   * @param stream Stream to write the header to.
+   * @param namespaceName Namespace of the generated code; it must be a valid
+   *     C++ identifier.
+   */
+  void ExportCpp(std::ostream& stream,
+                 const std::string& namespaceName = "model") const;
+
+  //! Get the number of trees in the forest.
+  size_t NumTrees() const { return roots.n_elem; }
+  //! Get the total number of nodes of all the trees.
+  size_t NumNodes() const { return nodeTypes.n_elem; }
+  //! Get the number of classes.
+  size_t NumClasses() const { return leafProbabilities.n_rows; }
+  //! Get the smallest dimensionality of points that can be classified.
+  size_t Dimensionality() const { return dimensionality; }
+
+  //! Serialize the forest.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! The types of nodes.
+  enum NodeType
+  {
+    Leaf = 0,
+    Numeric = 1,
+    Categorical = 2
+  };
+
+  /**
+   * Find the leaf of the given tree that column col of data falls into, and
+   * return the column of its class probabilities in leafProbabilities.
+   */
+  template<typename MatType>
+  size_t FindLeaf(const size_t tree,
+                  const MatType& data,
+                  const size_t col) const;
+
+  //! Throw an exception if the given points cannot be classified.
+  void CheckPoints(const size_t pointDimensionality) const;
+
+  //! Write the given node (and its subtree) as C++ code that returns the
+  //! column of leafProbabilities of the leaf a point falls into.
+  void ExportNode(std::ostream& stream,
+                  const size_t node,
+                  const size_t depth) const;
+
+  //! The index of the root node of each tree.
+  arma::Col<size_t> roots;
+  //! The type of each node.
+  arma::Col<unsigned char> nodeTypes;
+  //! The split dimension of each node (unused for leaves).
+  arma::Col<size_t> dimensions;
+  //! The threshold of each numeric node (unused for other nodes).
+  arma::vec thresholds;
+  //! For numeric nodes, the index of the first child (the second child is
+  //! next to it); for categorical nodes, the offset of the node's table in
+  //! categoryChildren; for leaves, the column of leafProbabilities.
+  arma::Col<size_t> offsets;
+  //! The table of each categorical node: the number of categories, followed
+  //! by the index of the child for each category.
+  arma::Col<size_t> categoryChildren;
+  //! The class probabilities of each leaf (one column for each leaf).
+  arma::mat leafProbabilities;
+  //! The smallest dimensionality of points that can be classified.
+  size_t dimensionality;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "flat_forest_impl.hpp"
+
+#endif
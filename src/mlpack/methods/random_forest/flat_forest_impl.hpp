@@ -0,0 +1,440 @@
+/**
+ * @file methods/random_forest/flat_forest_impl.hpp
+ *
+ * Implementation of the FlatForest class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_FLAT_FOREST_IMPL_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_FLAT_FOREST_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "flat_forest.hpp"
+
+namespace mlpack {
+
+inline FlatForest::FlatForest() :
+    dimensionality(0)
+{
+  // Nothing to do.
+}
+
+template<typename ForestType>
+FlatForest::FlatForest(const ForestType& forest) :
+    dimensionality(0)
+{
+  Flatten(forest);
+}
+
+template<typename ForestType>
+void FlatForest::Flatten(const ForestType& forest)
+{
+  roots.clear();
+  nodeTypes.clear();
+  dimensions.clear();
+  thresholds.clear();
+  offsets.clear();
+  categoryChildren.clear();
+  leafProbabilities.clear();
+  dimensionality = 0;
+
+  for (size_t i = 0; i < forest.NumTrees(); ++i)
+    AddTree(forest.Tree(i));
+}
+
+template<typename TreeType>
+void FlatForest::AddTree(const TreeType& tree)
+{
+  typedef FlatNumericSplit<typename TreeType::NumericSplit> NumericTraits;
+  typedef FlatCategoricalSplit<typename TreeType::CategoricalSplit>
+      CategoricalTraits;
+
+  const size_t numClasses = tree.NumClasses();
+  if (numClasses == 0)
+  {
+    throw std::invalid_argument("FlatForest::AddTree(): the tree is not "
+        "trained!");
+  }
+  else if (roots.n_elem > 0 && numClasses != NumClasses())
+  {
+    std::ostringstream oss;
+    oss << "FlatForest::AddTree(): the tree has " << numClasses << " classes, "
+        << "but the forest has " << NumClasses() << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Visit the nodes breadth-first, so that the children of each node are
+  // consecutive.
+  std::vector<const TreeType*> nodes(1, &tree);
+  size_t numLeaves = 0;
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    if (nodes[i]->NumChildren() == 0)
+      ++numLeaves;
+    for (size_t c = 0; c < nodes[i]->NumChildren(); ++c)
+      nodes.push_back(&nodes[i]->Child(c));
+  }
+
+  const size_t firstNode = nodeTypes.n_elem;
+  const size_t firstLeaf = leafProbabilities.n_cols;
+  roots.resize(roots.n_elem + 1);
+  roots[roots.n_elem - 1] = firstNode;
+  nodeTypes.resize(firstNode + nodes.size());
+  dimensions.resize(firstNode + nodes.size());
+  thresholds.resize(firstNode + nodes.size());
+  offsets.resize(firstNode + nodes.size());
+  leafProbabilities.resize(numClasses, firstLeaf + numLeaves);
+
+  std::vector<size_t> table(categoryChildren.begin(), categoryChildren.end());
+  size_t nextChild = firstNode + 1;
+  size_t nextLeaf = firstLeaf;
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    const TreeType& node = *nodes[i];
+    const size_t n = firstNode + i;
+    dimensions[n] = node.SplitDimension();
+    thresholds[n] = 0.0;
+
+    if (node.NumChildren() == 0)
+    {
+      nodeTypes[n] = Leaf;
+      dimensions[n] = 0;
+      offsets[n] = nextLeaf;
+      leafProbabilities.col(nextLeaf++) = node.ClassProbabilities();
+      continue;
+    }
+
+    dimensionality = std::max(dimensionality, node.SplitDimension() + 1);
+    if (node.SplitDimensionType() == data::Datatype::categorical)
+    {
+      nodeTypes[n] = Categorical;
+      offsets[n] = table.size();
+
+      const arma::vec& splitInfo = node.ClassProbabilities();
+      const size_t numCategories = CategoricalTraits::NumCategories(splitInfo,
+          node.NumChildren());
+      table.push_back(numCategories);
+      for (size_t c = 0; c < numCategories; ++c)
+        table.push_back(nextChild + CategoricalTraits::Child(splitInfo, c));
+    }
+    else
+    {
+      nodeTypes[n] = Numeric;
+      offsets[n] = nextChild;
+      thresholds[n] = NumericTraits::Threshold(node.ClassProbabilities());
+    }
+
+    nextChild += node.NumChildren();
+  }
+
+  categoryChildren = arma::Col<size_t>(table);
+}
+
+template<typename VecType>
+size_t FlatForest::Classify(const VecType& point) const
+{
+  size_t prediction;
+  arma::vec probabilities;
+  Classify(point, prediction, probabilities);
+
+  return prediction;
+}
+
+template<typename VecType>
+void FlatForest::Classify(const VecType& point,
+                          size_t& prediction,
+                          arma::vec& probabilities) const
+{
+  CheckPoints(point.n_elem);
+
+  probabilities.zeros(NumClasses());
+  for (size_t t = 0; t < roots.n_elem; ++t)
+    probabilities += leafProbabilities.col(FindLeaf(t, point, 0));
+
+  probabilities /= roots.n_elem;
+  arma::uword maxIndex = 0;
+  probabilities.max(maxIndex);
+  prediction = (size_t) maxIndex;
+}
+
+template<typename MatType>
+void FlatForest::Classify(const MatType& data,
+                          arma::Row<size_t>& predictions) const
+{
+  arma::mat probabilities;
+  Classify(data, predictions, probabilities);
+}
+
+template<typename MatType>
+void FlatForest::Classify(const MatType& data,
+                          arma::Row<size_t>& predictions,
+                          arma::mat& probabilities) const
+{
+  CheckPoints(data.n_rows);
+
+  const size_t numClasses = NumClasses();
+  probabilities.zeros(numClasses, data.n_cols);
+  predictions.set_size(data.n_cols);
+
+  // Each thread takes a block of points and walks every tree for all of the
+  // points of the block, one tree at a time.
+  const size_t numBlocks = (data.n_cols + BlockSize - 1) / BlockSize;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * BlockSize;
+    const size_t end = std::min(begin + BlockSize, (size_t) data.n_cols);
+    for (size_t t = 0; t < roots.n_elem; ++t)
+    {
+      for (size_t i = begin; i < end; ++i)
+      {
+        const double* leaf = leafProbabilities.colptr(FindLeaf(t, data, i));
+        double* probs = probabilities.colptr(i);
+        for (size_t k = 0; k < numClasses; ++k)
+          probs[k] += leaf[k];
+      }
+    }
+
+    for (size_t i = begin; i < end; ++i)
+    {
+      probabilities.col(i) /= roots.n_elem;
+      arma::uword maxIndex = 0;
+      probabilities.col(i).max(maxIndex);
+      predictions[i] = (size_t) maxIndex;
+    }
+  }
+}
+
+template<typename Archive>
+void FlatForest::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(roots));
+  ar(CEREAL_NVP(nodeTypes));
+  ar(CEREAL_NVP(dimensions));
+  ar(CEREAL_NVP(thresholds));
+  ar(CEREAL_NVP(offsets));
+  ar(CEREAL_NVP(categoryChildren));
+  ar(CEREAL_NVP(leafProbabilities));
+  ar(CEREAL_NVP(dimensionality));
+}
+
+inline void FlatForest::ExportCpp(std::ostream& stream,
+                                  const std::string& namespaceName) const
+{
+  if (roots.n_elem == 0)
+  {
+    throw std::invalid_argument("FlatForest::ExportCpp(): no forest "
+        "flattened!");
+  }
+
+  bool validName = !namespaceName.empty() &&
+      !std::isdigit((unsigned char) namespaceName[0]);
+  for (size_t i = 0; i < namespaceName.size(); ++i)
+  {
+    if (!std::isalnum((unsigned char) namespaceName[i]) &&
+        namespaceName[i] != '_')
+      validName = false;
+  }
+
+  if (!validName)
+  {
+    throw std::invalid_argument("FlatForest::ExportCpp(): '" + namespaceName +
+        "' is not a valid namespace name!");
+  }
+
+  std::string guard = "MLPACK_EXPORTED_MODEL_" + namespaceName + "_HPP";
+  for (size_t i = 0; i < guard.size(); ++i)
+    guard[i] = (char) std::toupper((unsigned char) guard[i]);
+
+  // Thresholds and probabilities are written with enough digits to be read
+  // back exactly.
+  const std::streamsize oldPrecision = stream.precision(
+      std::numeric_limits<double>::max_digits10);
+
+  const size_t numClasses = NumClasses();
+  stream << "// Generated by mlpack from a trained forest of " << NumTrees()
+      << " tree(s)." << std::endl
+      << "#ifndef " << guard << std::endl
+      << "#define " << guard << std::endl
+      << std::endl
+      << "#include <cstddef>" << std::endl
+      << std::endl
+      << "namespace " << namespaceName << " {" << std::endl
+      << std::endl
+      << "//! The number of classes." << std::endl
+      << "static const std::size_t NumClasses = " << numClasses << ";"
+      << std::endl
+      << "//! The smallest number of values of a point." << std::endl
+      << "static const std::size_t Dimensionality = " << dimensionality << ";"
+      << std::endl
+      << std::endl
+      << "namespace detail {" << std::endl
+      << std::endl
+      << "//! The class probabilities of each leaf." << std::endl
+      << "static const double leafProbabilities[" << leafProbabilities.n_cols
+      << "][" << numClasses << "] = {" << std::endl;
+  for (size_t l = 0; l < leafProbabilities.n_cols; ++l)
+  {
+    stream << "  {";
+    for (size_t k = 0; k < numClasses; ++k)
+      stream << ((k == 0) ? " " : ", ") << leafProbabilities(k, l);
+    stream << " }" << ((l + 1 < leafProbabilities.n_cols) ? "," : "")
+        << std::endl;
+  }
+  stream << "};" << std::endl;
+
+  for (size_t t = 0; t < roots.n_elem; ++t)
+  {
+    stream << std::endl
+        << "//! Return the leaf of tree " << t << " that the point falls into."
+        << std::endl
+        << "inline std::size_t Tree" << t << "(const double* point)"
+        << std::endl
+        << "{" << std::endl;
+    ExportNode(stream, roots[t], 1);
+    stream << "}" << std::endl;
+  }
+
+  stream << std::endl
+      << "} // namespace detail" << std::endl
+      << std::endl
+      << "//! Predict the class of the given point, and store the class "
+      << "probabilities" << std::endl
+      << "//! if probabilities is not NULL." << std::endl
+      << "inline std::size_t Predict(const double* point,"
+      << " double* probabilities = 0)" << std::endl
+      << "{" << std::endl
+      << "  double p[NumClasses] = { 0.0 };" << std::endl
+      << "  const double* leaf;" << std::endl;
+  for (size_t t = 0; t < roots.n_elem; ++t)
+  {
+    stream << "  leaf = detail::leafProbabilities[detail::Tree" << t
+        << "(point)];" << std::endl
+        << "  for (std::size_t k = 0; k < NumClasses; ++k)" << std::endl
+        << "    p[k] += leaf[k];" << std::endl;
+  }
+  stream << std::endl
+      << "  std::size_t prediction = 0;" << std::endl
+      << "  for (std::size_t k = 0; k < NumClasses; ++k)" << std::endl
+      << "  {" << std::endl
+      << "    p[k] /= " << roots.n_elem << ".0;" << std::endl
+      << "    if (p[k] > p[prediction])" << std::endl
+      << "      prediction = k;" << std::endl
+      << "  }" << std::endl
+      << std::endl
+      << "  if (probabilities)" << std::endl
+      << "    for (std::size_t k = 0; k < NumClasses; ++k)" << std::endl
+      << "      probabilities[k] = p[k];" << std::endl
+      << std::endl
+      << "  return prediction;" << std::endl
+      << "}" << std::endl
+      << std::endl
+      << "} // namespace " << namespaceName << std::endl
+      << std::endl
+      << "#endif" << std::endl;
+
+  stream.precision(oldPrecision);
+}
+
+inline void FlatForest::ExportNode(std::ostream& stream,
+                                   const size_t node,
+                                   const size_t depth) const
+{
+  const std::string indent(2 * depth, ' ');
+  if (nodeTypes[node] == Leaf)
+  {
+    stream << indent << "return " << offsets[node] << ";" << std::endl;
+  }
+  else if (nodeTypes[node] == Numeric)
+  {
+    stream << indent << "if (point[" << dimensions[node] << "] <= "
+        << thresholds[node] << ")" << std::endl
+        << indent << "{" << std::endl;
+    ExportNode(stream, offsets[node], depth + 1);
+    stream << indent << "}" << std::endl
+        << indent << "else" << std::endl
+        << indent << "{" << std::endl;
+    ExportNode(stream, offsets[node] + 1, depth + 1);
+    stream << indent << "}" << std::endl;
+  }
+  else
+  {
+    // As in FindLeaf(), unknown categories go to the child of category 0.
+    // Categories that go to the same child share one case.
+    const size_t* table = categoryChildren.memptr() + offsets[node];
+    const size_t numCategories = table[0];
+    std::vector<size_t> children;
+    for (size_t c = 0; c < numCategories; ++c)
+      if (std::find(children.begin(), children.end(), table[1 + c]) ==
+          children.end())
+        children.push_back(table[1 + c]);
+
+    stream << indent << "switch ((point[" << dimensions[node] << "] >= 0.0) ? "
+        << "(std::size_t) point[" << dimensions[node] << "] : "
+        << numCategories << ")" << std::endl
+        << indent << "{" << std::endl;
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+      for (size_t c = 0; c < numCategories; ++c)
+        if (table[1 + c] == children[i])
+          stream << indent << "  case " << c << ":" << std::endl;
+      if (children[i] == table[1])
+        stream << indent << "  default:" << std::endl;
+
+      stream << indent << "  {" << std::endl;
+      ExportNode(stream, children[i], depth + 2);
+      stream << indent << "  }" << std::endl;
+    }
+    stream << indent << "}" << std::endl;
+  }
+}
+
+template<typename MatType>
+size_t FlatForest::FindLeaf(const size_t tree,
+                            const MatType& data,
+                            const size_t col) const
+{
+  size_t node = roots[tree];
+  while (nodeTypes[node] != Leaf)
+  {
+    const double value = data(dimensions[node], col);
+    if (nodeTypes[node] == Numeric)
+    {
+      node = offsets[node] + ((value <= thresholds[node]) ? 0 : 1);
+    }
+    else
+    {
+      // Unknown categories go to the first child.
+      const size_t* table = categoryChildren.memptr() + offsets[node];
+      const size_t category = (value >= 0.0) ? (size_t) value : table[0];
+      node = (category < table[0]) ? table[1 + category] : table[1];
+    }
+  }
+
+  return offsets[node];
+}
+
+inline void FlatForest::CheckPoints(const size_t pointDimensionality) const
+{
+  if (roots.n_elem == 0)
+  {
+    throw std::invalid_argument("FlatForest::Classify(): no forest "
+        "flattened!");
+  }
+
+  if (pointDimensionality < dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "FlatForest::Classify(): dimensionality of points ("
+        << pointDimensionality << ") is less than the dimensionality required "
+        << "by the forest (" << dimensionality << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+}
+
+} // namespace mlpack
+
+#endif
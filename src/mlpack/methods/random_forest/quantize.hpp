@@ -0,0 +1,160 @@
+/**
+ * @file methods/random_forest/quantize.hpp
+ *
+ * Implementation of the QuantizeDataset() function, which bins each dimension
+ * of a dataset into one byte, and of UnquantizeSplits(), which converts the
+ * splits of a tree trained on the quantized dataset back to the original
+ * values.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_QUANTIZE_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_QUANTIZE_HPP
+
+#include <mlpack/methods/decision_tree/split_functions/histogram_numeric_split.hpp>
+
+namespace mlpack {
+
+/**
+ * Quantize the given dataset to one byte for each value.  Each numeric
+ * dimension is binned into at most 256 quantile buckets with
+ * HistogramNumericSplit::Bin(), and the value of a point is the index of its
+ * bucket; the values of categorical dimensions (which must have at most 256
+ * categories) are kept.  For each numeric dimension d, splitPoints[d][b] is a
+ * value that is at least as large as every value of the buckets 0 to b, and
+ * smaller than every value of the later buckets; so, a split of the quantized
+ * dimension at b + 0.5 is the same as a split of the original dimension at
+ * splitPoints[d][b].  splitPoints[d] is empty for categorical dimensions.
+ *
+ * @param dataset Dataset to quantize.
+ * @param datasetInfo Types of the dimensions of the dataset.
+ * @param useDatasetInfo If false, all dimensions are numeric.
+ * @param quantized Will hold the quantized dataset.
+ * @param splitPoints Will hold the split points of each numeric dimension.
+ */
+template<typename MatType>
+void QuantizeDataset(const MatType& dataset,
+                     const data::DatasetInfo& datasetInfo,
+                     const bool useDatasetInfo,
+                     arma::Mat<unsigned char>& quantized,
+                     std::vector<arma::vec>& splitPoints)
+{
+  typedef HistogramNumericSplit<GiniGain> Histogram;
+
+  if (useDatasetInfo)
+  {
+    for (size_t d = 0; d < dataset.n_rows; ++d)
+    {
+      if (datasetInfo.Type(d) == data::Datatype::categorical &&
+          datasetInfo.NumMappings(d) > Histogram::MaxBins)
+      {
+        std::ostringstream oss;
+        oss << "QuantizeDataset(): dimension " << d << " has "
+            << datasetInfo.NumMappings(d) << " categories, but at most "
+            << Histogram::MaxBins << " are supported!";
+        throw std::invalid_argument(oss.str());
+      }
+    }
+  }
+
+  quantized.set_size(dataset.n_rows, dataset.n_cols);
+  splitPoints.clear();
+  splitPoints.resize(dataset.n_rows);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t d = 0; d < dataset.n_rows; ++d)
+  {
+    if (useDatasetInfo && datasetInfo.Type(d) == data::Datatype::categorical)
+    {
+      for (size_t i = 0; i < dataset.n_cols; ++i)
+        quantized(d, i) = (unsigned char) dataset(d, i);
+      continue;
+    }
+
+    arma::Row<unsigned char> bins;
+    arma::Col<size_t> binCounts;
+    arma::vec binMin, binMax;
+    const size_t numBins = Histogram::Bin(dataset.row(d), bins, binCounts,
+        binMin, binMax);
+    quantized.row(d) = bins;
+
+    // The split point after bucket b is halfway between the largest value of
+    // the buckets up to b and the smallest value of the buckets after it.
+    // Some buckets may be empty.
+    arma::vec& points = splitPoints[d];
+    points.set_size(numBins);
+    double lowerMax = -DBL_MAX;
+    for (size_t b = 0; b < numBins; ++b)
+    {
+      if (binCounts[b] > 0)
+        lowerMax = binMax[b];
+
+      size_t next = b + 1;
+      while (next < numBins && binCounts[next] == 0)
+        ++next;
+
+      if (next == numBins)
+      {
+        points[b] = lowerMax;
+      }
+      else if (lowerMax == -DBL_MAX)
+      {
+        points[b] = std::nexttoward(binMin[next], -DBL_MAX);
+      }
+      else
+      {
+        points[b] = (lowerMax + binMin[next]) / 2.0;
+        // Make sure the smallest value of the next bucket goes right.
+        if (points[b] == binMin[next])
+          points[b] = lowerMax;
+      }
+    }
+  }
+}
+
+/**
+ * Convert the numeric splits of the given tree, which was trained on a dataset
+ * quantized by QuantizeDataset(), into splits of the original dimensions, so
+ * that the tree can classify points that are not quantized.  The numeric split
+ * type of the tree must send points whose value is at most splitInfo[0] to the
+ * first child, as all the numeric splits of mlpack do.
+ *
+ * @param node Tree (or node of a tree) to convert.
+ * @param splitPoints Split points of each dimension, from QuantizeDataset().
+ */
+template<typename TreeType>
+void UnquantizeSplits(TreeType& node,
+                      const std::vector<arma::vec>& splitPoints)
+{
+  if (node.NumChildren() == 0)
+    return;
+
+  if (node.SplitDimensionType() == data::Datatype::numeric)
+  {
+    // Points of the quantized dimension with value at most the split go to the
+    // first child; since values are bucket indices, this is the same as a
+    // split after the bucket floor(split).
+    const arma::vec& points = splitPoints[node.SplitDimension()];
+    double& split = node.ClassProbabilities()[0];
+    if (split < 0.0)
+    {
+      split = -DBL_MAX;
+    }
+    else
+    {
+      const size_t bin = std::min((size_t) std::floor(split),
+          (size_t) points.n_elem - 1);
+      split = points[bin];
+    }
+  }
+
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    UnquantizeSplits(node.Child(i), splitPoints);
+}
+
+} // namespace mlpack
+
+#endif
@@ -14,6 +14,7 @@
 
 #include <mlpack/methods/decision_tree/decision_tree.hpp>
 #include "bootstrap.hpp"
+#include "quantize.hpp"
 
 namespace mlpack {
 
@@ -184,6 +185,8 @@ class RandomForest
    * @param maximumDepth Maximum depth for the tree.
    * @param warmStart When set to `true`, it adds `numTrees` new trees to the
    *     existing random forest otherwise a new forest is trained from scratch.
+   *     The data must have the dimensions and the number of classes of the
+   *     data the existing trees were trained on.
    * @param dimensionSelector Instantiated dimension selection policy.
    * @return The average entropy of all the decision trees trained under forest.
    */
@@ -218,6 +221,8 @@ class RandomForest
    * @param maximumDepth Maximum depth for the tree.
    * @param warmStart When set to `true`, it adds `numTrees` new trees to the
    *     existing random forest else a new forest is trained from scratch.
+   *     The data must have the dimensions and the number of classes of the
+   *     data the existing trees were trained on.
    * @param dimensionSelector Instantiated dimension selection policy.
    * @return The average entropy of all the decision trees trained under forest.
    */
@@ -251,6 +256,8 @@ class RandomForest
    * @param maximumDepth Maximum depth for the tree.
    * @param warmStart When set to `true`, it adds `numTrees` new trees to the
    *     existing random forest else a new forest is trained from scratch.
+   *     The data must have the dimensions and the number of classes of the
+   *     data the existing trees were trained on.
    * @param dimensionSelector Instantiated dimension selection policy.
    * @return The average entropy of all the decision trees trained under forest.
    */
@@ -286,6 +293,8 @@ class RandomForest
    * @param maximumDepth Maximum depth for the tree.
    * @param warmStart When set to `true`, it adds `numTrees` new trees to the
    *     existing random forest else a new forest is trained from scratch.
+   *     The data must have the dimensions and the number of classes of the
+   *     data the existing trees were trained on.
    * @param dimensionSelector Instantiated dimension selection policy.
    * @return The average entropy of all the decision trees trained under forest.
    */
@@ -303,6 +312,83 @@ class RandomForest
                DimensionSelectionType dimensionSelector =
                    DimensionSelectionType());
 
+  /**
+   * Train the random forest on the given labeled training data, after
+   * quantizing each dimension to one byte.  The data is binned only once (see
+   * QuantizeDataset()): each numeric dimension is binned into at most 256
+   * quantile buckets.  Instead of a bootstrapped copy of the data, the
+   * bootstrap sample of each tree is the number of times each point is drawn,
+   * which is used as the weight of the point; each tree is trained on the
+   * quantized values of the points that are drawn at least once, which takes
+   * about a twelfth of the memory of a bootstrapped copy of a dataset of
+   * doubles.  After each tree is trained, its splits are converted
+   * back to the original values, so the forest classifies points that are not
+   * quantized, like a forest trained by Train().
+   *
+   * Since splits are only made between buckets, the trees may differ from
+   * those built by Train() when a dimension has more than 256 distinct values.
+   * A point drawn several times counts once towards minimumLeafSize.
+   *
+   * @param data Dataset to train on.
+   * @param labels Labels for dataset.
+   * @param numClasses Number of classes in dataset.
+   * @param numTrees Number of trees in the forest.
+   * @param minimumLeafSize Minimum number of points in each tree's leaf nodes.
+   * @param minimumGainSplit Minimum gain for splitting a decision tree node.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param warmStart When set to `true`, it adds `numTrees` new trees to the
+   *     existing random forest else a new forest is trained from scratch.
+   *     The data must have the dimensions and the number of classes of the
+   *     data the existing trees were trained on.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @return The average entropy of all the decision trees trained under forest.
+   */
+  template<typename MatType>
+  double TrainQuantized(const MatType& data,
+                        const arma::Row<size_t>& labels,
+                        const size_t numClasses,
+                        const size_t numTrees = 20,
+                        const size_t minimumLeafSize = 1,
+                        const double minimumGainSplit = 1e-7,
+                        const size_t maximumDepth = 0,
+                        const bool warmStart = false,
+                        DimensionSelectionType dimensionSelector =
+                            DimensionSelectionType());
+
+  /**
+   * Train the random forest on the given labeled training data with the given
+   * dataset info, after quantizing each numeric dimension to one byte; see the
+   * other overload of TrainQuantized() for details.  Categorical dimensions
+   * must have at most 256 categories.
+   *
+   * @param data Dataset to train on.
+   * @param datasetInfo Dimension info for the dataset.
+   * @param labels Labels for dataset.
+   * @param numClasses Number of classes in dataset.
+   * @param numTrees Number of trees in the forest.
+   * @param minimumLeafSize Minimum number of points in each tree's leaf nodes.
+   * @param minimumGainSplit Minimum gain for splitting a decision tree node.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param warmStart When set to `true`, it adds `numTrees` new trees to the
+   *     existing random forest else a new forest is trained from scratch.
+   *     The data must have the dimensions and the number of classes of the
+   *     data the existing trees were trained on.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @return The average entropy of all the decision trees trained under forest.
+   */
+  template<typename MatType>
+  double TrainQuantized(const MatType& data,
+                        const data::DatasetInfo& datasetInfo,
+                        const arma::Row<size_t>& labels,
+                        const size_t numClasses,
+                        const size_t numTrees = 20,
+                        const size_t minimumLeafSize = 1,
+                        const double minimumGainSplit = 1e-7,
+                        const size_t maximumDepth = 0,
+                        const bool warmStart = false,
+                        DimensionSelectionType dimensionSelector =
+                            DimensionSelectionType());
+
   /**
    * Predict the class of the given point.  If the random forest has not been
    * trained, this will throw an exception.
@@ -359,6 +445,58 @@ class RandomForest
   //! Get the number of trees in the forest.
   size_t NumTrees() const { return trees.size(); }
 
+  /**
+   * Train each of the next trees with its own seed, so that the trees do not
+   * depend on the threads (or the machines) that train them: the tree at
+   * position i of this forest is trained with the seed
+   * (seed + firstTreeIndex + i).  Forests trained on different machines with
+   * the same seed and consecutive ranges of tree indices can be merged with
+   * Merge() into the same forest as one trained with all the trees at once.
+   * With Armadillo versions older than 12.6.2, whose random number generator is
+   * shared by all threads, the trees are only reproducible with one thread.
+   *
+   * @param seed Seed of the first tree.
+   * @param firstTreeIndex Index of the first tree of this forest among all the
+   *     trees that are trained with this seed.
+   */
+  void SetTreeSeeds(const size_t seed, const size_t firstTreeIndex = 0);
+
+  /**
+   * Add the trees of the given forest to this forest, after its own trees.
+   * Both forests must be trained for the same number of classes.
+   *
+   * @param other Forest to take the trees of.
+   */
+  void Merge(const RandomForest& other);
+
+  /**
+   * Move the trees of the given forest to the end of this forest, leaving it
+   * empty.  Both forests must be trained for the same number of classes.
+   *
+   * @param other Forest to take the trees of.
+   */
+  void Merge(RandomForest&& other);
+
+  /**
+   * Remove the given number of the oldest trees, at the start of the forest.
+   * Since a warm start adds its trees at the end of the forest, a forest can be
+   * refreshed with newer data by training a few new trees with
+   * `warmStart = true` and removing as many of the oldest trees, instead of
+   * training the whole forest again.  The trees that are trained with their
+   * own seeds (see SetTreeSeeds()) keep their seed, so the next trees don't
+   * reuse the seeds of the remaining ones.
+   *
+   * @param numTrees Number of trees to remove (at most NumTrees()).
+   */
+  void RemoveOldestTrees(const size_t numTrees);
+
+  /**
+   * Get the dimension information of the data the forest was trained on (all
+   * the dimensions are numeric when no DatasetInfo was given).  This is empty
+   * for forests that were saved by older versions of mlpack.
+   */
+  const data::DatasetInfo& TrainingInfo() const { return trainingInfo; }
+
   /**
    * Serialize the random forest.
    */
@@ -401,11 +539,55 @@ class RandomForest
                DimensionSelectionType& dimensionSelector,
                const bool warmStart = false);
 
+  /**
+   * Perform the actual training of TrainQuantized(), for the public overloads.
+   *
+   * @tparam UseDatasetInfo Whether or not to use the datasetInfo parameter.
+   * @tparam MatType The type of data matrix (i.e. arma::mat).
+   * @return The average entropy of all the decision trees trained under forest.
+   */
+  template<bool UseDatasetInfo, typename MatType>
+  double TrainQuantized(const MatType& data,
+                        const data::DatasetInfo& datasetInfo,
+                        const arma::Row<size_t>& labels,
+                        const size_t numClasses,
+                        const size_t numTrees,
+                        const size_t minimumLeafSize,
+                        const double minimumGainSplit,
+                        const size_t maximumDepth,
+                        DimensionSelectionType& dimensionSelector,
+                        const bool warmStart);
+
+  /**
+   * If the trees are trained with their own seeds, seed the random number
+   * generators of the calling thread for the tree at the given position.
+   */
+  void SeedTree(const size_t index) const;
+
+  /**
+   * Throw std::invalid_argument if new trees, trained for the given number of
+   * classes on data with the given dimension information, can't be added to the
+   * forest.
+   */
+  void CheckCompatible(const data::DatasetInfo& newDatasetInfo,
+                       const size_t numClasses,
+                       const std::string& caller) const;
+
   //! The trees in the forest.
   std::vector<DecisionTreeType> trees;
+  //! The gain of each tree.
+  std::vector<double> gains;
 
   //! The average gain of the forest.
   double avgGain;
+
+  //! The dimension information of the data the trees were trained on.
+  data::DatasetInfo trainingInfo;
+
+  //! Whether the trees are trained with their own seeds.
+  bool seedTrees;
+  //! The seed of the tree at position 0 of the forest, if seedTrees is true.
+  size_t treeSeed;
 };
 
 /**
@@ -442,6 +624,14 @@ using ExtraTrees = RandomForest<FitnessFunction,
 
 } // namespace mlpack
 
+CEREAL_TEMPLATE_CLASS_VERSION((typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap), (mlpack::RandomForest<FitnessFunction,
+    DimensionSelectionType, NumericSplitType, CategoricalSplitType,
+    UseBootstrap>), (1));
+
 // Include implementation.
 #include "random_forest_impl.hpp"
 
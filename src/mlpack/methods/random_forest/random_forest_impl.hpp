@@ -31,7 +31,9 @@ RandomForest<
     CategoricalSplitType,
     UseBootstrap
 >::RandomForest() :
-    avgGain(0.0)
+    avgGain(0.0),
+    seedTrees(false),
+    treeSeed(0)
 {
   // Nothing to do here.
 }
@@ -58,7 +60,9 @@ RandomForest<
                 const double minimumGainSplit,
                 const size_t maximumDepth,
                 DimensionSelectionType dimensionSelector) :
-    avgGain(0.0)
+    avgGain(0.0),
+    seedTrees(false),
+    treeSeed(0)
 {
   // Pass off work to the Train() method.
   data::DatasetInfo info; // Ignored.
@@ -91,7 +95,9 @@ RandomForest<
                 const double minimumGainSplit,
                 const size_t maximumDepth,
                 DimensionSelectionType dimensionSelector):
-                    avgGain(0.0)
+                    avgGain(0.0),
+                    seedTrees(false),
+                    treeSeed(0)
 {
   // Pass off work to the Train() method.
   arma::rowvec weights; // Fake weights, not used.
@@ -123,7 +129,9 @@ RandomForest<
                 const double minimumGainSplit,
                 const size_t maximumDepth,
                 DimensionSelectionType dimensionSelector) :
-    avgGain(0.0)
+    avgGain(0.0),
+    seedTrees(false),
+    treeSeed(0)
 {
   // Pass off work to the Train() method.
   data::DatasetInfo info; // Ignored by Train().
@@ -156,7 +164,9 @@ RandomForest<
                 const double minimumGainSplit,
                 const size_t maximumDepth,
                 DimensionSelectionType dimensionSelector) :
-    avgGain(0.0)
+    avgGain(0.0),
+    seedTrees(false),
+    treeSeed(0)
 {
   // Pass off work to the Train() method.
   Train<true, true>(dataset, datasetInfo, labels, numClasses, weights,
@@ -292,6 +302,68 @@ double RandomForest<
       dimensionSelector, warmStart);
 }
 
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+template<typename MatType>
+double RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::TrainQuantized(const MatType& dataset,
+                  const arma::Row<size_t>& labels,
+                  const size_t numClasses,
+                  const size_t numTrees,
+                  const size_t minimumLeafSize,
+                  const double minimumGainSplit,
+                  const size_t maximumDepth,
+                  const bool warmStart,
+                  DimensionSelectionType dimensionSelector)
+{
+  // Pass off to TrainQuantized().
+  data::DatasetInfo datasetInfo; // Ignored by TrainQuantized().
+  return TrainQuantized<false>(dataset, datasetInfo, labels, numClasses,
+      numTrees, minimumLeafSize, minimumGainSplit, maximumDepth,
+      dimensionSelector, warmStart);
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+template<typename MatType>
+double RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::TrainQuantized(const MatType& dataset,
+                  const data::DatasetInfo& datasetInfo,
+                  const arma::Row<size_t>& labels,
+                  const size_t numClasses,
+                  const size_t numTrees,
+                  const size_t minimumLeafSize,
+                  const double minimumGainSplit,
+                  const size_t maximumDepth,
+                  const bool warmStart,
+                  DimensionSelectionType dimensionSelector)
+{
+  // Pass off to TrainQuantized().
+  return TrainQuantized<true>(dataset, datasetInfo, labels, numClasses,
+      numTrees, minimumLeafSize, minimumGainSplit, maximumDepth,
+      dimensionSelector, warmStart);
+}
+
 template<
     typename FitnessFunction,
     typename DimensionSelectionType,
@@ -436,6 +508,206 @@ void RandomForest<
   }
 }
 
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+void RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::SetTreeSeeds(
+    const size_t seed,
+    const size_t firstTreeIndex)
+{
+  seedTrees = true;
+  treeSeed = seed + firstTreeIndex;
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+void RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::SeedTree(const size_t index) const
+{
+  if (!seedTrees)
+    return;
+
+  RandGen().seed((uint32_t) (treeSeed + index));
+  arma::arma_rng::set_seed(treeSeed + index);
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+void RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::Merge(const RandomForest& other)
+{
+  RandomForest copy(other);
+  Merge(std::move(copy));
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+void RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::Merge(RandomForest&& other)
+{
+  if (other.trees.empty())
+    return;
+
+  CheckCompatible(other.trainingInfo, other.trees[0].NumClasses(),
+      "RandomForest::Merge()");
+  if (trees.empty() || trainingInfo.Dimensionality() == 0)
+    trainingInfo = other.trainingInfo;
+
+  trees.reserve(trees.size() + other.trees.size());
+  for (size_t i = 0; i < other.trees.size(); ++i)
+  {
+    trees.push_back(std::move(other.trees[i]));
+    gains.push_back(other.gains[i]);
+  }
+
+  avgGain = std::accumulate(gains.begin(), gains.end(), 0.0) / trees.size();
+  other.trees.clear();
+  other.gains.clear();
+  other.avgGain = 0.0;
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+void RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::RemoveOldestTrees(const size_t numTrees)
+{
+  if (numTrees > trees.size())
+  {
+    std::ostringstream oss;
+    oss << "RandomForest::RemoveOldestTrees(): cannot remove " << numTrees
+        << " trees from a forest of " << trees.size() << " trees!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  trees.erase(trees.begin(), trees.begin() + numTrees);
+  gains.erase(gains.begin(), gains.begin() + numTrees);
+  treeSeed += numTrees;
+
+  avgGain = trees.empty() ? 0.0 :
+      std::accumulate(gains.begin(), gains.end(), 0.0) / trees.size();
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+void RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::CheckCompatible(
+    const data::DatasetInfo& newDatasetInfo,
+    const size_t numClasses,
+    const std::string& caller) const
+{
+  if (trees.empty())
+    return;
+
+  if (trees[0].NumClasses() != numClasses)
+  {
+    std::ostringstream oss;
+    oss << caller << ": cannot add trees trained for " << numClasses
+        << " classes to a forest trained for " << trees[0].NumClasses()
+        << " classes!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Forests saved by older versions of mlpack have no dimension information.
+  if (trainingInfo.Dimensionality() == 0 ||
+      newDatasetInfo.Dimensionality() == 0)
+    return;
+
+  if (newDatasetInfo.Dimensionality() != trainingInfo.Dimensionality())
+  {
+    std::ostringstream oss;
+    oss << caller << ": cannot add trees trained on data with "
+        << newDatasetInfo.Dimensionality() << " dimensions to a forest "
+        << "trained on data with " << trainingInfo.Dimensionality()
+        << " dimensions!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // The categorical splits of the existing trees have one child per category,
+  // so the categories of each dimension must be the same.
+  for (size_t d = 0; d < trainingInfo.Dimensionality(); ++d)
+  {
+    const bool categorical =
+        (trainingInfo.Type(d) == data::Datatype::categorical);
+    const bool newCategorical =
+        (newDatasetInfo.Type(d) == data::Datatype::categorical);
+    if (categorical != newCategorical || (categorical &&
+        trainingInfo.NumMappings(d) != newDatasetInfo.NumMappings(d)))
+    {
+      std::ostringstream oss;
+      oss << caller << ": dimension " << d << " of the data is "
+          << (newCategorical ? "categorical" : "numeric");
+      if (newCategorical)
+        oss << " with " << newDatasetInfo.NumMappings(d) << " categories";
+      oss << ", but the forest was trained with a "
+          << (categorical ? "categorical" : "numeric") << " dimension";
+      if (categorical)
+        oss << " with " << trainingInfo.NumMappings(d) << " categories";
+      oss << "!";
+      throw std::invalid_argument(oss.str());
+    }
+  }
+}
+
 template<
     typename FitnessFunction,
     typename DimensionSelectionType,
@@ -450,7 +722,7 @@ void RandomForest<
     NumericSplitType,
     CategoricalSplitType,
     UseBootstrap
->::serialize(Archive& ar, const uint32_t /* version */)
+>::serialize(Archive& ar, const uint32_t version)
 {
   size_t numTrees;
   if (cereal::is_loading<Archive>())
@@ -466,6 +738,18 @@ void RandomForest<
 
   ar(CEREAL_NVP(trees));
   ar(CEREAL_NVP(avgGain));
+
+  // Version 1 added the gain of each tree and the dimension information.
+  if (version >= 1)
+  {
+    ar(CEREAL_NVP(gains));
+    ar(CEREAL_NVP(trainingInfo));
+  }
+  else if (cereal::is_loading<Archive>())
+  {
+    gains.assign(numTrees, avgGain);
+    trainingInfo = data::DatasetInfo();
+  }
 }
 
 template<
@@ -494,17 +778,25 @@ double RandomForest<
          DimensionSelectionType& dimensionSelector,
          const bool warmStart)
 {
-  // Reset the forest if we are not doing a warm-start.
+  // Reset the forest if we are not doing a warm-start; otherwise, the new
+  // trees must be trained on the same kind of data as the existing ones.
+  const data::DatasetInfo newDatasetInfo = UseDatasetInfo ? datasetInfo :
+      data::DatasetInfo(dataset.n_rows);
   if (!warmStart)
+  {
     trees.clear();
+    gains.clear();
+  }
+  CheckCompatible(newDatasetInfo, numClasses, "RandomForest::Train()");
+  if (trees.empty() || trainingInfo.Dimensionality() == 0)
+    trainingInfo = newDatasetInfo;
+
   const size_t oldNumTrees = trees.size();
   trees.resize(trees.size() + numTrees);
-
-  // Convert avgGain to total gain.
-  double totalGain = avgGain * oldNumTrees;
+  gains.resize(trees.size());
 
   // Train each tree individually.
-  #pragma omp parallel for reduction( + : totalGain)
+  #pragma omp parallel for
   for (size_t i = 0; i < numTrees; ++i)
   {
     // NOTE: this is a hacky workaround for older versions of Armadillo that did
@@ -525,6 +817,9 @@ double RandomForest<
       #endif
     #endif
 
+    // If each tree has its own seed, it overrides the seeds of the thread.
+    SeedTree(oldNumTrees + i);
+
     MatType bootstrapDataset;
     arma::Row<size_t> bootstrapLabels;
     arma::rowvec bootstrapWeights;
@@ -538,20 +833,22 @@ double RandomForest<
     {
       if (UseDatasetInfo)
       {
-        totalGain += UseBootstrap ?
-            trees[oldNumTrees + i].Train(bootstrapDataset, datasetInfo,
-                bootstrapLabels, numClasses, bootstrapWeights, minimumLeafSize,
-                minimumGainSplit, maximumDepth, dimensionSelector) :
+        gains[oldNumTrees + i] = UseBootstrap ?
+            trees[oldNumTrees + i].Train(std::move(bootstrapDataset),
+                datasetInfo, std::move(bootstrapLabels), numClasses,
+                std::move(bootstrapWeights), minimumLeafSize, minimumGainSplit,
+                maximumDepth, dimensionSelector) :
             trees[oldNumTrees + i].Train(dataset, datasetInfo, labels,
                 numClasses, weights, minimumLeafSize, minimumGainSplit,
                 maximumDepth, dimensionSelector);
       }
       else
       {
-        totalGain += UseBootstrap ?
-            trees[oldNumTrees + i].Train(bootstrapDataset, bootstrapLabels,
-                numClasses, bootstrapWeights, minimumLeafSize,
-                minimumGainSplit, maximumDepth, dimensionSelector) :
+        gains[oldNumTrees + i] = UseBootstrap ?
+            trees[oldNumTrees + i].Train(std::move(bootstrapDataset),
+                std::move(bootstrapLabels), numClasses,
+                std::move(bootstrapWeights), minimumLeafSize, minimumGainSplit,
+                maximumDepth, dimensionSelector) :
             trees[oldNumTrees + i].Train(dataset, labels, numClasses,
                 weights, minimumLeafSize, minimumGainSplit, maximumDepth,
                 dimensionSelector);
@@ -561,20 +858,21 @@ double RandomForest<
     {
       if (UseDatasetInfo)
       {
-        totalGain += UseBootstrap ?
-            trees[oldNumTrees + i].Train(bootstrapDataset, datasetInfo,
-                bootstrapLabels, numClasses, minimumLeafSize, minimumGainSplit,
-                maximumDepth, dimensionSelector) :
+        gains[oldNumTrees + i] = UseBootstrap ?
+            trees[oldNumTrees + i].Train(std::move(bootstrapDataset),
+                datasetInfo, std::move(bootstrapLabels), numClasses,
+                minimumLeafSize, minimumGainSplit, maximumDepth,
+                dimensionSelector) :
             trees[oldNumTrees + i].Train(dataset, datasetInfo, labels,
                 numClasses, minimumLeafSize, minimumGainSplit, maximumDepth,
                 dimensionSelector);
       }
       else
       {
-        totalGain += UseBootstrap ?
-            trees[oldNumTrees + i].Train(bootstrapDataset, bootstrapLabels,
-                numClasses, minimumLeafSize, minimumGainSplit, maximumDepth,
-                dimensionSelector) :
+        gains[oldNumTrees + i] = UseBootstrap ?
+            trees[oldNumTrees + i].Train(std::move(bootstrapDataset),
+                std::move(bootstrapLabels), numClasses, minimumLeafSize,
+                minimumGainSplit, maximumDepth, dimensionSelector) :
             trees[oldNumTrees + i].Train(dataset, labels, numClasses,
                 minimumLeafSize, minimumGainSplit, maximumDepth,
                 dimensionSelector);
@@ -582,7 +880,111 @@ double RandomForest<
     }
   }
 
-  avgGain = totalGain / trees.size();
+  avgGain = std::accumulate(gains.begin(), gains.end(), 0.0) / trees.size();
+  return avgGain;
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+template<bool UseDatasetInfo, typename MatType>
+double RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::TrainQuantized(const MatType& dataset,
+                  const data::DatasetInfo& datasetInfo,
+                  const arma::Row<size_t>& labels,
+                  const size_t numClasses,
+                  const size_t numTrees,
+                  const size_t minimumLeafSize,
+                  const double minimumGainSplit,
+                  const size_t maximumDepth,
+                  DimensionSelectionType& dimensionSelector,
+                  const bool warmStart)
+{
+  util::CheckSameSizes(dataset, labels, "RandomForest::TrainQuantized()");
+
+  // Quantize the dataset once; all of the trees are trained on it.
+  arma::Mat<unsigned char> quantized;
+  std::vector<arma::vec> splitPoints;
+  QuantizeDataset(dataset, datasetInfo, UseDatasetInfo, quantized,
+      splitPoints);
+
+  // Reset the forest if we are not doing a warm-start; otherwise, the new
+  // trees must be trained on the same kind of data as the existing ones.
+  const data::DatasetInfo newDatasetInfo = UseDatasetInfo ? datasetInfo :
+      data::DatasetInfo(dataset.n_rows);
+  if (!warmStart)
+  {
+    trees.clear();
+    gains.clear();
+  }
+  CheckCompatible(newDatasetInfo, numClasses,
+      "RandomForest::TrainQuantized()");
+  if (trees.empty() || trainingInfo.Dimensionality() == 0)
+    trainingInfo = newDatasetInfo;
+
+  const size_t oldNumTrees = trees.size();
+  trees.resize(trees.size() + numTrees);
+  gains.resize(trees.size());
+
+  // Train each tree individually.
+  #pragma omp parallel for
+  for (size_t i = 0; i < numTrees; ++i)
+  {
+    // See the note on the Armadillo RNG seeds in Train().
+    #if (MLPACK_ARMA_VERSION < 1200602) // 12.6.2
+      #ifndef MLPACK_DONT_OVERWRITE_ARMA_RNG_SEEDS
+      arma::arma_rng::set_seed(RandGen()());
+      #endif
+    #endif
+
+    // If each tree has its own seed, it overrides the seeds of the thread.
+    SeedTree(oldNumTrees + i);
+
+    DecisionTreeType& tree = trees[oldNumTrees + i];
+    if (UseBootstrap)
+    {
+      // The bootstrap sample is given by the number of times each point is
+      // drawn; only the points that are drawn are copied, and their counts are
+      // their weights.
+      arma::rowvec counts;
+      BootstrapCounts(dataset.n_cols, counts);
+      const arma::uvec inBag = arma::find(counts > 0.0);
+
+      arma::Mat<unsigned char> treeData = quantized.cols(inBag);
+      arma::Row<size_t> treeLabels = labels.cols(inBag);
+      arma::rowvec treeWeights = counts.cols(inBag);
+      gains[oldNumTrees + i] = UseDatasetInfo ?
+          tree.Train(std::move(treeData), datasetInfo, std::move(treeLabels),
+              numClasses, std::move(treeWeights), minimumLeafSize,
+              minimumGainSplit, maximumDepth, dimensionSelector) :
+          tree.Train(std::move(treeData), std::move(treeLabels), numClasses,
+              std::move(treeWeights), minimumLeafSize, minimumGainSplit,
+              maximumDepth, dimensionSelector);
+    }
+    else
+    {
+      gains[oldNumTrees + i] = UseDatasetInfo ?
+          tree.Train(quantized, datasetInfo, labels, numClasses,
+              minimumLeafSize, minimumGainSplit, maximumDepth,
+              dimensionSelector) :
+          tree.Train(quantized, labels, numClasses, minimumLeafSize,
+              minimumGainSplit, maximumDepth, dimensionSelector);
+    }
+
+    // Convert the splits of the tree back to the original values.
+    UnquantizeSplits(tree, splitPoints);
+  }
+
+  avgGain = std::accumulate(gains.begin(), gains.end(), 0.0) / trees.size();
   return avgGain;
 }
 
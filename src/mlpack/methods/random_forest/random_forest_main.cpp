@@ -16,6 +16,7 @@
 
 #include <mlpack/core/util/mlpack_main.hpp>
 #include <mlpack/methods/random_forest/random_forest.hpp>
+#include <mlpack/methods/random_forest/flat_forest.hpp>
 
 using namespace mlpack;
 using namespace mlpack::util;
@@ -71,7 +72,30 @@ BINDING_LONG_DESC(
     PRINT_PARAM_STRING("test_labels") + " parameter.  Predictions for each "
     "test point may be saved via the " + PRINT_PARAM_STRING("predictions") +
     "output parameter.  Class probabilities for each prediction may be saved "
-    "with the " + PRINT_PARAM_STRING("probabilities") + " output parameter.");
+    "with the " + PRINT_PARAM_STRING("probabilities") + " output parameter."
+    "\n\n"
+    "For fast scoring without mlpack, the " + PRINT_PARAM_STRING("export_cpp") +
+    " parameter may be used to write the forest to a self-contained C++ header "
+    "file that defines a function `model::Predict(const double* point, "
+    "double* probabilities = 0)`, in which each tree is compiled into nested "
+    "if/else statements."
+    "\n\n"
+    "Large forests can be trained on several machines: with the same nonzero " +
+    PRINT_PARAM_STRING("seed") + ", each tree is trained with its own seed, "
+    "given by the seed and its index among all the trees, and " +
+    PRINT_PARAM_STRING("first_tree") + " gives the index of the first tree "
+    "trained by each machine.  The forests can then be combined by passing one "
+    "of them as " + PRINT_PARAM_STRING("merge_model") + ", whose trees are "
+    "added to the trained or input model."
+    "\n\n"
+    "With " + PRINT_PARAM_STRING("warm_start") + ", the trees trained on the "
+    "given data are added to the trees of the " +
+    PRINT_PARAM_STRING("input_model") + ", which must have been trained on "
+    "data with the same dimensions and for the same classes.  A model can be "
+    "refreshed with newer data without training all of its trees again, by "
+    "training a few new trees and passing " +
+    PRINT_PARAM_STRING("replace_trees") + " to remove as many of the oldest "
+    "trees of the model.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -124,6 +148,8 @@ PARAM_MATRIX_OUT("probabilities", "Predicted class probabilities for each "
     "point in the test set.", "P");
 PARAM_UROW_OUT("predictions", "Predicted classes for each point in the test "
     "set.", "p");
+PARAM_STRING_IN("export_cpp", "If specified, a C++ header file with a "
+    "Predict() function for the forest is written to this file.", "E", "");
 
 PARAM_DOUBLE_IN("minimum_gain_split", "Minimum gain needed to make a split "
     "when building a tree.", "g", 0);
@@ -134,6 +160,12 @@ PARAM_INT_IN("subspace_dim", "Dimensionality of random subspace to use for "
 PARAM_INT_IN("seed", "Random seed.  If 0, 'std::time(NULL)' is used.", "s", 0);
 PARAM_FLAG("warm_start", "If true and passed along with `training` and "
     "`input_model` then trains more trees on top of existing model.", "w");
+PARAM_INT_IN("replace_trees", "With warm_start, the number of the oldest trees "
+    "of the input model that are removed once the new trees are trained.", "r",
+    0);
+PARAM_INT_IN("first_tree", "Index of the first tree trained by this run among "
+    "all the trees trained with the same seed; with a nonzero seed, each tree "
+    "is trained with its own seed given by the seed and its index.", "f", 0);
 
 /**
  * This is the class that we will serialize.  It is a pretty simple wrapper
@@ -161,6 +193,9 @@ PARAM_MODEL_IN(RandomForestModel, "input_model", "Pre-trained random forest to "
     "use for classification.", "m");
 PARAM_MODEL_OUT(RandomForestModel, "output_model", "Model to save trained "
     "random forest to.", "M");
+PARAM_MODEL_IN(RandomForestModel, "merge_model", "Random forest whose trees "
+    "are added to the trained or input model (for instance, a forest trained "
+    "on another machine).", "G");
 
 void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 {
@@ -187,8 +222,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   ReportIgnoredParam(params, {{ "test", false }}, "test_labels");
 
   RequireAtLeastOnePassed(params, { "test", "output_model",
-      "print_training_accuracy" }, false, "the trained forest model will not "
-      "be used or saved");
+      "print_training_accuracy", "export_cpp" }, false, "the trained forest "
+      "model will not be used or saved");
 
   if (params.Has("training"))
   {
@@ -215,6 +250,13 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 
   ReportIgnoredParam(params, {{ "training", false }}, "num_trees");
   ReportIgnoredParam(params, {{ "training", false }}, "minimum_leaf_size");
+  ReportIgnoredParam(params, {{ "training", false }}, "first_tree");
+  ReportIgnoredParam(params, {{ "seed", false }}, "first_tree");
+  RequireParamValue<int>(params, "first_tree", [](int x) { return x >= 0; },
+      true, "index of the first tree must not be negative");
+  ReportIgnoredParam(params, {{ "warm_start", false }}, "replace_trees");
+  RequireParamValue<int>(params, "replace_trees", [](int x) { return x >= 0; },
+      true, "number of trees to replace must not be negative");
 
   RandomForestModel* rfModel;
   // Input model is loaded when we are either doing warm-started training or
@@ -252,12 +294,48 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     Log::Info << "Training random forest with " << numTrees << " trees..."
         << endl;
 
-    const size_t numClasses = max(labels) + 1;
+    // A warm start keeps the classes of the input model, which the new labels
+    // may not all have.
+    size_t numClasses = max(labels) + 1;
+    const size_t oldNumTrees = rfModel->rf.NumTrees();
+    if (params.Has("warm_start") && oldNumTrees > 0)
+    {
+      const size_t modelClasses = rfModel->rf.Tree(0).NumClasses();
+      if (numClasses > modelClasses)
+      {
+        Log::Fatal << "The labels must be less than the number of classes of "
+            << "the input model (" << modelClasses << ")!" << endl;
+      }
+      numClasses = modelClasses;
+    }
+
+    const size_t replacedTrees = (size_t) params.Get<int>("replace_trees");
+    if (params.Has("warm_start") && replacedTrees > oldNumTrees)
+    {
+      Log::Fatal << "Cannot replace " << replacedTrees << " trees of an input "
+          << "model with " << oldNumTrees << " trees!" << endl;
+    }
+
+    // With a seed, each tree gets its own seed, so that the forest does not
+    // depend on how its trees are split among threads or machines.
+    if (params.Get<int>("seed") != 0)
+    {
+      rfModel->rf.SetTreeSeeds((size_t) params.Get<int>("seed"),
+          (size_t) params.Get<int>("first_tree"));
+    }
 
     // Train the model.
     rfModel->rf.Train(data, labels, numClasses, numTrees, minimumLeafSize,
         minimumGainSplit, maxDepth, params.Has("warm_start"), mrds);
 
+    // Remove the oldest trees, if they are replaced by the new ones.
+    if (params.Has("warm_start") && replacedTrees > 0)
+    {
+      Log::Info << "Removing the " << replacedTrees << " oldest trees..."
+          << endl;
+      rfModel->rf.RemoveOldestTrees(replacedTrees);
+    }
+
     timers.Stop("rf_training");
 
     // Did we want training accuracy?
@@ -276,6 +354,10 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     }
   }
 
+  // Add the trees of another forest, if needed.
+  if (params.Has("merge_model"))
+    rfModel->rf.Merge(params.Get<RandomForestModel*>("merge_model")->rf);
+
   if (params.Has("test"))
   {
     arma::mat testData = std::move(params.Get<arma::mat>("test"));
@@ -305,6 +387,20 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     params.Get<arma::Row<size_t>>("predictions") = std::move(predictions);
   }
 
+  // Export the forest as C++ code, if needed.
+  if (params.Has("export_cpp"))
+  {
+    const string filename = params.Get<string>("export_cpp");
+    ofstream stream(filename);
+    if (!stream.is_open())
+    {
+      Log::Fatal << "Cannot open '" << filename << "' to export the forest to!"
+          << endl;
+    }
+
+    FlatForest(rfModel->rf).ExportCpp(stream);
+  }
+
   // Save the output model.
   params.Get<RandomForestModel*>("output_model") = rfModel;
 }
@@ -0,0 +1,146 @@
+/**
+ * @file methods/random_fourier_features/random_fourier_features.hpp
+ *
+ * Random Fourier features: an explicit, randomized feature map whose dot
+ * products approximate a shift-invariant kernel.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOURIER_FEATURES_RANDOM_FOURIER_FEATURES_HPP
+#define MLPACK_METHODS_RANDOM_FOURIER_FEATURES_RANDOM_FOURIER_FEATURES_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+
+/**
+ * Random Fourier features (Rahimi and Recht, 2007) map each point x to
+ *
+ * @f[
+ * z(x) = \sqrt{2 / D} \cos(W x + b),
+ * @f]
+ *
+ * where the D rows of W are drawn from the Fourier transform of the kernel and
+ * b is uniform in [0, 2 pi), so that z(x)^T z(y) is an unbiased estimate of
+ * K(x, y).  The kernel matrix is never computed: transforming n points costs
+ * one matrix multiplication and nD cosines, and each point is transformed
+ * independently, so a dataset can be transformed in batches.  The features can
+ * then be given to any linear method (for instance LinearSVM or
+ * LogisticRegression) in place of a kernel method, and they are used by
+ * RandomFourierFeaturesKernelRule for KernelPCA.
+ *
+ * The supported kernels are GaussianKernel, LaplacianKernel and CauchyKernel.
+ *
+ * @code
+ * @inproceedings{rahimi2007random,
+ *   title={Random Features for Large-Scale Kernel Machines},
+ *   author={Rahimi, Ali and Recht, Benjamin},
+ *   booktitle={Advances in Neural Information Processing Systems 20},
+ *   pages={1177--1184},
+ *   year={2007}
+ * }
+ * @endcode
+ *
+ * @code
+ * RandomFourierFeatures<GaussianKernel> rff(1000, GaussianKernel(2.0));
+ * rff.Fit(trainData);
+ *
+ * arma::mat trainFeatures, testFeatures;
+ * rff.Transform(trainData, trainFeatures);
+ * rff.Transform(testData, testFeatures);
+ * @endcode
+ *
+ * @tparam KernelType Shift-invariant kernel to approximate.
+ */
+template<typename KernelType>
+class RandomFourierFeatures
+{
+ public:
+  /**
+   * Create the RandomFourierFeatures object; Fit() must be called before
+   * Transform().
+   *
+   * @param numFeatures Number of features to compute (D).
+   * @param kernel Kernel to approximate.
+   */
+  RandomFourierFeatures(const size_t numFeatures = 100,
+                        const KernelType& kernel = KernelType());
+
+  /**
+   * Draw the frequencies and the phases of the features for points with the
+   * dimensionality of the given dataset.  Only the dimensionality of the
+   * dataset is used; the features do not depend on the points.
+   *
+   * @param input Dataset to fit.
+   */
+  template<typename MatType>
+  void Fit(const MatType& input);
+
+  /**
+   * Draw the frequencies and the phases of the features for points of the
+   * given dimensionality.
+   *
+   * @param dimensionality Dimensionality of the points.
+   */
+  void Fit(const size_t dimensionality);
+
+  /**
+   * Compute the features of the given points (dense or sparse), with one
+   * point in each column; the features of each point are a column of the
+   * output.
+   *
+   * @param input Points to transform.
+   * @param output Matrix to store the features in.
+   */
+  template<typename MatType>
+  void Transform(const MatType& input, arma::mat& output) const;
+
+  //! Get the number of features.
+  size_t NumFeatures() const { return numFeatures; }
+  //! Modify the number of features (call Fit() again afterwards).
+  size_t& NumFeatures() { return numFeatures; }
+
+  //! Get the kernel.
+  const KernelType& Kernel() const { return kernel; }
+  //! Modify the kernel (call Fit() again afterwards).
+  KernelType& Kernel() { return kernel; }
+
+  //! Get the frequencies (one row for each feature).
+  const arma::mat& Frequencies() const { return frequencies; }
+  //! Get the phases (one element for each feature).
+  const arma::vec& Phases() const { return phases; }
+
+  //! Serialize the features.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Draw frequencies from the Fourier transform of the Gaussian kernel.
+  static void SampleFrequencies(const GaussianKernel& kernel,
+                                arma::mat& frequencies);
+  //! Draw frequencies from the Fourier transform of the Laplacian kernel.
+  static void SampleFrequencies(const LaplacianKernel& kernel,
+                                arma::mat& frequencies);
+  //! Draw frequencies from the Fourier transform of the Cauchy kernel.
+  static void SampleFrequencies(const CauchyKernel& kernel,
+                                arma::mat& frequencies);
+
+  //! The number of features.
+  size_t numFeatures;
+  //! The kernel to approximate.
+  KernelType kernel;
+  //! The frequencies, with one row for each feature.
+  arma::mat frequencies;
+  //! The phases, with one element for each feature.
+  arma::vec phases;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "random_fourier_features_impl.hpp"
+
+#endif
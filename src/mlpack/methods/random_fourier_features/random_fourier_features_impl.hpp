@@ -0,0 +1,125 @@
+/**
+ * @file methods/random_fourier_features/random_fourier_features_impl.hpp
+ *
+ * Implementation of random Fourier features.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOURIER_FEATURES_RANDOM_FOURIER_FEATURES_IMPL_HPP
+#define MLPACK_METHODS_RANDOM_FOURIER_FEATURES_RANDOM_FOURIER_FEATURES_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "random_fourier_features.hpp"
+
+namespace mlpack {
+
+template<typename KernelType>
+RandomFourierFeatures<KernelType>::RandomFourierFeatures(
+    const size_t numFeatures,
+    const KernelType& kernel) :
+    numFeatures(numFeatures),
+    kernel(kernel)
+{
+  // Nothing to do.
+}
+
+template<typename KernelType>
+template<typename MatType>
+void RandomFourierFeatures<KernelType>::Fit(const MatType& input)
+{
+  Fit(input.n_rows);
+}
+
+template<typename KernelType>
+void RandomFourierFeatures<KernelType>::Fit(const size_t dimensionality)
+{
+  if (numFeatures == 0)
+  {
+    throw std::invalid_argument("RandomFourierFeatures::Fit(): the number of "
+        "features must be positive");
+  }
+
+  frequencies.set_size(numFeatures, dimensionality);
+  SampleFrequencies(kernel, frequencies);
+  phases = 2.0 * M_PI * arma::randu<arma::vec>(numFeatures);
+}
+
+template<typename KernelType>
+template<typename MatType>
+void RandomFourierFeatures<KernelType>::Transform(const MatType& input,
+                                                  arma::mat& output) const
+{
+  if (frequencies.is_empty())
+  {
+    throw std::runtime_error("RandomFourierFeatures::Transform(): call Fit() "
+        "before Transform()");
+  }
+  if (input.n_rows != frequencies.n_cols)
+  {
+    throw std::invalid_argument("RandomFourierFeatures::Transform(): the "
+        "points have " + std::to_string(input.n_rows) + " dimensions, but the "
+        "features were fitted for " + std::to_string(frequencies.n_cols));
+  }
+
+  output = frequencies * input;
+  output.each_col() += phases;
+  output = std::sqrt(2.0 / numFeatures) * arma::cos(output);
+}
+
+template<typename KernelType>
+template<typename Archive>
+void RandomFourierFeatures<KernelType>::serialize(
+    Archive& ar,
+    const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(numFeatures));
+  ar(CEREAL_NVP(kernel));
+  ar(CEREAL_NVP(frequencies));
+  ar(CEREAL_NVP(phases));
+}
+
+// The Fourier transform of exp(-|| d ||^2 / (2 bw^2)) is a Gaussian with
+// covariance I / bw^2.
+template<typename KernelType>
+void RandomFourierFeatures<KernelType>::SampleFrequencies(
+    const GaussianKernel& kernel,
+    arma::mat& frequencies)
+{
+  frequencies.randn();
+  frequencies /= kernel.Bandwidth();
+}
+
+// The Fourier transform of exp(-|| d || / bw) is a multivariate Cauchy
+// distribution with scale 1 / bw: a Gaussian frequency divided by |g| / bw,
+// with g a standard Gaussian shared by the whole frequency.
+template<typename KernelType>
+void RandomFourierFeatures<KernelType>::SampleFrequencies(
+    const LaplacianKernel& kernel,
+    arma::mat& frequencies)
+{
+  frequencies.randn();
+  const arma::vec scales = kernel.Bandwidth() *
+      arma::abs(arma::randn<arma::vec>(frequencies.n_rows));
+  frequencies.each_col() /= scales;
+}
+
+// 1 / (1 + || d ||^2 / bw^2) is the expectation of exp(-t || d ||^2 / bw^2)
+// over t ~ Exp(1), so each frequency is a Gaussian with covariance
+// (2 t / bw^2) I, with its own t.
+template<typename KernelType>
+void RandomFourierFeatures<KernelType>::SampleFrequencies(
+    const CauchyKernel& kernel,
+    arma::mat& frequencies)
+{
+  frequencies.randn();
+  const arma::vec scales = arma::sqrt(2.0 * arma::randg<arma::vec>(
+      frequencies.n_rows, arma::distr_param(1.0, 1.0))) / kernel.Bandwidth();
+  frequencies.each_col() %= scales;
+}
+
+} // namespace mlpack
+
+#endif
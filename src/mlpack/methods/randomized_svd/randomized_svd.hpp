@@ -46,6 +46,11 @@ namespace mlpack {
  * }
  * @endcode
  *
+ * The data can be dense or sparse (e.g. `arma::mat`, `arma::fmat`,
+ * `arma::sp_mat`); sparse data is only used in products with dense matrices,
+ * and is never centered or converted to a dense matrix.  The singular vectors
+ * and values have the element type of `MatType` and `VecType`.
+ *
  * An example of how to use the interface is shown below:
  *
  * @code
@@ -106,7 +111,9 @@ class RandomizedSVD
 
 /**
    * Center the data to apply Principal Component Analysis on given sparse
-   * matrix dataset using randomized SVD.
+   * matrix dataset using randomized SVD.  The data is not centered (or
+   * densified) explicitly; the dense row mean is subtracted from each product
+   * instead.
    *
    * @param data Sparse data matrix.
    * @param u First unitary matrix.
@@ -59,8 +59,10 @@ inline void RandomizedSVD::Apply(const arma::SpMat<eT>& data,
                                  MatType& v,
                                  const size_t rank)
 {
-  // Center the data into a temporary matrix for sparse matrix.
-  arma::SpMat<eT> rowMean = sum(data, 1) / data.n_cols;
+  // The mean of the sparse data is dense, so it is held in a dense vector; the
+  // data itself is never centered or densified.
+  arma::Mat<eT> rowMean(sum(data, 1));
+  rowMean /= data.n_cols;
 
   Apply(data, u, s, v, rank, rowMean);
 }
@@ -97,16 +99,23 @@ inline void RandomizedSVD::Apply(const InMatType& data,
 
   MatType R, Q, Qdata;
 
+  // The data is only used in products with dense matrices, so it can be
+  // sparse.  Products with the transposed data are computed as trans(X.t() *
+  // data): for sparse data, this avoids building a transposed copy of the data,
+  // and the transpose of the (small) dense result is cheap.  The mean is
+  // subtracted from the products instead of the data, and sum(X, 0) is used
+  // instead of ones(1, n) * X.
+
   // Apply the centered data matrix to a random matrix, obtaining Q.
   if (data.n_cols >= data.n_rows)
   {
     R.randn(data.n_rows, iteratedPower);
-    Q = (data.t() * R) - repmat(trans(R.t() * rowMean), data.n_cols, 1);
+    Q = trans(R.t() * data) - repmat(trans(R.t() * rowMean), data.n_cols, 1);
   }
   else
   {
     R.randn(data.n_cols, iteratedPower);
-    Q = (data * R) - (rowMean * (ones<MatType>(1, data.n_cols) * R));
+    Q = (data * R) - (rowMean * sum(R, 0));
   }
 
   // Form a matrix Q whose columns constitute a
@@ -125,15 +134,15 @@ inline void RandomizedSVD::Apply(const InMatType& data,
   {
     if (data.n_cols >= data.n_rows)
     {
-      Q = (data * Q) - rowMean * (ones<MatType>(1, data.n_cols) * Q);
+      Q = (data * Q) - rowMean * sum(Q, 0);
       arma::lu(Q, v, Q);
-      Q = (data.t() * Q) - repmat(rowMean.t() * Q, data.n_cols, 1);
+      Q = trans(Q.t() * data) - repmat(rowMean.t() * Q, data.n_cols, 1);
     }
     else
     {
-      Q = (data.t() * Q) - repmat(rowMean.t() * Q, data.n_cols, 1);
+      Q = trans(Q.t() * data) - repmat(rowMean.t() * Q, data.n_cols, 1);
       arma::lu(Q, v, Q);
-      Q = (data * Q) - (rowMean * (ones<MatType>(1, data.n_cols) * Q));
+      Q = (data * Q) - (rowMean * sum(Q, 0));
     }
 
     // Computing the LU decomposition is more efficient than computing the QR
@@ -155,7 +164,7 @@ inline void RandomizedSVD::Apply(const InMatType& data,
   // applied to Q.
   if (data.n_cols >= data.n_rows)
   {
-    Qdata = (data * Q) - rowMean * (ones<MatType>(1, data.n_cols) * Q);
+    Qdata = (data * Q) - rowMean * sum(Q, 0);
     arma::svd_econ(u, s, v, Qdata);
     v = Q * v;
   }
@@ -12,5 +12,6 @@
 #define MLPACK_RANGE_SEARCH_HPP
 
 #include "range_search/range_search.hpp"
+#include "range_search/grid_range_search.hpp"
 
 #endif
@@ -0,0 +1,258 @@
+/**
+ * @file methods/range_search/grid_range_search.hpp
+ *
+ * Defines the GridRangeSearch class, which performs Euclidean range searches on
+ * low-dimensional data with a uniform grid instead of a tree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_GRID_RANGE_SEARCH_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_GRID_RANGE_SEARCH_HPP
+
+#include <mlpack/core.hpp>
+#include "range_search_results.hpp"
+
+#include <unordered_map>
+
+namespace mlpack {
+
+/**
+ * The GridRangeSearch class performs range searches with the Euclidean distance
+ * by hashing the reference points into a uniform grid.  The cells of the grid
+ * have side h / sqrt(d), where h is the upper end of the search range and d is
+ * the dimensionality, so a whole cell fits inside a ball of radius h; to find
+ * the points in range of a query point, only the nonempty cells within a fixed
+ * pattern of offsets around the cell of the query point need to be searched.
+ *
+ * The grid is built for the upper end of the range the first time Search() or
+ * Count() is called, and only rebuilt when a different range is used.  Only
+ * nonempty cells are stored, so the memory used does not depend on the extent
+ * of the data.  Count() also uses the cells that lie entirely within the range
+ * of the query cell without computing any distances; in particular, every
+ * other point in the cell of a query point is in range.
+ *
+ * The number of cells to search grows exponentially with the dimensionality,
+ * so this is meant for low-dimensional data (for instance, geospatial
+ * coordinates), where it is usually faster than tree-based range search.  It
+ * implements the parts of the RangeSearch API that DBSCAN uses, so it can be
+ * used as the RangeSearchType of DBSCAN.  If OpenMP is enabled, the query
+ * points are split between threads.
+ *
+ * @tparam MatType Type of data to use (a dense matrix).
+ */
+template<typename MatType = arma::mat>
+class GridRangeSearch
+{
+ public:
+  //! The type of Matrix.
+  typedef MatType Mat;
+  //! The type of element held in MatType.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Initialize the GridRangeSearch object with the given reference dataset,
+   * which is moved (or copied) into the object.  The grid is not built until
+   * the first search.
+   *
+   * @param referenceSet Reference dataset.
+   */
+  GridRangeSearch(MatType referenceSet = MatType());
+
+  /**
+   * Set the reference set to a new reference set.  The grid is rebuilt at the
+   * next search.
+   *
+   * @param referenceSet New reference set to use.
+   */
+  void Train(MatType referenceSet);
+
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, returning the results in the neighbors and distances objects.
+   * See RangeSearch::Search() for the format of the results.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search; the upper end must be
+   *     positive and finite.
+   * @param neighbors Object which will hold the list of neighbors for each
+   *      point which fell into the given range, for each query point.
+   * @param distances Object which will hold the list of distances for each
+   *      point which fell into the given range, for each query point.
+   */
+  void Search(const MatType& querySet,
+              const RangeType<ElemType>& range,
+              std::vector<std::vector<size_t>>& neighbors,
+              std::vector<std::vector<ElemType>>& distances);
+
+  /**
+   * Search for all points in the given range for each point in the reference
+   * set.  A point is not returned as its own neighbor.
+   *
+   * @param range Range of distances in which to search.
+   * @param neighbors Object which will hold the list of neighbors for each
+   *      point which fell into the given range, for each query point.
+   * @param distances Object which will hold the list of distances for each
+   *      point which fell into the given range, for each query point.
+   */
+  void Search(const RangeType<ElemType>& range,
+              std::vector<std::vector<size_t>>& neighbors,
+              std::vector<std::vector<ElemType>>& distances);
+
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, returning the results in compressed sparse row (CSR) format.
+   * See the CSR overload of RangeSearch::Search() for the format.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param offsets Offsets of the results of each query point.
+   * @param neighbors Concatenated indices of the reference points in range of
+   *      each query point.
+   * @param distances Concatenated distances to the reference points in range of
+   *      each query point.
+   */
+  void Search(const MatType& querySet,
+              const RangeType<ElemType>& range,
+              arma::Col<size_t>& offsets,
+              arma::Col<size_t>& neighbors,
+              arma::Col<ElemType>& distances);
+
+  /**
+   * Search for all points in the given range for each point in the reference
+   * set, returning the results in compressed sparse row (CSR) format.  A point
+   * is not returned as its own neighbor.
+   *
+   * @param range Range of distances in which to search.
+   * @param offsets Offsets of the results of each query point.
+   * @param neighbors Concatenated indices of the reference points in range of
+   *      each query point.
+   * @param distances Concatenated distances to the reference points in range of
+   *      each query point.
+   */
+  void Search(const RangeType<ElemType>& range,
+              arma::Col<size_t>& offsets,
+              arma::Col<size_t>& neighbors,
+              arma::Col<ElemType>& distances);
+
+  /**
+   * Count the number of reference points in the given range of each point in
+   * the query set.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param counts Will hold the number of reference points in range of each
+   *      query point.
+   */
+  void Count(const MatType& querySet,
+             const RangeType<ElemType>& range,
+             arma::Col<size_t>& counts);
+
+  /**
+   * Count the number of other points in the given range of each point in the
+   * reference set.
+   *
+   * @param range Range of distances in which to search.
+   * @param counts Will hold the number of points in range of each point in the
+   *      reference set.
+   */
+  void Count(const RangeType<ElemType>& range, arma::Col<size_t>& counts);
+
+  //! Get the number of distance calculations during the last search.
+  size_t BaseCases() const { return baseCases; }
+
+  //! Get the side of the cells of the grid (0 if it has not been built yet).
+  double CellSize() const { return cellSize; }
+  //! Get the number of nonempty cells of the grid.
+  size_t NumCells() const { return cellIndices.size(); }
+
+  //! Return the reference set.
+  const MatType& ReferenceSet() const { return referenceSet; }
+
+ private:
+  /**
+   * Build the grid for the given search radius, unless it was already built for
+   * that radius.
+   */
+  void BuildGrid(const ElemType radius);
+
+  /**
+   * Compute the cell coordinates of the given point.  Returns false if the
+   * point is so far from the reference points that none can be in range.
+   */
+  template<typename VecType>
+  bool PointCell(const VecType& point, arma::Col<arma::sword>& cell) const;
+
+  /**
+   * Search for the reference points in range of each query point, passing them
+   * to the given results policy (see range_search_results.hpp).
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param results Instantiated results policy; each thread uses a copy.
+   * @param sameSet If true, the query set is the reference set, and query
+   *     points are not returned as their own neighbor.
+   * @param countCells If true, the points of cells entirely in range are added
+   *     without computing their distance (which is passed as 0).
+   */
+  template<typename ResultsType>
+  void SearchWithResults(const MatType& querySet,
+                         const RangeType<ElemType>& range,
+                         const ResultsType& results,
+                         const bool sameSet,
+                         const bool countCells);
+
+  /**
+   * Search for the reference points in range of each query point, returning
+   * the results in CSR format; the query points are searched twice, first to
+   * count the results and then to store them.
+   */
+  void SearchCSR(const MatType& querySet,
+                 const RangeType<ElemType>& range,
+                 const bool sameSet,
+                 arma::Col<size_t>& offsets,
+                 arma::Col<size_t>& neighbors,
+                 arma::Col<ElemType>& distances);
+
+  //! The reference set.
+  MatType referenceSet;
+
+  //! The search radius the grid was built for (0 if it has not been built).
+  ElemType gridRadius;
+  //! The side of the cells.
+  double cellSize;
+  //! The lower corner of the grid.
+  arma::vec minBounds;
+  //! The number of cells of the grid along each dimension.
+  arma::Col<size_t> cellExtents;
+  //! The step in the cell key for each dimension.
+  arma::Col<size_t> cellStrides;
+
+  //! The position of each nonempty cell in cellOffsets, by cell key.
+  std::unordered_map<size_t, size_t> cellIndices;
+  //! The points of nonempty cell i are cellPoints[cellOffsets[i]] to
+  //! cellPoints[cellOffsets[i + 1] - 1].
+  arma::Col<size_t> cellOffsets;
+  //! The reference points, sorted by cell.
+  arma::Col<size_t> cellPoints;
+
+  //! The offsets of the cells to search around the cell of a query point (one
+  //! column for each offset).
+  arma::imat neighborOffsets;
+  //! Whether each offset cell lies entirely in range of the query cell.
+  std::vector<char> neighborContained;
+  //! The largest offset along any dimension.
+  arma::sword maxOffset;
+
+  //! The number of distance calculations during the last search.
+  size_t baseCases;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "grid_range_search_impl.hpp"
+
+#endif
@@ -0,0 +1,397 @@
+/**
+ * @file methods/range_search/grid_range_search_impl.hpp
+ *
+ * Implementation of the GridRangeSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_GRID_RANGE_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_GRID_RANGE_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "grid_range_search.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+GridRangeSearch<MatType>::GridRangeSearch(MatType referenceSet) :
+    referenceSet(std::move(referenceSet)),
+    gridRadius(0),
+    cellSize(0.0),
+    maxOffset(0),
+    baseCases(0)
+{
+  // Nothing to do.
+}
+
+template<typename MatType>
+void GridRangeSearch<MatType>::Train(MatType newReferenceSet)
+{
+  referenceSet = std::move(newReferenceSet);
+
+  // Force the grid to be rebuilt.
+  gridRadius = 0;
+  cellSize = 0.0;
+  cellIndices.clear();
+}
+
+template<typename MatType>
+void GridRangeSearch<MatType>::Search(
+    const MatType& querySet,
+    const RangeType<ElemType>& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<ElemType>>& distances)
+{
+  util::CheckSameDimensionality(querySet, referenceSet,
+      "GridRangeSearch::Search()", "query set");
+
+  neighbors.clear();
+  neighbors.resize(querySet.n_cols);
+  distances.clear();
+  distances.resize(querySet.n_cols);
+
+  SearchWithResults(querySet, range,
+      RangeSearchNestedResults<ElemType>(neighbors, distances), false, false);
+}
+
+template<typename MatType>
+void GridRangeSearch<MatType>::Search(
+    const RangeType<ElemType>& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<ElemType>>& distances)
+{
+  neighbors.clear();
+  neighbors.resize(referenceSet.n_cols);
+  distances.clear();
+  distances.resize(referenceSet.n_cols);
+
+  SearchWithResults(referenceSet, range,
+      RangeSearchNestedResults<ElemType>(neighbors, distances), true, false);
+}
+
+template<typename MatType>
+void GridRangeSearch<MatType>::Search(
+    const MatType& querySet,
+    const RangeType<ElemType>& range,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::Col<ElemType>& distances)
+{
+  util::CheckSameDimensionality(querySet, referenceSet,
+      "GridRangeSearch::Search()", "query set");
+
+  SearchCSR(querySet, range, false, offsets, neighbors, distances);
+}
+
+template<typename MatType>
+void GridRangeSearch<MatType>::Search(
+    const RangeType<ElemType>& range,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::Col<ElemType>& distances)
+{
+  SearchCSR(referenceSet, range, true, offsets, neighbors, distances);
+}
+
+template<typename MatType>
+void GridRangeSearch<MatType>::Count(
+    const MatType& querySet,
+    const RangeType<ElemType>& range,
+    arma::Col<size_t>& counts)
+{
+  util::CheckSameDimensionality(querySet, referenceSet,
+      "GridRangeSearch::Count()", "query set");
+
+  counts.zeros(querySet.n_cols);
+  SearchWithResults(querySet, range, RangeSearchCountResults<ElemType>(counts),
+      false, true);
+}
+
+template<typename MatType>
+void GridRangeSearch<MatType>::Count(
+    const RangeType<ElemType>& range,
+    arma::Col<size_t>& counts)
+{
+  counts.zeros(referenceSet.n_cols);
+  SearchWithResults(referenceSet, range,
+      RangeSearchCountResults<ElemType>(counts), true, true);
+}
+
+template<typename MatType>
+void GridRangeSearch<MatType>::BuildGrid(const ElemType radius)
+{
+  if (radius == gridRadius)
+    return;
+
+  const size_t dims = referenceSet.n_rows;
+
+  // The cells are made very slightly smaller than radius / sqrt(d), so that
+  // rounding can never put two points of a cell out of range of each other.
+  const double newCellSize = double(radius) /
+      (std::sqrt((double) dims) * (1.0 + 1e-6));
+
+  // Find the pattern of cells around a cell that can hold points in range of
+  // the points of that cell.
+  const arma::sword newMaxOffset =
+      (arma::sword) std::ceil(double(radius) / newCellSize);
+  const double numOffsets = std::pow(2.0 * newMaxOffset + 1.0, (double) dims);
+  if (numOffsets > 1e6)
+  {
+    std::ostringstream oss;
+    oss << "GridRangeSearch: too many cells to search around each query point "
+        << "in " << dims << " dimensions; use tree-based range search instead";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const double radiusSquared = double(radius) * double(radius);
+  std::vector<arma::sword> offsets;
+  neighborContained.clear();
+  arma::Col<arma::sword> offset(dims);
+  offset.fill(-newMaxOffset);
+  for (size_t o = 0; o < (size_t) numOffsets; ++o)
+  {
+    double minDistance = 0.0;
+    double maxDistance = 0.0;
+    for (size_t d = 0; d < dims; ++d)
+    {
+      const double cells = (double) std::abs(offset[d]);
+      minDistance += std::pow(std::max(cells - 1.0, 0.0) * newCellSize, 2.0);
+      maxDistance += std::pow((cells + 1.0) * newCellSize, 2.0);
+    }
+
+    if (minDistance <= radiusSquared)
+    {
+      offsets.insert(offsets.end(), offset.begin(), offset.end());
+      neighborContained.push_back(maxDistance <= radiusSquared);
+    }
+
+    // Go to the next offset.
+    for (size_t d = 0; d < dims; ++d)
+    {
+      if (++offset[d] <= newMaxOffset)
+        break;
+      offset[d] = -newMaxOffset;
+    }
+  }
+  neighborOffsets = arma::imat(offsets.data(), dims, neighborContained.size());
+
+  // Now size the grid to the bounding box of the data.  Only nonempty cells are
+  // stored, but each cell needs a unique key.
+  minBounds = arma::conv_to<arma::vec>::from(arma::min(referenceSet, 1));
+  const arma::vec maxBounds =
+      arma::conv_to<arma::vec>::from(arma::max(referenceSet, 1));
+  cellExtents.set_size(dims);
+  cellStrides.set_size(dims);
+  double numCells = 1.0;
+  for (size_t d = 0; d < dims; ++d)
+  {
+    const double extent =
+        std::floor((maxBounds[d] - minBounds[d]) / newCellSize) + 1.0;
+    cellStrides[d] = (size_t) numCells;
+    numCells *= extent;
+    if (numCells > 4e18)
+    {
+      throw std::invalid_argument("GridRangeSearch: the search radius is too "
+          "small for the extent of the data");
+    }
+
+    cellExtents[d] = (size_t) extent;
+  }
+
+  cellSize = newCellSize;
+  maxOffset = newMaxOffset;
+  gridRadius = radius;
+
+  // Sort the points by the key of their cell.
+  arma::Col<size_t> keys(referenceSet.n_cols);
+  #pragma omp parallel
+  {
+    arma::Col<arma::sword> cell(dims);
+
+    #pragma omp for schedule(static)
+    for (size_t i = 0; i < (size_t) referenceSet.n_cols; ++i)
+    {
+      PointCell(referenceSet.col(i), cell);
+      keys[i] = 0;
+      for (size_t d = 0; d < dims; ++d)
+        keys[i] += cell[d] * cellStrides[d];
+    }
+  }
+
+  const arma::uvec order = arma::stable_sort_index(keys);
+  cellPoints.set_size(referenceSet.n_cols);
+  cellIndices.clear();
+  std::vector<size_t> offsetsOfCells;
+  for (size_t i = 0; i < order.n_elem; ++i)
+  {
+    cellPoints[i] = order[i];
+    if (i == 0 || keys[order[i]] != keys[order[i - 1]])
+    {
+      cellIndices[keys[order[i]]] = offsetsOfCells.size();
+      offsetsOfCells.push_back(i);
+    }
+  }
+  offsetsOfCells.push_back(order.n_elem);
+  cellOffsets = arma::Col<size_t>(offsetsOfCells);
+
+  Log::Info << "Built grid with " << cellIndices.size() << " nonempty cells of "
+      << "side " << cellSize << "." << std::endl;
+}
+
+template<typename MatType>
+template<typename VecType>
+bool GridRangeSearch<MatType>::PointCell(const VecType& point,
+                                         arma::Col<arma::sword>& cell) const
+{
+  for (size_t d = 0; d < point.n_elem; ++d)
+  {
+    const double c = std::floor((double(point[d]) - minBounds[d]) / cellSize);
+    if (c < -maxOffset || c >= double(cellExtents[d]) + maxOffset)
+      return false;
+
+    cell[d] = (arma::sword) c;
+  }
+
+  return true;
+}
+
+template<typename MatType>
+template<typename ResultsType>
+void GridRangeSearch<MatType>::SearchWithResults(
+    const MatType& querySet,
+    const RangeType<ElemType>& range,
+    const ResultsType& results,
+    const bool sameSet,
+    const bool countCells)
+{
+  baseCases = 0;
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet.n_cols == 0)
+    return;
+
+  if (!(range.Hi() > 0) || !std::isfinite(double(range.Hi())))
+  {
+    throw std::invalid_argument("GridRangeSearch: the upper end of the range "
+        "must be positive and finite");
+  }
+
+  BuildGrid(range.Hi());
+
+  // Cells entirely in range can only be used if the lower end of the range
+  // does not exclude any of their points.
+  const bool useContained = countCells && range.Lo() <= 0;
+  const size_t dims = referenceSet.n_rows;
+  size_t totalBaseCases = 0;
+
+  #pragma omp parallel reduction(+:totalBaseCases)
+  {
+    ResultsType threadResults(results);
+    arma::Col<arma::sword> cell(dims);
+
+    #pragma omp for schedule(dynamic, 64)
+    for (size_t q = 0; q < (size_t) querySet.n_cols; ++q)
+    {
+      if (!PointCell(querySet.col(q), cell))
+        continue;
+
+      for (size_t o = 0; o < neighborOffsets.n_cols; ++o)
+      {
+        // Find the key of the offset cell, if it is inside the grid.
+        bool inGrid = true;
+        size_t key = 0;
+        for (size_t d = 0; d < dims; ++d)
+        {
+          const arma::sword c = cell[d] + neighborOffsets(d, o);
+          if (c < 0 || c >= (arma::sword) cellExtents[d])
+          {
+            inGrid = false;
+            break;
+          }
+          key += c * cellStrides[d];
+        }
+        if (!inGrid)
+          continue;
+
+        const typename std::unordered_map<size_t, size_t>::const_iterator it =
+            cellIndices.find(key);
+        if (it == cellIndices.end())
+          continue;
+
+        const size_t begin = cellOffsets[it->second];
+        const size_t end = cellOffsets[it->second + 1];
+        if (useContained && neighborContained[o])
+        {
+          for (size_t i = begin; i < end; ++i)
+          {
+            if (!sameSet || cellPoints[i] != q)
+              threadResults.Add(q, cellPoints[i], 0);
+          }
+          continue;
+        }
+
+        totalBaseCases += end - begin;
+        for (size_t i = begin; i < end; ++i)
+        {
+          const size_t r = cellPoints[i];
+          if (sameSet && r == q)
+            continue;
+
+          const ElemType distance = EuclideanDistance::Evaluate(
+              querySet.col(q), referenceSet.col(r));
+          if (range.Contains(distance))
+            threadResults.Add(q, r, distance);
+        }
+      }
+    }
+  }
+
+  baseCases = totalBaseCases;
+}
+
+template<typename MatType>
+void GridRangeSearch<MatType>::SearchCSR(
+    const MatType& querySet,
+    const RangeType<ElemType>& range,
+    const bool sameSet,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::Col<ElemType>& distances)
+{
+  const size_t numQueries = querySet.n_cols;
+
+  // First count the results of each query point, so that all of the space for
+  // the results can be allocated at once.  Distances are computed for every
+  // point, so that the count matches the second pass exactly.
+  arma::Col<size_t> cursor(numQueries, arma::fill::zeros);
+  SearchWithResults(querySet, range, RangeSearchCountResults<ElemType>(cursor),
+      sameSet, false);
+  const size_t countBaseCases = baseCases;
+
+  // Turn the counts into offsets; the cursor of each query point starts at its
+  // offset.
+  offsets.set_size(numQueries + 1);
+  size_t total = 0;
+  for (size_t i = 0; i < numQueries; ++i)
+  {
+    offsets[i] = total;
+    total += cursor[i];
+    cursor[i] = offsets[i];
+  }
+  offsets[numQueries] = total;
+
+  neighbors.set_size(total);
+  distances.set_size(total);
+
+  SearchWithResults(querySet, range,
+      RangeSearchCSRResults<ElemType>(cursor, neighbors, distances), sameSet,
+      false);
+  baseCases += countBaseCases;
+}
+
+} // namespace mlpack
+
+#endif
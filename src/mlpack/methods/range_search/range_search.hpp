@@ -23,7 +23,8 @@ namespace mlpack {
 //! Forward declaration.
 template<template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
+                  typename TreeMatType> class TreeType,
+         typename DistanceType>
 class LeafSizeRSWrapper;
 
 /**
@@ -271,6 +272,120 @@ class RangeSearch
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<ElemType>>& distances);
 
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, returning the results in compressed sparse row (CSR) format.
+   * This avoids allocating a separate vector for each query point.  The results
+   * of query point i are held in elements offsets[i] to offsets[i + 1] - 1 of
+   * the neighbors and distances arrays.
+   *
+   * That is:
+   *
+   * - offsets.n_elem equals the number of query points plus one; offsets[0] is
+   *   0, and the last element is the total number of results.
+   *
+   * - neighbors and distances both hold offsets[offsets.n_elem - 1] elements.
+   *
+   * - The results of each query point are not sorted in any particular order.
+   *
+   * The search is run twice: once to count the results of each query point (see
+   * Count()), and once to write them into the preallocated arrays.  BaseCases()
+   * and Scores() report the total for both passes.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param offsets Offsets of the results of each query point.
+   * @param neighbors Concatenated indices of the reference points in range of
+   *      each query point.
+   * @param distances Concatenated distances to the reference points in range of
+   *      each query point.
+   */
+  void Search(const MatType& querySet,
+              const RangeType<ElemType>& range,
+              arma::Col<size_t>& offsets,
+              arma::Col<size_t>& neighbors,
+              arma::Col<ElemType>& distances);
+
+  /**
+   * Given a pre-built query tree, search for all reference points in the given
+   * range for each point in the query set, returning the results in compressed
+   * sparse row (CSR) format.  See the CSR overload of Search() that takes a
+   * query set for details on the format.
+   *
+   * If either naive or singleMode are set to true, this will throw an
+   * invalid_argument exception; passing in a query tree implies dual-tree
+   * search.
+   *
+   * @param queryTree Tree built on query points.
+   * @param range Range of distances in which to search.
+   * @param offsets Offsets of the results of each query point.
+   * @param neighbors Concatenated indices of the reference points in range of
+   *      each query point.
+   * @param distances Concatenated distances to the reference points in range of
+   *      each query point.
+   */
+  void Search(Tree* queryTree,
+              const RangeType<ElemType>& range,
+              arma::Col<size_t>& offsets,
+              arma::Col<size_t>& neighbors,
+              arma::Col<ElemType>& distances);
+
+  /**
+   * Search for all points in the given range for each point in the reference
+   * set, returning the results in compressed sparse row (CSR) format.  See the
+   * CSR overload of Search() that takes a query set for details on the format.
+   *
+   * @param range Range of distances in which to search.
+   * @param offsets Offsets of the results of each query point.
+   * @param neighbors Concatenated indices of the reference points in range of
+   *      each query point.
+   * @param distances Concatenated distances to the reference points in range of
+   *      each query point.
+   */
+  void Search(const RangeType<ElemType>& range,
+              arma::Col<size_t>& offsets,
+              arma::Col<size_t>& neighbors,
+              arma::Col<ElemType>& distances);
+
+  /**
+   * Count the number of reference points in the given range of each point in
+   * the query set, without storing the points themselves.  This is cheaper than
+   * Search(): when a whole reference node falls in the range, the distances to
+   * its points are never computed.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param counts Will hold the number of reference points in range of each
+   *      query point.
+   */
+  void Count(const MatType& querySet,
+             const RangeType<ElemType>& range,
+             arma::Col<size_t>& counts);
+
+  /**
+   * Given a pre-built query tree, count the number of reference points in the
+   * given range of each point in the query set.  If either naive or singleMode
+   * are set to true, this will throw an invalid_argument exception.
+   *
+   * @param queryTree Tree built on query points.
+   * @param range Range of distances in which to search.
+   * @param counts Will hold the number of reference points in range of each
+   *      query point.
+   */
+  void Count(Tree* queryTree,
+             const RangeType<ElemType>& range,
+             arma::Col<size_t>& counts);
+
+  /**
+   * Count the number of other points in the given range of each point in the
+   * reference set.
+   *
+   * @param range Range of distances in which to search.
+   * @param counts Will hold the number of points in range of each point in the
+   *      reference set.
+   */
+  void Count(const RangeType<ElemType>& range, arma::Col<size_t>& counts);
+
   //! Get whether single-tree search is being used.
   bool SingleMode() const { return singleMode; }
   //! Modify whether single-tree search is being used.
@@ -321,8 +436,33 @@ class RangeSearch
   //! The total number of scores during the last search.
   size_t scores;
 
+  /**
+   * Run the search with the given result storage policy, in naive, single-tree
+   * or dual-tree mode.  In dual-tree mode, queryTree must be the tree built on
+   * querySet.  BaseCases() and Scores() are incremented.
+   */
+  template<typename ResultsType>
+  void SearchWithResults(const MatType& querySet,
+                         Tree* queryTree,
+                         const RangeType<ElemType>& range,
+                         const ResultsType& results,
+                         const bool sameSet);
+
+  /**
+   * Count the results of a search, then write them in CSR format.  The query
+   * map (if not NULL) gives the original index of each point in querySet.
+   */
+  void SearchCSR(const MatType& querySet,
+                 Tree* queryTree,
+                 const RangeType<ElemType>& range,
+                 const std::vector<size_t>* queryMap,
+                 const bool sameSet,
+                 arma::Col<size_t>& offsets,
+                 arma::Col<size_t>& neighbors,
+                 arma::Col<ElemType>& distances);
+
   //! For access to mappings when building models.
-  friend class LeafSizeRSWrapper<TreeType>;
+  friend class LeafSizeRSWrapper<TreeType, DistanceType>;
 };
 
 } // namespace mlpack
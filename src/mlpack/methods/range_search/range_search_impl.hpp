@@ -338,31 +338,12 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
   baseCases = 0;
   scores = 0;
 
-  if (naive)
-  {
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        distance);
-
-    // The naive brute-force solution.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      for (size_t j = 0; j < referenceSet->n_cols; ++j)
-        rules.BaseCase(i, j);
-
-    baseCases += (querySet.n_cols * referenceSet->n_cols);
-  }
-  else if (singleMode)
+  if (naive || singleMode)
   {
-    // Create the traverser.
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        distance);
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
-
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
-
-    baseCases += rules.BaseCases();
-    scores += rules.Scores();
+    // The query points are searched in parallel; each one only writes to its
+    // own (preallocated) vectors of results.
+    SearchWithResults(querySet, NULL, range,
+        RangeSearchNestedResults<ElemType>(*neighborPtr, *distancePtr), false);
   }
   else // Dual-tree recursion.
   {
@@ -548,35 +529,23 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
   distancePtr->clear();
   distancePtr->resize(referenceSet->n_cols);
 
-  // Create the helper object for the traversal.
-  typedef RangeSearchRules<DistanceType, Tree> RuleType;
-  RuleType rules(*referenceSet, *referenceSet, range, *neighborPtr,
-      *distancePtr, distance, true /* don't return the query in the results */);
-
-  if (naive)
+  if (naive || singleMode)
   {
-    // The naive brute-force solution.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      for (size_t j = 0; j < referenceSet->n_cols; ++j)
-        rules.BaseCase(i, j);
-
-    baseCases = (referenceSet->n_cols * referenceSet->n_cols);
+    // The query points are searched in parallel; each one only writes to its
+    // own (preallocated) vectors of results.
+    baseCases = 0;
     scores = 0;
-  }
-  else if (singleMode)
-  {
-    // Create the traverser.
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
-
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
-
-    baseCases = rules.BaseCases();
-    scores = rules.Scores();
+    SearchWithResults(*referenceSet, NULL, range,
+        RangeSearchNestedResults<ElemType>(*neighborPtr, *distancePtr),
+        true /* don't return the query in the results */);
   }
   else // Dual-tree recursion.
   {
+    // Create the helper object for the traversal.
+    typedef RangeSearchRules<DistanceType, Tree> RuleType;
+    RuleType rules(*referenceSet, *referenceSet, range, *neighborPtr,
+        *distancePtr, distance, true /* don't return the query in results */);
+
     // Create the traverser.
     typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
 
@@ -614,6 +583,361 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
   }
 }
 
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<DistanceType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const RangeType<ElemType>& range,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::Col<ElemType>& distances)
+{
+  util::CheckSameDimensionality(querySet, *referenceSet,
+      "RangeSearch::Search()", "query set");
+
+  // Reset counts.
+  baseCases = 0;
+  scores = 0;
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+  {
+    offsets.zeros(querySet.n_cols + 1);
+    neighbors.reset();
+    distances.reset();
+    return;
+  }
+
+  if (naive || singleMode)
+  {
+    SearchCSR(querySet, NULL, range, NULL, false, offsets, neighbors,
+        distances);
+  }
+  else
+  {
+    // Build the query tree.  If it rearranges the query points, the results
+    // are written directly at the original query indices.
+    std::vector<size_t> oldFromNewQueries;
+    Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
+
+    SearchCSR(queryTree->Dataset(), queryTree, range,
+        TreeTraits<Tree>::RearrangesDataset ? &oldFromNewQueries : NULL, false,
+        offsets, neighbors, distances);
+
+    // Clean up tree memory.
+    delete queryTree;
+  }
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<DistanceType, MatType, TreeType>::Search(
+    Tree* queryTree,
+    const RangeType<ElemType>& range,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::Col<ElemType>& distances)
+{
+  // Make sure we are in dual-tree mode.
+  if (singleMode || naive)
+    throw std::invalid_argument("cannot call RangeSearch::Search() with a "
+        "query tree when naive or singleMode are set to true");
+
+  // Reset counts.
+  baseCases = 0;
+  scores = 0;
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+  {
+    offsets.zeros(queryTree->Dataset().n_cols + 1);
+    neighbors.reset();
+    distances.reset();
+    return;
+  }
+
+  // The query indices are not mapped, since the user built the query tree.
+  SearchCSR(queryTree->Dataset(), queryTree, range, NULL, false, offsets,
+      neighbors, distances);
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<DistanceType, MatType, TreeType>::Search(
+    const RangeType<ElemType>& range,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::Col<ElemType>& distances)
+{
+  // Reset counts.
+  baseCases = 0;
+  scores = 0;
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+  {
+    offsets.zeros(1);
+    neighbors.reset();
+    distances.reset();
+    return;
+  }
+
+  // Here, we will use the query set as the reference set, so the query indices
+  // need the same mapping as the reference indices.
+  const std::vector<size_t>* queryMap =
+      (treeOwner && TreeTraits<Tree>::RearrangesDataset) ?
+      &oldFromNewReferences : NULL;
+
+  SearchCSR(*referenceSet, (naive || singleMode) ? NULL : referenceTree, range,
+      queryMap, true /* don't return the query in the results */, offsets,
+      neighbors, distances);
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<DistanceType, MatType, TreeType>::Count(
+    const MatType& querySet,
+    const RangeType<ElemType>& range,
+    arma::Col<size_t>& counts)
+{
+  util::CheckSameDimensionality(querySet, *referenceSet,
+      "RangeSearch::Count()", "query set");
+
+  // Reset counts.
+  baseCases = 0;
+  scores = 0;
+
+  counts.zeros(querySet.n_cols);
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+    return;
+
+  if (naive || singleMode)
+  {
+    SearchWithResults(querySet, NULL, range,
+        RangeSearchCountResults<ElemType>(counts), false);
+  }
+  else
+  {
+    // Build the query tree, and count with the original query indices.
+    std::vector<size_t> oldFromNewQueries;
+    Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
+
+    SearchWithResults(queryTree->Dataset(), queryTree, range,
+        RangeSearchCountResults<ElemType>(counts,
+        TreeTraits<Tree>::RearrangesDataset ? &oldFromNewQueries : NULL),
+        false);
+
+    // Clean up tree memory.
+    delete queryTree;
+  }
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<DistanceType, MatType, TreeType>::Count(
+    Tree* queryTree,
+    const RangeType<ElemType>& range,
+    arma::Col<size_t>& counts)
+{
+  // Make sure we are in dual-tree mode.
+  if (singleMode || naive)
+    throw std::invalid_argument("cannot call RangeSearch::Count() with a "
+        "query tree when naive or singleMode are set to true");
+
+  // Reset counts.
+  baseCases = 0;
+  scores = 0;
+
+  counts.zeros(queryTree->Dataset().n_cols);
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+    return;
+
+  SearchWithResults(queryTree->Dataset(), queryTree, range,
+      RangeSearchCountResults<ElemType>(counts), false);
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<DistanceType, MatType, TreeType>::Count(
+    const RangeType<ElemType>& range,
+    arma::Col<size_t>& counts)
+{
+  // Reset counts.
+  baseCases = 0;
+  scores = 0;
+
+  counts.zeros(referenceSet->n_cols);
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+    return;
+
+  const std::vector<size_t>* queryMap =
+      (treeOwner && TreeTraits<Tree>::RearrangesDataset) ?
+      &oldFromNewReferences : NULL;
+
+  SearchWithResults(*referenceSet, (naive || singleMode) ? NULL :
+      referenceTree, range, RangeSearchCountResults<ElemType>(counts, queryMap),
+      true /* don't return the query in the results */);
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename ResultsType>
+void RangeSearch<DistanceType, MatType, TreeType>::SearchWithResults(
+    const MatType& querySet,
+    Tree* queryTree,
+    const RangeType<ElemType>& range,
+    const ResultsType& results,
+    const bool sameSet)
+{
+  // Create the helper object for the traversal.
+  typedef RangeSearchRules<DistanceType, Tree, ResultsType> RuleType;
+  RuleType rules(*referenceSet, querySet, range, results, distance, sameSet);
+
+  if (naive)
+  {
+    // The naive brute-force solution.  Each query point is handled by a single
+    // thread, and the copies of the results policy write into the same
+    // results, so no locking is needed.  Searches of a few points (like those
+    // of DBSCAN, one point at a time) are not worth starting threads for.
+    #pragma omp parallel if (querySet.n_cols > 16)
+    {
+      RuleType threadRules(*referenceSet, querySet, range, results, distance,
+          sameSet);
+
+      #pragma omp for schedule(dynamic, 16)
+      for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
+        for (size_t j = 0; j < referenceSet->n_cols; ++j)
+          threadRules.BaseCase(i, j);
+    }
+
+    baseCases += (querySet.n_cols * referenceSet->n_cols);
+  }
+  else if (singleMode && !TreeTraits<Tree>::HasSelfChildren)
+  {
+    // Each thread traverses the tree for some of the query points, with its
+    // own rules (which hold the traversal state and the counters).
+    #pragma omp parallel if (querySet.n_cols > 16)
+    {
+      RuleType threadRules(*referenceSet, querySet, range, results, distance,
+          sameSet);
+      typename Tree::template SingleTreeTraverser<RuleType>
+          traverser(threadRules);
+
+      #pragma omp for schedule(dynamic, 16)
+      for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
+        traverser.Traverse(i, *referenceTree);
+
+      #pragma omp critical
+      {
+        baseCases += threadRules.BaseCases();
+        scores += threadRules.Scores();
+      }
+    }
+  }
+  else if (singleMode)
+  {
+    // Trees with self-children cache the last base case in the statistic of
+    // each reference node during the traversal, so the queries can't run in
+    // parallel.
+    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+    // Now have it traverse for each point.
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    baseCases += rules.BaseCases();
+    scores += rules.Scores();
+  }
+  else // Dual-tree recursion.
+  {
+    // Create the traverser.
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+    traverser.Traverse(*queryTree, *referenceTree);
+
+    baseCases += rules.BaseCases();
+    scores += rules.Scores();
+  }
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<DistanceType, MatType, TreeType>::SearchCSR(
+    const MatType& querySet,
+    Tree* queryTree,
+    const RangeType<ElemType>& range,
+    const std::vector<size_t>* queryMap,
+    const bool sameSet,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::Col<ElemType>& distances)
+{
+  const size_t numQueries = querySet.n_cols;
+
+  // Reference indices only need to be mapped if we built the reference tree
+  // ourselves.
+  const std::vector<size_t>* referenceMap =
+      (treeOwner && TreeTraits<Tree>::RearrangesDataset) ?
+      &oldFromNewReferences : NULL;
+
+  // First count the results of each query point, so that all of the space for
+  // the results can be allocated at once.
+  arma::Col<size_t> cursor(numQueries, arma::fill::zeros);
+  SearchWithResults(querySet, queryTree, range,
+      RangeSearchCountResults<ElemType>(cursor, queryMap), sameSet);
+
+  // Turn the counts into offsets; the cursor of each query point starts at its
+  // offset.
+  offsets.set_size(numQueries + 1);
+  size_t total = 0;
+  for (size_t i = 0; i < numQueries; ++i)
+  {
+    offsets[i] = total;
+    total += cursor[i];
+    cursor[i] = offsets[i];
+  }
+  offsets[numQueries] = total;
+
+  neighbors.set_size(total);
+  distances.set_size(total);
+
+  // Now write the results.  The traversal is deterministic, so every query
+  // point gets exactly the number of results that was counted.
+  SearchWithResults(querySet, queryTree, range,
+      RangeSearchCSRResults<ElemType>(cursor, neighbors, distances, queryMap,
+      referenceMap), sameSet);
+}
+
 template<typename DistanceType,
          typename MatType,
          template<typename TreeDistanceType,
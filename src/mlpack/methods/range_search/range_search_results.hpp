@@ -0,0 +1,202 @@
+/**
+ * @file methods/range_search/range_search_results.hpp
+ *
+ * Result storage policies for RangeSearchRules.  These control what happens
+ * when the rules find a reference point inside the range of a query point:
+ * the point can be appended to a vector of vectors, written into flat
+ * compressed sparse row (CSR) arrays, or just counted.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RESULTS_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RESULTS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Store range search results in a vector of vectors: neighbors[i] and
+ * distances[i] hold the indices and distances of the reference points in range
+ * of query point i.  This is the storage used by the RangeSearch::Search()
+ * overloads that take std::vector<std::vector<>> objects.
+ *
+ * All of the result storage policies only hold references to the output
+ * objects, so copies of a policy write into the same results.
+ *
+ * @tparam ElemType Type of distances to store.
+ */
+template<typename ElemType>
+class RangeSearchNestedResults
+{
+ public:
+  //! If false, the rules do not need to compute the distances of points that
+  //! are added without a base case.
+  static constexpr bool NeedsDistances = true;
+
+  /**
+   * Store results in the given vectors, which must already have one entry for
+   * each query point.
+   *
+   * @param neighbors Vector to store resulting neighbors in.
+   * @param distances Vector to store resulting distances in.
+   */
+  RangeSearchNestedResults(std::vector<std::vector<size_t>>& neighbors,
+                           std::vector<std::vector<ElemType>>& distances) :
+      neighbors(&neighbors),
+      distances(&distances)
+  { }
+
+  //! Prepare to add up to the given number of results to the given query point.
+  void Reserve(const size_t queryIndex, const size_t numResults)
+  {
+    std::vector<size_t>& n = (*neighbors)[queryIndex];
+    std::vector<ElemType>& d = (*distances)[queryIndex];
+    n.reserve(n.size() + numResults);
+    d.reserve(d.size() + numResults);
+  }
+
+  //! Add the given reference point to the results of the given query point.
+  void Add(const size_t queryIndex,
+           const size_t referenceIndex,
+           const ElemType distance)
+  {
+    (*neighbors)[queryIndex].push_back(referenceIndex);
+    (*distances)[queryIndex].push_back(distance);
+  }
+
+ private:
+  //! The vector the resultant neighbor indices should be stored in.
+  std::vector<std::vector<size_t>>* neighbors;
+  //! The vector the resultant neighbor distances should be stored in.
+  std::vector<std::vector<ElemType>>* distances;
+};
+
+/**
+ * Only count the number of reference points in range of each query point.
+ * Distances of points that fall in range because their whole node does are
+ * never computed.
+ *
+ * Query indices may optionally be mapped through a vector (for instance
+ * oldFromNewQueries, when the query tree rearranged the query set).
+ *
+ * @tparam ElemType Type of distances the rules work with.
+ */
+template<typename ElemType>
+class RangeSearchCountResults
+{
+ public:
+  //! If false, the rules do not need to compute the distances of points that
+  //! are added without a base case.
+  static constexpr bool NeedsDistances = false;
+
+  /**
+   * Count results into the given vector, which must already have one
+   * (initialized) element for each query point.
+   *
+   * @param counts Vector to store the number of results of each query point in.
+   * @param queryMap If not NULL, query index i is counted in
+   *     counts[(*queryMap)[i]].
+   */
+  RangeSearchCountResults(arma::Col<size_t>& counts,
+                          const std::vector<size_t>* queryMap = NULL) :
+      counts(&counts),
+      queryMap(queryMap)
+  { }
+
+  //! Prepare to add up to the given number of results to the given query point.
+  void Reserve(const size_t /* queryIndex */, const size_t /* numResults */) { }
+
+  //! Add the given reference point to the results of the given query point.
+  void Add(const size_t queryIndex,
+           const size_t /* referenceIndex */,
+           const ElemType /* distance */)
+  {
+    ++(*counts)[(queryMap == NULL) ? queryIndex : (*queryMap)[queryIndex]];
+  }
+
+ private:
+  //! The vector the counts are stored in.
+  arma::Col<size_t>* counts;
+  //! The mapping for query indices, if any.
+  const std::vector<size_t>* queryMap;
+};
+
+/**
+ * Store range search results in flat compressed sparse row (CSR) arrays.  The
+ * space for each query point must be known ahead of time (usually from a
+ * counting pass with RangeSearchCountResults); the results of query point i are
+ * written to neighbors and distances starting at position cursor[i], which is
+ * advanced after each result.
+ *
+ * Query and reference indices may optionally be mapped through vectors (for
+ * instance oldFromNewQueries and oldFromNewReferences, when trees rearranged
+ * the datasets).
+ *
+ * @tparam ElemType Type of distances to store.
+ */
+template<typename ElemType>
+class RangeSearchCSRResults
+{
+ public:
+  //! If false, the rules do not need to compute the distances of points that
+  //! are added without a base case.
+  static constexpr bool NeedsDistances = true;
+
+  /**
+   * Write results into the given arrays.
+   *
+   * @param cursor Position of the next result of each query point.
+   * @param neighbors Array to write resulting neighbors into.
+   * @param distances Array to write resulting distances into.
+   * @param queryMap If not NULL, the results of query index i are stored as
+   *     results of query point (*queryMap)[i].
+   * @param referenceMap If not NULL, reference index j is stored as
+   *     (*referenceMap)[j].
+   */
+  RangeSearchCSRResults(arma::Col<size_t>& cursor,
+                        arma::Col<size_t>& neighbors,
+                        arma::Col<ElemType>& distances,
+                        const std::vector<size_t>* queryMap = NULL,
+                        const std::vector<size_t>* referenceMap = NULL) :
+      cursor(&cursor),
+      neighbors(&neighbors),
+      distances(&distances),
+      queryMap(queryMap),
+      referenceMap(referenceMap)
+  { }
+
+  //! Prepare to add up to the given number of results to the given query point.
+  void Reserve(const size_t /* queryIndex */, const size_t /* numResults */) { }
+
+  //! Add the given reference point to the results of the given query point.
+  void Add(const size_t queryIndex,
+           const size_t referenceIndex,
+           const ElemType distance)
+  {
+    const size_t q = (queryMap == NULL) ? queryIndex : (*queryMap)[queryIndex];
+    const size_t pos = (*cursor)[q]++;
+    (*neighbors)[pos] = (referenceMap == NULL) ? referenceIndex :
+        (*referenceMap)[referenceIndex];
+    (*distances)[pos] = distance;
+  }
+
+ private:
+  //! The position of the next result of each query point.
+  arma::Col<size_t>* cursor;
+  //! The array the resultant neighbor indices are written into.
+  arma::Col<size_t>* neighbors;
+  //! The array the resultant neighbor distances are written into.
+  arma::Col<ElemType>* distances;
+  //! The mapping for query indices, if any.
+  const std::vector<size_t>* queryMap;
+  //! The mapping for reference indices, if any.
+  const std::vector<size_t>* referenceMap;
+};
+
+} // namespace mlpack
+
+#endif
@@ -12,7 +12,9 @@
 #ifndef MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RULES_HPP
 #define MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RULES_HPP
 
+#include <mlpack/core/tree/rule_traits.hpp>
 #include <mlpack/core/tree/traversal_info.hpp>
+#include "range_search_results.hpp"
 
 namespace mlpack {
 
@@ -22,8 +24,12 @@ namespace mlpack {
  *
  * @tparam DistanceType The distance metric to use for computation.
  * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ * @tparam ResultsType How to store the results; see range_search_results.hpp.
  */
-template<typename DistanceType, typename TreeType>
+template<typename DistanceType,
+         typename TreeType,
+         typename ResultsType =
+             RangeSearchNestedResults<typename TreeType::Mat::elem_type>>
 class RangeSearchRules
 {
  public:
@@ -53,6 +59,25 @@ class RangeSearchRules
                    DistanceType& distance,
                    const bool sameSet = false);
 
+  /**
+   * Construct the RangeSearchRules object with the given result storage
+   * policy.
+   *
+   * @param referenceSet Set of reference data.
+   * @param querySet Set of query data.
+   * @param range Range to search for.
+   * @param results Result storage policy to give results to.
+   * @param distance Instantiated distance metric.
+   * @param sameSet If true, the query and reference set are taken to be the
+   *      same, and a query point will not return itself in the results.
+   */
+  RangeSearchRules(const MatType& referenceSet,
+                   const MatType& querySet,
+                   const RangeType<ElemType>& range,
+                   const ResultsType& results,
+                   DistanceType& distance,
+                   const bool sameSet = false);
+
   /**
    * Compute the base case between the given query point and reference point.
    *
@@ -118,8 +143,12 @@ class RangeSearchRules
 
   //! Get the number of base cases.
   size_t BaseCases() const { return baseCases; }
+  //! Modify the number of base cases.
+  size_t& BaseCases() { return baseCases; }
   //! Get the number of scores (that is, calls to RangeDistance()).
   size_t Scores() const { return scores; }
+  //! Modify the number of scores.
+  size_t& Scores() { return scores; }
 
   //! Get the minimum number of base cases we need to perform to have acceptable
   //! results.
@@ -135,11 +164,8 @@ class RangeSearchRules
   //! The range of distances for which we are searching.
   const RangeType<ElemType>& range;
 
-  //! The vector the resultant neighbor indices should be stored in.
-  std::vector<std::vector<size_t> >& neighbors;
-
-  //! The vector the resultant neighbor distances should be stored in.
-  std::vector<std::vector<ElemType> >& distances;
+  //! The storage the results are given to.
+  ResultsType results;
 
   //! The instantiated distance metric.
   DistanceType& distance;
@@ -166,6 +192,20 @@ class RangeSearchRules
   size_t scores;
 };
 
+/**
+ * The RangeSearchRules only add results to the query points they are given,
+ * and their dual-tree Score() does not write any tree statistics.  All of the
+ * result storage policies hold pointers to the output objects, so copies of the
+ * rules write into the same results, and disjoint query subtrees can be
+ * traversed in parallel.
+ */
+template<typename DistanceType, typename TreeType, typename ResultsType>
+class RuleTraits<RangeSearchRules<DistanceType, TreeType, ResultsType>>
+{
+ public:
+  static const bool HasPerQueryResults = true;
+};
+
 } // namespace mlpack
 
 // Include implementation.
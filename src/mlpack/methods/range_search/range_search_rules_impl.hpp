@@ -17,8 +17,8 @@
 
 namespace mlpack {
 
-template<typename DistanceType, typename TreeType>
-RangeSearchRules<DistanceType, TreeType>::RangeSearchRules(
+template<typename DistanceType, typename TreeType, typename ResultsType>
+RangeSearchRules<DistanceType, TreeType, ResultsType>::RangeSearchRules(
     const MatType& referenceSet,
     const MatType& querySet,
     const RangeType<ElemType>& range,
@@ -29,8 +29,29 @@ RangeSearchRules<DistanceType, TreeType>::RangeSearchRules(
     referenceSet(referenceSet),
     querySet(querySet),
     range(range),
-    neighbors(neighbors),
-    distances(distances),
+    results(neighbors, distances),
+    distance(distance),
+    sameSet(sameSet),
+    lastQueryIndex(querySet.n_cols),
+    lastReferenceIndex(referenceSet.n_cols),
+    baseCases(0),
+    scores(0)
+{
+  // Nothing to do.
+}
+
+template<typename DistanceType, typename TreeType, typename ResultsType>
+RangeSearchRules<DistanceType, TreeType, ResultsType>::RangeSearchRules(
+    const MatType& referenceSet,
+    const MatType& querySet,
+    const RangeType<ElemType>& range,
+    const ResultsType& results,
+    DistanceType& distance,
+    const bool sameSet) :
+    referenceSet(referenceSet),
+    querySet(querySet),
+    range(range),
+    results(results),
     distance(distance),
     sameSet(sameSet),
     lastQueryIndex(querySet.n_cols),
@@ -43,10 +64,10 @@ RangeSearchRules<DistanceType, TreeType>::RangeSearchRules(
 
 //! The base case.  Evaluate the distance between the two points and add to the
 //! results if necessary.
-template<typename DistanceType, typename TreeType>
+template<typename DistanceType, typename TreeType, typename ResultsType>
 inline mlpack_force_inline
-typename RangeSearchRules<DistanceType, TreeType>::ElemType
-RangeSearchRules<DistanceType, TreeType>::BaseCase(
+typename RangeSearchRules<DistanceType, TreeType, ResultsType>::ElemType
+RangeSearchRules<DistanceType, TreeType, ResultsType>::BaseCase(
     const size_t queryIndex,
     const size_t referenceIndex)
 {
@@ -67,19 +88,17 @@ RangeSearchRules<DistanceType, TreeType>::BaseCase(
   lastReferenceIndex = referenceIndex;
 
   if (range.Contains(d))
-  {
-    neighbors[queryIndex].push_back(referenceIndex);
-    distances[queryIndex].push_back(d);
-  }
+    results.Add(queryIndex, referenceIndex, d);
 
   return d;
 }
 
 //! Single-tree scoring function.
-template<typename DistanceType, typename TreeType>
-typename RangeSearchRules<DistanceType, TreeType>::ElemType
-RangeSearchRules<DistanceType, TreeType>::Score(const size_t queryIndex,
-                                                TreeType& referenceNode)
+template<typename DistanceType, typename TreeType, typename ResultsType>
+typename RangeSearchRules<DistanceType, TreeType, ResultsType>::ElemType
+RangeSearchRules<DistanceType, TreeType, ResultsType>::Score(
+    const size_t queryIndex,
+    TreeType& referenceNode)
 {
   // We must get the minimum and maximum distances and store them in this
   // object.
@@ -137,9 +156,9 @@ RangeSearchRules<DistanceType, TreeType>::Score(const size_t queryIndex,
 }
 
 //! Single-tree rescoring function.
-template<typename DistanceType, typename TreeType>
-typename RangeSearchRules<DistanceType, TreeType>::ElemType
-RangeSearchRules<DistanceType, TreeType>::Rescore(
+template<typename DistanceType, typename TreeType, typename ResultsType>
+typename RangeSearchRules<DistanceType, TreeType, ResultsType>::ElemType
+RangeSearchRules<DistanceType, TreeType, ResultsType>::Rescore(
     const size_t /* queryIndex */,
     TreeType& /* referenceNode */,
     const ElemType oldScore) const
@@ -149,10 +168,11 @@ RangeSearchRules<DistanceType, TreeType>::Rescore(
 }
 
 //! Dual-tree scoring function.
-template<typename DistanceType, typename TreeType>
-typename RangeSearchRules<DistanceType, TreeType>::ElemType
-RangeSearchRules<DistanceType, TreeType>::Score(TreeType& queryNode,
-                                                TreeType& referenceNode)
+template<typename DistanceType, typename TreeType, typename ResultsType>
+typename RangeSearchRules<DistanceType, TreeType, ResultsType>::ElemType
+RangeSearchRules<DistanceType, TreeType, ResultsType>::Score(
+    TreeType& queryNode,
+    TreeType& referenceNode)
 {
   RangeType<ElemType> distances;
   if (TreeTraits<TreeType>::FirstPointIsCentroid)
@@ -212,9 +232,9 @@ RangeSearchRules<DistanceType, TreeType>::Score(TreeType& queryNode,
 }
 
 //! Dual-tree rescoring function.
-template<typename DistanceType, typename TreeType>
-typename RangeSearchRules<DistanceType, TreeType>::ElemType
-RangeSearchRules<DistanceType, TreeType>::Rescore(
+template<typename DistanceType, typename TreeType, typename ResultsType>
+typename RangeSearchRules<DistanceType, TreeType, ResultsType>::ElemType
+RangeSearchRules<DistanceType, TreeType, ResultsType>::Rescore(
     TreeType& /* queryNode */,
     TreeType& /* referenceNode */,
     const ElemType oldScore) const
@@ -225,8 +245,8 @@ RangeSearchRules<DistanceType, TreeType>::Rescore(
 
 //! Add all the points in the given node to the results for the given query
 //! point.
-template<typename DistanceType, typename TreeType>
-void RangeSearchRules<DistanceType, TreeType>::AddResult(
+template<typename DistanceType, typename TreeType, typename ResultsType>
+void RangeSearchRules<DistanceType, TreeType, ResultsType>::AddResult(
     const size_t queryIndex, TreeType& referenceNode)
 {
   // Some types of trees calculate the base case evaluation before Score() is
@@ -240,14 +260,10 @@ void RangeSearchRules<DistanceType, TreeType>::AddResult(
     baseCaseMod = 1;
   }
 
-  // Resize distances and neighbors vectors appropriately.  We have to use
-  // reserve() and not resize(), because we don't know if we will encounter the
-  // case where the datasets and points are the same (and we skip in that case).
-  const size_t oldSize = neighbors[queryIndex].size();
-  neighbors[queryIndex].reserve(oldSize + referenceNode.NumDescendants() -
-      baseCaseMod);
-  distances[queryIndex].reserve(oldSize + referenceNode.NumDescendants() -
-      baseCaseMod);
+  // Reserve space for the results appropriately.  We can't add all of them at
+  // once, because we don't know if we will encounter the case where the
+  // datasets and points are the same (and we skip in that case).
+  results.Reserve(queryIndex, referenceNode.NumDescendants() - baseCaseMod);
 
   for (size_t i = baseCaseMod; i < referenceNode.NumDescendants(); ++i)
   {
@@ -255,11 +271,15 @@ void RangeSearchRules<DistanceType, TreeType>::AddResult(
         (queryIndex == referenceNode.Descendant(i)))
       continue;
 
-    const ElemType d = distance.Evaluate(querySet.unsafe_col(queryIndex),
-        referenceNode.Dataset().unsafe_col(referenceNode.Descendant(i)));
+    // When only counting, there is no need to compute the distance.
+    ElemType d = 0;
+    if constexpr (ResultsType::NeedsDistances)
+    {
+      d = distance.Evaluate(querySet.unsafe_col(queryIndex),
+          referenceNode.Dataset().unsafe_col(referenceNode.Descendant(i)));
+    }
 
-    neighbors[queryIndex].push_back(referenceNode.Descendant(i));
-    distances[queryIndex].push_back(d);
+    results.Add(queryIndex, referenceNode.Descendant(i), d);
   }
 }
 
@@ -15,6 +15,9 @@
 #ifndef MLPACK_METHODS_RANGE_SEARCH_RS_MODEL_HPP
 #define MLPACK_METHODS_RANGE_SEARCH_RS_MODEL_HPP
 
+#include <sstream>
+
+#include <mlpack/core/distances/fixed_lmetric.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
 #include <mlpack/core/tree/rectangle_tree.hpp>
@@ -80,11 +83,14 @@ class RSWrapperBase
 };
 
 /**
- * RSWrapper is a wrapper class for most RangeSearch types.
+ * RSWrapper is a wrapper class for most RangeSearch types.  The distance is
+ * the Euclidean distance, unless another DistanceType (such as a FixedLMetric
+ * for low-dimensional data) is given.
  */
 template<template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
+                  typename TreeMatType> class TreeType,
+         typename DistanceType = EuclideanDistance>
 class RSWrapper : public RSWrapperBase
 {
  public:
@@ -145,7 +151,7 @@ class RSWrapper : public RSWrapperBase
   }
 
  protected:
-  typedef RangeSearch<EuclideanDistance, arma::mat, TreeType> RSType;
+  typedef RangeSearch<DistanceType, arma::mat, TreeType> RSType;
 
   //! The instantiated RangeSearch object that we are wrapping.
   RSType rs;
@@ -158,14 +164,15 @@ class RSWrapper : public RSWrapperBase
  */
 template<template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-class LeafSizeRSWrapper : public RSWrapper<TreeType>
+                  typename TreeMatType> class TreeType,
+         typename DistanceType = EuclideanDistance>
+class LeafSizeRSWrapper : public RSWrapper<TreeType, DistanceType>
 {
  public:
   //! Construct the LeafSizeRSWrapper by delegating to the RSWrapper
   //! constructor.
   LeafSizeRSWrapper(const bool singleMode, const bool naive) :
-      RSWrapper<TreeType>(singleMode, naive)
+      RSWrapper<TreeType, DistanceType>(singleMode, naive)
   {
     // Nothing else to do.
   }
@@ -201,7 +208,7 @@ class LeafSizeRSWrapper : public RSWrapper<TreeType>
   }
 
  protected:
-  using RSWrapper<TreeType>::rs;
+  using RSWrapper<TreeType, DistanceType>::rs;
 };
 
 /**
@@ -209,6 +216,11 @@ class LeafSizeRSWrapper : public RSWrapper<TreeType>
  * abstracting away the TreeType parameter and allowing it to be specified at
  * runtime.  This class is written for the sake of the `range_search` binding,
  * but is not necessarily restricted to that usage.
+ *
+ * When a kd-tree is built on 2-, 3- or 4-dimensional data, the Euclidean
+ * distance is computed with FixedLMetric, whose loop over the dimensions has
+ * a compile-time trip count; FixedDimension() returns the dimensionality that
+ * was chosen (or 0).
  */
 class RSModel
 {
@@ -307,6 +319,10 @@ class RSModel
   //! been built).
   bool& RandomBasis() { return randomBasis; }
 
+  //! Get the dimensionality that the kd-tree's FixedLMetric is specialized
+  //! for, or 0 if the Euclidean distance is used.
+  size_t FixedDimension() const { return fixedDimension; }
+
   /**
    * Allocate the memory for the range search model.
    */
@@ -369,6 +385,14 @@ class RSModel
   //! Random projection matrix.
   arma::mat q;
 
+  //! If nonzero, the kd-tree uses FixedLMetric for data of this
+  //! dimensionality; this is set by BuildModel().
+  size_t fixedDimension;
+
+  //! The wrapper type of a kd-tree that uses FixedLMetric for Dim dimensions.
+  template<size_t Dim>
+  using FixedKDWrapper = LeafSizeRSWrapper<KDTree, FixedLMetric<2, Dim>>;
+
   /**
    * rSearch holds an instance of the RangeSearch class for the current
    * treeType. It is initialized every time BuildModel is executed.
@@ -385,10 +409,20 @@ class RSModel
    * Clean up memory.
    */
   void CleanMemory();
+
+  //! Serialize rSearch, which must be of type WrapperType.
+  template<typename WrapperType, typename Archive>
+  void SerializeSearch(Archive& ar)
+  {
+    WrapperType& typedSearch = dynamic_cast<WrapperType&>(*rSearch);
+    ar(CEREAL_NVP(typedSearch));
+  }
 };
 
 } // namespace mlpack
 
+CEREAL_CLASS_VERSION(mlpack::RSModel, 1);
+
 // Include implementation (of serialize() and templated wrapper classes).
 #include "rs_model_impl.hpp"
 
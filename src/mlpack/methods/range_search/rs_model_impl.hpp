@@ -27,6 +27,7 @@ inline RSModel::RSModel(TreeTypes treeType, bool randomBasis) :
     treeType(treeType),
     leafSize(0),
     randomBasis(randomBasis),
+    fixedDimension(0),
     rSearch(NULL)
 {
   // Nothing to do.
@@ -38,6 +39,7 @@ inline RSModel::RSModel(const RSModel& other) :
     leafSize(other.leafSize),
     randomBasis(other.randomBasis),
     q(other.q),
+    fixedDimension(other.fixedDimension),
     rSearch(other.rSearch->Clone())
 {
   // Nothing to do.
@@ -49,12 +51,14 @@ inline RSModel::RSModel(RSModel&& other) :
     leafSize(other.leafSize),
     randomBasis(other.randomBasis),
     q(std::move(other.q)),
+    fixedDimension(other.fixedDimension),
     rSearch(std::move(other.rSearch))
 {
   // Reset other model.
   other.treeType = TreeTypes::KD_TREE;
   other.leafSize = 0;
   other.randomBasis = false;
+  other.fixedDimension = 0;
 }
 
 // Copy operator.
@@ -68,6 +72,7 @@ inline RSModel& RSModel::operator=(const RSModel& other)
     leafSize = other.leafSize;
     randomBasis = other.randomBasis;
     q = other.q;
+    fixedDimension = other.fixedDimension;
     rSearch = other.rSearch->Clone();
   }
 
@@ -85,11 +90,13 @@ inline RSModel& RSModel::operator=(RSModel&& other)
     leafSize = other.leafSize;
     randomBasis = other.randomBasis;
     q = std::move(other.q);
+    fixedDimension = other.fixedDimension;
     rSearch = std::move(other.rSearch);
 
     other.treeType = TreeTypes::KD_TREE;
     other.leafSize = 0;
     other.randomBasis = false;
+    other.fixedDimension = 0;
   }
 
   return *this;
@@ -110,7 +117,14 @@ inline void RSModel::InitializeModel(const bool naive,
   switch (treeType)
   {
     case KD_TREE:
-      rSearch = new LeafSizeRSWrapper<KDTree>(naive, singleMode);
+      if (fixedDimension == 2)
+        rSearch = new FixedKDWrapper<2>(naive, singleMode);
+      else if (fixedDimension == 3)
+        rSearch = new FixedKDWrapper<3>(naive, singleMode);
+      else if (fixedDimension == 4)
+        rSearch = new FixedKDWrapper<4>(naive, singleMode);
+      else
+        rSearch = new LeafSizeRSWrapper<KDTree>(naive, singleMode);
       break;
 
     case COVER_TREE:
@@ -191,6 +205,11 @@ inline void RSModel::BuildModel(util::Timers& timers,
   if (!naive)
     Log::Info << "Building reference tree..." << std::endl;
 
+  // Low-dimensional kd-trees use a distance with a compile-time
+  // dimensionality.
+  const size_t dim = referenceSet.n_rows;
+  fixedDimension = (treeType == KD_TREE && dim >= 2 && dim <= 4) ? dim : 0;
+
   InitializeModel(naive, singleMode);
 
   rSearch->Train(timers, std::move(referenceSet), leafSize);
@@ -206,6 +225,15 @@ inline void RSModel::Search(util::Timers& timers,
                             std::vector<std::vector<size_t>>& neighbors,
                             std::vector<std::vector<double>>& distances)
 {
+  // FixedLMetric does not check the dimensionality of the points.
+  if (fixedDimension != 0 && querySet.n_rows != fixedDimension)
+  {
+    std::ostringstream oss;
+    oss << "RSModel::Search(): the query set has " << querySet.n_rows
+        << " dimensions, but the reference set has " << fixedDimension << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
   // We may need to map the query set randomly.
   if (randomBasis)
   {
@@ -291,10 +319,12 @@ inline void RSModel::CleanMemory()
 
 template<template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RSWrapper<TreeType>::Train(util::Timers& timers,
-                                arma::mat&& referenceSet,
-                                const size_t /* leafSize */)
+                  typename TreeMatType> class TreeType,
+         typename DistanceType>
+void RSWrapper<TreeType, DistanceType>::Train(
+    util::Timers& timers,
+    arma::mat&& referenceSet,
+    const size_t /* leafSize */)
 {
   if (!Naive())
     timers.Start("tree_building");
@@ -306,13 +336,15 @@ void RSWrapper<TreeType>::Train(util::Timers& timers,
 
 template<template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RSWrapper<TreeType>::Search(util::Timers& timers,
-                                 arma::mat&& querySet,
-                                 const Range& range,
-                                 std::vector<std::vector<size_t>>& neighbors,
-                                 std::vector<std::vector<double>>& distances,
-                                 const size_t /* leafSize */)
+                  typename TreeMatType> class TreeType,
+         typename DistanceType>
+void RSWrapper<TreeType, DistanceType>::Search(
+    util::Timers& timers,
+    arma::mat&& querySet,
+    const Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances,
+    const size_t /* leafSize */)
 {
   if (!Naive() && !SingleMode())
   {
@@ -335,11 +367,13 @@ void RSWrapper<TreeType>::Search(util::Timers& timers,
 
 template<template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RSWrapper<TreeType>::Search(util::Timers& timers,
-                                 const Range& range,
-                                 std::vector<std::vector<size_t>>& neighbors,
-                                 std::vector<std::vector<double>>& distances)
+                  typename TreeMatType> class TreeType,
+         typename DistanceType>
+void RSWrapper<TreeType, DistanceType>::Search(
+    util::Timers& timers,
+    const Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances)
 {
   timers.Start("computing_neighbors");
   rs.Search(range, neighbors, distances);
@@ -348,10 +382,12 @@ void RSWrapper<TreeType>::Search(util::Timers& timers,
 
 template<template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void LeafSizeRSWrapper<TreeType>::Train(util::Timers& timers,
-                                        arma::mat&& referenceSet,
-                                        const size_t leafSize)
+                  typename TreeMatType> class TreeType,
+         typename DistanceType>
+void LeafSizeRSWrapper<TreeType, DistanceType>::Train(
+    util::Timers& timers,
+    arma::mat&& referenceSet,
+    const size_t leafSize)
 {
   if (rs.Naive())
   {
@@ -376,8 +412,9 @@ void LeafSizeRSWrapper<TreeType>::Train(util::Timers& timers,
 
 template<template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void LeafSizeRSWrapper<TreeType>::Search(
+                  typename TreeMatType> class TreeType,
+         typename DistanceType>
+void LeafSizeRSWrapper<TreeType, DistanceType>::Search(
     util::Timers& timers,
     arma::mat&& querySet,
     const Range& range,
@@ -422,12 +459,18 @@ void LeafSizeRSWrapper<TreeType>::Search(
 
 // Serialize the model.
 template<typename Archive>
-void RSModel::serialize(Archive& ar, const uint32_t /* version */)
+void RSModel::serialize(Archive& ar, const uint32_t version)
 {
   ar(CEREAL_NVP(treeType));
   ar(CEREAL_NVP(randomBasis));
   ar(CEREAL_NVP(q));
 
+  // Models from before version 1 always used the Euclidean distance.
+  if (cereal::is_loading<Archive>() && version < 1)
+    fixedDimension = 0;
+  else
+    ar(CEREAL_NVP(fixedDimension));
+
   // This should never happen, but just in case...
   if (cereal::is_loading<Archive>())
     InitializeModel(false, false); // Values will be overwritten.
@@ -436,12 +479,15 @@ void RSModel::serialize(Archive& ar, const uint32_t /* version */)
   switch (treeType)
   {
     case KD_TREE:
-      {
-        LeafSizeRSWrapper<KDTree>& typedSearch =
-            dynamic_cast<LeafSizeRSWrapper<KDTree>&>(*rSearch);
-        ar(CEREAL_NVP(typedSearch));
-        break;
-      }
+      if (fixedDimension == 2)
+        SerializeSearch<FixedKDWrapper<2>>(ar);
+      else if (fixedDimension == 3)
+        SerializeSearch<FixedKDWrapper<3>>(ar);
+      else if (fixedDimension == 4)
+        SerializeSearch<FixedKDWrapper<4>>(ar);
+      else
+        SerializeSearch<LeafSizeRSWrapper<KDTree>>(ar);
+      break;
     case COVER_TREE:
       {
         RSWrapper<StandardCoverTree>& typedSearch =
@@ -60,16 +60,35 @@ class LeafSizeRAWrapper;
  *
  * RASearch is currently known to not work with ball trees (#356).
  *
+ * Single-tree search runs the queries in parallel with OpenMP.  Dual-tree
+ * search is parallel when a parallel DualTreeTraversalType is given, such as
+ * BinarySpaceTree::ParallelDualTreeTraverser.  Each query point draws its
+ * samples from its own random number stream (see RASearchRules), so the
+ * results of single-tree search for a given random seed do not depend on the
+ * number of threads.
+ *
  * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
  * @tparam DistanceType The distance metric to use for computation.
  * @tparam TreeType The tree type to use.
+ * @tparam DualTreeTraversalType The type of dual tree traversal to use
+ *     (defaults to the tree's default traverser).
+ * @tparam SingleTreeTraversalType The type of single tree traversal to use
+ *     (defaults to the tree's default traverser).
  */
 template<typename SortPolicy = NearestNeighborSort,
          typename DistanceType = EuclideanDistance,
          typename MatType = arma::mat,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType = KDTree>
+                  typename TreeMatType> class TreeType = KDTree,
+         template<typename RuleType> class DualTreeTraversalType =
+             TreeType<DistanceType,
+                      RAQueryStat<SortPolicy>,
+                      MatType>::template DualTreeTraverser,
+         template<typename RuleType> class SingleTreeTraversalType =
+             TreeType<DistanceType,
+                      RAQueryStat<SortPolicy>,
+                      MatType>::template SingleTreeTraverser>
 class RASearch
 {
  public:
@@ -359,6 +378,17 @@ class RASearch
   void serialize(Archive& ar, const uint32_t /* version */);
 
  private:
+  /**
+   * Run a single-tree traversal for each query point, in parallel.  Each thread
+   * uses its own copy of the rules, which shares the results with the others.
+   *
+   * @param rules Rules to traverse with; the counters of all threads are added
+   *     to them.
+   * @param numQueries Number of query points.
+   */
+  template<typename RuleType>
+  void SingleTreeSearch(RuleType& rules, const size_t numQueries);
+
   //! Permutations of reference points during tree building.
   std::vector<size_t> oldFromNewReferences;
   //! Pointer to the root of the reference tree.
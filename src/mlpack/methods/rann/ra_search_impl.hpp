@@ -25,8 +25,11 @@ template<typename SortPolicy,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-RASearch<SortPolicy, DistanceType, MatType, TreeType>::
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+RASearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::
 RASearch(MatType referenceSetIn,
          const bool naive,
          const bool singleMode,
@@ -60,8 +63,11 @@ template<typename SortPolicy,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-RASearch<SortPolicy, DistanceType, MatType, TreeType>::
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+RASearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::
 RASearch(Tree* referenceTree,
          const bool singleMode,
          const double tau,
@@ -91,8 +97,11 @@ template<typename SortPolicy,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-RASearch<SortPolicy, DistanceType, MatType, TreeType>::
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+RASearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::
 RASearch(const bool naive,
          const bool singleMode,
          const double tau,
@@ -131,8 +140,11 @@ template<typename SortPolicy,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-RASearch<SortPolicy, DistanceType, MatType, TreeType>::
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+RASearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::
 ~RASearch()
 {
   if (treeOwner && referenceTree)
@@ -147,8 +159,11 @@ template<typename SortPolicy,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RASearch<SortPolicy, DistanceType, MatType, TreeType>::Train(
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void RASearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Train(
     MatType referenceSet)
 {
   // Clean up the old tree, if we built one.
@@ -189,8 +204,11 @@ template<typename SortPolicy,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RASearch<SortPolicy, DistanceType, MatType, TreeType>::Train(
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void RASearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Train(
     Tree* referenceTree)
 {
   if (naive)
@@ -217,8 +235,11 @@ template<typename SortPolicy,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RASearch<SortPolicy, DistanceType, MatType, TreeType>::
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void RASearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::
 Search(const MatType& querySet,
        const size_t k,
        arma::Mat<size_t>& neighbors,
@@ -293,12 +314,8 @@ Search(const MatType& querySet,
     {
       Log::Info << "Performing single-tree traversal..." << std::endl;
 
-      // Create the traverser.
-      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
-
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+      // Traverse for each point.
+      SingleTreeSearch(rules, querySet.n_cols);
 
       Log::Info << "Single-tree traversal complete." << std::endl;
       Log::Info << "Average number of distance calculations per query point: "
@@ -318,7 +335,7 @@ Search(const MatType& querySet,
 
     RuleType rules(*referenceSet, queryTree->Dataset(), k, distance, tau, alpha,
         naive, sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
-    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+    DualTreeTraversalType<RuleType> traverser(rules);
 
     Log::Info << "Query statistic pre-search: "
         << queryTree->Stat().NumSamplesMade() << std::endl;
@@ -399,8 +416,11 @@ template<typename SortPolicy,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RASearch<SortPolicy, DistanceType, MatType, TreeType>::Search(
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void RASearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Search(
     Tree* queryTree,
     const size_t k,
     arma::Mat<size_t>& neighbors,
@@ -429,7 +449,7 @@ void RASearch<SortPolicy, DistanceType, MatType, TreeType>::Search(
       naive, sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
 
   // Create the traverser.
-  typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+  DualTreeTraversalType<RuleType> traverser(rules);
   traverser.Traverse(*queryTree, *referenceTree);
 
   rules.GetResults(*neighborPtr, distances);
@@ -455,8 +475,11 @@ template<typename SortPolicy,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RASearch<SortPolicy, DistanceType, MatType, TreeType>::Search(
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void RASearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Search(
     const size_t k,
     arma::Mat<size_t>& neighbors,
     arma::mat& distances)
@@ -496,17 +519,13 @@ void RASearch<SortPolicy, DistanceType, MatType, TreeType>::Search(
   }
   else if (singleMode)
   {
-    // Create the traverser.
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
-
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+    // Traverse for each point.
+    SingleTreeSearch(rules, referenceSet->n_cols);
   }
   else
   {
     // Create the traverser.
-    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+    DualTreeTraversalType<RuleType> traverser(rules);
 
     traverser.Traverse(*referenceTree, *referenceTree);
   }
@@ -541,8 +560,48 @@ template<typename SortPolicy,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RASearch<SortPolicy, DistanceType, MatType, TreeType>::ResetQueryTree(
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+template<typename RuleType>
+void RASearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::SingleTreeSearch(
+    RuleType& rules,
+    const size_t numQueries)
+{
+  #pragma omp parallel
+  {
+    // Each thread has its own copy of the rules, which holds the counters but
+    // shares the candidate lists, the number of samples made and the random
+    // number streams of each query point; since every query point is handled
+    // by a single thread, these need no locking.
+    RuleType threadRules(rules);
+    threadRules.BaseCases() = 0;
+    threadRules.Scores() = 0;
+    SingleTreeTraversalType<RuleType> traverser(threadRules);
+
+    #pragma omp for schedule(dynamic, 16)
+    for (size_t i = 0; i < numQueries; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    #pragma omp critical
+    {
+      rules.BaseCases() += threadRules.BaseCases();
+      rules.Scores() += threadRules.Scores();
+    }
+  }
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void RASearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::ResetQueryTree(
     Tree* queryNode) const
 {
   queryNode->Stat().Bound() = SortPolicy::WorstDistance();
@@ -557,9 +616,12 @@ template<typename SortPolicy,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
 template<typename Archive>
-void RASearch<SortPolicy, DistanceType, MatType, TreeType>::serialize(
+void RASearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::serialize(
     Archive& ar, const uint32_t /* version */)
 {
   // Serialize preferences for search.
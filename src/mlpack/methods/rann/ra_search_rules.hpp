@@ -14,9 +14,12 @@
 #ifndef MLPACK_METHODS_RANN_RA_SEARCH_RULES_HPP
 #define MLPACK_METHODS_RANN_RA_SEARCH_RULES_HPP
 
+#include <mlpack/core/tree/rule_traits.hpp>
 #include <mlpack/core/tree/traversal_info.hpp>
 
+#include <memory>
 #include <queue>
+#include <unordered_set>
 
 namespace mlpack {
 
@@ -24,6 +27,15 @@ namespace mlpack {
  * The RASearchRules class is a template helper class used by RASearch class
  * when performing rank-approximate search via random-sampling.
  *
+ * Copies of the rules share the candidate lists, the number of samples made
+ * for each query point, and the random number streams, so that different
+ * threads can traverse for disjoint sets of query points at the same time.
+ * Each query point has its own random number stream, seeded from RandGen()
+ * when the rules are constructed, so the samples taken for a query point do
+ * not depend on the order in which the query points are handled; thus, for a
+ * given seed, the results of a single-tree search do not depend on the number
+ * of threads.
+ *
  * @tparam SortPolicy The sort policy for distances.
  * @tparam DistanceType The distance metric to use for computation.
  * @tparam TreeType The tree type to use; must adhere to the TreeType API.
@@ -229,12 +241,23 @@ class RASearchRules
   size_t NumDistComputations() { return numDistComputations; }
   size_t NumEffectiveSamples()
   {
-    if (numSamplesMade.n_elem == 0)
+    if (numSamplesMade->n_elem == 0)
       return 0;
     else
-      return sum(numSamplesMade);
+      return sum(*numSamplesMade);
   }
 
+  //! Get the number of base cases (distance calculations) that have been
+  //! performed.
+  size_t BaseCases() const { return numDistComputations; }
+  //! Modify the number of base cases that have been performed.
+  size_t& BaseCases() { return numDistComputations; }
+
+  //! Get the number of scores that have been performed.
+  size_t Scores() const { return scores; }
+  //! Modify the number of scores that have been performed.
+  size_t& Scores() { return scores; }
+
   typedef typename mlpack::TraversalInfo<TreeType> TraversalInfoType;
 
   const TraversalInfoType& TraversalInfo() const { return traversalInfo; }
@@ -267,8 +290,9 @@ class RASearchRules
   typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
       CandidateList;
 
-  //! Set of candidate neighbors for each point.
-  std::vector<CandidateList> candidates;
+  //! Set of candidate neighbors for each point.  This is shared between copies
+  //! of the rules.
+  std::shared_ptr<std::vector<CandidateList>> candidates;
 
   //! Number of neighbors to search for.
   const size_t k;
@@ -288,8 +312,13 @@ class RASearchRules
   //! The minimum number of samples required per query.
   size_t numSamplesReqd;
 
-  //! The number of samples made for every query.
-  arma::Col<size_t> numSamplesMade;
+  //! The number of samples made for every query.  This is shared between
+  //! copies of the rules.
+  std::shared_ptr<arma::Col<size_t>> numSamplesMade;
+
+  //! The state of the random number stream of every query.  This is shared
+  //! between copies of the rules.
+  std::shared_ptr<std::vector<uint64_t>> randomStates;
 
   //! The sampling ratio.
   double samplingRatio;
@@ -297,6 +326,9 @@ class RASearchRules
   //! The number of distance calculations performed during search.
   size_t numDistComputations;
 
+  //! The number of scores performed during search.
+  size_t scores;
+
   //! If the query and reference set are identical, this is true.
   bool sameSet;
 
@@ -313,6 +345,21 @@ class RASearchRules
                       const size_t neighbor,
                       const double distance);
 
+  /**
+   * Sample the given number of distinct indices in [0, n) uniformly at random
+   * from the random number stream of the given query point.
+   *
+   * @param queryIndex Index of the query point to sample for.
+   * @param n The number of indices to sample from.
+   * @param numSamples The number of indices to sample.
+   */
+  arma::uvec RandomSample(const size_t queryIndex,
+                          const size_t n,
+                          const size_t numSamples);
+
+  //! Advance the given random number stream, and return the next number.
+  static uint64_t NextRandom(uint64_t& state);
+
   /**
    * Perform actual scoring for single-tree case.
    */
@@ -333,6 +380,18 @@ class RASearchRules
       "provide a unique number of descendants points.");
 }; // class RASearchRules
 
+/**
+ * The RASearchRules only write results of the query points they are given,
+ * and copies share the candidate lists, so disjoint query subtrees can be
+ * traversed in parallel.
+ */
+template<typename SortPolicy, typename DistanceType, typename TreeType>
+class RuleTraits<RASearchRules<SortPolicy, DistanceType, TreeType>>
+{
+ public:
+  static const bool HasPerQueryResults = true;
+};
+
 } // namespace mlpack
 
 // Include implementation.
@@ -60,8 +60,10 @@ RASearchRules(const arma::mat& referenceSet,
   numSamplesReqd = RAUtil::MinimumSamplesReqd(n, k, tau, alpha);
 
   // Initialize some statistics to be collected during the search.
-  numSamplesMade = zeros<arma::Col<size_t>>(querySet.n_cols);
+  numSamplesMade = std::make_shared<arma::Col<size_t>>(querySet.n_cols,
+      arma::fill::zeros);
   numDistComputations = 0;
+  scores = 0;
   samplingRatio = (double) numSamplesReqd / (double) n;
 
   Log::Info << "Minimum samples required per query: " << numSamplesReqd <<
@@ -77,9 +79,18 @@ RASearchRules(const arma::mat& referenceSet,
   std::vector<Candidate> vect(k, def);
   CandidateList pqueue(CandidateCmp(), std::move(vect));
 
-  candidates.reserve(querySet.n_cols);
+  candidates = std::make_shared<std::vector<CandidateList>>(querySet.n_cols,
+      pqueue);
+
+  // Give each query point its own random number stream.  The streams start at
+  // scrambled positions, so that they do not overlap in practice.
+  const uint64_t seed = (uint64_t(RandGen()()) << 32) | uint64_t(RandGen()());
+  randomStates = std::make_shared<std::vector<uint64_t>>(querySet.n_cols);
   for (size_t i = 0; i < querySet.n_cols; ++i)
-    candidates.push_back(pqueue);
+  {
+    uint64_t state = seed + i * 0x9E3779B97F4A7C15ULL;
+    (*randomStates)[i] = NextRandom(state);
+  }
 
   if (naive) // No tree traversal; just do naive sampling here.
   {
@@ -87,7 +98,7 @@ RASearchRules(const arma::mat& referenceSet,
     arma::uvec distinctSamples;
     for (size_t i = 0; i < querySet.n_cols; ++i)
     {
-      distinctSamples = arma::randperm(n, numSamplesReqd);
+      distinctSamples = RandomSample(i, n, numSamplesReqd);
       for (size_t j = 0; j < distinctSamples.n_elem; ++j)
         BaseCase(i, (size_t) distinctSamples[j]);
     }
@@ -104,7 +115,7 @@ void RASearchRules<SortPolicy, DistanceType, TreeType>::GetResults(
 
   for (size_t i = 0; i < querySet.n_cols; ++i)
   {
-    CandidateList& pqueue = candidates[i];
+    CandidateList& pqueue = (*candidates)[i];
     for (size_t j = 1; j <= k; ++j)
     {
       neighbors(k - j, i) = pqueue.top().second;
@@ -130,7 +141,7 @@ double RASearchRules<SortPolicy, DistanceType, TreeType>::BaseCase(
 
   InsertNeighbor(queryIndex, referenceIndex, d);
 
-  numSamplesMade[queryIndex]++;
+  (*numSamplesMade)[queryIndex]++;
 
   numDistComputations++;
 
@@ -142,10 +153,11 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
     const size_t queryIndex,
     TreeType& referenceNode)
 {
+  ++scores;
   const arma::vec queryPoint = querySet.unsafe_col(queryIndex);
   const double d = SortPolicy::BestPointToNodeDistance(queryPoint,
       &referenceNode);
-  const double bestDistance = candidates[queryIndex].top().first;
+  const double bestDistance = (*candidates)[queryIndex].top().first;
 
   return Score(queryIndex, referenceNode, d, bestDistance);
 }
@@ -156,10 +168,11 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
     TreeType& referenceNode,
     const double baseCaseResult)
 {
+  ++scores;
   const arma::vec queryPoint = querySet.unsafe_col(queryIndex);
   const double d = SortPolicy::BestPointToNodeDistance(queryPoint,
       &referenceNode, baseCaseResult);
-  const double bestDistance = candidates[queryIndex].top().first;
+  const double bestDistance = (*candidates)[queryIndex].top().first;
 
   return Score(queryIndex, referenceNode, d, bestDistance);
 }
@@ -175,19 +188,19 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
   // will be something down this node.  Also check if enough samples are already
   // made for this query.
   if (SortPolicy::IsBetter(dist, bestDistance)
-      && numSamplesMade[queryIndex] < numSamplesReqd)
+      && (*numSamplesMade)[queryIndex] < numSamplesReqd)
   {
     // We cannot prune this node; try approximating it by sampling.
 
     // If we are required to visit the first leaf (to find possible duplicates),
     // make sure we do not approximate.
-    if (numSamplesMade[queryIndex] > 0 || !firstLeafExact)
+    if ((*numSamplesMade)[queryIndex] > 0 || !firstLeafExact)
     {
       // Check if this node can be approximated by sampling.
       size_t samplesReqd = (size_t) std::ceil(samplingRatio *
           (double) referenceNode.NumDescendants());
       samplesReqd = std::min(samplesReqd,
-          numSamplesReqd - numSamplesMade[queryIndex]);
+          numSamplesReqd - (*numSamplesMade)[queryIndex]);
 
       if (samplesReqd > singleSampleLimit && !referenceNode.IsLeaf())
       {
@@ -200,8 +213,8 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
         {
           // Then samplesReqd <= singleSampleLimit.
           // Hence, approximate the node by sampling enough number of points.
-          arma::uvec distinctSamples =
-              arma::randperm(referenceNode.NumDescendants(), samplesReqd);
+          arma::uvec distinctSamples = RandomSample(queryIndex,
+              referenceNode.NumDescendants(), samplesReqd);
           for (size_t i = 0; i < distinctSamples.n_elem; ++i)
             // The counting of the samples are done in the 'BaseCase' function
             // so no book-keeping is required here.
@@ -215,8 +228,8 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
           if (sampleAtLeaves) // If allowed to sample at leaves.
           {
             // Approximate node by sampling enough number of points.
-            arma::uvec distinctSamples =
-                arma::randperm(referenceNode.NumDescendants(), samplesReqd);
+            arma::uvec distinctSamples = RandomSample(queryIndex,
+                referenceNode.NumDescendants(), samplesReqd);
             for (size_t i = 0; i < distinctSamples.n_elem; ++i)
               // The counting of the samples are done in the 'BaseCase' function
               // so no book-keeping is required here.
@@ -251,7 +264,7 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
 
     // If enough samples are already made, this step does not change the result
     // of the search.
-    numSamplesMade[queryIndex] += (size_t) std::floor(
+    (*numSamplesMade)[queryIndex] += (size_t) std::floor(
         samplingRatio * (double) referenceNode.NumDescendants());
 
     return DBL_MAX;
@@ -269,13 +282,13 @@ Rescore(const size_t queryIndex,
     return oldScore;
 
   // Just check the score again against the distances.
-  const double bestDistance = candidates[queryIndex].top().first;
+  const double bestDistance = (*candidates)[queryIndex].top().first;
 
   // If this is better than the best distance we've seen so far,
   // maybe there will be something down this node.
   // Also check if enough samples are already made for this query.
   if (SortPolicy::IsBetter(oldScore, bestDistance)
-      && numSamplesMade[queryIndex] < numSamplesReqd)
+      && (*numSamplesMade)[queryIndex] < numSamplesReqd)
   {
     // We cannot prune this node; thus, we try approximating this node by
     // sampling.
@@ -288,7 +301,7 @@ Rescore(const size_t queryIndex,
     size_t samplesReqd = (size_t) std::ceil(samplingRatio *
         (double) referenceNode.NumDescendants());
     samplesReqd = std::min(samplesReqd, numSamplesReqd -
-        numSamplesMade[queryIndex]);
+        (*numSamplesMade)[queryIndex]);
 
     if (samplesReqd > singleSampleLimit && !referenceNode.IsLeaf())
     {
@@ -302,8 +315,8 @@ Rescore(const size_t queryIndex,
       {
         // Then, samplesReqd <= singleSampleLimit.  Hence, approximate the node
         // by sampling enough number of points.
-        arma::uvec distinctSamples =
-            arma::randperm(referenceNode.NumDescendants(), samplesReqd);
+        arma::uvec distinctSamples = RandomSample(queryIndex,
+            referenceNode.NumDescendants(), samplesReqd);
         for (size_t i = 0; i < distinctSamples.n_elem; ++i)
           // The counting of the samples are done in the 'BaseCase' function so
           // no book-keeping is required here.
@@ -317,8 +330,8 @@ Rescore(const size_t queryIndex,
         if (sampleAtLeaves)
         {
           // Approximate node by sampling enough points.
-          arma::uvec distinctSamples =
-              arma::randperm(referenceNode.NumDescendants(), samplesReqd);
+          arma::uvec distinctSamples = RandomSample(queryIndex,
+              referenceNode.NumDescendants(), samplesReqd);
           for (size_t i = 0; i < distinctSamples.n_elem; ++i)
             // The counting of the samples are done in the 'BaseCase' function
             // so no book-keeping is required here.
@@ -343,7 +356,7 @@ Rescore(const size_t queryIndex,
     // Add 'fake' samples from this node; they are fake because the distances to
     // these samples need not be computed.  If enough samples are already made,
     // this step does not change the result of the search.
-    numSamplesMade[queryIndex] += (size_t) std::floor(samplingRatio *
+    (*numSamplesMade)[queryIndex] += (size_t) std::floor(samplingRatio *
         (double) referenceNode.NumDescendants());
 
     return DBL_MAX;
@@ -355,6 +368,8 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
     TreeType& queryNode,
     TreeType& referenceNode)
 {
+  ++scores;
+
   // First try to find the distance bound to check if we can prune by distance.
 
   // Calculate the best node-to-node distance.
@@ -367,7 +382,7 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
 
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double bound = candidates[queryNode.Point(i)].top().first
+    const double bound = (*candidates)[queryNode.Point(i)].top().first
         + maxDescendantDistance;
     if (bound < pointBound)
       pointBound = bound;
@@ -393,6 +408,8 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
       TreeType& referenceNode,
       const double baseCaseResult)
 {
+  ++scores;
+
   // First try to find the distance bound to check if we can prune
   // by distance.
 
@@ -406,7 +423,7 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
 
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double bound = candidates[queryNode.Point(i)].top().first
+    const double bound = (*candidates)[queryNode.Point(i)].top().first
         + maxDescendantDistance;
     if (bound < pointBound)
       pointBound = bound;
@@ -504,8 +521,8 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
           for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
           {
             const size_t queryIndex = queryNode.Descendant(i);
-            distinctSamples = arma::randperm(referenceNode.NumDescendants(),
-                samplesReqd);
+            distinctSamples = RandomSample(queryIndex,
+                referenceNode.NumDescendants(), samplesReqd);
             for (size_t j = 0; j < distinctSamples.n_elem; ++j)
               // The counting of the samples are done in the 'BaseCase' function
               // so no book-keeping is required here.
@@ -534,8 +551,8 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
             for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
             {
               const size_t queryIndex = queryNode.Descendant(i);
-              distinctSamples = arma::randperm(referenceNode.NumDescendants(),
-                  samplesReqd);
+              distinctSamples = RandomSample(queryIndex,
+                  referenceNode.NumDescendants(), samplesReqd);
               for (size_t j = 0; j < distinctSamples.n_elem; ++j)
                 // The counting of the samples are done in the 'BaseCase'
                 // function so no book-keeping is required here.
@@ -620,7 +637,7 @@ Rescore(TreeType& queryNode,
 
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double bound = candidates[queryNode.Point(i)].top().first
+    const double bound = (*candidates)[queryNode.Point(i)].top().first
         + maxDescendantDistance;
     if (bound < pointBound)
       pointBound = bound;
@@ -709,8 +726,8 @@ Rescore(TreeType& queryNode,
         for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
         {
           const size_t queryIndex = queryNode.Descendant(i);
-          distinctSamples = arma::randperm(referenceNode.NumDescendants(),
-              samplesReqd);
+          distinctSamples = RandomSample(queryIndex,
+              referenceNode.NumDescendants(), samplesReqd);
           for (size_t j = 0; j < distinctSamples.n_elem; ++j)
             // The counting of the samples are done in the 'BaseCase'
             // function so no book-keeping is required here.
@@ -738,8 +755,8 @@ Rescore(TreeType& queryNode,
           for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
           {
             const size_t queryIndex = queryNode.Descendant(i);
-            distinctSamples = arma::randperm(referenceNode.NumDescendants(),
-                samplesReqd);
+            distinctSamples = RandomSample(queryIndex,
+                referenceNode.NumDescendants(), samplesReqd);
             for (size_t j = 0; j < distinctSamples.n_elem; ++j)
               // The counting of the samples are done in BaseCase() so no
               // book-keeping is required here.
@@ -805,7 +822,7 @@ InsertNeighbor(
     const size_t neighbor,
     const double dist)
 {
-  CandidateList& pqueue = candidates[queryIndex];
+  CandidateList& pqueue = (*candidates)[queryIndex];
   Candidate c = std::make_pair(dist, neighbor);
 
   if (CandidateCmp()(c, pqueue.top()))
@@ -815,6 +832,52 @@ InsertNeighbor(
   }
 }
 
+template<typename SortPolicy, typename DistanceType, typename TreeType>
+inline uint64_t RASearchRules<SortPolicy, DistanceType, TreeType>::NextRandom(
+    uint64_t& state)
+{
+  // This is the SplitMix64 generator.
+  state += 0x9E3779B97F4A7C15ULL;
+  uint64_t z = state;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+template<typename SortPolicy, typename DistanceType, typename TreeType>
+arma::uvec RASearchRules<SortPolicy, DistanceType, TreeType>::RandomSample(
+    const size_t queryIndex,
+    const size_t n,
+    const size_t numSamples)
+{
+  uint64_t& state = (*randomStates)[queryIndex];
+  const size_t m = std::min(numSamples, n);
+
+  // Use Floyd's algorithm: for each j in [n - m, n), pick a random index in
+  // [0, j], and take j instead if that index was already picked.  Few samples
+  // are taken from each node, so a linear search of the samples is fastest;
+  // otherwise, use a set.
+  arma::uvec samples(m);
+  std::unordered_set<size_t> picked;
+  const bool usePicked = (m > 64);
+  for (size_t j = n - m, c = 0; j < n; ++j, ++c)
+  {
+    const size_t t = (size_t) (NextRandom(state) % (uint64_t) (j + 1));
+    bool seen;
+    if (usePicked)
+      seen = !picked.insert(t).second;
+    else
+      seen = std::find(samples.begin(), samples.begin() + c, t) !=
+          samples.begin() + c;
+
+    samples[c] = seen ? j : t;
+    if (usePicked && seen)
+      picked.insert(j);
+  }
+
+  return samples;
+}
+
 } // namespace mlpack
 
 #endif // MLPACK_METHODS_RANN_RA_SEARCH_RULES_IMPL_HPP
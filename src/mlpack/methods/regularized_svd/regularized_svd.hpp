@@ -82,7 +82,28 @@ class RegularizedSVD
              arma::mat& u,
              arma::mat& v);
 
+  /**
+   * Obtains the user and item matrices using the provided rating triples,
+   * which are used directly (without conversion to double precision).
+   *
+   * @param data Rating triples (possibly memory-mapped).
+   * @param rank Rank parameter to be used for optimization.
+   * @param u Item matrix obtained on decomposition.
+   * @param v User matrix obtained on decomposition.
+   */
+  void Apply(const data::RatingTriples& data,
+             const size_t rank,
+             arma::mat& u,
+             arma::mat& v);
+
  private:
+  //! Obtain the user and item matrices for any type of rating data.
+  template<typename MatType>
+  void ApplyInternal(const MatType& data,
+                     const size_t rank,
+                     arma::mat& u,
+                     arma::mat& v);
+
   //! Number of optimization iterations.
   size_t iterations;
   //! Learning rate for the SGD optimizer.
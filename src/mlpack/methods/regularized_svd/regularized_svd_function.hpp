@@ -14,13 +14,16 @@
 #define MLPACK_METHODS_REGULARIZED_SVD_REGULARIZED_FUNCTION_SVD_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/rating_triples.hpp>
 #include <ensmallen.hpp>
 
 namespace mlpack {
 
 /**
  * The data is stored in a matrix of type MatType, so that this class can be
- * used with both dense and sparse matrix types.
+ * used with both dense and sparse matrix types, or in a data::RatingTriples
+ * object, so that compact (possibly memory-mapped) ratings can be used
+ * directly.
  *
  * @tparam MatType The matrix type of the dataset.
  */
@@ -97,7 +100,7 @@ class RegularizedSVDFunction
   const arma::mat& GetInitialPoint() const { return initialPoint; }
 
   //! Return the dataset passed into the constructor.
-  const arma::mat& Dataset() const { return data; }
+  const MatType& Dataset() const { return data; }
 
   //! Return the number of training examples. Useful for SGD optimizer.
   size_t NumFunctions() const { return data.n_cols; }
@@ -129,6 +132,21 @@ class RegularizedSVDFunction
   size_t numItems;
 };
 
+/**
+ * Run the specialized SGD for RegularizedSVDFunction; this is the body of the
+ * specializations of ens::StandardSGD::Optimize() below, for any dataset type.
+ *
+ * @param function RegularizedSVDFunction to optimize.
+ * @param parameters Starting point, and resulting parameters.
+ * @param stepSize Step size of SGD.
+ * @param maxIterations Maximum number of iterations (0 means no limit).
+ */
+template<typename MatType>
+double OptimizeRegularizedSVD(RegularizedSVDFunction<MatType>& function,
+                              arma::mat& parameters,
+                              const double stepSize,
+                              const size_t maxIterations);
+
 } // namespace mlpack
 
 namespace ens {
@@ -145,6 +163,12 @@ namespace ens {
       mlpack::RegularizedSVDFunction<arma::mat>& function,
       arma::mat& parameters);
 
+  template <>
+  template <>
+  inline double StandardSGD::Optimize(
+      mlpack::RegularizedSVDFunction<mlpack::data::RatingTriples>& function,
+      arma::mat& parameters);
+
   template <>
   template <>
   inline double ParallelSGD<ExponentialBackoff>::Optimize(
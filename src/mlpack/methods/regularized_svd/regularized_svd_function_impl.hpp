@@ -150,16 +150,11 @@ void RegularizedSVDFunction<MatType>::Gradient(const arma::mat& parameters,
   }
 }
 
-} // namespace mlpack
-
-// Template specialization for the SGD optimizer.
-namespace ens {
-
-template <>
-template <>
-double StandardSGD::Optimize(
-    mlpack::RegularizedSVDFunction<arma::mat>& function,
-    arma::mat& parameters)
+template<typename MatType>
+double OptimizeRegularizedSVD(RegularizedSVDFunction<MatType>& function,
+                              arma::mat& parameters,
+                              const double stepSize,
+                              const size_t maxIterations)
 {
   // Find the number of functions to use.
   const size_t numFunctions = function.NumFunctions();
@@ -172,7 +167,7 @@ double StandardSGD::Optimize(
   for (size_t i = 0; i < numFunctions; ++i)
     overallObjective += function.Evaluate(parameters, i);
 
-  const arma::mat data = function.Dataset();
+  const MatType& data = function.Dataset();
 
   // Now iterate!
   for (size_t i = 1; i != maxIterations; ++i, currentFunction++)
@@ -216,6 +211,30 @@ double StandardSGD::Optimize(
   return overallObjective;
 }
 
+} // namespace mlpack
+
+// Template specialization for the SGD optimizer.
+namespace ens {
+
+template <>
+template <>
+inline double StandardSGD::Optimize(
+    mlpack::RegularizedSVDFunction<arma::mat>& function,
+    arma::mat& parameters)
+{
+  return mlpack::OptimizeRegularizedSVD(function, parameters, stepSize,
+      maxIterations);
+}
+
+template <>
+template <>
+inline double StandardSGD::Optimize(
+    mlpack::RegularizedSVDFunction<mlpack::data::RatingTriples>& function,
+    arma::mat& parameters)
+{
+  return mlpack::OptimizeRegularizedSVD(function, parameters, stepSize,
+      maxIterations);
+}
 
 template <>
 template <>
@@ -31,6 +31,25 @@ void RegularizedSVD<OptimizerType>::Apply(const arma::mat& data,
                                           const size_t rank,
                                           arma::mat& u,
                                           arma::mat& v)
+{
+  ApplyInternal(data, rank, u, v);
+}
+
+template<typename OptimizerType>
+void RegularizedSVD<OptimizerType>::Apply(const data::RatingTriples& data,
+                                          const size_t rank,
+                                          arma::mat& u,
+                                          arma::mat& v)
+{
+  ApplyInternal(data, rank, u, v);
+}
+
+template<typename OptimizerType>
+template<typename MatType>
+void RegularizedSVD<OptimizerType>::ApplyInternal(const MatType& data,
+                                                  const size_t rank,
+                                                  arma::mat& u,
+                                                  arma::mat& v)
 {
   // batchSize is 1 in our implementation of Regularized SVD.
   // batchSize other than 1 has not been supported yet.
@@ -39,7 +58,7 @@ void RegularizedSVD<OptimizerType>::Apply(const arma::mat& data,
       << std::endl;
 
   // Make the optimizer object using a RegularizedSVDFunction object.
-  RegularizedSVDFunction<arma::mat> rSVDFunc(data, rank, lambda);
+  RegularizedSVDFunction<MatType> rSVDFunc(data, rank, lambda);
   ens::StandardSGD optimizer(alpha, batchSize,
       iterations * data.n_cols);
 
@@ -48,8 +67,8 @@ void RegularizedSVD<OptimizerType>::Apply(const arma::mat& data,
   optimizer.Optimize(rSVDFunc, parameters);
 
   // Constants for extracting user and item matrices.
-  const size_t numUsers = max(data.row(0)) + 1;
-  const size_t numItems = max(data.row(1)) + 1;
+  const size_t numUsers = rSVDFunc.NumUsers();
+  const size_t numItems = rSVDFunc.NumItems();
 
   // Extract user and item matrices from the optimized parameters.
   u = parameters.submat(0, numUsers, rank - 1, numUsers + numItems - 1).t();
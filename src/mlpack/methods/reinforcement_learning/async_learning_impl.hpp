@@ -14,7 +14,7 @@
 #define MLPACK_METHODS_RL_ASYNC_LEARNING_IMPL_HPP
 
 #include <mlpack/prereqs.hpp>
-#include "queue"
+#include <atomic>
 
 namespace mlpack {
 
@@ -71,10 +71,10 @@ void AsyncLearning<
     learningNetwork.Reset(environment.InitialSample().Encode().n_elem);
   }
 
-  NetworkType targetNetwork = learningNetwork;
+  SharedParameters targetParameters(learningNetwork.Parameters());
   size_t totalSteps = 0;
   PolicyType policy = this->policy;
-  bool stop = false;
+  std::atomic<bool> stop(false);
 
   // Set up worker pool, worker 0 will be deterministic for evaluation.
   std::vector<WorkerType> workers;
@@ -83,11 +83,6 @@ void AsyncLearning<
     workers.push_back(WorkerType(updater, environment, config, !i));
     workers.back().Initialize(learningNetwork);
   }
-  // Set up task queue corresponding to worker pool.
-  std::queue<size_t> tasks;
-  for (size_t i = 0; i <= config.NumWorkers(); ++i)
-    tasks.push(i);
-
   /**
    * Compute the number of threads for the for-loop. In general, we should use
    * OpenMP task rather than for-loop, here we do so to be compatible with some
@@ -98,8 +93,16 @@ void AsyncLearning<
   numThreads++;
   Log::Debug << numThreads << " threads will be used in total." << std::endl;
 
-  #pragma omp parallel for shared(stop, workers, tasks, learningNetwork, \
-      targetNetwork, totalSteps, policy)
+  /**
+   * The workers are split between the threads once and for all: thread `i`
+   * steps the workers `i`, `i + numThreads`, ... in turn; extra threads have
+   * nothing to do.  Gradients are applied to the shared learning network
+   * without locks (Hogwild).  The target network is shared through
+   * SharedParameters, whose lock is only taken to publish a sync; copying a
+   * newer target network does not wait for it.
+   */
+  #pragma omp parallel for shared(stop, workers, learningNetwork, \
+      targetParameters, totalSteps, policy)
   for (size_t i = 0; i < numThreads; ++i)
   {
     #pragma omp critical
@@ -109,33 +112,23 @@ void AsyncLearning<
             " started." << std::endl;
       #endif
     }
-    size_t task = std::numeric_limits<size_t>::max();
+    // This may happen when threads are more than workers.
+    if (i >= workers.size())
+      continue;
+
     while (!stop)
     {
-      // Assign task to current thread from queue.
-      #pragma omp critical
+      for (size_t task = i; task < workers.size() && !stop;
+          task += numThreads)
       {
-        if (task != std::numeric_limits<size_t>::max())
-          tasks.push(task);
-
-        if (!tasks.empty())
+        // Get corresponding worker.
+        WorkerType& worker = workers[task];
+        double episodeReturn;
+        if (worker.Step(learningNetwork, targetParameters, totalSteps,
+            policy, episodeReturn) && !task)
         {
-          task = tasks.front();
-          tasks.pop();
+          stop = measure(episodeReturn);
         }
-      };
-
-      // This may happen when threads are more than workers.
-      if (task == std::numeric_limits<size_t>::max())
-        continue;
-
-      // Get corresponding worker.
-      WorkerType& worker = workers[task];
-      double episodeReturn;
-      if (worker.Step(learningNetwork, targetNetwork, totalSteps,
-          policy, episodeReturn) && !task)
-      {
-        stop = measure(episodeReturn);
       }
     }
   }
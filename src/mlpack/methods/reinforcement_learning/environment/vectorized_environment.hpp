@@ -0,0 +1,205 @@
+/**
+ * @file methods/reinforcement_learning/environment/vectorized_environment.hpp
+ *
+ * Wrapper that steps several copies of an RL environment in lockstep.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_ENVIRONMENT_VECTORIZED_ENVIRONMENT_HPP
+#define MLPACK_METHODS_RL_ENVIRONMENT_VECTORIZED_ENVIRONMENT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * A VectorizedEnvironment holds several copies of an environment, each with
+ * its own current state, and steps all of them at once.  The current states
+ * can be encoded as one matrix (one column per copy), so that an agent can
+ * select the actions of every copy with a single batched forward pass of its
+ * network; see for instance `QLearning::Steps()`.
+ *
+ * When the episode of a copy ends (because its next state is terminal, or
+ * because it reached the step limit), its return is recorded and the copy is
+ * reset to a new initial state, so that every copy is always in the middle of
+ * an episode.
+ *
+ * If `parallel` is true, the copies are stepped in parallel with OpenMP.  This
+ * is only worthwhile for environments whose `Sample()` is expensive, and only
+ * valid if `Sample()` does not use shared state (such as the random number
+ * generator).  New initial states are always drawn sequentially.
+ *
+ * @tparam EnvironmentType A type of Environment that is being wrapped.
+ */
+template<typename EnvironmentType>
+class VectorizedEnvironment
+{
+ public:
+  //! Convenient typedef for state.
+  using State = typename EnvironmentType::State;
+
+  //! Convenient typedef for action.
+  using Action = typename EnvironmentType::Action;
+
+  /**
+   * Create the VectorizedEnvironment with the given number of copies of the
+   * given environment, and draw the initial state of each copy.
+   *
+   * @param environment The environment to copy.
+   * @param numEnvironments Number of copies of the environment.
+   * @param parallel Whether to step the copies in parallel.
+   */
+  VectorizedEnvironment(const EnvironmentType& environment = EnvironmentType(),
+                        const size_t numEnvironments = 1,
+                        const bool parallel = false) :
+      environments(numEnvironments, environment),
+      parallel(parallel)
+  {
+    if (numEnvironments == 0)
+    {
+      throw std::invalid_argument("VectorizedEnvironment: the number of "
+          "environments must be positive!");
+    }
+
+    Reset();
+  }
+
+  /**
+   * Start a new episode in every copy of the environment.
+   */
+  void Reset()
+  {
+    states.resize(environments.size());
+    for (size_t i = 0; i < environments.size(); ++i)
+      states[i] = environments[i].InitialSample();
+
+    episodeReturns.zeros(environments.size());
+    episodeSteps.zeros(environments.size());
+    completedReturns.clear();
+  }
+
+  /**
+   * Encode the current state of each copy of the environment as a column of
+   * the given matrix.
+   *
+   * @param encoded Matrix to store the encoded states into.
+   */
+  void Encode(arma::mat& encoded) const
+  {
+    encoded.set_size(states[0].Encode().n_elem, states.size());
+    for (size_t i = 0; i < states.size(); ++i)
+      encoded.col(i) = states[i].Encode();
+  }
+
+  /**
+   * Take the given action in each copy of the environment.  The next state of
+   * each copy (before any reset) is stored in `nextStates`, and `isTerminal`
+   * is set to 1 for the copies whose next state is terminal.  The copies whose
+   * episode ended are then reset; the returns of those episodes are given by
+   * CompletedReturns().
+   *
+   * @param actions The action to take in each copy.
+   * @param rewards The reward received by each copy.
+   * @param nextStates The next state of each copy.
+   * @param isTerminal Whether the next state of each copy is terminal.
+   * @param stepLimit Maximum number of steps of each episode (0 means no
+   *     limit).
+   */
+  void Step(const std::vector<Action>& actions,
+            arma::rowvec& rewards,
+            std::vector<State>& nextStates,
+            arma::irowvec& isTerminal,
+            const size_t stepLimit = 0)
+  {
+    if (actions.size() != environments.size())
+    {
+      std::ostringstream oss;
+      oss << "VectorizedEnvironment::Step(): " << actions.size() << " actions "
+          << "given, but there are " << environments.size()
+          << " environments!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    rewards.set_size(environments.size());
+    nextStates.resize(environments.size());
+    isTerminal.set_size(environments.size());
+
+    #pragma omp parallel for if (parallel)
+    for (size_t i = 0; i < environments.size(); ++i)
+    {
+      rewards[i] = environments[i].Sample(states[i], actions[i],
+          nextStates[i]);
+      isTerminal[i] = environments[i].IsTerminal(nextStates[i]) ? 1 : 0;
+    }
+
+    episodeReturns += rewards;
+    episodeSteps += 1;
+
+    completedReturns.clear();
+    for (size_t i = 0; i < environments.size(); ++i)
+    {
+      if (isTerminal[i] || (stepLimit != 0 && episodeSteps[i] >= stepLimit))
+      {
+        completedReturns.push_back(episodeReturns[i]);
+        states[i] = environments[i].InitialSample();
+        episodeReturns[i] = 0.0;
+        episodeSteps[i] = 0;
+      }
+      else
+      {
+        states[i] = nextStates[i];
+      }
+    }
+  }
+
+  //! Get the number of copies of the environment.
+  size_t NumEnvironments() const { return environments.size(); }
+
+  //! Get the current state of each copy.
+  const std::vector<State>& States() const { return states; }
+
+  //! Get the returns of the episodes that ended in the last call to Step().
+  const std::vector<double>& CompletedReturns() const
+  {
+    return completedReturns;
+  }
+
+  //! Get the copies of the environment.
+  const std::vector<EnvironmentType>& Environments() const
+  {
+    return environments;
+  }
+  //! Modify the copies of the environment.
+  std::vector<EnvironmentType>& Environments() { return environments; }
+
+  //! Get whether the copies are stepped in parallel.
+  bool Parallel() const { return parallel; }
+  //! Modify whether the copies are stepped in parallel.
+  bool& Parallel() { return parallel; }
+
+ private:
+  //! The copies of the environment.
+  std::vector<EnvironmentType> environments;
+
+  //! The current state of each copy.
+  std::vector<State> states;
+
+  //! The return of the current episode of each copy, so far.
+  arma::rowvec episodeReturns;
+
+  //! The number of steps of the current episode of each copy, so far.
+  arma::Row<size_t> episodeSteps;
+
+  //! The returns of the episodes that ended in the last call to Step().
+  std::vector<double> completedReturns;
+
+  //! Whether the copies are stepped in parallel.
+  bool parallel;
+};
+
+} // namespace mlpack
+
+#endif
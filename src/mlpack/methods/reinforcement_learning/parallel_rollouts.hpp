@@ -0,0 +1,344 @@
+/**
+ * @file methods/reinforcement_learning/parallel_rollouts.hpp
+ *
+ * Definition of the ParallelRollouts class, which collects experience with
+ * several actor threads while a learner thread trains an off-policy agent.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_PARALLEL_ROLLOUTS_HPP
+#define MLPACK_METHODS_RL_PARALLEL_ROLLOUTS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <thread>
+
+#include "shared_parameters.hpp"
+
+namespace mlpack {
+
+/**
+ * An actor-learner split for off-policy agents such as DDPG, TD3 and SAC.
+ * Each actor has its own copy of the environment and of the policy network,
+ * and runs in its own thread; the transitions it collects are handed to the
+ * learner thread, which stores them in the replay buffer of the agent and
+ * keeps training.  The replay buffer itself is only used by the learner, so
+ * it does not need to be thread-safe, and the actors only take a lock for
+ * the time needed to hand over a transition.
+ *
+ * The learner never performs more updates than the agent would do
+ * sequentially for the same transitions; it publishes the parameters of its
+ * policy network every `syncInterval` updates, and each actor picks them up
+ * before its next step (see SharedParameters).
+ *
+ * One thread is used for the learner and one for each actor.  If fewer
+ * threads are available (for instance without OpenMP), the remaining threads
+ * take turns between the actors, and a single thread alternates between
+ * acting and learning.
+ *
+ * @tparam EnvironmentType The environment of the reinforcement learning task.
+ * @tparam PolicyNetworkType The network used to select actions.
+ */
+template<typename EnvironmentType, typename PolicyNetworkType>
+class ParallelRollouts
+{
+ public:
+  //! Convenient typedef for state.
+  using StateType = typename EnvironmentType::State;
+
+  //! Convenient typedef for action.
+  using ActionType = typename EnvironmentType::Action;
+
+  /**
+   * Create the actors, each with its own copy of the given environment.
+   *
+   * @param environment The environment of the actors.
+   * @param numActors Number of actors.
+   * @param stepLimit Maximum number of steps of each episode (0 means no
+   *     limit).
+   * @param syncInterval Number of updates of the learner between syncs of the
+   *     policy network of the actors.
+   */
+  ParallelRollouts(const EnvironmentType& environment,
+                   const size_t numActors,
+                   const size_t stepLimit,
+                   const size_t syncInterval) :
+      environments(numActors, environment),
+      stepLimit(stepLimit),
+      syncInterval(syncInterval),
+      claimedSteps(0),
+      finishedSteps(0),
+      budget(0),
+      updates(0)
+  {
+    if (numActors == 0)
+    {
+      throw std::invalid_argument("ParallelRollouts: the number of actors "
+          "must be positive!");
+    }
+
+    if (syncInterval == 0)
+    {
+      throw std::invalid_argument("ParallelRollouts: the sync interval must "
+          "be positive!");
+    }
+  }
+
+  /**
+   * Take the given number of steps in total over all the actors, while
+   * training the agent.
+   *
+   * `selectAction(network, actor, state, action)` must set `action` to the
+   * action of actor `actor` in `state`, using the given copy of the policy
+   * network; it is called concurrently by the actor threads.
+   * `store(state, action, reward, nextState, isEnd)` is called by the learner
+   * for each transition, and must return the number of updates that the
+   * transition allows; `update()` performs one update of the agent, and must
+   * update `policyNetwork`.
+   *
+   * @param policyNetwork The policy network trained by the learner.
+   * @param steps Total number of steps to take.
+   * @param selectAction Function selecting the action of an actor.
+   * @param store Function storing a transition for the learner.
+   * @param update Function performing one update of the learner.
+   * @return Returns of the episodes completed by the actors.
+   */
+  template<typename SelectActionType, typename StoreType, typename UpdateType>
+  std::vector<double> Run(PolicyNetworkType& policyNetwork,
+                          const size_t steps,
+                          SelectActionType& selectAction,
+                          StoreType& store,
+                          UpdateType& update)
+  {
+    const size_t numActors = environments.size();
+    networks = std::vector<PolicyNetworkType>(numActors, policyNetwork);
+    versions = std::vector<size_t>(numActors, 0);
+    states.resize(numActors);
+    for (size_t a = 0; a < numActors; ++a)
+      states[a] = environments[a].InitialSample();
+    episodeReturns.zeros(numActors);
+    episodeSteps.zeros(numActors);
+
+    claimedSteps = 0;
+    finishedSteps = 0;
+    budget = 0;
+    pending.clear();
+    returns.clear();
+
+    SharedParameters sharedPolicy(policyNetwork.Parameters());
+
+    #pragma omp parallel num_threads(numActors + 1) shared(sharedPolicy)
+    {
+      size_t thread = 0;
+      size_t numThreads = 1;
+      #ifdef MLPACK_USE_OPENMP
+      thread = omp_get_thread_num();
+      numThreads = omp_get_num_threads();
+      #endif
+
+      if (numThreads == 1)
+      {
+        // Alternate between a step of each actor and the updates it allows.
+        bool acting = true;
+        while (acting)
+        {
+          acting = false;
+          for (size_t a = 0; a < numActors; ++a)
+            acting = Act(a, steps, sharedPolicy, selectAction) || acting;
+
+          Learn(policyNetwork, steps, sharedPolicy, store, update, false);
+        }
+      }
+      else if (thread == 0)
+      {
+        Learn(policyNetwork, steps, sharedPolicy, store, update, true);
+      }
+      else
+      {
+        // Thread t steps the actors t - 1, t - 1 + (numThreads - 1), ...
+        bool acting = true;
+        while (acting)
+        {
+          acting = false;
+          for (size_t a = thread - 1; a < numActors; a += numThreads - 1)
+            acting = Act(a, steps, sharedPolicy, selectAction) || acting;
+        }
+      }
+    }
+
+    // Finish the updates allowed by the last transitions.
+    Learn(policyNetwork, steps, sharedPolicy, store, update, true);
+
+    networks.clear();
+    return std::move(returns);
+  }
+
+  //! Get the number of actors.
+  size_t NumActors() const { return environments.size(); }
+
+ private:
+  //! A transition: state, action, reward, next state, and whether the next
+  //! state is terminal.
+  using TransitionType =
+      std::tuple<StateType, ActionType, double, StateType, bool>;
+
+  /**
+   * Take one step with the given actor, unless all the steps have been taken
+   * already, and hand the transition to the learner.
+   *
+   * @return Whether a step was taken.
+   */
+  template<typename SelectActionType>
+  bool Act(const size_t actor,
+           const size_t steps,
+           const SharedParameters& sharedPolicy,
+           SelectActionType& selectAction)
+  {
+    size_t step;
+    #pragma omp atomic capture
+    step = claimedSteps++;
+    if (step >= steps)
+      return false;
+
+    // Get the latest policy of the learner, if it changed.
+    sharedPolicy.Update(networks[actor].Parameters(), versions[actor]);
+
+    ActionType action;
+    selectAction(networks[actor], actor, states[actor], action);
+    StateType nextState;
+    const double reward = environments[actor].Sample(states[actor], action,
+        nextState);
+    const bool terminal = environments[actor].IsTerminal(nextState);
+
+    episodeReturns[actor] += reward;
+    episodeSteps[actor]++;
+    const bool ended = terminal ||
+        (stepLimit != 0 && episodeSteps[actor] >= stepLimit);
+
+    #pragma omp critical(ParallelRolloutsPending)
+    {
+      pending.push_back(std::make_tuple(states[actor], action, reward,
+          nextState, terminal));
+      if (ended)
+        returns.push_back(episodeReturns[actor]);
+    }
+
+    if (ended)
+    {
+      states[actor] = environments[actor].InitialSample();
+      episodeReturns[actor] = 0.0;
+      episodeSteps[actor] = 0;
+    }
+    else
+    {
+      states[actor] = nextState;
+    }
+
+    #pragma omp atomic
+    finishedSteps++;
+
+    return true;
+  }
+
+  /**
+   * Store the transitions handed over by the actors, and perform the updates
+   * they allow.  If `wait` is true, this returns once all the steps have been
+   * taken and trained on; otherwise, it returns as soon as there is nothing
+   * left to do.
+   */
+  template<typename StoreType, typename UpdateType>
+  void Learn(PolicyNetworkType& policyNetwork,
+             const size_t steps,
+             SharedParameters& sharedPolicy,
+             StoreType& store,
+             UpdateType& update,
+             const bool wait)
+  {
+    std::vector<TransitionType> received;
+    while (true)
+    {
+      // Every transition of a finished step has been handed over already.
+      size_t finished;
+      #pragma omp atomic read
+      finished = finishedSteps;
+
+      #pragma omp critical(ParallelRolloutsPending)
+      {
+        received.swap(pending);
+      }
+
+      for (size_t i = 0; i < received.size(); ++i)
+      {
+        const TransitionType& t = received[i];
+        budget += store(std::get<0>(t), std::get<1>(t), std::get<2>(t),
+            std::get<3>(t), std::get<4>(t));
+      }
+      received.clear();
+
+      if (budget > 0)
+      {
+        update();
+        --budget;
+        if (++updates % syncInterval == 0)
+          sharedPolicy.Publish(policyNetwork.Parameters());
+      }
+      else if (finished >= steps || !wait)
+      {
+        return;
+      }
+      else
+      {
+        // Wait for the actors.
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  //! The environment of each actor.
+  std::vector<EnvironmentType> environments;
+
+  //! Maximum number of steps of each episode (0 means no limit).
+  size_t stepLimit;
+
+  //! Number of updates between syncs of the policy networks of the actors.
+  size_t syncInterval;
+
+  //! The copy of the policy network of each actor.
+  std::vector<PolicyNetworkType> networks;
+
+  //! The version of the policy parameters held by each actor.
+  std::vector<size_t> versions;
+
+  //! The current state of each actor.
+  std::vector<StateType> states;
+
+  //! The return of the current episode of each actor, so far.
+  arma::rowvec episodeReturns;
+
+  //! The number of steps of the current episode of each actor, so far.
+  arma::Row<size_t> episodeSteps;
+
+  //! The number of steps started by the actors.
+  size_t claimedSteps;
+
+  //! The number of steps whose transition has been handed over.
+  size_t finishedSteps;
+
+  //! The transitions not yet received by the learner.
+  std::vector<TransitionType> pending;
+
+  //! The returns of the episodes completed by the actors.
+  std::vector<double> returns;
+
+  //! The number of updates the learner may still perform.
+  size_t budget;
+
+  //! The number of updates performed by the learner.
+  size_t updates;
+};
+
+} // namespace mlpack
+
+#endif
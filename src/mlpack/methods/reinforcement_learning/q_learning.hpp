@@ -16,7 +16,9 @@
 #include <mlpack/core.hpp>
 #include <mlpack/methods/ann/ann.hpp>
 
+#include "environment/vectorized_environment.hpp"
 #include "replay/replay.hpp"
+#include "q_networks/atom_distribution.hpp"
 #include "training_config.hpp"
 
 namespace mlpack {
@@ -103,12 +105,37 @@ class QLearning
    */
   void SelectAction();
 
+  /**
+   * Select an action for each of the given states, with a single batched
+   * forward pass of the learning network.
+   *
+   * @param states Encoded states, one per column.
+   * @param actions The selected action for each state.
+   */
+  void SelectActions(const arma::mat& states,
+                     std::vector<ActionType>& actions);
+
   /**
    * Execute an episode.
    * @return Return of the episode.
    */
   double Episode();
 
+  /**
+   * Take the given number of steps in every copy of the given vectorized
+   * environment.  At each step, the actions of all the copies are selected
+   * with one batched forward pass (see SelectActions()); each transition is
+   * then stored and trained on as in Episode().  N-step replay can only be
+   * used with a single copy of the environment.
+   *
+   * @param environments Copies of the environment to step in lockstep.
+   * @param steps Number of steps to take in each copy.
+   * @return Returns of the episodes that ended during these steps.
+   */
+  std::vector<double> Steps(
+      VectorizedEnvironment<EnvironmentType>& environments,
+      const size_t steps);
+
   //! Modify total steps from beginning.
   size_t& TotalSteps() { return totalSteps; }
   //! Get total steps from beginning.
@@ -233,8 +233,6 @@ void QLearning<
       sampledNextStates, isTerminal);
 
   size_t atomSize = config.AtomSize();
-  arma::colvec support = arma::linspace<arma::colvec>(config.VMin(),
-      config.VMax(), atomSize);
 
   size_t batchSize = sampledNextStates.n_cols;
 
@@ -263,26 +261,12 @@ void QLearning<
         arma::size(atomSize, 1));
   }
 
-  arma::mat tZ = (ConvTo<arma::mat>::From(config.Discount() *
-      (support * (1 - isTerminal))).each_row() + sampledRewards);
-  tZ = arma::clamp(tZ, config.VMin(), config.VMax());
-  arma::mat b = (tZ - config.VMin()) / (config.VMax() - config.VMin()) *
-      (atomSize - 1);
-  arma::mat l = arma::floor(b);
-  arma::mat u = arma::ceil(b);
+  // Project the distributional Bellman update of the whole batch onto the
+  // support.
+  arma::mat projDist;
+  ProjectDistribution(nextDist, sampledRewards, isTerminal, config.Discount(),
+      config.VMin(), config.VMax(), projDist);
 
-  arma::mat projDistUpper = nextDist % (u - b);
-  arma::mat projDistLower = nextDist % (b - l);
-
-  arma::mat projDist = zeros<arma::mat>(arma::size(nextDist));
-  for (size_t batchNo = 0; batchNo < batchSize; batchNo++)
-  {
-    for (size_t j = 0; j < atomSize; j++)
-    {
-      projDist(l(j, batchNo), batchNo) += projDistUpper(j, batchNo);
-      projDist(u(j, batchNo), batchNo) += projDistLower(j, batchNo);
-    }
-  }
   arma::mat dists;
   learningNetwork.Forward(sampledStates, dists);
   arma::mat lossGradients = zeros<arma::mat>(arma::size(dists));
@@ -331,12 +315,40 @@ void QLearning<
   ReplayType
 >::SelectAction()
 {
-  // Get the action value for each action at current state.
-  arma::colvec actionValue;
-  learningNetwork.Predict(state.Encode(), actionValue);
+  // Select the action as a batch of one state.
+  std::vector<ActionType> actions;
+  SelectActions(state.Encode(), actions);
+  action = actions[0];
+}
+
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+void QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::SelectActions(
+    const arma::mat& states,
+    std::vector<ActionType>& actions)
+{
+  // Get the action values for every state with one forward pass.
+  arma::mat actionValues;
+  learningNetwork.Predict(states, actionValues);
 
-  // Select an action according to the behavior policy.
-  action = policy.Sample(actionValue, deterministic, config.NoisyQLearning());
+  // Select an action for each state according to the behavior policy.
+  actions.resize(states.n_cols);
+  for (size_t i = 0; i < states.n_cols; ++i)
+  {
+    actions[i] = policy.Sample(actionValues.unsafe_col(i), deterministic,
+        config.NoisyQLearning());
+  }
 }
 
 template <
@@ -388,6 +400,67 @@ double QLearning<
   return totalReturn;
 }
 
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+std::vector<double> QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::Steps(
+    VectorizedEnvironment<EnvironmentType>& environments,
+    const size_t steps)
+{
+  // N-step replay assumes that consecutive transitions are from one episode.
+  if (replayMethod.NSteps() > 1 && environments.NumEnvironments() > 1)
+  {
+    throw std::invalid_argument("QLearning::Steps(): n-step replay cannot be "
+        "used with more than one environment!");
+  }
+
+  std::vector<double> returns;
+  arma::mat states;
+  std::vector<ActionType> actions;
+  arma::rowvec rewards;
+  std::vector<StateType> nextStates;
+  arma::irowvec isTerminal;
+  for (size_t s = 0; s < steps; ++s)
+  {
+    // Select the actions of all the environments with one forward pass.
+    environments.Encode(states);
+    SelectActions(states, actions);
+
+    // Step() replaces the current states, so keep them for the replay.
+    const std::vector<StateType> currentStates = environments.States();
+    environments.Step(actions, rewards, nextStates, isTerminal);
+    returns.insert(returns.end(), environments.CompletedReturns().begin(),
+        environments.CompletedReturns().end());
+
+    // Store and learn from each transition, as Episode() does.
+    for (size_t i = 0; i < actions.size(); ++i)
+    {
+      totalSteps++;
+      replayMethod.Store(currentStates[i], actions[i], rewards[i],
+          nextStates[i], isTerminal[i] != 0, config.Discount());
+
+      if (deterministic || totalSteps < config.ExplorationSteps())
+        continue;
+      if (config.IsCategorical())
+        TrainCategoricalAgent();
+      else
+        TrainAgent();
+    }
+  }
+
+  return returns;
+}
+
 } // namespace mlpack
 
 #endif
@@ -0,0 +1,174 @@
+/**
+ * @file methods/reinforcement_learning/q_networks/atom_distribution.hpp
+ *
+ * Functions on the distributions over the atoms of the support of the return
+ * used by the categorical deep q network: the softmax over the atoms and its
+ * gradient, and the projection of the distributional Bellman update.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_Q_NETWORKS_ATOM_DISTRIBUTION_HPP
+#define MLPACK_METHODS_RL_Q_NETWORKS_ATOM_DISTRIBUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Compute the softmax over each group of atomSize consecutive rows of the given
+ * logits, in one pass over each group; each column of the logits holds one
+ * group per action.  The log-softmax can be computed in the same pass, from
+ * the logits, so that it does not underflow for small probabilities.
+ *
+ * @param logits Logits of the atoms (numActions * atomSize x batchSize).
+ * @param atomSize Number of atoms of each distribution.
+ * @param probabilities Will contain the probabilities of the atoms.
+ * @param logProbabilities If not nullptr, will contain the logarithms of the
+ *     probabilities of the atoms.
+ */
+inline void AtomSoftmax(const arma::mat& logits,
+                        const size_t atomSize,
+                        arma::mat& probabilities,
+                        arma::mat* logProbabilities = nullptr)
+{
+  if (atomSize == 0 || logits.n_rows % atomSize != 0)
+  {
+    std::ostringstream oss;
+    oss << "AtomSoftmax(): the number of logits (" << logits.n_rows << ") is "
+        << "not a multiple of the number of atoms (" << atomSize << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  probabilities.set_size(arma::size(logits));
+  if (logProbabilities != nullptr)
+    logProbabilities->set_size(arma::size(logits));
+
+  // The groups are contiguous in memory, since the matrices are column-major.
+  const size_t numDists = logits.n_elem / atomSize;
+  #pragma omp parallel for schedule(static)
+  for (size_t d = 0; d < numDists; ++d)
+  {
+    const double* in = logits.memptr() + d * atomSize;
+    double* out = probabilities.memptr() + d * atomSize;
+
+    double maxLogit = in[0];
+    for (size_t k = 1; k < atomSize; ++k)
+      maxLogit = std::max(maxLogit, in[k]);
+
+    double sum = 0.0;
+    for (size_t k = 0; k < atomSize; ++k)
+    {
+      out[k] = std::exp(in[k] - maxLogit);
+      sum += out[k];
+    }
+
+    const double invSum = 1.0 / sum;
+    for (size_t k = 0; k < atomSize; ++k)
+      out[k] *= invSum;
+
+    if (logProbabilities != nullptr)
+    {
+      double* logOut = logProbabilities->memptr() + d * atomSize;
+      const double logSum = maxLogit + std::log(sum);
+      for (size_t k = 0; k < atomSize; ++k)
+        logOut[k] = in[k] - logSum;
+    }
+  }
+}
+
+/**
+ * Compute the gradient of a loss with respect to the logits of AtomSoftmax(),
+ * given its gradient with respect to the probabilities: g = p % (gy -
+ * sum(gy % p)), where the sum is over the atoms of each distribution.
+ *
+ * @param probabilities Probabilities computed by AtomSoftmax().
+ * @param gy Gradient of the loss with respect to the probabilities.
+ * @param atomSize Number of atoms of each distribution.
+ * @param g Will contain the gradient of the loss with respect to the logits.
+ */
+inline void AtomSoftmaxBackward(const arma::mat& probabilities,
+                                const arma::mat& gy,
+                                const size_t atomSize,
+                                arma::mat& g)
+{
+  g.set_size(arma::size(probabilities));
+
+  const size_t numDists = probabilities.n_elem / atomSize;
+  #pragma omp parallel for schedule(static)
+  for (size_t d = 0; d < numDists; ++d)
+  {
+    const double* p = probabilities.memptr() + d * atomSize;
+    const double* grad = gy.memptr() + d * atomSize;
+    double* out = g.memptr() + d * atomSize;
+
+    double dot = 0.0;
+    for (size_t k = 0; k < atomSize; ++k)
+      dot += grad[k] * p[k];
+    for (size_t k = 0; k < atomSize; ++k)
+      out[k] = p[k] * (grad[k] - dot);
+  }
+}
+
+/**
+ * Project the distributional Bellman update of the given distributions onto
+ * the support of the distributions.  For transition i, the atom z_j with
+ * probability p_ij is moved to r_i + discount * z_j (or to r_i, if the
+ * transition is terminal), clamped to [vMin, vMax], and its probability is
+ * split between the two nearest atoms of the support, in proportion to how
+ * close it is to each of them.  The updated positions of all the atoms of the
+ * batch are computed at once, and the probabilities of each transition are
+ * scattered into its column in parallel.
+ *
+ * @param nextDist Distributions of the next states (atomSize x batchSize).
+ * @param rewards Rewards of the transitions.
+ * @param isTerminal Whether each transition ends an episode.
+ * @param discount Discount of the returns.
+ * @param vMin Smallest atom of the support.
+ * @param vMax Largest atom of the support.
+ * @param projDist Will contain the projected distributions.
+ */
+inline void ProjectDistribution(const arma::mat& nextDist,
+                                const arma::rowvec& rewards,
+                                const arma::irowvec& isTerminal,
+                                const double discount,
+                                const double vMin,
+                                const double vMax,
+                                arma::mat& projDist)
+{
+  const size_t atomSize = nextDist.n_rows;
+  const arma::colvec support = arma::linspace<arma::colvec>(vMin, vMax,
+      atomSize);
+
+  // Updated positions of the atoms, as fractional indices into the support.
+  arma::mat b = support * (discount *
+      (1 - arma::conv_to<arma::rowvec>::from(isTerminal)));
+  b.each_row() += rewards;
+  b = (arma::clamp(b, vMin, vMax) - vMin) / (vMax - vMin) * (atomSize - 1);
+
+  projDist.zeros(atomSize, nextDist.n_cols);
+
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < nextDist.n_cols; ++i)
+  {
+    const double* position = b.colptr(i);
+    const double* probability = nextDist.colptr(i);
+    double* out = projDist.colptr(i);
+    for (size_t j = 0; j < atomSize; ++j)
+    {
+      // An atom that lands exactly on an atom of the support keeps all its
+      // probability there; the upper neighbor of the last atom is itself.
+      const size_t lower = std::min((size_t) position[j], atomSize - 1);
+      const size_t upper = std::min(lower + 1, atomSize - 1);
+      const double fraction = position[j] - lower;
+      out[lower] += probability[j] * (1.0 - fraction);
+      out[upper] += probability[j] * fraction;
+    }
+  }
+}
+
+} // namespace mlpack
+
+#endif
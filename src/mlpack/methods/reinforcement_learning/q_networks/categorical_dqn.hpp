@@ -19,6 +19,7 @@
 #include <mlpack/methods/ann/loss_functions/mean_squared_error.hpp>
 #include <mlpack/methods/ann/loss_functions/empty_loss.hpp>
 #include "../training_config.hpp"
+#include "atom_distribution.hpp"
 
 namespace mlpack {
 
@@ -129,17 +130,16 @@ class CategoricalDQN
   {
     arma::mat q_atoms;
     network.Predict(state, q_atoms);
-    activations.copy_size(q_atoms);
-    actionValue.set_size(q_atoms.n_rows / atomSize, q_atoms.n_cols);
-    arma::rowvec support = arma::linspace<arma::rowvec>(vMin, vMax, atomSize);
-    for (size_t i = 0; i < q_atoms.n_rows; i += atomSize)
-    {
-      arma::mat activation = activations.rows(i, i + atomSize - 1);
-      arma::mat input = q_atoms.rows(i, i + atomSize - 1);
-      softMax.Forward(input, activation);
-      activations.rows(i, i + atomSize - 1) = activation;
-      actionValue.row(i/atomSize) = support * activation;
-    }
+    AtomSoftmax(q_atoms, atomSize, activations);
+
+    // Each column of this alias is the distribution of one action for one
+    // state, so the action values are all computed with one product.
+    const arma::mat dists(activations.memptr(), atomSize,
+        activations.n_elem / atomSize, false, true);
+    const arma::rowvec support = arma::linspace<arma::rowvec>(vMin, vMax,
+        atomSize);
+    actionValue = arma::reshape(support * dists, q_atoms.n_rows / atomSize,
+        q_atoms.n_cols);
   }
 
   /**
@@ -152,14 +152,7 @@ class CategoricalDQN
   {
     arma::mat q_atoms;
     network.Forward(state, q_atoms);
-    activations.copy_size(q_atoms);
-    for (size_t i = 0; i < q_atoms.n_rows; i += atomSize)
-    {
-      arma::mat activation = activations.rows(i, i + atomSize - 1);
-      arma::mat input = q_atoms.rows(i, i + atomSize - 1);
-      softMax.Forward(input, activation);
-      activations.rows(i, i + atomSize - 1) = activation;
-    }
+    AtomSoftmax(q_atoms, atomSize, activations);
     dist = activations;
   }
 
@@ -199,15 +192,9 @@ class CategoricalDQN
                 arma::mat& lossGradients,
                 arma::mat& gradient)
   {
-    arma::mat activationGradients(arma::size(activations));
-    for (size_t i = 0; i < activations.n_rows; i += atomSize)
-    {
-      arma::mat activationGrad;
-      arma::mat lossGrad = lossGradients.rows(i, i + atomSize - 1);
-      arma::mat activation = activations.rows(i, i + atomSize - 1);
-      softMax.Backward({} /* unused */, activation, lossGrad, activationGrad);
-      activationGradients.rows(i, i + atomSize - 1) = activationGrad;
-    }
+    arma::mat activationGradients;
+    AtomSoftmaxBackward(activations, lossGradients, atomSize,
+        activationGradients);
     network.Backward(state, activationGradients, gradient);
   }
 
@@ -230,10 +217,7 @@ class CategoricalDQN
   //! Locally-stored indexes of noisy layers in the network.
   std::vector<size_t> noisyLayerIndex;
 
-  //! Locally-stored softmax activation function.
-  Softmax softMax;
-
-  //! Locally-stored activations from softMax.
+  //! Locally-stored probabilities of the atoms from the last forward pass.
   arma::mat activations;
 };
 
@@ -0,0 +1,273 @@
+/**
+ * @file methods/reinforcement_learning/replay/compact_replay.hpp
+ *
+ * This file is an implementation of random experience replay that stores each
+ * observation only once.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_REPLAY_COMPACT_REPLAY_HPP
+#define MLPACK_METHODS_RL_REPLAY_COMPACT_REPLAY_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Implementation of random experience replay with a compact ring buffer.  It
+ * samples transitions uniformly, like RandomReplay, but stores each encoded
+ * observation only once: the next state of the transition stored in slot `i`
+ * of the buffer is the observation in slot `i + 1`.  When a transition
+ * continues the previous one (its state is the previous next state), the
+ * shared observation is not stored again; a new observation slot is only
+ * used when an episode starts.  This takes about half the memory of
+ * RandomReplay, and observations can also be stored in single precision with
+ * `ElemType = float`.
+ *
+ * Sample() writes into the given matrices, so callers that keep their sample
+ * buffers between calls do not allocate any memory.
+ *
+ * N-step transitions are not supported, since their next state is not the
+ * next observation.
+ *
+ * @tparam EnvironmentType Desired task.
+ * @tparam ElemType Type used to store encoded observations.
+ */
+template <typename EnvironmentType, typename ElemType = double>
+class CompactReplay
+{
+ public:
+  //! Convenient typedef for action.
+  using ActionType = typename EnvironmentType::Action;
+
+  //! Convenient typedef for state.
+  using StateType = typename EnvironmentType::State;
+
+  CompactReplay():
+      batchSize(0),
+      capacity(0),
+      position(0),
+      full(false),
+      nSteps(1),
+      chained(false),
+      transitions(0)
+  { /* Nothing to do here. */ }
+
+  /**
+   * Construct an instance of compact experience replay class.
+   *
+   * @param batchSize Number of examples returned at each sample.
+   * @param capacity Total memory size in terms of number of observations.
+   * @param dimension The dimension of an encoded state.
+   */
+  CompactReplay(const size_t batchSize,
+                const size_t capacity,
+                const size_t dimension = StateType::dimension) :
+      batchSize(batchSize),
+      capacity(capacity),
+      position(0),
+      full(false),
+      nSteps(1),
+      chained(false),
+      transitions(0),
+      observations(dimension, capacity),
+      actions(capacity),
+      rewards(capacity),
+      isTerminal(capacity),
+      isTransition(capacity, false)
+  {
+    if (capacity < 2)
+    {
+      throw std::invalid_argument("CompactReplay: the capacity must be at "
+          "least 2!");
+    }
+  }
+
+  /**
+   * Store the given experience.
+   *
+   * @param state Given state.
+   * @param action Given action.
+   * @param reward Given reward.
+   * @param nextState Given next state.
+   * @param isEnd Whether next state is terminal state.
+   * @param * (discount) The discount parameter (unused).
+   */
+  void Store(const StateType& state,
+             const ActionType& action,
+             const double reward,
+             const StateType& nextState,
+             const bool isEnd,
+             const double& /* discount */)
+  {
+    // The last observation written is the next state of the last transition;
+    // if this transition starts from it, it is not stored again.
+    const size_t last = (position + capacity - 1) % capacity;
+    const arma::Col<ElemType> encodedState =
+        ConvTo<arma::Col<ElemType>>::From(state.Encode());
+    size_t slot = last;
+    if (!chained || !arma::all(observations.col(last) == encodedState))
+    {
+      slot = position;
+      Write(encodedState);
+    }
+
+    actions[slot] = action;
+    rewards[slot] = reward;
+    isTerminal[slot] = isEnd;
+    isTransition[slot] = true;
+    ++transitions;
+
+    Write(ConvTo<arma::Col<ElemType>>::From(nextState.Encode()));
+
+    // The next episode starts from a new state.
+    chained = !isEnd;
+  }
+
+  /**
+   * Sample some experiences.  The given matrices are only reallocated if they
+   * do not have the right size already.
+   *
+   * @param sampledStates Sampled encoded states.
+   * @param sampledActions Sampled actions.
+   * @param sampledRewards Sampled rewards.
+   * @param sampledNextStates Sampled encoded next states.
+   * @param sampledIsTerminal Indicate whether corresponding next state is
+   *        terminal state.
+   */
+  void Sample(arma::mat& sampledStates,
+              std::vector<ActionType>& sampledActions,
+              arma::rowvec& sampledRewards,
+              arma::mat& sampledNextStates,
+              arma::irowvec& sampledIsTerminal)
+  {
+    if (transitions == 0)
+    {
+      throw std::logic_error("CompactReplay::Sample(): no transitions have "
+          "been stored!");
+    }
+
+    sampledStates.set_size(observations.n_rows, batchSize);
+    sampledActions.resize(batchSize);
+    sampledRewards.set_size(batchSize);
+    sampledNextStates.set_size(observations.n_rows, batchSize);
+    sampledIsTerminal.set_size(batchSize);
+
+    const size_t upperBound = full ? capacity : position;
+    for (size_t i = 0; i < batchSize; ++i)
+    {
+      // At least half of the used slots hold a transition, so this takes two
+      // tries on average.
+      size_t slot;
+      do
+      {
+        slot = RandInt(upperBound);
+      } while (!isTransition[slot]);
+
+      const size_t next = (slot + 1) % capacity;
+      for (size_t d = 0; d < observations.n_rows; ++d)
+      {
+        sampledStates(d, i) = observations(d, slot);
+        sampledNextStates(d, i) = observations(d, next);
+      }
+      sampledActions[i] = actions[slot];
+      sampledRewards[i] = rewards[slot];
+      sampledIsTerminal[i] = isTerminal[slot];
+    }
+  }
+
+  /**
+   * Get the number of transitions in the memory.
+   *
+   * @return Number of transitions that can be sampled.
+   */
+  size_t Size() const { return transitions; }
+
+  /**
+   * Update the priorities of transitions and Update the gradients.
+   *
+   * @param * (target) The learned value
+   * @param * (sampledActions) Agent's sampled action
+   * @param * (nextActionValues) Agent's next action
+   * @param * (gradients) The model's gradients
+   */
+  void Update(arma::mat /* target */,
+              std::vector<ActionType> /* sampledActions */,
+              arma::mat /* nextActionValues */,
+              arma::mat& /* gradients */)
+  {
+    /* Do nothing for compact replay. */
+  }
+
+  //! Get the number of steps for n-step agent; this is always 1.
+  const size_t& NSteps() const { return nSteps; }
+
+ private:
+  /**
+   * Write the given observation in the next slot of the ring buffer.  Slots
+   * are overwritten in order, so the transition being overwritten is always
+   * the oldest one, and the next state of every remaining transition is still
+   * in the buffer.
+   */
+  void Write(const arma::Col<ElemType>& observation)
+  {
+    if (isTransition[position])
+    {
+      isTransition[position] = false;
+      --transitions;
+    }
+
+    observations.col(position) = observation;
+    position++;
+    if (position == capacity)
+    {
+      full = true;
+      position = 0;
+    }
+  }
+
+  //! Locally-stored number of examples of each sample.
+  size_t batchSize;
+
+  //! Locally-stored total memory limit, in observations.
+  size_t capacity;
+
+  //! Indicate the position to store the next observation.
+  size_t position;
+
+  //! Locally-stored indicator that whether the memory is full or not
+  bool full;
+
+  //! Locally-stored number of steps to look into the future (always 1).
+  size_t nSteps;
+
+  //! Whether the last observation written may be the state of the next
+  //! transition.
+  bool chained;
+
+  //! Locally-stored number of transitions in the memory.
+  size_t transitions;
+
+  //! Locally-stored encoded observations.
+  arma::Mat<ElemType> observations;
+
+  //! Locally-stored action of the transition starting at each slot.
+  std::vector<ActionType> actions;
+
+  //! Locally-stored reward of the transition starting at each slot.
+  arma::rowvec rewards;
+
+  //! Locally-stored termination information of each transition.
+  arma::irowvec isTerminal;
+
+  //! Whether a transition starts at each slot (the last observation of an
+  //! episode is only a next state).
+  std::vector<bool> isTransition;
+};
+
+} // namespace mlpack
+
+#endif
@@ -98,14 +98,8 @@ class PrioritizedReplay
       nextStates(dimension, capacity),
       isTerminal(capacity)
   {
-    size_t size = 1;
-    while (size < capacity)
-    {
-      size *= 2;
-    }
-
     beta = initialBeta;
-    idxSum = SumTree<double>(size);
+    idxSum = SumTree<double>(capacity);
   }
 
   /**
@@ -190,20 +184,23 @@ class PrioritizedReplay
   }
 
   /**
-   * Sample some experience according to their priorities.
+   * Sample some experience according to their priorities.  The total
+   * priority is split into `batchSize` equal ranges, and one transition is
+   * sampled from each range; the masses are increasing, so they are all found
+   * in a single pass over the sum tree.
    *
    * @return The indices to be chosen.
    */
   arma::ucolvec SampleProportional()
   {
-    arma::ucolvec idxes(batchSize);
+    arma::ucolvec idxes;
     double totalSum = idxSum.Sum(0, (full ? capacity : position));
     double sumPerRange = totalSum / batchSize;
+    arma::colvec masses(batchSize);
     for (size_t bt = 0; bt < batchSize; bt++)
-    {
-      const double mass = arma::randu() * sumPerRange + bt * sumPerRange;
-      idxes(bt) = idxSum.FindPrefixSum(mass);
-    }
+      masses(bt) = arma::randu() * sumPerRange + bt * sumPerRange;
+
+    idxSum.BatchFindPrefixSum(masses, idxes);
     return idxes;
   }
 
@@ -25,11 +25,21 @@ namespace mlpack {
  *
  * Used to maintain prefix-sum of an array.
  *
+ * The tree is an implicit `Arity`-ary tree stored level by level, starting
+ * from the root; the children of node `j` of a level are the nodes
+ * `Arity * j` to `Arity * j + Arity - 1` of the next level, so they are
+ * contiguous in memory.  With the default of 8 children, the tree is only a
+ * third as deep as a binary tree, each step of a descent reads a single cache
+ * line, and no padding is needed when the capacity is not a power of two.
+ *
  * @tparam T The array's element type.
+ * @tparam Arity The number of children of each node.
  */
-template<typename T>
+template<typename T, size_t Arity = 8>
 class SumTree
 {
+  static_assert(Arity >= 2, "SumTree: the arity must be at least 2.");
+
  public:
   /**
    * Default constructor.
@@ -44,7 +54,21 @@ class SumTree
    */
   SumTree(const size_t capacity) : capacity(capacity)
   {
-    element = std::vector<T>(2 * capacity);
+    if (capacity == 0)
+      return;
+
+    // Compute the size of each level, from the leaves up to the root.
+    std::vector<size_t> sizes(1, capacity);
+    while (sizes.back() > 1)
+      sizes.push_back((sizes.back() + Arity - 1) / Arity);
+    std::reverse(sizes.begin(), sizes.end());
+
+    levelOffsets.resize(sizes.size() + 1);
+    levelOffsets[0] = 0;
+    for (size_t k = 0; k < sizes.size(); ++k)
+      levelOffsets[k + 1] = levelOffsets[k] + sizes[k];
+
+    element = std::vector<T>(levelOffsets.back());
   }
 
   /**
@@ -55,32 +79,43 @@ class SumTree
    */
   void Set(size_t idx, const T value)
   {
-    idx += capacity;
-    element[idx] = value;
-    idx /= 2;
-    while (idx >= 1)
+    element[LeafOffset() + idx] = value;
+    for (size_t k = Levels() - 1; k > 0; --k)
     {
-      element[idx] = element[2 * idx] + element[2 * idx + 1];
-      idx /= 2;
+      idx /= Arity;
+      UpdateNode(k - 1, idx);
     }
   }
 
   /**
    * Update the data with batch rather loop over the indices with set method.
+   * Only the ancestors of the changed elements are updated, and each of them
+   * only once.
    *
    * @param indices The indices of data to be changed.
    * @param data The data that array with indices to be.
    */
   void BatchUpdate(const arma::ucolvec& indices, const arma::Col<T>& data)
   {
+    if (indices.n_elem == 0)
+      return;
+
+    const size_t leafOffset = LeafOffset();
     for (size_t i = 0; i < indices.n_rows; ++i)
+      element[leafOffset + indices[i]] = data[i];
+
+    // Update the tree bottom-up.  The parents of sorted nodes are sorted, so
+    // duplicates are adjacent.
+    std::vector<size_t> nodes(indices.begin(), indices.end());
+    std::sort(nodes.begin(), nodes.end());
+    for (size_t k = Levels() - 1; k > 0; --k)
     {
-      element[indices[i] + capacity] = data[i];
-    }
-    // update the total tree with bottom-up technique.
-    for (size_t i = capacity - 1; i > 0; i--)
-    {
-      element[i] = element[2 * i] + element[2 * i + 1];
+      for (size_t i = 0; i < nodes.size(); ++i)
+        nodes[i] /= Arity;
+      nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+      for (size_t i = 0; i < nodes.size(); ++i)
+        UpdateNode(k - 1, nodes[i]);
     }
   }
 
@@ -91,46 +126,7 @@ class SumTree
    */
   T Get(size_t idx)
   {
-    idx += capacity;
-    return element[idx];
-  }
-
-  /**
-   * Help function for the `sum` function
-   *
-   * @param start The starting position of subsequence.
-   * @param end The end position of subsequence.
-   * @param node Reference position.
-   * @param nodeStart Starting position of reference segment.
-   * @param nodeEnd End position of reference segment.
-   */
-  T SumHelper(const size_t start,
-              const size_t end,
-              const size_t node,
-              const size_t nodeStart,
-              const size_t nodeEnd)
-  {
-    if (start == nodeStart && end == nodeEnd)
-    {
-      return element[node];
-    }
-    size_t mid = (nodeStart + nodeEnd) / 2;
-    if (end <= mid)
-    {
-      return SumHelper(start, end, 2 * node, nodeStart, mid);
-    }
-    else
-    {
-      if (mid + 1 <= start)
-      {
-        return SumHelper(start, end, 2 * node + 1, mid + 1 , nodeEnd);
-      }
-      else
-      {
-        return SumHelper(start, mid, 2 * node, nodeStart, mid) +
-            SumHelper(mid + 1, end, 2 * node + 1, mid + 1 , nodeEnd);
-      }
-    }
+    return element[LeafOffset() + idx];
   }
 
   /**
@@ -141,8 +137,7 @@ class SumTree
    */
   T Sum(const size_t start, size_t end)
   {
-    end -= 1;
-    return SumHelper(start, end, 1, 0, capacity - 1);
+    return PrefixSum(end) - PrefixSum(start);
   }
 
   /**
@@ -150,38 +145,138 @@ class SumTree
    */
   T Sum()
   {
-    return Sum(0, capacity);
+    return (capacity == 0) ? T(0) : element[0];
   }
 
   /**
    * Find the highest index `idx` in the array such that
-   * sum(arr[0] + arr[1] + ... + arr[idx]) <= mass.
+   * sum(arr[0] + arr[1] + ... + arr[idx]) <= mass.  If `mass` is at least the
+   * sum of the whole array, the last element with a nonzero value is
+   * returned.
    *
    * @param mass The upper bound of segment array sum.
    */
   size_t FindPrefixSum(T mass)
   {
-    size_t idx = 1;
-    while (idx < capacity)
+    size_t idx = 0;
+    for (size_t k = 0; k + 1 < Levels(); ++k)
+      idx = FindChild(k + 1, idx, mass);
+
+    return idx;
+  }
+
+  /**
+   * Find the index given by FindPrefixSum() for each of the given masses.
+   * The masses should be sorted (as they are for stratified sampling); all of
+   * them then descend the tree together, one level at a time, so that every
+   * level is read only once, in order.
+   *
+   * @param masses The masses to find, in increasing order.
+   * @param indices The index found for each mass.
+   */
+  void BatchFindPrefixSum(const arma::Col<T>& masses, arma::ucolvec& indices)
+  {
+    indices.zeros(masses.n_elem);
+    arma::Col<T> remaining(masses);
+    for (size_t k = 0; k + 1 < Levels(); ++k)
     {
-      if (element[2 * idx] > mass)
-      {
-        idx = 2 * idx;
-      }
-      else
+      for (size_t i = 0; i < masses.n_elem; ++i)
+        indices[i] = FindChild(k + 1, indices[i], remaining[i]);
+    }
+  }
+
+ private:
+  //! Get the number of levels of the tree.
+  size_t Levels() const { return levelOffsets.size() - 1; }
+
+  //! Get the position of the first leaf.
+  size_t LeafOffset() const { return levelOffsets[Levels() - 1]; }
+
+  //! Get the number of nodes of the given level.
+  size_t LevelSize(const size_t level) const
+  {
+    return levelOffsets[level + 1] - levelOffsets[level];
+  }
+
+  //! Set the node `j` of the given level to the sum of its children.
+  void UpdateNode(const size_t level, const size_t j)
+  {
+    const size_t first = j * Arity;
+    const size_t last = std::min(first + Arity, LevelSize(level + 1));
+    const T* children = element.data() + levelOffsets[level + 1];
+
+    T sum = 0;
+    for (size_t c = first; c < last; ++c)
+      sum += children[c];
+    element[levelOffsets[level] + j] = sum;
+  }
+
+  /**
+   * Find the child of node `j` (of the level above `level`) that contains the
+   * given mass, and subtract the children before it from the mass.  If no
+   * child is large enough (because of rounding), the last nonzero child is
+   * used.
+   */
+  size_t FindChild(const size_t level, const size_t j, T& mass) const
+  {
+    const size_t first = j * Arity;
+    const size_t last = std::min(first + Arity, LevelSize(level));
+    const T* children = element.data() + levelOffsets[level];
+
+    size_t lastNonzero = first;
+    T massBefore = mass;
+    for (size_t c = first; c < last; ++c)
+    {
+      if (children[c] > mass)
+        return c;
+
+      if (children[c] > 0)
       {
-        mass -= element[2 * idx];
-        idx = 2 * idx + 1;
+        lastNonzero = c;
+        massBefore = mass;
       }
+      mass -= children[c];
     }
-    return idx - capacity;
+
+    // Stay at the end of the last nonzero child.
+    mass = std::min(massBefore, children[lastNonzero]);
+    return lastNonzero;
+  }
+
+  /**
+   * Compute the sum of the elements before `end`, by adding up the siblings
+   * to the left of the path from the leaf `end` to the root.
+   */
+  T PrefixSum(size_t end) const
+  {
+    if (end == 0)
+      return T(0);
+
+    T result = 0;
+    for (size_t k = Levels() - 1; k > 0; --k)
+    {
+      const T* nodes = element.data() + levelOffsets[k];
+      const size_t parent = end / Arity;
+      for (size_t c = parent * Arity; c < end; ++c)
+        result += nodes[c];
+      end = parent;
+    }
+
+    // The root itself is included if the whole array is covered.
+    if (end > 0)
+      result += element[0];
+    return result;
   }
 
- private:
   //! The capacity of the data array.
   size_t capacity;
 
-  //! Double size of capacity, maintain the segment sum of data.
+  //! The position of the first node of each level (from the root), followed
+  //! by the total number of nodes.
+  std::vector<size_t> levelOffsets;
+
+  //! The sum of each node of the tree, level by level; the last level holds
+  //! the data array.
   std::vector<T> element;
 };
 
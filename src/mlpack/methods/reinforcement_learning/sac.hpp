@@ -17,6 +17,8 @@
 #include <ensmallen.hpp>
 #include <mlpack/methods/ann/ann.hpp>
 
+#include "environment/vectorized_environment.hpp"
+#include "parallel_rollouts.hpp"
 #include "replay/replay.hpp"
 #include "training_config.hpp"
 
@@ -114,12 +116,55 @@ class SAC
    */
   void SelectAction();
 
+  /**
+   * Select an action for each of the given states, with a single batched
+   * forward pass of the policy network.
+   *
+   * @param states Encoded states, one per column.
+   * @param actions The selected action for each state.
+   */
+  void SelectActions(const arma::mat& states,
+                     std::vector<ActionType>& actions);
+
   /**
    * Execute an episode.
    * @return Return of the episode.
    */
   double Episode();
 
+  /**
+   * Take the given number of steps in every copy of the given vectorized
+   * environment.  At each step, the actions of all the copies are selected
+   * with one batched forward pass (see SelectActions()); each transition is
+   * then stored and trained on as in Episode().  N-step replay can only be
+   * used with a single copy of the environment.
+   *
+   * @param environments Copies of the environment to step in lockstep.
+   * @param steps Number of steps to take in each copy.
+   * @return Returns of the episodes that ended during these steps.
+   */
+  std::vector<double> Steps(
+      VectorizedEnvironment<EnvironmentType>& environments,
+      const size_t steps);
+
+  /**
+   * Train with several actors in parallel (see ParallelRollouts).  Each actor
+   * has its own thread, copy of the environment and copy of the policy
+   * network, and collects transitions while a learner thread keeps training:
+   * it stores each transition and performs the same updates Episode() would,
+   * as soon as they are allowed.  The policy network of the actors is synced
+   * with the trained one every `syncInterval` updates.  N-step replay can only
+   * be used with a single actor.
+   *
+   * @param numActors Number of actors.
+   * @param steps Total number of steps to take over all the actors.
+   * @param syncInterval Number of updates between syncs of the actors.
+   * @return Returns of the episodes completed by the actors.
+   */
+  std::vector<double> ParallelSteps(const size_t numActors,
+                                    const size_t steps,
+                                    const size_t syncInterval = 1);
+
   //! Modify total steps from beginning.
   size_t& TotalSteps() { return totalSteps; }
   //! Get total steps from beginning.
@@ -140,6 +185,14 @@ class SAC
 
 
  private:
+  /**
+   * Select an action for each of the given states with the given copy of the
+   * policy network.
+   */
+  void SelectActions(PolicyNetworkType& network,
+                     const arma::mat& states,
+                     std::vector<ActionType>& actions);
+
   //! Locally-stored hyper-parameters.
   TrainingConfig& config;
 
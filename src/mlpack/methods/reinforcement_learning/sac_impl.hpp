@@ -296,18 +296,69 @@ void SAC<
   ReplayType
 >::SelectAction()
 {
-  // Get the action at current state, from policy.
-  arma::colvec outputAction;
-  policyNetwork.Predict(state.Encode(), outputAction);
+  // Select the action as a batch of one state.
+  std::vector<ActionType> actions;
+  SelectActions(state.Encode(), actions);
+  action = actions[0];
+}
+
+template <
+  typename EnvironmentType,
+  typename QNetworkType,
+  typename PolicyNetworkType,
+  typename UpdaterType,
+  typename ReplayType
+>
+void SAC<
+  EnvironmentType,
+  QNetworkType,
+  PolicyNetworkType,
+  UpdaterType,
+  ReplayType
+>::SelectActions(
+    const arma::mat& states,
+    std::vector<ActionType>& actions)
+{
+  // Select the actions with the trained policy network.
+  SelectActions(policyNetwork, states, actions);
+}
+
+template <
+  typename EnvironmentType,
+  typename QNetworkType,
+  typename PolicyNetworkType,
+  typename UpdaterType,
+  typename ReplayType
+>
+void SAC<
+  EnvironmentType,
+  QNetworkType,
+  PolicyNetworkType,
+  UpdaterType,
+  ReplayType
+>::SelectActions(
+    PolicyNetworkType& network,
+    const arma::mat& states,
+    std::vector<ActionType>& actions)
+{
+  // Get the action for every state from the policy, with one forward pass.
+  arma::mat outputActions;
+  network.Predict(states, outputActions);
 
   if (!deterministic)
   {
-    arma::colvec noise;
-    noise.randn(outputAction.n_rows) * 0.1;
+    arma::mat noise = arma::randn<arma::mat>(outputActions.n_rows,
+        outputActions.n_cols);
     noise = arma::clamp(noise, -0.25, 0.25);
-    outputAction = outputAction + noise;
+    outputActions += noise;
+  }
+
+  actions.resize(outputActions.n_cols);
+  for (size_t i = 0; i < outputActions.n_cols; ++i)
+  {
+    actions[i].action = ConvTo<std::vector<double>>::From(
+        outputActions.col(i));
   }
-  action.action = ConvTo<std::vector<double>>::From(outputAction);
 }
 
 template <
@@ -364,5 +415,123 @@ double SAC<
   return totalReturn;
 }
 
+template <
+  typename EnvironmentType,
+  typename QNetworkType,
+  typename PolicyNetworkType,
+  typename UpdaterType,
+  typename ReplayType
+>
+std::vector<double> SAC<
+  EnvironmentType,
+  QNetworkType,
+  PolicyNetworkType,
+  UpdaterType,
+  ReplayType
+>::Steps(
+    VectorizedEnvironment<EnvironmentType>& environments,
+    const size_t steps)
+{
+  // N-step replay assumes that consecutive transitions are from one episode.
+  if (replayMethod.NSteps() > 1 && environments.NumEnvironments() > 1)
+  {
+    throw std::invalid_argument("SAC::Steps(): n-step replay cannot be used "
+        "with more than one environment!");
+  }
+
+  std::vector<double> returns;
+  arma::mat states;
+  std::vector<ActionType> actions;
+  arma::rowvec rewards;
+  std::vector<StateType> nextStates;
+  arma::irowvec isTerminal;
+  for (size_t s = 0; s < steps; ++s)
+  {
+    // Select the actions of all the environments with one forward pass.
+    environments.Encode(states);
+    SelectActions(states, actions);
+
+    // Step() replaces the current states, so keep them for the replay.
+    const std::vector<StateType> currentStates = environments.States();
+    environments.Step(actions, rewards, nextStates, isTerminal,
+        config.StepLimit());
+    returns.insert(returns.end(), environments.CompletedReturns().begin(),
+        environments.CompletedReturns().end());
+
+    // Store and learn from each transition, as Episode() does.
+    for (size_t i = 0; i < actions.size(); ++i)
+    {
+      totalSteps++;
+      replayMethod.Store(currentStates[i], actions[i], rewards[i],
+          nextStates[i], isTerminal[i] != 0, config.Discount());
+
+      if (deterministic || totalSteps < config.ExplorationSteps())
+        continue;
+      for (size_t j = 0; j < config.UpdateInterval(); j++)
+        Update();
+    }
+  }
+
+  return returns;
+}
+
+template <
+  typename EnvironmentType,
+  typename QNetworkType,
+  typename PolicyNetworkType,
+  typename UpdaterType,
+  typename ReplayType
+>
+std::vector<double> SAC<
+  EnvironmentType,
+  QNetworkType,
+  PolicyNetworkType,
+  UpdaterType,
+  ReplayType
+>::ParallelSteps(
+    const size_t numActors,
+    const size_t steps,
+    const size_t syncInterval)
+{
+  // N-step replay assumes that consecutive transitions are from one episode.
+  if (replayMethod.NSteps() > 1 && numActors > 1)
+  {
+    throw std::invalid_argument("SAC::ParallelSteps(): n-step replay cannot "
+        "be used with more than one actor!");
+  }
+
+  auto selectAction = [&](PolicyNetworkType& network,
+                          const size_t /* actor */,
+                          const StateType& actorState,
+                          ActionType& actorAction)
+  {
+    std::vector<ActionType> actions;
+    SelectActions(network, actorState.Encode(), actions);
+    actorAction = actions[0];
+  };
+
+  // The learner stores each transition, and performs the updates that
+  // Episode() would perform after it.
+  auto store = [&](const StateType& transitionState,
+                   const ActionType& transitionAction,
+                   const double reward,
+                   const StateType& nextState,
+                   const bool isEnd) -> size_t
+  {
+    totalSteps++;
+    replayMethod.Store(transitionState, transitionAction, reward, nextState,
+        isEnd, config.Discount());
+
+    if (deterministic || totalSteps < config.ExplorationSteps())
+      return 0;
+    return config.UpdateInterval();
+  };
+  auto update = [&]() { Update(); };
+
+  ParallelRollouts<EnvironmentType, PolicyNetworkType> rollouts(environment,
+      numActors, config.StepLimit(), syncInterval);
+  return rollouts.Run(policyNetwork, steps, selectAction, store, update);
+}
+
 } // namespace mlpack
 #endif
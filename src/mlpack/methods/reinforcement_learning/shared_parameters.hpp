@@ -0,0 +1,119 @@
+/**
+ * @file methods/reinforcement_learning/shared_parameters.hpp
+ *
+ * Definition of the SharedParameters class, a copy of network parameters
+ * shared between threads.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_SHARED_PARAMETERS_HPP
+#define MLPACK_METHODS_RL_SHARED_PARAMETERS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace mlpack {
+
+/**
+ * The parameters of a network, shared between threads: the target network of
+ * the workers of AsyncLearning, or the policy network of the actors of
+ * `DDPG::ParallelSteps()`.  Each reader keeps its own copy of the network and
+ * only copies the shared parameters again when their version changes.
+ *
+ * Each publication writes the parameters into a new buffer, which is never
+ * modified afterwards, and then swaps the pointer to the latest buffer
+ * atomically.  A reader takes the latest buffer and copies it without any
+ * lock, so it never waits for a publisher and never sees a mix of two
+ * publications; a buffer is freed once the last reader copying it is done.
+ * Publishers hold a mutex, so any number of threads may publish.  Checking
+ * whether anything new was published only reads the atomic version.
+ */
+class SharedParameters
+{
+ public:
+  /**
+   * Create the shared parameters from the given parameters.
+   *
+   * @param parameters The initial parameters of the network.
+   */
+  SharedParameters(const arma::mat& parameters) :
+      latest(std::make_shared<const Buffer>(parameters, 0)),
+      version(0)
+  { }
+
+  /**
+   * Publish new parameters of the network.  Publishers are serialized, so
+   * several threads may call Publish() at the same time.
+   *
+   * @param newParameters The new parameters of the network.
+   */
+  void Publish(const arma::mat& newParameters)
+  {
+    std::lock_guard<std::mutex> lock(publishMutex);
+    const size_t newVersion = version.load(std::memory_order_relaxed) + 1;
+    std::atomic_store(&latest,
+        std::make_shared<const Buffer>(newParameters, newVersion));
+    version.store(newVersion, std::memory_order_release);
+  }
+
+  /**
+   * Copy the latest published parameters into the given matrix, if they are
+   * newer than the given version.
+   *
+   * @param localParameters The parameters of a local copy of the network.
+   * @param knownVersion The version of `localParameters`; it is updated if the
+   *     parameters are copied.
+   * @return Whether the parameters were copied.
+   */
+  bool Update(arma::mat& localParameters, size_t& knownVersion) const
+  {
+    if (version.load(std::memory_order_acquire) == knownVersion)
+      return false;
+
+    // Holding the buffer keeps it alive while it is copied, even if newer
+    // parameters are published meanwhile.  Copy in place, so that the local
+    // network keeps using the same memory.
+    const std::shared_ptr<const Buffer> buffer = std::atomic_load(&latest);
+    std::copy(buffer->parameters.begin(), buffer->parameters.end(),
+        localParameters.begin());
+    knownVersion = buffer->version;
+    return true;
+  }
+
+  //! Get the version of the latest published parameters.
+  size_t Version() const { return version.load(std::memory_order_acquire); }
+
+ private:
+  //! One publication of the parameters, and its version.
+  struct Buffer
+  {
+    Buffer(const arma::mat& parameters, const size_t version) :
+        parameters(parameters),
+        version(version)
+    { }
+
+    //! The published parameters.
+    const arma::mat parameters;
+    //! The version of the parameters.
+    const size_t version;
+  };
+
+  //! The latest publication; only accessed with std::atomic_load() and
+  //! std::atomic_store().
+  std::shared_ptr<const Buffer> latest;
+
+  //! The number of publications so far.
+  std::atomic<size_t> version;
+
+  //! Held while the parameters are published.
+  std::mutex publishMutex;
+};
+
+} // namespace mlpack
+
+#endif
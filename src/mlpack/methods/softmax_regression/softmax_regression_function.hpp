@@ -171,6 +171,34 @@ class SoftmaxRegressionFunction
                        size_t j,
                        GradType& gradient) const;
 
+  /**
+   * Evaluate the objective function and its gradient given the current set of
+   * parameters, in one pass over the data.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param gradient Matrix where gradient values will be stored.
+   * @return The value of the objective function.
+   */
+  template<typename GradType>
+  ElemType EvaluateWithGradient(const DenseMatType& parameters,
+                                GradType& gradient) const;
+
+  /**
+   * Evaluate the objective function and its gradient given the current set of
+   * parameters, on a subset of the data, in one pass over the data.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param start First index of the data points to use.
+   * @param gradient Matrix to store gradient into.
+   * @param batchSize Number of data points to evaluate gradient for.
+   * @return The value of the objective function.
+   */
+  template<typename GradType>
+  ElemType EvaluateWithGradient(const DenseMatType& parameters,
+                                const size_t start,
+                                GradType& gradient,
+                                const size_t batchSize = 1) const;
+
   //! Return the initial point for the optimization.
   const DenseMatType& GetInitialPoint() const { return initialPoint; }
 
@@ -195,7 +223,32 @@ class SoftmaxRegressionFunction
   //! Gets the intercept flag.
   bool FitIntercept() const { return fitIntercept; }
 
+  //! Get the number of points whose class scores are computed at once.
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of points whose class scores are computed at once.
+  size_t& BlockSize() { return blockSize; }
+
  private:
+  /**
+   * Compute the log-likelihood of the labels of the points start to start +
+   * batchSize - 1, and, if gradient is not nullptr, the gradient of the
+   * negative log-likelihood summed over these points (without regularization).
+   * The scores, the softmax and the gradient contribution are computed for
+   * BlockSize() points at a time in one numClasses x BlockSize() workspace,
+   * so the probabilities of all the points are never held in memory.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param start First index of the data points to use.
+   * @param batchSize Number of data points to use.
+   * @param gradient Matrix to store the gradient into, or nullptr.
+   * @return The log-likelihood of the labels of the points.
+   */
+  template<typename GradType>
+  ElemType BlockLogLikelihood(const DenseMatType& parameters,
+                              const size_t start,
+                              const size_t batchSize,
+                              GradType* gradient) const;
+
   //! Training data matrix.  This is an alias until the data is shuffled.
   MatType data;
   //! Label matrix for the provided data.
@@ -208,6 +261,8 @@ class SoftmaxRegressionFunction
   double lambda;
   //! Intercept term flag.
   bool fitIntercept;
+  //! The number of points whose class scores are computed at once.
+  size_t blockSize;
 };
 
 } // namespace mlpack
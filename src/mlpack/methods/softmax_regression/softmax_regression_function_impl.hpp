@@ -25,7 +25,10 @@ inline SoftmaxRegressionFunction<MatType>::SoftmaxRegressionFunction(
     const bool fitIntercept) :
     numClasses(numClasses),
     lambda(lambda),
-    fitIntercept(fitIntercept)
+    fitIntercept(fitIntercept),
+    // Keep the workspace of the class scores to about 2^20 elements.
+    blockSize(std::max((size_t) 1, ((size_t) 1 << 20) /
+        std::max(numClasses, (size_t) 1)))
 {
   MakeAlias(data, dataIn, dataIn.n_rows, dataIn.n_cols, 0, false);
 
@@ -214,14 +217,11 @@ SoftmaxRegressionFunction<MatType>::Evaluate(
   // The sum is calculated over all the classes.
   // x_i is the input vector for a particular training example.
   // theta_j is the parameter vector associated with a particular class.
-  DenseMatType probabilities;
-  GetProbabilitiesMatrix(parameters, probabilities, 0, data.n_cols);
-
-  // Calculate the log likelihood and regularization terms.
+  // They are computed one block of points at a time.
   ElemType logLikelihood, weightDecay, cost;
 
-  logLikelihood = arma::accu(groundTruth % log(probabilities)) /
-                  data.n_cols;
+  logLikelihood = BlockLogLikelihood(parameters, 0, data.n_cols,
+      (DenseMatType*) nullptr) / data.n_cols;
   weightDecay = ((typename MatType::elem_type) 0.5) * lambda *
       arma::accu(parameters % parameters);
 
@@ -243,14 +243,11 @@ SoftmaxRegressionFunction<MatType>::Evaluate(
     const size_t start,
     const size_t batchSize) const
 {
-  MatType probabilities;
-  GetProbabilitiesMatrix(parameters, probabilities, start, batchSize);
-
   // Calculate the log likelihood and regularization terms.
   ElemType logLikelihood, weightDecay;
 
-  logLikelihood = arma::accu(groundTruth.cols(start, start + batchSize - 1) %
-      log(probabilities)) / batchSize;
+  logLikelihood = BlockLogLikelihood(parameters, start, batchSize,
+      (DenseMatType*) nullptr) / batchSize;
   weightDecay = ((typename MatType::elem_type) 0.5) * lambda *
       norm(vectorise(parameters), 2);
 
@@ -272,28 +269,10 @@ inline void SoftmaxRegressionFunction<MatType>::Gradient(
   // The sum is calculated over all the classes.
   // x_i is the input vector for a particular training example.
   // theta_j is the parameter vector associated with a particular class.
-  DenseMatType probabilities;
-  GetProbabilitiesMatrix(parameters, probabilities, 0, data.n_cols);
-
-  // Calculate the parameter gradients.
-  gradient.set_size(parameters.n_rows, parameters.n_cols);
-  if (fitIntercept)
-  {
-    // Treating the intercept term parameters.col(0) seperately to avoid
-    // the cost of building matrix [1; data].
-    DenseMatType inner = probabilities - groundTruth;
-    gradient.col(0) =
-        inner * ones<DenseMatType>(data.n_cols, 1) / data.n_cols +
-        lambda * parameters.col(0);
-    gradient.cols(1, parameters.n_cols - 1) =
-        inner * data.t() / data.n_cols +
-        lambda * parameters.cols(1, parameters.n_cols - 1);
-  }
-  else
-  {
-    gradient = (probabilities - groundTruth) * data.t() / data.n_cols +
-               lambda * parameters;
-  }
+  // The gradient is accumulated one block of points at a time.
+  BlockLogLikelihood(parameters, 0, data.n_cols, &gradient);
+  gradient /= data.n_cols;
+  gradient += lambda * parameters;
 }
 
 template<typename MatType>
@@ -304,28 +283,9 @@ inline void SoftmaxRegressionFunction<MatType>::Gradient(
     GradType& gradient,
     const size_t batchSize) const
 {
-  DenseMatType probabilities;
-  GetProbabilitiesMatrix(parameters, probabilities, start, batchSize);
-
-  // Calculate the parameter gradients.
-  gradient.set_size(parameters.n_rows, parameters.n_cols);
-  if (fitIntercept)
-  {
-    DenseMatType inner = probabilities - groundTruth.cols(start, start +
-        batchSize - 1);
-    gradient.col(0) =
-        inner * ones<DenseMatType>(batchSize, 1) / batchSize +
-        lambda * parameters.col(0);
-    gradient.cols(1, parameters.n_cols - 1) =
-        inner * data.cols(start, start + batchSize - 1).t() / batchSize +
-        lambda * parameters.cols(1, parameters.n_cols - 1);
-  }
-  else
-  {
-    gradient = (probabilities - groundTruth.cols(start, start + batchSize - 1))
-        * data.cols(start, start + batchSize - 1).t() / batchSize
-        + lambda * parameters;
-  }
+  BlockLogLikelihood(parameters, start, batchSize, &gradient);
+  gradient /= batchSize;
+  gradient += lambda * parameters;
 }
 
 template<typename MatType>
@@ -363,6 +323,118 @@ inline void SoftmaxRegressionFunction<MatType>::PartialGradient(
   }
 }
 
+template<typename MatType>
+template<typename GradType>
+inline
+typename SoftmaxRegressionFunction<MatType>::ElemType
+SoftmaxRegressionFunction<MatType>::EvaluateWithGradient(
+    const typename SoftmaxRegressionFunction<MatType>::DenseMatType& parameters,
+    GradType& gradient) const
+{
+  const ElemType logLikelihood = BlockLogLikelihood(parameters, 0,
+      data.n_cols, &gradient) / data.n_cols;
+  gradient /= data.n_cols;
+  gradient += lambda * parameters;
+
+  return -logLikelihood + ((ElemType) 0.5) * lambda *
+      arma::accu(parameters % parameters);
+}
+
+template<typename MatType>
+template<typename GradType>
+inline
+typename SoftmaxRegressionFunction<MatType>::ElemType
+SoftmaxRegressionFunction<MatType>::EvaluateWithGradient(
+    const typename SoftmaxRegressionFunction<MatType>::DenseMatType& parameters,
+    const size_t start,
+    GradType& gradient,
+    const size_t batchSize) const
+{
+  const ElemType logLikelihood = BlockLogLikelihood(parameters, start,
+      batchSize, &gradient) / batchSize;
+  gradient /= batchSize;
+  gradient += lambda * parameters;
+
+  return -logLikelihood + ((ElemType) 0.5) * lambda *
+      norm(vectorise(parameters), 2);
+}
+
+template<typename MatType>
+template<typename GradType>
+inline
+typename SoftmaxRegressionFunction<MatType>::ElemType
+SoftmaxRegressionFunction<MatType>::BlockLogLikelihood(
+    const typename SoftmaxRegressionFunction<MatType>::DenseMatType& parameters,
+    const size_t start,
+    const size_t batchSize,
+    GradType* gradient) const
+{
+  if (gradient != nullptr)
+    gradient->zeros(parameters.n_rows, parameters.n_cols);
+
+  // The workspace holds the scores of the points of a block; they are turned
+  // into the probabilities of the points, and then into the difference
+  // between the probabilities and the ground truth.
+  DenseMatType workspace;
+  ElemType logLikelihood = 0;
+  const size_t end = start + batchSize;
+  for (size_t begin = start; begin < end; begin += blockSize)
+  {
+    const size_t last = std::min(begin + blockSize, end) - 1;
+
+    if (fitIntercept)
+    {
+      // Treating the intercept term parameters.col(0) separately avoids the
+      // cost of building the matrix [1; data].
+      workspace = parameters.cols(1, parameters.n_cols - 1) *
+          data.cols(begin, last);
+      workspace.each_col() += parameters.col(0);
+    }
+    else
+    {
+      workspace = parameters * data.cols(begin, last);
+    }
+
+    for (size_t i = 0; i < workspace.n_cols; ++i)
+    {
+      ElemType* scores = workspace.colptr(i);
+      const size_t label = groundTruth.begin_col(begin + i).row();
+
+      // Subtracting the largest score keeps exp() from overflowing, and the
+      // log-likelihood is computed from the scores so that it cannot underflow.
+      const ElemType maxScore = workspace.col(i).max();
+      const ElemType labelScore = scores[label] - maxScore;
+      ElemType normalizer = 0;
+      for (size_t c = 0; c < numClasses; ++c)
+      {
+        scores[c] = std::exp(scores[c] - maxScore);
+        normalizer += scores[c];
+      }
+      logLikelihood += labelScore - std::log(normalizer);
+
+      for (size_t c = 0; c < numClasses; ++c)
+        scores[c] /= normalizer;
+      scores[label] -= 1;
+    }
+
+    if (gradient != nullptr)
+    {
+      if (fitIntercept)
+      {
+        gradient->col(0) += arma::sum(workspace, 1);
+        gradient->cols(1, parameters.n_cols - 1) += workspace *
+            data.cols(begin, last).t();
+      }
+      else
+      {
+        *gradient += workspace * data.cols(begin, last).t();
+      }
+    }
+  }
+
+  return logLikelihood;
+}
+
 } // namespace mlpack
 
 #endif
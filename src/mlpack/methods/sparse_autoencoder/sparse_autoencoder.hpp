@@ -44,9 +44,15 @@ namespace mlpack {
  * const size_t numIterations = 100; // Maximum number of iterations.
  *
  * // Use an instantiated optimizer for the training.
- * SparseAutoencoderFunction saf(data, vSize, hSize);
- * L_BFGS<SparseAutoencoderFunction> optimizer(saf, numBasis, numIterations);
- * SparseAutoencoder<L_BFGS> encoder2(optimizer);
+ * ens::L_BFGS optimizer(numBasis, numIterations);
+ * SparseAutoencoder encoder2(data, vSize, hSize, 0.0001, 3, 0.01, optimizer);
+ *
+ * // The objective is separable, so a mini-batch optimizer can be used too;
+ * // this trains on float data with batches of 256 points.
+ * arma::fmat fdata = arma::conv_to<arma::fmat>::from(data);
+ * ens::Adam adam(0.001, 256, 0.9, 0.999, 1e-8, 10 * fdata.n_cols);
+ * SparseAutoencoder<arma::fmat> encoder3(fdata, vSize, hSize, 0.0001, 3, 0.01,
+ *     adam);
  *
  * arma::mat features1, features2; // Matrices for storing new representations.
  *
@@ -58,7 +64,10 @@ namespace mlpack {
  * This implementation allows the use of arbitrary mlpack optimizers via the
  * OptimizerType template parameter.
  *
+ * @tparam MatType Type of the data and of the parameters, such as arma::mat or
+ *     arma::fmat.
  */
+template<typename MatType = arma::mat>
 class SparseAutoencoder
 {
  public:
@@ -78,7 +87,7 @@ class SparseAutoencoder
    * @param optimizer Desired optimizer.
    */
   template<typename OptimizerType = ens::L_BFGS>
-  SparseAutoencoder(const arma::mat& data,
+  SparseAutoencoder(const MatType& data,
                     const size_t visibleSize,
                     const size_t hiddenSize,
                     const double lambda = 0.0001,
@@ -105,7 +114,7 @@ class SparseAutoencoder
    *        See https://www.ensmallen.org/docs.html#callback-documentation.
    */
   template<typename OptimizerType, typename... CallbackTypes>
-  SparseAutoencoder(const arma::mat& data,
+  SparseAutoencoder(const MatType& data,
                     const size_t visibleSize,
                     const size_t hiddenSize,
                     const double lambda,
@@ -122,7 +131,7 @@ class SparseAutoencoder
    * @param data Matrix of the provided data.
    * @param features The hidden layer representation of the provided data.
    */
-  void GetNewFeatures(arma::mat& data, arma::mat& features);
+  void GetNewFeatures(const MatType& data, MatType& features);
 
   /**
    * Returns the elementwise sigmoid of the passed matrix, where the sigmoid
@@ -131,9 +140,10 @@ class SparseAutoencoder
    * @param x Matrix of real values for which we require the sigmoid activation.
    * @param output Output matrix.
    */
-  void Sigmoid(const arma::mat& x, arma::mat& output) const
+  template<typename InputType>
+  void Sigmoid(const InputType& x, MatType& output) const
   {
-    output = (1.0 / (1 + exp(-x)));
+    output = (1 / (1 + exp(-x)));
   }
 
   //! Sets size of the visible layer.
@@ -198,7 +208,7 @@ class SparseAutoencoder
 
  private:
   //! Parameters after optimization.
-  arma::mat parameters;
+  MatType parameters;
   //! Size of the visible layer.
   size_t visibleSize;
   //! Size of the hidden layer.
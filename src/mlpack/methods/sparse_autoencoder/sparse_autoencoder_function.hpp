@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_SPARSE_AUTOENCODER_SPARSE_AUTOENCODER_FUNCTION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/make_alias.hpp>
 
 namespace mlpack {
 
@@ -21,10 +22,24 @@ namespace mlpack {
  * This is a class for the sparse autoencoder objective function. It can be used
  * to create learning models like self-taught learning, stacked autoencoders,
  * conditional random fields (CRFs), and so forth.
+ *
+ * The objective and its gradient are computed BlockSize() points at a time, so
+ * the activations of all the points are never held in memory, and the blocks
+ * are processed in parallel.  The function is also separable, so it can be
+ * optimized with mini-batch optimizers like ens::SGD or ens::Adam; the
+ * objective of a mini-batch uses the average activations of the hidden layer
+ * over the mini-batch for the KL divergence term.
+ *
+ * @tparam MatType Type of the data and of the parameters, such as arma::mat or
+ *     arma::fmat.
  */
+template<typename MatType = arma::mat>
 class SparseAutoencoderFunction
 {
  public:
+  //! The element type of the data and the parameters.
+  typedef typename MatType::elem_type ElemType;
+
   /**
    * Construct the sparse autoencoder objective function with the given
    * parameters.
@@ -36,7 +51,7 @@ class SparseAutoencoderFunction
    * @param beta KL divergence parameter.
    * @param rho Sparsity parameter.
    */
-  SparseAutoencoderFunction(const arma::mat& data,
+  SparseAutoencoderFunction(const MatType& data,
                             const size_t visibleSize,
                             const size_t hiddenSize,
                             const double lambda = 0.0001,
@@ -44,7 +59,10 @@ class SparseAutoencoderFunction
                             const double rho = 0.01);
 
   //! Initializes the parameters of the model to suitable values.
-  const arma::mat InitializeWeights();
+  const MatType InitializeWeights();
+
+  //! Shuffle the points of the dataset.
+  void Shuffle();
 
   /**
    * Evaluates the objective function of the sparse autoencoder model using the
@@ -56,7 +74,21 @@ class SparseAutoencoderFunction
    *
    * @param parameters Current values of the model parameters.
    */
-  double Evaluate(const arma::mat& parameters) const;
+  ElemType Evaluate(const MatType& parameters) const;
+
+  /**
+   * Evaluates the objective function of the sparse autoencoder model on the
+   * points from start to start + batchSize - 1, with the same terms as above;
+   * the reconstruction error and the average activations are computed over
+   * these points only.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param start First index of the data points to use.
+   * @param batchSize Number of data points to use.
+   */
+  ElemType Evaluate(const MatType& parameters,
+                    const size_t start,
+                    const size_t batchSize = 1) const;
 
   /**
    * Evaluates the gradient values of the objective function given the current
@@ -67,7 +99,48 @@ class SparseAutoencoderFunction
    * @param parameters Current values of the model parameters.
    * @param gradient Matrix where gradient values will be stored.
    */
-  void Gradient(const arma::mat& parameters, arma::mat& gradient) const;
+  void Gradient(const MatType& parameters, MatType& gradient) const;
+
+  /**
+   * Evaluates the gradient of the objective function on the points from start
+   * to start + batchSize - 1.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param start First index of the data points to use.
+   * @param gradient Matrix where gradient values will be stored.
+   * @param batchSize Number of data points to use.
+   */
+  void Gradient(const MatType& parameters,
+                const size_t start,
+                MatType& gradient,
+                const size_t batchSize = 1) const;
+
+  /**
+   * Evaluates the objective function and its gradient given the current set of
+   * parameters, sharing the feedforward pass.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param gradient Matrix where gradient values will be stored.
+   */
+  ElemType EvaluateWithGradient(const MatType& parameters,
+                                MatType& gradient) const;
+
+  /**
+   * Evaluates the objective function and its gradient on the points from start
+   * to start + batchSize - 1.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param start First index of the data points to use.
+   * @param gradient Matrix where gradient values will be stored.
+   * @param batchSize Number of data points to use.
+   */
+  ElemType EvaluateWithGradient(const MatType& parameters,
+                                const size_t start,
+                                MatType& gradient,
+                                const size_t batchSize = 1) const;
+
+  //! Return the number of separable functions (the number of data points).
+  size_t NumFunctions() const { return data.n_cols; }
 
   /**
    * Returns the elementwise sigmoid of the passed matrix, where the sigmoid
@@ -76,13 +149,14 @@ class SparseAutoencoderFunction
    * @param x Matrix of real values for which we require the sigmoid activation.
    * @param output Output matrix.
    */
-  void Sigmoid(const arma::mat& x, arma::mat& output) const
+  template<typename InputType>
+  void Sigmoid(const InputType& x, MatType& output) const
   {
-    output = (1.0 / (1 + exp(-x)));
+    output = (1 / (1 + exp(-x)));
   }
 
   //! Return the initial point for the optimization.
-  const arma::mat& GetInitialPoint() const { return initialPoint; }
+  const MatType& GetInitialPoint() const { return initialPoint; }
 
   //! Sets size of the visible layer.
   void VisibleSize(const size_t visible)
@@ -144,11 +218,45 @@ class SparseAutoencoderFunction
     return rho;
   }
 
+  //! Get the number of points whose activations are computed at once.
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of points whose activations are computed at once.
+  size_t& BlockSize() { return blockSize; }
+
  private:
-  //! The matrix of data points.
-  const arma::mat& data;
+  /**
+   * Compute the objective on the points from start to start + batchSize - 1,
+   * and, if gradient is not nullptr, its gradient.  The activations are
+   * computed for BlockSize() points at a time; a fixed number of workspaces
+   * each handle every few blocks in parallel, and their sums are merged in
+   * order, so the results don't depend on the number of threads.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param start First index of the data points to use.
+   * @param batchSize Number of data points to use.
+   * @param gradient Matrix to store the gradient into, or nullptr.
+   * @return The objective on the points.
+   */
+  ElemType BlockObjective(const MatType& parameters,
+                          const size_t start,
+                          const size_t batchSize,
+                          MatType* gradient) const;
+
+  //! Compute the hidden layer activations of the given points.
+  template<typename InputType>
+  void HiddenActivations(const MatType& parameters,
+                         const InputType& points,
+                         MatType& hidden) const;
+
+  //! Compute the output layer activations from the hidden layer activations.
+  void OutputActivations(const MatType& parameters,
+                         const MatType& hidden,
+                         MatType& output) const;
+
+  //! The matrix of data points.  This is an alias until the data is shuffled.
+  MatType data;
   //! Initial parameter vector.
-  arma::mat initialPoint;
+  MatType initialPoint;
   //! Size of the visible layer.
   size_t visibleSize;
   //! Size of the hidden layer.
@@ -159,6 +267,8 @@ class SparseAutoencoderFunction
   double beta;
   //! Sparsity parameter.
   double rho;
+  //! The number of points whose activations are computed at once.
+  size_t blockSize;
 };
 
 } // namespace mlpack
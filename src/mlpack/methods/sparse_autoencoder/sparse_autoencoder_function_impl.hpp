@@ -16,20 +16,23 @@
 
 namespace mlpack {
 
-inline SparseAutoencoderFunction::SparseAutoencoderFunction(
-    const arma::mat& data,
+template<typename MatType>
+inline SparseAutoencoderFunction<MatType>::SparseAutoencoderFunction(
+    const MatType& dataIn,
     const size_t visibleSize,
     const size_t hiddenSize,
     const double lambda,
     const double beta,
     const double rho) :
-    data(data),
     visibleSize(visibleSize),
     hiddenSize(hiddenSize),
     lambda(lambda),
     beta(beta),
-    rho(rho)
+    rho(rho),
+    blockSize(256)
 {
+  MakeAlias(data, dataIn, dataIn.n_rows, dataIn.n_cols, 0, false);
+
   // Initialize the parameters to suitable values.
   initialPoint = InitializeWeights();
 }
@@ -39,7 +42,8 @@ inline SparseAutoencoderFunction::SparseAutoencoderFunction(
   * [-r, r] where 'r' is decided using the sizes of the visible and hidden
   * layers. The biases b1, b2 are initialized to 0.
   */
-inline const arma::mat SparseAutoencoderFunction::InitializeWeights()
+template<typename MatType>
+inline const MatType SparseAutoencoderFunction<MatType>::InitializeWeights()
 {
   // The module uses a matrix to store the parameters, its structure looks like:
   //          vSize   1
@@ -57,14 +61,15 @@ inline const arma::mat SparseAutoencoderFunction::InitializeWeights()
 
   // Initialize w1 and w2 to random values in the range [0, 1], then set b1 and
   // b2 to 0.
-  arma::mat parameters;
+  MatType parameters;
   parameters.randu(2 * hiddenSize + 1, visibleSize + 1);
   parameters.row(2 * hiddenSize).zeros();
   parameters.col(visibleSize).zeros();
 
   // Decide the parameter 'r' depending on the size of the visible and hidden
   // layers. The formula used is r = sqrt(6) / sqrt(vSize + hSize + 1).
-  const double range = std::sqrt(6) / std::sqrt(visibleSize + hiddenSize + 1);
+  const ElemType range = std::sqrt(6) /
+      std::sqrt(visibleSize + hiddenSize + 1);
 
   // Shift range of w1 and w2 values from [0, 1] to [-r, r].
   parameters.submat(0, 0, 2 * hiddenSize - 1, visibleSize - 1) = 2 * range *
@@ -73,10 +78,113 @@ inline const arma::mat SparseAutoencoderFunction::InitializeWeights()
   return parameters;
 }
 
+/**
+ * Shuffle the data.
+ */
+template<typename MatType>
+inline void SparseAutoencoderFunction<MatType>::Shuffle()
+{
+  const arma::uvec ordering = arma::randperm(data.n_cols);
+  MatType newData = data.cols(ordering);
+  ClearAlias(data);
+  data = std::move(newData);
+}
+
 /** Evaluates the objective function given the parameters.
   */
-inline double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters)
-    const
+template<typename MatType>
+inline typename MatType::elem_type
+SparseAutoencoderFunction<MatType>::Evaluate(const MatType& parameters) const
+{
+  return BlockObjective(parameters, 0, data.n_cols, nullptr);
+}
+
+template<typename MatType>
+inline typename MatType::elem_type
+SparseAutoencoderFunction<MatType>::Evaluate(const MatType& parameters,
+                                             const size_t start,
+                                             const size_t batchSize) const
+{
+  return BlockObjective(parameters, start, batchSize, nullptr);
+}
+
+/** Calculates and stores the gradient values given a set of parameters.
+  */
+template<typename MatType>
+inline void SparseAutoencoderFunction<MatType>::Gradient(
+    const MatType& parameters,
+    MatType& gradient) const
+{
+  BlockObjective(parameters, 0, data.n_cols, &gradient);
+}
+
+template<typename MatType>
+inline void SparseAutoencoderFunction<MatType>::Gradient(
+    const MatType& parameters,
+    const size_t start,
+    MatType& gradient,
+    const size_t batchSize) const
+{
+  BlockObjective(parameters, start, batchSize, &gradient);
+}
+
+template<typename MatType>
+inline typename MatType::elem_type
+SparseAutoencoderFunction<MatType>::EvaluateWithGradient(
+    const MatType& parameters,
+    MatType& gradient) const
+{
+  return BlockObjective(parameters, 0, data.n_cols, &gradient);
+}
+
+template<typename MatType>
+inline typename MatType::elem_type
+SparseAutoencoderFunction<MatType>::EvaluateWithGradient(
+    const MatType& parameters,
+    const size_t start,
+    MatType& gradient,
+    const size_t batchSize) const
+{
+  return BlockObjective(parameters, start, batchSize, &gradient);
+}
+
+template<typename MatType>
+template<typename InputType>
+inline void SparseAutoencoderFunction<MatType>::HiddenActivations(
+    const MatType& parameters,
+    const InputType& points,
+    MatType& hidden) const
+{
+  // w1 <- parameters.submat(0, 0, l1-1, l2-1)
+  // b1 <- parameters.submat(0, l2, l1-1, l2)
+  hidden = parameters.submat(0, 0, hiddenSize - 1, visibleSize - 1) * points;
+  hidden.each_col() += parameters.submat(0, visibleSize, hiddenSize - 1,
+      visibleSize);
+  Sigmoid(hidden, hidden);
+}
+
+template<typename MatType>
+inline void SparseAutoencoderFunction<MatType>::OutputActivations(
+    const MatType& parameters,
+    const MatType& hidden,
+    MatType& output) const
+{
+  // w2 <- parameters.submat(l1, 0, l3-1, l2-1).t()
+  // b2 <- parameters.submat(l3, 0, l3, l2-1).t()
+  output = parameters.submat(hiddenSize, 0, 2 * hiddenSize - 1,
+      visibleSize - 1).t() * hidden;
+  output.each_col() += parameters.submat(2 * hiddenSize, 0, 2 * hiddenSize,
+      visibleSize - 1).t();
+  Sigmoid(output, output);
+}
+
+template<typename MatType>
+inline typename MatType::elem_type
+SparseAutoencoderFunction<MatType>::BlockObjective(
+    const MatType& parameters,
+    const size_t start,
+    const size_t batchSize,
+    MatType* gradient) const
 {
   // The objective function is the average squared reconstruction error of the
   // network. w1 and b1 are the weights and biases associated with the hidden
@@ -91,39 +199,107 @@ inline double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters)
   const size_t l2 = visibleSize;
   const size_t l3 = 2 * hiddenSize;
 
-  // w1, w2, b1 and b2 are not extracted separately, 'parameters' is directly
-  // used in their place to avoid copying data. The following representations
-  // are used:
-  // w1 <- parameters.submat(0, 0, l1-1, l2-1)
-  // w2 <- parameters.submat(l1, 0, l3-1, l2-1).t()
-  // b1 <- parameters.submat(0, l2, l1-1, l2)
-  // b2 <- parameters.submat(l3, 0, l3, l2-1).t()
-
-  arma::mat hiddenLayer, outputLayer;
-
-  // Compute activations of the hidden and output layers.
-  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * data +
-      repmat(parameters.submat(0, l2, l1 - 1, l2), 1, data.n_cols),
-      hiddenLayer);
-
-  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
-      repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, data.n_cols),
-      outputLayer);
-
-  arma::mat rhoCap, diff;
+  // Workspace s handles the blocks s, s + numSlots, s + 2 * numSlots, and so
+  // on.  The number of workspaces is fixed, so that the sums are the same for
+  // any number of threads.
+  const size_t maxSlots = 16;
+  const size_t end = start + batchSize;
+  const size_t numBlocks = (batchSize + blockSize - 1) / blockSize;
+  const size_t numSlots = std::max(std::min(numBlocks, maxSlots), (size_t) 1);
+
+  std::vector<MatType> hidden(numSlots), output(numSlots);
+  MatType hiddenSums(l1, numSlots, arma::fill::zeros);
+  arma::Col<ElemType> errors(numSlots, arma::fill::zeros);
+
+  // The KL divergence term depends on the average activations of the hidden
+  // layer over all the points, so they are computed first.  Without the
+  // gradient, the reconstruction error is computed in the same pass; with the
+  // gradient, the hidden layer is computed again in the second pass, which is
+  // cheaper than keeping the activations of all the points.
+  #pragma omp parallel for schedule(static)
+  for (size_t s = 0; s < numSlots; ++s)
+  {
+    for (size_t b = s; b < numBlocks; b += numSlots)
+    {
+      const size_t begin = start + b * blockSize;
+      const size_t last = std::min(begin + blockSize, end) - 1;
+
+      HiddenActivations(parameters, data.cols(begin, last), hidden[s]);
+      hiddenSums.col(s) += arma::sum(hidden[s], 1);
+
+      if (gradient == nullptr)
+      {
+        OutputActivations(parameters, hidden[s], output[s]);
+        errors[s] += arma::accu(arma::square(output[s] -
+            data.cols(begin, last)));
+      }
+    }
+  }
 
   // Average activations of the hidden layer.
-  rhoCap = sum(hiddenLayer, 1) / data.n_cols;
-  // Difference between the reconstructed data and the original data.
-  diff = outputLayer - data;
-
-  double wL2SquaredNorm;
+  const arma::Col<ElemType> rhoCap = arma::sum(hiddenSums, 1) / batchSize;
+
+  if (gradient != nullptr)
+  {
+    // The delta vector for the output layer is given by diff * f'(z), where z
+    // is the preactivation and f is the activation function. The derivative of
+    // the sigmoid function turns out to be f(z) * (1 - f(z)). For every other
+    // layer in the neural network which comes before the output layer, the
+    // delta values are given del_n = w_n' * del_(n+1) * f'(z_n). Since our cost
+    // function also includes the KL divergence term, we adjust for that in the
+    // formula below.
+    const arma::Col<ElemType> klDivGrad = beta * (-(rho / rhoCap) +
+        (1 - rho) / (1 - rhoCap));
+
+    std::vector<MatType> delOut(numSlots), delHid(numSlots),
+        gradients(numSlots);
+    #pragma omp parallel for schedule(static)
+    for (size_t s = 0; s < numSlots; ++s)
+    {
+      gradients[s].zeros(arma::size(parameters));
+      for (size_t b = s; b < numBlocks; b += numSlots)
+      {
+        const size_t begin = start + b * blockSize;
+        const size_t last = std::min(begin + blockSize, end) - 1;
+
+        HiddenActivations(parameters, data.cols(begin, last), hidden[s]);
+        OutputActivations(parameters, hidden[s], output[s]);
+
+        // Difference between the reconstructed data and the original data.
+        delOut[s] = output[s] - data.cols(begin, last);
+        errors[s] += arma::accu(arma::square(delOut[s]));
+
+        delOut[s] %= output[s] % (1 - output[s]);
+        delHid[s] = parameters.submat(l1, 0, l3 - 1, l2 - 1) * delOut[s];
+        delHid[s].each_col() += klDivGrad;
+        delHid[s] %= hidden[s] % (1 - hidden[s]);
+
+        // Compute the gradient values using the activations and the delta
+        // values.
+        gradients[s].submat(0, 0, l1 - 1, l2 - 1) += delHid[s] *
+            data.cols(begin, last).t();
+        gradients[s].submat(l1, 0, l3 - 1, l2 - 1) += hidden[s] *
+            delOut[s].t();
+        gradients[s].submat(0, l2, l1 - 1, l2) += arma::sum(delHid[s], 1);
+        gradients[s].submat(l3, 0, l3, l2 - 1) +=
+            arma::sum(delOut[s], 1).t();
+      }
+    }
+
+    // Merge the sums of the workspaces in order, then add the regularization
+    // terms.
+    *gradient = std::move(gradients[0]);
+    for (size_t s = 1; s < numSlots; ++s)
+      *gradient += gradients[s];
+    *gradient /= batchSize;
+
+    gradient->submat(0, 0, l3 - 1, l2 - 1) += lambda *
+        parameters.submat(0, 0, l3 - 1, l2 - 1);
+  }
 
   // Calculate squared L2-norms of w1 and w2.
-  wL2SquaredNorm = accu(parameters.submat(0, 0, l3 - 1, l2 - 1) %
-      parameters.submat(0, 0, l3 - 1, l2 - 1));
-
-  double sumOfSquaresError, weightDecay, klDivergence, cost;
+  const ElemType wL2SquaredNorm = arma::accu(arma::square(
+      parameters.submat(0, 0, l3 - 1, l2 - 1)));
 
   // Calculate the reconstruction error, the regularization cost and the KL
   // divergence cost terms. 'sumOfSquaresError' is the average squared l2-norm
@@ -131,85 +307,13 @@ inline double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters)
   // of the weights w1 and w2. 'klDivergence' is the cost of the hidden layer
   // activations not being low. It is given by the following formula:
   // KL = sum_over_hSize(rho*log(rho/rhoCaq) + (1-rho)*log((1-rho)/(1-rhoCap)))
-  sumOfSquaresError = 0.5 * accu(diff % diff) / data.n_cols;
-  weightDecay = 0.5 * lambda * wL2SquaredNorm;
-  klDivergence = beta * accu(rho * log(rho / rhoCap) + (1 - rho) *
-      log((1 - rho) / (1 - rhoCap)));
+  const ElemType sumOfSquaresError = 0.5 * arma::accu(errors) / batchSize;
+  const ElemType weightDecay = 0.5 * lambda * wL2SquaredNorm;
+  const ElemType klDivergence = beta * arma::accu(rho * log(rho / rhoCap) +
+      (1 - rho) * log((1 - rho) / (1 - rhoCap)));
 
   // The cost is the sum of the terms calculated above.
-  cost = sumOfSquaresError + weightDecay + klDivergence;
-
-  return cost;
-}
-
-/** Calculates and stores the gradient values given a set of parameters.
-  */
-inline void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
-                                                arma::mat& gradient) const
-{
-  // Performs a feedforward pass of the neural network, and computes the
-  // activations of the output layer as in the Evaluate() method. It uses the
-  // Backpropagation algorithm to calculate the delta values at each layer,
-  // except for the input layer. The delta values are then used with input layer
-  // and hidden layer activations to get the parameter gradients.
-
-  // Compute the limits for the parameters w1, w2, b1 and b2.
-  const size_t l1 = hiddenSize;
-  const size_t l2 = visibleSize;
-  const size_t l3 = 2 * hiddenSize;
-
-  // w1, w2, b1 and b2 are not extracted separately, 'parameters' is directly
-  // used in their place to avoid copying data. The following representations
-  // are used:
-  // w1 <- parameters.submat(0, 0, l1-1, l2-1)
-  // w2 <- parameters.submat(l1, 0, l3-1, l2-1).t()
-  // b1 <- parameters.submat(0, l2, l1-1, l2)
-  // b2 <- parameters.submat(l3, 0, l3, l2-1).t()
-
-  arma::mat hiddenLayer, outputLayer;
-
-  // Compute activations of the hidden and output layers.
-  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * data +
-      repmat(parameters.submat(0, l2, l1 - 1, l2), 1, data.n_cols),
-      hiddenLayer);
-
-  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
-      repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, data.n_cols),
-      outputLayer);
-
-  arma::mat rhoCap, diff;
-
-  // Average activations of the hidden layer.
-  rhoCap = sum(hiddenLayer, 1) / data.n_cols;
-  // Difference between the reconstructed data and the original data.
-  diff = outputLayer - data;
-
-  arma::mat klDivGrad, delOut, delHid;
-
-  // The delta vector for the output layer is given by diff * f'(z), where z is
-  // the preactivation and f is the activation function. The derivative of the
-  // sigmoid function turns out to be f(z) * (1 - f(z)). For every other layer
-  // in the neural network which comes before the output layer, the delta values
-  // are given del_n = w_n' * del_(n+1) * f'(z_n). Since our cost function also
-  // includes the KL divergence term, we adjust for that in the formula below.
-  klDivGrad = beta * (-(rho / rhoCap) + (1 - rho) / (1 - rhoCap));
-  delOut = diff % outputLayer % (1 - outputLayer);
-  delHid = (parameters.submat(l1, 0, l3 - 1, l2 - 1) * delOut +
-      repmat(klDivGrad, 1, data.n_cols)) % hiddenLayer %
-      (1 - hiddenLayer);
-
-  gradient.zeros(2 * hiddenSize + 1, visibleSize + 1);
-
-  // Compute the gradient values using the activations and the delta values. The
-  // formula also accounts for the regularization terms in the objective.
-  // function.
-  gradient.submat(0, 0, l1 - 1, l2 - 1) = delHid * data.t() / data.n_cols +
-      lambda * parameters.submat(0, 0, l1 - 1, l2 - 1);
-  gradient.submat(l1, 0, l3 - 1, l2 - 1) =
-      (delOut * hiddenLayer.t() / data.n_cols +
-      lambda * parameters.submat(l1, 0, l3 - 1, l2 - 1).t()).t();
-  gradient.submat(0, l2, l1 - 1, l2) = sum(delHid, 1) / data.n_cols;
-  gradient.submat(l3, 0, l3, l2 - 1) = (sum(delOut, 1) / data.n_cols).t();
+  return sumOfSquaresError + weightDecay + klDivergence;
 }
 
 } // namespace mlpack
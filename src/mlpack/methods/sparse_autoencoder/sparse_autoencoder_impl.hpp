@@ -17,22 +17,23 @@
 
 namespace mlpack {
 
+template<typename MatType>
 template<typename OptimizerType>
-SparseAutoencoder::SparseAutoencoder(const arma::mat& data,
-                                     const size_t visibleSize,
-                                     const size_t hiddenSize,
-                                     double lambda,
-                                     double beta,
-                                     double rho,
-                                     OptimizerType optimizer) :
+SparseAutoencoder<MatType>::SparseAutoencoder(const MatType& data,
+                                              const size_t visibleSize,
+                                              const size_t hiddenSize,
+                                              double lambda,
+                                              double beta,
+                                              double rho,
+                                              OptimizerType optimizer) :
     visibleSize(visibleSize),
     hiddenSize(hiddenSize),
     lambda(lambda),
     beta(beta),
     rho(rho)
 {
-  SparseAutoencoderFunction encoderFunction(data, visibleSize, hiddenSize,
-                                            lambda, beta, rho);
+  SparseAutoencoderFunction<MatType> encoderFunction(data, visibleSize,
+      hiddenSize, lambda, beta, rho);
 
   parameters = encoderFunction.GetInitialPoint();
 
@@ -43,23 +44,24 @@ SparseAutoencoder::SparseAutoencoder(const arma::mat& data,
       << "trained model is " << out << "." << std::endl;
 }
 
+template<typename MatType>
 template<typename OptimizerType, typename... CallbackTypes>
-SparseAutoencoder::SparseAutoencoder(const arma::mat& data,
-                                     const size_t visibleSize,
-                                     const size_t hiddenSize,
-                                     double lambda,
-                                     double beta,
-                                     double rho,
-                                     OptimizerType optimizer,
-                                     CallbackTypes&&... callbacks) :
+SparseAutoencoder<MatType>::SparseAutoencoder(const MatType& data,
+                                              const size_t visibleSize,
+                                              const size_t hiddenSize,
+                                              double lambda,
+                                              double beta,
+                                              double rho,
+                                              OptimizerType optimizer,
+                                              CallbackTypes&&... callbacks) :
     visibleSize(visibleSize),
     hiddenSize(hiddenSize),
     lambda(lambda),
     beta(beta),
     rho(rho)
 {
-  SparseAutoencoderFunction encoderFunction(data, visibleSize, hiddenSize,
-                                            lambda, beta, rho);
+  SparseAutoencoderFunction<MatType> encoderFunction(data, visibleSize,
+      hiddenSize, lambda, beta, rho);
 
   parameters = encoderFunction.GetInitialPoint();
 
@@ -71,8 +73,9 @@ SparseAutoencoder::SparseAutoencoder(const arma::mat& data,
       << "trained model is " << out << "." << std::endl;
 }
 
-inline void SparseAutoencoder::GetNewFeatures(arma::mat& data,
-                                              arma::mat& features)
+template<typename MatType>
+inline void SparseAutoencoder<MatType>::GetNewFeatures(const MatType& data,
+                                                       MatType& features)
 {
   const size_t l1 = hiddenSize;
   const size_t l2 = visibleSize;
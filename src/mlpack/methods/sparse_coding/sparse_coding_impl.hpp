@@ -65,26 +65,13 @@ inline void SparseCoding<MatType>::Encode(const MatType& data,
   // lambda2 > 0.
   MatType matGram = trans(dictionary) * dictionary;
 
-  codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
-  {
-    // Report progress.
-    if ((i % 100) == 0)
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
-
-    bool useCholesky = true;
-    // Intercept fitting and data normalization is disabled.
-    LARS<MatType> lars(useCholesky, lambda1, lambda2,
-        1e-16 /* default tolerance */, false, false);
-
-    // Create an alias of the code (using the same memory), and then LARS will
-    // place the result directly into that; then we will not need to have an
-    // extra copy.
-    ColType code = codes.unsafe_col(i);
-    RowType responses = data.unsafe_col(i).t();
-    lars.Train(dictionary, responses, false, useCholesky, matGram);
-    code = lars.Beta();
-  }
+  // Each point is the target of one LARS problem against the dictionary (which
+  // is in row-major form for LARS); they are all solved with the same Gram
+  // matrix, in parallel.  Intercept fitting and data normalization are
+  // disabled.
+  LARS<MatType> lars(true, lambda1, lambda2, 1e-16 /* default tolerance */,
+      false, false);
+  lars.SolveBatch(dictionary, data, codes, false, matGram);
 }
 
 // Dictionary step for optimization.
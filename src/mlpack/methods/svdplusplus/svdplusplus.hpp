@@ -128,6 +128,29 @@ class SVDPlusPlus
              arma::vec& q,
              arma::mat& y);
 
+  /**
+   * Trains the model and obtains user/item matrices, user/item bias, and
+   * item implicit matrix, using the provided rating triples directly (without
+   * conversion to double precision).  Whether a user rates an item is used as
+   * implicit feedback.
+   *
+   * @param data Rating triples (possibly memory-mapped).
+   * @param rank Rank parameter to be used for optimization.
+   * @param u Item matrix obtained on decomposition.
+   * @param v User matrix obtained on decomposition.
+   * @param p Item bias.
+   * @param q User bias.
+   * @param y Item matrix with respect to implicit feedback. Each column is a
+   *     latent vector of an item with respect to implicit feedback.
+   */
+  void Apply(const data::RatingTriples& data,
+             const size_t rank,
+             arma::mat& u,
+             arma::mat& v,
+             arma::vec& p,
+             arma::vec& q,
+             arma::mat& y);
+
   /**
    * Converts the User, Item matrix of implicit data to Item-User Table.
    */
@@ -136,6 +159,18 @@ class SVDPlusPlus
                         const arma::mat& data);
 
  private:
+  //! Train the model for any type of rating data, with the given Item-User
+  //! table of implicit feedback.
+  template<typename DataType>
+  void ApplyInternal(const DataType& data,
+                     const arma::sp_mat& cleanedData,
+                     const size_t rank,
+                     arma::mat& u,
+                     arma::mat& v,
+                     arma::vec& p,
+                     arma::vec& q,
+                     arma::mat& y);
+
   //! Number of optimization iterations.
   size_t iterations;
   //! Learning rate for the SGD optimizer.
@@ -15,6 +15,7 @@
 #define MLPACK_METHODS_SVDPLUSPLUS_SVDPLUSPLUS_FUNCTION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/rating_triples.hpp>
 #include <ensmallen.hpp>
 
 namespace mlpack {
@@ -24,7 +25,7 @@ namespace mlpack {
  * SVD++'s objective function, to calculate gradient of parameters with
  * respect to the objective function, etc.
  *
- * @tparam MatType The matrix type of the dataset.
+ * @tparam MatType The matrix type of the dataset (or data::RatingTriples).
  */
 template <typename MatType = arma::mat>
 class SVDPlusPlusFunction
@@ -106,7 +107,7 @@ class SVDPlusPlusFunction
   const arma::mat& GetInitialPoint() const { return initialPoint; }
 
   //! Return the dataset passed into the constructor.
-  const arma::mat& Dataset() const { return data; }
+  const MatType& Dataset() const { return data; }
 
   //! Return the implicit data passed into the constructor.
   const arma::sp_mat& ImplicitDataset() const { return implicitData; }
@@ -143,6 +144,21 @@ class SVDPlusPlusFunction
   size_t numItems;
 };
 
+/**
+ * Run the specialized SGD for SVDPlusPlusFunction; this is the body of the
+ * specializations of ens::StandardSGD::Optimize() below, for any dataset type.
+ *
+ * @param function SVDPlusPlusFunction to optimize.
+ * @param parameters Starting point, and resulting parameters.
+ * @param stepSize Step size of SGD.
+ * @param maxIterations Maximum number of iterations (0 means no limit).
+ */
+template<typename MatType>
+double OptimizeSVDPlusPlus(SVDPlusPlusFunction<MatType>& function,
+                           arma::mat& parameters,
+                           const double stepSize,
+                           const size_t maxIterations);
+
 } // namespace mlpack
 
 namespace ens {
@@ -159,6 +175,12 @@ namespace ens {
       mlpack::SVDPlusPlusFunction<arma::mat>& function,
       arma::mat& parameters);
 
+  template <>
+  template <>
+  inline double StandardSGD::Optimize(
+      mlpack::SVDPlusPlusFunction<mlpack::data::RatingTriples>& function,
+      arma::mat& parameters);
+
   template <>
   template <>
   inline double ParallelSGD<ExponentialBackoff>::Optimize(
@@ -28,11 +28,21 @@ SVDPlusPlusFunction<MatType>::SVDPlusPlusFunction(
     rank(rank),
     lambda(lambda)
 {
-  MakeAlias(data, dataIn, dataIn.n_rows, dataIn.n_cols, false);
+  if constexpr (std::is_same<MatType, data::RatingTriples>::value)
+  {
+    // Copies of RatingTriples share the triples.
+    data = dataIn;
+    numUsers = data.NumUsers();
+    numItems = data.NumItems();
+  }
+  else
+  {
+    MakeAlias(data, dataIn, dataIn.n_rows, dataIn.n_cols, false);
 
-  // Number of users and items in the data.
-  numUsers = max(data.row(0)) + 1;
-  numItems = max(data.row(1)) + 1;
+    // Number of users and items in the data.
+    numUsers = max(data.row(0)) + 1;
+    numItems = max(data.row(1)) + 1;
+  }
 
   // Initialize the parameters.
   // Item matrix: submat(0, numUsers, rank - 1, numUsers + numItems - 1).t()
@@ -49,8 +59,15 @@ SVDPlusPlusFunction<MatType>::SVDPlusPlusFunction(
 template<typename MatType>
 void SVDPlusPlusFunction<MatType>::Shuffle()
 {
-  data = data.cols(arma::shuffle(arma::linspace<arma::uvec>(0, data.n_cols - 1,
-      data.n_cols)));
+  if constexpr (std::is_same<MatType, data::RatingTriples>::value)
+  {
+    data.Shuffle();
+  }
+  else
+  {
+    data = data.cols(arma::shuffle(arma::linspace<arma::uvec>(0,
+        data.n_cols - 1, data.n_cols)));
+  }
 }
 
 template <typename MatType>
@@ -285,16 +302,11 @@ void SVDPlusPlusFunction<MatType>::Gradient(const arma::mat& parameters,
   }
 }
 
-} // namespace mlpack
-
-// Template specialization for the SGD optimizer.
-namespace ens {
-
-template <>
-template <>
-double StandardSGD::Optimize(
-    mlpack::SVDPlusPlusFunction<arma::mat>& function,
-    arma::mat& parameters)
+template<typename MatType>
+double OptimizeSVDPlusPlus(SVDPlusPlusFunction<MatType>& function,
+                           arma::mat& parameters,
+                           const double stepSize,
+                           const size_t maxIterations)
 {
   // Find the number of functions to use.
   const size_t numFunctions = function.NumFunctions();
@@ -307,8 +319,8 @@ double StandardSGD::Optimize(
   for (size_t i = 0; i < numFunctions; ++i)
     overallObjective += function.Evaluate(parameters, i);
 
-  const arma::mat data = function.Dataset();
-  const arma::sp_mat implicitData = function.ImplicitDataset();
+  const MatType& data = function.Dataset();
+  const arma::sp_mat& implicitData = function.ImplicitDataset();
   const size_t numUsers = function.NumUsers();
   const size_t numItems = function.NumItems();
   const double lambda = function.Lambda();
@@ -391,6 +403,30 @@ double StandardSGD::Optimize(
   return overallObjective;
 }
 
+} // namespace mlpack
+
+// Template specialization for the SGD optimizer.
+namespace ens {
+
+template <>
+template <>
+inline double StandardSGD::Optimize(
+    mlpack::SVDPlusPlusFunction<arma::mat>& function,
+    arma::mat& parameters)
+{
+  return mlpack::OptimizeSVDPlusPlus(function, parameters, stepSize,
+      maxIterations);
+}
+
+template <>
+template <>
+inline double StandardSGD::Optimize(
+    mlpack::SVDPlusPlusFunction<mlpack::data::RatingTriples>& function,
+    arma::mat& parameters)
+{
+  return mlpack::OptimizeSVDPlusPlus(function, parameters, stepSize,
+      maxIterations);
+}
 
 template <>
 template <>
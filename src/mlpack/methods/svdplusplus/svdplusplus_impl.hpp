@@ -36,6 +36,24 @@ void SVDPlusPlus<OptimizerType>::Apply(const arma::mat& data,
                                        arma::vec& p,
                                        arma::vec& q,
                                        arma::mat& y)
+{
+  // Converts implicitData to the form of sparse matrix.
+  arma::sp_mat cleanedData;
+  CleanData(implicitData, cleanedData, data);
+
+  ApplyInternal(data, cleanedData, rank, u, v, p, q, y);
+}
+
+template<typename OptimizerType>
+template<typename DataType>
+void SVDPlusPlus<OptimizerType>::ApplyInternal(const DataType& data,
+                                               const arma::sp_mat& cleanedData,
+                                               const size_t rank,
+                                               arma::mat& u,
+                                               arma::mat& v,
+                                               arma::vec& p,
+                                               arma::vec& q,
+                                               arma::mat& y)
 {
   // batchSize is 1 in our implementation of SVDPlusPlus.
   // batchSize other than 1 has not been supported yet.
@@ -43,12 +61,8 @@ void SVDPlusPlus<OptimizerType>::Apply(const arma::mat& data,
   Log::Warn << "The batch size for optimizing SVDPlusPlus is 1."
       << std::endl;
 
-  // Converts implicitData to the form of sparse matrix.
-  arma::sp_mat cleanedData;
-  CleanData(implicitData, cleanedData, data);
-
   // Make the optimizer object using a SVDPlusPlusFunction object.
-  SVDPlusPlusFunction<arma::mat> svdPPFunc(data, cleanedData, rank, lambda);
+  SVDPlusPlusFunction<DataType> svdPPFunc(data, cleanedData, rank, lambda);
   ens::StandardSGD optimizer(alpha, batchSize,
       iterations * data.n_cols);
 
@@ -57,8 +71,8 @@ void SVDPlusPlus<OptimizerType>::Apply(const arma::mat& data,
   optimizer.Optimize(svdPPFunc, parameters);
 
   // Constants for extracting user and item matrices.
-  const size_t numUsers = max(data.row(0)) + 1;
-  const size_t numItems = max(data.row(1)) + 1;
+  const size_t numUsers = svdPPFunc.NumUsers();
+  const size_t numItems = svdPPFunc.NumItems();
 
   // Extract user and item matrices, user and item bias, item implicit matrix
   // from the optimized parameters.
@@ -85,6 +99,30 @@ void SVDPlusPlus<OptimizerType>::Apply(const arma::mat& data,
   Apply(data, implicitData, rank, u, v, p, q, y);
 }
 
+// Use whether a user rates an item as binary implicit data, building the
+// Item-User table directly from the triples.
+template<typename OptimizerType>
+void SVDPlusPlus<OptimizerType>::Apply(const data::RatingTriples& data,
+                                       const size_t rank,
+                                       arma::mat& u,
+                                       arma::mat& v,
+                                       arma::vec& p,
+                                       arma::vec& q,
+                                       arma::mat& y)
+{
+  arma::umat locations(2, data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    // Items are rows, and users are columns.
+    locations(0, i) = data.Item(i);
+    locations(1, i) = data.User(i);
+  }
+
+  const arma::sp_mat cleanedData(locations, arma::ones<arma::vec>(data.n_cols),
+      data.NumItems(), data.NumUsers());
+  ApplyInternal(data, cleanedData, rank, u, v, p, q, y);
+}
+
 template<typename OptimizerType>
 void SVDPlusPlus<OptimizerType>::CleanData(const arma::mat& implicitData,
                                            arma::sp_mat& cleanedData,
@@ -0,0 +1,129 @@
+/**
+ * @file methods/xgboost/loss_functions/logistic_loss.hpp
+ *
+ * The logistic loss class, which is a loss function for gradient boosted
+ * trees for two-class classification.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_LOSS_FUNCTIONS_LOGISTIC_LOSS_HPP
+#define MLPACK_METHODS_XGBOOST_LOSS_FUNCTIONS_LOGISTIC_LOSS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * The logistic loss is the negative log-likelihood of two-class labels (0 or
+ * 1) when the probability of class 1 is the logistic sigmoid of the score:
+ *
+ * Loss = -y * log(p) - (1 - y) * log(1 - p),  p = 1 / (1 + exp(-score)).
+ *
+ * Its gradient with respect to the score is p - y, and its hessian is
+ * p * (1 - p).
+ */
+class LogisticLoss
+{
+ public:
+  //! The smallest hessian given for a point, so that leaf values stay finite.
+  static constexpr double MinHessian = 1e-16;
+
+  //! Get the number of scores the boosting model computes for each point.
+  size_t NumOutputs() const { return 1; }
+
+  /**
+   * Compute the initial score of the boosting model: the log-odds of class 1
+   * in the training labels.  An exception is thrown if a label is not 0 or 1.
+   *
+   * @param responses Labels of the training points.
+   * @param scores Will hold the initial score.
+   */
+  void InitialScores(const arma::rowvec& responses, arma::vec& scores) const
+  {
+    for (size_t i = 0; i < responses.n_elem; ++i)
+    {
+      if (responses[i] != 0.0 && responses[i] != 1.0)
+      {
+        throw std::invalid_argument("LogisticLoss::InitialScores(): labels "
+            "must be 0 or 1!");
+      }
+    }
+
+    const double p = (responses.n_elem == 0) ? 0.5 :
+        std::min(std::max(arma::mean(responses), 1e-6), 1.0 - 1e-6);
+    scores.set_size(1);
+    scores[0] = std::log(p / (1.0 - p));
+  }
+
+  /**
+   * Compute the gradients and hessians of the loss with respect to the scores
+   * of each point.
+   *
+   * @param responses Labels of the points.
+   * @param scores Current scores of the points.
+   * @param gradients Will hold the gradient for each point.
+   * @param hessians Will hold the hessian for each point.
+   */
+  void Gradients(const arma::rowvec& responses,
+                 const arma::mat& scores,
+                 arma::mat& gradients,
+                 arma::mat& hessians) const
+  {
+    const arma::rowvec p = 1.0 / (1.0 + arma::exp(-scores.row(0)));
+    gradients = p - responses;
+    hessians = arma::clamp(p % (1.0 - p), MinHessian, 1.0);
+  }
+
+  /**
+   * Turn the scores into the probability of class 1 for each point.
+   */
+  void Transform(const arma::mat& scores, arma::mat& predictions) const
+  {
+    predictions = 1.0 / (1.0 + arma::exp(-scores));
+  }
+
+  /**
+   * Compute the predicted label of each point from the probabilities given by
+   * Transform().
+   */
+  void Classify(const arma::mat& predictions, arma::Row<size_t>& labels) const
+  {
+    labels.set_size(predictions.n_cols);
+    for (size_t i = 0; i < predictions.n_cols; ++i)
+      labels[i] = (predictions(0, i) > 0.5) ? 1 : 0;
+  }
+
+  /**
+   * Compute the average loss of the given scores.
+   *
+   * @param responses Labels of the points.
+   * @param scores Scores of the points.
+   */
+  double Loss(const arma::rowvec& responses, const arma::mat& scores) const
+  {
+    if (responses.n_elem == 0)
+      return 0.0;
+
+    // log(1 + exp(s)) - y * s, computed without overflow.
+    double loss = 0.0;
+    for (size_t i = 0; i < responses.n_elem; ++i)
+    {
+      const double s = scores(0, i);
+      loss += std::max(s, 0.0) + std::log1p(std::exp(-std::abs(s))) -
+          responses[i] * s;
+    }
+
+    return loss / responses.n_elem;
+  }
+
+  //! Serialize the loss function (nothing to do).
+  template<typename Archive>
+  void serialize(Archive& /* ar */, const uint32_t /* version */) { }
+};
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,18 @@
+/**
+ * @file methods/xgboost/loss_functions/loss_functions.hpp
+ *
+ * Include all loss functions for gradient boosted trees.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_LOSS_FUNCTIONS_LOSS_FUNCTIONS_HPP
+#define MLPACK_METHODS_XGBOOST_LOSS_FUNCTIONS_LOSS_FUNCTIONS_HPP
+
+#include "sse_loss.hpp"
+#include "logistic_loss.hpp"
+#include "softmax_loss.hpp"
+
+#endif
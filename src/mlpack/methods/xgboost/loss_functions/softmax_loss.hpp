@@ -0,0 +1,165 @@
+/**
+ * @file methods/xgboost/loss_functions/softmax_loss.hpp
+ *
+ * The softmax loss class, which is a loss function for gradient boosted trees
+ * for multi-class classification.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_LOSS_FUNCTIONS_SOFTMAX_LOSS_HPP
+#define MLPACK_METHODS_XGBOOST_LOSS_FUNCTIONS_SOFTMAX_LOSS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * The softmax loss is the negative log-likelihood of labels in [0, numClasses)
+ * when the probabilities of the classes are the softmax of one score for each
+ * class:
+ *
+ * Loss = -log(p_y),  p_k = exp(score_k) / sum_j exp(score_j).
+ *
+ * Its gradient with respect to score_k is p_k - [y == k], and the diagonal of
+ * its hessian is p_k * (1 - p_k).  One tree is grown for each class in each
+ * round of boosting.
+ */
+class SoftmaxLoss
+{
+ public:
+  //! The smallest hessian given for a point, so that leaf values stay finite.
+  static constexpr double MinHessian = 1e-16;
+
+  /**
+   * Create the softmax loss for the given number of classes.  If the number of
+   * classes is 0, it is set from the largest training label.
+   *
+   * @param numClasses Number of classes.
+   */
+  SoftmaxLoss(const size_t numClasses = 0) : numClasses(numClasses)
+  {
+    // Nothing to do.
+  }
+
+  //! Get the number of scores the boosting model computes for each point.
+  size_t NumOutputs() const { return numClasses; }
+
+  //! Get the number of classes.
+  size_t NumClasses() const { return numClasses; }
+  //! Modify the number of classes.
+  size_t& NumClasses() { return numClasses; }
+
+  /**
+   * Compute the initial scores of the boosting model: the logarithm of the
+   * (smoothed) frequency of each class in the training labels.  An exception
+   * is thrown if a label is not an integer in [0, numClasses).
+   *
+   * @param responses Labels of the training points.
+   * @param scores Will hold the initial score of each class.
+   */
+  void InitialScores(const arma::rowvec& responses, arma::vec& scores)
+  {
+    if (numClasses == 0)
+    {
+      numClasses = (responses.n_elem == 0) ? 1 :
+          (size_t) std::max(arma::max(responses), 0.0) + 1;
+    }
+
+    arma::vec counts(numClasses, arma::fill::ones);
+    for (size_t i = 0; i < responses.n_elem; ++i)
+    {
+      const double label = responses[i];
+      if (label < 0.0 || label >= numClasses || label != std::floor(label))
+      {
+        std::ostringstream oss;
+        oss << "SoftmaxLoss::InitialScores(): labels must be integers in [0, "
+            << numClasses << ")!";
+        throw std::invalid_argument(oss.str());
+      }
+
+      counts[(size_t) label] += 1.0;
+    }
+
+    scores = arma::log(counts / arma::accu(counts));
+    scores -= arma::mean(scores);
+  }
+
+  /**
+   * Compute the gradients and hessians of the loss with respect to the scores
+   * of each point.
+   *
+   * @param responses Labels of the points.
+   * @param scores Current scores of the points (one row for each class).
+   * @param gradients Will hold the gradients for each class and point.
+   * @param hessians Will hold the hessians for each class and point.
+   */
+  void Gradients(const arma::rowvec& responses,
+                 const arma::mat& scores,
+                 arma::mat& gradients,
+                 arma::mat& hessians) const
+  {
+    Transform(scores, gradients);
+    hessians = arma::clamp(gradients % (1.0 - gradients), MinHessian, 1.0);
+    for (size_t i = 0; i < responses.n_elem; ++i)
+      gradients((size_t) responses[i], i) -= 1.0;
+  }
+
+  /**
+   * Turn the scores into the probability of each class for each point.
+   */
+  void Transform(const arma::mat& scores, arma::mat& predictions) const
+  {
+    predictions = arma::exp(scores.each_row() - arma::max(scores, 0));
+    predictions.each_row() /= arma::sum(predictions, 0);
+  }
+
+  /**
+   * Compute the predicted label of each point from the probabilities given by
+   * Transform().
+   */
+  void Classify(const arma::mat& predictions, arma::Row<size_t>& labels) const
+  {
+    labels = arma::conv_to<arma::Row<size_t>>::from(
+        arma::index_max(predictions, 0));
+  }
+
+  /**
+   * Compute the average loss of the given scores.
+   *
+   * @param responses Labels of the points.
+   * @param scores Scores of the points (one row for each class).
+   */
+  double Loss(const arma::rowvec& responses, const arma::mat& scores) const
+  {
+    if (responses.n_elem == 0)
+      return 0.0;
+
+    double loss = 0.0;
+    for (size_t i = 0; i < responses.n_elem; ++i)
+    {
+      const double maxScore = scores.col(i).max();
+      loss += maxScore + std::log(arma::accu(arma::exp(scores.col(i) -
+          maxScore))) - scores((size_t) responses[i], i);
+    }
+
+    return loss / responses.n_elem;
+  }
+
+  //! Serialize the loss function.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(numClasses));
+  }
+
+ private:
+  //! The number of classes.
+  size_t numClasses;
+};
+
+} // namespace mlpack
+
+#endif
@@ -91,11 +91,78 @@ class SSELoss
 
     return std::pow(ApplyL1(accu(gradients)), 2) / (accu(hessians) + lambda);
   }
+
+  //! Get the number of scores the boosting model computes for each point.
+  size_t NumOutputs() const { return 1; }
+
+  /**
+   * Compute the initial score of the boosting model: the mean of the
+   * responses.
+   *
+   * @param responses Responses of the training points.
+   * @param scores Will hold the initial score.
+   */
+  void InitialScores(const arma::rowvec& responses, arma::vec& scores)
+  {
+    scores.set_size(1);
+    scores[0] = InitialPrediction(responses);
+  }
+
+  /**
+   * Compute the gradients and hessians of the loss with respect to the scores
+   * of each point.
+   *
+   * @param responses Responses of the points.
+   * @param scores Current scores of the points.
+   * @param gradients Will hold the gradient for each point.
+   * @param hessians Will hold the hessian for each point.
+   */
+  void Gradients(const arma::rowvec& responses,
+                 const arma::mat& scores,
+                 arma::mat& gradients,
+                 arma::mat& hessians) const
+  {
+    gradients = scores - responses;
+    hessians.ones(1, responses.n_elem);
+  }
+
+  /**
+   * Turn the scores into predictions; for the SSE loss, the scores are the
+   * predicted responses.
+   */
+  void Transform(const arma::mat& scores, arma::mat& predictions) const
+  {
+    predictions = scores;
+  }
+
+  /**
+   * Compute the average loss of the given scores.
+   *
+   * @param responses Responses of the points.
+   * @param scores Scores of the points.
+   */
+  double Loss(const arma::rowvec& responses, const arma::mat& scores) const
+  {
+    if (responses.n_elem == 0)
+      return 0.0;
+
+    return 0.5 * arma::accu(arma::square(scores - responses)) /
+        responses.n_elem;
+  }
+
+  //! Serialize the loss function.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(alpha));
+    ar(CEREAL_NVP(lambda));
+  }
+
  private:
   //! The L1 regularization parameter.
-  const double alpha;
+  double alpha;
   //! The L2 regularization parameter.
-  const double lambda;
+  double lambda;
   //! First order gradients.
   arma::vec gradients;
   //! Second order gradients (hessians).
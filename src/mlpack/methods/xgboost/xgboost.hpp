@@ -0,0 +1,306 @@
+/**
+ * @file methods/xgboost/xgboost.hpp
+ *
+ * Definition of the XGBoost class, which trains gradient boosted regression
+ * trees with second-order (gradient and hessian) statistics.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_XGBOOST_HPP
+#define MLPACK_METHODS_XGBOOST_XGBOOST_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/decision_tree/split_functions/histogram_numeric_split.hpp>
+
+#include "loss_functions/loss_functions.hpp"
+#include "xgboost_tree.hpp"
+
+namespace mlpack {
+
+/**
+ * The XGBoost class implements gradient boosting of regression trees in the
+ * style of XGBoost.  The model predicts a score for each point (one score for
+ * each class with SoftmaxLoss), which is an initial score plus the sum of the
+ * values given by each tree.  In each round of boosting, the gradients and
+ * hessians of the loss with respect to the current scores are computed, and a
+ * new XGBoostTree is grown to minimize the second-order approximation of the
+ * loss; its leaf values are shrunk by the learning rate.
+ *
+ * Before training, each dimension of the data is binned into at most 256
+ * quantile buckets (see HistogramNumericSplit::Bin()), and trees only split
+ * between buckets.  In each round, a random fraction of the points may be used
+ * to grow the trees (row subsampling), and each tree may be restricted to a
+ * random fraction of the dimensions (column subsampling).  If a validation set
+ * is given, the loss on it is computed after each round, and training stops
+ * when it has not improved for a number of rounds; the model then keeps the
+ * trees of the best round.
+ *
+ * The loss function type must provide the following functions:
+ *
+ * @code
+ * // Return the number of scores for each point.
+ * size_t NumOutputs() const;
+ * // Compute the initial scores (one for each output) from the training
+ * // responses, checking the responses.
+ * void InitialScores(const arma::rowvec& responses, arma::vec& scores);
+ * // Compute the gradients and hessians of the loss for each output and point.
+ * void Gradients(const arma::rowvec& responses, const arma::mat& scores,
+ *                arma::mat& gradients, arma::mat& hessians) const;
+ * // Turn scores into predictions (e.g. probabilities).
+ * void Transform(const arma::mat& scores, arma::mat& predictions) const;
+ * // Compute the average loss of the given scores.
+ * double Loss(const arma::rowvec& responses, const arma::mat& scores) const;
+ * @endcode
+ *
+ * Classification losses (LogisticLoss, SoftmaxLoss) also provide Classify(),
+ * which is used by XGBoost::Classify().
+ *
+ * For more information, see the following paper:
+ *
+ * @code
+ * @inproceedings{chen2016xgboost,
+ *   title={XGBoost: A Scalable Tree Boosting System},
+ *   author={Chen, Tianqi and Guestrin, Carlos},
+ *   booktitle={Proceedings of the 22nd ACM SIGKDD International Conference on
+ *       Knowledge Discovery and Data Mining},
+ *   pages={785--794},
+ *   year={2016}
+ * }
+ * @endcode
+ *
+ * @tparam LossFunctionType Loss function to minimize (SSELoss for regression,
+ *     LogisticLoss for two-class and SoftmaxLoss for multi-class
+ *     classification).
+ */
+template<typename LossFunctionType = SSELoss>
+class XGBoost
+{
+ public:
+  /**
+   * Create an untrained model with the given loss function.
+   *
+   * @param loss Loss function to minimize.
+   */
+  XGBoost(LossFunctionType loss = LossFunctionType());
+
+  /**
+   * Train a model on the given data and responses (or labels, for
+   * classification losses).  See Train() for the meaning of the parameters.
+   */
+  template<typename MatType, typename ResponsesType>
+  XGBoost(const MatType& data,
+          const ResponsesType& responses,
+          const size_t numRounds = 100,
+          const double learningRate = 0.3,
+          const size_t maxDepth = 6,
+          const double minChildWeight = 1.0,
+          const double lambda = 1.0,
+          const double alpha = 0.0,
+          const double gamma = 0.0,
+          const double subsample = 1.0,
+          const double colsample = 1.0,
+          LossFunctionType loss = LossFunctionType());
+
+  /**
+   * Train the model on the given data and responses (or labels, for
+   * classification losses), replacing any previous model.
+   *
+   * @param data Training dataset (one column for each point).
+   * @param responses Responses or labels of the training points.
+   * @param numRounds Number of rounds of boosting.
+   * @param learningRate Factor the values of each tree are multiplied by.
+   * @param maxDepth Maximum depth of each tree (0 means no limit).
+   * @param minChildWeight Minimum sum of hessians of each child of a split.
+   * @param lambda L2 regularization of the leaf values.
+   * @param alpha L1 regularization of the leaf values.
+   * @param gamma Minimum gain (reduction of the loss) of a split.
+   * @param subsample Fraction of the points used in each round, in (0, 1].
+   * @param colsample Fraction of the dimensions used by each tree, in (0, 1].
+   * @return The average training loss of the final model.
+   */
+  template<typename MatType, typename ResponsesType>
+  double Train(const MatType& data,
+               const ResponsesType& responses,
+               const size_t numRounds = 100,
+               const double learningRate = 0.3,
+               const size_t maxDepth = 6,
+               const double minChildWeight = 1.0,
+               const double lambda = 1.0,
+               const double alpha = 0.0,
+               const double gamma = 0.0,
+               const double subsample = 1.0,
+               const double colsample = 1.0);
+
+  /**
+   * Train the model on the given data and responses, with early stopping on
+   * the given validation set: after each round, the loss on the validation set
+   * is computed, and if it has not improved for earlyStoppingRounds rounds,
+   * training stops and the trees added after the best round are removed.  If
+   * earlyStoppingRounds is 0, all rounds are run and all trees are kept.
+   *
+   * @param data Training dataset (one column for each point).
+   * @param responses Responses or labels of the training points.
+   * @param validationData Validation dataset.
+   * @param validationResponses Responses or labels of the validation points.
+   * @param earlyStoppingRounds Number of rounds without improvement of the
+   *     validation loss after which training stops.
+   * @param numRounds Maximum number of rounds of boosting.
+   * @param learningRate Factor the values of each tree are multiplied by.
+   * @param maxDepth Maximum depth of each tree (0 means no limit).
+   * @param minChildWeight Minimum sum of hessians of each child of a split.
+   * @param lambda L2 regularization of the leaf values.
+   * @param alpha L1 regularization of the leaf values.
+   * @param gamma Minimum gain (reduction of the loss) of a split.
+   * @param subsample Fraction of the points used in each round, in (0, 1].
+   * @param colsample Fraction of the dimensions used by each tree, in (0, 1].
+   * @return The average validation loss of the final model.
+   */
+  template<typename MatType, typename ResponsesType>
+  double Train(const MatType& data,
+               const ResponsesType& responses,
+               const MatType& validationData,
+               const ResponsesType& validationResponses,
+               const size_t earlyStoppingRounds = 10,
+               const size_t numRounds = 100,
+               const double learningRate = 0.3,
+               const size_t maxDepth = 6,
+               const double minChildWeight = 1.0,
+               const double lambda = 1.0,
+               const double alpha = 0.0,
+               const double gamma = 0.0,
+               const double subsample = 1.0,
+               const double colsample = 1.0);
+
+  /**
+   * Compute the raw scores of the given points (one row for each output of
+   * the loss function), before they are transformed by the loss function.
+   *
+   * @param data Points to compute scores for.
+   * @param scores Will hold the scores of each point.
+   */
+  template<typename MatType>
+  void Scores(const MatType& data, arma::mat& scores) const;
+
+  /**
+   * Compute the predictions of the model for the given points: the predicted
+   * responses for SSELoss, the probability of class 1 for LogisticLoss, and
+   * the probability of each class for SoftmaxLoss.
+   *
+   * @param data Points to predict.
+   * @param predictions Will hold the predictions (one column for each point).
+   */
+  template<typename MatType>
+  void Predict(const MatType& data, arma::mat& predictions) const;
+
+  /**
+   * Compute the predictions of the model for the given points, for loss
+   * functions with one output (such as SSELoss).
+   *
+   * @param data Points to predict.
+   * @param predictions Will hold the prediction of each point.
+   */
+  template<typename MatType>
+  void Predict(const MatType& data, arma::rowvec& predictions) const;
+
+  /**
+   * Predict the class of each of the given points.  This is only available
+   * for classification loss functions.
+   *
+   * @param data Points to classify.
+   * @param predictions Will hold the predicted class of each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const;
+
+  /**
+   * Predict the class of each of the given points, and the probabilities
+   * given by Predict().  This is only available for classification loss
+   * functions.
+   *
+   * @param data Points to classify.
+   * @param predictions Will hold the predicted class of each point.
+   * @param probabilities Will hold the probabilities given by Predict().
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  //! Get the number of scores of each point.
+  size_t NumOutputs() const { return initialScores.n_elem; }
+  //! Get the number of rounds of boosting in the model.
+  size_t NumRounds() const
+  {
+    return (NumOutputs() == 0) ? 0 : trees.size() / NumOutputs();
+  }
+  //! Get the number of trees (one for each output in each round).
+  size_t NumTrees() const { return trees.size(); }
+  //! Get the tree of the given index; the trees of round r are the trees
+  //! r * NumOutputs() to (r + 1) * NumOutputs() - 1.
+  const XGBoostTree& Tree(const size_t i) const { return trees[i]; }
+
+  //! Get the initial scores of the model.
+  const arma::vec& InitialScores() const { return initialScores; }
+
+  //! Get the loss function.
+  const LossFunctionType& LossFunction() const { return loss; }
+  //! Modify the loss function.
+  LossFunctionType& LossFunction() { return loss; }
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Train the model, with early stopping if validationData is not NULL.
+   */
+  template<typename MatType>
+  double TrainInternal(const MatType& data,
+                       const arma::rowvec& responses,
+                       const MatType* validationData,
+                       const arma::rowvec* validationResponses,
+                       const size_t earlyStoppingRounds,
+                       const size_t numRounds,
+                       const double learningRate,
+                       const size_t maxDepth,
+                       const double minChildWeight,
+                       const double lambda,
+                       const double alpha,
+                       const double gamma,
+                       const double subsample,
+                       const double colsample);
+
+  /**
+   * Add the values of the given tree for each point to the given row of the
+   * scores.
+   */
+  template<typename MatType>
+  static void AddTree(const XGBoostTree& tree,
+                      const MatType& data,
+                      arma::mat& scores,
+                      const size_t row);
+
+  //! Throw an exception if the model cannot predict the given points.
+  void CheckPoints(const size_t pointDimensionality) const;
+
+  //! The loss function.
+  LossFunctionType loss;
+  //! The initial score for each output.
+  arma::vec initialScores;
+  //! The trees; round r holds trees r * NumOutputs() to
+  //! (r + 1) * NumOutputs() - 1.
+  std::vector<XGBoostTree> trees;
+  //! The dimensionality of the training data.
+  size_t dimensionality;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "xgboost_impl.hpp"
+
+#endif
@@ -0,0 +1,402 @@
+/**
+ * @file methods/xgboost/xgboost_impl.hpp
+ *
+ * Implementation of the XGBoost class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_XGBOOST_IMPL_HPP
+#define MLPACK_METHODS_XGBOOST_XGBOOST_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "xgboost.hpp"
+
+namespace mlpack {
+
+template<typename LossFunctionType>
+XGBoost<LossFunctionType>::XGBoost(LossFunctionType loss) :
+    loss(loss),
+    dimensionality(0)
+{
+  // Nothing to do.
+}
+
+template<typename LossFunctionType>
+template<typename MatType, typename ResponsesType>
+XGBoost<LossFunctionType>::XGBoost(const MatType& data,
+                                   const ResponsesType& responses,
+                                   const size_t numRounds,
+                                   const double learningRate,
+                                   const size_t maxDepth,
+                                   const double minChildWeight,
+                                   const double lambda,
+                                   const double alpha,
+                                   const double gamma,
+                                   const double subsample,
+                                   const double colsample,
+                                   LossFunctionType loss) :
+    loss(loss),
+    dimensionality(0)
+{
+  Train(data, responses, numRounds, learningRate, maxDepth, minChildWeight,
+      lambda, alpha, gamma, subsample, colsample);
+}
+
+template<typename LossFunctionType>
+template<typename MatType, typename ResponsesType>
+double XGBoost<LossFunctionType>::Train(const MatType& data,
+                                        const ResponsesType& responses,
+                                        const size_t numRounds,
+                                        const double learningRate,
+                                        const size_t maxDepth,
+                                        const double minChildWeight,
+                                        const double lambda,
+                                        const double alpha,
+                                        const double gamma,
+                                        const double subsample,
+                                        const double colsample)
+{
+  const arma::rowvec r = arma::conv_to<arma::rowvec>::from(responses);
+  return TrainInternal(data, r, (const MatType*) NULL,
+      (const arma::rowvec*) NULL, 0, numRounds, learningRate, maxDepth,
+      minChildWeight, lambda, alpha, gamma, subsample, colsample);
+}
+
+template<typename LossFunctionType>
+template<typename MatType, typename ResponsesType>
+double XGBoost<LossFunctionType>::Train(const MatType& data,
+                                        const ResponsesType& responses,
+                                        const MatType& validationData,
+                                        const ResponsesType& validationResponses,
+                                        const size_t earlyStoppingRounds,
+                                        const size_t numRounds,
+                                        const double learningRate,
+                                        const size_t maxDepth,
+                                        const double minChildWeight,
+                                        const double lambda,
+                                        const double alpha,
+                                        const double gamma,
+                                        const double subsample,
+                                        const double colsample)
+{
+  const arma::rowvec r = arma::conv_to<arma::rowvec>::from(responses);
+  const arma::rowvec vr =
+      arma::conv_to<arma::rowvec>::from(validationResponses);
+  return TrainInternal(data, r, &validationData, &vr, earlyStoppingRounds,
+      numRounds, learningRate, maxDepth, minChildWeight, lambda, alpha, gamma,
+      subsample, colsample);
+}
+
+template<typename LossFunctionType>
+template<typename MatType>
+double XGBoost<LossFunctionType>::TrainInternal(
+    const MatType& data,
+    const arma::rowvec& responses,
+    const MatType* validationData,
+    const arma::rowvec* validationResponses,
+    const size_t earlyStoppingRounds,
+    const size_t numRounds,
+    const double learningRate,
+    const size_t maxDepth,
+    const double minChildWeight,
+    const double lambda,
+    const double alpha,
+    const double gamma,
+    const double subsample,
+    const double colsample)
+{
+  if (data.n_cols != responses.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "XGBoost::Train(): number of points (" << data.n_cols << ") does "
+        << "not match number of responses (" << responses.n_elem << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (validationData != NULL &&
+      validationData->n_cols != validationResponses->n_elem)
+  {
+    std::ostringstream oss;
+    oss << "XGBoost::Train(): number of validation points ("
+        << validationData->n_cols << ") does not match number of validation "
+        << "responses (" << validationResponses->n_elem << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (data.n_rows == 0)
+  {
+    throw std::invalid_argument("XGBoost::Train(): the data must have at "
+        "least one dimension!");
+  }
+
+  if (validationData != NULL && validationData->n_rows != data.n_rows)
+  {
+    throw std::invalid_argument("XGBoost::Train(): the validation data must "
+        "have the same dimensionality as the training data!");
+  }
+
+  if (subsample <= 0.0 || subsample > 1.0)
+  {
+    throw std::invalid_argument("XGBoost::Train(): subsample must be in "
+        "(0, 1]!");
+  }
+
+  if (colsample <= 0.0 || colsample > 1.0)
+  {
+    throw std::invalid_argument("XGBoost::Train(): colsample must be in "
+        "(0, 1]!");
+  }
+
+  if (learningRate <= 0.0)
+  {
+    throw std::invalid_argument("XGBoost::Train(): the learning rate must be "
+        "positive!");
+  }
+
+  if (lambda < 0.0 || alpha < 0.0 || gamma < 0.0 || minChildWeight < 0.0)
+  {
+    throw std::invalid_argument("XGBoost::Train(): lambda, alpha, gamma and "
+        "minChildWeight must not be negative!");
+  }
+
+  const size_t n = data.n_cols;
+  const size_t d = data.n_rows;
+  dimensionality = d;
+  trees.clear();
+  loss.InitialScores(responses, initialScores);
+  const size_t numOutputs = initialScores.n_elem;
+
+  // Bin each dimension, and find the threshold between each pair of
+  // consecutive bins.
+  arma::Mat<unsigned char> bins(n, d);
+  std::vector<arma::vec> cuts(d);
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < d; ++i)
+  {
+    arma::Row<unsigned char> dimBins;
+    arma::Col<size_t> binCounts;
+    arma::vec binMin, binMax;
+    const size_t numBins = HistogramNumericSplit<MSEGain>::Bin(data.row(i),
+        dimBins, binCounts, binMin, binMax);
+    bins.col(i) = dimBins.t();
+
+    // The threshold after bin b is halfway between the largest value of the
+    // bins up to b and the smallest value of the later bins.
+    cuts[i].zeros(numBins - 1);
+    arma::vec nextMin(numBins);
+    nextMin[numBins - 1] = binMin[numBins - 1];
+    for (size_t b = numBins - 1; b > 0; --b)
+      nextMin[b - 1] = std::min(binMin[b - 1], nextMin[b]);
+
+    double lastMax = -DBL_MAX;
+    for (size_t b = 0; b + 1 < numBins; ++b)
+    {
+      lastMax = std::max(lastMax, binMax[b]);
+      if (lastMax == -DBL_MAX || nextMin[b + 1] == DBL_MAX)
+        continue;
+
+      cuts[i][b] = lastMax + (nextMin[b + 1] - lastMax) / 2.0;
+      if (!(cuts[i][b] < nextMin[b + 1]))
+        cuts[i][b] = lastMax;
+    }
+  }
+
+  arma::mat scores = arma::repmat(initialScores, 1, n);
+  arma::mat validationScores;
+  double bestLoss = DBL_MAX;
+  size_t bestRound = 0;
+  if (validationData != NULL)
+  {
+    validationScores = arma::repmat(initialScores, 1, validationData->n_cols);
+    bestLoss = loss.Loss(*validationResponses, validationScores);
+  }
+
+  const size_t numPoints = std::max((size_t) std::ceil(subsample * n),
+      (size_t) 1);
+  const size_t numDims = std::max((size_t) std::ceil(colsample * d),
+      (size_t) 1);
+  arma::mat gradients, hessians;
+  arma::Col<size_t> sample, points;
+  arma::Col<size_t> dimensions = arma::regspace<arma::Col<size_t>>(0, d - 1);
+  for (size_t round = 0; round < numRounds && n > 0; ++round)
+  {
+    loss.Gradients(responses, scores, gradients, hessians);
+
+    if (numPoints < n)
+    {
+      sample = arma::sort(arma::conv_to<arma::Col<size_t>>::from(
+          arma::randperm(n, numPoints)));
+    }
+    else
+    {
+      sample = arma::regspace<arma::Col<size_t>>(0, n - 1);
+    }
+
+    for (size_t k = 0; k < numOutputs; ++k)
+    {
+      // Each tree reorders the points it is grown on.
+      points = sample;
+      if (numDims < d)
+      {
+        dimensions = arma::sort(arma::conv_to<arma::Col<size_t>>::from(
+            arma::randperm(d, numDims)));
+      }
+
+      trees.push_back(XGBoostTree());
+      trees.back().Train(bins, cuts, gradients.row(k), hessians.row(k), points,
+          dimensions, maxDepth, minChildWeight, lambda, alpha, gamma,
+          learningRate);
+
+      AddTree(trees.back(), data, scores, k);
+      if (validationData != NULL)
+        AddTree(trees.back(), *validationData, validationScores, k);
+    }
+
+    if (validationData != NULL)
+    {
+      const double validationLoss = loss.Loss(*validationResponses,
+          validationScores);
+      Log::Debug << "XGBoost::Train(): round " << round << ", validation loss "
+          << validationLoss << "." << std::endl;
+
+      if (validationLoss < bestLoss)
+      {
+        bestLoss = validationLoss;
+        bestRound = round + 1;
+      }
+      else if (earlyStoppingRounds > 0 &&
+               round + 1 - bestRound >= earlyStoppingRounds)
+      {
+        Log::Info << "XGBoost::Train(): validation loss has not improved for "
+            << earlyStoppingRounds << " rounds; keeping the " << bestRound
+            << " best rounds." << std::endl;
+        trees.resize(bestRound * numOutputs);
+        return bestLoss;
+      }
+    }
+  }
+
+  if (validationData != NULL)
+  {
+    if (earlyStoppingRounds > 0)
+    {
+      trees.resize(bestRound * numOutputs);
+      return bestLoss;
+    }
+
+    return loss.Loss(*validationResponses, validationScores);
+  }
+
+  return loss.Loss(responses, scores);
+}
+
+template<typename LossFunctionType>
+template<typename MatType>
+void XGBoost<LossFunctionType>::Scores(const MatType& data,
+                                       arma::mat& scores) const
+{
+  CheckPoints(data.n_rows);
+
+  scores = arma::repmat(initialScores, 1, data.n_cols);
+  #pragma omp parallel for
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    for (size_t t = 0; t < trees.size(); ++t)
+      scores(t % NumOutputs(), i) += trees[t].Predict(data, i);
+  }
+}
+
+template<typename LossFunctionType>
+template<typename MatType>
+void XGBoost<LossFunctionType>::Predict(const MatType& data,
+                                        arma::mat& predictions) const
+{
+  arma::mat scores;
+  Scores(data, scores);
+  loss.Transform(scores, predictions);
+}
+
+template<typename LossFunctionType>
+template<typename MatType>
+void XGBoost<LossFunctionType>::Predict(const MatType& data,
+                                        arma::rowvec& predictions) const
+{
+  if (NumOutputs() > 1)
+  {
+    throw std::invalid_argument("XGBoost::Predict(): the model has more than "
+        "one output; use the arma::mat overload!");
+  }
+
+  arma::mat allPredictions;
+  Predict(data, allPredictions);
+  predictions = allPredictions.row(0);
+}
+
+template<typename LossFunctionType>
+template<typename MatType>
+void XGBoost<LossFunctionType>::Classify(const MatType& data,
+                                         arma::Row<size_t>& predictions) const
+{
+  arma::mat probabilities;
+  Classify(data, predictions, probabilities);
+}
+
+template<typename LossFunctionType>
+template<typename MatType>
+void XGBoost<LossFunctionType>::Classify(const MatType& data,
+                                         arma::Row<size_t>& predictions,
+                                         arma::mat& probabilities) const
+{
+  Predict(data, probabilities);
+  loss.Classify(probabilities, predictions);
+}
+
+template<typename LossFunctionType>
+template<typename Archive>
+void XGBoost<LossFunctionType>::serialize(Archive& ar,
+                                          const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(loss));
+  ar(CEREAL_NVP(initialScores));
+  ar(CEREAL_NVP(trees));
+  ar(CEREAL_NVP(dimensionality));
+}
+
+template<typename LossFunctionType>
+template<typename MatType>
+void XGBoost<LossFunctionType>::AddTree(const XGBoostTree& tree,
+                                        const MatType& data,
+                                        arma::mat& scores,
+                                        const size_t row)
+{
+  #pragma omp parallel for
+  for (size_t i = 0; i < data.n_cols; ++i)
+    scores(row, i) += tree.Predict(data, i);
+}
+
+template<typename LossFunctionType>
+void XGBoost<LossFunctionType>::CheckPoints(
+    const size_t pointDimensionality) const
+{
+  if (initialScores.n_elem == 0)
+  {
+    throw std::invalid_argument("XGBoost::Predict(): the model is not "
+        "trained!");
+  }
+
+  if (pointDimensionality != dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "XGBoost::Predict(): dimensionality of points ("
+        << pointDimensionality << ") does not match the dimensionality of the "
+        << "model (" << dimensionality << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+}
+
+} // namespace mlpack
+
+#endif
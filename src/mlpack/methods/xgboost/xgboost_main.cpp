@@ -0,0 +1,334 @@
+/**
+ * @file methods/xgboost/xgboost_main.cpp
+ *
+ * A program to train and use gradient boosted trees.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#undef BINDING_NAME
+#define BINDING_NAME xgboost
+
+#include <mlpack/core/util/mlpack_main.hpp>
+#include <mlpack/methods/xgboost/xgboost.hpp>
+
+using namespace mlpack;
+using namespace mlpack::util;
+using namespace std;
+
+// Program Name.
+BINDING_USER_NAME("Gradient boosted trees");
+
+// Short description.
+BINDING_SHORT_DESC(
+    "An implementation of gradient boosted trees in the style of XGBoost, for "
+    "regression and classification.  Given a dataset with responses or "
+    "labels, a model can be trained and saved for future use; or, a "
+    "pre-trained model can be used to make predictions.");
+
+// Long description.
+BINDING_LONG_DESC(
+    "This program trains gradient boosted regression trees in the style of "
+    "XGBoost, where each tree is grown on the gradients and hessians of a loss "
+    "function, between the buckets of a quantile histogram of each dimension."
+    "  The loss function is specified with the " + PRINT_PARAM_STRING("loss") +
+    " parameter: 'squared_error' for regression, 'logistic' for two-class "
+    "classification (with labels 0 and 1), or 'softmax' for multi-class "
+    "classification (with labels in `[0, num_classes - 1]`)."
+    "\n\n"
+    "The training set and associated responses or labels are specified with "
+    "the " + PRINT_PARAM_STRING("training") + " and " +
+    PRINT_PARAM_STRING("responses") + " parameters.  The " +
+    PRINT_PARAM_STRING("num_rounds") + " parameter controls the number of "
+    "rounds of boosting, and the " + PRINT_PARAM_STRING("learning_rate") +
+    " parameter controls the shrinkage of each tree.  The trees are limited "
+    "by the " + PRINT_PARAM_STRING("maximum_depth") + " and " +
+    PRINT_PARAM_STRING("min_child_weight") + " parameters, and the leaf "
+    "values are regularized by the " + PRINT_PARAM_STRING("lambda") + " (L2) "
+    "and " + PRINT_PARAM_STRING("alpha") + " (L1) parameters; splits must "
+    "reduce the loss by at least " + PRINT_PARAM_STRING("gamma") + ".  The " +
+    PRINT_PARAM_STRING("subsample") + " and " +
+    PRINT_PARAM_STRING("colsample") + " parameters give the fraction of the "
+    "points used in each round and the fraction of the dimensions used by "
+    "each tree."
+    "\n\n"
+    "If a validation set is given with the " +
+    PRINT_PARAM_STRING("validation") + " and " +
+    PRINT_PARAM_STRING("validation_responses") + " parameters, training "
+    "stops when the validation loss has not improved for " +
+    PRINT_PARAM_STRING("early_stopping_rounds") + " rounds, and the model "
+    "keeps the trees of the best round."
+    "\n\n"
+    "When a model is trained, the " + PRINT_PARAM_STRING("output_model") + " "
+    "output parameter may be used to save the trained model.  A model may be "
+    "loaded for predictions with the " + PRINT_PARAM_STRING("input_model") +
+    " parameter.  Predictions for the points given with the " +
+    PRINT_PARAM_STRING("test") + " parameter are saved with the " +
+    PRINT_PARAM_STRING("predictions") + " output parameter: predicted "
+    "responses for regression, and predicted labels for classification.  For "
+    "classification, the probabilities of each class may be saved with the " +
+    PRINT_PARAM_STRING("probabilities") + " output parameter.");
+
+// Example.
+BINDING_EXAMPLE(
+    "For example, to train a model with 200 rounds and a learning rate of 0.1 "
+    "for two-class classification on the dataset " + PRINT_DATASET("data") +
+    " with labels " + PRINT_DATASET("labels") + ", stopping early on the "
+    "validation set " + PRINT_DATASET("valid") + " with labels " +
+    PRINT_DATASET("valid_labels") + ", and save the model to " +
+    PRINT_MODEL("model") + ", one could call"
+    "\n\n" +
+    PRINT_CALL("xgboost", "training", "data", "responses", "labels", "loss",
+        "logistic", "num_rounds", 200, "learning_rate", 0.1, "validation",
+        "valid", "validation_responses", "valid_labels", "output_model",
+        "model") +
+    "\n\n"
+    "Then, to use that model to predict the labels of the points in " +
+    PRINT_DATASET("test_set") + ", saving them to " +
+    PRINT_DATASET("predictions") + ", one could call "
+    "\n\n" +
+    PRINT_CALL("xgboost", "input_model", "model", "test", "test_set",
+        "predictions", "predictions"));
+
+// See also...
+BINDING_SEE_ALSO("@random_forest", "#random_forest");
+BINDING_SEE_ALSO("@decision_tree", "#decision_tree");
+BINDING_SEE_ALSO("Gradient boosting on Wikipedia",
+    "https://en.wikipedia.org/wiki/Gradient_boosting");
+BINDING_SEE_ALSO("XGBoost: A Scalable Tree Boosting System (pdf)",
+    "https://arxiv.org/pdf/1603.02754");
+BINDING_SEE_ALSO("XGBoost C++ class documentation",
+    "@doc/user/methods/xgboost.md");
+
+PARAM_MATRIX_IN("training", "Training dataset.", "t");
+PARAM_ROW_IN("responses", "Responses (or labels) for the training dataset.",
+    "r");
+PARAM_MATRIX_IN("validation", "Validation dataset for early stopping.", "v");
+PARAM_ROW_IN("validation_responses", "Responses (or labels) for the "
+    "validation dataset.", "V");
+PARAM_MATRIX_IN("test", "Test dataset to produce predictions for.", "T");
+
+PARAM_STRING_IN("loss", "Loss function: 'squared_error', 'logistic' or "
+    "'softmax'.", "L", "squared_error");
+PARAM_INT_IN("num_rounds", "Number of rounds of boosting.", "N", 100);
+PARAM_DOUBLE_IN("learning_rate", "Learning rate (shrinkage) of each tree.",
+    "e", 0.3);
+PARAM_INT_IN("maximum_depth", "Maximum depth of each tree (0 means no limit).",
+    "D", 6);
+PARAM_DOUBLE_IN("min_child_weight", "Minimum sum of hessians in each child of "
+    "a split.", "w", 1.0);
+PARAM_DOUBLE_IN("lambda", "L2 regularization of the leaf values.", "l", 1.0);
+PARAM_DOUBLE_IN("alpha", "L1 regularization of the leaf values.", "a", 0.0);
+PARAM_DOUBLE_IN("gamma", "Minimum loss reduction of a split.", "g", 0.0);
+PARAM_DOUBLE_IN("subsample", "Fraction of the points used in each round.",
+    "S", 1.0);
+PARAM_DOUBLE_IN("colsample", "Fraction of the dimensions used by each tree.",
+    "C", 1.0);
+PARAM_INT_IN("early_stopping_rounds", "Number of rounds without improvement "
+    "of the validation loss after which training stops (0 means never stop "
+    "early).", "E", 10);
+
+PARAM_ROW_OUT("predictions", "Predicted responses (or labels) for each point "
+    "in the test set.", "p");
+PARAM_MATRIX_OUT("probabilities", "Predicted class probabilities for each "
+    "point in the test set (classification only).", "P");
+
+PARAM_INT_IN("seed", "Random seed.  If 0, 'std::time(NULL)' is used.", "s", 0);
+
+/**
+ * This is the class that we will serialize.  It holds a model for the loss
+ * function that was used for training.
+ */
+class XGBoostModel
+{
+ public:
+  //! The loss function of the model.
+  std::string loss;
+  //! The model, if the loss is the squared error.
+  XGBoost<SSELoss> sse;
+  //! The model, if the loss is the logistic loss.
+  XGBoost<LogisticLoss> logistic;
+  //! The model, if the loss is the softmax loss.
+  XGBoost<SoftmaxLoss> softmax;
+
+  // Create the model.
+  XGBoostModel() : loss("squared_error") { /* Nothing to do. */ }
+
+  // Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(loss));
+    if (loss == "logistic")
+      ar(CEREAL_NVP(logistic));
+    else if (loss == "softmax")
+      ar(CEREAL_NVP(softmax));
+    else
+      ar(CEREAL_NVP(sse));
+  }
+};
+
+PARAM_MODEL_IN(XGBoostModel, "input_model", "Pre-trained model to use for "
+    "predictions.", "m");
+PARAM_MODEL_OUT(XGBoostModel, "output_model", "Model to save the trained "
+    "model to.", "M");
+
+// Train the given model with the parameters of the binding.
+template<typename ModelType>
+void TrainModel(util::Params& params, ModelType& model)
+{
+  arma::mat data = std::move(params.Get<arma::mat>("training"));
+  arma::rowvec responses = std::move(params.Get<arma::rowvec>("responses"));
+
+  const size_t numRounds = (size_t) params.Get<int>("num_rounds");
+  const double learningRate = params.Get<double>("learning_rate");
+  const size_t maxDepth = (size_t) params.Get<int>("maximum_depth");
+  const double minChildWeight = params.Get<double>("min_child_weight");
+  const double lambda = params.Get<double>("lambda");
+  const double alpha = params.Get<double>("alpha");
+  const double gamma = params.Get<double>("gamma");
+  const double subsample = params.Get<double>("subsample");
+  const double colsample = params.Get<double>("colsample");
+
+  double result;
+  if (params.Has("validation"))
+  {
+    arma::mat validation = std::move(params.Get<arma::mat>("validation"));
+    arma::rowvec validationResponses =
+        std::move(params.Get<arma::rowvec>("validation_responses"));
+    const size_t earlyStoppingRounds =
+        (size_t) params.Get<int>("early_stopping_rounds");
+
+    result = model.Train(data, responses, validation, validationResponses,
+        earlyStoppingRounds, numRounds, learningRate, maxDepth, minChildWeight,
+        lambda, alpha, gamma, subsample, colsample);
+    Log::Info << "Validation loss: " << result << " after "
+        << model.NumRounds() << " rounds." << endl;
+  }
+  else
+  {
+    result = model.Train(data, responses, numRounds, learningRate, maxDepth,
+        minChildWeight, lambda, alpha, gamma, subsample, colsample);
+    Log::Info << "Training loss: " << result << "." << endl;
+  }
+}
+
+void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
+{
+  // Initialize random seed if needed.
+  if (params.Get<int>("seed") != 0)
+    RandomSeed((size_t) params.Get<int>("seed"));
+  else
+    RandomSeed((size_t) std::time(NULL));
+
+  // Check for incompatible input parameters.
+  RequireOnlyOnePassed(params, { "training", "input_model" }, true);
+  RequireAtLeastOnePassed(params, { "test", "output_model" }, false,
+      "the trained model will not be used or saved");
+
+  if (params.Has("training"))
+  {
+    RequireAtLeastOnePassed(params, { "responses" }, true, "must pass "
+        "responses when training set given");
+  }
+
+  RequireNoneOrAllPassed(params, { "validation", "validation_responses" },
+      true);
+  ReportIgnoredParam(params, {{ "training", false }}, "validation");
+  ReportIgnoredParam(params, {{ "validation", false }},
+      "early_stopping_rounds");
+  ReportIgnoredParam(params, {{ "test", false }}, "predictions");
+  ReportIgnoredParam(params, {{ "test", false }}, "probabilities");
+
+  RequireParamInSet<string>(params, "loss", { "squared_error", "logistic",
+      "softmax" }, true, "unknown loss function");
+  RequireParamValue<int>(params, "num_rounds", [](int x) { return x > 0; },
+      true, "number of rounds must be positive");
+  RequireParamValue<double>(params, "learning_rate",
+      [](double x) { return x > 0.0; }, true, "learning rate must be "
+      "positive");
+  RequireParamValue<int>(params, "maximum_depth", [](int x) { return x >= 0; },
+      true, "maximum depth must not be negative");
+  RequireParamValue<double>(params, "min_child_weight",
+      [](double x) { return x >= 0.0; }, true, "minimum child weight must not "
+      "be negative");
+  RequireParamValue<double>(params, "lambda", [](double x) { return x >= 0.0; },
+      true, "lambda must not be negative");
+  RequireParamValue<double>(params, "alpha", [](double x) { return x >= 0.0; },
+      true, "alpha must not be negative");
+  RequireParamValue<double>(params, "gamma", [](double x) { return x >= 0.0; },
+      true, "gamma must not be negative");
+  RequireParamValue<double>(params, "subsample",
+      [](double x) { return x > 0.0 && x <= 1.0; }, true, "subsample must be "
+      "in (0, 1]");
+  RequireParamValue<double>(params, "colsample",
+      [](double x) { return x > 0.0 && x <= 1.0; }, true, "colsample must be "
+      "in (0, 1]");
+  RequireParamValue<int>(params, "early_stopping_rounds",
+      [](int x) { return x >= 0; }, true, "number of early stopping rounds "
+      "must not be negative");
+
+  XGBoostModel* model;
+  if (params.Has("input_model"))
+    model = params.Get<XGBoostModel*>("input_model");
+  else
+    model = new XGBoostModel();
+
+  if (params.Has("training"))
+  {
+    timers.Start("xgboost_training");
+
+    model->loss = params.Get<string>("loss");
+    Log::Info << "Training gradient boosted trees with " << model->loss
+        << " loss..." << endl;
+    if (model->loss == "logistic")
+      TrainModel(params, model->logistic);
+    else if (model->loss == "softmax")
+      TrainModel(params, model->softmax);
+    else
+      TrainModel(params, model->sse);
+
+    timers.Stop("xgboost_training");
+  }
+
+  if (params.Has("test"))
+  {
+    arma::mat testData = std::move(params.Get<arma::mat>("test"));
+    timers.Start("xgboost_prediction");
+
+    arma::Row<size_t> labels;
+    arma::mat probabilities;
+    arma::rowvec predictions;
+    if (model->loss == "logistic")
+    {
+      model->logistic.Classify(testData, labels, probabilities);
+      // Give the probability of each of the two classes.
+      probabilities = arma::join_cols(1.0 - probabilities, probabilities);
+      predictions = arma::conv_to<arma::rowvec>::from(labels);
+    }
+    else if (model->loss == "softmax")
+    {
+      model->softmax.Classify(testData, labels, probabilities);
+      predictions = arma::conv_to<arma::rowvec>::from(labels);
+    }
+    else
+    {
+      ReportIgnoredParam(params, "probabilities", "the squared error loss "
+          "does not give class probabilities");
+      model->sse.Predict(testData, predictions);
+    }
+
+    timers.Stop("xgboost_prediction");
+
+    // Save the outputs.
+    params.Get<arma::rowvec>("predictions") = std::move(predictions);
+    params.Get<arma::mat>("probabilities") = std::move(probabilities);
+  }
+
+  // Save the output model.
+  params.Get<XGBoostModel*>("output_model") = model;
+}
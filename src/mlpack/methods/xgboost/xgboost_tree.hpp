@@ -0,0 +1,151 @@
+/**
+ * @file methods/xgboost/xgboost_tree.hpp
+ *
+ * Definition of the XGBoostTree class, a regression tree fit to the gradients
+ * and hessians of a loss function, for gradient boosting.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_XGBOOST_TREE_HPP
+#define MLPACK_METHODS_XGBOOST_XGBOOST_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * The XGBoostTree is a binary regression tree that is grown on pre-binned data
+ * to minimize the second-order approximation of a loss function, given the
+ * gradient g_i and hessian h_i of the loss at each point.  The value of a leaf
+ * with gradient sum G and hessian sum H is
+ *
+ *   w = -eta * T(G) / (H + lambda),
+ *
+ * where T() shrinks G towards zero by alpha (L1 regularization) and eta is the
+ * learning rate, and a node is split where the gain
+ *
+ *   0.5 * (T(G_L)^2 / (H_L + lambda) + T(G_R)^2 / (H_R + lambda)
+ *       - T(G)^2 / (H + lambda)) - gamma
+ *
+ * is largest and positive, as long as each child has a hessian sum of at least
+ * minChildWeight.  Only splits between the bins of each dimension are
+ * considered; the gradient and hessian sums of the bins of a node are
+ * collected into a histogram, in parallel over the dimensions with OpenMP, and
+ * the histogram of the larger child of each split is the histogram of the node
+ * minus that of the smaller child.
+ *
+ * The tree is stored as a few flat arrays; the children of a node are next to
+ * each other, and points with value at most the threshold of the node go to
+ * the first child.
+ */
+class XGBoostTree
+{
+ public:
+  //! The maximum number of bins of each dimension.
+  static constexpr size_t MaxBins = 256;
+  //! The number of histogram entries (points times dimensions) above which a
+  //! histogram is built in parallel.
+  static constexpr size_t ParallelMinWork = 32768;
+
+  /**
+   * Create an empty tree, which predicts 0 for every point.
+   */
+  XGBoostTree();
+
+  /**
+   * Grow the tree on the given binned data.
+   *
+   * @param bins Bin of each point (row) in each dimension (column); bins are
+   *     ordered by value.
+   * @param cuts For each dimension, the threshold between each bin and the
+   *     next one: all values of the bins up to b are at most cuts[d][b], and
+   *     all values of later bins are greater.
+   * @param gradients Gradient of the loss at each point.
+   * @param hessians Hessian of the loss at each point.
+   * @param points The points to grow the tree on; this is reordered.
+   * @param dimensions The dimensions that may be split on.
+   * @param maxDepth Maximum depth of the tree (0 means no limit).
+   * @param minChildWeight Minimum sum of hessians of each child of a split.
+   * @param lambda L2 regularization of the leaf values.
+   * @param alpha L1 regularization of the leaf values.
+   * @param gamma Minimum gain of a split.
+   * @param learningRate Factor the leaf values are multiplied by.
+   */
+  void Train(const arma::Mat<unsigned char>& bins,
+             const std::vector<arma::vec>& cuts,
+             const arma::rowvec& gradients,
+             const arma::rowvec& hessians,
+             arma::Col<size_t>& points,
+             const arma::Col<size_t>& dimensions,
+             const size_t maxDepth,
+             const double minChildWeight,
+             const double lambda,
+             const double alpha,
+             const double gamma,
+             const double learningRate);
+
+  /**
+   * Compute the value of the leaf that column col of the given data falls in.
+   *
+   * @param data Dataset.
+   * @param col Column of the point.
+   */
+  template<typename MatType>
+  double Predict(const MatType& data, const size_t col) const;
+
+  //! Get the number of nodes of the tree.
+  size_t NumNodes() const { return values.n_elem; }
+  //! Get the number of leaves of the tree.
+  size_t NumLeaves() const { return (NumNodes() + 1) / 2; }
+
+  //! Get the split dimension of each node (unused for leaves).
+  const arma::Col<size_t>& SplitDimensions() const { return splitDimensions; }
+  //! Get the threshold of each node (unused for leaves).
+  const arma::vec& Thresholds() const { return thresholds; }
+  //! Get the index of the first child of each node (0 for leaves).
+  const arma::Col<size_t>& Children() const { return children; }
+  //! Get the value of each node (only used for leaves).
+  const arma::vec& Values() const { return values; }
+
+  //! Serialize the tree.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Compute the gradient and hessian sums of each bin of the given dimensions
+   * for the points in [begin, begin + count).  Column i of the histogram holds
+   * the gradient sum of bin b in row 2b and the hessian sum in row 2b + 1.
+   */
+  static void BuildHistogram(const arma::Mat<unsigned char>& bins,
+                             const arma::rowvec& gradients,
+                             const arma::rowvec& hessians,
+                             const arma::Col<size_t>& points,
+                             const size_t begin,
+                             const size_t count,
+                             const arma::Col<size_t>& dimensions,
+                             arma::mat& histogram);
+
+  //! Shrink the given gradient sum towards zero by alpha.
+  static double ThresholdL1(const double sumGradients, const double alpha);
+
+  //! The split dimension of each node.
+  arma::Col<size_t> splitDimensions;
+  //! The threshold of each node.
+  arma::vec thresholds;
+  //! The index of the first child of each node; the second child follows it.
+  //! Leaves have no children, and hold 0.
+  arma::Col<size_t> children;
+  //! The value of each node.
+  arma::vec values;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "xgboost_tree_impl.hpp"
+
+#endif
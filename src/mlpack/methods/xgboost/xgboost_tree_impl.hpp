@@ -0,0 +1,269 @@
+/**
+ * @file methods/xgboost/xgboost_tree_impl.hpp
+ *
+ * Implementation of the XGBoostTree class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_XGBOOST_TREE_IMPL_HPP
+#define MLPACK_METHODS_XGBOOST_XGBOOST_TREE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "xgboost_tree.hpp"
+
+namespace mlpack {
+
+inline XGBoostTree::XGBoostTree() :
+    splitDimensions(1, arma::fill::zeros),
+    thresholds(1, arma::fill::zeros),
+    children(1, arma::fill::zeros),
+    values(1, arma::fill::zeros)
+{
+  // Nothing to do.
+}
+
+inline void XGBoostTree::Train(const arma::Mat<unsigned char>& bins,
+                               const std::vector<arma::vec>& cuts,
+                               const arma::rowvec& gradients,
+                               const arma::rowvec& hessians,
+                               arma::Col<size_t>& points,
+                               const arma::Col<size_t>& dimensions,
+                               const size_t maxDepth,
+                               const double minChildWeight,
+                               const double lambda,
+                               const double alpha,
+                               const double gamma,
+                               const double learningRate)
+{
+  std::vector<size_t> nodeDimensions(1, 0), nodeChildren(1, 0);
+  std::vector<double> nodeThresholds(1, 0.0), nodeValues(1, 0.0);
+
+  // A node that may still be split, with the histogram of its points (unless
+  // it is at the maximum depth, where it will not be split).
+  struct Node
+  {
+    size_t index;
+    size_t begin;
+    size_t count;
+    size_t depth;
+    double sumGradients;
+    double sumHessians;
+    arma::mat histogram;
+  };
+
+  std::vector<Node> stack(1);
+  stack[0].index = 0;
+  stack[0].begin = 0;
+  stack[0].count = points.n_elem;
+  stack[0].depth = 0;
+  stack[0].sumGradients = 0.0;
+  stack[0].sumHessians = 0.0;
+  for (size_t i = 0; i < points.n_elem; ++i)
+  {
+    stack[0].sumGradients += gradients[points[i]];
+    stack[0].sumHessians += hessians[points[i]];
+  }
+  BuildHistogram(bins, gradients, hessians, points, 0, points.n_elem,
+      dimensions, stack[0].histogram);
+
+  const size_t numDims = dimensions.n_elem;
+  arma::vec gains(numDims);
+  arma::Col<size_t> splitBins(numDims);
+  while (!stack.empty())
+  {
+    Node node = std::move(stack.back());
+    stack.pop_back();
+
+    const double sumGradients = node.sumGradients;
+    const double sumHessians = node.sumHessians;
+    const double nodeL1 = ThresholdL1(sumGradients, alpha);
+    nodeValues[node.index] = -learningRate * nodeL1 / (sumHessians + lambda);
+
+    if (node.count < 2 || (maxDepth != 0 && node.depth >= maxDepth))
+      continue;
+
+    // Find the best split of each dimension.
+    const double nodeScore = nodeL1 * nodeL1 / (sumHessians + lambda);
+    #pragma omp parallel for schedule(static) \
+        if (numDims * MaxBins >= ParallelMinWork)
+    for (size_t d = 0; d < numDims; ++d)
+    {
+      gains[d] = 0.0;
+      const double* histogram = node.histogram.colptr(d);
+
+      // Only split before the last bin that holds points of the node.
+      size_t lastBin = cuts[dimensions[d]].n_elem;
+      while (lastBin > 0 && histogram[2 * lastBin + 1] <= 0.0)
+        --lastBin;
+
+      double leftGradients = 0.0, leftHessians = 0.0;
+      for (size_t b = 0; b < lastBin; ++b)
+      {
+        leftGradients += histogram[2 * b];
+        leftHessians += histogram[2 * b + 1];
+        if (leftHessians <= 0.0 || leftHessians < minChildWeight)
+          continue;
+
+        const double rightHessians = sumHessians - leftHessians;
+        if (rightHessians < minChildWeight)
+          break;
+
+        const double leftL1 = ThresholdL1(leftGradients, alpha);
+        const double rightL1 = ThresholdL1(sumGradients - leftGradients,
+            alpha);
+        const double gain = 0.5 * (leftL1 * leftL1 / (leftHessians + lambda) +
+            rightL1 * rightL1 / (rightHessians + lambda) - nodeScore) - gamma;
+        if (gain > gains[d])
+        {
+          gains[d] = gain;
+          splitBins[d] = b;
+        }
+      }
+    }
+
+    // Take the first dimension with the best gain, so the split does not
+    // depend on the number of threads.
+    size_t bestDim = numDims;
+    double bestGain = 0.0;
+    for (size_t d = 0; d < numDims; ++d)
+    {
+      if (gains[d] > bestGain)
+      {
+        bestGain = gains[d];
+        bestDim = d;
+      }
+    }
+
+    if (bestDim == numDims)
+      continue;
+
+    // Move the points of the left child before the points of the right child.
+    const size_t dim = dimensions[bestDim];
+    const size_t bin = splitBins[bestDim];
+    const unsigned char* dimBins = bins.colptr(dim);
+    size_t* first = points.memptr() + node.begin;
+    size_t* middle = std::stable_partition(first, first + node.count,
+        [&](const size_t p) { return dimBins[p] <= bin; });
+    const size_t leftCount = middle - first;
+
+    double leftGradients = 0.0, leftHessians = 0.0;
+    for (size_t b = 0; b <= bin; ++b)
+    {
+      leftGradients += node.histogram(2 * b, bestDim);
+      leftHessians += node.histogram(2 * b + 1, bestDim);
+    }
+
+    const size_t left = nodeValues.size();
+    nodeDimensions[node.index] = dim;
+    nodeThresholds[node.index] = cuts[dim][bin];
+    nodeChildren[node.index] = left;
+    for (size_t c = 0; c < 2; ++c)
+    {
+      nodeDimensions.push_back(0);
+      nodeThresholds.push_back(0.0);
+      nodeChildren.push_back(0);
+      nodeValues.push_back(0.0);
+    }
+
+    Node leftNode, rightNode;
+    leftNode.index = left;
+    leftNode.begin = node.begin;
+    leftNode.count = leftCount;
+    leftNode.sumGradients = leftGradients;
+    leftNode.sumHessians = leftHessians;
+    rightNode.index = left + 1;
+    rightNode.begin = node.begin + leftCount;
+    rightNode.count = node.count - leftCount;
+    rightNode.sumGradients = sumGradients - leftGradients;
+    rightNode.sumHessians = sumHessians - leftHessians;
+    leftNode.depth = rightNode.depth = node.depth + 1;
+
+    // Build the histogram of the smaller child, and get the histogram of the
+    // larger child by subtraction.  Children at the maximum depth do not need
+    // histograms.
+    if (maxDepth == 0 || node.depth + 1 < maxDepth)
+    {
+      const bool leftSmaller = (leftNode.count <= rightNode.count);
+      Node& smaller = leftSmaller ? leftNode : rightNode;
+      Node& larger = leftSmaller ? rightNode : leftNode;
+      BuildHistogram(bins, gradients, hessians, points, smaller.begin,
+          smaller.count, dimensions, smaller.histogram);
+      larger.histogram = std::move(node.histogram);
+      larger.histogram -= smaller.histogram;
+    }
+
+    stack.push_back(std::move(rightNode));
+    stack.push_back(std::move(leftNode));
+  }
+
+  splitDimensions = arma::Col<size_t>(nodeDimensions);
+  thresholds = arma::vec(nodeThresholds);
+  children = arma::Col<size_t>(nodeChildren);
+  values = arma::vec(nodeValues);
+}
+
+template<typename MatType>
+double XGBoostTree::Predict(const MatType& data, const size_t col) const
+{
+  size_t node = 0;
+  while (children[node] != 0)
+  {
+    node = children[node] +
+        ((data(splitDimensions[node], col) <= thresholds[node]) ? 0 : 1);
+  }
+
+  return values[node];
+}
+
+template<typename Archive>
+void XGBoostTree::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(splitDimensions));
+  ar(CEREAL_NVP(thresholds));
+  ar(CEREAL_NVP(children));
+  ar(CEREAL_NVP(values));
+}
+
+inline void XGBoostTree::BuildHistogram(const arma::Mat<unsigned char>& bins,
+                                        const arma::rowvec& gradients,
+                                        const arma::rowvec& hessians,
+                                        const arma::Col<size_t>& points,
+                                        const size_t begin,
+                                        const size_t count,
+                                        const arma::Col<size_t>& dimensions,
+                                        arma::mat& histogram)
+{
+  histogram.zeros(2 * MaxBins, dimensions.n_elem);
+
+  #pragma omp parallel for schedule(static) \
+      if (count * dimensions.n_elem >= ParallelMinWork)
+  for (size_t d = 0; d < dimensions.n_elem; ++d)
+  {
+    const unsigned char* dimBins = bins.colptr(dimensions[d]);
+    double* dimHistogram = histogram.colptr(d);
+    for (size_t i = begin; i < begin + count; ++i)
+    {
+      const size_t p = points[i];
+      dimHistogram[2 * dimBins[p]] += gradients[p];
+      dimHistogram[2 * dimBins[p] + 1] += hessians[p];
+    }
+  }
+}
+
+inline double XGBoostTree::ThresholdL1(const double sumGradients,
+                                       const double alpha)
+{
+  if (sumGradients > alpha)
+    return sumGradients - alpha;
+  else if (sumGradients < -alpha)
+    return sumGradients + alpha;
+
+  return 0.0;
+}
+
+} // namespace mlpack
+
+#endif
@@ -1104,3 +1104,43 @@ TEMPLATE_TEST_CASE("AdaBoostTrainOverloads", "[AdaBoostTest]", fmat, mat)
   REQUIRE(a3.WeakLearner(0).MaxIterations() == 1000);
   REQUIRE(a4.WeakLearner(0).MaxIterations() == 100);
 }
+
+// Make sure that batch classification, which is done in blocks of points (in
+// parallel with OpenMP), gives the same results as classifying each point on
+// its own.
+TEMPLATE_TEST_CASE("AdaBoostBatchClassifyMatchesSinglePoint", "[AdaBoostTest]",
+    mat, fmat)
+{
+  typedef TestType MatType;
+  typedef typename MatType::elem_type eT;
+
+  // Use enough points for several blocks, with a partial last block.
+  MatType data = randu<MatType>(5, 2500);
+  Row<size_t> labels(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    labels[i] = (data(0, i) + data(1, i) > 1.0) ? 1 : 0;
+
+  typedef Perceptron<SimpleWeightUpdate, ZeroInitialization, MatType>
+      PerceptronType;
+  AdaBoost<PerceptronType, MatType> ab(data, labels, 2, 10, 1e-10, 100);
+
+  Row<size_t> predictions;
+  MatType probabilities;
+  ab.Classify(data, predictions, probabilities);
+
+  REQUIRE(predictions.n_elem == data.n_cols);
+  REQUIRE(probabilities.n_rows == 2);
+  REQUIRE(probabilities.n_cols == data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    size_t prediction;
+    Row<eT> pointProbabilities;
+    ab.Classify(data.col(i), prediction, pointProbabilities);
+
+    REQUIRE(predictions[i] == prediction);
+    REQUIRE(probabilities(0, i) ==
+        Approx(pointProbabilities[0]).epsilon(1e-5));
+    REQUIRE(probabilities(1, i) ==
+        Approx(pointProbabilities[1]).epsilon(1e-5));
+  }
+}
@@ -276,6 +276,33 @@ TEST_CASE("AKNNSingleSpillTreeTest", "[AKNNTest]")
     REQUIRE_RELATIVE_ERR(distancesSPTree(i), distancesExact(i), 0.05);
 }
 
+/**
+ * Make sure that defeatist search on a compact spill tree finds the same
+ * neighbors as on the tree it was compacted from.
+ */
+TEST_CASE("AKNNSingleCompactSpillTreeTest", "[AKNNTest]")
+{
+  arma::mat dataset;
+  dataset.randu(5, 1000);
+
+  const size_t k = 5;
+
+  SpillKNN::Tree tree(dataset, 0.1 /* tau */);
+  SpillKNN::Tree compactTree(tree);
+  compactTree.Compact();
+
+  SpillKNN search(std::move(tree), SINGLE_TREE_MODE);
+  SpillKNN compactSearch(std::move(compactTree), SINGLE_TREE_MODE);
+
+  arma::Mat<size_t> neighbors, compactNeighbors;
+  arma::mat distances, compactDistances;
+  search.Search(dataset, k, neighbors, distances);
+  compactSearch.Search(dataset, k, compactNeighbors, compactDistances);
+
+  for (size_t i = 0; i < distances.n_elem; ++i)
+    REQUIRE(compactDistances(i) == Approx(distances(i)).epsilon(1e-12));
+}
+
 /**
  * Make sure sparse nearest neighbors works with kd trees.
  */
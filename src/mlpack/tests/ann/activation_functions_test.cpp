@@ -864,3 +864,93 @@ TEST_CASE("BipolaSigmoidFunctionTest", "[ActivationFunctionsTest]")
       inputTemp, -2, 2);
   REQUIRE(maxRelativeError <= 1e-3);
 }
+
+/**
+ * Return the largest error of the given approximation, relative to the larger
+ * of 1 and the exact value.
+ */
+double MaxScaledError(const arma::mat& approximation, const arma::mat& exact)
+{
+  return arma::max(arma::vectorise(arma::abs(approximation - exact) /
+      arma::clamp(arma::abs(exact), 1.0, arma::datum::inf)));
+}
+
+/**
+ * Check the fast approximation of an activation function and its derivative
+ * against the exact functions, with both double and float matrices.
+ */
+template<typename FastFunction, typename ExactFunction>
+void CheckFastActivation(const double lower, const double upper)
+{
+  const arma::mat input = arma::linspace<arma::rowvec>(lower, upper, 1001);
+
+  arma::mat exact, exactDerivative;
+  ExactFunction::Fn(input, exact);
+  ExactFunction::Deriv(input, exact, exactDerivative);
+
+  arma::mat fast, fastDerivative;
+  FastFunction::Fn(input, fast);
+  FastFunction::Deriv(input, fast, fastDerivative);
+
+  REQUIRE(MaxScaledError(fast, exact) <= 1e-12);
+  REQUIRE(MaxScaledError(fastDerivative, exactDerivative) <= 1e-10);
+
+  // The scalar overloads give the same results.
+  for (size_t i = 0; i < input.n_elem; ++i)
+  {
+    REQUIRE(FastFunction::Fn(input(i)) == Approx(fast(i)).margin(1e-15));
+    REQUIRE(FastFunction::Deriv(input(i), fast(i)) ==
+        Approx(fastDerivative(i)).margin(1e-15));
+  }
+
+  const arma::fmat inputFloat = arma::conv_to<arma::fmat>::from(input);
+  arma::fmat fastFloat, fastFloatDerivative;
+  FastFunction::Fn(inputFloat, fastFloat);
+  FastFunction::Deriv(inputFloat, fastFloat, fastFloatDerivative);
+
+  REQUIRE(MaxScaledError(arma::conv_to<arma::mat>::from(fastFloat), exact) <=
+      1e-5);
+  REQUIRE(MaxScaledError(arma::conv_to<arma::mat>::from(fastFloatDerivative),
+      exactDerivative) <= 1e-5);
+}
+
+/**
+ * Test FastExp() against std::exp(), and the fast activation functions against
+ * the exact ones.
+ */
+TEST_CASE("FastActivationFunctionsTest", "[ActivationFunctionsTest]")
+{
+  for (double x = -700.0; x <= 700.0; x += 0.37)
+  {
+    REQUIRE(FastExp(x) == Approx(std::exp(x)).epsilon(1e-15));
+    if (std::abs(x) < 87.0)
+    {
+      REQUIRE(FastExp((float) x) ==
+          Approx(std::exp((float) x)).epsilon(1e-6));
+    }
+  }
+
+  // Large inputs are clamped, and NaN is propagated.
+  REQUIRE(std::isfinite(FastExp(1e4)));
+  REQUIRE(FastExp(-1e4) > 0.0);
+  REQUIRE(FastExp(-1e4) < 1e-300);
+  REQUIRE(std::isnan(FastExp(arma::datum::nan)));
+
+  CheckFastActivation<FastLogisticFunction, LogisticFunction>(-30, 30);
+  CheckFastActivation<FastTanhFunction, TanhFunction>(-20, 20);
+  CheckFastActivation<FastSwishFunction, SwishFunction>(-30, 30);
+  CheckFastActivation<FastMishFunction, MishFunction>(-20, 20);
+
+  // GELUFunction::Deriv() uses constants rounded to 6 digits, so only the
+  // forward pass is compared with it here; the Jacobian tests below check the
+  // derivatives.
+  const arma::mat input = arma::linspace<arma::rowvec>(-10, 10, 1001);
+  arma::mat exact, fast;
+  GELUFunction::Fn(input, exact);
+  FastGELUFunction::Fn(input, fast);
+  REQUIRE(MaxScaledError(fast, exact) <= 1e-12);
+
+  arma::mat inputTemp(10, 1);
+  REQUIRE(ActivationJacobianTest<FastGELUFunction>(inputTemp, -3, 3) <= 1e-3);
+  REQUIRE(ActivationJacobianTest<FastMishFunction>(inputTemp, -3, 3) <= 1e-3);
+}
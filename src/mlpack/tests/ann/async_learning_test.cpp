@@ -233,3 +233,108 @@ TEST_CASE("NStepQLearningTest", "[AsyncLearningTest]")
   agent.Train(measure);
   Log::Debug << "Total test episodes: " << testEpisodes << std::endl;
 }
+
+// Make sure the shared parameters only copy newly published parameters, and
+// copy them in place.
+TEST_CASE("SharedParametersTest", "[AsyncLearningTest]")
+{
+  arma::mat initial(10, 1, arma::fill::randu);
+  SharedParameters target(initial);
+  REQUIRE(target.Version() == 0);
+
+  arma::mat local(initial);
+  const double* memory = local.memptr();
+  size_t version = 0;
+  REQUIRE(!target.Update(local, version));
+
+  for (size_t i = 1; i <= 3; ++i)
+  {
+    arma::mat published(10, 1, arma::fill::randu);
+    target.Publish(published);
+    REQUIRE(target.Version() == i);
+
+    REQUIRE(target.Update(local, version));
+    REQUIRE(version == i);
+    REQUIRE(local.memptr() == memory);
+    REQUIRE(arma::approx_equal(local, published, "absdiff", 1e-10));
+
+    // Nothing new has been published.
+    REQUIRE(!target.Update(local, version));
+  }
+}
+
+// Make sure that readers never see a mix of two publications, while another
+// thread keeps publishing.
+TEST_CASE("SharedParametersConcurrentTest", "[AsyncLearningTest]")
+{
+  // Publication i fills the parameters with i, so a copy is consistent if all
+  // its elements are equal to its version.
+  const size_t numPublications = 500;
+  const size_t numReaders = 3;
+  SharedParameters shared(arma::mat(10000, 1, arma::fill::zeros));
+
+  size_t inconsistent = 0;
+  #pragma omp parallel for schedule(static, 1) reduction(+:inconsistent)
+  for (size_t task = 0; task <= numReaders; ++task)
+  {
+    if (task == 0)
+    {
+      arma::mat published(10000, 1);
+      for (size_t i = 1; i <= numPublications; ++i)
+      {
+        published.fill((double) i);
+        shared.Publish(published);
+      }
+      continue;
+    }
+
+    arma::mat local(10000, 1, arma::fill::zeros);
+    size_t version = 0;
+    while (version < numPublications)
+    {
+      if (!shared.Update(local, version))
+        continue;
+
+      if (arma::any(local.col(0) != (double) version))
+        ++inconsistent;
+    }
+  }
+
+  REQUIRE(inconsistent == 0);
+  REQUIRE(shared.Version() == numPublications);
+}
+
+// Make sure that several workers can publish at the same time, as the workers
+// of AsyncLearning do, while the others copy the target network.
+TEST_CASE("SharedParametersConcurrentPublishTest", "[AsyncLearningTest]")
+{
+  // Each task writes its own id into every element of the parameters, so a
+  // consistent copy has all its elements equal.
+  const size_t numTasks = 6;
+  const size_t numSteps = 300;
+  SharedParameters target(arma::mat(5000, 1, arma::fill::zeros));
+
+  size_t inconsistent = 0;
+  #pragma omp parallel for schedule(static, 1) reduction(+:inconsistent)
+  for (size_t task = 0; task < numTasks; ++task)
+  {
+    arma::mat published(5000, 1);
+    published.fill((double) (task + 1));
+    arma::mat local(5000, 1, arma::fill::zeros);
+    size_t version = 0;
+    for (size_t step = 0; step < numSteps; ++step)
+    {
+      if (step % 3 == 0)
+        target.Publish(published);
+
+      if (target.Update(local, version) && arma::any(local.col(0) !=
+          local(0, 0)))
+      {
+        ++inconsistent;
+      }
+    }
+  }
+
+  REQUIRE(inconsistent == 0);
+  REQUIRE(target.Version() == numTasks * ((numSteps + 2) / 3));
+}
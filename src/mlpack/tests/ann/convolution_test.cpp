@@ -183,6 +183,14 @@ TEST_CASE("ValidConvolution2DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution2DMethodTest<SVDConvolution<ValidConvolution> >(input, filter,
       output);
+
+  // Perform the convolution through matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<ValidConvolution> >(input, filter,
+      output);
+
+  // Perform the convolution with the Winograd algorithm.
+  Convolution2DMethodTest<WinogradConvolution<ValidConvolution> >(input, filter,
+      output);
 }
 
 /**
@@ -220,6 +228,14 @@ TEST_CASE("FullConvolution2DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution2DMethodTest<SVDConvolution<FullConvolution> >(input, filter,
       output);
+
+  // Perform the convolution through matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output);
+
+  // Perform the convolution with the Winograd algorithm.
+  Convolution2DMethodTest<WinogradConvolution<FullConvolution> >(input, filter,
+      output);
 }
 
 /**
@@ -265,6 +281,10 @@ TEST_CASE("ValidConvolution3DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution3DMethodTest<SVDConvolution<ValidConvolution> >(inputCube,
       filterCube, outputCube);
+
+  // Perform the convolution through matrix multiplication.
+  Convolution3DMethodTest<Im2ColConvolution<ValidConvolution> >(inputCube,
+      filterCube, outputCube);
 }
 
 /**
@@ -314,6 +334,10 @@ TEST_CASE("FullConvolution3DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution3DMethodTest<SVDConvolution<FullConvolution> >(inputCube,
       filterCube, outputCube);
+
+  // Perform the convolution through matrix multiplication.
+  Convolution3DMethodTest<Im2ColConvolution<FullConvolution> >(inputCube,
+      filterCube, outputCube);
 }
 
 /**
@@ -356,6 +380,10 @@ TEST_CASE("ValidConvolutionBatchTest", "[ConvolutionTest]")
   // speed up the computation.
   ConvolutionMethodBatchTest<SVDConvolution<ValidConvolution> >(input,
       filterCube, outputCube);
+
+  // Perform the convolution through matrix multiplication.
+  ConvolutionMethodBatchTest<Im2ColConvolution<ValidConvolution> >(input,
+      filterCube, outputCube);
 }
 
 /**
@@ -402,6 +430,10 @@ TEST_CASE("FullConvolutionBatchTest", "[ConvolutionTest]")
   // speed up the computation.
   ConvolutionMethodBatchTest<SVDConvolution<FullConvolution> >(input,
       filterCube, outputCube);
+
+  // Perform the convolution through matrix multiplication.
+  ConvolutionMethodBatchTest<Im2ColConvolution<FullConvolution> >(input,
+      filterCube, outputCube);
 }
 
 /**
@@ -468,6 +500,10 @@ TEST_CASE("UnequalStrideConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 3, 2, 1, 1);
+
+  // Perform the convolution through matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 3, 2, 1, 1);
 }
 
 TEST_CASE("Dilation2ConvolutionTest", "[ConvolutionTest]")
@@ -541,6 +577,10 @@ TEST_CASE("UnequalDilationConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 1, 1, 3, 2);
+
+  // Perform the convolution through matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 1, 1, 3, 2);
 }
 
 TEST_CASE("DilationAndStrideConvolutionTest", "[ConvolutionTest]")
@@ -562,4 +602,63 @@ TEST_CASE("DilationAndStrideConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 2, 2, 2, 2);
+
+  // Perform the convolution through matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 2, 2, 2, 2);
+}
+
+/**
+ * Make sure that the Winograd convolution gives the same results as the naive
+ * convolution for inputs of odd and even sizes, and that it falls back to the
+ * naive convolution for other filter sizes and strides.
+ */
+TEST_CASE("WinogradConvolutionTest", "[ConvolutionTest]")
+{
+  arma::mat filter(3, 3, arma::fill::randn);
+  for (size_t rows = 3; rows < 8; ++rows)
+  {
+    for (size_t cols = 3; cols < 8; ++cols)
+    {
+      arma::mat input(rows, cols, arma::fill::randn);
+
+      arma::mat output, winogradOutput;
+      NaiveConvolution<ValidConvolution>::Convolution(input, filter, output);
+      WinogradConvolution<ValidConvolution>::Convolution(input, filter,
+          winogradOutput);
+      CheckMatrices(output, winogradOutput);
+
+      NaiveConvolution<FullConvolution>::Convolution(input, filter, output);
+      WinogradConvolution<FullConvolution>::Convolution(input, filter,
+          winogradOutput);
+      CheckMatrices(output, winogradOutput);
+
+      // The transformed filter can be reused, and the results can be added to
+      // an existing output.
+      arma::mat transformedFilter;
+      WinogradConvolution<>::TransformFilter(filter, transformedFilter);
+      NaiveConvolution<ValidConvolution>::Convolution(input, filter, output);
+      winogradOutput.ones(output.n_rows, output.n_cols);
+      WinogradConvolution<>::TransformedConvolution(input, transformedFilter,
+          winogradOutput, true);
+      CheckMatrices(arma::mat(output + 1), winogradOutput);
+    }
+  }
+
+  // Other filter sizes and strides are not supported by the Winograd
+  // algorithm.
+  REQUIRE(!WinogradConvolution<>::Supported(5, 5));
+  REQUIRE(!WinogradConvolution<>::Supported(3, 3, 2, 2));
+  arma::mat input(9, 8, arma::fill::randn);
+  arma::mat largeFilter(5, 4, arma::fill::randn);
+  arma::mat output, winogradOutput;
+  NaiveConvolution<ValidConvolution>::Convolution(input, largeFilter, output);
+  WinogradConvolution<ValidConvolution>::Convolution(input, largeFilter,
+      winogradOutput);
+  CheckMatrices(output, winogradOutput);
+
+  NaiveConvolution<ValidConvolution>::Convolution(input, filter, output, 2, 2);
+  WinogradConvolution<ValidConvolution>::Convolution(input, filter,
+      winogradOutput, 2, 2);
+  CheckMatrices(output, winogradOutput);
 }
@@ -714,6 +714,56 @@ TEST_CASE("FFSerializationTest", "[FeedForwardNetworkTest]")
       binaryPredictions);
 }
 
+/**
+ * Test that a network saved with SaveMapped() and loaded with LoadMapped()
+ * gives the same predictions, without copying its parameters.
+ */
+TEST_CASE("FFNMappedTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(10, 50, arma::fill::randu);
+
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(8);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(3);
+  model.Add<LogSoftMax>();
+  model.Reset(10);
+
+  arma::mat predictions;
+  model.Predict(data, predictions);
+
+  model.SaveMapped("ffn_model_mapped.bin");
+  // The network must be unchanged after saving.
+  arma::mat savedPredictions;
+  model.Predict(data, savedPredictions);
+  CheckMatrices(savedPredictions, predictions);
+
+  FFN<NegativeLogLikelihood> loaded;
+  loaded.Add<Linear>(10); // Layer that will get removed.
+  loaded.LoadMapped("ffn_model_mapped.bin");
+  REQUIRE(loaded.IsMapped());
+  CheckMatrices(loaded.Parameters(), model.Parameters());
+
+  arma::mat mappedPredictions;
+  loaded.Predict(data, mappedPredictions);
+  CheckMatrices(mappedPredictions, predictions);
+
+  // A copy of a mapped network owns its parameters.
+  FFN<NegativeLogLikelihood> copy(loaded);
+  REQUIRE(!copy.IsMapped());
+  arma::mat copyPredictions;
+  copy.Predict(data, copyPredictions);
+  CheckMatrices(copyPredictions, predictions);
+
+  // Changing the parameters of the mapped network does not modify the file.
+  loaded.Parameters().zeros();
+  FFN<NegativeLogLikelihood> reloaded;
+  reloaded.LoadMapped("ffn_model_mapped.bin");
+  CheckMatrices(reloaded.Parameters(), model.Parameters());
+
+  remove("ffn_model_mapped.bin");
+}
+
 /**
  * Test the overload of Forward function which allows partial forward pass.
  */
@@ -763,6 +813,531 @@ TEST_CASE("PartialForwardTest", "[FeedForwardNetworkTest]")
   CheckMatrices(output, arma::ones(10, 1) * 20);
 }
 
+/**
+ * Make sure that Predict(), which only keeps two buffers for the outputs of the
+ * layers, gives the same results as Forward(), and that the network can still
+ * be trained afterwards.
+ */
+TEST_CASE("FFNPredictInferenceMemoryTest", "[FeedForwardNetworkTest]")
+{
+  FFN<MeanSquaredError, RandomInitialization> model;
+  model.Add<Linear>(20);
+  model.Add<ReLU>();
+  model.Add<Linear>(7);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(13);
+  model.Add<ReLU>();
+  model.Add<Linear>(3);
+
+  arma::mat data(10, 50, arma::fill::randu);
+  arma::mat responses(3, 50, arma::fill::randu);
+  model.Reset(10);
+
+  arma::mat forwardOutput, predictions;
+  model.Forward(data, forwardOutput);
+  model.Predict(data, predictions, 16);
+  CheckMatrices(forwardOutput, predictions);
+
+  // A forward and backward pass must still work after prediction.
+  arma::mat gradient;
+  model.Forward(data, forwardOutput);
+  model.Backward(data, responses, gradient);
+  REQUIRE(gradient.n_elem == model.Parameters().n_elem);
+  REQUIRE(gradient.is_finite());
+
+  ens::StandardSGD opt(0.01, 1, 100, -100, false);
+  model.Train(data, responses, opt);
+  model.SetNetworkMode(false);
+
+  model.Forward(data, forwardOutput);
+  model.Predict(data, predictions);
+  CheckMatrices(forwardOutput, predictions);
+}
+
+/**
+ * Test that folding the BatchNorm layers of a trained network into the
+ * previous Linear and Convolution layers does not change the predictions.
+ */
+TEST_CASE("FFNFuseLayersTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(10, 50, arma::fill::randu);
+  arma::mat responses(3, 50, arma::fill::randu);
+  ens::StandardSGD opt(0.01, 10, 500, -100, false);
+
+  FFN<MeanSquaredError, RandomInitialization> model;
+  model.Add<Linear>(20);
+  model.Add<BatchNorm>();
+  model.Add<ReLU>();
+  model.Add<Linear>(7);
+  model.Add<BatchNorm>();
+  model.Add<Sigmoid>();
+  model.Add<Linear>(3);
+  model.Train(data, responses, opt);
+
+  arma::mat predictions, fusedPredictions;
+  model.Predict(data, predictions);
+  REQUIRE(model.FuseLayers() == 2);
+  REQUIRE(model.Network().size() == 5);
+  REQUIRE(model.Parameters().n_elem == model.WeightSize());
+  model.Predict(data, fusedPredictions);
+  CheckMatrices(predictions, fusedPredictions);
+
+  // Nothing is left to fuse.
+  REQUIRE(model.FuseLayers() == 0);
+
+  // Convolution layers are folded per output map.
+  arma::mat images(36, 50, arma::fill::randu);
+  FFN<MeanSquaredError, RandomInitialization> convModel;
+  convModel.Add<Convolution>(4, 3, 3);
+  convModel.Add<BatchNorm>();
+  convModel.Add<ReLU>();
+  convModel.Add<Linear>(3);
+  convModel.InputDimensions() = std::vector<size_t>({ 6, 6 });
+  convModel.Train(images, responses, opt);
+
+  convModel.Predict(images, predictions);
+  REQUIRE(convModel.FuseLayers() == 1);
+  convModel.Predict(images, fusedPredictions);
+  CheckMatrices(predictions, fusedPredictions);
+}
+
+/**
+ * Test that the predictions of a quantized network are close to the
+ * predictions of the original network, and that a quantized network can be
+ * serialized.
+ */
+TEST_CASE("FFNQuantizeTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat images(64, 100, arma::fill::randu);
+  arma::mat responses(3, 100, arma::fill::randu);
+  ens::StandardSGD opt(0.01, 10, 500, -100, false);
+
+  FFN<MeanSquaredError, RandomInitialization> model;
+  model.Add<Convolution>(4, 3, 3, 1, 1, 1, 1);
+  model.Add<ReLU>();
+  model.Add<Linear>(20);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(3);
+  model.InputDimensions() = std::vector<size_t>({ 8, 8 });
+  model.Train(images, responses, opt);
+
+  arma::mat predictions, quantizedPredictions;
+  model.Predict(images, predictions);
+  REQUIRE(model.Quantize(images) == 3);
+  REQUIRE(model.Parameters().n_elem == 0);
+  model.Predict(images, quantizedPredictions);
+
+  // The quantization error is small compared to the range of the outputs.
+  const double range = arma::max(arma::max(arma::abs(predictions)));
+  REQUIRE(arma::abs(predictions - quantizedPredictions).max() <
+      0.05 * range);
+
+  FFN<MeanSquaredError, RandomInitialization> xmlModel, jsonModel, binaryModel;
+  SerializeObjectAll(model, xmlModel, jsonModel, binaryModel);
+
+  arma::mat xmlPredictions, jsonPredictions, binaryPredictions;
+  xmlModel.Predict(images, xmlPredictions);
+  jsonModel.Predict(images, jsonPredictions);
+  binaryModel.Predict(images, binaryPredictions);
+  CheckMatrices(quantizedPredictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+}
+
+/**
+ * Test that a pruned network stores only the nonzero blocks of the pruned
+ * weights, that its predictions match those of the dense network with the same
+ * pruned weights, and that it can be serialized.
+ */
+TEST_CASE("FFNPruneTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(30, 50, arma::fill::randu);
+
+  FFN<MeanSquaredError, RandomInitialization> model;
+  model.Add<Linear>(20);
+  model.Add<ReLU>();
+  model.Add<LinearNoBias>(3);
+  model.Reset(30);
+
+  REQUIRE_THROWS_AS(model.Prune(1.5), std::invalid_argument);
+
+  // Prune the weights of the original layers by hand.
+  const Linear* linear = dynamic_cast<const Linear*>(model.Network()[0]);
+  const LinearNoBias* linearNoBias =
+      dynamic_cast<const LinearNoBias*>(model.Network()[2]);
+  REQUIRE(linear != nullptr);
+  REQUIRE(linearNoBias != nullptr);
+  arma::mat weight1 = linear->Weight();
+  const arma::mat bias1 = linear->Bias();
+  arma::mat weight2 = arma::reshape(linearNoBias->Parameters(), 3, 20);
+  PruneBlocks(weight1, 0.75, 4, 3);
+  PruneBlocks(weight2, 0.75, 4, 3);
+
+  REQUIRE(model.Prune(0.75, 4, 3) == 2);
+  REQUIRE(model.Parameters().n_elem == 0);
+
+  // 20x30 weights give 5x10 blocks, of which 37 are pruned; 3x20 weights give
+  // 1x7 blocks (the last ones are smaller), of which 5 are pruned.
+  const BlockSparseLinear* sparse1 =
+      dynamic_cast<const BlockSparseLinear*>(model.Network()[0]);
+  const BlockSparseLinear* sparse2 =
+      dynamic_cast<const BlockSparseLinear*>(model.Network()[2]);
+  REQUIRE(sparse1 != nullptr);
+  REQUIRE(sparse2 != nullptr);
+  REQUIRE(sparse1->NonzeroBlocks() == 13);
+  REQUIRE(sparse2->NonzeroBlocks() == 2);
+
+  arma::mat denseWeight1, denseWeight2;
+  sparse1->DenseWeight(denseWeight1);
+  sparse2->DenseWeight(denseWeight2);
+  CheckMatrices(denseWeight1, weight1);
+  CheckMatrices(denseWeight2, weight2);
+  REQUIRE(arma::accu(weight1 == 0) >= 37 * 12);
+
+  arma::mat predictions;
+  model.Predict(data, predictions);
+  arma::mat hidden = weight1 * data;
+  hidden.each_col() += bias1;
+  hidden.elem(arma::find(hidden < 0)).zeros();
+  const arma::mat expected = weight2 * hidden;
+  CheckMatrices(predictions, expected);
+
+  FFN<MeanSquaredError, RandomInitialization> xmlModel, jsonModel, binaryModel;
+  SerializeObjectAll(model, xmlModel, jsonModel, binaryModel);
+
+  arma::mat xmlPredictions, jsonPredictions, binaryPredictions;
+  xmlModel.Predict(data, xmlPredictions);
+  jsonModel.Predict(data, jsonPredictions);
+  binaryModel.Predict(data, binaryPredictions);
+  CheckMatrices(predictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+}
+
+/**
+ * Test that a single-precision network trained with mixed precision learns a
+ * simple regression problem, and that the loss scale is reduced when the
+ * scaled gradient overflows.
+ */
+TEST_CASE("FFNMixedPrecisionTest", "[FeedForwardNetworkTest]")
+{
+  arma::fmat data(5, 200, arma::fill::randu);
+  arma::fmat responses = arma::sum(data, 0) / 5;
+
+  FFN<MeanSquaredError, RandomInitialization, arma::fmat> model;
+  model.Add<LinearType<arma::fmat>>(10);
+  model.Add<SigmoidType<arma::fmat>>();
+  model.Add<LinearType<arma::fmat>>(1);
+
+  model.Reset(5);
+  const double initialObjective = model.Evaluate(data, responses);
+
+  ens::Adam opt(0.01, 10, 0.9, 0.999, 1e-8, 2000, -1, false);
+  const double objective = model.TrainMixedPrecision(data, responses, opt);
+  REQUIRE(std::isfinite(objective));
+  REQUIRE(model.Evaluate(data, responses) < 0.1 * initialObjective);
+
+  // With a huge loss scale, the gradient overflows in single precision; the
+  // step must be skipped and the scale halved.
+  model.ResetData(data, responses);
+  MixedPrecisionFunction<FFN<MeanSquaredError, RandomInitialization,
+      arma::fmat>> function(model, 1e300, 0);
+  arma::mat master = arma::conv_to<arma::mat>::from(model.Parameters());
+  arma::mat gradient;
+  function.EvaluateWithGradient(master, 0, gradient, 10);
+  REQUIRE(gradient.n_elem == master.n_elem);
+  REQUIRE(arma::all(arma::vectorise(gradient) == 0));
+  REQUIRE(function.LossScale() == Approx(5e299).epsilon(1e-5));
+  REQUIRE(model.LossScale() == 1.0);
+
+  // With a reasonable scale, the unscaled gradient matches the gradient
+  // computed without loss scaling.
+  function.LossScale() = 1024.0;
+  function.EvaluateWithGradient(master, 0, gradient, 10);
+  arma::fmat floatGradient;
+  model.EvaluateWithGradient(model.Parameters(), 0, floatGradient, 10);
+  REQUIRE(arma::approx_equal(gradient,
+      arma::conv_to<arma::mat>::from(floatGradient), "both", 1e-6, 1e-4));
+}
+
+/**
+ * Test that data-parallel training gives the same objective and gradient as
+ * training with one worker, and that it can train a network.
+ */
+TEST_CASE("FFNDataParallelTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(5, 200, arma::fill::randu);
+  arma::mat responses = arma::sum(data, 0) / 5;
+
+  FFN<MeanSquaredError> model;
+  model.Add<Linear>(10);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(1);
+
+  model.Reset(5);
+  model.ResetData(data, responses);
+
+  arma::mat gradient, parallelGradient;
+  const double objective = model.EvaluateWithGradient(model.Parameters(), 10,
+      gradient, 37);
+
+  // Use more workers than a power of two, so that the tree reduction has an
+  // uneven last level.
+  model.Workers() = 5;
+  const double parallelObjective = model.EvaluateWithGradient(
+      model.Parameters(), 10, parallelGradient, 37);
+
+  REQUIRE(parallelObjective == Approx(objective).epsilon(1e-10));
+  REQUIRE(arma::approx_equal(gradient, parallelGradient, "both", 1e-10,
+      1e-8));
+
+  // A batch smaller than the number of workers uses fewer workers.
+  model.EvaluateWithGradient(model.Parameters(), 0, gradient, 3);
+  model.Workers() = 1;
+  model.EvaluateWithGradient(model.Parameters(), 0, parallelGradient, 3);
+  REQUIRE(arma::approx_equal(gradient, parallelGradient, "both", 1e-10,
+      1e-8));
+
+  model.Workers() = 4;
+  const double initialObjective = model.Evaluate(data, responses);
+  ens::Adam opt(0.01, 32, 0.9, 0.999, 1e-8, 2000, -1, false);
+  const double finalObjective = model.Train(data, responses, opt);
+  REQUIRE(std::isfinite(finalObjective));
+  REQUIRE(model.Evaluate(data, responses) < 0.1 * initialObjective);
+}
+
+/**
+ * Test that data-parallel training leaves the parameters untouched when a
+ * layer writes to its weights during the forward pass.
+ */
+TEST_CASE("FFNDataParallelDropConnectTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(5, 200, arma::fill::randu);
+  arma::mat responses = arma::sum(data, 0) / 5;
+
+  FFN<MeanSquaredError> model;
+  model.Add<DropConnect>(10, 0.3);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(1);
+
+  model.Reset(5);
+  model.ResetData(data, responses);
+  const arma::mat parameters = model.Parameters();
+
+  model.Workers() = 4;
+  arma::mat gradient;
+  for (size_t i = 0; i < 10; ++i)
+  {
+    const double objective = model.EvaluateWithGradient(model.Parameters(),
+        0, gradient, 200);
+    REQUIRE(std::isfinite(objective));
+    REQUIRE(gradient.is_finite());
+    REQUIRE(arma::approx_equal(model.Parameters(), parameters, "absdiff",
+        0.0));
+  }
+}
+
+/**
+ * Test that BatchPipeline gives the right batches, whether or not they were
+ * prefetched, and that a network can be trained on a pipeline.
+ */
+TEST_CASE("FFNTrainPipelineTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(5, 200, arma::fill::randu);
+  arma::mat responses = arma::sum(data, 0) / 5;
+
+  BatchPipeline<MatrixLoader<>> pipeline(MatrixLoader<>(data, responses));
+  REQUIRE(pipeline.NumPoints() == 200);
+
+  // The second batch is prefetched; the third one is not.
+  arma::mat predictorsBatch, responsesBatch;
+  pipeline.Batch(0, 32, predictorsBatch, responsesBatch);
+  REQUIRE(arma::approx_equal(predictorsBatch, data.cols(0, 31), "absdiff",
+      0.0));
+  pipeline.Batch(32, 32, predictorsBatch, responsesBatch);
+  REQUIRE(arma::approx_equal(predictorsBatch, data.cols(32, 63), "absdiff",
+      0.0));
+  pipeline.Batch(100, 10, predictorsBatch, responsesBatch);
+  REQUIRE(arma::approx_equal(responsesBatch, responses.cols(100, 109),
+      "absdiff", 0.0));
+
+  // After shuffling, the batches follow the new order.
+  pipeline.Shuffle();
+  const arma::uvec order = pipeline.Order();
+  REQUIRE(arma::all(arma::sort(order) == arma::regspace<arma::uvec>(0, 199)));
+  pipeline.Batch(0, 10, predictorsBatch, responsesBatch);
+  REQUIRE(arma::approx_equal(predictorsBatch,
+      data.cols(order.subvec(0, 9)), "absdiff", 0.0));
+  pipeline.Batch(190, 10, predictorsBatch, responsesBatch);
+  REQUIRE(arma::approx_equal(predictorsBatch,
+      data.cols(order.subvec(190, 199)), "absdiff", 0.0));
+
+  REQUIRE_THROWS_AS(pipeline.Batch(195, 10, predictorsBatch, responsesBatch),
+      std::invalid_argument);
+
+  FFN<MeanSquaredError> model;
+  model.Add<Linear>(10);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(1);
+
+  model.Reset(5);
+  const double initialObjective = model.Evaluate(data, responses);
+
+  ens::Adam opt(0.01, 32, 0.9, 0.999, 1e-8, 2000, -1, true);
+  const double objective = model.TrainPipeline(pipeline, opt);
+  REQUIRE(std::isfinite(objective));
+  REQUIRE(model.Evaluate(data, responses) < 0.1 * initialObjective);
+}
+
+/**
+ * Test that predicting with several workers gives the same predictions as
+ * predicting with one worker.
+ */
+TEST_CASE("FFNParallelPredictTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(5, 200, arma::fill::randu);
+
+  FFN<MeanSquaredError> model;
+  model.Add<Linear>(10);
+  model.Add<LeakyReLU>();
+  model.Add<Linear>(10);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(2);
+  model.Reset(5);
+
+  arma::mat predictions, parallelPredictions;
+  model.Predict(data, predictions, 16);
+
+  // 200 points give 13 batches, which are not split evenly between the
+  // workers.
+  model.Workers() = 3;
+  model.Predict(data, parallelPredictions, 16);
+  REQUIRE(arma::approx_equal(predictions, parallelPredictions, "absdiff",
+      0.0));
+
+  // With fewer batches than workers, only some of the workers are used.
+  model.Workers() = 8;
+  model.Predict(data, parallelPredictions, 64);
+  REQUIRE(arma::approx_equal(predictions, parallelPredictions, "absdiff",
+      1e-12));
+  model.Predict(data, parallelPredictions, 256);
+  REQUIRE(arma::approx_equal(predictions, parallelPredictions, "absdiff",
+      1e-12));
+}
+
+/**
+ * Test that the LayerProfiler records the passes and the outputs of each layer,
+ * and that nothing is recorded when it is removed.
+ */
+TEST_CASE("FFNLayerProfilerTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(5, 200, arma::fill::randu);
+  arma::mat responses = arma::sum(data, 0) / 5;
+
+  FFN<MeanSquaredError> model;
+  model.Add<Linear>(10);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(1);
+
+  model.Reset(5);
+  model.ResetData(data, responses);
+
+  LayerProfiler profiler;
+  model.Profiler() = &profiler;
+
+  arma::mat gradient;
+  model.EvaluateWithGradient(model.Parameters(), 0, gradient, 50);
+
+  const std::vector<LayerProfiler::LayerProfile>& profiles =
+      profiler.Profiles();
+  REQUIRE(profiles.size() == 3);
+  REQUIRE(profiles[0].name == "Linear");
+  REQUIRE(profiles[2].name == "Linear");
+  for (size_t i = 0; i < 3; ++i)
+  {
+    REQUIRE(profiles[i].calls[LayerProfiler::FORWARD] == 1);
+    REQUIRE(profiles[i].calls[LayerProfiler::BACKWARD] == 1);
+    REQUIRE(profiles[i].calls[LayerProfiler::GRADIENT] == 1);
+    REQUIRE(profiles[i].outputRows == ((i == 2) ? 1 : 10));
+    REQUIRE(profiles[i].outputCols == 50);
+    REQUIRE(profiles[i].outputBytes == profiles[i].outputRows * 50 *
+        sizeof(double));
+  }
+  REQUIRE(profiles[1].deltaBytes == 10 * 50 * sizeof(double));
+
+  // Prediction is done in two batches, without backward passes.
+  arma::mat predictions;
+  model.Predict(data, predictions, 128);
+  REQUIRE(profiles[0].calls[LayerProfiler::FORWARD] == 3);
+  REQUIRE(profiles[0].calls[LayerProfiler::BACKWARD] == 1);
+  REQUIRE(profiles[2].outputCols == 72);
+
+  std::ostringstream json;
+  profiler.ExportJSON(json);
+  REQUIRE(json.str().find("\"type\": \"Linear\"") != std::string::npos);
+  REQUIRE(json.str().find("\"calls\": 3") != std::string::npos);
+
+  model.Profiler() = nullptr;
+  model.Predict(data, predictions);
+  REQUIRE(profiles[0].calls[LayerProfiler::FORWARD] == 3);
+
+  profiler.Reset();
+  REQUIRE(profiler.Profiles().empty());
+}
+
+/**
+ * Test that ImageLoader reads, decodes and scales the images of a batch.
+ */
+TEST_CASE("ImageLoaderTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat image;
+  data::ImageInfo info;
+  if (!data::Load("test_image.png", image, info, false))
+    FAIL("Cannot load test_image.png");
+
+  ImageLoader<> loader(std::vector<std::string>(3, "test_image.png"),
+      arma::mat("0 1 2"), info);
+  REQUIRE(loader.NumPoints() == 3);
+
+  arma::mat predictors, responses;
+  loader.Load(arma::uvec("2 0"), predictors, responses);
+  REQUIRE(predictors.n_rows == image.n_elem);
+  REQUIRE(predictors.n_cols == 2);
+  REQUIRE(arma::approx_equal(predictors.col(0), image / 255, "absdiff",
+      1e-12));
+  REQUIRE(arma::approx_equal(predictors.col(1), image / 255, "absdiff",
+      1e-12));
+  REQUIRE(responses(0) == 2);
+  REQUIRE(responses(1) == 0);
+
+  // Each image is either unchanged or mirrored.
+  arma::mat mirrored(image.n_rows, 1);
+  for (size_t y = 0; y < info.Height(); ++y)
+  {
+    for (size_t x = 0; x < info.Width(); ++x)
+    {
+      for (size_t c = 0; c < info.Channels(); ++c)
+      {
+        mirrored((y * info.Width() + x) * info.Channels() + c) =
+            image((y * info.Width() + info.Width() - 1 - x) * info.Channels() +
+            c);
+      }
+    }
+  }
+
+  arma::mat images = arma::repmat(image, 1, 20);
+  RandomFlipImageTransform().Transform(images, info);
+  for (size_t i = 0; i < images.n_cols; ++i)
+  {
+    REQUIRE((arma::approx_equal(images.col(i), image / 255, "absdiff",
+        1e-12) || arma::approx_equal(images.col(i), mirrored / 255, "absdiff",
+        1e-12)));
+  }
+
+  ImageLoader<> missing(std::vector<std::string>(1, "missing_image.png"),
+      arma::mat("0"), info);
+  REQUIRE_THROWS_AS(missing.Load(arma::uvec("0"), predictors, responses),
+      std::runtime_error);
+}
+
 /**
  * Test that FFN::Train() returns finite objective value.
  */
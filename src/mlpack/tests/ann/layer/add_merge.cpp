@@ -138,3 +138,48 @@ TEST_CASE("AddMergeAdvanceTestCase", "[ANNLayerTest]")
 
   CheckMatrices(output1, output2, 1e-3);
 }
+
+/**
+ * AddMerge numerical gradient test, with layers whose backward pass uses their
+ * own output.
+ */
+TEST_CASE("GradientAddMergeLayerTest", "[ANNLayerTest]")
+{
+  struct GradientFunction
+  {
+    GradientFunction() :
+        input(arma::randu(10, 4)),
+        target(arma::mat("0 1 1 0"))
+    {
+      model = new FFN<NegativeLogLikelihood, NguyenWidrowInitialization>();
+      model->ResetData(input, target);
+      model->Add<Linear>(5);
+
+      AddMerge* addMerge = new AddMerge();
+      addMerge->Add<Sigmoid>();
+      addMerge->Add<TanH>();
+      model->Add(addMerge);
+      model->Add<Linear>(2);
+      model->Add<LogSoftMax>();
+    }
+
+    ~GradientFunction()
+    {
+      delete model;
+    }
+
+    double Gradient(arma::mat& gradient) const
+    {
+      double error = model->Evaluate(model->Parameters(), 0, 4);
+      model->Gradient(model->Parameters(), 0, gradient, 4);
+      return error;
+    }
+
+    arma::mat& Parameters() { return model->Parameters(); }
+
+    FFN<NegativeLogLikelihood, NguyenWidrowInitialization>* model;
+    arma::mat input, target;
+  } function;
+
+  REQUIRE(CheckGradient(function) <= 1e-4);
+}
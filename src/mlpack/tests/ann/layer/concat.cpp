@@ -225,3 +225,44 @@ TEST_CASE("GradientConcatLayerTest", "[ANNLayerTest]")
 
   REQUIRE(CheckGradient(function) <= 1e-4);
 }
+
+/**
+ * Make sure that a batch gives the same results as its points one by one: the
+ * blocks of each layer are aliases of the concatenated matrices for one
+ * point, and copies for a batch.
+ */
+TEST_CASE("ConcatBatchMatchesSinglePointsTest", "[ANNLayerTest]")
+{
+  Concat module;
+  module.Add<Linear>(3);
+  module.Add<Linear>(4);
+  module.InputDimensions() = std::vector<size_t>({ 5 });
+  module.ComputeOutputDimensions();
+  arma::mat weights(module.WeightSize(), 1);
+  module.SetWeights(weights);
+  weights.randu();
+
+  arma::mat input(arma::randn(5, 6));
+  arma::mat error(arma::randn(7, 6));
+
+  arma::mat output(7, 6), delta(5, 6), gradient(module.WeightSize(), 1);
+  module.Forward(input, output);
+  module.Backward(input, output, error, delta);
+  module.Gradient(input, error, gradient);
+
+  arma::mat pointGradientSum(module.WeightSize(), 1, arma::fill::zeros);
+  for (size_t i = 0; i < input.n_cols; ++i)
+  {
+    arma::mat pointOutput(7, 1), pointDelta(5, 1),
+        pointGradient(module.WeightSize(), 1);
+    module.Forward(input.col(i), pointOutput);
+    module.Backward(input.col(i), pointOutput, error.col(i), pointDelta);
+    module.Gradient(input.col(i), error.col(i), pointGradient);
+
+    CheckMatrices(pointOutput, output.col(i));
+    CheckMatrices(pointDelta, delta.col(i));
+    pointGradientSum += pointGradient;
+  }
+
+  CheckMatrices(pointGradientSum, gradient);
+}
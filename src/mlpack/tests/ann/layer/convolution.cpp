@@ -462,3 +462,80 @@ TEST_CASE("NonSquareConvolutionTest", "[ANNLayerTest]")
   arma::mat gradientResult(module1.WeightSize(), 1);
   REQUIRE_NOTHROW(module1.Gradient(data, backwardResult, gradientResult));
 }
+
+/**
+ * Make sure that the Convolution layer gives the same forward pass, backward
+ * pass and gradient with the Im2ColConvolution rule as with the naive rule,
+ * with several input and output maps, padding, and a stride.
+ */
+TEST_CASE("GEMMConvolutionLayerTest", "[ANNLayerTest]")
+{
+  Convolution layer(4, 3, 3, 2, 2, 1, 1);
+  GEMMConvolution gemmLayer(4, 3, 3, 2, 2, 1, 1);
+  layer.InputDimensions() = std::vector<size_t>({ 9, 7, 3 });
+  gemmLayer.InputDimensions() = std::vector<size_t>({ 9, 7, 3 });
+  layer.ComputeOutputDimensions();
+  gemmLayer.ComputeOutputDimensions();
+  REQUIRE(gemmLayer.WeightSize() == layer.WeightSize());
+  REQUIRE(gemmLayer.OutputSize() == layer.OutputSize());
+
+  arma::mat weights(layer.WeightSize(), 1, arma::fill::randn);
+  layer.SetWeights(weights);
+  gemmLayer.SetWeights(weights);
+
+  arma::mat input(9 * 7 * 3, 5, arma::fill::randu);
+  arma::mat output(layer.OutputSize(), 5), gemmOutput(layer.OutputSize(), 5);
+  layer.Forward(input, output);
+  gemmLayer.Forward(input, gemmOutput);
+  CheckMatrices(output, gemmOutput);
+
+  arma::mat error(layer.OutputSize(), 5, arma::fill::randn);
+  arma::mat delta(input.n_rows, 5), gemmDelta(input.n_rows, 5);
+  layer.Backward(input, output, error, delta);
+  gemmLayer.Backward(input, gemmOutput, error, gemmDelta);
+  CheckMatrices(delta, gemmDelta);
+
+  arma::mat gradient(layer.WeightSize(), 1);
+  arma::mat gemmGradient(layer.WeightSize(), 1);
+  layer.Gradient(input, error, gradient);
+  gemmLayer.Gradient(input, error, gemmGradient);
+  CheckMatrices(gradient, gemmGradient);
+}
+
+/**
+ * Make sure that the Convolution layer gives the same results with the
+ * Winograd rule as with the naive rule, for 3x3 filters.
+ */
+TEST_CASE("WinogradConvolutionLayerTest", "[ANNLayerTest]")
+{
+  typedef ConvolutionType<
+      WinogradConvolution<ValidConvolution>,
+      WinogradConvolution<FullConvolution>,
+      NaiveConvolution<ValidConvolution>,
+      arma::mat
+  > WinogradConvolutionLayer;
+
+  Convolution layer(3, 3, 3, 1, 1, 1, 1);
+  WinogradConvolutionLayer winogradLayer(3, 3, 3, 1, 1, 1, 1);
+  layer.InputDimensions() = std::vector<size_t>({ 7, 6, 2 });
+  winogradLayer.InputDimensions() = std::vector<size_t>({ 7, 6, 2 });
+  layer.ComputeOutputDimensions();
+  winogradLayer.ComputeOutputDimensions();
+
+  arma::mat weights(layer.WeightSize(), 1, arma::fill::randn);
+  layer.SetWeights(weights);
+  winogradLayer.SetWeights(weights);
+
+  arma::mat input(7 * 6 * 2, 4, arma::fill::randu);
+  arma::mat output(layer.OutputSize(), 4);
+  arma::mat winogradOutput(layer.OutputSize(), 4);
+  layer.Forward(input, output);
+  winogradLayer.Forward(input, winogradOutput);
+  CheckMatrices(output, winogradOutput);
+
+  arma::mat error(layer.OutputSize(), 4, arma::fill::randn);
+  arma::mat delta(input.n_rows, 4), winogradDelta(input.n_rows, 4);
+  layer.Backward(input, output, error, delta);
+  winogradLayer.Backward(input, winogradOutput, error, winogradDelta);
+  CheckMatrices(delta, winogradDelta);
+}
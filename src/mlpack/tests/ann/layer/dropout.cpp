@@ -100,3 +100,47 @@ TEST_CASE("NoDropoutTest", "[ANNLayerTest]")
   REQUIRE(accu(output) == accu(input));
 }
 
+
+/**
+ * The bit-packed dropout mask must keep each element with probability
+ * 1 - ratio, be reproducible with the same seed, and give the same values when
+ * it is applied as the expanded mask.
+ */
+TEST_CASE("DropoutMaskTest", "[ANNLayerTest]")
+{
+  DropoutMask mask;
+  mask.Generate(301, 333, 0.3);
+  REQUIRE(mask.NumRows() == 301);
+  REQUIRE(mask.NumCols() == 333);
+  REQUIRE(mask.Words().size() == (301 * 333 + 63) / 64);
+
+  const double keptRatio = (double) mask.NumKept() / (301 * 333);
+  REQUIRE(keptRatio == Approx(0.7).epsilon(0.01));
+
+  const arma::mat expanded = mask.Expand<arma::mat>();
+  REQUIRE(arma::accu(expanded) == mask.NumKept());
+  for (size_t i = 0; i < expanded.n_elem; i += 97)
+    REQUIRE(expanded[i] == (mask.Kept(i) ? 1.0 : 0.0));
+
+  const arma::mat input = arma::randn<arma::mat>(301, 333);
+  arma::mat output;
+  mask.Apply(input, output, 2.0, 0.5, -1.0);
+  CheckMatrices(output, expanded % (2.0 * input + 0.5) - (1.0 - expanded));
+
+  // The same seed gives the same mask.
+  RandomSeed(17);
+  mask.Generate(50, 20, 0.5);
+  const std::vector<uint64_t> words = mask.Words();
+  RandomSeed(17);
+  mask.Generate(50, 20, 0.5);
+  REQUIRE(mask.Words() == words);
+
+  // A ratio of 0 keeps every element, and a ratio of 1 drops every element.
+  mask.Generate(10, 7, 0.0);
+  REQUIRE(mask.NumKept() == 70);
+  mask.Generate(10, 7, 1.0);
+  REQUIRE(mask.NumKept() == 0);
+
+  REQUIRE_THROWS_AS(mask.Apply(arma::mat(7, 10), output, 1.0),
+      std::invalid_argument);
+}
@@ -0,0 +1,117 @@
+/**
+ * @file tests/ann/layer/embedding.cpp
+ *
+ * Tests the Embedding layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann.hpp>
+
+#include "../../test_catch_tools.hpp"
+#include "../../catch.hpp"
+#include "../../serialization.hpp"
+#include "../ann_test_tools.hpp"
+
+using namespace mlpack;
+
+/**
+ * Make sure that the Embedding layer looks up the embedding of each token, and
+ * that only the embeddings of the tokens of the batch get a gradient.
+ */
+TEST_CASE("SimpleEmbeddingLayerTest", "[ANNLayerTest]")
+{
+  const size_t vocabSize = 50;
+  const size_t embeddingSize = 4;
+  const size_t seqLength = 3;
+
+  Embedding module(vocabSize, embeddingSize);
+  module.InputDimensions() = std::vector<size_t>({ seqLength });
+  module.ComputeOutputDimensions();
+  REQUIRE(module.OutputDimensions().size() == 2);
+  REQUIRE(module.OutputDimensions()[0] == embeddingSize);
+  REQUIRE(module.OutputDimensions()[1] == seqLength);
+
+  arma::mat weights(module.WeightSize(), 1, arma::fill::randu);
+  module.SetWeights(weights);
+
+  // Token 7 appears twice.
+  const arma::mat input("7 0 49; 12 7 3");
+  arma::mat output(embeddingSize * seqLength, 2);
+  module.Forward(input.t(), output);
+  for (size_t i = 0; i < 2; ++i)
+  {
+    for (size_t t = 0; t < seqLength; ++t)
+    {
+      CheckMatrices(output.col(i).rows(t * embeddingSize,
+          (t + 1) * embeddingSize - 1),
+          module.Weight().col((size_t) input(i, t)));
+    }
+  }
+
+  arma::mat g;
+  module.Backward(input.t(), output, output, g);
+  REQUIRE(g.n_rows == seqLength);
+  REQUIRE(g.n_cols == 2);
+  REQUIRE(arma::accu(arma::abs(g)) == 0.0);
+
+  const arma::mat error(embeddingSize * seqLength, 2, arma::fill::randu);
+  arma::mat gradient(module.WeightSize(), 1);
+  gradient.fill(1.0);
+  module.Gradient(input.t(), error, gradient);
+
+  const arma::mat embeddingGradient(gradient.memptr(), embeddingSize,
+      vocabSize, false, true);
+  CheckMatrices(embeddingGradient.col(7), error.col(0).rows(0, 3) +
+      error.col(1).rows(4, 7));
+  CheckMatrices(embeddingGradient.col(49), error.col(0).rows(8, 11));
+  REQUIRE(arma::accu(arma::abs(embeddingGradient.col(1))) == 0.0);
+  REQUIRE(arma::accu(arma::abs(embeddingGradient.col(48))) == 0.0);
+
+  // Tokens outside of the vocabulary are rejected.
+  const arma::mat badInput("1; 50; 2");
+  REQUIRE_THROWS_AS(module.Forward(badInput, output), std::invalid_argument);
+}
+
+/**
+ * Embedding layer numerical gradient test.
+ */
+TEST_CASE("GradientEmbeddingLayerTest", "[ANNLayerTest]")
+{
+  // Embedding function gradient instantiation.
+  struct GradientFunction
+  {
+    GradientFunction() :
+        input(arma::mat("0 5 9; 3 3 1; 8 2 5")),
+        target(arma::mat("1 0 1"))
+    {
+      model = new FFN<NegativeLogLikelihood, NguyenWidrowInitialization>();
+      model->ResetData(input, target);
+      model->Add<Embedding>(10, 4);
+      model->Add<Linear>(2);
+      model->Add<LogSoftMax>();
+    }
+
+    ~GradientFunction()
+    {
+      delete model;
+    }
+
+    double Gradient(arma::mat& gradient) const
+    {
+      double error = model->Evaluate(model->Parameters(), 0, 3);
+      model->Gradient(model->Parameters(), 0, gradient, 3);
+      return error;
+    }
+
+    arma::mat& Parameters() { return model->Parameters(); }
+
+    FFN<NegativeLogLikelihood, NguyenWidrowInitialization>* model;
+    arma::mat input, target;
+  } function;
+
+  REQUIRE(CheckGradient(function) <= 1e-4);
+}
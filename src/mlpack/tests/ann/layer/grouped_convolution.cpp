@@ -224,3 +224,42 @@ TEST_CASE("NonSquareGroupedConvolutionTest", "[ANNLayerTest]")
   arma::mat gradientResult(module1.WeightSize(), 1);
   REQUIRE_NOTHROW(module1.Gradient(data, backwardResult, gradientResult));
 }
+
+/**
+ * Make sure that the GroupedConvolution layer gives the same forward pass,
+ * backward pass and gradient with the Im2ColConvolution rule as with the naive
+ * rule.
+ */
+TEST_CASE("GEMMGroupedConvolutionLayerTest", "[ANNLayerTest]")
+{
+  GroupedConvolution layer(6, 3, 2, 3, 1, 1, 1, 0);
+  GEMMGroupedConvolution gemmLayer(6, 3, 2, 3, 1, 1, 1, 0);
+  layer.InputDimensions() = std::vector<size_t>({ 8, 7, 3 });
+  gemmLayer.InputDimensions() = std::vector<size_t>({ 8, 7, 3 });
+  layer.ComputeOutputDimensions();
+  gemmLayer.ComputeOutputDimensions();
+  REQUIRE(gemmLayer.WeightSize() == layer.WeightSize());
+  REQUIRE(gemmLayer.OutputSize() == layer.OutputSize());
+
+  arma::mat weights(layer.WeightSize(), 1, arma::fill::randn);
+  layer.SetWeights(weights);
+  gemmLayer.SetWeights(weights);
+
+  arma::mat input(8 * 7 * 3, 4, arma::fill::randu);
+  arma::mat output(layer.OutputSize(), 4), gemmOutput(layer.OutputSize(), 4);
+  layer.Forward(input, output);
+  gemmLayer.Forward(input, gemmOutput);
+  CheckMatrices(output, gemmOutput);
+
+  arma::mat error(layer.OutputSize(), 4, arma::fill::randn);
+  arma::mat delta(input.n_rows, 4), gemmDelta(input.n_rows, 4);
+  layer.Backward(input, output, error, delta);
+  gemmLayer.Backward(input, gemmOutput, error, gemmDelta);
+  CheckMatrices(delta, gemmDelta);
+
+  arma::mat gradient(layer.WeightSize(), 1);
+  arma::mat gemmGradient(layer.WeightSize(), 1);
+  layer.Gradient(input, error, gradient);
+  gemmLayer.Gradient(input, error, gemmGradient);
+  CheckMatrices(gradient, gemmGradient);
+}
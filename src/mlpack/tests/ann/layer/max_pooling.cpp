@@ -112,3 +112,62 @@ TEST_CASE("MaxPoolingTestCase", "[ANNLayerTest]")
   REQUIRE(output.n_elem == 4);
   REQUIRE(output.n_cols == 1);
 }
+
+/**
+ * Compare the forward and backward passes of MaxPooling with a direct
+ * computation, for windows with one-byte and two-byte offsets and for
+ * truncated windows.
+ */
+TEST_CASE("MaxPoolingOffsetsTest", "[ANNLayerTest]")
+{
+  // Each configuration is (kernel width, kernel height, stride width, stride
+  // height, floor).
+  const size_t configs[4][5] = { { 3, 3, 2, 2, 1 }, { 4, 3, 3, 2, 0 },
+                                 { 20, 17, 5, 4, 1 }, { 20, 17, 7, 9, 0 } };
+  for (size_t c = 0; c < 4; ++c)
+  {
+    const size_t kw = configs[c][0], kh = configs[c][1];
+    const size_t sw = configs[c][2], sh = configs[c][3];
+    MaxPooling module(kw, kh, sw, sh, configs[c][4] == 1);
+    module.InputDimensions() = std::vector<size_t>({ 31, 27, 2 });
+    module.ComputeOutputDimensions();
+    module.Training() = true;
+
+    const size_t outRows = module.OutputDimensions()[0];
+    const size_t outCols = module.OutputDimensions()[1];
+
+    // Use distinct values, so that each maximum is unique.
+    arma::mat input = arma::shuffle(arma::regspace(0, 31 * 27 * 2 * 3 - 1));
+    input.reshape(31 * 27 * 2, 3);
+    arma::mat output(module.OutputSize(), 3);
+    module.Forward(input, output);
+
+    arma::mat gy(arma::randu(module.OutputSize(), 3));
+    arma::mat g(input.n_rows, input.n_cols);
+    module.Backward(input, output, gy, g);
+
+    const arma::cube inputCube(input.memptr(), 31, 27, 6);
+    const arma::cube outputCube(output.memptr(), outRows, outCols, 6);
+    const arma::cube gyCube(gy.memptr(), outRows, outCols, 6);
+    arma::cube expectedG(31, 27, 6, arma::fill::zeros);
+    for (size_t s = 0; s < 6; ++s)
+    {
+      for (size_t j = 0; j < outCols; ++j)
+      {
+        for (size_t i = 0; i < outRows; ++i)
+        {
+          const arma::mat window = inputCube.slice(s).submat(i * sw, j * sh,
+              std::min(i * sw + kw, (size_t) 31) - 1,
+              std::min(j * sh + kh, (size_t) 27) - 1);
+          REQUIRE(outputCube(i, j, s) == window.max());
+
+          const arma::uword index = window.index_max();
+          expectedG(i * sw + index % window.n_rows,
+              j * sh + index / window.n_rows, s) += gyCube(i, j, s);
+        }
+      }
+    }
+
+    CheckMatrices(arma::cube(g.memptr(), 31, 27, 6), expectedG);
+  }
+}
@@ -233,3 +233,67 @@ TEST_CASE("GradientMultiheadAttentionTest", "[ANNLayerTest]")
 
   REQUIRE(CheckGradient(function) <= 3e-06);
 }
+
+/**
+ * Make sure that the blocked attention gives the same results as the attention
+ * computed without blocks, with and without masks.
+ */
+TEST_CASE("BlockedMultiheadAttentionTest", "[ANNLayerTest]")
+{
+  const size_t tLen = 5;
+  const size_t sLen = 7;
+  const size_t embedDim = 4;
+  const size_t numHeads = 2;
+  const size_t bsz = 3;
+
+  arma::mat attnMask = arma::zeros(tLen, sLen);
+  for (size_t i = 0; i < tLen; ++i)
+  {
+    for (size_t j = 0; j < sLen; ++j)
+    {
+      if (i < j)
+        attnMask(i, j) = std::numeric_limits<double>::lowest();
+    }
+  }
+
+  arma::mat keyPaddingMask = arma::zeros(1, sLen);
+  keyPaddingMask(sLen - 1) = std::numeric_limits<double>::lowest();
+
+  arma::mat input = arma::randu(embedDim * (tLen + 2 * sLen), bsz);
+  arma::mat gy = 0.01 * arma::randu(embedDim * tLen, bsz);
+
+  for (size_t masked = 0; masked < 2; ++masked)
+  {
+    MultiheadAttention module(tLen, numHeads);
+    module.InputDimensions() = std::vector<size_t>({ embedDim,
+        tLen + 2 * sLen });
+    module.ComputeOutputDimensions();
+    arma::mat weights(module.WeightSize(), 1);
+    weights.randu();
+    module.SetWeights(weights);
+
+    if (masked == 1)
+    {
+      module.AttentionMask() = attnMask;
+      module.KeyPaddingMask() = keyPaddingMask;
+    }
+
+    arma::mat output, g, gradient;
+    module.Forward(input, output);
+    module.Backward(input, output, gy, g);
+    module.Gradient(input, gy, gradient);
+
+    // The source sequence length is not a multiple of the block size, so the
+    // last block is smaller.
+    module.BlockSize() = 3;
+
+    arma::mat blockedOutput, blockedG, blockedGradient;
+    module.Forward(input, blockedOutput);
+    module.Backward(input, blockedOutput, gy, blockedG);
+    module.Gradient(input, gy, blockedGradient);
+
+    CheckMatrices(output, blockedOutput, 1e-6);
+    CheckMatrices(g, blockedG, 1e-6);
+    CheckMatrices(gradient, blockedGradient, 1e-6);
+  }
+}
@@ -0,0 +1,142 @@
+/**
+ * @file tests/ann/layer/sparse_linear.cpp
+ *
+ * Tests the SparseLinear layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann.hpp>
+
+#include "../../test_catch_tools.hpp"
+#include "../../catch.hpp"
+#include "../../serialization.hpp"
+#include "../ann_test_tools.hpp"
+
+using namespace mlpack;
+
+/**
+ * Make sure that the SparseLinear layer gives the same output and gradient as
+ * a dense linear transformation of the sparse input.
+ */
+TEST_CASE("SimpleSparseLinearLayerTest", "[ANNLayerTest]")
+{
+  const size_t inSize = 1000;
+  const size_t outSize = 7;
+  const size_t maxNonzeros = 5;
+  const size_t batchSize = 20;
+
+  // Each point has between 0 and maxNonzeros nonzero elements.
+  arma::sp_mat sparseInput(inSize, batchSize);
+  for (size_t c = 0; c < batchSize; ++c)
+  {
+    const size_t nonzeros = c % (maxNonzeros + 1);
+    for (size_t j = 0; j < nonzeros; ++j)
+      sparseInput(RandInt(inSize), c) = Random(0.5, 1.5);
+  }
+
+  arma::mat input;
+  SparseLinear::Encode(sparseInput, maxNonzeros, input);
+  REQUIRE(input.n_rows == 2 * maxNonzeros);
+  REQUIRE(input.n_cols == batchSize);
+
+  SparseLinear module(inSize, outSize, maxNonzeros);
+  module.InputDimensions() = std::vector<size_t>({ 2 * maxNonzeros });
+  module.ComputeOutputDimensions();
+  REQUIRE(module.OutputDimensions()[0] == outSize);
+  arma::mat weights(module.WeightSize(), 1, arma::fill::randu);
+  module.SetWeights(weights);
+
+  const arma::mat denseInput(sparseInput);
+  arma::mat output(outSize, batchSize);
+  module.Forward(input, output);
+  arma::mat expectedOutput = module.Weight() * denseInput;
+  expectedOutput.each_col() += module.Bias();
+  CheckMatrices(output, expectedOutput, 1e-6);
+
+  // The backpropagated error of each value is the error of the corresponding
+  // element of the dense input.
+  const arma::mat gy(outSize, batchSize, arma::fill::randu);
+  arma::mat g;
+  module.Backward(input, output, gy, g);
+  const arma::mat denseG = module.Weight().t() * gy;
+  REQUIRE(arma::accu(arma::abs(g.rows(0, maxNonzeros - 1))) == 0.0);
+  for (size_t c = 0; c < batchSize; ++c)
+  {
+    for (size_t j = 0; j < maxNonzeros; ++j)
+    {
+      if (input(maxNonzeros + j, c) != 0.0)
+      {
+        REQUIRE(g(maxNonzeros + j, c) ==
+            Approx(denseG((size_t) input(j, c), c)).epsilon(1e-8));
+      }
+    }
+  }
+
+  arma::mat gradient(module.WeightSize(), 1);
+  gradient.fill(1.0);
+  module.Gradient(input, gy, gradient);
+  arma::mat expectedGradient = join_cols(vectorise(gy * denseInput.t()),
+      sum(gy, 1));
+  CheckMatrices(gradient, expectedGradient, 1e-6);
+
+  // A point with too many nonzero elements cannot be encoded.
+  REQUIRE_THROWS_AS(SparseLinear::Encode(sparseInput, maxNonzeros - 1, input),
+      std::invalid_argument);
+
+  // The input must have room for maxNonzeros indices and values.
+  module.InputDimensions() = std::vector<size_t>({ maxNonzeros });
+  REQUIRE_THROWS_AS(module.ComputeOutputDimensions(), std::invalid_argument);
+}
+
+/**
+ * SparseLinear layer numerical gradient test.
+ */
+TEST_CASE("GradientSparseLinearLayerTest", "[ANNLayerTest]")
+{
+  // SparseLinear function gradient instantiation.
+  struct GradientFunction
+  {
+    GradientFunction() :
+        target(arma::mat("1 0 1"))
+    {
+      arma::sp_mat sparseInput(100, 3);
+      sparseInput(3, 0) = 0.5;
+      sparseInput(42, 0) = -1.0;
+      sparseInput(42, 1) = 2.0;
+      sparseInput(99, 2) = 1.5;
+      sparseInput(7, 2) = 0.25;
+      sparseInput(60, 2) = -0.75;
+      SparseLinear::Encode(sparseInput, 3, input);
+
+      model = new FFN<NegativeLogLikelihood, NguyenWidrowInitialization>();
+      model->ResetData(input, target);
+      model->Add<SparseLinear>(100, 10, 3);
+      model->Add<Sigmoid>();
+      model->Add<Linear>(2);
+      model->Add<LogSoftMax>();
+    }
+
+    ~GradientFunction()
+    {
+      delete model;
+    }
+
+    double Gradient(arma::mat& gradient) const
+    {
+      double error = model->Evaluate(model->Parameters(), 0, 3);
+      model->Gradient(model->Parameters(), 0, gradient, 3);
+      return error;
+    }
+
+    arma::mat& Parameters() { return model->Parameters(); }
+
+    FFN<NegativeLogLikelihood, NguyenWidrowInitialization>* model;
+    arma::mat input, target;
+  } function;
+
+  REQUIRE(CheckGradient(function) <= 1e-4);
+}
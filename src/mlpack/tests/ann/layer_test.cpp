@@ -30,6 +30,7 @@
 #include "layer/concatenate.cpp"
 #include "layer/c_relu.cpp"
 #include "layer/dropout.cpp"
+#include "layer/embedding.cpp"
 #include "layer/flexible_relu.cpp"
 #include "layer/grouped_convolution.cpp"
 #include "layer/hard_tanh.cpp"
@@ -46,6 +47,7 @@
 #include "layer/repeat.cpp"
 #include "layer/softmax.cpp"
 #include "layer/softmin.cpp"
+#include "layer/sparse_linear.cpp"
 #include "layer/ftswish.cpp"
 #include "layer/layer_norm.cpp"
 #include "layer/multihead_attention.cpp"
@@ -430,3 +430,191 @@ TEST_CASE("RNNFFNTest", "[RecurrentNetworkTest]")
   // Now, the weights should be the same!
   CheckMatrices(ffn.Parameters(), rnn.Parameters());
 }
+
+/**
+ * Test that gradient checkpointing gives the same objective and gradient as
+ * holding the state of every BPTT step.
+ */
+TEST_CASE("RNNCheckpointingTest", "[RecurrentNetworkTest]")
+{
+  const size_t steps = 30;
+  arma::cube data(3, 8, steps, arma::fill::randu);
+  arma::cube responses(4, 8, steps, arma::fill::randu);
+
+  RNN<MeanSquaredError> model(steps);
+  model.Add<LSTM>(4);
+
+  model.Reset(3);
+  model.ResetData(data, responses);
+
+  arma::mat gradient, checkpointedGradient;
+  const double objective = model.EvaluateWithGradient(model.Parameters(), 2,
+      gradient, 5);
+
+  model.Checkpointing() = true;
+  const double checkpointedObjective = model.EvaluateWithGradient(
+      model.Parameters(), 2, checkpointedGradient, 5);
+
+  REQUIRE(checkpointedObjective == Approx(objective).epsilon(1e-10));
+  REQUIRE(arma::approx_equal(gradient, checkpointedGradient, "both", 1e-10,
+      1e-8));
+
+  // Checkpointing is kept when the network is copied.
+  RNN<MeanSquaredError> copy(model);
+  REQUIRE(copy.Checkpointing() == true);
+}
+
+/**
+ * Test that the LSTM layer computes the LSTM equations (with peephole
+ * connections) over a few time steps.
+ */
+TEST_CASE("LSTMForwardTest", "[RecurrentNetworkTest]")
+{
+  const size_t inSize = 3;
+  const size_t outSize = 4;
+  const size_t steps = 3;
+
+  RNN<MeanSquaredError> model(steps);
+  model.Add<LSTM>(outSize);
+  model.Reset(inSize);
+  model.Parameters().randn();
+  model.Parameters() *= 0.5;
+
+  // Unpack the parameters in the order used by LSTM::SetWeights().
+  const arma::mat& p = model.Parameters();
+  size_t offset = 0;
+  arma::mat w[4], u[4];
+  arma::vec b[4], peephole[3];
+  for (size_t g = 0; g < 4; ++g)
+  {
+    w[g] = arma::reshape(p.rows(offset, offset + outSize * inSize - 1),
+        outSize, inSize);
+    offset += outSize * inSize;
+    b[g] = p.rows(offset, offset + outSize - 1);
+    offset += outSize;
+  }
+  for (size_t g = 0; g < 4; ++g)
+  {
+    u[g] = arma::reshape(p.rows(offset, offset + outSize * outSize - 1),
+        outSize, outSize);
+    offset += outSize * outSize;
+  }
+  for (size_t g = 0; g < 3; ++g)
+  {
+    peephole[g] = p.rows(offset, offset + outSize - 1);
+    offset += outSize;
+  }
+
+  // The gates are stored as output, forget, input, hidden; the peephole
+  // weights as output, forget, input.
+  arma::cube input(inSize, 5, steps, arma::fill::randu);
+  arma::cube output;
+  model.Predict(input, output);
+
+  arma::mat h(outSize, 5, arma::fill::zeros), c(outSize, 5, arma::fill::zeros);
+  for (size_t t = 0; t < steps; ++t)
+  {
+    const arma::mat& x = input.slice(t);
+    arma::mat i = w[2] * x + u[2] * h + c.each_col() % peephole[2];
+    i.each_col() += b[2];
+    i = 1 / (1 + arma::exp(-i));
+    arma::mat f = w[1] * x + u[1] * h + c.each_col() % peephole[1];
+    f.each_col() += b[1];
+    f = 1 / (1 + arma::exp(-f));
+    arma::mat z = w[3] * x + u[3] * h;
+    z.each_col() += b[3];
+    z = arma::tanh(z);
+    c = f % c + i % z;
+    arma::mat o = w[0] * x + u[0] * h + c.each_col() % peephole[0];
+    o.each_col() += b[0];
+    o = 1 / (1 + arma::exp(-o));
+    h = o % arma::tanh(c);
+
+    REQUIRE(arma::approx_equal(output.slice(t), h, "absdiff", 1e-10));
+  }
+}
+
+/**
+ * Test that packed sequences of different lengths give the same objective,
+ * gradient and predictions as passing each sequence on its own, without its
+ * padding.
+ */
+TEST_CASE("RNNPackedSequencesTest", "[RecurrentNetworkTest]")
+{
+  const size_t steps = 10;
+  arma::cube data(3, 6, steps, arma::fill::randu);
+  arma::cube responses(4, 6, steps, arma::fill::randu);
+  const arma::urowvec lengths = { 10, 4, 7, 1, 10, 5 };
+
+  RNN<MeanSquaredError> model(steps);
+  model.Add<LSTM>(4);
+  model.Reset(3);
+
+  // Compute the reference objective and gradient of each sequence on its own.
+  double expectedObjective = 0.0;
+  arma::mat expectedGradient(arma::size(model.Parameters()),
+      arma::fill::zeros);
+  arma::cube expectedPredictions(4, 6, steps, arma::fill::zeros);
+  for (size_t i = 0; i < lengths.n_elem; ++i)
+  {
+    const arma::span sequenceSteps(0, lengths[i] - 1);
+    const arma::cube sequence = data(arma::span::all, arma::span(i),
+        sequenceSteps);
+    const arma::cube sequenceResponses = responses(arma::span::all,
+        arma::span(i), sequenceSteps);
+
+    model.ResetData(sequence, sequenceResponses);
+    arma::mat gradient;
+    expectedObjective += model.EvaluateWithGradient(model.Parameters(), 0,
+        gradient, 1);
+    expectedGradient += gradient;
+
+    arma::cube predictions;
+    model.Predict(sequence, predictions);
+    expectedPredictions(arma::span::all, arma::span(i), sequenceSteps) =
+        predictions;
+  }
+
+  // The batch is not sorted by length, so it is reordered first.
+  model.ResetData(data, responses, lengths);
+  arma::mat gradient;
+  const double objective = model.EvaluateWithGradient(model.Parameters(), 0,
+      gradient, 6);
+  REQUIRE(objective == Approx(expectedObjective).epsilon(1e-10));
+  REQUIRE(arma::approx_equal(gradient, expectedGradient, "both", 1e-10,
+      1e-8));
+
+  // The objective without the gradient is the same.
+  model.ResetData(data, responses, lengths);
+  REQUIRE(model.Evaluate(model.Parameters(), 0, 6) ==
+      Approx(expectedObjective).epsilon(1e-10));
+
+  // Predictions are given for each step of each sequence, in the original
+  // order, and are zero after the end of the sequence.
+  arma::cube predictions;
+  model.Predict(data, predictions, lengths, 4);
+  REQUIRE(arma::approx_equal(predictions, expectedPredictions, "absdiff",
+      1e-10));
+
+  // Sequences of the full length give the same result as unpacked sequences.
+  arma::mat unpackedGradient, packedGradient;
+  model.ResetData(data, responses);
+  const double unpackedObjective = model.EvaluateWithGradient(
+      model.Parameters(), 1, unpackedGradient, 4);
+  arma::urowvec fullLengths(6);
+  fullLengths.fill(steps);
+  model.ResetData(data, responses, fullLengths);
+  const double packedObjective = model.EvaluateWithGradient(
+      model.Parameters(), 1, packedGradient, 4);
+  REQUIRE(packedObjective == Approx(unpackedObjective).epsilon(1e-10));
+  REQUIRE(arma::approx_equal(packedGradient, unpackedGradient, "both", 1e-10,
+      1e-8));
+
+  // Invalid lengths are not accepted.
+  const arma::urowvec tooLong = { 10, 4, 7, 1, 11, 5 };
+  const arma::urowvec tooFew = { 10, 4, 7 };
+  REQUIRE_THROWS_AS(model.ResetData(data, responses, tooLong),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(model.Predict(data, predictions, tooFew),
+      std::invalid_argument);
+}
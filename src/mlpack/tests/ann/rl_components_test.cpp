@@ -262,6 +262,55 @@ TEST_CASE("RandomReplayTest", "[RLComponentsTest]")
   }
 }
 
+/**
+ * Store two short episodes in a compact replay instance and check that every
+ * sampled transition is one of the transitions that are still stored, even
+ * after the ring buffer has wrapped around.
+ */
+TEST_CASE("CompactReplayTest", "[RLComponentsTest]")
+{
+  // The observations are stored in single precision.
+  CompactReplay<CartPole, float> replay(1, 6);
+  std::vector<CartPole::State> states;
+  for (size_t i = 0; i < 7; ++i)
+    states.push_back(CartPole::State(arma::randu<arma::colvec>(4)));
+  CartPole::Action action;
+  action.action = CartPole::Action::actions::forward;
+
+  // The first episode is s0 -> s1 -> s2 -> s3; the second is s4 -> s5.  The
+  // reward of each transition is the index of its state.
+  replay.Store(states[0], action, 0.0, states[1], false, 0.9);
+  replay.Store(states[1], action, 1.0, states[2], false, 0.9);
+  replay.Store(states[2], action, 2.0, states[3], true, 0.9);
+  replay.Store(states[4], action, 4.0, states[5], false, 0.9);
+  // The six slots hold s0 to s5, since consecutive states are shared.
+  REQUIRE(replay.Size() == 4);
+
+  // This overwrites s0, so the first transition is gone.
+  replay.Store(states[5], action, 5.0, states[6], false, 0.9);
+  REQUIRE(replay.Size() == 4);
+
+  arma::mat sampledState, sampledNextState;
+  std::vector<CartPole::Action> sampledAction;
+  arma::rowvec sampledReward;
+  arma::irowvec sampledTerminal;
+  for (size_t i = 0; i < 50; ++i)
+  {
+    replay.Sample(sampledState, sampledAction, sampledReward, sampledNextState,
+        sampledTerminal);
+
+    REQUIRE(sampledAction.size() == 1);
+    const size_t index = (size_t) sampledReward[0];
+    REQUIRE(index >= 1);
+    REQUIRE(index != 3);
+    REQUIRE(arma::approx_equal(sampledState, states[index].Encode(), "absdiff",
+        1e-6));
+    REQUIRE(arma::approx_equal(sampledNextState, states[index + 1].Encode(),
+        "absdiff", 1e-6));
+    REQUIRE(sampledTerminal[0] == (index == 2 ? 1 : 0));
+  }
+}
+
 /**
  * Construct a greedy policy instance and check if it works as
  * it should be.
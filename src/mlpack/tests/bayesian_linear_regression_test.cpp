@@ -313,3 +313,63 @@ TEMPLATE_TEST_CASE("BayesianLinearRegressionTrainVariantTest",
   REQUIRE(blr5.MaxIterations() == 110);
   REQUIRE(blr5.Tolerance() == 1e-3);
 }
+
+// Ensure that Update() with fixed hyperparameters gives the exact posterior of
+// all the points, and that Update() with tuning reaches the same model as
+// training on all the points.
+TEST_CASE("BayesianLinearRegressionUpdateTest",
+          "[BayesianLinearRegressionTest]")
+{
+  arma::mat matX;
+  arma::rowvec y;
+  GenerateProblem(matX, y, 300, 5, 0.1);
+
+  const arma::mat firstX = matX.cols(0, 99);
+  const arma::rowvec firstY = y.subvec(0, 99);
+  const arma::mat restX = matX.cols(100, 299);
+  const arma::rowvec restY = y.subvec(100, 299);
+
+  BayesianLinearRegression<> estimator(true, false);
+  estimator.Train(firstX, firstY);
+  const double alpha = estimator.Alpha();
+  const double beta = estimator.Beta();
+  const arma::mat secondX = restX.cols(0, 49);
+  const arma::rowvec secondY = restY.subvec(0, 49);
+  const arma::mat thirdX = restX.cols(50, 199);
+  const arma::rowvec thirdY = restY.subvec(50, 199);
+  estimator.Update(secondX, secondY);
+  estimator.Update(thirdX, thirdY);
+
+  REQUIRE(estimator.Alpha() == alpha);
+  REQUIRE(estimator.Beta() == beta);
+
+  // Compute the posterior of all the points directly.
+  const arma::mat phi = matX.each_col() - estimator.DataOffset();
+  const arma::rowvec t = y - estimator.ResponsesOffset();
+  const arma::mat precision = alpha * arma::eye(5, 5) + beta * phi * phi.t();
+  const arma::vec omega = beta * arma::solve(precision, phi * t.t());
+  REQUIRE(arma::approx_equal(estimator.Omega(), omega, "reldiff", 1e-6));
+
+  arma::rowvec predictions, stds;
+  estimator.Predict(matX, predictions, stds);
+  const arma::rowvec expectedStds = arma::sqrt(1.0 / beta +
+      arma::sum(phi % arma::solve(precision, phi), 0));
+  REQUIRE(arma::approx_equal(stds, expectedStds, "reldiff", 1e-6));
+
+  // Without centering, the statistics are the same as the statistics of all
+  // the points, so tuning should converge to the same hyperparameters.
+  BayesianLinearRegression<> full(false, false, 100, 1e-10);
+  full.Train(matX, y);
+
+  BayesianLinearRegression<> updated(false, false, 100, 1e-10);
+  updated.Train(firstX, firstY);
+  updated.Update(restX, restY, 100);
+
+  REQUIRE(updated.Alpha() == Approx(full.Alpha()).epsilon(1e-5));
+  REQUIRE(updated.Beta() == Approx(full.Beta()).epsilon(1e-5));
+  REQUIRE(arma::approx_equal(updated.Omega(), full.Omega(), "reldiff", 1e-5));
+
+  // Points of the wrong dimensionality are rejected.
+  REQUIRE_THROWS_AS(updated.Update(arma::mat(4, 10, arma::fill::randn),
+      arma::rowvec(10, arma::fill::randn)), std::invalid_argument);
+}
@@ -104,3 +104,73 @@ TEST_CASE("RandomizedBlockKrylovSVDNoisyLowRankTest", "[BlockKrylovSVDTest]")
   double error = arma::max(arma::abs(s1.subvec(0, rank) - s2.subvec(0, rank)));
   REQUIRE(error == Approx(0.0).margin(1e-4));
 }
+
+/**
+ * Make sure that sparse and single-precision data give the same factorization
+ * as dense data.
+ */
+TEMPLATE_TEST_CASE("RandomizedBlockKrylovSVDSparseAndFloatTest",
+    "[BlockKrylovSVDTest]", float, double)
+{
+  typedef TestType eT;
+
+  arma::SpMat<eT> data;
+  data.sprandu(150, 400, 0.05);
+  const arma::Mat<eT> dense(data);
+
+  arma::Mat<eT> U1, U2, V1, V2;
+  arma::Col<eT> s1, s2;
+
+  RandomSeed(5);
+  RandomizedBlockKrylovSVD rSVD(5, 10);
+  rSVD.Apply(dense, U1, s1, V1, 5);
+
+  RandomSeed(5);
+  rSVD.Apply(data, U2, s2, V2, 5);
+
+  REQUIRE(U2.n_rows == 150);
+  REQUIRE(V2.n_rows == 400);
+  REQUIRE(s1.n_elem == s2.n_elem);
+
+  const double tolerance = std::is_same<eT, float>::value ? 1e-3 : 1e-8;
+  REQUIRE(arma::norm(s1 - s2) / arma::norm(s1) < tolerance);
+
+  // The singular values should also be close to the exact ones.
+  arma::Mat<eT> U3, V3;
+  arma::Col<eT> s3;
+  arma::svd_econ(U3, s3, V3, dense);
+  REQUIRE(arma::norm(s2.subvec(0, 4) - s3.subvec(0, 4)) /
+      arma::norm(s3.subvec(0, 4)) < 1e-2);
+}
+
+/**
+ * Make sure that double-precision data (dense or sparse) can be decomposed in
+ * single precision, by giving single-precision outputs.
+ */
+TEST_CASE("RandomizedBlockKrylovSVDMixedPrecisionTest", "[BlockKrylovSVDTest]")
+{
+  arma::sp_mat data;
+  data.sprandu(150, 400, 0.05);
+  const arma::mat dense(data);
+
+  arma::mat U1, V1;
+  arma::vec s1;
+  arma::svd_econ(U1, s1, V1, dense);
+
+  RandomizedBlockKrylovSVD rSVD(5, 10);
+  arma::fmat U2, V2, U3, V3;
+  arma::fvec s2, s3;
+  rSVD.Apply(dense, U2, s2, V2, 5);
+  rSVD.Apply(data, U3, s3, V3, 5);
+
+  REQUIRE(U2.n_rows == 150);
+  REQUIRE(V2.n_rows == 400);
+  REQUIRE(U3.n_rows == 150);
+  REQUIRE(V3.n_rows == 400);
+
+  const arma::vec exact = s1.subvec(0, 4);
+  REQUIRE(arma::norm(arma::conv_to<arma::vec>::from(s2.subvec(0, 4)) -
+      exact) / arma::norm(exact) < 1e-2);
+  REQUIRE(arma::norm(arma::conv_to<arma::vec>::from(s3.subvec(0, 4)) -
+      exact) / arma::norm(exact) < 1e-2);
+}
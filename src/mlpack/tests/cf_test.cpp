@@ -281,6 +281,115 @@ void BatchPredict()
   }
 }
 
+/**
+ * Make sure that SearchRecommendations() gives the same recommendations as
+ * GetRecommendations(), up to ties.
+ */
+template<typename DecompositionPolicy>
+void SearchRecommendations()
+{
+  DecompositionPolicy decomposition;
+
+  // Load GroupLens data.
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  CFType<DecompositionPolicy> c(dataset, decomposition, 5, 5, 30);
+
+  const size_t numRecs = 5;
+  const size_t numItems = c.CleanedData().n_rows;
+  arma::Col<size_t> users = arma::regspace<arma::Col<size_t>>(0, 19);
+  arma::Mat<size_t> recommendations, searchRecommendations;
+  c.GetRecommendations(numRecs, recommendations, users);
+  c.template SearchRecommendations<FastMKSItemSearch>(numRecs,
+      searchRecommendations, users);
+
+  REQUIRE(searchRecommendations.n_rows == numRecs);
+  REQUIRE(searchRecommendations.n_cols == users.n_elem);
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    arma::Mat<size_t> combinations(2, numItems);
+    combinations.row(0).fill(users[i]);
+    combinations.row(1) = arma::regspace<arma::Row<size_t>>(0, numItems - 1);
+    arma::vec predictions;
+    c.Predict(combinations, predictions);
+
+    for (size_t k = 0; k < numRecs; ++k)
+    {
+      REQUIRE(c.CleanedData()(searchRecommendations(k, i), users[i]) == 0.0);
+      REQUIRE(predictions[searchRecommendations(k, i)] ==
+          Approx(predictions[recommendations(k, i)]).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Make sure that the batched ratings of a decomposition match the weighted sums
+ * of single-user ratings, and that GetRecommendations() returns the unrated
+ * items with the highest predicted ratings.
+ */
+template<typename DecompositionPolicy>
+void GetRecommendationsBatch()
+{
+  DecompositionPolicy decomposition;
+
+  // Load GroupLens data.
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  CFType<DecompositionPolicy> c(dataset, decomposition, 5, 5, 30);
+
+  // Compare weighted ratings for random groups of users.
+  const arma::Mat<size_t> groups = arma::randi<arma::Mat<size_t>>(3, 4,
+      arma::distr_param(0, (int) c.CleanedData().n_cols - 1));
+  const arma::mat weights(3, 4, arma::fill::randu);
+  arma::mat ratings;
+  c.Decomposition().GetWeightedRatings(groups, weights, ratings);
+  REQUIRE(ratings.n_rows == c.CleanedData().n_rows);
+  REQUIRE(ratings.n_cols == groups.n_cols);
+  for (size_t i = 0; i < groups.n_cols; ++i)
+  {
+    arma::vec expected(c.CleanedData().n_rows, arma::fill::zeros);
+    for (size_t j = 0; j < groups.n_rows; ++j)
+    {
+      arma::vec userRatings;
+      c.Decomposition().GetRatingOfUser(groups(j, i), userRatings);
+      expected += weights(j, i) * userRatings;
+    }
+
+    REQUIRE(arma::approx_equal(ratings.col(i), expected, "absdiff", 1e-8));
+  }
+
+  // Compare the recommendations with the predictions for every item.
+  const size_t numRecs = 5;
+  const size_t numItems = c.CleanedData().n_rows;
+  arma::Col<size_t> users = arma::regspace<arma::Col<size_t>>(0, 9);
+  arma::Mat<size_t> recommendations;
+  c.GetRecommendations(numRecs, recommendations, users);
+
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    arma::Mat<size_t> combinations(2, numItems);
+    combinations.row(0).fill(users[i]);
+    combinations.row(1) = arma::regspace<arma::Row<size_t>>(0, numItems - 1);
+    arma::vec predictions;
+    c.Predict(combinations, predictions);
+    for (size_t j = 0; j < numItems; ++j)
+      if (c.CleanedData()(j, users[i]) != 0.0)
+        predictions[j] = -DBL_MAX;
+
+    const arma::vec sorted = arma::sort(predictions, "descend");
+    for (size_t k = 0; k < numRecs; ++k)
+    {
+      REQUIRE(c.CleanedData()(recommendations(k, i), users[i]) == 0.0);
+      REQUIRE(predictions[recommendations(k, i)] ==
+          Approx(sorted[k]).epsilon(1e-7));
+    }
+  }
+}
+
 /**
  * Make sure we can train an already-trained model and it works okay.
  */
@@ -721,3 +830,50 @@ TEST_CASE("CFPredictRegressionInterpolation", "[CFTest]")
             EuclideanSearch,
             RegressionInterpolation>(2.2);
 }
+
+/**
+ * Make sure that batched recommendations are correct for all methods.
+ */
+TEMPLATE_TEST_CASE("CFGetRecommendationsBatchTest", "[CFTest]",
+    RandomizedSVDPolicy, RegSVDPolicy, BatchSVDPolicy, NMFPolicy,
+    SVDCompletePolicy, SVDIncompletePolicy, BiasSVDPolicy, SVDPlusPlusPolicy,
+    QUIC_SVDPolicy, BlockKrylovSVDPolicy)
+{
+  GetRecommendationsBatch<TestType>();
+}
+
+/**
+ * Make sure that recommendations from the item factor search are correct for
+ * all methods.
+ */
+TEMPLATE_TEST_CASE("CFSearchRecommendationsTest", "[CFTest]",
+    RandomizedSVDPolicy, RegSVDPolicy, BatchSVDPolicy, NMFPolicy,
+    SVDCompletePolicy, SVDIncompletePolicy, BiasSVDPolicy, SVDPlusPlusPolicy,
+    QUIC_SVDPolicy, BlockKrylovSVDPolicy)
+{
+  SearchRecommendations<TestType>();
+}
+
+/**
+ * Make sure that the incremental SVD policies can be trained in parallel from
+ * CFType.
+ */
+TEMPLATE_TEST_CASE("CFParallelSVDIncrementalTest", "[CFTest]",
+    SVDCompletePolicy, SVDIncompletePolicy)
+{
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  CFType<TestType> c(dataset, TestType(true), 5, 5, 20, 1e-5, true);
+  REQUIRE(c.Decomposition().Parallel() == true);
+  REQUIRE(c.Decomposition().W().n_rows == c.CleanedData().n_rows);
+  REQUIRE(c.Decomposition().H().n_cols == c.CleanedData().n_cols);
+  REQUIRE(c.Decomposition().W().is_finite());
+  REQUIRE(c.Decomposition().H().is_finite());
+
+  arma::Mat<size_t> recommendations;
+  c.GetRecommendations(10, recommendations);
+  REQUIRE(recommendations.n_rows == 10);
+  REQUIRE(recommendations.n_cols == c.CleanedData().n_cols);
+}
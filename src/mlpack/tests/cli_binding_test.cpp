@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/bindings/cli/cli_option.hpp>
+#include <mlpack/bindings/cli/serve.hpp>
 
 #include "catch.hpp"
 #include "test_catch_tools.hpp"
@@ -44,6 +45,8 @@ void AddCLIMapFunctions(util::Params& p)
   p.functionMap[TYPENAME(N)]["DeleteAllocatedMemory"] =
       &cli::DeleteAllocatedMemory<N>;
   p.functionMap[TYPENAME(N)]["InPlaceCopy"] = &cli::InPlaceCopy<N>;
+  p.functionMap[TYPENAME(N)]["ServeInputParam"] = &cli::ServeInputParam<N>;
+  p.functionMap[TYPENAME(N)]["ServeOutputParam"] = &cli::ServeOutputParam<N>;
 }
 
 /**
@@ -684,3 +687,76 @@ TEST_CASE("DeleteAllocatedMemoryModelTest", "[CLIOptionTest]")
   DeleteAllocatedMemory<GaussianKernel*>((util::ParamData&) d,
       (const void*) NULL, (void*) NULL);
 }
+
+// Test that requests of the serving mode are read, one point per line, up to
+// an empty line.
+TEST_CASE("ReadServeRequestTest", "[CLIOptionTest]")
+{
+  std::istringstream stream("\n1,2,3\n4 5 6\n\n7,8,9\n\n1,2\n3\n");
+
+  arma::mat batch;
+  REQUIRE(ReadServeRequest(stream, batch) == true);
+  REQUIRE(batch.n_rows == 3);
+  REQUIRE(batch.n_cols == 2);
+  for (size_t i = 0; i < 6; ++i)
+    REQUIRE(batch[i] == Approx(double(i + 1)));
+
+  REQUIRE(ReadServeRequest(stream, batch) == true);
+  REQUIRE(batch.n_rows == 3);
+  REQUIRE(batch.n_cols == 1);
+  REQUIRE(batch[2] == Approx(9.0));
+
+  // Lines with different numbers of values are an invalid request.
+  REQUIRE_THROWS_AS(ReadServeRequest(stream, batch), std::invalid_argument);
+  REQUIRE(ReadServeRequest(stream, batch) == false);
+}
+
+// Test that ServeInputParam() sets matrices from the points of a request.
+TEST_CASE("ServeInputParamTest", "[CLIOptionTest]")
+{
+  util::ParamData d;
+  typedef tuple<string, size_t, size_t> TupleType;
+  d.value = make_tuple(arma::mat(), TupleType{"", 0, 0});
+  d.noTranspose = false;
+
+  arma::mat batch(4, 5, arma::fill::randu);
+  ServeInputParam<arma::mat>(d, (const void*) &batch, (void*) NULL);
+
+  tuple<arma::mat, TupleType>& t =
+      *std::any_cast<tuple<arma::mat, TupleType>>(&d.value);
+  REQUIRE(d.loaded == true);
+  REQUIRE(get<0>(t).n_rows == 4);
+  REQUIRE(get<0>(t).n_cols == 5);
+  REQUIRE(get<1>(get<1>(t)) == 4);
+  REQUIRE(get<2>(get<1>(t)) == 5);
+  CheckMatrices(get<0>(t), batch);
+
+  // Non-matrix parameters cannot be given in requests.
+  util::ParamData d2;
+  d2.value = string("hello");
+  REQUIRE_THROWS_AS(ServeInputParam<string>(d2, (const void*) &batch,
+      (void*) NULL), std::runtime_error);
+}
+
+// Test that ServeOutputParam() writes matrices in the layout of saved files.
+TEST_CASE("ServeOutputParamTest", "[CLIOptionTest]")
+{
+  util::ParamData d;
+  typedef tuple<string, size_t, size_t> TupleType;
+  arma::mat m = { { 1, 2, 3 }, { 4, 5, 6 } };
+  d.value = make_tuple(m, TupleType{"", 0, 0});
+  d.noTranspose = false;
+
+  std::ostringstream stream;
+  ServeOutputParam<arma::mat>(d, (const void*) NULL, (void*) &stream);
+  REQUIRE(stream.str() == "1,4\n2,5\n3,6\n");
+
+  // Vectors have one element on each line.
+  util::ParamData d2;
+  arma::Row<size_t> r = { 0, 1, 2 };
+  d2.value = make_tuple(r, TupleType{"", 0, 0});
+  std::ostringstream stream2;
+  ServeOutputParam<arma::Row<size_t>>(d2, (const void*) NULL,
+      (void*) &stream2);
+  REQUIRE(stream2.str() == "0\n1\n2\n");
+}
@@ -219,6 +219,42 @@ TEST_CASE("CosineTreeModifiedGramSchmidt", "[CosineTreeTest]")
   }
 }
 
+/**
+ * Make sure that the basis built by the CosineTree is orthonormal, and that it
+ * captures low-rank data.
+ */
+TEST_CASE("CosineTreeBasisTest", "[CosineTreeTest]")
+{
+  // A rank-5 dataset.
+  arma::mat data = arma::randn(40, 5) * arma::randn(5, 300);
+
+  CosineTree<> tree(data, 1e-4, 0.1);
+  arma::mat basis;
+  tree.GetFinalBasis(basis);
+
+  REQUIRE(basis.n_rows == 40);
+  REQUIRE(basis.n_cols > 0);
+
+  // Every basis vector is either orthogonal to all the others and normalized,
+  // or zero (if the centroid was already in the span of the basis).
+  const arma::mat gram = basis.t() * basis;
+  for (size_t j = 0; j < gram.n_cols; ++j)
+  {
+    for (size_t i = 0; i < gram.n_rows; ++i)
+    {
+      if (i == j && gram(i, i) > 0.5)
+        REQUIRE(gram(i, j) == Approx(1.0).epsilon(1e-5));
+      else if (i != j)
+        REQUIRE(gram(i, j) == Approx(0.0).margin(1e-5));
+    }
+  }
+
+  // The projection onto the basis should reconstruct the data.
+  const arma::mat reconstruction = basis * (basis.t() * data);
+  REQUIRE(arma::norm(data - reconstruction, "fro") <
+      1e-2 * arma::norm(data, "fro"));
+}
+
 /**
  * Test the copy constructor & copy assignment using Cosine trees.
  */
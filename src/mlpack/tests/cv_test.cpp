@@ -128,6 +128,57 @@ TEST_CASE("BinaryClassificationMetricsTest", "[CVTest]")
                     std::invalid_argument);
 }
 
+/**
+ * Test that ClassificationStatistics gives the same metrics as the metric
+ * classes from a single pass, whether the points are added at once or in
+ * merged chunks.
+ */
+TEST_CASE("ClassificationStatisticsTest", "[CVTest]")
+{
+  arma::mat data = arma::linspace<arma::rowvec>(1.0, 12.0, 12);
+  arma::Row<size_t> labels("0 1  0 1  2 2 1 2  3 3 3 3");
+  arma::Row<size_t> predictedLabels("0 0  1 1  2 2 2 2  3 3 3 3");
+  NaiveBayesClassifier<> nb(data, predictedLabels, 4);
+
+  ClassificationStatistics stats(2);
+  stats.Add(nb, data, labels);
+
+  ClassificationStatistics first(2), second(2);
+  first.Add(nb, arma::mat(data.cols(0, 4)), labels.cols(0, 4));
+  second.Add(nb, arma::mat(data.cols(5, 11)), labels.cols(5, 11));
+  first.Merge(second);
+
+  for (const ClassificationStatistics* s : { &stats, &first })
+  {
+    REQUIRE(s->NumPoints() == 12);
+    REQUIRE(s->Accuracy() ==
+        Approx(Accuracy::Evaluate(nb, data, labels)).epsilon(1e-7));
+    REQUIRE(s->Precision(Binary) ==
+        Approx(Precision<Binary, 2>::Evaluate(nb, data, labels)).epsilon(1e-7));
+    REQUIRE(s->Recall(Micro) ==
+        Approx(Recall<Micro>::Evaluate(nb, data, labels)).epsilon(1e-7));
+    REQUIRE(s->Precision(Macro) ==
+        Approx(Precision<Macro>::Evaluate(nb, data, labels)).epsilon(1e-7));
+    REQUIRE(s->Recall(Macro) ==
+        Approx(Recall<Macro>::Evaluate(nb, data, labels)).epsilon(1e-7));
+    REQUIRE(s->F1(Macro) ==
+        Approx(F1<Macro>::Evaluate(nb, data, labels)).epsilon(1e-7));
+  }
+
+  // Scores that fall on the bin edges give the exact ROC AUC.
+  arma::Row<size_t> rocLabels("0 0 1 1 0 1 1 0");
+  arma::rowvec rocScores("0.1 0.4 0.35 0.8 0.4 0.9 0.1 0.2");
+  ClassificationStatistics rocStats(1, 20);
+  rocStats.Add(rocLabels, rocLabels, rocScores);
+  REQUIRE(rocStats.AUC() ==
+      Approx(ROCAUCScore<1>::Evaluate(rocLabels, rocScores)).epsilon(1e-7));
+
+  arma::Row<size_t> zeroLabels(8, arma::fill::zeros);
+  ClassificationStatistics oneClass;
+  oneClass.Add(zeroLabels, zeroLabels, rocScores);
+  REQUIRE_THROWS_AS(oneClass.AUC(), std::invalid_argument);
+}
+
 /**
  * Test for confusion matrix.
  */
@@ -556,6 +607,32 @@ TEST_CASE("KFoldCVMSETest", "[CVTest]")
   REQUIRE_NOTHROW(cv.Model());
 }
 
+/**
+ * Training the folds in parallel should give the same score as training them
+ * one after the other.
+ */
+TEST_CASE("KFoldCVParallelFoldsTest", "[CVTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(3, 200);
+  arma::Row<size_t> labels(200);
+  for (size_t i = 0; i < 200; ++i)
+    labels[i] = (data(0, i) + data(1, i) > 1.0) ? 1 : 0;
+
+  KFoldCV<NaiveBayesClassifier<>, Accuracy> cv(10, data, labels, 2, false);
+  REQUIRE(cv.ParallelFolds() == 1);
+  REQUIRE(cv.FoldThreads() == 1);
+  const double sequentialAccuracy = cv.Evaluate();
+
+  cv.ParallelFolds() = 4;
+  REQUIRE(cv.Evaluate() == Approx(sequentialAccuracy).epsilon(1e-10));
+  REQUIRE_NOTHROW(cv.Model());
+
+  // More folds at a time than there are folds, with several threads each.
+  cv.ParallelFolds() = 20;
+  cv.FoldThreads() = 2;
+  REQUIRE(cv.Evaluate() == Approx(sequentialAccuracy).epsilon(1e-10));
+}
+
 /**
  * Test k-fold cross-validation with the Accuracy metric.
  */
@@ -858,3 +935,36 @@ TEST_CASE("SilhouetteScoreTest", "[CVTest]")
   double silhouetteScore = SilhouetteScore::Overall(X, labels, metric);
   REQUIRE(silhouetteScore == Approx(0.1121684822489150).epsilon(1e-7));
 }
+
+/**
+ * Test that the silhouette scores computed without storing the distances
+ * match the ones computed from the distance matrix, and that the sampled
+ * estimate is close to the exact score.
+ */
+TEST_CASE("SilhouetteScoreBlockedTest", "[CVTest]")
+{
+  // Three clusters, with more points than a block.
+  arma::mat X = arma::randn<arma::mat>(3, 300);
+  arma::Row<size_t> labels(300);
+  for (size_t i = 0; i < 300; ++i)
+  {
+    labels[i] = 2 * (i % 3);
+    X.col(i) += 4.0 * labels[i];
+  }
+
+  EuclideanDistance metric;
+  const arma::rowvec expected = SilhouetteScore::SamplesScore(
+      PairwiseDistances(X, metric), labels);
+  const arma::rowvec scores = SilhouetteScore::SamplesScore(X, labels,
+      metric);
+
+  REQUIRE(scores.n_elem == expected.n_elem);
+  for (size_t i = 0; i < scores.n_elem; ++i)
+    REQUIRE(scores[i] == Approx(expected[i]).epsilon(1e-7));
+
+  const double overall = SilhouetteScore::Overall(X, labels, metric);
+  REQUIRE(SilhouetteScore::Overall(X, labels, metric, 0) ==
+      Approx(overall).epsilon(1e-7));
+  REQUIRE(SilhouetteScore::Overall(X, labels, metric, 100) ==
+      Approx(overall).epsilon(0.1));
+}
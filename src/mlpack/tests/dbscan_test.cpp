@@ -364,3 +364,156 @@ TEST_CASE("NoiseConnectionTest", "[DBSCANTest]")
 
   REQUIRE(numClusters == 2);
 }
+
+/**
+ * Make sure that parallel DBSCAN finds the same clusters as serial DBSCAN.  The
+ * two can only differ in the cluster given to non-core points that are in the
+ * neighborhood of core points from several clusters.
+ */
+TEST_CASE("ParallelDBSCANTest", "[DBSCANTest]")
+{
+  arma::mat points(3, 3000);
+
+  GaussianDistribution<> g1(3), g2(3), g3(3);
+  g1.Mean() = arma::vec("0.0 0.0 0.0");
+  g2.Mean() = arma::vec("6.0 6.0 8.0");
+  g3.Mean() = arma::vec("-6.0 1.0 -7.0");
+  for (size_t i = 0; i < 1000; ++i)
+    points.col(i) = g1.Random();
+  for (size_t i = 1000; i < 2000; ++i)
+    points.col(i) = g2.Random();
+  for (size_t i = 2000; i < 3000; ++i)
+    points.col(i) = g3.Random();
+
+  // Add some sparse noise.
+  points.cols(0, 99) = 30.0 * arma::randu<arma::mat>(3, 100) - 15.0;
+
+  const double epsilon = 0.6;
+  const size_t minPoints = 10;
+
+  // Find which points are core points.
+  arma::Col<size_t> counts;
+  RangeSearch<> rs(points);
+  rs.Count(Range(0.0, epsilon), counts);
+
+  for (size_t mode = 0; mode < 3; ++mode)
+  {
+    // Naive, single-tree, and dual-tree search.
+    DBSCAN<> serial(epsilon, minPoints, true,
+        RangeSearch<>(mode == 0, mode == 1));
+    DBSCAN<> parallel(epsilon, minPoints, true,
+        RangeSearch<>(mode == 0, mode == 1), OrderedPointSelection(), true);
+
+    arma::Row<size_t> serialAssignments, parallelAssignments;
+    const size_t serialClusters = serial.Cluster(points, serialAssignments);
+    const size_t parallelClusters = parallel.Cluster(points,
+        parallelAssignments);
+
+    REQUIRE(parallelClusters == serialClusters);
+    REQUIRE(parallelClusters >= 3);
+
+    // Noise must be the same, and core points must be partitioned the same way.
+    std::vector<size_t> mapping(serialClusters, SIZE_MAX);
+    for (size_t i = 0; i < points.n_cols; ++i)
+    {
+      REQUIRE((serialAssignments[i] == SIZE_MAX) ==
+          (parallelAssignments[i] == SIZE_MAX));
+      if (counts[i] + 1 < minPoints)
+        continue;
+
+      if (mapping[serialAssignments[i]] == SIZE_MAX)
+        mapping[serialAssignments[i]] = parallelAssignments[i];
+      REQUIRE(mapping[serialAssignments[i]] == parallelAssignments[i]);
+    }
+
+    // The parallel result should not depend on the run.
+    arma::Row<size_t> parallelAssignments2;
+    parallel.Cluster(points, parallelAssignments2);
+    REQUIRE(arma::all(parallelAssignments == parallelAssignments2));
+  }
+}
+
+/**
+ * Check that noise points do not connect clusters in parallel mode either.
+ */
+TEST_CASE("ParallelNoiseConnectionTest", "[DBSCANTest]")
+{
+  arma::mat dataset({
+      // cluster 1           cluster 2            noise
+      { 0.0, 0.5,  0.5, 1.0, 3.0, 3.5,  3.5, 4.0, 2.0 },
+      { 0.0, 0.5, -0.5, 0.0, 0.0, 0.5, -0.5, 0.0, 0.0 }});
+
+  DBSCAN<> dbscan(1.1, 4, true, RangeSearch<>(), OrderedPointSelection(),
+      true);
+
+  arma::Row<size_t> labels;
+  const size_t numClusters = dbscan.Cluster(dataset, labels);
+
+  REQUIRE(numClusters == 2);
+}
+
+/**
+ * Count the points whose cluster differs between two clusterings, up to a
+ * renumbering of the clusters.
+ */
+size_t CountClusterDifferences(const arma::Row<size_t>& a,
+                               const arma::Row<size_t>& b)
+{
+  std::map<size_t, size_t> mapping;
+  size_t differences = 0;
+  for (size_t i = 0; i < a.n_elem; ++i)
+  {
+    if (a[i] == SIZE_MAX || b[i] == SIZE_MAX)
+    {
+      differences += (a[i] != b[i]);
+      continue;
+    }
+
+    if (mapping.count(a[i]) == 0)
+      mapping[a[i]] = b[i];
+    differences += (mapping[a[i]] != b[i]);
+  }
+
+  return differences;
+}
+
+/**
+ * Make sure that DBSCAN with grid range search finds the same clusters as with
+ * tree-based range search, in batch, pointwise, and parallel mode.
+ */
+TEST_CASE("GridDBSCANTest", "[DBSCANTest]")
+{
+  arma::mat points(2, 600);
+
+  GaussianDistribution<> g1(2), g2(2), g3(2);
+  g1.Mean() = arma::vec("0.0 0.0");
+  g2.Mean() = arma::vec("8.0 6.0");
+  g3.Mean() = arma::vec("-7.0 5.0");
+  for (size_t i = 0; i < 200; ++i)
+    points.col(i) = g1.Random();
+  for (size_t i = 200; i < 400; ++i)
+    points.col(i) = g2.Random();
+  for (size_t i = 400; i < 600; ++i)
+    points.col(i) = g3.Random();
+
+  DBSCAN<> tree(0.8, 5);
+  arma::Row<size_t> treeAssignments;
+  const size_t treeClusters = tree.Cluster(points, treeAssignments);
+  REQUIRE(treeClusters >= 3);
+
+  for (size_t mode = 0; mode < 3; ++mode)
+  {
+    DBSCAN<GridRangeSearch<>> grid(0.8, 5, mode != 1, GridRangeSearch<>(),
+        OrderedPointSelection(), mode == 2);
+
+    arma::Row<size_t> gridAssignments;
+    const size_t gridClusters = grid.Cluster(points, gridAssignments);
+
+    REQUIRE(gridClusters == treeClusters);
+    // Only border points can change clusters in parallel mode.
+    if (mode != 2)
+      REQUIRE(CountClusterDifferences(treeAssignments, gridAssignments) == 0);
+    else
+      REQUIRE(CountClusterDifferences(treeAssignments, gridAssignments) < 20);
+  }
+}
@@ -1352,3 +1352,92 @@ TEST_CASE("WeightedDecisionTreeMADGainTest", "[DecisionTreeRegressorTest]")
 
   REQUIRE(success == true);
 }
+
+/**
+ * Check that HistogramNumericSplit finds the same regression split as
+ * BestBinaryNumericSplit when every value gets its own bucket, and that a tree
+ * built with it performs decently.
+ */
+TEST_CASE("HistogramNumericSplitRegressionTest", "[DecisionTreeRegressorTest]")
+{
+  arma::rowvec predictors(500);
+  arma::rowvec responses(500);
+  arma::rowvec weights(500);
+  for (size_t i = 0; i < 500; ++i)
+  {
+    predictors[i] = RandInt(0, 50);
+    responses[i] = 100.0 + ((predictors[i] > 20) ? 3.0 : 0.0) + RandNormal();
+    weights[i] = Random(0.5, 1.5);
+  }
+
+  arma::vec splitInfo, histogramSplitInfo;
+  BestBinaryNumericSplit<MSEGain>::AuxiliarySplitInfo aux;
+  HistogramNumericSplit<MSEGain>::AuxiliarySplitInfo histogramAux;
+  MSEGain f;
+
+  double bestGain = f.Evaluate<false>(responses, weights);
+  double gain = BestBinaryNumericSplit<MSEGain>::SplitIfBetter<false>(
+      bestGain, predictors, responses, weights, 3, 1e-7, splitInfo, aux, f);
+  double histogramGain = HistogramNumericSplit<MSEGain>::SplitIfBetter<false>(
+      bestGain, predictors, responses, weights, 3, 1e-7, histogramSplitInfo,
+      histogramAux, f);
+
+  REQUIRE(gain != DBL_MAX);
+  REQUIRE(histogramGain == Approx(gain).epsilon(1e-7));
+  REQUIRE(histogramSplitInfo.n_elem == 1);
+  REQUIRE(histogramSplitInfo[0] == Approx(splitInfo[0]).epsilon(1e-10));
+
+  bestGain = f.Evaluate<true>(responses, weights);
+  gain = BestBinaryNumericSplit<MSEGain>::SplitIfBetter<true>(
+      bestGain, predictors, responses, weights, 3, 1e-7, splitInfo, aux, f);
+  histogramGain = HistogramNumericSplit<MSEGain>::SplitIfBetter<true>(
+      bestGain, predictors, responses, weights, 3, 1e-7, histogramSplitInfo,
+      histogramAux, f);
+
+  REQUIRE(gain != DBL_MAX);
+  REQUIRE(histogramGain == Approx(gain).epsilon(1e-7));
+  REQUIRE(histogramSplitInfo.n_elem == 1);
+  REQUIRE(histogramSplitInfo[0] == Approx(splitInfo[0]).epsilon(1e-10));
+
+  arma::mat X;
+  arma::rowvec Y;
+  if (!data::Load("lars_dependent_x.csv", X))
+    FAIL("Cannot load dataset lars_dependent_x.csv");
+  if (!data::Load("lars_dependent_y.csv", Y))
+    FAIL("Cannot load dataset lars_dependent_y.csv");
+
+  arma::mat XTrain, XTest;
+  arma::rowvec YTrain, YTest;
+  data::Split(X, Y, XTrain, XTest, YTrain, YTest, 0.3);
+
+  DecisionTreeRegressor<MSEGain, HistogramNumericSplit> tree(XTrain, YTrain,
+      5);
+
+  arma::rowvec predictions;
+  tree.Predict(XTest, predictions);
+
+  const double rmse = RMSE(predictions, YTest);
+  REQUIRE(rmse < 1.0);
+}
+
+/**
+ * Make sure that the batch Predict() method, which routes blocks of points down
+ * the tree, gives the same results as predicting each point on its own.
+ */
+TEST_CASE("DecisionTreeRegressorBatchTest", "[DecisionTreeRegressorTest]")
+{
+  arma::mat dataset(4, 2 * DecisionTreeRegressor<>::PredictBlockSize + 77,
+      arma::fill::randu);
+  arma::rowvec responses = 3.0 * dataset.row(0) + arma::square(dataset.row(1)) -
+      2.0 * dataset.row(3);
+
+  DecisionTreeRegressor<> tree(dataset, responses, 10);
+  REQUIRE(tree.NumChildren() > 0);
+
+  arma::rowvec predictions;
+  tree.Predict(dataset, predictions);
+
+  REQUIRE(predictions.n_elem == dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    REQUIRE(predictions[i] == tree.Predict(dataset.col(i)));
+}
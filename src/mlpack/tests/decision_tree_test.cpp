@@ -468,6 +468,135 @@ TEST_CASE("RandomBinaryNumericSplitDiffSplitTest", "[DecisionTreeTest]")
   REQUIRE(classProbabilities[0] != classProbabilities1[0]);
 }
 
+/**
+ * Check that HistogramNumericSplit finds the same split as
+ * BestBinaryNumericSplit when there are few distinct values, and that it splits
+ * large dimensions with many distinct values in about the right place.
+ */
+TEST_CASE("HistogramNumericSplitTest", "[DecisionTreeTest]")
+{
+  // 1000 points with 100 distinct values; each value gets its own bucket.
+  arma::rowvec values(1000);
+  arma::Row<size_t> labels(1000);
+  arma::rowvec weights(1000);
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    values[i] = RandInt(0, 100);
+    labels[i] = (values[i] > 40) ? 1 : 0;
+    // Add some noise.
+    if (Random() < 0.1)
+      labels[i] = 1 - labels[i];
+    weights[i] = Random(0.5, 1.5);
+  }
+
+  arma::vec splitInfo, histogramSplitInfo;
+  BestBinaryNumericSplit<GiniGain>::AuxiliarySplitInfo aux;
+  HistogramNumericSplit<GiniGain>::AuxiliarySplitInfo histogramAux;
+
+  double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  double gain = BestBinaryNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 3, 1e-7, splitInfo, aux);
+  double histogramGain = HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 3, 1e-7, histogramSplitInfo,
+      histogramAux);
+
+  REQUIRE(gain != DBL_MAX);
+  REQUIRE(histogramGain == Approx(gain).epsilon(1e-10));
+  REQUIRE(histogramSplitInfo.n_elem == 1);
+  REQUIRE(histogramSplitInfo[0] == Approx(splitInfo[0]).epsilon(1e-10));
+
+  bestGain = GiniGain::Evaluate<true>(labels, 2, weights);
+  gain = BestBinaryNumericSplit<GiniGain>::SplitIfBetter<true>(
+      bestGain, values, labels, 2, weights, 3, 1e-7, splitInfo, aux);
+  histogramGain = HistogramNumericSplit<GiniGain>::SplitIfBetter<true>(
+      bestGain, values, labels, 2, weights, 3, 1e-7, histogramSplitInfo,
+      histogramAux);
+
+  REQUIRE(gain != DBL_MAX);
+  REQUIRE(histogramGain == Approx(gain).epsilon(1e-10));
+  REQUIRE(histogramSplitInfo.n_elem == 1);
+  REQUIRE(histogramSplitInfo[0] == Approx(splitInfo[0]).epsilon(1e-10));
+
+  // Now use many more points, which are all distinct; the buckets are then
+  // quantiles, and the split should still be close to the true boundary.
+  values.randu(20000);
+  labels.set_size(20000);
+  for (size_t i = 0; i < 20000; ++i)
+    labels[i] = (values[i] > 0.3) ? 1 : 0;
+
+  arma::Row<unsigned char> bins;
+  arma::Col<size_t> binCounts;
+  arma::vec binMin, binMax;
+  const size_t numBins = HistogramNumericSplit<GiniGain>::Bin(values, bins,
+      binCounts, binMin, binMax);
+  REQUIRE(numBins <= 256);
+  REQUIRE(numBins > 200);
+  REQUIRE(accu(binCounts) == 20000);
+  for (size_t i = 0; i < 20000; ++i)
+  {
+    REQUIRE(values[i] >= binMin[bins[i]]);
+    REQUIRE(values[i] <= binMax[bins[i]]);
+  }
+
+  bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  histogramGain = HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 3, 1e-7, histogramSplitInfo,
+      histogramAux);
+
+  REQUIRE(histogramGain > bestGain);
+  REQUIRE(histogramGain != DBL_MAX);
+  REQUIRE(histogramSplitInfo.n_elem == 1);
+  REQUIRE(histogramSplitInfo[0] == Approx(0.3).margin(0.01));
+}
+
+/**
+ * Test that a decision tree built with HistogramNumericSplit generalizes
+ * reasonably.
+ */
+TEST_CASE("HistogramNumericSplitGeneralizationTest", "[DecisionTreeTest]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load test dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  arma::rowvec weights(labels.n_cols, arma::fill::ones);
+
+  DecisionTree<GiniGain, HistogramNumericSplit> d(inputData, labels, 3, 10);
+  DecisionTree<GiniGain, HistogramNumericSplit> wd(inputData, labels, 3,
+      weights, 10);
+
+  arma::mat testData;
+  if (!data::Load("vc2_test.csv", testData))
+    FAIL("Cannot load test dataset vc2_test.csv!");
+
+  arma::Mat<size_t> trueTestLabels;
+  if (!data::Load("vc2_test_labels.txt", trueTestLabels))
+    FAIL("Cannot load labels for vc2_test_labels.txt");
+
+  arma::Row<size_t> predictions, weightedPredictions;
+  d.Classify(testData, predictions);
+  wd.Classify(testData, weightedPredictions);
+
+  REQUIRE(predictions.n_elem == testData.n_cols);
+  REQUIRE(weightedPredictions.n_elem == testData.n_cols);
+
+  double correct = 0.0, weightedCorrect = 0.0;
+  for (size_t i = 0; i < predictions.n_elem; ++i)
+  {
+    if (predictions[i] == trueTestLabels[i])
+      ++correct;
+    if (weightedPredictions[i] == trueTestLabels[i])
+      ++weightedCorrect;
+  }
+
+  REQUIRE(correct / predictions.n_elem > 0.75);
+  REQUIRE(weightedCorrect / predictions.n_elem > 0.75);
+}
+
 /**
  * Check that the AllCategoricalSplit will split when the split is obviously
  * better.
@@ -1852,3 +1981,163 @@ TEST_CASE("DifferentMaximumDepthTest", "[DecisionTreeTest]")
   REQUIRE(d2.Child(0).NumChildren() == 2);
   REQUIRE(d2.Child(1).NumChildren() == 2);
 }
+
+// Recursively check that two decision trees have the same structure.
+template<typename TreeType>
+void CheckSameTree(const TreeType& a, const TreeType& b)
+{
+  REQUIRE(a.NumChildren() == b.NumChildren());
+  if (a.NumChildren() == 0)
+    return;
+
+  REQUIRE(a.SplitDimension() == b.SplitDimension());
+  for (size_t i = 0; i < a.NumChildren(); ++i)
+    CheckSameTree(a.Child(i), b.Child(i));
+}
+
+/**
+ * Make sure that a decision tree trained on a dataset large enough to be
+ * trained in parallel is the same as one trained with a single thread, with
+ * and without categorical dimensions.
+ */
+TEST_CASE("DecisionTreeParallelTrainTest", "[DecisionTreeTest]")
+{
+  arma::mat dataset(8, 20000, arma::fill::randu);
+  arma::Row<size_t> labels(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    labels[i] = (dataset(0, i) + dataset(3, i) > 1.0) ? 1 : 0;
+    if (dataset(5, i) > 0.7)
+      labels[i] += 1;
+    // Add some noise.
+    if (Random() < 0.05)
+      labels[i] = RandInt(3);
+  }
+
+  // Make the last dimension categorical.
+  data::DatasetInfo info(dataset.n_rows);
+  info.Type(7) = data::Datatype::categorical;
+  info.MapString<double>("0", 7);
+  info.MapString<double>("1", 7);
+  dataset.row(7) = arma::round(dataset.row(7));
+
+  #ifdef MLPACK_USE_OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  DecisionTree<> single(dataset, labels, 3, 10);
+  DecisionTree<> singleCategorical(dataset, info, labels, 3, 10);
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(threads);
+  #endif
+
+  DecisionTree<> parallel(dataset, labels, 3, 10);
+  DecisionTree<> parallelCategorical(dataset, info, labels, 3, 10);
+
+  CheckSameTree(single, parallel);
+  CheckSameTree(singleCategorical, parallelCategorical);
+
+  arma::Row<size_t> singlePredictions, parallelPredictions;
+  single.Classify(dataset, singlePredictions);
+  parallel.Classify(dataset, parallelPredictions);
+  REQUIRE(arma::all(singlePredictions == parallelPredictions));
+
+  singleCategorical.Classify(dataset, singlePredictions);
+  parallelCategorical.Classify(dataset, parallelPredictions);
+  REQUIRE(arma::all(singlePredictions == parallelPredictions));
+}
+
+/**
+ * Make sure that TrainPresorted() builds the same tree as Train(), with and
+ * without weights.
+ */
+TEST_CASE("DecisionTreeTrainPresortedTest", "[DecisionTreeTest]")
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load test dataset vc2.csv!");
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt!");
+
+  arma::rowvec weights(labels.n_elem);
+  for (size_t i = 0; i < weights.n_elem; ++i)
+    weights[i] = (i % 3 == 0) ? 2.0 : 1.0;
+
+  DecisionTree<> tree(dataset, labels, 3, 5);
+  DecisionTree<> weightedTree(dataset, labels, 3, weights, 5);
+
+  DecisionTree<> presortedTree, weightedPresortedTree;
+  const double entropy = presortedTree.TrainPresorted(dataset, labels, 3, 5);
+  const double weightedEntropy = weightedPresortedTree.TrainPresorted(dataset,
+      labels, 3, weights, 5);
+
+  CheckSameTree(tree, presortedTree);
+  CheckSameTree(weightedTree, weightedPresortedTree);
+  REQUIRE(entropy == Approx(tree.Train(dataset, labels, 3, 5)).epsilon(1e-10));
+  REQUIRE(weightedEntropy == Approx(weightedTree.Train(dataset, labels, 3,
+      weights, 5)).epsilon(1e-10));
+
+  arma::Row<size_t> predictions, presortedPredictions;
+  tree.Classify(dataset, predictions);
+  presortedTree.Classify(dataset, presortedPredictions);
+  REQUIRE(arma::all(predictions == presortedPredictions));
+
+  weightedTree.Classify(dataset, predictions);
+  weightedPresortedTree.Classify(dataset, presortedPredictions);
+  REQUIRE(arma::all(predictions == presortedPredictions));
+}
+
+/**
+ * Make sure that the batch Classify() methods, which route blocks of points
+ * down the tree, give the same results as classifying each point on its own.
+ */
+TEST_CASE("DecisionTreeBatchClassifyTest", "[DecisionTreeTest]")
+{
+  // Use more points than one block, and a number of points that is not a
+  // multiple of the block size.
+  arma::mat dataset(6, 2 * DecisionTree<>::ClassifyBlockSize + 123,
+      arma::fill::randu);
+  arma::Row<size_t> labels(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    labels[i] = (dataset(0, i) + dataset(2, i) > 1.0) ? 1 : 0;
+    if (dataset(4, i) > 0.6)
+      labels[i] += 1;
+    if (Random() < 0.05)
+      labels[i] = RandInt(3);
+  }
+
+  // Make the last dimension categorical.
+  data::DatasetInfo info(dataset.n_rows);
+  info.Type(5) = data::Datatype::categorical;
+  info.MapString<double>("0", 5);
+  info.MapString<double>("1", 5);
+  info.MapString<double>("2", 5);
+  dataset.row(5) = arma::floor(3 * dataset.row(5));
+
+  DecisionTree<> tree(dataset, info, labels, 3, 5);
+  REQUIRE(tree.NumChildren() > 0);
+
+  arma::Row<size_t> predictions, probabilityPredictions;
+  arma::mat probabilities;
+  tree.Classify(dataset, predictions);
+  tree.Classify(dataset, probabilityPredictions, probabilities);
+
+  REQUIRE(predictions.n_elem == dataset.n_cols);
+  REQUIRE(probabilities.n_rows == 3);
+  REQUIRE(probabilities.n_cols == dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    size_t prediction;
+    arma::vec pointProbabilities;
+    tree.Classify(dataset.col(i), prediction, pointProbabilities);
+
+    REQUIRE(predictions[i] == tree.Classify(dataset.col(i)));
+    REQUIRE(probabilityPredictions[i] == prediction);
+    REQUIRE(arma::approx_equal(probabilities.col(i), pointProbabilities,
+        "absdiff", 1e-12));
+  }
+}
@@ -490,6 +490,56 @@ TEST_CASE("TestSparseComputeValue", "[DETTest]")
   REQUIRE(0.0 == Approx(testDTree.ComputeValue(q4)).epsilon(1e-12));
 }
 
+/**
+ * Make sure that a tree grown on a large dataset (whose subtrees are grown in
+ * parallel) is the same as the tree grown with one thread, and that the batch
+ * ComputeValue() gives the same densities as ComputeValue() on each point.
+ */
+TEST_CASE("TestParallelGrowAndBatchComputeValue", "[DETTest]")
+{
+  const arma::mat data = arma::randu<arma::mat>(3, 25000);
+  arma::mat singleData(data), parallelData(data);
+  arma::Col<size_t> singleOldFromNew = arma::regspace<arma::Col<size_t>>(0,
+      data.n_cols - 1);
+  arma::Col<size_t> parallelOldFromNew(singleOldFromNew);
+
+  #ifdef MLPACK_USE_OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  DTree<arma::mat> single(singleData);
+  const double singleAlpha = single.Grow(singleData, singleOldFromNew, false,
+      10, 5);
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(threads);
+  #endif
+
+  DTree<arma::mat> parallel(parallelData);
+  const double parallelAlpha = parallel.Grow(parallelData, parallelOldFromNew,
+      false, 10, 5);
+
+  REQUIRE(single.SubtreeLeaves() > 1);
+  REQUIRE(parallel.SubtreeLeaves() == single.SubtreeLeaves());
+  REQUIRE(parallelAlpha == Approx(singleAlpha).epsilon(1e-12));
+  REQUIRE(arma::all(parallelOldFromNew == singleOldFromNew));
+
+  const arma::mat queries = arma::randu<arma::mat>(3, 1000);
+  arma::vec singleValues, parallelValues;
+  single.ComputeValue(queries, singleValues);
+  parallel.ComputeValue(queries, parallelValues);
+
+  REQUIRE(parallelValues.n_elem == queries.n_cols);
+  for (size_t i = 0; i < queries.n_cols; ++i)
+  {
+    const arma::vec query = queries.col(i);
+    REQUIRE(singleValues[i] ==
+        Approx(single.ComputeValue(query)).epsilon(1e-12));
+    REQUIRE(parallelValues[i] == Approx(singleValues[i]).epsilon(1e-12));
+  }
+}
+
 /**
  * These are not yet implemented.
  *
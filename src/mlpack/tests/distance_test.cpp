@@ -210,6 +210,54 @@ TEMPLATE_TEST_CASE("MDFullCovarianceTest", "[DistanceTest]", float, double)
   REQUIRE(md.Evaluate(b, a) == Approx(15.7).epsilon(1e-7));
 }
 
+/**
+ * Make sure that the Euclidean distances between the points stretched by
+ * Transform() are the Mahalanobis distances, for positive definite and
+ * positive semidefinite Q matrices.
+ */
+TEMPLATE_TEST_CASE("MDTransformTest", "[DistanceTest]", float, double)
+{
+  typedef TestType eT;
+
+  arma::Mat<eT> x(6, 6, arma::fill::randn);
+  arma::Mat<eT> lowRank(6, 3, arma::fill::randn);
+  arma::Mat<eT> data(6, 20, arma::fill::randn);
+
+  // The last Q is only positive semidefinite (rank 3).
+  std::vector<arma::Mat<eT>> qs = { x.t() * x + arma::eye<arma::Mat<eT>>(6, 6),
+      lowRank * lowRank.t() };
+
+  for (size_t i = 0; i < qs.size(); ++i)
+  {
+    MahalanobisDistance<true, arma::Mat<eT>> md(qs[i]);
+
+    arma::Mat<eT> transformed;
+    md.Transform(data, transformed);
+    REQUIRE(transformed.n_cols == data.n_cols);
+    REQUIRE(arma::approx_equal(md.Whitening().t() * md.Whitening(), qs[i],
+        "reldiff", 1e-3));
+
+    for (size_t j = 1; j < data.n_cols; ++j)
+    {
+      const eT distance = md.Evaluate(data.col(0), data.col(j));
+      const eT euclidean = EuclideanDistance::Evaluate(transformed.col(0),
+          transformed.col(j));
+      REQUIRE(euclidean == Approx(distance).epsilon(1e-3).margin(1e-3));
+    }
+  }
+
+  // Modifying Q should discard the cached factor.
+  MahalanobisDistance<true, arma::Mat<eT>> md(qs[0]);
+  REQUIRE(md.Whitening().n_rows == 6);
+  md.Q() = arma::eye<arma::Mat<eT>>(6, 6);
+  REQUIRE(arma::approx_equal(arma::abs(md.Whitening()),
+      arma::eye<arma::Mat<eT>>(6, 6), "absdiff", 1e-5));
+
+  // The dimensionality must match.
+  arma::Mat<eT> wrongData(5, 3, arma::fill::randn), wrongOutput;
+  REQUIRE_THROWS_AS(md.Transform(wrongData, wrongOutput), std::runtime_error);
+}
+
 /**
  * Simple test for L-1 metric.
  */
@@ -288,6 +336,77 @@ TEST_CASE("LINFMetricTest", "[DistanceTest]")
       Approx(lMetric.Evaluate(a2, b2)).epsilon(1e-7));
 }
 
+/**
+ * Make sure that FixedLMetric gives the same results as a straightforward
+ * computation of the L-metrics.
+ */
+TEMPLATE_TEST_CASE("FixedLMetricTest", "[DistanceTest]", float, double)
+{
+  typedef TestType eT;
+
+  arma::Mat<eT> data(3, 10, arma::fill::randn);
+  typename arma::Col<eT>::template fixed<3> a = data.col(0);
+  for (size_t i = 1; i < data.n_cols; ++i)
+  {
+    const arma::Col<eT> diff = arma::abs(data.col(0) - data.col(i));
+
+    REQUIRE(FixedLMetric<1, 3>::Evaluate(a, data.col(i)) ==
+        Approx(arma::accu(diff)).epsilon(1e-5));
+    REQUIRE(FixedLMetric<2, 3, false>::Evaluate(data.col(0), data.col(i)) ==
+        Approx(arma::accu(arma::square(diff))).epsilon(1e-5));
+    REQUIRE(FixedLMetric<2, 3>::Evaluate(data.col(0), data.col(i)) ==
+        Approx(std::sqrt(arma::accu(arma::square(diff)))).epsilon(1e-5));
+    REQUIRE(FixedLMetric<3, 3>::Evaluate(a, data.col(i)) ==
+        Approx(std::cbrt(arma::accu(arma::pow(diff, 3)))).epsilon(1e-5));
+    REQUIRE(FixedLMetric<4, 3, false>::Evaluate(data.col(0), data.col(i)) ==
+        Approx(arma::accu(arma::pow(diff, 4))).epsilon(1e-5));
+    REQUIRE(FixedLMetric<INT_MAX, 3>::Evaluate(data.col(0), data.col(i)) ==
+        Approx(diff.max()).epsilon(1e-5));
+  }
+}
+
+/**
+ * Make sure that LMetric gives the same results as FixedLMetric and as a
+ * straightforward computation, for low and high dimensionalities.
+ */
+TEMPLATE_TEST_CASE("LMetricFixedDimensionTest", "[DistanceTest]", float,
+    double)
+{
+  typedef TestType eT;
+
+  arma::Mat<eT> points(4, 2, arma::fill::randn);
+  REQUIRE(EuclideanDistance::Evaluate(points.col(0), points.col(1)) ==
+      Approx((FixedLMetric<2, 4>::Evaluate(points.col(0), points.col(1))))
+      .epsilon(1e-5));
+  REQUIRE(ManhattanDistance::Evaluate(points.col(0), points.col(1)) ==
+      Approx((FixedLMetric<1, 4>::Evaluate(points.col(0), points.col(1))))
+      .epsilon(1e-5));
+
+  for (size_t dim = 1; dim <= 35; ++dim)
+  {
+    arma::Mat<eT> data(dim, 2, arma::fill::randn);
+    const arma::Col<eT> a = data.col(0);
+    const arma::Col<eT> b = data.col(1);
+    const arma::Col<eT> diff = arma::abs(a - b);
+
+    REQUIRE(ManhattanDistance::Evaluate(a, b) ==
+        Approx(arma::accu(diff)).epsilon(1e-5));
+    REQUIRE(SquaredEuclideanDistance::Evaluate(data.col(0), data.col(1)) ==
+        Approx(arma::accu(arma::square(diff))).epsilon(1e-5));
+    REQUIRE(EuclideanDistance::Evaluate(a, data.col(1)) ==
+        Approx(std::sqrt(arma::accu(arma::square(diff)))).epsilon(1e-5));
+    REQUIRE(LMetric<3, false>::Evaluate(a, b) ==
+        Approx(arma::accu(arma::pow(diff, 3))).epsilon(1e-5));
+    REQUIRE(ChebyshevDistance::Evaluate(data.col(0), b) ==
+        Approx(diff.max()).epsilon(1e-5));
+
+    // Sparse vectors take the general path.
+    const arma::SpCol<eT> sa(a), sb(b);
+    REQUIRE(SquaredEuclideanDistance::Evaluate(sa, sb) ==
+        Approx(arma::accu(arma::square(diff))).epsilon(1e-5));
+  }
+}
+
 /**
  * Simple test for IoU distance.
  */
@@ -162,3 +162,30 @@ TEST_CASE("SparseTest", "[DrusillaSelectTest]")
   REQUIRE(distances.n_cols == 1000);
   REQUIRE(distances.n_rows == 3);
 }
+
+// With every point in the candidate set, a search on 32-bit floats over more
+// queries than fit in one block should still give the exact furthest
+// neighbors.
+TEST_CASE("DrusillaSelectFloatExhaustiveTest", "[DrusillaSelectTest]")
+{
+  arma::fmat dataset = arma::randu<arma::fmat>(5, 600);
+
+  DrusillaSelect<arma::fmat> ds(dataset, 600, 1);
+
+  arma::fmat distances;
+  arma::Mat<size_t> neighbors;
+  ds.Search(dataset, 5, neighbors, distances);
+
+  KFN kfn(arma::conv_to<arma::mat>::from(dataset));
+  arma::mat distancesTrue;
+  arma::Mat<size_t> neighborsTrue;
+  kfn.Search(5, neighborsTrue, distancesTrue);
+
+  REQUIRE(neighbors.n_rows == 5);
+  REQUIRE(neighbors.n_cols == 600);
+  REQUIRE(distances.n_rows == 5);
+  REQUIRE(distances.n_cols == 600);
+
+  for (size_t i = 0; i < distances.n_elem; ++i)
+    REQUIRE(distances[i] == Approx(distancesTrue[i]).epsilon(1e-5));
+}
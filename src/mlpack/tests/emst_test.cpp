@@ -269,3 +269,50 @@ TEST_CASE("EMSTBallTreeTest", "[EMSTTest]")
     REQUIRE(bstResults(2, i) == Approx(ballResults(2, i)).epsilon(1e-7));
   }
 }
+
+/**
+ * Make sure that points with many equal distances (which are split between
+ * threads if OpenMP is enabled) give a spanning tree of the right length, and
+ * that the same tree is found every time.
+ */
+TEST_CASE("EMSTTiedDistancesTest", "[EMSTTest]")
+{
+  // Points of a 20x20x5 integer lattice, where every edge has length 1.
+  arma::mat inputData(3, 2000);
+  for (size_t i = 0; i < inputData.n_cols; ++i)
+  {
+    inputData(0, i) = i % 20;
+    inputData(1, i) = (i / 20) % 20;
+    inputData(2, i) = i / 400;
+  }
+
+  DualTreeBoruvka<> naive(inputData, true);
+  DualTreeBoruvka<> dualTree(inputData);
+  DualTreeBoruvka<> dualTree2(inputData);
+
+  arma::mat naiveResults, dualResults, dualResults2;
+  naive.ComputeMST(naiveResults);
+  dualTree.ComputeMST(dualResults);
+  dualTree2.ComputeMST(dualResults2);
+
+  REQUIRE(naiveResults.n_cols == 1999);
+  REQUIRE(dualResults.n_cols == 1999);
+  REQUIRE(arma::accu(naiveResults.row(2)) == Approx(1999.0).epsilon(1e-7));
+  REQUIRE(arma::accu(dualResults.row(2)) == Approx(1999.0).epsilon(1e-7));
+
+  // The result must be a spanning tree.
+  UnionFind uf(inputData.n_cols);
+  for (size_t i = 0; i < dualResults.n_cols; ++i)
+  {
+    const size_t e1 = (size_t) dualResults(0, i);
+    const size_t e2 = (size_t) dualResults(1, i);
+    REQUIRE(uf.Find(e1) != uf.Find(e2));
+    uf.Union(e1, e2);
+  }
+
+  for (size_t i = 0; i < dualResults.n_cols; ++i)
+  {
+    REQUIRE(dualResults(0, i) == dualResults2(0, i));
+    REQUIRE(dualResults(1, i) == dualResults2(1, i));
+  }
+}
@@ -1137,3 +1137,82 @@ TEST_CASE("CopyAssignmentTest", "[FastMKSTest]")
       REQUIRE(newKernels[i] == Approx(0.0).margin(1e-5));
   }
 }
+
+/**
+ * Make sure that single-tree and dual-tree search give the same results as
+ * naive search whether the queries are split between threads or not, also when
+ * a query tree is searched with more than once.
+ */
+TEST_CASE("FastMKSParallelSearchTest", "[FastMKSTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(6, 1500);
+  arma::mat queryData = arma::randu<arma::mat>(6, 800);
+  GaussianKernel gk(0.5);
+
+  FastMKS<GaussianKernel> naive(referenceData, gk, false, true);
+  arma::Mat<size_t> naiveIndices;
+  arma::mat naiveKernels;
+  naive.Search(queryData, 5, naiveIndices, naiveKernels);
+
+  #ifdef MLPACK_USE_OPENMP
+  const int threads = omp_get_max_threads();
+  #endif
+
+  FastMKS<GaussianKernel> single(referenceData, gk, true);
+  FastMKS<GaussianKernel> dual(referenceData, gk);
+  FastMKS<GaussianKernel>::Tree queryTree(queryData);
+
+  for (size_t trial = 0; trial < 2; ++trial)
+  {
+    #ifdef MLPACK_USE_OPENMP
+    omp_set_num_threads(trial == 0 ? 1 : threads);
+    #endif
+
+    arma::Mat<size_t> singleIndices, dualIndices, treeIndices;
+    arma::mat singleKernels, dualKernels, treeKernels;
+    single.Search(queryData, 5, singleIndices, singleKernels);
+    dual.Search(queryData, 5, dualIndices, dualKernels);
+    dual.Search(&queryTree, 5, treeIndices, treeKernels);
+
+    // The cover tree does not rearrange the query points.
+    REQUIRE(arma::all(arma::vectorise(singleIndices == naiveIndices)));
+    REQUIRE(arma::all(arma::vectorise(dualIndices == naiveIndices)));
+    REQUIRE(arma::all(arma::vectorise(treeIndices == naiveIndices)));
+    for (size_t i = 0; i < naiveKernels.n_elem; ++i)
+    {
+      REQUIRE(singleKernels[i] == Approx(naiveKernels[i]).epsilon(1e-7));
+      REQUIRE(dualKernels[i] == Approx(naiveKernels[i]).epsilon(1e-7));
+      REQUIRE(treeKernels[i] == Approx(naiveKernels[i]).epsilon(1e-7));
+    }
+  }
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(threads);
+  #endif
+}
+
+/**
+ * Naive search evaluates the kernel for every pair of points, and tree search
+ * should evaluate it for fewer pairs.
+ */
+TEST_CASE("FastMKSBaseCasesTest", "[FastMKSTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(3, 1000);
+
+  FastMKS<LinearKernel> naive(data, false, true);
+  FastMKS<LinearKernel> dual(data);
+
+  arma::Mat<size_t> indices;
+  arma::mat kernels;
+  naive.Search(data, 5, indices, kernels);
+  REQUIRE(naive.BaseCases() == 1000 * 1000);
+  REQUIRE(naive.Scores() == 0);
+
+  naive.Search(5, indices, kernels);
+  REQUIRE(naive.BaseCases() == 1000 * 999);
+
+  dual.Search(5, indices, kernels);
+  REQUIRE(dual.BaseCases() > 0);
+  REQUIRE(dual.BaseCases() < 1000 * 999);
+  REQUIRE(dual.Scores() > 0);
+}
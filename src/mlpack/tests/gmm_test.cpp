@@ -486,6 +486,53 @@ TEST_CASE("GMMRandomTest", "[GMMTest]")
       1)).epsilon(0.13));
 }
 
+/**
+ * Make sure that the observations generated in a batch follow the
+ * distribution of the GMM, and only depend on the random seed.
+ */
+TEST_CASE("GMMBatchedRandomTest", "[GMMTest]")
+{
+  GMM gmm(3, 2);
+  gmm.Weights() = arma::vec("0.20 0.30 0.50");
+  gmm.Component(0) = GaussianDistribution<>("2.25 3.10",
+                                            "1.00 0.60; 0.60 0.89");
+  gmm.Component(1) = GaussianDistribution<>("-4.10 1.01",
+                                            "1.00 0.70; 0.70 1.01");
+  gmm.Component(2) = GaussianDistribution<>("0.00 -5.00",
+                                            "0.50 0.00; 0.00 2.00");
+
+  RandomSeed(7);
+  arma::mat observations;
+  gmm.Random(20000, observations);
+  REQUIRE(observations.n_rows == 2);
+  REQUIRE(observations.n_cols == 20000);
+
+  RandomSeed(7);
+  arma::mat sameObservations;
+  gmm.Random(20000, sameObservations);
+  CheckMatrices(observations, sameObservations);
+
+  // The components are far enough apart to classify the observations.
+  arma::Row<size_t> labels;
+  gmm.Classify(observations, labels);
+  for (size_t g = 0; g < 3; ++g)
+  {
+    const arma::uvec points = arma::find(labels == g);
+    REQUIRE((double) points.n_elem / 20000.0 ==
+        Approx(gmm.Weights()[g]).margin(0.02));
+
+    // The observations of a component must not all be together.
+    REQUIRE(points.max() - points.min() > 10000);
+
+    const arma::vec mean = arma::mean(observations.cols(points), 1);
+    REQUIRE(mean[0] == Approx(gmm.Component(g).Mean()[0]).margin(0.1));
+    REQUIRE(mean[1] == Approx(gmm.Component(g).Mean()[1]).margin(0.1));
+  }
+
+  gmm.Random(0, observations);
+  REQUIRE(observations.n_cols == 0);
+}
+
 /**
  * Test classification of observations by component.
  */
@@ -533,6 +580,46 @@ TEST_CASE("GMMClassifyTest", "[GMMTest]")
   REQUIRE(classes[12] == 2);
 }
 
+/**
+ * Test that the batched evaluation of many points (across several blocks)
+ * matches the evaluation of each point by itself.
+ */
+TEST_CASE("GMMBatchedProbabilityTest", "[GMMTest]")
+{
+  GMM gmm(3, 4);
+  for (size_t j = 0; j < 3; ++j)
+  {
+    arma::mat factor = arma::randn(4, 4);
+    gmm.Component(j) = GaussianDistribution<>(3.0 * arma::randn<arma::vec>(4),
+        factor * factor.t() + 0.5 * arma::eye(4, 4));
+  }
+  gmm.Weights() = "0.5 0.3 0.2";
+
+  arma::mat observations = 3.0 * arma::randn(4, 3000);
+
+  arma::vec logProbs, probs;
+  arma::Row<size_t> classes;
+  gmm.LogProbability(observations, logProbs);
+  gmm.Probability(observations, probs);
+  gmm.Classify(observations, classes);
+
+  REQUIRE(logProbs.n_elem == observations.n_cols);
+  REQUIRE(probs.n_elem == observations.n_cols);
+  REQUIRE(classes.n_elem == observations.n_cols);
+  for (size_t i = 0; i < observations.n_cols; ++i)
+  {
+    const arma::vec observation = observations.col(i);
+    REQUIRE(logProbs[i] == Approx(gmm.LogProbability(observation)));
+    REQUIRE(probs[i] == Approx(gmm.Probability(observation)));
+
+    arma::vec componentLogProbs(3);
+    for (size_t j = 0; j < 3; ++j)
+      componentLogProbs[j] = gmm.LogProbability(observation, j);
+    REQUIRE(componentLogProbs[classes[i]] ==
+        Approx(componentLogProbs.max()).epsilon(1e-10));
+  }
+}
+
 TEST_CASE("GMMLoadSaveTest", "[GMMTest]")
 {
   // Create a GMM, save it, and load it.
@@ -1121,6 +1208,56 @@ TEST_CASE("DiagonalGMMTrainEMMultipleGaussiansWithProbability", "[GMMTest]")
   }
 }
 
+/**
+ * Test that the blocked evaluation of a DiagonalGMM matches the evaluation of
+ * each point by itself, and that a single precision copy of the model gives
+ * the same results up to its precision.
+ */
+TEST_CASE("DiagonalGMMBlockedFloatTest", "[GMMTest]")
+{
+  DiagonalGMM gmm(20, 8);
+  for (size_t j = 0; j < 20; ++j)
+  {
+    gmm.Component(j) = DiagonalGaussianDistribution<>(
+        2.0 * arma::randn<arma::vec>(8), arma::randu<arma::vec>(8) + 0.5);
+  }
+  gmm.Weights() = arma::normalise(arma::randu<arma::vec>(20) + 0.1, 1);
+
+  // Several blocks of points, the last one incomplete.
+  arma::mat observations = 2.0 * arma::randn(8, 1000);
+
+  arma::vec logProbs;
+  arma::Row<size_t> classes;
+  gmm.LogProbability(observations, logProbs);
+  gmm.Classify(observations, classes);
+
+  REQUIRE(logProbs.n_elem == observations.n_cols);
+  REQUIRE(classes.n_elem == observations.n_cols);
+  for (size_t i = 0; i < observations.n_cols; ++i)
+  {
+    const arma::vec observation = observations.col(i);
+    REQUIRE(logProbs[i] == Approx(gmm.LogProbability(observation)));
+
+    arma::vec componentLogProbs(20);
+    for (size_t j = 0; j < 20; ++j)
+      componentLogProbs[j] = gmm.LogProbability(observation, j);
+    REQUIRE(componentLogProbs[classes[i]] ==
+        Approx(componentLogProbs.max()).epsilon(1e-10));
+  }
+
+  // Now convert the model to single precision.
+  DiagonalGMMType<arma::fmat> floatGMM(gmm);
+  REQUIRE(floatGMM.Gaussians() == 20);
+  REQUIRE(floatGMM.Dimensionality() == 8);
+
+  arma::fvec floatLogProbs;
+  floatGMM.LogProbability(arma::conv_to<arma::fmat>::from(observations),
+      floatLogProbs);
+  REQUIRE(floatLogProbs.n_elem == observations.n_cols);
+  for (size_t i = 0; i < observations.n_cols; ++i)
+    REQUIRE(floatLogProbs[i] == Approx(logProbs[i]).epsilon(1e-4));
+}
+
 /**
  * Make sure generating observations randomly works.  We'll do this by
  * generating a bunch of random observations and then re-training on them, and
@@ -1231,3 +1368,148 @@ TEST_CASE("DiagonalGMMLoadSaveTest", "[GMMTest]")
     }
   }
 }
+
+/**
+ * Make sure that a single EM iteration (with points split into several blocks)
+ * gives the same model as the textbook update, with and without point
+ * probabilities.  The data is far from the origin, to check that the
+ * covariances are computed accurately.
+ */
+TEST_CASE("EMFitSingleIterationTest", "[GMMTest]")
+{
+  const size_t dims = 3;
+  const size_t gaussians = 2;
+  arma::mat data = arma::randn(dims, 3000);
+  data.cols(0, 1499).each_col() += arma::vec({ 1000.0, 1000.0, 1000.0 });
+  data.cols(1500, 2999).each_col() += arma::vec({ 1003.0, 1000.0, 997.0 });
+  data += 0.3 * arma::randu(dims, 3000);
+
+  std::vector<GaussianDistribution<>> initialDists(gaussians);
+  initialDists[0] = GaussianDistribution<>(
+      arma::vec({ 1001.0, 1001.0, 1001.0 }),
+      2.0 * arma::eye<arma::mat>(dims, dims));
+  initialDists[1] = GaussianDistribution<>(
+      arma::vec({ 1002.0, 999.0, 998.0 }),
+      arma::eye<arma::mat>(dims, dims));
+  const arma::vec initialWeights({ 0.3, 0.7 });
+
+  for (size_t trial = 0; trial < 2; ++trial)
+  {
+    const arma::vec probabilities = (trial == 0) ?
+        arma::vec(data.n_cols, arma::fill::ones) :
+        arma::vec(arma::randu<arma::vec>(data.n_cols));
+
+    // Compute the expected update directly.
+    arma::mat resp(data.n_cols, gaussians);
+    for (size_t i = 0; i < gaussians; ++i)
+    {
+      arma::vec prob;
+      initialDists[i].Probability(data, prob);
+      resp.col(i) = initialWeights[i] * prob;
+    }
+    resp.each_col() /= arma::sum(resp, 1);
+    resp.each_col() %= probabilities;
+
+    std::vector<GaussianDistribution<>> dists(initialDists);
+    arma::vec weights(initialWeights);
+    EMFit<KMeans<>, NoConstraint> fitter(2, 0.0);
+    if (trial == 0)
+      fitter.Estimate(data, dists, weights, true);
+    else
+      fitter.Estimate(data, probabilities, dists, weights, true);
+
+    for (size_t i = 0; i < gaussians; ++i)
+    {
+      const double total = arma::accu(resp.col(i));
+      const arma::vec mean = data * resp.col(i) / total;
+      const arma::mat centered = data.each_col() - mean;
+      const arma::mat cov = (centered.each_row() % resp.col(i).t()) *
+          centered.t() / total;
+
+      REQUIRE(weights[i] ==
+          Approx(total / arma::accu(probabilities)).epsilon(1e-8));
+      for (size_t j = 0; j < dims; ++j)
+        REQUIRE(dists[i].Mean()[j] == Approx(mean[j]).epsilon(1e-8));
+      for (size_t j = 0; j < cov.n_elem; ++j)
+        REQUIRE(dists[i].Covariance()[j] ==
+            Approx(cov[j]).epsilon(1e-6).margin(1e-8));
+    }
+  }
+}
+
+/**
+ * Make sure that stepwise EM recovers two well-separated Gaussians, both from
+ * a dataset in memory and from a stream of batches, for GMM and DiagonalGMM.
+ */
+TEST_CASE("StepwiseEMFitTest", "[GMMTest]")
+{
+  // Two Gaussians with diagonal covariances, with 30% and 70% of the points.
+  arma::mat data(2, 4000);
+  data.randn();
+  data.row(0) *= 2.0;
+  data.cols(0, 1199).each_col() += arma::vec({ 50.0, 50.0 });
+  data.cols(1200, 3999).each_col() += arma::vec({ 60.0, 40.0 });
+  data = data.cols(arma::randperm(data.n_cols));
+
+  const arma::vec trueWeights({ 0.3, 0.7 });
+  const arma::mat trueMeans({ { 50.0, 60.0 }, { 50.0, 40.0 } });
+  const arma::vec trueVariances({ 4.0, 1.0 });
+
+  for (size_t trial = 0; trial < 4; ++trial)
+  {
+    GMM gmm(2, 2);
+    DiagonalGMM dgmm(2, 2);
+    StepwiseEMFit<> fitter(200, 5);
+    StepwiseEMFit<KMeans<>, DiagonalConstraint,
+        DiagonalGaussianDistribution<>> diagonalFitter(200, 5);
+
+    if (trial == 0)
+    {
+      gmm.Train(data, 1, false, fitter);
+    }
+    else if (trial == 1)
+    {
+      dgmm.Train(data, 1, false, diagonalFitter);
+    }
+    else
+    {
+      // Stream the data in chunks.
+      for (size_t epoch = 0; epoch < 5; ++epoch)
+      {
+        for (size_t begin = 0; begin < data.n_cols; begin += 500)
+        {
+          const arma::mat chunk = data.cols(begin, begin + 499);
+          if (trial == 2)
+            gmm.TrainBatch(chunk, fitter);
+          else
+            dgmm.TrainBatch(chunk, diagonalFitter);
+        }
+      }
+      REQUIRE((trial == 2 ? fitter.Steps() : diagonalFitter.Steps()) == 40);
+    }
+
+    for (size_t i = 0; i < 2; ++i)
+    {
+      const arma::vec mean = (trial % 2 == 0) ? gmm.Component(i).Mean() :
+          dgmm.Component(i).Mean();
+      const arma::vec variances = (trial % 2 == 0) ?
+          arma::vec(gmm.Component(i).Covariance().diag()) :
+          dgmm.Component(i).Covariance();
+      const double weight = (trial % 2 == 0) ? gmm.Weights()[i] :
+          dgmm.Weights()[i];
+
+      // Find the matching Gaussian.
+      const size_t j = (mean[0] < 55.0) ? 0 : 1;
+      REQUIRE(weight == Approx(trueWeights[j]).margin(0.05));
+      REQUIRE(mean[0] == Approx(trueMeans(0, j)).margin(0.3));
+      REQUIRE(mean[1] == Approx(trueMeans(1, j)).margin(0.3));
+      REQUIRE(variances[0] == Approx(trueVariances[0]).epsilon(0.25));
+      REQUIRE(variances[1] == Approx(trueVariances[1]).epsilon(0.25));
+    }
+  }
+
+  // The step exponent must be in (0.5, 1].
+  GMM gmm(2, 2);
+  StepwiseEMFit<> fitter(200, 5, 0.4);
+  REQUIRE_THROWS_AS(gmm.Train(data, 1, false, fitter), std::invalid_argument);
+}
@@ -526,6 +526,114 @@ TEST_CASE("DiscreteHMMLogLikelihoodTest", "[HMMTest]")
       Approx(-24.51556128368).epsilon(1e-7));
 }
 
+/**
+ * Make sure that the log-likelihoods and the most probable state sequences of
+ * several sequences at once (which may be computed in parallel) are the same as
+ * for each sequence on its own.
+ */
+TEST_CASE("DiscreteHMMMultipleSequencesTest", "[HMMTest]")
+{
+  arma::vec initial("0.5 0.2 0.3");
+  arma::mat transition("0.5 0.0 0.1;"
+                       "0.2 0.6 0.2;"
+                       "0.3 0.4 0.7");
+  std::vector<DiscreteDistribution<>> emission(3);
+  emission[0].Probabilities() = "0.75 0.25 0.00 0.00";
+  emission[1].Probabilities() = "0.00 0.25 0.25 0.50";
+  emission[2].Probabilities() = "0.10 0.40 0.40 0.10";
+
+  HMM<DiscreteDistribution<>> hmm(initial, transition, emission);
+
+  std::vector<arma::mat> dataSeq(50);
+  for (size_t i = 0; i < dataSeq.size(); ++i)
+  {
+    arma::Row<size_t> states;
+    hmm.Generate(5 + i, dataSeq[i], states);
+  }
+  dataSeq[0] = "0 1 2 3";
+  dataSeq[1] = "0 2 2 1 2 3 0 0 1 3 1 0 0 3 1 2 2";
+
+  arma::vec logLikelihoods;
+  const double total = hmm.LogLikelihood(dataSeq, logLikelihoods);
+  REQUIRE(logLikelihoods.n_elem == dataSeq.size());
+  REQUIRE(logLikelihoods[0] == Approx(-4.9887223949).epsilon(1e-7));
+  REQUIRE(logLikelihoods[1] == Approx(-24.51556128368).epsilon(1e-7));
+  REQUIRE(total == Approx(arma::accu(logLikelihoods)).epsilon(1e-10));
+
+  std::vector<arma::Row<size_t>> stateSeq;
+  arma::vec stateLogLikelihoods;
+  hmm.Predict(dataSeq, stateSeq, stateLogLikelihoods);
+  REQUIRE(stateSeq.size() == dataSeq.size());
+  for (size_t i = 0; i < dataSeq.size(); ++i)
+  {
+    REQUIRE(logLikelihoods[i] ==
+        Approx(hmm.LogLikelihood(dataSeq[i])).epsilon(1e-10));
+
+    arma::Row<size_t> states;
+    const double stateLogLikelihood = hmm.Predict(dataSeq[i], states);
+    REQUIRE(stateLogLikelihoods[i] ==
+        Approx(stateLogLikelihood).epsilon(1e-10));
+    REQUIRE(arma::all(stateSeq[i] == states));
+  }
+
+  // Training on the sequences must give a valid model that is at least as
+  // likely as the original one.
+  HMM<DiscreteDistribution<>> trained(hmm);
+  trained.Train(dataSeq);
+  REQUIRE(arma::accu(trained.Initial()) == Approx(1.0).epsilon(1e-7));
+  for (size_t i = 0; i < 3; ++i)
+  {
+    REQUIRE(arma::accu(trained.Transition().col(i)) ==
+        Approx(1.0).epsilon(1e-7));
+  }
+  arma::vec trainedLogLikelihoods;
+  REQUIRE(trained.LogLikelihood(dataSeq, trainedLogLikelihoods) >=
+      total - 1e-5);
+}
+
+/**
+ * Make sure that decoding a batch of equal-length sequences at once gives the
+ * same results as decoding each one on its own, for an HMM with some
+ * impossible transitions and emissions.
+ */
+TEST_CASE("DiscreteHMMBatchPredictTest", "[HMMTest]")
+{
+  arma::vec initial("0.5 0.2 0.3");
+  arma::mat transition("0.5 0.0 0.1;"
+                       "0.2 0.6 0.2;"
+                       "0.3 0.4 0.7");
+  std::vector<DiscreteDistribution<>> emission(3);
+  emission[0].Probabilities() = "0.75 0.25 0.00 0.00";
+  emission[1].Probabilities() = "0.00 0.25 0.25 0.50";
+  emission[2].Probabilities() = "0.10 0.40 0.40 0.10";
+
+  HMM<DiscreteDistribution<>> hmm(initial, transition, emission);
+
+  arma::cube dataSeq(1, 30, 100);
+  for (size_t i = 0; i < dataSeq.n_slices; ++i)
+  {
+    arma::mat sequence;
+    arma::Row<size_t> states;
+    hmm.Generate(dataSeq.n_cols, sequence, states);
+    dataSeq.slice(i) = sequence;
+  }
+
+  arma::Mat<size_t> stateSeq;
+  arma::vec logLikelihoods;
+  hmm.Predict(dataSeq, stateSeq, logLikelihoods);
+
+  REQUIRE(stateSeq.n_rows == dataSeq.n_slices);
+  REQUIRE(stateSeq.n_cols == dataSeq.n_cols);
+  REQUIRE(logLikelihoods.n_elem == dataSeq.n_slices);
+  for (size_t i = 0; i < dataSeq.n_slices; ++i)
+  {
+    arma::Row<size_t> states;
+    const double logLikelihood = hmm.Predict(dataSeq.slice(i), states);
+    REQUIRE(logLikelihoods[i] == Approx(logLikelihood).epsilon(1e-10));
+    REQUIRE(arma::all(stateSeq.row(i) == states));
+  }
+}
+
 /**
  * A simple test to make sure HMMs with Gaussian output distributions work.
  */
@@ -0,0 +1,173 @@
+/**
+ * @file tests/hnsw_test.cpp
+ *
+ * Unit tests for the 'HNSWSearch' class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include "catch.hpp"
+#include "test_catch_tools.hpp"
+
+#include <mlpack/methods/hnsw.hpp>
+#include <mlpack/methods/neighbor_search.hpp>
+
+using namespace std;
+using namespace mlpack;
+
+/**
+ * Make sure that the graph has a high recall against exact kNN, and that the
+ * recall grows with ef.
+ */
+TEST_CASE("HNSWRecallTest", "[HNSWTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(10, 3000);
+  arma::mat queryData = arma::randu<arma::mat>(10, 200);
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  knn.Search(queryData, 10, trueNeighbors, trueDistances);
+
+  HNSWSearch<> hnsw(referenceData, 16, 100);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  hnsw.Search(queryData, 10, neighbors, distances, 10);
+  const double lowRecall = HNSWSearch<>::ComputeRecall(neighbors,
+      trueNeighbors);
+
+  hnsw.Search(queryData, 10, neighbors, distances, 200);
+  const double highRecall = HNSWSearch<>::ComputeRecall(neighbors,
+      trueNeighbors);
+
+  REQUIRE(highRecall >= lowRecall);
+  REQUIRE(highRecall > 0.95);
+
+  // The neighbors must be sorted, and the distances must be correct.
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+  {
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+    {
+      REQUIRE(distances(j, i) == Approx(EuclideanDistance::Evaluate(
+          queryData.col(i), referenceData.col(neighbors(j, i)))).epsilon(1e-7));
+      if (j > 0)
+        REQUIRE(distances(j, i) >= distances(j - 1, i));
+    }
+  }
+}
+
+/**
+ * In a monochromatic search, no point may be its own neighbor.
+ */
+TEST_CASE("HNSWMonochromaticTest", "[HNSWTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(5, 1000);
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  knn.Search(5, trueNeighbors, trueDistances);
+
+  HNSWSearch<> hnsw(referenceData);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  hnsw.Search(5, neighbors, distances, 100);
+
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+    REQUIRE(arma::all(neighbors.col(i) != i));
+
+  REQUIRE(HNSWSearch<>::ComputeRecall(neighbors, trueNeighbors) > 0.95);
+}
+
+/**
+ * Build a graph one point at a time, and make sure that every node has at
+ * most the allowed number of links, and only to nodes of the same layer.
+ */
+TEST_CASE("HNSWIncrementalInsertTest", "[HNSWTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(8, 1500);
+
+  HNSWSearch<> hnsw(8, 100);
+  for (size_t i = 0; i < referenceData.n_cols; ++i)
+    hnsw.Insert(referenceData.col(i));
+
+  CheckMatrices(hnsw.ReferenceSet(), referenceData);
+  REQUIRE(hnsw.Level(hnsw.EntryPoint()) + 1 == hnsw.NumLayers());
+
+  for (size_t i = 0; i < referenceData.n_cols; ++i)
+  {
+    for (size_t layer = 0; layer <= hnsw.Level(i); ++layer)
+    {
+      const std::vector<size_t>& links = hnsw.Links(i, layer);
+      REQUIRE(links.size() <= ((layer == 0) ? 16 : 8));
+      for (size_t j = 0; j < links.size(); ++j)
+      {
+        REQUIRE(links[j] != i);
+        REQUIRE(hnsw.Level(links[j]) >= layer);
+      }
+    }
+  }
+
+  // Search for points that are in the reference set.
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  hnsw.Search(referenceData.cols(0, 99), 1, neighbors, distances, 50);
+  size_t found = 0;
+  for (size_t i = 0; i < 100; ++i)
+    found += (neighbors(0, i) == i) ? 1 : 0;
+  REQUIRE(found >= 98);
+
+  // Points of the wrong dimensionality can't be inserted.
+  REQUIRE_THROWS_AS(hnsw.Insert(arma::vec(3, arma::fill::randu)),
+      std::invalid_argument);
+}
+
+/**
+ * Search with the kernel-induced metric of the cosine similarity, which orders
+ * the neighbors of normalized points by inner product.
+ */
+TEST_CASE("HNSWInnerProductTest", "[HNSWTest]")
+{
+  arma::mat referenceData = arma::normalise(arma::randn<arma::mat>(6, 1000));
+  arma::mat queryData = arma::normalise(arma::randn<arma::mat>(6, 50));
+
+  HNSWSearch<IPMetric<CosineSimilarity>> hnsw(referenceData);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  hnsw.Search(queryData, 5, neighbors, distances, 100);
+
+  size_t found = 0;
+  for (size_t i = 0; i < queryData.n_cols; ++i)
+  {
+    const arma::rowvec products = queryData.col(i).t() * referenceData;
+    const arma::uvec order = arma::sort_index(products, "descend");
+    for (size_t j = 0; j < 5; ++j)
+      found += arma::any(neighbors.col(i) == order[j]) ? 1 : 0;
+  }
+
+  REQUIRE(found >= 0.95 * 5 * queryData.n_cols);
+}
+
+/**
+ * Make sure that invalid parameters and searches throw.
+ */
+TEST_CASE("HNSWInvalidParametersTest", "[HNSWTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(3, 20);
+
+  REQUIRE_THROWS_AS(HNSWSearch<>(referenceData, 1), std::invalid_argument);
+
+  HNSWSearch<> hnsw(referenceData);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  REQUIRE_THROWS_AS(hnsw.Search(referenceData, 21, neighbors, distances),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(hnsw.Search(20, neighbors, distances),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(hnsw.Search(arma::mat(4, 5, arma::fill::randu), 3,
+      neighbors, distances), std::invalid_argument);
+}
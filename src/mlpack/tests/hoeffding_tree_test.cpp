@@ -1835,3 +1835,138 @@ TEST_CASE("HoeffdingTreeCategoricalFloatDataTest", "[HoeffdingTreeTest]")
   REQUIRE(accu(batchPredictions == labels) > (labels.n_elem / 2));
   REQUIRE(accu(streamPredictions == labels) > (labels.n_elem / 2));
 }
+
+/**
+ * Make sure that mini-batch training with a batch size of 1 gives the same tree
+ * as streaming training.
+ */
+TEST_CASE("HoeffdingTreeMiniBatchStreamingTest", "[HoeffdingTreeTest]")
+{
+  // The label depends on the first two dimensions, so the tree should split
+  // several times.
+  arma::mat data(4, 5000, arma::fill::randu);
+  arma::Row<size_t> labels(5000);
+  for (size_t i = 0; i < 5000; ++i)
+    labels[i] = (data(0, i) < 0.5 ? 0 : 1) + (data(1, i) < 0.3 ? 0 : 2);
+
+  HoeffdingTree<> streamTree(4, 4, 0.9, 0, 50, 50);
+  HoeffdingTree<> miniBatchTree(4, 4, 0.9, 0, 50, 50);
+  streamTree.Train(data, labels, 4, false);
+  miniBatchTree.TrainMiniBatch(data, labels, 1);
+
+  REQUIRE(streamTree.NumDescendants() > 1);
+  REQUIRE(miniBatchTree.NumDescendants() == streamTree.NumDescendants());
+
+  arma::Row<size_t> streamPredictions, miniBatchPredictions;
+  arma::rowvec streamProbabilities, miniBatchProbabilities;
+  streamTree.Classify(data, streamPredictions, streamProbabilities);
+  miniBatchTree.Classify(data, miniBatchPredictions, miniBatchProbabilities);
+
+  CheckMatrices(streamPredictions, miniBatchPredictions);
+  CheckMatrices(streamProbabilities, miniBatchProbabilities);
+}
+
+/**
+ * Make sure that mini-batch training with large batches learns a decent tree,
+ * on numeric and categorical data, and rejects bad arguments.
+ */
+TEST_CASE("HoeffdingTreeMiniBatchTest", "[HoeffdingTreeTest]")
+{
+  // Dimension 0 is numeric and dimension 1 is categorical with 3 categories.
+  data::DatasetInfo info(2);
+  info.MapString<size_t>("a", 1);
+  info.MapString<size_t>("b", 1);
+  info.MapString<size_t>("c", 1);
+
+  arma::mat data(2, 20000);
+  arma::Row<size_t> labels(20000);
+  for (size_t i = 0; i < 20000; ++i)
+  {
+    data(0, i) = Random();
+    data(1, i) = RandInt(3);
+    labels[i] = (data(1, i) == 2) ? 2 : (data(0, i) < 0.5 ? 0 : 1);
+  }
+
+  arma::mat trainData = data.cols(0, 14999);
+  arma::Row<size_t> trainLabels = labels.subvec(0, 14999);
+  arma::mat testData = data.cols(15000, 19999);
+  arma::Row<size_t> testLabels = labels.subvec(15000, 19999);
+
+  HoeffdingTree<> tree(info, 3);
+  tree.TrainMiniBatch(trainData, trainLabels, 1000);
+
+  REQUIRE(tree.NumDescendants() > 1);
+
+  arma::Row<size_t> predictions;
+  tree.Classify(testData, predictions);
+  const size_t correct = arma::accu(predictions == testLabels);
+  REQUIRE(correct >= 4500);
+
+  // The dimensionality must match that of the tree.
+  arma::mat badData(3, 100, arma::fill::randu);
+  arma::Row<size_t> badLabels(100, arma::fill::zeros);
+  REQUIRE_THROWS_AS(tree.TrainMiniBatch(badData, badLabels, 10),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(tree.TrainMiniBatch(data, badLabels, 10),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(tree.TrainMiniBatch(data, labels, 0),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that the number of active leaves stays within the limit during
+ * streaming training, that the tree still learns, and that removing the limit
+ * reactivates all leaves.
+ */
+TEST_CASE("HoeffdingTreeMaxActiveLeavesTest", "[HoeffdingTreeTest]")
+{
+  // Only the first two dimensions are informative.
+  arma::mat data(4, 20000, arma::fill::randu);
+  arma::Row<size_t> labels(20000);
+  for (size_t i = 0; i < 20000; ++i)
+    labels[i] = (data(0, i) < 0.5 ? 0 : 1) + (data(1, i) < 0.3 ? 0 : 2);
+
+  HoeffdingTree<> tree(4, 4, 0.9, 0, 50, 50);
+  tree.MaxActiveLeaves(2);
+  REQUIRE(tree.MaxActiveLeaves() == 2);
+
+  for (size_t i = 0; i < 20000; ++i)
+  {
+    tree.Train(data.col(i), labels[i]);
+    REQUIRE(tree.NumActiveLeaves() <= 2);
+  }
+
+  // The tree should have grown past the number of active leaves.
+  REQUIRE(tree.NumDescendants() > 3);
+
+  arma::Row<size_t> predictions;
+  tree.Classify(data, predictions);
+  REQUIRE(arma::accu(predictions == labels) >= 12000);
+
+  // The limit should survive serialization.
+  HoeffdingTree<> xmlTree, jsonTree, binaryTree;
+  SerializeObjectAll(tree, xmlTree, jsonTree, binaryTree);
+  REQUIRE(xmlTree.MaxActiveLeaves() == 2);
+  REQUIRE(jsonTree.NumActiveLeaves() == tree.NumActiveLeaves());
+  arma::Row<size_t> binaryPredictions;
+  binaryTree.Classify(data, binaryPredictions);
+  CheckMatrices(predictions, binaryPredictions);
+
+  // Count the leaves of the tree.
+  size_t numLeaves = 0;
+  std::stack<const HoeffdingTree<>*> stack;
+  stack.push(&tree);
+  while (!stack.empty())
+  {
+    const HoeffdingTree<>* node = stack.top();
+    stack.pop();
+    if (node->NumChildren() == 0)
+      ++numLeaves;
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+      stack.push(&node->Child(i));
+  }
+
+  REQUIRE(tree.NumActiveLeaves() < numLeaves);
+  tree.MaxActiveLeaves(0);
+  REQUIRE(tree.NumActiveLeaves() == numLeaves);
+}
@@ -315,6 +315,64 @@ TEST_CASE("HPTTest", "[HPTTest]")
   REQUIRE(expectedObjective == Approx(objective).epsilon(1e-7));
 }
 
+/**
+ * Test that evaluating the grid in parallel gives the same result as the
+ * sequential search, with SimpleCV and KFoldCV.
+ */
+TEST_CASE("HPTParallelGridSearchTest", "[HPTTest]")
+{
+  arma::mat xs;
+  arma::rowvec ys;
+  double validationSize;
+  InitProneToOverfittingData(xs, ys, validationSize);
+
+  bool transposeData = true;
+  bool useCholesky = false;
+  arma::vec lambda1Set("0 0.001 0.01 0.1 1.0 10.0 100.0");
+  arma::vec lambda2Set("0.0 0.05 0.5 5.0");
+
+  double expectedLambda1, expectedLambda2;
+  HyperParameterTuner<LARS<>, MSE, SimpleCV, GridSearch>
+      hpt(validationSize, xs, ys);
+  std::tie(expectedLambda1, expectedLambda2) = hpt.Optimize(
+      Fixed(transposeData), Fixed(useCholesky), lambda1Set, lambda2Set);
+
+  double actualLambda1, actualLambda2;
+  HyperParameterTuner<LARS<>, MSE, SimpleCV, GridSearch>
+      parallelHpt(validationSize, xs, ys);
+  parallelHpt.ParallelEvaluations() = 4;
+  std::tie(actualLambda1, actualLambda2) = parallelHpt.Optimize(
+      Fixed(transposeData), Fixed(useCholesky), lambda1Set, lambda2Set);
+
+  REQUIRE(actualLambda1 == expectedLambda1);
+  REQUIRE(actualLambda2 == expectedLambda2);
+  REQUIRE(parallelHpt.BestObjective() ==
+      Approx(hpt.BestObjective()).epsilon(1e-7));
+
+  size_t validationFirstColumn = round(xs.n_cols * (1.0 - validationSize));
+  arma::mat validationXs = xs.cols(validationFirstColumn, xs.n_cols - 1);
+  arma::rowvec validationYs = ys.cols(validationFirstColumn, ys.n_cols - 1);
+  REQUIRE(MSE::Evaluate(parallelHpt.BestModel(), validationXs, validationYs) ==
+      Approx(hpt.BestObjective()).epsilon(1e-7));
+
+  // The same with k-fold cross-validation, without shuffling.
+  HyperParameterTuner<LARS<>, MSE, KFoldCV, GridSearch>
+      kfoldHpt(4, xs, ys, false);
+  std::tie(expectedLambda1, expectedLambda2) = kfoldHpt.Optimize(
+      Fixed(transposeData), Fixed(useCholesky), lambda1Set, lambda2Set);
+
+  HyperParameterTuner<LARS<>, MSE, KFoldCV, GridSearch>
+      parallelKFoldHpt(4, xs, ys, false);
+  parallelKFoldHpt.ParallelEvaluations() = 3;
+  std::tie(actualLambda1, actualLambda2) = parallelKFoldHpt.Optimize(
+      Fixed(transposeData), Fixed(useCholesky), lambda1Set, lambda2Set);
+
+  REQUIRE(actualLambda1 == expectedLambda1);
+  REQUIRE(actualLambda2 == expectedLambda2);
+  REQUIRE(parallelKFoldHpt.BestObjective() ==
+      Approx(kfoldHpt.BestObjective()).epsilon(1e-7));
+}
+
 /**
  * Test HyperParamterTuner maximizes Accuracy rather than minimizes it.
  */
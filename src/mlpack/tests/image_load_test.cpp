@@ -152,4 +152,57 @@ TEST_CASE("ImageInfoSerialization", "[ImageLoadTest]")
   REQUIRE(info.Quality() == binaryInfo.Quality());
 }
 
+/**
+ * Test that images are resized and converted to the number of channels of the
+ * ImageInfo when loaded together.
+ */
+TEST_CASE("LoadVectorImageResizeTest", "[ImageLoadTest]")
+{
+  arma::Mat<unsigned char> matrix;
+  data::ImageInfo info(20, 30, 1);
+  std::vector<std::string> files = {"test_image.png", "test_image.png",
+      "test_image.png"};
+  REQUIRE(data::Load(files, matrix, info, false, true) == true);
+  REQUIRE(matrix.n_rows == 20 * 30 * 1);
+  REQUIRE(matrix.n_cols == 3);
+  REQUIRE(info.Width() == 20);
+  REQUIRE(info.Height() == 30);
+  REQUIRE(info.Channels() == 1);
+  REQUIRE(arma::all(matrix.col(0) == matrix.col(2)));
+
+  // Resizing to the size of the image only converts it.
+  arma::mat original, resized;
+  data::ImageInfo originalInfo, resizedInfo(50, 50, 3);
+  REQUIRE(data::Load(files, original, originalInfo, false) == true);
+  REQUIRE(data::Load(files, resized, resizedInfo, false, true) == true);
+  CheckMatrices(original, resized);
+
+  // The size must be given to resize images.
+  data::ImageInfo emptyInfo;
+  REQUIRE(data::Load(files, matrix, emptyInfo, false, true) == false);
+}
+
+/**
+ * Test bilinear resizing of a small image.
+ */
+TEST_CASE("ResizeImageTest", "[ImageLoadTest]")
+{
+  // A 2x2 image with two channels.
+  const unsigned char image[8] = { 0, 10, 100, 10, 0, 10, 100, 10 };
+  arma::vec output(4 * 2 * 2);
+  data::ResizeImage(image, 2, 2, 2, output.memptr(), 4, 2);
+
+  // The second channel is constant, and the first one increases from left to
+  // right in both rows.
+  for (size_t y = 0; y < 2; ++y)
+  {
+    REQUIRE(output[(y * 4 + 0) * 2] == Approx(0.0).margin(1e-7));
+    REQUIRE(output[(y * 4 + 1) * 2] == Approx(25.0).epsilon(1e-7));
+    REQUIRE(output[(y * 4 + 2) * 2] == Approx(75.0).epsilon(1e-7));
+    REQUIRE(output[(y * 4 + 3) * 2] == Approx(100.0).epsilon(1e-7));
+    for (size_t x = 0; x < 4; ++x)
+      REQUIRE(output[(y * 4 + x) * 2 + 1] == Approx(10.0).epsilon(1e-7));
+  }
+}
+
 #endif // MLPACK_HAS_STB.
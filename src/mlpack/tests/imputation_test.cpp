@@ -304,3 +304,49 @@ TEST_CASE("DatasetMapperPointerMapping", "[ImputationTest]")
   REQUIRE(dm.UnmapString(1, 0) == &b);
   REQUIRE(dm.UnmapString(2, 0) == &c);
 }
+
+/**
+ * Make sure imputing several dimensions at once gives the same result as
+ * imputing each dimension, and that medians of even numbers of elements are
+ * right.
+ */
+TEST_CASE("ImputerMultipleDimensionsTest", "[ImputationTest]")
+{
+  fstream f;
+  f.open("test_file.csv", fstream::out);
+  f << "a, 2, 3, 1"  << endl;
+  f << "5, 6, a, 4"  << endl;
+  f << "8, a, 10, a" << endl;
+  f << "4, 1, 7, 3" << endl;
+  f << "2, 3, 5, 6" << endl;
+  f.close();
+
+  arma::mat input;
+  MissingPolicy policy({"a"});
+  DatasetMapper<MissingPolicy> info(policy);
+  REQUIRE(data::Load("test_file.csv", input, info) == true);
+  remove("test_file.csv");
+
+  const std::vector<size_t> dimensions = { 0, 1, 2, 3 };
+  arma::mat sequentialInput(input);
+  Imputer<double, DatasetMapper<MissingPolicy>, MedianImputation<double>>
+      imputer(info);
+  for (size_t d : dimensions)
+    imputer.Impute(sequentialInput, "a", d);
+  imputer.Impute(input, "a", dimensions);
+
+  CheckMatrices(input, sequentialInput);
+  // The dimensions are the columns of the file.
+  REQUIRE(input(0, 0) == Approx(4.5).epsilon(1e-7));
+  REQUIRE(input(1, 2) == Approx(2.5).epsilon(1e-7));
+  REQUIRE(input(2, 1) == Approx(6.0).epsilon(1e-7));
+  REQUIRE(input(3, 2) == Approx(3.5).epsilon(1e-7));
+
+  // A dimension without valid elements cannot be imputed.
+  arma::mat missing(3, 4);
+  missing.fill(arma::datum::nan);
+  Imputer<double, DatasetMapper<MissingPolicy>, MeanImputation<double>>
+      meanImputer(info);
+  REQUIRE_THROWS_AS(meanImputer.Impute(missing, "a", dimensions),
+      std::runtime_error);
+}
@@ -1229,3 +1229,226 @@ TEST_CASE("GaussianBreadthDualKDTreeMonteCarloKDE", "[KDETest]")
 
   REQUIRE(correctResults > 70);
 }
+
+/**
+ * Test that splitting the evaluation between threads gives the same
+ * single-tree estimations, and dual-tree estimations within the error
+ * tolerance, for bichromatic and monochromatic evaluation.
+ */
+TEST_CASE("ParallelKDETest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 2000);
+  arma::mat query = arma::randu(2, 500);
+  const double relError = 0.05;
+  GaussianKernel kernel(0.3);
+
+  arma::vec bfEstimations(query.n_cols, arma::fill::zeros);
+  BruteForceKDE<GaussianKernel>(reference, query, bfEstimations, kernel);
+  arma::vec bfMonoEstimations(reference.n_cols, arma::fill::zeros);
+  EuclideanDistance distance;
+  for (size_t i = 0; i < reference.n_cols; ++i)
+  {
+    for (size_t j = 0; j < reference.n_cols; ++j)
+    {
+      if (i != j)
+      {
+        bfMonoEstimations(i) += kernel.Evaluate(distance.Evaluate(
+            reference.col(i), reference.col(j)));
+      }
+    }
+  }
+  bfMonoEstimations /= reference.n_cols;
+
+  KDE<GaussianKernel, EuclideanDistance, arma::mat, KDTree> singleKDE(
+      relError, 0.0, kernel, KDEMode::KDE_SINGLE_TREE_MODE);
+  singleKDE.Train(reference);
+
+  #ifdef MLPACK_USE_OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  arma::vec sequentialEstimations;
+  singleKDE.Evaluate(query, sequentialEstimations);
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(4);
+  #endif
+
+  arma::vec parallelEstimations;
+  singleKDE.Evaluate(query, parallelEstimations);
+  REQUIRE(arma::approx_equal(parallelEstimations, sequentialEstimations,
+      "absdiff", 1e-12));
+
+  KDE<GaussianKernel, EuclideanDistance, arma::mat, KDTree> dualKDE(
+      relError, 0.0, kernel, KDEMode::KDE_DUAL_TREE_MODE);
+  dualKDE.Train(reference);
+  arma::vec dualEstimations, monoEstimations;
+  dualKDE.Evaluate(query, dualEstimations);
+  dualKDE.Evaluate(monoEstimations);
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(threads);
+  #endif
+
+  for (size_t i = 0; i < query.n_cols; ++i)
+    REQUIRE(dualEstimations(i) == Approx(bfEstimations(i)).epsilon(relError));
+  for (size_t i = 0; i < reference.n_cols; ++i)
+  {
+    REQUIRE(monoEstimations(i) ==
+        Approx(bfMonoEstimations(i)).epsilon(relError));
+  }
+}
+
+/**
+ * Make sure that the ParallelDualTreeTraverser gives the same density
+ * estimates as the DualTreeTraverser, for several task depths.
+ */
+TEST_CASE("KDEParallelDualTreeTraverserTest", "[KDETest]")
+{
+  typedef KDTree<EuclideanDistance, KDEStat, arma::mat> TreeType;
+  typedef KDERules<EuclideanDistance, GaussianKernel, TreeType> RuleType;
+
+  // Only rules with per-query results may be used by the parallel traverser.
+  REQUIRE((bool) RuleTraits<RuleType>::HasPerQueryResults == true);
+
+  arma::mat reference = arma::randu(2, 1000);
+  arma::mat query = arma::randu(2, 400);
+  GaussianKernel kernel(0.3);
+  EuclideanDistance distance;
+
+  // The trees are built again for each traversal, because the rules write the
+  // statistics of the query nodes.
+  TreeType serialReferenceTree(reference, 10);
+  TreeType serialQueryTree(query, 10);
+  arma::vec serialDensities(query.n_cols, arma::fill::zeros);
+  RuleType serialRules(serialReferenceTree.Dataset(),
+      serialQueryTree.Dataset(), serialDensities, 0.05, 0.0, 0.95, 100, 3.0,
+      0.4, distance, kernel, false, false);
+  TreeType::DualTreeTraverser<RuleType> serialTraverser(serialRules);
+  serialTraverser.Traverse(serialQueryTree, serialReferenceTree);
+
+  for (size_t depth = 0; depth < 12; depth += 3)
+  {
+    TreeType referenceTree(reference, 10);
+    TreeType queryTree(query, 10);
+    arma::vec densities(query.n_cols, arma::fill::zeros);
+    RuleType rules(referenceTree.Dataset(), queryTree.Dataset(), densities,
+        0.05, 0.0, 0.95, 100, 3.0, 0.4, distance, kernel, false, false);
+    TreeType::ParallelDualTreeTraverser<RuleType> traverser(rules, depth);
+    traverser.Traverse(queryTree, referenceTree);
+
+    REQUIRE(rules.BaseCases() == serialRules.BaseCases());
+    REQUIRE(rules.Scores() == serialRules.Scores());
+    REQUIRE(arma::approx_equal(densities, serialDensities, "absdiff",
+        1e-12));
+  }
+}
+
+/**
+ * Test that points added to a trained model with AddReferences() are taken
+ * into account by every kind of evaluation, both before and after the
+ * reference tree is rebuilt.
+ */
+TEST_CASE("KDEAddReferencesTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 600);
+  arma::mat query = arma::randu(2, 200);
+  const double relError = 0.05;
+  GaussianKernel kernel(0.3);
+  EuclideanDistance distance;
+
+  KDE<GaussianKernel, EuclideanDistance, arma::mat, KDTree> singleKDE(
+      relError, 0.0, kernel, KDEMode::KDE_SINGLE_TREE_MODE);
+  KDE<GaussianKernel, EuclideanDistance, arma::mat, KDTree> dualKDE(
+      relError, 0.0, kernel, KDEMode::KDE_DUAL_TREE_MODE);
+  singleKDE.MaxBufferSize() = 150;
+  dualKDE.MaxBufferSize() = 150;
+  singleKDE.Train(reference.cols(0, 399));
+  dualKDE.Train(reference.cols(0, 399));
+
+  // The first batch stays in the buffer; the second one goes over the limit.
+  const size_t batchEnds[2] = { 499, 599 };
+  const size_t bufferSizes[2] = { 100, 0 };
+  size_t begin = 400;
+  for (size_t b = 0; b < 2; ++b)
+  {
+    singleKDE.AddReferences(reference.cols(begin, batchEnds[b]));
+    dualKDE.AddReferences(reference.cols(begin, batchEnds[b]));
+    begin = batchEnds[b] + 1;
+
+    REQUIRE(singleKDE.NumReferences() == begin);
+    REQUIRE(dualKDE.NumReferences() == begin);
+    REQUIRE(singleKDE.ReferenceBuffer().n_cols == bufferSizes[b]);
+    REQUIRE(dualKDE.ReferenceBuffer().n_cols == bufferSizes[b]);
+
+    const arma::mat currentReference = reference.cols(0, begin - 1);
+    arma::vec bfEstimations(query.n_cols, arma::fill::zeros);
+    BruteForceKDE<GaussianKernel>(currentReference, query, bfEstimations,
+        kernel);
+    arma::vec bfMonoEstimations(begin, arma::fill::zeros);
+    for (size_t i = 0; i < begin; ++i)
+    {
+      for (size_t j = 0; j < begin; ++j)
+      {
+        if (i != j)
+        {
+          bfMonoEstimations(i) += kernel.Evaluate(distance.Evaluate(
+              currentReference.col(i), currentReference.col(j)));
+        }
+      }
+    }
+    bfMonoEstimations /= begin;
+
+    arma::vec singleEstimations, dualEstimations, monoEstimations;
+    singleKDE.Evaluate(query, singleEstimations);
+    dualKDE.Evaluate(query, dualEstimations);
+    dualKDE.Evaluate(monoEstimations);
+
+    REQUIRE(monoEstimations.n_elem == begin);
+    for (size_t i = 0; i < query.n_cols; ++i)
+    {
+      REQUIRE(singleEstimations(i) ==
+          Approx(bfEstimations(i)).epsilon(relError));
+      REQUIRE(dualEstimations(i) ==
+          Approx(bfEstimations(i)).epsilon(relError));
+    }
+    for (size_t i = 0; i < begin; ++i)
+    {
+      REQUIRE(monoEstimations(i) ==
+          Approx(bfMonoEstimations(i)).epsilon(relError));
+    }
+  }
+
+  // Points of the wrong dimensionality are rejected.
+  REQUIRE_THROWS_AS(dualKDE.AddReferences(arma::randu(3, 10)),
+      std::invalid_argument);
+}
+
+/**
+ * The base cases of the last evaluation should be counted, including those
+ * with the reference buffer, and a tree evaluation should need fewer than a
+ * brute-force one.
+ */
+TEST_CASE("KDEBaseCasesTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 1000);
+  arma::mat query = arma::randu(2, 200);
+
+  KDE<GaussianKernel, EuclideanDistance, arma::mat, KDTree>
+      kde(0.05, 0.0, GaussianKernel(0.05));
+  kde.Train(reference);
+  REQUIRE(kde.BaseCases() == 0);
+
+  arma::vec estimations;
+  kde.Evaluate(query, estimations);
+  const size_t treeBaseCases = kde.BaseCases();
+  REQUIRE(treeBaseCases > 0);
+  REQUIRE(treeBaseCases < 200 * 1000);
+  REQUIRE(kde.Scores() > 0);
+
+  // The buffer is evaluated by brute force.
+  kde.AddReferences(arma::randu(2, 10));
+  kde.Evaluate(query, estimations);
+  REQUIRE(kde.BaseCases() >= 200 * 10);
+}
@@ -408,6 +408,59 @@ TEST_CASE("PSpectrumStringEvaluateTest", "[KernelTest]")
   REQUIRE(p.Evaluate(b, a) == Approx(11.0).epsilon(1e-7));
 }
 
+/**
+ * Make sure that the indexed p-spectrum kernel gives the same results as the
+ * kernel without the index, for single evaluations and for blocks of strings.
+ */
+TEST_CASE("PSpectrumStringIndexTest", "[KernelTest]")
+{
+  std::vector<std::vector<std::string>> datasets(2);
+  datasets[0] = { "herpgle", "herpagkle", "klunktor", "flibbynopple", "" };
+  datasets[1] = { "floggy3245", "flippydopflip", "stupid fricking cat",
+      "food time isn't until later", "obloblobloblobloblobloblob" };
+
+  PSpectrumStringKernel indexed(datasets, 2);
+  PSpectrumStringKernel unindexed(datasets, 2, false);
+  REQUIRE(indexed.Indexed());
+  REQUIRE(!unindexed.Indexed());
+  REQUIRE(indexed.Index().size() == 2);
+  REQUIRE(indexed.Index()[0].n_cols == 5);
+  REQUIRE(indexed.Index()[1].n_rows == indexed.NumSubstrings());
+
+  arma::mat strings(2, 10);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    strings(0, i) = i / 5;
+    strings(1, i) = i % 5;
+  }
+
+  for (size_t i = 0; i < strings.n_cols; ++i)
+    for (size_t j = 0; j < strings.n_cols; ++j)
+      REQUIRE(indexed.Evaluate(strings.col(i), strings.col(j)) ==
+          unindexed.Evaluate(strings.col(i), strings.col(j)));
+
+  arma::mat k, kUnindexed, kMatrix;
+  indexed.Evaluate(strings, strings.cols(2, 6).eval(), k);
+  unindexed.Evaluate(strings, strings.cols(2, 6).eval(), kUnindexed);
+  KernelMatrix(indexed, strings, kMatrix);
+
+  REQUIRE(k.n_rows == 10);
+  REQUIRE(k.n_cols == 5);
+  CheckMatrices(k, kUnindexed);
+  for (size_t i = 0; i < strings.n_cols; ++i)
+    for (size_t j = 0; j < strings.n_cols; ++j)
+      REQUIRE(kMatrix(i, j) ==
+          unindexed.Evaluate(strings.col(i), strings.col(j)));
+
+  // Modifying the counts discards the index.
+  ++indexed.Counts()[0][0]["he"];
+  REQUIRE(!indexed.Indexed());
+  REQUIRE(indexed.Evaluate(strings.col(0), strings.col(1)) == 5.0);
+  indexed.BuildIndex();
+  REQUIRE(indexed.Indexed());
+  REQUIRE(indexed.Evaluate(strings.col(0), strings.col(1)) == 5.0);
+}
+
 /**
  * Cauchy Kernel test.
  */
@@ -420,3 +473,118 @@ TEST_CASE("CauchyKernelTest", "[KernelTest]")
   REQUIRE(ck.Evaluate(a, b) == Approx(0.92592588).epsilon(1e-7));
   REQUIRE(ck.Evaluate(b, a) == Approx(0.92592588).epsilon(1e-7));
 }
+
+/**
+ * Make sure that KernelMatrix() gives the same results as evaluating the
+ * kernel on each pair of points, both for the kernels computed with matrix
+ * multiplications and for the kernels computed by blocks.
+ */
+template<typename KernelType, typename MatType>
+void CheckKernelMatrix(KernelType& kernel, const double tolerance)
+{
+  // More than one block of points on each side.
+  const MatType a = arma::randu<MatType>(5, 150);
+  const MatType b = arma::randu<MatType>(5, 70);
+
+  arma::Mat<typename MatType::elem_type> k, kSym;
+  KernelMatrix(kernel, a, b, k);
+  KernelMatrix(kernel, a, kSym);
+
+  REQUIRE(k.n_rows == 150);
+  REQUIRE(k.n_cols == 70);
+  REQUIRE(kSym.n_rows == 150);
+  REQUIRE(kSym.n_cols == 150);
+
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      REQUIRE(k(i, j) == Approx(kernel.Evaluate(a.col(i), b.col(j))).epsilon(
+          tolerance).margin(tolerance));
+
+  for (size_t j = 0; j < a.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      REQUIRE(kSym(i, j) == Approx(kernel.Evaluate(a.col(i),
+          a.col(j))).epsilon(tolerance).margin(tolerance));
+}
+
+TEST_CASE("KernelMatrixTest", "[KernelTest]")
+{
+  LinearKernel linear;
+  PolynomialKernel polynomial(3.0, 1.0);
+  GaussianKernel gaussian(0.7);
+  LaplacianKernel laplacian(0.5);
+  CosineSimilarity cosine;
+  EpanechnikovKernel epanechnikov(1.5);
+
+  CheckKernelMatrix<LinearKernel, arma::mat>(linear, 1e-10);
+  CheckKernelMatrix<PolynomialKernel, arma::mat>(polynomial, 1e-10);
+  CheckKernelMatrix<GaussianKernel, arma::mat>(gaussian, 1e-10);
+  CheckKernelMatrix<LaplacianKernel, arma::mat>(laplacian, 1e-10);
+  CheckKernelMatrix<CosineSimilarity, arma::mat>(cosine, 1e-10);
+  CheckKernelMatrix<EpanechnikovKernel, arma::mat>(epanechnikov, 1e-10);
+
+  CheckKernelMatrix<PolynomialKernel, arma::fmat>(polynomial, 1e-4);
+  CheckKernelMatrix<GaussianKernel, arma::fmat>(gaussian, 1e-4);
+  CheckKernelMatrix<LaplacianKernel, arma::fmat>(laplacian, 1e-4);
+
+  // This kernel has no batch Evaluate() function, so the blocks are computed
+  // point by point.
+  REQUIRE(!KernelTraits<ExampleKernel>::HasBatchEvaluate);
+  ExampleKernel example;
+  CheckKernelMatrix<ExampleKernel, arma::mat>(example, 1e-10);
+}
+
+/**
+ * Make sure that the batch Evaluate() function of each kernel gives the same
+ * results as the evaluation on each pair of points.
+ */
+template<typename KernelType>
+void CheckBatchEvaluate(KernelType& kernel)
+{
+  REQUIRE(KernelTraits<KernelType>::HasBatchEvaluate);
+
+  const arma::mat a = arma::randu<arma::mat>(4, 30);
+  const arma::mat b = arma::randu<arma::mat>(4, 20);
+  arma::mat k;
+  kernel.Evaluate(a, b, k);
+
+  REQUIRE(k.n_rows == 30);
+  REQUIRE(k.n_cols == 20);
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      REQUIRE(k(i, j) == Approx(kernel.Evaluate(a.col(i), b.col(j))).epsilon(
+          1e-10).margin(1e-10));
+}
+
+TEST_CASE("KernelBatchEvaluateTest", "[KernelTest]")
+{
+  LinearKernel linear;
+  PolynomialKernel polynomial(2.0, 0.5);
+  HyperbolicTangentKernel tangent(0.3, -0.2);
+  GaussianKernel gaussian(0.5);
+  LaplacianKernel laplacian(0.8);
+  EpanechnikovKernel epanechnikov(1.0);
+  CauchyKernel cauchy(0.6);
+  TriangularKernel triangular(1.2);
+  SphericalKernel spherical(0.9);
+  CosineSimilarity cosine;
+
+  CheckBatchEvaluate(linear);
+  CheckBatchEvaluate(polynomial);
+  CheckBatchEvaluate(tangent);
+  CheckBatchEvaluate(gaussian);
+  CheckBatchEvaluate(laplacian);
+  CheckBatchEvaluate(epanechnikov);
+  CheckBatchEvaluate(cauchy);
+  CheckBatchEvaluate(triangular);
+  CheckBatchEvaluate(spherical);
+  CheckBatchEvaluate(cosine);
+
+  // The cosine similarity with a zero point is 0.
+  arma::mat a = arma::randu<arma::mat>(4, 3);
+  a.col(1).zeros();
+  arma::mat k;
+  CosineSimilarity::Evaluate(a, a, k);
+  REQUIRE(arma::accu(arma::abs(k.row(1))) == 0.0);
+  REQUIRE(arma::accu(arma::abs(k.col(1))) == 0.0);
+  REQUIRE(k(0, 0) == Approx(1.0));
+}
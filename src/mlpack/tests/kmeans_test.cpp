@@ -536,6 +536,63 @@ TEST_CASE("KMeansPlusPlusTest", "[KMeansTest]")
   REQUIRE(distortion < 14500.0);
 }
 
+/**
+ * Make sure that the k-means|| initialization gives initial centroids at least
+ * as good as k-means++ on the same five Gaussians.
+ */
+TEST_CASE("KMeansParallelInitializationTest", "[KMeansTest]")
+{
+  arma::mat data(3, 3000);
+  data.randn();
+
+  arma::mat centroids(" 0  5 -2 -6  1;"
+                      " 0  0 -2  8  6;"
+                      " 0 -2 -2  8  1");
+
+  for (size_t i = 1000; i < 1200; ++i)
+    data.col(i) += centroids.col(1);
+  for (size_t i = 1200; i < 1700; ++i)
+    data.col(i) += centroids.col(2);
+  for (size_t i = 1700; i < 1800; ++i)
+    data.col(i) += centroids.col(3);
+  for (size_t i = 1800; i < 3000; ++i)
+    data.col(i) += centroids.col(4);
+
+  KMeansParallelInitialization k;
+  arma::mat resultingCentroids;
+  k.Cluster(data, 5, resultingCentroids);
+
+  REQUIRE(resultingCentroids.n_rows == 3);
+  REQUIRE(resultingCentroids.n_cols == 5);
+
+  // Calculate the sum of distances to the closest centroids.
+  double distortion = 0;
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    double bestDist = DBL_MAX;
+    for (size_t j = 0; j < 5; ++j)
+    {
+      bestDist = std::min(bestDist, EuclideanDistance::Evaluate(data.col(i),
+          resultingCentroids.col(j)));
+    }
+    distortion += bestDist;
+  }
+
+  // This is the same bound as for k-means++.
+  REQUIRE(distortion < 14500.0);
+
+  // The policy should also work as the initial partition policy of KMeans.
+  KMeans<EuclideanDistance, KMeansParallelInitialization> kmeans;
+  arma::Row<size_t> assignments;
+  kmeans.Cluster(data, 5, assignments);
+  REQUIRE(assignments.n_elem == 3000);
+  REQUIRE(arma::max(assignments) < 5);
+
+  // Asking for more clusters than points is an error.
+  REQUIRE_THROWS_AS(k.Cluster(data.cols(0, 3), 5, resultingCentroids),
+      std::invalid_argument);
+}
+
 #ifdef ARMA_HAS_SPMAT
 /**
  * Make sure sparse k-means works okay.
@@ -581,8 +638,109 @@ TEST_CASE("SparseKMeansTest", "[KMeansTest]")
   REQUIRE(assignments[11] == clusterTwo);
 }
 
+/**
+ * Make sure that the naive and Hamerly steps give the same clusters for sparse
+ * data (where the distances are computed with cached norms) as the naive step
+ * gives for the same data stored densely.
+ */
+TEST_CASE("SparseHamerlyKMeansTest", "[KMeansTest]")
+{
+  arma::sp_mat data;
+  data.sprandu(200, 1000, 0.05);
+  arma::mat denseData(data);
+
+  const size_t k = 10;
+  arma::mat centroids(200, k);
+  centroids.randu();
+  centroids *= 0.1;
+
+  arma::mat denseCentroids(centroids);
+  KMeans<> km;
+  arma::Row<size_t> assignments;
+  km.Cluster(denseData, k, assignments, denseCentroids, false, true);
+
+  KMeans<EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+      NaiveKMeans, arma::sp_mat> naive;
+  arma::Row<size_t> naiveAssignments;
+  arma::mat naiveCentroids(centroids);
+  naive.Cluster(data, k, naiveAssignments, naiveCentroids, false, true);
+
+  KMeans<EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+      HamerlyKMeans, arma::sp_mat> hamerly;
+  arma::Row<size_t> hamerlyAssignments;
+  arma::mat hamerlyCentroids(centroids);
+  hamerly.Cluster(data, k, hamerlyAssignments, hamerlyCentroids, false, true);
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    REQUIRE(assignments[i] == naiveAssignments[i]);
+    REQUIRE(assignments[i] == hamerlyAssignments[i]);
+  }
+
+  for (size_t i = 0; i < centroids.n_elem; ++i)
+  {
+    REQUIRE(denseCentroids[i] ==
+        Approx(naiveCentroids[i]).epsilon(1e-7).margin(1e-10));
+    REQUIRE(denseCentroids[i] ==
+        Approx(hamerlyCentroids[i]).epsilon(1e-7).margin(1e-10));
+  }
+}
+
 #endif // ARMA_HAS_SPMAT
 
+/**
+ * Make sure that the naive and Hamerly steps give the same clusters for single
+ * precision data as for the same data in double precision.
+ */
+TEST_CASE("FloatKMeansTest", "[KMeansTest]")
+{
+  // Use values that can be represented exactly in single precision.
+  arma::mat data = arma::round(1024 * arma::randu<arma::mat>(10, 1000)) / 1024;
+  arma::fmat floatData = ConvTo<arma::fmat>::From(data);
+
+  const size_t k = 10;
+  arma::mat centroids(10, k);
+  centroids.randu();
+
+  arma::mat doubleCentroids(centroids);
+  KMeans<> km;
+  arma::Row<size_t> assignments;
+  km.Cluster(data, k, assignments, doubleCentroids, false, true);
+
+  KMeans<EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+      NaiveKMeans, arma::fmat> naive;
+  arma::Row<size_t> naiveAssignments;
+  arma::mat naiveCentroids(centroids);
+  naive.Cluster(floatData, k, naiveAssignments, naiveCentroids, false, true);
+
+  KMeans<EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+      HamerlyKMeans, arma::fmat> hamerly;
+  arma::Row<size_t> hamerlyAssignments;
+  arma::mat hamerlyCentroids(centroids);
+  hamerly.Cluster(floatData, k, hamerlyAssignments, hamerlyCentroids, false,
+      true);
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    REQUIRE(assignments[i] == naiveAssignments[i]);
+    REQUIRE(assignments[i] == hamerlyAssignments[i]);
+  }
+
+  for (size_t i = 0; i < centroids.n_elem; ++i)
+  {
+    REQUIRE(doubleCentroids[i] == Approx(naiveCentroids[i]).epsilon(1e-7));
+    REQUIRE(doubleCentroids[i] == Approx(hamerlyCentroids[i]).epsilon(1e-7));
+  }
+
+  // The initialization policies must work with single precision data too.
+  KMeans<EuclideanDistance, KMeansPlusPlusInitialization,
+      MaxVarianceNewCluster, NaiveKMeans, arma::fmat> plusPlus;
+  arma::mat plusPlusCentroids;
+  plusPlus.Cluster(floatData, k, plusPlusCentroids);
+  REQUIRE(plusPlusCentroids.n_rows == 10);
+  REQUIRE(plusPlusCentroids.n_cols == k);
+}
+
 TEST_CASE("ElkanTest", "[KMeansTest]")
 {
   const size_t trials = 5;
@@ -617,6 +775,51 @@ TEST_CASE("ElkanTest", "[KMeansTest]")
   }
 }
 
+// Make sure Elkan's algorithm gives the same result with one thread as with
+// many, and that both match the naive algorithm, with a larger number of
+// clusters.
+TEST_CASE("ElkanParallelTest", "[KMeansTest]")
+{
+  arma::mat dataset(10, 3000);
+  dataset.randu();
+
+  const size_t k = 100;
+  arma::mat centroids(10, k);
+  centroids.randu();
+
+  arma::mat naiveCentroids(centroids);
+  KMeans<> km;
+  arma::Row<size_t> assignments;
+  km.Cluster(dataset, k, assignments, naiveCentroids, false, true);
+
+  #ifdef MLPACK_USE_OPENMP
+  const int threads = omp_get_max_threads();
+  #endif
+
+  for (size_t trial = 0; trial < 2; ++trial)
+  {
+    #ifdef MLPACK_USE_OPENMP
+    omp_set_num_threads(trial == 0 ? 1 : threads);
+    #endif
+
+    KMeans<EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+        ElkanKMeans> elkan;
+    arma::Row<size_t> elkanAssignments;
+    arma::mat elkanCentroids(centroids);
+    elkan.Cluster(dataset, k, elkanAssignments, elkanCentroids, false, true);
+
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+      REQUIRE(assignments[i] == elkanAssignments[i]);
+
+    for (size_t i = 0; i < centroids.n_elem; ++i)
+      REQUIRE(naiveCentroids[i] == Approx(elkanCentroids[i]).epsilon(1e-7));
+  }
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(threads);
+  #endif
+}
+
 TEST_CASE("HamerlyTest", "[KMeansTest]")
 {
   const size_t trials = 5;
@@ -652,6 +855,85 @@ TEST_CASE("HamerlyTest", "[KMeansTest]")
   }
 }
 
+// Make sure the Yinyang algorithm returns the same clusters as the naive
+// method, with few and many clusters (and thus few and many groups).
+TEST_CASE("YinyangTest", "[KMeansTest]")
+{
+  const size_t ks[] = { 5, 30, 120 };
+
+  for (const size_t k : ks)
+  {
+    arma::mat dataset(10, 2000);
+    dataset.randu();
+
+    arma::mat centroids(10, k);
+    centroids.randu();
+
+    arma::mat naiveCentroids(centroids);
+    KMeans<> km;
+    arma::Row<size_t> assignments;
+    km.Cluster(dataset, k, assignments, naiveCentroids, false, true);
+
+    KMeans<EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+        YinyangKMeans> yinyang;
+    arma::Row<size_t> yinyangAssignments;
+    arma::mat yinyangCentroids(centroids);
+    yinyang.Cluster(dataset, k, yinyangAssignments, yinyangCentroids, false,
+        true);
+
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+      REQUIRE(assignments[i] == yinyangAssignments[i]);
+
+    for (size_t i = 0; i < centroids.n_elem; ++i)
+      REQUIRE(naiveCentroids[i] == Approx(yinyangCentroids[i]).epsilon(1e-7));
+  }
+}
+
+// Make sure each Yinyang step matches a naive step when the number of groups
+// is set by hand, including a single group and one group per cluster.
+TEST_CASE("YinyangStepTest", "[KMeansTest]")
+{
+  arma::mat dataset(5, 1000);
+  dataset.randu();
+
+  const size_t k = 20;
+  const size_t groups[] = { 1, 4, k };
+  EuclideanDistance distance;
+
+  for (const size_t g : groups)
+  {
+    arma::mat centroids(5, k);
+    centroids.randu();
+
+    NaiveKMeans<EuclideanDistance, arma::mat> naive(dataset, distance);
+    YinyangKMeans<EuclideanDistance, arma::mat> yinyang(dataset, distance, g);
+    REQUIRE(yinyang.Groups() == g);
+
+    arma::mat naiveCentroids(centroids), yinyangCentroids(centroids);
+    for (size_t iteration = 0; iteration < 10; ++iteration)
+    {
+      arma::mat newNaiveCentroids, newYinyangCentroids;
+      arma::Col<size_t> naiveCounts, yinyangCounts;
+      const double naiveNorm = naive.Iterate(naiveCentroids, newNaiveCentroids,
+          naiveCounts);
+      const double yinyangNorm = yinyang.Iterate(yinyangCentroids,
+          newYinyangCentroids, yinyangCounts);
+
+      REQUIRE(yinyangNorm == Approx(naiveNorm).epsilon(1e-7).margin(1e-10));
+      for (size_t c = 0; c < k; ++c)
+        REQUIRE(naiveCounts[c] == yinyangCounts[c]);
+      for (size_t i = 0; i < centroids.n_elem; ++i)
+      {
+        REQUIRE(newNaiveCentroids[i] ==
+            Approx(newYinyangCentroids[i]).epsilon(1e-7).margin(1e-10));
+      }
+
+      naiveCentroids = std::move(newNaiveCentroids);
+      yinyangCentroids = std::move(newYinyangCentroids);
+    }
+  }
+}
+
 TEST_CASE("PellegMooreTest", "[KMeansTest]")
 {
   const size_t trials = 5;
@@ -750,6 +1032,142 @@ TEST_CASE("DTNNCoverTreeTest", "[KMeansTest]")
   }
 }
 
+// Make sure the tree-based algorithms give the same clusters as the naive
+// method when their trees are split between threads.
+TEST_CASE("TreeKMeansParallelTest", "[KMeansTest]")
+{
+  arma::mat dataset(5, 5000);
+  dataset.randu();
+
+  const size_t k = 20;
+  arma::mat centroids(5, k);
+  centroids.randu();
+
+  arma::mat naiveCentroids(centroids);
+  KMeans<> km;
+  arma::Row<size_t> assignments;
+  km.Cluster(dataset, k, assignments, naiveCentroids, false, true);
+
+  #ifdef MLPACK_USE_OPENMP
+  const int threads = omp_get_max_threads();
+  #endif
+
+  for (size_t trial = 0; trial < 2; ++trial)
+  {
+    #ifdef MLPACK_USE_OPENMP
+    omp_set_num_threads(trial == 0 ? 1 : threads);
+    #endif
+
+    KMeans<EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+        PellegMooreKMeans> pellegMoore;
+    arma::Row<size_t> pmAssignments;
+    arma::mat pmCentroids(centroids);
+    pellegMoore.Cluster(dataset, k, pmAssignments, pmCentroids, false, true);
+
+    KMeans<EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+        DefaultDualTreeKMeans> dtnn;
+    arma::Row<size_t> dtnnAssignments;
+    arma::mat dtnnCentroids(centroids);
+    dtnn.Cluster(dataset, k, dtnnAssignments, dtnnCentroids, false, true);
+
+    KMeans<EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+        CoverTreeDualTreeKMeans> coverDtnn;
+    arma::Row<size_t> coverAssignments;
+    arma::mat coverCentroids(centroids);
+    coverDtnn.Cluster(dataset, k, coverAssignments, coverCentroids, false,
+        true);
+
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+    {
+      REQUIRE(assignments[i] == pmAssignments[i]);
+      REQUIRE(assignments[i] == dtnnAssignments[i]);
+      REQUIRE(assignments[i] == coverAssignments[i]);
+    }
+
+    for (size_t i = 0; i < centroids.n_elem; ++i)
+    {
+      REQUIRE(naiveCentroids[i] == Approx(pmCentroids[i]).epsilon(1e-7));
+      REQUIRE(naiveCentroids[i] == Approx(dtnnCentroids[i]).epsilon(1e-7));
+      REQUIRE(naiveCentroids[i] == Approx(coverCentroids[i]).epsilon(1e-7));
+    }
+  }
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(threads);
+  #endif
+}
+
+/**
+ * Make sure that mini-batch k-means finds the three well-separated clusters of
+ * the simple dataset, starting from rough guesses of the centroids.
+ */
+TEST_CASE("MiniBatchKMeansSimpleTest", "[KMeansTest]")
+{
+  KMeans<EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+      MiniBatchKMeans> kmeans(100);
+
+  const arma::mat data = trans(kMeansData);
+  arma::mat centroids(" 1.0  8.0 -8.0;"
+                      " 1.0  8.0  4.0");
+  arma::Row<size_t> assignments;
+  kmeans.Cluster(data, 3, assignments, centroids, false, true);
+
+  for (size_t i = 0; i < 13; ++i)
+    REQUIRE(assignments(i) == 0);
+  for (size_t i = 13; i < 20; ++i)
+    REQUIRE(assignments(i) == 1);
+  for (size_t i = 20; i < 30; ++i)
+    REQUIRE(assignments(i) == 2);
+
+  // Every centroid is a running mean of sampled points of its class, so it
+  // must be within the class.
+  REQUIRE(arma::norm(centroids.col(0) - arma::mean(data.cols(0, 12), 1)) <
+      0.5);
+  REQUIRE(arma::norm(centroids.col(1) - arma::mean(data.cols(13, 19), 1)) <
+      0.5);
+  REQUIRE(arma::norm(centroids.col(2) - arma::mean(data.cols(20, 29), 1)) <
+      0.5);
+}
+
+/**
+ * Make sure that a single mini-batch step moves each centroid to the mean of
+ * all the batch points assigned to it so far.
+ */
+TEST_CASE("MiniBatchKMeansStepTest", "[KMeansTest]")
+{
+  // Two points far apart; with two centroids next to them, every batch point
+  // goes to the closest centroid, which must end up exactly on its point.
+  arma::mat dataset(" 0.0 10.0;"
+                    " 0.0 10.0");
+  arma::mat centroids(" 1.0  9.0;"
+                      " 1.0  9.0");
+
+  EuclideanDistance distance;
+  MiniBatchKMeans<EuclideanDistance, arma::mat> step(dataset, distance, 50);
+  REQUIRE(step.BatchSize() == 50);
+
+  arma::mat newCentroids, otherCentroids;
+  arma::Col<size_t> counts;
+  step.Iterate(centroids, newCentroids, counts);
+
+  REQUIRE(counts.n_elem == 2);
+  REQUIRE(counts[0] + counts[1] == 50);
+  for (size_t c = 0; c < 2; ++c)
+  {
+    // A cluster that received no points stays where it was.
+    const double expected = (counts[c] == 0) ? centroids(0, c) : 10.0 * c;
+    REQUIRE(newCentroids(0, c) == Approx(expected).margin(1e-10));
+    REQUIRE(newCentroids(1, c) == Approx(expected).margin(1e-10));
+  }
+
+  // The counts accumulate over iterations.
+  step.Iterate(newCentroids, otherCentroids, counts);
+  REQUIRE(counts[0] + counts[1] == 100);
+
+  REQUIRE_THROWS_AS(MiniBatchKMeans<EuclideanDistance, arma::mat>(dataset,
+      distance, 0), std::invalid_argument);
+}
+
 /**
  * Make sure that the sample initialization strategy successfully samples points
  * from the dataset.
@@ -783,3 +1201,85 @@ TEST_CASE("SampleInitializationTest", "[KMeansTest]")
     REQUIRE(j < dataset.n_cols);
   }
 }
+
+/**
+ * Run iterations of the given Lloyd step on partitions of the dataset, and make
+ * sure that they give the same results as NaiveKMeans on the whole dataset,
+ * also when the centroids are changed between iterations.
+ */
+template<template<class, class> class LloydStepType>
+void CheckPartitionedKMeans(const arma::mat& dataset,
+                            const arma::mat& initialCentroids)
+{
+  EuclideanDistance distance;
+  NaiveKMeans<EuclideanDistance, arma::mat> naive(dataset, distance);
+  PartitionedKMeans<EuclideanDistance, arma::mat, LloydStepType> partitioned(
+      dataset, distance, 4);
+  REQUIRE(partitioned.NumPartitions() == 4);
+
+  arma::mat centroids(initialCentroids);
+  arma::mat partitionedCentroids(initialCentroids);
+  arma::mat newCentroids, newPartitionedCentroids;
+  arma::Col<size_t> counts, partitionedCounts;
+  for (size_t i = 0; i < 10; ++i)
+  {
+    naive.Iterate(centroids, newCentroids, counts);
+    partitioned.Iterate(partitionedCentroids, newPartitionedCentroids,
+        partitionedCounts);
+
+    REQUIRE(arma::all(counts == partitionedCounts));
+    REQUIRE(arma::approx_equal(newCentroids, newPartitionedCentroids, "both",
+        1e-7, 1e-10));
+
+    centroids = newCentroids;
+    partitionedCentroids = newPartitionedCentroids;
+
+    // Move a centroid, as an empty cluster policy would, so that the bounds of
+    // the partitions no longer hold for the new centroids.
+    if (i == 4)
+    {
+      centroids.col(0) = dataset.col(0);
+      partitionedCentroids.col(0) = dataset.col(0);
+    }
+  }
+}
+
+/**
+ * Make sure the partitioned Lloyd step gives the same results as the naive
+ * step, with each of the Lloyd steps that can run on partitions.
+ */
+TEST_CASE("PartitionedKMeansTest", "[KMeansTest]")
+{
+  arma::mat dataset(5, 1003, arma::fill::randu);
+  arma::mat centroids(5, 8, arma::fill::randu);
+
+  CheckPartitionedKMeans<NaiveKMeans>(dataset, centroids);
+  CheckPartitionedKMeans<HamerlyKMeans>(dataset, centroids);
+  CheckPartitionedKMeans<ElkanKMeans>(dataset, centroids);
+}
+
+/**
+ * Make sure that KMeans with the partitioned Lloyd step gives the same
+ * clusters as with the naive step.
+ */
+TEST_CASE("PartitionedKMeansClusterTest", "[KMeansTest]")
+{
+  arma::mat dataset(4, 2000, arma::fill::randu);
+  arma::mat centroids(4, 6, arma::fill::randu);
+
+  KMeans<> km;
+  arma::Row<size_t> assignments;
+  arma::mat naiveCentroids(centroids);
+  km.Cluster(dataset, 6, assignments, naiveCentroids, false, true);
+
+  KMeans<EuclideanDistance, SampleInitialization, MaxVarianceNewCluster,
+      PartitionedKMeans> partitioned;
+  arma::Row<size_t> partitionedAssignments;
+  arma::mat partitionedCentroids(centroids);
+  partitioned.Cluster(dataset, 6, partitionedAssignments, partitionedCentroids,
+      false, true);
+
+  REQUIRE(arma::all(assignments == partitionedAssignments));
+  REQUIRE(arma::approx_equal(naiveCentroids, partitionedCentroids, "both",
+      1e-7, 1e-10));
+}
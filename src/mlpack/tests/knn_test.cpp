@@ -11,6 +11,7 @@
 #include <mlpack/core.hpp>
 #include <mlpack/methods/neighbor_search.hpp>
 #include <mlpack/methods/neighbor_search/ns_model.hpp>
+#include "serialization.hpp"
 #include "test_catch_tools.hpp"
 #include "catch.hpp"
 
@@ -711,6 +712,129 @@ TEST_CASE("KNNDualTreeVsNaive2", "[KNNTest]")
   }
 }
 
+/**
+ * Test the parallel dual-tree traverser against the naive method, with a few
+ * different task depths (including 0, which means it is chosen
+ * automatically).
+ *
+ * Errors are produced if the results are not identical.
+ */
+TEST_CASE("KNNParallelDualTreeVsNaive", "[KNNTest]")
+{
+  arma::mat dataset;
+
+  if (!data::Load("test_data_3_1000.csv", dataset))
+    FAIL("Cannot load test dataset test_data_3_1000.csv!");
+
+  typedef KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+  typedef NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+      KDTree, TreeType::template ParallelDualTreeTraverser> ParallelKNN;
+  typedef NeighborSearchRules<NearestNeighborSort, EuclideanDistance,
+      TreeType> RuleType;
+
+  // Only rules with per-query results may be used by the parallel traverser.
+  REQUIRE((bool) RuleTraits<RuleType>::HasPerQueryResults == true);
+  REQUIRE((bool) RuleTraits<InstrumentedRules<RuleType,
+      TraversalInstrumentation>>::HasPerQueryResults == true);
+
+  ParallelKNN knn(dataset);
+  KNN naive(dataset, NAIVE_MODE);
+
+  arma::Mat<size_t> neighborsTree;
+  arma::mat distancesTree;
+  knn.Search(dataset, 15, neighborsTree, distancesTree);
+
+  arma::Mat<size_t> neighborsNaive;
+  arma::mat distancesNaive;
+  naive.Search(dataset, 15, neighborsNaive, distancesNaive);
+
+  for (size_t i = 0; i < neighborsTree.n_elem; ++i)
+  {
+    REQUIRE(neighborsTree(i) == neighborsNaive(i));
+    REQUIRE(distancesTree(i) == Approx(distancesNaive(i)).epsilon(1e-7));
+  }
+
+  // Now run the traverser by hand with explicit task depths.
+  for (size_t depth = 0; depth < 12; depth += 3)
+  {
+    std::vector<size_t> oldFromNew;
+    TreeType queryTree(dataset, oldFromNew, 10);
+    TreeType referenceTree(dataset, 10);
+
+    EuclideanDistance distance;
+    RuleType rules(referenceTree.Dataset(), queryTree.Dataset(), 15, distance);
+    TreeType::ParallelDualTreeTraverser<RuleType> traverser(rules, depth);
+    traverser.Traverse(queryTree, referenceTree);
+
+    // The base cases of every task must have been added back to the rules.
+    REQUIRE(rules.BaseCases() > 0);
+    REQUIRE(rules.BaseCases() <= traverser.NumBaseCases());
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    rules.GetResults(neighbors, distances);
+
+    for (size_t i = 0; i < neighbors.n_cols; ++i)
+    {
+      for (size_t j = 0; j < neighbors.n_rows; ++j)
+      {
+        REQUIRE(distances(j, i) ==
+            Approx(distancesNaive(j, oldFromNew[i])).epsilon(1e-7));
+      }
+    }
+  }
+}
+
+TEST_CASE("KNNLeafBaseCaseTest", "[KNNTest]")
+{
+  // Make sure that the blocked leaf base case gives exactly the same results
+  // as calling BaseCase() for every pair, including for duplicate points and
+  // when the query and reference sets are the same.
+  typedef KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+  typedef NeighborSearchRules<NearestNeighborSort, EuclideanDistance,
+      TreeType> RuleType;
+
+  arma::mat dataset = arma::randu<arma::mat>(8, 60);
+  dataset.cols(40, 49) = dataset.cols(0, 9);
+
+  for (size_t sameSet = 0; sameSet < 2; ++sameSet)
+  {
+    // Use a single leaf for everything.
+    TreeType referenceTree(dataset, 100);
+    arma::mat querySet = sameSet ? referenceTree.Dataset() :
+        arma::mat(dataset.cols(20, 59));
+    REQUIRE(referenceTree.IsLeaf());
+
+    EuclideanDistance distance;
+    RuleType blockRules(referenceTree.Dataset(), querySet, 5, distance, 0.0,
+        (sameSet == 1));
+    RuleType pairRules(referenceTree.Dataset(), querySet, 5, distance, 0.0,
+        (sameSet == 1));
+
+    std::vector<size_t> queryIndices(querySet.n_cols);
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      queryIndices[i] = i;
+
+    blockRules.LeafBaseCase(queryIndices, referenceTree);
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      for (size_t j = 0; j < referenceTree.NumPoints(); ++j)
+        pairRules.BaseCase(i, referenceTree.Point(j));
+
+    arma::Mat<size_t> blockNeighbors, pairNeighbors;
+    arma::mat blockDistances, pairDistances;
+    blockRules.GetResults(blockNeighbors, blockDistances);
+    pairRules.GetResults(pairNeighbors, pairDistances);
+
+    REQUIRE(blockRules.BaseCases() == pairRules.BaseCases());
+    REQUIRE(arma::all(arma::vectorise(blockNeighbors ==
+        pairNeighbors)));
+    REQUIRE(arma::all(arma::vectorise(blockDistances ==
+        pairDistances)));
+  }
+}
+
 /**
  * Test the single-tree nearest-neighbors method with the naive method.  This
  * uses only a reference dataset.
@@ -746,6 +870,58 @@ TEST_CASE("KNNSingleTreeVsNaive", "[KNNTest]")
   }
 }
 
+/**
+ * Test that a single-tree search over a FrozenTree gives the same results as
+ * the naive method.
+ */
+TEST_CASE("KNNFrozenTreeVsNaive", "[KNNTest]")
+{
+  arma::mat dataset;
+
+  if (!data::Load("test_data_3_1000.csv", dataset))
+    FAIL("Cannot load test dataset test_data_3_1000.csv!");
+
+  typedef KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+  typedef NeighborSearchRules<NearestNeighborSort, EuclideanDistance,
+      TreeType> RuleType;
+
+  std::vector<size_t> oldFromNew;
+  TreeType tree(dataset, oldFromNew, 15);
+  FrozenTree<TreeType> frozenTree(tree);
+
+  // Nodes are stored in breadth-first order.
+  REQUIRE(frozenTree.Count(0) == dataset.n_cols);
+  REQUIRE(frozenTree.Left(0) == 1);
+  REQUIRE(frozenTree.Count(1) == tree.Left()->Count());
+  REQUIRE(frozenTree.Count(2) == tree.Right()->Count());
+
+  arma::mat queries(3, 100, arma::fill::randu);
+  EuclideanDistance distance;
+  RuleType rules(frozenTree.Dataset(), queries, 10, distance);
+  FrozenTree<TreeType>::SingleTreeTraverser<RuleType> traverser(rules);
+  for (size_t i = 0; i < queries.n_cols; ++i)
+    traverser.Traverse(i, frozenTree);
+
+  arma::Mat<size_t> neighborsFrozen;
+  arma::mat distancesFrozen;
+  rules.GetResults(neighborsFrozen, distancesFrozen);
+
+  KNN naive(dataset, NAIVE_MODE);
+  arma::Mat<size_t> neighborsNaive;
+  arma::mat distancesNaive;
+  naive.Search(queries, 10, neighborsNaive, distancesNaive);
+
+  for (size_t i = 0; i < neighborsFrozen.n_elem; ++i)
+  {
+    REQUIRE(oldFromNew[neighborsFrozen[i]] == neighborsNaive[i]);
+    REQUIRE(distancesFrozen[i] == Approx(distancesNaive[i]).epsilon(1e-7));
+  }
+
+  // Some pruning should have happened.
+  REQUIRE(rules.BaseCases() < queries.n_cols * dataset.n_cols);
+}
+
 /**
  * Test the single-tree nearest-neighbors method with the naive method.
  *
@@ -1186,6 +1362,267 @@ TEST_CASE("KNNModelTest", "[KNNTest]")
   }
 }
 
+TEST_CASE("KNNModelMappedTest", "[KNNTest]")
+{
+  // Ensure that a model saved with SaveMapped() and loaded with LoadMapped()
+  // gives the same results as the original model.
+  typedef NSModel<NearestNeighborSort> KNNModel;
+  util::Timers timers;
+
+  arma::mat queryData = arma::randu<arma::mat>(5, 100);
+  arma::mat referenceData = arma::randu<arma::mat>(5, 1000);
+
+  KNNModel models[3];
+  models[0] = KNNModel(KNNModel::TreeTypes::KD_TREE, false);
+  models[1] = KNNModel(KNNModel::TreeTypes::KD_TREE, true);
+  models[2] = KNNModel(KNNModel::TreeTypes::COVER_TREE, false);
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    arma::mat referenceCopy(referenceData);
+    models[i].BuildModel(timers, std::move(referenceCopy), DUAL_TREE_MODE);
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    arma::mat queryCopy(queryData);
+    models[i].Search(timers, std::move(queryCopy), 5, neighbors, distances);
+
+    models[i].SaveMapped("knn_model_mapped.bin");
+    // The reference set must be unchanged after saving.
+    REQUIRE(models[i].Dataset().n_cols == referenceData.n_cols);
+
+    KNNModel loaded;
+    loaded.LoadMapped("knn_model_mapped.bin");
+    REQUIRE(loaded.IsMapped());
+    REQUIRE(loaded.TreeType() == models[i].TreeType());
+    CheckMatrices(loaded.Dataset(), models[i].Dataset());
+
+    arma::Mat<size_t> mappedNeighbors;
+    arma::mat mappedDistances;
+    queryCopy = queryData;
+    loaded.Search(timers, std::move(queryCopy), 5, mappedNeighbors,
+        mappedDistances);
+
+    CheckMatrices(mappedNeighbors, neighbors);
+    CheckMatrices(mappedDistances, distances);
+
+    // A copy of a mapped model owns its reference set.
+    KNNModel copy(loaded);
+    REQUIRE(!copy.IsMapped());
+    CheckMatrices(copy.Dataset(), loaded.Dataset());
+  }
+
+  remove("knn_model_mapped.bin");
+}
+
+TEST_CASE("KNNModelAutoTuneTest", "[KNNTest]")
+{
+  // Ensure that AutoTune() chooses one of its candidate configurations, and
+  // that the model built with it gives exact results.
+  typedef NSModel<NearestNeighborSort> KNNModel;
+  util::Timers timers;
+
+  arma::mat queryData = arma::randu<arma::mat>(4, 300);
+  arma::mat referenceData = arma::randu<arma::mat>(4, 2000);
+
+  KNN knn(referenceData, NAIVE_MODE);
+  arma::Mat<size_t> baselineNeighbors;
+  arma::mat baselineDistances;
+  knn.Search(queryData, 5, baselineNeighbors, baselineDistances);
+
+  KNNModel model;
+  REQUIRE(!model.AutoTuned());
+  const NeighborSearchMode searchMode = model.AutoTune(timers, referenceData,
+      &queryData, 5, 0.0, 500);
+
+  REQUIRE(model.AutoTuned());
+  REQUIRE(searchMode != GREEDY_SINGLE_TREE_MODE);
+  REQUIRE((model.TreeType() == KNNModel::KD_TREE ||
+           model.TreeType() == KNNModel::BALL_TREE ||
+           model.TreeType() == KNNModel::VP_TREE ||
+           model.TreeType() == KNNModel::COVER_TREE));
+
+  arma::mat referenceCopy(referenceData);
+  arma::mat queryCopy(queryData);
+  model.BuildModel(timers, std::move(referenceCopy), searchMode);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  model.Search(timers, std::move(queryCopy), 5, neighbors, distances);
+
+  CheckMatrices(neighbors, baselineNeighbors);
+  CheckMatrices(distances, baselineDistances);
+}
+
+TEST_CASE("KNNModelQueryTreeTest", "[KNNTest]")
+{
+  // Ensure that searches with a query tree built once by BuildQueryTree() give
+  // the same results as Search() with the query set, for several values of k.
+  typedef NSModel<NearestNeighborSort> KNNModel;
+  util::Timers timers;
+
+  arma::mat queryData = arma::randu<arma::mat>(5, 200);
+  arma::mat referenceData = arma::randu<arma::mat>(5, 1000);
+
+  KNNModel models[4];
+  models[0] = KNNModel(KNNModel::TreeTypes::KD_TREE, false);
+  models[1] = KNNModel(KNNModel::TreeTypes::COVER_TREE, true);
+  models[2] = KNNModel(KNNModel::TreeTypes::OCTREE, false);
+  models[3] = KNNModel(KNNModel::TreeTypes::BALL_TREE, false);
+
+  for (size_t j = 0; j < 2; ++j)
+  {
+    for (size_t i = 0; i < 4; ++i)
+    {
+      arma::mat referenceCopy(referenceData);
+      models[i].BuildModel(timers, std::move(referenceCopy),
+          (j == 0) ? DUAL_TREE_MODE : SINGLE_TREE_MODE);
+
+      REQUIRE(!models[i].HasQueryTree());
+      arma::mat queryCopy(queryData);
+      models[i].BuildQueryTree(timers, std::move(queryCopy));
+      REQUIRE(models[i].HasQueryTree());
+
+      for (const size_t k : { 3, 1, 7 })
+      {
+        arma::Mat<size_t> baselineNeighbors;
+        arma::mat baselineDistances;
+        arma::mat searchCopy(queryData);
+        models[i].Search(timers, std::move(searchCopy), k, baselineNeighbors,
+            baselineDistances);
+
+        arma::Mat<size_t> neighbors;
+        arma::mat distances;
+        models[i].SearchQueryTree(timers, k, neighbors, distances);
+
+        REQUIRE(neighbors.n_rows == k);
+        REQUIRE(neighbors.n_cols == queryData.n_cols);
+        CheckMatrices(neighbors, baselineNeighbors);
+        CheckMatrices(distances, baselineDistances);
+      }
+
+      models[i].ClearQueryTree();
+      REQUIRE(!models[i].HasQueryTree());
+
+      arma::Mat<size_t> neighbors;
+      arma::mat distances;
+      REQUIRE_THROWS_AS(models[i].SearchQueryTree(timers, 3, neighbors,
+          distances), std::logic_error);
+    }
+  }
+}
+
+TEST_CASE("KNNModelFloatTest", "[KNNTest]")
+{
+  // Ensure that an NSModel holding single-precision data gives the same
+  // results as a double-precision naive search, and that reranking gives
+  // double-precision distances.
+  typedef NSModel<NearestNeighborSort, arma::fmat> FloatKNNModel;
+  util::Timers timers;
+
+  arma::mat queryData = arma::randu<arma::mat>(5, 100);
+  arma::mat referenceData = arma::randu<arma::mat>(5, 1000);
+
+  KNN naive(referenceData, NAIVE_MODE);
+  arma::Mat<size_t> naiveNeighbors;
+  arma::mat naiveDistances;
+  naive.Search(queryData, 5, naiveNeighbors, naiveDistances);
+
+  FloatKNNModel model(FloatKNNModel::TreeTypes::KD_TREE, false);
+  model.BuildModel(timers, arma::conv_to<arma::fmat>::from(referenceData),
+      DUAL_TREE_MODE);
+
+  for (size_t r = 0; r < 2; ++r)
+  {
+    const bool rerank = (r == 1);
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    model.Search(timers, arma::conv_to<arma::fmat>::from(queryData), 5,
+        neighbors, distances, rerank);
+
+    REQUIRE(neighbors.n_rows == 5);
+    REQUIRE(neighbors.n_cols == queryData.n_cols);
+    for (size_t i = 0; i < distances.n_elem; ++i)
+    {
+      // Reranked distances are computed in double precision.
+      REQUIRE(distances[i] ==
+          Approx(naiveDistances[i]).epsilon(rerank ? 1e-10 : 1e-5));
+    }
+
+    if (rerank)
+    {
+      for (size_t i = 0; i < neighbors.n_elem; ++i)
+      {
+        const size_t q = i / neighbors.n_rows;
+        REQUIRE(distances[i] == Approx(arma::norm(queryData.col(q) -
+            referenceData.col(neighbors[i]))).epsilon(1e-12));
+      }
+
+      for (size_t i = 0; i < distances.n_cols; ++i)
+        for (size_t j = 1; j < distances.n_rows; ++j)
+          REQUIRE(distances(j - 1, i) <= distances(j, i));
+    }
+  }
+
+  // Only BinarySpaceTree-based trees are available for float data.
+  FloatKNNModel coverModel(FloatKNNModel::TreeTypes::COVER_TREE, false);
+  REQUIRE_THROWS_AS(coverModel.BuildModel(timers,
+      arma::conv_to<arma::fmat>::from(referenceData), DUAL_TREE_MODE),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that traversal instrumentation counts what the rules do, and does
+ * not change the results.
+ */
+TEST_CASE("KNNTraversalInstrumentationTest", "[KNNTest]")
+{
+  typedef KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+  typedef NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+      KDTree, TreeType::DualTreeTraverser, TreeType::SingleTreeTraverser,
+      TraversalInstrumentation> InstrumentedKNN;
+
+  arma::mat queryData = arma::randu<arma::mat>(3, 200);
+  arma::mat referenceData = arma::randu<arma::mat>(3, 2000);
+
+  KNN knn(referenceData);
+  InstrumentedKNN instrumentedKnn(referenceData);
+
+  const NeighborSearchMode modes[] = { SINGLE_TREE_MODE, DUAL_TREE_MODE };
+  for (const NeighborSearchMode mode : modes)
+  {
+    knn.SearchMode() = mode;
+    instrumentedKnn.SearchMode() = mode;
+
+    arma::Mat<size_t> neighbors, instrumentedNeighbors;
+    arma::mat distances, instrumentedDistances;
+    knn.Search(queryData, 3, neighbors, distances);
+    instrumentedKnn.Search(queryData, 3, instrumentedNeighbors,
+        instrumentedDistances);
+
+    CheckMatrices(neighbors, instrumentedNeighbors);
+    CheckMatrices(distances, instrumentedDistances);
+
+    const TraversalInstrumentation& instrumentation =
+        instrumentedKnn.Instrumentation();
+    REQUIRE(instrumentation.Scores() == instrumentedKnn.Scores());
+    REQUIRE(instrumentation.Scores() == instrumentation.NodesVisited() +
+        instrumentation.Prunes());
+    REQUIRE(instrumentation.Prunes() > 0);
+    // Every call to BaseCase() is counted, even if the rules skip it.
+    REQUIRE(instrumentation.BaseCases() >= instrumentedKnn.BaseCases());
+    REQUIRE(instrumentation.BaseCases() <
+        queryData.n_cols * referenceData.n_cols);
+
+    util::Timers timers;
+    timers.Enabled() = true;
+    instrumentation.Report(timers, "knn");
+    REQUIRE(timers.GetAllTimers().count("knn_score") == 1);
+    REQUIRE(timers.GetAllTimers().count("knn_base_case") == 1);
+  }
+}
+
 TEST_CASE("KNNModelMonochromaticTest", "[KNNTest]")
 {
   // Ensure that we can build an NSModel<NearestNeighborSearch> and get correct
@@ -1865,3 +2302,460 @@ TEST_CASE("KNNSpillTreeSearchEnoughResults", "[KNNTest]")
   REQUIRE(accu(distancesGreedy < 0.0 || distancesGreedy > std::sqrt(3.0))
       == 0);
 }
+
+/**
+ * Make sure that single-tree and greedy searches give the same results and do
+ * the same work whether the queries are split between threads or not.
+ */
+template<typename KNNType>
+void CheckParallelSingleTreeSearch(KNNType& knn, const arma::mat& querySet)
+{
+  #ifdef MLPACK_USE_OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  arma::Mat<size_t> sequentialNeighbors;
+  arma::mat sequentialDistances;
+  knn.Search(querySet, 5, sequentialNeighbors, sequentialDistances);
+  const size_t sequentialBaseCases = knn.BaseCases();
+  const size_t sequentialScores = knn.Scores();
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(threads);
+  #endif
+
+  arma::Mat<size_t> parallelNeighbors;
+  arma::mat parallelDistances;
+  knn.Search(querySet, 5, parallelNeighbors, parallelDistances);
+
+  REQUIRE(knn.BaseCases() == sequentialBaseCases);
+  REQUIRE(knn.Scores() == sequentialScores);
+  CheckMatrices(parallelNeighbors, sequentialNeighbors);
+  CheckMatrices(parallelDistances, sequentialDistances);
+}
+
+TEST_CASE("KNNParallelSingleTreeSearchTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(4, 2000);
+  arma::mat querySet = arma::randu<arma::mat>(4, 1500);
+
+  KNN knn(dataset, SINGLE_TREE_MODE);
+  CheckParallelSingleTreeSearch(knn, querySet);
+  knn.SearchMode() = GREEDY_SINGLE_TREE_MODE;
+  CheckParallelSingleTreeSearch(knn, querySet);
+
+  SpillKNN spillKNN(dataset, SINGLE_TREE_MODE);
+  CheckParallelSingleTreeSearch(spillKNN, querySet);
+  spillKNN.SearchMode() = GREEDY_SINGLE_TREE_MODE;
+  CheckParallelSingleTreeSearch(spillKNN, querySet);
+
+  // Cover trees are searched on one thread; the results must not change.
+  NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+      StandardCoverTree> coverKNN(dataset, SINGLE_TREE_MODE);
+  CheckParallelSingleTreeSearch(coverKNN, querySet);
+}
+
+/**
+ * Make sure that the tiled brute-force search gives exactly the results of the
+ * tree searches, for blocks that are larger and smaller than k, and for
+ * high-dimensional data where the trees don't prune much.
+ */
+TEST_CASE("KNNBlockNaiveSearchTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(60, 1100);
+  arma::mat querySet = arma::randu<arma::mat>(60, 700);
+
+  KNN naive(dataset, NAIVE_MODE);
+  KNN dualTree(dataset, DUAL_TREE_MODE);
+
+  // Bichromatic search; k = 300 is larger than the last reference tile, which
+  // holds only 76 points.
+  for (const size_t k : { 1, 10, 300 })
+  {
+    arma::Mat<size_t> naiveNeighbors, treeNeighbors;
+    arma::mat naiveDistances, treeDistances;
+    naive.Search(querySet, k, naiveNeighbors, naiveDistances);
+    dualTree.Search(querySet, k, treeNeighbors, treeDistances);
+
+    REQUIRE(naive.BaseCases() == querySet.n_cols * dataset.n_cols);
+    CheckMatrices(naiveNeighbors, treeNeighbors);
+    CheckMatrices(naiveDistances, treeDistances);
+  }
+
+  // Monochromatic search, where each point must not be its own neighbor.
+  arma::Mat<size_t> naiveNeighbors, treeNeighbors;
+  arma::mat naiveDistances, treeDistances;
+  naive.Search(10, naiveNeighbors, naiveDistances);
+  dualTree.Search(10, treeNeighbors, treeDistances);
+
+  CheckMatrices(naiveNeighbors, treeNeighbors);
+  CheckMatrices(naiveDistances, treeDistances);
+  for (size_t i = 0; i < naiveNeighbors.n_cols; ++i)
+    REQUIRE(arma::all(naiveNeighbors.col(i) != i));
+
+  // The same must hold for the squared distance and for floats.
+  NeighborSearch<NearestNeighborSort, SquaredEuclideanDistance, arma::fmat>
+      naiveFloat(arma::conv_to<arma::fmat>::from(dataset), NAIVE_MODE);
+  NeighborSearch<NearestNeighborSort, SquaredEuclideanDistance, arma::fmat>
+      singleTreeFloat(arma::conv_to<arma::fmat>::from(dataset),
+      SINGLE_TREE_MODE);
+  const arma::fmat floatQuerySet = arma::conv_to<arma::fmat>::from(querySet);
+
+  arma::Mat<size_t> naiveFloatNeighbors, treeFloatNeighbors;
+  arma::fmat naiveFloatDistances, treeFloatDistances;
+  naiveFloat.Search(floatQuerySet, 10, naiveFloatNeighbors,
+      naiveFloatDistances);
+  singleTreeFloat.Search(floatQuerySet, 10, treeFloatNeighbors,
+      treeFloatDistances);
+
+  CheckMatrices(naiveFloatNeighbors, treeFloatNeighbors);
+  CheckMatrices(naiveFloatDistances, treeFloatDistances);
+}
+
+/**
+ * Make sure that nearest neighbor search with FixedLMetric gives the same
+ * results as with EuclideanDistance, for all search modes.
+ */
+TEST_CASE("KNNFixedLMetricTest", "[KNNTest]")
+{
+  arma::mat dataset(3, 500, arma::fill::randu);
+  arma::mat querySet(3, 100, arma::fill::randu);
+
+  KNN knn(dataset);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(querySet, 5, neighbors, distances);
+
+  const std::vector<NeighborSearchMode> modes = { NAIVE_MODE, SINGLE_TREE_MODE,
+      DUAL_TREE_MODE };
+  for (const NeighborSearchMode mode : modes)
+  {
+    NeighborSearch<NearestNeighborSort, FixedLMetric<2, 3>> fixedKnn(dataset,
+        mode);
+    arma::Mat<size_t> fixedNeighbors;
+    arma::mat fixedDistances;
+    fixedKnn.Search(querySet, 5, fixedNeighbors, fixedDistances);
+
+    CheckMatrices(neighbors, fixedNeighbors);
+    CheckMatrices(distances, fixedDistances);
+  }
+}
+
+/**
+ * Make sure that NSModel selects FixedLMetric for kd-trees on 2-, 3- and
+ * 4-dimensional data, and that it gives the same results as a search with
+ * EuclideanDistance, also after serialization.
+ */
+TEST_CASE("KNNModelFixedLMetricTest", "[KNNTest]")
+{
+  typedef NSModel<NearestNeighborSort> KNNModel;
+  util::Timers timers;
+
+  for (size_t dim = 1; dim <= 5; ++dim)
+  {
+    arma::mat dataset(dim, 500, arma::fill::randu);
+    arma::mat querySet(dim, 100, arma::fill::randu);
+
+    KNN knn(dataset);
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    knn.Search(querySet, 5, neighbors, distances);
+
+    KNNModel model(KNNModel::KD_TREE);
+    model.BuildModel(timers, arma::mat(dataset), DUAL_TREE_MODE);
+    REQUIRE(model.FixedDimension() == ((dim >= 2 && dim <= 4) ? dim : 0));
+
+    KNNModel xmlModel, jsonModel, binaryModel;
+    SerializeObjectAll(model, xmlModel, jsonModel, binaryModel);
+    REQUIRE(xmlModel.FixedDimension() == model.FixedDimension());
+    REQUIRE(jsonModel.FixedDimension() == model.FixedDimension());
+    REQUIRE(binaryModel.FixedDimension() == model.FixedDimension());
+
+    arma::Mat<size_t> modelNeighbors, binaryNeighbors;
+    arma::mat modelDistances, binaryDistances;
+    model.Search(timers, arma::mat(querySet), 5, modelNeighbors,
+        modelDistances);
+    binaryModel.Search(timers, arma::mat(querySet), 5, binaryNeighbors,
+        binaryDistances);
+
+    CheckMatrices(neighbors, modelNeighbors);
+    CheckMatrices(distances, modelDistances);
+    CheckMatrices(neighbors, binaryNeighbors);
+    CheckMatrices(distances, binaryDistances);
+
+    // A query set of another dimensionality must be rejected.
+    if (model.FixedDimension() != 0)
+    {
+      REQUIRE_THROWS_AS(model.Search(timers, arma::mat(dim + 1, 10), 5,
+          modelNeighbors, modelDistances), std::invalid_argument);
+    }
+  }
+
+  // Naive search and other trees keep the Euclidean distance.
+  arma::mat dataset(3, 100, arma::fill::randu);
+  KNNModel naiveModel(KNNModel::KD_TREE);
+  naiveModel.BuildModel(timers, arma::mat(dataset), NAIVE_MODE);
+  REQUIRE(naiveModel.FixedDimension() == 0);
+  KNNModel ballModel(KNNModel::BALL_TREE);
+  ballModel.BuildModel(timers, arma::mat(dataset), DUAL_TREE_MODE);
+  REQUIRE(ballModel.FixedDimension() == 0);
+}
+
+/**
+ * Make sure that merging the results of searches in shards of the reference
+ * set gives the results of a search in the full reference set.
+ */
+TEST_CASE("KNNMergeNeighborsTest", "[KNNTest]")
+{
+  arma::mat queryData = arma::randu<arma::mat>(3, 100);
+  arma::mat referenceData = arma::randu<arma::mat>(3, 1000);
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(queryData, 10, neighbors, distances);
+
+  // Search three shards of different sizes, and merge their results.
+  const size_t offsets[] = { 0, 300, 750, 1000 };
+  arma::Mat<size_t> mergedNeighbors;
+  arma::mat mergedDistances;
+  for (size_t s = 0; s < 3; ++s)
+  {
+    KNN shardKNN(referenceData.cols(offsets[s], offsets[s + 1] - 1));
+    arma::Mat<size_t> shardNeighbors;
+    arma::mat shardDistances;
+    shardKNN.Search(queryData, 10, shardNeighbors, shardDistances);
+
+    if (s == 0)
+    {
+      mergedNeighbors = std::move(shardNeighbors);
+      mergedDistances = std::move(shardDistances);
+    }
+    else
+    {
+      KNN::MergeNeighbors(mergedNeighbors, mergedDistances, shardNeighbors,
+          shardDistances, offsets[s]);
+    }
+  }
+
+  CheckMatrices(neighbors, mergedNeighbors);
+  CheckMatrices(distances, mergedDistances);
+
+  // Results for different numbers of query points cannot be merged.
+  arma::Mat<size_t> otherNeighbors(10, 99);
+  arma::mat otherDistances(10, 99);
+  REQUIRE_THROWS_AS(KNN::MergeNeighbors(mergedNeighbors, mergedDistances,
+      otherNeighbors, otherDistances), std::invalid_argument);
+}
+
+/**
+ * Check the results of a dynamic search against a static search of the points
+ * currently in the reference set, whose identifiers are given.
+ */
+void CheckDynamicKNN(DynamicKNN& dynamicKNN,
+                     const arma::mat& points,
+                     const arma::Col<size_t>& pointIds,
+                     const arma::mat& queryData,
+                     const size_t k)
+{
+  REQUIRE(dynamicKNN.NumPoints() == points.n_cols);
+
+  KNN knn(points);
+  arma::Mat<size_t> neighbors, dynamicNeighbors;
+  arma::mat distances, dynamicDistances;
+  knn.Search(queryData, k, neighbors, distances);
+  dynamicKNN.Search(queryData, k, dynamicNeighbors, dynamicDistances);
+
+  CheckMatrices(distances, dynamicDistances);
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+    REQUIRE(pointIds[neighbors[i]] == dynamicNeighbors[i]);
+}
+
+/**
+ * Inserting and removing points of a dynamic search must give the same results
+ * as a search of a tree built on the points that are left, including after
+ * levels are merged or rebuilt, and after serialization.
+ */
+TEST_CASE("DynamicKNNInsertRemoveTest", "[KNNTest]")
+{
+  arma::mat points = arma::randu<arma::mat>(3, 500);
+  arma::Col<size_t> pointIds = arma::regspace<arma::Col<size_t>>(0, 499);
+  const arma::mat queryData = arma::randu<arma::mat>(3, 50);
+
+  DynamicKNN dynamicKNN(points, 16);
+  REQUIRE(dynamicKNN.Dimensionality() == 3);
+  CheckDynamicKNN(dynamicKNN, points, pointIds, queryData, 10);
+
+  // Insert points one at a time and by batches, and remove random points, so
+  // that levels are merged and rebuilt.
+  for (size_t round = 0; round < 20; ++round)
+  {
+    const arma::mat newPoints = arma::randu<arma::mat>(3, round % 4 == 0 ?
+        40 : 1);
+    const size_t first = dynamicKNN.Insert(newPoints);
+    points = arma::join_rows(points, newPoints);
+    pointIds = arma::join_cols(pointIds, arma::regspace<arma::Col<size_t>>(
+        first, first + newPoints.n_cols - 1));
+
+    for (size_t i = 0; i < 15; ++i)
+    {
+      const size_t index = RandInt(points.n_cols);
+      REQUIRE(dynamicKNN.Remove(pointIds[index]));
+      REQUIRE(!dynamicKNN.Contains(pointIds[index]));
+      REQUIRE(!dynamicKNN.Remove(pointIds[index]));
+      points.shed_col(index);
+      pointIds.shed_row(index);
+    }
+
+    CheckDynamicKNN(dynamicKNN, points, pointIds, queryData, 10);
+  }
+
+  // k can be as large as the number of points left.
+  CheckDynamicKNN(dynamicKNN, points, pointIds, queryData, points.n_cols);
+  // The points of a level are deleted, or sit in its tree.
+  size_t levelPoints = 0;
+  for (size_t l = 0; l < dynamicKNN.NumLevels(); ++l)
+  {
+    REQUIRE(dynamicKNN.LevelIds(l).n_elem <= 16 * (size_t(1) << l));
+    REQUIRE(dynamicKNN.Level(l).ReferenceSet().n_cols ==
+        dynamicKNN.LevelIds(l).n_elem);
+    levelPoints += arma::accu(dynamicKNN.LevelIds(l) != SIZE_MAX);
+  }
+  REQUIRE(levelPoints == points.n_cols);
+
+  DynamicKNN xmlKNN, jsonKNN, binaryKNN;
+  SerializeObjectAll(dynamicKNN, xmlKNN, jsonKNN, binaryKNN);
+  CheckDynamicKNN(xmlKNN, points, pointIds, queryData, 10);
+  CheckDynamicKNN(binaryKNN, points, pointIds, queryData, 10);
+
+  // The parameters must be checked.
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  REQUIRE_THROWS_AS(dynamicKNN.Search(queryData, points.n_cols + 1, neighbors,
+      distances), std::invalid_argument);
+  REQUIRE_THROWS_AS(dynamicKNN.Search(arma::mat(2, 10), 1, neighbors,
+      distances), std::invalid_argument);
+  REQUIRE_THROWS_AS(dynamicKNN.Insert(arma::mat(2, 10)),
+      std::invalid_argument);
+}
+
+/**
+ * Removing all the points and inserting new ones must work, even with a
+ * different dimensionality.
+ */
+TEST_CASE("DynamicKNNEmptyTest", "[KNNTest]")
+{
+  DynamicKNN dynamicKNN(4);
+  REQUIRE(dynamicKNN.NumPoints() == 0);
+  REQUIRE(dynamicKNN.Insert(arma::randu<arma::mat>(3, 10)) == 0);
+  for (size_t i = 0; i < 10; ++i)
+    REQUIRE(dynamicKNN.Remove(i));
+  REQUIRE(dynamicKNN.NumPoints() == 0);
+
+  arma::mat points = arma::randu<arma::mat>(2, 30);
+  REQUIRE(dynamicKNN.Insert(points) == 10);
+  CheckDynamicKNN(dynamicKNN, points, arma::regspace<arma::Col<size_t>>(10,
+      39), arma::randu<arma::mat>(2, 5), 5);
+}
+
+/**
+ * Readers of a ConcurrentNeighborSearch must get consistent results while a
+ * writer inserts and deletes points, and the final results must be those of
+ * the points that are left.
+ */
+TEST_CASE("ConcurrentKNNReadersWriterTest", "[KNNTest]")
+{
+  const arma::mat referenceData = arma::randu<arma::mat>(3, 1000);
+  const arma::mat newPoints = arma::randu<arma::mat>(3, 500);
+  const arma::mat queryData = arma::randu<arma::mat>(3, 20);
+  ConcurrentNeighborSearch<> search(referenceData);
+  REQUIRE(search.NumPoints() == 1000);
+
+  // Catch assertions can't be made by other threads, so the readers count the
+  // inconsistent results.
+  std::atomic<bool> done(false);
+  std::atomic<size_t> errors(0);
+  std::vector<std::thread> readers;
+  for (size_t t = 0; t < 3; ++t)
+  {
+    readers.push_back(std::thread([&]()
+    {
+      arma::Mat<size_t> neighbors;
+      arma::mat distances;
+      size_t searches = 0;
+      while (!done || searches < 5)
+      {
+        search.Search(queryData, 5, neighbors, distances);
+        for (size_t q = 0; q < neighbors.n_cols; ++q)
+        {
+          for (size_t j = 0; j < neighbors.n_rows; ++j)
+          {
+            const size_t index = neighbors(j, q);
+            const double distance = (index < 1000) ?
+                EuclideanDistance::Evaluate(queryData.col(q),
+                    referenceData.col(index)) :
+                EuclideanDistance::Evaluate(queryData.col(q),
+                    newPoints.col(index - 1000));
+            if (std::abs(distance - distances(j, q)) > 1e-10 ||
+                (j > 0 && distances(j, q) < distances(j - 1, q)))
+              ++errors;
+          }
+        }
+        ++searches;
+      }
+    }));
+  }
+
+  // Insert the new points by batches, and delete every tenth point of the
+  // original reference set.
+  for (size_t b = 0; b < 10; ++b)
+  {
+    REQUIRE(search.Insert(newPoints.cols(50 * b, 50 * b + 49)) ==
+        1000 + 50 * b);
+    for (size_t i = 100 * b; i < 100 * (b + 1); i += 10)
+      REQUIRE(search.Remove(i));
+  }
+  REQUIRE(!search.Remove(0));
+  REQUIRE(!search.Remove(1500));
+
+  done = true;
+  for (size_t t = 0; t < readers.size(); ++t)
+    readers[t].join();
+  REQUIRE(errors == 0);
+  REQUIRE(search.NumPoints() == 1400);
+
+  // Compare with a search of the points that are left.
+  arma::uvec left(1400);
+  size_t n = 0;
+  for (size_t i = 0; i < 1500; ++i)
+  {
+    if (i >= 1000 || i % 10 != 0)
+      left[n++] = i;
+  }
+  const arma::mat allPoints = arma::join_rows(referenceData, newPoints);
+  const arma::mat leftPoints = allPoints.cols(left);
+  KNN knn(leftPoints);
+  arma::Mat<size_t> neighbors, concurrentNeighbors;
+  arma::mat distances, concurrentDistances;
+  knn.Search(queryData, 10, neighbors, distances);
+  search.Search(queryData, 10, concurrentNeighbors, concurrentDistances);
+  CheckMatrices(distances, concurrentDistances);
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+    REQUIRE(left[neighbors[i]] == concurrentNeighbors[i]);
+
+  // The range search must find the points within the range.
+  std::vector<std::vector<size_t>> rangeNeighbors;
+  std::vector<std::vector<double>> rangeDistances;
+  search.Search(queryData, RangeType<double>(0.0, 0.25), rangeNeighbors,
+      rangeDistances);
+  for (size_t q = 0; q < queryData.n_cols; ++q)
+  {
+    const arma::rowvec queryDistances = arma::sqrt(arma::sum(arma::square(
+        leftPoints.each_col() - queryData.col(q)), 0));
+    REQUIRE(rangeNeighbors[q].size() ==
+        (size_t) arma::accu(queryDistances <= 0.25));
+    for (size_t j = 0; j < rangeNeighbors[q].size(); ++j)
+      REQUIRE(rangeNeighbors[q][j] % 10 != 0 || rangeNeighbors[q][j] >= 1000);
+  }
+}
@@ -730,3 +730,124 @@ TEST_CASE("RAModelTest", "[KRANNTest]")
     }
   }
 }
+
+// Make sure that single-tree search gives the same results for the same seed,
+// whether the queries are split between threads or not.
+TEST_CASE("ParallelSingleTreeSearchTest", "[KRANNTest]")
+{
+  arma::mat refData;
+  arma::mat queryData;
+
+  if (!data::Load("rann_test_r_3_900.csv", refData))
+    FAIL("Cannot load dataset rann_test_r_3_900.csv");
+  if (!data::Load("rann_test_q_3_100.csv", queryData))
+    FAIL("Cannot load dataset rann_test_q_3_100.csv");
+
+  RASearch<> tssRann(refData, false, true, 1.0, 0.95, false, false);
+
+  #ifdef MLPACK_USE_OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  arma::Mat<size_t> sequentialNeighbors;
+  arma::mat sequentialDistances;
+  RandomSeed(12);
+  tssRann.Search(queryData, 3, sequentialNeighbors, sequentialDistances);
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(threads);
+  #endif
+
+  arma::Mat<size_t> parallelNeighbors;
+  arma::mat parallelDistances;
+  RandomSeed(12);
+  tssRann.Search(queryData, 3, parallelNeighbors, parallelDistances);
+
+  REQUIRE(arma::all(arma::vectorise(parallelNeighbors ==
+      sequentialNeighbors)));
+  REQUIRE(arma::approx_equal(parallelDistances, sequentialDistances, "both",
+      1e-10, 1e-10));
+
+  // The same holds for monochromatic search.
+  RASearch<> monoRann(queryData, false, true, 5.0);
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(1);
+  #endif
+
+  RandomSeed(12);
+  monoRann.Search(2, sequentialNeighbors, sequentialDistances);
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(threads);
+  #endif
+
+  RandomSeed(12);
+  monoRann.Search(2, parallelNeighbors, parallelDistances);
+
+  REQUIRE(arma::all(arma::vectorise(parallelNeighbors ==
+      sequentialNeighbors)));
+  REQUIRE(arma::approx_equal(parallelDistances, sequentialDistances, "both",
+      1e-10, 1e-10));
+}
+
+// Test the guarantees of dual-tree rank-approximate search with the parallel
+// dual-tree traverser.
+TEST_CASE("ParallelDualTreeSearchTest", "[KRANNTest]")
+{
+  arma::mat refData;
+  arma::mat queryData;
+
+  if (!data::Load("rann_test_r_3_900.csv", refData))
+    FAIL("Cannot load dataset rann_test_r_3_900.csv");
+  if (!data::Load("rann_test_q_3_100.csv", queryData))
+    FAIL("Cannot load dataset rann_test_q_3_100.csv");
+
+  typedef KDTree<EuclideanDistance, RAQueryStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+  typedef RASearch<NearestNeighborSort, EuclideanDistance, arma::mat, KDTree,
+      TreeType::template ParallelDualTreeTraverser> ParallelKRANN;
+
+  ParallelKRANN tsdRann(refData, false, false, 1.0, 0.95, false, false, 5);
+
+  arma::Mat<size_t> qrRanks;
+  if (!data::Load("rann_test_qr_ranks.csv", qrRanks, false, false))
+    FAIL("Cannot load dataset rann_test_qr_ranks.csv");
+
+  size_t numRounds = 1000;
+  arma::Col<size_t> numSuccessRounds(queryData.n_cols);
+  numSuccessRounds.fill(0);
+
+  // 1% of 900 is 9, so the rank is expected to be less than 10.
+  size_t expectedRankErrorUB = 10;
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  for (size_t rounds = 0; rounds < numRounds; rounds++)
+  {
+    tsdRann.Search(queryData, 1, neighbors, distances);
+
+    for (size_t i = 0; i < queryData.n_cols; ++i)
+      if (qrRanks(i, neighbors(0, i)) < expectedRankErrorUB)
+        numSuccessRounds[i]++;
+
+    neighbors.reset();
+    distances.reset();
+  }
+
+  // Find the 95%-tile threshold so that 95% of the queries should pass this
+  // threshold.
+  size_t threshold = floor(numRounds *
+      (0.95 - (1.96 * sqrt(0.95 * 0.05 / numRounds))));
+  size_t numQueriesFail = 0;
+  for (size_t i = 0; i < queryData.n_cols; ++i)
+    if (numSuccessRounds[i] < threshold)
+      numQueriesFail++;
+
+  // Assert that at most 5% of the queries fall out of this threshold.
+  // 5% of 100 queries is 5.
+  size_t maxNumQueriesFail = 6;
+
+  REQUIRE(numQueriesFail < maxNumQueriesFail);
+}
@@ -1347,3 +1347,63 @@ TEMPLATE_TEST_CASE("LARSSparseModelDenseData", "[LARSTest]", float, double)
   REQUIRE(lars2.ActiveSet().size() < 1000);
   REQUIRE(lars2.ActiveSet().size() > 0);
 }
+
+/**
+ * Make sure that solving a batch of problems against the same data gives the
+ * same solutions as training a model for each of them.
+ */
+TEST_CASE("LARSSolveBatchTest", "[LARSTest]")
+{
+  arma::mat data = arma::randn<arma::mat>(15, 100);
+  arma::mat responses = arma::randn<arma::mat>(4, 15) * data +
+      0.1 * arma::randn<arma::mat>(4, 100) + 3.0;
+  // Make sure one problem is solved by the all-zeros model.
+  responses.row(3).fill(0.5);
+  const arma::mat responsesTrans = responses.t();
+
+  for (const bool fitIntercept : { false, true })
+  {
+    for (const bool normalizeData : { false, true })
+    {
+      for (const bool useCholesky : { false, true })
+      {
+        LARS<> lars(useCholesky, 0.1, 0.05, 1e-16, fitIntercept,
+            normalizeData);
+
+        arma::mat betas;
+        arma::rowvec intercepts;
+        lars.SolveBatch(data, responsesTrans, betas, intercepts);
+        REQUIRE(betas.n_rows == 15);
+        REQUIRE(betas.n_cols == 4);
+        REQUIRE(intercepts.n_elem == 4);
+
+        // The same problems with row-major data.
+        arma::mat rowMajorBetas;
+        lars.SolveBatch(arma::mat(data.t()), responsesTrans, rowMajorBetas,
+            false);
+
+        for (size_t i = 0; i < 4; ++i)
+        {
+          const arma::rowvec y = responses.row(i);
+          LARS<> single(data, y, true, useCholesky, 0.1, 0.05, 1e-16,
+              fitIntercept, normalizeData);
+          CheckMatrices(arma::vec(betas.col(i)), single.Beta(), 1e-6);
+          CheckMatrices(arma::vec(rowMajorBetas.col(i)), single.Beta(), 1e-6);
+          REQUIRE(intercepts[i] == Approx(single.Intercept()).margin(1e-6));
+        }
+      }
+    }
+  }
+
+  // With a given Gram matrix.
+  LARS<> lars(true, 0.1, 0.0, 1e-16, false, false);
+  const arma::mat gram = data * data.t();
+  arma::mat betas;
+  lars.SolveBatch(data, responsesTrans, betas, true, gram);
+  for (size_t i = 0; i < 4; ++i)
+  {
+    const arma::rowvec y = responses.row(i);
+    LARS<> single(data, y, true, true, 0.1, 0.0, 1e-16, false, false);
+    CheckMatrices(arma::vec(betas.col(i)), single.Beta(), 1e-6);
+  }
+}
@@ -423,3 +423,46 @@ TEST_CASE("LinearRegressionSparseTrainingTest", "[LinearRegressionTest]")
 
   REQUIRE(predictions.n_elem == 5000);
 }
+
+/**
+ * Make sure that a model fit one batch at a time with Partial() and Finalize()
+ * is the same as a model trained on all the points at once.
+ */
+TEST_CASE("LinearRegressionPartialTest", "[LinearRegressionTest]")
+{
+  arma::mat data(10, 3500, arma::fill::randu);
+  arma::rowvec responses = arma::randn<arma::rowvec>(10) * data +
+      0.1 * arma::randn<arma::rowvec>(3500) + 2.0;
+
+  for (const bool intercept : { true, false })
+  {
+    for (const double lambda : { 0.0, 0.5 })
+    {
+      LinearRegression<> lr(data, responses, lambda, intercept);
+
+      // The model trained on a few points is overwritten by Finalize().
+      LinearRegression<> partialLr(data.cols(0, 9), responses.subvec(0, 9),
+          lambda, intercept);
+      // Batches of different sizes, one of them larger than the block size.
+      partialLr.Partial(data.cols(0, 99), responses.subvec(0, 99));
+      partialLr.Partial(data.cols(100, 2599), responses.subvec(100, 2599));
+      partialLr.Partial(data.cols(2600, 3499), responses.subvec(2600, 3499));
+      const double error = partialLr.Finalize();
+
+      CheckMatrices(partialLr.Parameters(), lr.Parameters(), 1e-5);
+      REQUIRE(error == Approx(lr.ComputeError(data, responses)).epsilon(1e-5));
+    }
+  }
+
+  // The statistics are cleared by Finalize().
+  LinearRegression<> lr;
+  REQUIRE_THROWS_AS(lr.Finalize(), std::runtime_error);
+  lr.Partial(data, responses);
+  lr.Finalize();
+  REQUIRE_THROWS_AS(lr.Finalize(), std::runtime_error);
+
+  // All batches must have the same dimensionality.
+  lr.Partial(data, responses);
+  REQUIRE_THROWS_AS(lr.Partial(data.rows(0, 4), responses),
+      std::invalid_argument);
+}
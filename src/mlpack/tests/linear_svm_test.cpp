@@ -1475,3 +1475,44 @@ TEMPLATE_TEST_CASE("LinearSVMTrainVariantTest", "[LinearSVMTest]", arma::fmat,
   REQUIRE(lsvm16.FeatureSize() == 10);
   REQUIRE(lsvm16.NumClasses() == 2);
 }
+
+/**
+ * Make sure the sparse gradient used by ParallelSGD only holds the rows of the
+ * dimensions of the batch (and the intercept), and matches the dense gradient
+ * there.
+ */
+TEST_CASE("LinearSVMFunctionSparseGradientTest", "[LinearSVMTest]")
+{
+  arma::sp_mat dataset;
+  dataset.sprandu(30, 200, 0.05);
+  arma::Row<size_t> labels(200);
+  for (size_t i = 0; i < 200; ++i)
+    labels[i] = RandInt(0, 3);
+
+  for (const bool fitIntercept : { false, true })
+  {
+    LinearSVMFunction<arma::sp_mat> svmf(dataset, labels, 3, 0.5, 1.0,
+        fitIntercept);
+    const size_t numRows = fitIntercept ? 31 : 30;
+    const arma::mat parameters = arma::randn<arma::mat>(numRows, 3);
+
+    arma::mat gradient;
+    arma::sp_mat sparseGradient;
+    svmf.Gradient(parameters, 50, gradient, 3);
+    svmf.Gradient(parameters, 50, sparseGradient, 3);
+
+    REQUIRE(sparseGradient.n_rows == numRows);
+    REQUIRE(sparseGradient.n_cols == 3);
+    const arma::mat batch(dataset.cols(50, 52));
+    for (size_t d = 0; d < numRows; ++d)
+    {
+      for (size_t c = 0; c < 3; ++c)
+      {
+        if (d == 30 || arma::any(batch.row(d) != 0.0))
+          REQUIRE(sparseGradient(d, c) == Approx(gradient(d, c)).margin(1e-10));
+        else
+          REQUIRE(sparseGradient(d, c) == 0.0);
+      }
+    }
+  }
+}
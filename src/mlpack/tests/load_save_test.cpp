@@ -972,6 +972,137 @@ TEST_CASE("LoadCSVTxtTest", "[LoadSaveTest]")
   remove("test_file.txt");
 }
 
+/**
+ * Make sure the parallel parser of mapped CSV files gives the same matrix as
+ * the stream parser, whatever the size of the chunks.
+ */
+TEST_CASE("LoadMappedCSVChunksTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test_file.csv", fstream::out | fstream::binary);
+
+  f << "1,2.5,-3,4e2\n";
+  f << "5, 6,7\r\n";
+  f << "+8,inf,-NaN,9,\n";
+  for (size_t i = 0; i < 50; ++i)
+    f << i << "," << (0.1 * i) << ",," << (i * i) << "\n";
+  f << "10,11\n";
+  f << "\n";
+  f << "12,13,14,15,16,17\n";
+
+  f.close();
+
+  data::LoadCSV loader;
+  std::fstream stream("test_file.csv", std::fstream::in);
+  arma::mat expected;
+  REQUIRE(loader.LoadNumericCSV(expected, stream) == true);
+  REQUIRE(expected.n_rows == 54);
+  REQUIRE(expected.n_cols == 5);
+
+  data::MappedFile file("test_file.csv");
+  const size_t chunkSizes[] = { 1, 7, 64, 1000000 };
+  for (size_t chunkSize : chunkSizes)
+  {
+    arma::mat test;
+    REQUIRE(loader.LoadNumericCSV(test, file, false, chunkSize) == true);
+    REQUIRE(test.n_rows == expected.n_rows);
+    REQUIRE(test.n_cols == expected.n_cols);
+    for (size_t i = 0; i < expected.n_elem; ++i)
+    {
+      if (std::isnan(expected[i]))
+        REQUIRE(std::isnan(test[i]));
+      else
+        REQUIRE(test[i] == expected[i]);
+    }
+
+    arma::mat transposed;
+    REQUIRE(loader.LoadNumericCSV(transposed, file, true, chunkSize) == true);
+    REQUIRE(transposed.n_rows == expected.n_cols);
+    REQUIRE(transposed.n_cols == expected.n_rows);
+    REQUIRE(transposed(1, 1) == 6.0);
+    REQUIRE(transposed(3, 53) == 0.0);
+  }
+
+  // Loading through data::Load() uses the mapped parser.
+  arma::mat loaded;
+  REQUIRE(data::Load("test_file.csv", loaded) == true);
+  REQUIRE(loaded.n_rows == expected.n_cols);
+  REQUIRE(loaded.n_cols == expected.n_rows);
+  REQUIRE(loaded(3, 0) == 400.0);
+
+  // Remove the file.
+  remove("test_file.csv");
+}
+
+/**
+ * Make sure mlpack datasets can be mapped, and loaded or saved through
+ * data::Load() and data::Save() with any element type.
+ */
+TEST_CASE("MappedDatasetTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test_file.csv", fstream::out);
+  f << "1,a,3" << endl;
+  f << "4,b,6" << endl;
+  f << "7,a,9" << endl;
+  f.close();
+
+  arma::mat dataset;
+  data::DatasetInfo info;
+  REQUIRE(data::Load("test_file.csv", dataset, info) == true);
+  remove("test_file.csv");
+
+  data::MappedDataset<>::Save("test_file.mlds", dataset, info);
+
+  data::MappedDataset<> mapped("test_file.mlds");
+  REQUIRE(mapped.IsMapped());
+  REQUIRE(mapped.Info().Dimensionality() == 3);
+  REQUIRE(mapped.Info().Type(1) == data::Datatype::categorical);
+  REQUIRE(mapped.Info().NumMappings(1) == 2);
+  REQUIRE(mapped.Matrix().n_rows == 3);
+  REQUIRE(mapped.Matrix().n_cols == 3);
+  REQUIRE(arma::approx_equal(mapped.Matrix(), dataset, "absdiff", 0.0));
+
+  // Copies share the mapping.
+  data::MappedDataset<> copy(mapped);
+  REQUIRE(copy.Matrix().memptr() == mapped.Matrix().memptr());
+
+  // The element type has to match to map the file...
+  data::MappedDataset<float> wrongType;
+  REQUIRE_THROWS_AS(wrongType.Load("test_file.mlds"), std::runtime_error);
+  REQUIRE(data::Load("test_file.mlds", wrongType) == false);
+
+  // ...but loading it can convert.
+  arma::fmat converted;
+  REQUIRE(data::Load("test_file.mlds", converted) == true);
+  REQUIRE(arma::approx_equal(converted, arma::conv_to<arma::fmat>::from(
+      dataset), "absdiff", 0.0));
+
+  arma::mat loaded;
+  data::DatasetInfo loadedInfo;
+  REQUIRE(data::Load("test_file.mlds", loaded, loadedInfo) == true);
+  REQUIRE(arma::approx_equal(loaded, dataset, "absdiff", 0.0));
+  REQUIRE(loadedInfo.Type(1) == data::Datatype::categorical);
+  REQUIRE(loadedInfo.UnmapString(1, 1) == "b");
+
+  // Round-trip through data::Save().
+  arma::Mat<size_t> counts = arma::randi<arma::Mat<size_t>>(4, 100,
+      arma::distr_param(0, 1000));
+  REQUIRE(data::Save("test_file.mlds", counts) == true);
+  arma::Mat<size_t> countsLoaded;
+  REQUIRE(data::Load("test_file.mlds", countsLoaded) == true);
+  REQUIRE(arma::all(arma::vectorise(countsLoaded == counts)));
+
+  // A truncated file is rejected.
+  f.open("test_file.mlds", fstream::out | fstream::binary);
+  f << "MLPKDSF1";
+  f.close();
+  REQUIRE(data::Load("test_file.mlds", loaded) == false);
+
+  // Remove the file.
+  remove("test_file.mlds");
+}
+
 /**
  * Make sure arma_binary is loaded correctly.
  */
@@ -1779,6 +1910,64 @@ TEST_CASE("CategoricalCSVLoadTest04", "[LoadSaveTest]")
   remove("test.csv");
 }
 
+/**
+ * Make sure that a file large enough to be mapped in several chunks gets the
+ * codes of a sequential mapping: each category is mapped to the index of its
+ * first appearance in the file.
+ */
+TEST_CASE("CategoricalCSVLoadChunksTest", "[LoadSaveTest]")
+{
+  const std::string names[] = { "red", "green", "blue", "cyan", "magenta" };
+  fstream f;
+  f.open("test.csv", fstream::out);
+  for (size_t i = 0; i < 2000; ++i)
+  {
+    // Dimension 1 sees new categories all along the file; dimension 2 looks
+    // numeric until its last line.
+    f << i << ", " << names[(i * i + i / 500) % 5] << "_" << (i / 400) << ", "
+        << ((i == 1999) ? std::string("x") : std::to_string(i % 7)) << endl;
+  }
+  f.close();
+
+  arma::mat matrix;
+  DatasetInfo info;
+  REQUIRE(data::Load("test.csv", matrix, info) == true);
+  REQUIRE(matrix.n_rows == 3);
+  REQUIRE(matrix.n_cols == 2000);
+
+  REQUIRE(info.Type(0) == Datatype::numeric);
+  REQUIRE(info.Type(1) == Datatype::categorical);
+  REQUIRE(info.Type(2) == Datatype::categorical);
+  REQUIRE(info.NumMappings(2) == 8);
+
+  std::unordered_map<std::string, size_t> first1, first2;
+  for (size_t i = 0; i < 2000; ++i)
+  {
+    REQUIRE(matrix(0, i) == double(i));
+
+    const std::string category = names[(i * i + i / 500) % 5] + "_" +
+        std::to_string(i / 400);
+    first1.emplace(category, first1.size());
+    REQUIRE(matrix(1, i) == double(first1.at(category)));
+    REQUIRE(info.UnmapString(size_t(matrix(1, i)), 1) == category);
+
+    const std::string value = (i == 1999) ? std::string("x") :
+        std::to_string(i % 7);
+    first2.emplace(value, first2.size());
+    REQUIRE(matrix(2, i) == double(first2.at(value)));
+  }
+  REQUIRE(info.NumMappings(1) == first1.size());
+
+  // A line with the wrong number of dimensions is still an error.
+  f.open("test.csv", fstream::out | fstream::app);
+  f << "1, red" << endl;
+  f.close();
+  DatasetInfo info2;
+  REQUIRE(data::Load("test.csv", matrix, info2) == false);
+
+  remove("test.csv");
+}
+
 TEST_CASE("CategoricalNontransposedCSVLoadTest00", "[LoadSaveTest]")
 {
   fstream f;
@@ -2362,6 +2551,77 @@ TEST_CASE("CategoryCaseTest", "[LoadSaveTest]")
   remove("test.arff");
 }
 
+/**
+ * Make sure that an ARFF file parsed in many chunks gives the same matrix and
+ * mappings as when it is parsed in one chunk, with categories mapped in the
+ * order of their first appearance.
+ */
+TEST_CASE("ChunkedARFFTest", "[LoadSaveTest]")
+{
+  const std::string colors[] = { "red", "green", "blue" };
+  fstream f;
+  f.open("test.arff", fstream::out);
+  f << "@relation test" << endl;
+  f << "@attribute a numeric" << endl;
+  f << "@attribute color {blue, green, red}" << endl;
+  f << "@attribute name string" << endl;
+  f << "@data" << endl;
+  for (size_t i = 0; i < 500; ++i)
+  {
+    if (i % 50 == 0)
+      f << "% comment" << endl << endl;
+    f << (i * 0.5) << ", " << colors[i % 3] << ", name" << (i / 7) << endl;
+  }
+  f.close();
+
+  arma::mat dataset, chunkedDataset;
+  DatasetInfo info, chunkedInfo;
+  LoadARFF("test.arff", dataset, info);
+  LoadARFF("test.arff", chunkedDataset, chunkedInfo, 64);
+
+  REQUIRE(dataset.n_rows == 3);
+  REQUIRE(dataset.n_cols == 500);
+  CheckMatrices(dataset, chunkedDataset);
+
+  // The nominal categories keep the order of the header.
+  REQUIRE(chunkedInfo.NumMappings(1) == 3);
+  REQUIRE(chunkedInfo.MapString<double>("blue", 1) == 0.0);
+  REQUIRE(chunkedInfo.MapString<double>("red", 1) == 2.0);
+
+  // The strings are mapped in the order they appear.
+  REQUIRE(chunkedInfo.NumMappings(2) == info.NumMappings(2));
+  for (size_t i = 0; i < 500; ++i)
+  {
+    REQUIRE(dataset(0, i) == Approx(i * 0.5).margin(1e-10));
+    REQUIRE(chunkedDataset(2, i) == double(i / 7));
+  }
+
+  remove("test.arff");
+}
+
+/**
+ * Missing values in ARFF files are not supported.
+ */
+TEST_CASE("MissingValueARFFTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.arff", fstream::out);
+  f << "@relation test" << endl;
+  f << "@attribute a numeric" << endl;
+  f << "@attribute b numeric" << endl;
+  f << "@data" << endl;
+  f << "1, 2" << endl;
+  f << "3, ?" << endl;
+  f.close();
+
+  arma::mat dataset;
+  DatasetInfo info;
+  REQUIRE_THROWS_AS(LoadARFF("test.arff", dataset, info),
+      std::runtime_error);
+
+  remove("test.arff");
+}
+
 /**
  * Test that a CSV with the wrong number of columns fails.
  */
@@ -2555,3 +2815,132 @@ TEST_CASE("LoadCSVHeaderTest", "[LoadSaveTest]")
   REQUIRE(dataset.n_rows == 4);
   REQUIRE(dataset.n_cols == 2);
 }
+
+/**
+ * Make sure that a CSVChunkReader reads a categorical file in chunks, mapping
+ * every chunk with the DatasetInfo of the first chunk.
+ */
+TEST_CASE("CSVChunkReaderTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test_chunks.csv", fstream::out);
+  f << "1, a, 0.5" << endl;
+  f << "2, b, 1.5" << endl;
+  f << endl;
+  f << "3, a, 2.5" << endl;
+  f << "4, c, 3.5" << endl; // Unknown category.
+  f << "5, b" << endl; // Too few values.
+  f << "6, b, x" << endl; // Not a number.
+  f << "7, b, 4.5" << endl;
+  f.close();
+
+  data::CSVChunkReader reader("test_chunks.csv");
+  arma::mat chunk;
+  REQUIRE(reader.Read(chunk, 2) == 2);
+  REQUIRE(reader.Info().Dimensionality() == 3);
+  REQUIRE(reader.Info().Type(0) == data::Datatype::numeric);
+  REQUIRE(reader.Info().Type(1) == data::Datatype::categorical);
+  REQUIRE(reader.Info().Type(2) == data::Datatype::numeric);
+  REQUIRE(reader.Info().NumMappings(1) == 2);
+  REQUIRE(chunk.n_rows == 3);
+  REQUIRE(chunk(0, 1) == Approx(2.0));
+  REQUIRE(chunk(1, 0) == 0.0);
+  REQUIRE(chunk(1, 1) == 1.0);
+  REQUIRE(chunk(2, 1) == Approx(1.5));
+
+  // The remaining points fit in one chunk; bad lines are skipped.
+  REQUIRE(reader.Read(chunk, 10) == 2);
+  REQUIRE(reader.SkippedLines() == 3);
+  REQUIRE(reader.Info().NumMappings(1) == 2);
+  REQUIRE(chunk.n_cols == 2);
+  REQUIRE(chunk(0, 0) == Approx(3.0));
+  REQUIRE(chunk(1, 0) == 0.0);
+  REQUIRE(chunk(0, 1) == Approx(7.0));
+  REQUIRE(chunk(1, 1) == 1.0);
+  REQUIRE(chunk(2, 1) == Approx(4.5));
+
+  REQUIRE(reader.Read(chunk, 10) == 0);
+  REQUIRE(chunk.n_elem == 0);
+
+  // After a reset, the first chunk is read again with the same mappings.
+  reader.Reset();
+  REQUIRE(reader.Read(chunk, 3) == 3);
+  REQUIRE(chunk(1, 2) == 0.0);
+
+  REQUIRE_THROWS_AS(data::CSVChunkReader("nonexistent_chunks.csv"),
+      std::runtime_error);
+
+  remove("test_chunks.csv");
+}
+
+/**
+ * Make sure that a ChunkedReader gives the points data::Load() would load, for
+ * every supported format.
+ */
+TEST_CASE("ChunkedReaderTest", "[LoadSaveTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(3, 25);
+  const std::string filenames[] = { "test_chunks.csv", "test_chunks.txt",
+      "test_chunks_arma.txt", "test_chunks.bin" };
+  const data::FileType types[] = { data::FileType::CSVASCII,
+      data::FileType::RawASCII, data::FileType::ArmaASCII,
+      data::FileType::ArmaBinary };
+  for (size_t i = 0; i < 4; ++i)
+  {
+    REQUIRE(data::Save(filenames[i], dataset, true, true, types[i]) == true);
+    arma::mat expected;
+    REQUIRE(data::Load(filenames[i], expected, true, true, types[i]) == true);
+
+    data::ChunkedReader<> reader(filenames[i], types[i]);
+    REQUIRE(reader.Type() == types[i]);
+    arma::mat chunk;
+    size_t points = 0;
+    while (reader.Read(chunk, 7) > 0)
+    {
+      REQUIRE(reader.Info().Dimensionality() == 3);
+      REQUIRE(chunk.n_rows == 3);
+      REQUIRE(chunk.n_cols == std::min<size_t>(7, 25 - points));
+      REQUIRE(arma::approx_equal(chunk, expected.cols(points,
+          points + chunk.n_cols - 1), "absdiff", 1e-5));
+      points += chunk.n_cols;
+    }
+    REQUIRE(points == 25);
+    REQUIRE(reader.SkippedLines() == 0);
+
+    // The points can be read again.
+    reader.Reset();
+    REQUIRE(reader.Read(chunk, 30) == 25);
+    REQUIRE(arma::approx_equal(chunk, expected, "absdiff", 1e-5));
+
+    remove(filenames[i].c_str());
+  }
+
+  // Armadillo binary files are converted to the element type of the chunks.
+  arma::Mat<size_t> counts = arma::randi<arma::Mat<size_t>>(4, 10,
+      arma::distr_param(0, 100));
+  REQUIRE(data::Save("test_chunks.bin", counts, true, true,
+      data::FileType::ArmaBinary) == true);
+  data::ChunkedReader<arma::fmat> floatReader("test_chunks.bin");
+  arma::fmat floatChunk;
+  REQUIRE(floatReader.Read(floatChunk, 4) == 4);
+  REQUIRE(floatReader.Read(floatChunk, 4) == 4);
+  REQUIRE(floatChunk(2, 1) == float(counts(2, 5)));
+
+  // A DatasetInfo with the wrong dimensionality is rejected.
+  REQUIRE_THROWS_AS(data::ChunkedReader<>("test_chunks.bin",
+      data::DatasetInfo(3)), std::invalid_argument);
+
+  // Raw binary files need a DatasetInfo.
+  arma::mat raw = arma::randu<arma::mat>(10, 4);
+  REQUIRE(raw.save("test_chunks.bin", arma::raw_binary) == true);
+  REQUIRE_THROWS_AS(data::ChunkedReader<>("test_chunks.bin",
+      data::FileType::RawBinary), std::runtime_error);
+  data::ChunkedReader<> rawReader("test_chunks.bin", data::DatasetInfo(4),
+      data::FileType::RawBinary);
+  arma::mat rawChunk;
+  REQUIRE(rawReader.Read(rawChunk, 6) == 6);
+  REQUIRE(rawReader.Read(rawChunk, 6) == 4);
+  REQUIRE(arma::approx_equal(rawChunk, raw.rows(6, 9).t(), "absdiff", 0.0));
+
+  remove("test_chunks.bin");
+}
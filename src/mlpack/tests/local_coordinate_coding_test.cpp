@@ -204,3 +204,33 @@ TEMPLATE_TEST_CASE("LocalCoordinateCodingTrainReturnObjective",
 
   REQUIRE(std::isfinite(objVal) == true);
 }
+
+/**
+ * Make sure that the points encoded in parallel get the same codes as with one
+ * thread.
+ */
+TEST_CASE("LocalCoordinateCodingParallelEncodeTest",
+    "[LocalCoordinateCodingTest]")
+{
+  arma::mat X = arma::randu<arma::mat>(20, 300);
+  LocalCoordinateCoding<> lcc(X, 10, 0.1, 2);
+
+  #ifdef MLPACK_USE_OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  arma::mat singleCodes;
+  lcc.Encode(X, singleCodes);
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(threads);
+  #endif
+
+  arma::mat codes;
+  lcc.Encode(X, codes);
+
+  REQUIRE(codes.n_rows == 10);
+  REQUIRE(codes.n_cols == 300);
+  CheckMatrices(codes, singleCodes);
+}
@@ -1271,3 +1271,164 @@ TEST_CASE("LogisticRegressionResetTest", "[LogisticRegressionTest]")
   REQUIRE(
       !arma::approx_equal(lr1.Parameters(), lr2.Parameters(), "absdiff", 1e-5));
 }
+
+/**
+ * Make sure that the objective and all of the gradients of the logistic
+ * regression function are the same for sparse and dense data.
+ */
+TEST_CASE("LogisticRegressionFunctionSparseTest", "[LogisticRegressionTest]")
+{
+  arma::sp_mat dataset;
+  dataset.sprandu(20, 300, 0.05);
+  arma::mat denseDataset(dataset);
+  arma::Row<size_t> labels(300);
+  for (size_t i = 0; i < 300; ++i)
+    labels[i] = RandInt(0, 2);
+
+  LogisticRegressionFunction<> lrf(denseDataset, labels, 0.5);
+  LogisticRegressionFunction<arma::sp_mat> sparseLrf(dataset, labels, 0.5);
+
+  const arma::rowvec parameters = arma::randn<arma::rowvec>(21);
+  REQUIRE(sparseLrf.Evaluate(parameters) ==
+      Approx(lrf.Evaluate(parameters)).epsilon(1e-10));
+  REQUIRE(sparseLrf.Evaluate(parameters, 100, 50) ==
+      Approx(lrf.Evaluate(parameters, 100, 50)).epsilon(1e-10));
+
+  arma::rowvec gradient, sparseGradient;
+  lrf.Gradient(parameters, gradient);
+  sparseLrf.Gradient(parameters, sparseGradient);
+  CheckMatrices(gradient, sparseGradient, 1e-8);
+
+  // The separable gradient used by SGD.
+  lrf.Gradient(parameters, 100, gradient, 50);
+  sparseLrf.Gradient(parameters, 100, sparseGradient, 50);
+  CheckMatrices(gradient, sparseGradient, 1e-8);
+
+  const double objective = lrf.EvaluateWithGradient(parameters, gradient);
+  const double sparseObjective = sparseLrf.EvaluateWithGradient(parameters,
+      sparseGradient);
+  REQUIRE(sparseObjective == Approx(objective).epsilon(1e-10));
+  CheckMatrices(gradient, sparseGradient, 1e-8);
+
+  const double batchObjective = lrf.EvaluateWithGradient(parameters, 100,
+      gradient, 50);
+  const double sparseBatchObjective = sparseLrf.EvaluateWithGradient(
+      parameters, 100, sparseGradient, 50);
+  REQUIRE(sparseBatchObjective == Approx(batchObjective).epsilon(1e-10));
+  CheckMatrices(gradient, sparseGradient, 1e-8);
+
+  for (size_t j = 0; j < 21; j += 5)
+  {
+    arma::rowvec partial, sparsePartial;
+    lrf.PartialGradient(parameters, j, partial);
+    sparseLrf.PartialGradient(parameters, j, sparsePartial);
+    REQUIRE(sparsePartial[j] == Approx(partial[j]).epsilon(1e-8));
+  }
+}
+
+/**
+ * Make sure that a model trained on sparse data classifies sparse points, and
+ * computes the error and accuracy, like the same model on dense data.
+ */
+TEST_CASE("LogisticRegressionSparseClassifyTest", "[LogisticRegressionTest]")
+{
+  arma::sp_mat dataset;
+  dataset.sprandu(15, 500, 0.3);
+  arma::Row<size_t> labels(500);
+  for (size_t i = 0; i < 500; ++i)
+    labels[i] = (dataset(0, i) + dataset(1, i) > 0.0) ? 1 : 0;
+
+  LogisticRegression<arma::sp_mat> lrSparse(dataset, labels, 0.1);
+  LogisticRegression<> lr(15, 0.1);
+  lr.Parameters() = lrSparse.Parameters();
+
+  arma::sp_mat testSet;
+  testSet.sprandu(15, 200, 0.3);
+  arma::mat denseTestSet(testSet);
+
+  arma::Row<size_t> predictions, sparsePredictions;
+  arma::mat probabilities, sparseProbabilities;
+  lr.Classify(denseTestSet, predictions, probabilities);
+  lrSparse.Classify(testSet, sparsePredictions, sparseProbabilities);
+
+  CheckMatrices(predictions, sparsePredictions);
+  CheckMatrices(probabilities, sparseProbabilities, 1e-8);
+  for (size_t i = 0; i < 200; ++i)
+    REQUIRE(lrSparse.Classify(testSet.col(i)) == predictions[i]);
+
+  arma::Row<size_t> testLabels(200);
+  for (size_t i = 0; i < 200; ++i)
+    testLabels[i] = (testSet(0, i) + testSet(1, i) > 0.0) ? 1 : 0;
+  REQUIRE(lrSparse.ComputeAccuracy(testSet, testLabels) ==
+      Approx(lr.ComputeAccuracy(denseTestSet, testLabels)));
+  REQUIRE(lrSparse.ComputeError(testSet, testLabels) ==
+      Approx(lr.ComputeError(denseTestSet, testLabels)).epsilon(1e-8));
+  REQUIRE(lrSparse.ComputeAccuracy(dataset, labels) >= 85.0);
+}
+
+/**
+ * Make sure the sparse gradient used by ParallelSGD only holds the intercept
+ * and the features of the batch, and matches the dense gradient there.
+ */
+TEST_CASE("LogisticRegressionFunctionSparseGradientTest",
+          "[LogisticRegressionTest]")
+{
+  arma::sp_mat dataset;
+  dataset.sprandu(30, 200, 0.05);
+  arma::Row<size_t> labels(200);
+  for (size_t i = 0; i < 200; ++i)
+    labels[i] = RandInt(0, 2);
+
+  LogisticRegressionFunction<arma::sp_mat> lrf(dataset, labels, 0.5);
+  const arma::rowvec parameters = arma::randn<arma::rowvec>(31);
+
+  arma::rowvec gradient;
+  arma::sp_mat sparseGradient;
+  lrf.Gradient(parameters, 50, gradient, 3);
+  lrf.Gradient(parameters, 50, sparseGradient, 3);
+
+  REQUIRE(sparseGradient.n_rows == 1);
+  REQUIRE(sparseGradient.n_cols == 31);
+  REQUIRE(sparseGradient(0, 0) == Approx(gradient[0]).epsilon(1e-10));
+  const arma::mat batch(dataset.cols(50, 52));
+  for (size_t d = 0; d < 30; ++d)
+  {
+    if (arma::any(batch.row(d) != 0.0))
+    {
+      REQUIRE(sparseGradient(0, d + 1) ==
+          Approx(gradient[d + 1]).epsilon(1e-10));
+    }
+    else
+    {
+      REQUIRE(sparseGradient(0, d + 1) == 0.0);
+    }
+  }
+
+  // With dense data, the sparse gradient is the dense gradient.
+  const arma::Row<size_t> batchLabels = labels.subvec(50, 52);
+  LogisticRegressionFunction<> denseLrf(batch, batchLabels, 0.5);
+  denseLrf.Gradient(parameters, 0, gradient, 3);
+  denseLrf.Gradient(parameters, 0, sparseGradient, 3);
+  CheckMatrices(gradient, arma::mat(sparseGradient), 1e-10);
+}
+
+/**
+ * Train a model on sparse data with ParallelSGD (Hogwild!).
+ */
+TEST_CASE("LogisticRegressionSparseParallelSGDTest", "[LogisticRegressionTest]")
+{
+  arma::sp_mat dataset;
+  dataset.sprandu(15, 1000, 0.3);
+  arma::Row<size_t> labels(1000);
+  for (size_t i = 0; i < 1000; ++i)
+    labels[i] = (dataset(0, i) + dataset(1, i) > 0.0) ? 1 : 0;
+
+  ens::ParallelSGD<ens::ConstantStep> optimizer(200,
+      std::ceil((float) dataset.n_cols / omp_get_max_threads()), 1e-8, true,
+      ens::ConstantStep(0.5));
+
+  LogisticRegression<arma::sp_mat> lr(dataset.n_rows, 0.0);
+  lr.Train(dataset, labels, optimizer);
+
+  REQUIRE(lr.ComputeAccuracy(dataset, labels) >= 85.0);
+}
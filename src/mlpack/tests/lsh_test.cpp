@@ -989,3 +989,163 @@ TEST_CASE("SparseLSHTest", "[LSHTest]")
     REQUIRE(!std::isnan(sparseDistances[i]));
   }
 }
+
+/**
+ * Make sure that the compact second hash table holds the same buckets as the
+ * regular one, and that searches give the same results with both.
+ */
+TEST_CASE("LSHCompactStorageTest", "[LSHTest]")
+{
+  arma::mat rdata(2, 1000, arma::fill::randu);
+  arma::mat qdata(2, 100, arma::fill::randu);
+  const size_t k = 5;
+
+  // Use a small bucket size so that some buckets are truncated.
+  RandomSeed(42);
+  LSHSearch<> lsh(rdata, 4, 10, 0.0, 99901, 20);
+  RandomSeed(42);
+  LSHSearch<> compactLSH(rdata, 4, 10, 0.0, 99901, 20, true);
+
+  REQUIRE(!lsh.CompactStorage());
+  REQUIRE(compactLSH.CompactStorage());
+  REQUIRE(compactLSH.SecondHashTable().empty());
+  REQUIRE(compactLSH.BucketOffsets().n_elem ==
+      lsh.SecondHashTable().size() + 1);
+
+  // Each row must hold the same points in the same order.
+  for (size_t i = 0; i < lsh.SecondHashTable().size(); ++i)
+  {
+    const size_t begin = compactLSH.BucketOffsets()[i];
+    const size_t end = compactLSH.BucketOffsets()[i + 1];
+    const arma::Col<size_t>& row = lsh.SecondHashTable()[i];
+    REQUIRE(end - begin == row.n_elem);
+    for (size_t j = 0; j < row.n_elem; ++j)
+      REQUIRE((size_t) compactLSH.BucketPoints()[begin + j] == row[j]);
+  }
+
+  arma::Mat<size_t> neighbors, compactNeighbors;
+  arma::mat distances, compactDistances;
+  lsh.Search(qdata, k, neighbors, distances, 0, 3);
+  compactLSH.Search(qdata, k, compactNeighbors, compactDistances, 0, 3);
+  CheckMatrices(neighbors, compactNeighbors);
+  CheckMatrices(distances, compactDistances);
+
+  lsh.Search(k, neighbors, distances);
+  compactLSH.Search(k, compactNeighbors, compactDistances);
+  CheckMatrices(neighbors, compactNeighbors);
+  CheckMatrices(distances, compactDistances);
+
+  // Copies keep the compact format.
+  LSHSearch<> copy(compactLSH);
+  REQUIRE(copy.CompactStorage());
+  copy.Search(k, neighbors, distances);
+  CheckMatrices(neighbors, compactNeighbors);
+  CheckMatrices(distances, compactDistances);
+}
+
+/**
+ * Test that inserting points into a trained model gives the same results as
+ * training on all the points, and that removed points are never returned.
+ */
+TEST_CASE("LSHInsertRemoveTest", "[LSHTest]")
+{
+  arma::mat rdata(2, 1000, arma::fill::randu);
+  arma::mat qdata(2, 100, arma::fill::randu);
+  const size_t k = 5;
+  arma::cube projections(2, 4, 10, arma::fill::randn);
+
+  for (const bool compact : { false, true })
+  {
+    // With no limit on the bucket size, each bucket must end up with the same
+    // points.
+    RandomSeed(42);
+    LSHSearch<> lsh(rdata, projections, 0.3, 99901, 0, compact);
+    RandomSeed(42);
+    LSHSearch<> insertLSH(rdata.cols(0, 599), projections, 0.3, 99901, 0,
+        compact);
+    insertLSH.Insert(rdata.cols(600, 799));
+    insertLSH.Insert(rdata.cols(800, 999));
+
+    REQUIRE(insertLSH.ReferenceSet().n_cols == 1000);
+    CheckMatrices(insertLSH.ReferenceSet(), rdata);
+
+    arma::Mat<size_t> neighbors, insertNeighbors;
+    arma::mat distances, insertDistances;
+    lsh.Search(qdata, k, neighbors, distances, 0, 3);
+    insertLSH.Search(qdata, k, insertNeighbors, insertDistances, 0, 3);
+    CheckMatrices(neighbors, insertNeighbors);
+    CheckMatrices(distances, insertDistances);
+
+    lsh.Search(k, neighbors, distances);
+    insertLSH.Search(k, insertNeighbors, insertDistances);
+    CheckMatrices(neighbors, insertNeighbors);
+    CheckMatrices(distances, insertDistances);
+
+    lsh.Search(qdata, k, neighbors, distances, 0, 3);
+
+    // Remove every third point, and some of the points twice.
+    arma::uvec ids = arma::regspace<arma::uvec>(0, 3, 999);
+    insertLSH.Remove(ids);
+    insertLSH.Remove(ids.head(10));
+    REQUIRE(insertLSH.NumRemoved() == ids.n_elem);
+    REQUIRE(insertLSH.IsRemoved(0));
+    REQUIRE(!insertLSH.IsRemoved(1));
+
+    insertLSH.Search(qdata, k, insertNeighbors, insertDistances, 0, 3);
+    for (size_t i = 0; i < insertNeighbors.n_elem; ++i)
+    {
+      REQUIRE((insertNeighbors[i] == 1000 ||
+          !insertLSH.IsRemoved(insertNeighbors[i])));
+    }
+
+    // The neighbors that were not removed keep their order.
+    for (size_t i = 0; i < qdata.n_cols; ++i)
+    {
+      size_t next = 0;
+      for (size_t j = 0; j < k; ++j)
+      {
+        if (neighbors(j, i) % 3 == 0)
+          continue;
+        REQUIRE(insertNeighbors(next, i) == neighbors(j, i));
+        ++next;
+      }
+    }
+
+    REQUIRE_THROWS_AS(insertLSH.Search(qdata, 1000 - ids.n_elem + 1,
+        insertNeighbors, insertDistances), std::invalid_argument);
+    REQUIRE_THROWS_AS(insertLSH.Remove(arma::uvec({ 1000 })),
+        std::invalid_argument);
+    REQUIRE_THROWS_AS(insertLSH.Insert(arma::mat(3, 10, arma::fill::randu)),
+        std::invalid_argument);
+  }
+}
+
+/**
+ * Make sure that searching a query set that spans several blocks of projected
+ * queries gives the same results as searching each part of it separately.
+ */
+TEST_CASE("LSHQueryBlocksTest", "[LSHTest]")
+{
+  const size_t k = 3;
+  arma::mat rdata(4, 2000, arma::fill::randu);
+  arma::mat qdata(4, 5000, arma::fill::randu);
+
+  LSHSearch<> lsh(rdata, 8, 10, 0.5);
+
+  arma::Mat<size_t> neighbors, firstNeighbors, lastNeighbors;
+  arma::mat distances, firstDistances, lastDistances;
+  lsh.Search(qdata, k, neighbors, distances, 0, 2);
+  lsh.Search(qdata.cols(0, 2499), k, firstNeighbors, firstDistances, 0, 2);
+  lsh.Search(qdata.cols(2500, 4999), k, lastNeighbors, lastDistances, 0, 2);
+
+  CheckMatrices(neighbors, arma::Mat<size_t>(arma::join_rows(firstNeighbors,
+      lastNeighbors)));
+  CheckMatrices(distances, arma::mat(arma::join_rows(firstDistances,
+      lastDistances)));
+
+  // Searching fewer tables only uses the projections of these tables.
+  lsh.Search(qdata, k, neighbors, distances, 4);
+  lsh.Search(qdata.cols(0, 2499), k, firstNeighbors, firstDistances, 4);
+  CheckMatrices(arma::Mat<size_t>(neighbors.cols(0, 2499)), firstNeighbors);
+  CheckMatrices(arma::mat(distances.cols(0, 2499)), firstDistances);
+}
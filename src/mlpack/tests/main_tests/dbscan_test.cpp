@@ -314,6 +314,19 @@ TEST_CASE_METHOD(DBSCANTestFixture, "DBSCANDiffTreeTypeTest",
   arma::Row<size_t> ballOutput;
   ballOutput = std::move(params.Get<arma::Row<size_t>>("assignments"));
 
+  CleanMemory();
+  ResetSettings();
+
+  // Tree Type = grid (no tree at all).
+
+  SetInputParam("input", inputData);
+  SetInputParam("tree_type", std::string("grid"));
+
+  RUN_BINDING();
+
+  arma::Row<size_t> gridOutput;
+  gridOutput = std::move(params.Get<arma::Row<size_t>>("assignments"));
+
   CheckMatrices(kdOutput, rOutput);
   CheckMatrices(kdOutput, rStarOutput);
   CheckMatrices(kdOutput, xOutput);
@@ -322,6 +335,7 @@ TEST_CASE_METHOD(DBSCANTestFixture, "DBSCANDiffTreeTypeTest",
   CheckMatrices(kdOutput, rPlusPlusOutput);
   CheckMatrices(kdOutput, coverOutput);
   CheckMatrices(kdOutput, ballOutput);
+  CheckMatrices(kdOutput, gridOutput);
 }
 
 /**
@@ -0,0 +1,124 @@
+/**
+ * @file tests/main_tests/hnsw_test.cpp
+ *
+ * Test RUN_BINDING() of hnsw_main.cpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#define BINDING_TYPE BINDING_TYPE_TEST
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/hnsw/hnsw_main.cpp>
+#include <mlpack/core/util/mlpack_main.hpp>
+
+#include "main_test_fixture.hpp"
+
+#include "../catch.hpp"
+#include "../test_catch_tools.hpp"
+
+using namespace mlpack;
+
+BINDING_TEST_FIXTURE(HNSWTestFixture);
+
+/**
+ * Check that output neighbors and distances have valid dimensions.
+ */
+TEST_CASE_METHOD(HNSWTestFixture, "HNSWOutputDimensionTest",
+                 "[HNSWMainTest][BindingTests]")
+{
+  arma::mat reference = arma::randu<arma::mat>(5, 100);
+  arma::mat query = arma::randu<arma::mat>(5, 40);
+
+  SetInputParam("reference", std::move(reference));
+  SetInputParam("query", std::move(query));
+  SetInputParam("k", (int) 6);
+
+  RUN_BINDING();
+
+  REQUIRE(params.Get<arma::Mat<size_t>>("neighbors").n_rows == 6);
+  REQUIRE(params.Get<arma::Mat<size_t>>("neighbors").n_cols == 40);
+  REQUIRE(params.Get<arma::mat>("distances").n_rows == 6);
+  REQUIRE(params.Get<arma::mat>("distances").n_cols == 40);
+}
+
+/**
+ * Ensure that k, links, ef_construction and ef_search are checked.
+ */
+TEST_CASE_METHOD(HNSWTestFixture, "HNSWParamValidityTest",
+                 "[HNSWMainTest][BindingTests]")
+{
+  arma::mat reference = arma::randu<arma::mat>(5, 100);
+
+  SetInputParam("reference", reference);
+  SetInputParam("k", (int) 6);
+  SetInputParam("links", (int) 1);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("reference", reference);
+  SetInputParam("k", (int) 6);
+  SetInputParam("ef_construction", (int) 0);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("reference", reference);
+  SetInputParam("k", (int) 6);
+  SetInputParam("ef_search", (int) -1);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("reference", std::move(reference));
+  SetInputParam("k", (int) -2);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+}
+
+/**
+ * Make sure that a saved model gives the same results as the model it was
+ * saved from, and that only one of a model and a reference set can be given.
+ */
+TEST_CASE_METHOD(HNSWTestFixture, "HNSWModelReuseTest",
+                 "[HNSWMainTest][BindingTests]")
+{
+  arma::mat reference = arma::randu<arma::mat>(5, 200);
+  arma::mat query = arma::randu<arma::mat>(5, 30);
+
+  SetInputParam("reference", std::move(reference));
+  SetInputParam("query", query);
+  SetInputParam("k", (int) 4);
+
+  RUN_BINDING();
+
+  arma::Mat<size_t> neighbors = params.Get<arma::Mat<size_t>>("neighbors");
+  arma::mat distances = params.Get<arma::mat>("distances");
+  HNSWSearch<>* model = params.Get<HNSWSearch<>*>("output_model");
+  params.Get<HNSWSearch<>*>("output_model") = NULL;
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("input_model", model);
+  SetInputParam("query", std::move(query));
+  SetInputParam("k", (int) 4);
+
+  RUN_BINDING();
+
+  CheckMatrices(neighbors, params.Get<arma::Mat<size_t>>("neighbors"));
+  CheckMatrices(distances, params.Get<arma::mat>("distances"));
+
+  // Passing a reference set as well is an error.
+  SetInputParam("reference", arma::mat(arma::randu<arma::mat>(5, 50)));
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+}
@@ -722,3 +722,140 @@ TEST_CASE_METHOD(HoeffdingTreeTestFixture, "HoeffdingBinningTest",
   REQUIRE((params.Get<HoeffdingTreeModel*>("output_model"))->NumNodes()
       == 1);
 }
+
+/**
+ * Ensure that a negative maximum number of active leaves is rejected, and that
+ * a limit still gives a working model.
+ */
+TEST_CASE_METHOD(HoeffdingTreeTestFixture, "HoeffdingMaxActiveLeavesTest",
+                 "[HoeffdingTreeMainTest][BindingTest]")
+{
+  arma::mat inputData;
+  DatasetInfo info;
+  if (!data::Load("vc2.csv", inputData, info))
+    FAIL("Cannot load train dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  arma::mat testData;
+  if (!data::Load("vc2_test.csv", testData, info))
+    FAIL("Cannot load test dataset vc2.csv!");
+
+  SetInputParam("training", std::make_tuple(info, inputData));
+  SetInputParam("labels", labels);
+  SetInputParam("max_active_leaves", -1);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  // Reset passed parameters.
+  ResetSettings();
+  CleanMemory();
+
+  SetInputParam("training", std::make_tuple(info, inputData));
+  SetInputParam("labels", std::move(labels));
+  SetInputParam("test", std::make_tuple(info, testData));
+  SetInputParam("max_active_leaves", 2);
+  SetInputParam("min_samples", 10);
+  SetInputParam("confidence", 0.25);
+
+  RUN_BINDING();
+
+  REQUIRE(params.Get<arma::Row<size_t>>("predictions").n_cols ==
+      testData.n_cols);
+}
+
+/**
+ * Make sure that streaming the training set from a file in chunks gives the
+ * same tree as training on the whole training set at once.
+ */
+TEST_CASE_METHOD(HoeffdingTreeTestFixture, "HoeffdingTrainingFileTest",
+                 "[HoeffdingTreeMainTest][BindingTest]")
+{
+  // Write the points of vc2.csv with their labels, ordered so that each class
+  // appears in the first chunk.
+  std::vector<std::string> lines, labelLines;
+  std::string line;
+  std::ifstream dataFile("vc2.csv"), labelsFile("vc2_labels.txt");
+  while (std::getline(dataFile, line))
+    lines.push_back(line);
+  while (std::getline(labelsFile, line))
+    labelLines.push_back(line);
+  REQUIRE(lines.size() == labelLines.size());
+
+  std::vector<std::vector<size_t>> classPoints;
+  for (size_t i = 0; i < labelLines.size(); ++i)
+  {
+    const size_t label = std::stoul(labelLines[i]);
+    if (label >= classPoints.size())
+      classPoints.resize(label + 1);
+    classPoints[label].push_back(i);
+  }
+
+  std::vector<size_t> order;
+  for (size_t r = 0; order.size() < lines.size(); ++r)
+    for (size_t c = 0; c < classPoints.size(); ++c)
+      if (r < classPoints[c].size())
+        order.push_back(classPoints[c][r]);
+
+  std::ofstream streamFile("hoeffding_stream.csv");
+  for (size_t i = 0; i < order.size(); ++i)
+    streamFile << lines[order[i]] << "," << labelLines[order[i]] << std::endl;
+  streamFile.close();
+
+  arma::mat inputData;
+  DatasetInfo info;
+  if (!data::Load("hoeffding_stream.csv", inputData, info))
+    FAIL("Cannot load train dataset hoeffding_stream.csv!");
+
+  arma::mat testData;
+  if (!data::Load("vc2_test.csv", testData))
+    FAIL("Cannot load test dataset vc2_test.csv!");
+
+  SetInputParam("training", std::make_tuple(info, inputData));
+  SetInputParam("test", std::make_tuple(info, testData));
+  SetInputParam("min_samples", 10);
+
+  RUN_BINDING();
+
+  const arma::Row<size_t> predictions =
+      params.Get<arma::Row<size_t>>("predictions");
+  const size_t numNodes =
+      params.Get<HoeffdingTreeModel*>("output_model")->NumNodes();
+
+  // Reset passed parameters.
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("training_file", std::string("hoeffding_stream.csv"));
+  SetInputParam("chunk_size", 50);
+  SetInputParam("test", std::make_tuple(info, testData));
+  SetInputParam("min_samples", 10);
+
+  RUN_BINDING();
+
+  REQUIRE(params.Get<HoeffdingTreeModel*>("output_model")->NumNodes() ==
+      numNodes);
+  CheckMatrices(params.Get<arma::Row<size_t>>("predictions"), predictions);
+
+  // The training set and the training file cannot both be given, and the
+  // chunk size must be positive.
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("training_file", std::string("hoeffding_stream.csv"));
+  SetInputParam("training", std::make_tuple(info, inputData));
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("training_file", std::string("hoeffding_stream.csv"));
+  SetInputParam("chunk_size", 0);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  remove("hoeffding_stream.csv");
+}
@@ -165,4 +165,21 @@ TEST_CASE_METHOD(ImageConverterTestFixture, "EmptyInputTest",
   REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
 }
 
+/**
+ * Test that images are resized when the size is given while loading.
+ */
+TEST_CASE_METHOD(ImageConverterTestFixture, "LoadResizeImageTest",
+                 "[ImageConverterMainTest][BindingTests]")
+{
+  SetInputParam<vector<string>>("input", {"test_image.png", "test_image.png"});
+  SetInputParam("height", 20);
+  SetInputParam("width", 25);
+  SetInputParam("channels", 1);
+
+  RUN_BINDING();
+  arma::mat output = params.Get<arma::mat>("output");
+  REQUIRE(output.n_rows == 25 * 20 * 1);
+  REQUIRE(output.n_cols == 2);
+}
+
 #endif // MLPACK_HAS_STB.
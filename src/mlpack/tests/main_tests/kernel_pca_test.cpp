@@ -31,7 +31,7 @@ TEST_CASE_METHOD(KernelPCATestFixture, "KernelPCADimensionTest",
 {
   std::string kernels[] = {
       "linear", "gaussian", "polynomial",
-      "hyptan", "laplacian", "epanechnikov", "cosine"
+      "hyptan", "laplacian", "epanechnikov", "cosine", "cauchy"
   };
 
   for (std::string& kernel : kernels)
@@ -333,3 +333,50 @@ TEST_CASE_METHOD(KernelPCATestFixture, "KernelPCASamplingSchemeTest",
   REQUIRE(arma::any(vectorise(output2 != output3)));
   REQUIRE(arma::any(vectorise(output1 != output3)));
 }
+
+/**
+ * Make sure that random Fourier features give the requested dimensionality for
+ * the shift-invariant kernels, and that they cannot be used with other kernels
+ * or with the Nystroem method.
+ */
+TEST_CASE_METHOD(KernelPCATestFixture, "KernelPCARandomFourierFeaturesTest",
+                 "[KernelPCAMainTest][BindingTests]")
+{
+  std::string kernels[] = { "gaussian", "laplacian", "cauchy" };
+
+  for (std::string& kernel : kernels)
+  {
+    CleanMemory();
+    ResetSettings();
+
+    SetInputParam("input", arma::mat(arma::randu<arma::mat>(5, 100)));
+    SetInputParam("new_dimensionality", (int) 3);
+    SetInputParam("kernel", kernel);
+    SetInputParam("random_fourier_features", true);
+    SetInputParam("num_features", (int) 50);
+
+    RUN_BINDING();
+
+    REQUIRE(params.Get<arma::mat>("output").n_rows == 3);
+    REQUIRE(params.Get<arma::mat>("output").n_cols == 100);
+  }
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("input", arma::mat(arma::randu<arma::mat>(5, 100)));
+  SetInputParam("kernel", (std::string) "polynomial");
+  SetInputParam("random_fourier_features", true);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("input", arma::mat(arma::randu<arma::mat>(5, 100)));
+  SetInputParam("kernel", (std::string) "gaussian");
+  SetInputParam("random_fourier_features", true);
+  SetInputParam("nystroem_method", true);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+}
@@ -375,3 +375,75 @@ TEST_CASE_METHOD(KmTestFixture, "AlgorithmsSimilarTest",
   CheckMatrices(naiveCentroid, dualTreeCentroid);
   CheckMatrices(naiveCentroid, dualCoverTreeCentroid);
 }
+
+/**
+ * Checking that holding the dataset in single precision or as a sparse matrix
+ * gives the same results as a dense double-precision matrix.
+ */
+TEST_CASE_METHOD(KmTestFixture, "MatrixTypesSimilarTest",
+                 "[KmeansMainTest][BindingTests]")
+{
+  int c = 5;
+  // Use values that can be represented exactly in single precision.
+  arma::mat inputData = arma::round(1024 * arma::randu<arma::mat>(10, 1000)) /
+      1024;
+  arma::mat initCentroid = arma::randu<arma::mat>(inputData.n_rows, c);
+
+  const std::string matrixTypes[] = { "dense", "float", "sparse" };
+  const std::string algorithms[] = { "naive", "hamerly" };
+  arma::mat denseOutput, denseCentroid;
+  for (const std::string& algorithm : algorithms)
+  {
+    for (const std::string& matrixType : matrixTypes)
+    {
+      SetInputParam("input", inputData);
+      SetInputParam("clusters", c);
+      SetInputParam("algorithm", std::string(algorithm));
+      SetInputParam("matrix_type", std::string(matrixType));
+      SetInputParam("labels_only", true);
+      SetInputParam("initial_centroids", initCentroid);
+
+      RUN_BINDING();
+
+      arma::mat output = std::move(params.Get<arma::mat>("output"));
+      arma::mat centroid = std::move(params.Get<arma::mat>("centroid"));
+      if (algorithm == "naive" && matrixType == "dense")
+      {
+        denseOutput = std::move(output);
+        denseCentroid = std::move(centroid);
+      }
+      else
+      {
+        CheckMatrices(denseOutput, output);
+        CheckMatrices(denseCentroid, centroid);
+      }
+
+      CleanMemory();
+      ResetSettings();
+    }
+  }
+}
+
+/**
+ * Checking that algorithms that need a dense double-precision dataset are
+ * rejected for other matrix types.
+ */
+TEST_CASE_METHOD(KmTestFixture, "MatrixTypeAlgorithmTest",
+                 "[KmeansMainTest][BindingTests]")
+{
+  SetInputParam("input", arma::randu<arma::mat>(5, 100));
+  SetInputParam("clusters", 3);
+  SetInputParam("algorithm", std::string("elkan"));
+  SetInputParam("matrix_type", std::string("float"));
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("input", arma::randu<arma::mat>(5, 100));
+  SetInputParam("clusters", 3);
+  SetInputParam("matrix_type", std::string("double"));
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+}
@@ -647,3 +647,171 @@ TEST_CASE_METHOD(KNNTestFixture, "KNNDifferentLeafSizes",
   REQUIRE(params.Get<KNNModel*>("output_model")->LeafSize() == (int) 10);
   delete output_model;
 }
+
+/*
+ * Ensure that auto-tuning gives exact results, and that the configuration it
+ * chooses is kept when the output model is given as input.
+ */
+TEST_CASE_METHOD(KNNTestFixture, "KNNAutoTuneTest",
+                 "[KNNMainTest][BindingTests]")
+{
+  arma::mat referenceData;
+  referenceData.randu(3, 500); // 500 points in 3 dimensions.
+  arma::mat queryData;
+  queryData.randu(3, 90); // 90 points in 3 dimensions.
+
+  // Get a baseline with naive search.
+  KNN knn(referenceData, NAIVE_MODE);
+  arma::Mat<size_t> baselineNeighbors;
+  arma::mat baselineDistances;
+  knn.Search(queryData, 5, baselineNeighbors, baselineDistances);
+
+  SetInputParam("reference", std::move(referenceData));
+  SetInputParam("query", queryData);
+  SetInputParam("k", (int) 5);
+  SetInputParam("auto_tune", true);
+
+  RUN_BINDING();
+
+  CheckMatrices(baselineNeighbors,
+      params.Get<arma::Mat<size_t>>("neighbors"));
+  CheckMatrices(baselineDistances, params.Get<arma::mat>("distances"));
+
+  KNNModel* output_model = params.Get<KNNModel*>("output_model");
+  REQUIRE(output_model->AutoTuned());
+  const NeighborSearchMode searchMode = output_model->SearchMode();
+
+  // Reset passed parameters.
+  params.Get<KNNModel*>("output_model") = NULL;
+  CleanMemory();
+  ResetSettings();
+
+  // The loaded model keeps the chosen search mode.
+  SetInputParam("input_model", output_model);
+  SetInputParam("query", queryData);
+  SetInputParam("k", (int) 5);
+
+  RUN_BINDING();
+
+  REQUIRE(params.Get<KNNModel*>("output_model")->SearchMode() == searchMode);
+  CheckMatrices(baselineNeighbors,
+      params.Get<arma::Mat<size_t>>("neighbors"));
+  CheckMatrices(baselineDistances, params.Get<arma::mat>("distances"));
+}
+
+/**
+ * Searching two shards of the reference set, and merging the results of the
+ * first into the second, gives the neighbors in the full reference set.
+ */
+TEST_CASE_METHOD(KNNTestFixture, "KNNShardedReferenceTest",
+                 "[KNNMainTest][BindingTests]")
+{
+  arma::mat referenceData;
+  referenceData.randu(3, 500); // 500 points in 3 dimensions.
+  arma::mat queryData;
+  queryData.randu(3, 90); // 90 points in 3 dimensions.
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> baselineNeighbors;
+  arma::mat baselineDistances;
+  knn.Search(queryData, 5, baselineNeighbors, baselineDistances);
+
+  SetInputParam("reference", arma::mat(referenceData.cols(0, 199)));
+  SetInputParam("query", queryData);
+  SetInputParam("k", (int) 5);
+
+  RUN_BINDING();
+
+  arma::Mat<size_t> shardNeighbors =
+      params.Get<arma::Mat<size_t>>("neighbors");
+  arma::mat shardDistances = params.Get<arma::mat>("distances");
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("reference", arma::mat(referenceData.cols(200, 499)));
+  SetInputParam("query", queryData);
+  SetInputParam("k", (int) 5);
+  SetInputParam("reference_offset", (int) 200);
+  SetInputParam("input_neighbors", std::move(shardNeighbors));
+  SetInputParam("input_distances", std::move(shardDistances));
+
+  RUN_BINDING();
+
+  CheckMatrices(baselineNeighbors,
+      params.Get<arma::Mat<size_t>>("neighbors"));
+  CheckMatrices(baselineDistances, params.Get<arma::mat>("distances"));
+}
+
+/**
+ * Write the given sparse matrix to a coordinate list file, with one line
+ * 'point dimension value' for each nonzero element.
+ */
+void SaveCoordinateList(const std::string& filename, const arma::sp_mat& data)
+{
+  std::fstream f(filename, std::fstream::out);
+  for (arma::sp_mat::const_iterator it = data.begin(); it != data.end(); ++it)
+    f << it.col() << " " << it.row() << " " << (*it) << std::endl;
+}
+
+/**
+ * A sparse reference set is searched with the cosine distance, with or without
+ * a sparse query set.
+ */
+TEST_CASE_METHOD(KNNTestFixture, "KNNSparseCosineTest",
+                 "[KNNMainTest][BindingTests]")
+{
+  arma::sp_mat referenceData = arma::sprandu<arma::sp_mat>(30, 200, 0.1);
+  arma::sp_mat queryData = arma::sprandu<arma::sp_mat>(20, 40, 0.1);
+  // Make sure the last point and the last dimension are not empty, so that
+  // the files give matrices of the same size.
+  referenceData(29, 199) = 0.5;
+  queryData(19, 39) = 0.5;
+  SaveCoordinateList("knn_sparse_reference.txt", referenceData);
+  SaveCoordinateList("knn_sparse_query.txt", queryData);
+
+  // The query set has fewer dimensions, which are empty.
+  queryData.resize(30, 40);
+  SparseCosineSearch<> search(referenceData);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  search.Search(queryData, 5, neighbors, distances);
+
+  SetInputParam("sparse_reference_file",
+      std::string("knn_sparse_reference.txt"));
+  SetInputParam("sparse_query_file", std::string("knn_sparse_query.txt"));
+  SetInputParam("k", (int) 5);
+
+  RUN_BINDING();
+
+  CheckMatrices(neighbors, params.Get<arma::Mat<size_t>>("neighbors"));
+  CheckMatrices(distances, params.Get<arma::mat>("distances"), 1e-5);
+
+  CleanMemory();
+  ResetSettings();
+
+  search.Search(5, neighbors, distances);
+
+  SetInputParam("sparse_reference_file",
+      std::string("knn_sparse_reference.txt"));
+  SetInputParam("k", (int) 5);
+
+  RUN_BINDING();
+
+  CheckMatrices(neighbors, params.Get<arma::Mat<size_t>>("neighbors"));
+  CheckMatrices(distances, params.Get<arma::mat>("distances"), 1e-5);
+
+  // A sparse reference set cannot be given with a dense one.
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("sparse_reference_file",
+      std::string("knn_sparse_reference.txt"));
+  SetInputParam("reference", arma::mat(arma::randu<arma::mat>(30, 10)));
+  SetInputParam("k", (int) 5);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  remove("knn_sparse_reference.txt");
+  remove("knn_sparse_query.txt");
+}
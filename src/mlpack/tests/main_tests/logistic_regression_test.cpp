@@ -649,3 +649,124 @@ TEST_CASE_METHOD(LogisticRegressionTestFixture, "LRPrintTrainingAccuracyTest",
   // Run the binding with print_training_accuracy set to true.
   REQUIRE_NOTHROW(RUN_BINDING());
 }
+
+// Write the given sparse matrix to a coordinate list file, with one line for
+// each nonzero value: the point, the dimension, and the value.
+void SaveCoordinateList(const arma::sp_mat& data,
+                               const std::string& filename)
+{
+  std::ofstream stream(filename);
+  stream.precision(17);
+  for (arma::sp_mat::const_iterator it = data.begin(); it != data.end(); ++it)
+    stream << it.col() << " " << it.row() << " " << (*it) << std::endl;
+}
+
+/**
+ * Make sure that training and predicting on sparse files gives the same model
+ * and predictions as on the same dense data.
+ */
+TEST_CASE_METHOD(LogisticRegressionTestFixture, "LRSparseTrainingTest",
+                 "[LogisticRegressionMainTest][BindingTests]")
+{
+  arma::sp_mat trainX, testX;
+  trainX.sprandu(20, 200, 0.2);
+  testX.sprandu(20, 50, 0.2);
+  // Make sure the last dimension and the last point are not empty, so the size
+  // of the matrix of each coordinate list is known.
+  trainX(19, 0) = 0.5;
+  trainX(2, 199) = 0.5;
+  testX(19, 0) = 0.5;
+  testX(2, 49) = 0.5;
+  arma::Row<size_t> trainY(200);
+  for (size_t i = 0; i < 200; ++i)
+    trainY[i] = (trainX(0, i) + trainX(1, i) > 0.0) ? 1 : 0;
+
+  SaveCoordinateList(trainX, "lr_sparse_train.txt");
+  SaveCoordinateList(testX, "lr_sparse_test.txt");
+
+  SetInputParam("sparse_training", std::string("lr_sparse_train.txt"));
+  SetInputParam("labels", trainY);
+  SetInputParam("sparse_test", std::string("lr_sparse_test.txt"));
+
+  RUN_BINDING();
+
+  const arma::rowvec sparseParameters =
+      params.Get<LogisticRegression<>*>("output_model")->Parameters();
+  const arma::Row<size_t> sparsePredictions =
+      params.Get<arma::Row<size_t>>("predictions");
+  const arma::mat sparseProbabilities = params.Get<arma::mat>("probabilities");
+  REQUIRE(sparseParameters.n_elem == 21);
+  REQUIRE(sparseProbabilities.n_cols == 50);
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("training", arma::mat(trainX));
+  SetInputParam("labels", trainY);
+  SetInputParam("test", arma::mat(testX));
+
+  RUN_BINDING();
+
+  CheckMatrices(params.Get<LogisticRegression<>*>("output_model")->Parameters(),
+      sparseParameters, 1e-5);
+  CheckMatrices(params.Get<arma::Row<size_t>>("predictions"),
+      sparsePredictions);
+  CheckMatrices(params.Get<arma::mat>("probabilities"), sparseProbabilities,
+      1e-5);
+
+  // A sparse training set without labels, or both a dense and a sparse
+  // training set, are errors.
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("sparse_training", std::string("lr_sparse_train.txt"));
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("sparse_training", std::string("lr_sparse_train.txt"));
+  SetInputParam("training", arma::mat(trainX));
+  SetInputParam("labels", trainY);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  remove("lr_sparse_train.txt");
+  remove("lr_sparse_test.txt");
+}
+
+/**
+ * Make sure that a model can be trained on sparse data with parallel SGD.
+ */
+TEST_CASE_METHOD(LogisticRegressionTestFixture, "LRParallelSGDTest",
+                 "[LogisticRegressionMainTest][BindingTests]")
+{
+  arma::sp_mat trainX;
+  trainX.sprandu(20, 500, 0.3);
+  // Make sure the last dimension and the last point are not empty, so the size
+  // of the matrix of the coordinate list is known.
+  trainX(19, 0) = 0.5;
+  trainX(2, 499) = 0.5;
+  arma::Row<size_t> trainY(500);
+  for (size_t i = 0; i < 500; ++i)
+    trainY[i] = (trainX(0, i) + trainX(1, i) > 0.0) ? 1 : 0;
+
+  SaveCoordinateList(trainX, "lr_psgd_train.txt");
+
+  SetInputParam("sparse_training", std::string("lr_psgd_train.txt"));
+  SetInputParam("labels", trainY);
+  SetInputParam("sparse_test", std::string("lr_psgd_train.txt"));
+  SetInputParam("optimizer", std::string("psgd"));
+  SetInputParam("step_size", 0.5);
+  SetInputParam("max_iterations", 100000);
+
+  RUN_BINDING();
+
+  const arma::Row<size_t>& predictions =
+      params.Get<arma::Row<size_t>>("predictions");
+  REQUIRE(predictions.n_elem == 500);
+  REQUIRE(arma::accu(predictions == trainY) >= 425);
+
+  remove("lr_psgd_train.txt");
+}
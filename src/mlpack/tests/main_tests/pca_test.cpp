@@ -96,3 +96,50 @@ TEST_CASE_METHOD(PCATestFixture, "PCATooHighNewDimensionalityTest",
 
   REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
 }
+
+/**
+ * Make sure that the incremental method gives the same variance as the exact
+ * method, when all the dimensions are kept.
+ */
+TEST_CASE_METHOD(PCATestFixture, "PCAIncrementalTest",
+                 "[PCAMainTest][BindingTests]")
+{
+  arma::mat x = arma::randu<arma::mat>(5, 50);
+  arma::mat exact = x;
+  arma::vec eigVal;
+  PCA<> pca;
+  pca.Apply(exact, exact, eigVal);
+
+  SetInputParam("input", std::move(x));
+  SetInputParam("decomposition_method", std::string("incremental"));
+  SetInputParam("batch_size", (int) 7);
+
+  RUN_BINDING();
+
+  const arma::mat& output = params.Get<arma::mat>("output");
+  REQUIRE(output.n_rows == 5);
+  REQUIRE(output.n_cols == 50);
+
+  // The components are only defined up to their sign.
+  for (size_t i = 0; i < output.n_rows; ++i)
+  {
+    const double diff = std::min(arma::norm(output.row(i) - exact.row(i)),
+        arma::norm(output.row(i) + exact.row(i)));
+    REQUIRE(diff == Approx(0.0).margin(1e-6));
+  }
+}
+
+/**
+ * Check that the incremental method cannot be used with scaling.
+ */
+TEST_CASE_METHOD(PCATestFixture, "PCAIncrementalScaleTest",
+                 "[PCAMainTest][BindingTests]")
+{
+  arma::mat x = arma::randu<arma::mat>(5, 5);
+
+  SetInputParam("input", std::move(x));
+  SetInputParam("decomposition_method", std::string("incremental"));
+  SetInputParam("scale", true);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+}
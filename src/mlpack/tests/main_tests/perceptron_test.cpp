@@ -383,3 +383,40 @@ TEST_CASE_METHOD(PerceptronTestFixture, "PerceptronWrongDimOfTestData2",
   // Wrong dimensionality of test data. It should give runtime error.
   REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
 }
+
+/**
+ * Make sure that a mini-batch perceptron is trained, and that the batch size
+ * must be positive.
+ */
+TEST_CASE_METHOD(PerceptronTestFixture, "PerceptronBatchSizeTest",
+                 "[PerceptronMainTest][BindingTests]")
+{
+  arma::mat trainX = arma::randu<arma::mat>(3, 100);
+  arma::Row<size_t> trainY(100);
+  for (size_t i = 0; i < 100; ++i)
+  {
+    trainY[i] = i % 2;
+    trainX(0, i) += 2.0 * trainY[i];
+  }
+
+  SetInputParam("training", trainX);
+  SetInputParam("labels", trainY);
+  SetInputParam("batch_size", 0);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("training", trainX);
+  SetInputParam("labels", trainY);
+  SetInputParam("batch_size", 10);
+  SetInputParam("test", trainX);
+
+  RUN_BINDING();
+
+  REQUIRE(params.Get<PerceptronModel*>("output_model")->P().BatchSize() == 10);
+  const arma::Row<size_t>& predictions =
+      params.Get<arma::Row<size_t>>("predictions");
+  REQUIRE(arma::accu(predictions == trainY) == 100);
+}
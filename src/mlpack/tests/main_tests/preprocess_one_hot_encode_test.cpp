@@ -430,3 +430,34 @@ TEST_CASE_METHOD(
   REQUIRE(output(8, 3) == 1);
   REQUIRE(output(8, 4) == 1);
 }
+
+/**
+ * Make sure the sparse output is the same as the dense output.
+ */
+TEST_CASE_METHOD(
+    PreprocessOneHotEncodingTestFixture, "PreprocessOneHotEncodingSparseTest",
+    "[PreprocessOneHotEncodingMainTest][BindingTests]")
+{
+  arma::mat dataset;
+  dataset = "1 1 -1 -1 -1 -1 1 1;"
+            "-1 1 -1 -1 -1 -1 1 -1;"
+            "1 1 -1 -1 -1 -1 1 1;"
+            "-1 1 -1 -1 -1 -1 1 -1;"
+            "1 1 -1 -1 -1 -1 1 1;";
+
+  data::DatasetInfo di(dataset.n_rows);
+  SetInputParam("input", std::make_tuple(di, dataset));
+  SetInputParam<vector<int>>("dimensions", {1, 3});
+  SetInputParam("sparse_output", std::string("ohe_sparse_output.txt"));
+  RUN_BINDING();
+
+  arma::sp_mat sparseOutput;
+  if (!data::Load("ohe_sparse_output.txt", sparseOutput, true))
+    FAIL("Cannot load sparse output ohe_sparse_output.txt");
+  remove("ohe_sparse_output.txt");
+
+  const arma::mat& output = params.Get<arma::mat>("output");
+  REQUIRE(sparseOutput.n_rows == output.n_rows);
+  REQUIRE(sparseOutput.n_cols == output.n_cols);
+  CheckMatrices(arma::mat(sparseOutput), output);
+}
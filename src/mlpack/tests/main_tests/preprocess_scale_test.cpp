@@ -350,3 +350,34 @@ TEST_CASE_METHOD(PreprocessScaleTestFixture, "MeanNormalizationBindingTest",
   SetInputParam("inverse_scaling", true);
   REQUIRE_NOTHROW(RUN_BINDING());
 }
+
+/**
+ * Check that a model fitted in two parts with partial_fit is the same as one
+ * fitted on the whole dataset.
+ */
+TEST_CASE_METHOD(PreprocessScaleTestFixture, "PartialFitTest",
+                 "[PreprocessScaleMainTest][BindingTests]")
+{
+  SetInputParam("input", scaleMainDataset);
+  SetInputParam("scaler_method", std::string("standard_scaler"));
+
+  RUN_BINDING();
+  arma::mat scaled = params.Get<arma::mat>("output");
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("input", arma::mat(scaleMainDataset.cols(0, 1)));
+  SetInputParam("scaler_method", std::string("standard_scaler"));
+
+  RUN_BINDING();
+
+  SetInputParam("input", arma::mat(scaleMainDataset.cols(2, 3)));
+  SetInputParam("input_model",
+                params.Get<ScalingModel*>("output_model"));
+  SetInputParam("partial_fit", true);
+
+  RUN_BINDING();
+  arma::mat output = params.Get<arma::mat>("output");
+  CheckMatrices(arma::mat(scaled.cols(2, 3)), output);
+}
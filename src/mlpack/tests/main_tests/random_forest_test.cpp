@@ -505,3 +505,151 @@ TEST_CASE_METHOD(RandomForestTestFixture, "RandomForestWarmStart",
 
   REQUIRE(oldNumTrees + 10 == newNumTrees);
 }
+
+/**
+ * Make sure that replace_trees removes the oldest trees of the input model
+ * after a warm start, and that too many trees can't be replaced.
+ */
+TEST_CASE_METHOD(RandomForestTestFixture, "RandomForestReplaceTreesTest",
+                 "[RandomForestMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load train dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  SetInputParam("training", inputData);
+  SetInputParam("labels", labels);
+  SetInputParam("num_trees", (int) 8);
+
+  RUN_BINDING();
+
+  RandomForestModel* model = params.Get<RandomForestModel*>("output_model");
+  params.Get<RandomForestModel*>("output_model") = NULL;
+  CleanMemory();
+  ResetSettings();
+
+  // Refresh the model with its last labels only: the classes of the model are
+  // kept.
+  const arma::uvec lastClass = arma::find(labels == 2);
+  SetInputParam("training", arma::mat(inputData.cols(lastClass)));
+  SetInputParam("labels", arma::Row<size_t>(labels.cols(lastClass)));
+  SetInputParam("num_trees", (int) 3);
+  SetInputParam("warm_start", true);
+  SetInputParam("replace_trees", (int) 3);
+  SetInputParam("input_model", model);
+
+  RUN_BINDING();
+
+  RandomForestModel* outputModel =
+      params.Get<RandomForestModel*>("output_model");
+  REQUIRE(outputModel->rf.NumTrees() == 8);
+  for (size_t i = 0; i < outputModel->rf.NumTrees(); ++i)
+    REQUIRE(outputModel->rf.Tree(i).NumClasses() == 3);
+
+  // The input model has 8 trees only.
+  SetInputParam("training", std::move(inputData));
+  SetInputParam("labels", std::move(labels));
+  SetInputParam("replace_trees", (int) 9);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+}
+
+/**
+ * Make sure that forests trained in two runs with the same seed and consecutive
+ * tree indices merge into the forest of a single run with all the trees.
+ */
+TEST_CASE_METHOD(RandomForestTestFixture, "RandomForestMergeModelTest",
+                 "[RandomForestMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load train dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  arma::mat testData;
+  if (!data::Load("vc2_test.csv", testData))
+    FAIL("Cannot load test dataset vc2_test.csv!");
+
+  // Train all the trees in one run.
+  SetInputParam("training", inputData);
+  SetInputParam("labels", labels);
+  SetInputParam("num_trees", (int) 6);
+  SetInputParam("seed", (int) 7);
+  SetInputParam("test", testData);
+
+  RUN_BINDING();
+
+  const arma::mat probabilities = params.Get<arma::mat>("probabilities");
+
+  CleanMemory();
+  ResetSettings();
+
+  // Train the last trees.
+  SetInputParam("training", inputData);
+  SetInputParam("labels", labels);
+  SetInputParam("num_trees", (int) 2);
+  SetInputParam("seed", (int) 7);
+  SetInputParam("first_tree", (int) 4);
+
+  RUN_BINDING();
+
+  RandomForestModel* lastModel =
+      params.Get<RandomForestModel*>("output_model");
+  params.Get<RandomForestModel*>("output_model") = NULL;
+  CleanMemory();
+  ResetSettings();
+
+  // Train the first trees, and merge the last ones.
+  SetInputParam("training", std::move(inputData));
+  SetInputParam("labels", std::move(labels));
+  SetInputParam("num_trees", (int) 4);
+  SetInputParam("seed", (int) 7);
+  SetInputParam("merge_model", lastModel);
+  SetInputParam("test", std::move(testData));
+
+  RUN_BINDING();
+
+  REQUIRE(params.Get<RandomForestModel*>("output_model")->rf.NumTrees() == 6);
+  CheckMatrices(probabilities, params.Get<arma::mat>("probabilities"));
+}
+
+/**
+ * Make sure that the forest can be exported as a C++ header.
+ */
+TEST_CASE_METHOD(RandomForestTestFixture, "RandomForestExportCppTest",
+                 "[RandomForestMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load train dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  SetInputParam("training", std::move(inputData));
+  SetInputParam("labels", std::move(labels));
+  SetInputParam("num_trees", (int) 3);
+  SetInputParam("export_cpp", std::string("random_forest_export.hpp"));
+
+  RUN_BINDING();
+
+  std::ifstream stream("random_forest_export.hpp");
+  REQUIRE(stream.is_open());
+  std::stringstream code;
+  code << stream.rdbuf();
+  stream.close();
+
+  REQUIRE(code.str().find("inline std::size_t Tree2(const double* point)") !=
+      std::string::npos);
+  REQUIRE(code.str().find("inline std::size_t Predict(") != std::string::npos);
+
+  remove("random_forest_export.hpp");
+}
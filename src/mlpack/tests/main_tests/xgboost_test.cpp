@@ -0,0 +1,141 @@
+/**
+ * @file tests/main_tests/xgboost_test.cpp
+ *
+ * Test RUN_BINDING() of xgboost_main.cpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#define BINDING_TYPE BINDING_TYPE_TEST
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/xgboost/xgboost_main.cpp>
+#include <mlpack/core/util/mlpack_main.hpp>
+
+#include "main_test_fixture.hpp"
+
+#include "../catch.hpp"
+#include "../test_catch_tools.hpp"
+
+using namespace mlpack;
+
+BINDING_TEST_FIXTURE(XGBoostTestFixture);
+
+/**
+ * Check that the softmax loss gives a prediction and a probability for each
+ * class for every test point.
+ */
+TEST_CASE_METHOD(XGBoostTestFixture, "XGBoostOutputDimensionTest",
+                 "[XGBoostMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load train dataset vc2.csv!");
+
+  arma::rowvec labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  arma::mat testData;
+  if (!data::Load("vc2_test.csv", testData))
+    FAIL("Cannot load test dataset vc2.csv!");
+
+  const size_t testSize = testData.n_cols;
+
+  SetInputParam("training", std::move(inputData));
+  SetInputParam("responses", std::move(labels));
+  SetInputParam("test", std::move(testData));
+  SetInputParam("loss", std::string("softmax"));
+  SetInputParam("num_rounds", 10);
+
+  RUN_BINDING();
+
+  REQUIRE(params.Get<arma::rowvec>("predictions").n_cols == testSize);
+  REQUIRE(params.Get<arma::mat>("probabilities").n_cols == testSize);
+  REQUIRE(params.Get<arma::mat>("probabilities").n_rows == 3);
+}
+
+/**
+ * Ensure that a saved model gives the same predictions when it is reused.
+ */
+TEST_CASE_METHOD(XGBoostTestFixture, "XGBoostModelReuseTest",
+                 "[XGBoostMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load train dataset vc2.csv!");
+
+  arma::rowvec labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  arma::mat testData;
+  if (!data::Load("vc2_test.csv", testData))
+    FAIL("Cannot load test dataset vc2.csv!");
+
+  SetInputParam("training", std::move(inputData));
+  SetInputParam("responses", std::move(labels));
+  SetInputParam("test", testData);
+  SetInputParam("num_rounds", 10);
+
+  RUN_BINDING();
+
+  const arma::rowvec predictions = params.Get<arma::rowvec>("predictions");
+
+  // Reset passed parameters.
+  XGBoostModel* m = params.Get<XGBoostModel*>("output_model");
+  params.Get<XGBoostModel*>("output_model") = NULL;
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("input_model", m);
+  SetInputParam("test", std::move(testData));
+
+  RUN_BINDING();
+
+  CheckMatrices(predictions, params.Get<arma::rowvec>("predictions"));
+}
+
+/**
+ * Make sure that an unknown loss function is rejected.
+ */
+TEST_CASE_METHOD(XGBoostTestFixture, "XGBoostInvalidLossTest",
+                 "[XGBoostMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load train dataset vc2.csv!");
+
+  arma::rowvec labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  SetInputParam("training", std::move(inputData));
+  SetInputParam("responses", std::move(labels));
+  SetInputParam("loss", std::string("hinge"));
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+}
+
+/**
+ * Make sure that the number of rounds must be positive.
+ */
+TEST_CASE_METHOD(XGBoostTestFixture, "XGBoostZeroRoundsTest",
+                 "[XGBoostMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load train dataset vc2.csv!");
+
+  arma::rowvec labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  SetInputParam("training", std::move(inputData));
+  SetInputParam("responses", std::move(labels));
+  SetInputParam("num_rounds", 0);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+}
@@ -1003,3 +1003,117 @@ TEST_CASE("InplaceSparseShuffleWeightsTest", "[MathTest]")
     REQUIRE(weightCounts[i] == 1);
   }
 }
+
+/**
+ * Make sure that PermuteColumns() gives the same result as cols(), with enough
+ * rows to be reordered in several blocks.
+ */
+TEST_CASE("PermuteColumnsTest", "[MathTest]")
+{
+  arma::mat data(50, 200, arma::fill::randu);
+  const arma::uvec ordering = ShuffleOrder(data.n_cols);
+  REQUIRE(ordering.n_elem == data.n_cols);
+
+  arma::mat permuted(data);
+  PermuteColumns(permuted, ordering);
+
+  REQUIRE(arma::approx_equal(permuted, arma::mat(data.cols(ordering)),
+      "absdiff", 0.0));
+
+  // An ordering that is not a permutation should be rejected.
+  arma::uvec badOrdering = ordering;
+  badOrdering[0] = badOrdering[1];
+  REQUIRE_THROWS_AS(PermuteColumns(permuted, badOrdering),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(PermuteColumns(permuted, arma::uvec(10)),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that shuffling data in place keeps the points and labels matched.
+ */
+TEST_CASE("ShuffleDataInPlaceTest", "[MathTest]")
+{
+  arma::mat data(20, 100, arma::fill::randu);
+  arma::Row<size_t> labels(100);
+  for (size_t i = 0; i < 100; ++i)
+  {
+    data(0, i) = i;
+    labels[i] = i;
+  }
+
+  arma::mat outputData(data);
+  arma::Row<size_t> outputLabels(labels);
+  ShuffleData(outputData, outputLabels);
+
+  REQUIRE(outputData.n_rows == data.n_rows);
+  REQUIRE(outputData.n_cols == data.n_cols);
+  REQUIRE(outputLabels.n_elem == labels.n_elem);
+
+  // Each point should appear once, with its label.
+  arma::Row<size_t> counts(100, arma::fill::zeros);
+  for (size_t i = 0; i < 100; ++i)
+  {
+    REQUIRE(outputLabels[i] < 100);
+    REQUIRE(arma::approx_equal(outputData.col(i),
+        data.col(outputLabels[i]), "absdiff", 0.0));
+    counts[outputLabels[i]]++;
+  }
+
+  for (size_t i = 0; i < 100; ++i)
+    REQUIRE(counts[i] == 1);
+}
+
+/**
+ * Make sure that the moments accumulated over uneven chunks (with several
+ * blocks in some of them) are those of the whole dataset.
+ */
+TEST_CASE("MomentsAccumulatorTest", "[MathTest]")
+{
+  // Use an offset and a skewed distribution, so that merging is not trivial.
+  arma::mat data = arma::exp(arma::randn<arma::mat>(4, 10000)) + 1000.0;
+  data.row(3) = arma::randu<arma::rowvec>(10000);
+
+  MomentsAccumulator moments;
+  moments.Update(data.cols(0, 6));
+  moments.Update(data.cols(7, 5006));
+  moments.Update(arma::mat(4, 0));
+  moments.Update(data.cols(5007, 9999));
+
+  REQUIRE(moments.Count() == 10000);
+  REQUIRE(moments.Dimensionality() == 4);
+  CheckMatrices(moments.Mean(), arma::mean(data, 1));
+  CheckMatrices(moments.Min(), arma::min(data, 1));
+  CheckMatrices(moments.Max(), arma::max(data, 1));
+  CheckMatrices(moments.Variance(), arma::var(data, 0, 1), 1e-5);
+  CheckMatrices(moments.Variance(true), arma::var(data, 1, 1), 1e-5);
+
+  for (size_t d = 0; d < 4; ++d)
+  {
+    const arma::rowvec deviations = data.row(d) - arma::mean(data.row(d));
+    const double n = 10000;
+    const double m2 = arma::accu(arma::square(deviations)) / n;
+    const double m3 = arma::accu(arma::pow(deviations, 3)) / n;
+    const double m4 = arma::accu(arma::pow(deviations, 4)) / n;
+
+    REQUIRE(moments.Skewness(true)[d] ==
+        Approx(m3 / std::pow(m2, 1.5)).epsilon(1e-5));
+    REQUIRE(moments.Kurtosis(true)[d] ==
+        Approx(m4 / (m2 * m2) - 3.0).epsilon(1e-5));
+
+    // The sample statistics are adjusted for the bias of small samples.
+    const double skewness = std::sqrt(n * (n - 1)) / (n - 2) * m3 /
+        std::pow(m2, 1.5);
+    REQUIRE(moments.Skewness()[d] == Approx(skewness).epsilon(1e-5));
+  }
+
+  // Merging accumulators must give the same moments.
+  MomentsAccumulator first, second;
+  first.Update(data.cols(0, 4999));
+  second.Update(data.cols(5000, 9999));
+  first.Merge(second);
+  CheckMatrices(first.Mean(), moments.Mean());
+  CheckMatrices(first.Kurtosis(), moments.Kurtosis(), 1e-5);
+
+  REQUIRE_THROWS_AS(moments.Update(arma::mat(3, 10)), std::invalid_argument);
+}
@@ -59,3 +59,78 @@ TEST_CASE("UniformMatrixCompletionSDP", "[MatrixCompletionTest]")
        Approx(Xorig(indices(0, i), indices(1, i))).epsilon(1e-7));
   }
 }
+
+/**
+ * Make sure that ALSMatrixCompletion recovers a random low-rank matrix from
+ * some of its entries, including the unknown ones.
+ */
+TEST_CASE("ALSMatrixCompletionLowRankTest", "[MatrixCompletionTest]")
+{
+  const size_t m = 150;
+  const size_t n = 120;
+  const size_t rank = 3;
+  const arma::mat x = arma::randu<arma::mat>(m, rank) *
+      arma::randu<arma::mat>(rank, n);
+
+  // Take 40% of the entries, and always a few of each row and column.
+  const arma::uvec order = arma::randperm(m * n);
+  arma::uvec taken(m * n, arma::fill::zeros);
+  taken.elem(order.head(m * n * 2 / 5)).ones();
+  for (size_t i = 0; i < m; ++i)
+    taken.elem(i + m * arma::regspace<arma::uvec>(i % 10, 10, n - 1)).ones();
+
+  const arma::uvec known = arma::find(taken);
+  arma::umat indices(2, known.n_elem);
+  arma::vec values(known.n_elem);
+  for (size_t k = 0; k < known.n_elem; ++k)
+  {
+    indices(0, k) = known[k] % m;
+    indices(1, k) = known[k] / m;
+    values[k] = x(indices(0, k), indices(1, k));
+  }
+
+  ALSMatrixCompletion mc(m, n, indices, values, rank, 1e-9, 500);
+  arma::mat recovered;
+  const double error = mc.Recover(recovered);
+
+  REQUIRE(error < 1e-4);
+  REQUIRE(mc.W().n_rows == rank);
+  REQUIRE(mc.W().n_cols == m);
+  REQUIRE(mc.H().n_cols == n);
+  REQUIRE(arma::norm(x - recovered, "fro") / arma::norm(x, "fro") < 1e-3);
+
+  // The predictions match the completed matrix.
+  const arma::umat entries = { { 0, 5, m - 1 }, { 3, n - 1, 0 } };
+  arma::vec predictions;
+  mc.Predict(entries, predictions);
+  for (size_t k = 0; k < entries.n_cols; ++k)
+  {
+    REQUIRE(predictions[k] == Approx(recovered(entries(0, k),
+        entries(1, k))).epsilon(1e-10));
+    REQUIRE(mc.Predict(entries(0, k), entries(1, k)) ==
+        Approx(predictions[k]).epsilon(1e-10));
+  }
+}
+
+/**
+ * Make sure that ALSMatrixCompletion rejects invalid problems.
+ */
+TEST_CASE("ALSMatrixCompletionInvalidTest", "[MatrixCompletionTest]")
+{
+  const arma::umat indices = { { 0, 1, 1 }, { 0, 0, 2 } };
+  const arma::vec values = { 1.0, 0.0, 2.0 };
+
+  REQUIRE_NOTHROW(ALSMatrixCompletion(2, 3, indices, values, 1));
+  REQUIRE_THROWS_AS(ALSMatrixCompletion(2, 2, indices, values, 1),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(ALSMatrixCompletion(2, 3, indices, values, 0),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(ALSMatrixCompletion(2, 3, indices, values, 1, 0.0),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(ALSMatrixCompletion(2, 3, indices,
+      arma::vec(values.head(2)), 1), std::invalid_argument);
+
+  const arma::umat repeated = { { 0, 1, 1 }, { 0, 2, 2 } };
+  REQUIRE_THROWS_AS(ALSMatrixCompletion(2, 3, repeated, values, 1),
+      std::invalid_argument);
+}
@@ -261,3 +261,74 @@ TEMPLATE_TEST_CASE("GaussianClusteringCentroidsOnly", "[MeanShiftTest]", float,
 
   REQUIRE(success == true);
 }
+
+/**
+ * Make sure that mean shift with a Gaussian kernel also finds the three
+ * classes.
+ */
+TEMPLATE_TEST_CASE("MeanShiftKernelTest", "[MeanShiftTest]", float, double)
+{
+  typedef TestType ElemType;
+
+  MeanShift<true> meanShift(2.0);
+
+  arma::Row<size_t> assignments;
+  arma::Mat<ElemType> centroids;
+  meanShift.Cluster(GetMeanShiftData<arma::Mat<ElemType>>(), assignments,
+      centroids);
+
+  REQUIRE(centroids.n_cols == 3);
+  for (size_t i = 1; i < 13; ++i)
+    REQUIRE(assignments(i) == assignments(0));
+  for (size_t i = 14; i < 20; ++i)
+    REQUIRE(assignments(i) == assignments(13));
+  for (size_t i = 21; i < 30; ++i)
+    REQUIRE(assignments(i) == assignments(20));
+
+  REQUIRE(assignments(0) != assignments(13));
+  REQUIRE(assignments(0) != assignments(20));
+  REQUIRE(assignments(13) != assignments(20));
+}
+
+/**
+ * Every centroid returned by flat-kernel mean shift should be (nearly) a fixed
+ * point: the mean of the points within the radius of it should be very close
+ * to it.  This checks the running sums against a brute-force computation.
+ */
+TEST_CASE("MeanShiftFixedPointTest", "[MeanShiftTest]")
+{
+  GaussianDistribution<> g1("0.0 0.0 0.0", arma::eye<arma::mat>(3, 3));
+  GaussianDistribution<> g2("6.0 6.0 6.0", arma::eye<arma::mat>(3, 3));
+
+  arma::mat dataset(3, 4000);
+  for (size_t i = 0; i < 2000; ++i)
+    dataset.col(i) = g1.Random();
+  for (size_t i = 2000; i < 4000; ++i)
+    dataset.col(i) = g2.Random();
+
+  const double radius = 2.0;
+  MeanShift<> meanShift(radius);
+  arma::mat centroids;
+  meanShift.Cluster(dataset, centroids, false, false);
+
+  REQUIRE(centroids.n_cols >= 2);
+  for (size_t c = 0; c < centroids.n_cols; ++c)
+  {
+    arma::vec mean(3, arma::fill::zeros);
+    size_t count = 0;
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+    {
+      if (EuclideanDistance::Evaluate(dataset.col(i), centroids.col(c)) <=
+          radius)
+      {
+        mean += dataset.col(i);
+        ++count;
+      }
+    }
+
+    REQUIRE(count > 0);
+    mean /= count;
+    REQUIRE(EuclideanDistance::Evaluate(mean, centroids.col(c)) <
+        2e-3 * radius);
+  }
+}
@@ -219,6 +219,115 @@ TEST_CASE("NMSMetricTest", "[MetricTest]")
   CheckMatrices(desiredBoundingBox, selectedBoundingBox);
 }
 
+/**
+ * Greedy non-maximal suppression of boxes in the {x0, y0, x1, y1} format, by
+ * brute force.
+ */
+arma::uvec BruteForceNMS(const arma::mat& bbox,
+                         const arma::vec& confidenceScores,
+                         const double threshold)
+{
+  const arma::uvec order = arma::stable_sort_index(confidenceScores,
+      "descend");
+  std::vector<bool> suppressed(order.n_elem, false);
+  std::vector<size_t> selected;
+  for (size_t i = 0; i < order.n_elem; ++i)
+  {
+    if (suppressed[i])
+      continue;
+
+    selected.push_back(order[i]);
+    const arma::vec a = bbox.col(order[i]);
+    for (size_t j = i + 1; j < order.n_elem; ++j)
+    {
+      // Unlike IoU<>, the corners are not counted as pixels.
+      const arma::vec b = bbox.col(order[j]);
+      const double intersection =
+          std::max(std::min(a(2), b(2)) - std::max(a(0), b(0)), 0.0) *
+          std::max(std::min(a(3), b(3)) - std::max(a(1), b(1)), 0.0);
+      const double iou = intersection / ((a(2) - a(0)) * (a(3) - a(1)) +
+          (b(2) - b(0)) * (b(3) - b(1)) - intersection);
+      if (iou > threshold)
+        suppressed[j] = true;
+    }
+  }
+
+  return arma::conv_to<arma::uvec>::from(selected);
+}
+
+/**
+ * Make sure that NMS selects the same boxes as a brute-force suppression on a
+ * large set of random boxes, with both representations.
+ */
+TEST_CASE("NMSLargeTest", "[MetricTest]")
+{
+  // 1000 boxes in a 100 x 100 image; many of them overlap.
+  arma::mat bbox(4, 1000);
+  bbox.rows(0, 1) = 100.0 * arma::randu<arma::mat>(2, 1000);
+  bbox.rows(2, 3) = bbox.rows(0, 1) + 1.0 +
+      19.0 * arma::randu<arma::mat>(2, 1000);
+  arma::vec confidenceScores = arma::randu<arma::vec>(1000);
+
+  for (const double threshold : { 0.1, 0.5, 0.9 })
+  {
+    const arma::uvec desiredIndices = BruteForceNMS(bbox, confidenceScores,
+        threshold);
+
+    arma::uvec selectedIndices;
+    NMS<true>::Evaluate(bbox, confidenceScores, selectedIndices, threshold);
+    CheckMatrices(desiredIndices, selectedIndices);
+
+    // Convert the boxes to the {x0, y0, h, w} representation.
+    arma::mat hwBox = bbox;
+    hwBox.rows(2, 3) -= bbox.rows(0, 1);
+    NMS<false>::Evaluate(hwBox, confidenceScores, selectedIndices, threshold);
+    CheckMatrices(desiredIndices, selectedIndices);
+  }
+}
+
+/**
+ * Make sure that NMS by class gives the union of the boxes selected in each
+ * class, sorted by confidence score.
+ */
+TEST_CASE("NMSByClassTest", "[MetricTest]")
+{
+  arma::mat bbox(4, 500);
+  bbox.rows(0, 1) = 50.0 * arma::randu<arma::mat>(2, 500);
+  bbox.rows(2, 3) = bbox.rows(0, 1) + 1.0 +
+      19.0 * arma::randu<arma::mat>(2, 500);
+  arma::vec confidenceScores = arma::randu<arma::vec>(500);
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(500,
+      arma::distr_param(0, 4));
+
+  arma::uvec selectedIndices;
+  NMS<true>::EvaluateByClass(bbox, confidenceScores, labels, selectedIndices,
+      0.5);
+
+  // Each class must have the boxes selected among the boxes of the class.
+  for (size_t c = 0; c < 5; ++c)
+  {
+    const arma::uvec classBoxes = arma::find(labels == c);
+    arma::uvec classSelected;
+    NMS<true>::Evaluate(bbox.cols(classBoxes),
+        confidenceScores.elem(classBoxes), classSelected, 0.5);
+
+    const arma::uvec selectedInClass = selectedIndices.elem(
+        arma::find(labels.cols(selectedIndices) == c));
+    CheckMatrices(arma::uvec(classBoxes.elem(classSelected)),
+        selectedInClass);
+  }
+
+  // The selected boxes must be sorted by confidence score.
+  for (size_t i = 1; i < selectedIndices.n_elem; ++i)
+  {
+    REQUIRE(confidenceScores[selectedIndices[i - 1]] >=
+        confidenceScores[selectedIndices[i]]);
+  }
+
+  REQUIRE_THROWS_AS(NMS<true>::EvaluateByClass(bbox, confidenceScores,
+      arma::Row<size_t>(10), selectedIndices), std::invalid_argument);
+}
+
 /**
  *
  */
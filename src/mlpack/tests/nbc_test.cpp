@@ -498,3 +498,66 @@ TEMPLATE_TEST_CASE("NBCModelMatTypeTest", "[NBCTest]", float, double)
   REQUIRE(nbc.Variances().n_rows == data.n_rows);
   REQUIRE(nbc.Variances().n_cols == 4);
 }
+
+/**
+ * Ensure that incremental training on several batches gives the same model as
+ * training on all the points at once, and that batch classification (which is
+ * done in blocks) matches single-point classification, for dense and sparse
+ * data.
+ */
+TEST_CASE("NBCBatchIncrementalTest", "[NBCTest]")
+{
+  // Use more points than one classification block.
+  arma::mat data(10, 3000, arma::fill::randn);
+  arma::Row<size_t> labels =
+      arma::randi<arma::Row<size_t>>(3000, arma::distr_param(0, 2));
+  data.cols(arma::find(labels == 1)) += 3.0;
+  data.cols(arma::find(labels == 2)) *= 2.0;
+
+  NaiveBayesClassifier<> full(data, labels, 3, false);
+
+  NaiveBayesClassifier<> batches(10, 3);
+  batches.Train(data.cols(0, 999), labels.subvec(0, 999), 3, true);
+  batches.Train(data.cols(1000, 2999), labels.subvec(1000, 2999), 3, true);
+
+  REQUIRE(batches.TrainingPoints() == 3000);
+  REQUIRE(arma::approx_equal(batches.Probabilities(), full.Probabilities(),
+      "absdiff", 1e-10));
+  REQUIRE(arma::approx_equal(batches.Means(), full.Means(), "reldiff", 1e-8));
+  REQUIRE(arma::approx_equal(batches.Variances(), full.Variances(), "reldiff",
+      1e-8));
+
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  full.Classify(data, predictions, probabilities);
+
+  arma::mat spData(data);
+  spData.elem(arma::find(arma::abs(spData) < 1.0)).zeros();
+  const arma::sp_mat sparseData(spData);
+  NaiveBayesClassifier<> sparse(sparseData, labels, 3);
+  arma::Row<size_t> sparsePredictions;
+  arma::mat sparseProbabilities;
+  sparse.Classify(sparseData, sparsePredictions, sparseProbabilities);
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    size_t prediction;
+    arma::vec pointProbabilities;
+    full.Classify(data.col(i), prediction, pointProbabilities);
+    REQUIRE(prediction == predictions[i]);
+    for (size_t c = 0; c < 3; ++c)
+    {
+      REQUIRE(pointProbabilities[c] ==
+          Approx(probabilities(c, i)).margin(1e-8));
+    }
+
+    const arma::vec point(spData.col(i));
+    sparse.Classify(point, prediction, pointProbabilities);
+    REQUIRE(prediction == sparsePredictions[i]);
+    for (size_t c = 0; c < 3; ++c)
+    {
+      REQUIRE(pointProbabilities[c] ==
+          Approx(sparseProbabilities(c, i)).margin(1e-8));
+    }
+  }
+}
@@ -12,6 +12,7 @@
 #include <mlpack/core.hpp>
 #include <mlpack/methods/nmf.hpp>
 
+#include "test_catch_tools.hpp"
 #include "catch.hpp"
 
 using namespace std;
@@ -174,6 +175,37 @@ TEST_CASE("SparseNMFAcolDistTest", "[NMFTest]")
       Approx(0.0).margin(1e-5));
 }
 
+/**
+ * Check that the sparse multiplicative update rules give the same
+ * factorization as the dense ones, from the same initialization.
+ */
+TEMPLATE_TEST_CASE("SparseNMFMultiplicativeUpdateTest", "[NMFTest]",
+    NMFMultiplicativeDistanceUpdate, NMFMultiplicativeDivergenceUpdate)
+{
+  sp_mat v;
+  v.sprandu(50, 40, 0.1);
+  // Ensure there is at least one nonzero element in every row and column.
+  for (size_t i = 0; i < 40; ++i)
+    v(i, i) += 0.1;
+  mat dv(v); // Make a dense copy.
+  const size_t r = 5;
+
+  // Get an initialization, used by both Apply() calls.
+  arma::mat iw, ih;
+  RandomAMFInitialization::Initialize(v, r, iw, ih);
+  GivenInitialization<> g(std::move(iw), std::move(ih));
+
+  MaxIterationTermination mit(50);
+  AMF<MaxIterationTermination, GivenInitialization<>, TestType> nmf(mit, g);
+
+  mat w, h, dw, dh;
+  nmf.Apply(v, r, w, h);
+  nmf.Apply(dv, r, dw, dh);
+
+  CheckMatrices(w, dw, 1e-5);
+  CheckMatrices(h, dh, 1e-5);
+}
+
 /**
  * Check that the product of the calculated factorization is close to the
  * input matrix, with a sparse input matrix.  This uses the random
@@ -10,6 +10,7 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/core.hpp>
+#include <mlpack/methods/neighbor_search.hpp>
 
 #include "catch.hpp"
 #include "test_catch_tools.hpp"
@@ -341,3 +342,108 @@ TEST_CASE("OctreeSerializationTest", "[OctreeTest]")
   delete binaryTree;
   delete jsonTree;
 }
+
+/**
+ * Make sure that two trees have the same shape: the same number of children
+ * and descendants, and the same bounds, in every node.
+ */
+template<typename TreeType>
+void CheckSameStructure(TreeType& node1, TreeType& node2)
+{
+  REQUIRE(node1.NumChildren() == node2.NumChildren());
+  REQUIRE(node1.NumPoints() == node2.NumPoints());
+  REQUIRE(node1.NumDescendants() == node2.NumDescendants());
+
+  REQUIRE(node1.Bound().Dim() == node2.Bound().Dim());
+  for (size_t d = 0; d < node1.Bound().Dim(); ++d)
+  {
+    REQUIRE(node1.Bound()[d].Lo() ==
+        Approx(node2.Bound()[d].Lo()).epsilon(1e-7));
+    REQUIRE(node1.Bound()[d].Hi() ==
+        Approx(node2.Bound()[d].Hi()).epsilon(1e-7));
+  }
+
+  for (size_t i = 0; i < node1.NumChildren(); ++i)
+    CheckSameStructure(node1.Child(i), node2.Child(i));
+}
+
+/**
+ * Make sure that the Morton-code build gives the same tree as the regular
+ * build, with correct mappings.
+ */
+TEST_CASE("OctreeMortonBuildTest", "[OctreeTest]")
+{
+  // Use enough points that some children are built in parallel.
+  arma::mat dataset(3, 10000, arma::fill::randu);
+  arma::mat datacopy(dataset);
+  std::vector<size_t> oldFromNewCopy, oldFromNewMove;
+
+  Octree<> t(dataset, 10);
+  Octree<> t1(dataset, MortonBuild(), oldFromNewCopy, 10);
+  Octree<> t2(std::move(dataset), MortonBuild(), oldFromNewMove, 10);
+
+  REQUIRE(oldFromNewCopy.size() == datacopy.n_cols);
+  REQUIRE(oldFromNewMove.size() == datacopy.n_cols);
+  for (size_t i = 0; i < oldFromNewCopy.size(); ++i)
+  {
+    REQUIRE(arma::norm(datacopy.col(oldFromNewCopy[i]) -
+        t1.Dataset().col(i)) == Approx(0.0).margin(1e-10));
+    REQUIRE(arma::norm(datacopy.col(oldFromNewMove[i]) -
+        t2.Dataset().col(i)) == Approx(0.0).margin(1e-10));
+  }
+
+  // No point of uniformly random data should be close enough to a cell
+  // boundary to end up in a different node.
+  CheckSameStructure(t, t1);
+  CheckSameStructure(t, t2);
+  CheckOverlap(t1);
+  CheckFurthestDistances(t1);
+}
+
+/**
+ * Make sure that the Morton-code build handles small and degenerate datasets.
+ */
+TEST_CASE("OctreeMortonBuildEdgeCasesTest", "[OctreeTest]")
+{
+  arma::mat empty(3, 0);
+  Octree<> t1(empty, MortonBuild());
+  REQUIRE(t1.NumChildren() == 0);
+  REQUIRE(t1.NumDescendants() == 0);
+
+  // All points are the same, so the root can't be split.
+  arma::mat same(3, 50, arma::fill::ones);
+  Octree<> t2(same, MortonBuild(), 5);
+  REQUIRE(t2.NumChildren() == 0);
+  REQUIRE(t2.NumDescendants() == 50);
+
+  // The four corners of the unit square each get their own child.
+  arma::mat corners("0 0 1 1; 0 1 0 1");
+  Octree<> t3(std::move(corners), MortonBuild(), 1);
+  REQUIRE(t3.NumChildren() == 4);
+  for (size_t i = 0; i < 4; ++i)
+    REQUIRE(t3.Child(i).NumDescendants() == 1);
+}
+
+/**
+ * Make sure that dual-tree k-nearest-neighbor search with an Octree built from
+ * Morton codes gives the same results as naive search.
+ */
+TEST_CASE("OctreeMortonBuildKNNTest", "[OctreeTest]")
+{
+  typedef NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+      Octree> KNNType;
+
+  arma::mat dataset(3, 5000, arma::fill::randu);
+  Octree<> tree(dataset, MortonBuild(), 10);
+
+  KNNType naive(tree.Dataset(), NAIVE_MODE);
+  KNNType dualTree(std::move(tree));
+
+  arma::Mat<size_t> naiveNeighbors, dualTreeNeighbors;
+  arma::mat naiveDistances, dualTreeDistances;
+  naive.Search(5, naiveNeighbors, naiveDistances);
+  dualTree.Search(5, dualTreeNeighbors, dualTreeDistances);
+
+  CheckMatrices(naiveNeighbors, dualTreeNeighbors);
+  CheckMatrices(naiveDistances, dualTreeDistances);
+}
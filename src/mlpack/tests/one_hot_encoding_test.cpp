@@ -229,3 +229,49 @@ TEST_CASE("OneHotEncodingDatasetinfoTest", "[OneHotEncodingTest]")
 
   remove("test.csv");
 }
+
+/**
+ * Make sure the sparse one-hot encoding of a dataset is the same as the dense
+ * encoding, for the label, indices and DatasetInfo variants.
+ */
+TEST_CASE("OneHotEncodingSparseOutputTest", "[OneHotEncodingTest]")
+{
+  // Use many levels, and some zeros in the dimensions that are not encoded.
+  arma::mat input = arma::floor(arma::randu<arma::mat>(6, 500) * 50.0);
+  input.row(2).zeros();
+  input(2, 10) = 3.0;
+
+  arma::Col<size_t> indices("0 3 5");
+  arma::mat denseOutput;
+  arma::sp_mat sparseOutput;
+  data::OneHotEncoding(input, indices, denseOutput);
+  data::OneHotEncoding(input, indices, sparseOutput);
+
+  REQUIRE(sparseOutput.n_rows == denseOutput.n_rows);
+  REQUIRE(sparseOutput.n_cols == denseOutput.n_cols);
+  REQUIRE(sparseOutput.n_nonzero ==
+      (size_t) arma::accu(denseOutput != 0.0));
+  CheckMatrices(arma::mat(sparseOutput), denseOutput);
+
+  // Encoding the same dimensions through a DatasetInfo gives the same result.
+  data::DatasetInfo info(input.n_rows);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+    info.Type(indices[i]) = data::Datatype::categorical;
+  arma::sp_mat infoOutput;
+  data::OneHotEncoding(input, infoOutput, info);
+  CheckMatrices(arma::mat(infoOutput), denseOutput);
+
+  // With nothing to encode, the dataset is only converted.
+  data::OneHotEncoding(input, arma::Col<size_t>(), sparseOutput);
+  CheckMatrices(arma::mat(sparseOutput), input);
+
+  // Check the label variant too.
+  arma::Row<size_t> labels = arma::conv_to<arma::Row<size_t>>::from(
+      input.row(1));
+  arma::mat denseLabels;
+  arma::sp_mat sparseLabels;
+  data::OneHotEncoding(labels, denseLabels);
+  data::OneHotEncoding(labels, sparseLabels);
+  REQUIRE(sparseLabels.n_nonzero == labels.n_elem);
+  CheckMatrices(arma::mat(sparseLabels), denseLabels);
+}
@@ -507,3 +507,96 @@ TEMPLATE_TEST_CASE("PCASparseToDenseTest", "[PCATest]", float, double)
 
   REQUIRE(denseData2.n_rows == transformedDataset2.n_rows);
 }
+
+/**
+ * Make sure that incremental PCA with all the components gives the same
+ * result as exact PCA, for any batch size.
+ */
+TEMPLATE_TEST_CASE("IncrementalPCAExactTest", "[PCATest]", float, double)
+{
+  typedef arma::Mat<TestType> MatType;
+  typedef arma::Col<TestType> ColType;
+
+  MatType data = arma::randn<MatType>(6, 300);
+  data.row(1) += 2 * data.row(0);
+  data.row(3) *= 5;
+  data.each_col() += ColType("1 -2 3 -4 5 -6");
+
+  MatType trueTransData, trueEigvec;
+  ColType trueEigval;
+  PCA<> p;
+  p.Apply(data, trueTransData, trueEigval, trueEigvec);
+
+  const double tolerance = std::is_same<TestType, float>::value ? 1e-3 : 1e-8;
+  for (const size_t batchSize : { 1, 7, 100, 300 })
+  {
+    IncrementalPCAType<MatType> ipca;
+    for (size_t begin = 0; begin < data.n_cols; begin += batchSize)
+    {
+      const size_t end = std::min(begin + batchSize, (size_t) data.n_cols);
+      ipca.Update(data.cols(begin, end - 1));
+    }
+
+    REQUIRE(ipca.NumPoints() == 300);
+    REQUIRE(ipca.Components().n_cols == 6);
+    REQUIRE(arma::approx_equal(ipca.Mean(), ColType(arma::mean(data, 1)),
+        "absdiff", tolerance));
+    REQUIRE(arma::approx_equal(ipca.Eigenvalues(), trueEigval, "reldiff",
+        tolerance));
+    REQUIRE(ipca.VarianceRetained(6) == Approx(1.0).epsilon(tolerance));
+    REQUIRE(ipca.VarianceRetained(2) == Approx(arma::accu(
+        trueEigval.subvec(0, 1)) / arma::accu(trueEigval)).epsilon(tolerance));
+
+    // The components and the transformed data are only defined up to their
+    // signs.
+    MatType transData;
+    ipca.Transform(data, transData);
+    for (size_t i = 0; i < 6; ++i)
+    {
+      const TestType sign = (arma::dot(ipca.Components().col(i),
+          trueEigvec.col(i)) < 0) ? -1 : 1;
+      REQUIRE(arma::approx_equal(sign * ipca.Components().col(i),
+          trueEigvec.col(i), "absdiff", tolerance));
+      REQUIRE(arma::norm(sign * transData.row(i) - trueTransData.row(i)) /
+          arma::norm(trueTransData.row(i)) < tolerance);
+    }
+  }
+}
+
+/**
+ * Make sure that incremental PCA with fewer components finds the dominant
+ * components of low-rank data, and that it checks the dimensionality.
+ */
+TEST_CASE("IncrementalPCALowRankTest", "[PCATest]")
+{
+  // Data in 20 dimensions that lies (up to small noise) in 3 dimensions.
+  arma::mat data = arma::randn<arma::mat>(20, 3) *
+      arma::randn<arma::mat>(3, 2000) + 0.01 * arma::randn<arma::mat>(20, 2000);
+
+  IncrementalPCA ipca(3);
+  for (size_t begin = 0; begin < data.n_cols; begin += 250)
+    ipca.Update(data.cols(begin, begin + 249));
+
+  REQUIRE(ipca.Components().n_rows == 20);
+  REQUIRE(ipca.Components().n_cols == 3);
+  REQUIRE(ipca.VarianceRetained(3) > 0.999);
+
+  // The transformed data should reconstruct the centered data.
+  arma::mat transData;
+  ipca.Transform(data, transData);
+  REQUIRE(transData.n_rows == 3);
+  REQUIRE(transData.n_cols == 2000);
+  arma::mat centered = data.each_col() - ipca.Mean();
+  const double error = arma::norm(ipca.Components() * transData - centered,
+      "fro") / arma::norm(centered, "fro");
+  REQUIRE(error < 0.01);
+
+  // Batches and points of the wrong dimensionality are rejected.
+  REQUIRE_THROWS_AS(ipca.Update(arma::randu<arma::mat>(19, 10)),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(ipca.Transform(arma::randu<arma::mat>(21, 10), transData),
+      std::invalid_argument);
+
+  IncrementalPCA empty;
+  REQUIRE_THROWS_AS(empty.Transform(data, transData), std::runtime_error);
+}
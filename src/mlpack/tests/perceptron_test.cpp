@@ -363,3 +363,40 @@ TEST_CASE("TrainFormTest", "[PerceptronTest]")
   REQUIRE(all(predictions5 == trueLabels));
   REQUIRE(all(predictions6 == trueLabels));
 }
+
+// Make sure that mini-batch training gives a perceptron that separates
+// linearly separable data, and that batch classification matches the
+// classification of single points.
+TEST_CASE("MiniBatchTrainingTest", "[PerceptronTest]")
+{
+  // Five well-separated Gaussian classes.
+  const size_t numClasses = 5;
+  const mat centers = 10.0 * randu<mat>(20, numClasses);
+  mat trainData(20, 2000);
+  Row<size_t> labels(2000);
+  for (size_t i = 0; i < trainData.n_cols; ++i)
+  {
+    labels[i] = i % numClasses;
+    trainData.col(i) = centers.col(labels[i]) + 0.1 * randn<vec>(20);
+  }
+
+  Perceptron<> p;
+  p.BatchSize() = 100;
+  p.Train(trainData, labels, numClasses, 1000);
+  REQUIRE(p.BatchSize() == 100);
+
+  Row<size_t> predictions;
+  p.Classify(trainData, predictions);
+  REQUIRE(predictions.n_elem == trainData.n_cols);
+  REQUIRE(accu(predictions == labels) == trainData.n_cols);
+
+  for (size_t i = 0; i < trainData.n_cols; ++i)
+    REQUIRE(p.Classify(trainData.col(i)) == predictions[i]);
+
+  // A batch size of one point gives the classic perceptron.
+  Perceptron<> p1(trainData, labels, numClasses, 10), p2;
+  p2.BatchSize() = 1;
+  p2.Train(trainData, labels, numClasses, 10);
+  REQUIRE(approx_equal(p1.Weights(), p2.Weights(), "absdiff", 1e-10));
+  REQUIRE(approx_equal(p1.Biases(), p2.Biases(), "absdiff", 1e-10));
+}
@@ -269,6 +269,66 @@ TEST_CASE("PendulumWithTD3", "[PolicyGradientTest]")
   REQUIRE(converged);
 }
 
+//! Test TD3 on Pendulum task with parallel actors.
+TEST_CASE("PendulumWithParallelTD3", "[PolicyGradientTest]")
+{
+  // It isn't guaranteed that the network will converge in the specified number
+  // of iterations using random weights.
+  bool converged = false;
+  for (size_t trial = 0; trial < 8; ++trial)
+  {
+    Log::Debug << "Trial number: " << trial << std::endl;
+    // Set up the replay method.
+    RandomReplay<Pendulum> replayMethod(32, 10000);
+
+    TrainingConfig config;
+    config.StepSize() = 0.001;
+    config.TargetNetworkSyncInterval() = 2;
+    config.UpdateInterval() = 3;
+
+    // Set up Actor network.
+    FFN<EmptyLoss, GaussianInitialization>
+        policyNetwork(EmptyLoss(), GaussianInitialization(0, 0.1));
+    policyNetwork.Add(new Linear(128));
+    policyNetwork.Add(new ReLU());
+    policyNetwork.Add(new Linear(1));
+    policyNetwork.Add(new TanH());
+
+    // Set up Critic network.
+    FFN<EmptyLoss, GaussianInitialization>
+        qNetwork(EmptyLoss(), GaussianInitialization(0, 0.1));
+    qNetwork.Add(new Linear(128));
+    qNetwork.Add(new ReLU());
+    qNetwork.Add(new Linear(1));
+
+    TD3<Pendulum, decltype(qNetwork), decltype(policyNetwork), AdamUpdate>
+        agent(config, qNetwork, policyNetwork, replayMethod);
+
+    // Train with four actors, and check the returns of the last episodes.
+    std::vector<double> returnList;
+    for (size_t chunk = 0; chunk < 50 && !converged; ++chunk)
+    {
+      const size_t totalSteps = agent.TotalSteps();
+      std::vector<double> returns = agent.ParallelSteps(4, 2000);
+      REQUIRE(agent.TotalSteps() == totalSteps + 2000);
+
+      returnList.insert(returnList.end(), returns.begin(), returns.end());
+      if (returnList.size() > 10)
+        returnList.erase(returnList.begin(), returnList.end() - 10);
+
+      const double averageReturn = std::accumulate(returnList.begin(),
+          returnList.end(), 0.0) / returnList.size();
+      Log::Debug << "Average return in last " << returnList.size()
+          << " consecutive episodes: " << averageReturn << std::endl;
+      converged = (returnList.size() >= 10 && averageReturn > -900);
+    }
+
+    if (converged)
+      break;
+  }
+  REQUIRE(converged);
+}
+
 //! A test to ensure TD3 works with multiple actions in action space.
 TEST_CASE("TD3ForMultipleActions", "[PolicyGradientTest]")
 {
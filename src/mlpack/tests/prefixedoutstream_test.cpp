@@ -235,3 +235,38 @@ TEST_CASE("TestArmaCustomPrecision", "[PrefixedOutStreamTest]")
       BASH_GREEN "[INFO ] " BASH_CLEAR "   2.5000   3.0000   3.5000\n"
       BASH_GREEN "[INFO ] " BASH_CLEAR "   4.0000   4.5000   5.0000\n");
 }
+
+/**
+ * Test that lines written in a single call from several threads at once are
+ * not interleaved, and that ignoreInput can be toggled while other threads
+ * write.
+ */
+TEST_CASE("TestPrefixedOutStreamThreads", "[PrefixedOutStreamTest]")
+{
+  std::stringstream ss;
+  PrefixedOutStream pss(ss, "[TEST] ");
+
+  #pragma omp parallel for num_threads(4)
+  for (int i = 0; i < 400; ++i)
+    pss << std::string("line from a thread\n");
+
+  // Toggle the stream; every line is either shown entirely or not at all.
+  #pragma omp parallel for num_threads(4)
+  for (int i = 0; i < 400; ++i)
+  {
+    if (i % 100 == 0)
+      pss.ignoreInput = !pss.ignoreInput;
+    pss << std::string("shown or not\n");
+  }
+
+  std::string line;
+  size_t lines = 0;
+  while (std::getline(ss, line))
+  {
+    if (lines < 400)
+      REQUIRE(line.find("from a thread") != std::string::npos);
+    REQUIRE(line.substr(0, 7) == "[TEST] ");
+    ++lines;
+  }
+  REQUIRE(lines >= 400);
+}
@@ -0,0 +1,205 @@
+/**
+ * @file tests/product_quantization_test.cpp
+ *
+ * Unit tests for the 'ProductQuantizer' and 'IVFPQSearch' classes.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include "catch.hpp"
+#include "serialization.hpp"
+#include "test_catch_tools.hpp"
+
+#include <mlpack/methods/product_quantization.hpp>
+#include <mlpack/methods/neighbor_search.hpp>
+
+using namespace std;
+using namespace mlpack;
+
+/**
+ * Make sure that the codes reconstruct the points, that more centroids give a
+ * lower error, and that the distance tables give the distances to the
+ * reconstructed points.
+ */
+TEST_CASE("ProductQuantizerReconstructionTest", "[ProductQuantizationTest]")
+{
+  arma::mat data = arma::randn<arma::mat>(10, 2000);
+
+  ProductQuantizer<> coarse(data, 5, 4);
+  ProductQuantizer<> fine(data, 5, 128);
+  REQUIRE(fine.NumSubspaces() == 5);
+  REQUIRE(fine.NumCentroids() == 128);
+  REQUIRE(fine.Dimensionality() == 10);
+
+  arma::Mat<uint8_t> codes;
+  arma::mat coarseReconstruction, fineReconstruction;
+  coarse.Encode(data, codes);
+  REQUIRE(codes.max() < 4);
+  coarse.Decode(codes, coarseReconstruction);
+  fine.Encode(data, codes);
+  REQUIRE(codes.n_rows == 5);
+  REQUIRE(codes.n_cols == 2000);
+  fine.Decode(codes, fineReconstruction);
+
+  const double coarseError = arma::accu(arma::square(data -
+      coarseReconstruction)) / data.n_cols;
+  const double fineError = arma::accu(arma::square(data -
+      fineReconstruction)) / data.n_cols;
+  REQUIRE(fineError < coarseError);
+  // Each point has a variance of 10.
+  REQUIRE(fineError < 3.0);
+
+  arma::mat table;
+  const arma::vec query = arma::randn<arma::vec>(10);
+  fine.DistanceTable(query, table);
+  REQUIRE(table.n_rows == 128);
+  REQUIRE(table.n_cols == 5);
+  for (size_t i = 0; i < 20; ++i)
+  {
+    double distance = 0.0;
+    for (size_t s = 0; s < 5; ++s)
+      distance += table(codes(s, i), s);
+
+    REQUIRE(distance == Approx(arma::accu(arma::square(query -
+        fineReconstruction.col(i)))).epsilon(1e-7));
+  }
+}
+
+/**
+ * The rotation learned by optimized product quantization must be orthogonal,
+ * it must not make the quantization worse, and the distance tables must still
+ * give the distances to the reconstructed points.
+ */
+TEST_CASE("OptimizedProductQuantizerTest", "[ProductQuantizationTest]")
+{
+  // Correlated points, whose variance is mostly in a few directions.
+  const arma::mat mixing = arma::randn<arma::mat>(8, 3);
+  arma::mat data = mixing * arma::randn<arma::mat>(3, 2000) +
+      0.1 * arma::randn<arma::mat>(8, 2000);
+
+  ProductQuantizer<> pq(data, 4, 16);
+  ProductQuantizer<> opq(data, 4, 16, 5);
+  REQUIRE(pq.Rotation().is_empty());
+  REQUIRE(arma::approx_equal(opq.Rotation().t() * opq.Rotation(),
+      arma::eye<arma::mat>(8, 8), "absdiff", 1e-8));
+
+  arma::Mat<uint8_t> codes;
+  arma::mat pqReconstruction, opqReconstruction;
+  pq.Encode(data, codes);
+  pq.Decode(codes, pqReconstruction);
+  opq.Encode(data, codes);
+  opq.Decode(codes, opqReconstruction);
+
+  const double pqError = arma::accu(arma::square(data - pqReconstruction));
+  const double opqError = arma::accu(arma::square(data - opqReconstruction));
+  REQUIRE(opqError < 1.1 * pqError);
+
+  arma::mat table;
+  opq.DistanceTable(data.col(0), table);
+  double distance = 0.0;
+  for (size_t s = 0; s < 4; ++s)
+    distance += table(codes(s, 1), s);
+  REQUIRE(distance == Approx(arma::accu(arma::square(data.col(0) -
+      opqReconstruction.col(1)))).epsilon(1e-7));
+}
+
+/**
+ * Make sure that the index has a reasonable recall with the codes only, a
+ * high recall with re-ranking, and that the re-ranked distances are exact.
+ */
+TEST_CASE("IVFPQRecallTest", "[ProductQuantizationTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(8, 4000);
+  arma::mat queryData = arma::randu<arma::mat>(8, 100);
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  knn.Search(queryData, 10, trueNeighbors, trueDistances);
+
+  IVFPQSearch<> ivfpq(referenceData, 16, 4, 64);
+  REQUIRE(ivfpq.NumPoints() == 4000);
+  REQUIRE(ivfpq.NumLists() == 16);
+  size_t listPoints = 0;
+  for (size_t l = 0; l < ivfpq.NumLists(); ++l)
+  {
+    REQUIRE(ivfpq.ListCodes(l).n_rows == ivfpq.ListIndices(l).n_elem);
+    REQUIRE(ivfpq.ListCodes(l).n_cols == 4);
+    listPoints += ivfpq.ListIndices(l).n_elem;
+  }
+  REQUIRE(listPoints == 4000);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  ivfpq.Search(queryData, 10, neighbors, distances, 1);
+  const double lowRecall = KNN::Recall(neighbors, trueNeighbors);
+  ivfpq.Search(queryData, 10, neighbors, distances, 16);
+  const double codeRecall = KNN::Recall(neighbors, trueNeighbors);
+  REQUIRE(codeRecall >= lowRecall);
+  REQUIRE(codeRecall > 0.3);
+
+  ivfpq.Search(queryData, referenceData, 10, neighbors, distances, 16, 200);
+  REQUIRE(KNN::Recall(neighbors, trueNeighbors) > 0.95);
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+  {
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+    {
+      REQUIRE(distances(j, i) == Approx(EuclideanDistance::Evaluate(
+          queryData.col(i), referenceData.col(neighbors(j, i)))).epsilon(1e-7));
+      if (j > 0)
+        REQUIRE(distances(j, i) >= distances(j - 1, i));
+    }
+  }
+}
+
+/**
+ * Adding the reference set by batches to an index trained on a sample must
+ * give the same index as adding it at once, and a serialized index must give
+ * the same results.
+ */
+TEST_CASE("IVFPQAddBatchesTest", "[ProductQuantizationTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(6, 2000);
+  arma::mat queryData = arma::randu<arma::mat>(6, 50);
+
+  IVFPQSearch<> ivfpq;
+  REQUIRE_THROWS_AS(ivfpq.Add(referenceData), std::runtime_error);
+
+  ivfpq.Train(referenceData.cols(0, 999), 8, 3, 32, 2);
+  IVFPQSearch<> batchIvfpq(ivfpq);
+  ivfpq.Add(referenceData);
+  batchIvfpq.Add(referenceData.cols(0, 1199));
+  batchIvfpq.Add(referenceData.cols(1200, 1999));
+  REQUIRE(batchIvfpq.NumPoints() == 2000);
+
+  arma::Mat<size_t> neighbors, batchNeighbors;
+  arma::mat distances, batchDistances;
+  ivfpq.Search(queryData, 5, neighbors, distances, 3);
+  batchIvfpq.Search(queryData, 5, batchNeighbors, batchDistances, 3);
+  CheckMatrices(neighbors, batchNeighbors);
+  CheckMatrices(distances, batchDistances);
+
+  IVFPQSearch<> xmlIvfpq, jsonIvfpq, binaryIvfpq;
+  SerializeObjectAll(ivfpq, xmlIvfpq, jsonIvfpq, binaryIvfpq);
+  jsonIvfpq.Search(queryData, 5, batchNeighbors, batchDistances, 3);
+  CheckMatrices(neighbors, batchNeighbors);
+  CheckMatrices(distances, batchDistances, 1e-5);
+  binaryIvfpq.Search(queryData, 5, batchNeighbors, batchDistances, 3);
+  CheckMatrices(neighbors, batchNeighbors);
+  CheckMatrices(distances, batchDistances);
+
+  // The parameters must be checked.
+  REQUIRE_THROWS_AS(ivfpq.Search(queryData, 5, neighbors, distances, 0),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(ivfpq.Search(queryData, referenceData, 5, neighbors,
+      distances, 1, 4), std::invalid_argument);
+  REQUIRE_THROWS_AS(ivfpq.Search(queryData, referenceData.cols(0, 99), 5,
+      neighbors, distances, 1, 10), std::invalid_argument);
+  REQUIRE_THROWS_AS(ivfpq.Add(arma::mat(5, 10, arma::fill::randu)),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(ProductQuantizer<>(referenceData, 3, 300),
+      std::invalid_argument);
+}
@@ -431,3 +431,149 @@ TEST_CASE("CartPoleWithCategoricalDQN", "[QLearningTest]")
   }
   REQUIRE(converged);
 }
+
+//! Test DQN in Cart Pole task with several copies of the environment that are
+//! stepped in lockstep.
+TEST_CASE("CartPoleWithVectorizedDQN", "[QLearningTest]")
+{
+  // The states of all the copies are packed as one matrix.
+  VectorizedEnvironment<CartPole> environments(CartPole(), 4);
+  arma::mat states;
+  environments.Encode(states);
+  REQUIRE(states.n_rows == CartPole::State::dimension);
+  REQUIRE(states.n_cols == 4);
+
+  // Set up the network.
+  SimpleDQN<> network(128, 128, 2);
+
+  // Set up the policy and replay method.
+  GreedyPolicy<CartPole> policy(1.0, 1000, 0.1, 0.99);
+  RandomReplay<CartPole> replayMethod(10, 10000);
+
+  // Setting all training hyperparameters.
+  TrainingConfig config;
+  config.StepSize() = 0.01;
+  config.Discount() = 0.9;
+  config.TargetNetworkSyncInterval() = 100;
+  config.ExplorationSteps() = 100;
+  config.DoubleQLearning() = false;
+  config.StepLimit() = 200;
+
+  // Set up DQN agent.
+  QLearning<CartPole, decltype(network), AdamUpdate, decltype(policy)>
+      agent(config, network, policy, replayMethod);
+
+  // Train until the average return of the last 50 episodes is high enough.
+  std::vector<double> returns;
+  bool converged = false;
+  for (size_t i = 0; i < 50000 && !converged; ++i)
+  {
+    const std::vector<double> completed = agent.Steps(environments, 1);
+    returns.insert(returns.end(), completed.begin(), completed.end());
+    if (returns.size() >= 50)
+    {
+      const double averageReturn = std::accumulate(returns.end() - 50,
+          returns.end(), 0.0) / 50;
+      converged = (averageReturn > 40);
+    }
+  }
+
+  // Every step takes one transition from each copy.
+  REQUIRE(agent.TotalSteps() % 4 == 0);
+  REQUIRE(converged);
+
+  // N-step replay cannot be used with several copies of the environment.
+  RandomReplay<CartPole> nStepReplay(10, 10000, 3);
+  QLearning<CartPole, decltype(network), AdamUpdate, decltype(policy)>
+      nStepAgent(config, network, policy, nStepReplay);
+  REQUIRE_THROWS_AS(nStepAgent.Steps(environments, 1), std::invalid_argument);
+}
+
+//! Make sure that the softmax over the atoms matches the softmax layer, and
+//! that its gradient matches the gradient of the layer.
+TEST_CASE("CategoricalDQNAtomSoftmax", "[QLearningTest]")
+{
+  const size_t atomSize = 11;
+  const arma::mat logits = 100 * arma::randn<arma::mat>(3 * atomSize, 8);
+  const arma::mat gy = arma::randn<arma::mat>(arma::size(logits));
+
+  arma::mat probabilities, logProbabilities, g;
+  AtomSoftmax(logits, atomSize, probabilities, &logProbabilities);
+  AtomSoftmaxBackward(probabilities, gy, atomSize, g);
+
+  Softmax softmax;
+  for (size_t i = 0; i < logits.n_rows; i += atomSize)
+  {
+    arma::mat expected, expectedGrad;
+    softmax.Forward(logits.rows(i, i + atomSize - 1), expected);
+    softmax.Backward({}, expected, gy.rows(i, i + atomSize - 1),
+        expectedGrad);
+
+    REQUIRE(arma::approx_equal(probabilities.rows(i, i + atomSize - 1),
+        expected, "absdiff", 1e-12));
+    REQUIRE(arma::approx_equal(g.rows(i, i + atomSize - 1), expectedGrad,
+        "absdiff", 1e-12));
+  }
+
+  // The log-probabilities are finite even where the probabilities underflow.
+  REQUIRE(logProbabilities.is_finite());
+  const arma::uvec large = arma::find(probabilities > 1e-300);
+  REQUIRE(arma::approx_equal(arma::exp(logProbabilities.elem(large)),
+      probabilities.elem(large), "reldiff", 1e-10));
+
+  REQUIRE_THROWS_AS(AtomSoftmax(logits, 4, probabilities),
+      std::invalid_argument);
+}
+
+//! Make sure that the projection of the distributional Bellman update matches
+//! a direct computation, and keeps all the probability mass.
+TEST_CASE("CategoricalDQNProjectDistribution", "[QLearningTest]")
+{
+  const size_t atomSize = 51;
+  const double vMin = -10.0;
+  const double vMax = 10.0;
+  const double discount = 0.9;
+  const size_t batchSize = 20;
+
+  arma::mat nextDist = arma::randu<arma::mat>(atomSize, batchSize);
+  nextDist.each_row() /= arma::sum(nextDist, 0);
+  arma::rowvec rewards = 4 * arma::randn<arma::rowvec>(batchSize);
+  // Some rewards move the atoms exactly onto the support, or out of it.
+  rewards[0] = 0.0;
+  rewards[1] = 50.0;
+  rewards[2] = -50.0;
+  arma::irowvec isTerminal = arma::randi<arma::irowvec>(batchSize,
+      arma::distr_param(0, 1));
+  isTerminal[0] = 1;
+
+  arma::mat projDist;
+  ProjectDistribution(nextDist, rewards, isTerminal, discount, vMin, vMax,
+      projDist);
+
+  REQUIRE(projDist.n_rows == atomSize);
+  REQUIRE(projDist.n_cols == batchSize);
+  REQUIRE(arma::approx_equal(arma::sum(projDist, 0),
+      arma::ones<arma::rowvec>(batchSize), "absdiff", 1e-12));
+
+  const double deltaZ = (vMax - vMin) / (atomSize - 1);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    arma::vec expected(atomSize, arma::fill::zeros);
+    for (size_t j = 0; j < atomSize; ++j)
+    {
+      const double z = vMin + j * deltaZ;
+      const double tz = std::min(vMax, std::max(vMin, rewards[i] +
+          (isTerminal[i] ? 0.0 : discount * z)));
+      const double b = (tz - vMin) / deltaZ;
+      const size_t l = std::min((size_t) std::floor(b), atomSize - 1);
+      const size_t u = std::min(l + 1, atomSize - 1);
+      expected[l] += nextDist(j, i) * (1.0 - (b - l));
+      expected[u] += nextDist(j, i) * (b - l);
+    }
+
+    REQUIRE(arma::approx_equal(projDist.col(i), expected, "absdiff", 1e-10));
+  }
+
+  // A terminal transition with zero reward puts all its mass on the atom at 0.
+  REQUIRE(projDist((atomSize - 1) / 2, 0) == Approx(1.0).epsilon(1e-10));
+}
@@ -240,3 +240,39 @@ TEST_CASE("QDAFNSparseTest", "[QDAFNTest]")
   REQUIRE(distances.n_rows == 3);
   REQUIRE(distances.n_cols == 1000);
 }
+
+/**
+ * Make sure that a search on 32-bit floats returns valid, distinct neighbors
+ * with correct distances.
+ */
+TEST_CASE("QDAFNFloatTest", "[QDAFNTest]")
+{
+  arma::fmat uniformSet = arma::randu<arma::fmat>(25, 1000);
+
+  QDAFN<arma::fmat> qdafn(uniformSet, 10, 30);
+
+  arma::Mat<size_t> neighbors;
+  arma::fmat distances;
+  qdafn.Search(uniformSet, 3, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == 3);
+  REQUIRE(neighbors.n_cols == 1000);
+  REQUIRE(distances.n_rows == 3);
+  REQUIRE(distances.n_cols == 1000);
+
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    for (size_t j = 0; j < 3; ++j)
+    {
+      REQUIRE(neighbors(j, i) < 1000);
+      const float d = EuclideanDistance::Evaluate(uniformSet.col(i),
+          uniformSet.col(neighbors(j, i)));
+      REQUIRE(distances(j, i) == Approx(d).epsilon(1e-5));
+    }
+
+    REQUIRE(neighbors(0, i) != neighbors(1, i));
+    REQUIRE(neighbors(1, i) != neighbors(2, i));
+    REQUIRE(distances(0, i) >= distances(1, i));
+    REQUIRE(distances(1, i) >= distances(2, i));
+  }
+}
@@ -607,3 +607,427 @@ TEST_CASE("ExtraTreesAccuracyTest", "[RandomForestTest]")
 
   REQUIRE(accuracy >= 0.85);
 }
+
+/**
+ * Make sure that a FlatForest gives the same predictions and probabilities as
+ * the forest it was built from, also after serialization.
+ */
+TEST_CASE("FlatForestNumericTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+
+  RandomForest<> rf(dataset, labels, 3, 20 /* 20 trees */, 1);
+  FlatForest flat(rf);
+
+  REQUIRE(flat.NumTrees() == 20);
+  REQUIRE(flat.NumClasses() == 3);
+  REQUIRE(flat.Dimensionality() <= dataset.n_rows);
+
+  arma::Row<size_t> rfPredictions, flatPredictions;
+  arma::mat rfProbabilities, flatProbabilities;
+  rf.Classify(dataset, rfPredictions, rfProbabilities);
+  flat.Classify(dataset, flatPredictions, flatProbabilities);
+
+  CheckMatrices(rfPredictions, flatPredictions);
+  CheckMatrices(rfProbabilities, flatProbabilities);
+
+  // Single points should give the same results.
+  for (size_t i = 0; i < dataset.n_cols; i += 10)
+  {
+    size_t prediction;
+    arma::vec probabilities;
+    flat.Classify(dataset.col(i), prediction, probabilities);
+
+    REQUIRE(prediction == rfPredictions[i]);
+    REQUIRE(flat.Classify(dataset.col(i)) == rfPredictions[i]);
+    CheckMatrices(probabilities, arma::vec(rfProbabilities.col(i)));
+  }
+
+  // Now serialize the flattened forest.
+  RandomForest<> otherForest(dataset, labels, 3, 3, 5);
+  FlatForest xmlFlat, jsonFlat, binaryFlat(otherForest);
+  SerializeObjectAll(flat, xmlFlat, jsonFlat, binaryFlat);
+
+  arma::Row<size_t> xmlPredictions, jsonPredictions, binaryPredictions;
+  arma::mat xmlProbabilities, jsonProbabilities, binaryProbabilities;
+  xmlFlat.Classify(dataset, xmlPredictions, xmlProbabilities);
+  jsonFlat.Classify(dataset, jsonPredictions, jsonProbabilities);
+  binaryFlat.Classify(dataset, binaryPredictions, binaryProbabilities);
+
+  CheckMatrices(rfPredictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+  CheckMatrices(rfProbabilities, xmlProbabilities, jsonProbabilities,
+      binaryProbabilities);
+
+  // An empty forest cannot classify anything, and points must have all the
+  // dimensions the trees split on.
+  FlatForest empty;
+  REQUIRE_THROWS_AS(empty.Classify(dataset, flatPredictions),
+      std::invalid_argument);
+  if (flat.Dimensionality() > 1)
+  {
+    arma::mat tooSmall = dataset.rows(0, flat.Dimensionality() - 2);
+    REQUIRE_THROWS_AS(flat.Classify(tooSmall, flatPredictions),
+        std::invalid_argument);
+  }
+}
+
+/**
+ * Make sure that a FlatForest gives the same predictions and probabilities as
+ * the forest it was built from for categorical data and random splits.
+ */
+TEST_CASE("FlatForestCategoricalTest", "[RandomForestTest]")
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  RandomForest<> rf(d, di, l, 5, 10 /* 10 trees */, 1, 1e-7, 0,
+      MultipleRandomDimensionSelect(4));
+  ExtraTrees<> et(d, di, l, 5, 10 /* 10 trees */, 1);
+
+  arma::Row<size_t> predictions, flatPredictions;
+  arma::mat probabilities, flatProbabilities;
+
+  FlatForest flat(rf);
+  rf.Classify(d, predictions, probabilities);
+  flat.Classify(d, flatPredictions, flatProbabilities);
+  CheckMatrices(predictions, flatPredictions);
+  CheckMatrices(probabilities, flatProbabilities);
+
+  flat.Flatten(et);
+  REQUIRE(flat.NumTrees() == 10);
+  et.Classify(d, predictions, probabilities);
+  flat.Classify(d, flatPredictions, flatProbabilities);
+  CheckMatrices(predictions, flatPredictions);
+  CheckMatrices(probabilities, flatProbabilities);
+}
+
+/**
+ * Make sure that the C++ code exported by a FlatForest has a Predict() function
+ * for each tree and every split of the forest, and that invalid exports throw.
+ */
+TEST_CASE("FlatForestExportCppTest", "[RandomForestTest]")
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  RandomForest<> rf(d, di, l, 5, 3 /* 3 trees */, 1, 1e-7, 4);
+  FlatForest flat(rf);
+
+  std::ostringstream stream;
+  flat.ExportCpp(stream, "exported_forest");
+  const std::string code = stream.str();
+
+  REQUIRE(code.find("#ifndef MLPACK_EXPORTED_MODEL_EXPORTED_FOREST_HPP") !=
+      std::string::npos);
+  REQUIRE(code.find("namespace exported_forest {") != std::string::npos);
+  REQUIRE(code.find("static const std::size_t NumClasses = 5;") !=
+      std::string::npos);
+  REQUIRE(code.find("inline std::size_t Predict(const double* point") !=
+      std::string::npos);
+  for (size_t t = 0; t < 3; ++t)
+  {
+    REQUIRE(code.find("inline std::size_t Tree" + std::to_string(t) +
+        "(const double* point)") != std::string::npos);
+  }
+  REQUIRE(code.find("Tree3") == std::string::npos);
+
+  // The trees split on either numeric or categorical dimensions.
+  REQUIRE((code.find("] <= ") != std::string::npos ||
+           code.find("switch (") != std::string::npos));
+
+  REQUIRE_THROWS_AS(flat.ExportCpp(stream, "1forest"), std::invalid_argument);
+  REQUIRE_THROWS_AS(flat.ExportCpp(stream, "my-forest"),
+      std::invalid_argument);
+
+  FlatForest empty;
+  REQUIRE_THROWS_AS(empty.ExportCpp(stream), std::invalid_argument);
+}
+
+/**
+ * Make sure that splitting a quantized dimension between two buckets is the
+ * same as splitting the original dimension at the split point of the buckets.
+ */
+TEST_CASE("QuantizeDatasetTest", "[RandomForestTest]")
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  arma::Mat<unsigned char> quantized;
+  std::vector<arma::vec> splitPoints;
+  QuantizeDataset(d, di, true, quantized, splitPoints);
+
+  REQUIRE(quantized.n_rows == d.n_rows);
+  REQUIRE(quantized.n_cols == d.n_cols);
+  REQUIRE(splitPoints.size() == d.n_rows);
+  for (size_t dim = 0; dim < d.n_rows; ++dim)
+  {
+    if (di.Type(dim) == data::Datatype::categorical)
+    {
+      REQUIRE(splitPoints[dim].n_elem == 0);
+      for (size_t i = 0; i < d.n_cols; ++i)
+        REQUIRE(quantized(dim, i) == (unsigned char) d(dim, i));
+      continue;
+    }
+
+    REQUIRE(splitPoints[dim].n_elem > 1);
+    REQUIRE(splitPoints[dim].n_elem <= 256);
+    for (size_t b = 0; b < splitPoints[dim].n_elem; ++b)
+    {
+      for (size_t i = 0; i < d.n_cols; ++i)
+      {
+        REQUIRE((quantized(dim, i) <= b) ==
+            (d(dim, i) <= splitPoints[dim][b]));
+      }
+    }
+  }
+}
+
+/**
+ * Make sure that a forest trained on quantized data classifies the original
+ * points about as well as a forest trained on the original data.
+ */
+TEST_CASE("QuantizedNumericLearningTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+
+  RandomForest<> rf(dataset, labels, 3, 20 /* 20 trees */, 1, 1e-7);
+  RandomForest<> quantizedRf;
+  const double gain = quantizedRf.TrainQuantized(dataset, labels, 3,
+      20 /* 20 trees */, 1, 1e-7);
+  REQUIRE(quantizedRf.NumTrees() == 20);
+  REQUIRE(std::isfinite(gain));
+
+  arma::mat testDataset;
+  if (!data::Load("vc2_test.csv", testDataset))
+    FAIL("Cannot load dataset vc2_test.csv");
+  arma::Row<size_t> testLabels;
+  if (!data::Load("vc2_test_labels.txt", testLabels))
+    FAIL("Cannot load dataset vc2_test_labels.txt");
+
+  arma::Row<size_t> rfPredictions, quantizedPredictions;
+  rf.Classify(testDataset, rfPredictions);
+  quantizedRf.Classify(testDataset, quantizedPredictions);
+
+  const size_t rfCorrect = accu(rfPredictions == testLabels);
+  const size_t quantizedCorrect = accu(quantizedPredictions == testLabels);
+
+  REQUIRE(quantizedCorrect >= rfCorrect * 0.9);
+  REQUIRE(quantizedCorrect >= size_t(0.7 * testDataset.n_cols));
+
+  // Warm-starting adds trees to the forest.
+  quantizedRf.TrainQuantized(dataset, labels, 3, 5 /* 5 trees */, 1, 1e-7, 0,
+      true);
+  REQUIRE(quantizedRf.NumTrees() == 25);
+}
+
+/**
+ * Make sure that quantized training works with categorical data, and with
+ * ExtraTrees, which do not bootstrap.
+ */
+TEST_CASE("QuantizedCategoricalLearningTest", "[RandomForestTest]")
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  // Split into a training set and a test set.
+  arma::mat trainingData = d.cols(0, 1999);
+  arma::mat testData = d.cols(2000, 3999);
+  arma::Row<size_t> trainingLabels = l.subvec(0, 1999);
+  arma::Row<size_t> testLabels = l.subvec(2000, 3999);
+
+  RandomForest<> rf;
+  rf.TrainQuantized(trainingData, di, trainingLabels, 5, 25 /* 25 trees */, 1,
+      1e-7, 0, false, MultipleRandomDimensionSelect(4));
+  ExtraTrees<> et;
+  et.TrainQuantized(trainingData, di, trainingLabels, 5, 25 /* 25 trees */, 1);
+
+  arma::Row<size_t> rfPredictions, etPredictions;
+  rf.Classify(testData, rfPredictions);
+  et.Classify(testData, etPredictions);
+
+  REQUIRE(accu(rfPredictions == testLabels) >= size_t(0.7 * testData.n_cols));
+  REQUIRE(et.NumTrees() == 25);
+  REQUIRE(accu(etPredictions == testLabels) >= size_t(0.6 * testData.n_cols));
+
+  // Categorical dimensions with more than 256 categories cannot be quantized.
+  data::DatasetInfo bigInfo(1);
+  bigInfo.Type(0) = data::Datatype::categorical;
+  for (size_t c = 0; c < 300; ++c)
+    bigInfo.MapString<double>(std::to_string(c), 0);
+  arma::mat bigData = arma::trans(arma::regspace(0, 299));
+  arma::Row<size_t> bigLabels(300, arma::fill::zeros);
+  REQUIRE_THROWS_AS(rf.TrainQuantized(bigData, bigInfo, bigLabels, 1, 1),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that forests trained with tree seeds on consecutive ranges of tree
+ * indices merge into the same forest as one trained with all the trees.
+ */
+TEST_CASE("RandomForestTreeSeedsMergeTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+
+  RandomForest<> rf;
+  rf.SetTreeSeeds(42);
+  rf.Train(dataset, labels, 3, 8 /* 8 trees */, 1, 1e-7);
+
+  RandomForest<> firstRf, lastRf;
+  firstRf.SetTreeSeeds(42);
+  firstRf.Train(dataset, labels, 3, 5 /* 5 trees */, 1, 1e-7);
+  lastRf.SetTreeSeeds(42, 5);
+  lastRf.Train(dataset, labels, 3, 3 /* 3 trees */, 1, 1e-7);
+
+  firstRf.Merge(std::move(lastRf));
+  REQUIRE(firstRf.NumTrees() == 8);
+  REQUIRE(lastRf.NumTrees() == 0);
+
+  arma::mat testDataset;
+  if (!data::Load("vc2_test.csv", testDataset))
+    FAIL("Cannot load dataset vc2_test.csv");
+
+  arma::Row<size_t> predictions, mergedPredictions;
+  arma::mat probabilities, mergedProbabilities;
+  rf.Classify(testDataset, predictions, probabilities);
+  firstRf.Classify(testDataset, mergedPredictions, mergedProbabilities);
+
+  CheckMatrices(predictions, mergedPredictions);
+  CheckMatrices(probabilities, mergedProbabilities);
+
+  // Forests for different numbers of classes cannot be merged.
+  RandomForest<> otherRf(dataset, labels, 4, 2 /* 2 trees */, 1, 1e-7);
+  REQUIRE_THROWS_AS(firstRf.Merge(otherRf), std::invalid_argument);
+}
+
+/**
+ * Make sure that a forest refreshed with a warm start, whose oldest trees are
+ * removed, is the same as a forest trained with the remaining trees only, and
+ * that the next trees don't reuse the seeds of the remaining ones.
+ */
+TEST_CASE("RandomForestRemoveOldestTreesTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+  arma::mat testDataset;
+  if (!data::Load("vc2_test.csv", testDataset))
+    FAIL("Cannot load dataset vc2_test.csv");
+
+  RandomForest<> rf;
+  rf.SetTreeSeeds(42);
+  rf.Train(dataset, labels, 3, 6 /* 6 trees */, 1, 1e-7);
+  rf.Train(dataset, labels, 3, 4 /* 4 trees */, 1, 1e-7, 0,
+      true /* warmStart */);
+  rf.RemoveOldestTrees(4);
+  REQUIRE(rf.NumTrees() == 6);
+
+  RandomForest<> lastRf;
+  lastRf.SetTreeSeeds(42, 4);
+  const double gain = lastRf.Train(dataset, labels, 3, 6 /* 6 trees */, 1,
+      1e-7);
+
+  arma::Row<size_t> predictions, lastPredictions;
+  arma::mat probabilities, lastProbabilities;
+  rf.Classify(testDataset, predictions, probabilities);
+  lastRf.Classify(testDataset, lastPredictions, lastProbabilities);
+  CheckMatrices(predictions, lastPredictions);
+  CheckMatrices(probabilities, lastProbabilities);
+
+  // The average gain must only count the remaining trees.
+  REQUIRE(rf.Train(dataset, labels, 3, 0 /* no trees */, 1, 1e-7, 0,
+      true /* warmStart */) == Approx(gain));
+
+  // The next tree must get the seed after the seed of the last tree.
+  RandomForest<> nextRf;
+  nextRf.SetTreeSeeds(42, 10);
+  nextRf.Train(dataset, labels, 3, 1 /* 1 tree */, 1, 1e-7);
+  rf.Train(dataset, labels, 3, 1 /* 1 tree */, 1, 1e-7, 0,
+      true /* warmStart */);
+
+  arma::Row<size_t> treePredictions, nextPredictions;
+  rf.Tree(6).Classify(testDataset, treePredictions);
+  nextRf.Tree(0).Classify(testDataset, nextPredictions);
+  CheckMatrices(treePredictions, nextPredictions);
+
+  // A serialized forest keeps the gains and the dimension information.
+  RandomForest<> xmlForest, jsonForest, binaryForest;
+  SerializeObjectAll(rf, xmlForest, jsonForest, binaryForest);
+  REQUIRE(binaryForest.TrainingInfo().Dimensionality() == dataset.n_rows);
+  binaryForest.RemoveOldestTrees(7);
+  REQUIRE(binaryForest.NumTrees() == 0);
+
+  REQUIRE_THROWS_AS(rf.RemoveOldestTrees(8), std::invalid_argument);
+}
+
+/**
+ * A warm start must be given data with the dimensions and the number of classes
+ * that the existing trees were trained with.
+ */
+TEST_CASE("RandomForestWarmStartCompatibilityTest", "[RandomForestTest]")
+{
+  arma::mat trainingData;
+  arma::Row<size_t> trainingLabels;
+  data::DatasetInfo di;
+  MockCategoricalData(trainingData, trainingLabels, di);
+
+  RandomForest<> rf(trainingData, di, trainingLabels, 5, 3 /* 3 trees */, 1,
+      1e-7, 0, MultipleRandomDimensionSelect(4));
+
+  // Different number of classes.
+  REQUIRE_THROWS_AS(rf.Train(trainingData, di, trainingLabels, 6, 2, 1, 1e-7,
+      0, true /* warmStart */, MultipleRandomDimensionSelect(4)),
+      std::invalid_argument);
+
+  // Numeric dimensions instead of categorical ones.
+  REQUIRE_THROWS_AS(rf.Train(trainingData, trainingLabels, 5, 2, 1, 1e-7, 0,
+      true /* warmStart */, MultipleRandomDimensionSelect(4)),
+      std::invalid_argument);
+
+  // Different dimensionality.
+  arma::mat largerData = arma::join_cols(trainingData,
+      arma::randu<arma::mat>(1, trainingData.n_cols));
+  data::DatasetInfo largerInfo(largerData.n_rows);
+  for (size_t d = 0; d < di.Dimensionality(); ++d)
+    largerInfo.Type(d) = di.Type(d);
+  REQUIRE_THROWS_AS(rf.Train(largerData, largerInfo, trainingLabels, 5, 2, 1,
+      1e-7, 0, true /* warmStart */, MultipleRandomDimensionSelect(4)),
+      std::invalid_argument);
+  REQUIRE(rf.NumTrees() == 3);
+
+  // The same kind of data can be used.
+  rf.Train(trainingData, di, trainingLabels, 5, 2 /* 2 trees */, 1, 1e-7, 0,
+      true /* warmStart */, MultipleRandomDimensionSelect(4));
+  REQUIRE(rf.NumTrees() == 5);
+
+  // Without a warm start, any data can be used.
+  rf.Train(largerData, trainingLabels, 6, 2 /* 2 trees */, 1, 1e-7);
+  REQUIRE(rf.NumTrees() == 2);
+  REQUIRE(rf.TrainingInfo().Dimensionality() == largerData.n_rows);
+}
@@ -0,0 +1,124 @@
+/**
+ * @file tests/random_fourier_features_test.cpp
+ *
+ * Test the RandomFourierFeatures class and its kernel rule for KernelPCA.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/random_fourier_features.hpp>
+#include <mlpack/methods/kernel_pca.hpp>
+
+#include "catch.hpp"
+#include "serialization.hpp"
+
+using namespace mlpack;
+
+/**
+ * Check that the dot products of the features of the given dataset approximate
+ * the kernel matrix.
+ */
+template<typename KernelType>
+void CheckKernelApproximation(const KernelType& kernel)
+{
+  arma::mat dataset = arma::randn<arma::mat>(4, 100);
+
+  RandomFourierFeatures<KernelType> rff(20000, kernel);
+  rff.Fit(dataset);
+
+  arma::mat features;
+  rff.Transform(dataset, features);
+  REQUIRE(features.n_rows == 20000);
+  REQUIRE(features.n_cols == 100);
+
+  arma::mat kernelMatrix;
+  KernelMatrix(kernel, dataset, kernelMatrix);
+
+  // The error of each element is about 1 / sqrt(D) = 0.007.
+  const arma::mat approximation = features.t() * features;
+  REQUIRE(arma::abs(approximation - kernelMatrix).max() < 0.05);
+}
+
+/**
+ * The features must approximate the Gaussian, Laplacian and Cauchy kernels.
+ */
+TEST_CASE("RandomFourierFeaturesApproximationTest",
+          "[RandomFourierFeaturesTest]")
+{
+  CheckKernelApproximation(GaussianKernel(1.5));
+  CheckKernelApproximation(LaplacianKernel(2.0));
+  CheckKernelApproximation(CauchyKernel(1.5));
+}
+
+/**
+ * Transforming a dataset by batches, sparse or not, or with a serialized model
+ * must give the same features as transforming it at once.
+ */
+TEST_CASE("RandomFourierFeaturesBatchTest", "[RandomFourierFeaturesTest]")
+{
+  arma::sp_mat sparseDataset;
+  sparseDataset.sprandu(10, 200, 0.2);
+  const arma::mat dataset(sparseDataset);
+
+  arma::mat features, batchFeatures, sparseFeatures;
+  RandomFourierFeatures<GaussianKernel> rff(50);
+  REQUIRE_THROWS_AS(rff.Transform(dataset, features), std::runtime_error);
+  rff.Fit(dataset);
+
+  rff.Transform(dataset, features);
+  rff.Transform(dataset.cols(100, 199), batchFeatures);
+  rff.Transform(sparseDataset, sparseFeatures);
+
+  REQUIRE(arma::approx_equal(batchFeatures, features.cols(100, 199), "absdiff",
+      1e-12));
+  REQUIRE(arma::approx_equal(sparseFeatures, features, "absdiff", 1e-12));
+
+  RandomFourierFeatures<GaussianKernel> xmlRff, jsonRff, binaryRff;
+  SerializeObjectAll(rff, xmlRff, jsonRff, binaryRff);
+
+  arma::mat xmlFeatures, jsonFeatures, binaryFeatures;
+  xmlRff.Transform(dataset, xmlFeatures);
+  jsonRff.Transform(dataset, jsonFeatures);
+  binaryRff.Transform(dataset, binaryFeatures);
+  REQUIRE(arma::approx_equal(xmlFeatures, features, "absdiff", 1e-10));
+  REQUIRE(arma::approx_equal(jsonFeatures, features, "absdiff", 1e-10));
+  REQUIRE(arma::approx_equal(binaryFeatures, features, "absdiff", 1e-10));
+
+  // The dimensionality of the points must match.
+  REQUIRE_THROWS_AS(rff.Transform(arma::mat(5, 10, arma::fill::randu),
+      features), std::invalid_argument);
+}
+
+/**
+ * KernelPCA with random Fourier features should turn three concentric rings
+ * into a linearly separable dataset in one dimension, like the exact kernel
+ * matrix does.
+ */
+TEST_CASE("RandomFourierFeaturesKernelPCATest", "[RandomFourierFeaturesTest]")
+{
+  arma::mat dataset;
+  dataset.randn(3, 750);
+  dataset *= 0.05;
+
+  // Push the second and the third 250 points away from the origin by 2 and 5.
+  for (size_t i = 250; i < 750; ++i)
+  {
+    const double radius = (i < 500) ? 2.0 : 5.0;
+    dataset.col(i) += radius * arma::normalise(dataset.col(i));
+  }
+
+  KernelPCA<GaussianKernel, RandomFourierFeaturesKernelRule<GaussianKernel>> p;
+  p.Apply(dataset, 1);
+  REQUIRE(dataset.n_rows == 1);
+
+  Range ranges[3];
+  for (size_t i = 0; i < 750; ++i)
+    ranges[i / 250] |= dataset(0, i);
+
+  REQUIRE(ranges[0].Contains(ranges[1]) == false);
+  REQUIRE(ranges[0].Contains(ranges[2]) == false);
+  REQUIRE(ranges[1].Contains(ranges[2]) == false);
+}
@@ -59,3 +59,46 @@ TEST_CASE("RandomizedSVDReconstructionError", "[RandomizedSVDTest]")
       arma::norm(centeredData, "frob");
   REQUIRE(error == Approx(0.0).margin(1e-5));
 }
+
+/**
+ * Make sure that sparse and single-precision data give the same factorization
+ * as dense double-precision data.
+ */
+TEMPLATE_TEST_CASE("RandomizedSVDSparseAndFloatTest", "[RandomizedSVDTest]",
+    float, double)
+{
+  typedef TestType eT;
+
+  // Wide and tall matrices take different paths.
+  for (const size_t cols : { 300, 40 })
+  {
+    arma::SpMat<eT> data;
+    data.sprandu(100, cols, 0.1);
+    const arma::Mat<eT> dense(data);
+
+    arma::Mat<eT> U1, U2, V1, V2;
+    arma::Col<eT> s1, s2;
+
+    RandomSeed(12);
+    RandomizedSVD rSVD(0, 4);
+    rSVD.Apply(dense, U1, s1, V1, 5);
+
+    RandomSeed(12);
+    rSVD.Apply(data, U2, s2, V2, 5);
+
+    REQUIRE(s1.n_elem == s2.n_elem);
+    REQUIRE(U2.n_rows == 100);
+    REQUIRE(V2.n_rows == cols);
+
+    // The dense version adds a small epsilon to the mean, so the results are
+    // only approximately equal.
+    const double tolerance = std::is_same<eT, float>::value ? 1e-3 : 1e-5;
+    REQUIRE(arma::norm(s1 - s2) / arma::norm(s1) < tolerance);
+
+    // The products of the singular vectors and values should match, for both
+    // signs of the singular vectors.
+    const arma::Mat<eT> r1 = U1 * arma::diagmat(s1) * V1.t();
+    const arma::Mat<eT> r2 = U2 * arma::diagmat(s2) * V2.t();
+    REQUIRE(arma::norm(r1 - r2, "fro") / arma::norm(r1, "fro") < tolerance);
+  }
+}
@@ -14,6 +14,7 @@
 #include <mlpack/methods/range_search/rs_model.hpp>
 
 #include "catch.hpp"
+#include "serialization.hpp"
 #include "test_catch_tools.hpp"
 
 using namespace mlpack;
@@ -605,6 +606,48 @@ TEST_CASE("SingleTreeVsNaive", "[RangeSearchTest]")
   }
 }
 
+/**
+ * Test the single-tree range search method with the naive method, with a
+ * separate query set and more query points than a thread handles at once, so
+ * that the query points are split between threads.
+ */
+TEST_CASE("SingleTreeVsNaiveQuerySet", "[RangeSearchTest]")
+{
+  arma::mat referenceData(3, 1000, arma::fill::randu);
+  arma::mat queryData(3, 500, arma::fill::randu);
+
+  RangeSearch<> single(referenceData, false, true);
+  RangeSearch<> naive(referenceData, true);
+
+  vector<vector<size_t>> neighborsSingle, neighborsNaive;
+  vector<vector<double>> distancesSingle, distancesNaive;
+  single.Search(queryData, Range(0.1, 0.3), neighborsSingle, distancesSingle);
+  naive.Search(queryData, Range(0.1, 0.3), neighborsNaive, distancesNaive);
+
+  vector<vector<pair<double, size_t>>> sortedTree, sortedNaive;
+  SortResults(neighborsSingle, distancesSingle, sortedTree);
+  SortResults(neighborsNaive, distancesNaive, sortedNaive);
+
+  REQUIRE(sortedTree.size() == queryData.n_cols);
+  REQUIRE(sortedNaive.size() == queryData.n_cols);
+  for (size_t i = 0; i < sortedTree.size(); ++i)
+  {
+    REQUIRE(sortedTree[i].size() == sortedNaive[i].size());
+
+    for (size_t j = 0; j < sortedTree[i].size(); ++j)
+    {
+      REQUIRE(sortedTree[i][j].second == sortedNaive[i][j].second);
+      REQUIRE(sortedTree[i][j].first ==
+          Approx(sortedNaive[i][j].first).epsilon(1e-7));
+    }
+  }
+
+  // The counters of all threads are summed.
+  REQUIRE(naive.BaseCases() == queryData.n_cols * referenceData.n_cols);
+  REQUIRE(single.BaseCases() > 0);
+  REQUIRE(single.Scores() > 0);
+}
+
 /**
  * Ensure that dual tree range search with cover trees works by comparing
  * with the kd-tree implementation.
@@ -1074,6 +1117,18 @@ TEST_CASE("EmptySearchTest", "[RangeSearchTest]")
   REQUIRE(neighbors.size() == 0);
   REQUIRE(distances.size() == 0);
 
+  // The CSR results should hold no points.
+  arma::Col<size_t> offsets, csrNeighbors, counts;
+  arma::vec csrDistances;
+  rs.Search(Range(0.0, 10.0), offsets, csrNeighbors, csrDistances);
+  rs.Count(Range(0.0, 10.0), counts);
+
+  REQUIRE(offsets.n_elem == 1);
+  REQUIRE(offsets[0] == 0);
+  REQUIRE(csrNeighbors.n_elem == 0);
+  REQUIRE(csrDistances.n_elem == 0);
+  REQUIRE(counts.n_elem == 0);
+
   // Now check with a query set.
   arma::mat querySet = arma::randu<arma::mat>(3, 100);
 
@@ -1434,6 +1489,142 @@ TEST_CASE("RSModelMonochromaticTest", "[RangeSearchTest]")
   }
 }
 
+/**
+ * Make sure that RSModel selects FixedLMetric for kd-trees on 2-, 3- and
+ * 4-dimensional data, and that it gives the same results as a search with
+ * EuclideanDistance, also after serialization.
+ */
+TEST_CASE("RSModelFixedLMetricTest", "[RangeSearchTest]")
+{
+  util::Timers timers;
+
+  for (size_t dim = 1; dim <= 5; ++dim)
+  {
+    arma::mat referenceData = arma::randu<arma::mat>(dim, 200);
+    arma::mat queryData = arma::randu<arma::mat>(dim, 50);
+    const Range range(0.05, 0.3);
+
+    RangeSearch<> rs(referenceData);
+    vector<vector<size_t>> baselineNeighbors;
+    vector<vector<double>> baselineDistances;
+    rs.Search(queryData, range, baselineNeighbors, baselineDistances);
+    vector<vector<pair<double, size_t>>> baselineSorted;
+    SortResults(baselineNeighbors, baselineDistances, baselineSorted);
+
+    for (size_t naive = 0; naive < 2; ++naive)
+    {
+      RSModel model(RSModel::TreeTypes::KD_TREE);
+      model.BuildModel(timers, arma::mat(referenceData), 5, (naive == 1),
+          false);
+      REQUIRE(model.FixedDimension() == ((dim >= 2 && dim <= 4) ? dim : 0));
+
+      RSModel xmlModel, jsonModel, binaryModel;
+      SerializeObjectAll(model, xmlModel, jsonModel, binaryModel);
+      REQUIRE(xmlModel.FixedDimension() == model.FixedDimension());
+      REQUIRE(jsonModel.FixedDimension() == model.FixedDimension());
+      REQUIRE(binaryModel.FixedDimension() == model.FixedDimension());
+
+      RSModel* models[2] = { &model, &binaryModel };
+      for (size_t m = 0; m < 2; ++m)
+      {
+        vector<vector<size_t>> neighbors;
+        vector<vector<double>> distances;
+        models[m]->Search(timers, arma::mat(queryData), range, neighbors,
+            distances);
+
+        vector<vector<pair<double, size_t>>> sorted;
+        SortResults(neighbors, distances, sorted);
+
+        REQUIRE(sorted.size() == baselineSorted.size());
+        for (size_t k = 0; k < sorted.size(); ++k)
+        {
+          REQUIRE(sorted[k].size() == baselineSorted[k].size());
+          for (size_t l = 0; l < sorted[k].size(); ++l)
+          {
+            REQUIRE(sorted[k][l].second == baselineSorted[k][l].second);
+            REQUIRE(sorted[k][l].first ==
+                Approx(baselineSorted[k][l].first).epsilon(1e-7));
+          }
+        }
+      }
+
+      // A query set of another dimensionality must be rejected.
+      if (model.FixedDimension() != 0)
+      {
+        vector<vector<size_t>> neighbors;
+        vector<vector<double>> distances;
+        REQUIRE_THROWS_AS(model.Search(timers, arma::mat(dim + 1, 10), range,
+            neighbors, distances), std::invalid_argument);
+      }
+    }
+  }
+
+  // Other trees keep the Euclidean distance.
+  RSModel ballModel(RSModel::TreeTypes::BALL_TREE);
+  ballModel.BuildModel(timers, arma::randu<arma::mat>(3, 100), 5, false,
+      false);
+  REQUIRE(ballModel.FixedDimension() == 0);
+}
+
+/**
+ * Make sure that the ParallelDualTreeTraverser gives the same range search
+ * results as the DualTreeTraverser, for several task depths.
+ */
+TEST_CASE("RangeSearchParallelDualTreeTest", "[RangeSearchTest]")
+{
+  typedef KDTree<EuclideanDistance, RangeSearchStat, arma::mat> TreeType;
+  typedef RangeSearchRules<EuclideanDistance, TreeType> RuleType;
+
+  // Only rules with per-query results may be used by the parallel traverser.
+  REQUIRE((bool) RuleTraits<RuleType>::HasPerQueryResults == true);
+
+  arma::mat referenceData = arma::randu<arma::mat>(3, 1000);
+  arma::mat queryData = arma::randu<arma::mat>(3, 500);
+  const Range range(0.05, 0.15);
+
+  TreeType referenceTree(referenceData, 10);
+  TreeType queryTree(queryData, 10);
+  EuclideanDistance distance;
+
+  vector<vector<size_t>> serialNeighbors(queryData.n_cols);
+  vector<vector<double>> serialDistances(queryData.n_cols);
+  RuleType serialRules(referenceTree.Dataset(), queryTree.Dataset(), range,
+      serialNeighbors, serialDistances, distance);
+  TreeType::DualTreeTraverser<RuleType> serialTraverser(serialRules);
+  serialTraverser.Traverse(queryTree, referenceTree);
+
+  vector<vector<pair<double, size_t>>> serialSorted;
+  SortResults(serialNeighbors, serialDistances, serialSorted);
+
+  for (size_t depth = 0; depth < 12; depth += 3)
+  {
+    vector<vector<size_t>> neighbors(queryData.n_cols);
+    vector<vector<double>> distances(queryData.n_cols);
+    RuleType rules(referenceTree.Dataset(), queryTree.Dataset(), range,
+        neighbors, distances, distance);
+    TreeType::ParallelDualTreeTraverser<RuleType> traverser(rules, depth);
+    traverser.Traverse(queryTree, referenceTree);
+
+    // The base cases of every task must have been added back to the rules.
+    REQUIRE(rules.BaseCases() == serialRules.BaseCases());
+    REQUIRE(rules.Scores() == serialRules.Scores());
+
+    vector<vector<pair<double, size_t>>> sorted;
+    SortResults(neighbors, distances, sorted);
+
+    REQUIRE(sorted.size() == serialSorted.size());
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+      REQUIRE(sorted[i].size() == serialSorted[i].size());
+      for (size_t j = 0; j < sorted[i].size(); ++j)
+      {
+        REQUIRE(sorted[i][j].second == serialSorted[i][j].second);
+        REQUIRE(sorted[i][j].first == Approx(serialSorted[i][j].first));
+      }
+    }
+  }
+}
+
 /**
  * Make sure that the neighborPtr matrix isn't accidentally deleted.
  * See issue #478.
@@ -1712,3 +1903,188 @@ TEST_CASE("MoveOperatorNaiveTest", "[RangeSearchTest]")
     }
   }
 }
+
+// Make sure that the CSR results match the nested vector results exactly, and
+// that the counts match the number of results.
+void CheckCSRResults(const vector<vector<size_t>>& neighbors,
+                     const vector<vector<double>>& distances,
+                     const arma::Col<size_t>& offsets,
+                     const arma::Col<size_t>& csrNeighbors,
+                     const arma::vec& csrDistances,
+                     const arma::Col<size_t>& counts)
+{
+  REQUIRE(offsets.n_elem == neighbors.size() + 1);
+  REQUIRE(counts.n_elem == neighbors.size());
+  REQUIRE(offsets[0] == 0);
+  REQUIRE(csrNeighbors.n_elem == offsets[offsets.n_elem - 1]);
+  REQUIRE(csrDistances.n_elem == offsets[offsets.n_elem - 1]);
+
+  for (size_t i = 0; i < neighbors.size(); ++i)
+  {
+    REQUIRE(offsets[i + 1] - offsets[i] == neighbors[i].size());
+    REQUIRE(counts[i] == neighbors[i].size());
+
+    // The traversal is the same, so the order of the results is too.
+    for (size_t j = 0; j < neighbors[i].size(); ++j)
+    {
+      REQUIRE(csrNeighbors[offsets[i] + j] == neighbors[i][j]);
+      REQUIRE(csrDistances[offsets[i] + j] ==
+          Approx(distances[i][j]).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Test that the CSR and count-only searches give the same results as the
+ * regular search, for every search mode, with trees that rearrange the dataset
+ * and with trees whose first point is the centroid.
+ */
+TEMPLATE_TEST_CASE("RangeSearchCSRAndCountTest", "[RangeSearchTest]",
+    RangeSearch<>,
+    (RangeSearch<EuclideanDistance, arma::mat, StandardCoverTree>))
+{
+  typedef TestType RangeSearchType;
+
+  arma::mat referenceData = arma::randu<arma::mat>(3, 600);
+  arma::mat queryData = arma::randu<arma::mat>(3, 400);
+  const Range range(0.1, 0.3);
+
+  for (size_t mode = 0; mode < 3; ++mode)
+  {
+    RangeSearchType rs(referenceData, mode == 0, mode == 1);
+
+    vector<vector<size_t>> neighbors;
+    vector<vector<double>> distances;
+    arma::Col<size_t> offsets, csrNeighbors, counts;
+    arma::vec csrDistances;
+
+    // Bichromatic search.
+    rs.Search(queryData, range, neighbors, distances);
+    rs.Search(queryData, range, offsets, csrNeighbors, csrDistances);
+    rs.Count(queryData, range, counts);
+    CheckCSRResults(neighbors, distances, offsets, csrNeighbors, csrDistances,
+        counts);
+
+    // Monochromatic search.
+    rs.Search(range, neighbors, distances);
+    rs.Search(range, offsets, csrNeighbors, csrDistances);
+    rs.Count(range, counts);
+    CheckCSRResults(neighbors, distances, offsets, csrNeighbors, csrDistances,
+        counts);
+
+    // Search with a query tree.
+    if (mode == 2)
+    {
+      typename RangeSearchType::Tree queryTree(queryData);
+      rs.Search(&queryTree, range, neighbors, distances);
+      rs.Search(&queryTree, range, offsets, csrNeighbors, csrDistances);
+      rs.Count(&queryTree, range, counts);
+      CheckCSRResults(neighbors, distances, offsets, csrNeighbors, csrDistances,
+          counts);
+    }
+    else
+    {
+      typename RangeSearchType::Tree queryTree(queryData);
+      REQUIRE_THROWS_AS(rs.Count(&queryTree, range, counts),
+          std::invalid_argument);
+    }
+  }
+}
+
+/**
+ * Check that two sets of sorted results are the same.
+ */
+void CheckSortedResults(const vector<vector<pair<double, size_t>>>& sorted,
+                        const vector<vector<pair<double, size_t>>>& expected)
+{
+  REQUIRE(sorted.size() == expected.size());
+  for (size_t i = 0; i < sorted.size(); ++i)
+  {
+    REQUIRE(sorted[i].size() == expected[i].size());
+    for (size_t j = 0; j < sorted[i].size(); ++j)
+    {
+      REQUIRE(sorted[i][j].second == expected[i][j].second);
+      REQUIRE(sorted[i][j].first ==
+          Approx(expected[i][j].first).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Make sure that GridRangeSearch gives the same results as naive range search,
+ * in low dimensions, for both monochromatic and bichromatic search, and for
+ * points exactly on the boundary of the range.
+ */
+TEST_CASE("GridRangeSearchTest", "[RangeSearchTest]")
+{
+  for (size_t dims = 1; dims <= 4; ++dims)
+  {
+    arma::mat referenceData = arma::randu<arma::mat>(dims, 1500);
+    arma::mat queryData = 1.2 * arma::randu<arma::mat>(dims, 300) - 0.1;
+    // Points on a lattice have many distances equal to the end of the range.
+    if (dims == 2)
+      referenceData = arma::floor(20.0 * referenceData) / 20.0;
+
+    RangeSearch<> naive(referenceData, true);
+    GridRangeSearch<> grid(referenceData);
+
+    const Range ranges[] = { Range(0.0, 0.05), Range(0.02, 0.1),
+        Range(0.0, 0.3) };
+    for (const Range& range : ranges)
+    {
+      vector<vector<size_t>> neighbors, naiveNeighbors;
+      vector<vector<double>> distances, naiveDistances;
+      vector<vector<pair<double, size_t>>> sorted, naiveSorted;
+      arma::Col<size_t> offsets, csrNeighbors, counts;
+      arma::vec csrDistances;
+
+      // Bichromatic search.
+      grid.Search(queryData, range, neighbors, distances);
+      grid.Search(queryData, range, offsets, csrNeighbors, csrDistances);
+      grid.Count(queryData, range, counts);
+      CheckCSRResults(neighbors, distances, offsets, csrNeighbors,
+          csrDistances, counts);
+
+      naive.Search(queryData, range, naiveNeighbors, naiveDistances);
+      SortResults(neighbors, distances, sorted);
+      SortResults(naiveNeighbors, naiveDistances, naiveSorted);
+      CheckSortedResults(sorted, naiveSorted);
+
+      // Monochromatic search.
+      grid.Search(range, neighbors, distances);
+      grid.Search(range, offsets, csrNeighbors, csrDistances);
+      grid.Count(range, counts);
+      CheckCSRResults(neighbors, distances, offsets, csrNeighbors,
+          csrDistances, counts);
+
+      naive.Search(range, naiveNeighbors, naiveDistances);
+      SortResults(neighbors, distances, sorted);
+      SortResults(naiveNeighbors, naiveDistances, naiveSorted);
+      CheckSortedResults(sorted, naiveSorted);
+    }
+
+    // With a small radius, the grid should compute few of the distances.
+    arma::Col<size_t> counts;
+    grid.Count(Range(0.0, 0.05), counts);
+    REQUIRE(grid.BaseCases() < referenceData.n_cols * referenceData.n_cols / 4);
+  }
+}
+
+/**
+ * GridRangeSearch should refuse ranges it cannot build a grid for.
+ */
+TEST_CASE("GridRangeSearchInvalidRangeTest", "[RangeSearchTest]")
+{
+  GridRangeSearch<> grid(arma::randu<arma::mat>(2, 100));
+  arma::Col<size_t> counts;
+
+  REQUIRE_THROWS_AS(grid.Count(Range(0.0, 0.0), counts),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(grid.Count(Range(0.0, numeric_limits<double>::infinity()),
+      counts), std::invalid_argument);
+
+  // There are too many cells to search in many dimensions.
+  GridRangeSearch<> highDimGrid(arma::randu<arma::mat>(20, 100));
+  REQUIRE_THROWS_AS(highDimGrid.Count(Range(0.0, 0.5), counts),
+      std::invalid_argument);
+}
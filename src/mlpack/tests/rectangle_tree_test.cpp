@@ -1353,3 +1353,88 @@ TEST_CASE("RectangleTreeMoveDatasetTest", "[RectangleTreeTraitsTest]")
   REQUIRE(tree.Dataset().n_rows == 3);
   REQUIRE(tree.Dataset().n_cols == 1000);
 }
+
+/**
+ * Count the leaves under (and including) the given node.
+ */
+template<typename TreeType>
+size_t CountLeaves(const TreeType& tree)
+{
+  if (tree.IsLeaf())
+    return 1;
+
+  size_t numLeaves = 0;
+  for (size_t i = 0; i < tree.NumChildren(); ++i)
+    numLeaves += CountLeaves(tree.Child(i));
+
+  return numLeaves;
+}
+
+/**
+ * Build a tree of the given type by bulk loading it with the given order, check
+ * that the tree is valid, and check that nearest neighbor search with it gives
+ * the same results as a naive search.
+ */
+template<template<typename, typename, typename> class TreeType,
+         typename BulkLoadType>
+void CheckBulkLoad(const arma::mat& dataset)
+{
+  typedef TreeType<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> Tree;
+  Tree tree(dataset, BulkLoadType(), 20, 6, 5, 2);
+
+  REQUIRE(tree.NumDescendants() == dataset.n_cols);
+  CheckContainment(tree);
+  CheckExactContainment(tree);
+  CheckHierarchy(tree);
+  CheckNumDescendants(tree);
+  CheckFills(tree);
+  REQUIRE(GetMinLevel(tree) == GetMaxLevel(tree));
+
+  NeighborSearch<NearestNeighborSort, LMetric<2, true>, arma::mat, TreeType>
+      knn1(std::move(tree), DUAL_TREE_MODE);
+  arma::Mat<size_t> neighbors1;
+  arma::mat distances1;
+  knn1.Search(5, neighbors1, distances1);
+
+  KNN knn2(dataset, NAIVE_MODE);
+  arma::Mat<size_t> neighbors2;
+  arma::mat distances2;
+  knn2.Search(5, neighbors2, distances2);
+
+  CheckMatrices(neighbors1, neighbors2);
+  CheckMatrices(distances1, distances2);
+}
+
+// Test that bulk loaded rectangle trees are valid and give correct nearest
+// neighbor results.
+TEST_CASE("RectangleTreeBulkLoadTest", "[RectangleTreeTraitsTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+
+  CheckBulkLoad<RTree, STRBulkLoad>(dataset);
+  CheckBulkLoad<RStarTree, STRBulkLoad>(dataset);
+  CheckBulkLoad<XTree, STRBulkLoad>(dataset);
+  CheckBulkLoad<RTree, HilbertBulkLoad>(dataset);
+  CheckBulkLoad<HilbertRTree, HilbertBulkLoad>(dataset);
+
+  // The packed tree must have full leaves: 1000 points in leaves of size 20
+  // need exactly 50 leaves.
+  typedef RTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+  TreeType tree(dataset, STRBulkLoad(), 20, 6, 5, 2);
+  REQUIRE(CountLeaves(tree) == 50);
+
+  // A bulk loaded Hilbert R tree must keep its points in Hilbert order.
+  typedef HilbertRTree<EuclideanDistance, EmptyStatistic, arma::mat>
+      HilbertTreeType;
+  HilbertTreeType hilbertTree(dataset, HilbertBulkLoad(), 20, 6, 5, 2);
+  CheckHilbertOrdering(hilbertTree);
+
+  // STR must give every point exactly once.
+  std::vector<size_t> order;
+  STRBulkLoad::Order(dataset, 20, order);
+  std::sort(order.begin(), order.end());
+  for (size_t i = 0; i < order.size(); ++i)
+    REQUIRE(order[i] == i);
+}
@@ -246,6 +246,55 @@ TEST_CASE("RegularizedSVDFunctionOptimize", "[RegularizedSVDTest]")
   REQUIRE(relativeError == Approx(0.0).margin(1e-2));
 }
 
+/**
+ * Make sure that rating triples can be saved and mapped, and that training
+ * from the mapped triples gives the same result as training from the
+ * coordinate list.
+ */
+TEST_CASE("RegularizedSVDRatingTriplesTest", "[RegularizedSVDTest]")
+{
+  // Make a rating dataset with distinct (user, item) pairs and integer
+  // ratings, which are exact in single precision.
+  arma::mat data(3, 200);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    data(0, i) = i % 20;
+    data(1, i) = i / 20;
+    data(2, i) = 1 + (i * 7) % 5;
+  }
+
+  data::RatingTriples(data).Save("rating_triples_test.bin");
+  data::RatingTriples triples;
+  triples.Load("rating_triples_test.bin");
+
+  REQUIRE(triples.IsMapped());
+  REQUIRE(triples.Size() == data.n_cols);
+  REQUIRE(triples.NumUsers() == 20);
+  REQUIRE(triples.NumItems() == 10);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    REQUIRE(triples.User(i) == data(0, i));
+    REQUIRE(triples.Item(i) == data(1, i));
+    REQUIRE(triples.Rating(i) == data(2, i));
+  }
+
+  RegularizedSVD<> svd(5, 0.01, 0.02);
+  arma::mat u1, v1, u2, v2;
+  RandomSeed(7);
+  svd.Apply(data, 3, u1, v1);
+  RandomSeed(7);
+  svd.Apply(triples, 3, u2, v2);
+
+  REQUIRE(arma::approx_equal(u1, u2, "absdiff", 1e-10));
+  REQUIRE(arma::approx_equal(v1, v2, "absdiff", 1e-10));
+
+  // A coordinate list must have three rows.
+  REQUIRE_THROWS_AS(data::RatingTriples(arma::mat(2, 10, arma::fill::zeros)),
+      std::invalid_argument);
+
+  remove("rating_triples_test.bin");
+}
+
 // The test is only compiled if the user has specified OpenMP to be
 // used.
 #ifdef MLPACK_USE_OPENMP
@@ -166,3 +166,84 @@ TEST_CASE("ZCAWhiteningTest", "[ScalingTest]")
   scale.InverseTransform(output, temp);
   CheckMatrices(dataset, temp);
 }
+
+/**
+ * Make sure the statistics the scalers are fitted with are the same as those
+ * computed by Armadillo, for a dataset with many dimensions (so that they are
+ * computed in several blocks).
+ */
+TEST_CASE("ScalerStatisticsTest", "[ScalingTest]")
+{
+  arma::mat data = arma::randn<arma::mat>(37, 250) * 3.0 + 1.0;
+
+  data::StandardScaler standardScale;
+  standardScale.Fit(data);
+  CheckMatrices(standardScale.ItemMean(), arma::vec(arma::mean(data, 1)));
+  CheckMatrices(standardScale.ItemStdDev(),
+      arma::vec(arma::stddev(data, 1, 1)));
+
+  data::MinMaxScaler minMaxScale;
+  minMaxScale.Fit(data);
+  CheckMatrices(minMaxScale.ItemMin(), arma::vec(arma::min(data, 1)));
+  CheckMatrices(minMaxScale.ItemMax(), arma::vec(arma::max(data, 1)));
+
+  data::MeanNormalization meanScale;
+  meanScale.Fit(data);
+  CheckMatrices(meanScale.ItemMean(), arma::vec(arma::mean(data, 1)));
+  CheckMatrices(meanScale.ItemMin(), arma::vec(arma::min(data, 1)));
+  CheckMatrices(meanScale.ItemMax(), arma::vec(arma::max(data, 1)));
+
+  data::MaxAbsScaler maxAbsScale;
+  maxAbsScale.Fit(data);
+  CheckMatrices(maxAbsScale.Scale(), arma::vec(arma::max(arma::abs(data),
+      1)));
+}
+
+/**
+ * Make sure that fitting each scaler in batches with PartialFit(), or on parts
+ * of the dataset merged with Merge(), gives the same scaler as fitting the
+ * whole dataset.
+ */
+template<typename ScalerType>
+void CheckPartialFit(const arma::mat& data)
+{
+  ScalerType scale;
+  scale.Fit(data);
+  arma::mat scaled;
+  scale.Transform(data, scaled);
+
+  ScalerType partialScale;
+  partialScale.PartialFit(arma::mat(data.cols(0, 9)));
+  partialScale.PartialFit(arma::mat(data.cols(10, 10)));
+  partialScale.PartialFit(arma::mat(data.cols(11, data.n_cols - 1)));
+  REQUIRE(partialScale.NumPoints() == data.n_cols);
+  arma::mat partialScaled;
+  partialScale.Transform(data, partialScaled);
+  CheckMatrices(scaled, partialScaled);
+
+  ScalerType firstScale, secondScale;
+  firstScale.Fit(arma::mat(data.cols(0, 24)));
+  secondScale.Fit(arma::mat(data.cols(25, data.n_cols - 1)));
+  firstScale.Merge(secondScale);
+  arma::mat mergedScaled;
+  firstScale.Transform(data, mergedScaled);
+  CheckMatrices(scaled, mergedScaled);
+
+  // Scalers fitted on points of different dimensionalities cannot be merged.
+  ScalerType otherScale;
+  otherScale.Fit(arma::mat(data.rows(0, 1)));
+  REQUIRE_THROWS_AS(firstScale.Merge(otherScale), std::invalid_argument);
+}
+
+TEST_CASE("PartialFitTest", "[ScalingTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(4, 60) * 10.0 - 3.0;
+
+  CheckPartialFit<data::MinMaxScaler>(data);
+  CheckPartialFit<data::MaxAbsScaler>(data);
+  CheckPartialFit<data::StandardScaler>(data);
+  CheckPartialFit<data::MeanNormalization>(data);
+  // The signs of the eigenvectors of PCAWhitening are arbitrary, so its
+  // output is only checked through ZCAWhitening, which uses it.
+  CheckPartialFit<data::ZCAWhitening>(data);
+}
@@ -23,6 +23,7 @@
 #include <mlpack/methods/naive_bayes.hpp>
 #include <mlpack/methods/rann.hpp>
 #include <mlpack/methods/lsh.hpp>
+#include <mlpack/methods/hnsw.hpp>
 #include <mlpack/methods/lars.hpp>
 #include <mlpack/methods/bayesian_linear_regression.hpp>
 
@@ -126,6 +127,79 @@ TEST_CASE("EmptySparseMatrixSerializeTest", "[SerializationTest]")
   TestAllArmadilloSerialization(m);
 }
 
+/**
+ * Make sure that binary archives, which write the memory of a matrix as one
+ * block, give the same bytes as when each element is written on its own, so
+ * that older models can still be loaded.
+ */
+TEST_CASE("MatrixBinaryBlockSerializeTest", "[SerializationTest]")
+{
+  arma::mat m;
+  m.randu(30, 40);
+
+  std::ostringstream blockStream(std::ios::binary);
+  {
+    cereal::BinaryOutputArchive ar(blockStream);
+    ar(cereal::make_nvp("matrix", m));
+  }
+
+  std::ostringstream elemStream(std::ios::binary);
+  {
+    cereal::BinaryOutputArchive ar(elemStream);
+    arma::uword n_rows = m.n_rows;
+    arma::uword n_cols = m.n_cols;
+    arma::uword vec_state = m.vec_state;
+    ar(CEREAL_NVP(n_rows), CEREAL_NVP(n_cols), CEREAL_NVP(vec_state));
+    for (size_t i = 0; i < m.n_elem; ++i)
+      ar(cereal::make_nvp("elem", m[i]));
+  }
+
+  REQUIRE(blockStream.str() == elemStream.str());
+
+  arma::mat loaded;
+  std::istringstream inStream(elemStream.str(), std::ios::binary);
+  {
+    cereal::BinaryInputArchive ar(inStream);
+    ar(cereal::make_nvp("matrix", loaded));
+  }
+
+  REQUIRE(loaded.n_rows == m.n_rows);
+  REQUIRE(loaded.n_cols == m.n_cols);
+  for (size_t i = 0; i < m.n_elem; ++i)
+    REQUIRE(loaded[i] == m[i]);
+}
+
+/**
+ * Portable binary archives should also be able to save and load matrices.
+ */
+TEST_CASE("MatrixPortableBinarySerializeTest", "[SerializationTest]")
+{
+  arma::fmat m;
+  m.randu(20, 25);
+  arma::sp_mat sp;
+  sp.sprandu(40, 30, 0.2);
+
+  std::ostringstream outStream(std::ios::binary);
+  {
+    cereal::PortableBinaryOutputArchive ar(outStream);
+    ar(cereal::make_nvp("matrix", m), cereal::make_nvp("sparse", sp));
+  }
+
+  arma::fmat loaded;
+  arma::sp_mat spLoaded;
+  std::istringstream inStream(outStream.str(), std::ios::binary);
+  {
+    cereal::PortableBinaryInputArchive ar(inStream);
+    ar(cereal::make_nvp("matrix", loaded), cereal::make_nvp("sparse",
+        spLoaded));
+  }
+
+  REQUIRE(arma::approx_equal(loaded, m, "absdiff", 0.0));
+  REQUIRE(spLoaded.n_nonzero == sp.n_nonzero);
+  REQUIRE(arma::approx_equal(arma::mat(spLoaded), arma::mat(sp), "absdiff",
+      0.0));
+}
+
 TEST_CASE("BallBoundTest", "[SerializationTest]")
 {
   BallBound<> b(100);
@@ -1053,6 +1127,64 @@ TEST_CASE("LSHTest", "[SerializationTest]")
       jsonLsh.SecondHashTable()[i], binaryLsh.SecondHashTable()[i]);
 }
 
+/**
+ * Test that an HNSW model can be serialized and deserialized, and that the
+ * deserialized graph gives the same search results.
+ */
+TEST_CASE("HNSWTest", "[SerializationTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(10, 500);
+  arma::mat queryData = arma::randu<arma::mat>(10, 50);
+
+  HNSWSearch<> hnsw(referenceData, 8, 50, 30);
+
+  HNSWSearch<> xmlHnsw;
+  arma::mat jsonData = arma::randu<arma::mat>(5, 50);
+  HNSWSearch<> jsonHnsw(jsonData, 4, 20);
+  HNSWSearch<> binaryHnsw(referenceData, 12);
+
+  SerializeObjectAll(hnsw, xmlHnsw, jsonHnsw, binaryHnsw);
+
+  CheckMatrices(hnsw.ReferenceSet(), xmlHnsw.ReferenceSet(),
+      jsonHnsw.ReferenceSet(), binaryHnsw.ReferenceSet());
+
+  REQUIRE(hnsw.M() == xmlHnsw.M());
+  REQUIRE(hnsw.M() == jsonHnsw.M());
+  REQUIRE(hnsw.M() == binaryHnsw.M());
+  REQUIRE(hnsw.EfSearch() == xmlHnsw.EfSearch());
+  REQUIRE(hnsw.EfSearch() == jsonHnsw.EfSearch());
+  REQUIRE(hnsw.EfSearch() == binaryHnsw.EfSearch());
+  REQUIRE(hnsw.NumLayers() == xmlHnsw.NumLayers());
+  REQUIRE(hnsw.NumLayers() == jsonHnsw.NumLayers());
+  REQUIRE(hnsw.NumLayers() == binaryHnsw.NumLayers());
+  REQUIRE(hnsw.EntryPoint() == xmlHnsw.EntryPoint());
+  REQUIRE(hnsw.EntryPoint() == jsonHnsw.EntryPoint());
+  REQUIRE(hnsw.EntryPoint() == binaryHnsw.EntryPoint());
+
+  for (size_t i = 0; i < referenceData.n_cols; ++i)
+  {
+    REQUIRE(hnsw.Level(i) == xmlHnsw.Level(i));
+    REQUIRE(hnsw.Level(i) == jsonHnsw.Level(i));
+    REQUIRE(hnsw.Level(i) == binaryHnsw.Level(i));
+    for (size_t layer = 0; layer <= hnsw.Level(i); ++layer)
+    {
+      REQUIRE(hnsw.Links(i, layer) == xmlHnsw.Links(i, layer));
+      REQUIRE(hnsw.Links(i, layer) == jsonHnsw.Links(i, layer));
+      REQUIRE(hnsw.Links(i, layer) == binaryHnsw.Links(i, layer));
+    }
+  }
+
+  arma::Mat<size_t> neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors;
+  arma::mat distances, xmlDistances, jsonDistances, binaryDistances;
+  hnsw.Search(queryData, 5, neighbors, distances);
+  xmlHnsw.Search(queryData, 5, xmlNeighbors, xmlDistances);
+  jsonHnsw.Search(queryData, 5, jsonNeighbors, jsonDistances);
+  binaryHnsw.Search(queryData, 5, binaryNeighbors, binaryDistances);
+
+  CheckMatrices(neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors);
+  CheckMatrices(distances, xmlDistances, jsonDistances, binaryDistances);
+}
+
 // Make sure serialization works for LARS.
 TEST_CASE("LARSTest", "[SerializationTest]")
 {
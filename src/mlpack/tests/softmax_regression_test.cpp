@@ -911,3 +911,88 @@ TEST_CASE("SoftmaxRegressionResetTest", "[SoftmaxRegressionTest]")
   REQUIRE(
       !arma::approx_equal(sr1.Parameters(), sr2.Parameters(), "absdiff", 1e-5));
 }
+
+/**
+ * Make sure the objective and gradient do not depend on the number of points
+ * whose scores are computed at once, match the probabilities matrix, and can
+ * be computed with 32-bit floats.
+ */
+TEST_CASE("SoftmaxRegressionFunctionBlockSizeTest", "[SoftmaxRegressionTest]")
+{
+  const size_t points = 300;
+  const size_t inputSize = 8;
+  const size_t numClasses = 6;
+
+  arma::mat data(inputSize, points, arma::fill::randu);
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; ++i)
+    labels[i] = RandInt(0, numClasses);
+
+  for (const bool fitIntercept : { false, true })
+  {
+    SoftmaxRegressionFunction<> srf(data, labels, numClasses, 0.01,
+        fitIntercept);
+    arma::mat parameters;
+    parameters.randn(numClasses, inputSize + (fitIntercept ? 1 : 0));
+
+    // The gradient computed from the whole probabilities matrix.
+    arma::mat probabilities;
+    srf.GetProbabilitiesMatrix(parameters, probabilities, 0, points);
+    arma::mat groundTruth(numClasses, points, arma::fill::zeros);
+    for (size_t i = 0; i < points; ++i)
+      groundTruth(labels[i], i) = 1.0;
+    const arma::mat inner = probabilities - groundTruth;
+    arma::mat expected(arma::size(parameters));
+    if (fitIntercept)
+    {
+      expected.col(0) = arma::sum(inner, 1);
+      expected.cols(1, inputSize) = inner * data.t();
+    }
+    else
+    {
+      expected = inner * data.t();
+    }
+    expected = expected / points + 0.01 * parameters;
+
+    arma::mat gradient;
+    srf.Gradient(parameters, gradient);
+    CheckMatrices(gradient, expected, 1e-7);
+    const double objective = srf.Evaluate(parameters);
+
+    // Blocks that do not divide the points evenly.
+    srf.BlockSize() = 7;
+    arma::mat blockGradient;
+    srf.Gradient(parameters, blockGradient);
+    CheckMatrices(blockGradient, expected, 1e-7);
+    REQUIRE(srf.Evaluate(parameters) == Approx(objective).epsilon(1e-7));
+    REQUIRE(srf.EvaluateWithGradient(parameters, blockGradient) ==
+        Approx(objective).epsilon(1e-7));
+    CheckMatrices(blockGradient, expected, 1e-7);
+
+    // A batch of points.
+    arma::mat batchGradient;
+    srf.Gradient(parameters, 20, batchGradient, 50);
+    const double batchObjective = srf.Evaluate(parameters, 20, 50);
+    srf.BlockSize() = 1000;
+    arma::mat oneBlockGradient;
+    srf.Gradient(parameters, 20, oneBlockGradient, 50);
+    CheckMatrices(batchGradient, oneBlockGradient, 1e-7);
+    REQUIRE(srf.EvaluateWithGradient(parameters, 20, oneBlockGradient, 50) ==
+        Approx(batchObjective).epsilon(1e-7));
+    CheckMatrices(batchGradient, oneBlockGradient, 1e-7);
+
+    // The same computation with floats.
+    const arma::fmat floatData = arma::conv_to<arma::fmat>::from(data);
+    SoftmaxRegressionFunction<arma::fmat> floatSrf(floatData, labels,
+        numClasses, 0.01, fitIntercept);
+    floatSrf.BlockSize() = 7;
+    const arma::fmat floatParameters =
+        arma::conv_to<arma::fmat>::from(parameters);
+    arma::fmat floatGradient;
+    const float floatObjective = floatSrf.EvaluateWithGradient(
+        floatParameters, floatGradient);
+    REQUIRE(floatObjective == Approx(objective).epsilon(1e-4));
+    REQUIRE(arma::approx_equal(arma::conv_to<arma::mat>::from(floatGradient),
+        expected, "absdiff", 1e-4));
+  }
+}
@@ -273,3 +273,95 @@ TEST_CASE("SparseAutoencoderFunctionGradient", "[SparseAutoencoderTest]")
     }
   }
 }
+
+/**
+ * Make sure that the mini-batch objective and gradient match a function built
+ * on the points of the mini-batch only, that the full objective does not
+ * depend on the block size, and that the mini-batch gradient is correct.
+ */
+TEST_CASE("SparseAutoencoderFunctionBatchTest", "[SparseAutoencoderTest]")
+{
+  const size_t vSize = 12;
+  const size_t hSize = 7;
+
+  arma::mat data;
+  data.randu(vSize, 1500);
+  const arma::mat batch = data.cols(200, 899);
+
+  SparseAutoencoderFunction saf(data, vSize, hSize, 0.5, 2, 0.1);
+  SparseAutoencoderFunction safBatch(batch, vSize, hSize, 0.5, 2, 0.1);
+  REQUIRE(saf.NumFunctions() == 1500);
+
+  arma::mat parameters;
+  parameters.randu(2 * hSize + 1, vSize + 1);
+
+  arma::mat gradient, batchGradient, fullGradient;
+  const double objective = saf.EvaluateWithGradient(parameters, 200,
+      gradient, 700);
+  REQUIRE(objective == Approx(safBatch.Evaluate(parameters)).epsilon(1e-10));
+  REQUIRE(objective == Approx(saf.Evaluate(parameters, 200, 700)).
+      epsilon(1e-10));
+  safBatch.Gradient(parameters, batchGradient);
+  REQUIRE(arma::approx_equal(gradient, batchGradient, "absdiff", 1e-10));
+
+  // Numerically check a few entries of the mini-batch gradient.
+  const double epsilon = 1e-5;
+  for (size_t k = 0; k < 20; ++k)
+  {
+    const size_t i = RandInt(2 * hSize + 1);
+    const size_t j = RandInt(vSize + 1);
+    parameters(i, j) += epsilon;
+    const double costPlus = saf.Evaluate(parameters, 200, 700);
+    parameters(i, j) -= 2 * epsilon;
+    const double costMinus = saf.Evaluate(parameters, 200, 700);
+    parameters(i, j) += epsilon;
+
+    REQUIRE((costPlus - costMinus) / (2 * epsilon) ==
+        Approx(gradient(i, j)).margin(1e-6));
+  }
+
+  // The block size only changes the order of the sums.
+  const double fullObjective = saf.EvaluateWithGradient(parameters,
+      fullGradient);
+  saf.BlockSize() = 7;
+  REQUIRE(saf.Evaluate(parameters) == Approx(fullObjective).epsilon(1e-10));
+  saf.Gradient(parameters, gradient);
+  REQUIRE(arma::approx_equal(gradient, fullGradient, "reldiff", 1e-8));
+}
+
+/**
+ * Train a sparse autoencoder on float data with a mini-batch optimizer, and
+ * make sure that it reconstructs the data better than the initial point.
+ */
+TEST_CASE("SparseAutoencoderFloatMiniBatchTest", "[SparseAutoencoderTest]")
+{
+  const size_t vSize = 10;
+  const size_t hSize = 4;
+
+  // The data lies close to a low-dimensional subspace.
+  arma::fmat data = arma::randu<arma::fmat>(vSize, 3) *
+      arma::randu<arma::fmat>(3, 2000) / 3;
+
+  SparseAutoencoderFunction<arma::fmat> saf(data, vSize, hSize, 0.0001, 0);
+  const float initialObjective = saf.Evaluate(saf.GetInitialPoint());
+
+  // The float function matches the double function.
+  const arma::mat doubleData = arma::conv_to<arma::mat>::from(data);
+  SparseAutoencoderFunction safDouble(doubleData, vSize, hSize, 0.0001, 0);
+  REQUIRE(initialObjective == Approx(safDouble.Evaluate(arma::conv_to<
+      arma::mat>::from(saf.GetInitialPoint()))).epsilon(1e-4));
+
+  arma::fmat parameters = saf.GetInitialPoint();
+  ens::Adam adam(0.01, 32, 0.9, 0.999, 1e-8, 20 * data.n_cols, 1e-8, true);
+  adam.Optimize(saf, parameters);
+
+  REQUIRE(saf.Evaluate(parameters) < 0.5 * initialObjective);
+
+  // The model can also be trained through SparseAutoencoder.
+  SparseAutoencoder<arma::fmat> encoder(data, vSize, hSize, 0.0001, 0, 0.01,
+      ens::Adam(0.01, 32, 0.9, 0.999, 1e-8, 5 * data.n_cols));
+  arma::fmat features;
+  encoder.GetNewFeatures(data, features);
+  REQUIRE(features.n_rows == hSize);
+  REQUIRE(features.n_cols == data.n_cols);
+}
@@ -0,0 +1,158 @@
+/**
+ * @file tests/sparse_cosine_search_test.cpp
+ *
+ * Unit tests for the 'SparseCosineSearch' class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include "catch.hpp"
+#include "serialization.hpp"
+#include "test_catch_tools.hpp"
+
+#include <mlpack/methods/neighbor_search.hpp>
+
+using namespace std;
+using namespace mlpack;
+
+/**
+ * Compute the cosine distances between all the query and the reference points
+ * by brute force; empty points have a similarity of 0 with every point.
+ */
+arma::mat BruteForceCosineDistances(const arma::sp_mat& querySet,
+                                    const arma::sp_mat& referenceSet)
+{
+  arma::mat queries(querySet), references(referenceSet);
+  for (size_t i = 0; i < queries.n_cols; ++i)
+  {
+    if (arma::norm(queries.col(i)) > 0)
+      queries.col(i) /= arma::norm(queries.col(i));
+  }
+  for (size_t i = 0; i < references.n_cols; ++i)
+  {
+    if (arma::norm(references.col(i)) > 0)
+      references.col(i) /= arma::norm(references.col(i));
+  }
+
+  return 1.0 - references.t() * queries;
+}
+
+/**
+ * Make sure that the neighbors found by the given search are the true nearest
+ * neighbors, given the brute-force distances.  Points at the same distance may
+ * be returned in any order, so the distances are compared, and each neighbor
+ * must be at the distance that was returned.
+ */
+void CheckCosineNeighbors(const arma::Mat<size_t>& neighbors,
+                          const arma::mat& distances,
+                          const arma::mat& trueDistances,
+                          const bool monochromatic = false)
+{
+  for (size_t q = 0; q < trueDistances.n_cols; ++q)
+  {
+    arma::vec sorted = trueDistances.col(q);
+    if (monochromatic)
+      sorted.shed_row(q);
+    sorted = arma::sort(sorted);
+
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+    {
+      REQUIRE(neighbors(j, q) < trueDistances.n_rows);
+      if (monochromatic)
+        REQUIRE(neighbors(j, q) != q);
+      REQUIRE(distances(j, q) ==
+          Approx(std::max(sorted[j], 0.0)).margin(1e-8));
+      REQUIRE(distances(j, q) == Approx(std::max(
+          trueDistances(neighbors(j, q), q), 0.0)).margin(1e-8));
+    }
+  }
+}
+
+/**
+ * The neighbors of sparse non-negative points (like TF-IDF vectors) must be
+ * those of a brute-force search.
+ */
+TEST_CASE("SparseCosineSearchNonNegativeTest", "[SparseCosineSearchTest]")
+{
+  arma::sp_mat referenceData = arma::sprandu<arma::sp_mat>(200, 1000, 0.03);
+  arma::sp_mat queryData = arma::sprandu<arma::sp_mat>(200, 50, 0.03);
+
+  SparseCosineSearch<> search(referenceData);
+  REQUIRE(search.NumPoints() == 1000);
+  REQUIRE(search.Dimensionality() == 200);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  search.Search(queryData, 10, neighbors, distances);
+  REQUIRE(neighbors.n_rows == 10);
+  REQUIRE(neighbors.n_cols == 50);
+
+  CheckCosineNeighbors(neighbors, distances,
+      BruteForceCosineDistances(queryData, referenceData));
+}
+
+/**
+ * With negative values, the pruning of the posting lists must still give the
+ * true nearest neighbors; queries that share no term with the reference set,
+ * and empty queries, are at a distance of 1 from every point.
+ */
+TEST_CASE("SparseCosineSearchNegativeTest", "[SparseCosineSearchTest]")
+{
+  arma::sp_mat referenceData = arma::sprandn<arma::sp_mat>(100, 500, 0.05);
+  arma::sp_mat queryData = arma::sprandn<arma::sp_mat>(100, 30, 0.05);
+  queryData.col(0).zeros();
+
+  SparseCosineSearch<> search(referenceData);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  search.Search(queryData, 495, neighbors, distances);
+
+  CheckCosineNeighbors(neighbors, distances,
+      BruteForceCosineDistances(queryData, referenceData));
+  for (size_t j = 0; j < 495; ++j)
+    REQUIRE(distances(j, 0) == Approx(1.0));
+}
+
+/**
+ * The monochromatic search must return the neighbors of each reference point
+ * other than itself, and a serialized model must give the same results.
+ */
+TEST_CASE("SparseCosineSearchMonochromaticTest", "[SparseCosineSearchTest]")
+{
+  arma::sp_mat referenceData = arma::sprandu<arma::sp_mat>(50, 300, 0.1);
+  // Duplicate points must be found at a distance of 0.
+  referenceData(0, 20) = 1.0;
+  referenceData(3, 20) = 0.5;
+  referenceData.col(10) = 2.0 * referenceData.col(20);
+
+  SparseCosineSearch<> search(referenceData);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  search.Search(5, neighbors, distances);
+
+  CheckCosineNeighbors(neighbors, distances,
+      BruteForceCosineDistances(referenceData, referenceData), true);
+  REQUIRE(neighbors(0, 10) == 20);
+  REQUIRE(neighbors(0, 20) == 10);
+  REQUIRE(distances(0, 10) == Approx(0.0).margin(1e-8));
+
+  SparseCosineSearch<> xmlSearch, jsonSearch, binarySearch;
+  SerializeObjectAll(search, xmlSearch, jsonSearch, binarySearch);
+
+  arma::Mat<size_t> serializedNeighbors;
+  arma::mat serializedDistances;
+  binarySearch.Search(5, serializedNeighbors, serializedDistances);
+  CheckMatrices(neighbors, serializedNeighbors);
+  CheckMatrices(distances, serializedDistances);
+
+  // The parameters must be checked.
+  REQUIRE_THROWS_AS(search.Search(300, neighbors, distances),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(search.Search(referenceData, 0, neighbors, distances),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(search.Search(arma::sp_mat(40, 10), 5, neighbors,
+      distances), std::invalid_argument);
+}
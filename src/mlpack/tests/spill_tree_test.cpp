@@ -301,3 +301,72 @@ TEST_CASE("SpillTreeMoveDatasetTest", "[SpillTreeTest]")
   REQUIRE(tree.Dataset().n_rows == 3);
   REQUIRE(tree.Dataset().n_cols == 1000);
 }
+
+/**
+ * Make sure that a compact tree holds the same points in each node as the tree
+ * it was compacted from, and that copies of it are compact.
+ */
+TEST_CASE("SpillTreeCompactTest", "[SpillTreeTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(3, 1000);
+  typedef SPTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  TreeType tree(dataset, 0.1);
+  TreeType compactTree(tree);
+  REQUIRE(!compactTree.IsCompact());
+  compactTree.Compact();
+  REQUIRE(compactTree.IsCompact());
+
+  // Only the root can be compacted.
+  REQUIRE_THROWS_AS(compactTree.Left()->Compact(), std::invalid_argument);
+
+  TreeType copiedTree(compactTree);
+  REQUIRE(copiedTree.IsCompact());
+
+  std::stack<TreeType*> nodes, compactNodes, copiedNodes;
+  nodes.push(&tree);
+  compactNodes.push(&compactTree);
+  copiedNodes.push(&copiedTree);
+  while (!nodes.empty())
+  {
+    TreeType* node = nodes.top();
+    TreeType* compactNode = compactNodes.top();
+    TreeType* copiedNode = copiedNodes.top();
+    nodes.pop();
+    compactNodes.pop();
+    copiedNodes.pop();
+
+    REQUIRE(compactNode->NumChildren() == node->NumChildren());
+    REQUIRE(compactNode->NumPoints() == node->NumPoints());
+    REQUIRE(compactNode->NumDescendants() == node->NumDescendants());
+
+    // The points of the lists are sorted in a compact tree.
+    arma::Col<size_t> descendants(node->NumDescendants());
+    arma::Col<size_t> compactDescendants(node->NumDescendants());
+    for (size_t i = 0; i < node->NumDescendants(); ++i)
+    {
+      descendants[i] = node->Descendant(i);
+      compactDescendants[i] = compactNode->Descendant(i);
+      REQUIRE(copiedNode->Descendant(i) == compactDescendants[i]);
+    }
+    REQUIRE(arma::all(arma::sort(descendants) ==
+        arma::sort(compactDescendants)));
+
+    if (node->IsLeaf())
+    {
+      for (size_t i = 0; i < node->NumPoints(); ++i)
+      {
+        REQUIRE(compactNode->Point(i) == compactDescendants[i]);
+        if (i > 0)
+          REQUIRE(compactNode->Point(i) > compactNode->Point(i - 1));
+      }
+    }
+
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+    {
+      nodes.push(&node->Child(i));
+      compactNodes.push(&compactNode->Child(i));
+      copiedNodes.push(&copiedNode->Child(i));
+    }
+  }
+}
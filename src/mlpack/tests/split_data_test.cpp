@@ -349,6 +349,69 @@ TEST_CASE("StratifiedSplitRunTimeErrorTest", "[SplitDataTest]")
       std::runtime_error);
 }
 
+/**
+ * Check that SplitIndices() gives the points Split() would give.
+ */
+TEST_CASE("SplitIndicesTest", "[SplitDataTest]")
+{
+  mat input(2, 250, fill::randu);
+
+  arma::uvec trainIndices, testIndices;
+  std::tie(trainIndices, testIndices) = SplitIndices(input.n_cols, 0.2);
+  REQUIRE(trainIndices.n_elem == 200);
+  REQUIRE(testIndices.n_elem == 50);
+
+  // Every point must be in one of the sets.
+  Row<size_t> counts(250, fill::zeros);
+  for (size_t i = 0; i < trainIndices.n_elem; ++i)
+    counts[trainIndices[i]]++;
+  for (size_t i = 0; i < testIndices.n_elem; ++i)
+    counts[testIndices[i]]++;
+  REQUIRE(all(counts == 1));
+
+  // With the same seed, Split() gives the same sets.
+  RandomSeed(10);
+  std::tie(trainIndices, testIndices) = SplitIndices(input.n_cols, 0.2);
+  RandomSeed(10);
+  const auto value = Split(input, 0.2);
+  CheckMatrices(std::get<0>(value), mat(input.cols(trainIndices)));
+  CheckMatrices(std::get<1>(value), mat(input.cols(testIndices)));
+
+  // Without shuffling, the sets are contiguous.
+  std::tie(trainIndices, testIndices) = SplitIndices(input.n_cols, 0.2, false);
+  for (size_t i = 0; i < trainIndices.n_elem; ++i)
+    REQUIRE(trainIndices[i] == i);
+  for (size_t i = 0; i < testIndices.n_elem; ++i)
+    REQUIRE(testIndices[i] == 200 + i);
+}
+
+/**
+ * Check that StratifiedSplitIndices() gives the points StratifiedSplit()
+ * would give.
+ */
+TEST_CASE("StratifiedSplitIndicesTest", "[SplitDataTest]")
+{
+  mat input(3, 300, fill::randu);
+  Row<size_t> labels(300);
+  for (size_t i = 0; i < 300; ++i)
+    labels[i] = (i < 100) ? 0 : 1;
+
+  RandomSeed(20);
+  arma::uvec trainIndices, testIndices;
+  std::tie(trainIndices, testIndices) = StratifiedSplitIndices(labels, 0.3);
+  REQUIRE(testIndices.n_elem == 90);
+  REQUIRE(trainIndices.n_elem == 210);
+  REQUIRE(accu(labels.cols(testIndices) == 0) == 30);
+
+  RandomSeed(20);
+  mat trainData, testData;
+  Row<size_t> trainLabels, testLabels;
+  StratifiedSplit(input, labels, trainData, testData, trainLabels, testLabels,
+      0.3);
+  CheckMatrices(trainData, mat(input.cols(trainIndices)));
+  CheckMatrices(testData, mat(input.cols(testIndices)));
+}
+
 /*
  * Split with input of type field<mat>.
  */
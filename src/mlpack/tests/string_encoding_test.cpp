@@ -1427,3 +1427,79 @@ TEST_CASE("SplitByAnyOfTfIdfEncodingSerialization", "[StringEncodingTest]")
 
   CheckMatrices(output, xmlOutput, jsonOutput, binaryOutput);
 }
+
+/**
+ * Make sure that the bag of words and tf-idf encoders give the same sparse
+ * output as the dense one, and label the tokens the same way, even when the
+ * corpus is tokenized in several chunks.
+ */
+TEST_CASE("SparseCountEncodingTest", "[StringEncodingTest]")
+{
+  const vector<string> words = { "mlpack", "is", "a", "fast", "flexible",
+      "machine", "learning", "library", "with", "bindings" };
+  vector<string> input = stringEncodingInput;
+  for (size_t i = 0; i < 300; ++i)
+  {
+    string line;
+    for (size_t j = 0; j < i % 13; ++j)
+      line += words[(i * j + j * j) % words.size()] + to_string(i / 50) + " ";
+    input.push_back(line);
+  }
+  SplitByAnyOf tokenizer(" ,.");
+
+  BagOfWordsEncoding<SplitByAnyOf::TokenType> denseEncoder, sparseEncoder;
+  arma::mat dense;
+  arma::sp_mat sparse;
+  denseEncoder.Encode(input, dense, tokenizer);
+  sparseEncoder.Encode(input, sparse, tokenizer);
+
+  REQUIRE(sparseEncoder.Dictionary().Size() ==
+      denseEncoder.Dictionary().Size());
+  for (auto& keyValue : denseEncoder.Dictionary().Mapping())
+  {
+    REQUIRE(sparseEncoder.Dictionary().Value(keyValue.first) ==
+        keyValue.second);
+  }
+  CheckMatrices(arma::mat(sparse), dense);
+
+  const TfIdfEncodingPolicy::TfTypes tfTypes[] = {
+      TfIdfEncodingPolicy::TfTypes::BINARY,
+      TfIdfEncodingPolicy::TfTypes::RAW_COUNT,
+      TfIdfEncodingPolicy::TfTypes::TERM_FREQUENCY,
+      TfIdfEncodingPolicy::TfTypes::SUBLINEAR_TF };
+  for (const TfIdfEncodingPolicy::TfTypes tfType : tfTypes)
+  {
+    for (const bool smoothIdf : { false, true })
+    {
+      TfIdfEncoding<SplitByAnyOf::TokenType> denseTfIdf(
+          TfIdfEncodingPolicy(tfType, smoothIdf));
+      TfIdfEncoding<SplitByAnyOf::TokenType> sparseTfIdf(
+          TfIdfEncodingPolicy(tfType, smoothIdf));
+      denseTfIdf.Encode(input, dense, tokenizer);
+      sparseTfIdf.Encode(input, sparse, tokenizer);
+      CheckMatrices(arma::mat(sparse), dense, 1e-12);
+    }
+  }
+
+  // Individual characters; the second encoding only adds new characters to
+  // the dictionary that is already there.
+  vector<string> characters = { "GACCA", "ABCABCD", "GAB" };
+  BagOfWordsEncoding<CharExtract::TokenType> charEncoder;
+  arma::sp_mat charOutput;
+  charEncoder.Encode(characters, charOutput, CharExtract());
+
+  arma::mat target = {
+    { 1, 2, 2, 0, 0 },
+    { 0, 2, 2, 2, 1 },
+    { 1, 1, 0, 1, 0 }
+  };
+  CheckMatrices(arma::mat(charOutput), target.t());
+
+  characters = { "XAX" };
+  charEncoder.Encode(characters, charOutput, CharExtract());
+  REQUIRE(charOutput.n_rows == 6);
+  REQUIRE(charOutput.n_cols == 1);
+  REQUIRE(charOutput(1, 0) == 1.0);
+  REQUIRE(charOutput(5, 0) == 2.0);
+  REQUIRE(charOutput.n_nonzero == 2);
+}
@@ -87,3 +87,65 @@ TEST_CASE("BatchUpdate", "[SumTreeTest]")
   REQUIRE(sumtree.FindPrefixSum(2.8) <= 3);
   REQUIRE(sumtree.FindPrefixSum(3.0) <= 3);
 }
+
+/**
+ * Check a SumTree with the given arity against a plain array.
+ */
+template<size_t Arity>
+void CheckSumTree(const size_t capacity)
+{
+  SumTree<double, Arity> sumtree(capacity);
+  arma::vec data = arma::randu<arma::vec>(capacity);
+  for (size_t i = 0; i < capacity; ++i)
+    sumtree.Set(i, data[i]);
+
+  // Change some elements at once; the indices may repeat.
+  arma::ucolvec indices = arma::randi<arma::ucolvec>(50,
+      arma::distr_param(0, (int) capacity - 1));
+  arma::colvec values = arma::randu<arma::colvec>(50);
+  sumtree.BatchUpdate(indices, values);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+    data[indices[i]] = values[i];
+
+  REQUIRE(sumtree.Sum() == Approx(arma::accu(data)).epsilon(1e-10));
+  for (size_t i = 0; i < 20; ++i)
+  {
+    const size_t start = RandInt(capacity);
+    const size_t end = RandInt(start + 1, capacity + 1);
+    REQUIRE(sumtree.Sum(start, end) ==
+        Approx(arma::accu(data.subvec(start, end - 1))).epsilon(1e-10));
+    REQUIRE(sumtree.Get(start) == data[start]);
+  }
+
+  // Stratified masses are found in one pass, with the same results.
+  arma::colvec masses = arma::sort(arma::randu<arma::colvec>(32)) *
+      arma::accu(data);
+  arma::ucolvec found;
+  sumtree.BatchFindPrefixSum(masses, found);
+  REQUIRE(found.n_elem == masses.n_elem);
+  const arma::vec prefix = arma::cumsum(data);
+  for (size_t i = 0; i < masses.n_elem; ++i)
+  {
+    REQUIRE(found[i] == sumtree.FindPrefixSum(masses[i]));
+    REQUIRE(found[i] < capacity);
+    REQUIRE(prefix[found[i]] > masses[i]);
+    if (found[i] > 0)
+      REQUIRE(prefix[found[i] - 1] <= masses[i]);
+  }
+
+  // A mass beyond the total gives the last element.
+  REQUIRE(sumtree.FindPrefixSum(2 * arma::accu(data)) == capacity - 1);
+}
+
+/**
+ * Test SumTrees of different arities and capacities that are not powers of
+ * their arity.
+ */
+TEST_CASE("SumTreeArityTest", "[SumTreeTest]")
+{
+  CheckSumTree<2>(1000);
+  CheckSumTree<4>(1000);
+  CheckSumTree<8>(1000);
+  CheckSumTree<8>(4096);
+  CheckSumTree<16>(37);
+}
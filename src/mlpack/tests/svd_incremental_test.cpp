@@ -152,3 +152,96 @@ TEMPLATE_TEST_CASE("SVDIncompleteIncrementalRegularizationTest",
 
   REQUIRE(regularizedRMSE < regularRMSE + 0.105);
 }
+
+/**
+ * Make sure that with one block, one pass of SVDParallelIncrementalLearning is
+ * the same as one pass of the sequential rules over all the ratings.
+ */
+TEST_CASE("SVDParallelIncrementalSequentialTest", "[SVDIncrementalTest]")
+{
+  sp_mat data;
+  data.sprandu(50, 40, 0.2);
+  // Make sure that some user has no ratings.
+  data.col(7).zeros();
+
+  size_t numUsers = 0;
+  for (size_t j = 0; j < data.n_cols; ++j)
+  {
+    if (data.col(j).n_nonzero > 0)
+      ++numUsers;
+  }
+
+  SpecificRandomInitialization<mat> sri(data.n_rows, 3, data.n_cols);
+
+  for (const bool complete : { true, false })
+  {
+    // MaxIterationTermination(n) makes n - 1 updates; the sequential complete
+    // rule visits one rating at each update, and the incomplete rule visits
+    // one user.
+    mat w1, h1;
+    if (complete)
+    {
+      AMF<MaxIterationTermination, SpecificRandomInitialization<mat>,
+          SVDCompleteIncrementalLearning<sp_mat>> amf(
+          MaxIterationTermination(data.n_nonzero + 1), sri,
+          SVDCompleteIncrementalLearning<sp_mat>(0.01, 0.02, 0.03));
+      amf.Apply(data, 3, w1, h1);
+    }
+    else
+    {
+      AMF<MaxIterationTermination, SpecificRandomInitialization<mat>,
+          SVDIncompleteIncrementalLearning<sp_mat>> amf(
+          MaxIterationTermination(numUsers + 1), sri,
+          SVDIncompleteIncrementalLearning<sp_mat>(0.01, 0.02, 0.03));
+      amf.Apply(data, 3, w1, h1);
+    }
+
+    AMF<MaxIterationTermination, SpecificRandomInitialization<mat>,
+        SVDParallelIncrementalLearning> amf(MaxIterationTermination(2), sri,
+        SVDParallelIncrementalLearning(0.01, 0.02, 0.03, complete, 1));
+    mat w2, h2;
+    amf.Apply(data, 3, w2, h2);
+
+    REQUIRE(approx_equal(w1, w2, "absdiff", 1e-10));
+    REQUIRE(approx_equal(h1, h2, "absdiff", 1e-10));
+  }
+}
+
+/**
+ * Make sure that SVDParallelIncrementalLearning with several blocks fits a
+ * low-rank matrix, and that a dense input gives the same result as a sparse
+ * one.
+ */
+TEMPLATE_TEST_CASE("SVDParallelIncrementalBlocksTest", "[SVDIncrementalTest]",
+    float, double)
+{
+  typedef TestType eT;
+
+  const Mat<eT> full = randu<Mat<eT>>(80, 2) * randu<Mat<eT>>(2, 60);
+  Mat<eT> mask = randu<Mat<eT>>(80, 60);
+  mask.transform([](eT x) { return (x < 0.5) ? eT(1) : eT(0); });
+  const SpMat<eT> data(full % mask);
+
+  SpecificRandomInitialization<Mat<eT>> sri(data.n_rows, 2, data.n_cols);
+  Mat<eT> w0, h0;
+  sri.Initialize(data, 2, w0, h0);
+
+  for (const bool complete : { true, false })
+  {
+    const double u = complete ? 0.05 : 0.02;
+    AMF<MaxIterationTermination, SpecificRandomInitialization<Mat<eT>>,
+        SVDParallelIncrementalLearning> amf(MaxIterationTermination(200), sri,
+        SVDParallelIncrementalLearning(u, 0, 0, complete, 4));
+    Mat<eT> w, h;
+    amf.Apply(data, 2, w, h);
+
+    const double initialError = norm((w0 * h0 - full) % mask, "fro");
+    const double error = norm((w * h - full) % mask, "fro");
+    REQUIRE(error < 0.2 * initialError);
+
+    Mat<eT> w2, h2;
+    amf.Apply(Mat<eT>(data), 2, w2, h2);
+    REQUIRE(approx_equal(w, w2, "absdiff", 1e-5));
+    REQUIRE(approx_equal(h, h2, "absdiff", 1e-5));
+  }
+}
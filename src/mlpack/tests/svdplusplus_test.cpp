@@ -432,6 +432,39 @@ TEST_CASE("SVDPlusPlusFunctionOptimize", "[SVDPlusPlusTest]")
   REQUIRE(relativeError == Approx(0.0).margin(1e-2));
 }
 
+/**
+ * Make sure that training from rating triples gives the same result as
+ * training from the coordinate list.
+ */
+TEST_CASE("SVDPlusPlusRatingTriplesTest", "[SVDPlusPlusTest]")
+{
+  // Make a rating dataset with distinct (user, item) pairs and integer
+  // ratings, which are exact in single precision.
+  arma::mat data(3, 200);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    data(0, i) = i % 20;
+    data(1, i) = i / 20;
+    data(2, i) = 1 + (i * 7) % 5;
+  }
+
+  const data::RatingTriples triples(data);
+
+  SVDPlusPlus<> svdPP(5, 0.001, 0.1);
+  arma::mat u1, v1, y1, u2, v2, y2;
+  arma::vec p1, q1, p2, q2;
+  RandomSeed(7);
+  svdPP.Apply(data, 3, u1, v1, p1, q1, y1);
+  RandomSeed(7);
+  svdPP.Apply(triples, 3, u2, v2, p2, q2, y2);
+
+  REQUIRE(arma::approx_equal(u1, u2, "absdiff", 1e-10));
+  REQUIRE(arma::approx_equal(v1, v2, "absdiff", 1e-10));
+  REQUIRE(arma::approx_equal(p1, p2, "absdiff", 1e-10));
+  REQUIRE(arma::approx_equal(q1, q2, "absdiff", 1e-10));
+  REQUIRE(arma::approx_equal(y1, y2, "absdiff", 1e-10));
+}
+
 // The test is only compiled if the user has specified OpenMP to be
 // used.
 #ifdef MLPACK_USE_OPENMP
@@ -0,0 +1,77 @@
+/**
+ * @file tests/threads_test.cpp
+ *
+ * Tests for the functions that control the number of threads of mlpack.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#include "catch.hpp"
+
+using namespace mlpack;
+
+/**
+ * Make sure that SetThreads() changes the number of threads of the parallel
+ * regions that are started afterwards.
+ */
+TEST_CASE("SetThreadsTest", "[ThreadsTest]")
+{
+  const size_t oldThreads = Threads();
+
+  SetThreads(2);
+  size_t regionThreads = 1;
+  #pragma omp parallel
+  {
+    #ifdef MLPACK_USE_OPENMP
+    #pragma omp single
+    regionThreads = (size_t) omp_get_num_threads();
+    #endif
+  }
+
+  #ifdef MLPACK_USE_OPENMP
+  REQUIRE(Threads() == 2);
+  REQUIRE(regionThreads == 2);
+  #else
+  REQUIRE(Threads() == 1);
+  REQUIRE(regionThreads == 1);
+  #endif
+
+  // Zero means one thread for each processor.
+  SetThreads(0);
+  #ifdef MLPACK_USE_OPENMP
+  REQUIRE(Threads() == (size_t) omp_get_num_procs());
+  #endif
+
+  SetThreads(oldThreads);
+  REQUIRE(Threads() == oldThreads);
+}
+
+/**
+ * Make sure that ScopedThreads restores the previous number of threads, also
+ * when nested.
+ */
+TEST_CASE("ScopedThreadsTest", "[ThreadsTest]")
+{
+  const size_t oldThreads = Threads();
+  {
+    ScopedThreads threads(3);
+    #ifdef MLPACK_USE_OPENMP
+    REQUIRE(Threads() == 3);
+    #endif
+
+    {
+      ScopedThreads innerThreads(1);
+      REQUIRE(Threads() == 1);
+    }
+
+    #ifdef MLPACK_USE_OPENMP
+    REQUIRE(Threads() == 3);
+    #endif
+  }
+
+  REQUIRE(Threads() == oldThreads);
+}
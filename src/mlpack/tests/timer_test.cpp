@@ -143,3 +143,136 @@ TEST_CASE("DisabledTimingTest", "[TimerTest]")
 
   REQUIRE(Timer::Get("test_timer") == std::chrono::microseconds(0));
 }
+
+/**
+ * Make sure that nested ScopedTimers get hierarchical names, and that the
+ * number of runs and the shortest and longest runs are kept.
+ */
+TEST_CASE("ScopedTimerTest", "[TimerTest]")
+{
+  util::Timers timers;
+  timers.Enabled() = true;
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    util::ScopedTimer outer(timers, "outer");
+    REQUIRE(outer.Name() == "outer");
+    {
+      util::ScopedTimer inner(timers, "inner");
+      REQUIRE(inner.Name() == "outer/inner");
+
+      #ifdef _WIN32
+      Sleep(10 * (i + 1));
+      #else
+      usleep(10000 * (i + 1));
+      #endif
+    }
+  }
+
+  // A scope that starts after the others is not nested in them.
+  {
+    util::ScopedTimer other(timers, "inner");
+    REQUIRE(other.Name() == "inner");
+  }
+
+  REQUIRE(timers.Count("outer") == 3);
+  REQUIRE(timers.Count("outer/inner") == 3);
+  REQUIRE(timers.Count("inner") == 1);
+  REQUIRE(timers.Count("none") == 0);
+  REQUIRE(timers.Min("outer/inner") >= std::chrono::microseconds(10000));
+  REQUIRE(timers.Max("outer/inner") >= std::chrono::microseconds(30000));
+  REQUIRE(timers.Min("outer/inner") <= timers.Max("outer/inner"));
+  REQUIRE(timers.Get("outer") >= timers.Get("outer/inner"));
+}
+
+/**
+ * Make sure that the runs of a ScopedTimer in several threads are summed, and
+ * that the trace holds one event for each run.
+ */
+TEST_CASE("ScopedTimerThreadsTraceTest", "[TimerTest]")
+{
+  util::Timers timers;
+  timers.Enabled() = true;
+  timers.Tracing() = true;
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    threads.push_back(std::thread([&timers]()
+        {
+          util::ScopedTimer t(timers, "thread_work");
+
+          #ifdef _WIN32
+          Sleep(20);
+          #else
+          usleep(20000);
+          #endif
+        }));
+  }
+
+  for (size_t i = 0; i < 3; ++i)
+    threads[i].join();
+
+  REQUIRE(timers.Count("thread_work") == 3);
+  REQUIRE(timers.Get("thread_work") >= std::chrono::microseconds(60000));
+
+  std::ostringstream trace;
+  timers.ExportTrace(trace);
+  const std::string json = trace.str();
+  REQUIRE(json.find("\"traceEvents\"") != std::string::npos);
+
+  size_t events = 0;
+  size_t pos = 0;
+  while ((pos = json.find("\"name\": \"thread_work\"", pos)) !=
+      std::string::npos)
+  {
+    ++events;
+    ++pos;
+  }
+  REQUIRE(events == 3);
+
+  // Each thread has its own thread id in the trace.
+  REQUIRE(json.find("\"tid\": 0") != std::string::npos);
+  REQUIRE(json.find("\"tid\": 1") != std::string::npos);
+  REQUIRE(json.find("\"tid\": 2") != std::string::npos);
+}
+
+/**
+ * When memory is tracked, the timers should record the peak memory of their
+ * runs, with nested timers getting their own peak; otherwise, nothing should
+ * be recorded.
+ */
+TEST_CASE("TimerPeakMemoryTest", "[TimerTest]")
+{
+  util::Timers timers;
+  timers.Enabled() = true;
+
+  {
+    util::ScopedTimer outer(timers, "outer");
+    {
+      util::ScopedTimer inner(timers, "inner");
+      arma::mat small(100, 100, arma::fill::ones);
+    }
+
+    arma::mat large(1000, 100, arma::fill::ones);
+    REQUIRE(large(0, 0) == 1.0);
+  }
+
+  const size_t smallBytes = 100 * 100 * sizeof(double);
+  const size_t largeBytes = 1000 * 100 * sizeof(double);
+  if (util::MemoryUsage::Enabled())
+  {
+    REQUIRE(timers.PeakMemory("outer/inner") >= smallBytes);
+    REQUIRE(timers.PeakMemory("outer/inner") < timers.PeakMemory("outer"));
+    REQUIRE(timers.PeakMemory("outer") >= largeBytes);
+    REQUIRE(timers.Allocations("outer") >= 2);
+    REQUIRE(timers.Allocations("outer/inner") >= 1);
+    REQUIRE(util::MemoryUsage::Peak() >= timers.PeakMemory("outer"));
+  }
+  else
+  {
+    REQUIRE(timers.PeakMemory("outer") == 0);
+    REQUIRE(timers.Allocations("outer") == 0);
+    REQUIRE(util::MemoryUsage::Current() == 0);
+  }
+}
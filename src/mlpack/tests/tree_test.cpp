@@ -1030,6 +1030,69 @@ TEST_CASE("HRectBoundDiameter", "[TreeTest]")
   REQUIRE(d.Diameter() == Approx(0.0).margin(1e-5));
 }
 
+/**
+ * Check the distances computed by an HRectBound with the given metric against
+ * the distances to the closest and furthest points of the bound, for several
+ * dimensionalities (both below and above HRectBoundKernels::MaxFixedDim).
+ */
+template<typename DistanceType>
+void CheckHRectBoundDistances()
+{
+  for (size_t dim = 1; dim <= 24; ++dim)
+  {
+    arma::mat lo(dim, 2, arma::fill::randn), hi(dim, 2, arma::fill::randn);
+    arma::mat boxLo = arma::min(lo, hi), boxHi = arma::max(lo, hi);
+    HRectBound<DistanceType> b(dim), c(dim);
+    for (size_t d = 0; d < dim; ++d)
+    {
+      b[d] = Range(boxLo(d, 0), boxHi(d, 0));
+      c[d] = Range(boxLo(d, 1), boxHi(d, 1));
+    }
+
+    arma::vec point(dim, arma::fill::randn);
+    point *= 2.0;
+
+    // Closest and furthest points of b to the point, and the closest and
+    // furthest pairs of points of b and c.
+    arma::vec closest = arma::clamp(point, boxLo.col(0), boxHi.col(0));
+    arma::vec furthest(dim), bClosest(dim), cClosest(dim), bFurthest(dim),
+        cFurthest(dim);
+    for (size_t d = 0; d < dim; ++d)
+    {
+      furthest[d] = (point[d] - boxLo(d, 0) > boxHi(d, 0) - point[d]) ?
+          boxLo(d, 0) : boxHi(d, 0);
+      bClosest[d] = std::min(std::max(boxLo(d, 1), boxLo(d, 0)), boxHi(d, 0));
+      cClosest[d] = std::min(std::max(bClosest[d], boxLo(d, 1)), boxHi(d, 1));
+      const bool loFirst = (boxHi(d, 1) - boxLo(d, 0) >
+          boxHi(d, 0) - boxLo(d, 1));
+      bFurthest[d] = loFirst ? boxLo(d, 0) : boxHi(d, 0);
+      cFurthest[d] = loFirst ? boxHi(d, 1) : boxLo(d, 1);
+    }
+
+    const double minPoint = DistanceType::Evaluate(point, closest);
+    const double maxPoint = DistanceType::Evaluate(point, furthest);
+    const double minBound = DistanceType::Evaluate(bClosest, cClosest);
+    const double maxBound = DistanceType::Evaluate(bFurthest, cFurthest);
+
+    REQUIRE(b.MinDistance(point) == Approx(minPoint).margin(1e-10));
+    REQUIRE(b.MaxDistance(point) == Approx(maxPoint).epsilon(1e-10));
+    REQUIRE(b.RangeDistance(point).Lo() == Approx(minPoint).margin(1e-10));
+    REQUIRE(b.RangeDistance(point).Hi() == Approx(maxPoint).epsilon(1e-10));
+    REQUIRE(b.MinDistance(c) == Approx(minBound).margin(1e-10));
+    REQUIRE(b.MaxDistance(c) == Approx(maxBound).epsilon(1e-10));
+    REQUIRE(b.RangeDistance(c).Lo() == Approx(minBound).margin(1e-10));
+    REQUIRE(b.RangeDistance(c).Hi() == Approx(maxBound).epsilon(1e-10));
+  }
+}
+
+TEST_CASE("HRectBoundDistanceKernelsTest", "[TreeTest]")
+{
+  CheckHRectBoundDistances<ManhattanDistance>();
+  CheckHRectBoundDistances<EuclideanDistance>();
+  CheckHRectBoundDistances<SquaredEuclideanDistance>();
+  CheckHRectBoundDistances<LMetric<3, true>>();
+}
+
 /**
  * It seems as though Bill has stumbled across a bug where
  * BinarySpaceTree<>::count() returns something different than
@@ -1353,6 +1416,79 @@ TEST_CASE("KdTreeTest", "[TreeTest]")
   TreeType root(dataset);
 }
 
+/**
+ * Make sure that the parallel partition gives exactly the same ordering and
+ * mapping as the sequential partition.
+ */
+TEST_CASE("ParallelPerformSplitTest", "[TreeTest]")
+{
+  typedef MidpointSplit<HRectBound<EuclideanDistance>, arma::mat> SplitType;
+
+  arma::mat dataset(4, 5000, arma::fill::randu);
+  arma::mat parallelDataset(dataset);
+
+  std::vector<size_t> oldFromNew(dataset.n_cols);
+  for (size_t i = 0; i < oldFromNew.size(); ++i)
+    oldFromNew[i] = i;
+  std::vector<size_t> parallelOldFromNew(oldFromNew);
+
+  SplitType::SplitInfo splitInfo;
+  splitInfo.splitDimension = 2;
+  splitInfo.splitVal = 0.3;
+
+  // Only split part of the dataset, to make sure that begin is respected.
+  const size_t splitCol = PerformSplit<arma::mat, SplitType>(dataset, 100,
+      4800, splitInfo, oldFromNew);
+  const size_t parallelSplitCol = ParallelPerformSplit<arma::mat, SplitType>(
+      parallelDataset, 100, 4800, splitInfo, &parallelOldFromNew);
+
+  REQUIRE(splitCol == parallelSplitCol);
+  CheckMatrices(dataset, parallelDataset);
+  for (size_t i = 0; i < oldFromNew.size(); ++i)
+    REQUIRE(oldFromNew[i] == parallelOldFromNew[i]);
+
+  // Check that the split is actually correct.
+  for (size_t i = 100; i < splitCol; ++i)
+    REQUIRE(dataset(2, i) < 0.3);
+  for (size_t i = splitCol; i < 4900; ++i)
+    REQUIRE(dataset(2, i) >= 0.3);
+}
+
+/**
+ * Build a kd-tree large enough that the children of the top nodes are built in
+ * parallel, and make sure that the mappings and bounds are still correct.
+ */
+TEST_CASE("ParallelKdTreeBuildTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  REQUIRE(TreeType::ParallelBuild == true);
+
+  arma::mat dataset(3, 8 * TreeType::ParallelBuildMinCount, arma::fill::randu);
+
+  std::vector<size_t> oldFromNew, newFromOld;
+  TreeType root(dataset, oldFromNew, newFromOld);
+  const arma::mat& treeset = root.Dataset();
+
+  REQUIRE(root.Count() == dataset.n_cols);
+  REQUIRE(root.NumDescendants() == dataset.n_cols);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    for (size_t j = 0; j < dataset.n_rows; ++j)
+    {
+      REQUIRE(treeset(j, i) == dataset(j, oldFromNew[i]));
+      REQUIRE(treeset(j, newFromOld[i]) == dataset(j, i));
+    }
+  }
+
+  CheckPointBounds(root);
+
+  // A tree built without mappings must end up with the same ordering.
+  TreeType unmappedRoot(dataset);
+  CheckMatrices(root.Dataset(), unmappedRoot.Dataset());
+}
+
 TEST_CASE("MaxRPTreeTest", "[TreeTest]")
 {
   typedef MaxRPTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
@@ -2067,6 +2203,49 @@ TEST_CASE("CoverTreeCopyConstructor", "[TreeTest]")
   REQUIRE(e.Dataset().memptr() != f.Dataset().memptr());
 }
 
+/**
+ * Check that two cover trees have exactly the same structure.
+ */
+template<typename TreeType>
+void CheckSameCoverTree(const TreeType& a, const TreeType& b)
+{
+  REQUIRE(a.Point() == b.Point());
+  REQUIRE(a.Scale() == b.Scale());
+  REQUIRE(a.ParentDistance() == b.ParentDistance());
+  REQUIRE(a.FurthestDescendantDistance() == b.FurthestDescendantDistance());
+  REQUIRE(a.NumDescendants() == b.NumDescendants());
+  REQUIRE(a.NumChildren() == b.NumChildren());
+
+  for (size_t i = 0; i < a.NumChildren(); ++i)
+    CheckSameCoverTree(a.Child(i), b.Child(i));
+}
+
+// Make sure that building a cover tree with several threads gives the same tree
+// as building it with one thread.
+TEST_CASE("CoverTreeParallelConstructionTest", "[TreeTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 5000);
+  typedef StandardCoverTree<EuclideanDistance, EmptyStatistic, arma::mat>
+      TreeType;
+
+  #ifdef MLPACK_USE_OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  TreeType sequentialTree(dataset, 1.3);
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(threads);
+  #endif
+
+  TreeType parallelTree(dataset, 1.3);
+
+  REQUIRE(sequentialTree.DistanceComps() == parallelTree.DistanceComps());
+  CheckSameCoverTree(sequentialTree, parallelTree);
+  CheckCovering<TreeType, EuclideanDistance>(parallelTree);
+}
+
 TEST_CASE("CoverTreeMoveDatasetTest", "[TreeTest]")
 {
   arma::mat dataset = arma::randu<arma::mat>(3, 1000);
@@ -2088,6 +2267,54 @@ TEST_CASE("CoverTreeMoveDatasetTest", "[TreeTest]")
   REQUIRE(t2.Dataset().n_cols == 1000);
 }
 
+template<typename TreeType>
+void CheckSameBinarySpaceTree(const TreeType& a, const TreeType& b)
+{
+  REQUIRE(a.Begin() == b.Begin());
+  REQUIRE(a.Count() == b.Count());
+  REQUIRE(a.NumChildren() == b.NumChildren());
+  REQUIRE(&a.Dataset() != &b.Dataset());
+
+  for (size_t i = 0; i < a.NumChildren(); ++i)
+  {
+    REQUIRE(a.Child(i).Parent() == &a);
+    CheckSameBinarySpaceTree(a.Child(i), b.Child(i));
+  }
+}
+
+/**
+ * The nodes of a tree are allocated from an arena owned by the root; make sure
+ * that copies and moves of the tree (which may allocate their nodes
+ * individually) outlive the arena of the tree they were made from.
+ */
+TEST_CASE("TreeArenaCopyMoveTest", "[TreeTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 3000);
+
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> KDTreeType;
+  KDTreeType* kdTree = new KDTreeType(dataset, 5);
+  KDTreeType kdCopy(*kdTree);
+  KDTreeType kdMoved(dataset, 5);
+  kdMoved = KDTreeType(*kdTree);
+  KDTreeType kdReference(dataset, 5);
+  delete kdTree;
+
+  CheckSameBinarySpaceTree(kdCopy, kdReference);
+  CheckSameBinarySpaceTree(kdMoved, kdReference);
+
+  typedef StandardCoverTree<EuclideanDistance, EmptyStatistic, arma::mat>
+      CoverTreeType;
+  CoverTreeType* coverTree = new CoverTreeType(dataset, 1.3);
+  CoverTreeType coverCopy(*coverTree);
+  CoverTreeType coverMoved(std::move(*coverTree));
+  delete coverTree;
+
+  CoverTreeType coverReference(dataset, 1.3);
+  CheckSameCoverTree(coverCopy, coverReference);
+  CheckSameCoverTree(coverMoved, coverReference);
+  CheckCovering<CoverTreeType, EuclideanDistance>(coverMoved);
+}
+
 /**
  * Make sure copy constructor works right for the binary space tree.
  */
@@ -45,3 +45,31 @@ TEST_CASE("TestUnion", "[UnionFindTest]")
   REQUIRE(testUnionFind.Find(1) == testUnionFind.Find(5));
   REQUIRE(testUnionFind.Find(6) == testUnionFind.Find(3));
 }
+
+TEST_CASE("ConcurrentUnionFindTest", "[UnionFindTest]")
+{
+  // Union the elements of a chain from all threads in a scrambled order; every
+  // element should end up in the component of element 0.
+  static const size_t testSize = 10000;
+  ConcurrentUnionFind testUnionFind(testSize);
+
+  #pragma omp parallel for schedule(dynamic, 16)
+  for (size_t i = 0; i < testSize - 1; ++i)
+  {
+    const size_t j = (i * 7919) % (testSize - 1);
+    testUnionFind.Union(j + 1, j);
+  }
+
+  for (size_t i = 0; i < testSize; ++i)
+    REQUIRE(testUnionFind.Find(i) == 0);
+
+  // Two separate components: the even and the odd elements.
+  ConcurrentUnionFind parityUnionFind(testSize);
+
+  #pragma omp parallel for schedule(dynamic, 16)
+  for (size_t i = 2; i < testSize; ++i)
+    parityUnionFind.Union(i, i - 2);
+
+  for (size_t i = 0; i < testSize; ++i)
+    REQUIRE(parityUnionFind.Find(i) == i % 2);
+}
@@ -0,0 +1,115 @@
+/**
+ * @file tests/weighted_als_test.cpp
+ *
+ * Test the WeightedALSUpdate class for AMF.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/amf.hpp>
+
+#include "catch.hpp"
+
+using namespace mlpack;
+
+/**
+ * Make sure that weighted ALS recovers a low-rank matrix from a sample of its
+ * elements.
+ */
+TEMPLATE_TEST_CASE("WeightedALSLowRankTest", "[WeightedALSTest]", float,
+    double)
+{
+  typedef TestType eT;
+
+  const arma::Mat<eT> w0 = arma::randu<arma::Mat<eT>>(60, 3) + 0.5;
+  const arma::Mat<eT> h0 = arma::randu<arma::Mat<eT>>(3, 80) + 0.5;
+  const arma::Mat<eT> full = w0 * h0;
+
+  // Observe about 40% of the elements.
+  arma::Mat<eT> mask = arma::randu<arma::Mat<eT>>(60, 80);
+  mask.transform([](eT x) { return (x < 0.4) ? eT(1) : eT(0); });
+  const arma::SpMat<eT> data(full % mask);
+
+  AMF<MaxIterationTermination, RandomAMFInitialization, WeightedALSUpdate>
+      amf(MaxIterationTermination(50), RandomAMFInitialization(),
+      WeightedALSUpdate(1e-6));
+  arma::Mat<eT> w, h;
+  amf.Apply(data, 3, w, h);
+
+  REQUIRE(w.n_rows == 60);
+  REQUIRE(w.n_cols == 3);
+  REQUIRE(h.n_rows == 3);
+  REQUIRE(h.n_cols == 80);
+
+  // The whole matrix, including the unobserved elements, should be
+  // recovered.
+  const double rmse = std::sqrt(arma::accu(arma::square(w * h - full)) /
+      full.n_elem);
+  REQUIRE(rmse < 1e-2);
+}
+
+/**
+ * Make sure that one update of H solves the regularized least squares problem
+ * of each user, for explicit and implicit feedback.
+ */
+TEST_CASE("WeightedALSUpdateSolutionTest", "[WeightedALSTest]")
+{
+  arma::sp_mat data;
+  data.sprandu(40, 30, 0.2);
+  const arma::mat w = arma::randu<arma::mat>(40, 4);
+  const arma::mat dense(data);
+  const double lambda = 0.1;
+
+  WeightedALSUpdate explicitUpdate(lambda);
+  arma::mat h;
+  explicitUpdate.Initialize(data, 4);
+  explicitUpdate.HUpdate(data, w, h);
+  REQUIRE(h.n_rows == 4);
+  REQUIRE(h.n_cols == 30);
+
+  WeightedALSUpdate implicitUpdate(lambda, true, 10.0);
+  arma::mat hImplicit;
+  implicitUpdate.Initialize(data, 4);
+  implicitUpdate.HUpdate(data, w, hImplicit);
+
+  for (size_t j = 0; j < data.n_cols; ++j)
+  {
+    // Explicit: only the observed elements of the user are used.
+    const arma::uvec observed = arma::find(dense.col(j) != 0);
+    if (observed.n_elem == 0)
+    {
+      REQUIRE(arma::accu(arma::abs(h.col(j))) == 0.0);
+    }
+    else
+    {
+      const arma::mat wObserved = w.rows(observed);
+      const arma::vec values = dense.col(j);
+      const arma::vec expected = arma::solve(wObserved.t() * wObserved +
+          lambda * observed.n_elem * arma::eye(4, 4),
+          wObserved.t() * values.elem(observed));
+      REQUIRE(arma::approx_equal(h.col(j), expected, "reldiff", 1e-6));
+    }
+
+    // Implicit: every element is used, with its confidence.
+    const arma::vec confidence = 1 + 10.0 * dense.col(j);
+    const arma::vec preference = arma::conv_to<arma::vec>::from(
+        dense.col(j) != 0);
+    const arma::vec expected = arma::solve(w.t() * arma::diagmat(confidence) *
+        w + lambda * arma::eye(4, 4), w.t() * (confidence % preference));
+    REQUIRE(arma::approx_equal(hImplicit.col(j), expected, "reldiff", 1e-6));
+  }
+
+  // The update of W is the update of H on the transposed problem.
+  const arma::mat hFixed = arma::randu<arma::mat>(4, 30);
+  arma::mat wUpdated, hTrans;
+  explicitUpdate.WUpdate(data, wUpdated, hFixed);
+  WeightedALSUpdate transUpdate(lambda);
+  const arma::sp_mat dataTrans = data.t();
+  transUpdate.Initialize(dataTrans, 4);
+  transUpdate.HUpdate(dataTrans, arma::mat(hFixed.t()), hTrans);
+  REQUIRE(arma::approx_equal(wUpdated, arma::mat(hTrans.t()), "absdiff",
+      1e-10));
+}
@@ -10,10 +10,11 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/core.hpp>
-#include <mlpack/methods/xgboost/loss_functions/sse_loss.hpp>
+#include <mlpack/methods/xgboost.hpp>
 
 #include "catch.hpp"
 #include "serialization.hpp"
+#include "test_catch_tools.hpp"
 
 using namespace mlpack;
 
@@ -63,3 +64,251 @@ TEST_CASE("SSEGainTest", "[XGBTest]")
   SSELoss Loss;
   REQUIRE(Loss.Evaluate<false>(input, weights) == gain);
 }
+
+/**
+ * Make sure that the logistic and softmax losses compute the right gradients
+ * and hessians.
+ */
+TEST_CASE("ClassificationLossGradientsTest", "[XGBTest]")
+{
+  arma::rowvec labels = { 0, 1, 1 };
+  arma::mat scores = { { 0.0, 2.0, -1.0 } };
+  arma::mat gradients, hessians;
+
+  LogisticLoss logistic;
+  logistic.Gradients(labels, scores, gradients, hessians);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    const double p = 1.0 / (1.0 + std::exp(-scores[i]));
+    REQUIRE(gradients[i] == Approx(p - labels[i]));
+    REQUIRE(hessians[i] == Approx(p * (1.0 - p)));
+  }
+
+  // The softmax loss of two classes with scores (0, s) is the logistic loss
+  // of s.
+  SoftmaxLoss softmax(2);
+  arma::mat softmaxScores = arma::join_cols(arma::zeros<arma::rowvec>(3),
+      scores.row(0));
+  arma::mat softmaxGradients, softmaxHessians;
+  softmax.Gradients(labels, softmaxScores, softmaxGradients, softmaxHessians);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    REQUIRE(softmaxGradients(1, i) == Approx(gradients[i]));
+    REQUIRE(softmaxGradients(0, i) == Approx(-gradients[i]));
+    REQUIRE(softmaxHessians(1, i) == Approx(hessians[i]));
+  }
+
+  REQUIRE(softmax.Loss(labels, softmaxScores) ==
+      Approx(logistic.Loss(labels, scores)));
+
+  // Invalid labels are rejected.
+  arma::vec initialScores;
+  arma::rowvec badLabels = { 0, 2, 1 };
+  REQUIRE_THROWS_AS(logistic.InitialScores(badLabels, initialScores),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(softmax.InitialScores(badLabels, initialScores),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that a single tree of depth one finds the obvious split of a step
+ * function.
+ */
+TEST_CASE("XGBoostStumpTest", "[XGBTest]")
+{
+  // Few distinct values, so that each value gets its own bin.
+  arma::mat data = arma::floor(10.0 * arma::randu<arma::mat>(2, 1000)) / 10.0;
+  arma::rowvec responses(1000);
+  for (size_t i = 0; i < 1000; ++i)
+    responses[i] = (data(1, i) <= 0.4) ? -1.0 : 1.0;
+
+  // With a learning rate of 1 and no regularization, each leaf predicts the
+  // mean response of its points.
+  XGBoost<> model(data, responses, 1, 1.0, 1, 1.0, 0.0);
+
+  REQUIRE(model.NumTrees() == 1);
+  REQUIRE(model.Tree(0).NumNodes() == 3);
+  REQUIRE(model.Tree(0).SplitDimensions()[0] == 1);
+  REQUIRE(model.Tree(0).Thresholds()[0] == Approx(0.45));
+
+  arma::rowvec predictions;
+  model.Predict(data, predictions);
+  REQUIRE(arma::max(arma::abs(predictions - responses)) < 1e-8);
+}
+
+/**
+ * Make sure that boosting fits a nonlinear regression function much better
+ * than the mean, and generalizes.
+ */
+TEST_CASE("XGBoostRegressionTest", "[XGBTest]")
+{
+  arma::mat data(3, 4000, arma::fill::randu);
+  arma::rowvec responses = arma::sin(4.0 * data.row(0)) +
+      arma::square(data.row(1)) + 0.05 * arma::randn<arma::rowvec>(4000);
+
+  arma::mat trainData = data.cols(0, 2999);
+  arma::rowvec trainResponses = responses.subvec(0, 2999);
+  arma::mat testData = data.cols(3000, 3999);
+  arma::rowvec testResponses = responses.subvec(3000, 3999);
+
+  XGBoost<> model;
+  const double trainLoss = model.Train(trainData, trainResponses, 100, 0.3, 4);
+  REQUIRE(model.NumRounds() == 100);
+
+  arma::rowvec predictions;
+  model.Predict(testData, predictions);
+  const double testMSE = arma::mean(arma::square(predictions - testResponses));
+  const double variance = arma::var(testResponses);
+
+  REQUIRE(trainLoss < 0.01);
+  REQUIRE(testMSE < 0.05 * variance);
+}
+
+/**
+ * Make sure that the logistic loss separates two classes.
+ */
+TEST_CASE("XGBoostLogisticTest", "[XGBTest]")
+{
+  arma::mat data(2, 2000, arma::fill::randn);
+  arma::Row<size_t> labels(2000);
+  for (size_t i = 0; i < 2000; ++i)
+    labels[i] = (data(0, i) * data(1, i) > 0.0) ? 1 : 0;
+
+  arma::mat trainData = data.cols(0, 1499);
+  arma::Row<size_t> trainLabels = labels.subvec(0, 1499);
+  arma::mat testData = data.cols(1500, 1999);
+  arma::Row<size_t> testLabels = labels.subvec(1500, 1999);
+
+  XGBoost<LogisticLoss> model(trainData, trainLabels, 50);
+
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  model.Classify(testData, predictions, probabilities);
+
+  REQUIRE(probabilities.n_rows == 1);
+  REQUIRE(probabilities.n_cols == 500);
+  REQUIRE(arma::all(arma::vectorise(probabilities) >= 0.0));
+  REQUIRE(arma::all(arma::vectorise(probabilities) <= 1.0));
+
+  const size_t correct = arma::accu(predictions == testLabels);
+  REQUIRE(correct >= 450);
+}
+
+/**
+ * Make sure that the softmax loss does well on the iris dataset, also with row
+ * and column subsampling.
+ */
+TEST_CASE("XGBoostSoftmaxTest", "[XGBTest]")
+{
+  arma::mat trainData, testData;
+  arma::Row<size_t> trainLabels, testLabels;
+  if (!data::Load("iris_train.csv", trainData))
+    FAIL("Cannot load dataset iris_train.csv");
+  if (!data::Load("iris_train_labels.csv", trainLabels))
+    FAIL("Cannot load dataset iris_train_labels.csv");
+  if (!data::Load("iris_test.csv", testData))
+    FAIL("Cannot load dataset iris_test.csv");
+  if (!data::Load("iris_test_labels.csv", testLabels))
+    FAIL("Cannot load dataset iris_test_labels.csv");
+
+  XGBoost<SoftmaxLoss> model(trainData, trainLabels, 30);
+  REQUIRE(model.NumOutputs() == 3);
+  REQUIRE(model.NumTrees() == 90);
+
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  model.Classify(testData, predictions, probabilities);
+  REQUIRE(probabilities.n_rows == 3);
+  for (size_t i = 0; i < probabilities.n_cols; ++i)
+    REQUIRE(arma::accu(probabilities.col(i)) == Approx(1.0));
+
+  double accuracy = arma::accu(predictions == testLabels);
+  accuracy /= testLabels.n_elem;
+  REQUIRE(accuracy >= 0.9);
+
+  // Subsample the points and the dimensions.
+  XGBoost<SoftmaxLoss> subsampled(trainData, trainLabels, 30, 0.3, 6, 1.0,
+      1.0, 0.0, 0.0, 0.7, 0.5);
+  subsampled.Classify(testData, predictions);
+
+  accuracy = arma::accu(predictions == testLabels);
+  accuracy /= testLabels.n_elem;
+  REQUIRE(accuracy >= 0.85);
+}
+
+/**
+ * Make sure that early stopping keeps the trees of the round with the best
+ * validation loss.
+ */
+TEST_CASE("XGBoostEarlyStoppingTest", "[XGBTest]")
+{
+  // Noisy labels, so that the validation loss eventually gets worse.
+  arma::mat data(5, 1500, arma::fill::randu);
+  arma::Row<size_t> labels(1500);
+  for (size_t i = 0; i < 1500; ++i)
+  {
+    labels[i] = (data(0, i) + data(1, i) > 1.0) ? 1 : 0;
+    if (Random() < 0.2)
+      labels[i] = 1 - labels[i];
+  }
+
+  arma::mat trainData = data.cols(0, 999);
+  arma::Row<size_t> trainLabels = labels.subvec(0, 999);
+  arma::mat validData = data.cols(1000, 1499);
+  arma::Row<size_t> validLabels = labels.subvec(1000, 1499);
+
+  XGBoost<LogisticLoss> model;
+  const double bestLoss = model.Train(trainData, trainLabels, validData,
+      validLabels, 5, 500, 0.5, 8, 0.0);
+
+  REQUIRE(model.NumRounds() < 500);
+
+  // The returned loss is the loss of the kept trees.
+  arma::mat scores;
+  model.Scores(validData, scores);
+  const arma::rowvec validResponses =
+      arma::conv_to<arma::rowvec>::from(validLabels);
+  REQUIRE(LogisticLoss().Loss(validResponses, scores) == Approx(bestLoss));
+
+  // Training for all rounds gives a worse validation loss.
+  XGBoost<LogisticLoss> full;
+  const double fullLoss = full.Train(trainData, trainLabels, validData,
+      validLabels, 0, 500, 0.5, 8, 0.0);
+  REQUIRE(full.NumRounds() == 500);
+  REQUIRE(fullLoss > bestLoss);
+}
+
+/**
+ * Make sure that a serialized model gives the same predictions.
+ */
+TEST_CASE("XGBoostSerializationTest", "[XGBTest]")
+{
+  arma::mat data;
+  if (!data::Load("vc2.csv", data))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+
+  XGBoost<SoftmaxLoss> model(data, labels, 10);
+
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  model.Classify(data, predictions, probabilities);
+
+  XGBoost<SoftmaxLoss> xmlModel, jsonModel, binaryModel;
+  binaryModel.Train(data, labels, 2, 0.1, 2);
+  SerializeObjectAll(model, xmlModel, jsonModel, binaryModel);
+
+  arma::Row<size_t> xmlPredictions, jsonPredictions, binaryPredictions;
+  arma::mat xmlProbabilities, jsonProbabilities, binaryProbabilities;
+  xmlModel.Classify(data, xmlPredictions, xmlProbabilities);
+  jsonModel.Classify(data, jsonPredictions, jsonProbabilities);
+  binaryModel.Classify(data, binaryPredictions, binaryProbabilities);
+
+  REQUIRE(binaryModel.NumTrees() == model.NumTrees());
+  CheckMatrices(predictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+  CheckMatrices(probabilities, xmlProbabilities, jsonProbabilities,
+      binaryProbabilities);
+}